@@ -39,3 +39,9 @@ void CopyJobAdaptor::Execute()
     parent()->Execute();
 }
 
+QDBusUnixFileDescriptor CopyJobAdaptor::ProgressChannel(QDBusUnixFileDescriptor &eventFd)
+{
+    // handle method call com.deepin.filemanager.daemon.CopyJob.ProgressChannel
+    return parent()->ProgressChannel(eventFd);
+}
+
@@ -34,6 +34,10 @@ class CopyJobAdaptor: public QDBusAbstractAdaptor
     Q_CLASSINFO("D-Bus Introspection", ""
 "  <interface name=\"com.deepin.filemanager.daemon.CopyJob\">\n"
 "    <method name=\"Execute\"/>\n"
+"    <method name=\"ProgressChannel\">\n"
+"      <arg direction=\"out\" type=\"h\" name=\"memoryFd\"/>\n"
+"      <arg direction=\"out\" type=\"h\" name=\"eventFd\"/>\n"
+"    </method>\n"
 "    <signal name=\"Done\">\n"
 "      <arg type=\"s\"/>\n"
 "    </signal>\n"
@@ -49,6 +53,7 @@ public:
 public: // PROPERTIES
 public Q_SLOTS: // METHODS
     void Execute();
+    QDBusUnixFileDescriptor ProgressChannel(QDBusUnixFileDescriptor &eventFd);
 Q_SIGNALS: // SIGNALS
     void Done(const QString &in0);
 };
@@ -39,3 +39,9 @@ void MoveJobAdaptor::Execute()
     parent()->Execute();
 }
 
+QDBusUnixFileDescriptor MoveJobAdaptor::ProgressChannel(QDBusUnixFileDescriptor &eventFd)
+{
+    // handle method call com.deepin.filemanager.daemon.RenameJob.ProgressChannel
+    return parent()->ProgressChannel(eventFd);
+}
+
@@ -42,6 +42,21 @@ public Q_SLOTS: // METHODS
         return asyncCallWithArgumentList(QStringLiteral("Execute"), argumentList);
     }
 
+    inline QDBusPendingReply<QDBusUnixFileDescriptor, QDBusUnixFileDescriptor> ProgressChannel()
+    {
+        QList<QVariant> argumentList;
+        return asyncCallWithArgumentList(QStringLiteral("ProgressChannel"), argumentList);
+    }
+    inline QDBusReply<QDBusUnixFileDescriptor> ProgressChannel(QDBusUnixFileDescriptor &eventFd)
+    {
+        QList<QVariant> argumentList;
+        QDBusMessage reply = callWithArgumentList(QDBus::Block, QStringLiteral("ProgressChannel"), argumentList);
+        if (reply.type() == QDBusMessage::ReplyMessage && reply.arguments().count() == 2) {
+            eventFd = qdbus_cast<QDBusUnixFileDescriptor>(reply.arguments().at(1));
+        }
+        return reply;
+    }
+
 Q_SIGNALS: // SIGNALS
     void Done(const QString &in0);
 };
@@ -3,56 +3,43 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "chinese2pinyin.h"
-
-#include <QHash>
-#include <QTextStream>
-#include <QFile>
+#include "pinyindict.h"
 
 namespace Pinyin {
 
-static QHash<uint, QString> dict = {};
-
-const char kDictFile[] = ":/misc/pinyin.dict";
+static const char *FindPinyin(ushort key) {
+    unsigned short index = kNoPinyin;
 
-void InitDict() {
-    if (!dict.isEmpty()) {
-        return;
+    if (key >= kFirst0 && key <= kLast0) {
+        index = kRange0[key - kFirst0];
+    } else if (key >= kFirst1 && key <= kLast1) {
+        index = kRange1[key - kFirst1];
     }
 
-    dict.reserve(25333);
-
-    QFile file(kDictFile);
-
-    if (!file.open(QIODevice::ReadOnly))
-        return;
-
-    QByteArray content = file.readAll();
-
-    file.close();
-
-    QTextStream stream(&content, QIODevice::ReadOnly);
+    return index == kNoPinyin ? nullptr : kSyllables[index];
+}
 
-    while (!stream.atEnd()) {
-        const QString line = stream.readLine();
-        const QStringList items = line.split(QChar(':'));
+QString Chinese2Pinyin(const QString& words) {
+    // 不含汉字时直接返回，避免复制
+    int first = 0;
 
-        if (items.size() == 2) {
-            dict.insert(static_cast<uint>(items[0].toInt(nullptr, 16)), items[1]);
-        }
+    while (first < words.length() && !FindPinyin(words.at(first).unicode())) {
+        ++first;
     }
-}
 
-QString Chinese2Pinyin(const QString& words) {
-    InitDict();
+    if (first == words.length()) {
+        return words;
+    }
 
     QString result;
+    result.reserve(words.length() * 4);
+    result.append(words.constData(), first);
 
-    for (int i = 0; i < words.length(); ++i) {
-        const uint key = words.at(i).unicode();
-        auto find_result = dict.find(key);
+    for (int i = first; i < words.length(); ++i) {
+        const char *pinyin = FindPinyin(words.at(i).unicode());
 
-        if (find_result != dict.end()) {
-            result.append(find_result.value());
+        if (pinyin) {
+            result.append(QLatin1String(pinyin));
         } else {
             result.append(words.at(i));
         }
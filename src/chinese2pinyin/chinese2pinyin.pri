@@ -1,10 +1,8 @@
 HEADERS += \
-    $$PWD/chinese2pinyin.h
+    $$PWD/chinese2pinyin.h \
+    $$PWD/pinyindict.h
 
 SOURCES += \
     $$PWD/chinese2pinyin.cpp
 
-RESOURCES += \
-    $$PWD/data.qrc
-
 INCLUDEPATH += $$PWD
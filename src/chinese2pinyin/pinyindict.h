@@ -0,0 +1,1911 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef SERVICE_BACKEND_PINYINDICT_H_
+#define SERVICE_BACKEND_PINYINDICT_H_
+
+// 由 pinyin.dict 生成，修改字典后需重新生成此文件
+// 汉字所在的两个编码区间各有一张按编码排列的表，表中是拼音在 kSyllables 中的序号，可直接按编码查找
+
+namespace Pinyin {
+
+constexpr unsigned short kNoPinyin = 0xffff;
+
+constexpr const char *const kSyllables[] = {
+    "a1", "a2", "a5", "ai1", "ai2", "ai3", "ai4", "an1", "an2", "an3",
+    "an4", "ang1", "ang2", "ang3", "ang4", "ao1", "ao2", "ao3", "ao4", "ba1",
+    "ba2", "ba3", "ba4", "ba5", "bai1", "bai2", "bai3", "bai4", "ban1", "ban3",
+    "ban4", "bang1", "bang3", "bang4", "bao1", "bao2", "bao3", "bao4", "bei1", "bei3",
+    "bei4", "ben1", "ben3", "ben4", "beng1", "beng2", "beng3", "beng4", "bi1", "bi2",
+    "bi3", "bi4", "bian1", "bian3", "bian4", "biao1", "biao3", "biao4", "bie1", "bie2",
+    "bie3", "bie4", "bin1", "bin4", "bing1", "bing3", "bing4", "bo1", "bo2", "bo3",
+    "bo4", "bo5", "bu1", "bu2", "bu3", "bu4", "ca1", "ca3", "ca4", "cai1",
+    "cai2", "cai3", "cai4", "can1", "can2", "can3", "can4", "cang1", "cang2", "cang4",
+    "cao1", "cao2", "cao3", "cao4", "ce4", "cen1", "cen2", "ceng1", "ceng2", "ceng4",
+    "cha1", "cha2", "cha3", "cha4", "chai1", "chai2", "chai3", "chai4", "chan1", "chan2",
+    "chan3", "chan4", "chang1", "chang2", "chang3", "chang4", "chao1", "chao2", "chao3", "chao4",
+    "che1", "che3", "che4", "chen1", "chen2", "chen3", "chen4", "cheng1", "cheng2", "cheng3",
+    "cheng4", "chi1", "chi2", "chi3", "chi4", "chong1", "chong2", "chong3", "chong4", "chou1",
+    "chou2", "chou3", "chou4", "chu1", "chu2", "chu3", "chu4", "chua4", "chuai2", "chuai3",
+    "chuai4", "chuan1", "chuan2", "chuan3", "chuan4", "chuang1", "chuang2", "chuang3", "chuang4", "chui1",
+    "chui2", "chui3", "chui4", "chun1", "chun2", "chun3", "chuo1", "chuo2", "chuo4", "ci1",
+    "ci2", "ci3", "ci4", "cong1", "cong2", "cong4", "cou3", "cou4", "cu1", "cu2",
+    "cu4", "cuan1", "cuan2", "cuan4", "cui1", "cui2", "cui3", "cui4", "cun1", "cun2",
+    "cun3", "cun4", "cuo1", "cuo2", "cuo3", "cuo4", "da1", "da2", "da3", "da4",
+    "da5", "dai1", "dai3", "dai4", "dan1", "dan3", "dan4", "dang1", "dang3", "dang4",
+    "dao1", "dao3", "dao4", "de2", "de5", "deng1", "deng3", "deng4", "di1", "di2",
+    "di3", "di4", "dia3", "dian1", "dian2", "dian3", "dian4", "diao1", "diao3", "diao4",
+    "die1", "die2", "die4", "ding1", "ding2", "ding3", "ding4", "diu1", "dong1", "dong3",
+    "dong4", "dou1", "dou3", "dou4", "du1", "du2", "du3", "du4", "duan1", "duan3",
+    "duan4", "dui1", "dui3", "dui4", "dun1", "dun3", "dun4", "duo1", "duo2", "duo3",
+    "duo4", "e1", "e2", "e3", "e4", "en1", "en3", "en4", "er2", "er3",
+    "er4", "fa1", "fa2", "fa3", "fa4", "fan1", "fan2", "fan3", "fan4", "fang1",
+    "fang2", "fang3", "fang4", "fei1", "fei2", "fei3", "fei4", "fen1", "fen2", "fen3",
+    "fen4", "feng1", "feng2", "feng3", "feng4", "fo2", "fou2", "fou3", "fou4", "fu1",
+    "fu2", "fu3", "fu4", "ga1", "ga2", "ga3", "ga4", "gai1", "gai3", "gai4",
+    "gan1", "gan2", "gan3", "gan4", "gang1", "gang3", "gang4", "gao1", "gao3", "gao4",
+    "ge1", "ge2", "ge3", "ge4", "gei3", "gen1", "gen3", "gen4", "geng1", "geng3",
+    "geng4", "gong1", "gong3", "gong4", "gou1", "gou3", "gou4", "gu1", "gu2", "gu3",
+    "gu4", "gua1", "gua3", "gua4", "guai1", "guai3", "guai4", "guan1", "guan3", "guan4",
+    "guang1", "guang3", "guang4", "gui1", "gui2", "gui3", "gui4", "gun1", "gun3", "gun4",
+    "guo1", "guo2", "guo3", "guo4", "guo5", "ha1", "ha2", "hai1", "hai2", "hai3",
+    "hai4", "han1", "han2", "han3", "han4", "hang1", "hang2", "hang3", "hang4", "hao1",
+    "hao2", "hao3", "hao4", "he1", "he2", "he4", "hei1", "hen2", "hen3", "hen4",
+    "heng1", "heng2", "heng4", "hong1", "hong2", "hong3", "hong4", "hou1", "hou2", "hou3",
+    "hou4", "hu1", "hu2", "hu3", "hu4", "hua1", "hua2", "hua3", "hua4", "huai1",
+    "huai2", "huai4", "huan1", "huan2", "huan3", "huan4", "huang1", "huang2", "huang3", "huang4",
+    "hui1", "hui2", "hui3", "hui4", "hun1", "hun2", "hun3", "hun4", "huo1", "huo2",
+    "huo3", "huo4", "ji1", "ji2", "ji3", "ji4", "jia1", "jia2", "jia3", "jia4",
+    "jian1", "jian3", "jian4", "jiang1", "jiang3", "jiang4", "jiao1", "jiao2", "jiao3", "jiao4",
+    "jie1", "jie2", "jie3", "jie4", "jin1", "jin3", "jin4", "jing1", "jing3", "jing4",
+    "jiong1", "jiong3", "jiong4", "jiu1", "jiu2", "jiu3", "jiu4", "ju1", "ju2", "ju3",
+    "ju4", "juan1", "juan3", "juan4", "jue1", "jue2", "jue3", "jue4", "jun1", "jun3",
+    "jun4", "ka1", "ka3", "ka4", "kai1", "kai3", "kai4", "kan1", "kan3", "kan4",
+    "kang1", "kang2", "kang3", "kang4", "kao1", "kao3", "kao4", "ke1", "ke2", "ke3",
+    "ke4", "ken3", "ken4", "keng1", "keng3", "kong1", "kong3", "kong4", "kou1", "kou3",
+    "kou4", "ku1", "ku3", "ku4", "kua1", "kua3", "kua4", "kuai1", "kuai3", "kuai4",
+    "kuan1", "kuan3", "kuan4", "kuang1", "kuang2", "kuang3", "kuang4", "kui1", "kui2", "kui3",
+    "kui4", "kun1", "kun3", "kun4", "kuo3", "kuo4", "la1", "la2", "la3", "la4",
+    "la5", "lai2", "lai3", "lai4", "lan2", "lan3", "lan4", "lang1", "lang2", "lang3",
+    "lang4", "lao1", "lao2", "lao3", "lao4", "le4", "le5", "lei2", "lei3", "lei4",
+    "lei5", "leng2", "leng3", "leng4", "li1", "li2", "li3", "li4", "lia3", "lian2",
+    "lian3", "lian4", "liang2", "liang3", "liang4", "liao1", "liao2", "liao3", "liao4", "lie1",
+    "lie3", "lie4", "lin2", "lin3", "lin4", "ling1", "ling2", "ling3", "ling4", "liu1",
+    "liu2", "liu3", "liu4", "long2", "long3", "long4", "lou1", "lou2", "lou3", "lou4",
+    "lou5", "lu1", "lu2", "lu3", "lu4", "luan2", "luan3", "luan4", "lun1", "lun2",
+    "lun3", "lun4", "luo1", "luo2", "luo3", "luo4", "lv2", "lv3", "lv4", "lve4",
+    "ma1", "ma2", "ma3", "ma4", "ma5", "mai2", "mai3", "mai4", "man2", "man3",
+    "man4", "mang2", "mang3", "mao1", "mao2", "mao3", "mao4", "me5", "mei2", "mei3",
+    "mei4", "men2", "men3", "men4", "men5", "meng2", "meng3", "meng4", "mi1", "mi2",
+    "mi3", "mi4", "mian2", "mian3", "mian4", "miao1", "miao2", "miao3", "miao4", "mie1",
+    "mie4", "min2", "min3", "ming2", "ming3", "ming4", "miu4", "mo1", "mo2", "mo3",
+    "mo4", "mo5", "mou1", "mou2", "mou3", "mou4", "mu2", "mu3", "mu4", "n3",
+    "na2", "na3", "na4", "nai2", "nai3", "nai4", "nan1", "nan2", "nan3", "nan4",
+    "nang1", "nang2", "nang3", "nang4", "nao2", "nao3", "nao4", "ne4", "ne5", "nei3",
+    "nei4", "nen1", "nen3", "nen4", "neng2", "neng4", "ng4", "ni1", "ni2", "ni3",
+    "ni4", "nian2", "nian3", "nian4", "niang2", "niang4", "niao3", "niao4", "nie1", "nie2",
+    "nie4", "nin2", "nin3", "ning2", "ning3", "ning4", "niu1", "niu2", "niu3", "niu4",
+    "nong2", "nong3", "nong4", "nou2", "nou4", "nu2", "nu3", "nu4", "nuan3", "nuan4",
+    "nuo2", "nuo3", "nuo4", "nv3", "nv4", "nve4", "o1", "ou1", "ou2", "ou3",
+    "ou4", "pa1", "pa2", "pa4", "pai1", "pai2", "pai3", "pai4", "pan1", "pan2",
+    "pan3", "pan4", "pang1", "pang2", "pang3", "pang4", "pao1", "pao2", "pao3", "pao4",
+    "pei1", "pei2", "pei3", "pei4", "pen1", "pen2", "pen3", "peng1", "peng2", "peng3",
+    "peng4", "pi1", "pi2", "pi3", "pi4", "pian1", "pian2", "pian3", "pian4", "piao1",
+    "piao2", "piao3", "piao4", "pie1", "pie3", "pie4", "pin1", "pin2", "pin3", "pin4",
+    "ping1", "ping2", "po1", "po2", "po3", "po4", "pou1", "pou2", "pou3", "pou4",
+    "pu1", "pu2", "pu3", "pu4", "qi1", "qi2", "qi3", "qi4", "qia1", "qia2",
+    "qia3", "qia4", "qian1", "qian2", "qian3", "qian4", "qiang1", "qiang2", "qiang3", "qiang4",
+    "qiao1", "qiao2", "qiao3", "qiao4", "qie1", "qie2", "qie3", "qie4", "qin1", "qin2",
+    "qin3", "qin4", "qing1", "qing2", "qing3", "qing4", "qiong1", "qiong2", "qiong3", "qiu1",
+    "qiu2", "qiu3", "qiu4", "qu1", "qu2", "qu3", "qu4", "quan1", "quan2", "quan3",
+    "quan4", "que1", "que2", "que4", "qun1", "qun2", "qun3", "ran2", "ran3", "rang2",
+    "rang3", "rang4", "rao2", "rao3", "rao4", "re3", "re4", "ren2", "ren3", "ren4",
+    "reng1", "reng2", "reng4", "ri4", "rong2", "rong3", "rong4", "rou2", "rou3", "rou4",
+    "ru2", "ru3", "ru4", "ruan2", "ruan3", "rui2", "rui3", "rui4", "run2", "run4",
+    "ruo4", "sa1", "sa3", "sa4", "sai1", "sai3", "sai4", "sai5", "san1", "san3",
+    "san4", "sang1", "sang3", "sao1", "sao3", "sao4", "se4", "sen1", "seng1", "sha1",
+    "sha3", "sha4", "shai1", "shai3", "shai4", "shan1", "shan3", "shan4", "shang1", "shang3",
+    "shang4", "shao1", "shao2", "shao3", "shao4", "she1", "she2", "she3", "she4", "shen1",
+    "shen2", "shen3", "shen4", "sheng1", "sheng2", "sheng3", "sheng4", "shi1", "shi2", "shi3",
+    "shi4", "shi5", "shou1", "shou3", "shou4", "shu1", "shu2", "shu3", "shu4", "shua1",
+    "shua3", "shua4", "shuai1", "shuai3", "shuai4", "shuan1", "shuan4", "shuang1", "shuang3", "shuang4",
+    "shui2", "shui3", "shui4", "shun3", "shun4", "shuo1", "shuo4", "si1", "si3", "si4",
+    "song1", "song3", "song4", "sou1", "sou3", "sou4", "su1", "su2", "su4", "suan1",
+    "suan3", "suan4", "sui1", "sui2", "sui3", "sui4", "sun1", "sun3", "sun4", "suo1",
+    "suo3", "suo4", "ta1", "ta3", "ta4", "tai1", "tai2", "tai4", "tan1", "tan2",
+    "tan3", "tan4", "tang1", "tang2", "tang3", "tang4", "tao1", "tao2", "tao3", "tao4",
+    "te4", "teng1", "teng2", "ti1", "ti2", "ti3", "ti4", "tian1", "tian2", "tian3",
+    "tian4", "tian5", "tiao1", "tiao2", "tiao3", "tiao4", "tie1", "tie3", "tie4", "ting1",
+    "ting2", "ting3", "tong1", "tong2", "tong3", "tong4", "tou1", "tou2", "tou3", "tou4",
+    "tu1", "tu2", "tu3", "tu4", "tuan1", "tuan2", "tuan3", "tuan4", "tui1", "tui2",
+    "tui3", "tui4", "tun1", "tun2", "tun3", "tun4", "tuo1", "tuo2", "tuo3", "tuo4",
+    "wa1", "wa2", "wa3", "wa4", "wai1", "wai4", "wan1", "wan2", "wan3", "wan4",
+    "wang1", "wang2", "wang3", "wang4", "wei1", "wei2", "wei3", "wei4", "wen1", "wen2",
+    "wen3", "wen4", "weng1", "weng3", "weng4", "wo1", "wo3", "wo4", "wu1", "wu2",
+    "wu3", "wu4", "xi1", "xi2", "xi3", "xi4", "xia1", "xia2", "xia3", "xia4",
+    "xian1", "xian2", "xian3", "xian4", "xiang1", "xiang2", "xiang3", "xiang4", "xiao1", "xiao2",
+    "xiao3", "xiao4", "xie1", "xie2", "xie3", "xie4", "xin1", "xin2", "xin3", "xin4",
+    "xing1", "xing2", "xing3", "xing4", "xiong1", "xiong2", "xiong4", "xiu1", "xiu3", "xiu4",
+    "xu1", "xu2", "xu3", "xu4", "xuan1", "xuan2", "xuan3", "xuan4", "xue1", "xue2",
+    "xue3", "xue4", "xun1", "xun2", "xun4", "ya1", "ya2", "ya3", "ya4", "yai2",
+    "yan1", "yan2", "yan3", "yan4", "yang1", "yang2", "yang3", "yang4", "yao1", "yao2",
+    "yao3", "yao4", "ye1", "ye2", "ye3", "ye4", "yi1", "yi2", "yi3", "yi4",
+    "yin1", "yin2", "yin3", "yin4", "ying1", "ying2", "ying3", "ying4", "yo1", "yo5",
+    "yong1", "yong2", "yong3", "yong4", "you1", "you2", "you3", "you4", "yu1", "yu2",
+    "yu3", "yu4", "yuan1", "yuan2", "yuan3", "yuan4", "yue1", "yue3", "yue4", "yun1",
+    "yun2", "yun3", "yun4", "za1", "za2", "za3", "zai1", "zai3", "zai4", "zan1",
+    "zan2", "zan3", "zan4", "zang1", "zang3", "zang4", "zao1", "zao2", "zao3", "zao4",
+    "ze2", "ze4", "zei2", "zen3", "zen4", "zeng1", "zeng3", "zeng4", "zha1", "zha2",
+    "zha3", "zha4", "zhai1", "zhai2", "zhai3", "zhai4", "zhan1", "zhan2", "zhan3", "zhan4",
+    "zhang1", "zhang3", "zhang4", "zhao1", "zhao2", "zhao3", "zhao4", "zhe1", "zhe2", "zhe3",
+    "zhe4", "zhen1", "zhen3", "zhen4", "zheng1", "zheng3", "zheng4", "zhi1", "zhi2", "zhi3",
+    "zhi4", "zhong1", "zhong3", "zhong4", "zhou1", "zhou2", "zhou3", "zhou4", "zhu1", "zhu2",
+    "zhu3", "zhu4", "zhua1", "zhua3", "zhuai3", "zhuan1", "zhuan3", "zhuan4", "zhuang1", "zhuang4",
+    "zhui1", "zhui3", "zhui4", "zhun1", "zhun3", "zhun4", "zhuo1", "zhuo2", "zhuo3", "zhuo4",
+    "zi1", "zi3", "zi4", "zong1", "zong3", "zong4", "zou1", "zou3", "zou4", "zu1",
+    "zu2", "zu3", "zuan1", "zuan3", "zuan4", "zui1", "zui3", "zui4", "zun1", "zun3",
+    "zun4", "zuo1", "zuo2", "zuo3", "zuo4",
+};
+
+constexpr unsigned short kFirst0 = 0x3400;
+constexpr unsigned short kLast0 = 0x9fc3;
+
+constexpr unsigned short kRange0[] = {
+    849, 1029, kNoPinyin, kNoPinyin, 516, 1100, 1182, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, 979, kNoPinyin, kNoPinyin, kNoPinyin,
+    kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, 1175, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, 140, kNoPinyin, kNoPinyin, kNoPinyin,
+    kNoPinyin, 742, kNoPinyin, kNoPinyin, 850, kNoPinyin, kNoPinyin, kNoPinyin, 1143, 1131, kNoPinyin, 1134, 590, 583, 1114, 1190,
+    1129, 1262, 203, 1101, 758, kNoPinyin, kNoPinyin, 622, 825, 1179, 1273, 679, 130, kNoPinyin, kNoPinyin, kNoPinyin,
+    kNoPinyin, 1296, 281, 17, 1100, 1324, kNoPinyin, 1277, 240, 988, 1179, 462, 1080, 558, 695, 1281,
+    kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, 1142, kNoPinyin, kNoPinyin, kNoPinyin, 453, 231, 740, 988, 1179, 595, 1187, 46,
+    kNoPinyin, kNoPinyin, kNoPinyin, 544, 656, 1179, 567, 435, 1200, 613, 105, kNoPinyin, kNoPinyin, kNoPinyin, 425, 1142,
+    423, 873, kNoPinyin, 1277, kNoPinyin, 374, 1105, 1007, 5, 423, 480, 623, 619, 1013, 1119, 1033,
+    1240, 1200, 513, 270, 693, 816, 134, 678, 374, 1014, 916, kNoPinyin, 847, 557, 902, kNoPinyin,
+    kNoPinyin, 423, 811, 1004, 957, kNoPinyin, 749, 1006, kNoPinyin, 652, 1090, 229, 1199, 660, 480, 716,
+    1125, 1195, kNoPinyin, kNoPinyin, 938, kNoPinyin, 558, 567, kNoPinyin, 614, kNoPinyin, 435, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin,
+    858, kNoPinyin, 80, 573, 339, 636, kNoPinyin, 342, 995, kNoPinyin, kNoPinyin, 636, 628, kNoPinyin, 950, 565,
+    kNoPinyin, 1082, 510, 160, 1263, kNoPinyin, kNoPinyin, kNoPinyin, 66, 415, 240, 333, kNoPinyin, kNoPinyin, 569, 461,
+    604, 1133, kNoPinyin, 687, 1125, kNoPinyin, 51, 451, 988, kNoPinyin, kNoPinyin, kNoPinyin, 1197, 1131, 817, kNoPinyin,
+    226, 301, 615, 821, 451, kNoPinyin, kNoPinyin, 1162, 170, kNoPinyin, 549, kNoPinyin, kNoPinyin, 384, kNoPinyin, 565,
+    408, 1047, 788, kNoPinyin, 480, 264, 837, 1179, 475, 897, 442, kNoPinyin, 134, 136, 132, kNoPinyin,
+    619, kNoPinyin, 582, 475, 988, 1121, 109, kNoPinyin, kNoPinyin, 1279, 205, 442, 1277, 259, 1125, 567,
+    kNoPinyin, 134, 1103, 441, kNoPinyin, 433, kNoPinyin, 286, 146, 32, 509, kNoPinyin, 20, 573, 519, kNoPinyin,
+    384, kNoPinyin, 475, 557, 941, 782, 1166, 618, 40, 264, 603, kNoPinyin, kNoPinyin, 122, 740, 990,
+    391, 1200, kNoPinyin, 355, 1179, 1113, 333, 599, kNoPinyin, 555, 950, kNoPinyin, 997, 1171, 451, 1308,
+    kNoPinyin, 863, 1181, kNoPinyin, 1270, 438, 404, 537, 400, 500, kNoPinyin, 459, 6, kNoPinyin, 264, 144,
+    1124, 144, 1085, kNoPinyin, kNoPinyin, 415, 988, 1197, kNoPinyin, 480, 1255, 1143, 949, kNoPinyin, kNoPinyin, 530,
+    kNoPinyin, 384, 309, 1162, 850, 1178, 408, kNoPinyin, 278, 1252, 205, 281, 982, 18, 301, 700,
+    385, 1195, 406, kNoPinyin, 124, 361, 706, 408, 567, 272, 380, 808, kNoPinyin, 979, kNoPinyin, kNoPinyin,
+    555, 584, 1179, 399, kNoPinyin, 1143, 854, 268, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, 700,
+    1086, 1125, 1024, 394, 1064, 70, 720, 1181, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, 1074, 954,
+    22, 1175, 433, 1049, 372, 461, 239, 1090, 604, 984, 361, 586, kNoPinyin, 1029, 609, kNoPinyin,
+    kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, 1175, 948, 1149, 290, 165, 887, 259, 1230, 264, 1123,
+    kNoPinyin, 264, 945, 1090, 628, 402, 321, 1107, 630, 51, 433, 398, 1270, kNoPinyin, kNoPinyin, kNoPinyin,
+    kNoPinyin, 27, 6, kNoPinyin, kNoPinyin, 336, 206, 26, 68, 682, 567, 1121, 1139, kNoPinyin, kNoPinyin, kNoPinyin,
+    kNoPinyin, kNoPinyin, 240, 1026, 180, 535, 552, 1270, 5, 1102, kNoPinyin, 837, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin,
+    146, 433, 431, 1003, 1161, 1143, kNoPinyin, 905, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, 1175, 1116, kNoPinyin, 1109,
+    1324, 1179, 170, kNoPinyin, kNoPinyin, 1111, 1006, 884, 1176, 1270, 1179, 1111, 470, 433, 373, kNoPinyin,
+    769, 567, kNoPinyin, 544, 85, 373, 1161, kNoPinyin, kNoPinyin, 1161, 373, kNoPinyin, 133, 712, 431, kNoPinyin,
+    51, 1107, 1093, 1145, kNoPinyin, 1195, 839, 1143, 700, 51, 382, 458, 18, 18, kNoPinyin, kNoPinyin,
+    kNoPinyin, kNoPinyin, 468, kNoPinyin, 1324, 75, 451, 6, 1225, 170, 272, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, 720,
+    592, 632, 253, kNoPinyin, 51, 36, kNoPinyin, 146, 372, 1029, 113, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, 302,
+    259, 1200, 1174, 528, 372, 519, kNoPinyin, 519, kNoPinyin, 594, kNoPinyin, 74, 132, 1123, 720, 549,
+    1179, kNoPinyin, 628, 1252, 1109, 358, kNoPinyin, kNoPinyin, 435, 576, 1175, 433, 1181, kNoPinyin, 196, 1179,
+    1125, 382, 1192, 373, 111, 1006, 1013, 1268, 37, 645, 356, 109, 558, kNoPinyin, 1105, kNoPinyin,
+    kNoPinyin, 831, 869, 1210, kNoPinyin, 593, 302, kNoPinyin, kNoPinyin, 339, kNoPinyin, kNoPinyin, 408, 361, kNoPinyin, 318,
+    1019, kNoPinyin, 926, 541, 720, 300, 318, 835, 30, kNoPinyin, kNoPinyin, 1105, 1143, 528, 646, 168,
+    kNoPinyin, 434, 735, 1119, 1179, 1199, 1177, 1162, kNoPinyin, 868, 382, 921, kNoPinyin, 1195, kNoPinyin, 1127,
+    50, kNoPinyin, 225, kNoPinyin, 75, kNoPinyin, 979, 269, kNoPinyin, 635, 1212, kNoPinyin, kNoPinyin, 832, kNoPinyin, 767,
+    kNoPinyin, kNoPinyin, 741, 451, kNoPinyin, 270, 259, kNoPinyin, kNoPinyin, kNoPinyin, 259, kNoPinyin, kNoPinyin, 837, kNoPinyin, 750,
+    984, 86, 243, kNoPinyin, 778, 1179, kNoPinyin, 1324, 805, 837, 1044, 1129, 1195, 40, 595, kNoPinyin,
+    kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, 1004, 545, 629, 828, 1275, 1163, kNoPinyin, 604, kNoPinyin, 914, 653,
+    kNoPinyin, 897, 274, 103, 695, kNoPinyin, 140, kNoPinyin, 958, 786, kNoPinyin, 529, 921, kNoPinyin, 1111, 1270,
+    kNoPinyin, kNoPinyin, kNoPinyin, 571, 1153, 1143, 651, 423, 678, kNoPinyin, 765, 1179, 336, 1013, 815, 1210,
+    958, 300, 1179, 197, kNoPinyin, 569, 91, 85, 470, 604, 988, 703, 18, 9, 825, kNoPinyin,
+    kNoPinyin, kNoPinyin, kNoPinyin, 867, 941, 625, 374, 1208, 268, 18, 1112, 623, kNoPinyin, kNoPinyin, 546, kNoPinyin,
+    1208, 240, 1093, 410, 647, 716, 1078, 649, 720, 854, 1222, 571, 1268, 1301, 368, 1143,
+    382, 1153, 1270, 278, 164, 336, kNoPinyin, 164, 605, 1281, 953, 576, 451, 1124, 236, 453,
+    884, 631, kNoPinyin, 321, 1171, 723, 1177, 548, 1191, 1181, kNoPinyin, 988, kNoPinyin, 582, 1158, 634,
+    663, 1317, 1200, 1175, 336, 650, 480, 1090, kNoPinyin, kNoPinyin, 226, 593, kNoPinyin, 1132, 187, 831,
+    652, 647, 840, kNoPinyin, 1077, 213, 6, kNoPinyin, 54, 733, 569, 455, kNoPinyin, 160, 1323, 68,
+    kNoPinyin, 1171, 1060, 433, kNoPinyin, 362, 434, 1086, kNoPinyin, kNoPinyin, 1143, 712, 1212, kNoPinyin, 21, 1258,
+    467, 1086, 1105, 816, 1177, 1125, 172, 850, 1063, 717, 817, 434, kNoPinyin, kNoPinyin, kNoPinyin, 226,
+    552, 1248, kNoPinyin, kNoPinyin, 1181, 96, 434, 423, 1217, 544, 694, 470, 841, 203, kNoPinyin, 451,
+    1142, kNoPinyin, 1193, 242, 132, kNoPinyin, 662, 417, 995, 499, 1310, 382, 128, 1151, 708, 134,
+    569, 10, 133, kNoPinyin, 1115, 1165, 406, 193, 850, 552, 300, 253, 631, 548, 1068, 372,
+    632, 68, kNoPinyin, 815, 372, kNoPinyin, 595, kNoPinyin, 1033, 553, 815, 1222, 649, 771, 1249, 1117,
+    315, kNoPinyin, 815, kNoPinyin, 604, kNoPinyin, 1212, 264, 858, 661, 1086, 858, 957, 661, kNoPinyin, kNoPinyin,
+    664, 1170, 475, 567, 519, 315, 1203, 200, kNoPinyin, 552, 597, 825, 16, 56, kNoPinyin, 631,
+    211, kNoPinyin, 16, kNoPinyin, 1103, 300, kNoPinyin, 466, 899, 1043, 853, 264, kNoPinyin, 433, 433, 406,
+    449, 1317, 56, 645, 27, 1086, 435, 18, 1200, 380, 253, 1097, 710, 182, kNoPinyin, 565,
+    602, 716, 408, 543, kNoPinyin, 618, kNoPinyin, 649, 1201, kNoPinyin, 470, kNoPinyin, kNoPinyin, 1248, kNoPinyin, 1178,
+    kNoPinyin, 435, 50, kNoPinyin, 879, kNoPinyin, 276, 321, 513, 453, 656, kNoPinyin, kNoPinyin, 1043, kNoPinyin, 171,
+    51, 485, 567, kNoPinyin, 997, 741, kNoPinyin, 433, 641, 1111, 821, 264, 636, kNoPinyin, kNoPinyin, 1047,
+    kNoPinyin, 832, kNoPinyin, kNoPinyin, 1101, kNoPinyin, 156, 1024, 569, 51, kNoPinyin, 631, 1150, 294, 558, kNoPinyin,
+    1266, 144, 630, 593, kNoPinyin, 1182, kNoPinyin, 1266, 822, 605, 719, 1179, kNoPinyin, 435, 433, 1243,
+    1200, 465, 413, 220, kNoPinyin, 586, 435, 42, 1240, 172, 206, 578, 1179, 1256, 1113, 134,
+    172, 133, 1162, 548, 243, 595, 109, kNoPinyin, 1059, 101, 5, 133, kNoPinyin, 1185, 103, 1047,
+    kNoPinyin, 1059, 101, 1170, 1304, kNoPinyin, kNoPinyin, 833, 569, 839, 603, 1163, kNoPinyin, kNoPinyin, 1179, 110,
+    461, 444, kNoPinyin, 459, kNoPinyin, 240, kNoPinyin, 473, 374, 221, kNoPinyin, kNoPinyin, 394, kNoPinyin, 132, 661,
+    51, kNoPinyin, 1154, 602, kNoPinyin, 938, 51, kNoPinyin, 51, kNoPinyin, 1111, 1086, 61, 269, 473, kNoPinyin,
+    1263, 40, 1179, 1200, 854, 1222, 649, 709, 979, kNoPinyin, kNoPinyin, kNoPinyin, 927, 1006, 678, 459,
+    54, 884, 99, 86, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, 219, 1043, 1004, 1131, kNoPinyin, 258, 1105,
+    1043, kNoPinyin, 1024, 926, 442, 1270, kNoPinyin, 1183, kNoPinyin, kNoPinyin, 414, 1272, 817, kNoPinyin, kNoPinyin, 1125,
+    1125, 1230, 1085, kNoPinyin, kNoPinyin, 1004, 1246, 725, kNoPinyin, kNoPinyin, kNoPinyin, 1179, 878, 958, 103, 1297,
+    kNoPinyin, 653, 433, 280, 773, 6, 278, 17, 841, 821, 1121, kNoPinyin, kNoPinyin, 832, kNoPinyin, 1043,
+    kNoPinyin, 1197, kNoPinyin, 43, 300, 146, 1281, kNoPinyin, 146, kNoPinyin, 376, 721, 475, kNoPinyin, 103, 506,
+    581, 567, 1143, kNoPinyin, 1199, 370, 567, 398, 332, 500, 1205, 213, 423, kNoPinyin, 524, 461,
+    1221, 302, 837, 39, 1103, 170, 763, kNoPinyin, 1105, 850, 418, kNoPinyin, kNoPinyin, 140, 910, kNoPinyin,
+    213, 213, 1020, 643, 586, 954, 226, 84, 231, 122, 778, kNoPinyin, 468, 435, 541, 1029,
+    1205, kNoPinyin, 81, 816, 1199, 569, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, 1199, 433, 1087, 650, 187, 1123,
+    1142, 1105, 850, 423, kNoPinyin, 1199, 837, 974, 160, 259, 597, kNoPinyin, 763, 1007, 1277, 1182,
+    kNoPinyin, 285, 942, 1203, 1177, 427, 916, 1175, 662, 289, 384, kNoPinyin, 1182, 94, 710, 18,
+    292, 569, 113, 110, 621, 221, kNoPinyin, 604, kNoPinyin, 1179, 406, kNoPinyin, 1061, 264, 408, 997,
+    710, 570, 565, 1113, 1163, 593, 643, 442, kNoPinyin, kNoPinyin, 53, 1199, 431, 657, 140, 370,
+    kNoPinyin, 555, 451, 1087, 1179, 413, 385, 85, 544, 1182, 1125, kNoPinyin, 614, 586, 823, 431,
+    kNoPinyin, 1096, kNoPinyin, kNoPinyin, 321, kNoPinyin, 231, 1192, 434, 14, 891, 1103, 969, 1143, 1177, 404,
+    433, 856, 1028, kNoPinyin, 824, 678, kNoPinyin, 635, 1182, 309, 20, 1112, 636, 281, 1156, kNoPinyin,
+    981, 1085, 1149, kNoPinyin, 346, 466, 264, 1301, 187, 51, 1072, kNoPinyin, 581, kNoPinyin, kNoPinyin, 518,
+    kNoPinyin, 370, kNoPinyin, 1281, 138, 1112, 1147, kNoPinyin, 850, 773, 355, 268, 332, 847, kNoPinyin, 553,
+    567, 126, 909, 68, 1096, 807, kNoPinyin, 260, kNoPinyin, 1020, 1004, 1269, 57, 340, kNoPinyin, kNoPinyin,
+    65, 1268, 239, 128, 1256, 700, 583, 803, 434, 662, 1086, 121, 336, kNoPinyin, 890, kNoPinyin,
+    74, kNoPinyin, 528, 552, 374, 1185, 1270, 451, 1132, 1123, 1153, 926, 823, 1125, 988, 368,
+    651, 425, kNoPinyin, kNoPinyin, 423, 682, 981, 43, 592, 451, 419, 545, kNoPinyin, 404, 241, 431,
+    321, 1169, 94, 355, 442, 441, 140, 456, 623, 423, 641, 84, 619, 783, 1167, 470,
+    470, 863, kNoPinyin, kNoPinyin, 922, kNoPinyin, 466, 408, 1113, 1123, kNoPinyin, 988, 286, 94, 1175, kNoPinyin,
+    kNoPinyin, kNoPinyin, 839, 422, 1063, kNoPinyin, 827, 1103, 1178, kNoPinyin, 645, 1055, 545, 380, 172, 1245,
+    791, 614, 649, kNoPinyin, kNoPinyin, kNoPinyin, 1123, 68, 423, 816, 1123, kNoPinyin, kNoPinyin, 68, 823, 29,
+    448, 475, 532, 981, 468, 264, 720, kNoPinyin, 231, 231, kNoPinyin, 355, kNoPinyin, 815, 160, kNoPinyin,
+    1199, 839, kNoPinyin, 499, 300, kNoPinyin, 220, 1113, 356, 384, 865, 374, 1044, 68, 926, 50,
+    604, 1175, 708, 148, 910, 229, 604, 1048, 570, 499, 910, 1262, 149, 571, 636, kNoPinyin,
+    825, 499, 933, 833, 51, kNoPinyin, 1183, kNoPinyin, 927, 988, 903, 897, 1297, 602, 586, 101,
+    kNoPinyin, 415, kNoPinyin, kNoPinyin, 437, 30, 402, 242, kNoPinyin, 598, kNoPinyin, 473, 499, 1000, 321, 1258,
+    235, 250, 1281, 1162, 763, 101, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, 1178, kNoPinyin, kNoPinyin, 1195, 358, 1170,
+    1170, 948, 332, 816, 327, kNoPinyin, kNoPinyin, 400, 651, 300, 401, 352, 206, kNoPinyin, kNoPinyin, 1161,
+    kNoPinyin, kNoPinyin, 856, kNoPinyin, 114, 664, kNoPinyin, 37, kNoPinyin, kNoPinyin, kNoPinyin, 1112, kNoPinyin, kNoPinyin, kNoPinyin, 636,
+    549, 688, 773, 124, kNoPinyin, kNoPinyin, 176, kNoPinyin, 837, 203, kNoPinyin, 533, 231, 604, kNoPinyin, kNoPinyin,
+    kNoPinyin, kNoPinyin, 1199, 1006, 111, 630, 652, 415, kNoPinyin, 738, 414, 398, 459, 68, 1112, 567,
+    455, kNoPinyin, 632, 792, 380, 1165, kNoPinyin, 1113, 988, 1086, 122, kNoPinyin, 456, 98, 385, kNoPinyin,
+    924, 586, kNoPinyin, 253, kNoPinyin, 813, 1208, 68, kNoPinyin, 423, 231, 1163, 470, 449, 519, 581,
+    1199, 1026, kNoPinyin, 1100, 395, 1119, 382, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, 418, 302, kNoPinyin, kNoPinyin, 256,
+    kNoPinyin, 881, 448, kNoPinyin, 1129, kNoPinyin, kNoPinyin, 1205, 475, 406, kNoPinyin, 33, 673, kNoPinyin, kNoPinyin, 1086,
+    kNoPinyin, 640, 979, 54, 602, kNoPinyin, kNoPinyin, kNoPinyin, 384, 936, 617, 757, 884, 850, 581, 332,
+    1112, 1105, kNoPinyin, kNoPinyin, 716, kNoPinyin, kNoPinyin, kNoPinyin, 1123, 559, kNoPinyin, 182, 1297, 286, 1324, 231,
+    435, 384, 433, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, 1051, 1111, 1162, 1013, 1004, 220, 475, 12,
+    372, 1169, 468, 895, 32, kNoPinyin, 720, 1030, 685, kNoPinyin, kNoPinyin, 1196, 652, kNoPinyin, kNoPinyin, 685,
+    1132, 817, kNoPinyin, 327, 1043, 268, 437, 839, 636, 264, 567, 132, kNoPinyin, 384, 451, 433,
+    kNoPinyin, 349, 398, 309, kNoPinyin, 290, 916, kNoPinyin, 433, kNoPinyin, 847, 384, kNoPinyin, 1111, 451, 406,
+    49, kNoPinyin, kNoPinyin, 1263, kNoPinyin, kNoPinyin, 950, kNoPinyin, 982, 1269, 42, kNoPinyin, kNoPinyin, kNoPinyin, 549, 51,
+    1112, 33, 203, kNoPinyin, kNoPinyin, 782, 110, 51, 988, 431, 387, 1186, 152, 444, 703, 339,
+    281, kNoPinyin, kNoPinyin, 1004, 187, kNoPinyin, 213, 868, 521, 122, 197, 402, 187, 604, 473, 604,
+    825, 769, 1263, kNoPinyin, 567, 91, 815, kNoPinyin, kNoPinyin, 1026, 586, 854, 570, 603, 957, 333,
+    1258, 56, 456, 843, kNoPinyin, kNoPinyin, 1303, 811, 455, 56, 442, 358, kNoPinyin, kNoPinyin, kNoPinyin, 581,
+    565, 614, 941, 652, 442, 219, 40, kNoPinyin, 570, kNoPinyin, 1153, 797, 863, 593, 1317, kNoPinyin,
+    475, kNoPinyin, 936, kNoPinyin, 1125, kNoPinyin, 545, 180, 1177, 740, 565, 1208, kNoPinyin, 1178, kNoPinyin, 435,
+    493, 1125, kNoPinyin, 1302, 499, 423, 856, kNoPinyin, kNoPinyin, kNoPinyin, 1071, kNoPinyin, 1153, kNoPinyin, 942, 510,
+    837, 921, 1143, 1158, 803, 1310, 1196, 1302, 570, 456, 1107, 1178, 837, 650, 449, kNoPinyin,
+    133, 950, kNoPinyin, 1182, 670, 1179, kNoPinyin, 916, 456, 1175, kNoPinyin, 863, 122, 605, kNoPinyin, 1266,
+    kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, 187, kNoPinyin, 10, 1138, 84, 153, 1239, kNoPinyin, 433, 68,
+    kNoPinyin, kNoPinyin, 548, 1060, kNoPinyin, 586, 264, 1097, 571, 245, 643, 546, 1086, 250, 519, 4,
+    1217, 423, 1179, 670, 1302, 43, 47, kNoPinyin, 51, 567, 602, 614, kNoPinyin, 206, kNoPinyin, 863,
+    124, kNoPinyin, 128, 466, 510, 435, 586, kNoPinyin, 932, 486, 897, 168, 705, kNoPinyin, 597, 36,
+    kNoPinyin, kNoPinyin, 37, 884, kNoPinyin, 559, kNoPinyin, kNoPinyin, 854, kNoPinyin, kNoPinyin, 1269, 1009, 885, 1310, 1186,
+    634, 685, 54, kNoPinyin, kNoPinyin, 1013, 374, 1229, 884, kNoPinyin, kNoPinyin, 811, kNoPinyin, 1010, kNoPinyin, 867,
+    723, 581, 231, 231, 1273, kNoPinyin, 618, 206, kNoPinyin, 355, 433, 710, 1179, 713, 1200, 1082,
+    363, 1231, 1161, 187, 1111, 448, 957, 302, 773, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, 75, 54, 133,
+    903, 1179, 54, kNoPinyin, 253, 544, kNoPinyin, 107, kNoPinyin, 1147, 1201, 1199, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin,
+    1004, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, 470, 1125, 1103, 441, kNoPinyin, 761, 1004, 1145, 1111, 717, kNoPinyin,
+    kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, 651, 435, 336, 1090, kNoPinyin, 1082, 1195, 1230, 51, 650, kNoPinyin, 1125,
+    278, 1179, kNoPinyin, 559, 1185, kNoPinyin, 456, 938, 1183, 434, kNoPinyin, 988, kNoPinyin, kNoPinyin, kNoPinyin, 1082,
+    654, 988, 1179, 1217, 916, 433, 615, kNoPinyin, 636, 1239, 995, 1270, 54, 565, kNoPinyin, kNoPinyin,
+    kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, 833, 349, kNoPinyin, 1263, kNoPinyin, 720, 480, 1125, 1170, 1125, kNoPinyin,
+    704, kNoPinyin, kNoPinyin, 594, 124, 651, 863, kNoPinyin, 682, kNoPinyin, kNoPinyin, kNoPinyin, 988, 1125, 68, 235,
+    183, kNoPinyin, 157, 122, 374, 206, 382, kNoPinyin, kNoPinyin, kNoPinyin, 941, 651, 111, 643, 373, 186,
+    475, 385, 286, 948, 121, 942, 744, 302, 630, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, 1179, 140, kNoPinyin,
+    kNoPinyin, 35, 557, 499, 226, 51, 993, 321, 51, 1179, 1111, 709, 1185, 1280, 164, 292,
+    1143, 791, 1100, 576, 88, 1308, kNoPinyin, 54, 1171, 413, 755, 985, kNoPinyin, 253, 459, 1103,
+    kNoPinyin, 361, kNoPinyin, kNoPinyin, 1161, 1149, 144, 391, 1185, kNoPinyin, kNoPinyin, kNoPinyin, 569, 1112, 413, kNoPinyin,
+    kNoPinyin, 571, 926, 88, 40, 441, 958, 278, 226, kNoPinyin, 22, 1199, kNoPinyin, kNoPinyin, 692, 558,
+    1179, 203, kNoPinyin, 109, 118, kNoPinyin, 456, 703, kNoPinyin, kNoPinyin, kNoPinyin, 577, 638, 466, kNoPinyin, 592,
+    372, kNoPinyin, 1193, 456, 133, 879, 730, kNoPinyin, kNoPinyin, 396, 1030, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, 68,
+    847, kNoPinyin, 958, 186, 423, 118, 243, 346, 264, 1087, 288, 1009, kNoPinyin, 609, 385, 1192,
+    422, kNoPinyin, 1199, 1304, 1163, 850, 1256, 461, 1006, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, 1061,
+    582, 461, 1240, kNoPinyin, 385, kNoPinyin, 1143, kNoPinyin, kNoPinyin, kNoPinyin, 187, 844, 670, kNoPinyin, kNoPinyin, 47,
+    565, kNoPinyin, kNoPinyin, 1163, 321, 670, 40, 472, 231, 934, kNoPinyin, 1099, 1163, kNoPinyin, 475, kNoPinyin,
+    1006, 373, kNoPinyin, 225, 435, 451, kNoPinyin, kNoPinyin, kNoPinyin, 1125, 539, 276, 431, 1105, 720, 649,
+    867, 183, 1181, 651, kNoPinyin, 475, kNoPinyin, 1043, 1079, kNoPinyin, 566, 932, 507, 488, 29, kNoPinyin,
+    1034, kNoPinyin, 40, 1175, 788, 109, 404, 502, kNoPinyin, 10, 164, 823, 40, kNoPinyin, 288, kNoPinyin,
+    1067, 1067, 1322, 586, kNoPinyin, 355, kNoPinyin, 950, 399, 581, kNoPinyin, 979, kNoPinyin, 40, 879, 245,
+    68, 572, 172, 51, 435, 1304, kNoPinyin, 384, 565, 1203, 1208, kNoPinyin, 110, 219, 557, 455,
+    136, 979, 812, 1179, kNoPinyin, kNoPinyin, 415, 1017, 890, 1185, 1185, 872, 1181, 950, 1181, 475,
+    1063, 1145, kNoPinyin, kNoPinyin, 837, 1281, kNoPinyin, kNoPinyin, 1197, kNoPinyin, kNoPinyin, 1105, 949, 1179, 670, kNoPinyin,
+    kNoPinyin, 402, 1121, 1099, kNoPinyin, 459, 1040, 949, 708, kNoPinyin, 1004, kNoPinyin, 145, 110, 791, 228,
+    694, 695, 312, 335, 1200, 398, kNoPinyin, kNoPinyin, kNoPinyin, 404, 1167, kNoPinyin, 1113, kNoPinyin, 884, 597,
+    1255, 84, 578, 792, 370, 276, 373, 206, 1249, kNoPinyin, 1003, 1281, 29, 442, 1199, 1297,
+    1197, 567, kNoPinyin, kNoPinyin, kNoPinyin, 109, 569, kNoPinyin, kNoPinyin, 466, 811, 850, 332, 1301, 1199, kNoPinyin,
+    kNoPinyin, 881, 728, 638, kNoPinyin, 464, kNoPinyin, 1143, 801, 54, 636, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, 1177,
+    1195, kNoPinyin, 801, kNoPinyin, 36, 423, kNoPinyin, kNoPinyin, kNoPinyin, 75, 631, 539, 1051, 1099, 567, 586,
+    kNoPinyin, 435, 480, kNoPinyin, 259, 475, 203, 40, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, 539, 54, 993,
+    1051, 231, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, 260, kNoPinyin, kNoPinyin, 995, 51, 1051, 916, 86, 1051,
+    653, kNoPinyin, 617, kNoPinyin, kNoPinyin, 1249, 50, 433, 96, kNoPinyin, 567, kNoPinyin, kNoPinyin, 995, kNoPinyin, 957,
+    kNoPinyin, kNoPinyin, 262, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, 847, 613, 1183, 1063, 339, 1200, 558, 40, 699,
+    786, 571, 851, 569, kNoPinyin, kNoPinyin, 567, 235, 1072, 1277, kNoPinyin, 1131, 14, 278, 780, 25,
+    1067, kNoPinyin, 263, 26, 817, 144, 332, 1043, 372, 128, 437, 415, 1133, 226, 625, 240,
+    262, 894, 581, 945, 749, 221, 1199, 152, 884, kNoPinyin, 1013, 174, 790, 968, 604, 1043,
+    1266, 567, 903, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, 346, 1179, 373, 1125, 613, 592, kNoPinyin, 205, kNoPinyin,
+    kNoPinyin, 1009, kNoPinyin, kNoPinyin, kNoPinyin, 1195, 687, kNoPinyin, 315, 480, 134, 510, 1078, 567, 590, 581,
+    1107, kNoPinyin, 9, 1201, 468, 887, 1153, kNoPinyin, 193, 86, 1236, 1192, 302, 894, kNoPinyin, 1103,
+    958, 448, 448, 374, 1252, kNoPinyin, kNoPinyin, 972, 124, 278, 433, kNoPinyin, kNoPinyin, 340, 1101, kNoPinyin,
+    837, 958, kNoPinyin, 1067, 245, 979, 867, 678, 302, 586, 433, 1139, 1146, 683, kNoPinyin, 453,
+    567, 197, 435, kNoPinyin, 617, 941, 566, 549, 329, 1182, kNoPinyin, 840, 837, 122, 1196, 75,
+    417, 863, 543, kNoPinyin, kNoPinyin, 1143, 33, 500, 816, kNoPinyin, 945, kNoPinyin, kNoPinyin, 1277, 417, 1059,
+    402, 40, kNoPinyin, kNoPinyin, kNoPinyin, 435, 339, kNoPinyin, 318, 105, 623, 1281, 1060, 1059, 569, 548,
+    kNoPinyin, kNoPinyin, kNoPinyin, 203, 6, 1112, kNoPinyin, 1103, kNoPinyin, 1059, 85, 915, kNoPinyin, 453, 290, 865,
+    kNoPinyin, 1171, 211, 437, 558, 1161, 602, 1059, 1185, 784, 615, 565, 60, kNoPinyin, 636, 25,
+    kNoPinyin, kNoPinyin, 1171, 384, 165, 402, 725, 140, 567, 1014, 413, 51, kNoPinyin, 122, 1167, 197,
+    16, 1149, kNoPinyin, kNoPinyin, kNoPinyin, 868, kNoPinyin, 1229, 1078, 1004, 35, kNoPinyin, 1161, kNoPinyin, 1281, 1157,
+    276, 1197, kNoPinyin, 1059, 645, 938, 456, 339, 817, 831, 448, 1161, kNoPinyin, 489, 653, 1113,
+    909, 682, kNoPinyin, 415, 727, 130, kNoPinyin, 475, 1103, 817, 12, 640, 339, kNoPinyin, kNoPinyin, 276,
+    854, 111, 974, 51, 636, 976, 339, 395, 415, 615, 376, 437, 858, kNoPinyin, 631, 74,
+    339, kNoPinyin, 678, 6, 1186, 974, 549, 451, 221, 451, kNoPinyin, 799, 879, 1161, 246, 221,
+    kNoPinyin, 549, 1113, kNoPinyin, 1133, 40, 9, 651, 817, 817, 1097, 936, 1201, 439, 128, 1170,
+    1187, 1165, 433, 453, 374, 661, 596, 485, 1170, 1162, 997, 355, 418, 1185, 945, 101,
+    569, kNoPinyin, 1145, 152, 122, 710, 856, 656, 431, 1199, 688, 402, 98, kNoPinyin, 823, 938,
+    444, 18, 625, 632, 1248, 53, 448, 475, 730, 51, 950, 567, 670, 581, 660, 670,
+    1102, 109, 854, 449, 431, kNoPinyin, 1143, 691, 1043, 398, 1201, kNoPinyin, kNoPinyin, 68, 1313, kNoPinyin,
+    168, kNoPinyin, 451, kNoPinyin, 1133, 423, 948, kNoPinyin, kNoPinyin, kNoPinyin, 1169, 1199, 33, 451, 1260, kNoPinyin,
+    936, 220, 239, 170, 302, 661, 1262, 1262, kNoPinyin, 1163, 229, 394, 332, kNoPinyin, 619, 346,
+    539, 187, 273, 194, 1161, kNoPinyin, 451, kNoPinyin, 361, 1000, 1078, 1266, 720, 229, 542, 1004,
+    187, kNoPinyin, 358, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, 652, kNoPinyin, 661, 469, 1199, kNoPinyin, 1256, 1230, kNoPinyin,
+    kNoPinyin, 759, 384, 336, 394, 552, 1101, 168, kNoPinyin, 604, 180, 569, kNoPinyin, 833, 956, kNoPinyin,
+    kNoPinyin, 96, kNoPinyin, 422, 988, 156, kNoPinyin, 593, kNoPinyin, 694, 1009, 205, 1086, 312, 197, 567,
+    kNoPinyin, 1113, 759, 539, kNoPinyin, 716, 410, 1185, 1113, 546, 668, 22, kNoPinyin, 300, 50, kNoPinyin,
+    431, 1179, 592, kNoPinyin, kNoPinyin, 473, 429, 128, 243, 262, kNoPinyin, 1162, 1292, 247, 816, 1199,
+    860, 429, 720, 391, 469, 938, kNoPinyin, kNoPinyin, 778, 663, 91, 597, 565, 165, kNoPinyin, 187,
+    927, kNoPinyin, 815, kNoPinyin, 543, 586, 577, 881, 1199, 694, 168, 816, 1177, 711, kNoPinyin, 441,
+    1156, kNoPinyin, 160, kNoPinyin, kNoPinyin, kNoPinyin, 51, 206, 805, 711, 1270, 117, 1029, 1029, 889, 1179,
+    581, 10, 384, 847, 567, kNoPinyin, 1302, 988, 1205, 1158, 247, 1078, kNoPinyin, 240, 1196, 423,
+    441, 895, 631, 469, kNoPinyin, kNoPinyin, 9, 995, 541, 427, 828, kNoPinyin, 260, kNoPinyin, 682, 85,
+    1024, 1142, 466, 417, 817, 451, 634, 1163, kNoPinyin, 1269, 1059, kNoPinyin, 6, 763, 89, 1013,
+    266, 427, 815, 144, 1000, 1297, 734, 1051, 1310, 597, 657, 565, 628, 339, 96, 406,
+    639, kNoPinyin, 569, 211, 927, 170, kNoPinyin, kNoPinyin, 1270, 22, 187, 849, kNoPinyin, 593, kNoPinyin, 286,
+    361, 128, 466, 264, kNoPinyin, 475, 394, 449, 182, 1169, 1043, 101, 1197, 958, 1170, 321,
+    415, 548, 475, 124, kNoPinyin, kNoPinyin, 942, kNoPinyin, 663, 663, kNoPinyin, 155, 1211, kNoPinyin, 456, 168,
+    kNoPinyin, 1010, kNoPinyin, 847, kNoPinyin, 128, kNoPinyin, 1201, 128, 1044, kNoPinyin, 833, kNoPinyin, 470, 544, 1179,
+    884, kNoPinyin, kNoPinyin, 979, kNoPinyin, 272, kNoPinyin, 645, 356, kNoPinyin, kNoPinyin, 370, 833, 168, 863, 253,
+    567, 22, 453, kNoPinyin, 615, kNoPinyin, 1211, kNoPinyin, 404, 1182, kNoPinyin, 1269, 570, kNoPinyin, 312, 442,
+    1277, 1281, 512, 682, 253, 1230, 1166, 1281, 333, 1179, kNoPinyin, kNoPinyin, 157, 553, 879, 884,
+    kNoPinyin, 682, 94, kNoPinyin, kNoPinyin, 1177, 475, 50, 128, 480, 140, 423, 134, 1270, 1161, kNoPinyin,
+    kNoPinyin, 609, 66, 1255, 372, 1201, 203, 1256, 284, 921, 586, 1004, kNoPinyin, 631, 1175, 35,
+    530, 342, 688, 321, kNoPinyin, 132, kNoPinyin, 1000, 170, 1277, 1006, 519, 841, kNoPinyin, 246, 94,
+    414, kNoPinyin, 905, 1266, 823, kNoPinyin, kNoPinyin, 1086, kNoPinyin, kNoPinyin, 1105, 682, 811, 410, 469, kNoPinyin,
+    kNoPinyin, kNoPinyin, 759, 1004, 825, kNoPinyin, 884, 615, 402, 984, kNoPinyin, 811, 660, kNoPinyin, 976, 627,
+    958, 586, 558, 444, 561, 1270, 228, kNoPinyin, 909, 402, 278, 640, 995, 441, 1013, 1125,
+    kNoPinyin, 668, 276, 557, kNoPinyin, 98, 586, kNoPinyin, 174, 1210, 645, 1201, 1270, 816, 205, 431,
+    1085, 1009, 916, 1125, 984, 981, kNoPinyin, 590, 1179, kNoPinyin, 559, 565, 286, 581, 584, 1113,
+    1169, kNoPinyin, 61, 1112, 869, 1287, kNoPinyin, 206, 54, 586, 394, 815, 578, 29, 651, 402,
+    402, kNoPinyin, 94, 773, 847, 663, 466, 75, 638, 909, 640, kNoPinyin, kNoPinyin, 565, 859, kNoPinyin,
+    267, 1116, kNoPinyin, 950, kNoPinyin, kNoPinyin, 545, 417, 466, 1161, kNoPinyin, 902, 1055, 1125, 1258, 641,
+    1105, 628, kNoPinyin, 417, 1009, 1121, 1156, 51, 613, 276, 567, 186, 103, 140, 219, 526,
+    145, kNoPinyin, 110, 649, 825, 850, 1263, kNoPinyin, kNoPinyin, kNoPinyin, 339, 1162, 133, 346, 678, 68,
+    516, 329, 1169, 636, 1082, kNoPinyin, kNoPinyin, kNoPinyin, 890, 475, kNoPinyin, 661, 444, kNoPinyin, 1249, 1324,
+    1208, 65, kNoPinyin, 1277, 51, 879, 1201, kNoPinyin, 168, 269, 1179, 649, 845, kNoPinyin, 1082, 435,
+    74, kNoPinyin, 61, 276, 1171, 565, 276, 854, 301, 268, kNoPinyin, kNoPinyin, kNoPinyin, 431, 456, 816,
+    468, 541, 121, 40, 729, 1179, 1143, 590, 1153, 300, kNoPinyin, 721, 1041, 46, 1240, kNoPinyin,
+    kNoPinyin, kNoPinyin, 750, 976, 329, 1013, 356, 423, 1004, kNoPinyin, 1169, kNoPinyin, 817, 374, 619, 651,
+    651, kNoPinyin, 604, 276, 750, 649, 451, 301, 649, 418, 988, 1169, 720, 456, 570, 51,
+    845, 1025, 586, 1313, 1269, 1182, 211, 140, 82, 651, 1161, 545, 136, kNoPinyin, kNoPinyin, 349,
+    938, 615, kNoPinyin, kNoPinyin, 615, 1279, kNoPinyin, 140, 473, 461, 269, 1179, 897, 81, 877, 300,
+    544, 995, 1199, 1169, 225, 586, 1281, 1004, 801, 823, 475, 160, 75, 339, 191, kNoPinyin,
+    373, 373, 674, 404, 394, 220, 300, 1147, 649, 638, 550, 340, 1256, 1004, 1201, 1305,
+    565, 578, 1099, 557, 434, 559, 565, kNoPinyin, 68, 13, 530, 1067, kNoPinyin, kNoPinyin, 1256, 355,
+    kNoPinyin, 1141, 683, 168, 260, kNoPinyin, 240, 356, 68, kNoPinyin, 413, 1146, 84, 567, 1059, 417,
+    1151, 402, 36, 868, 1033, 302, 578, kNoPinyin, 1179, 958, 805, 385, 180, kNoPinyin, 682, 10,
+    118, 604, 1248, 1004, kNoPinyin, kNoPinyin, kNoPinyin, 831, 988, kNoPinyin, 349, kNoPinyin, kNoPinyin, 144, kNoPinyin, 268,
+    268, 738, 816, 979, 144, kNoPinyin, 1162, 33, 10, kNoPinyin, 697, 158, 22, kNoPinyin, 1026, 374,
+    1322, 22, 1258, 1073, 946, 51, 270, 1281, 1101, 1089, 1269, 1276, 604, 1089, 358, 850,
+    539, 1217, 984, 652, 1270, 817, 91, 792, 569, kNoPinyin, 593, 988, 817, 1205, 292, kNoPinyin,
+    475, 221, 788, 348, 728, 878, 1263, 309, 783, 1010, 118, 165, kNoPinyin, 164, 670, 61,
+    817, 950, 50, 475, 979, kNoPinyin, 406, 680, 422, kNoPinyin, 270, kNoPinyin, 673, kNoPinyin, 1103, 1270,
+    878, 468, 231, 1260, 934, 646, 51, 374, 1199, 1113, kNoPinyin, 704, 84, 75, kNoPinyin, 816,
+    435, 716, 604, 461, 374, 1177, 81, 164, 1268, 1302, 197, kNoPinyin, 1029, 1277, kNoPinyin, 165,
+    kNoPinyin, 1258, kNoPinyin, 887, 63, 433, 1177, 246, 475, 321, 433, kNoPinyin, kNoPinyin, 1000, 900, 1117,
+    418, 815, 1281, 195, 132, 1093, kNoPinyin, 496, 339, 485, 278, kNoPinyin, 91, 1270, 110, 557,
+    kNoPinyin, kNoPinyin, 1258, 1199, 356, 417, 455, kNoPinyin, 361, 915, 1011, kNoPinyin, 1105, 628, 258, 16,
+    784, 1101, 5, 645, 784, 645, 1166, 1270, 68, 1185, 1085, 694, 544, 1163, 110, 858,
+    1262, 811, kNoPinyin, 1006, 286, 957, kNoPinyin, 209, 101, 867, 1028, 133, 1004, 438, 974, 417,
+    577, kNoPinyin, kNoPinyin, kNoPinyin, 456, 264, kNoPinyin, 300, 260, kNoPinyin, 264, kNoPinyin, 1171, 221, kNoPinyin, 221,
+    75, 628, 122, 609, 815, 678, 84, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, 1195, kNoPinyin, 197, kNoPinyin, 988,
+    300, 435, 444, 93, 68, 1022, 122, 302, 74, 1100, kNoPinyin, 1166, 665, 764, 632, kNoPinyin,
+    645, 92, 1033, 485, 27, 1120, 1129, 817, kNoPinyin, kNoPinyin, 933, 391, 727, 1119, 124, kNoPinyin,
+    277, 1182, 12, 868, 883, 274, 278, 856, 949, 384, 54, 203, 670, 216, kNoPinyin, kNoPinyin,
+    kNoPinyin, kNoPinyin, 103, 259, 1196, 382, kNoPinyin, kNoPinyin, 1111, 559, 455, 816, kNoPinyin, 638, kNoPinyin, kNoPinyin,
+    kNoPinyin, kNoPinyin, 1161, 1179, 1181, 815, 1258, 1105, 1179, 1173, 264, kNoPinyin, 1270, 373, 168, kNoPinyin,
+    164, 65, 518, 140, kNoPinyin, 1068, 847, kNoPinyin, 466, kNoPinyin, 179, 301, kNoPinyin, 645, 567, 581,
+    1004, kNoPinyin, 340, 573, kNoPinyin, 539, 225, 172, kNoPinyin, kNoPinyin, kNoPinyin, 435, kNoPinyin, 103, 636, 245,
+    kNoPinyin, 105, 897, 388, 893, kNoPinyin, 543, 1133, kNoPinyin, 1179, 639, kNoPinyin, 385, 435, kNoPinyin, 373,
+    kNoPinyin, 567, 1301, 1311, 1169, kNoPinyin, 565, 816, 312, 567, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, 988, 142,
+    kNoPinyin, 1123, 40, 1142, 459, 811, 586, 1115, 1324, 229, 164, 844, 687, kNoPinyin, 618, 132,
+    933, 1199, 406, 565, kNoPinyin, kNoPinyin, kNoPinyin, 565, kNoPinyin, kNoPinyin, 253, kNoPinyin, 1179, 725, kNoPinyin, 402,
+    300, kNoPinyin, 128, 688, 94, kNoPinyin, 1024, 839, 56, 995, 1085, kNoPinyin, 916, 6, 264, 453,
+    521, 285, kNoPinyin, 1183, kNoPinyin, 914, 243, 423, 1125, 1230, 1009, 114, 1270, 1179, 300, 262,
+    kNoPinyin, 480, kNoPinyin, 101, 1111, 630, kNoPinyin, 51, 586, 451, 530, 437, kNoPinyin, kNoPinyin, 550, kNoPinyin,
+    286, 603, 1240, 384, kNoPinyin, 709, 1185, 1121, 1022, 553, 1230, 528, kNoPinyin, 823, 468, 790,
+    30, 242, 583, 649, 1297, 1123, 404, 649, kNoPinyin, 1214, 174, 321, 687, 1279, 1161, 374,
+    kNoPinyin, 1179, 605, 1208, 867, 586, 715, 1201, 745, kNoPinyin, 1177, 745, 839, 823, 1107, 145,
+    456, 651, kNoPinyin, 682, 374, 1311, 1107, 1161, 1051, kNoPinyin, kNoPinyin, 1000, 1181, 136, 1276, 632,
+    1203, 744, 656, 915, 1078, 565, kNoPinyin, 682, 948, 51, 170, 33, kNoPinyin, 473, 1116, 356,
+    757, kNoPinyin, 1153, 1241, 1169, kNoPinyin, kNoPinyin, kNoPinyin, 262, 1165, 1033, 1195, 475, 565, kNoPinyin, 565,
+    kNoPinyin, 435, 403, 1249, 301, 113, 348, 468, 645, kNoPinyin, 128, 673, kNoPinyin, 566, kNoPinyin, kNoPinyin,
+    kNoPinyin, 1179, 66, kNoPinyin, 398, 1078, 134, kNoPinyin, 321, 372, 68, kNoPinyin, 590, 84, 84, 1179,
+    1145, 1161, 1000, 318, 1191, kNoPinyin, kNoPinyin, kNoPinyin, 1199, kNoPinyin, 1260, 621, kNoPinyin, kNoPinyin, 968, 456,
+    349, 811, 584, kNoPinyin, 1040, kNoPinyin, 539, 1179, kNoPinyin, 172, 1162, 451, kNoPinyin, 1087, 1112, 723,
+    302, 321, kNoPinyin, 670, 302, 683, 1112, 1089, 567, 84, 660, kNoPinyin, 710, 107, kNoPinyin, 1143,
+    744, 627, kNoPinyin, 489, kNoPinyin, 376, kNoPinyin, kNoPinyin, 1201, 1087, 1279, kNoPinyin, kNoPinyin, 1179, kNoPinyin, kNoPinyin,
+    300, 50, 1280, 1301, 958, 1107, 708, kNoPinyin, 448, 1147, kNoPinyin, 734, 884, 231, 903, kNoPinyin,
+    kNoPinyin, 1201, kNoPinyin, kNoPinyin, kNoPinyin, 604, 374, kNoPinyin, 1179, 1317, 1249, 988, 1078, 708, 348, 475,
+    46, 84, kNoPinyin, 260, 817, 1171, 356, 738, 398, 1153, 1125, kNoPinyin, 423, kNoPinyin, 1123, 68,
+    500, kNoPinyin, 1143, 26, kNoPinyin, 146, kNoPinyin, 1026, 145, 132, 716, 349, 292, 1125, kNoPinyin, 260,
+    475, 423, 1237, 903, 259, 586, 645, kNoPinyin, 362, 645, 593, kNoPinyin, 1187, kNoPinyin, 349, 180,
+    565, 245, kNoPinyin, 264, kNoPinyin, kNoPinyin, kNoPinyin, 213, 213, 444, 569, kNoPinyin, 934, 1105, kNoPinyin, 1087,
+    kNoPinyin, kNoPinyin, 385, 1195, 604, 541, 749, 945, 473, 817, kNoPinyin, 1212, kNoPinyin, 817, kNoPinyin, 563,
+    433, 625, 156, 712, kNoPinyin, 567, 586, kNoPinyin, 124, kNoPinyin, 1112, 402, kNoPinyin, 1310, 202, 202,
+    427, kNoPinyin, 122, 1024, kNoPinyin, 742, 1270, 590, 286, 448, kNoPinyin, 16, 582, kNoPinyin, 881, 1018,
+    783, 1129, 927, 1125, 1073, 1018, kNoPinyin, 1105, 1125, 783, 1169, 1169, 744, 382, 721, 1183,
+    277, 687, 132, 1083, 1204, 1107, 1277, 1204, 950, 651, kNoPinyin, 321, 767, 286, 404, 708,
+    170, 651, 54, kNoPinyin, 680, 1201, 264, 1269, 721, 1143, 619, 423, 1154, 694, 373, 437,
+    243, 408, kNoPinyin, kNoPinyin, 180, 1105, 982, 649, 1129, 1101, 847, 1266, 140, 1133, 466, 470,
+    425, 1024, 628, 441, 816, 954, 558, 1078, 122, 86, 453, 1197, 422, 1240, 988, 321,
+    695, 1105, kNoPinyin, kNoPinyin, 132, 1085, 670, 358, kNoPinyin, kNoPinyin, 1229, 423, 605, 576, 552, kNoPinyin,
+    kNoPinyin, 821, 18, 720, 993, 627, 1011, 1129, 458, 8, 1004, 109, 1087, 1056, 435, 124,
+    122, 1143, 1112, 1126, kNoPinyin, kNoPinyin, kNoPinyin, 695, kNoPinyin, 1163, 850, 394, 981, 480, 576, 468,
+    kNoPinyin, 629, 581, kNoPinyin, 146, 133, 1115, kNoPinyin, 639, 958, 94, 133, 338, 1199, kNoPinyin, kNoPinyin,
+    576, 552, 958, 1258, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, 264, kNoPinyin, 921, 1305, 475, 480, kNoPinyin, 597,
+    1085, kNoPinyin, 1281, 539, kNoPinyin, 1258, 1255, kNoPinyin, 1179, kNoPinyin, 708, kNoPinyin, kNoPinyin, 1178, 382, 1158,
+    413, 630, 630, 854, 553, 380, kNoPinyin, 641, 1111, 1263, 956, 1322, 1281, 336, 1147, 1179,
+    1024, kNoPinyin, 456, 84, kNoPinyin, 75, 572, 1270, 435, 1078, 349, kNoPinyin, 843, 6, 302, 356,
+    336, 1113, 894, 1270, 57, 1177, 1000, 231, 355, 946, 1154, 126, 936, 843, kNoPinyin, kNoPinyin,
+    165, 394, 240, 127, 1086, 231, 957, kNoPinyin, 433, 1214, 815, kNoPinyin, 302, 17, 300, 805,
+    kNoPinyin, 1010, 1241, 121, 854, 1197, 384, 400, 355, 264, 445, 1211, 1049, 851, kNoPinyin, 302,
+    1322, 402, kNoPinyin, 68, kNoPinyin, 476, 221, 475, 302, 417, kNoPinyin, 1192, 161, 1000, 132, kNoPinyin,
+    kNoPinyin, kNoPinyin, 628, 78, 817, 442, 51, kNoPinyin, 1268, 1279, 854, 1248, 433, 224, kNoPinyin, 567,
+    567, 538, 858, kNoPinyin, 302, 103, 1015, 950, 378, 837, 815, 68, 682, 1049, 144, 180,
+    1208, 221, 124, 146, 51, 631, 20, 1028, 661, 580, 293, kNoPinyin, 852, 1033, 300, 535,
+    441, kNoPinyin, kNoPinyin, kNoPinyin, 1263, 850, 195, 134, 528, 581, 32, 247, 1100, kNoPinyin, 476, 604,
+    114, kNoPinyin, 144, 573, 1029, 532, 113, 475, 1051, 408, 286, 50, kNoPinyin, 819, 1097, 435,
+    856, 529, 402, 180, 995, kNoPinyin, kNoPinyin, 852, 784, 40, 1073, 448, 884, kNoPinyin, 180, 231,
+    134, 193, 647, 1146, 259, 59, 1260, 144, 111, 356, 250, 1308, 217, 541, 1022, 1208,
+    858, 957, 586, kNoPinyin, 840, 302, 938, 1034, kNoPinyin, 4, kNoPinyin, 847, 229, 368, 926, 1075,
+    1248, 594, 466, 567, kNoPinyin, 662, 884, 1208, 475, 492, 276, 815, 394, 300, 602, 394,
+    1067, 661, 1028, 473, 816, 1265, 459, 332, 1028, 548, 636, 1183, 604, 1211, 468, 784,
+    kNoPinyin, 1123, 54, kNoPinyin, kNoPinyin, 884, 912, 1100, 103, 339, 109, 778, 630, kNoPinyin, kNoPinyin, 969,
+    504, 1286, 109, kNoPinyin, 156, 995, 40, 486, kNoPinyin, 1270, 1087, 661, 586, kNoPinyin, 700, 586,
+    817, 1208, kNoPinyin, 1179, 1104, 124, kNoPinyin, 885, 124, 730, 1195, 435, 68, 281, kNoPinyin, kNoPinyin,
+    179, 220, kNoPinyin, 1199, 321, 1143, 618, 384, kNoPinyin, 27, 333, 461, kNoPinyin, 1158, 737, 1195,
+    982, 1125, 89, 1169, 958, 1161, 964, 578, kNoPinyin, 1201, 68, 993, kNoPinyin, 1163, 559, 582,
+    1006, 245, 1208, 434, kNoPinyin, 1210, kNoPinyin, kNoPinyin, kNoPinyin, 469, kNoPinyin, 124, kNoPinyin, 1117, 1112, kNoPinyin,
+    355, 1200, 558, kNoPinyin, 1051, 124, 1131, 850, 378, kNoPinyin, 208, 81, 220, 1162, kNoPinyin, kNoPinyin,
+    kNoPinyin, 109, kNoPinyin, 565, 1000, 622, 622, kNoPinyin, 1013, 771, 597, kNoPinyin, 193, 1051, 264, 84,
+    451, 1024, 433, 208, 449, 50, 559, 1179, 164, 164, 805, 565, 1217, 1007, 805, 1029,
+    470, 1143, 278, kNoPinyin, 1143, 270, 429, kNoPinyin, 868, 272, kNoPinyin, kNoPinyin, 572, 1025, 651, kNoPinyin,
+    kNoPinyin, 96, 638, 1183, 653, 1051, 528, kNoPinyin, kNoPinyin, 651, 884, 361, kNoPinyin, 649, 468, 783,
+    455, 1083, 434, 645, 442, 1151, 37, 312, 110, 567, 566, 850, 256, 1187, 1211, 124,
+    432, 868, kNoPinyin, 619, kNoPinyin, 355, 1208, 423, 784, 101, 259, 109, kNoPinyin, 522, 938, 1131,
+    1093, 950, 134, 1175, 372, 286, 1175, 1161, 1314, kNoPinyin, 1182, 260, 1113, kNoPinyin, kNoPinyin, 837,
+    110, 372, 647, 1208, 180, 825, 455, 927, 677, kNoPinyin, kNoPinyin, kNoPinyin, 1266, 1270, 164, 1200,
+    673, 1079, 140, kNoPinyin, 988, 794, 1028, 521, 180, 995, kNoPinyin, 451, 442, 16, 448, 1175,
+    kNoPinyin, 1175, 593, 1227, 35, 569, kNoPinyin, 413, 618, 1085, 1112, 1037, 68, 1266, 1279, 22,
+    647, 1124, kNoPinyin, kNoPinyin, kNoPinyin, 1120, 567, 1239, 649, kNoPinyin, 1173, kNoPinyin, kNoPinyin, kNoPinyin, 1124, kNoPinyin,
+    kNoPinyin, kNoPinyin, 927, kNoPinyin, kNoPinyin, 927, 475, 435, 281, kNoPinyin, 716, 16, 146, 1101, 348, 1125,
+    1041, 1125, 209, kNoPinyin, 1010, kNoPinyin, 1107, 1143, 51, 979, 431, 1266, 1099, kNoPinyin, 899, 150,
+    949, 413, 535, 302, 150, 1111, 839, 835, 544, kNoPinyin, 1158, kNoPinyin, 863, kNoPinyin, 165, 1270,
+    kNoPinyin, 529, 825, 378, 1179, 709, 1266, 150, kNoPinyin, 948, kNoPinyin, 172, 475, 1143, 1211, kNoPinyin,
+    kNoPinyin, 146, 212, 226, 323, 1026, 394, 709, kNoPinyin, 566, kNoPinyin, 1112, kNoPinyin, 1105, 1147, kNoPinyin,
+    kNoPinyin, kNoPinyin, 541, kNoPinyin, 678, 128, 442, 51, 815, 586, 382, 33, 1013, 221, 302, 1113,
+    966, kNoPinyin, kNoPinyin, kNoPinyin, 811, 423, 1085, 1178, 1175, kNoPinyin, 122, 380, kNoPinyin, kNoPinyin, 1112, 109,
+    427, kNoPinyin, 374, 170, kNoPinyin, 815, 528, 887, kNoPinyin, kNoPinyin, 1135, kNoPinyin, 402, 186, kNoPinyin, 863,
+    219, 122, kNoPinyin, kNoPinyin, 1163, 576, 49, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, 745, 35, 1186, 394, 170,
+    821, 1024, 1201, 557, 35, kNoPinyin, 435, 300, 1113, 96, kNoPinyin, 916, kNoPinyin, kNoPinyin, 1200, kNoPinyin,
+    5, 372, 206, 321, 219, 404, 763, kNoPinyin, kNoPinyin, 586, 625, 627, 569, kNoPinyin, 1150, 1263,
+    805, 302, 733, 1105, 253, 206, 1211, 1113, 1182, kNoPinyin, 253, 47, 404, 285, 285, 823,
+    40, kNoPinyin, kNoPinyin, 950, 1029, 1248, 441, kNoPinyin, 423, 301, 1078, 669, 831, 577, kNoPinyin, 660,
+    321, 394, 1199, 815, 260, 12, kNoPinyin, 22, 221, 1147, 221, 51, 1277, 767, 711, 1177,
+    kNoPinyin, 437, 197, 259, 1105, 206, 1033, 1125, 115, 1204, 348, 573, 46, kNoPinyin, 604, 433,
+    1147, 958, kNoPinyin, 957, 402, 1212, 110, kNoPinyin, 884, 262, kNoPinyin, 22, 292, kNoPinyin, 1260, 288,
+    348, 74, 321, kNoPinyin, 417, 245, 1025, 68, 824, 539, 593, 1087, 1249, 544, kNoPinyin, 682,
+    51, 1067, 449, kNoPinyin, 74, 468, 805, 1107, 1086, 300, 385, 276, 111, 404, 1214, kNoPinyin,
+    kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, 276, 231, 394, 132, 35, 1181, kNoPinyin, kNoPinyin, 68, 894, 141, 1185,
+    kNoPinyin, 308, kNoPinyin, 1211, 1262, 1157, kNoPinyin, 400, 661, 771, 321, 54, kNoPinyin, 382, 649, 945,
+    326, 51, 259, 164, 147, 910, 128, 867, 1234, 636, 68, 1059, 783, 301, kNoPinyin, kNoPinyin,
+    582, kNoPinyin, 641, 1099, 817, 1270, 125, 1107, 384, 912, kNoPinyin, 398, kNoPinyin, 301, 872, 425,
+    771, 825, kNoPinyin, 1103, 663, 529, 321, kNoPinyin, 18, 909, 968, 597, 1262, 423, 84, kNoPinyin,
+    584, 680, 374, 245, 456, 652, 276, 264, 694, 394, 394, 1149, 1151, kNoPinyin, 51, kNoPinyin,
+    1196, 1177, 1151, 903, 1201, 567, 567, 1205, 253, 382, 837, 561, kNoPinyin, kNoPinyin, 361, 75,
+    1086, 1087, kNoPinyin, 10, 1143, 929, 391, 1165, kNoPinyin, 1169, kNoPinyin, 51, kNoPinyin, 391, 1017, 590,
+    kNoPinyin, 1281, kNoPinyin, 817, 117, 1179, 243, 1203, 180, kNoPinyin, 68, 85, 1166, kNoPinyin, 1177, 711,
+    934, 43, kNoPinyin, 29, 670, 6, 267, 937, kNoPinyin, 1270, 1167, 442, 1205, 253, 1024, 1086,
+    1154, 1270, 1179, 878, 950, 402, 697, 1179, 442, 994, 1186, 36, 402, 402, 1123, kNoPinyin,
+    1167, 569, kNoPinyin, 267, kNoPinyin, 442, 1281, 1186, 1163, 455, 156, 206, kNoPinyin, 519, 1179, 1175,
+    441, 267, 723, 170, 824, 1151, 68, 650, 972, 651, 572, 816, 816, 953, 51, 68,
+    46, 59, 709, 1087, 413, 276, 815, 590, 302, 12, 12, kNoPinyin, 815, 865, 1067, 1179,
+    68, 786, 68, kNoPinyin, 1145, kNoPinyin, kNoPinyin, 1201, 132, 602, 1177, 567, kNoPinyin, 716, 1105, 1099,
+    kNoPinyin, 559, kNoPinyin, 1256, 1316, 168, kNoPinyin, 10, 268, 1201, 563, 302, 921, 413, 146, 984,
+    kNoPinyin, 51, 231, kNoPinyin, 219, 567, kNoPinyin, 372, 1217, 338, 128, 597, 670, 651, 627, 18,
+    205, 1279, 417, 276, 217, 1043, kNoPinyin, 245, 402, 1087, 435, 134, 582, kNoPinyin, 763, 441,
+    720, 613, 433, kNoPinyin, kNoPinyin, 720, 1179, kNoPinyin, 1077, 1158, 821, 68, kNoPinyin, 586, 313, 429,
+    368, kNoPinyin, 391, 528, 96, kNoPinyin, 548, 51, 415, 805, 749, 441, 1026, 994, kNoPinyin, 253,
+    17, 441, 668, 356, 519, 10, 623, 844, 288, kNoPinyin, 495, 382, 259, kNoPinyin, 683, kNoPinyin,
+    453, 302, 752, kNoPinyin, 113, 720, 628, kNoPinyin, 172, kNoPinyin, 535, kNoPinyin, 219, 301, 1033, 1310,
+    1096, 286, 82, 778, 950, kNoPinyin, 887, 815, 102, 759, 68, 628, 1304, 172, 356, 435,
+    544, kNoPinyin, 645, 652, 759, 602, 182, kNoPinyin, 590, 1178, 1089, 567, 567, 1237, 1280, 425,
+    940, 134, 1133, 1082, kNoPinyin, 431, 783, kNoPinyin, 640, 121, 640, 117, 468, 734, kNoPinyin, 709,
+    890, 586, 1158, kNoPinyin, 817, kNoPinyin, kNoPinyin, 33, kNoPinyin, 1230, 453, 1199, 1127, 40, 22, 1067,
+    kNoPinyin, 831, 1196, 220, 453, 670, 944, 927, 815, 927, 650, 205, 1177, 330, 330, 1048,
+    kNoPinyin, 1149, 1179, 1040, 1033, 673, 590, kNoPinyin, 565, kNoPinyin, 604, 1143, 195, 22, 590, 470,
+    1249, 468, kNoPinyin, 1310, 1113, 1268, kNoPinyin, kNoPinyin, 1270, kNoPinyin, kNoPinyin, 539, kNoPinyin, 330, 262, 676,
+    1273, 221, 1161, kNoPinyin, 330, kNoPinyin, 548, 1199, kNoPinyin, 682, 368, 406, 1248, kNoPinyin, 597, 111,
+    231, 1087, 1145, 1228, 661, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, 1068, 96, 521, 1022, 699, 552,
+    603, 1177, 1125, 1162, 843, 812, 140, 1111, 348, 451, 543, 645, 1175, kNoPinyin, 567, 1183,
+    kNoPinyin, kNoPinyin, 1022, 1199, kNoPinyin, kNoPinyin, 101, 247, 394, kNoPinyin, 1105, kNoPinyin, 815, kNoPinyin, 1203, 433,
+    1212, 281, kNoPinyin, 376, 1263, 404, kNoPinyin, kNoPinyin, 453, 771, 313, 1145, kNoPinyin, 211, 832, 170,
+    231, 20, 1033, 1078, 170, 1269, 25, 1100, 36, 206, 20, 1043, kNoPinyin, kNoPinyin, 466, 356,
+    172, 1196, 1203, 553, 466, 296, 700, 262, 262, 1132, 384, 1163, 1051, 75, 46, 510,
+    160, kNoPinyin, 815, 1203, kNoPinyin, kNoPinyin, kNoPinyin, 398, 417, kNoPinyin, 473, 528, 264, 433, 670, 136,
+    36, 1101, 1263, 1143, 197, 134, kNoPinyin, 174, 621, 510, 1163, 84, kNoPinyin, 385, kNoPinyin, 544,
+    1043, 1201, 378, 694, 567, 288, 811, 586, 17, 1145, 1177, 1145, 645, kNoPinyin, 558, 1163,
+    36, 231, 586, 947, 446, 581, 457, 468, 1023, 784, 315, 448, 410, 75, 219, 413,
+    1170, 567, 649, kNoPinyin, kNoPinyin, kNoPinyin, 877, kNoPinyin, kNoPinyin, 790, 604, 586, 1179, 80, 927, kNoPinyin,
+    956, 1067, 670, 385, 1038, 65, 778, 425, kNoPinyin, 362, 75, 565, 110, 27, 193, 645,
+    1000, 829, 1268, 526, 49, 16, 645, 1113, kNoPinyin, 1047, kNoPinyin, 1086, kNoPinyin, kNoPinyin, kNoPinyin, 553,
+    110, 710, 710, 565, 239, 470, 442, 300, 921, 1240, 1018, 442, 731, 1158, 459, 312,
+    219, 441, 640, 197, 441, 938, 1125, 1218, 631, 565, 359, 1201, 1004, 1260, 1167, 1056,
+    kNoPinyin, 385, 229, 1087, 1212, 1239, 854, kNoPinyin, kNoPinyin, kNoPinyin, 1041, 339, kNoPinyin, 78, 300, 1038,
+    1004, 1004, 1297, 372, 801, 384, kNoPinyin, 1277, 68, 590, 744, kNoPinyin, 769, 221, 921, 1025,
+    519, 1026, 815, 435, 132, 752, 456, 500, 567, 470, 855, 539, 340, 821, 815, 1113,
+    441, 948, 1111, 4, 406, 469, 1230, 1170, kNoPinyin, 435, 101, 488, kNoPinyin, kNoPinyin, 1161, kNoPinyin,
+    kNoPinyin, 1043, 687, 1208, kNoPinyin, 132, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin,
+    kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin,
+    kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin,
+    kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin,
+    kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin,
+    1176, 233, 495, 814, 930, 1109, kNoPinyin, 1079, 1252, 908, 930, 1109, 432, 75, 1200, 653,
+    309, 141, 141, 1285, 836, 781, 950, 950, 849, 65, 1175, 174, 238, 977, 128, 237,
+    849, 573, 237, 1196, 573, 1161, 66, 911, 358, 463, 323, 1155, 827, 1271, 434, 453,
+    291, 349, 154, 110, 582, 1298, 1280, kNoPinyin, 1077, 204, 1087, 1280, 458, 567, 469, 794,
+    300, 1177, 1179, 684, kNoPinyin, 465, 465, 1258, 1168, 1179, kNoPinyin, 1267, 1098, 1241, 401, 272,
+    555, 1273, 800, 762, 831, 403, 344, 128, 128, 1178, 1182, kNoPinyin, 659, 465, 816, 1174,
+    1103, 1114, 309, 465, kNoPinyin, kNoPinyin, 955, kNoPinyin, 949, 432, 691, 436, kNoPinyin, 948, kNoPinyin, kNoPinyin,
+    626, 607, kNoPinyin, 891, 1149, 1162, 301, 919, 681, 310, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, 310, 134,
+    353, 310, 607, 582, 1179, 475, 556, kNoPinyin, 1199, 1264, 950, 950, 270, 146, 1199, 1199,
+    1199, 1210, 404, 815, 1100, 458, 979, 995, 327, 327, 1158, 1122, 1158, 815, 1158, 433,
+    1047, 1081, 493, 1004, 446, 370, 1179, 110, 390, 677, kNoPinyin, 1116, 457, 1040, 574, 1116,
+    457, 1175, 838, 68, 1197, 1125, 205, 569, 259, 1086, 877, 877, 433, kNoPinyin, 1081, 1179,
+    948, 877, 555, 233, 1231, 455, 810, 140, 19, 1251, 454, 453, 64, 881, 174, 295,
+    909, 609, kNoPinyin, 87, 1301, 950, 1002, 1252, 302, 1110, 1110, 1066, 394, 1043, 879, 822,
+    311, 1179, 219, 203, 588, 1178, 119, 113, 901, kNoPinyin, 1177, 678, 644, 879, 438, 119,
+    1166, 823, 1273, 783, 1079, 1100, 442, 439, 1170, 291, 87, 879, 1081, 290, 218, 281,
+    1271, 816, 773, 1199, 229, 256, 1091, 1179, 1128, 493, 1176, 433, 6, 1100, 435, 300,
+    272, 1137, 456, 38, 205, 299, 1014, 1273, 1194, 430, 423, 1200, 187, 152, 909, 1086,
+    152, 120, 1156, 1113, 928, 112, 609, 87, 1154, 1129, 1086, 1281, kNoPinyin, 1145, 735, 68,
+    337, 709, 709, 1125, 30, 1143, 586, 1277, 939, 853, 979, 44, 979, 835, 781, 1179,
+    979, 5, 1264, 226, 372, 627, 206, 1281, 75, 853, 50, 934, 171, 1087, 218, 1281,
+    1323, 1197, 1164, 1025, 1249, 384, 51, 1067, 936, 1199, 1179, 295, 1324, 510, 725, 1043,
+    709, 1144, 854, 1193, 1072, 822, kNoPinyin, 482, kNoPinyin, 773, 421, 385, 553, 1115, 321, 1165,
+    26, 273, 663, 436, 270, 66, 433, 388, 429, 355, 858, 1032, 448, 172, 1179, 949,
+    1131, 939, 1066, 488, 1268, 307, 541, 1177, 133, 514, 350, 567, 1180, 950, 650, 1278,
+    1143, 1197, 7, 604, 673, 268, 609, 1042, 103, 134, 1154, 331, 1274, 1176, 891, 442,
+    1107, 439, 1218, 617, kNoPinyin, 448, 1261, 94, 831, 519, 105, 725, 730, 455, 1100, 398,
+    461, 129, 1263, 1324, 141, 838, 617, 468, 958, 1041, 942, 1066, 68, 687, 379, 54,
+    1060, 1200, 1105, 180, 262, 850, 1141, 525, 513, 1101, 480, 1179, 301, 548, 1311, 833,
+    567, 1192, 427, 459, 1113, 910, 756, 987, 300, 1102, 566, 301, 800, 36, 1199, 979,
+    1107, 1129, 1137, 1200, 1026, 120, 140, kNoPinyin, 1162, 568, 567, 541, kNoPinyin, 441, 1137, 301,
+    385, 470, 1121, 755, 442, 57, 146, 286, 294, 1158, 9, 40, 1201, 1126, 50, 442,
+    112, 132, 66, 1220, 1169, 187, 568, 1078, 541, 87, 1305, 323, 347, 40, 1027, 955,
+    955, 644, 211, 1009, 475, 160, 1133, 778, 1014, 400, 1178, 814, 1026, 313, 459, 453,
+    992, 115, 451, 281, 1268, 505, 473, 1303, 470, 825, 708, 609, 1296, 1084, 614, 980,
+    561, 427, 238, 1302, 43, 1100, 470, 685, 81, 441, 1245, 1172, 1268, 921, 842, kNoPinyin,
+    1184, 127, 440, 1162, 739, 1273, 165, 438, 451, 1086, 1200, 65, 900, 1024, 1084, 785,
+    1163, 291, 1014, 1097, 264, 1123, 121, 945, 488, 221, 1324, 100, 1040, 40, 1175, 417,
+    1170, 1249, 141, 1160, 1196, 442, 1140, 1238, 169, 302, 48, 1270, 1304, 653, 433, 1178,
+    1125, 1153, 977, 248, 94, 1261, 749, 1046, 1046, 40, 1214, 617, 451, 1086, 290, 113,
+    353, 984, 1270, 988, 1106, 302, 1205, 885, 567, 892, 1211, 336, 623, 33, 223, 1013,
+    382, 451, 1102, 927, 825, 475, 87, 146, 909, 40, 1121, 1192, 1169, 1011, 999, 1166,
+    271, 66, 436, 202, 1218, 1014, kNoPinyin, 63, 145, 740, 83, 558, 184, 1190, 1226, 1304,
+    778, 981, 18, 152, 1200, 1245, 177, 928, 828, 459, 134, 920, 374, 1250, 842, 1163,
+    221, 1102, 617, 40, 792, 455, 569, 604, 630, 822, 1110, 1011, 1185, 240, 1287, 1117,
+    927, 831, 461, 1060, 1319, 811, 1102, 552, 114, 350, 576, 814, 217, 109, 1086, 432,
+    275, 423, 153, 442, 206, 448, 466, 918, 290, 1113, 475, 264, 446, 442, 1043, 583,
+    68, 340, kNoPinyin, 988, 1113, 443, 662, 1175, 456, 439, 833, 784, 291, 1277, 6, 906,
+    1177, 480, 730, 109, 1179, 207, 458, 1144, 519, 441, 146, 204, 448, 920, 1218, kNoPinyin,
+    63, 10, 890, 1006, 140, 105, 544, 709, 455, 825, 645, 1100, 723, 847, 709, 113,
+    581, 558, 617, 526, 37, 245, 55, 1221, 1268, 979, 1194, 380, 126, 126, 567, 1022,
+    1086, 594, 145, 111, 869, 955, 423, 567, 613, 1221, 740, 1014, 1162, 558, 693, 268,
+    1101, 1211, 1219, 1203, 1134, 135, 1256, 1134, 1110, 350, 253, 500, 253, 653, 1053, 113,
+    268, 253, 268, 1126, 1053, 979, 1162, 1162, 949, kNoPinyin, 208, 822, 241, 287, 634, 939,
+    241, kNoPinyin, 457, 566, 417, 892, 1081, 700, 858, 573, 1199, 19, 331, 592, 1102, kNoPinyin,
+    544, 333, 1027, 347, 1130, 64, 815, 470, 225, 1300, kNoPinyin, 1166, 440, 954, 435, 1179,
+    435, 110, 460, kNoPinyin, 868, 700, kNoPinyin, 635, 314, 868, 94, 460, 94, 1218, 342, 461,
+    636, 1277, 636, 336, 1142, 653, 651, 885, 1181, 1124, 488, 478, 730, 1177, 649, 950,
+    347, 645, 1272, 470, 1202, 663, 510, kNoPinyin, 302, 1124, 651, 64, 238, 1006, 314, 292,
+    64, 404, 135, 475, 404, 526, 1174, 562, 761, 300, 662, 240, 1112, 581, 1107, 440,
+    459, 958, 639, 1051, 814, 340, 1294, 980, 459, 572, 845, 227, 586, 240, 313, 441,
+    1180, 177, 1177, 567, 87, 664, kNoPinyin, 185, 977, 258, 456, 583, 583, 723, 1102, 245,
+    432, 276, 276, 276, 294, 467, 145, kNoPinyin, 291, kNoPinyin, kNoPinyin, 300, 291, 801, 291, 485,
+    417, 485, 310, 217, 801, 853, 1134, 519, 1050, 15, 143, 433, 209, 372, 372, 1227,
+    210, 227, 210, 879, 879, 155, 287, 834, 1179, 432, 487, 825, 190, 144, 1090, 432,
+    205, 1131, 406, 1077, 475, 565, 1208, 581, 590, 1230, 314, 158, 300, 143, 856, 467,
+    925, 662, 586, 1271, 761, 59, 451, 451, 37, 567, 925, 59, 110, 458, 341, 325,
+    212, 158, 527, 511, 260, 270, 1270, 959, 860, 103, 172, 500, 451, 356, 172, 356,
+    485, 260, 435, 1026, 458, 597, 325, 1230, 1202, 195, 1148, 500, 539, 823, 103, 158,
+    342, 442, 195, 565, 1023, 286, 806, 110, 815, 158, 1302, 314, 1076, 67, 432, 257,
+    843, 1162, 1297, 442, 435, 67, 1160, 470, 431, 946, 441, 258, 248, 1098, 342, 302,
+    946, 442, 320, 1238, 485, 158, 471, 110, 1055, 604, 565, 296, 925, 792, 508, 448,
+    341, 830, 475, 408, 1239, 1299, 569, 470, 781, 590, 356, 448, 356, 442, 442, 1012,
+    428, 435, 442, 1179, 442, 1268, 109, 182, 668, 565, 1279, 567, 1155, 860, 30, 331,
+    436, 1101, 627, 581, 456, 503, 1123, 1269, 240, 1281, 736, 451, 854, 934, 1179, 1278,
+    657, 567, 459, 552, 552, 473, 509, 1165, 1070, 1121, 673, 523, 451, 581, 384, 950,
+    500, 456, 380, 68, 662, 134, 548, 1192, 1192, 653, 500, 1152, 473, 843, 604, 808,
+    646, 543, 555, 486, 653, 240, 1143, 1143, 487, 1101, 1179, 1152, 1093, 946, 552, 678,
+    604, 792, 950, 432, 839, 828, 448, 860, 1166, 1179, 475, 276, 473, 1043, 470, 204,
+    1123, 627, 1152, 1152, 618, 567, 122, 869, 860, 34, 932, 1210, 463, 37, 334, 1101,
+    1210, kNoPinyin, kNoPinyin, 309, 309, 34, 173, kNoPinyin, 1134, 777, 468, 1017, 321, 811, 10, 767,
+    300, 331, 197, 466, 846, 50, 408, 39, 695, 132, 279, 466, 1177, 1213, 445, 493,
+    445, 523, 401, 1107, 853, 54, 355, 837, 1223, 523, 285, 401, 1047, 355, 356, 423,
+    204, 356, 569, 569, 990, 245, 466, 854, 1104, 783, 853, 1179, 821, 1162, 53, 710,
+    853, 948, 1129, 822, 713, 903, 1310, 943, 1100, 423, 30, 950, 1105, 1079, 406, 1123,
+    1079, 38, 1310, 1296, 1123, 204, 627, 687, 204, 433, 68, 964, 74, 526, 54, 74,
+    1246, 820, 602, 1196, 603, 1102, 343, 1097, 1125, 451, 451, 1087, 12, 847, 1267, 635,
+    1183, 1084, 934, 433, 863, 606, 950, 473, 1125, 1143, 455, 863, 1101, 433, 264, 842,
+    1102, kNoPinyin, 114, 1246, 264, 1039, 567, 1258, 373, 567, 1157, 1155, 1163, 938, 1269, 1240,
+    763, kNoPinyin, 384, 1156, 1270, 94, 763, 1024, 565, 938, 400, 1039, 1315, 195, 286, 1203,
+    94, 1203, 1114, 1162, 567, 475, 921, 223, 144, 466, 839, 16, 355, 1163, 977, 567,
+    114, 544, 567, 1161, 1162, 1203, 977, 331, 582, 850, 856, 856, kNoPinyin, 558, 244, 1113,
+    1285, 908, 83, 83, 83, 83, 6, 203, 1197, 100, 433, 1196, 967, 277, 952, 346,
+    20, 271, 900, 950, 955, 1297, 855, 954, 54, 1143, 438, 761, 984, 319, 1087, 984,
+    231, 897, 174, 509, 339, 470, 588, 342, 1016, 510, 1269, 449, 1256, 19, 233, 499,
+    1006, 134, 949, 1197, 850, 804, 1175, 382, 977, 1011, 133, 555, 227, 432, kNoPinyin, 393,
+    659, 1140, 631, 131, 323, 1144, 1168, 1301, 384, 433, 229, 191, 1043, 663, 400, 567,
+    1052, 1117, 1241, 1109, 1174, 617, 0, 624, 749, 1148, 1176, 478, 141, 584, 1062, 1181,
+    286, 50, 841, 841, 453, 75, 297, 23, 254, 287, 262, 372, 1039, 376, 973, 816,
+    394, 1267, 941, 1099, 1099, 118, 698, 1151, 1102, 159, 241, 1090, 399, 747, 1099, 319,
+    1155, 480, 617, 264, 321, 638, 201, 816, 128, 1099, 319, 299, 449, 393, 133, 943,
+    697, 1062, 301, 1179, 201, 747, 567, 27, 1203, 517, kNoPinyin, 826, 1098, 264, 947, 859,
+    774, 1090, 708, kNoPinyin, 586, 868, 1194, 220, 1274, 950, 1277, 1036, 1105, 1179, 817, 801,
+    1301, 337, 1300, 1087, 1140, 383, 694, 1106, 770, 1179, 1118, 939, 401, 665, 197, 853,
+    469, kNoPinyin, 1213, 1066, 257, 809, 767, 51, 300, 1164, 384, 1241, 384, 367, 466, 1192,
+    302, 863, 1277, 1072, 482, 337, 481, 1323, 75, 593, 238, 723, kNoPinyin, 977, 1113, 431,
+    817, 270, 264, 350, 1241, 1105, 1177, 580, 1300, 659, 648, 1269, 1170, 432, 1277, 320,
+    964, 1220, 1121, 498, 420, 514, 411, 1017, 1111, 264, 1146, 1137, 1074, 1160, 553, 1176,
+    3, 798, 941, 1043, 393, 1134, 257, 1070, 365, 1216, 1201, 221, 757, 1116, 3, 388,
+    523, 1157, 196, 1118, 51, 1207, kNoPinyin, 405, kNoPinyin, 519, 259, kNoPinyin, 435, 730, 672, 1189,
+    382, 1203, 595, 808, 631, 320, 262, 131, 934, 564, 681, 1310, 384, 511, 1118, 1113,
+    552, 67, 1258, 1238, 574, 19, 659, 555, 992, 296, 74, 374, 390, 329, 975, 322,
+    1196, 1163, 339, 339, 27, 371, 999, 164, 1179, 3, 437, 1052, 1111, 414, 567, 1102,
+    1013, 1324, 850, 120, 1099, 1229, 1157, 241, 816, 219, 841, 623, kNoPinyin, 395, 242, kNoPinyin,
+    552, 573, 1000, 1229, 415, kNoPinyin, 919, 432, 1323, 1095, 293, 1181, 403, 814, 954, 1085,
+    959, 115, 268, 567, 829, 9, 453, 1188, 713, 1198, 1029, 542, 921, 1102, 1069, 401,
+    4, 1274, 734, 501, 1297, 1297, 928, 219, 392, 544, 2, 1118, 1114, 1062, 1100, 1091,
+    187, 921, 401, 816, 816, 1017, 206, 206, 1175, 1301, 50, 187, 168, 384, 1157, 816,
+    1258, 283, 573, 1111, 782, 921, 540, 1230, 842, 343, 751, 1259, 916, 1287, 720, 364,
+    612, 1160, 221, 858, 1008, 71, 236, 547, 1121, kNoPinyin, 1013, 134, 1024, 8, 463, 206,
+    481, 1191, 1087, 687, 927, 1201, 1258, 538, 450, 398, 373, 231, 1274, 105, 1074, 875,
+    1201, 1180, 1220, 1168, 746, 653, 402, 1211, 153, 423, 415, 415, 1104, 383, 432, 530,
+    1272, 1086, 921, 1142, 417, 247, 720, 1144, 574, 1201, 911, 131, 831, 1163, 204, 774,
+    83, 565, 1189, 1238, 1084, 655, 1185, 774, kNoPinyin, 528, 1105, 1201, 451, 600, 513, 915,
+    431, 1024, 1169, 385, 1, 1139, 826, 916, 1190, 988, 395, 1123, 1179, 999, 624, 100,
+    370, 500, 1004, 912, 1028, 892, 983, 1070, 432, 764, 1098, 1111, 950, 321, 1300, 450,
+    615, 1092, 1073, 979, 131, 380, 999, kNoPinyin, 367, 1000, 839, 720, 383, kNoPinyin, 906, kNoPinyin,
+    323, 680, 222, 6, kNoPinyin, 1042, 51, 16, 16, 569, 184, 1257, 670, 985, 984, 1010,
+    219, 814, 449, 135, 446, 485, 1011, 908, 91, 436, 4, 1118, 789, 600, 303, 339,
+    1118, 401, 423, 360, 747, 1110, 1230, 113, 1140, 803, 213, 624, 623, 402, 560, 244,
+    303, 1012, 1174, 44, 1184, kNoPinyin, 449, 651, 1121, 405, 626, 867, 1321, 777, 552, 1121,
+    432, 1280, 117, 530, 1316, 1118, 977, 380, 301, 576, 831, 1102, 1139, 1008, 1009, 386,
+    1154, 263, 1319, 275, 131, 420, 1221, 156, 180, 206, 1201, 1062, 127, 449, 1172, 1102,
+    817, 380, 569, 1140, 215, 420, 1181, 810, 474, 839, 1153, 720, 601, 977, 1162, 1187,
+    196, 204, 746, 1277, 456, 730, 1207, 423, 817, 264, 1229, 1176, 950, 449, 1202, 5,
+    1190, 475, 519, 1200, 774, 212, 321, 1126, 254, 207, kNoPinyin, 907, 781, 783, 1180, 1316,
+    723, 219, 546, 1004, 431, 890, 379, 1109, 1158, 257, 1105, 140, 435, 456, 380, 1026,
+    113, kNoPinyin, kNoPinyin, 76, 1026, 601, 423, 68, 1194, 720, 1181, 404, 670, 416, 1258, 565,
+    590, kNoPinyin, 691, 1118, 668, 1163, 567, 602, 593, 300, 206, 126, 797, 783, 1117, 431,
+    668, 1105, 259, 513, 1161, 109, 1184, 870, 225, 536, 1004, 1118, 447, 168, 412, 431,
+    1287, 720, 1118, 78, 565, 110, 107, 567, 1179, 612, 691, 1222, 986, 1104, kNoPinyin, 440,
+    1214, 1280, 544, 720, 690, kNoPinyin, kNoPinyin, 1085, 421, 1180, 850, 979, 721, 441, 421, 1129,
+    1180, 686, 1055, 1055, 256, 493, 1202, 461, 785, 1212, 173, 402, 421, 1203, 262, 361,
+    533, 173, 1085, 1051, 1085, 609, 361, 864, 883, 586, 340, 361, 1005, 361, 1051, 1197,
+    361, 1181, 427, 812, 1200, 372, 1203, 609, 857, 1200, 842, 361, 152, 1085, 1203, 857,
+    511, 302, 1203, 1203, 264, kNoPinyin, 1051, 1051, 1055, 619, 423, 1179, 1203, 605, 605, 1052,
+    1158, 1052, 1039, 946, 812, 604, kNoPinyin, 1155, 1218, 1085, 320, 1201, 1098, 353, 783, 1177,
+    221, 822, 822, 1263, 1297, 209, 821, kNoPinyin, kNoPinyin, 526, 113, 815, 720, 670, 433, 437,
+    1269, 1269, 29, 1152, 1047, 840, 288, 478, 503, 1063, 279, 290, 43, 1008, 488, 411,
+    1324, 503, 51, 1131, 221, 457, 435, 519, 220, 457, 440, 1009, 567, 22, 1101, 288,
+    1292, 802, 760, 1012, 531, 853, 1010, 1267, 1067, 310, 801, 226, 343, 708, 1006, 781,
+    460, 1166, 295, 18, 592, 849, 678, 499, 336, 1151, 20, 132, 122, 586, 1281, 302,
+    401, 1270, 160, 536, 594, 594, 602, 18, kNoPinyin, 767, kNoPinyin, 1131, 240, 435, 500, 604,
+    170, 133, 558, 307, 1180, 400, 251, 1256, 300, 350, 1169, 259, 259, 355, 101, 1165,
+    1181, 272, 336, 1203, 231, 1123, 501, 460, 953, 264, kNoPinyin, 226, 394, 1101, 515, kNoPinyin,
+    kNoPinyin, 209, 485, kNoPinyin, 695, 9, 1130, 1113, 415, 31, 770, 22, 1179, 1183, 374, 1143,
+    160, 96, 329, 3, 778, 280, 863, 1192, 1154, 437, 221, 625, 550, 1147, 128, 1161,
+    454, 1258, 559, 581, 812, 128, kNoPinyin, 75, 948, 1152, 360, 460, 1174, 713, 220, 1201,
+    75, 1158, 472, 995, 782, 127, 1078, 470, 610, 1264, 505, 137, 238, 203, 1011, 9,
+    82, 956, 46, 488, 1268, 259, 1179, 1268, 1179, 771, 432, 1294, 815, 915, 470, 708,
+    511, 500, 1013, 531, 710, 440, 251, 455, 314, 1201, 264, 778, 340, 1053, 563, kNoPinyin,
+    1156, 825, kNoPinyin, 10, kNoPinyin, 260, 695, 1050, 128, 1180, 425, 51, 571, 360, 231, 1287,
+    400, 36, 36, 1199, 218, 634, 450, 893, 264, 330, 487, 1303, 1199, 417, 264, 1169,
+    1163, 37, 433, 638, 113, 246, 1067, 1183, 292, 1273, 453, 1261, 291, 314, 153, 441,
+    kNoPinyin, kNoPinyin, 1117, 416, 561, 250, kNoPinyin, 1144, 435, 433, 519, 1185, 1002, 128, 1192, 485,
+    988, 988, 948, 651, 1003, 1093, 128, 1051, 1013, 863, 1272, 567, 778, 33, 904, 1225,
+    251, 1028, 1101, 129, 1152, 321, 1263, 6, 331, 1161, 488, 1028, 1203, 1088, 1125, 592,
+    kNoPinyin, 549, 113, 778, 47, 124, 180, 603, 749, 825, 638, 670, 1285, 968, 956, 598,
+    132, 630, 55, 459, 814, 958, 221, 1250, 489, 1190, 226, 125, 1267, 1105, 360, 828,
+    456, 218, 928, 678, 184, 1163, 1003, 1235, 815, 827, 572, kNoPinyin, 1292, 830, 1235, 1140,
+    927, 927, 20, 810, 519, 239, 276, 863, 670, 254, 254, 1318, 221, 946, 260, 260,
+    1009, 217, 1100, 288, 417, 1009, 196, 1175, kNoPinyin, kNoPinyin, 18, 827, 432, 830, 501, 1179,
+    782, 51, 226, 443, 1174, 1190, 68, 1009, 545, 470, 411, 209, 870, 825, 1152, 546,
+    1104, 385, 6, 1155, 211, 380, 893, kNoPinyin, 558, 526, 602, 1161, 1009, 1085, 411, 594,
+    594, 897, 567, 582, 870, kNoPinyin, 1152, 1161, 557, 22, kNoPinyin, 950, 877, kNoPinyin, 1289, 1289,
+    943, 1176, 627, 498, 1280, 1289, 402, 402, 532, 1176, 402, 1143, 532, 954, 632, 1318,
+    954, 1176, 1269, 337, 146, 445, 292, 40, kNoPinyin, 54, 992, 864, 586, 302, 1324, 1109,
+    1136, kNoPinyin, 694, 1109, 528, 1102, 1075, 1205, 635, 988, 257, 257, 1175, 843, kNoPinyin, 336,
+    336, 817, 647, 647, 1181, 430, 126, 199, 1231, 1027, 1007, 299, 346, 1168, 1164, 375,
+    318, 947, 42, 1007, 1047, 1162, 50, 1177, 514, 436, 258, kNoPinyin, 525, 1212, 436, 751,
+    265, 569, 415, 221, 1162, 769, 859, 815, 685, 294, 1123, 290, 225, kNoPinyin, 528, 1308,
+    415, 817, 484, 935, 41, 1179, 444, 1019, 1225, 42, 1102, 1116, 285, 227, 1154, 503,
+    226, 18, 935, 1093, 760, 18, 1101, 18, 444, 569, 258, 1209, 444, 950, 290, 431,
+    51, 569, 259, 743, 735, 233, 684, 822, 440, 1002, 465, 687, 103, 381, 1110, 278,
+    434, 976, 890, 283, 1083, 394, 1288, 302, 620, 204, 879, 299, 459, 1161, 1125, 1091,
+    1271, 751, 247, 435, 503, 1273, 1168, 456, 1210, 658, 770, kNoPinyin, 1208, 1288, 726, 1163,
+    682, 1126, 288, 50, 1199, 1068, 291, 1203, 280, 1100, 1201, 353, 247, 20, 707, 1275,
+    1297, 1253, 197, 684, 1204, 1048, 1145, 1268, 261, 640, 670, 814, 51, 939, 837, 261,
+    384, 1142, 272, 1264, 661, 30, 677, 299, 586, 1301, 1301, 949, 868, 925, 1164, 628,
+    452, 337, 979, 1133, 1086, 1300, 470, 925, 796, 879, 1169, 1044, 443, 955, 433, 307,
+    930, 535, 471, 446, 336, 677, 440, 440, 1177, 713, 1268, 432, 432, 1113, 391, 350,
+    478, 514, 1163, 664, 581, 773, 1162, 1197, 1161, 103, 939, 1180, 133, 355, 857, 1300,
+    980, 1084, 394, 1071, 597, 1158, 873, 446, 605, 800, 1113, 934, 566, 128, 1121, 631,
+    kNoPinyin, 999, 1100, 1086, 500, 543, 168, 236, 714, 1131, 687, 1199, 740, 770, 699, 471,
+    939, 1270, 372, 221, 1288, 262, 797, 1061, 374, 653, 1099, 1161, 1100, 1102, 1161, 1199,
+    979, 1199, 1070, kNoPinyin, 1111, 467, 855, 972, 814, 1111, 1290, 238, 112, 604, 5, 261,
+    261, 597, 652, 174, 808, 468, 803, 81, 234, 1078, 56, 1118, 957, 816, 420, 302,
+    261, 1096, 1009, 283, kNoPinyin, 451, 1027, 708, 858, 459, 424, 457, 822, 226, 1133, 404,
+    1073, 541, 51, 1180, 1274, 168, 302, 459, 609, 1163, 544, 531, 1181, 1158, kNoPinyin, 567,
+    225, 1111, kNoPinyin, 408, 1184, 109, 941, 1040, 209, 1170, 1101, 689, 900, 438, 1046, 1143,
+    1199, 1084, 1024, 887, 639, 204, 894, 838, kNoPinyin, 1098, 823, 163, 634, 302, 452, 248,
+    1102, 1273, 638, 417, 652, 7, 1184, 1144, kNoPinyin, 1084, 640, 1205, 1261, 849, 1024, 1125,
+    1068, 571, 636, 868, 977, 785, 1087, 1070, 466, 402, 17, kNoPinyin, kNoPinyin, 1140, 1046, 353,
+    1306, 1169, 784, 1103, 1203, 1187, 884, 892, 131, 590, 639, 759, 17, 620, 336, 530,
+    839, 439, 914, 1261, 1203, 100, 1191, 663, 1184, 433, 988, 716, 1111, 1016, 763, 548,
+    695, 35, 6, 784, 797, 1179, 792, 1201, 557, 1145, 630, 1176, 1250, 490, 1191, 710,
+    565, 219, 353, 1160, 456, 1285, 113, 94, 371, 703, 554, 668, 1257, 404, 404, 18,
+    703, 827, kNoPinyin, 795, 337, 1100, 447, 1068, 1248, 634, 1111, 1111, 670, 576, 569, 408,
+    353, 215, 1267, 1140, kNoPinyin, 406, 1102, 423, 873, 1102, 1163, 109, 446, 639, 278, 275,
+    1110, 1179, 1087, 449, 302, 950, 51, 927, 995, 827, 570, 413, kNoPinyin, 716, 239, 1179,
+    84, 6, 714, 704, 620, 1034, 140, 456, 170, 1199, 797, kNoPinyin, 1140, 684, 1160, 1006,
+    1184, 84, 716, kNoPinyin, 1185, 652, kNoPinyin, 620, 941, 1133, 710, 245, 591, 1202, 545, 1163,
+    967, 586, 448, 714, 545, 1110, 1184, 967, 962, 858, 650, 565, 605, 1161, 1280, 545,
+    1301, 451, 475, 475, 506, 1212, 1300, 1302, 189, 996, 300, 40, 1300, 1121, 1129, 647,
+    979, 1005, 34, 435, 337, 735, 1149, kNoPinyin, 1286, 368, 605, 996, 411, 659, 174, 822,
+    956, 109, 1155, 1300, 709, 299, 1300, 565, 1149, 70, 890, 541, 720, 720, 1184, 605,
+    652, 723, 885, 1002, 355, 1243, 847, 1200, 953, 7, 1051, 982, 1077, 889, 1170, 394,
+    1177, 458, 1293, 651, 1280, 209, 394, 1303, 347, 1277, 236, 1078, 1177, 36, 948, 948,
+    137, 941, 500, 1144, 950, 1197, 415, 1177, 1034, 949, 1113, 331, 128, 865, 331, 1118,
+    1217, 1241, 36, 370, 1163, 1118, 436, 941, 124, 884, 418, 651, 510, 520, 62, 988,
+    82, 1221, 435, 1202, 435, 1181, 651, 510, 842, 863, 1261, 441, 302, 723, 66, 413,
+    640, 840, 372, 1201, 948, 723, 456, 723, 1270, 1200, 36, 520, 723, 840, 670, 101,
+    470, 342, 840, 401, 1101, 576, 948, 723, 1245, 941, 1086, 1124, 520, 423, 576, 480,
+    413, 1179, 1177, 36, 841, 137, 36, 291, 191, 253, 979, 1153, 211, 618, 253, 954,
+    804, 291, 1285, 299, 938, 500, 443, 443, 1285, 1087, 1318, 1153, 958, 253, 211, 1120,
+    432, 933, 269, 269, 269, 305, 440, 956, 124, 930, 930, kNoPinyin, 304, 113, 578, 1112,
+    1112, kNoPinyin, 1080, 1080, 1195, 578, 578, 1169, 631, 1080, 1080, 1080, 306, 1169, 260, 530,
+    1272, 466, 310, 339, 310, 1059, 310, 310, 947, 1182, 133, 494, 708, 455, 1086, 717,
+    468, 784, 98, 1105, 48, 467, 453, 1028, 853, 1026, 453, 1098, 228, 947, 949, 801,
+    432, 1125, 124, 1105, 708, 1248, 1102, kNoPinyin, 629, 261, 599, 801, 1026, 286, 957, 1125,
+    1051, 617, 617, 1104, 98, 617, 470, 1125, 470, 474, 576, 475, 957, 1105, 122, 1063,
+    710, 925, kNoPinyin, 1110, 567, 1148, kNoPinyin, kNoPinyin, 593, 1179, 816, 879, 1101, 374, 939, 1200,
+    143, 995, 816, kNoPinyin, 1208, 29, 1170, 12, 1156, 1101, 451, 264, 433, 822, 287, 1203,
+    815, 96, 823, 815, 103, 453, 853, 315, 1113, 18, 544, 211, 19, 1324, 1324, 1166,
+    470, 314, 499, 335, 1151, 38, 567, 1033, 467, 1161, 300, 1139, 438, 586, 1067, 770,
+    1196, 203, 526, 1208, 853, 404, 805, 661, 10, 1033, 586, 132, kNoPinyin, 238, kNoPinyin, 527,
+    1139, 635, 1043, 1149, 1179, kNoPinyin, 383, 497, 615, 261, 302, 1153, 231, 604, 7, 269,
+    307, 858, 1043, 1177, 677, 948, 7, 1085, 401, 1270, 651, 566, 432, 1043, 1085, 1197,
+    kNoPinyin, 1107, 566, 1169, 449, 1264, 605, 446, 262, 262, 1201, 1173, 72, 833, 864, 291,
+    291, 694, 566, 1195, 1113, 394, 211, 939, 128, 1051, 329, 480, 382, 1107, 1180, 1200,
+    550, 488, 552, 541, 1112, 863, 505, 136, 136, 1004, kNoPinyin, 406, 467, 541, 815, 661,
+    531, 531, 1310, 340, 184, 1156, 1156, 315, 609, 609, 561, 475, 257, 1264, 360, 1181,
+    238, 372, 1264, 1086, 1169, 783, 1160, 980, 451, 44, 1310, 475, 238, 1248, 340, 1181,
+    kNoPinyin, 1230, 417, 1199, 1084, 1165, 291, 850, 256, 1024, 1178, 1270, 950, 1217, 1170, 264,
+    1281, 487, 618, 1162, 639, 310, 432, 432, 414, 1040, 946, 638, 825, 1101, 1199, 1303,
+    544, 475, 1161, 1161, 1086, 1303, 101, 995, 884, kNoPinyin, 838, 1199, kNoPinyin, 598, 1051, 251,
+    1102, 1092, 87, 207, 394, 451, 4, 590, 1100, 980, 830, 1300, 1085, 44, 223, 193,
+    824, 1192, 720, 193, 433, kNoPinyin, kNoPinyin, 981, 1303, 445, 576, kNoPinyin, 110, 231, 95, 235,
+    1050, 598, 1252, 1248, 1248, 16, 91, 853, 826, 1315, 1316, 211, 211, 1103, 1201, 68,
+    593, 1116, 98, 67, 838, 446, 1162, 552, 1249, 582, 576, 576, 454, 217, 260, 1318,
+    449, 356, 1169, 831, 1169, 475, 1246, 1179, 1149, 694, 1175, 1175, 1177, 264, 1112, 433,
+    1125, 499, 1102, 221, 18, 1316, kNoPinyin, 1177, 884, 211, 587, 1214, 1200, 1208, 1182, kNoPinyin,
+    450, 567, 994, 593, 593, 223, 1185, 1102, 468, 109, 1186, 527, 1161, 1084, 694, 858,
+    118, 182, 605, 223, 223, kNoPinyin, 1161, 1161, 1162, 694, 1162, 151, 356, 151, 1274, 416,
+    457, 1153, 117, 117, 579, 331, 1323, 832, 470, 332, kNoPinyin, 1098, kNoPinyin, kNoPinyin, 103, 850,
+    850, 434, 1178, 979, 19, 1267, 1253, 1117, 1177, 455, 1154, 473, kNoPinyin, 1154, 454, 300,
+    1213, 51, 950, 75, 233, 964, 275, 720, 947, 287, 753, 1269, 1102, 404, 206, 1085,
+    1252, 1014, 203, 623, 773, 753, 1036, 300, 569, 1270, 1276, 68, 1270, 221, 670, 1179,
+    1179, 801, 821, 473, 890, 964, 203, 1266, 972, 833, 1261, 947, 865, 1103, 31, 203,
+    353, 140, 801, 1252, 919, 1076, 203, 1085, 113, 921, 815, 1230, 361, 636, 246, 398,
+    1266, 1140, 651, 1085, 1097, 300, 1179, 31, 801, kNoPinyin, 331, 759, 418, 210, 651, 436,
+    1022, 420, 1271, 925, 630, 678, 55, 361, 1230, 678, 31, 1252, 461, 110, 300, 1270,
+    401, 275, 156, 51, kNoPinyin, kNoPinyin, 651, 830, 108, 288, 645, 31, 140, 660, 144, 451,
+    1112, 544, 310, 801, 711, 822, 66, 66, 1133, 313, 1168, 415, 1197, 1194, 434, 351,
+    783, 1039, 1231, 351, 1288, 671, 845, 51, 839, 256, 156, 355, 1157, 27, 453, 1143,
+    602, 1100, kNoPinyin, 513, 1187, 220, 767, 226, 1155, 658, 328, 169, 301, 1043, 763, 286,
+    1115, 1178, 1270, 1032, 1270, 1137, 247, 1324, 1118, 1051, 355, 513, 763, 1040, 1196, 72,
+    233, 129, 541, 38, 433, 7, 958, 490, 1190, 1068, 980, 958, 844, 1201, 1200, 658,
+    983, 94, 1114, 286, 466, 384, 423, 592, 921, 569, 548, 983, 1270, 808, 844, 466,
+    466, 455, 16, 535, 597, 1183, 578, 203, 604, 1179, 144, 109, 1050, 977, 1126, 658,
+    114, 1100, 286, 351, kNoPinyin, 519, 51, 827, 1125, 583, 583, 576, 602, kNoPinyin, 1185, 1110,
+    1039, 1190, 565, 1039, 1182, 1153, 1161, 1040, 219, 805, 442, 421, 684, 421, 332, 713,
+    484, 54, 1179, 817, 732, 288, 469, 1162, 1179, 1225, 51, 1179, 1176, 270, 908, 950,
+    270, 950, 950, 331, 229, 1182, 404, 300, 394, 1098, 1059, 132, 445, 22, 941, 221,
+    1250, 475, 1016, 301, 220, 649, 1111, 402, 116, 736, 459, 1262, 1177, 650, 857, 1076,
+    931, 900, 1144, 459, 254, 1250, 445, 827, 778, 206, 827, 51, 51, 938, 206, 441,
+    336, kNoPinyin, 271, 51, 508, kNoPinyin, 61, 1118, 206, 535, 827, 394, 649, 535, 1076, 475,
+    435, 435, 353, 207, 604, 604, 1057, 423, 1270, 423, 423, 1177, 1177, 1177, 1177, 431,
+    431, 925, 1131, 1089, 1043, 1163, 1163, 1201, 131, 81, 55, 227, 62, 778, 1192, 789,
+    1250, 1186, 131, 134, 1297, 1068, 433, 763, 1271, 1179, 1081, 122, 50, 132, 587, 300,
+    1082, 1264, 179, 1082, 459, 203, 1102, 1154, 388, 1165, 410, 618, 400, 1070, 129, 1270,
+    1141, 459, 1051, 174, kNoPinyin, 541, 174, 213, 755, 1104, kNoPinyin, 817, 113, 1270, 174, 1274,
+    541, 1201, 1125, 453, 442, 132, 438, 54, 417, 302, 1153, 1086, 763, 1169, 1084, 1102,
+    1264, 792, 132, 213, 1264, 1264, 61, 213, 135, 122, 448, 1087, 449, 420, 638, 595,
+    1114, 37, 854, 1126, kNoPinyin, 51, 1179, 555, 877, 210, 236, 308, 435, 878, 877, 111,
+    1010, 1020, 1020, 310, 817, 950, 190, 1270, 1083, 631, 1102, 276, 1184, 1029, 661, 661,
+    1271, 135, 1101, 433, 1100, 1105, 1175, 1194, 1079, 173, 1271, 519, 1201, 54, 1270, 815,
+    187, 124, 1007, 1063, 823, 713, 425, 1134, 728, 1082, 1110, 1126, 490, 401, 486, 290,
+    410, 1007, 981, 1100, 750, 115, 158, 470, 1179, 36, 116, 661, 770, 1324, 1233, 1167,
+    510, 30, 737, 694, 1264, 753, 75, 1036, 340, 404, 470, 197, 569, 977, 139, 221,
+    203, 1177, 1051, 1195, 299, 433, 777, 1133, 1205, 708, 346, 300, 1105, 51, 1194, 837,
+    1147, 173, 65, 418, 1143, 146, 781, 1102, 1102, 1008, kNoPinyin, 1304, 253, kNoPinyin, kNoPinyin, 1179,
+    133, 879, 1153, 950, 1105, 553, 391, 523, 676, 1269, 1123, 571, 1032, 418, 231, 381,
+    506, 355, 391, 1102, 1121, 958, kNoPinyin, 515, 849, 1167, 423, 421, 134, 437, 1177, 1134,
+    346, 584, 420, 1302, 1143, 133, 1117, 744, 389, 265, 500, 1042, 1028, 331, 858, 1102,
+    821, 1208, 777, 501, 213, 423, 264, kNoPinyin, 1045, 1163, 485, 94, 695, 1212, 631, 1192,
+    1192, 1202, 781, 532, 832, 1208, 1201, 1201, 453, 1102, 1258, 584, 1026, 374, 382, 837,
+    1026, 75, 1179, 825, 422, 1102, 40, 628, 1176, 390, 981, 857, 129, 527, 1101, 1101,
+    1194, 565, 574, 415, 173, 1179, 1208, 567, 721, 695, 264, 863, 1145, 822, 1101, 662,
+    174, 285, 38, 258, 187, 115, 643, 567, 435, 349, 349, 1133, 212, 814, 505, 1029,
+    609, 1102, 488, 531, 710, 843, 140, 254, 362, 108, 572, 1078, 1202, 454, 435, 582,
+    1201, 431, 384, 858, 1009, 1026, 1026, 718, 1082, 168, 401, 424, 1102, 114, 1126, 1085,
+    423, 264, 896, 1304, 440, 1192, 226, 470, 85, 128, 213, 40, 837, 84, 206, 349,
+    260, 695, 1212, 1116, 1292, 232, 417, 165, 847, 875, 1130, 94, 53, 424, 1303, 1024,
+    832, 140, 40, 1144, 1084, 321, 822, 1086, 1201, 1199, 51, 1144, 415, 662, 51, 1179,
+    653, 1192, 486, 209, 1180, 264, 124, 675, 500, 500, 1199, 6, 837, 1162, 742, 312,
+    1212, 1304, 904, 563, 290, kNoPinyin, 530, 530, 863, 331, 1210, 988, 988, 815, 1169, 981,
+    418, 433, 339, 470, 158, 710, 1123, 485, 1265, 1192, 92, 998, 942, 68, 486, 1205,
+    1123, 427, 1192, 1166, 567, 913, 1016, 1180, 170, 1143, 825, 1007, 416, 1212, 942, 664,
+    kNoPinyin, 938, 174, 792, 670, 678, 361, 134, 85, 84, 84, 185, 662, 1020, 1250, 1045,
+    18, 968, 630, 349, 863, 1229, 466, 423, 485, 569, 750, 981, 455, 1183, 618, 928,
+    1087, 1055, 628, 822, 938, 1190, 845, 490, 221, 1268, 597, 473, 814, 814, 1201, 801,
+    576, 173, 1194, 135, 1270, 1045, 127, 817, 853, 778, 40, 58, 164, 446, 1235, 134,
+    569, 801, 530, 423, 831, 128, 1183, 1183, 1104, 1104, 206, 1009, 259, 253, 253, 988,
+    475, 94, 1118, 276, 290, 552, 554, 135, 371, 817, 1111, 662, 458, 577, 1100, 85,
+    475, 180, 1113, 1010, 944, 781, 1179, 145, 1110, 694, 206, 1010, 458, 980, 374, 446,
+    1075, 413, 239, 839, 839, 854, 92, 501, 1125, 1184, 18, 636, 1179, 583, 916, 480,
+    410, 643, 545, 6, 583, 1160, 341, 1109, 134, 1200, 1183, 201, 647, 6, 645, 253,
+    815, 669, 544, 643, 140, 1270, 742, 742, 1160, 1166, 68, 1268, 526, 526, 1196, 299,
+    590, 660, 128, kNoPinyin, 111, 646, 545, 410, 1145, 871, 111, 435, 470, 412, 938, 1179,
+    571, 688, 649, 1014, 475, 316, 316, 316, 320, 1208, 1101, 440, 1140, 958, 884, 1105,
+    128, 1096, 453, 320, 440, 826, 431, 826, 1249, 240, 814, 437, 231, 1232, 437, 434,
+    950, 487, 433, 528, 309, 216, 1249, 155, 320, 441, 451, 1201, 441, 1162, 604, 1105,
+    1249, 1105, 1105, 166, 203, 854, 404, 404, 404, 264, 950, 567, 635, 404, 567, 280,
+    1000, 53, 226, 460, 929, 1177, 1178, 927, 404, 283, 1162, 953, kNoPinyin, 80, 1238, 850,
+    555, 810, 19, 198, 880, 300, kNoPinyin, 1218, 1066, 1252, 227, 491, 1198, 511, 374, 939,
+    100, 1178, 339, 510, 1101, 1066, 822, 1268, 879, 535, 641, 914, 1165, 728, 30, 121,
+    873, 1102, 823, 28, 437, 1199, 300, 18, 1102, 781, 1269, 1302, 264, 256, 1255, 128,
+    435, 1162, 524, 54, 116, 467, 1091, 402, 1208, 475, 21, 841, 1262, 1265, 1211, 1077,
+    737, 1179, 955, 1282, 807, 1047, 242, 493, 1258, 807, 301, 766, 20, 17, 1230, 1055,
+    508, 609, 828, kNoPinyin, 404, 37, 65, 1269, 777, 1008, 810, 781, 1006, 1170, 1262, 1238,
+    1166, 37, 383, 709, 1179, 220, 134, 781, 1213, 669, 640, 942, 1155, 139, 853, 662,
+    146, 436, 300, 1248, 1280, 206, 104, 677, 711, 536, 301, 766, 30, 754, 585, 680,
+    345, 823, 470, 1069, 20, 1066, 1066, 17, 467, 1297, 761, 1253, 27, 27, 220, 709,
+    470, 535, 594, 441, kNoPinyin, 1192, 544, 723, 67, 1230, 822, 387, 535, 950, 451, 1265,
+    722, 332, 332, 858, 965, 189, 1221, 495, 133, 1123, 94, 420, 796, 1175, 948, 680,
+    70, 132, 343, 1270, 535, 259, 259, 1269, 837, 10, 732, 1263, 321, 449, 511, 240,
+    890, 1032, 581, 1238, 617, 231, 1070, 475, kNoPinyin, 469, 1270, 605, 1158, 1282, 1004, 1123,
+    694, 208, 448, 1264, 434, 420, 1153, kNoPinyin, 3, 1066, 740, 195, 68, 329, 1025, 1263,
+    128, 999, 999, 503, 639, 595, 468, 778, 441, 1179, 1041, 925, 742, 1078, 1123, 100,
+    291, 448, 1100, 480, 466, 1044, 532, 431, 1051, 1296, 807, 555, 19, 374, 931, 718,
+    471, 1230, 981, 1173, 475, 74, 413, 75, 1320, 1179, 1242, 617, 983, 1066, 551, 997,
+    31, 441, 415, 211, kNoPinyin, 1079, 839, 779, 937, 581, 661, 641, 301, 26, 470, 211,
+    1096, 4, 472, 1208, 1304, 125, 160, 451, 1050, 43, 682, 712, 740, 1310, 1097, 1102,
+    1110, 128, 223, 914, 608, 845, 314, 258, 954, 229, 807, 220, 1251, 358, 434, 1016,
+    818, 815, 755, 956, 822, 588, 1175, 1158, 475, 1264, 573, 343, 1178, 431, 927, 1265,
+    619, 81, 1011, 122, 64, 450, 1026, 507, 1058, 1162, 195, 1306, 468, 1030, 823, 502,
+    24, 953, 450, 603, 361, kNoPinyin, kNoPinyin, 1268, 205, kNoPinyin, 1110, 913, 349, 780, 1205, 742,
+    441, 1261, 463, 440, 1199, 1161, 528, 688, 393, 887, 784, 1084, 904, 1308, 1144, 656,
+    1024, 718, 100, 950, 1304, 1263, 1176, 973, 391, 54, 1165, 415, 1162, 1314, 9, 1140,
+    1158, 1097, 500, 149, 433, 1026, 537, 539, 128, 484, 463, 463, 1051, 450, 420, 328,
+    138, 976, 936, 1125, 1203, 823, 1173, 100, 1238, 38, 1169, kNoPinyin, kNoPinyin, 545, 1091, 841,
+    108, 320, 598, 1304, 328, 448, 336, 841, 1192, 863, 139, 133, 1248, 997, 996, 68,
+    146, 885, 47, 192, 913, 500, 1169, 211, 1267, 737, 1123, 440, 983, 851, 318, 1112,
+    976, 912, 456, 660, 264, 160, 742, 925, 1004, 451, 1013, 759, 28, 196, 567, 1016,
+    402, 1270, 1070, 1107, 822, 1091, 828, 1028, 1261, 264, 1102, 742, 858, 101, 1241, 321,
+    1100, 267, 938, 491, 938, 955, 26, 1169, 63, 983, 1008, 903, 110, 999, 576, 135,
+    155, 361, 66, 292, 962, 221, 817, kNoPinyin, 1242, 570, 1013, 131, 349, 604, 615, 598,
+    1304, 309, 404, 1238, 157, 1015, 408, 184, 683, 668, 443, 353, 1187, 1268, 16, 1270,
+    720, 628, 927, 508, 955, 1000, 1055, 448, 667, 668, 1258, 926, 503, 789, 445, 1180,
+    336, 822, 578, 433, 1184, 474, 793, 793, 551, 254, 1113, 893, 530, 1221, 1179, 1153,
+    127, 127, 901, 694, 392, 977, 824, 417, 196, 1319, 712, 583, 1265, 420, 1289, 448,
+    434, 90, 205, 205, 122, 67, 121, 475, 1118, 575, 43, 301, 833, 67, 192, 1297,
+    1287, 1068, 810, 841, 254, 712, kNoPinyin, 1123, 603, 448, 181, 1004, 374, 833, 1282, 441,
+    312, 1190, 557, 534, 603, 927, 1297, 1230, 810, 168, 432, 208, 1000, 90, 843, 459,
+    415, 450, 839, 518, 204, 1102, 322, 784, 70, 18, 470, 1175, kNoPinyin, kNoPinyin, 984, 649,
+    434, 1006, 1297, 211, 1132, 545, 76, 469, 1173, 891, 1175, 1175, 709, 1097, 433, 63,
+    723, 320, 1270, 451, 535, 668, 442, 1123, 581, 1008, 26, 984, 603, 619, 873, 1268,
+    758, 1166, 559, 903, 955, 1221, 712, 1112, 480, 431, 567, 539, 374, 1185, 602, 594,
+    822, 822, 1221, 822, 544, 908, 1184, 638, 871, 108, kNoPinyin, 181, 1123, 938, 614, 480,
+    649, 565, 1221, 605, 1008, 1314, 567, 223, 1070, 208, 448, 475, 545, 567, 692, 1267,
+    356, 355, 814, 1127, 810, 992, 952, 495, 1194, 308, 1178, 331, 310, 28, 282, 1266,
+    68, 223, 510, 662, 1101, 340, 384, 94, 1121, 650, 146, 321, 219, 1143, 449, 662,
+    124, 466, 1263, 258, 1200, 134, 16, 27, 1143, 449, 258, 571, 720, 51, 114, 225,
+    258, 1179, 312, 910, 499, 1163, 254, 816, 242, 1121, 258, 449, 459, 1165, 1107, 661,
+    958, 4, 830, 4, 1265, 219, 1263, 299, 958, 576, 853, 1136, 1104, 448, kNoPinyin, 448,
+    1297, 1179, 570, 51, 567, 1121, 1121, 1089, 1149, 815, 815, 1242, 62, 475, 1242, kNoPinyin,
+    285, 28, 28, 544, 1200, 544, 1086, 242, 943, 578, 438, 402, 1123, 438, 1200, 1261,
+    449, 1097, 1048, 146, 454, 134, 1181, 301, 826, 1248, 854, 1297, 1248, 250, 1297, 977,
+    1126, 1297, 1297, 839, 582, 1297, 146, 250, 1280, 279, 1125, 376, 1199, 947, 773, 1195,
+    kNoPinyin, 763, 815, 1246, 634, 617, 773, 781, 590, 299, 281, 1145, 457, 457, 709, 1310,
+    1256, 1178, 590, 931, 442, kNoPinyin, 1178, 815, 1270, 275, 789, 275, 1246, 346, 995, 1199,
+    1099, 435, 435, 435, 431, 883, 206, 466, 1269, 1228, 1123, 1032, 1153, 1143, 1143, 1143,
+    313, 374, 1006, 221, 1140, 110, 948, 526, 1165, 948, 1083, 661, 661, 1062, 163, 1100,
+    1210, 40, 12, 1231, 29, 451, 531, 943, 404, 281, 382, 356, 112, 1144, 663, 424,
+    287, 840, 401, 1179, 1102, 1126, 1161, 1231, 281, 1009, 942, 470, 1165, 1221, 65, 1130,
+    1187, 1147, 772, 1262, 585, 163, 382, 640, 1322, 670, 54, 1142, 424, 1253, 1305, 950,
+    950, 1201, 286, 231, 635, 710, 114, 1088, 238, 5, 65, 12, 1277, 593, 1112, 526,
+    1034, 117, 948, 418, 418, 1144, 528, 1140, 448, 456, 1269, 456, 929, 1043, 395, 1163,
+    307, 1116, 924, 1120, 1172, 1209, 420, 372, 374, 480, 1078, 1113, 531, 1277, 1102, 946,
+    944, 72, 1258, 1257, 1101, 374, 423, 382, 124, 1078, 1029, 1297, 1317, 1276, 812, 458,
+    1102, 926, 1178, 1105, 843, 816, 457, 355, 1262, 1179, 1270, 9, 1078, 582, 574, 112,
+    1082, 1120, 1222, kNoPinyin, 1144, 1146, 1177, 1107, 1209, 420, 301, 662, 528, 385, 1187, 246,
+    1086, 957, 843, 636, 687, 441, 738, 10, 1165, 163, 1169, 1000, 456, 663, 448, 485,
+    318, 1093, 115, 817, 382, 1163, 567, 6, 435, 356, 642, 1222, 1125, 382, 678, 670,
+    173, 710, 1250, 423, 37, 374, 1145, 152, 576, 1110, 206, 458, 793, 582, 1062, 1104,
+    1179, 435, 419, 1007, 1175, 1175, 567, 1009, 1043, 1120, 286, 840, 1256, 382, 1179, 1117,
+    1130, 917, 448, 37, 459, 1163, 6, 1175, 890, 958, 645, 1152, 1171, 813, 567, 124,
+    526, 231, kNoPinyin, 1163, 431, 602, 1102, 884, 593, 692, 614, 605, 924, 1014, 1162, 144,
+    1206, 1206, 853, 1175, 330, 1175, 401, 384, 955, 91, 91, kNoPinyin, 630, 97, 98, 1026,
+    1317, 85, 1143, 423, 1183, 837, 287, 782, 1208, 1196, 894, 778, 28, 300, 586, 285,
+    854, kNoPinyin, 744, 1035, 976, 1263, 549, 549, 471, 663, 416, 1083, 1062, 1253, 432, 814,
+    1184, 1303, 1083, 1043, 549, kNoPinyin, 645, 593, 678, 216, 1087, 670, 42, 1239, 958, 1279,
+    kNoPinyin, 1278, 877, 19, 805, 259, 259, 210, 567, 850, 432, 463, 50, 1138, 1040, 172,
+    919, kNoPinyin, 1214, 858, 822, 1199, 310, 1098, 100, 925, 1153, 275, 1101, 1301, 566, 1133,
+    80, 188, 879, 932, 1066, 221, 1252, 631, 134, 1179, 339, 331, 247, 1177, 816, 958,
+    314, 1033, kNoPinyin, kNoPinyin, kNoPinyin, 541, kNoPinyin, 631, 1165, 623, 657, 979, 1203, 376, 286, 38,
+    451, 238, 318, 1170, 1110, 145, 163, 752, 955, 408, 1126, 141, 1281, 141, 980, 29,
+    980, 433, 1208, 456, 334, 432, 634, 782, 51, 1082, 14, 279, 288, 1179, 300, 687,
+    1102, 404, 1156, 242, 1153, 1262, 1168, 582, 897, 263, 638, 1256, 362, 1267, 173, 1212,
+    kNoPinyin, 242, 955, 1228, kNoPinyin, 567, kNoPinyin, 442, 128, kNoPinyin, 826, 291, 687, 1118, 1110, 511,
+    801, 1177, 1104, 1267, 345, 1118, 439, 436, 469, 299, 670, 1179, 1175, 1175, 950, 720,
+    50, 260, 1177, 586, 65, 709, 536, 384, 759, 276, 1271, 203, 170, 1164, 299, 26,
+    674, 310, 814, 868, 887, 636, 1253, 980, 1260, 1107, 1197, 939, 356, 1069, 1324, 687,
+    723, 1192, 220, 1268, 1238, 101, 206, 337, kNoPinyin, 466, 15, 300, 441, 67, 260, 497,
+    685, 1281, 51, 591, 105, 1241, 979, 1281, 770, 950, 345, 101, 1170, 475, 466, 950,
+    1267, 591, 638, kNoPinyin, 884, 1241, kNoPinyin, 55, 1249, 451, 593, 240, 602, kNoPinyin, 567, 544,
+    1192, 958, 1153, 965, 817, 1261, 814, 567, 1178, 1115, 1263, 567, 988, 341, 487, 64,
+    878, 1121, 68, 878, 66, 1300, 140, 1179, 451, 1142, 1278, 442, 1317, 268, 269, 1196,
+    272, 332, 495, 553, 1246, 567, kNoPinyin, 1165, 384, 325, 1269, 950, 321, 1216, 605, 300,
+    451, 391, 356, 1017, 352, 1085, 526, 890, 10, 7, 473, 1177, 1296, 511, 1270, 847,
+    1043, 911, 911, 413, 451, 466, 1151, 260, 1292, 1199, 1221, kNoPinyin, 1184, kNoPinyin, kNoPinyin, 1249,
+    1156, 694, 1261, 208, 814, 831, 408, 519, 444, 1288, 1153, 999, 919, 1261, 38, 1039,
+    341, 459, 68, 43, 300, 896, 1044, 475, 1102, 548, 591, 291, 814, 1090, 478, 312,
+    180, 572, 850, 1041, 1196, 638, 31, 595, 777, 1288, 221, 1144, 1051, 1229, 15, 340,
+    51, 219, 372, 1301, 1267, 879, 40, 329, 442, 415, 1078, 740, 437, 1033, 435, 1118,
+    617, 425, 931, 96, 288, 980, 647, 1099, 565, 565, 243, 95, 1186, 999, 468, 1023,
+    1125, 532, 1297, 955, 108, 278, 1086, 459, 565, 64, kNoPinyin, kNoPinyin, 1017, 1270, 541, 569,
+    441, 1297, 586, 565, 817, 66, 1293, 173, 825, 652, 815, 815, 81, 359, 109, 1020,
+    285, 755, 33, 808, 424, 1303, 128, 1228, 433, 567, 778, 1201, 1201, 340, 425, 240,
+    1013, 314, 1082, 221, 1103, 276, 127, 1249, 816, 1202, 1162, 1201, 857, 1179, 917, 878,
+    160, 561, 814, 1297, 300, 497, 541, 1306, 1306, 1296, 347, 288, 288, 123, 847, 720,
+    1078, 362, 604, 380, 450, 1178, 140, 469, 468, 128, 1322, 572, 826, 1268, 1290, 1155,
+    467, 38, 446, 1297, 1300, 62, 778, 236, 145, kNoPinyin, kNoPinyin, kNoPinyin, 441, 353, 1105, 245,
+    825, kNoPinyin, kNoPinyin, kNoPinyin, 613, 1267, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, 780, 1248, kNoPinyin, 1068, 917, 258,
+    1173, 298, 1086, 1084, 250, 438, 1303, 440, 1177, 942, 1103, 1163, 1162, 152, 1249, 163,
+    1200, 384, 1238, 1097, 786, 51, 1168, 431, 1140, 900, 1165, 539, 1161, 42, 425, 528,
+    453, 528, 977, 291, 1122, 1068, 1270, 442, 678, 636, 145, 404, 402, 571, 561, 1040,
+    687, 1199, 1195, 638, 981, 1147, 1147, 1184, 1261, 786, 1175, 433, 451, 1175, 145, 973,
+    1199, 177, 1084, 638, 221, 433, 451, 485, 849, 1185, 887, 391, 597, 555, kNoPinyin, kNoPinyin,
+    798, kNoPinyin, 309, 1009, 545, 1210, 1199, 126, 616, 469, kNoPinyin, kNoPinyin, kNoPinyin, 1125, 438, 1179,
+    1248, 302, 685, 651, 548, 884, 339, 442, 469, 1003, 1170, 1261, 32, 919, 1203, 1301,
+    663, 988, 439, 1169, 451, 418, 313, 285, 1241, 823, 623, 997, 1203, 1125, 884, 948,
+    1267, 184, 1210, 1040, 590, 884, 1013, 863, 1242, 977, 946, 1004, 500, 1102, 340, 814,
+    495, 318, 996, 759, 1016, 321, 1153, 223, 734, 433, 976, 336, 160, 826, 101, 824,
+    410, 638, 1143, 316, 317, 1297, 1069, kNoPinyin, 1167, 223, 438, 442, 1317, kNoPinyin, kNoPinyin, 62,
+    1278, kNoPinyin, 1103, 816, 569, 423, 1191, 825, 362, 309, 309, 1055, 408, 180, 917, 184,
+    47, 1196, 402, 444, 404, 415, 530, 1179, 720, 317, 490, 353, 353, 91, 628, 455,
+    221, 1288, 555, 548, 124, 173, 565, 1137, 843, 968, 276, 1042, 349, 432, 999, 558,
+    603, 572, 651, 597, 117, 988, 497, 143, 1013, 55, 604, 463, 958, 1238, 955, 1250,
+    641, 668, 716, 1167, 1033, 778, 1281, 919, 1102, 858, 391, 440, 173, kNoPinyin, kNoPinyin, 827,
+    kNoPinyin, 1184, 270, 1127, 1268, 831, 1315, 173, 811, 958, 408, 530, 1261, 1318, 1208, 1248,
+    1102, 1153, 226, 271, 312, 668, 1100, 830, 694, 584, 590, 831, 1113, 899, 276, 1248,
+    1067, 553, 1210, 974, 1059, 127, 1013, 645, 468, 128, 988, 475, 475, 1008, 423, 432,
+    741, 1117, 1068, 724, 896, 1278, 156, 1235, 288, 847, 868, 391, 96, 337, 591, 554,
+    317, 144, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, 433, 241, kNoPinyin, 603, kNoPinyin, kNoPinyin, 1203, 1004, 955, 443,
+    1009, 583, 730, 1182, 1103, 995, 925, 1317, 1145, 127, 313, 467, 1317, 1179, 839, 812,
+    1161, 557, 291, 422, 209, 435, 995, 70, 51, 235, 145, 1282, 356, 433, 452, 438,
+    843, 1260, 441, 827, 212, 1178, 56, 980, 935, 583, kNoPinyin, 101, 645, 1181, 1017, 1006,
+    652, 815, kNoPinyin, 62, 431, 435, 822, 649, 723, 1176, 318, 442, 1183, 268, 844, 1162,
+    815, 651, 1256, 356, 163, 432, 528, 803, 217, 144, kNoPinyin, 652, 1194, 1270, 352, 822,
+    558, 558, 903, 603, 567, 182, 616, 660, 423, 747, 616, 451, 317, 245, 1203, 567,
+    286, 1297, 984, 569, kNoPinyin, 144, kNoPinyin, 1278, 602, 1161, 567, 1278, 126, 451, 264, 986,
+    410, 720, 1201, 593, 543, kNoPinyin, 1112, kNoPinyin, 469, 1118, 586, 1184, 440, 1182, 1195, 1185,
+    1114, 730, 68, 109, 544, 469, 967, 938, 1085, 175, 858, 854, kNoPinyin, kNoPinyin, 1201, 613,
+    566, 1222, 605, 208, 475, kNoPinyin, 545, 544, 1280, 557, 566, 22, 691, 1201, 586, kNoPinyin,
+    825, 172, 412, 1126, 1199, 1201, 822, 747, 1140, 116, 146, 131, 486, 1179, 475, 1103,
+    1140, 1109, 1201, 519, 548, 521, 976, 1102, 5, 1176, 814, 1140, 133, 838, 521, 488,
+    521, 488, 152, 921, kNoPinyin, 1180, 1126, 1122, 1199, 825, 1118, 1177, 320, 1098, 1011, 456,
+    747, 401, 1026, 412, 1140, 774, 1102, 1121, 1140, 1102, kNoPinyin, 371, 146, 1179, 488, 1199,
+    168, 412, 1269, 1266, 171, 75, 1100, 815, 75, 75, 1074, 470, 823, 132, 916, 133,
+    916, 1272, 995, 995, 567, 195, 1199, 567, 353, 202, 202, 978, 440, 1258, 670, 670,
+    1170, 670, 179, 1164, 1029, 943, 203, 928, 1143, 1154, 955, 84, 475, 791, 821, 852,
+    988, 843, 1211, 571, 1179, 297, 1268, 1175, 84, 424, 204, 433, 1175, kNoPinyin, 1211, 1088,
+    142, 63, 1026, 456, 928, 1181, 227, 180, 423, 183, 1179, 204, 247, 443, 571, 63,
+    245, kNoPinyin, 440, 955, 747, 250, 1281, 1180, 845, 1179, 919, 863, 498, 1169, 480, 226,
+    422, 422, 339, 863, 432, 1179, 747, 422, 250, 1176, 1118, 1099, 349, 677, 639, 639,
+    5, 1323, 245, 1201, 50, 51, 51, 782, 782, 51, 109, 634, kNoPinyin, kNoPinyin, 811, kNoPinyin,
+    436, 1246, 904, 678, 1069, 1153, 270, 884, 1112, 468, 676, 380, 850, 243, kNoPinyin, 1010,
+    771, 468, 258, 187, 48, 908, kNoPinyin, 636, 992, 955, 1198, 1069, 384, 442, 1004, 908,
+    616, 676, 634, 1043, 885, 114, 812, 613, 1246, 915, 1246, 645, 613, 854, 231, 950,
+    220, 661, 475, 631, 817, 793, 684, 817, 210, 1110, 151, 287, 883, 700, kNoPinyin, 300,
+    939, 238, 842, 817, 1180, 1102, 370, 1166, 7, 1158, 500, 842, 1158, 238, 206, 618,
+    842, 1166, 1209, 1209, 971, kNoPinyin, 1265, 64, 1192, 209, kNoPinyin, 555, 710, 1064, 278, 355,
+    1039, 1267, 850, 62, 1231, 653, 181, 423, 227, 374, 103, 1297, 154, 1077, 278, 203,
+    1105, 1066, 631, 850, 817, 927, 757, 374, 822, 1098, 1098, 1154, 979, 891, 332, 443,
+    132, 1098, kNoPinyin, kNoPinyin, 1012, 1267, 132, 822, 651, 339, 1080, 845, 458, 897, 478, 394,
+    1007, 859, 433, 54, 54, 313, 1091, 1271, 279, 1134, 475, 377, kNoPinyin, 817, 288, 1143,
+    1143, 841, 1177, 1097, 1210, 1203, 376, 1162, 124, 124, 206, 1195, 256, 404, 431, 814,
+    678, 887, 638, 1004, 653, 1101, 135, 1027, 50, 919, 1269, 773, 761, 1291, 1213, 334,
+    590, 638, 1230, 291, 750, 567, 609, 87, 292, 1085, 404, 670, 640, 958, 467, 1221,
+    1066, 1067, 1067, 384, 567, 650, 1177, 271, 286, 1195, 1028, 1270, 1255, 337, 1246, 1161,
+    977, 526, 461, 470, 1125, 850, 1176, 436, 1271, 858, 68, 423, 651, 41, 1297, 146,
+    555, 1196, 337, 394, 310, 273, 635, 979, 401, 801, 171, 278, 132, 988, 725, 127,
+    586, 769, 67, 817, 979, 708, 468, 1208, 1281, 943, 559, 1147, 1151, 299, 761, 662,
+    1007, 1164, 434, 1192, 349, 47, 1149, 593, 602, kNoPinyin, 68, 1125, 802, 1230, 457, 1181,
+    1274, 433, 1179, 420, 421, 1316, 128, 1180, 1085, 400, 442, 1165, 581, 979, 435, 268,
+    1131, 300, 902, 1000, 1269, 1180, 1099, 1104, 495, 1278, 445, 615, kNoPinyin, 10, 240, 1177,
+    673, 558, 1176, 650, 858, 454, 670, 1086, 1119, 1125, 394, 1143, 976, 523, 1017, 837,
+    470, 269, 1274, 892, 801, 1153, 1134, 1270, 350, 413, 663, 429, 1070, 821, 757, 1098,
+    855, 590, 1179, 437, 459, 824, 443, 446, 128, 947, 1297, 94, kNoPinyin, 519, 435, 590,
+    110, 425, 403, 730, 1153, 456, 581, 850, 1086, 1260, 480, 374, 31, 631, 1297, 1195,
+    1102, 68, 243, 1078, 394, 1179, 812, 1186, 545, 382, 550, 373, 566, 328, 300, 1099,
+    571, 164, 292, 1179, 1201, 1043, 552, 369, 456, 437, 135, 1093, 639, 992, 127, 773,
+    1113, 942, 1051, 533, 796, 720, 374, 457, 1118, 938, 712, 1050, 1192, 1121, 1111, 1041,
+    262, 988, 1062, 471, 96, 1026, 567, 972, 979, 559, 972, 1016, 245, 554, 541, 569,
+    1085, 1095, 1210, 415, 219, kNoPinyin, 899, 442, 1251, 916, 300, 349, 1133, 954, 966, 1156,
+    168, 1252, 1175, 505, 1097, 372, 1066, 238, 384, 1095, 467, 313, 572, 424, 1004, 1296,
+    226, 837, 213, 473, 1300, 1102, 1169, 815, 339, 362, 374, 582, 1014, 1274, 779, 382,
+    112, 956, 814, 279, 134, 604, 696, 468, 1017, 174, 559, 1270, 778, 284, 980, 1029,
+    784, 206, 1201, 708, 1198, 604, 313, 651, 459, 586, 609, 1181, 187, 854, 410, 1201,
+    712, 939, 790, 164, 1073, 1202, 541, 427, 842, 1160, 824, 1027, 657, 1269, 1182, 651,
+    41, 1202, 1091, 876, 283, 842, 1202, 499, 435, 938, 1202, kNoPinyin, 604, 1302, 245, kNoPinyin,
+    442, 662, 784, kNoPinyin, 1199, 1202, 941, 942, 887, 415, 1280, 441, 738, 1199, 850, 1040,
+    854, 247, 292, 1238, 68, 1097, 1095, 221, 1084, 1088, 890, 1125, 94, 1087, 320, 315,
+    1162, 394, 1147, 650, 499, 634, 1184, 1162, 1195, 393, 657, 1132, 639, 1216, 425, 685,
+    528, 948, 264, 757, 638, 571, 817, 817, 638, 1028, 177, 1085, 83, 1054, 653, 423,
+    670, 1142, 433, 775, 440, 441, 402, 294, 1114, 1179, 1183, 1249, 948, 450, 128, 417,
+    1011, 1199, 51, 662, 947, 1051, 943, 1192, 856, 1273, kNoPinyin, 448, 448, kNoPinyin, 1180, 1012,
+    593, 431, 1203, 688, 30, 1196, 858, 160, 574, 109, 1161, 164, 720, 1300, 1076, 947,
+    629, 1185, kNoPinyin, 530, kNoPinyin, 442, 1143, 617, 353, 309, kNoPinyin, kNoPinyin, 802, 456, 356, 1013,
+    1203, 1000, 1203, 569, 1170, 647, 1294, 944, 500, 1007, 197, 1070, 589, 334, 913, 663,
+    1241, 948, 1179, 609, 622, 812, 1085, 567, 80, 1101, 1102, 1088, 826, 1230, 947, 988,
+    1176, 1261, 983, 1210, 1139, 1180, 884, 427, 988, 988, 710, 1004, 947, 892, 1084, 761,
+    146, 144, 762, 1093, 87, 660, 384, 223, 382, 418, 1105, 1300, 219, 1269, 1131, 301,
+    451, 406, 320, 1301, 1016, 1022, 992, 50, 449, 423, 358, 1181, 317, 593, 1270, 1163,
+    938, 629, 1187, 164, 618, 546, 605, kNoPinyin, 62, 1008, 1201, 984, 404, 51, 55, 1270,
+    444, 510, 942, 928, 218, 651, 16, 603, 403, 401, 1195, 110, 278, 1191, 358, 629,
+    845, 1199, 789, 433, 1156, 448, 814, 1104, 435, 604, 617, 593, 455, 361, 174, 599,
+    1268, 309, 827, 565, 1162, 91, 449, 173, 164, 1055, 750, 1022, 1174, 1103, 651, 1013,
+    670, 928, 374, 569, 545, 1070, 565, 823, 292, 1145, 1176, 630, 1302, 632, 490, 1004,
+    777, 958, 1251, 1250, 136, 1143, 415, 535, 442, 1160, 157, 576, 186, 1024, 1167, 443,
+    174, 1186, 394, 1153, 958, 349, 1185, 1118, kNoPinyin, kNoPinyin, 1143, 571, 1270, 1085, 784, 475,
+    449, 802, 209, 423, 451, 1100, 752, 433, 758, 354, 1118, 823, 823, 1102, 604, 1105,
+    998, 256, 417, 662, 899, 988, 553, 1261, 1271, 1179, 219, 1076, 206, 1009, 117, 1153,
+    530, kNoPinyin, 934, 1051, 1278, 910, 386, 50, 925, 109, 109, 957, 1043, 812, 582, 1085,
+    916, 916, 128, 462, 128, 408, 446, 554, 122, 312, 188, 392, 977, 958, 778, 374,
+    1210, 592, 396, 300, 382, 384, 1110, 442, 925, 1105, kNoPinyin, kNoPinyin, 544, kNoPinyin, 1199, 583,
+    653, 1228, 207, 414, 1230, 1125, 1201, 566, 950, 1149, 586, 630, 1300, 1190, 519, 86,
+    571, 226, 1175, 18, 413, 1261, 109, 630, 205, 206, 1179, 995, 784, 470, 1004, 839,
+    432, 1297, 569, 730, 360, 456, 288, 916, 433, 992, 423, 145, 1004, 980, 235, kNoPinyin,
+    1280, 543, 62, 569, 650, 947, 958, 651, 725, 1185, 1185, 645, 456, 815, 784, 435,
+    380, 890, 1316, 1097, 1016, 1183, 1182, 253, 170, 431, 459, 546, 480, 6, 811, 1297,
+    1085, 62, 339, 823, 1131, kNoPinyin, 535, 286, kNoPinyin, kNoPinyin, 442, 1086, 615, 1222, 618, 567,
+    1194, 1167, 603, 979, 451, 1187, 245, 1082, 420, 1125, 759, 941, 55, 109, 670, 590,
+    440, 813, 916, 128, 339, 62, 431, 1113, 602, 838, 374, 1185, 1190, 567, 459, 1118,
+    1185, 994, 1085, 1125, 410, 382, 1278, 593, 543, 253, 276, 402, 543, kNoPinyin, kNoPinyin, 1185,
+    649, 435, 571, 442, 1186, 290, 582, 1179, 440, 1208, 109, 203, 869, 441, 544, 276,
+    969, 1202, 1297, 291, 938, 558, 544, 174, 854, 1190, 823, 273, 349, 863, 1163, 382,
+    kNoPinyin, 902, 1222, 605, 1163, 565, 650, 927, 1008, 208, 448, 110, kNoPinyin, 382, 22, 1279,
+    545, 544, 692, 1076, 605, 1153, 1112, 1163, 312, 1163, 1201, 430, 55, 660, 350, 215,
+    420, 1118, 1118, kNoPinyin, 394, 586, 1229, 1287, 465, 1241, 1125, 134, 1297, 1216, 1216, 86,
+    1165, 817, 1271, 288, 728, 461, 1089, 805, 1179, 602, 159, 781, 486, 761, 1161, 486,
+    765, 678, 118, 578, 356, 493, 1063, 350, 1126, 1270, kNoPinyin, 350, 1086, 829, kNoPinyin, 197,
+    1107, 1264, 1279, 499, 1256, 300, 20, 260, 260, 588, 1297, 1147, 470, 1011, 769, 461,
+    767, 1006, 1006, 65, 1166, 1042, 371, 1281, 1241, 225, 1087, 948, 571, 134, 418, kNoPinyin,
+    401, 976, 546, 458, 448, 1143, 1131, 860, 581, 415, 1165, 1118, 1137, 1112, 1181, 1098,
+    1274, 1169, 950, 1084, 1043, 1151, 1216, 486, 393, 615, 1107, 1279, 1146, 1264, 805, 1160,
+    422, 350, 1260, 420, 495, kNoPinyin, 276, 931, 1175, 423, kNoPinyin, 1015, 456, 876, kNoPinyin, 1102,
+    300, 461, 122, 812, 458, 1297, 1041, 1077, 369, 777, 549, 925, 401, 291, 134, 884,
+    402, kNoPinyin, 956, 385, 1152, 513, 475, 1118, 1102, 1160, 374, 1289, 480, 221, 1125, 433,
+    1101, kNoPinyin, kNoPinyin, 372, 1163, 415, 643, 468, 140, 40, 288, 584, 531, 427, 1062, 1103,
+    187, 1099, 393, 470, 301, 1097, 446, 173, 294, 800, 846, 900, 1103, 847, 1129, 1297,
+    1163, 1163, 1179, 475, 1201, 316, 867, 782, 339, kNoPinyin, 943, 115, 931, kNoPinyin, kNoPinyin, 328,
+    kNoPinyin, 124, 385, 529, 1271, 250, 1106, 420, 294, 571, 1144, 1130, 417, 448, 440, 51,
+    1184, 1280, 1086, 1054, 1030, 1102, 738, 738, 109, 1160, 461, 461, 1201, 640, 919, 1087,
+    1175, 1129, 847, 888, 638, 415, 1142, 1256, 1084, 276, 850, 995, 1165, 581, 1280, kNoPinyin,
+    319, 341, 34, 402, 1209, 1106, kNoPinyin, kNoPinyin, 52, 336, 1061, 1013, 118, 925, 265, 68,
+    418, 1123, 1105, 1101, 1103, 1212, 384, 385, 1102, 1210, 1135, 683, 927, kNoPinyin, 1171, 1152,
+    651, 569, 1185, 1100, 884, kNoPinyin, kNoPinyin, 829, 589, 1102, 51, 55, 1304, 604, 440, 956,
+    1179, 597, 291, 992, 1179, 1042, 475, 1303, 1212, 404, 1177, 1270, 16, 1087, 576, 374,
+    747, 876, 461, 630, kNoPinyin, 928, 183, 1235, 440, 1102, 1102, 1102, 1179, 1121, 134, 417,
+    110, 1175, 823, 867, 1163, 1111, 831, 1320, 215, 256, 939, 446, 288, 977, 577, 1201,
+    582, 1043, 931, 287, 276, 1163, 1153, 546, 639, 1015, 1176, 458, 643, kNoPinyin, kNoPinyin, 1185,
+    1201, 1179, 1149, 544, 1007, 1229, 86, 995, 1102, 863, 173, 569, 422, 1279, 1125, 586,
+    1084, 1179, 1123, 1256, 423, kNoPinyin, kNoPinyin, 544, 890, 1112, 495, 1152, 456, 140, 212, 1171,
+    385, 546, 55, 884, 567, 670, 37, 900, 616, 539, 16, 1154, 526, 976, kNoPinyin, 567,
+    602, 475, 578, 1163, 1102, 1125, 593, 1175, kNoPinyin, 870, 1208, 546, 174, 475, 1043, 349,
+    kNoPinyin, 122, 649, 1014, 546, 1279, kNoPinyin, 586, 183, 1201, 1283, kNoPinyin, 752, 1264, 767, 127,
+    1203, 6, 1087, kNoPinyin, 475, 475, 302, 1173, 22, 230, 1173, 1169, 1311, 968, 269, 827,
+    156, 320, 1223, 231, 826, 1191, 827, 788, 29, 761, 932, 440, 755, 245, 155, 1047,
+    1239, 52, 231, 32, 68, 155, 1196, kNoPinyin, 245, 1156, 130, 727, kNoPinyin, 799, 463, 673,
+    1067, 677, 552, 879, 631, 279, 634, 678, 314, 1101, 1163, 320, 40, 979, 442, 339,
+    1197, 320, 943, 677, 220, 822, 860, 858, 1302, 1020, 1102, 631, 503, 822, 1099, 340,
+    1102, 565, 565, 808, 432, 314, 1268, 41, 858, 898, 245, 470, 436, 440, 291, 785,
+    497, 468, 496, 144, 1105, 40, 615, 453, 621, 908, 1087, 565, 254, 1043, kNoPinyin, 445,
+    kNoPinyin, 567, 245, 581, 782, 791, 37, 1102, 139, 1087, 528, 139, 859, kNoPinyin, 20, 278,
+    850, 434, 80, 167, 10, 320, 1289, 351, 623, 1195, 493, 68, 399, 1156, 1181, 412,
+    1289, 1211, 524, 728, 219, 842, 1273, 678, 40, 781, 468, 708, 943, 767, 1107, 1067,
+    402, 586, 286, 781, 709, 17, 1197, 335, 1208, 467, 206, 805, 339, 1112, 723, 413,
+    388, 448, 384, 1256, 433, 1154, 925, 1004, 884, 954, 1042, 553, 245, 1107, 947, 406,
+    1264, 1201, 996, 1199, 51, 631, 1104, 473, 565, 1107, 1181, 989, 548, 40, 1270, 1161,
+    919, 567, 374, 1112, 457, 755, 283, 1169, 22, 815, 708, 55, 1183, 541, 1103, 440,
+    826, 531, 1160, 362, 1305, 649, 112, 1176, 1270, 1264, 1156, 646, 79, 180, 938, kNoPinyin,
+    kNoPinyin, 613, 402, 1303, 435, 1086, 291, 1095, 1203, 1130, 1278, 633, 1087, 1203, 1113, 1054,
+    1158, 694, 1122, 436, 398, 52, 1195, 1195, 638, 1238, 1169, 996, 68, 663, 406, 1203,
+    983, 623, 1203, 201, 1201, 947, 380, kNoPinyin, 1179, 1261, 158, 380, 630, 459, 444, 676,
+    1250, 109, 16, 16, 380, 184, 288, 475, 51, 51, 417, 811, 582, 1201, 1043, 1171,
+    576, 976, 1118, kNoPinyin, kNoPinyin, 1103, 321, 473, 245, 423, 519, 1112, 1125, 1004, 1112, 1152,
+    723, 797, 431, 734, 645, 581, 694, 351, 954, 602, 1003, 1113, 649, 869, 412, 694,
+    613, 1112, 815, 475, 1145, 658, 1300, 618, 602, 1201, 988, 1081, 850, 305, 233, 555,
+    19, 432, 394, 221, 154, 310, 465, 1199, 434, 1199, 1165, 622, 331, 1100, 299, 661,
+    453, 1158, 62, 54, 33, 1208, 475, 1211, 475, 1077, 440, 638, 205, 782, 1086, 413,
+    1113, 826, 586, 203, 1179, 8, 801, 226, 300, 1145, 1104, 67, 171, 335, 438, 932,
+    805, 170, 497, 868, 943, 939, 1177, 1311, 436, 661, 925, 591, 51, 1261, 1261, 475,
+    274, 593, 454, 449, 442, 567, 350, 1110, 1274, 332, 1160, 1139, 1165, 1142, 615, 988,
+    1278, 839, 502, 1153, 36, 269, 1117, 1169, 1107, 391, 353, 135, 1143, 28, 773, kNoPinyin,
+    207, kNoPinyin, 425, 1089, 262, 128, 221, 1100, 1099, 128, 480, 638, 40, 1041, 1113, 168,
+    372, 1145, 1161, 850, 859, 548, 566, 1139, 300, 590, 1173, 1102, 586, 567, 456, 569,
+    1000, kNoPinyin, kNoPinyin, 1077, 226, 797, 1248, 187, 661, 1201, 467, 123, 541, 1089, 946, 1085,
+    225, 146, 1297, 772, 127, 403, 815, 264, 531, 112, 815, 46, 1078, 604, 174, 348,
+    1162, 227, 40, 582, 839, 782, 752, 863, 1297, 839, 274, kNoPinyin, 847, 246, 453, 425,
+    1200, 636, 638, kNoPinyin, 1144, 1024, 1130, 203, 887, 661, 1261, 1086, 894, 415, 450, 151,
+    441, 1287, 1165, 571, 858, 1107, 250, 1205, 1173, 695, 402, 1184, 1199, 417, 897, 916,
+    590, kNoPinyin, 884, 1000, 1169, 1088, 1098, 454, 456, 1185, 622, 1016, 590, 1013, 567, 548,
+    353, 1030, 826, 194, 475, 1255, 1169, 6, 62, 1051, 113, 531, 1285, 173, 455, 1176,
+    186, 173, 815, 565, 1186, 1000, 850, 1145, 16, 569, 641, 1250, 1181, kNoPinyin, 1184, 1270,
+    604, 1099, 215, kNoPinyin, 1235, 1153, 854, 209, 582, 576, 847, 988, 417, 353, 811, 458,
+    276, 456, 590, 432, kNoPinyin, 458, 6, 51, 86, 854, 1228, 207, 448, 359, 1010, 423,
+    413, 916, 995, 1028, kNoPinyin, 1199, 456, 602, 62, 954, 1091, 1316, 544, 1104, 435, 1145,
+    894, 431, 309, 557, 245, 567, 1268, 887, 565, 1222, 847, 1258, 353, 995, 539, 593,
+    602, 567, 1222, 546, 1184, 649, 1114, 1102, 349, 212, 1222, 413, 341, 68, 231, 35,
+    404, 1268, 790, 30, 869, 567, 1072, kNoPinyin, 443, kNoPinyin, 277, 775, 281, 205, 1094, 747,
+    kNoPinyin, kNoPinyin, kNoPinyin, 402, 586, 1177, 801, 170, kNoPinyin, 473, 113, 131, kNoPinyin, 209, 646, 808,
+    1292, 801, 52, 1277, 1261, kNoPinyin, 170, 1184, 817, 1111, 598, 221, 747, 645, 1285, 780,
+    582, 1237, 1100, 784, 204, 1094, 1184, 1162, 310, 203, 940, 1028, 1028, 371, 113, 943,
+    843, 939, 110, 110, 895, 943, 986, 917, 1193, 963, 604, 301, 1192, 45, 294, 723,
+    1028, 1195, 438, 939, 1239, 226, 300, 687, 226, 801, 1041, 408, 1041, 859, 1300, 645,
+    51, 815, 592, 1153, 590, 115, 677, 1210, 278, 300, 328, 1028, 453, 453, 859, 1087,
+    300, 1028, 677, kNoPinyin, 761, 443, 1070, 197, 687, 590, 42, 1262, 146, 677, 677, 94,
+    kNoPinyin, 307, 51, 197, 1270, 619, 815, 619, 758, kNoPinyin, 275, 408, 1199, 1199, 677, 480,
+    1179, 590, 1199, 231, 140, 408, 207, 168, 432, 1078, 443, 944, 115, 1056, 557, 432,
+    100, 590, kNoPinyin, 1056, 582, 443, 443, 140, 70, 231, 231, 783, 720, 206, 955, 955,
+    1270, 1177, 156, 684, 233, 50, 451, 576, 314, 320, 466, 1276, 1109, 927, 1140, 745,
+    567, 1165, 126, 1195, 19, 453, 475, 1267, 1106, 187, 51, 1179, 567, 1305, 155, 291,
+    1281, 769, 782, 310, 497, 169, 1125, 815, 205, 1262, 272, 1269, 1022, 467, 433, 286,
+    854, 226, 436, 1111, 1241, 66, 710, 1266, 1190, 459, 858, 136, 1042, 1177, 484, 1086,
+    421, 259, 1166, 134, 1270, 387, 1157, 640, 243, 459, 1118, 1045, 1050, 631, 783, 1118,
+    989, 810, 567, 1270, 193, 258, 1101, 919, 552, 954, 415, 1111, 1179, 778, 1252, 348,
+    1009, 286, 621, 582, 131, 435, 225, 7, 134, 51, 51, 661, 340, 251, 261, 1086,
+    1198, 187, 1157, 1279, 180, 206, 942, 1272, 435, 1201, 398, 291, 539, 1165, 942, 1051,
+    1200, 341, 1089, 415, 513, 438, 1180, 1179, 616, 913, 475, 134, 1103, 347, 1179, 1088,
+    433, 155, 28, 558, 590, 107, 954, 745, 223, 200, 793, 1008, 1252, 55, 942, 180,
+    614, 1179, 1305, 139, 1252, 1245, 985, 1000, 862, 229, 599, 616, 670, 456, 1182, 1186,
+    417, 300, 576, 593, 831, 590, 552, 1111, 286, 206, 1183, 385, 4, 28, 1111, 347,
+    346, 730, 1201, 1085, 1179, 1190, 783, 558, 567, 957, 206, 583, 226, 583, 543, 60,
+    435, 131, 1166, 1112, 451, 1264, kNoPinyin, 567, 431, 543, kNoPinyin, 223, 1146, 1186, 1182, 854,
+    1190, 1008, 223, 614, 605, 605, 67, kNoPinyin, 355, 802, 271, 215, 271, 25, 26, 835,
+    48, 1229, 1229, 636, 214, 751, 450, 417, 353, 171, 586, 317, 670, 433, 448, 779,
+    317, 4, 262, 382, 374, 48, 1078, 140, 825, 1102, 4, 461, 382, 418, 382, 1230,
+    186, 382, 1120, 1175, 803, 382, 448, 6, 1130, 419, 567, 791, 385, 449, 782, 312,
+    769, 1277, 478, 850, 188, 863, 1238, 339, 478, 478, 1277, 1238, 339, 1248, 245, 662,
+    816, 1185, 1199, 38, 1253, 1271, 775, 384, 1185, 384, 1179, 67, 1078, 384, 14, 1248,
+    1161, 440, 384, 1198, 527, 278, 309, 212, 759, 301, 850, 946, 212, 604, 1248, 645,
+    566, 456, 1143, 440, 759, 349, 7, 602, 957, 1274, 209, 7, 339, 567, 678, 233,
+    312, 1140, 631, 631, 1268, 817, 894, 1028, 1114, 255, 1126, 1105, 761, 291, 256, 661,
+    663, 945, 950, 1210, 653, 758, 281, 657, 204, 638, 636, 489, 1113, 747, 950, 1164,
+    1264, 1170, 942, 431, 199, 1262, 526, 467, 942, 134, 945, 640, 670, 1281, 1261, 1261,
+    652, 218, 1202, 231, 1177, 1302, 1302, 118, 1240, 1147, 65, 650, 593, 992, 240, 650,
+    231, 1177, 270, 664, 1147, 131, 526, 473, 673, 1263, 1035, 1165, 1162, 670, 1273, 627,
+    1254, 1264, 638, 480, 934, 374, 414, 221, 129, 192, 473, 262, 1078, 1113, 1102, 533,
+    543, 441, 926, 1029, 426, 1078, 586, 950, 847, 581, 1159, 457, 1264, 565, 543, 995,
+    473, 972, 992, 244, 51, 51, 678, 424, 710, 604, 1179, 451, 81, 1276, 1199, 424,
+    623, 1109, 1132, 1102, 359, kNoPinyin, 165, 440, 640, 246, 398, 1144, 1026, 528, 317, 897,
+    636, 1143, 271, 1088, 656, 141, 530, 648, 1093, 510, 209, 123, 497, 984, 1106, 847,
+    636, 663, 628, 972, 1230, 1252, 1179, 227, 747, 670, 974, 173, 596, 131, 628, 791,
+    127, 435, 645, kNoPinyin, 898, 793, 1102, 831, 811, 1280, 217, 941, 974, 577, 122, 1111,
+    489, 1175, 1143, 1043, 673, 582, 530, 1111, 1175, 6, 423, 1246, 441, 339, 1256, 470,
+    1085, 141, 915, 724, 1152, 1171, 431, 645, 652, 62, 652, 567, 526, 475, 1144, 652,
+    431, 602, 645, 593, 349, 629, 1104, 146, 1014, 489, 1280, 634, 454, 582, 1201, 976,
+    94, 475, 949, 1178, 941, 1267, 398, 941, 1186, 469, 1274, 448, 193, 249, 5, 448,
+    1235, 431, 26, 948, 236, 817, 432, 1301, 310, 1101, 1066, 513, 826, 1105, 276, 526,
+    209, 622, 919, 204, 475, 567, 299, 661, 741, 431, 493, 1269, 817, 488, 453, 287,
+    264, 1158, 781, 1258, 1161, 995, 1285, 120, 256, 758, 1163, kNoPinyin, 291, 272, 670, 1241,
+    853, 1201, 614, 1067, 1067, 220, 1245, 1261, 6, 286, 677, 1280, 567, 52, 736, 800,
+    777, 586, 769, 555, 805, 67, 805, 939, 1214, 741, 567, 593, 1043, kNoPinyin, 567, kNoPinyin,
+    145, 503, 858, 1278, 523, 353, 264, 694, 437, 604, 1086, 6, 615, 502, 1131, 1161,
+    1043, 777, 1102, kNoPinyin, 394, 976, 1107, 830, kNoPinyin, 1087, 831, kNoPinyin, 503, 1118, 863, 111,
+    549, 394, 1199, 1118, 1107, 632, 595, 1192, 120, 122, 262, 590, 1187, 631, 863, 1163,
+    919, 532, 1201, kNoPinyin, kNoPinyin, 603, 125, 441, 745, 980, 1297, 503, 778, 1162, 1292, 505,
+    98, 815, 1305, 845, 582, 478, 67, 236, 661, 227, 440, 385, 604, 6, 995, 863,
+    586, 38, 1181, 253, 1100, 815, 611, 1078, 225, 314, 40, 817, 125, 894, 1161, 231,
+    236, 245, 1067, 451, 1184, 53, 500, 51, 1084, 976, 1261, 250, 1107, 209, 1024, 695,
+    780, 441, 221, 1011, 101, kNoPinyin, 817, kNoPinyin, 291, 1147, 863, 863, 622, 331, 712, 988,
+    262, 170, 592, 977, 1013, 33, 406, 781, 1086, 912, 558, 192, 1261, 1107, 814, 569,
+    759, 1087, 1211, 251, 1258, 497, 536, kNoPinyin, 845, 358, 1285, 109, 817, 16, 777, 604,
+    603, 489, 828, 125, 1182, 558, 55, 817, 668, 814, 184, 1303, 845, 168, kNoPinyin, 432,
+    927, 552, 854, 1235, 217, 442, 1105, 582, 236, 226, 417, 759, 1214, 830, 218, 567,
+    kNoPinyin, 446, kNoPinyin, 1251, 831, 254, 1112, 1201, 1292, 384, 431, 1243, 559, 499, 145, 433,
+    863, 209, 1178, 443, 784, 781, 1201, 796, 817, 6, 486, 440, 1201, 894, 645, 769,
+    170, 68, kNoPinyin, 660, 77, 1111, 526, 559, 558, 1270, 567, 567, 276, 863, 769, 1184,
+    567, 593, 593, 670, 68, 967, 349, 544, 1221, 1161, 950, 950, 566, 881, 938, 1208,
+    979, 815, 1002, 623, 1125, 1168, 1110, 815, 815, 1269, 44, 253, 1273, kNoPinyin, 1176, 948,
+    1197, 1270, 1033, 300, 302, 651, 1311, 1267, 991, 640, 1324, 853, 404, 1281, 940, 995,
+    170, 105, 649, 617, 1200, 1115, 1099, 1032, 792, 1278, 355, 1107, 1267, 435, 319, 1261,
+    319, 972, 454, 125, 307, 532, 221, 211, 431, 1017, 815, 340, 349, 1317, 586, 604,
+    65, 456, 211, 1268, 604, 927, 38, 1259, 420, 1196, 1105, 1180, 1300, 431, 1261, 300,
+    1205, 1099, 1112, 1165, 1024, 1176, 638, 977, 221, kNoPinyin, 1297, 1261, 1192, 433, 319, 1013,
+    977, 623, 1002, kNoPinyin, 1144, 815, 1201, 1104, 432, 979, 109, 1010, 519, 995, 566, 730,
+    709, 211, 567, 869, 1208, 1024, 1221, 559, 887, 1200, 1199, 565, 1125, 839, 384, 1050,
+    1139, 977, 877, 1050, 1301, 101, 312, 1179, 1110, 65, 711, 849, 849, 1272, 288, 382,
+    1210, 497, 657, 1267, 328, 50, 1267, 1201, 651, 513, 30, 781, 708, 567, 1195, 1309,
+    781, 20, 586, 670, 130, 711, 839, 1164, 1322, 1270, 1267, 956, 470, 1301, 429, 432,
+    127, 1043, 1270, 429, 384, 1180, 1300, 1268, 450, 878, 247, 1177, 1278, 423, 730, 301,
+    1102, 495, 548, 299, 1231, 972, 617, 532, 312, 328, 1024, 128, 1051, 931, 972, 1158,
+    610, 604, 340, 1322, 878, 1295, 33, 27, 432, 1268, 1270, 532, 561, 778, 497, 65,
+    140, 1310, 1201, 986, 619, kNoPinyin, 1176, 1105, 52, 435, 302, 48, 742, 450, 1272, 1303,
+    1140, 127, 212, 1090, 569, 1300, 1201, 435, 1143, 1262, 1270, 212, 439, 432, 318, 318,
+    339, 884, 995, kNoPinyin, 435, 490, 678, 925, 641, 1270, 435, 604, 986, 432, 1186, 1090,
+    849, 916, kNoPinyin, 1179, 417, 837, 434, 995, 1118, 811, 446, 1296, 1043, kNoPinyin, 617, 995,
+    730, 916, 423, 869, 742, 1201, kNoPinyin, 435, 1059, 1090, 127, 431, 332, 617, 55, kNoPinyin,
+    869, 1296, 565, 1222, 1149, 1070, 463, 847, 1105, 847, 505, 1198, 917, 458, 1171, 151,
+    1293, 1050, 552, 837, 1244, 1170, 53, 35, 1170, 65, 1070, 1279, 449, 833, 229, 1098,
+    353, 1169, 1270, 155, 1170, 1034, 449, 155, 461, 1118, 128, 510, 183, 1095, 206, 511,
+    497, 1292, 1143, 988, kNoPinyin, 527, 243, kNoPinyin, 1183, 1095, 1070, 1158, 1199, 470, 847, 1169,
+    1169, 1035, 117, 1200, 1028, 229, 470, 576, 1102, 1101, 527, 155, 1253, kNoPinyin, 521, 593,
+    127, 187, 790, 1229, 183, 833, 847, 243, 1229, 594, 837, 567, 146, kNoPinyin, 298, kNoPinyin,
+    146, 394, 815, kNoPinyin, kNoPinyin, kNoPinyin, 958, 658, 469, 1249, 1281, 586, 593, 66, 459, 459,
+    1250, kNoPinyin, 979, 480, 394, 1043, 981, 459, 229, 1179, 958, 459, 855, 451, 801, 248,
+    932, 1286, 98, 215, 184, 409, 459, 489, 459, 1279, 1279, 555, 778, 1199, 132, 310,
+    631, 1279, kNoPinyin, 246, 432, 1119, 19, 991, 433, 1262, 1256, 997, 1156, 1292, 1203, 404,
+    314, 1121, 96, 782, 50, 441, 1178, 238, 925, 943, 1107, 219, 1279, 682, 131, 337,
+    567, 837, 662, 34, 1033, 979, 300, 94, 43, 773, 197, 1301, 221, 586, 1230, 735,
+    300, 335, 276, 436, 322, 278, 949, 635, 804, kNoPinyin, 440, 847, 593, kNoPinyin, 52, 615,
+    356, 855, 132, 1180, 1171, 1112, 50, 847, 341, 216, 448, 454, 858, 997, 890, 272,
+    523, 1279, 1044, 432, 197, 1131, 94, 1273, 510, 541, 51, 922, 207, 1264, 94, 299,
+    1210, 1051, 752, 567, 548, 469, 348, 441, 372, 1044, 1107, 1270, 128, 991, 950, 1281,
+    1322, 1120, 931, 1040, 94, 1161, 318, 519, 310, 140, kNoPinyin, 316, 1210, kNoPinyin, 822, 1120,
+    441, 811, 541, 1306, 51, 51, 51, 323, 132, 345, 1198, 440, 1256, 337, 132, 1264,
+    457, 921, 1276, 604, 68, 432, 582, 991, 480, 300, 1239, 337, 505, 823, 857, 480,
+    160, 348, 1202, 94, 468, 69, 1230, 837, 1069, 613, 204, 1118, 900, 442, kNoPinyin, 52,
+    997, 1114, 1112, 801, 1261, 945, 402, 947, 1281, 1206, 165, 618, 1098, 239, 976, 433,
+    451, 417, 1130, 638, 278, 160, 1287, 785, 291, 1279, 394, 837, 398, 849, 657, 825,
+    kNoPinyin, 530, kNoPinyin, 598, 1210, 384, 1013, 1208, 139, 317, 285, 900, 1264, 334, 720, 825,
+    1120, 183, 331, 763, 246, 567, 51, 1297, 144, 922, 132, 1279, 826, 593, 544, 440,
+    75, 565, 423, 51, 219, 173, 1160, 778, 917, 1287, 755, 792, 241, 1200, 660, 1285,
+    1230, 1104, 361, 1177, 404, 110, 510, 180, 801, 142, 432, 355, 988, 598, 1241, 604,
+    712, 999, 183, kNoPinyin, 999, 555, 250, kNoPinyin, 1118, 68, 651, 977, 209, 576, 204, 226,
+    301, 441, 662, 530, 203, 446, 215, 417, 997, 552, 1219, 1118, 604, 950, 1219, kNoPinyin,
+    755, kNoPinyin, 755, 313, 470, 247, 604, 1161, 70, 207, 906, 497, 593, 822, 569, 75,
+    1277, 543, kNoPinyin, 544, 530, 1199, 1208, 380, 1261, 1006, 1026, 649, 140, 433, kNoPinyin, kNoPinyin,
+    1022, 1287, 1277, 275, 984, 1277, kNoPinyin, 1297, 1022, 604, 602, 440, 1069, 1185, 1201, 543,
+    593, kNoPinyin, 569, 544, 822, 1208, 1271, 854, 569, 52, 250, 1313, 565, 977, 613, 1185,
+    1208, 1297, 1201, 650, 219, 276, 939, 1258, 939, 743, 1123, 559, 1110, 1301, 708, 191,
+    kNoPinyin, 822, kNoPinyin, 50, 29, 1101, 919, 490, 888, 289, 51, 187, kNoPinyin, 565, 133, kNoPinyin,
+    kNoPinyin, 19, 567, 310, 470, 805, 670, 178, 711, 1277, 565, 988, 1035, 567, 1102, 988,
+    394, 1043, 1300, 94, 1208, 1274, 584, 1288, 26, kNoPinyin, 290, kNoPinyin, kNoPinyin, kNoPinyin, 572, 1113,
+    300, 572, 86, 328, 566, 1208, 604, 468, 815, 187, 27, 1250, 582, 1305, 457, 362,
+    kNoPinyin, 908, 909, 1013, 52, 888, 654, 398, 1142, 1305, 402, 442, 1220, 170, 565, 1125,
+    299, 710, 40, 339, 1138, 317, 1013, 851, kNoPinyin, 90, 1288, 1013, 649, 909, 290, 1226,
+    490, 445, 668, 909, 909, 742, 1102, 572, 445, 519, 68, 413, kNoPinyin, 1305, 1113, 742,
+    1055, 720, 567, 1324, 219, 720, 1035, 544, 651, 977, 463, 1105, 331, 1265, 463, 1197,
+    435, 103, 1277, 1153, 1206, 394, 1198, 384, 1077, 879, 1091, 1089, 850, 682, 1300, 1048,
+    728, 296, 453, 955, 164, 781, 1182, 919, 394, 1269, 433, 287, 1210, 879, 205, 454,
+    988, 281, 1000, 187, 465, 1239, kNoPinyin, 455, 302, 1270, 171, 1301, 140, 394, 1213, 559,
+    1105, 300, 1125, 939, 40, 1281, 855, 586, 1281, 934, 313, 1164, 300, 1067, 1262, 203,
+    146, 947, 1271, 1111, 1311, 461, 30, 470, 670, 958, 1317, kNoPinyin, 457, 877, 392, 1125,
+    451, 1278, 140, 343, 26, 475, 526, 402, 172, 328, 328, 1016, 1123, 513, 448, 857,
+    308, 615, 1147, 64, 1113, 300, 324, 1043, 884, 1035, 1180, 558, 1125, 860, 1143, 307,
+    231, 1044, 977, 445, 1115, 423, 475, 1268, 441, 473, 131, 653, 1262, 617, 128, 850,
+    955, 32, 1044, 1118, 1079, 838, 329, 1138, 1024, 1139, 1123, 394, 1105, 300, 1039, 992,
+    253, 532, 299, 457, 404, 1267, 1161, 461, 292, 435, kNoPinyin, kNoPinyin, 1303, 582, 259, 567,
+    618, 572, 140, 859, 934, 817, 815, 1294, 815, 1078, 825, 1113, 954, 1085, 816, 1017,
+    1078, 314, 1082, 44, 1292, 81, 362, 187, 609, 591, 816, 1249, 38, 168, 586, 652,
+    814, 837, 1008, 1303, 358, 1306, 1179, 1300, 1133, 573, 455, 283, 895, 661, 1201, 1304,
+    276, 618, 1143, 1184, 1252, kNoPinyin, 1143, 1114, 440, 500, 1113, 894, 652, 432, 250, 1273,
+    221, 661, 656, 1203, 1125, 36, 977, 849, 52, 414, 328, 173, 653, 1087, 302, 1086,
+    1199, 334, 657, 1123, 571, 1303, 54, 1212, 1180, 1024, 341, 1270, 1209, 127, 109, 203,
+    1107, 1203, 1304, 1140, kNoPinyin, kNoPinyin, 328, kNoPinyin, 1185, 456, 1179, 1292, 710, 31, 339, 759,
+    1277, 440, 194, 859, 968, 1209, 1107, 184, 1102, 884, 1016, 300, 1210, 123, 318, 892,
+    402, 1217, 1022, 1113, 988, 1262, 1305, 1016, kNoPinyin, 82, 51, 292, 180, 565, 999, 1182,
+    1104, 1305, 557, 1287, 822, 630, 1268, 617, 670, 791, 569, 649, 1147, 1304, 432, 925,
+    995, 276, 964, 44, 1176, 913, 673, 1169, 828, 425, kNoPinyin, 1105, kNoPinyin, 1139, 867, 1147,
+    995, 830, 1235, 1323, 1267, 927, 909, 582, 1201, 275, 576, 168, 1318, 442, 874, 110,
+    896, 1139, 423, 408, 1313, 1102, 828, kNoPinyin, 197, 944, 423, 1105, 916, 441, 443, 413,
+    1228, 173, 453, 448, 70, 109, 1179, 694, 995, 1179, 923, 1140, 435, 62, 824, 544,
+    811, 1152, 1313, 815, 778, 567, 670, 559, 1123, 1313, 526, 1194, 1143, 557, 1110, 109,
+    kNoPinyin, 602, 109, 1184, 80, 1114, 1110, 1315, 1313, 615, 1104, 212, 546, 557, 571, 977,
+    463, 1198, 394, 1277, 1110, 384, 1206, 433, 1077, 526, 435, 879, 1086, 1210, 394, 164,
+    782, 919, 314, 682, 877, 1305, 609, 287, 1269, 1089, 281, 1281, 1182, 728, 955, 1113,
+    313, 1125, 300, 571, 1311, 939, 1105, 1267, 1271, 1277, 30, 300, 1297, 934, 1179, 457,
+    203, 32, 884, 451, 513, 874, 231, 392, 423, 324, 1147, 445, 615, 475, 448, 1044,
+    329, 1118, 473, 1139, 1105, 992, 1016, 435, 1024, 432, 1143, 586, 1184, 1143, 816, 283,
+    168, 1251, 358, 944, 1085, 652, 954, 44, 140, 1017, 591, 859, 1305, 1249, 1078, 618,
+    1292, 1300, 500, 1114, 440, 653, 546, 1024, 657, 817, 1209, 423, 977, 259, 250, 54,
+    1113, 334, 1292, 414, 221, 617, 52, 661, 1203, 456, 300, 892, 1261, 292, 962, 318,
+    109, 565, 1179, 440, 62, 791, 630, 557, 1184, 999, 673, 913, 1123, 576, 927, 1235,
+    443, 824, 1228, 413, 448, 1313, 297, 1125, 314, 297, 861, 297, kNoPinyin, 67, 801, 400,
+    kNoPinyin, 314, 1184, 1184, 845, 1109, 349, 1318, 1009, kNoPinyin, 817, 1094, 1184, 557, 1009, 602,
+    349, 1082, 1082, 314, 1082, 373, kNoPinyin, 612, 300, 649, 272, 337, 1280, 467, 634, 339,
+    661, 314, 22, 343, 1024, 473, 300, 582, 1162, 1256, 1317, 343, 1297, 1201, 1270, 9,
+    272, 688, 957, 977, 782, 623, 591, 22, 272, 565, 116, 1087, 51, 435, 1235, 1043,
+    591, 432, 473, 651, 1256, 613, 782, 432, 432, 605, 1165, 650, 826, 1004, 639, 1165,
+    1196, 1196, 288, 19, 317, 1167, 339, 826, 1223, 317, 586, 1179, 1281, 218, 1137, 822,
+    1177, 1113, 884, 865, 865, 828, 413, 999, 1113, 1179, kNoPinyin, 826, 1111, 1199, 328, 451,
+    1012, 1203, 1102, 276, 925, 289, 925, 570, 557, 328, 733, 829, 111, 1200, 333, 1179,
+    135, 1092, 287, 394, 134, 134, 187, 300, 1107, 776, 1179, 536, 1179, 781, 586, 592,
+    1270, 854, 1103, 1123, 1115, 1105, 1105, 815, 831, 423, 420, 1118, 916, 394, 443, 219,
+    187, 285, 1016, 921, 134, 1281, 441, 1144, 950, 785, 1303, 1079, 420, 398, 384, 385,
+    374, 16, 789, 1179, 569, 854, kNoPinyin, 582, 776, 831, 16, 275, 1179, 423, 1144, 212,
+    1171, 553, kNoPinyin, 495, 636, 1259, 815, 335, 335, 335, 232, 232, 268, 960, 894, 268,
+    685, 1285, 558, 1039, 1301, 328, 119, 382, 1210, 22, 781, 132, 979, 144, 436, 470,
+    384, 144, 554, 610, 433, 1014, 749, 597, 734, 444, 764, 1230, 597, 432, 554, 431,
+    1194, 670, 410, 269, 1258, 1039, 1173, 196, 981, 839, 1210, 133, 204, 204, 394, 329,
+    1268, kNoPinyin, 720, 204, 1262, 122, 586, 1264, 1196, 1070, 576, 593, 1268, 723, 1032, 268,
+    1158, 231, 341, kNoPinyin, 569, 382, 946, 581, 799, 457, 470, 51, 220, 361, 1089, 1143,
+    801, 173, kNoPinyin, kNoPinyin, 1040, 1200, 173, 528, kNoPinyin, 530, 173, 569, 1093, 530, 569, 569,
+    173, 16, 943, 981, 1039, 530, 720, 1268, 204, 723, kNoPinyin, 432, 1039, 1039, 593, 1201,
+    1201, 1256, 979, 988, 1179, 988, 979, 1256, 1256, 889, 1179, 559, 432, 850, 501, 93,
+    320, 221, 413, 416, 1178, 879, 1121, 891, 1276, 1202, 247, 314, 884, 310, 100, 1097,
+    113, 339, 1267, 372, 299, 284, 288, 770, 765, 440, 280, 1293, 1195, 682, 376, 501,
+    867, 331, 1201, 1090, 1169, 456, 782, 822, 1105, 1102, 286, 501, 458, 1007, 942, 1272,
+    1252, 1123, 939, 1087, 1277, 231, 205, 286, 20, 68, 854, 1028, 40, 341, 1005, 1301,
+    511, 1267, 710, 801, 1302, 302, 765, 1261, 1111, 1324, 770, 438, 946, 1267, 34, 677,
+    853, 402, 497, 1178, 1183, 1140, 1164, 593, 240, 482, 602, 459, 736, 1160, 763, 516,
+    1177, 350, 369, 320, 240, 1270, 1119, 1134, 1134, 268, 264, 1131, 786, 704, 1302, kNoPinyin,
+    128, 1035, 1267, 187, 638, 1123, 187, 1123, 627, 627, 433, kNoPinyin, kNoPinyin, 519, 903, 1223,
+    815, 695, 650, 730, 605, 1078, 68, 1090, 348, 850, 448, 459, 887, 390, 194, 581,
+    925, 1041, 638, 164, 942, 824, 1020, 1315, 180, 1137, 1129, 1066, 766, 128, 699, 301,
+    243, 1066, 717, kNoPinyin, 783, 339, 341, 567, 570, 1252, 187, 451, 573, 1274, 782, 55,
+    609, 786, 363, 530, 160, 206, 1029, 699, 457, 450, 539, 1179, 1160, 878, 942, 168,
+    301, 301, 467, 284, 826, 1079, 240, 782, 361, 1303, 236, 1098, 638, 894, 1287, 1270,
+    177, 341, 749, 221, 7, 1130, 695, 1199, 153, 688, 1212, 1272, 887, 264, 904, 1051,
+    1168, 442, 1086, 448, 1199, 436, 250, 51, 113, 302, 1113, 710, 653, 1073, 1022, 1060,
+    32, 822, 617, 1073, 985, 1013, 988, 1292, 321, 1179, 68, 576, 433, 782, 1123, 317,
+    617, 63, kNoPinyin, 113, 604, 361, 762, 148, 791, 444, 299, 1013, 670, 1102, 1285, 618,
+    446, 1187, 616, 1270, kNoPinyin, 163, 570, 1043, 778, 710, 1241, 576, 187, 353, 1118, 1021,
+    276, 1268, 446, 927, 401, 187, 899, 1114, 994, 290, 1184, 206, 1282, 205, 519, 730,
+    1063, 569, 51, 1192, 475, 146, 1179, 472, 539, 570, 913, 1063, 339, 815, 187, 63,
+    1152, 890, 431, 1225, 1113, 55, 1133, 520, 539, 1160, 602, 431, 1223, 614, 854, 1225,
+    605, 708, 1223, 124, 822, 1097, 352, 1223, 582, 352, 1302, 448, 720, 142, 435, 317,
+    142, 652, 720, 1270, 1270, 321, 442, 231, 1270, 1137, 1006, 1261, 466, 1113, 1199, 100,
+    1170, 1199, 135, 1105, 1105, 466, 1199, 1200, 1130, 469, 466, 1129, 936, 938, kNoPinyin, 465,
+    950, 1008, 955, 950, 1029, 206, 813, 813, 348, 408, 1008, 153, 974, 1107, 1100, 1274,
+    210, 314, 925, 1178, kNoPinyin, 751, 1007, 276, 29, 152, 376, 281, 28, 863, kNoPinyin, 1271,
+    442, 87, 586, 1279, 1230, 260, 68, 1111, 322, 152, 1107, 603, 394, 763, 1102, kNoPinyin,
+    300, 1229, 292, 565, 931, 1199, 548, 1041, kNoPinyin, 1086, 68, 646, 713, 467, 417, 953,
+    1303, 54, 636, 231, kNoPinyin, 33, 100, 1179, 913, 87, 91, 597, 203, kNoPinyin, 1171, 1043,
+    kNoPinyin, 207, 1009, 603, 1178, 453, 442, 431, 645, 815, 603, 602, 109, 967, 327, 572,
+    440, 440, 916, 1163, 300, 801, 1163, 1163, 92, kNoPinyin, 1179, 555, 1039, 850, 6, 684,
+    1033, 446, 451, 778, 1077, 1179, 104, 652, 659, 310, 822, 1201, 1201, 932, 846, 1052,
+    1109, 816, 631, 1301, 422, 992, 1270, 1114, 782, 300, 1063, 1086, 1099, 1267, 816, 925,
+    1089, 825, 877, 300, 508, 453, 602, 1143, 433, 839, 815, 1203, 287, 19, 897, 1126,
+    435, 405, 405, 279, 1101, 475, 334, 1269, 1210, 839, 17, 144, 636, 1156, 286, 882,
+    376, 173, 1181, 1196, 54, 1179, kNoPinyin, 1086, 567, 783, 264, 1113, 113, 87, 645, 986,
+    1177, 1205, 868, 586, 1006, 1033, 220, 656, 848, 567, 1193, 497, 678, 773, 34, 335,
+    661, 1178, 1178, 470, 781, 900, 512, 1281, 709, 68, 65, 925, 850, 1170, 1110, 42,
+    394, 1184, 1240, 238, 467, 231, 719, 310, 401, 801, 638, 300, 943, 337, 51, 1087,
+    300, 1297, 636, 278, 835, 634, 635, 20, 1301, 670, 1300, 220, 132, 435, 457, 593,
+    kNoPinyin, 716, kNoPinyin, 1149, 1185, 847, 321, 663, 567, 884, 1183, 327, 825, 106, 124, 1201,
+    1137, 1302, 581, 1099, 435, 353, 94, 136, 170, 335, 350, 631, 132, 446, 446, 300,
+    1199, 1278, 1300, 443, 421, 1180, 101, 272, 884, 890, 135, 632, 1043, 1273, kNoPinyin, 1279,
+    1153, 413, 514, 858, 307, 196, 457, 1133, 153, 92, 457, 268, 10, 952, 132, 878,
+    442, 1024, 416, 801, 567, 454, 553, 958, 1288, 197, 437, 872, 51, 1230, 831, 423,
+    815, 209, kNoPinyin, 884, 424, 1185, 615, 1185, 1153, 456, 996, 1183, 626, 394, 1277, 1171,
+    247, 1086, 146, 243, 299, 878, 1181, 384, 49, 75, 1210, 219, 1051, 992, 992, 128,
+    124, 1099, 59, 1102, 329, 567, 301, 1281, 670, 567, 1288, 433, 258, 850, 919, 999,
+    124, 291, 469, 638, 645, 1133, 457, 120, 939, 478, 1161, 1040, 229, 195, 347, 374,
+    1196, 195, 437, 1081, 1195, 728, 931, 1113, 548, 300, 262, 670, 1091, 451, 687, 678,
+    488, 541, 569, 948, 1095, kNoPinyin, 570, 431, 1195, 1185, 1184, kNoPinyin, 164, 632, 632, 172,
+    1078, 457, 218, 854, 238, 440, 1306, 337, 536, 604, 468, 1087, 478, 720, 531, 384,
+    811, 1300, 318, 362, 300, 609, 112, 140, 980, 160, 1249, 641, 82, 20, 565, 1053,
+    67, 374, 37, 841, 472, 1102, 839, 220, 450, 811, 209, 455, 1255, 1006, 328, 406,
+    337, 586, 283, 454, 7, 1082, 46, 1276, 1160, 467, 440, 583, 1010, 956, 1028, 212,
+    403, 815, 384, 187, 1017, 163, 784, 113, 413, 284, 541, 814, 645, 801, 1084, 206,
+    921, 413, 1162, 1177, 1033, 815, 1078, 94, 685, kNoPinyin, 1069, 463, 1036, 613, kNoPinyin, kNoPinyin,
+    645, kNoPinyin, kNoPinyin, kNoPinyin, 1185, 1185, 1185, 1118, 903, 849, 497, 1117, 1079, 1200, 1201, 302,
+    571, 1144, 1203, 687, 1230, 1095, 165, 1118, 1199, 785, 636, 7, 264, 615, 1185, 429,
+    341, 443, 653, 1322, 1324, 467, 36, 887, 1104, 1175, 7, 854, 440, 300, 618, 457,
+    775, 291, 394, 394, 398, 1161, 1051, 1281, 1300, 1114, 942, 321, 451, 459, 650, 417,
+    939, 811, 309, 239, 1277, 823, 1086, 68, 1084, 751, 435, 402, 1225, 436, 250, 1171,
+    480, 173, 858, 1084, 1261, 528, 1040, 424, 1104, 947, 817, 544, 1303, 1168, 1202, 638,
+    1209, 958, 221, 1287, 347, kNoPinyin, 1148, 110, 485, 530, kNoPinyin, 444, 597, 1085, 757, kNoPinyin,
+    983, 1180, 947, 164, 948, 1209, 1261, 550, 735, 645, 384, 861, 991, 1203, 567, 469,
+    1103, 33, 144, 1141, 1051, 590, 1097, 1261, 825, 1309, 805, 192, 1202, 144, 1201, 518,
+    759, 811, 811, 682, 976, 1102, 288, 1210, 1264, 440, 433, 900, 87, 265, 649, 379,
+    996, 1261, 663, 431, 1143, 590, 1103, 339, 548, 884, 1093, 309, 195, 947, 1013, 614,
+    892, 999, 1110, 40, 1170, 356, 51, 1304, 358, kNoPinyin, 1137, 94, kNoPinyin, 544, kNoPinyin, 435,
+    565, 83, 548, 1201, kNoPinyin, 1187, 670, 229, 1032, 636, 1042, 1279, 778, 7, 569, 173,
+    1104, 801, 849, 456, 164, 451, 1086, 1058, 91, 1200, 1179, 433, 577, 51, 603, 988,
+    75, 1250, 613, 445, 630, 1161, 586, 435, 791, 358, 373, 219, 988, 604, 938, 928,
+    219, 660, 1152, 630, 71, 221, 193, 1260, 917, 1147, 1087, 402, 16, 650, 597, 180,
+    1271, 82, 803, 444, 651, 173, 716, 423, 480, 1181, 442, 1160, 955, 1183, 530, 124,
+    404, 919, 510, 825, 621, 1223, kNoPinyin, 827, 241, 571, 584, 510, 5, 51, 565, 1085,
+    433, 1153, 946, 276, 645, 749, 110, 225, 1154, 446, 896, 896, 558, 1199, 831, 144,
+    406, 440, 626, 1210, 34, 1195, 854, 604, 872, 423, 264, 1022, 285, 475, 1317, 274,
+    890, 288, 530, 974, 895, 1157, 1140, 302, 475, 209, 1099, 1043, 977, 1118, 1105, 593,
+    1212, kNoPinyin, 815, 440, 1212, 996, 586, 1201, 1107, 1190, 433, 396, 979, 730, 558, 1144,
+    1212, 1201, 1103, 382, 68, 379, 6, 1085, 423, 1087, 435, 169, 1114, 607, 660, 1179,
+    561, 443, 86, 939, 827, 569, 497, 1203, 197, 1026, 1013, 1148, 51, 1247, 996, 570,
+    276, 235, 450, 339, 1125, 957, 442, 495, 393, 903, 1126, 1152, 1171, kNoPinyin, 984, 957,
+    1152, 253, 797, 1086, 704, 140, 625, 890, 789, 1006, 170, 1228, 124, 1261, 269, 709,
+    1185, 318, 175, 1118, 815, 272, 441, 1143, 527, 453, 53, 229, 651, 544, 456, 88,
+    657, 847, 837, 1112, kNoPinyin, 749, 1111, 988, 616, 1179, 1143, 1124, 565, 1179, 538, 558,
+    1121, 219, 1269, 38, 1022, 1171, 670, 414, 55, 276, 984, 1009, 1058, 847, 831, 1087,
+    590, 423, kNoPinyin, 318, 1212, kNoPinyin, 567, 957, 144, 5, 584, 1228, 1144, 126, 543, 431,
+    1069, 1101, 896, 896, 815, 391, 602, 986, 1059, 631, 1212, 797, 1200, 1152, 435, 460,
+    1110, 668, kNoPinyin, 986, 460, kNoPinyin, 720, 70, 869, 1179, 1112, 1199, 468, 571, 571, 1182,
+    827, 1184, 593, 1045, 1086, 1208, 586, 854, 1169, 276, 649, 544, 527, 544, 435, 209,
+    kNoPinyin, 559, 557, 407, 291, 1268, 1087, 528, 1249, 411, 565, 435, 649, 558, 411, 613,
+    432, 528, 604, 440, kNoPinyin, kNoPinyin, 557, 859, 1118, 1179, 605, 641, 58, 401, 403, 603,
+    745, 618, 977, 1118, 823, 146, 401, 1140, 193, 300, 1140, 1140, 603, 403, 1199, 382,
+    448, 470, 361, 37, 1161, 1249, 1249, 527, 28, 1105, 956, 136, 850, 227, 432, 850,
+    128, 947, kNoPinyin, 221, 1258, 936, 1198, 310, 1301, 394, 422, 645, 323, 992, 1106, 107,
+    948, 1178, 622, 1117, 279, 264, 751, 133, 822, 1089, 1089, 897, 33, 50, 1208, 1208,
+    478, 815, 1043, 1182, 815, 84, 1203, 475, 421, 839, 815, 1273, 1156, 172, 678, 1081,
+    288, 288, 376, 331, 1228, 301, 867, 453, 300, 131, 242, 790, 1113, 708, 1020, 849,
+    1195, 1241, 801, 132, 1196, 384, 371, 470, 567, 302, 867, 1239, 335, 782, 69, 1111,
+    1281, 227, 60, 65, 337, 867, 853, 936, 1038, 586, 339, 206, 339, 1185, 567, 127,
+    853, 673, 321, 172, 421, 421, 631, 302, 1165, 1070, 581, 1278, 1176, 1111, 535, 446,
+    567, 1179, 801, 451, 366, 936, 1177, 1082, 670, 847, 837, 355, 332, 1270, 628, kNoPinyin,
+    1268, 437, 872, 977, 815, 1130, 581, 850, 931, 1192, 437, 1061, 120, 27, 262, 374,
+    957, 1145, 291, 942, 1263, 301, 1113, 1258, 1099, 300, 565, 548, 51, 144, 1202, 1196,
+    451, 206, 1161, 1040, 226, 972, 421, 341, 1267, 980, 283, 467, 651, 815, 815, 1201,
+    479, 539, 646, 826, 977, 1102, 609, 567, 231, 1033, 1016, 531, 310, 374, 1201, 33,
+    284, 782, 1086, 254, 1179, 1202, 988, 858, 824, 897, 708, 842, 1087, 573, 362, 1076,
+    238, 264, 29, 221, 1082, 84, 1166, 1185, 360, 109, kNoPinyin, 539, 497, 433, 384, 1040,
+    627, 1140, 652, 1199, 450, 948, 1144, 417, 1162, 52, 887, 1084, 302, 1203, 640, 1087,
+    300, 894, 1123, 1195, 850, 634, 1106, 1184, 947, 136, 1012, 1278, 1303, 1024, 302, 1203,
+    422, 645, 539, 245, 402, 849, 231, 567, 341, 1209, 469, 688, 597, 866, 884, 1185,
+    443, kNoPinyin, 548, 763, 977, 1102, 172, 1102, 1203, 1092, 569, 983, 28, 884, 884, 433,
+    1098, 852, 374, 839, 1177, 48, 406, 1013, 1178, 247, 685, 384, 402, 423, 622, 663,
+    1179, 1089, 1185, 1022, 1200, 87, kNoPinyin, kNoPinyin, 629, kNoPinyin, 928, 950, 91, 131, 221, 16,
+    604, 1087, 1270, 1013, 124, 789, 854, 782, 1199, 442, 613, 597, 840, 1271, 1182, 443,
+    964, 1089, 446, 1079, 1258, 1260, 621, 621, 360, 590, 634, 1102, 173, 565, 629, 1118,
+    kNoPinyin, 1250, 632, 1117, 670, 1315, 977, 849, 1020, 1268, 778, 778, 448, 854, 59, 576,
+    759, 355, 1104, 434, 1285, 417, 286, 552, 475, 475, 423, 1181, 109, 446, 927, 872,
+    1118, 673, 136, 1153, 977, kNoPinyin, 127, 207, 566, 1125, 927, 1178, 458, 197, 109, 817,
+    169, 1117, 938, 614, 839, 1185, 107, 567, 1230, 1144, 569, 1279, 1230, 1122, 632, 1125,
+    815, 884, 441, 646, 380, 890, 431, 1297, 451, 62, 385, 660, 276, 557, 451, 539,
+    651, 566, 165, 567, 849, 720, 602, 247, 1118, 1278, 593, 567, 593, 291, 1172, 47,
+    930, 339, 471, 1184, kNoPinyin, 1102, 84, 854, 858, 247, 84, 628, 475, 451, 1279, 1239,
+    1124, 416, 729, 770, 744, 1129, 1273, 670, 270, 500, 660, 1105, 1131, 1162, 489, 1205,
+    kNoPinyin, 586, 1147, 958, 1111, 1045, 595, 450, 1111, 1156, 402, 1087, 212, 135, 1087, 212,
+    1293, 391, 854, 1176, kNoPinyin, 74, 312, 1199, 56, 103, 1178, 925, 126, 299, 358, 287,
+    962, 451, 682, 1271, 205, 883, 1273, 1271, 1125, 815, 1123, 867, 1267, 879, 838, 454,
+    478, 1203, 640, 107, 17, 716, 420, 867, 436, 1067, 587, 203, 37, 767, 1171, 1324,
+    51, 934, 1010, 469, 385, 958, 1139, 1262, 1177, 753, 67, 218, 1073, 302, 358, 1270,
+    1270, 867, 761, 1179, 636, kNoPinyin, 682, 508, 1113, 108, 853, 40, 358, 1103, kNoPinyin, 68,
+    kNoPinyin, 300, 1177, 133, 513, 879, 445, 437, 189, 670, 451, 268, 615, 890, 1278, 353,
+    1180, 80, 581, kNoPinyin, kNoPinyin, 1288, 207, kNoPinyin, 531, 502, 716, 958, 437, 532, 128, 566,
+    471, 939, 807, 321, 1179, 1201, 1262, 590, 850, 865, 435, 1179, 74, 1288, 972, 919,
+    865, 566, 569, 571, 513, 441, 296, 108, 51, 357, 1017, 1205, 586, 133, 112, 140,
+    258, 56, 573, 113, 771, 771, 283, 1202, 614, 362, 1162, 246, 1103, 1270, 467, 816,
+    435, 1268, 343, 502, kNoPinyin, 1026, 1024, 302, 136, 1122, 53, 231, 531, 248, 1139, 1139,
+    384, 1205, 34, 36, 302, 1199, 1057, 1162, 420, 40, 145, 617, kNoPinyin, kNoPinyin, 1211, 197,
+    334, 196, 410, 884, 1205, 892, 685, 461, 1000, 28, 1065, 133, 912, 716, 1184, 453,
+    822, 410, 513, 569, 36, 565, 1258, 947, 617, 1179, 231, 1125, 1110, 1087, 56, 91,
+    432, 444, 917, 34, 1114, kNoPinyin, 811, 441, 1287, 442, 1317, 433, 204, 1214, 276, 68,
+    1117, 1127, 59, 872, 629, 544, 17, 258, 356, 93, 995, 730, 108, 571, 51, 454,
+    207, 956, 1010, 51, 544, 811, 890, 1269, kNoPinyin, 957, 1073, 950, 26, 1123, 68, 126,
+    543, 593, 1103, 1110, 544, 1258, 203, kNoPinyin, 1222, 947, 441, 761, 1179, kNoPinyin, 1158, 1102,
+    1102, 1171, 293, 1009, kNoPinyin, 57, 302, 22, 384, 432, 432, 442, 347, 54, 1163, 353,
+    475, 787, 634, 651, 651, 660, 950, 977, 1246, 613, 475, 651, 1035, 569, 1171, 1270,
+    478, 1103, 926, 1084, 1105, 1029, 1199, 545, 264, 246, 838, 764, 435, 663, 1185, 336,
+    856, 1249, 455, 347, 215, 442, 613, 856, 442, 1085, 475, 856, 613, 545, 941, 219,
+    347, 442, 347, 1163, 353, 651, 950, 1246, 545, 475, 435, 1103, 219, 1029, 1199, 336,
+    455, 856, 448, 463, 454, 178, 475, 1270, 119, 433, 337, 206, 1300, 220, 928, 408,
+    858, 321, 134, 452, 355, 331, 146, 452, 427, 850, 1130, 988, 708, 432, 604, 1270,
+    1238, 51, 1130, 402, 928, 331, 1270, 1149, 146, 1102, 1177, 604, 475, 1102, 1163, 1102,
+    1161, kNoPinyin, 236, 302, 850, 850, 449, 393, 435, 278, 1154, 229, 394, 103, 1018, 1140,
+    451, 1177, 879, 1154, 1181, 927, 817, 1066, 435, 1154, 1181, 262, 287, 1158, 1168, 982,
+    941, 1181, 1126, 475, 1119, 697, 124, 1195, 1269, 1134, 281, 1129, 116, 938, 1110, 920,
+    1063, 1142, 1179, 1179, 988, 131, 383, 939, 384, 1143, 1262, 1281, 1266, 336, 1301, 1301,
+    1246, 339, 302, 859, 231, 586, 220, 1167, 567, 694, 761, 1277, 313, 1179, 470, 18,
+    1241, 1067, 1177, 855, 1256, 801, 51, 1136, 853, 20, 197, 1311, 1016, 1280, 170, 1258,
+    1192, 1142, 1153, 1179, 418, 384, 950, 101, 446, 947, 388, 103, 336, 355, 858, 423,
+    451, 408, 307, 1115, 1084, 939, 140, 1043, 649, 1246, 665, 264, 420, 1161, 1134, 343,
+    270, 46, 1034, 133, 558, 1278, 523, 514, 1099, 1201, 1022, 435, 1270, 879, 988, 549,
+    262, 524, 264, 950, 1041, 206, 68, 109, 1197, 391, 833, 838, 961, 7, 1200, 1121,
+    128, 453, 1113, 1098, 1101, 319, 982, 812, 423, 459, 975, 1263, 975, 245, kNoPinyin, 115,
+    970, 451, 500, 853, 174, 1119, 995, 1082, 1145, 285, 131, 1004, 1179, 680, 1181, 229,
+    783, 168, 110, 123, 1293, 432, 814, 1009, 1292, 1086, 468, 844, 442, 1264, 1230, 1306,
+    822, 1297, 574, 442, 1281, 380, 611, 941, 56, 411, 786, 1199, 231, 1142, 787, 950,
+    1144, 950, 427, 408, 264, 1273, 221, 1123, 300, 812, 1040, 442, 816, 1201, 1300, 152,
+    1104, 423, 1180, 7, 1111, 687, 124, 293, 1278, 1165, 1163, 390, 1144, 321, 742, 817,
+    673, 1175, 1087, kNoPinyin, 1022, 1306, 927, 441, 68, kNoPinyin, 418, 431, 320, 1185, 649, 1120,
+    651, 1105, 826, 123, 745, 1024, 988, 33, 132, 822, 950, 444, 1205, 1125, 1151, 1016,
+    1169, 1169, kNoPinyin, 1199, 55, 175, 845, 565, 668, 670, 928, 1258, 666, 441, 1230, 450,
+    569, 597, 83, 747, 349, 1103, 1297, 16, 16, 455, 1258, 1177, 404, 445, 628, 117,
+    374, 406, 110, 1140, 1235, 916, 1102, 935, 253, 1266, 694, 544, 262, 1187, 475, 432,
+    1319, 448, 70, 423, 1287, 676, 1234, 1239, 951, 831, 1009, 1234, 812, 944, 1144, 1229,
+    1008, 208, 995, 822, 432, 449, 458, 569, 733, 1176, 6, 1246, 784, 422, 408, 1179,
+    1179, 927, 871, 734, 824, 1292, 1004, 404, 1274, 380, 1175, 1184, 442, 1201, 441, 423,
+    245, 1258, 1147, 1222, 558, 941, 1087, 110, 567, 1177, 54, 1258, 1163, 264, 140, 1087,
+    140, 1171, 109, 871, 1182, 544, 126, 431, 1258, 412, 1222, 1179, 208, 1246, 1163, 245,
+    1161, 435, 236, 302, 879, 432, 451, 394, 1018, 871, 927, 817, 1066, 1154, 1179, 1154,
+    435, 879, 444, 423, 747, 470, 1158, 697, 1142, 262, 611, 1134, 982, 291, 938, 281,
+    475, 1266, 339, 383, 801, 1311, 950, 1136, 1241, 988, 1262, 220, 1306, 170, 856, 1256,
+    51, 1179, 1177, 523, 558, 950, 343, 947, 451, 420, 128, 1278, 939, 408, 206, 336,
+    858, 355, 1153, 1179, 1264, 307, 1115, 103, 427, 1142, 1274, 453, 1099, 1200, 833, 1101,
+    319, 1197, 423, 524, 975, 982, 3, 844, 1278, 1306, 742, 245, 1297, 285, 500, 1086,
+    1199, 970, 941, 229, 110, 574, 1293, 995, 1009, 941, 1177, 673, 124, 231, 418, 442,
+    1123, 745, 1175, 1087, 264, 1201, 1144, 109, 1300, 7, 1163, 221, 649, 786, 1142, 668,
+    208, 988, 1125, 1169, 33, 950, 822, 651, 455, 628, 1258, 441, 666, 1009, 1234, 831,
+    544, 812, 475, 1163, 824, 1246, 126, 339, 822, 394, 1106, 475, 394, 371, 393, 1102,
+    1102, 428, 576, 373, 245, 593, 243, 443, 816, 133, 566, 215, 1076, 48, 958, 1113,
+    291, 1270, 1270, 1163, 1163, 949, 146, 420, 1063, 1179, 1063, 1179, 440, 19, 400, 264,
+    179, 1117, 415, 440, 501, 307, 854, 299, 1102, 62, 380, 1201, 1278, 436, 288, 1102,
+    68, 1088, 413, 62, 219, 1303, 288, 1179, 1270, 37, 105, 10, 782, 682, 781, 335,
+    682, 1197, 227, 670, 979, 1137, 413, 531, 384, 384, 670, 374, 636, 565, 708, 50,
+    1200, 436, 1054, 633, 782, 1102, 264, 470, 670, 143, 1009, 412, 475, 40, 1261, 1203,
+    302, 80, 333, 1020, 1177, 376, 1079, 797, 431, 278, 1008, 349, 1230, 1268, 270, 1280,
+    950, 51, 1300, 270, 356, 787, 53, 626, 203, 946, 526, 286, 1036, 1177, 132, 636,
+    385, 51, 604, 584, 423, 307, 786, 1300, 438, 1143, 1232, 448, 309, 1223, 442, 1187,
+    1154, 1263, 935, 62, 62, 850, 935, 154, 1223, 1274, 543, 1222, 172, 123, 929, 1029,
+    771, 328, 1111, 627, 442, 995, 302, 1011, 174, 174, 1270, 432, 1252, 246, 456, 1134,
+    973, 1211, 36, 1216, 543, 294, 89, 432, 946, 6, 1287, 302, 336, 906, 1230, 576,
+    1087, 27, 125, 1287, 1270, 1292, 55, 1209, 1237, 1010, 1222, 1163, kNoPinyin, 927, 1079, 1185,
+    456, 312, 1111, 1223, 51, 245, 956, 1163, kNoPinyin, 1147, 595, 313, 1223, 40, 1261, 302,
+    1203, 333, 80, 1230, 1111, 27, 1252, 431, 1268, 278, 1008, 797, 53, 336, 1280, 349,
+    270, 442, 51, 950, 1036, 356, 526, 203, 636, 286, 385, 1177, 1232, 1270, 438, 423,
+    1300, 879, 604, 1223, 1300, 307, 456, 850, 1263, 543, 935, 302, 246, 432, 956, 929,
+    979, 51, 1274, 328, 771, 1011, 543, 294, 1292, 302, 1287, 906, 1230, 1163, 1222, 1209,
+    1237, 927, 1185, 313, 134, 1105, 938, 688, 1135, 1105, 127, 385, 127, 1259, 1107, 1013,
+    1307, 1307, 567, 465, 302, 1256, 312, 816, 927, 847, 839, 1112, 169, 475, 840, 132,
+    169, 126, 126, 231, 467, 116, 218, 916, 1246, 1279, 1208, 853, 451, 132, 144, 341,
+    1151, 169, 1033, 259, 581, 312, 999, 180, 1103, 1256, 988, 1182, 468, 442, 863, 1015,
+    168, 186, 604, 856, 209, 849, 1300, 1024, 853, 134, 417, 831, 831, 1171, 1229, 1026,
+    kNoPinyin, 1221, 1221, 1310, 751, 37, 513, 497, 255, 475, 299, 125, 441, 282, 1269, 903,
+    1208, 752, 815, 1208, 826, 1069, 1006, 1179, 712, 586, 640, 20, 230, 511, 1067, 436,
+    171, 768, 820, 1281, 467, 231, 1268, 299, 759, 469, 925, 69, 708, 470, 567, 325,
+    1177, 432, 203, 1112, 446, 260, 1278, 858, 516, 1284, 356, 847, 529, 1115, 134, 604,
+    47, 1270, 437, 1035, 81, 442, 1004, 830, 51, 1110, 260, 432, 468, 435, 956, 1051,
+    146, 459, 720, 1118, 68, 134, 864, 674, 955, 548, 1192, 448, 140, 830, kNoPinyin, 1004,
+    442, 815, 1095, 1086, 1297, 451, 433, 718, 468, 467, 609, 604, 563, 410, 470, 132,
+    1078, 858, 1023, 68, 1310, 837, 434, 180, 1303, 81, 1303, 780, 1270, 1264, 225, 1268,
+    1199, 260, 256, 165, 1192, 1272, 221, 1259, 125, 150, 442, 341, 1013, 469, 300, 1310,
+    231, 786, 887, 742, 1024, 102, 1060, 441, 211, 192, 1102, 1004, 826, 1248, 223, 1024,
+    433, 720, 628, 589, 1249, 51, 135, 604, 576, 180, 1012, 203, 999, 1104, 529, 432,
+    1268, 826, 219, 759, 1303, 569, 47, 1226, 712, 59, 1059, 468, 217, 99, 1110, 276,
+    144, 1271, 254, 67, 180, 1310, 475, 475, 584, 1004, 830, 830, 811, 575, 254, 181,
+    526, 1229, 1004, 51, 51, 1279, 470, 144, 833, 255, 140, 432, 1100, 1208, 712, 584,
+    581, 1268, 567, 1270, 109, 144, 250, 1087, 593, 584, 1110, 1087, 1312, 544, 1125, 869,
+    1124, 720, 1004, 854, 453, 181, 1312, 1104, 528, 475, 584, 939, 331, 204, kNoPinyin, 853,
+    1025, 259, 259, 331, 548, kNoPinyin, 614, 5, 432, 468, 1014, kNoPinyin, kNoPinyin, 1162, kNoPinyin, 490,
+    853, 597, 554, 1068, 1268, kNoPinyin, 1025, 212, kNoPinyin, 1201, 120, 1158, 355, 478, 1087, 1208,
+    1129, 221, 1144, 278, 879, 925, 827, 955, 1063, 124, 203, 264, 682, 815, 634, 894,
+    879, 277, 1286, 393, 401, 854, 419, 220, 586, 203, 15, 1262, 278, 523, 13, 777,
+    40, 337, 511, 767, 1281, 885, 264, 20, 1275, 1269, 1169, 497, 1179, 842, 950, 801,
+    268, 847, 468, 449, 350, 604, 485, 858, 1274, 1218, 1270, 935, 574, 1201, 931, 1195,
+    414, 1211, 1258, 1078, 301, 842, 1274, 708, 586, 1258, 1249, 574, 1300, 420, 1082, 168,
+    362, 488, 1178, 778, 825, 358, 712, 786, 348, 40, 609, 755, 572, 894, 887, 433,
+    1165, 1111, 152, 177, 163, 321, 1195, 393, 955, 302, 1300, 300, 1088, 43, 1248, 1199,
+    1088, 1016, 339, 1261, 1107, 1203, 604, 463, 117, 1286, 1087, 425, kNoPinyin, 122, 449, 1249,
+    811, 553, 288, 275, 582, 321, 916, 488, 415, 1178, 433, 253, 268, 1199, 1113, 393,
+    558, 773, 567, 567, 602, 584, 120, 1158, 355, 1144, 221, 879, 1286, 264, 609, 894,
+    393, 511, 497, 602, 1275, 1269, 1179, 401, 1262, 567, 1169, 842, 950, 1218, 1270, 449,
+    1274, 858, 604, 449, 1258, 301, 574, 712, 40, 420, 358, 1082, 572, 168, 1300, 177,
+    300, 433, 1088, 955, 773, 1203, 1107, 1248, 604, 122, 582, 1126, 337, 170, 170, 784,
+    1317, 54, 539, 539, 170, 1148, 30, 54, 54, 54, kNoPinyin, 54, 28, 170, 54, 54,
+    124, 891, 730, 730, 1262, 168, 168, kNoPinyin, 881, 52, 52, kNoPinyin, kNoPinyin, 576, 197, 108,
+    310, 822, 1198, 1198, 817, 1154, 1178, 363, 627, 815, 1213, 1083, kNoPinyin, 1293, 1185, 1026,
+    1212, 456, 376, 1158, 277, 1101, 197, 262, 413, 1260, kNoPinyin, 456, 1204, 1085, 569, 132,
+    122, 710, 1033, 1270, 1178, 461, 436, 124, 203, 269, 219, 805, 1082, 231, 1230, 1017,
+    958, 1067, kNoPinyin, 459, 421, 1043, 1197, 649, 47, 432, 684, 1177, 451, 1290, 581, 1154,
+    1061, 982, 950, 1017, 763, 400, 710, 256, 461, 1146, 1154, 72, 1195, 1118, 850, 1049,
+    1279, 850, 221, 221, 1051, 459, 1026, 243, 1178, 1260, 1042, 352, 1101, 950, 129, 988,
+    1229, 864, 292, 569, 1001, 421, 566, kNoPinyin, 541, 43, 195, 475, 47, 415, 203, 604,
+    1195, 1274, 456, 1201, 168, 528, 1084, 1026, 1179, 197, 1204, 613, 48, 742, 1199, 209,
+    993, 256, 995, 1162, 152, 132, 1024, 1201, 948, 1261, 1195, 1212, 264, 54, 363, 264,
+    1107, 417, 850, 212, 197, 1085, kNoPinyin, 1177, 336, 1169, 146, 590, 1154, 1004, 221, 132,
+    1204, 988, 1004, 824, kNoPinyin, 1169, 349, 1250, 16, 950, 94, 134, 988, 1226, 1257, 256,
+    221, 597, 132, 192, 582, 1318, 874, 822, 1146, 1201, 1177, 1101, 576, 470, 950, 51,
+    1168, 627, 1125, 995, 413, 1246, 1022, 269, 657, 52, 52, 537, 565, 1203, 1169, 613,
+    566, 1179, 1040, 217, 816, 1190, 925, 372, 1199, 631, 890, 847, kNoPinyin, 526, 299, 493,
+    62, 279, 1131, 682, kNoPinyin, 941, 31, 1203, 188, 430, 1123, 31, 1098, 470, 1195, 372,
+    1006, 849, 51, 771, 65, 934, 40, 1072, 220, 1306, 1175, 582, 523, 353, 1278, 947,
+    511, 1201, 307, 384, 1105, 1270, 433, 1153, 400, 1131, 446, 1103, 353, 740, 548, 437,
+    519, 1266, kNoPinyin, 1212, 1161, 128, 241, 131, 617, 301, 1099, 300, 319, 381, 548, 437,
+    329, 480, 1186, 68, 1105, 40, 567, 1210, 75, 1119, 814, 782, 842, 360, kNoPinyin, 1009,
+    1306, 801, 541, 708, 123, 1195, 75, 1114, 204, 468, 1190, 830, 1176, 244, 1162, 638,
+    900, 40, 264, 1199, 473, 1200, 1212, 400, 528, 1114, 1114, 983, 1013, 663, 1105, 892,
+    146, 1300, 1306, 468, 1098, 1114, 1210, 382, 1190, 50, 670, 117, 299, 577, 1181, 1285,
+    404, 830, 1160, 1250, 630, 830, 1142, 217, 51, 1127, 51, 98, 1085, 1266, 636, 927,
+    582, 803, 204, 645, 1175, 90, 519, 291, 645, 1306, 526, 570, 1222, 109, 1194, 815,
+    1160, 109, 1222, 586, 412, 1102, 291, 1222, 567, 1196, 235, 850, 1297, 773, 1277, 1177,
+    378, 1200, 465, 1162, 1317, 634, 204, 1143, 1047, 1261, 287, kNoPinyin, kNoPinyin, 1212, 1007, 1027,
+    820, 1067, 1324, 371, 337, 986, 805, 140, 1218, 663, 554, 168, 140, 1197, 1043, 1269,
+    1110, 445, 128, 1183, 1051, 449, 638, 513, 989, 559, 811, 1317, 369, 1163, 1104, 715,
+    1085, 604, 545, 1160, 1017, 770, 1248, 164, 1009, 1317, 168, 180, 531, 1024, 652, 244,
+    402, 1142, 1132, 1010, 463, 164, 1212, 805, 500, 983, 649, 858, 141, 193, 1212, 1193,
+    14, 1241, 369, 1013, 445, 791, 926, 1201, 565, 1227, 552, 1176, 445, 73, 449, 1102,
+    1009, 805, 730, 1179, 566, 470, 449, 1179, 715, 890, 1152, 140, 1163, 586, 649, 649,
+    715, 1129, 449, 1104, 649, 1163, 54, 81, 950, 1197, 950, 950, 566, 1273, 1174, 574,
+    565, 454, kNoPinyin, 304, 1178, 577, 210, 1253, 233, 805, 850, 384, 301, 1261, 1268, 19,
+    607, 301, 683, 229, 927, 832, 510, 154, 1301, 276, 1199, 406, 374, 314, 815, 631,
+    883, 221, 979, 1105, 1179, 104, 947, 1052, 1105, 743, 822, kNoPinyin, 442, 781, 1173, 1181,
+    21, 279, 124, 1131, 242, 1208, 1161, 299, 781, 682, 1126, 262, 475, 256, 334, 1182,
+    823, 29, 433, 877, 116, 728, 287, 1211, 434, 839, 782, 360, 394, 1181, 478, 947,
+    1179, 1271, 718, 309, 883, 430, 1007, 493, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, 258, 1300, 708, 1051,
+    950, 661, 337, 497, 586, 66, 1177, 339, 68, 781, 1201, 979, 1322, 75, 1195, 226,
+    438, 1261, 949, 950, 1037, 470, 108, 947, 947, 1147, 1253, 37, 384, 51, 943, 144,
+    948, 68, 1281, 134, 1213, 802, 1043, 823, 300, 1244, 591, 822, 300, 567, 1208, 781,
+    1164, 30, 67, 451, 334, 958, 1264, 677, 709, 718, 221, 436, 678, 206, 939, 1178,
+    977, 526, 482, 39, 442, 1043, 1131, 394, 448, 133, 269, 323, 65, 950, 673, 365,
+    1181, 478, 1274, 138, 930, 1043, 670, 559, 432, 1201, 1143, 877, 1320, 1270, 846, 927,
+    134, 1112, 1131, 858, 781, 1037, 1278, 398, 663, 515, 1169, 1110, 1111, 1137, 478, 100,
+    553, 433, 783, 890, 650, 1176, 1180, 350, 9, 237, 1196, 916, 496, 823, 605, kNoPinyin,
+    3, 229, 374, 897, 950, 503, 850, 1118, 1258, 1139, 1225, 1023, 195, 341, 332, 1271,
+    243, 617, 638, 548, 1078, 1126, 1210, 40, 1101, 988, 1201, 109, 1041, 68, 374, 437,
+    394, 181, 291, 108, 1078, 1270, 977, 1144, 1099, 1099, 1033, 332, 1297, 619, 1131, 822,
+    942, 372, 619, 1123, 144, 1266, 467, 1113, 1037, 631, 810, 565, 761, 897, 128, 319,
+    566, 1020, kNoPinyin, 1281, kNoPinyin, 1050, 591, 1317, 470, 114, 1202, 442, 314, 229, 1017, 113,
+    609, 362, 586, 38, 604, 565, 826, 807, 473, 661, 1317, 778, 10, 782, 1113, 1158,
+    1290, 559, 0, 505, 1004, 531, 246, 1087, 160, 1300, 1264, 41, 718, 174, 253, 1009,
+    236, 815, 823, 1297, 815, 1201, 455, 348, 634, 112, 1029, 1103, 571, 1017, 340, 195,
+    958, 1261, 604, 646, 604, 405, 56, 304, 541, 501, kNoPinyin, kNoPinyin, 685, 1078, 1222, kNoPinyin,
+    213, 1110, kNoPinyin, 428, 574, kNoPinyin, 641, 485, 1184, 218, 571, 360, 1112, 247, 1051, 1085,
+    173, 302, 887, 433, 264, 887, 125, 1024, 1239, 396, 1165, 250, 1106, 1199, 503, 1130,
+    417, 1086, 302, 1253, 101, 837, 936, 393, 528, 1029, 673, 830, 830, 398, 1046, 173,
+    413, 1175, 661, 442, 248, 442, 977, 527, 402, 1144, 1259, 451, 1261, 52, 1271, 1300,
+    1137, 1173, 639, 757, 3, 453, kNoPinyin, 638, 166, 1004, 33, 1107, 569, 1000, 1105, 590,
+    1310, 1175, 734, 1092, 884, 1013, 1000, 826, 321, 976, 160, 68, 759, 903, 51, 912,
+    314, 1300, 1098, 1187, 418, 1033, 590, 485, 997, 919, 983, 1079, 382, 1263, 1263, 614,
+    1179, 1203, 1014, 720, 1103, 436, 320, 622, 471, kNoPinyin, kNoPinyin, 1000, kNoPinyin, kNoPinyin, kNoPinyin, 680,
+    603, 1000, 747, 1310, 1055, 1137, 349, 1147, 571, 954, 16, 629, 670, 613, 51, 1087,
+    590, 219, 830, 173, 1177, 604, 16, 503, 826, 184, 817, 113, 1012, 630, 1190, 110,
+    291, 459, 55, 958, 599, 1139, 173, 593, 1222, 442, 91, 565, 1109, 1102, 490, kNoPinyin,
+    47, kNoPinyin, kNoPinyin, 1264, 604, 406, 433, 811, 423, 826, 802, 582, 1000, 1139, 909, 127,
+    530, 977, 592, 694, 391, 794, 995, 276, 831, 857, 1165, 1015, 1117, 475, 446, 1318,
+    576, 451, 552, 253, 1009, 1219, 432, 441, 1271, 217, 1158, 1187, 253, 475, 734, 1026,
+    812, 1037, kNoPinyin, kNoPinyin, 235, 927, 484, 441, 286, 995, 603, 471, 423, 1201, 569, 1297,
+    830, 822, 1297, 557, 51, 1037, 413, 1175, 258, 362, 207, 470, 288, 197, 40, 1179,
+    6, 1303, 1154, 229, 1281, 391, 1292, 432, 718, 1004, 431, 845, 62, 1184, 530, 723,
+    1140, 442, 442, kNoPinyin, 102, 1270, 660, 565, 557, 432, 1314, 526, 930, 778, 539, 245,
+    976, 168, 618, 55, 37, 603, kNoPinyin, kNoPinyin, 593, 264, 602, 1126, 442, 544, 68, 440,
+    1171, 109, 1114, 442, 1102, 349, 88, 720, 558, 183, 854, 761, 613, 1312, 605, 1227,
+    720, 475, 1014, 957, 544, 454, 850, 1178, 1261, 233, 1253, 805, 228, 1052, 822, 154,
+    927, 433, 276, 229, 641, 743, 1103, 104, 1131, 309, 75, 1007, 470, 256, 116, 1271,
+    682, 40, 314, 29, 823, 1171, 838, 478, 1101, 334, 493, 279, 429, 242, 728, 21,
+    1201, 823, 1264, 823, 337, 67, 261, 802, 75, 20, 1208, 1314, 678, 206, 438, 226,
+    1195, 1037, 68, 586, 976, 822, 591, 37, 950, 1147, 936, 51, 709, 781, 258, 1131,
+    496, 553, 270, 631, 1158, 1196, 128, 437, 1173, 694, 1270, 207, 1043, 617, 229, 1180,
+    485, 1239, 1278, 1112, 1041, 237, 1110, 406, 858, 919, 437, 1169, 323, 663, 1264, 916,
+    448, 1178, 110, 138, 1015, 7, 1181, 891, 1281, 552, 810, 1099, 541, 1020, 571, 503,
+    1118, 1000, 566, 1266, 144, 360, 319, 1037, 1139, 195, 619, 291, 1126, 591, 484, 441,
+    897, 1026, 548, 822, 468, 0, 826, 259, 1029, 195, 634, 41, 815, 213, 515, 531,
+    112, 1103, 340, 613, 160, 1290, 455, 1270, 1110, 473, 428, 807, 1009, 236, 442, 470,
+    646, 1300, 837, 1184, 485, 826, 980, 264, 101, 830, 1271, 250, 983, 417, 413, 3,
+    247, 639, 599, 1300, 286, 638, 670, 1263, 68, 321, 720, 1014, 471, 720, 680, 590,
+    382, 33, 1179, 436, 62, 884, 55, 1012, 630, 613, 47, 1190, 459, 219, 1310, 1147,
+    590, 1009, 475, 576, 811, 603, 253, 546, 812, 183, 826, 215, 431, 557, 413, 1297,
+    569, 1179, 102, 55, 539, 109, 1114, 113, 113, 465, 17, 231, 853, 577, 649, 113,
+    641, 623, 965, 926, 431, 641, 1161, 51, 374, 51, kNoPinyin, 484, 493, 44, 394, 899,
+    910, 1111, 1111, 440, 662, 1106, kNoPinyin, 243, 1239, 696, kNoPinyin, 777, 1108, 586, 54, 51,
+    899, 384, 347, 321, 321, 272, 146, 396, 353, 662, kNoPinyin, 532, 549, 616, 1040, 921,
+    468, 1208, 1208, 110, 856, 584, 112, 924, 532, 1160, 1089, 1161, 264, 424, 1201, 1089,
+    1117, 34, 1117, 856, 1170, 1089, 29, 10, 1085, 1180, 535, 863, 544, 244, kNoPinyin, kNoPinyin,
+    1028, 720, 1004, 485, 384, 863, 157, 347, 243, 816, 527, 1013, 347, 790, 489, 1105,
+    423, 110, 784, 209, 413, 1004, 1089, kNoPinyin, 641, 965, 926, 1163, 374, 51, 1091, 157,
+    899, 1085, 1111, 394, 440, 662, 493, 643, 1239, 696, 353, 1089, 1004, 662, 616, 485,
+    272, 321, 384, 532, 463, 1208, 549, 244, 1201, 1160, 112, 1105, 1089, 424, 1161, 264,
+    110, 544, 856, 423, 535, 863, 321, 1028, 1004, 863, 489, 413, 302, 302, 555, 253,
+    1129, 822, 1101, 1179, 1067, 1180, 1165, 242, 264, 943, 29, 771, 503, 1211, 894, 1269,
+    782, 458, 280, 1165, 1180, 1263, 450, 127, 264, 853, 220, 1311, 1324, 226, 587, 0,
+    1067, 1067, 38, 65, 302, 435, 604, 594, 124, 1131, 260, 599, 670, 445, 955, 260,
+    1113, 268, 355, 1198, 307, 926, 1154, 833, 1131, 164, 302, 51, 1107, 926, 943, 1270,
+    810, 242, 1205, 1263, 144, 1113, kNoPinyin, 720, 1211, 1112, 771, 771, 1306, 1176, 252, 609,
+    1180, 467, 160, 124, 782, 586, 1017, 1113, 604, kNoPinyin, 1112, 1180, 1280, 1165, 881, 926,
+    136, 1163, 1180, 1199, 218, 1199, 593, 1084, 1084, 720, 253, 993, 9, 417, 450, 993,
+    1182, 307, 1162, 420, 321, 1211, 1101, 1086, 6, 1105, 1013, 435, 1252, 211, 16, 1105,
+    1182, kNoPinyin, 874, 582, 1059, 217, 783, 995, 993, 1201, 1112, 287, 709, 268, 432, 211,
+    1103, 1182, 262, 420, 594, 1102, 567, 567, 567, 1290, 385, 1267, 1294, 480, 687, 1179,
+    863, 1163, 839, 1157, 1135, 1157, 433, 340, 413, 1270, 336, 480, 170, 1190, 467, 144,
+    401, 1214, 615, 1199, 140, 227, 992, 374, 431, 967, 349, 144, 1214, 1190, 432, 1102,
+    140, 592, 565, 687, 1149, 1214, 433, 433, 1200, 1199, 1150, 681, 297, 916, 678, 1089,
+    287, 763, 1210, 567, 567, 13, 586, 557, 8, 35, 645, 226, 209, 1131, 1101, 1256,
+    1140, 435, 678, 124, 1118, 1239, 1040, 1263, 773, 638, 586, 814, 139, 431, 921, 283,
+    1092, 1246, 1180, 708, 1281, 1063, 582, kNoPinyin, 240, 1184, 1101, 586, 967, 586, 1107, 394,
+    1180, 670, 627, 1211, 592, 647, 62, 1101, 1087, 431, 1181, 1103, 1179, 5, 206, 217,
+    1113, 1201, 604, 593, 203, 433, 763, 1165, 22, 781, 1085, kNoPinyin, 1104, 435, 625, 647,
+    645, 557, 567, 431, 5, 286, 203, 593, 586, 6, 291, 567, 36, kNoPinyin, 385, 385,
+    66, 842, 842, 459, 1027, 1261, 459, 130, 845, 459, 459, 226, 459, 1027, 283, 283,
+    496, 650, 654, 654, 769, 1175, 1029, 423, 1175, 321, 233, 100, 440, 879, 219, 247,
+    1101, 879, 839, 456, 1148, 728, 21, 1182, 902, 682, 670, 1311, 197, 30, 1179, 1171,
+    1017, 1067, 437, 394, 767, 1166, kNoPinyin, 1180, 437, 1017, 433, 1123, 7, 7, 387, 332,
+    kNoPinyin, 197, 830, 1039, 1078, 1187, 992, 1033, 833, 1147, 507, 46, 1004, 1251, 65, 535,
+    467, 540, 1125, 887, 31, 1179, 849, 849, 384, 1121, 678, 468, 440, 52, 218, 440,
+    kNoPinyin, 1016, 334, 1004, 40, 1123, 759, 321, 51, 535, kNoPinyin, 597, 356, 831, 1148, 432,
+    440, 443, 111, 197, 431, 1112, 822, 245, 1073, 440, 544, 1085, 879, 300, 640, 473,
+    321, 1086, 833, 372, 115, kNoPinyin, 887, 1154, 938, 1086, 321, 40, 1016, 334, 1212, kNoPinyin,
+    51, 1086, 423, 245, 1073, 245, 1085, 879, 300, 372, 1086, 1212, 1016, 465, 465, 1110,
+    1125, 1110, 432, 1180, 1214, 1212, 932, 555, 778, 391, 1184, 1212, 778, 1180, 1180, 1116,
+    404, 1175, 235, 844, 528, 1117, 974, 371, 1140, 1177, 1143, 340, 982, 529, 815, 376,
+    1201, 1077, 28, 256, 219, 204, 761, 802, 587, 94, 458, 558, 384, 830, 264, 262,
+    1086, 451, 341, 941, 1177, 941, 368, 251, 785, 800, 559, 301, 437, 1047, 423, 528,
+    437, 555, 1041, 127, 1186, 478, 402, 374, 458, 1059, 1059, 797, 543, 1059, 1300, 1300,
+    160, 236, 543, 1161, 374, 440, 497, 187, 461, 838, 1177, 904, 1024, 262, 264, 1161,
+    425, 488, 1191, 1285, 1161, 1112, 1129, 1178, 1205, 912, 223, 223, 444, 511, 559, 576,
+    792, 1179, 628, 814, 874, 382, 831, 340, 1154, 822, 420, 1249, 890, 393, 62, 1112,
+    797, 602, 545, 720, 858, 1175, 235, 844, 371, 1117, 974, 1140, 1143, 1077, 340, 256,
+    815, 28, 982, 376, 1201, 602, 587, 804, 458, 451, 437, 1031, 374, 1186, 461, 368,
+    1177, 797, 423, 1059, 374, 1186, 1186, 497, 1024, 1191, 264, 1285, 1161, 262, 720, 628,
+    223, 912, 382, 559, 1249, 890, 797, 858, 291, 55, kNoPinyin, 300, 1106, 1248, 55, 903,
+    20, 1006, 581, 341, 1147, 934, 470, 48, 977, 1086, 1165, 1169, 983, 485, 913, 276,
+    590, 1103, 576, 789, 789, 590, 55, 55, 56, 576, kNoPinyin, 916, 291, 55, 291, 1165,
+    1248, 55, 903, 470, 977, 983, 1169, 590, 789, 55, 55, 283, 275, 283, 283, 948,
+    948, 83, 432, 236, 979, 1066, 1246, 996, 1116, 1063, 879, 1201, 473, 134, 1182, 278,
+    278, 996, 1182, 1281, 1177, 1244, 51, 452, 1016, 591, 170, 1038, 979, 36, 950, 260,
+    370, 879, 1029, 448, 437, 65, 1169, 1043, 170, 1116, 1166, 1166, 269, 1163, 556, 1176,
+    83, 67, 699, 264, 72, 480, 243, 988, 1199, 950, 1169, 425, 362, 950, 442, 1292,
+    65, 1113, 75, 1175, 1009, 285, 1250, 1087, 348, 264, 738, 425, 402, 417, 1038, 423,
+    440, 398, 384, 1131, 287, 1087, 339, 100, 982, 1013, 68, 317, 1105, 530, 592, 983,
+    1017, 1175, 1210, 668, 1013, 628, 51, 1201, 1137, 455, 909, 530, 1287, 927, 134, 206,
+    1179, 432, 872, 127, 1190, 1016, 423, 1116, 1246, 287, 370, 645, 1163, 668, 109, 1116,
+    613, 1314, 692, 948, 236, 432, 1066, 1131, 1063, 1105, 879, 1201, 134, 278, 1182, 442,
+    950, 36, 979, 260, 1177, 269, 872, 1116, 437, 556, 448, 1176, 65, 68, 243, 264,
+    1199, 699, 480, 362, 425, 1113, 348, 100, 530, 339, 983, 109, 1175, 668, 68, 592,
+    1137, 455, 628, 909, 1287, 692, 953, 528, 361, 1114, 288, 20, 709, 51, 68, 1051,
+    371, 283, 440, 7, 5, 302, 1110, 1088, 1126, 288, 62, 1130, 622, 1201, 292, 374,
+    221, 1067, 1066, 132, 1153, 1281, 1267, 773, 1129, 883, 903, 1182, 1089, 1268, 206, 616,
+    1195, 68, 36, 519, 1067, 1179, 853, kNoPinyin, 853, 460, 69, 1253, 1202, 777, 1277, 470,
+    1281, 735, 467, 781, 1224, 439, 586, 1261, 1006, 302, 1166, 949, 51, 1067, 1067, 979,
+    590, 623, 786, 1017, 1270, 884, 1022, 240, 1153, 858, 939, 460, 269, 370, 68, kNoPinyin,
+    1180, 615, kNoPinyin, 206, 1125, 590, 468, 981, 838, 631, 572, 374, 1051, 1147, 1061, 480,
+    262, 129, 1130, 4, 604, 1290, 1274, 937, 786, 531, 1017, 541, 1303, 500, 815, 815,
+    1163, 283, 913, 1162, 451, 1170, 1101, 788, 173, 788, 823, 283, 417, 440, 431, 1201,
+    1024, 858, 1107, 1303, 528, 887, 977, 341, 1067, 530, 983, 822, 128, 1270, 590, 763,
+    1022, 1102, 92, 245, 1163, 1203, 1306, 913, 927, 565, 1270, 968, 604, 1103, 613, 1250,
+    670, 18, 83, 792, 173, 853, 51, 1270, 1201, 1140, 406, 67, 988, 1118, 582, 110,
+    254, 590, 1067, 1235, 1009, 446, 1037, 1163, 613, 1246, 457, 1179, 1175, 1066, 62, 1308,
+    1163, 778, 616, 1022, 1114, 435, 967, 468, 1102, 412, 565, 55, 622, 1201, 1067, 1153,
+    132, 853, 883, 68, 616, 1224, 949, 979, 302, 467, 1306, 1281, 1067, 735, 439, 1179,
+    1006, 1118, 623, 1180, 446, 406, 615, 370, 786, 55, 565, 129, 1163, 1126, 838, 480,
+    815, 815, 500, 1290, 1303, 988, 83, 788, 1270, 528, 913, 1101, 16, 590, 822, 927,
+    792, 613, 173, 110, 1308, 435, 967, 1114, 339, 1086, 1086, 1086, 1199, 313, 1179, 11,
+    1047, 1125, 34, 51, 131, 1025, 220, 511, 368, 830, 336, 516, 321, 1060, 329, 786,
+    51, 497, 483, 1199, 994, 597, 68, 1118, 763, 67, 169, 520, 63, 668, 576, 597,
+    694, 245, 1223, 994, 1025, 63, 520, 602, 317, 317, 833, 494, 830, 554, 1229, 55,
+    531, 531, 1026, 281, 1137, 867, 634, 206, 531, 63, 274, 1033, 781, 1300, 274, 867,
+    1026, 769, 781, 634, 300, 268, 884, 853, kNoPinyin, 1137, 343, 435, 778, 1282, 931, 919,
+    1026, 567, 63, 1303, 1026, 778, 980, 1264, 858, 1303, 974, 440, 259, 402, 539, 463,
+    815, 569, 1262, 63, 778, 670, 908, 630, 628, 918, 1140, 581, 822, 822, 730, 413,
+    519, 723, 63, 581, 869, 243, 243, 696, 396, 1105, 243, 373, 243, 243, 463, 115,
+    1201, 1201, 567, 473, 301, 823, 353, 1303, 592, 353, 928, 1201, 355, 640, 435, 815,
+    453, 528, 425, 20, 805, 640, 1143, 1162, 1118, 573, 1201, 1059, 814, 1082, 573, 1087,
+    440, 131, 789, 51, 668, 434, 1140, 141, 1162, 1248, 1199, 210, 877, 435, kNoPinyin, 331,
+    1067, 229, 434, 1143, 262, 264, 919, 376, 1063, 670, 453, 941, 277, 1203, 49, 603,
+    1089, 402, 602, 1214, 280, 288, 682, 1195, kNoPinyin, kNoPinyin, 384, 1107, 853, 371, 782, 586,
+    1067, 67, 850, 801, 300, 51, 435, 1087, 467, 227, 68, 1195, 358, 781, 711, 1130,
+    1006, 37, 302, 1240, 470, 337, kNoPinyin, kNoPinyin, kNoPinyin, 1004, 451, 958, 400, 1116, 268, 10,
+    1085, 1032, 1278, 1183, 581, 615, 1043, 1177, 815, 66, 1086, 446, 75, 353, 1110, 321,
+    421, kNoPinyin, kNoPinyin, 495, kNoPinyin, 258, 478, 1024, 653, 1118, 1215, 919, 838, 1199, 699, 1258,
+    358, 329, kNoPinyin, 1099, 850, 1040, 301, 1078, 1033, 566, 919, 919, 319, 645, kNoPinyin, kNoPinyin,
+    kNoPinyin, kNoPinyin, 1192, 708, 1300, 815, 842, 1116, 699, 164, 435, 227, 837, 340, 1276, 238,
+    541, 283, 708, 1179, 531, 604, 466, 112, 457, 609, 586, 1306, 565, 646, 1303, 1270,
+    711, kNoPinyin, kNoPinyin, kNoPinyin, 947, 939, 426, 950, 398, 1130, 1278, 539, 1303, 435, 52, 52,
+    415, 858, 1230, 1084, 1084, 1199, 864, 887, 231, 417, 571, 1162, 850, 849, 442, 51,
+    264, 1165, 302, 904, 441, 1107, 1068, 402, kNoPinyin, 900, kNoPinyin, 1088, 440, 382, 1098, 280,
+    913, 590, 622, 948, 947, 347, kNoPinyin, 1022, 1004, 1169, 321, 884, 823, 815, 1088, 900,
+    kNoPinyin, 569, 16, 555, 420, 662, 435, 1033, 853, 440, 913, 628, 1103, 850, 57, 432,
+    435, 1279, 443, 849, 1285, 1191, 1250, 490, 1150, 58, 475, 853, 1117, 67, 448, 1153,
+    988, 417, 1320, 927, 927, 275, 356, 582, 1153, 656, 1104, kNoPinyin, kNoPinyin, 290, 347, 400,
+    519, 1232, 913, 1246, 312, 356, 944, 566, 113, kNoPinyin, kNoPinyin, kNoPinyin, 890, 435, 1143, 431,
+    kNoPinyin, 567, 581, 567, 660, 1261, 1116, 264, 602, 349, 565, 1110, 1199, 210, 434, 1195,
+    1063, 603, 280, 19, 384, 67, 801, 711, 602, 1195, 1240, 302, 68, 37, 400, 781,
+    1006, 353, 451, 495, 1086, 268, 1043, 1230, 400, 519, 435, 448, 1110, 1215, 1116, 1153,
+    329, 565, 569, 440, 566, 948, 1033, 358, 919, 1078, 478, 435, 1192, 842, 586, 815,
+    1306, 283, 531, 112, 340, 708, 711, 227, 457, 939, 947, 1300, 290, 231, 51, 113,
+    950, 1088, 1084, 904, 264, 849, 302, 417, 858, 443, 52, 913, 16, 815, 1004, 1181,
+    1169, 280, 440, 555, 57, 1150, 58, 628, 662, 1191, 1087, 1103, 475, 927, 582, 1320,
+    431, 312, 566, 1246, 348, 716, 1178, 300, 567, 463, 74, 1163, 300, 227, 432, 294,
+    kNoPinyin, 310, 947, 294, 663, 36, 1202, 1267, 404, 839, 299, 287, 1089, 440, 947, 1201,
+    297, 1168, 477, 475, 781, 412, 1263, 36, 1163, 1155, 1266, 279, 294, 1089, 747, 1020,
+    436, 735, 586, 660, 300, 1067, 1089, 567, 54, 1270, 320, 1202, 1300, 854, 1118, 131,
+    206, 467, 1197, 337, 1271, 1201, 1164, 886, 1155, 1037, 1201, kNoPinyin, 1184, 1290, 1098, 268,
+    341, 6, 1267, 1163, 391, 446, 433, 581, 1278, 877, 1177, 394, 615, 890, 673, 320,
+    879, 446, 1137, 1274, 1267, 615, kNoPinyin, kNoPinyin, kNoPinyin, 605, 437, 435, 1199, 412, 1068, 72,
+    1099, 471, 1201, 68, 1154, 1154, 51, 1102, 480, 468, 1051, 457, 1024, 262, 262, 524,
+    402, 1100, 939, 543, kNoPinyin, kNoPinyin, 604, 801, 955, 300, 7, 1256, 778, 839, 822, 38,
+    227, 604, 863, 440, 468, 1053, 1155, 1202, 815, 565, 1175, 1290, 505, 1292, 531, 943,
+    815, 457, 1179, 1179, 457, 1300, 541, 238, 814, 164, 328, 467, 853, kNoPinyin, kNoPinyin, 432,
+    958, kNoPinyin, 134, 656, 887, 7, 849, 1024, 402, 1024, 264, 450, 634, 300, 163, 1051,
+    1162, 384, 1203, 785, 1212, 638, 402, 1184, 256, 1101, 468, kNoPinyin, 87, 281, 340, 1184,
+    1203, 1144, 1092, 947, 385, 144, 1013, 1109, 900, 590, 433, 338, 440, 1294, 374, 1300,
+    1300, 710, 1171, 1163, 432, 567, 1028, 510, 1023, 1023, 710, 1051, 622, 446, 317, 1028,
+    124, 567, 1285, 1260, 16, 1170, 1176, 747, 134, 1270, 576, 884, 597, 51, 967, 1297,
+    1199, 1099, 475, 1181, 858, 977, 446, 1179, 405, 51, 1184, 988, 417, 276, 446, 576,
+    1163, 494, 466, 1111, 1111, 1051, 626, 1318, 1201, 1184, 604, 1055, 1111, 1149, 1179, 784,
+    956, 613, 814, 1177, 433, 1258, 1199, 1246, 1175, 1165, 784, 723, 431, 649, 1184, 645,
+    219, 1208, 1199, 558, 37, 602, 385, 593, 967, 1208, 1184, 349, 854, 565, 605, 716,
+    463, 432, 1202, 663, 947, 747, 1155, 87, 36, 1263, 337, 238, 602, 1155, 1118, 1164,
+    586, 1267, 854, 1202, 1149, 1067, 977, 1270, 268, 341, 1137, 391, 1274, 320, 605, 394,
+    1099, 68, 565, 471, 402, 262, 1201, 1111, 1024, 1100, 863, 656, 7, 531, 38, 778,
+    822, 164, 328, 1202, 988, 402, 384, 264, 338, 849, 1300, 638, 678, 710, 1171, 1092,
+    590, 433, 710, 440, 385, 1176, 1184, 1260, 576, 576, 446, 466, 1201, 604, 1145, 1246,
+    1184, 431, 645, 349, 967, 603, 454, 586, 441, 1111, 193, 441, 441, 1161, 193, 604,
+    1194, 178, 434, 55, 178, 55, 1281, 478, 1280, 440, 649, 649, 1099, 590, 124, 478,
+    582, 708, 815, 604, 466, 478, 457, 567, 1114, 1161, 436, 649, 567, 938, 1250, 582,
+    457, 432, 586, 1161, 178, 627, 627, 320, 118, 299, 653, 653, 299, 769, 856, 854,
+    673, 299, 1113, 541, 854, 654, kNoPinyin, 291, 299, 854, 654, 621, 637, 671, 420, kNoPinyin,
+    1306, 701, 288, 417, 417, 454, 350, 1027, 1048, 391, 1102, 525, 391, 957, 565, 711,
+    131, 386, 386, 1179, 823, 204, 1105, 1056, 670, 670, 823, 203, 146, 1196, 225, 1176,
+    1107, 1162, 853, 639, 1162, 843, 1201, 565, 208, 245, 85, 1180, 10, 1160, 1010, 10,
+    1262, 203, 85, 1176, 638, 205, 1162, 245, 602, 1269, 289, 300, 301, 662, 662, 1203,
+    180, 856, 117, 1070, 1278, 1267, 631, 16, 58, 1067, 51, 1203, 117, 1067, 235, 651,
+    685, 235, 1300, 339, 339, 238, 288, 1017, 1202, 782, 112, 317, 817, 1202, 1012, 1021,
+    957, 957, 288, 286, 1089, 20, 227, 1067, 1043, 854, 943, 948, 1197, 948, 1040, 1099,
+    713, 457, 425, 468, 1162, 1051, 1024, 1102, 1112, 1162, 557, 49, 1170, 850, 371, 1098,
+    1101, 397, 1105, 321, 1238, 1139, 1094, 1238, 730, 693, 815, 1242, 435, 1300, 432, 432,
+    815, 432, 133, 126, 126, 384, 1156, 501, 1125, 767, 195, 950, 1300, 131, 713, 469,
+    1033, 586, 586, 143, 858, 1125, 501, 720, 466, 1170, 168, 532, 1200, 145, 1178, 708,
+    195, 1306, 855, 702, 1112, 748, 264, 1097, 1179, 166, 1306, 223, 145, 456, 1158, 133,
+    126, 384, 501, 469, 586, 767, 1033, 1300, 501, 1200, 168, 855, 1097, 593, 763, 331,
+    763, 1162, 593, 593, 331, 487, 1004, 586, 1004, 593, 331, 487, 353, 849, 58, 353,
+    1208, 162, 384, 475, 1123, 1201, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin,
+    kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin,
+    kNoPinyin, kNoPinyin, kNoPinyin, 926,
+};
+
+constexpr unsigned short kFirst1 = 0xf90e;
+constexpr unsigned short kLast1 = 0xfa2d;
+
+constexpr unsigned short kRange1[] = {
+    539, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin,
+    kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin,
+    kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin,
+    kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin,
+    kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin,
+    kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin,
+    kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin,
+    kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin,
+    kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin,
+    kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin,
+    kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin,
+    kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin,
+    kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin,
+    kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin,
+    kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin,
+    kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, kNoPinyin, 1101, 431,
+    kNoPinyin, kNoPinyin, 1272, kNoPinyin, 843, kNoPinyin, kNoPinyin, 1102, 1278, 1179, 566, 940, 1115, 300, 459, 457,
+    1200, kNoPinyin, kNoPinyin, kNoPinyin, 1278, kNoPinyin, kNoPinyin, 1179, 244, kNoPinyin, kNoPinyin, kNoPinyin, 278, 979, 348, 385,
+};
+
+static_assert(sizeof(kRange0) / sizeof(kRange0[0]) == kLast0 - kFirst0 + 1, "invalid pinyin table");
+static_assert(sizeof(kRange1) / sizeof(kRange1[0]) == kLast1 - kFirst1 + 1, "invalid pinyin table");
+
+}  // namespace Pinyin end
+
+#endif  // SERVICE_BACKEND_PINYINDICT_H_
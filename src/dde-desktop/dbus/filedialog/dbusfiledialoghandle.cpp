@@ -163,6 +163,14 @@ void DBusFileDialogHandle::makeHeartbeat()
     m_heartbeatTimer.start();
 }
 
+/*!
+ * \brief DBusFileDialogHandle::stopHeartbeat 预先创建的对话框在交给调用方之前不需要心跳
+ */
+void DBusFileDialogHandle::stopHeartbeat()
+{
+    m_heartbeatTimer.stop();
+}
+
 quint32 DBusFileDialogHandle::windowFlags() const
 {
     return widget()->windowFlags();
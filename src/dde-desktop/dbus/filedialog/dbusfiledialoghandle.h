@@ -63,6 +63,7 @@ public:
 
     int heartbeatInterval() const;
     void makeHeartbeat();
+    void stopHeartbeat();
 
     quint32 windowFlags() const;
 
@@ -18,12 +18,21 @@
 
 #include <QDBusConnection>
 
+// 预先创建的对话框数量，每个对话框都包含完整的窗口、视图和侧边栏，不宜过多
+#define FILE_DIALOG_POOL_SIZE 1
+// 对话框关闭后等待多久再预先创建下一个，避免与正在打开的对话框争抢界面线程（毫秒）
+#define FILE_DIALOG_PREPARE_DELAY 3000
+// 长时间没有使用对话框时释放预先创建的对话框（毫秒）
+#define FILE_DIALOG_POOL_RELEASE_TIMEOUT (10 * 60 * 1000)
+
 DFM_USE_NAMESPACE
 
 DBusFileDialogManager::DBusFileDialogManager(QObject *parent)
     : QObject(parent)
 {
-
+    m_poolReleaseTimer.setSingleShot(true);
+    m_poolReleaseTimer.setInterval(FILE_DIALOG_POOL_RELEASE_TIMEOUT);
+    connect(&m_poolReleaseTimer, &QTimer::timeout, this, &DBusFileDialogManager::releaseDialogPool);
 }
 
 QDBusObjectPath DBusFileDialogManager::createDialog(QString key)
@@ -31,6 +40,32 @@ QDBusObjectPath DBusFileDialogManager::createDialog(QString key)
     if (key.isEmpty())
         key = QUuid::createUuid().toRfc4122().toHex();
 
+    const QDBusObjectPath path("/com/deepin/filemanager/filedialog/" + key);
+
+    if (m_dialogObjectMap.contains(path)) {
+        return path;
+    }
+
+    initEnvironment();
+
+    DBusFileDialogHandle *handle = takeDialog();
+    Q_UNUSED(new FiledialogAdaptor(handle));
+
+    if (!QDBusConnection::sessionBus().registerObject(path.path(), handle)) {
+        qWarning("Cannot register to the D-Bus object.\n");
+        handle->deleteLater();
+
+        return QDBusObjectPath();
+    }
+
+    m_dialogObjectMap[path] = handle;
+    connect(handle, &DBusFileDialogHandle::destroyed, this, &DBusFileDialogManager::onDialogDestroy);
+
+    return path;
+}
+
+void DBusFileDialogManager::initEnvironment()
+{
     g_isFileDialogMode = true;
 
     if (!initJobDone) {
@@ -80,27 +115,48 @@ QDBusObjectPath DBusFileDialogManager::createDialog(QString key)
 
         initJobDone = true;
     }
+}
 
-    DBusFileDialogHandle *handle = new DBusFileDialogHandle();
-    Q_UNUSED(new FiledialogAdaptor(handle));
-
-    const QDBusObjectPath path("/com/deepin/filemanager/filedialog/" + key);
+/*!
+ * \brief DBusFileDialogManager::takeDialog 优先使用预先创建好的对话框，没有时再创建
+ */
+DBusFileDialogHandle *DBusFileDialogManager::takeDialog()
+{
+    DBusFileDialogHandle *handle = nullptr;
 
-    if (m_dialogObjectMap.contains(path)) {
-        return path;
+    if (!m_dialogPool.isEmpty()) {
+        handle = m_dialogPool.takeFirst();
+        handle->makeHeartbeat();
+    } else {
+        handle = new DBusFileDialogHandle();
     }
 
-    if (!QDBusConnection::sessionBus().registerObject(path.path(), handle)) {
-        qWarning("Cannot register to the D-Bus object.\n");
-        handle->deleteLater();
+    // 使用过对话框的程序很可能会再次打开对话框
+    m_poolReleaseTimer.start();
+    QTimer::singleShot(FILE_DIALOG_PREPARE_DELAY, this, &DBusFileDialogManager::prepareDialogs);
 
-        return QDBusObjectPath();
+    return handle;
+}
+
+void DBusFileDialogManager::prepareDialogs()
+{
+    if (!m_poolReleaseTimer.isActive())
+        return;
+
+    while (m_dialogPool.size() < FILE_DIALOG_POOL_SIZE) {
+        DBusFileDialogHandle *handle = new DBusFileDialogHandle();
+
+        handle->stopHeartbeat();
+        m_dialogPool << handle;
     }
+}
 
-    m_dialogObjectMap[path] = handle;
-    connect(handle, &DBusFileDialogHandle::destroyed, this, &DBusFileDialogManager::onDialogDestroy);
+void DBusFileDialogManager::releaseDialogPool()
+{
+    for (DBusFileDialogHandle *handle : m_dialogPool)
+        handle->deleteLater();
 
-    return path;
+    m_dialogPool.clear();
 }
 
 void DBusFileDialogManager::destroyDialog(const QDBusObjectPath &path)
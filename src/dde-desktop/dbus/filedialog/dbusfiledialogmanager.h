@@ -7,6 +7,9 @@
 
 #include <QObject>
 #include <QDBusObjectPath>
+#include <QTimer>
+
+class DBusFileDialogHandle;
 
 class DBusFileDialogManager : public QObject
 {
@@ -28,8 +31,15 @@ public:
 
 private:
     void onDialogDestroy();
+    void initEnvironment();
+    DBusFileDialogHandle *takeDialog();
+    void prepareDialogs();
+    void releaseDialogPool();
 
     bool initJobDone = false;
+    //! 预先创建好的对话框，只使用一次，不会复用调用方用过的对话框
+    QList<DBusFileDialogHandle *> m_dialogPool;
+    QTimer m_poolReleaseTimer;
 
     QString m_errorString;
     QMap<QDBusObjectPath, QObject*> m_dialogObjectMap;
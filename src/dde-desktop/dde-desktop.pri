@@ -62,6 +62,7 @@ SOURCES += \
     $$PWD/screen/screenobjectwayland.cpp \
     $$PWD/dbus/licenceInterface.cpp \
     $$PWD/view/canvasviewmanager.cpp \
+    $$PWD/view/desktopsnapshot.cpp \
     $$PWD/presenter/deepinlicensehelper.cpp
 
 
@@ -96,6 +97,7 @@ HEADERS += \
     $$PWD/screen/screenmanagerwayland.h \
     $$PWD/screen/screenobjectwayland.h \
     $$PWD/view/canvasviewmanager.h \
+    $$PWD/view/desktopsnapshot.h \
     $$PWD/screen/abstractscreenmanager_p.h \
     $$PWD/accessible/frameaccessibledefine.h \
     $$PWD/accessible/accessiblelist.h \
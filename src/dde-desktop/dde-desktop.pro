@@ -90,6 +90,7 @@ SOURCES += \
     screen/screenobjectwayland.cpp \
     dbus/licenceInterface.cpp \
     view/canvasviewmanager.cpp \
+    view/desktopsnapshot.cpp \
     presenter/deepinlicensehelper.cpp
 
 
@@ -125,6 +126,7 @@ HEADERS += \
     screen/screenmanagerwayland.h \
     screen/screenobjectwayland.h \
     view/canvasviewmanager.h \
+    view/desktopsnapshot.h \
     accessibility/ac-desktop-define.h \
     accessibility/acobjectlist.h \
     desktopprivate.h \
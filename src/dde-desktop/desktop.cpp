@@ -20,6 +20,9 @@
 #include "config/config.h"
 #include "desktopitemdelegate.h"
 
+#include <dfmtrace.h>
+#include <dfmmetrics.h>
+
 Desktop::Desktop()
     : d(new DesktopPrivate)
 {
@@ -216,7 +219,7 @@ void Desktop::PrintInfo()
             if (core->screensCoordInfo.contains(screenNum)) {
                 auto coord = core->screensCoordInfo.value(screenNum);
                 qInfo() << "coord " << coord.first << "*" << coord.second
-                        << "display items count" << core->itemGrids.value(screenNum).size();
+                        << "display items count" << core->screens.value(screenNum).itemCount();
             } else {
                 qCritical() << "Grid" << iter.value()->screenNum() << "not find coordinfo";
             }
@@ -291,3 +294,24 @@ bool Desktop::SetIconSizeMode(int iSizeMode)
     }
     return true;
 }
+
+/*!
+ * \brief Desktop::StartTrace 开始记录耗时，StopTrace 时写入 filePath，可用 chrome://tracing 或 Perfetto 打开
+ */
+bool Desktop::StartTrace(const QString &filePath)
+{
+    return DFMTrace::start(filePath);
+}
+
+bool Desktop::StopTrace()
+{
+    return DFMTrace::stop();
+}
+
+/*!
+ * \brief Desktop::GetMetrics 获取性能计数器的当前值，包括缓存命中次数、队列长度、文件监视器数量等
+ */
+QVariantMap Desktop::GetMetrics()
+{
+    return DFMMetrics::snapshot();
+}
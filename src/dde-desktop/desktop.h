@@ -7,6 +7,7 @@
 
 #include <QObject>
 #include <QScopedPointer>
+#include <QVariantMap>
 
 #include "global/singleton.h"
 
@@ -40,6 +41,9 @@ public slots:
     Q_SCRIPTABLE QList<int> GetIconSize();
     Q_SCRIPTABLE int GetIconSizeMode();
     Q_SCRIPTABLE bool SetIconSizeMode(int);
+    Q_SCRIPTABLE bool StartTrace(const QString &filePath);
+    Q_SCRIPTABLE bool StopTrace();
+    Q_SCRIPTABLE QVariantMap GetMetrics();
 protected:
     void showWallpaperSettings(QString name, int mode = 0);
 private:
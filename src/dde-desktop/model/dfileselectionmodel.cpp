@@ -4,6 +4,8 @@
 
 #include "dfileselectionmodel.h"
 
+#include <QSet>
+
 DFileSelectionModel::DFileSelectionModel(QAbstractItemModel *model)
     : QItemSelectionModel(model)
 {
@@ -35,7 +37,7 @@ int DFileSelectionModel::selectedCount() const
     if (m_currentCommand != QItemSelectionModel::SelectionFlags(Current | Rows | ClearAndSelect))
         return selectedIndexes().count();
 
-    return m_lastSelectedIndex.row() - m_firstSelectedIndex.row() + 1;
+    return m_lastSelectedIndex.isValid() ? (m_lastSelectedIndex.row() - m_firstSelectedIndex.row() + 1) : 0;
 }
 
 QModelIndexList DFileSelectionModel::selectedIndexes() const
@@ -44,16 +46,18 @@ QModelIndexList DFileSelectionModel::selectedIndexes() const
         if (m_currentCommand != QItemSelectionModel::SelectionFlags(Current | Rows | ClearAndSelect)) {
             m_selectedList = QItemSelectionModel::selectedIndexes();
         } else {
+            // 区间可能重叠，用哈希表去重，逐个查找列表在选中大量文件时是平方复杂度
+            QSet<QModelIndex> added;
+
             for (const QItemSelectionRange &range : m_selection) {
                 for (const QModelIndex &index : range.indexes()) {
-                    if (!m_selectedList.contains(index))
+                    if (!added.contains(index)) {
+                        added.insert(index);
                         m_selectedList << index;
+                    }
                 }
             }
         }
-
-        // remove repeated item
-        //m_selectedList = m_selectedList.toSet().toList();
     }
 
     return m_selectedList;
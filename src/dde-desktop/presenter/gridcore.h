@@ -5,6 +5,7 @@
 #pragma once
 
 #include <QMap>
+#include <QHash>
 #include <QVector>
 #include <QString>
 #include <QPoint>
@@ -37,6 +38,149 @@ template <> inline bool qMapLessThanKey(const QPoint &key1, const QPoint &key2)
 }
 
 
+/*!
+ * \brief GridScreen 一个屏幕的栅格，图标按栅格编号（x * coordHeight + y）密集存放，
+ * 同时记录图标所在的栅格与空闲栅格的位图，查找位置和空位时不再遍历整个屏幕的图标
+ */
+class GridScreen
+{
+public:
+    GridScreen() = default;
+    explicit GridScreen(int cellCount)
+        : m_cells(cellCount)
+        , m_freeBits((cellCount + 63) / 64, ~quint64(0))
+    {
+        // 最后一个字中超出栅格数的位不是空位
+        if (cellCount % 64) {
+            m_freeBits.last() = (quint64(1) << (cellCount % 64)) - 1;
+        }
+    }
+
+    inline int cellCount() const { return m_cells.size(); }
+    inline int itemCount() const { return m_itemIndexes.size(); }
+    inline int freeCount() const { return cellCount() - itemCount(); }
+    inline bool isFull() const { return cellCount() > 0 && freeCount() == 0; }
+    inline bool isValidIndex(GIndex index) const { return index >= 0 && index < cellCount(); }
+
+    inline bool isUsed(GIndex index) const
+    {
+        return isValidIndex(index) && !(m_freeBits.at(index >> 6) & bit(index));
+    }
+
+    inline QString item(GIndex index) const
+    {
+        return isValidIndex(index) ? m_cells.at(index) : QString();
+    }
+
+    inline bool contains(const QString &item) const { return m_itemIndexes.contains(item); }
+    inline GIndex indexOf(const QString &item) const { return m_itemIndexes.value(item, -1); }
+
+    //! 栅格无效、已被占用或图标已在此屏幕上时返回 false
+    bool insert(GIndex index, const QString &item)
+    {
+        if (item.isEmpty() || !isValidIndex(index) || isUsed(index) || contains(item)) {
+            return false;
+        }
+
+        m_cells[index] = item;
+        m_itemIndexes.insert(item, index);
+        m_freeBits[index >> 6] &= ~bit(index);
+        return true;
+    }
+
+    QString takeAt(GIndex index)
+    {
+        if (!isUsed(index)) {
+            return QString();
+        }
+
+        QString item;
+        item.swap(m_cells[index]);
+        m_itemIndexes.remove(item);
+        m_freeBits[index >> 6] |= bit(index);
+        return item;
+    }
+
+    //! 返回图标原来所在的栅格，不在此屏幕上时返回 -1
+    GIndex remove(const QString &item)
+    {
+        GIndex index = indexOf(item);
+        if (index >= 0) {
+            takeAt(index);
+        }
+        return index;
+    }
+
+    //! 从 from 开始向后查找第一个空位，没有时返回 -1
+    GIndex findFree(GIndex from = 0) const
+    {
+        if (from < 0) {
+            from = 0;
+        }
+
+        for (int word = from >> 6; word < m_freeBits.size(); ++word) {
+            quint64 bits = m_freeBits.at(word);
+            if (word == (from >> 6)) {
+                bits &= ~quint64(0) << (from & 63);
+            }
+            if (bits) {
+                return (word << 6) + __builtin_ctzll(bits);
+            }
+        }
+        return -1;
+    }
+
+    //! 从 from 开始向前查找第一个空位，没有时返回 -1
+    GIndex findFreeBackward(GIndex from) const
+    {
+        if (from >= cellCount()) {
+            from = cellCount() - 1;
+        }
+
+        for (int word = from >> 6; word >= 0; --word) {
+            quint64 bits = m_freeBits.at(word);
+            if (word == (from >> 6)) {
+                bits &= ~quint64(0) >> (63 - (from & 63));
+            }
+            if (bits) {
+                return (word << 6) + 63 - __builtin_clzll(bits);
+            }
+        }
+        return -1;
+    }
+
+    QList<GIndex> freeIndexes() const
+    {
+        QList<GIndex> ret;
+        ret.reserve(freeCount());
+        for (GIndex i = findFree(); i >= 0; i = findFree(i + 1)) {
+            ret.append(i);
+        }
+        return ret;
+    }
+
+    //! 按栅格编号排序的图标
+    QStringList items() const
+    {
+        QStringList ret;
+        ret.reserve(itemCount());
+        for (const QString &item : m_cells) {
+            if (!item.isEmpty()) {
+                ret.append(item);
+            }
+        }
+        return ret;
+    }
+
+private:
+    static inline quint64 bit(GIndex index) { return quint64(1) << (index & 63); }
+
+    QVector<QString>            m_cells;
+    QHash<QString, GIndex>      m_itemIndexes;
+    QVector<quint64>            m_freeBits;//置位表示空闲
+};
+
+
 // TODO: move all grid calc to GridCore
 class GridCore
 {
@@ -44,10 +188,7 @@ public:
 
     QStringList           overlapItems;
 
-    QMap<int, QMap<GPos, QString>> gridItems;
-    QMap<int, QMap<QString, GPos>> itemGrids;
-    QMap<int, bool>             m_screenFullStatus;//屏幕图标状态
-    QMap<int, QVector<bool>>    m_cellStatus;//<screenNum, QVector<bool>>
+    QMap<int, GridScreen>        screens;//<screenNum, GridScreen>
     QMap<int, QString>           positionProfiles;
     QMap<int, QPair<int, int>>   screensCoordInfo; //<screenNum,<coordWidth,coordHeight>>
 
@@ -56,8 +197,10 @@ public:
 
     void addItem(int screenNum, GIndex index, const QString &item)
     {
+        auto screen = screens.find(screenNum);
+
         //bug#45219，当出现错误的index时，放入堆叠
-        if (index < 0 || index >= m_cellStatus.value(screenNum).length()) {
+        if (index < 0 || screen == screens.end() || index >= screen->cellCount()) {
             qWarning() << "screen" << screenNum << "error index" << index << item;
             if (!overlapItems.contains(item)) {
                 overlapItems << item;
@@ -65,92 +208,37 @@ public:
             return;
         }
 
-        if (!m_cellStatus.contains(screenNum)) {
-            qDebug() << "can not find num :" << screenNum;
-            return;
-        }
-        auto cellStatusItor = m_cellStatus.find(screenNum);
-        cellStatusItor.value()[index] = true;
-        auto position = toPos(screenNum, index);
-
-        if (!itemGrids.contains(screenNum)
-                || !gridItems.contains(screenNum)) {
-            qDebug() << "can not find num :" << screenNum;
-            return;
-        }
-        auto tempGridItemsItor = gridItems.find(screenNum);
-        auto tempItemGridsItor = itemGrids.find(screenNum);
-        tempItemGridsItor->insert(item, position);
-        tempGridItemsItor->insert(position, item);
+        // 目标栅格上原有的图标被替换
+        screen->remove(item);
+        screen->takeAt(index);
+        screen->insert(index, item);
     }
 
     void removeItem(int screenNum, GPos pos)
     {
-        if (!gridItems.contains(screenNum) || !itemGrids.contains(screenNum)) {
-            qDebug() << "can not find num :" << screenNum;
-            return;
-        }
-        auto tempGridItemsItor = gridItems.find(screenNum);
-        auto tempItemGridsItor = itemGrids.find(screenNum);
-
-        auto index = toIndex(screenNum, pos);
-        auto item = tempGridItemsItor.value().take(pos);
-        tempItemGridsItor.value().remove(item);
-
-        if (!m_cellStatus.contains(screenNum)) {
-            qDebug() << "can not find num :" << screenNum;
-            return;
-        }
-        Q_ASSERT(index < m_cellStatus.value(screenNum).length());
-        auto cellStatusItor = m_cellStatus.find(screenNum);
-        cellStatusItor.value()[index] = false;
+        removeItem(screenNum, toIndex(screenNum, pos));
     }
 
     void removeItem(int screenNum, GIndex index)
     {
-        if (!gridItems.contains(screenNum) || !itemGrids.contains(screenNum)) {
+        auto screen = screens.find(screenNum);
+        if (screen == screens.end()) {
             qDebug() << "can not find num :" << screenNum;
             return;
         }
-        auto tempGridItemsItor = gridItems.find(screenNum);
-        auto tempItemGridsItor = itemGrids.find(screenNum);
 
-
-        auto position = toPos(screenNum, index);
-        auto item = tempGridItemsItor.value().take(position);
-        tempItemGridsItor.value().remove(item);
-
-
-        if (!m_cellStatus.contains(screenNum)) {
-            qDebug() << "can not find num :" << screenNum;
-            return;
-        }
-        Q_ASSERT(index < m_cellStatus.value(screenNum).length());
-        auto cellStatusItor = m_cellStatus.find(screenNum);
-        cellStatusItor.value()[index] = false;
+        screen->takeAt(index);
     }
 
     void removeItem(int screenNum, const QString &item)
     {
-        if (!gridItems.contains(screenNum) || !itemGrids.contains(screenNum)) {
+        auto screen = screens.find(screenNum);
+        if (screen == screens.end()) {
             qDebug() << "can not find num :" << screenNum;
             return;
         }
-        auto tempGridItemsItor = gridItems.find(screenNum);
-        auto tempItemGridsItor = itemGrids.find(screenNum);
-
-        auto position = tempItemGridsItor.value().take(item);
-        auto index = toIndex(screenNum, position);
-        tempGridItemsItor.value().take(position);
-
-        if (!m_cellStatus.contains(screenNum)) {
-            qDebug() << "can not find num :" << screenNum;
-            return;
-        }
-        Q_ASSERT(index < m_cellStatus.value(screenNum).length());
-        auto cellStatusItor = m_cellStatus.find(screenNum);
-        cellStatusItor.value()[index] = false;
 
+        screen->remove(item);
     }
 
     inline GIndex toIndex(int screenNum, const GPos &pos) const
@@ -170,31 +258,30 @@ public:
 
     inline GPos pos(int screenNum, const QString &item) const
     {
-        if (itemGrids.value(screenNum).contains(item)) {
-            return itemGrids.value(screenNum).value(item);
+        auto screen = screens.constFind(screenNum);
+        if (screen != screens.cend() && screen->contains(item)) {
+            return toPos(screenNum, screen->indexOf(item));
         } else {
             auto coordInfo = screensCoordInfo.value(screenNum);
             return GPos(coordInfo.first - 1, coordInfo.second - 1);
         }
     }
 
-    GIndex findEmptyForward(int screenNum, GIndex index, int emptyCount)
+    GIndex findEmptyForward(int screenNum, GIndex index, int emptyCount) const
     {
         if (0 == emptyCount) {
             return index;
         }
-        if (!m_cellStatus.contains(screenNum)) {
+        auto screen = screens.constFind(screenNum);
+        if (screen == screens.cend()) {
             qDebug() << "can not find num :" << screenNum;
             return index;//return right?
         }
-        auto cellStatusItor = m_cellStatus.find(screenNum);
-
-        for (auto i = index; i >= 0; --i) {
-            if (!cellStatusItor.value()[i]) {
-                --emptyCount;
-                if (0 == emptyCount) {
-                    return i;
-                }
+
+        for (auto i = screen->findFreeBackward(index); i >= 0; i = screen->findFreeBackward(i - 1)) {
+            --emptyCount;
+            if (0 == emptyCount) {
+                return i;
             }
         }
         return 0;
@@ -203,98 +290,77 @@ public:
     QStringList reloacleForward(int screenNum, GIndex start, GIndex end)
     {
         QStringList items;
-        if (!gridItems.contains(screenNum) || !itemGrids.contains(screenNum)) {
+        auto screen = screens.find(screenNum);
+        if (screen == screens.end()) {
             qDebug() << "can not find num :" << screenNum;
             return items;
         }
-        auto tempGridItemsItor = gridItems.find(screenNum);
-        auto tempItemGridsItor = itemGrids.find(screenNum);
 
         for (auto i = start; i <= end; ++i) {
-            auto position = toPos(screenNum, i);
-            if (tempGridItemsItor.value().contains(position)) {
-                items << tempGridItemsItor.value().value(position);
-                tempGridItemsItor.value().remove(position);
+            if (screen->isUsed(i)) {
+                items << screen->takeAt(i);
             }
         }
 
         for (auto i = start; i < start + items.length(); ++i) {
-            auto position = toPos(screenNum, i);
-            auto item = items.value(i - start);
-            tempGridItemsItor.value().insert(position, item);
-            tempItemGridsItor.value().insert(item, position);
+            screen->insert(i, items.value(i - start));
         }
         return items;
     }
 
-    GIndex findEmptyBackward(int screenNum, GIndex index, int emptyCount)
+    GIndex findEmptyBackward(int screenNum, GIndex index, int emptyCount) const
     {
-        if (!m_cellStatus.contains(screenNum)) {
+        auto screen = screens.constFind(screenNum);
+        if (screen == screens.cend()) {
             qDebug() << "can not find num :" << screenNum;
             return index;//return right?
         }
-        auto cellStatusItor = m_cellStatus.find(screenNum);
 
         if (0 == emptyCount) {
             return index;
         }
 
-        for (auto i = index; i < m_cellStatus.value(screenNum).length(); ++i) {
-            if (!cellStatusItor.value()[i]) {
-                --emptyCount;
-                if (0 == emptyCount) {
-                    return i;
-                }
+        for (auto i = screen->findFree(index); i >= 0; i = screen->findFree(i + 1)) {
+            --emptyCount;
+            if (0 == emptyCount) {
+                return i;
             }
         }
-        return m_cellStatus.value(screenNum).length() - 1;
+        return screen->cellCount() - 1;
     }
 
     // start < end
     QStringList reloacleBackward(int screenNum, GIndex start, GIndex end)
     {
         QStringList items;
-        if (!gridItems.contains(screenNum) || !itemGrids.contains(screenNum)) {
+        auto screen = screens.find(screenNum);
+        if (screen == screens.end()) {
             qDebug() << "can not find num :" << screenNum;
             return items;
         }
-        auto tempGridItemsItor = gridItems.find(screenNum);
-        auto tempItemGridsItor = itemGrids.find(screenNum);
 
         for (auto i = end; i >= start; --i) {
-            auto position = toPos(screenNum, i);
-            if (tempGridItemsItor.value().contains(position)) {
-                items << tempGridItemsItor.value().value(position);
-                tempGridItemsItor.value().remove(position);
+            if (screen->isUsed(i)) {
+                items << screen->takeAt(i);
             }
         }
 
         for (auto i = end; i > end - items.length(); --i) {
-            auto position = toPos(screenNum, i);
-            auto item = items.value(end - i);
-            tempGridItemsItor.value().insert(position, item);
-            tempItemGridsItor.value().insert(item, position);
+            screen->insert(i, items.value(end - i));
         }
         return items;
     }
 
     QList<GIndex> emptyPostion(int screenNum) const
     {
-        QList<GIndex> ret;
-        if (!m_cellStatus.contains(screenNum)) {
+        auto screen = screens.constFind(screenNum);
+        if (screen == screens.cend()) {
             qDebug() << "can not find num :" << screenNum;
-            return ret;
+            return QList<GIndex>();
         }
 
-        auto cellStatusItor = m_cellStatus.find(screenNum);
-        for (GIndex i = 0; i < m_cellStatus.value(screenNum).length(); ++i) {
-            if (!cellStatusItor.value()[i]) {
-                ret.append(i);
-            }
-        }
-        return ret;
+        return screen->freeIndexes();
     }
 
     QStringList reloacle(int screenNum, GIndex targetIndex, int emptyBefore, int emptyAfter);
 };
-
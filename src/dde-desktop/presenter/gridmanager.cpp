@@ -9,6 +9,7 @@
 #include <QDebug>
 #include <QStandardPaths>
 #include <QTimer>
+#include <QSet>
 
 #include <dgiosettings.h>
 #include <dfilesystemmodel.h>
@@ -72,52 +73,31 @@ public:
 
     void clear()
     {
-        m_itemGrids.clear();
-        m_gridItems.clear();
+        m_screens.clear();
         m_overlapItems.clear();
-        m_cellStatus.clear();
 
         for (int i : screenCode()) {
-
-            //add empty m_itemGrids
-            QMap<QPoint, QString> gridItem;
-            m_gridItems.insert(i, gridItem);
-
-            //add empty m_gridItems
-            QMap<QString, QPoint> itemGrid;
-            m_itemGrids.insert(i, itemGrid);
-
-            m_screenFullStatus.insert(i, false);
-        }
-
-        auto coordkeys = screensCoordInfo.keys();
-        for (auto key : coordkeys) {
-            //add empty coordInfo
-            QVector<bool> tempVector;
-            tempVector.resize(cellCount(key));
-            m_cellStatus.insert(key, tempVector);
-        }
-        auto statusValues = m_cellStatus.values();
-        for (auto &oneValue : statusValues) {
-            for (int i = 0; i < oneValue.length(); ++i) {
-                oneValue[i] = false;
-            }
+            //add empty grid cells
+            m_screens.insert(i, GridScreen(cellCount(i)));
         }
     }
 
-    QStringList rangeItems(int screenNum)
+    inline const GridScreen &screenCells(int screenNum) const
     {
-        QStringList sortItems;
-
-        auto inUsePos = m_gridItems.value(screenNum).keys();
-        qSort(inUsePos.begin(), inUsePos.end(), qQPointLessThanKey);
+        static const GridScreen emptyScreen;
+        auto screen = m_screens.constFind(screenNum);
+        return screen == m_screens.cend() ? emptyScreen : screen.value();
+    }
 
-        for (int index = 0; index < inUsePos.length(); ++index) {
-            auto gridPos = inUsePos.value(index);
-            auto item = m_gridItems.value(screenNum).value(gridPos);
-            sortItems << item;
-        }
+    inline QPoint itemPos(int screenNum, const QString &itemId) const
+    {
+        int index = screenCells(screenNum).indexOf(itemId);
+        return index < 0 ? QPoint() : gridPosAt(screenNum, index);
+    }
 
+    QStringList rangeItems(int screenNum)
+    {
+        QStringList sortItems = screenCells(screenNum).items();
         sortItems << m_overlapItems;
         return sortItems;
     }
@@ -125,22 +105,22 @@ public:
     QStringList rangeItems(const int screenNum, const QStringList itemList)
     {
         QStringList sortItems;
-        QList<QPoint> itemPosList;
+        QList<int> itemIndexList;
         QStringList unknownItemList;
+        const GridScreen &cells = screenCells(screenNum);
         foreach (auto item, itemList) {
-            if (m_itemGrids.contains(screenNum) && m_itemGrids.value(screenNum).contains(item)) {
-                itemPosList.append(m_itemGrids.value(screenNum).value(item));
+            int index = cells.indexOf(item);
+            if (index >= 0) {
+                itemIndexList.append(index);
             } else {
                 unknownItemList.append(item);
             }
         }
 
-        qSort(itemPosList.begin(), itemPosList.end(), qQPointLessThanKey);
+        std::sort(itemIndexList.begin(), itemIndexList.end());
 
-        for (int index = 0; index < itemPosList.length(); ++index) {
-            auto gridPos = itemPosList.value(index);
-            auto item = m_gridItems.value(screenNum).value(gridPos);
-            sortItems << item;
+        for (int index : itemIndexList) {
+            sortItems << cells.item(index);
         }
         sortItems << unknownItemList;
         return sortItems;
@@ -165,29 +145,21 @@ public:
         QTime t;
         t.start();
         qDebug() << "screen count" << screenOrder.size();
+        int taken = 0;
         for (int screenNum : screenOrder) {
-            qDebug() << "arrange Num" << screenNum << sortedItems.size();
-            QMap<QPoint, QString> gridItems;
-            QMap<QString, QPoint> itemGrids;
-            if (!sortedItems.empty()) {
-                auto cellStatus = m_cellStatus.value(screenNum);
-                int coordHeight = screensCoordInfo.value(screenNum).second;
+            qDebug() << "arrange Num" << screenNum << sortedItems.size() - taken;
+            GridScreen cells(screenCells(screenNum).cellCount());
+            if (taken < sortedItems.size()) {
                 int i = 0;
-                for (; i < cellStatus.size() && !sortedItems.empty(); ++i) {
-                    QString item = sortedItems.takeFirst();
-                    QPoint pos(i / coordHeight, i % coordHeight);
-                    //cellStatus[i] = true;
-                    gridItems.insert(pos, item);
-                    itemGrids.insert(item, pos);
-                    setCellStatus(screenNum, i, true);
+                for (; i < cells.cellCount() && taken < sortedItems.size(); ++i) {
+                    cells.insert(i, sortedItems.at(taken++));
                 }
-                qDebug() << "screen" << screenNum << "put item:" << i << "cell" << cellStatus.size();
+                qDebug() << "screen" << screenNum << "put item:" << i << "cell" << cells.cellCount();
             }
-            m_gridItems.insert(screenNum, gridItems);
-            m_itemGrids.insert(screenNum, itemGrids);
+            m_screens.insert(screenNum, cells);
         }
-        qDebug() << "time " << t.elapsed() << "(ms) overlapItems " << sortedItems.size();
-        m_overlapItems = sortedItems;
+        qDebug() << "time " << t.elapsed() << "(ms) overlapItems " << sortedItems.size() - taken;
+        m_overlapItems = sortedItems.mid(taken);
     }
 
     void createProfile()
@@ -221,7 +193,7 @@ public:
                 QString item = settings->value(key).toString();
                 if (existItems.contains(item)) {
                     QPoint pos{x, y};
-                    if (!screenCode().contains(screenKey) || m_screenFullStatus.value(screenKey) || !isValid(screenKey, pos)) {
+                    if (!screenCode().contains(screenKey) || screenCells(screenKey).isFull() || !isValid(screenKey, pos)) {
                         if (moreIcon.contains(screenKey)) {
                             moreIcon.find(screenKey)->append(item);
                         } else {
@@ -337,20 +309,16 @@ public:
     {
         //返回空位屏以及编号
         QPair<int, QPoint> posPair;
-        //if(-1 != emptyScreenNum){
-        for (int emptyScreenNum : screenCode()) { //todo 优化效率
-            auto cellStatus = m_cellStatus.value(emptyScreenNum);
-            for (int i = 0; i < cellStatus.size(); ++i) {
-                if (!cellStatus[i]) {
-                    //cellStatus[i] = true;
-                    posPair.first = emptyScreenNum;
-                    posPair.second = gridPosAt(emptyScreenNum, i);
-                    return posPair;
-                }
+        for (int emptyScreenNum : screenCode()) {
+            int index = screenCells(emptyScreenNum).findFree();
+            if (index >= 0) {
+                posPair.first = emptyScreenNum;
+                posPair.second = gridPosAt(emptyScreenNum, index);
+                return posPair;
             }
         }
 
-        if (!m_cellStatus.isEmpty()) {
+        if (!m_screens.isEmpty()) {
             posPair.first = screenCode().last();
             posPair.second = overlapPos(posPair.first);
         }
@@ -383,7 +351,7 @@ public:
             }
         }
 
-        if (!m_cellStatus.isEmpty()) {
+        if (!m_screens.isEmpty()) {
             emptyPosPair.first = screenCode().last();
             emptyPosPair.second = overlapPos(screenCode().last());
         }
@@ -392,80 +360,50 @@ public:
 
     bool getEmptyPos(int screenNum, bool isRightTop, QPoint &resultPos)
     {
-        if (!m_screenFullStatus.contains(screenNum) || m_screenFullStatus.value(screenNum)
-                || !m_cellStatus.contains(screenNum) || !screensCoordInfo.contains(screenNum)) {
+        if (!m_screens.contains(screenNum) || !screensCoordInfo.contains(screenNum)
+                || screenCells(screenNum).isFull()) {
             return  false;
         }
 
-        auto cellStatus = m_cellStatus.value(screenNum);
+        const GridScreen &cells = screenCells(screenNum);
 
         if (isRightTop) {
+            //从最右一列开始，每列内从上到下
             QPair<int, int> screenSize = screensCoordInfo.value(screenNum);
             for (int xIndex = screenSize.first - 1; xIndex >= 0; --xIndex) {
-                for (int yIndex = 0; yIndex < screenSize.second; ++yIndex) {
-                    int rightTopIndex = xIndex * screenSize.second + yIndex;
-                    if (rightTopIndex < cellStatus.size() && !cellStatus[rightTopIndex]) {
-                        resultPos = QPoint(xIndex, yIndex);
-                        return  true;
-                    }
+                int index = cells.findFree(xIndex * screenSize.second);
+                if (index >= 0 && index < (xIndex + 1) * screenSize.second) {
+                    resultPos = QPoint(xIndex, index - xIndex * screenSize.second);
+                    return  true;
                 }
             }
         } else {
-            for (int index = 0; index < cellStatus.size(); ++index) {
-                if (!cellStatus[index]) {
-                    resultPos = gridPosAt(screenNum, index);
-                    return true;
-                }
+            int index = cells.findFree();
+            if (index >= 0) {
+                resultPos = gridPosAt(screenNum, index);
+                return true;
             }
         }
 
         return  false;
     }
 
-    bool setCellStatus(int screenNum, int index, bool state)
-    {
-        if (!m_cellStatus.contains(screenNum))
-            return false;
-
-        if (m_cellStatus.value(screenNum).length() <= index || index < 0) {
-            return false;
-        }
-
-        auto cellStatusItor = m_cellStatus.find(screenNum);
-        cellStatusItor.value()[index] = state;
-
-        updateScreenFullStatus(screenNum);
-        return true;
-    }
-
-    void updateScreenFullStatus(int screenNum)
-    {
-        auto cellStatus = m_cellStatus.value(screenNum);
-        for (int index = 0; index < cellStatus.size(); ++index) {
-            if (!cellStatus[index]) {
-                m_screenFullStatus.find(screenNum).value() = false;
-                return;
-            }
-        }
-
-        m_screenFullStatus.find(screenNum).value() = true;
-    }
-
     bool add(int screenNum, QPoint pos, const QString &itemId)
     {
         if (itemId.isEmpty()) {
             qCritical() << "add empty item"; // QVector<QString>.value() may retruen an empty QString
             return false;
-        } else if (m_itemGrids.value(screenNum).contains(itemId)) {
+        } else if (screenCells(screenNum).contains(itemId)) {
             qCritical() << "add" << itemId  << "failed."
-                        << m_itemGrids.value(screenNum).value(itemId) << "grid exist item";
+                        << itemPos(screenNum, itemId) << "grid exist item";
             return false;
         }
 
-        if (m_gridItems.value(screenNum).contains(pos)) {
+        int index = indexOfGridPos(screenNum, pos);
+        if (isValid(screenNum, pos) && screenCells(screenNum).isUsed(index)) {
             if (pos != overlapPos(screenNum)) {
                 qCritical() << "add" << itemId  << "failed."
-                            << pos << "grid exist item in screenNun " << screenNum << "-" << m_gridItems.value(screenNum).value(pos);
+                            << pos << "grid exist item in screenNun " << screenNum << "-" << screenCells(screenNum).item(index);
                 return false;
             } else {
                 if (!m_overlapItems.contains(itemId)) {
@@ -480,15 +418,11 @@ public:
             return false;
         }
 
-        if (m_gridItems.end() != m_gridItems.find(screenNum)) {
-            m_gridItems.find(screenNum)->insert(pos, itemId);
-        }
-        if (m_itemGrids.end() != m_itemGrids.find(screenNum)) {
-            m_itemGrids.find(screenNum)->insert(itemId, pos);
-        }
+        auto screen = m_screens.find(screenNum);
+        if (screen == m_screens.end())
+            return false;
 
-        int index = indexOfGridPos(screenNum, pos);
-        return setCellStatus(screenNum, index, true);
+        return screen->insert(index, itemId);
     }
 
     QPair<QStringList, QVariantList> generateProfileConfigVariable(int screenNum)
@@ -496,10 +430,12 @@ public:
         //根据屏幕编号获取对应屏幕图标信息
         QStringList keyList;
         QVariantList valueList;
-        QMap<QPoint, QString> onceScreenGridItems = m_gridItems.value(screenNum);
-        for (auto pos : onceScreenGridItems.keys()) {
-            keyList << positionKey(pos);
-            valueList << onceScreenGridItems.value(pos);
+        const GridScreen &cells = screenCells(screenNum);
+        for (int index = 0; index < cells.cellCount(); ++index) {
+            if (cells.isUsed(index)) {
+                keyList << positionKey(gridPosAt(screenNum, index));
+                valueList << cells.item(index);
+            }
         }
 
         return QPair<QStringList, QVariantList>(keyList, valueList);
@@ -524,22 +460,12 @@ public:
     {
         //m_overlapItems 重叠items
         m_overlapItems.removeAll(id);
-        if (!m_itemGrids.value(screenNum).contains(id)) {
+        if (!screenCells(screenNum).contains(id)) {
             qDebug() << "can not remove" << pos << id;
             return false;
         }
 
-        auto tempGridItemsItor = m_gridItems.find(screenNum);
-        auto tempItemGridsItor = m_itemGrids.find(screenNum);
-        tempGridItemsItor->remove(pos);
-        tempItemGridsItor->remove(id);
-
-        auto usageIndex = indexOfGridPos(screenNum, pos);
-
-        if (!m_cellStatus.contains(screenNum))
-            return false;
-
-        setCellStatus(screenNum, usageIndex, false);
+        m_screens.find(screenNum)->remove(id);
         return true;
     }
 
@@ -579,15 +505,7 @@ public:
         QStringList items;
         auto screens = screenCode();
         for (int num : screens) {
-            auto cells = m_cellStatus.value(num);
-            auto gridItems = m_gridItems.value(num);
-            for (int i = 0; i < cells.size(); ++i) {
-                if (cells.value(i)) {
-                    QPoint pos = gridPosAt(num, i);
-                    const QString &item = gridItems.value(pos);
-                    items << item;
-                }
-            }
+            items << screenCells(num).items();
         }
         items << m_overlapItems;
         return items;
@@ -602,11 +520,7 @@ public:
 public:
     QStringList                                         m_overlapItems;
     QList<DAbstractFileInfoPointer>                     m_allItems;
-    QMap<int, QMap<QPoint, QString>>                    m_gridItems;
-    QMap<int, QMap<QString, QPoint>>                    m_itemGrids;
-    //newer
-    QMap<int, bool>                                     m_screenFullStatus;//屏幕图标状态
-    QMap<int, QVector<bool>>                            m_cellStatus;//<screenNum, QVector<bool>>
+    QMap<int, GridScreen>                               m_screens;//<screenNum, GridScreen>
     QMap<int, QString>           positionProfiles;
     QMap<int, QPair<int, int>>                           screensCoordInfo; //<screenNum,<coordWidth,coordHeight>>
     bool                                                autoArrange;
@@ -739,7 +653,7 @@ void GridManager::initGridItemsInfos()
 
         //顺序
         QStringList list;
-        //加载配置文件位置信息，此加载应当加载所有，通过add来将不同屏幕图标信息加载到m_gridItems和m_itemGrids
+        //加载配置文件位置信息，此加载应当加载所有，通过add来将不同屏幕图标信息加载到m_screens
         QHash<QString, bool> indexHash;
 
         for (const DAbstractFileInfoPointer &df : infoList) {
@@ -821,7 +735,7 @@ bool GridManager::add(int screenNum, const QString &id)
     if (!GridManager::instance()->desktopFileShow(tempUrl, true))
         return true;
     for (int screenNum : d->screenCode()) {
-        if (d->m_itemGrids.value(screenNum).contains(id)) {
+        if (d->screenCells(screenNum).contains(id)) {
             qWarning() << "item exist item" << screenNum << id;
             return false;
         }
@@ -847,27 +761,30 @@ bool GridManager::add(int screenNum, QPoint pos, const QString &id)
 }
 bool GridManager::move(int screenNum, const QStringList &selecteds, const QString &current, int x, int y)
 {
-    auto currentPos = d->m_itemGrids.value(screenNum).value(current);
+    auto currentPos = d->itemPos(screenNum, current);
     auto destPos = QPoint(x, y);
     auto offset = destPos - currentPos;
 
     QList<QPoint> originPosList;
     QList<QPoint> destPosList;
     // check dest is empty;
-    auto destPosMap = d->m_gridItems[screenNum];
-    auto destUsedGrids = d->m_cellStatus[screenNum];
+    //选中的图标所在的栅格视为空位
+    const GridScreen &destCells = d->screenCells(screenNum);
+    QSet<int> movedIndexes;
+    auto isUsed = [&destCells, &movedIndexes](int index) {
+        return destCells.isUsed(index) && !movedIndexes.contains(index);
+    };
     for (auto &id : selecteds) {
-        auto oldPos = d->m_itemGrids.value(screenNum).value(id);
+        auto oldPos = d->itemPos(screenNum, id);
         originPosList << oldPos;
-        destPosMap.remove(oldPos);
-        destUsedGrids[d->indexOfGridPos(screenNum, oldPos)] = false;
+        movedIndexes.insert(d->indexOfGridPos(screenNum, oldPos));
         auto tempDestPos = oldPos + offset;
         destPosList << tempDestPos;
     }
 
     bool conflict = false;
     for (auto pos : destPosList) {
-        if (destPosMap.contains(pos) || !d->isValid(screenNum, pos)) {
+        if (!d->isValid(screenNum, pos) || isUsed(d->indexOfGridPos(screenNum, pos))) {
             conflict = true;
             break;
         }
@@ -882,7 +799,7 @@ bool GridManager::move(int screenNum, const QStringList &selecteds, const QStrin
         QList<int> emptyIndexList;
 
         for (int  i = 0; i < d->cellCount(screenNum); ++i) {
-            if (false == destUsedGrids.value(i)) {
+            if (!isUsed(i)) {
                 emptyIndexList << i;
             }
         }
@@ -904,7 +821,7 @@ bool GridManager::move(int screenNum, const QStringList &selecteds, const QStrin
 
         startIndex = emptyIndexList.value(startIndex);
         for (int i = startIndex; i < d->cellCount(screenNum); ++i) {
-            if (false == destUsedGrids.value(i)) {
+            if (!isUsed(i)) {
                 destPosList << d->gridPosAt(screenNum, i);
             }
         }
@@ -930,29 +847,25 @@ bool GridManager::move(int screenNum, const QStringList &selecteds, const QStrin
 
 bool GridManager::move(int fromScreen, int toScreen, const QStringList &selectedIds, const QString &itemId, int x, int y)
 {
-    QPoint currentPos = d->m_itemGrids.value(fromScreen).value(itemId);
+    QPoint currentPos = d->itemPos(fromScreen, itemId);
     QPoint destPos = QPoint(x, y);
     QPoint offset = destPos - currentPos;
 
     QList<QPoint> originPosList;
     QList<QPoint> destPosList;
+    //源，非 const 的 find 可能使 m_screens 分离，需在取目标屏的引用之前调用
+    auto orgCells = d->m_screens.find(fromScreen);
     // check dest is empty;
-    QMap<QPoint, QString> &destPosMap = d->m_gridItems[toScreen];
-
-    //源
-    QMap<QPoint, QString> &orgPosMap = d->m_gridItems[fromScreen];
-    QMap<QString, QPoint> &orgItemMap = d->m_itemGrids[fromScreen];
-    QVector<bool> &orgUsedGrids = d->m_cellStatus[fromScreen];
+    const GridScreen &destCells = d->screenCells(toScreen);
 
     QStringList overflowItemList;
     QStringList sortItems = d->rangeItems(fromScreen, selectedIds);
     //移除源
     for (const QString &id : sortItems) {
-        QPoint oldPos = orgItemMap.value(id);
+        QPoint oldPos = d->itemPos(fromScreen, id);
         originPosList << oldPos;
-        orgPosMap.remove(oldPos);
-        orgItemMap.remove(id);
-        orgUsedGrids[d->indexOfGridPos(fromScreen, oldPos)] = false;
+        if (orgCells != d->m_screens.end())
+            orgCells->remove(id);
 
         auto tempDestPos = oldPos + offset;
         destPosList << tempDestPos;
@@ -960,7 +873,7 @@ bool GridManager::move(int fromScreen, int toScreen, const QStringList &selected
 
     bool conflict = false;
     for (auto pos : destPosList) {
-        if (destPosMap.contains(pos) || !d->isValid(toScreen, pos)) {
+        if (!d->isValid(toScreen, pos) || destCells.isUsed(d->indexOfGridPos(toScreen, pos))) {
             conflict = true;
             break;
         }
@@ -968,7 +881,6 @@ bool GridManager::move(int fromScreen, int toScreen, const QStringList &selected
 
     // no need to resize
     if (conflict) {
-        QVector<bool> &destUsedGrids = d->m_cellStatus[toScreen];
         auto selectedHeadCount = sortItems.indexOf(itemId);
         // find free grid before destPos
         auto destIndex = d->indexOfGridPos(toScreen, destPos);
@@ -976,7 +888,7 @@ bool GridManager::move(int fromScreen, int toScreen, const QStringList &selected
         QList<int> emptyIndexList;
 
         for (int  i = 0; i < d->cellCount(toScreen); ++i) {
-            if (false == destUsedGrids.value(i)) {
+            if (!destCells.isUsed(i)) {
                 emptyIndexList << i;
             }
         }
@@ -1004,7 +916,7 @@ bool GridManager::move(int fromScreen, int toScreen, const QStringList &selected
 
         startIndex = emptyIndexList.value(startIndex);
         for (int i = startIndex; i < d->cellCount(toScreen); ++i) {
-            if (false == destUsedGrids.value(i)) {
+            if (!destCells.isUsed(i)) {
                 destPosList << d->gridPosAt(toScreen, i);
             }
         }
@@ -1042,8 +954,8 @@ bool GridManager::move(int fromScreen, int toScreen, const QStringList &selected
 
 bool GridManager::remove(int screenNum, const QString &id)
 {
-    if (d->m_itemGrids.value(screenNum).contains(id)) {
-        auto pos = d->m_itemGrids.value(screenNum).value(id);
+    if (d->screenCells(screenNum).contains(id)) {
+        auto pos = d->itemPos(screenNum, id);
         bool ret = remove(screenNum, pos, id);
         qDebug() << screenNum << id  << pos << ret;
         return ret;
@@ -1069,8 +981,8 @@ int GridManager::addToOverlap(const QString &itemId)
     if (d->m_overlapItems.contains(itemId))
         return 1;
 
-    for (auto coor : d->m_itemGrids.values()) {
-        if (coor.contains(itemId))
+    for (const GridScreen &cells : d->m_screens) {
+        if (cells.contains(itemId))
             return -1;
     }
 
@@ -1080,7 +992,7 @@ int GridManager::addToOverlap(const QString &itemId)
 
 int GridManager::emptyPostionCount(int screenNum) const
 {
-    return d->m_cellStatus.value(screenNum).size() - d->m_gridItems.value(screenNum).size();
+    return d->screenCells(screenNum).freeCount();
 }
 
 bool GridManager::remove(int screenNum, QPoint pos, const QString &id)
@@ -1105,11 +1017,8 @@ bool GridManager::clear()
 void GridManager::restCoord()
 {
     d->screensCoordInfo.clear();
-    d->m_gridItems.clear();
-    d->m_itemGrids.clear();
-    d->m_cellStatus.clear();
+    d->m_screens.clear();
     d->m_overlapItems.clear();
-    d->m_screenFullStatus.clear();
 }
 
 void GridManager::addCoord(int screenNum, QPair<int, int> coordInfo)
@@ -1120,27 +1029,15 @@ void GridManager::addCoord(int screenNum, QPair<int, int> coordInfo)
         return;
     //初始化栅格
     d->screensCoordInfo.insert(screenNum, coordInfo);
-    if (!d->m_gridItems.contains(screenNum)) {
-        QMap<QPoint, QString> gridItem;
-        d->m_gridItems.insert(screenNum, gridItem);
-    }
-    if (!d->m_itemGrids.contains(screenNum)) {
-        QMap<QString, QPoint> itemGrid;
-        d->m_itemGrids.insert(screenNum, itemGrid);
-    }
-//    if(!d->m_cellStatus.contains(screenNum)){
-//        QVector<bool> cellStatus;
-//        cellStatus.resize(coordInfo.first * coordInfo.second);
-//        d->m_cellStatus.insert(screenNum, cellStatus);
-//    }
+    //栅格在clear时按屏幕大小创建
 }
 
 QString GridManager::firstItemId(int screenNum)
 {
-    for (int i = 0; i < d->m_cellStatus.value(screenNum).length(); ++i) {
-        if (d->m_cellStatus.value(screenNum).value(i)) {
-            auto pos = d->gridPosAt(screenNum, i);
-            return  itemId(screenNum, pos);
+    const GridScreen &cells = d->screenCells(screenNum);
+    for (int i = 0; i < cells.cellCount(); ++i) {
+        if (cells.isUsed(i)) {
+            return cells.item(i);
         }
     }
     return "";
@@ -1148,11 +1045,10 @@ QString GridManager::firstItemId(int screenNum)
 
 QString GridManager::lastItemId(int screenNum)
 {
-    auto len = d->m_cellStatus.value(screenNum).length();
-    for (int i = 0; i < len; ++i) {
-        if (d->m_cellStatus.value(screenNum).value(len - 1 - i)) {
-            auto pos = d->gridPosAt(screenNum, len - 1 - i);
-            return itemId(screenNum, pos);
+    const GridScreen &cells = d->screenCells(screenNum);
+    for (int i = cells.cellCount() - 1; i >= 0; --i) {
+        if (cells.isUsed(i)) {
+            return cells.item(i);
         }
     }
     return "";
@@ -1160,10 +1056,10 @@ QString GridManager::lastItemId(int screenNum)
 
 QString GridManager::lastItemTop(int screenNum)
 {
-    auto len = d->m_cellStatus.value(screenNum).length();
-    for (int i = 0; i < len; ++i) {
-        if (d->m_cellStatus.value(screenNum).value(len - 1 - i)) {
-            auto pos = d->gridPosAt(screenNum, len - 1 - i);
+    const GridScreen &cells = d->screenCells(screenNum);
+    for (int i = cells.cellCount() - 1; i >= 0; --i) {
+        if (cells.isUsed(i)) {
+            auto pos = d->gridPosAt(screenNum, i);
             return itemTop(screenNum, pos);
         }
     }
@@ -1172,13 +1068,7 @@ QString GridManager::lastItemTop(int screenNum)
 
 QStringList GridManager::itemIds(int screenNum)
 {
-    QStringList ids;
-    for (int i = 0; i < d->m_cellStatus.value(screenNum).length(); ++i) {
-        if (d->m_cellStatus.value(screenNum).value(i)) {
-            auto pos = d->gridPosAt(screenNum, i);
-            ids.append(itemId(screenNum, pos));
-        }
-    }
+    QStringList ids = d->screenCells(screenNum).items();
     if (screenNum == d->screenCode().last())
         ids << d->m_overlapItems;
     return ids;
@@ -1191,17 +1081,17 @@ QStringList GridManager::allItems() const
 
 bool GridManager::contains(int screebNum, const QString &id)
 {
-    return d->m_itemGrids.value(screebNum).contains(id) ||
+    return d->screenCells(screebNum).contains(id) ||
            (d->screenCode().last() == screebNum && d->m_overlapItems.contains(id));
 }
 
 QPoint GridManager::position(int screenNum, const QString &id)
 {
-    if (!d->m_itemGrids.value(screenNum).contains(id)) {
+    if (!d->screenCells(screenNum).contains(id)) {
         return d->overlapPos(screenNum);
     }
 
-    return d->m_itemGrids.value(screenNum).value(id);
+    return d->itemPos(screenNum, id);
 }
 
 bool GridManager::find(const QString &itemId, QPair<int, QPoint> &pos)
@@ -1223,12 +1113,15 @@ bool GridManager::find(const QString &itemId, QPair<int, QPoint> &pos)
 
 QString GridManager::itemId(int screenNum, int x, int y)
 {
-    return d->m_gridItems.value(screenNum).value(QPoint(x, y));
+    return itemId(screenNum, QPoint(x, y));
 }
 
 QString GridManager::itemId(int screenNum, QPoint pos)
 {
-    return d->m_gridItems.value(screenNum).value(pos);
+    if (!d->isValid(screenNum, pos))
+        return QString();
+
+    return d->screenCells(screenNum).item(d->indexOfGridPos(screenNum, pos));
 }
 
 QString GridManager::itemTop(int screenNum, int x, int y)
@@ -1249,12 +1142,12 @@ QString GridManager::itemTop(int screenNum, QPoint pos)
 
 bool GridManager::isEmpty(int screenNum, int x, int y)
 {
-    auto cellStatus = d->m_cellStatus.value(screenNum);
+    const GridScreen &cells = d->screenCells(screenNum);
     int pos = d->indexOfGridPos(screenNum, QPoint(x, y));
-    if (pos >= cellStatus.size() || pos < 0)
+    if (!cells.isValidIndex(pos))
         return false;
 
-    return !cellStatus.value(pos);
+    return !cells.isUsed(pos);
 }
 
 QStringList GridManager::overlapItems(int screen) const
@@ -1398,9 +1291,7 @@ GridCore *GridManager::core()
 {
     auto core = new GridCore;
     core->overlapItems = d->m_overlapItems;
-    core->gridItems = d->m_gridItems;
-    core->itemGrids = d->m_itemGrids;
-    core->m_cellStatus = d->m_cellStatus;
+    core->screens = d->m_screens;
     core->screensCoordInfo = d->screensCoordInfo;
     return core;
 }
@@ -1417,17 +1308,17 @@ bool GridManager::getWhetherShowHiddenFiles() noexcept
 
 bool GridManager::getCanvasFullStatus(int screenId)
 {
-    return d->m_screenFullStatus.value(screenId);
+    return d->screenCells(screenId).isFull();
 }
 
 void GridManager::dump()
 {
-    for (auto key : d->m_gridItems.keys()) {
-        qDebug() << key << d->m_gridItems.value(key);
-    }
-
-    for (auto key : d->m_itemGrids.keys()) {
-        qDebug() << key << d->m_itemGrids.value(key);
+    for (auto key : d->m_screens.keys()) {
+        const GridScreen &cells = d->m_screens.value(key);
+        for (int i = 0; i < cells.cellCount(); ++i) {
+            if (cells.isUsed(i))
+                qDebug() << key << d->gridPosAt(key, i) << cells.item(i);
+        }
     }
 }
 
@@ -7,6 +7,11 @@
 
 #include <QDebug>
 
+// 屏幕事件的合并窗口，窗口内没有新事件时才处理
+#define SCREEN_EVENT_SETTLE_INTERVAL 300
+// 持续有事件时最长的等待时间，避免插拔扩展坞时长时间不响应
+#define SCREEN_EVENT_SETTLE_MAX 1000
+
 ScreenManagerPrivate::ScreenManagerPrivate(AbstractScreenManager *p): q(p)
 {
     QObject::connect(&m_eventShot, &QTimer::timeout, q, [=]() {
@@ -21,6 +26,13 @@ ScreenManagerPrivate::~ScreenManagerPrivate()
 
 void ScreenManagerPrivate::readyShot(int wait)
 {
+    if (!m_eventShot.isActive()) {
+        m_settleTime.start();
+    } else if (m_settleTime.elapsed() >= SCREEN_EVENT_SETTLE_MAX) {
+        qDebug() << "events have been collected for" << m_settleTime.elapsed() << "ms, shotting soon";
+        return;
+    }
+
     m_eventShot.stop();
     qDebug() << "shotting later " << wait;
 
@@ -32,6 +44,26 @@ void ScreenManagerPrivate::readyShot(int wait)
     m_eventShot.start(wait);
 }
 
+ScreenLayout ScreenManagerPrivate::currentLayout() const
+{
+    ScreenLayout layout;
+    layout.valid = true;
+    layout.mode = q->lastChangedMode();
+
+    ScreenPointer primary = q->primaryScreen();
+    if (primary)
+        layout.primary = primary->name();
+
+    for (const ScreenPointer &sp : q->logicScreens()) {
+        layout.screens.append(sp.data());
+        layout.names.append(sp->name());
+        layout.geometries.append(sp->geometry());
+        layout.availableGeometries.append(sp->availableGeometry());
+    }
+
+    return layout;
+}
+
 AbstractScreenManager::AbstractScreenManager(QObject *parent)
     : QObject(parent)
     ,d(new ScreenManagerPrivate(this))
@@ -49,5 +81,50 @@ void AbstractScreenManager::appendEvent(AbstractScreenManager::Event e)
     qDebug() << "append event" << e << "current size" << (d->m_events.size() + 1);
     //收集短时间内爆发出的事件，合并处理，优化响应速度
     d->m_events.insert(e,0);
-    d->readyShot(100);
+    d->readyShot(SCREEN_EVENT_SETTLE_INTERVAL);
+}
+
+/*!
+ * \brief AbstractScreenManager::dispatchEvent 与上次处理后的屏幕布局比较，只发送实际发生变化的事件
+ *
+ * 屏幕组成和显示模式没有变化时，屏幕和模式事件降为几何区域事件，背景和画布只调整区域，不再重建；
+ * 布局完全没有变化时不发送信号。
+ */
+void AbstractScreenManager::dispatchEvent()
+{
+    const ScreenLayout layout = d->currentLayout();
+    const ScreenLayout &last = d->m_layout;
+
+    if (last.valid && layout.mode == last.mode && layout.primary == last.primary
+            && layout.screens == last.screens && layout.names == last.names) {
+        d->m_events.remove(Mode);
+        d->m_events.remove(Screen);
+        d->m_events.remove(Geometry);
+        d->m_events.remove(AvailableGeometry);
+
+        if (layout.geometries != last.geometries)
+            d->m_events.insert(Geometry, 0);
+
+        if (layout.availableGeometries != last.availableGeometries)
+            d->m_events.insert(AvailableGeometry, 0);
+
+        if (d->m_events.isEmpty())
+            qInfo() << "screen layout is not changed, ignore the events";
+    }
+
+    d->m_layout = layout;
+
+    //事件优先级。由上往下，背景和画布模块在处理上层的事件已经处理过下层事件的涉及的改变，因此直接忽略
+    if (d->m_events.contains(AbstractScreenManager::Mode)) {
+        emit sigDisplayModeChanged();
+    }
+    else if (d->m_events.contains(AbstractScreenManager::Screen)) {
+        emit sigScreenChanged();
+    }
+    else if (d->m_events.contains(AbstractScreenManager::Geometry)) {
+        emit sigScreenGeometryChanged();
+    }
+    else if (d->m_events.contains(AbstractScreenManager::AvailableGeometry)) {
+        emit sigScreenAvailableGeometryChanged();
+    }
 }
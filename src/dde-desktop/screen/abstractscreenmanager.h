@@ -30,6 +30,7 @@ public:
     virtual void reset() = 0;
 protected:
     void appendEvent(Event);    //添加屏幕事件
+    void dispatchEvent();       //按屏幕布局的实际变化发送事件信号
     virtual void processEvent() = 0;
 signals:
     void sigScreenChanged();    //屏幕接入，移除
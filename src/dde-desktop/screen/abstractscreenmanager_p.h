@@ -8,7 +8,22 @@
 #include "abstractscreenmanager.h"
 
 #include <QTimer>
+#include <QElapsedTimer>
 #include <QMultiMap>
+#include <QVector>
+
+//! 屏幕布局，用于比较两次处理事件之间屏幕的实际变化
+class ScreenLayout
+{
+public:
+    bool valid = false;
+    int mode = -1;
+    QString primary;
+    QVector<AbstractScreen *> screens;  //主屏第一，其他按接入顺序
+    QVector<QString> names;
+    QVector<QRect> geometries;
+    QVector<QRect> availableGeometries;
+};
 
 class ScreenManagerPrivate
 {
@@ -16,9 +31,12 @@ public:
     explicit ScreenManagerPrivate(AbstractScreenManager *p);
     ~ScreenManagerPrivate();
     void readyShot(int wait = 50);
+    ScreenLayout currentLayout() const;
 public:
     QTimer m_eventShot;      //延迟处理定时器
+    QElapsedTimer m_settleTime;  //本轮事件开始收集的时间
     QMultiMap<AbstractScreenManager::Event,qint64> m_events;    //事件池
+    ScreenLayout m_layout;   //上次处理事件后的屏幕布局
     AbstractScreenManager *q;    
 };
 
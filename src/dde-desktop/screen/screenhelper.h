@@ -7,11 +7,33 @@
 
 #include "abstractscreenmanager.h"
 
+#include <QMap>
+
 #define ScreenMrg ScreenHelper::screenManager()
 class ScreenHelper
 {
 public:
     static AbstractScreenManager *screenManager();
+
+    /*!
+     * \brief remapScreens 屏幕重新接入后屏幕对象会重新创建，按名称把旧屏幕对象的数据转给同名的新屏幕，
+     * 保留已经创建的窗口和数据，不再删除重建
+     */
+    template<typename T>
+    static void remapScreens(QMap<ScreenPointer, T> &map, const QVector<ScreenPointer> &screens)
+    {
+        for (const ScreenPointer &sp : map.keys()) {
+            if (screens.contains(sp))
+                continue;
+
+            for (const ScreenPointer &sc : screens) {
+                if (sc->name() == sp->name() && !map.contains(sc)) {
+                    map.insert(sc, map.take(sp));
+                    break;
+                }
+            }
+        }
+    }
 private:
     ScreenHelper();
 };
@@ -167,19 +167,7 @@ void ScreenManagerWayland::reset()
 
 void ScreenManagerWayland::processEvent()
 {
-    //事件优先级。由上往下，背景和画布模块在处理上层的事件已经处理过下层事件的涉及的改变，因此直接忽略
-    if (d->m_events.contains(AbstractScreenManager::Mode)) {
-        emit sigDisplayModeChanged();
-    }
-    else if (d->m_events.contains(AbstractScreenManager::Screen)) {
-        emit sigScreenChanged();
-    }
-    else if (d->m_events.contains(AbstractScreenManager::Geometry)) {
-        emit sigScreenGeometryChanged();
-    }
-    else if (d->m_events.contains(AbstractScreenManager::AvailableGeometry)) {
-        emit sigScreenAvailableGeometryChanged();
-    }
+    dispatchEvent();
 }
 
 void ScreenManagerWayland::onMonitorChanged()
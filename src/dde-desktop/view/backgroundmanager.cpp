@@ -8,12 +8,19 @@
 
 #include <qpa/qplatformwindow.h>
 #include <QImageReader>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QFutureWatcher>
+#include <QtConcurrent>
+
+static constexpr int PIXMAPCACHECOST{ 128 * 1024 }; // KB
 
 BackgroundManager::BackgroundManager(bool preview, QObject *parent)
     : QObject(parent)
     , windowManagerHelper(DWindowManagerHelper::instance())
     , m_preview(preview)
 {
+    m_pixmapCache.setMaxCost(PIXMAPCACHECOST);
     init();
     QDBusConnection::sessionBus().connect("org.freedesktop.DBus", "/org/freedesktop/DBus", "org.freedesktop.DBus",  "NameOwnerChanged", this, SLOT(onWmDbusStarted(QString, QString, QString)));
 }
@@ -364,6 +371,8 @@ void BackgroundManager::onBackgroundBuild()
             return;
         }
 
+        //重新接入的同名屏幕沿用原来的背景窗口
+        ScreenHelper::remapScreens(m_backgroundMap, QVector<ScreenPointer>() << primary);
         BackgroundWidgetPointer bwp = m_backgroundMap.value(primary);
         m_backgroundMap.clear();
         if (!bwp.isNull()) {
@@ -384,6 +393,7 @@ void BackgroundManager::onBackgroundBuild()
             qWarning() << "Disable show the background widget, of screen:" << primary->name() << primary->geometry();
     } else { //多屏
         auto screes = ScreenMrg->logicScreens();
+        ScreenHelper::remapScreens(m_backgroundMap, screes);
         for (auto sp : m_backgroundMap.keys()) {
             if (!screes.contains(sp)) {
                 auto rmd = m_backgroundMap.take(sp);
@@ -422,25 +432,8 @@ void BackgroundManager::onSkipBackgroundBuild()
 
 void BackgroundManager::onResetBackgroundImage()
 {
-    auto getPix = [](const QString & path, const QPixmap & defalutPixmap)->QPixmap{
-        if (path.isEmpty())
-            return defalutPixmap;
-
-        QString currentWallpaper = path.startsWith("file:") ? QUrl(path).toLocalFile() : path;
-        QPixmap backgroundPixmap(currentWallpaper);
-        // fix whiteboard shows when a jpeg file with filename xxx.png
-        // content formart not epual to extension
-        if (backgroundPixmap.isNull()) {
-            QImageReader reader(currentWallpaper);
-            reader.setDecideFormatFromContent(true);
-            backgroundPixmap = QPixmap::fromImage(reader.read());
-        }
-        return backgroundPixmap.isNull() ? defalutPixmap : backgroundPixmap;
-    };
-
-    QPixmap defaultImage;
-
     QMap<QString, QString> recorder; //记录有效的壁纸
+    m_requestedPixmaps.clear();
     for (ScreenPointer sp : m_backgroundMap.keys()) {
         QString userPath;
         if (!m_backgroundImagePath.contains(sp->name())) {
@@ -449,39 +442,98 @@ void BackgroundManager::onResetBackgroundImage()
             userPath = m_backgroundImagePath.value(sp->name());
         }
 
-        if (!userPath.isEmpty())
-            recorder.insert(sp->name(), userPath);
-
-        QPixmap backgroundPixmap = getPix(userPath, defaultImage);
-        if (backgroundPixmap.isNull()) {
-            qCritical() << "screen " << sp->name() << "backfround path" << userPath
-                        << "can not read!";
+        if (userPath.isEmpty()) {
+            qCritical() << "screen " << sp->name() << "backfround path is empty!";
             continue;
         }
+        recorder.insert(sp->name(), userPath);
 
         BackgroundWidgetPointer bw = m_backgroundMap.value(sp);
-        QSize trueSize = sp->handleGeometry().size(); //使用屏幕缩放前的分辨率
-        auto pix = backgroundPixmap.scaled(trueSize,
-                                           Qt::KeepAspectRatioByExpanding,
-                                           Qt::SmoothTransformation);
-
-        if (pix.width() > trueSize.width() || pix.height() > trueSize.height()) {
-            pix = pix.copy(QRect(static_cast<int>((pix.width() - trueSize.width()) / 2.0),
-                                 static_cast<int>((pix.height() - trueSize.height()) / 2.0),
-                                 trueSize.width(),
-                                 trueSize.height()));
-        }
+        const QString currentWallpaper = userPath.startsWith("file:") ? QUrl(userPath).toLocalFile() : userPath;
+        const QSize trueSize = sp->handleGeometry().size(); //使用屏幕缩放前的分辨率
+        const qreal ratio = bw->devicePixelRatioF();
+        const QString key = QString("%1|%2|%3x%4|%5")
+                            .arg(currentWallpaper)
+                            .arg(QFileInfo(currentWallpaper).lastModified().toMSecsSinceEpoch())
+                            .arg(trueSize.width()).arg(trueSize.height())
+                            .arg(ratio);
+        m_requestedPixmaps.insert(sp->name(), key);
 
         qDebug() << sp->name() << "background path" << userPath << "truesize" << trueSize << "devicePixelRatio"
-                 << bw->devicePixelRatioF() << pix << "widget" << bw.get();
-        pix.setDevicePixelRatio(bw->devicePixelRatioF());
-        bw->setPixmap(pix);
+                 << ratio << "widget" << bw.get();
+
+        if (QPixmap *pix = m_pixmapCache.object(key)) {
+            bw->setPixmap(*pix);
+        } else {
+            loadBackgroundPixmap(key, currentWallpaper, trueSize, ratio);
+        }
     }
 
     //更新壁纸
     m_backgroundImagePath = recorder;
 }
 
+void BackgroundManager::loadBackgroundPixmap(const QString &key, const QString &path, const QSize &size, qreal ratio)
+{
+    // 相同几何的屏幕只加载一次
+    if (m_loadingPixmaps.contains(key))
+        return;
+
+    m_loadingPixmaps.insert(key);
+    auto watcher = new QFutureWatcher<QImage>(this);
+    connect(watcher, &QFutureWatcher<QImage>::finished, this, [this, watcher, key, path, ratio]() {
+        watcher->deleteLater();
+        m_loadingPixmaps.remove(key);
+
+        QPixmap pix = QPixmap::fromImage(watcher->result());
+        if (pix.isNull()) {
+            qCritical() << "backfround path" << path << "can not read!";
+            return;
+        }
+
+        pix.setDevicePixelRatio(ratio);
+        m_pixmapCache.insert(key, new QPixmap(pix), qMax(1, pix.width() * pix.height() * pix.depth() / 8 / 1024));
+        applyBackgroundPixmap(key, pix);
+    });
+    watcher->setFuture(QtConcurrent::run(&BackgroundManager::scaledBackgroundImage, path, size));
+}
+
+void BackgroundManager::applyBackgroundPixmap(const QString &key, const QPixmap &pixmap)
+{
+    for (ScreenPointer sp : m_backgroundMap.keys()) {
+        // 加载期间壁纸或屏幕已变化的不再使用
+        if (m_requestedPixmaps.value(sp->name()) != key)
+            continue;
+
+        m_backgroundMap.value(sp)->setPixmap(pixmap);
+    }
+}
+
+QImage BackgroundManager::scaledBackgroundImage(const QString &path, const QSize &size)
+{
+    QImage image(path);
+    // fix whiteboard shows when a jpeg file with filename xxx.png
+    // content formart not epual to extension
+    if (image.isNull()) {
+        QImageReader reader(path);
+        reader.setDecideFormatFromContent(true);
+        image = reader.read();
+    }
+
+    if (image.isNull())
+        return image;
+
+    image = image.scaled(size, Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
+    if (image.width() > size.width() || image.height() > size.height()) {
+        image = image.copy(QRect(static_cast<int>((image.width() - size.width()) / 2.0),
+                                 static_cast<int>((image.height() - size.height()) / 2.0),
+                                 size.width(),
+                                 size.height()));
+    }
+
+    return image;
+}
+
 void BackgroundManager::onWmDbusStarted(QString name, QString oldOwner, QString newOwner)
 {
     Q_UNUSED(oldOwner)
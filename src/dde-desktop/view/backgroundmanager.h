@@ -14,6 +14,9 @@
 
 #include <QObject>
 #include <QMap>
+#include <QSet>
+#include <QCache>
+#include <QPixmap>
 
 using WMInter = com::deepin::wm;
 
@@ -49,6 +52,9 @@ private:
     QString getBackgroundFromWmConfig(const QString &screen);
     QString getDefaultBackground() const;
     BackgroundWidgetPointer createBackgroundWidget(ScreenPointer);
+    void loadBackgroundPixmap(const QString &key, const QString &path, const QSize &size, qreal ratio);
+    void applyBackgroundPixmap(const QString &key, const QPixmap &pixmap);
+    static QImage scaledBackgroundImage(const QString &path, const QSize &size);
 protected:
     DGioSettings *gsettings = nullptr;
     WMInter *wmInter = nullptr;
@@ -64,6 +70,13 @@ private:
 
     //记录设置的背景的壁纸
     QMap<QString, QString> m_backgroundImagePath;
+
+    //! 缩放后的壁纸，按路径、修改时间、目标大小和设备像素比记录，几何相同的屏幕共用一个
+    QCache<QString, QPixmap> m_pixmapCache;
+    //! 每个屏幕当前要显示的壁纸
+    QMap<QString, QString> m_requestedPixmaps;
+    //! 正在线程中解码缩放的壁纸
+    QSet<QString> m_loadingPixmaps;
 };
 
 #endif // BACKGROUNDMANAGER_H
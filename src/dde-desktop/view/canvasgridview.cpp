@@ -23,6 +23,11 @@
 #include <QDir>
 #include <QStandardPaths>
 #include <QPropertyAnimation>
+#include <QSet>
+#include <QMap>
+
+#include <algorithm>
+
 #include <danchors.h>
 #include <DUtil>
 
@@ -36,6 +41,7 @@
 #include <dfilemenu.h>
 #include <dfilemenumanager.h>
 #include <dfilewatcher.h>
+#include <dfanotifywatcher.h>
 #include <dfmapplication.h>
 #include <dfmsettings.h>
 #include <dgiosettings.h>
@@ -64,6 +70,7 @@
 #include "controllers/mergeddesktopcontroller.h"
 #include "../dde-wallpaper-chooser/screensavercontrol.h"
 #include "shutil/fileutils.h"
+#include "shutil/dfmdragurls.h"
 
 #include "accessibility/ac-desktop-define.h"
 #include "app/filesignalmanager.h"
@@ -113,7 +120,12 @@ namespace  {
     // end
 }
 
-CanvasGridView::CanvasGridView(const QString &screen, QWidget *parent)
+/*!
+ * \brief CanvasGridView::CanvasGridView
+ * \param sharedModel 其他画布的 model，多屏时所有画布共用同一个桌面 model，
+ * 各画布只显示 GridManager 分配到本屏的项目；为空时创建自己的 model
+ */
+CanvasGridView::CanvasGridView(const QString &screen, QWidget *parent, DFileSystemModel *sharedModel)
     : QAbstractItemView(parent)
     , d(new CanvasViewPrivate(this))
     , m_screenName(screen)
@@ -121,8 +133,12 @@ CanvasGridView::CanvasGridView(const QString &screen, QWidget *parent)
 {
     AC_SET_OBJECT_NAME(this, AC_CANVAS_GRID_VIEW);
     AC_SET_ACCESSIBLE_NAME(this, AC_CANVAS_GRID_VIEW);
-    initUI();
+    initUI(sharedModel);
     initConnection();
+
+    // 首次启动时加载上次的桌面快照，在桌面文件加载完成前先绘制
+    if (!GridManager::instance()->doneInit())
+        d->snapshot = DesktopSnapshot::load(m_screenName);
 }
 
 CanvasGridView::~CanvasGridView()
@@ -135,9 +151,7 @@ QRect CanvasGridView::visualRect(const QModelIndex &index) const
     auto url = model()->getUrlByIndex(index);
     auto gridPos = GridManager::instance()->position(m_screenNum, url.toString());
 
-    auto x = gridPos.x() * d->cellWidth + d->viewMargins.left();
-    auto y = gridPos.y() * d->cellHeight + d->viewMargins.top();
-    return QRect(x, y, d->cellWidth, d->cellHeight);
+    return cellRect(gridPos);
 }
 
 QModelIndex CanvasGridView::indexAt(const QPoint &point) const
@@ -147,9 +161,10 @@ QModelIndex CanvasGridView::indexAt(const QPoint &point) const
     QString localFile = GridManager::instance()->itemTop(m_screenNum, gridPos.x(), gridPos.y());
     //GridManager::instance()->itemId(m_screenNum, gridPos.x(), gridPos.y());
 
-    QModelIndex rowIndex = model()->index(DUrl(localFile));
+    // 格子中没有项时不需要查找索引和计算绘制区域，只检查编辑框等控件
+    QModelIndex rowIndex = localFile.isEmpty() ? QModelIndex() : model()->index(DUrl(localFile));
     QPoint pos = QPoint(point.x() + horizontalOffset(), point.y() + verticalOffset());
-    auto list = itemPaintGeomertys(rowIndex);
+    auto list = rowIndex.isValid() ? itemPaintGeomertys(rowIndex) : QList<QRect>();
 
 
     for (QModelIndex &index : itemDelegate()->hasWidgetIndexs()) {
@@ -346,6 +361,10 @@ void CanvasGridView::updateHiddenItems()
               filters | QDir::Hidden : filters & ~QDir::Hidden;
     qDebug() << "current filters" << GridManager::instance()->getWhetherShowHiddenFiles()
              << filters << m_screenName << m_screenNum;
+    // 共用 model 时其他画布已经更新过过滤规则并刷新
+    if (filters == model()->filters())
+        return;
+
     model()->setFilters(filters);
     delayModelRefresh(0);
     return;
@@ -371,31 +390,7 @@ void CanvasGridView::setGeometry(const QRect &rect)
 
 bool CanvasGridView::fetchDragEventUrlsFromSharedMemory()
 {
-    QSharedMemory sm;
-    sm.setKey(DRAG_EVENT_URLS);
-
-    if (!sm.isAttached()) {
-        if (!sm.attach()) {
-            qWarning() << "FQSharedMemory detach failed.";
-            return false;
-        }
-    }
-
-    QBuffer buffer;
-    QDataStream in(&buffer);
-
-    sm.lock();
-    //用缓冲区得到共享内存关联后得到的数据和数据大小
-
-//    buffer.setData((char*)sm.constData(), sm.size());//解决警告采用下方方式
-    buffer.setData(static_cast<char *>(const_cast<void *>(sm.constData())), sm.size());
-
-    buffer.open(QBuffer::ReadOnly);     //设置读取模式
-    in >> m_urlsForDragEvent;               //使用数据流从缓冲区获得共享内存的数据，然后输出到字符串中
-    sm.unlock();    //解锁
-    sm.detach();//与共享内存空间分离
-
-    return true;
+    return DFMDragUrls::read(DRAG_EVENT_URLS, m_urlsForDragEvent);
 }
 
 bool CanvasGridView::prohibitPaths()
@@ -419,6 +414,13 @@ void CanvasGridView::setTargetUrlToApp(const QMimeData *data, const DUrl &url)
 
 void CanvasGridView::delayModelRefresh(int ms)
 {
+    // 共用 model 的画布统一由持有 model 的画布刷新，多个画布同时请求时只刷新一次
+    CanvasGridView *owner = modelOwner();
+    if (owner && owner != this) {
+        owner->delayModelRefresh(ms);
+        return;
+    }
+
     if (m_refreshTimer != nullptr) {
         m_refreshTimer->stop();
         delete m_refreshTimer;
@@ -444,6 +446,21 @@ void CanvasGridView::delayModelRefresh(int ms)
     m_refreshTimer->start(ms);
 }
 
+/*!
+ * \brief CanvasGridView::takeModelOwnership 由本画布持有共用的 model，持有 model 的画布被移除前需要转交给其他画布
+ */
+void CanvasGridView::takeModelOwnership()
+{
+    if (model()->QObject::parent() != d->fileViewHelper)
+        model()->setParent(d->fileViewHelper);
+}
+
+CanvasGridView *CanvasGridView::modelOwner() const
+{
+    CanvasViewHelper *helper = qobject_cast<CanvasViewHelper *>(model()->parent());
+    return helper ? helper->parent() : nullptr;
+}
+
 void CanvasGridView::delayArrage(int ms)
 {
     static QTimer *arrangeTimer = nullptr;
@@ -780,11 +797,35 @@ void CanvasGridView::setSelection(const QRect &rect, QItemSelectionModel::Select
 
 QRegion CanvasGridView::visualRegionForSelection(const QItemSelection &selection) const
 {
-    QRegion region;
-    auto selectedList = selection.indexes();
-    for (auto &index : selectedList) {
-        region = region.united(QRegion(visualRect(index)));
+    // 选中的项都在网格中：按行收集所在的格子，同一行中相邻的格子合并为一个矩形，
+    // 得到的矩形互不相交且按行排序，可以直接构造区域，不必逐个合并
+    QMap<int, QVector<int>> rowColumns;
+    for (const QItemSelectionRange &range : selection) {
+        for (const QModelIndex &index : range.indexes()) {
+            const QPoint &gridPos = GridManager::instance()->position(m_screenNum, model()->getUrlByIndex(index).toString());
+            rowColumns[gridPos.y()].append(gridPos.x());
+        }
     }
+
+    QVector<QRect> rects;
+    for (auto it = rowColumns.begin(); it != rowColumns.end(); ++it) {
+        QVector<int> &columns = it.value();
+        std::sort(columns.begin(), columns.end());
+        columns.erase(std::unique(columns.begin(), columns.end()), columns.end());
+
+        for (int i = 0; i < columns.size();) {
+            int j = i;
+            while (j + 1 < columns.size() && columns.at(j + 1) == columns.at(j) + 1)
+                ++j;
+
+            const QRect &first = cellRect(QPoint(columns.at(i), it.key()));
+            rects.append(QRect(first.topLeft(), QSize((j - i + 1) * d->cellWidth, d->cellHeight)));
+            i = j + 1;
+        }
+    }
+
+    QRegion region;
+    region.setRects(rects.constData(), rects.size());
     return region;
 }
 
@@ -802,6 +843,7 @@ void CanvasGridView::mouseMoveEvent(QMouseEvent *event)
 
     auto curPos = event->pos();
     QRect selectRect;
+    const QRect oldSelectRect = d->selectRect;
 
     if (d->showSelectRect) {
         selectRect.setLeft(qMin(curPos.x(), d->lastPos.x()));
@@ -812,7 +854,8 @@ void CanvasGridView::mouseMoveEvent(QMouseEvent *event)
     }
 
     if (d->showSelectRect) {
-        update();
+        // 只重绘新旧选框覆盖的区域，选中状态变化的图标由 selectionChanged 刷新
+        viewport()->update(oldSelectRect.united(d->selectRect).adjusted(-2, -2, 2, 2));
         setState(DragSelectingState);
         auto command = QItemSelectionModel::Current | QItemSelectionModel::ClearAndSelect;
         setSelection(selectRect, command, true);
@@ -1685,10 +1728,42 @@ void CanvasGridView::paintEvent(QPaintEvent *event)
         }
     }
 
+    const QString &tileContext = itemTileContext();
+    if (d->itemTileContext != tileContext) {
+        d->itemTiles.clear();
+        d->itemTileContext = tileContext;
+    }
+
+    if (!d->snapshot.isEmpty()) {
+        if (d->snapshot.context == itemTileContext(true)) {
+            for (const DesktopSnapshot::Item &item : d->snapshot.items) {
+                const QRect cellRect(item.pos.x() * d->cellWidth + d->viewMargins.left(),
+                                     item.pos.y() * d->cellHeight + d->viewMargins.top(),
+                                     d->cellWidth, d->cellHeight);
+                if (repaintRect.intersects(cellRect))
+                    painter.drawPixmap(cellRect.topLeft(), item.tile);
+            }
+            emit snapshotDone();
+            return;
+        }
+
+        // 栅格或图标大小等已变化，快照不可用
+        qInfo() << "drop the desktop snapshot of" << m_screenName;
+        d->snapshot.clear();
+        emit snapshotDone();
+    } else if (GridManager::instance()->doneInit() && d->fileViewHelper->isPaintFile()) {
+        d->snapshotSaveTimer.start();
+    }
+
     QStringList repaintLocalFiles;
-    if (d->fileViewHelper->isPaintFile()) {
-        for (int x = 0; x < d->colCount; ++x) {
-            for (int y = 0; y < d->rowCount; ++y) {
+    if (d->fileViewHelper->isPaintFile() && d->cellWidth > 0 && d->cellHeight > 0) {
+        // 只取与重绘区域相交的栅格
+        const int firstCol = qBound(0, (repaintRect.left() - d->viewMargins.left()) / d->cellWidth, d->colCount);
+        const int lastCol = qBound(-1, (repaintRect.right() - d->viewMargins.left()) / d->cellWidth, d->colCount - 1);
+        const int firstRow = qBound(0, (repaintRect.top() - d->viewMargins.top()) / d->cellHeight, d->rowCount);
+        const int lastRow = qBound(-1, (repaintRect.bottom() - d->viewMargins.top()) / d->cellHeight, d->rowCount - 1);
+        for (int x = firstCol; x <= lastCol; ++x) {
+            for (int y = firstRow; y <= lastRow; ++y) {
                 auto localFile = GridManager::instance()->itemId(m_screenNum, x, y);
                 if (!localFile.isEmpty()) {
                     repaintLocalFiles << localFile;
@@ -1706,6 +1781,7 @@ void CanvasGridView::paintEvent(QPaintEvent *event)
         }
     }
 
+    const QModelIndexList &hasWidgetIndexs = itemDelegate()->hasWidgetIndexs();
 //    int drawCount = 0;
     for (auto &localFile : repaintLocalFiles) {
         auto url = DUrl(localFile);
@@ -1780,7 +1856,16 @@ void CanvasGridView::paintEvent(QPaintEvent *event)
             }
         }
 
-        this->itemDelegate()->paint(&painter, option, index);
+        // 选中、获得焦点、拖放目标以及有编辑框或展开的图标每次都重新绘制，其余的绘制缓存的图块
+        bool useTile = !d->_debug_show_grid
+                       && !(option.state & (QStyle::State_Selected | QStyle::State_HasFocus))
+                       && !d->fileViewHelper->isDropTarget(index)
+                       && !hasWidgetIndexs.contains(index);
+        if (useTile) {
+            painter.drawPixmap(visualRect(index).topLeft(), itemTile(option, index));
+        } else {
+            this->itemDelegate()->paint(&painter, option, index);
+        }
         DAbstractFileInfoPointer info = model()->fileInfo(index);
         if (info && info->scheme() == DFMMD_SCHEME && info->isVirtualEntry()) {
             DMD_TYPES oneType = MergedDesktopController::entryTypeByName(info->fileName());
@@ -2004,13 +2089,14 @@ QPixmap CanvasGridView::renderToPixmap(const QModelIndexList &indexes) const
             scale = windowHandle->devicePixelRatio();
     }
 
-    //将当前按住的index剔除
-    QModelIndexList indexesWithoutPressed = indexes;
-    auto needRemove = [=](const QModelIndex &index) {
-        return index.row() == d->m_currentMousePressIndex.row();
-    };
-    indexesWithoutPressed.erase(std::remove_if(indexesWithoutPressed.begin(), indexesWithoutPressed.end(), needRemove),
-                                indexesWithoutPressed.end());
+    //将当前按住的index剔除，只取需要绘制的 DRAGICON_MAX 个
+    QModelIndexList indexesWithoutPressed;
+    for (const QModelIndex &index : indexes) {
+        if (indexesWithoutPressed.length() >= DRAGICON_MAX)
+            break;
+        if (index.row() != d->m_currentMousePressIndex.row())
+            indexesWithoutPressed << index;
+    }
     //拖拽聚合图标可绘制区域大小
     QRect pixRect(0, 0, DRAGICON_SIZE + DRAGICON_OUTLINE * 2, DRAGICON_SIZE + DRAGICON_OUTLINE * 2);
     QPixmap pixmap(pixRect.size() * scale);
@@ -2163,10 +2249,36 @@ bool CanvasGridView::setCurrentUrl(const DUrl &url)
 
     const DUrl &checkUrl = currentUrl();
 
-    if (checkUrl == fileUrl) {
+    if (checkUrl == fileUrl && d->filesystemWatcher == model()->fileWatcher()) {
         return false;
     }
 
+    // 共用的 model 已被其他画布切换到该目录，只需绑定根索引和 watcher，不再重新列出目录
+    if (fileUrl == model()->rootUrl() && d->filesystemWatcher != model()->fileWatcher()) {
+        setRootIndex(model()->index(fileUrl));
+        QAbstractItemView::setCurrentIndex(QModelIndex());
+
+        if (d->filesystemWatcher)
+            disconnect(d->filesystemWatcher, nullptr, this, nullptr);
+
+        connectFileWatcher();
+
+        // 目录已加载完成时收不到 sigJobFinished，按加载完成处理本屏的项目
+        if (model()->state() == DFileSystemModel::Idle)
+            QMetaObject::invokeMethod(this, "onRefreshFinished", Qt::QueuedConnection);
+
+        return true;
+    }
+
+    // 桌面上的每个文件都有 watcher，fanotify 可用时监视整个桌面目录树，不再逐个占用 inotify 的监视
+    const QString &subtreePath = fileUrl.isLocalFile() ? fileUrl.toLocalFile() : QString();
+    if (subtreePath != d->watchedSubtree) {
+        if (!d->watchedSubtree.isEmpty())
+            DFanotifyWatcher::instance()->removeSubtree(d->watchedSubtree);
+
+        d->watchedSubtree = DFanotifyWatcher::instance()->addSubtree(subtreePath) ? subtreePath : QString();
+    }
+
     QModelIndex index = model()->setRootUrl(fileUrl);
     setRootIndex(index);
 
@@ -2193,6 +2305,12 @@ bool CanvasGridView::setCurrentUrl(const DUrl &url)
         qDebug() << "refresh" << m_screenNum << fileUrl;
     }
 
+    connectFileWatcher();
+    return true;
+}
+
+void CanvasGridView::connectFileWatcher()
+{
     d->filesystemWatcher = model()->fileWatcher();
 
 #if 0 //!由于model中已做了刷新，故无需下面代码 task#40201
@@ -2297,7 +2415,6 @@ bool CanvasGridView::setCurrentUrl(const DUrl &url)
 
         update();
     });
-    return true;
 }
 
 void CanvasGridView::initRootUrl()
@@ -2517,6 +2634,12 @@ void CanvasGridView::selectAll()
 void CanvasGridView::onRefreshFinished()
 {
     qDebug() << "fresh ending spend " << m_rt.elapsed() << m_screenNum;
+    // 桌面文件已加载，由实际的图标替换快照
+    if (!d->snapshot.isEmpty()) {
+        d->snapshot.clear();
+        emit snapshotDone();
+        update();
+    }
     model()->setEnabledSort(false);
     if (GridManager::instance()->autoMerge()) {
         delayAutoMerge();
@@ -2593,7 +2716,7 @@ void CanvasGridView::Refresh(bool silent)
     }
 }
 
-void CanvasGridView::initUI()
+void CanvasGridView::initUI(DFileSystemModel *sharedModel)
 {
 #ifdef QT_DEBUG
     EnableUIDebug(true);
@@ -2613,18 +2736,23 @@ void CanvasGridView::initUI()
     d->fileViewHelper = new CanvasViewHelper(this);
     d->fileViewHelper->setProperty("isCanvasViewHelper", true);
 
-    setModel(new DFileSystemModel(d->fileViewHelper));
-    model()->isDesktop = true;//紧急修复，由于修复bug#33209添加了一次事件循环的处理，导致桌面的自动排列在删除，恢复文件时显示异常
+    if (sharedModel) {
+        // 共用的 model 已由创建它的画布完成初始化
+        setModel(sharedModel);
+    } else {
+        setModel(new DFileSystemModel(d->fileViewHelper));
+        model()->isDesktop = true;//紧急修复，由于修复bug#33209添加了一次事件循环的处理，导致桌面的自动排列在删除，恢复文件时显示异常
 
-    //默认按类型排序
-    model()->setSortRole(DFileSystemModel::FileMimeTypeRole);
-    model()->setEnabledSort(true);
+        //默认按类型排序
+        model()->setSortRole(DFileSystemModel::FileMimeTypeRole);
+        model()->setEnabledSort(true);
 
-    //设置是否显示隐藏文件
-    auto filters = model()->filters();
-    filters = GridManager::instance()->getWhetherShowHiddenFiles() ?
-              filters | QDir::Hidden : filters & ~QDir::Hidden;
-    model()->setFilters(filters);
+        //设置是否显示隐藏文件
+        auto filters = model()->filters();
+        filters = GridManager::instance()->getWhetherShowHiddenFiles() ?
+                  filters | QDir::Hidden : filters & ~QDir::Hidden;
+        model()->setFilters(filters);
+    }
 
     setSelectionModel(new DFileSelectionModel(model(), this));
     auto delegate = new DesktopItemDelegate(d->fileViewHelper);
@@ -2678,6 +2806,8 @@ void CanvasGridView::initConnection()
         emit GridManager::instance()->sigSyncSelection(this, selectedUrls());
     });
 
+    connect(&d->snapshotSaveTimer, &QTimer::timeout, this, &CanvasGridView::saveSnapshot);
+
     connect(&d->dodgeDelayTimer, &QTimer::timeout,
     this, [ = ]() {
 //        qDebug() << "start animation";
@@ -2934,6 +3064,18 @@ void CanvasGridView::initConnection()
     connect(this->model(), &DFileSystemModel::requestSelectFiles,
             d->fileViewHelper, &CanvasViewHelper::onRequestSelectFiles);
 
+    // 图块按签名校验，这里只释放不再需要的图块
+    connect(this->model(), &QAbstractItemModel::rowsAboutToBeRemoved,
+    this, [ = ](const QModelIndex & parent, int first, int last) {
+        for (int i = first; i <= last; ++i) {
+            d->itemTiles.remove(model()->getUrlByIndex(model()->index(i, 0, parent)).toString());
+        }
+    });
+
+    connect(this->model(), &QAbstractItemModel::modelReset, this, [ = ]() {
+        d->itemTiles.clear();
+    });
+
     connect(this->model(), &QAbstractItemModel::dataChanged,
     this, [ = ](const QModelIndex & topLeft, const QModelIndex & bottomRight, const QVector<int> &roles) {
         qDebug() << "dataChanged" << roles << d->bReloadItem;
@@ -3055,6 +3197,11 @@ void CanvasGridView::updateCanvas()
     update();
 }
 
+bool CanvasGridView::hasSnapshot() const
+{
+    return !d->snapshot.isEmpty();
+}
+
 void CanvasGridView::setIconByLevel(int level)
 {
     if (itemDelegate()->iconSizeLevel() == level) {
@@ -3100,6 +3247,14 @@ inline QRect CanvasGridView::gridRectAt(const QPoint &pos) const
     return QRect(x, y, d->cellWidth, d->cellHeight).marginsRemoved(d->cellMargins);
 }
 
+// 网格坐标为 gridPos 的格子所在的区域
+inline QRect CanvasGridView::cellRect(const QPoint &gridPos) const
+{
+    auto x = gridPos.x() * d->cellWidth + d->viewMargins.left();
+    auto y = gridPos.y() * d->cellHeight + d->viewMargins.top();
+    return QRect(x, y, d->cellWidth, d->cellHeight);
+}
+
 inline QList<QRect> CanvasGridView::itemPaintGeomertys(const QModelIndex &index) const
 {
     QStyleOptionViewItem option = viewOptions();
@@ -3119,6 +3274,126 @@ inline QRect CanvasGridView::itemIconGeomerty(const QModelIndex &index) const
     return rects.value(0);
 }
 
+QString CanvasGridView::itemTileContext(bool persistent) const
+{
+    const QFont &font = viewOptions().font;
+    QString context = QString("%1x%2|%3x%4|%5|%6|%7")
+                      .arg(d->cellWidth).arg(d->cellHeight)
+                      .arg(iconSize().width()).arg(iconSize().height())
+                      .arg(devicePixelRatioF())
+                      .arg(font.key())
+                      .arg(QIcon::themeName());
+
+    // 调色板的 cacheKey 只在进程内有效，保存到快照时改为记录文字颜色和栅格的位置
+    if (persistent) {
+        const QMargins &margins = d->viewMargins;
+        context.append(QString("|%1|%2|%3x%4|%5,%6")
+                       .arg(palette().color(QPalette::Text).rgba())
+                       .arg(palette().color(QPalette::BrightText).rgba())
+                       .arg(d->colCount).arg(d->rowCount)
+                       .arg(margins.left()).arg(margins.top()));
+    } else {
+        context.append(QString("|%1").arg(palette().cacheKey()));
+    }
+    return context;
+}
+
+QString CanvasGridView::itemTileSignature(const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    // 图块记录绘制时依赖的文件数据，任一项变化都需要重新绘制
+    QString signature = QString("%1|%2|%3|%4")
+                        .arg(option.state & QStyle::State_Enabled ? 1 : 0)
+                        .arg(d->fileViewHelper->isTransparent(index) ? 1 : 0)
+                        .arg(qvariant_cast<QIcon>(index.data(Qt::DecorationRole)).cacheKey())
+                        .arg(itemDelegate()->displayFileName(index));
+
+    for (const QIcon &icon : d->fileViewHelper->additionalIcon(index)) {
+        signature.append(QString("|e%1").arg(icon.cacheKey()));
+    }
+
+    const QVariantHash &ep = index.data(DFileSystemModel::ExtraProperties).toHash();
+    for (const QColor &color : qvariant_cast<QList<QColor>>(ep.value("colored"))) {
+        signature.append(QString("|c%1").arg(color.rgba()));
+    }
+
+    return signature;
+}
+
+QPixmap CanvasGridView::itemTile(const QStyleOptionViewItem &option, const QModelIndex &index)
+{
+    const QString &localFile = model()->getUrlByIndex(index).toString();
+    const QString &signature = itemTileSignature(option, index);
+
+    auto tile = d->itemTiles.find(localFile);
+    if (tile != d->itemTiles.end() && tile->signature == signature)
+        return tile->pixmap;
+
+    // 图块覆盖整个栅格，文字阴影不会被裁掉
+    const QRect cellRect = visualRect(index);
+    const qreal ratio = devicePixelRatioF();
+    QPixmap pixmap(cellRect.size() * ratio);
+    pixmap.setDevicePixelRatio(ratio);
+    pixmap.fill(Qt::transparent);
+
+    QStyleOptionViewItem tileOption = option;
+    tileOption.rect = option.rect.translated(-cellRect.topLeft());
+
+    QPainter painter(&pixmap);
+    painter.setRenderHints(QPainter::HighQualityAntialiasing);
+    itemDelegate()->paintItemTile(&painter, tileOption, index);
+    painter.end();
+
+    d->itemTiles.insert(localFile, {signature, pixmap});
+    return pixmap;
+}
+
+void CanvasGridView::saveSnapshot()
+{
+    if (!model() || !GridManager::instance()->doneInit() || !d->fileViewHelper->isPaintFile())
+        return;
+
+    DesktopSnapshot snapshot;
+    snapshot.context = itemTileContext(true);
+    QString signature = snapshot.context;
+
+    // 快照中的图标都按未选中绘制
+    QStyleOptionViewItem viewOption = viewOptions();
+    viewOption.textElideMode = Qt::ElideMiddle;
+    viewOption.state &= ~(QStyle::State_Selected | QStyle::State_HasFocus | QStyle::State_MouseOver);
+
+    for (int x = 0; x < d->colCount; ++x) {
+        for (int y = 0; y < d->rowCount; ++y) {
+            const QString &localFile = GridManager::instance()->itemId(m_screenNum, x, y);
+            if (localFile.isEmpty())
+                continue;
+
+            const QModelIndex &index = model()->index(DUrl(localFile));
+            if (!index.isValid())
+                continue;
+
+            QStyleOptionViewItem option = viewOption;
+            option.rect = visualRect(index).marginsRemoved(d->cellMargins);
+            if (option.state & QStyle::State_Enabled) {
+                if ((model()->flags(index) & Qt::ItemIsEnabled) == 0) {
+                    option.state &= ~QStyle::State_Enabled;
+                    option.palette.setCurrentColorGroup(QPalette::Disabled);
+                } else {
+                    option.palette.setCurrentColorGroup(QPalette::Normal);
+                }
+            }
+            const QPixmap &tile = itemTile(option, index);
+            snapshot.items.append({QPoint(x, y), localFile, tile});
+            signature.append(QString("|%1,%2,%3").arg(x).arg(y).arg(tile.cacheKey()));
+        }
+    }
+
+    if (signature == d->savedSnapshotSignature)
+        return;
+
+    d->savedSnapshotSignature = signature;
+    DesktopSnapshot::save(m_screenName, snapshot);
+}
+
 
 inline QModelIndex CanvasGridView::firstIndex()
 {
@@ -3186,10 +3461,16 @@ void CanvasGridView::setSelection(const QRect &rect, QItemSelectionModel::Select
             topLeftGridPos = gridAt(d->selectRect.topLeft());
             bottomRightGridPos = gridAt(d->selectRect.bottomRight());
 
+            // 只遍历框选区域覆盖的格子，由格子直接得到其中的项
             QItemSelection rectSelection;
+            QSet<QModelIndex> rectIndexes;
             QMargins margins(10, 10, 10, 10);
             for (auto x = topLeftGridPos.x(); x <= bottomRightGridPos.x(); ++x) {
                 for (auto y = topLeftGridPos.y(); y <= bottomRightGridPos.y(); ++y) {
+                    //需求，桌面图标向内收缩10个像素为框选触发范围
+                    if (!cellRect(QPoint(x, y)).marginsRemoved(margins).intersects(selectRect))
+                        continue;
+
                     auto localFile = GridManager::instance()->itemTop(m_screenNum, x, y);
                     //GridManager::instance()->itemId(m_screenNum, x, y);
                     if (localFile.isEmpty()) {
@@ -3197,39 +3478,44 @@ void CanvasGridView::setSelection(const QRect &rect, QItemSelectionModel::Select
                     }
                     auto index = model()->index(DUrl(localFile));
 
-                    //需求，桌面图标向内收缩10个像素为框选触发范围
-                    auto tempVr = visualRect(index);
-                    tempVr = tempVr.marginsRemoved(margins);
-                    if (tempVr.intersects(selectRect)) {
-                        QItemSelectionRange selectionRange(index);
-                        if (!rectSelection.contains(index)) {
-                            rectSelection.push_back(selectionRange);
-                        }
+                    if (!rectIndexes.contains(index)) {
+                        rectIndexes.insert(index);
+                        rectSelection.push_back(QItemSelectionRange(index));
                     }
                 }
             }
             if (command != QItemSelectionModel::Deselect) {
+                QSet<QModelIndex> oldIndexes;
+                for (const QItemSelectionRange &range : oldSelection) {
+                    for (const QModelIndex &index : range.indexes())
+                        oldIndexes.insert(index);
+                }
+
                 QItemSelection lastAllSelection;
                 if (DFMGlobal::keyShiftIsPressed()) {
                     //shitf键增量
                     for (auto &sel : rectSelection) {
-                        for (auto &index : sel.indexes())
-                            if (!oldSelection.contains(index)) {
-                                oldSelection.push_back(sel);
-                            }
+                        if (!oldIndexes.contains(sel.topLeft())) {
+                            oldSelection.push_back(sel);
+                        }
                     }
                     lastAllSelection.merge(oldSelection, QItemSelectionModel::Select);
                 } else {
                     // Remove dump select
-                    auto tempNewSelection = rectSelection;
-                    auto tempOldSelection = oldSelection;
+                    //bug87509，产品要求按住ctrl鼠标框选效果与文管保持一直
+                    QItemSelection tempNewSelection;
+                    QSet<QModelIndex> toggledIndexes;
                     for (auto &sel : rectSelection) {
-                        for (auto &index : sel.indexes())
-                            if (oldSelection.contains(index)) {
-                                //bug87509，产品要求按住ctrl鼠标框选效果与文管保持一直
-                                tempNewSelection.removeOne(sel);
-                                tempOldSelection.removeOne(sel);
-                            }
+                        if (oldIndexes.contains(sel.topLeft()))
+                            toggledIndexes.insert(sel.topLeft());
+                        else
+                            tempNewSelection.push_back(sel);
+                    }
+
+                    QItemSelection tempOldSelection;
+                    for (auto &sel : oldSelection) {
+                        if (!(sel.topLeft() == sel.bottomRight() && toggledIndexes.remove(sel.topLeft())))
+                            tempOldSelection.push_back(sel);
                     }
                     // merge
                     lastAllSelection.merge(tempNewSelection, QItemSelectionModel::Select);
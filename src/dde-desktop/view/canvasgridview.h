@@ -28,7 +28,7 @@ class CanvasGridView: public QAbstractItemView
 public:
     static QMap<DMD_TYPES, bool> virtualEntryExpandState;
 
-    explicit CanvasGridView(const QString &screen, QWidget *parent = Q_NULLPTR);
+    explicit CanvasGridView(const QString &screen, QWidget *parent = Q_NULLPTR, DFileSystemModel *sharedModel = Q_NULLPTR);
     ~CanvasGridView() override;
 
 
@@ -128,12 +128,14 @@ public:
     void updateEntryExpandedState(const DUrl &url);
     void setGeometry(const QRect &rect);
     void delayModelRefresh(int ms = 50);
+    void takeModelOwnership();
     DUrl currentCursorFile() const;
     inline int screenNum() const {return m_screenNum;}
     void syncIconLevel(int level);
     void updateHiddenItems();
     void updateExpandItemGeometry();
     void updateCanvas();
+    bool hasSnapshot() const;
 signals:
     void sortRoleChanged(int role, Qt::SortOrder order);
     void autoAlignToggled();
@@ -144,6 +146,8 @@ signals:
 signals:
     void itemDeleted(const DUrl &url);
     void itemCreated(const DUrl &url);
+    //! 快照已绘制或因与画布不一致被丢弃
+    void snapshotDone();
 
 public slots:
     bool edit(const QModelIndex &index, EditTrigger trigger, QEvent *event) override;
@@ -168,8 +172,10 @@ private:
 
     friend class DEventFilter;
 
-    void initUI();
+    void initUI(DFileSystemModel *sharedModel);
     void initConnection();
+    void connectFileWatcher();
+    CanvasGridView *modelOwner() const;
 
     void setIconByLevel(int level);
     void increaseIcon();
@@ -177,8 +183,13 @@ private:
 
     inline QPoint gridAt(const QPoint &pos) const;
     inline QRect gridRectAt(const QPoint &pos) const;
+    inline QRect cellRect(const QPoint &gridPos) const;
     inline QList<QRect> itemPaintGeomertys(const QModelIndex &index) const;
     inline QRect itemIconGeomerty(const QModelIndex &index) const;
+    QString itemTileContext(bool persistent = false) const;
+    QString itemTileSignature(const QStyleOptionViewItem &option, const QModelIndex &index) const;
+    QPixmap itemTile(const QStyleOptionViewItem &option, const QModelIndex &index);
+    void saveSnapshot();
 
     inline QModelIndex firstIndex();
     inline QModelIndex lastIndex();
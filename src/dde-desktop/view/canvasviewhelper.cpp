@@ -35,6 +35,26 @@ quint64 CanvasViewHelper::windowId() const
     return parent()->winId();
 }
 
+/*!
+ * \brief CanvasViewHelper::isModelWindow 多个画布共用同一个 model，任一画布所在窗口的新建、重命名等事件都由该 model 处理
+ */
+bool CanvasViewHelper::isModelWindow(quint64 windowId) const
+{
+    if (DFileViewHelper::isModelWindow(windowId))
+        return true;
+
+    QWidget *window = QWidget::find(static_cast<WId>(windowId));
+    if (!window)
+        return false;
+
+    // 有背景时画布是背景窗口的子控件，没有背景时画布本身就是窗口
+    CanvasGridView *view = qobject_cast<CanvasGridView *>(window);
+    if (!view)
+        view = window->findChild<CanvasGridView *>();
+
+    return view && view->model() == parent()->model();
+}
+
 const DAbstractFileInfoPointer CanvasViewHelper::fileInfo(const QModelIndex &index) const
 {
     return parent()->model()->fileInfo(index);
@@ -18,6 +18,7 @@ public:
     CanvasGridView *parent() const;
 
     virtual quint64 windowId() const override;
+    virtual bool isModelWindow(quint64 windowId) const override;
     virtual const DAbstractFileInfoPointer fileInfo(const QModelIndex &index) const override;
     virtual DFMStyledItemDelegate *itemDelegate() const override;
     virtual DFileSystemModel *model() const override;
@@ -11,8 +11,10 @@
 #include "util/dde/desktopinfo.h"
 
 #include <QPair>
+#include <QTimer>
 
 static const char * const PROPERTY_VIEW_INITED = "view_inited";
+static constexpr int SNAPSHOT_WAIT_TIMEOUT{ 200 };
 inline QRect relativeRect(const QRect &avRect,const QRect &geometry)
 {
     QPoint relativePos = avRect.topLeft() - geometry.topLeft();
@@ -64,13 +66,12 @@ void CanvasViewManager::onCanvasViewBuild(int imode)
             return;
         }
 
+        //重新接入的同名屏幕沿用原来的画布
+        ScreenHelper::remapScreens(m_canvasMap, QVector<ScreenPointer>() << primary);
         CanvasViewPointer mView = m_canvasMap.value(primary);
 
-        //删除其他
-        m_canvasMap.clear();
-
         if (mView.get() == nullptr){
-            mView = CanvasViewPointer(new CanvasGridView(primary->name()));
+            mView = CanvasViewPointer(new CanvasGridView(primary->name(), nullptr, sharedModel()));
             mView->setScreenNum(1);
             //设置未初始化
             mView->setProperty(PROPERTY_VIEW_INITED,false);
@@ -89,6 +90,10 @@ void CanvasViewManager::onCanvasViewBuild(int imode)
             GridManager::instance()->addCoord(1, {0,0});
         }
 
+        //删除其他，删除前由保留的画布持有共用的model
+        mView->takeModelOwnership();
+        m_canvasMap.clear();
+
         GridManager::instance()->setDisplayMode(true);
         m_canvasMap.insert(primary, mView);
 
@@ -98,6 +103,7 @@ void CanvasViewManager::onCanvasViewBuild(int imode)
     }
     else {
         auto currentScreens = ScreenMrg->logicScreens();
+        ScreenHelper::remapScreens(m_canvasMap, currentScreens);
         int screenNum = 0;
         //检查新增的屏幕
         for (const ScreenPointer &sp : currentScreens){
@@ -106,7 +112,7 @@ void CanvasViewManager::onCanvasViewBuild(int imode)
 
             //新增
             if (mView.get() == nullptr){
-                mView = CanvasViewPointer(new CanvasGridView(sp->name()));
+                mView = CanvasViewPointer(new CanvasGridView(sp->name(), nullptr, sharedModel()));
                 mView->setScreenNum(screenNum);
                 //设置未初始化
                 mView->setProperty(PROPERTY_VIEW_INITED,false);
@@ -126,7 +132,10 @@ void CanvasViewManager::onCanvasViewBuild(int imode)
                      << "devicePixelRatio" << ScreenMrg->devicePixelRatio();
         }
 
-        //检查移除的屏幕
+        //检查移除的屏幕，移除前由保留的画布持有共用的model
+        if (!currentScreens.isEmpty() && m_canvasMap.contains(currentScreens.first()))
+            m_canvasMap.value(currentScreens.first())->takeModelOwnership();
+
         for (const ScreenPointer &sp : m_canvasMap.keys()){
             if (!currentScreens.contains(sp)){
                 auto rmd = m_canvasMap.take(sp);
@@ -139,6 +148,14 @@ void CanvasViewManager::onCanvasViewBuild(int imode)
     onBackgroundEnableChanged();
 }
 
+/*!
+ * \brief CanvasViewManager::sharedModel 所有画布显示同一个桌面目录，新建的画布共用已有画布的model
+ */
+DFileSystemModel *CanvasViewManager::sharedModel() const
+{
+    return m_canvasMap.isEmpty() ? nullptr : m_canvasMap.first()->model();
+}
+
 void CanvasViewManager::onBackgroundEnableChanged()
 {
     if (m_background->isEnabled()) {
@@ -224,6 +241,41 @@ void CanvasViewManager::onBackgroundEnableChanged()
                      << "canvas's screen"<< sp->name() << sp->geometry() << "availableGeometry" << avRect;
         }
     }
+
+    // 有上次的桌面快照时先绘制快照，再同步列出桌面文件，避免启动时桌面长时间空白
+    m_snapshotViews.clear();
+    for (CanvasViewPointer view : m_canvasMap.values()) {
+        if (view->hasSnapshot()) {
+            m_snapshotViews.insert(view.data());
+            connect(view.data(), &CanvasGridView::snapshotDone,
+                    this, &CanvasViewManager::onSnapshotDone, Qt::UniqueConnection);
+        }
+    }
+
+    m_gridInitPending = true;
+    if (m_snapshotViews.isEmpty()) {
+        initGridItems();
+    } else {
+        // 画布未能绘制时不再等待
+        QTimer::singleShot(SNAPSHOT_WAIT_TIMEOUT, this, &CanvasViewManager::initGridItems);
+    }
+}
+
+void CanvasViewManager::onSnapshotDone()
+{
+    m_snapshotViews.remove(qobject_cast<CanvasGridView *>(sender()));
+    // 等快照显示到屏幕上后再列出桌面文件
+    if (m_snapshotViews.isEmpty() && m_gridInitPending)
+        QTimer::singleShot(0, this, &CanvasViewManager::initGridItems);
+}
+
+void CanvasViewManager::initGridItems()
+{
+    if (!m_gridInitPending)
+        return;
+
+    m_gridInitPending = false;
+    m_snapshotViews.clear();
     GridManager::instance()->initGridItemsInfos();
 }
 
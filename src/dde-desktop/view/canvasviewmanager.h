@@ -8,6 +8,7 @@
 #include "backgroundmanager.h"
 #include "canvasgridview.h"
 #include <QObject>
+#include <QSet>
 
 typedef QSharedPointer<CanvasGridView> CanvasViewPointer;
 
@@ -26,12 +27,18 @@ private slots:
     void onScreenGeometryChanged();
     void onSyncOperation(int so, QVariant var);
     void onSyncSelection(CanvasGridView *v, DUrlList selected);
+    void onSnapshotDone();
 private:
     void init();
     void arrageEditDeal(const QString &);
+    void initGridItems();
+    DFileSystemModel *sharedModel() const;
 private:
     BackgroundManager *m_background = nullptr;
     QMap<ScreenPointer, CanvasViewPointer> m_canvasMap;
+    //! 等待绘制快照的画布，全部绘制后再列出桌面文件
+    QSet<CanvasGridView *> m_snapshotViews;
+    bool m_gridInitPending = false;
 };
 
 #endif // CANVASVIEWMANAGER_H
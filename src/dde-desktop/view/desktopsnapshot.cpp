@@ -0,0 +1,104 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "desktopsnapshot.h"
+
+#include <QApplication>
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QtConcurrent>
+
+static constexpr quint32 SNAPSHOTMAGIC{ 0x44534e50 }; // "DSNP"
+static constexpr quint32 SNAPSHOTVERSION{ 1 };
+
+QString DesktopSnapshot::filePath(const QString &screenName)
+{
+    QString name = screenName;
+    name.replace('/', '_');
+
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation)
+           + "/" + QApplication::organizationName()
+           + "/" + QApplication::applicationName()
+           + "/snapshot/" + name;
+}
+
+DesktopSnapshot DesktopSnapshot::load(const QString &screenName)
+{
+    DesktopSnapshot snapshot;
+    QFile file(filePath(screenName));
+    if (!file.open(QIODevice::ReadOnly))
+        return snapshot;
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_6);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    qint32 count = 0;
+    in >> magic >> version;
+    if (magic != SNAPSHOTMAGIC || version != SNAPSHOTVERSION)
+        return snapshot;
+
+    in >> snapshot.context >> count;
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        Item item;
+        QImage tile;
+        qreal ratio = 1;
+        in >> item.pos >> item.file >> ratio >> tile;
+        // QImage 的流不保存设备像素比
+        tile.setDevicePixelRatio(ratio);
+        item.tile = QPixmap::fromImage(tile);
+        snapshot.items.append(item);
+    }
+
+    if (in.status() != QDataStream::Ok) {
+        qWarning() << "invalid desktop snapshot" << file.fileName();
+        snapshot.clear();
+    }
+
+    return snapshot;
+}
+
+void DesktopSnapshot::save(const QString &screenName, const DesktopSnapshot &snapshot)
+{
+    // QPixmap 只能在主线程使用，转换为 QImage 后在线程中编码
+    struct ImageItem
+    {
+        QPoint pos;
+        QString file;
+        QImage tile;
+    };
+    QList<ImageItem> images;
+    for (const Item &item : snapshot.items) {
+        images.append({item.pos, item.file, item.tile.toImage()});
+    }
+
+    const QString path = filePath(screenName);
+    const QString context = snapshot.context;
+    QtConcurrent::run([path, context, images]() {
+        QDir().mkpath(QFileInfo(path).absolutePath());
+
+        QSaveFile file(path);
+        if (!file.open(QIODevice::WriteOnly)) {
+            qWarning() << "can not write desktop snapshot" << path << file.errorString();
+            return;
+        }
+
+        QDataStream out(&file);
+        out.setVersion(QDataStream::Qt_5_6);
+        out << SNAPSHOTMAGIC << SNAPSHOTVERSION << context << qint32(images.size());
+        for (const ImageItem &item : images) {
+            out << item.pos << item.file << item.tile.devicePixelRatio() << item.tile;
+        }
+
+        if (!file.commit())
+            qWarning() << "save desktop snapshot failed" << path << file.errorString();
+    });
+}
@@ -0,0 +1,42 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DESKTOPSNAPSHOT_H
+#define DESKTOPSNAPSHOT_H
+
+#include <QList>
+#include <QPixmap>
+#include <QPoint>
+#include <QString>
+
+/*!
+ * \brief DesktopSnapshot 一个屏幕上次显示的桌面图标
+ *
+ * 记录每个图标所在的栅格和绘制好的图块，启动时在列出桌面文件之前先绘制快照，
+ * 文件加载完成后由实际的图标替换。context 为绘制图块时的栅格、图标大小等状态，
+ * 与当前不一致时快照不可用。
+ */
+class DesktopSnapshot
+{
+public:
+    struct Item
+    {
+        QPoint pos;
+        QString file;
+        QPixmap tile;
+    };
+
+    QString context;
+    QList<Item> items;
+
+    inline bool isEmpty() const { return items.isEmpty(); }
+    inline void clear() { context.clear(); items.clear(); }
+
+    static QString filePath(const QString &screenName);
+    static DesktopSnapshot load(const QString &screenName);
+    //! 在线程中编码并写入文件
+    static void save(const QString &screenName, const DesktopSnapshot &snapshot);
+};
+
+#endif // DESKTOPSNAPSHOT_H
@@ -17,12 +17,15 @@
 #include <QTimer>
 #include <QLabel>
 #include <QEventLoop>
+#include <QHash>
+#include <QPixmap>
 #include <dfilesystemwatcher.h>
 
 #include "../../global/coorinate.h"
 #include "../../dbus/dbusdock.h"
 #include "../canvasgridview.h"
 #include "desktopitemdelegate.h"
+#include "../desktopsnapshot.h"
 
 class QFrame;
 class CanvasViewHelper;
@@ -51,6 +54,8 @@ public:
         mousePressed = false;
         bReloadItem = false;
         dodgeDelayTimer.setInterval(200);
+        snapshotSaveTimer.setSingleShot(true);
+        snapshotSaveTimer.setInterval(3000);
 
         touchTimer.setTimerType(Qt::PreciseTimer);
         QObject::connect(&touchTimer, &QTimer::timeout, &touchTimer, &QTimer::stop);
@@ -184,11 +189,29 @@ public:
 //    QTimer              *syncTimer          = nullptr;
 //    qint64              lastRepaintTime     = 0;
     DAbstractFileWatcher  *filesystemWatcher  = nullptr;
+    //! 通过 DFanotifyWatcher 监视的桌面目录树
+    QString watchedSubtree;
     WaterMaskFrame *waterMaskFrame          = nullptr;
 
     //DBusDock            *dbusDock           = nullptr;
     QEventLoop          *menuLoop           = nullptr;
 
+    //! 未选中的图标绘制后的图块（图标和省略后的文字），按文件记录，绘制时图块的签名不同则重新绘制
+    struct ItemTile
+    {
+        QString signature;
+        QPixmap pixmap;
+    };
+    QHash<QString, ItemTile> itemTiles;
+    //! 图块依赖的整体状态（栅格、图标大小、字体、调色板等），变化时清空所有图块
+    QString itemTileContext;
+
+    //! 启动时在桌面文件加载完成前绘制的上次的快照
+    DesktopSnapshot snapshot;
+    //! 绘制后延迟保存快照，内容与上次保存的相同时不再写入
+    QTimer snapshotSaveTimer;
+    QString savedSnapshotSignature;
+
     // debug
     bool                _debug_log          = false;
     bool                _debug_show_grid    = false;
@@ -5,12 +5,12 @@
 #include "dattachedudisks2device.h"
 #include "diskcontrolitem.h"
 #include "diskcontrolwidget.h"
+#include "diskusagerefresher.h"
 #include "interfaces/dumountmanager.h"
 
 #include <ddiskmanager.h>
 #include <dblockdevice.h>
 #include <ddiskdevice.h>
-#include <QStorageInfo>
 #include <QtConcurrentRun>
 
 DFM_USE_NAMESPACE
@@ -32,6 +32,13 @@ DAttachedUdisks2Device::DAttachedUdisks2Device(const DBlockDevice *blockDevicePo
     mountPoint = mountPoints.isEmpty() ? "" : mountPoints.first();
     deviceDBusId = blockDevicePointer->path();
     c_blockDevice.reset(DDiskManager::createBlockDevice(deviceDBusId)); // not take the ownership of the passed pointer.
+
+    DiskUsageRefresher::instance()->addMountPoint(mountPoint);
+}
+
+DAttachedUdisks2Device::~DAttachedUdisks2Device()
+{
+    DiskUsageRefresher::instance()->removeMountPoint(mountPoint);
 }
 
 bool DAttachedUdisks2Device::isValid()
@@ -67,8 +74,8 @@ QString DAttachedUdisks2Device::displayName()
         {"data", "Data Disk"}
     };
 
-    QStorageInfo storage_info(mountPoint);
     QString result;
+    DiskUsageRefresher::Usage usage;
 
     if (blockDevice()->isValid()) {
         QString devName = blockDevice()->idLabel();
@@ -83,28 +90,26 @@ QString DAttachedUdisks2Device::displayName()
         }
 
         result = devName;
-    } else if (storage_info.isValid()) {
-        qint64 bytesTotal = storage_info.bytesTotal();
-        result = qApp->translate("DeepinStorage", "%1 Volume").arg(DiskControlItem::formatDiskSize(static_cast<quint64>(bytesTotal)));
+    } else if (DiskUsageRefresher::instance()->usage(mountPoint, &usage)) {
+        result = qApp->translate("DeepinStorage", "%1 Volume").arg(DiskControlItem::formatDiskSize(usage.bytesTotal));
     }
 
     return result;
 }
 
+// 容量由 DiskUsageRefresher 在后台读取，这里只取缓存的结果，不会被卡住的设备阻塞
 bool DAttachedUdisks2Device::deviceUsageValid()
 {
-    QStorageInfo storage_info(mountPoint);
-    return storage_info.isValid();
+    return DiskUsageRefresher::instance()->usage(mountPoint, nullptr);
 }
 
 QPair<quint64, quint64> DAttachedUdisks2Device::deviceUsage()
 {
-    QStorageInfo storage_info(mountPoint);
+    DiskUsageRefresher::Usage usage;
 
-    if (storage_info.isValid()) {
+    if (DiskUsageRefresher::instance()->usage(mountPoint, &usage)) {
         quint64 bytesTotal = blockDevice()->size();
-        qint64 bytesFree = storage_info.bytesAvailable();
-        return QPair<quint64, quint64>(static_cast<quint64>(bytesFree), static_cast<quint64>(bytesTotal));
+        return QPair<quint64, quint64>(usage.bytesFree, bytesTotal);
     }
 
     return QPair<quint64, quint64>(0, 0);
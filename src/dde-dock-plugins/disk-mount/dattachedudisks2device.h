@@ -21,7 +21,7 @@ class DAttachedUdisks2Device : public DAttachedDeviceInterface
 {
 public:
     explicit DAttachedUdisks2Device(const DBlockDevice *blockDevicePointer);
-    virtual ~DAttachedUdisks2Device() override {}
+    virtual ~DAttachedUdisks2Device() override;
     bool isValid() override;
     bool detachable() override;
     void detach() override;
@@ -4,6 +4,7 @@
 
 #include "diskcontrolitem.h"
 #include "dattachedudisks2device.h"
+#include "diskusagerefresher.h"
 
 #include "dfmglobal.h"
 
@@ -138,6 +139,11 @@ DiskControlItem::DiskControlItem(DAttachedDeviceInterface *attachedDevicePtr, QW
 
     connect(DGuiApplicationHelper::instance(), &DGuiApplicationHelper::themeTypeChanged, this, &DiskControlItem::refreshIcon);
     refreshIcon();
+
+    connect(DiskUsageRefresher::instance(), &DiskUsageRefresher::usageChanged, this, [this](const QString &mountPoint) {
+        if (isVisible() && mountPoint == attachedDevice->mountpointUrl().toLocalFile())
+            refreshUsage();
+    });
 }
 
 DiskControlItem::~DiskControlItem()
@@ -266,6 +272,13 @@ void DiskControlItem::showEvent(QShowEvent *e)
     QString elideText = fm.elidedText(name, Qt::ElideRight, m_diskName->width());
     m_diskName->setText(elideText);
 
+    refreshUsage();
+
+    QFrame::showEvent(e);
+}
+
+void DiskControlItem::refreshUsage()
+{
     if (attachedDevice->deviceUsageValid()) {
         QString iconName = attachedDevice->iconName();
         QPair<quint64, quint64> freeAndTotal = attachedDevice->deviceUsage();
@@ -325,8 +338,6 @@ void DiskControlItem::showEvent(QShowEvent *e)
             m_capacityValueBar->setValue(static_cast<int>(100 * (bytesTotal - bytesFree) / bytesTotal));
         }
     }
-
-    QFrame::showEvent(e);
 }
 
 DFMSettings *getGsGlobal()
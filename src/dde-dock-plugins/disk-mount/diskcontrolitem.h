@@ -48,6 +48,7 @@ private:
     void mouseReleaseEvent(QMouseEvent *e) override;
     void showEvent(QShowEvent *e) override;
     void refreshIcon();
+    void refreshUsage();
 
 private:
     QIcon m_unknowIcon;
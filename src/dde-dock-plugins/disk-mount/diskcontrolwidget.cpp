@@ -9,6 +9,7 @@
 #include "models/dfmrootfileinfo.h"
 #include "interfaces/dumountmanager.h"
 #include "diskglobal.h"
+#include "diskusagerefresher.h"
 #include "rlog/datas/blockmountreportdata.h"
 
 #include <dgiovolumemanager.h>
@@ -74,6 +75,21 @@ DiskControlWidget::~DiskControlWidget()
 {
 }
 
+// 只有弹出窗口显示时才刷新设备容量
+void DiskControlWidget::showEvent(QShowEvent *event)
+{
+    DiskUsageRefresher::instance()->setActive(true);
+
+    QScrollArea::showEvent(event);
+}
+
+void DiskControlWidget::hideEvent(QHideEvent *event)
+{
+    DiskUsageRefresher::instance()->setActive(false);
+
+    QScrollArea::hideEvent(event);
+}
+
 void DiskControlWidget::initConnect()
 {
     connect(m_diskManager, &DDiskManager::diskDeviceAdded, this, &DiskControlWidget::onDriveConnected);
@@ -42,6 +42,10 @@ public:
 signals:
     void diskCountChanged(const int count) const;
 
+protected:
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+
 private:
     void popQueryScanningDialog(QObject *object, std::function<void()> onStop);
 
@@ -0,0 +1,139 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "diskusagerefresher.h"
+
+#include <QStorageInfo>
+#include <QtConcurrent>
+
+// 弹出窗口显示时刷新容量的间隔(毫秒)
+#define USAGE_REFRESH_INTERVAL 3000
+// 查询超过这个时间(毫秒)没有返回时不再显示旧的容量
+#define USAGE_QUERY_TIMEOUT 5000
+// 卡住的挂载点各占用一个线程，其余挂载点仍可查询
+#define USAGE_QUERY_THREADS 4
+
+DiskUsageRefresher *DiskUsageRefresher::instance()
+{
+    static DiskUsageRefresher *refresher = new DiskUsageRefresher();
+
+    return refresher;
+}
+
+DiskUsageRefresher::DiskUsageRefresher(QObject *parent)
+    : QObject(parent)
+{
+    m_pool.setMaxThreadCount(USAGE_QUERY_THREADS);
+
+    m_refreshTimer.setInterval(USAGE_REFRESH_INTERVAL);
+    connect(&m_refreshTimer, &QTimer::timeout, this, &DiskUsageRefresher::refresh);
+}
+
+void DiskUsageRefresher::addMountPoint(const QString &mountPoint)
+{
+    if (mountPoint.isEmpty())
+        return;
+
+    ++m_mountPoints[mountPoint];
+
+    if (m_refreshTimer.isActive())
+        refresh();
+}
+
+void DiskUsageRefresher::removeMountPoint(const QString &mountPoint)
+{
+    auto it = m_mountPoints.find(mountPoint);
+
+    if (it == m_mountPoints.end() || --it.value() > 0)
+        return;
+
+    m_mountPoints.erase(it);
+    m_usages.remove(mountPoint);
+}
+
+/*!
+ * \brief DiskUsageRefresher::usage 获取缓存的容量
+ * \return 还没有结果或查询超时时返回 false
+ */
+bool DiskUsageRefresher::usage(const QString &mountPoint, Usage *usage) const
+{
+    auto it = m_usages.constFind(mountPoint);
+
+    if (it == m_usages.constEnd())
+        return false;
+
+    if (usage)
+        *usage = it.value();
+
+    return true;
+}
+
+/*!
+ * \brief DiskUsageRefresher::setActive 弹出窗口显示时开始定时刷新，隐藏后停止
+ */
+void DiskUsageRefresher::setActive(bool active)
+{
+    if (active == m_refreshTimer.isActive())
+        return;
+
+    if (active) {
+        refresh();
+        m_refreshTimer.start();
+    } else {
+        m_refreshTimer.stop();
+    }
+}
+
+void DiskUsageRefresher::refresh()
+{
+    for (const QString &mountPoint : m_mountPoints.keys()) {
+        auto querying = m_querying.constFind(mountPoint);
+
+        if (querying != m_querying.constEnd()) {
+            // 上一次查询还没有返回，不再重复查询
+            if (querying->hasExpired(USAGE_QUERY_TIMEOUT) && m_usages.remove(mountPoint) > 0)
+                emit usageChanged(mountPoint);
+            continue;
+        }
+
+        m_querying[mountPoint].start();
+
+        QtConcurrent::run(&m_pool, [this, mountPoint] {
+            QStorageInfo info(mountPoint);
+            Usage usage;
+            const bool valid = info.isValid();
+
+            if (valid) {
+                usage.bytesFree = static_cast<quint64>(info.bytesAvailable());
+                usage.bytesTotal = static_cast<quint64>(info.bytesTotal());
+            }
+
+            QTimer::singleShot(0, this, [this, mountPoint, valid, usage] {
+                updateUsage(mountPoint, valid, usage);
+            });
+        });
+    }
+}
+
+void DiskUsageRefresher::updateUsage(const QString &mountPoint, bool valid, const Usage &usage)
+{
+    m_querying.remove(mountPoint);
+
+    // 查询期间设备已被移除
+    if (!m_mountPoints.contains(mountPoint))
+        return;
+
+    if (!valid) {
+        if (m_usages.remove(mountPoint) > 0)
+            emit usageChanged(mountPoint);
+        return;
+    }
+
+    auto it = m_usages.find(mountPoint);
+    if (it != m_usages.end() && it->bytesFree == usage.bytesFree && it->bytesTotal == usage.bytesTotal)
+        return;
+
+    m_usages.insert(mountPoint, usage);
+    emit usageChanged(mountPoint);
+}
@@ -0,0 +1,55 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DISKUSAGEREFRESHER_H
+#define DISKUSAGEREFRESHER_H
+
+#include <QObject>
+#include <QHash>
+#include <QTimer>
+#include <QThreadPool>
+#include <QElapsedTimer>
+
+/*!
+ * \brief DiskUsageRefresher 所有已挂载设备共用的容量刷新
+ *
+ * 断网的网络设备或卡住的 USB 设备上 statvfs 可能长时间不返回，容量统一在线程池中读取，
+ * 每个挂载点同时只有一个查询，超时的挂载点不会阻塞其它挂载点。设备项只读取缓存的结果，
+ * 只有弹出窗口显示时才定时刷新。
+ */
+class DiskUsageRefresher : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Usage {
+        quint64 bytesFree = 0;
+        quint64 bytesTotal = 0;
+    };
+
+    static DiskUsageRefresher *instance();
+
+    void addMountPoint(const QString &mountPoint);
+    void removeMountPoint(const QString &mountPoint);
+    bool usage(const QString &mountPoint, Usage *usage) const;
+
+    void setActive(bool active);
+    void refresh();
+
+signals:
+    void usageChanged(const QString &mountPoint);
+
+private:
+    explicit DiskUsageRefresher(QObject *parent = nullptr);
+
+    void updateUsage(const QString &mountPoint, bool valid, const Usage &usage);
+
+    QHash<QString, int> m_mountPoints; // 挂载点的引用计数，设备项重建时新旧设备可能同时存在
+    QHash<QString, Usage> m_usages;
+    QHash<QString, QElapsedTimer> m_querying;
+    QTimer m_refreshTimer;
+    QThreadPool m_pool;
+};
+
+#endif // DISKUSAGEREFRESHER_H
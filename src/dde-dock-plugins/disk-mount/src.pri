@@ -16,6 +16,7 @@ HEADERS += \
     $$PWD/dattacheddeviceinterface.h \
     $$PWD/dattachedudisks2device.h \
     $$PWD/dattachedvfsdevice.h \
+    $$PWD/diskusagerefresher.h \
     $$PWD/../../dde-file-manager-lib/interfaces/dfmsettings.h \
     $$PWD/../../dde-file-manager-lib/interfaces/dfmstandardpaths.h \
     $$PWD/../../dde-file-manager-lib/interfaces/durl.h \
@@ -34,6 +35,7 @@ SOURCES += \
     $$PWD/diskglobal.cpp \
     $$PWD/dattachedudisks2device.cpp \
     $$PWD/dattachedvfsdevice.cpp \
+    $$PWD/diskusagerefresher.cpp \
     $$PWD/../../dde-file-manager-lib/interfaces/dfmsettings.cpp \
     $$PWD/../../dde-file-manager-lib/interfaces/dfmstandardpaths.cpp \
     $$PWD/../../dde-file-manager-lib/interfaces/durl.cpp \
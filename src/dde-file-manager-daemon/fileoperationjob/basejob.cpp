@@ -39,6 +39,23 @@ bool BaseJob::checkAuthorization(const QString &actionId, qint64 applicationPid)
     return isAuthenticationSucceeded;
 }
 
+bool BaseJob::checkCaller()
+{
+    if (!calledFromDBus())
+        return true;
+
+    const QString &service = message().service();
+    if (m_ownerService.isEmpty())
+        m_ownerService = service;
+
+    if (m_ownerService != service) {
+        sendErrorReply(QDBusError::AccessDenied, QStringLiteral("The job belongs to another client"));
+        return false;
+    }
+
+    return true;
+}
+
 QString BaseJob::objectPath() const
 {
     return m_objectPath;
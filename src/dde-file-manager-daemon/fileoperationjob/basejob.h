@@ -18,6 +18,8 @@ public:
 
     qint64 getClientPid();
     bool checkAuthorization(const QString& actionId, qint64 applicationPid);
+    //! 任务只属于第一个调用它的客户端，其它客户端的调用被拒绝
+    bool checkCaller();
 
     QString objectPath() const;
     void setObjectPath(const QString &objectPath);
@@ -30,6 +32,7 @@ public slots:
 
 private:
     QString m_objectPath;
+    QString m_ownerService;
 };
 
 #endif // BASEJOB_H
@@ -4,6 +4,7 @@
 
 #include "copyjob.h"
 #include "dbusadaptor/copyjob_adaptor.h"
+#include "copymoveexecutor.h"
 
 QString CopyJob::BaseObjectPath = "/com/deepin/filemanager/daemon/CreateCopyJob";
 QString CopyJob::PolicyKitActionId = "com.deepin.filemanager.daemon.NewCopyJob";
@@ -17,6 +18,7 @@ CopyJob::CopyJob(const QStringList &filelist, const QString &targetDir, QObject
     JobId += 1;
     m_jobId = JobId;
     setObjectPath(QString("%1%2").arg(BaseObjectPath, QString::number(m_jobId)));
+    m_progressChannel = DFM_NAMESPACE::DJobProgressChannel::create();
     m_adaptor = new CopyJobAdaptor(this);
 }
 
@@ -27,11 +29,40 @@ CopyJob::~CopyJob()
 
 void CopyJob::Execute()
 {
-    qDebug() << "CreateFolderJob execute";
+    qDebug() << "CopyJob execute";
     qDebug() << PolicyKitActionId;
+    if (!checkCaller())
+        return;
+
     bool isAuthenticationSucceeded = checkAuthorization(PolicyKitActionId, getClientPid());
-    if (isAuthenticationSucceeded){
-        qDebug() << "CreateFolderJob executing";
+    if (!isAuthenticationSucceeded) {
+        emit Done(QStringLiteral("Authorization failed"));
+        deleteLater();
+        return;
+    }
+
+    qDebug() << "CopyJob executing" << m_filelist << m_targetDir;
+    // 整批文件在一个任务中完成，结束后通过 Done 返回结果
+    CopyMoveExecutor *executor = new CopyMoveExecutor(DFM_NAMESPACE::DFileCopyMoveJob::CopyMode, m_filelist, m_targetDir, this);
+    executor->setProgressChannel(m_progressChannel);
+    connect(executor, &CopyMoveExecutor::finished, this, [this](const QString &message) {
+        emit Done(message);
+        deleteLater();
+    });
+    executor->start();
+}
+
+QDBusUnixFileDescriptor CopyJob::ProgressChannel(QDBusUnixFileDescriptor &eventFd)
+{
+    if (!checkCaller())
+        return QDBusUnixFileDescriptor();
+
+    if (!m_progressChannel) {
+        sendErrorReply(QDBusError::Failed, QStringLiteral("Progress channel is unavailable"));
+        return QDBusUnixFileDescriptor();
     }
-    deleteLater();
+
+    // QDBusUnixFileDescriptor 会复制文件描述符，任务自己持有的不受影响
+    eventFd = QDBusUnixFileDescriptor(m_progressChannel->eventFd());
+    return QDBusUnixFileDescriptor(m_progressChannel->memoryFd());
 }
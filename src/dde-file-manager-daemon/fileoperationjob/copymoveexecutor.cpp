@@ -0,0 +1,115 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "copymoveexecutor.h"
+
+#include <QDir>
+#include <QDebug>
+
+DFM_USE_NAMESPACE
+
+CopyMoveExecutor::CopyMoveExecutor(DFileCopyMoveJob::Mode mode, const QStringList &filelist,
+                                   const QString &targetDir, QObject *parent)
+    : QObject(parent)
+    , m_mode(mode)
+    , m_filelist(filelist)
+    , m_targetDir(targetDir)
+{
+}
+
+CopyMoveExecutor::~CopyMoveExecutor()
+{
+    if (m_job) {
+        m_job->stop();
+        m_job->wait();
+    }
+}
+
+void CopyMoveExecutor::setProgressChannel(const QSharedPointer<DJobProgressChannel> &channel)
+{
+    m_progressChannel = channel;
+}
+
+void CopyMoveExecutor::start()
+{
+    DUrlList sourceUrls;
+
+    for (const QString &file : m_filelist) {
+        // 只接受绝对路径，避免相对于守护进程工作目录的路径
+        if (!QDir::isAbsolutePath(file)) {
+            m_errors << QString("%1: not an absolute path").arg(file);
+            continue;
+        }
+
+        sourceUrls << DUrl::fromLocalFile(file);
+    }
+
+    if (sourceUrls.isEmpty() || !QDir::isAbsolutePath(m_targetDir)) {
+        if (!QDir::isAbsolutePath(m_targetDir))
+            m_errors << QString("%1: not an absolute path").arg(m_targetDir);
+
+        emit finished(m_errors.join('\n'));
+        return;
+    }
+
+    m_job = new DFileCopyMoveJob(this);
+    m_job->setMode(m_mode);
+    m_job->setErrorHandle(this);
+    m_job->setActionOfErrorType(DFileCopyMoveJob::FileExistsError, DFileCopyMoveJob::CoexistAction);
+    m_job->setActionOfErrorType(DFileCopyMoveJob::DirectoryExistsError, DFileCopyMoveJob::CoexistAction);
+
+    connect(m_job, &QThread::finished, this, &CopyMoveExecutor::onJobFinished);
+
+    if (m_progressChannel) {
+        // 直接在任务线程中写入，不经过事件循环
+        const QSharedPointer<DJobProgressChannel> channel = m_progressChannel;
+        DFileCopyMoveJob *job = m_job;
+
+        connect(m_job, &DFileCopyMoveJob::fileStatisticsFinished, this, [channel, job] {
+            channel->setTotal(job->totalDataSize(), job->totalFilesCount());
+        }, Qt::DirectConnection);
+        connect(m_job, &DFileCopyMoveJob::progressChanged, this, [channel](qreal, qint64 writeData) {
+            channel->setProcessedBytes(writeData);
+        }, Qt::DirectConnection);
+        connect(m_job, &DFileCopyMoveJob::completedFilesCountChanged, this, [channel](int count) {
+            channel->setProcessedFiles(count);
+        }, Qt::DirectConnection);
+        connect(m_job, &DFileCopyMoveJob::currentJobChanged, this, [channel](const DUrl from, const DUrl, const bool) {
+            channel->setCurrentFile(from.toLocalFile());
+        }, Qt::DirectConnection);
+        connect(m_job, &DFileCopyMoveJob::stateChanged, this, [channel](DFileCopyMoveJob::State state) {
+            channel->setState(state);
+        }, Qt::DirectConnection);
+    }
+
+    m_job->start(sourceUrls, DUrl::fromLocalFile(m_targetDir));
+}
+
+DFileCopyMoveJob::Action CopyMoveExecutor::handleError(DFileCopyMoveJob *job, DFileCopyMoveJob::Error error,
+                                                       const DAbstractFileInfoPointer sourceInfo,
+                                                       const DAbstractFileInfoPointer targetInfo)
+{
+    Q_UNUSED(targetInfo)
+
+    const QString &path = sourceInfo ? sourceInfo->filePath() : QString();
+    m_errors << QString("%1: %2").arg(path, job->errorString());
+    qWarning() << "privileged copy/move error:" << error << path << job->errorString();
+
+    // 空间不足、目标只读时其余文件也无法完成
+    if (error == DFileCopyMoveJob::NotEnoughSpaceError || error == DFileCopyMoveJob::TargetReadOnlyError)
+        return DFileCopyMoveJob::CancelAction;
+
+    return DFileCopyMoveJob::SkipAction;
+}
+
+void CopyMoveExecutor::onJobFinished()
+{
+    if (m_job->error() != DFileCopyMoveJob::NoError && m_errors.isEmpty())
+        m_errors << m_job->errorString();
+
+    if (m_progressChannel)
+        m_progressChannel->setState(DFileCopyMoveJob::StoppedState);
+
+    emit finished(m_errors.join('\n'));
+}
@@ -0,0 +1,53 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef COPYMOVEEXECUTOR_H
+#define COPYMOVEEXECUTOR_H
+
+#include <QObject>
+#include <QStringList>
+#include <QSharedPointer>
+
+#include "io/dfilecopymovejob.h"
+#include "io/djobprogresschannel.h"
+
+/*!
+ * \brief CopyMoveExecutor 在守护进程中执行一批需要授权的复制、移动
+ *
+ * 直接使用 DFileCopyMoveJob 的数据通路（内核拷贝、缓冲池），整批文件在一个任务中完成，
+ * 不再逐个文件经过 pkexec。守护进程没有界面，文件已存在时保留两者，其它错误跳过并记录。
+ */
+class CopyMoveExecutor : public QObject, public DFM_NAMESPACE::DFileCopyMoveJob::Handle
+{
+    Q_OBJECT
+public:
+    explicit CopyMoveExecutor(DFM_NAMESPACE::DFileCopyMoveJob::Mode mode, const QStringList &filelist,
+                              const QString &targetDir, QObject *parent = nullptr);
+    ~CopyMoveExecutor() override;
+
+    //! 需要在 start() 之前设置，任务线程直接写入共享内存
+    void setProgressChannel(const QSharedPointer<DFM_NAMESPACE::DJobProgressChannel> &channel);
+    void start();
+
+signals:
+    //! message 为空表示全部成功，否则为出错的文件和原因
+    void finished(const QString &message);
+
+private:
+    DFM_NAMESPACE::DFileCopyMoveJob::Action handleError(DFM_NAMESPACE::DFileCopyMoveJob *job,
+                                                        DFM_NAMESPACE::DFileCopyMoveJob::Error error,
+                                                        const DAbstractFileInfoPointer sourceInfo,
+                                                        const DAbstractFileInfoPointer targetInfo) override;
+    void onJobFinished();
+
+    DFM_NAMESPACE::DFileCopyMoveJob *m_job = nullptr;
+    DFM_NAMESPACE::DFileCopyMoveJob::Mode m_mode;
+    QStringList m_filelist;
+    QString m_targetDir;
+    QSharedPointer<DFM_NAMESPACE::DJobProgressChannel> m_progressChannel;
+    //! 只在任务线程中写入，任务结束后读取
+    QStringList m_errors;
+};
+
+#endif // COPYMOVEEXECUTOR_H
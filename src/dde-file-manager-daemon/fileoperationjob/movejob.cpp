@@ -4,6 +4,7 @@
 
 #include "movejob.h"
 #include "dbusadaptor/movejob_adaptor.h"
+#include "copymoveexecutor.h"
 
 QString MoveJob::BaseObjectPath = "/com/deepin/filemanager/daemon/MoveJob";
 QString MoveJob::PolicyKitActionId = "com.deepin.filemanager.daemon.NewMoveJob";
@@ -17,6 +18,7 @@ MoveJob::MoveJob(const QStringList &filelist, const QString &targetDir, QObject
     JobId += 1;
     m_jobId = JobId;
     setObjectPath(QString("%1%2").arg(BaseObjectPath, QString::number(m_jobId)));
+    m_progressChannel = DFM_NAMESPACE::DJobProgressChannel::create();
     m_adaptor = new MoveJobAdaptor(this);
 }
 
@@ -29,10 +31,38 @@ void MoveJob::Execute()
 {
     qDebug() << "MoveJob execute";
     qDebug() << PolicyKitActionId;
+    if (!checkCaller())
+        return;
+
     bool isAuthenticationSucceeded = checkAuthorization(PolicyKitActionId, getClientPid());
-    if (isAuthenticationSucceeded){
-        qDebug() << "MoveJob executing";
+    if (!isAuthenticationSucceeded) {
+        emit Done(QStringLiteral("Authorization failed"));
+        deleteLater();
+        return;
     }
-    deleteLater();
+
+    qDebug() << "MoveJob executing" << m_filelist << m_targetDir;
+    // 整批文件在一个任务中完成，结束后通过 Done 返回结果
+    CopyMoveExecutor *executor = new CopyMoveExecutor(DFM_NAMESPACE::DFileCopyMoveJob::MoveMode, m_filelist, m_targetDir, this);
+    executor->setProgressChannel(m_progressChannel);
+    connect(executor, &CopyMoveExecutor::finished, this, [this](const QString &message) {
+        emit Done(message);
+        deleteLater();
+    });
+    executor->start();
 }
 
+QDBusUnixFileDescriptor MoveJob::ProgressChannel(QDBusUnixFileDescriptor &eventFd)
+{
+    if (!checkCaller())
+        return QDBusUnixFileDescriptor();
+
+    if (!m_progressChannel) {
+        sendErrorReply(QDBusError::Failed, QStringLiteral("Progress channel is unavailable"));
+        return QDBusUnixFileDescriptor();
+    }
+
+    // QDBusUnixFileDescriptor 会复制文件描述符，任务自己持有的不受影响
+    eventFd = QDBusUnixFileDescriptor(m_progressChannel->eventFd());
+    return QDBusUnixFileDescriptor(m_progressChannel->memoryFd());
+}
@@ -6,7 +6,10 @@
 #define MOVEJOB_H
 
 #include <QObject>
+#include <QSharedPointer>
+#include <QDBusUnixFileDescriptor>
 #include "basejob.h"
+#include "io/djobprogresschannel.h"
 
 class MoveJobAdaptor;
 
@@ -26,11 +29,14 @@ signals:
 
 public slots:
     void Execute();
+    //! 返回进度共享内存和状态 eventfd，界面据此轮询进度，不再需要逐个文件的信号
+    QDBusUnixFileDescriptor ProgressChannel(QDBusUnixFileDescriptor &eventFd);
 
 private:
     QStringList m_filelist;
     QString m_targetDir;
     int m_jobId = 0;
+    QSharedPointer<DFM_NAMESPACE::DJobProgressChannel> m_progressChannel;
 
     MoveJobAdaptor* m_adaptor;
 };
@@ -22,9 +22,11 @@ HEADERS += \
     $$PWD/fileoperationjob/createtemplatefilejob.h \
     $$PWD/fileoperationjob/movejob.h \
     $$PWD/fileoperationjob/copyjob.h \
+    $$PWD/fileoperationjob/copymoveexecutor.h \
     $$PWD/fileoperationjob/deletejob.h \
     $$PWD/usershare/usersharemanager.h \
     $$PWD/tag/tagmanagerdaemon.h \
+    $$PWD/tag/tagdatabasewriter.h \
     $$PWD/accesscontrol/accesscontrolmanager.h \
     $$PWD/vault/vaultmanager.h \
     $$PWD/vault/vaultclock.h \
@@ -74,9 +76,11 @@ SOURCES += \
     $$PWD/fileoperationjob/createtemplatefilejob.cpp \
     $$PWD/fileoperationjob/movejob.cpp \
     $$PWD/fileoperationjob/copyjob.cpp \
+    $$PWD/fileoperationjob/copymoveexecutor.cpp \
     $$PWD/fileoperationjob/deletejob.cpp \
     $$PWD/usershare/usersharemanager.cpp \
     $$PWD/tag/tagmanagerdaemon.cpp \
+    $$PWD/tag/tagdatabasewriter.cpp \
     $$PWD/accesscontrol/accesscontrolmanager.cpp \
     $$PWD/vault/vaultmanager.cpp \
     $$PWD/vault/vaultclock.cpp \
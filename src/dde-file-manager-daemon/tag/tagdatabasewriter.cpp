@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "tagdatabasewriter.h"
+#include "tag/tagutil.h"
+#include "shutil/dsqlitehandle.h"
+
+#include <QDebug>
+#include <QDBusVariant>
+
+//! 等待写入的请求上限，超过后直接回复错误，避免请求无限堆积
+static constexpr const int MAXPENDINGREQUESTS{ 64 };
+
+TagDatabaseWriter::TagDatabaseWriter()
+    : QObject{ nullptr }
+{
+    m_thread.setObjectName("TagDatabaseWriter");
+
+    //! 数据库连接只能在创建它的线程中使用和销毁
+    QObject::connect(&m_thread, &QThread::finished, this, [this] {
+        delete m_sqliteHandle;
+        m_sqliteHandle = nullptr;
+    }, Qt::DirectConnection);
+
+    moveToThread(&m_thread);
+    m_thread.start();
+}
+
+TagDatabaseWriter::~TagDatabaseWriter()
+{
+    m_thread.quit();
+    m_thread.wait();
+}
+
+bool TagDatabaseWriter::isWriteRequest(const unsigned long long &type)
+{
+    switch (static_cast<Tag::ActionType>(type)) {
+    case Tag::ActionType::MakeFilesTags:
+    case Tag::ActionType::RemoveTagsOfFiles:
+    case Tag::ActionType::DeleteTags:
+    case Tag::ActionType::ChangeTagName:
+    case Tag::ActionType::DeleteFiles:
+    case Tag::ActionType::MakeFilesTagThroughColor:
+    case Tag::ActionType::ChangeFilesName:
+    case Tag::ActionType::BeforeMakeFilesTags:
+    case Tag::ActionType::ChangeTagColor:
+    case Tag::ActionType::MakeTagsOfEachFile:
+        return true;
+    default:
+        break;
+    }
+
+    return false;
+}
+
+bool TagDatabaseWriter::postRequest(const QDBusConnection &connection, const QDBusMessage &message,
+                                    const QMap<QString, QList<QString>> &filesAndTags, const unsigned long long &type)
+{
+    QMutexLocker locker{ &m_mutex };
+
+    if (m_requests.size() >= MAXPENDINGREQUESTS) {
+        qWarning() << "too many tag requests are waiting, drop the request:" << type;
+        return false;
+    }
+
+    m_requests.enqueue(Request{ connection, message, filesAndTags, type });
+
+    //! processRequests 每次取走全部请求，只有队列由空变为非空时需要唤醒写线程
+    if (m_requests.size() == 1) {
+        QMetaObject::invokeMethod(this, "processRequests", Qt::QueuedConnection);
+    }
+
+    return true;
+}
+
+void TagDatabaseWriter::processRequests()
+{
+    if (!m_sqliteHandle) {
+        m_sqliteHandle = new DSqliteHandle;
+
+        QObject::connect(m_sqliteHandle, &DSqliteHandle::addNewTags, this, &TagDatabaseWriter::addNewTags);
+        QObject::connect(m_sqliteHandle, &DSqliteHandle::deleteTags, this, &TagDatabaseWriter::deleteTags);
+        QObject::connect(m_sqliteHandle, &DSqliteHandle::changeTagColor, this, &TagDatabaseWriter::changeTagColor);
+        QObject::connect(m_sqliteHandle, &DSqliteHandle::changeTagName, this, &TagDatabaseWriter::changeTagName);
+        QObject::connect(m_sqliteHandle, &DSqliteHandle::filesWereTagged, this, &TagDatabaseWriter::filesWereTagged);
+        QObject::connect(m_sqliteHandle, &DSqliteHandle::untagFiles, this, &TagDatabaseWriter::untagFiles);
+    }
+
+    QQueue<Request> requests;
+    {
+        QMutexLocker locker{ &m_mutex };
+        requests.swap(m_requests);
+    }
+
+    while (!requests.isEmpty()) {
+        const Request request{ requests.dequeue() };
+        QVariant var{ m_sqliteHandle->disposeClientData(request.filesAndTags, request.type) };
+
+        //! 写入完成后才回复，客户端随后的查询一定能看到本次修改
+        request.connection.send(request.message.createReply(QVariant::fromValue(QDBusVariant{ var })));
+    }
+}
@@ -0,0 +1,67 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef TAGDATABASEWRITER_H
+#define TAGDATABASEWRITER_H
+
+#include <QMap>
+#include <QList>
+#include <QMutex>
+#include <QQueue>
+#include <QObject>
+#include <QThread>
+#include <QVariant>
+#include <QDBusMessage>
+#include <QDBusConnection>
+
+class DSqliteHandle;
+
+/*!
+ * \brief TagDatabaseWriter 标记数据库的写线程
+ *
+ * 修改标记的请求在独立的线程中依次执行，使用自己的数据库连接，DBus 的回复在写入完成后发送。
+ * 查询请求仍由主线程的 DSqliteHandle 处理，数据库为 WAL 模式，查询不会等待写入。
+ */
+class TagDatabaseWriter : public QObject
+{
+    Q_OBJECT
+public:
+    //! 对象移动到写线程中，因此没有父对象
+    TagDatabaseWriter();
+    ~TagDatabaseWriter() override;
+
+    static bool isWriteRequest(const unsigned long long &type);
+
+    //! 队列已满时返回 false，由调用者回复错误
+    bool postRequest(const QDBusConnection &connection, const QDBusMessage &message,
+                     const QMap<QString, QList<QString>> &filesAndTags, const unsigned long long &type);
+
+signals:
+    void addNewTags(const QVariant &new_tags);
+    void deleteTags(const QVariant &be_deleted_tags);
+    void changeTagColor(const QVariantMap &old_and_new_color);
+    void changeTagName(const QVariantMap &old_and_new_name);
+    void filesWereTagged(const QVariantMap &files_were_tagged);
+    void untagFiles(const QVariantMap &del_tags_of_file);
+
+private slots:
+    void processRequests();
+
+private:
+    struct Request
+    {
+        QDBusConnection connection;
+        QDBusMessage message;
+        QMap<QString, QList<QString>> filesAndTags;
+        unsigned long long type;
+    };
+
+    QThread m_thread;
+    QMutex m_mutex;
+    QQueue<Request> m_requests;
+    //! 在写线程中创建，连接只在该线程使用
+    DSqliteHandle *m_sqliteHandle{ nullptr };
+};
+
+#endif // TAGDATABASEWRITER_H
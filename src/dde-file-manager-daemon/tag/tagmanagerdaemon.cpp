@@ -5,6 +5,7 @@
 #include "app/define.h"
 #include "tag/tagutil.h"
 #include "tagmanagerdaemon.h"
+#include "tagdatabasewriter.h"
 #include "shutil/dsqlitehandle.h"
 #include "dbusadaptor/tagmanagerdaemon_adaptor.h"
 
@@ -19,7 +20,8 @@ std::atomic<int> counter{ 0 };
 TagManagerDaemon::TagManagerDaemon(QObject *const parent)
     : QObject{ parent },
       adaptor{ new TagManagerDaemonAdaptor{ this } },
-m_anything_monitor{ new DAnythingMonitorFilter{this} }
+m_anything_monitor{ new DAnythingMonitorFilter{this} },
+m_writer{ new TagDatabaseWriter }
 {
 
     this->init_connection();
@@ -29,6 +31,10 @@ m_anything_monitor{ new DAnythingMonitorFilter{this} }
     }
 }
 
+TagManagerDaemon::~TagManagerDaemon()
+{
+}
+
 QDBusVariant TagManagerDaemon::disposeClientData(const QMap<QString, QVariant> &filesAndTags, const unsigned long long &type)
 {
     QDBusVariant dbusVar{};
@@ -50,6 +56,18 @@ QDBusVariant TagManagerDaemon::disposeClientData(const QMap<QString, QVariant> &
             filesAndTagsName[key] = values;
         }
 
+        ///###: the writes are done in the writer thread, and replied after they were committed.
+        ///###: the queries are answered here with another connection, they do not wait for the writes.
+        if (calledFromDBus() && TagDatabaseWriter::isWriteRequest(type)) {
+            setDelayedReply(true);
+
+            if (!m_writer->postRequest(connection(), message(), filesAndTagsName, type)) {
+                sendErrorReply(QDBusError::LimitsExceeded, "Too many tag requests are waiting.");
+            }
+
+            return dbusVar;
+        }
+
         QVariant var{ DSqliteHandle::instance()->disposeClientData(filesAndTagsName, type) };
         dbusVar.setVariant(var);
     }
@@ -97,5 +115,12 @@ void TagManagerDaemon::init_connection()noexcept
         QObject::connect(DSqliteHandle::instance(), &DSqliteHandle::changeTagName, this, &TagManagerDaemon::onChangeTagName);
         QObject::connect(DSqliteHandle::instance(), &DSqliteHandle::filesWereTagged, this, &TagManagerDaemon::onFileWereTagged);
         QObject::connect(DSqliteHandle::instance(), &DSqliteHandle::untagFiles, this, &TagManagerDaemon::onUntagFiles);
+
+        QObject::connect(m_writer.get(), &TagDatabaseWriter::addNewTags, this, &TagManagerDaemon::onAddNewTags);
+        QObject::connect(m_writer.get(), &TagDatabaseWriter::deleteTags, this, &TagManagerDaemon::onDeleteTags);
+        QObject::connect(m_writer.get(), &TagDatabaseWriter::changeTagColor, this, &TagManagerDaemon::onChangeTagColor);
+        QObject::connect(m_writer.get(), &TagDatabaseWriter::changeTagName, this, &TagManagerDaemon::onChangeTagName);
+        QObject::connect(m_writer.get(), &TagDatabaseWriter::filesWereTagged, this, &TagManagerDaemon::onFileWereTagged);
+        QObject::connect(m_writer.get(), &TagDatabaseWriter::untagFiles, this, &TagManagerDaemon::onUntagFiles);
     }
 }
@@ -10,19 +10,21 @@
 #include <QMap>
 #include <QList>
 #include <QObject>
+#include <QDBusContext>
 
 
 #include "deviceinfo/udisklistener.h"
 #include "deviceinfo/udiskdeviceinfo.h"
 #include "shutil/danythingmonitorfilter.h"
 
+class TagDatabaseWriter;
 class TagManagerDaemonAdaptor;
-class TagManagerDaemon : public QObject
+class TagManagerDaemon : public QObject, protected QDBusContext
 {
     Q_OBJECT
 public:
     explicit TagManagerDaemon(QObject *const parent);
-    virtual ~TagManagerDaemon() = default;
+    virtual ~TagManagerDaemon();
     TagManagerDaemon(const TagManagerDaemon &other) = delete;
     TagManagerDaemon &operator=(const TagManagerDaemon &other) = delete;
 
@@ -51,5 +53,6 @@ private:
 
     TagManagerDaemonAdaptor *adaptor{ nullptr };
     DAnythingMonitorFilter *m_anything_monitor{ nullptr };
+    std::unique_ptr<TagDatabaseWriter> m_writer{ nullptr };
 };
 #endif // TAGMANAGERDAEMON_H
@@ -8,6 +8,7 @@
 #include <QFuture>
 #include <QFutureWatcher>
 #include <QtConcurrent/QtConcurrent>
+#include <QTimer>
 
 #define BluetoothService "com.deepin.daemon.Bluetooth"
 #define BluetoothPath "/com/deepin/daemon/Bluetooth"
@@ -17,6 +18,9 @@
 #define ControlcenterService "com.deepin.dde.ControlCenter"
 #define ControlcenterPath "/com/deepin/dde/ControlCenter"
 
+// 传输进度信号的最短发送间隔
+#define TransferProgressInterval 200
+
 BluetoothManagerPrivate::BluetoothManagerPrivate(BluetoothManager *qq)
     : q_ptr(qq),
       m_model(new BluetoothModel(qq))
@@ -28,6 +32,13 @@ BluetoothManagerPrivate::BluetoothManagerPrivate(BluetoothManager *qq)
     m_controlcenterInter = new DBusControlcenter(ControlcenterService, ControlcenterPath,
                                                  QDBusConnection::sessionBus(), q);
 
+    m_progressTimer = new QTimer(q);
+    m_progressTimer->setSingleShot(true);
+    m_progressTimer->setInterval(TransferProgressInterval);
+    QObject::connect(m_progressTimer, &QTimer::timeout, q, [this] {
+        flushTransferProgress();
+    });
+
     initConnects();
 }
 
@@ -169,11 +180,15 @@ void BluetoothManagerPrivate::initConnects()
 
     QObject::connect(m_bluetoothInter, &DBusBluetooth::ObexSessionRemoved, q, [=](const QDBusObjectPath & sessionPath) {
         qDebug() << sessionPath.path();
+        Q_Q(BluetoothManager);
+        // 会话结束前发送最后一次进度
+        const TransferProgress progress = m_transferProgress.take(sessionPath.path());
+        if (progress.pending)
+            Q_EMIT q->transferProgressUpdated(sessionPath.path(), progress.total, progress.transferred, progress.currentIdx);
     });
 
     QObject::connect(m_bluetoothInter, &DBusBluetooth::ObexSessionProgress, q, [=](const QDBusObjectPath & sessionPath, qulonglong totalSize, qulonglong transferred, int currentIdx) {
-        Q_Q(BluetoothManager);
-        Q_EMIT q->transferProgressUpdated(sessionPath.path(), totalSize, transferred, currentIdx);
+        updateTransferProgress(sessionPath.path(), totalSize, transferred, currentIdx);
     });
 
     QObject::connect(m_bluetoothInter, &DBusBluetooth::TransferFailed, q, [=](const QString & file, const QDBusObjectPath & sessionPath, const QString & errInfo) {
@@ -182,6 +197,44 @@ void BluetoothManagerPrivate::initConnects()
     });
 }
 
+void BluetoothManagerPrivate::updateTransferProgress(const QString &sessionPath, qulonglong total, qulonglong transferred, int currentIdx)
+{
+    Q_Q(BluetoothManager);
+
+    auto it = m_transferProgress.find(sessionPath);
+    // 会话的第一次进度是请求头的数据，传输对话框依靠它判断对方是否接收，需要立即发送
+    const bool immediate = it == m_transferProgress.end() || it->currentIdx != currentIdx || total == transferred;
+
+    if (it == m_transferProgress.end())
+        it = m_transferProgress.insert(sessionPath, TransferProgress());
+
+    it->total = total;
+    it->transferred = transferred;
+    it->currentIdx = currentIdx;
+    it->pending = !immediate;
+
+    if (immediate) {
+        Q_EMIT q->transferProgressUpdated(sessionPath, total, transferred, currentIdx);
+        return;
+    }
+
+    if (!m_progressTimer->isActive())
+        m_progressTimer->start();
+}
+
+void BluetoothManagerPrivate::flushTransferProgress()
+{
+    Q_Q(BluetoothManager);
+
+    for (auto it = m_transferProgress.begin(); it != m_transferProgress.end(); ++it) {
+        if (!it->pending)
+            continue;
+
+        it->pending = false;
+        Q_EMIT q->transferProgressUpdated(it.key(), it->total, it->transferred, it->currentIdx);
+    }
+}
+
 void BluetoothManagerPrivate::inflateAdapter(BluetoothAdapter *adapter, const QJsonObject &adapterObj)
 {
     Q_Q(BluetoothManager);
@@ -347,8 +400,6 @@ void BluetoothManager::showBluetoothSettings()
 
 void BluetoothManager::sendFiles(const QString &id, const QStringList &filePath, const QString &senderToken)
 {
-    Q_D(BluetoothManager);
-
     // /org/bluez/hci0/dev_90_63_3B_DA_5A_4C  --》  90:63:3B:DA:5A:4C
     QString deviceAddress = id;
     deviceAddress.remove(QRegularExpression("/org/bluez/hci[0-9]*/dev_")).replace("_", ":");
@@ -360,21 +411,13 @@ void BluetoothManager::sendFiles(const QString &id, const QStringList &filePath,
        return qMakePair<QString, QString>(reply.value().path(), reply.error().message());
     });
 
-    if (d->m_watcher) {
-        if (d->m_watcher->isRunning())
-            d->m_watcher->future().cancel();
-        delete d->m_watcher;
-        d->m_watcher = nullptr;
-    }
-
-    // 此处 watcher 在 run 完成之后会 delete，但无法在传输对话框关闭后立即 delete
-    d->m_watcher = new QFutureWatcher<QPair<QString, QString>>();
-    d->m_watcher->setFuture(future);
-    connect(d->m_watcher, &QFutureWatcher<QString>::finished, this, [d, senderToken, this]{
-        emit transferEstablishFinish(d->m_watcher->result().first, d->m_watcher->result().second, senderToken);
-        delete d->m_watcher;
-        d->m_watcher = nullptr;
-   });
+    // 每次发送使用单独的 watcher，同时向多个设备发送文件时，之前的对话框也能收到会话建立的结果
+    QFutureWatcher<QPair<QString, QString>> *watcher = new QFutureWatcher<QPair<QString, QString>>(this);
+    connect(watcher, &QFutureWatcher<QString>::finished, this, [watcher, senderToken, this]{
+        emit transferEstablishFinish(watcher->result().first, watcher->result().second, senderToken);
+        watcher->deleteLater();
+    });
+    watcher->setFuture(future);
 }
 
 bool BluetoothManager::cancelTransfer(const QString &sessionPath)
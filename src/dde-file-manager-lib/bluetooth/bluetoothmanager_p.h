@@ -8,6 +8,7 @@
 #include "bluetoothmanager.h"
 
 #include <QDBusConnection>
+#include <QHash>
 
 #include <com_deepin_daemon_bluetooth.h>
 #include <com_deepin_dde_controlcenter.h>
@@ -16,8 +17,7 @@
 using DBusBluetooth = com::deepin::daemon::Bluetooth;
 using DBusControlcenter = com::deepin::dde::ControlCenter;
 
-template<class T>
-class QFutureWatcher;
+class QTimer;
 
 class BluetoothManagerPrivate
 {
@@ -51,12 +51,34 @@ public:
      */
     void inflateDevice(BluetoothDevice *device, const QJsonObject &deviceObj);
 
+    /**
+     * @brief 合并传输会话的进度信号，切换文件和传输完成时立即发送，其它进度定时发送最新的一次
+     * @param sessionPath
+     * @param total
+     * @param transferred
+     * @param currentIdx
+     */
+    void updateTransferProgress(const QString &sessionPath, qulonglong total, qulonglong transferred, int currentIdx);
+
+    /**
+     * @brief 发送所有会话中尚未发送的进度
+     */
+    void flushTransferProgress();
+
 public:
+    struct TransferProgress {
+        qulonglong total = 0;
+        qulonglong transferred = 0;
+        int currentIdx = 0;
+        bool pending = false;
+    };
+
     BluetoothManager *q_ptr {nullptr};
     BluetoothModel *m_model {nullptr};
     DBusBluetooth *m_bluetoothInter {nullptr};
     DBusControlcenter *m_controlcenterInter {nullptr};
-    QFutureWatcher<QPair<QString, QString>> *m_watcher {nullptr};
+    QHash<QString, TransferProgress> m_transferProgress;
+    QTimer *m_progressTimer {nullptr};
 
     Q_DECLARE_PUBLIC(BluetoothManager)
 };
@@ -468,7 +468,7 @@ void AppController::actionCompleteDeletion(const QSharedPointer<DFMUrlListBaseEv
     bool force { false };
     if (DThreadUtil::runInMainThread(dialogManager, &DialogManager::showDeleteFilesClearTrashDialog,
                                      DFMUrlListBaseEvent(sender, list)) == DDialog::Accepted) {
-        DFMEventDispatcher::instance()->processEventAsync(dMakeEventPointer<DFMDeleteEvent>(sender, list, slient, force));
+        DFMEventDispatcher::instance()->processEventAsync(dMakeEventPointer<DFMDeleteEvent>(sender, list, slient, force), nullptr, DFMEventDispatcher::BulkPriority);
     }
 }
 
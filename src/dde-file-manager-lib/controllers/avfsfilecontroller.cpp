@@ -37,16 +37,34 @@ public:
     DUrl url() const override;
 
 private:
-    QDirIterator *iterator;
+    static bool passFilters(const DFMArchiveIndex::Entry &entry, const QStringList &nameFilters, QDir::Filters filter);
+
+    QDirIterator *iterator = nullptr;
     DUrl currentUrl;
+    // 压缩包有索引时直接遍历索引中的文件列表
+    QList<DFMArchiveIndex::Entry> entries;
+    int entryIndex = -1;
 };
 
 AVFSIterator::AVFSIterator(const DUrl &url, const QStringList &nameFilters, QDir::Filters filter, QDirIterator::IteratorFlags flags):
     DDirIterator()
 {
+    currentUrl = url;
+
+    QList<DFMArchiveIndex::Entry> indexEntries;
+
+    // 递归遍历仍然使用 avfs
+    if (!flags.testFlag(QDirIterator::Subdirectories) && DFMArchiveIndex::instance()->entries(url.path(), &indexEntries)) {
+        for (const DFMArchiveIndex::Entry &entry : indexEntries) {
+            if (passFilters(entry, nameFilters, filter))
+                entries << entry;
+        }
+
+        return;
+    }
+
     QString realPath = AVFSFileInfo::realDirUrl(url).toLocalFile();
     iterator = new QDirIterator(realPath, nameFilters, filter, flags);
-    currentUrl = url;
 }
 
 AVFSIterator::~AVFSIterator()
@@ -56,6 +74,11 @@ AVFSIterator::~AVFSIterator()
 
 DUrl AVFSIterator::next()
 {
+    if (!iterator) {
+        ++entryIndex;
+        return fileUrl();
+    }
+
     QString realPath = iterator->next();
     Q_UNUSED(realPath);
     DUrl url = DUrl::fromAVFSFile(currentUrl.path() + "/" + fileName());
@@ -64,21 +87,33 @@ DUrl AVFSIterator::next()
 
 bool AVFSIterator::hasNext() const
 {
+    if (!iterator)
+        return entryIndex + 1 < entries.size();
+
     return iterator->hasNext();
 }
 
 QString AVFSIterator::fileName() const
 {
+    if (!iterator)
+        return entries.value(entryIndex).name;
+
     return fileInfo()->fileName();
 }
 
 DUrl AVFSIterator::fileUrl() const
 {
+    if (!iterator)
+        return DUrl::fromAVFSFile(currentUrl.path() + "/" + fileName());
+
     return fileInfo()->fileUrl();
 }
 
 const DAbstractFileInfoPointer AVFSIterator::fileInfo() const
 {
+    if (!iterator)
+        return DAbstractFileInfoPointer(new AVFSFileInfo(fileUrl(), entries.value(entryIndex)));
+
     DUrl url = DUrl::fromAVFSFile(currentUrl.path() + "/" + iterator->fileName());
     return DAbstractFileInfoPointer(new AVFSFileInfo(url));
 }
@@ -88,6 +123,34 @@ DUrl AVFSIterator::url() const
     return currentUrl;
 }
 
+/*!
+ * \brief AVFSIterator::passFilters 按 QDirIterator 的规则过滤索引中的文件
+ */
+bool AVFSIterator::passFilters(const DFMArchiveIndex::Entry &entry, const QStringList &nameFilters, QDir::Filters filter)
+{
+    if (!(filter & QDir::TypeMask))
+        filter |= QDir::AllEntries;
+
+    if (!(filter & QDir::Hidden) && entry.name.startsWith('.'))
+        return false;
+
+    if ((filter & QDir::NoSymLinks) && entry.isSymLink)
+        return false;
+
+    if (entry.isDir) {
+        if (!(filter & (QDir::Dirs | QDir::AllDirs)))
+            return false;
+
+        // AllDirs 表示目录不受名称过滤的限制
+        if (filter & QDir::AllDirs)
+            return true;
+    } else if (!(filter & QDir::Files)) {
+        return false;
+    }
+
+    return nameFilters.isEmpty() || QDir::match(nameFilters, entry.name);
+}
+
 AVFSFileController::AVFSFileController(QObject *parent):
     DAbstractFileController(parent)
 {
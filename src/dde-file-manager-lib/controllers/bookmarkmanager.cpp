@@ -28,6 +28,14 @@
 #include "shutil/fileutils.h"
 #include "deviceinfo/udisklistener.h"
 
+#include <QThreadPool>
+
+//! 书签目标检查结果的有效时间（ms）
+#define BOOKMARK_REACHABILITY_CACHE_TIME 30000
+
+//! 访问无响应的网络书签可能长时间阻塞，不占用全局线程池
+Q_GLOBAL_STATIC(QThreadPool, bookmarkCheckThreadPool)
+
 
 #define BOOKMARK_NAME "name"
 #define BOOKMARK_CREATED "created"
@@ -101,6 +109,70 @@ bool BookMarkManager::checkExist(const DUrl &url)
 //    return p;
 }
 
+/*!
+ * \brief BookMarkManager::reachability 返回书签目标最近一次的检查结果，不会访问书签目标
+ * \param url 书签url
+ */
+BookMarkManager::Reachability BookMarkManager::reachability(const DUrl &url) const
+{
+    auto iter = m_reachability.constFind(url);
+    if (iter == m_reachability.constEnd())
+        return ReachabilityUnknown;
+
+    return iter->reachable ? TargetReachable : TargetUnreachable;
+}
+
+/*!
+ * \brief BookMarkManager::validateBookmark 在线程池中检查书签目标是否存在，完成后发出 reachabilityChanged 信号
+ *
+ * 检查结果在 BOOKMARK_REACHABILITY_CACHE_TIME 内有效，有效期内或正在检查时不再重复检查。
+ * \param url 书签url
+ */
+void BookMarkManager::validateBookmark(const DUrl &url)
+{
+    if (!url.isBookMarkFile() || m_validatingUrls.contains(url))
+        return;
+
+    auto iter = m_reachability.constFind(url);
+    if (iter != m_reachability.constEnd() && iter->checkedTimer.isValid()
+            && iter->checkedTimer.elapsed() < BOOKMARK_REACHABILITY_CACHE_TIME) {
+        return;
+    }
+
+    const BookmarkData &data = findBookmarkData(url);
+    if (!data.m_url.isValid())
+        return;
+
+    // BookMark::exists() 会修改文件信息的数据，使用单独的对象在线程中检查，不与界面使用的对象共享
+    BookMarkPointer item(new BookMark(url));
+    item->mountPoint = data.mountPoint;
+    item->locateUrl = data.locateUrl;
+
+    m_validatingUrls.insert(url);
+
+    QtConcurrent::run(bookmarkCheckThreadPool, [this, url, item] {
+        const bool reachable = item->exists();
+
+        QMetaObject::invokeMethod(this, "onBookmarkValidated", Qt::QueuedConnection,
+                                  Q_ARG(DUrl, url), Q_ARG(bool, reachable));
+    });
+}
+
+void BookMarkManager::onBookmarkValidated(const DUrl &url, bool reachable)
+{
+    m_validatingUrls.remove(url);
+
+    BookmarkReachability &state = m_reachability[url];
+    const bool changed = !state.checkedTimer.isValid() || state.reachable != reachable;
+
+    state.reachable = reachable;
+    state.checkedTimer.start();
+
+    // 检查期间书签可能已被删除
+    if (changed && m_bookmarkDataMap.contains(url.bookmarkTargetUrl()))
+        emit reachabilityChanged(url, reachable);
+}
+
 bool BookMarkManager::renameFile(const QSharedPointer<DFMRenameEvent> &event) const
 {
     DUrl from = event->fromUrl();
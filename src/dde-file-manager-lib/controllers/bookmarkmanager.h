@@ -12,6 +12,8 @@
 #include <deque>
 
 #include <QDir>
+#include <QElapsedTimer>
+#include <QSet>
 
 class DAbstractFileInfo;
 class DBookmarkItem;
@@ -26,6 +28,12 @@ struct BookmarkData {
     QString udisksMountPoint = QString();
 };
 
+//! 书签目标最近一次的检查结果
+struct BookmarkReachability {
+    bool reachable = true;
+    QElapsedTimer checkedTimer;
+};
+
 class BookMarkManager : public DAbstractFileController
 {
     Q_OBJECT
@@ -35,6 +43,15 @@ public:
 
     bool checkExist(const DUrl &url);
 
+    enum Reachability {
+        ReachabilityUnknown,
+        TargetReachable,
+        TargetUnreachable
+    };
+
+    Reachability reachability(const DUrl &url) const;
+    void validateBookmark(const DUrl &url);
+
     bool renameFile(const QSharedPointer<DFMRenameEvent> &event) const override;
     bool deleteFiles(const QSharedPointer<DFMDeleteEvent> &event) const override;
     bool touch(const QSharedPointer<DFMTouchFileEvent> &event) const override;
@@ -54,11 +71,19 @@ public:
 
     void initData();
 
+signals:
+    void reachabilityChanged(const DUrl &url, bool reachable);
+
+private slots:
+    void onBookmarkValidated(const DUrl &url, bool reachable);
+
 private:
     BookMarkPointer findBookmark(const DUrl &url) const;
     BookmarkData findBookmarkData(const DUrl &url) const;
     mutable QMap<DUrl, BookMarkPointer> m_bookmarks;
     mutable QMap<DUrl, BookmarkData> m_bookmarkDataMap;
+    QMap<DUrl, BookmarkReachability> m_reachability;
+    QSet<DUrl> m_validatingUrls;
 
     void update(const QVariant &value);
     void onFileEdited(const QString &group, const QString &key, const QVariant &value);
@@ -134,7 +134,30 @@ static bool ignoreBlkDevice(const QString& blkPath, QSharedPointer<DBlockDevice>
 
 DFMRootController::DFMRootController(QObject *parent) : DAbstractFileController(parent)
 {
+    // 块设备的增删和挂载变化时增量更新缓存的条目，getChildren 不再每次查询所有块设备
+    m_diskManager = new DDiskManager(this);
+    m_diskManager->setWatchChanges(true);
+
+    connect(m_diskManager, &DDiskManager::blockDeviceAdded, this, &DFMRootController::updateBlockEntry);
+    connect(m_diskManager, &DDiskManager::blockDeviceRemoved, this, &DFMRootController::removeBlockEntry);
+    connect(m_diskManager, &DDiskManager::fileSystemAdded, this, &DFMRootController::updateBlockEntry);
+    connect(m_diskManager, &DDiskManager::fileSystemRemoved, this, &DFMRootController::updateBlockEntry);
+    connect(m_diskManager, &DDiskManager::mountAdded, this, [this](const QString &blockDevicePath, const QByteArray &) {
+        updateBlockEntry(blockDevicePath);
+    });
+    connect(m_diskManager, &DDiskManager::mountRemoved, this, [this](const QString &blockDevicePath, const QByteArray &) {
+        updateBlockEntry(blockDevicePath);
+    });
+    // 是否隐藏 loop 设备会影响过滤结果，下次获取时重新枚举
+    if (DFMApplication::instance()) {
+        connect(DFMApplication::instance(), &DFMApplication::genericAttributeChanged, this, [this](DFMApplication::GenericAttribute ga) {
+            if (ga != DFMApplication::GA_HideLoopPartitions)
+                return;
 
+            QMutexLocker locker(&m_blockEntriesMutex);
+            m_blockEntriesLoaded = false;
+        });
+    }
 }
 
 bool DFMRootController::renameFile(const QSharedPointer<DFMRenameEvent> &event) const
@@ -217,35 +240,30 @@ const QList<DAbstractFileInfoPointer> DFMRootController::getChildren(const QShar
             diskPolicyList = GroupPolicy::instance()->getValue(DISK_HIDDEN).toStringList();
     }
 
-    QStringList blkds = DDiskManager::blockDevices({});
-    for (auto blks : blkds) {
-        QSharedPointer<DBlockDevice> blk(DDiskManager::createBlockDevice(blks));
-        QSharedPointer<DDiskDevice> drv(DDiskManager::createDiskDevice(blk->drive()));
-        if(ignoreBlkDevice(blks, blk, drv)){
-            continue;
-        }
-
-        reloadBlkName(blks, blk);
+    const QMap<QString, BlockEntry> &blkEntries = blockEntries();
+    for (auto it = blkEntries.constBegin(); it != blkEntries.constEnd(); ++it) {
+        const QString &blks = it.key();
+        const BlockEntry &entry = it.value();
 
         if (DTK_POLICY_SUPPORT) {
-            if (hasSetDiskPolicy && blk->hintSystem() && diskPolicyList.contains(blk->idUUID()))
+            if (hasSetDiskPolicy && entry.hintSystem && diskPolicyList.contains(entry.uuid))
                 continue;
 
-            if (blk->hintSystem())
-                hintSystemDisks << blk->idUUID();
+            if (entry.hintSystem)
+                hintSystemDisks << entry.uuid;
 
-            if (!hasSetDiskPolicy && DFMApplication::genericAttribute(DFMApplication::GA_HiddenSystemPartition).toBool() && blk->hintSystem()) {
+            if (!hasSetDiskPolicy && DFMApplication::genericAttribute(DFMApplication::GA_HiddenSystemPartition).toBool() && entry.hintSystem) {
                 qDebug()  << "block device is ignored by hintSystem&HiddenSystemPartition:"  << blks;
                 continue;
             }
         } else {
-            if (DFMApplication::genericAttribute(DFMApplication::GA_HiddenSystemPartition).toBool() && blk->hintSystem()) {
+            if (DFMApplication::genericAttribute(DFMApplication::GA_HiddenSystemPartition).toBool() && entry.hintSystem) {
                 qDebug()  << "block device is ignored by hintSystem&HiddenSystemPartition:"  << blks;
                 continue;
             }
         }
 
-        DAbstractFileInfoPointer fp(new DFMRootFileInfo(DUrl(DFMROOT_ROOT + QString(blk->device()).mid(QString("/dev/").length()) + "." SUFFIX_UDISKS)));
+        DAbstractFileInfoPointer fp(new DFMRootFileInfo(DUrl(DFMROOT_ROOT + entry.device.mid(QString("/dev/").length()) + "." SUFFIX_UDISKS)));
         ret.push_back(fp);
     }
 
@@ -400,6 +418,64 @@ QStringList DFMRootController::systemDiskList()
     return tempList;
 }
 
+bool DFMRootController::loadBlockEntry(const QString &blkPath, BlockEntry *entry) const
+{
+    QSharedPointer<DBlockDevice> blk(DDiskManager::createBlockDevice(blkPath));
+    QSharedPointer<DDiskDevice> drv(DDiskManager::createDiskDevice(blk->drive()));
+    if (ignoreBlkDevice(blkPath, blk, drv))
+        return false;
+
+    reloadBlkName(blkPath, blk);
+
+    entry->device = QString(blk->device());
+    entry->uuid = blk->idUUID();
+    entry->hintSystem = blk->hintSystem();
+    return true;
+}
+
+void DFMRootController::updateBlockEntry(const QString &blkPath)
+{
+    {
+        QMutexLocker locker(&m_blockEntriesMutex);
+        // 还没有枚举过块设备时，等到第一次获取时再一起查询
+        if (!m_blockEntriesLoaded)
+            return;
+    }
+
+    BlockEntry entry;
+    bool visible = loadBlockEntry(blkPath, &entry);
+
+    QMutexLocker locker(&m_blockEntriesMutex);
+    if (visible)
+        m_blockEntries.insert(blkPath, entry);
+    else
+        m_blockEntries.remove(blkPath);
+}
+
+void DFMRootController::removeBlockEntry(const QString &blkPath)
+{
+    QMutexLocker locker(&m_blockEntriesMutex);
+    m_blockEntries.remove(blkPath);
+}
+
+QMap<QString, DFMRootController::BlockEntry> DFMRootController::blockEntries() const
+{
+    QMutexLocker locker(&m_blockEntriesMutex);
+    if (m_blockEntriesLoaded)
+        return m_blockEntries;
+
+    m_blockEntries.clear();
+    QStringList blkds = DDiskManager::blockDevices({});
+    for (auto blks : blkds) {
+        BlockEntry entry;
+        if (loadBlockEntry(blks, &entry))
+            m_blockEntries.insert(blks, entry);
+    }
+    m_blockEntriesLoaded = true;
+
+    return m_blockEntries;
+}
+
 void DFMRootController::loadDiskInfo(const QString &jsonPath) const
 {
     //不存在该目录
@@ -12,8 +12,11 @@
 #include <dblockdevice.h>
 #include <ddiskdevice.h>
 
+#include <QMutex>
+
 #define DISK_HIDDEN "dfm.disk.hidden"
 class DFMRootFileInfo;
+class DDiskManager;
 class DFMRootFileWatcherPrivate;
 class DFMRootFileWatcher : public DAbstractFileWatcher
 {
@@ -58,6 +61,28 @@ private:
      */
     bool setLocalDiskAlias(DFMRootFileInfo *fi, const QString &alias) const;
 
+    // 计算机页面中的块设备条目，只保存不会被过滤的设备
+    struct BlockEntry {
+        QString device;
+        QString uuid;
+        bool hintSystem = false;
+    };
+
+    /**
+     * @brief loadBlockEntry 查询块设备并判断是否在计算机页面显示
+     * @return 需要显示时返回 true
+     */
+    bool loadBlockEntry(const QString &blkPath, BlockEntry *entry) const;
+    // 块设备变化时更新缓存的条目
+    void updateBlockEntry(const QString &blkPath);
+    void removeBlockEntry(const QString &blkPath);
+    // 返回缓存的块设备条目，第一次调用时枚举所有块设备
+    QMap<QString, BlockEntry> blockEntries() const;
+
+    DDiskManager *m_diskManager { nullptr };
+    mutable QMap<QString, BlockEntry> m_blockEntries;
+    mutable bool m_blockEntriesLoaded { false };
+    mutable QMutex m_blockEntriesMutex;
 };
 
 #endif // DFMROOTCONTROLLER_H
@@ -18,6 +18,7 @@
 #include "interfaces/dfilemenu.h"
 
 #include <DDialog>
+#include <QApplication>
 
 DFM_BEGIN_NAMESPACE
 
@@ -32,9 +33,27 @@ DFMSideBarItem *DFMSideBarBookmarkItemHandler::createItem(const DUrl &url)
     item->setFlags(Qt::ItemIsSelectable | Qt::ItemIsEnabled | Qt::ItemIsDragEnabled | Qt::ItemIsEditable | Qt::ItemNeverHasChildren);
     item->setRegisteredHandler(SIDEBAR_ID_BOOKMARK);
 
+    // 先按上次的检查结果显示，书签目标在线程中检查，结果由 BookMarkManager::reachabilityChanged 更新
+    if (bookmarkManager->reachability(url) == BookMarkManager::TargetUnreachable)
+        setItemReachable(item, false);
+
+    bookmarkManager->validateBookmark(url);
+
     return item;
 }
 
+/*!
+ * \brief DFMSideBarBookmarkItemHandler::setItemReachable 书签目标无法访问时使用禁用状态的文字颜色
+ */
+void DFMSideBarBookmarkItemHandler::setItemReachable(DFMSideBarItem *item, bool reachable)
+{
+    if (!item)
+        return;
+
+    item->setData(reachable ? QVariant() : QVariant(qApp->palette().brush(QPalette::Disabled, QPalette::Text)),
+                  Qt::ForegroundRole);
+}
+
 DFMSideBarBookmarkItemHandler::DFMSideBarBookmarkItemHandler()
 {
 
@@ -43,7 +62,13 @@ DFMSideBarBookmarkItemHandler::DFMSideBarBookmarkItemHandler()
 void DFMSideBarBookmarkItemHandler::cdAction(const DFMSideBar *sidebar, const DFMSideBarItem *item)
 {
     DAbstractFileInfoPointer info = DFileService::instance()->createFileInfo(nullptr, item->url());
-    if (info->exists()) {
+    // 最近检查过的书签不再访问书签目标，避免无响应的网络书签阻塞界面
+    const BookMarkManager::Reachability state = bookmarkManager->reachability(item->url());
+    const bool exists = state == BookMarkManager::ReachabilityUnknown ? info->exists()
+                                                                      : state == BookMarkManager::TargetReachable;
+    bookmarkManager->validateBookmark(item->url());
+
+    if (exists) {
         DFileManagerWindow *wnd = qobject_cast<DFileManagerWindow *>(sidebar->topLevelWidget());
         wnd->cd(info->fileUrl());
     } else {
@@ -66,7 +91,9 @@ QMenu *DFMSideBarBookmarkItemHandler::contextMenu(const DFMSideBar *sidebar, con
     DFileManagerWindow *wnd = qobject_cast<DFileManagerWindow *>(sidebar->topLevelWidget());
     bool shouldEnable = WindowManager::tabAddableByWinId(wnd->windowId());
     const DAbstractFileInfoPointer& info = DFileService::instance()->createFileInfo(nullptr, item->url());
-    bool fileExist = info->exists();
+    const BookMarkManager::Reachability state = bookmarkManager->reachability(item->url());
+    bool fileExist = state == BookMarkManager::ReachabilityUnknown ? info->exists()
+                                                                   : state == BookMarkManager::TargetReachable;
 
     menu->addAction(QObject::tr("Open in new window"), [item]() {
         WindowManager::instance()->showNewWindow(item->url(), true);
@@ -16,6 +16,7 @@ class DFMSideBarBookmarkItemHandler : public DFMSideBarItemInterface
 {
 public:
     static DFMSideBarItem * createItem(const DUrl &url);
+    static void setItemReachable(DFMSideBarItem *item, bool reachable);
 
     DFMSideBarBookmarkItemHandler();
 
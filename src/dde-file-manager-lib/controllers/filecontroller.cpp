@@ -17,6 +17,7 @@
 #include "dlocalfilehandler.h"
 #include "dfilecopymovejob.h"
 #include "dstorageinfo.h"
+#include "dmounttable.h"
 #include <sys/stat.h>
 #include "models/desktopfileinfo.h"
 #include "models/trashfileinfo.h"
@@ -60,11 +61,18 @@
 
 #include <thread>
 #include <unistd.h>
+#include <fcntl.h>
+#include <dirent.h>
+#ifdef Q_OS_LINUX
+#include <sys/syscall.h>
+#endif
 #include <gio/gio.h>
 
 #include <QQueue>
 #include <QMutex>
 #include <QTextCodec>
+#include <QThreadPool>
+#include <QtConcurrent>
 
 #include "dfmsettings.h"
 #include "dfmapplication.h"
@@ -208,6 +216,471 @@ private:
     QFileInfo currentFileInfo;
 };
 
+#ifdef SYS_getdents64
+#define LOCAL_DIRENT_BUFFER_LEN 256 * 1024
+// 网络文件系统上每批并行读取属性的文件数
+#define NETWORK_STAT_BATCH_SIZE 256
+// 读取属性的并发数，主要耗时在等待服务器响应
+#define NETWORK_STAT_THREAD_COUNT 16
+
+Q_GLOBAL_STATIC(QThreadPool, networkStatThreadPool)
+
+struct LocalDirent64 {
+    quint64 d_ino;
+    qint64 d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[1];
+};
+
+/*!
+ * \brief 本地目录的快速迭代器
+ *
+ * 使用getdents64按大块读取目录项，通过d_type区分文件和目录，只有符号链接和文件系统不提供类型时才需要stat。
+ * 迭代时只记录文件名，fileInfo()中才创建文件信息，DFileInfo的各项属性在第一次使用时读取。
+ * 名称过滤、递归、权限过滤和gvfs目录仍使用DFMQDirIterator。
+ * 在nfs、cifs等网络文件系统上按批创建文件信息，并在线程池中并行地用statx读取属性。
+ */
+class DFMLocalDirIterator : public DDirIterator
+{
+public:
+    DFMLocalDirIterator(const QString &path, QDir::Filters filter)
+        : dirPath(QDir::cleanPath(path))
+        , filters(filter == QDir::NoFilter ? QDir::AllEntries : filter)
+    {
+        fd = open(QFile::encodeName(dirPath).constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        networkFileSystem = DMountTable::instance()->mountClass(dirPath) == DMountTable::NetworkMount;
+    }
+
+    ~DFMLocalDirIterator() override
+    {
+        if (fd >= 0)
+            ::close(fd);
+    }
+
+    static bool isSupported(const QString &path, const QStringList &nameFilters, QDir::Filters filter,
+                            QDirIterator::IteratorFlags flags, bool gvfs)
+    {
+        if (gvfs || !nameFilters.isEmpty() || flags != QDirIterator::NoIteratorFlags)
+            return false;
+
+        if (filter != QDir::NoFilter && (filter & (QDir::PermissionMask | QDir::Modified)))
+            return false;
+
+        return !FileUtils::isGvfsMountFile(path, true);
+    }
+
+    DUrl next() override
+    {
+        if (!hasNext())
+            return DUrl();
+
+        hasNextEntry = false;
+        currentName = nextName;
+        currentIsRegularFile = nextIsRegularFile;
+        currentInfo = prefetchedInfos.isEmpty() ? DAbstractFileInfoPointer() : prefetchedInfos.dequeue();
+
+        return fileUrl();
+    }
+
+    bool hasNext() const override
+    {
+        if (hasNextEntry)
+            return true;
+
+        if (networkFileSystem) {
+            if (prefetchedInfos.isEmpty())
+                prefetchBatch();
+
+            if (prefetchedInfos.isEmpty())
+                return false;
+
+            nextName = prefetchedInfos.head()->fileName();
+            // 文件信息已创建，不再需要目录项的类型
+            nextIsRegularFile = false;
+            hasNextEntry = true;
+
+            return true;
+        }
+
+        if (!readEntry(nextName, nextIsRegularFile))
+            return false;
+
+        hasNextEntry = true;
+
+        return true;
+    }
+
+    QString fileName() const override
+    {
+        return currentName;
+    }
+
+    DUrl fileUrl() const override
+    {
+        return DUrl::fromLocalFile(currentFilePath());
+    }
+
+    const DAbstractFileInfoPointer fileInfo() const override
+    {
+        if (currentInfo)
+            return currentInfo;
+
+        return createFileInfo(fileUrl(), currentName, currentIsRegularFile);
+    }
+
+    DUrl url() const override
+    {
+        return DUrl::fromLocalFile(dirPath);
+    }
+
+    void close() override
+    {
+        closed = true;
+    }
+
+private:
+    QString currentFilePath() const
+    {
+        return dirPath == "/" ? dirPath + currentName : dirPath + "/" + currentName;
+    }
+
+    static DAbstractFileInfoPointer createFileInfo(const DUrl &url, const QString &name, bool isRegularFile)
+    {
+        // 按后缀判断是否可能是desktop文件，不必为每个文件读取内容推断mime类型
+        if (isRegularFile && name.endsWith(".desktop", Qt::CaseInsensitive) && FileUtils::isDesktopFile(url.toLocalFile()))
+            return DAbstractFileInfoPointer(new DesktopFileInfo(url));
+
+        return DAbstractFileInfoPointer(new DFileInfo(url));
+    }
+
+    // 读取一批目录项，并行地一次性取得它们的属性，之后访问文件信息时不必再逐个与服务器同步
+    void prefetchBatch() const
+    {
+        QList<DFileInfo *> infos;
+        QString name;
+        bool isRegularFile = false;
+
+        while (prefetchedInfos.size() < NETWORK_STAT_BATCH_SIZE && readEntry(name, isRegularFile)) {
+            const DUrl &url = DUrl::fromLocalFile(dirPath == "/" ? dirPath + name : dirPath + "/" + name);
+            const DAbstractFileInfoPointer &info = createFileInfo(url, name, isRegularFile);
+
+            prefetchedInfos.enqueue(info);
+
+            if (DFileInfo *fileInfo = dynamic_cast<DFileInfo *>(info.data()))
+                infos << fileInfo;
+        }
+
+        if (infos.isEmpty())
+            return;
+
+        QThreadPool *pool = networkStatThreadPool;
+
+        if (pool->maxThreadCount() != NETWORK_STAT_THREAD_COUNT)
+            pool->setMaxThreadCount(NETWORK_STAT_THREAD_COUNT);
+
+        const int step = qMax(1, infos.size() / NETWORK_STAT_THREAD_COUNT);
+        QList<QFuture<void>> futures;
+
+        for (int i = 0; i < infos.size(); i += step) {
+            const QList<DFileInfo *> &part = infos.mid(i, step);
+
+            futures << QtConcurrent::run(pool, [part] {
+                for (DFileInfo *info : part)
+                    info->loadStatAttributes(true);
+            });
+        }
+
+        for (QFuture<void> &future : futures)
+            future.waitForFinished();
+    }
+
+    bool readEntry(QString &name, bool &isRegularFile) const
+    {
+        while (!closed && fd >= 0) {
+            if (bufferPos >= bufferLength) {
+                if (buffer.isEmpty())
+                    buffer.resize(LOCAL_DIRENT_BUFFER_LEN);
+
+                const long length = syscall(SYS_getdents64, fd, buffer.data(), buffer.size());
+                if (length <= 0) {
+                    closed = true;
+                    break;
+                }
+
+                bufferLength = length;
+                bufferPos = 0;
+            }
+
+            const LocalDirent64 *entry = reinterpret_cast<const LocalDirent64 *>(buffer.constData() + bufferPos);
+            bufferPos += entry->d_reclen;
+
+            if (!matchesFilters(entry->d_name, entry->d_type, isRegularFile))
+                continue;
+
+            name = QFile::decodeName(entry->d_name);
+
+            return true;
+        }
+
+        return false;
+    }
+
+    // 与QDirIterator在没有名称过滤时的规则一致，isRegularFile返回目录项本身是否为普通文件
+    bool matchesFilters(const char *name, unsigned char type, bool &isRegularFile) const
+    {
+        const bool isDot = name[0] == '.' && name[1] == '\0';
+        const bool isDotDot = name[0] == '.' && name[1] == '.' && name[2] == '\0';
+
+        if ((isDot && filters.testFlag(QDir::NoDot)) || (isDotDot && filters.testFlag(QDir::NoDotDot)))
+            return false;
+
+        if (name[0] == '.' && !isDot && !isDotDot && !filters.testFlag(QDir::Hidden))
+            return false;
+
+        auto typeOfMode = [](mode_t mode) -> unsigned char {
+            return S_ISDIR(mode) ? DT_DIR : S_ISREG(mode) ? DT_REG : S_ISLNK(mode) ? DT_LNK : DT_UNKNOWN;
+        };
+
+        struct stat st;
+        // 文件系统不提供类型时才stat
+        if (type == DT_UNKNOWN) {
+            if (fstatat(fd, name, &st, AT_SYMLINK_NOFOLLOW) != 0)
+                return false;
+
+            type = typeOfMode(st.st_mode);
+        }
+
+        const bool isSymLink = type == DT_LNK;
+        // 符号链接按指向的文件判断是文件还是目录
+        bool exists = true;
+        if (isSymLink) {
+            exists = fstatat(fd, name, &st, 0) == 0;
+            type = exists ? typeOfMode(st.st_mode) : DT_UNKNOWN;
+        }
+
+        const bool isDir = type == DT_DIR;
+        const bool isFile = type == DT_REG;
+
+        if (!filters.testFlag(QDir::System) && ((!isDir && !isFile && !isSymLink) || (isSymLink && !exists)))
+            return false;
+
+        if (isDir && !(filters & (QDir::Dirs | QDir::AllDirs)))
+            return false;
+
+        if (isFile && !filters.testFlag(QDir::Files))
+            return false;
+
+        // 损坏的链接在需要系统文件时仍然保留
+        if (isSymLink && filters.testFlag(QDir::NoSymLinks) && (exists || !filters.testFlag(QDir::System)))
+            return false;
+
+        isRegularFile = isFile && !isSymLink;
+
+        return true;
+    }
+
+    QString dirPath;
+    QDir::Filters filters;
+    int fd = -1;
+    mutable QAtomicInteger<bool> closed{false};
+
+    mutable QByteArray buffer;
+    mutable long bufferPos = 0;
+    mutable long bufferLength = 0;
+
+    mutable bool hasNextEntry = false;
+    mutable QString nextName;
+    mutable bool nextIsRegularFile = false;
+
+    bool networkFileSystem = false;
+    mutable QQueue<DAbstractFileInfoPointer> prefetchedInfos;
+
+    QString currentName;
+    bool currentIsRegularFile = false;
+    DAbstractFileInfoPointer currentInfo;
+};
+#endif
+
+// smb目录每批读取的文件数，读完一批即交给模型显示
+#define GVFS_ENUMERATE_BATCH_SIZE 500
+// 一次枚举取得创建DGvfsFileInfo所需的全部属性
+#define GVFS_ENUMERATE_ATTRIBUTES "standard::name,standard::type,standard::size,standard::is-symlink," \
+    "standard::content-type,access::can-write,access::can-rename,time::modified,time::access,unix::uid,unix::inode"
+
+/*!
+ * \brief smb目录的迭代器
+ *
+ * 通过fuse路径逐个访问文件时，每个文件的stat、access等都要与服务器往返一次，大目录长时间没有结果。
+ * 这里直接通过gio枚举，一次请求取得所有需要的属性，按批读取后用这些属性创建DGvfsFileInfo，
+ * 创建文件信息时不再访问文件。名称过滤、递归和权限过滤仍使用DFMQDirIterator。
+ */
+class DFMGvfsDirIterator : public DDirIterator
+{
+public:
+    DFMGvfsDirIterator(const QString &path, QDir::Filters filter)
+        : dirPath(QDir::cleanPath(path))
+        , filters(filter)
+        , cancellable(g_cancellable_new())
+    {
+    }
+
+    ~DFMGvfsDirIterator() override
+    {
+        if (enumerator) {
+            g_file_enumerator_close(enumerator, nullptr, nullptr);
+            g_object_unref(enumerator);
+        }
+
+        g_object_unref(cancellable);
+    }
+
+    static bool isSupported(const QString &path, const QStringList &nameFilters, QDir::Filters filter,
+                            QDirIterator::IteratorFlags flags, bool gvfs)
+    {
+        if (!gvfs || !nameFilters.isEmpty() || flags != QDirIterator::NoIteratorFlags)
+            return false;
+
+        // gio不返回.和..
+        if (!filter.testFlag(QDir::NoDot) || !filter.testFlag(QDir::NoDotDot))
+            return false;
+
+        if (filter & (QDir::PermissionMask | QDir::Modified))
+            return false;
+
+        return FileUtils::isSmbPath(path);
+    }
+
+    DUrl next() override
+    {
+        if (!hasNext())
+            return DUrl();
+
+        currentInfo = prefetchedInfos.dequeue();
+
+        return currentInfo->fileUrl();
+    }
+
+    bool hasNext() const override
+    {
+        if (prefetchedInfos.isEmpty())
+            prefetchBatch();
+
+        return !prefetchedInfos.isEmpty();
+    }
+
+    QString fileName() const override
+    {
+        return currentInfo ? currentInfo->fileName() : QString();
+    }
+
+    DUrl fileUrl() const override
+    {
+        return currentInfo ? currentInfo->fileUrl() : DUrl();
+    }
+
+    const DAbstractFileInfoPointer fileInfo() const override
+    {
+        return currentInfo;
+    }
+
+    DUrl url() const override
+    {
+        return DUrl::fromLocalFile(dirPath);
+    }
+
+    void close() override
+    {
+        g_cancellable_cancel(cancellable);
+    }
+
+private:
+    // 在job线程中运行，同步读取即可；gvfs的守护进程会连续发送目录项，读取时不必逐个等待
+    void prefetchBatch() const
+    {
+        if (finished || g_cancellable_is_cancelled(cancellable))
+            return;
+
+        if (!enumerator) {
+            GFile *dir = g_file_new_for_path(QFile::encodeName(dirPath).constData());
+            GError *error = nullptr;
+
+            enumerator = g_file_enumerate_children(dir, GVFS_ENUMERATE_ATTRIBUTES, G_FILE_QUERY_INFO_NONE,
+                                                   cancellable, &error);
+            g_object_unref(dir);
+
+            if (!enumerator) {
+                qWarning() << "enumerate gvfs dir failed:" << dirPath << (error ? error->message : "");
+                if (error)
+                    g_error_free(error);
+                finished = true;
+                return;
+            }
+        }
+
+        while (prefetchedInfos.size() < GVFS_ENUMERATE_BATCH_SIZE) {
+            GError *error = nullptr;
+            GFileInfo *info = g_file_enumerator_next_file(enumerator, cancellable, &error);
+
+            if (!info) {
+                if (error) {
+                    qWarning() << "read gvfs dir failed:" << dirPath << error->message;
+                    g_error_free(error);
+                }
+                finished = true;
+                break;
+            }
+
+            const DAbstractFileInfoPointer &fileInfo = createFileInfo(info);
+            if (fileInfo)
+                prefetchedInfos.enqueue(fileInfo);
+
+            g_object_unref(info);
+        }
+    }
+
+    DAbstractFileInfoPointer createFileInfo(GFileInfo *info) const
+    {
+        const QString &name = QFile::decodeName(g_file_info_get_name(info));
+        const GFileType type = g_file_info_get_file_type(info);
+        const bool isSymLink = g_file_info_get_is_symlink(info);
+        const bool isDir = type == G_FILE_TYPE_DIRECTORY;
+        const bool isFile = type == G_FILE_TYPE_REGULAR;
+
+        // 与QDirIterator在没有名称过滤时的规则一致
+        if (name.startsWith('.') && !filters.testFlag(QDir::Hidden))
+            return DAbstractFileInfoPointer();
+
+        if (!filters.testFlag(QDir::System) && !isDir && !isFile)
+            return DAbstractFileInfoPointer();
+
+        if (isDir && !(filters & (QDir::Dirs | QDir::AllDirs)))
+            return DAbstractFileInfoPointer();
+
+        if (isFile && !filters.testFlag(QDir::Files))
+            return DAbstractFileInfoPointer();
+
+        if (isSymLink && filters.testFlag(QDir::NoSymLinks))
+            return DAbstractFileInfoPointer();
+
+        const DUrl &url = DUrl::fromLocalFile(dirPath + "/" + name);
+
+        if (isFile && name.endsWith(".desktop", Qt::CaseInsensitive) && FileUtils::isDesktopFile(url.toLocalFile()))
+            return DAbstractFileInfoPointer(new DesktopFileInfo(url));
+
+        return DAbstractFileInfoPointer(new DGvfsFileInfo(url, info));
+    }
+
+    QString dirPath;
+    QDir::Filters filters;
+    GCancellable *cancellable = nullptr;
+    mutable GFileEnumerator *enumerator = nullptr;
+    mutable bool finished = false;
+
+    mutable QQueue<DAbstractFileInfoPointer> prefetchedInfos;
+    DAbstractFileInfoPointer currentInfo;
+};
+
 class FileDirIterator : public DDirIterator
 {
 public:
@@ -773,6 +1246,17 @@ DUrlList FileController::pasteFilesV2(const QSharedPointer<DFMPasteEvent> &event
 
     // sp3 feature： 复制时不进行校验，后面调整为独立的功能
     job->setFileHints(job->fileHints() | DFileCopyMoveJob::DontIntegrityChecking);
+    // 复制虚拟机镜像等稀疏文件时保留空洞，避免目标文件占满磁盘
+    job->setFileHints(job->fileHints() | DFileCopyMoveJob::SparseFile);
+    // 添加到光盘暂存区的文件尽量以硬链接暂存，刻录时直接读取源文件的数据，不需要额外的磁盘空间
+    if (action == DFMGlobal::CopyAction && target.burnIsOnLocalStaging())
+        job->setFileHints(job->fileHints() | DFileCopyMoveJob::LinkToDestination);
+    // 复制备份快照等包含大量硬链接的目录时，互为硬链接的文件只复制一次
+    if (action == DFMGlobal::CopyAction && DFMApplication::genericAttribute(DFMApplication::GA_CopyPreserveHardLinks).toBool())
+        job->setFileHints(job->fileHints() | DFileCopyMoveJob::PreserveHardLinks);
+    // 替换网络目录或者移动设备中的虚拟机镜像等大文件时只写入修改过的数据块
+    if (action == DFMGlobal::CopyAction && DFMApplication::genericAttribute(DFMApplication::GA_CopyDeltaTransfer).toBool())
+        job->setFileHints(job->fileHints() | DFileCopyMoveJob::DeltaTransfer);
     if (action == DFMGlobal::DeleteAction) {
         // for remove mode
         job->setActionOfErrorType(DFileCopyMoveJob::NonexistenceError, DFileCopyMoveJob::SkipAction);
@@ -923,6 +1407,24 @@ DUrlList FileController::pasteFilesV2(const QSharedPointer<DFMPasteEvent> &event
         mode = DFileCopyMoveJob::UnknowMode;
     }
     job->setMode(mode);
+    // 拷贝到网络目录时记录拷贝日志，网络中断后再次拷贝可以跳过已经完成的文件并续传未完成的文件
+    if (mode == DFileCopyMoveJob::CopyMode && FileUtils::isGvfsMountFile(target.toLocalFile())) {
+        job->setJournalFile(DFileCopyMoveJob::defaultJournalFile(list, target));
+    }
+    // 拷贝后校验目标文件，默认不开启
+    if (mode == DFileCopyMoveJob::CopyMode) {
+        const int verifyMode = DFMApplication::genericAttribute(DFMApplication::GA_CopyVerifyMode).toInt();
+        if (verifyMode > DFileCopyMoveJob::NoVerify && verifyMode <= DFileCopyMoveJob::Sha256Verify)
+            job->setVerifyMode(static_cast<DFileCopyMoveJob::VerifyMode>(verifyMode));
+        // 合并到已存在的目录时跳过没有变化的文件
+        const int identicalFilePolicy = DFMApplication::genericAttribute(DFMApplication::GA_CopyIdenticalFilePolicy).toInt();
+        if (identicalFilePolicy > DFileCopyMoveJob::NoSkipIdentical && identicalFilePolicy <= DFileCopyMoveJob::SkipSameContent)
+            job->setIdenticalFilePolicy(static_cast<DFileCopyMoveJob::IdenticalFilePolicy>(identicalFilePolicy));
+    }
+    // 大量拷贝时丢弃页缓存，避免其它程序的缓存被挤出内存
+    const int pageCachePolicy = DFMApplication::genericAttribute(DFMApplication::GA_CopyPageCachePolicy).toInt();
+    if (pageCachePolicy > DFileCopyMoveJob::AutoPageCache && pageCachePolicy <= DFileCopyMoveJob::DropPageCache)
+        job->setPageCachePolicy(static_cast<DFileCopyMoveJob::PageCachePolicy>(pageCachePolicy));
 
     job->start(list, target);
     //走以前的老流程，阻塞主线去拷贝或者删除
@@ -1570,6 +2072,12 @@ FileDirIterator::FileDirIterator(const QString &path, const QStringList &nameFil
 
     if (sort_inode) {
         iterator = new DFMSortInodeDirIterator(path);
+#ifdef SYS_getdents64
+    } else if (DFMLocalDirIterator::isSupported(path, nameFilters, filter, flags, gvfs)) {
+        iterator = new DFMLocalDirIterator(path, filter);
+#endif
+    } else if (DFMGvfsDirIterator::isSupported(path, nameFilters, filter, flags, gvfs)) {
+        iterator = new DFMGvfsDirIterator(path, filter);
     } else {
         iterator = new DFMQDirIterator(path, nameFilters, filter, flags, gvfs);
     }
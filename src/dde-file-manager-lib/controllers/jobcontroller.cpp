@@ -4,6 +4,8 @@
 
 #include "jobcontroller.h"
 #include "dfileservices.h"
+#include "dfmtrace.h"
+#include "io/ddeviceaccessscheduler.h"
 
 #include <QtConcurrent/QtConcurrent>
 
@@ -123,6 +125,7 @@ void JobController::setCountCeiling(int countCeiling)
 
 void JobController::run()
 {
+    DFM_TRACE_SPAN("listing", "JobController::run");
     m_updateFinished = false;
     if (!m_iterator) {
         const auto &&list = DFileService::instance()->getChildren(this, m_fileUrl, m_nameFilters, m_filters, QDirIterator::NoIteratorFlags, m_silent);
@@ -136,7 +139,40 @@ void JobController::run()
         return;
     }
 
-    QQueue<DAbstractFileInfoPointer> fileInfoQueue;
+    // MTP 设备上的请求是串行处理的，同一目录同时只遍历一次，并且遍历时拷贝、缩略图让出设备
+    DDeviceAccessScheduler *scheduler = DDeviceAccessScheduler::instance();
+    const QString &device = DDeviceAccessScheduler::deviceOf(m_fileUrl.toLocalFile());
+    const QString &listingKey = m_fileUrl.toLocalFile() + QLatin1Char('\n') + QString::number(static_cast<int>(m_filters))
+            + QLatin1Char('\n') + m_nameFilters.join(QLatin1Char('\n'));
+    DDeviceAccessScheduler::ListingPointer sharedListing;
+
+    if (!device.isEmpty()) {
+        bool owner = false;
+        sharedListing = scheduler->joinListing(listingKey, &owner);
+
+        if (!owner) {
+            while (m_state != Stoped && !scheduler->waitListing(sharedListing, LOAD_FILE_INTERVAL * 2)) {}
+
+            if (m_state != Stoped && sharedListing->complete) {
+                m_updateFinished = true;
+                emit addChildren(QList<DAbstractFileInfoPointer>(), true);
+                emit childrenUpdated(sharedListing->infoList);
+                emit addChildrenList(sharedListing->infoList);
+                setState(Stoped);
+
+                return;
+            }
+
+            // 其它请求的遍历被中止时自己遍历
+            sharedListing.clear();
+        }
+
+        scheduler->begin(device, DDeviceAccessScheduler::ListingPriority);
+    }
+
+    QList<DAbstractFileInfoPointer> fileInfoQueue;
+    // 按url去重，不必为每个文件遍历一次待发送的列表
+    QSet<DUrl> fileUrlSet;
 
     if (!timer)
         timer = new QElapsedTimer();
@@ -166,53 +202,72 @@ void JobController::run()
 
         DAbstractFileInfoPointer fileinfo;
         fileinfo = m_iterator->fileInfo();
+        if (!fileinfo)
+            continue;
+
         /*fix bug 49039 解决多次调用m_iterator->hasNext导致有重复结果，这里去重*/
-        if (!fileinfo || fileInfoQueue.contains(fileinfo))
+        const int urlCount = fileUrlSet.size();
+        fileUrlSet.insert(fileinfo->fileUrl());
+        if (fileUrlSet.size() == urlCount)
             continue;
 
-        if (update_children) {
-            fileInfoQueue.enqueue(fileinfo);
+        fileInfoQueue.append(fileinfo);
+
+        if (sharedListing)
+            sharedListing->infoList.append(fileinfo);
 
-            if (timer->elapsed() > m_timeCeiling || fileInfoQueue.count() > m_countCeiling) {
+        if (timer->elapsed() > m_timeCeiling || fileInfoQueue.count() > m_countCeiling) {
+            DFM_TRACE_COUNTER("listing", "batchSize", fileInfoQueue.count());
+            if (update_children) {
                 update_children = false;
                 emit childrenUpdated(fileInfoQueue);
-                emit addChildrenList(fileInfoQueue);
-
-                fileInfoQueue.clear();
-            }
-        } else {
-            fileInfoQueue.enqueue(fileinfo);
-
-            if (timer->elapsed() > m_timeCeiling || fileInfoQueue.count() > m_countCeiling) {
+            } else {
                 timer->restart();
-
-                emit addChildrenList(fileInfoQueue);
-
-                fileInfoQueue.clear();
+                emit addChildren(fileInfoQueue);
             }
 
-            emit addChildren(fileinfo);
+            emit addChildrenList(fileInfoQueue);
 
+            // 发送后不再持有列表，接收方持有的是唯一的引用，后续不会发生拷贝
+            fileInfoQueue = QList<DAbstractFileInfoPointer>();
         }
     }
     //刷新已完成
     m_updateFinished = true;
 
-    if (m_state != Stoped)
-        emit addChildren(DAbstractFileInfoPointer(nullptr), true);
+    if (sharedListing)
+        scheduler->finishListing(listingKey, sharedListing, m_state != Stoped);
+
+    scheduler->end(device, DDeviceAccessScheduler::ListingPriority);
 
     if (timer) {
         delete timer;
         timer = Q_NULLPTR;
     }
+
     if (update_children) {
+        if (m_state != Stoped)
+            emit addChildren(QList<DAbstractFileInfoPointer>(), true);
+
         emit childrenUpdated(fileInfoQueue);
         emit addChildrenList(fileInfoQueue);
+    } else {
+        if (!fileInfoQueue.isEmpty() || m_state != Stoped)
+            emit addChildren(fileInfoQueue, m_state != Stoped);
+
+        if (!fileInfoQueue.isEmpty())
+            emit addChildrenList(fileInfoQueue);
     }
 
     setState(Stoped);
 }
 
+void JobController::setFilters(const QStringList &nameFilters, QDir::Filters filters)
+{
+    m_nameFilters = nameFilters;
+    m_filters = filters;
+}
+
 void JobController::setState(JobController::State state)
 {
     if (m_state == state)
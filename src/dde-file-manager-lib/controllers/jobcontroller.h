@@ -42,6 +42,8 @@ public:
     int timeCeiling() const;
     int countCeiling() const;
     inline bool isUpdatedFinished() const {return m_updateFinished;}
+    // 遍历使用的过滤条件，MTP 设备上条件相同的重复遍历会合并为一次
+    void setFilters(const QStringList &nameFilters, QDir::Filters filters);
 public slots:
     void start();
     void pause();
@@ -53,7 +55,8 @@ public slots:
 
 signals:
     void stateChanged(State state);
-    void addChildren(const DAbstractFileInfoPointer info, const bool isEnd = false);
+    // 首次刷新之后的文件按批发送，isEnd为true时表示遍历已结束
+    void addChildren(const QList<DAbstractFileInfoPointer> &infoList, const bool isEnd = false);
     void addChildrenList(const QList<DAbstractFileInfoPointer> &infoList);
     void childrenUpdated(const QList<DAbstractFileInfoPointer> &list);
 
@@ -6,6 +6,7 @@
 #include "mergeddesktopcontroller_p.h"
 
 #include "dfilewatcher.h"
+#include "dfanotifywatcher.h"
 #include "dfileservices.h"
 #include "appcontroller.h"
 
@@ -17,8 +18,21 @@
 #include "shutil/dfmfilelistfile.h"
 
 #include <QList>
+#include <QSet>
 #include <QStandardPaths>
 
+#include <algorithm>
+
+//! 分类中的文件保持与 initData 相同的文件名顺序
+static void insertArrangedUrl(QList<DUrl> &urls, const DUrl &url)
+{
+    const QString &fileName = url.fileName();
+    auto pos = std::upper_bound(urls.begin(), urls.end(), fileName, [](const QString &name, const DUrl &other) {
+        return FileSortFunction::compareByString(name, other.fileName());
+    });
+    urls.insert(pos, url);
+}
+
 MergedDesktopWatcher::MergedDesktopWatcher(const DUrl &url, DAbstractFileWatcher *baseWatcher, QObject *parent)
     : DAbstractFileWatcher(*new MergedDesktopWatcherPrivate(this), url, parent)
 {
@@ -95,6 +109,9 @@ MergedDesktopController::MergedDesktopController(QObject *parent)
     : DAbstractFileController(parent),
       m_desktopFileWatcher(new DFileWatcher(QStandardPaths::standardLocations(QStandardPaths::DesktopLocation).first(), this))
 {
+    // 整理桌面为每个桌面文件都建立 watcher，fanotify 可用时由一个目录树监视代替逐个文件的 inotify 监视
+    DFanotifyWatcher::instance()->addSubtree(QStandardPaths::standardLocations(QStandardPaths::DesktopLocation).first());
+
     connect(m_desktopFileWatcher, &DFileWatcher::fileDeleted, this, &MergedDesktopController::desktopFilesRemoved);
     connect(m_desktopFileWatcher, &DFileWatcher::subfileCreated, this, &MergedDesktopController::desktopFilesCreated);
     connect(m_desktopFileWatcher, &DFileWatcher::fileMoved, this, &MergedDesktopController::desktopFilesRenamed);
@@ -108,11 +125,8 @@ const DAbstractFileInfoPointer MergedDesktopController::createFileInfo(const QSh
 
 const QList<DAbstractFileInfoPointer> MergedDesktopController::getChildren(const QSharedPointer<DFMGetChildrensEvent> &event) const
 {
-//    if (!dataInitialized) {
-//        initData();
-//        dataInitialized = true;
-//    }
     // blumia: 文件监听占用完了的时候有可能桌面会监听不到文件变动,此时即便 F5 也不会刷新该 Controller 存储的整理桌面数据,故改为每次都重新初始化整理数据
+    // 每次仍与桌面目录比对，但只对新增的文件判断类型，已分类的文件不再重新读取 mime
 
     //加锁失败，说明有线程在跑后面的算法
     if (!m_runMtx.tryLock(0)){
@@ -125,7 +139,7 @@ const QList<DAbstractFileInfoPointer> MergedDesktopController::getChildren(const
 
     QMutexLocker aful(&m_arrangedFileUrlsMtx); //禁止其他线程修改arrangedFileUrls
 
-    arrangedFileUrls = initData(event->filters());
+    updateArrangedFileUrls(event->filters());
     currentUrl = event->url();
     QString path { currentUrl.path() };
     QList<DAbstractFileInfoPointer> infoList;
@@ -445,7 +459,7 @@ void MergedDesktopController::desktopFilesCreated(const DUrl &url)
         return; //不return会崩溃，不知道为什么 todo
 //        arrangedFileUrls[typeInfo].removeAll(url);//return后不执行，导致警告屏蔽之
     }
-    arrangedFileUrls[typeInfo].append(url);
+    insertArrangedUrl(arrangedFileUrls[typeInfo], url);
     aful.unlock();
 
     DUrl vUrl = convertToDFMMDPath(url, typeInfo);
@@ -491,7 +505,7 @@ MergedDesktopController::desktopFilesRenamed(const DUrl &oriUrl, const DUrl &dst
     }
 
     DMD_TYPES typeInfo = checkUrlArrangedType(dstUrl);
-    arrangedFileUrls[typeInfo].append(dstUrl);
+    insertArrangedUrl(arrangedFileUrls[typeInfo], dstUrl);
     aful.unlock();
 
     DUrl vOriUrl = convertToDFMMDPath(oriUrl, orgTypeInfo);
@@ -508,6 +522,18 @@ QMap<DMD_TYPES, QList<DUrl> > MergedDesktopController::initData(QDir::Filters ft
     QMap<DMD_TYPES, QList<DUrl> > tArrangedFileUrls;
 
     QDir desktopDir(QStandardPaths::standardLocations(QStandardPaths::DesktopLocation).first());
+    for (const QString &oneFile : desktopFileNames(ftrs)) {
+        DUrl oneUrl = DUrl::fromLocalFile(desktopDir.filePath(oneFile));
+        DMD_TYPES typeInfo = checkUrlArrangedType(oneUrl);
+        tArrangedFileUrls[typeInfo].append(oneUrl);
+    }
+
+    return tArrangedFileUrls;
+}
+
+QStringList MergedDesktopController::desktopFileNames(QDir::Filters ftrs)
+{
+    QDir desktopDir(QStandardPaths::standardLocations(QStandardPaths::DesktopLocation).first());
 #if 0
     const QStringList &fileList = desktopDir.entryList(QDir::AllEntries | QDir::NoDotAndDotDot);
 #else
@@ -523,18 +549,57 @@ QMap<DMD_TYPES, QList<DUrl> > MergedDesktopController::initData(QDir::Filters ft
 
     //解决自动整理时的文件隐藏显示问题
     bool showHidden = ftrs.testFlag(QDir::Hidden);
-    DFMFileListFile hiddenFiles(QStandardPaths::standardLocations(QStandardPaths::DesktopLocation).first());
+    if (!showHidden) {
+        DFMFileListFile hiddenFiles(desktopDir.absolutePath());
+        for (auto it = fileList.begin(); it != fileList.end();) {
+            if (hiddenFiles.contains(*it))
+                it = fileList.erase(it);
+            else
+                ++it;
+        }
+    }
 
-    for (const QString &oneFile : fileList) {
-        if (!showHidden && hiddenFiles.contains(oneFile)){
-            continue;
+    return fileList;
+}
+
+void MergedDesktopController::updateArrangedFileUrls(QDir::Filters ftrs) const
+{
+    // 首次或过滤条件变化时全部重新分类
+    if (!dataInitialized || arrangedFilters != ftrs) {
+        arrangedFileUrls = initData(ftrs);
+        arrangedFilters = ftrs;
+        dataInitialized = true;
+        return;
+    }
+
+    QDir desktopDir(QStandardPaths::standardLocations(QStandardPaths::DesktopLocation).first());
+    const QStringList &fileList = desktopFileNames(ftrs);
+    QSet<DUrl> existed;
+    for (const QString &oneFile : fileList)
+        existed << DUrl::fromLocalFile(desktopDir.filePath(oneFile));
+
+    // 移除监视遗漏的已删除文件
+    QSet<DUrl> arranged;
+    for (auto it = arrangedFileUrls.begin(); it != arrangedFileUrls.end(); ++it) {
+        QList<DUrl> &urls = it.value();
+        for (auto url = urls.begin(); url != urls.end();) {
+            if (existed.contains(*url) && !arranged.contains(*url)) {
+                arranged << *url;
+                ++url;
+            } else {
+                url = urls.erase(url);
+            }
         }
-        DUrl oneUrl = DUrl::fromLocalFile(desktopDir.filePath(oneFile));
-        DMD_TYPES typeInfo = checkUrlArrangedType(oneUrl);
-        tArrangedFileUrls[typeInfo].append(oneUrl);
     }
 
-    return tArrangedFileUrls;
+    // 只对新增的文件判断类型，按文件名的顺序插入到所属的分类中
+    for (const QString &oneFile : fileList) {
+        DUrl oneUrl = DUrl::fromLocalFile(desktopDir.filePath(oneFile));
+        if (arranged.contains(oneUrl))
+            continue;
+
+        insertArrangedUrl(arrangedFileUrls[checkUrlArrangedType(oneUrl)], oneUrl);
+    }
 }
 
 //为了防止自动整理下剪切与分类名相同的文件夹，这里创建虚拟的分类路径做对比
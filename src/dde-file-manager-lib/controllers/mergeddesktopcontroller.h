@@ -62,6 +62,7 @@ public:
     static DUrlList convertToRealPaths(DUrlList urlList);
     static DMD_TYPES checkUrlArrangedType(const DUrl url);
     static QMap<DMD_TYPES, QList<DUrl> > initData(QDir::Filters ftrs);
+    static QStringList desktopFileNames(QDir::Filters ftrs);
     //为了防止自动整理下剪切与分类名相同的文件夹，这里创建虚拟的分类路径做对比
     static bool isVirtualEntryPaths(const DUrl &oneUrl);
 
@@ -72,10 +73,13 @@ public slots:
 
 private:
     //void appendEntryFiles(QList<DAbstractFileInfoPointer> &infoList, const DMD_TYPES &entryType) const;
+    void updateArrangedFileUrls(QDir::Filters ftrs) const;
 
     DFileWatcher* m_desktopFileWatcher;
     mutable DUrl currentUrl;
-//    mutable bool dataInitialized = false;
+    //! 分类结果按文件保留，由监视事件和每次 getChildren 时与桌面目录的比对增量更新
+    mutable bool dataInitialized = false;
+    mutable QDir::Filters arrangedFilters;
     mutable QMap<DMD_TYPES, QList<DUrl> > arrangedFileUrls;
     mutable QMutex m_arrangedFileUrlsMtx; //多线程访问arrangedFileUrls 的锁
 
@@ -42,6 +42,9 @@ public:
         fetchNetworksMutex->lock();
         if (!m_silence && NetworkManager::NetworkNodes.value(m_url).isEmpty()) {
             Singleton<NetworkManager>::instance()->fetchNetworks(DFMUrlBaseEvent(m_sender.data(), m_url));
+        } else if (!m_silence) {
+            // 先显示缓存的列表
+            NetworkManager::refreshNetworksIfExpired(m_url);
         }
         fetchNetworksMutex->unlock();
 
@@ -8,8 +8,22 @@
 #include "dbusinterface/revocationmgr_interface.h"
 #include "vaultcontroller.h"
 #include <QDBusConnection>
+#include <QTemporaryFile>
 #include <unistd.h>
 
+// 文件数达到此值时压缩保存撤销事件的文件列表
+static const int kCompactUrlCount = 100;
+// 压缩后的文件列表超过此大小时保存到磁盘中
+static const qint64 kJournalSize = 8 * 1024 * 1024;
+// 撤销栈占用的内存上限，超出时删除最早的操作
+static const qint64 kMemoryLimit = 32 * 1024 * 1024;
+// 未压缩时每个文件的 DUrl 大约占用的内存
+static const qint64 kUrlMemoryCost = 256;
+
+#define REVOCATION_PARENT_PROPERTY "_dfm_revocation_parent"
+#define REVOCATION_NAMES_PROPERTY "_dfm_revocation_names"
+#define REVOCATION_JOURNAL_PROPERTY "_dfm_revocation_journal"
+
 DFM_BEGIN_NAMESPACE
 
 class OperatorRevocationPrivate : public OperatorRevocation
@@ -37,7 +51,16 @@ bool OperatorRevocation::fmEvent(const QSharedPointer<DFMEvent> &event, QVariant
             if (REVOCATION_TIMES == operatorStack.count()) {
                 operatorStack.pop_front();
             }
-            operatorStack.push(*event.data());
+            operatorStack.push(compactEvent(*e));
+
+            qint64 memorySize = 0;
+            for (const DFMEvent &saved : operatorStack)
+                memorySize += eventMemorySize(saved);
+
+            while (operatorStack.count() > 1 && memorySize > kMemoryLimit) {
+                memorySize -= eventMemorySize(operatorStack.first());
+                operatorStack.pop_front();
+            }
         }
         pushEvent();
         return true;
@@ -130,7 +153,8 @@ bool OperatorRevocation::revocation()
     if (operatorStack.isEmpty())
         return true;
 
-    DFMSaveOperatorEvent e = dfmevent_cast<DFMSaveOperatorEvent>(operatorStack.pop());
+    const DFMEvent saved = operatorStack.pop();
+    DFMSaveOperatorEvent e = dfmevent_cast<DFMSaveOperatorEvent>(saved);
     lk.unlock();
 
     if (e.split()) {
@@ -145,6 +169,7 @@ bool OperatorRevocation::revocation()
     const QSharedPointer<DFMEvent> new_event = e.event();
 
     new_event->setProperty("_dfm_is_revocaion_event", true);
+    expandEvent(saved, new_event);
 
     //! 保险箱文件处理撤销事件，如果路径是保险箱路径但scheme是非保险箱的，需要重新设置scheme为DFMVAULT_SCHEME
     DUrlList urlList = new_event.data()->fileUrlList();
@@ -219,5 +244,126 @@ QString OperatorRevocation::getProcessOwner()
 }
 
 
+DFMEvent OperatorRevocation::compactEvent(const DFMSaveOperatorEvent &event) const
+{
+    if (event.split())
+        return event;
+
+    const QSharedPointer<DFMEvent> &operatorEvent = event.event();
+    // 发起操作的事件只在入栈前判断是否为撤销事件，不再保存它的文件列表
+    DFMSaveOperatorEvent saved(QSharedPointer<DFMEvent>(), operatorEvent, event.async());
+
+    if (!operatorEvent)
+        return saved;
+
+    const DUrlList &urls = qvariant_cast<DUrlList>(operatorEvent->data());
+
+    if (urls.count() < kCompactUrlCount)
+        return saved;
+
+    QString parent;
+
+    for (const DUrl &url : urls) {
+        if (!url.isLocalFile())
+            return saved;
+
+        const QString &path = url.toLocalFile();
+
+        if (parent.isNull()) {
+            parent = path.left(path.lastIndexOf('/') + 1);
+            continue;
+        }
+
+        while (!path.startsWith(parent))
+            parent = parent.left(parent.lastIndexOf('/', -2) + 1);
+    }
+
+    // 相对路径以'\0'分隔，按文件名的编码保存
+    QByteArray names;
+
+    for (const DUrl &url : urls) {
+        names.append(QFile::encodeName(url.toLocalFile().mid(parent.size())));
+        names.append('\0');
+    }
+
+    saved.setProperty(REVOCATION_PARENT_PROPERTY, parent);
+
+    QSharedPointer<QTemporaryFile> journal;
+
+    if (names.size() > kJournalSize) {
+        journal.reset(new QTemporaryFile());
+
+        if (!journal->open() || journal->write(names) != names.size() || !journal->flush())
+            journal.clear();
+    }
+
+    if (journal)
+        saved.setProperty(REVOCATION_JOURNAL_PROPERTY, QVariant::fromValue(journal));
+    else
+        saved.setProperty(REVOCATION_NAMES_PROPERTY, names);
+
+    operatorEvent->setData(DUrlList());
+
+    return saved;
+}
+
+void OperatorRevocation::expandEvent(const DFMEvent &saved, const QSharedPointer<DFMEvent> &event) const
+{
+    const QVariant &parent = saved.property(REVOCATION_PARENT_PROPERTY);
+
+    if (!parent.isValid() || !event)
+        return;
+
+    const QSharedPointer<QTemporaryFile> &journal = qvariant_cast<QSharedPointer<QTemporaryFile>>(saved.property(REVOCATION_JOURNAL_PROPERTY));
+    QByteArray names;
+    uchar *mapped = nullptr;
+
+    if (journal) {
+        mapped = journal->map(0, journal->size());
+
+        if (!mapped) {
+            qWarning() << "failed to map the revocation journal:" << journal->errorString();
+            return;
+        }
+
+        names = QByteArray::fromRawData(reinterpret_cast<const char *>(mapped), static_cast<int>(journal->size()));
+    } else {
+        names = saved.property(REVOCATION_NAMES_PROPERTY).toByteArray();
+    }
+
+    const QString &parentPath = parent.toString();
+    DUrlList urls;
+    int begin = 0;
+
+    urls.reserve(names.count('\0'));
+
+    while (begin < names.size()) {
+        int end = names.indexOf('\0', begin);
+
+        if (end < 0)
+            end = names.size();
+
+        urls << DUrl::fromLocalFile(parentPath + QFile::decodeName(names.mid(begin, end - begin)));
+        begin = end + 1;
+    }
+
+    if (mapped)
+        journal->unmap(mapped);
+
+    event->setData(urls);
+}
+
+qint64 OperatorRevocation::eventMemorySize(const DFMEvent &saved)
+{
+    if (saved.property(REVOCATION_JOURNAL_PROPERTY).isValid())
+        return 0;
+
+    if (saved.property(REVOCATION_PARENT_PROPERTY).isValid())
+        return saved.property(REVOCATION_NAMES_PROPERTY).toByteArray().size();
+
+    const QSharedPointer<DFMEvent> &event = dfmevent_cast<DFMSaveOperatorEvent>(saved).event();
+
+    return event ? qvariant_cast<DUrlList>(event->data()).count() * kUrlMemoryCost : 0;
+}
 
 DFM_END_NAMESPACE
@@ -76,6 +76,23 @@ private:
      * @return  当前程序启动的的系统用户名
      */
     QString getProcessOwner();
+
+    /**
+     * @brief compactEvent 生成保存到撤销栈中的事件，文件较多时只保存共同的父目录和相对路径，
+     * 文件列表很大时保存到磁盘上的临时文件中
+     * @return 保存到撤销栈中的事件
+     */
+    DFMEvent compactEvent(const DFMSaveOperatorEvent &event) const;
+
+    /**
+     * @brief expandEvent 从撤销栈中的事件恢复撤销事件的文件列表
+     */
+    void expandEvent(const DFMEvent &saved, const QSharedPointer<DFMEvent> &event) const;
+
+    /**
+     * @brief eventMemorySize 估算撤销栈中的事件占用的内存
+     */
+    static qint64 eventMemorySize(const DFMEvent &saved);
 private:
     QStack<DFMEvent> operatorStack;
     QMutex m_mtx;
@@ -5,6 +5,7 @@
 #include "recentcontroller.h"
 #include "dfileservices.h"
 #include "dfilewatcher.h"
+#include "dfanotifywatcher.h"
 #include "dfmevent.h"
 #include "dfmglobal.h"
 #include "private/dabstractfilewatcher_p.h"
@@ -21,14 +22,27 @@
 #include <QtConcurrent>
 #include <QQueue>
 #include <QTimer>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QThreadPool>
 #include <QDebug>
 
 #include <DRecentManager>
 #include <DDialog>
 
+#include <sys/stat.h>
+
 DCORE_USE_NAMESPACE
 DWIDGET_USE_NAMESPACE
 
+//! xbel 变化后等待更多变化的时间（ms）
+#define RECENT_CHANGE_DELAY 300
+//! 检查每个挂载点中的文件是否存在的超时时间（ms）
+#define RECENT_CHECK_TIMEOUT 2000
+
+//! 访问可能无响应的挂载点时可能长时间阻塞，不占用全局线程池
+Q_GLOBAL_STATIC(QThreadPool, recentCheckThreadPool)
+
 class RecentFileWatcherPrivate;
 class RecentFileWatcher : public DAbstractFileWatcher
 {
@@ -46,6 +60,13 @@ private:
     void onFileModified(const DUrl &url);
     void onFileMoved(const DUrl &from, const DUrl &to);
 
+    // 目录 watcher 的事件，只分发给最近使用中的文件
+    void onDirectoryFileDeleted(const DUrl &url);
+    void onDirectoryFileAttributeChanged(const DUrl &url);
+    void onDirectoryFileModified(const DUrl &url);
+    void onDirectoryFileMoved(const DUrl &from, const DUrl &to);
+    void removeWatchersInDirectory(const QString &dirPath);
+
 public slots:
     void removeRecentFile(const QString &path);
 
@@ -58,6 +79,18 @@ public:
     explicit RecentFileWatcherPrivate(DAbstractFileWatcher *qq)
         : DAbstractFileWatcherPrivate(qq) {}
 
+    ~RecentFileWatcherPrivate() override
+    {
+        DFanotifyWatcher *subtreeWatcher = DFanotifyWatcher::instance();
+        if (!subtreeWatcher)
+            return;
+
+        for (auto it = dirWatchers.constBegin(); it != dirWatchers.constEnd(); ++it) {
+            if (it->subtreeAdded)
+                subtreeWatcher->removeSubtree(it.key());
+        }
+    }
+
     bool start() override
     {
         started = true;
@@ -72,7 +105,22 @@ public:
         return proxy && proxy->stopWatcher();
     }
 
+    //! 同一目录中的最近使用文件共用该目录的 watcher
+    struct DirWatcher
+    {
+        DAbstractFileWatcher *watcher = nullptr;
+        int refCount = 0;
+        bool subtreeAdded = false;   // 通过 DFanotifyWatcher 监视
+    };
+
+    static QString parentPath(const DUrl &url)
+    {
+        return url.parentUrl().path();
+    }
+
+    //! 最近使用的文件及其所在目录的 watcher
     QMap<DUrl, DAbstractFileWatcher *> urlToWatcherMap;
+    QHash<QString, DirWatcher> dirWatchers;
     QPointer<DAbstractFileWatcher> proxy;
 
     Q_DECLARE_PUBLIC(RecentFileWatcher)
@@ -120,27 +168,41 @@ void RecentFileWatcher::addWatcher(const DUrl &url)
     if (DFileService::instance()->checkGvfsMountfileBusy(url,false))
         return;
 
-    DUrl real_url = url;
-    real_url.setScheme(FILE_SCHEME);
+    const QString &dirPath = RecentFileWatcherPrivate::parentPath(url);
+    auto it = d->dirWatchers.find(dirPath);
 
-    DAbstractFileWatcher *watcher = DFileService::instance()->createFileWatcher(this, real_url);
+    if (it == d->dirWatchers.end()) {
+        // 最近使用的文件分散在各处，fanotify 可用时按所在目录监视，同一文件系统只需一个标记
+        const bool subtreeAdded = DFanotifyWatcher::instance()->addSubtree(dirPath);
 
-    if (!watcher)
-        return;
+        DAbstractFileWatcher *watcher = DFileService::instance()->createFileWatcher(this, DUrl::fromLocalFile(dirPath));
+
+        if (!watcher) {
+            if (subtreeAdded)
+                DFanotifyWatcher::instance()->removeSubtree(dirPath);
+            return;
+        }
 
-    watcher->moveToThread(this->thread());
-    watcher->setParent(this);
+        watcher->moveToThread(this->thread());
+        watcher->setParent(this);
 
-    connect(watcher, &DAbstractFileWatcher::fileAttributeChanged, this, &RecentFileWatcher::onFileAttributeChanged);
-    connect(watcher, &DAbstractFileWatcher::fileDeleted, this, &RecentFileWatcher::onFileDeleted);
-    connect(watcher, &DAbstractFileWatcher::fileModified, this, &RecentFileWatcher::onFileModified);
-    connect(watcher, &DAbstractFileWatcher::fileMoved, this, &RecentFileWatcher::onFileMoved);
+        connect(watcher, &DAbstractFileWatcher::fileAttributeChanged, this, &RecentFileWatcher::onDirectoryFileAttributeChanged);
+        connect(watcher, &DAbstractFileWatcher::fileDeleted, this, &RecentFileWatcher::onDirectoryFileDeleted);
+        connect(watcher, &DAbstractFileWatcher::fileModified, this, &RecentFileWatcher::onDirectoryFileModified);
+        connect(watcher, &DAbstractFileWatcher::fileMoved, this, &RecentFileWatcher::onDirectoryFileMoved);
 
-    d->urlToWatcherMap[url] = watcher;
+        RecentFileWatcherPrivate::DirWatcher dirWatcher;
+        dirWatcher.watcher = watcher;
+        dirWatcher.subtreeAdded = subtreeAdded;
+        it = d->dirWatchers.insert(dirPath, dirWatcher);
 
-    if (d->started) {
-        watcher->startWatcher();
+        if (d->started) {
+            watcher->startWatcher();
+        }
     }
+
+    ++it->refCount;
+    d->urlToWatcherMap[url] = it->watcher;
 }
 
 void RecentFileWatcher::removeWatcher(const DUrl &url)
@@ -153,7 +215,17 @@ void RecentFileWatcher::removeWatcher(const DUrl &url)
         return;
     }
 
-    watcher->deleteLater();
+    const QString &dirPath = RecentFileWatcherPrivate::parentPath(url);
+    auto it = d->dirWatchers.find(dirPath);
+
+    if (it == d->dirWatchers.end() || --it->refCount > 0)
+        return;
+
+    if (it->subtreeAdded)
+        DFanotifyWatcher::instance()->removeSubtree(dirPath);
+
+    it->watcher->deleteLater();
+    d->dirWatchers.erase(it);
 }
 
 void RecentFileWatcher::onFileDeleted(const DUrl &url)
@@ -189,6 +261,78 @@ void RecentFileWatcher::onFileMoved(const DUrl &from, const DUrl &to)
 
     emit fileMoved(newFromUrl, to);
 }
+void RecentFileWatcher::onDirectoryFileDeleted(const DUrl &url)
+{
+    Q_D(RecentFileWatcher);
+
+    DUrl recentUrl = url;
+    recentUrl.setScheme(RECENT_SCHEME);
+
+    if (d->urlToWatcherMap.contains(recentUrl)) {
+        onFileDeleted(url);
+        return;
+    }
+
+    // 监视的目录或其上级目录被删除
+    if (d->dirWatchers.contains(url.path()))
+        removeWatchersInDirectory(url.path());
+}
+
+void RecentFileWatcher::onDirectoryFileAttributeChanged(const DUrl &url)
+{
+    Q_D(RecentFileWatcher);
+
+    DUrl recentUrl = url;
+    recentUrl.setScheme(RECENT_SCHEME);
+
+    if (d->urlToWatcherMap.contains(recentUrl))
+        onFileAttributeChanged(url);
+}
+
+void RecentFileWatcher::onDirectoryFileModified(const DUrl &url)
+{
+    Q_D(RecentFileWatcher);
+
+    DUrl recentUrl = url;
+    recentUrl.setScheme(RECENT_SCHEME);
+
+    if (d->urlToWatcherMap.contains(recentUrl))
+        onFileModified(url);
+}
+
+void RecentFileWatcher::onDirectoryFileMoved(const DUrl &from, const DUrl &to)
+{
+    Q_D(RecentFileWatcher);
+
+    DUrl recentUrl = from;
+    recentUrl.setScheme(RECENT_SCHEME);
+
+    if (d->urlToWatcherMap.contains(recentUrl)) {
+        onFileMoved(from, to);
+        return;
+    }
+
+    // 监视的目录被移走，其中的文件不再存在于原来的位置
+    if (d->dirWatchers.contains(from.path()))
+        removeWatchersInDirectory(from.path());
+}
+
+void RecentFileWatcher::removeWatchersInDirectory(const QString &dirPath)
+{
+    Q_D(RecentFileWatcher);
+
+    const DUrlList &urls = d->urlToWatcherMap.keys();
+
+    for (const DUrl &url : urls) {
+        if (RecentFileWatcherPrivate::parentPath(url) != dirPath)
+            continue;
+
+        DUrl fileUrl = url;
+        fileUrl.setScheme(FILE_SCHEME);
+        onFileDeleted(fileUrl);
+    }
+}
+
 //fix bug 63922 移除父目录是path的url
 void RecentFileWatcher::removeRecentFile(const QString &path)
 {
@@ -290,9 +434,14 @@ DUrl RecentDirIterator::url() const
 RecentController::RecentController(QObject *parent)
     : DAbstractFileController(parent),
       m_xbelPath(QDir::homePath() + "/.local/share/recently-used.xbel"),
-      m_watcher(new DFileWatcher(m_xbelPath, this))
+      m_watcher(new DFileWatcher(m_xbelPath, this)),
+      m_changeTimer(new QTimer(this))
 {
-    asyncHandleFileChanged();
+    m_changeTimer->setSingleShot(true);
+    m_changeTimer->setInterval(RECENT_CHANGE_DELAY);
+    connect(m_changeTimer, &QTimer::timeout, this, &RecentController::startHandleFileChanged);
+
+    startHandleFileChanged();
 
     connect(m_watcher, &DFileWatcher::subfileCreated, this, &RecentController::asyncHandleFileChanged);
     connect(m_watcher, &DFileWatcher::fileModified, this, &RecentController::asyncHandleFileChanged);
@@ -549,110 +698,232 @@ DUrlList RecentController::realUrlList(const DUrlList &recentUrls)
     return list;
 }
 
-void RecentController::handleFileChanged()
+/*!
+ * \brief RecentController::checkFilesExist 按挂载点分组并行检查文件是否存在
+ *
+ * 未挂载或无响应的网络文件系统可能长时间阻塞 stat，超过 timeout 仍未完成的挂载点中的文件不在返回值中，
+ * 下次解析时再检查。上次的检查仍阻塞的挂载点直接跳过，避免占满线程。
+ */
+QHash<QString, bool> RecentController::checkFilesExist(const QStringList &paths, int timeout)
 {
-    // read xbel file.
-    QFile file(m_xbelPath);
-    QList<DUrl> urlList;
+    struct CheckState
+    {
+        QMutex mutex;
+        QHash<QString, bool> result;
+    };
+
+    static QMutex busyMountsMutex;
+    static QSet<QString> busyMounts;
+
+    // 只读取挂载表，不访问文件系统
+    QStringList mountPoints;
+    QFile mounts("/proc/self/mounts");
+    if (mounts.open(QIODevice::ReadOnly)) {
+        for (const QByteArray &line : mounts.readAll().split('\n')) {
+            const QList<QByteArray> &fields = line.split(' ');
+            if (fields.size() > 1)
+                mountPoints << QString::fromLocal8Bit(fields.at(1)).replace("\\040", " ");
+        }
+    }
 
-    // try interrupting any other running parsers, then acquire the lock
-    m_condition.wakeAll();
-    if (!m_xbelFileLock.tryLock(100)) {
-        return;
+    std::sort(mountPoints.begin(), mountPoints.end(), [](const QString &a, const QString &b) {
+        return a.size() > b.size();
+    });
+
+    QHash<QString, QStringList> groups;
+    for (const QString &path : paths) {
+        QString mountPoint("/");
+        for (const QString &mp : mountPoints) {
+            if (path == mp || path.startsWith(mp.endsWith('/') ? mp : mp + '/')) {
+                mountPoint = mp;
+                break;
+            }
+        }
+
+        groups[mountPoint] << path;
     }
 
-    QPointer<RecentController> dp = this;
+    QSharedPointer<CheckState> state(new CheckState);
+    QList<QFuture<void>> futures;
 
-    if (m_condition.wait(&m_xbelFileLock, 1000)) {
-        // if the parser is interrupted.
-        // we need a timeout long enough so that
-        // virtually all execution time is spent here.
-        m_xbelFileLock.unlock();
-        return;
+    for (auto it = groups.constBegin(); it != groups.constEnd(); ++it) {
+        const QString mountPoint = it.key();
+        const QStringList group = it.value();
+
+        QMutexLocker lk(&busyMountsMutex);
+        if (busyMounts.contains(mountPoint))
+            continue;
+
+        busyMounts.insert(mountPoint);
+        lk.unlock();
+
+        futures << QtConcurrent::run(recentCheckThreadPool, [state, mountPoint, group] {
+            for (const QString &path : group) {
+                struct stat st;
+                const bool exists = ::stat(QFile::encodeName(path).constData(), &st) == 0 && S_ISREG(st.st_mode);
+
+                QMutexLocker locker(&state->mutex);
+                state->result.insert(path, exists);
+            }
+
+            QMutexLocker lk(&busyMountsMutex);
+            busyMounts.remove(mountPoint);
+        });
     }
 
+    QElapsedTimer timer;
+    timer.start();
+
+    for (const QFuture<void> &future : futures) {
+        while (!future.isFinished() && timer.elapsed() < timeout)
+            QThread::msleep(5);
+    }
+
+    QMutexLocker locker(&state->mutex);
+    return state->result;
+}
+
+/*!
+ * \brief RecentController::handleFileChanged 解析 xbel 并与上次的结果比较，只检查新增或修改时间变化的记录
+ */
+void RecentController::handleFileChanged()
+{
+    QPointer<RecentController> dp = this;
+
+    // read xbel file. 文件不存在时所有记录都被移除
+    QList<QPair<QString, QString>> bookmarks;
+    QFile file(m_xbelPath);
+
     if (file.open(QIODevice::ReadOnly)) {
         QXmlStreamReader reader(&file);
-        m_bindPathMaps.clear();
 
         while (!reader.atEnd()) {
-
-            if (!reader.readNextStartElement() ||
-                    reader.name() != "bookmark") {
+            if (!reader.readNextStartElement() || reader.name() != "bookmark")
                 continue;
-            }
 
             const QStringRef &location = reader.attributes().value("href");
-            const QStringRef &readTime = reader.attributes().value("modified");
-
-            if (!location.isEmpty()) {
-                QString path = location.toString();
-                path = FileUtils::bindPathTransform(path);
-                DUrl url = DUrl(path);
-                QFileInfo info(url.toLocalFile());
-                DUrl recentUrl = url;
-                recentUrl.setScheme(RECENT_SCHEME);
-
-                if (info.exists() && info.isFile()) {
-                    urlList << recentUrl;
-                    if (path != location.toString())
-                        m_bindPathMaps.insert(info.filePath(), location.toString());
-
-                    DThreadUtil::runInMainThread([ = ]() {
-                        if (dp.isNull())
-                            return;
-                        // 保险箱内文件不显示到最近使用页面
-                        if(!VaultController::isVaultFile(location.toString())) {
-                            if (!recentNodes.contains(recentUrl)) {
-                                recentNodes[recentUrl] = new RecentFileInfo(recentUrl);
-                                DAbstractFileWatcher::ghostSignal(DUrl(RECENT_ROOT),
-                                                                  &DAbstractFileWatcher::subfileCreated,
-                                                                  recentUrl);
-                            }
-                            //如果readtime变更了，需要通知filesystemmodel重新排序
-                            else if (recentNodes[recentUrl]->readDateTime().toSecsSinceEpoch() != QDateTime::fromString(readTime.toString(), Qt::ISODate).toSecsSinceEpoch()) {
-                                //先更新info数据
-                                recentNodes[recentUrl]->updateInfo();
-                                DAbstractFileWatcher::ghostSignal(DUrl(RECENT_ROOT),
-                                                                  &DAbstractFileWatcher::fileModified,
-                                                                  recentUrl);
-                            }
-                        }
-                    });
-                }
-            }
+            if (!location.isEmpty())
+                bookmarks << qMakePair(location.toString(), reader.attributes().value("modified").toString());
         }
     }
 
-    if (dp.isNull())
-        return;
-    // delete does not exist url.
-    for (auto iter = recentNodes.begin(); iter != recentNodes.end();) {
+    const QHash<QString, XbelEntry> oldEntries = m_xbelEntries;
+    QHash<QString, XbelEntry> entries;
+    QStringList checkHrefs;
+    QStringList checkPaths;
+
+    entries.reserve(bookmarks.size());
+
+    for (const QPair<QString, QString> &bookmark : bookmarks) {
+        const QString &href = bookmark.first;
+
+        if (entries.contains(href))
+            continue;
+
+        auto it = oldEntries.constFind(href);
+        if (it != oldEntries.constEnd() && it->modified == bookmark.second) {
+            entries.insert(href, it.value());
+            continue;
+        }
+
+        XbelEntry entry;
+        entry.modified = bookmark.second;
+        entry.path = FileUtils::bindPathTransform(href);
+        entries.insert(href, entry);
+
+        // 保险箱内文件不显示到最近使用页面
+        if (!VaultController::isVaultFile(href)) {
+            checkHrefs << href;
+            checkPaths << DUrl(entry.path).toLocalFile();
+        }
+    }
+
+    const QHash<QString, bool> &exists = checkFilesExist(checkPaths, RECENT_CHECK_TIMEOUT);
+
+    for (int i = 0; i < checkHrefs.size(); ++i) {
+        XbelEntry &entry = entries[checkHrefs.at(i)];
+        auto it = exists.constFind(checkPaths.at(i));
+
+        if (it != exists.constEnd()) {
+            entry.visible = it.value();
+            continue;
+        }
+
+        // 检查超时，保持原来的状态，下次解析时重新检查
+        const XbelEntry &oldEntry = oldEntries.value(checkHrefs.at(i));
+        entry.visible = oldEntry.visible;
+        entry.modified = oldEntry.visible ? oldEntry.modified : QString();
+    }
+
+    QList<QPair<QString, XbelEntry>> added, changed, removed;
+
+    for (auto it = entries.constBegin(); it != entries.constEnd(); ++it) {
+        const XbelEntry &oldEntry = oldEntries.value(it.key());
+
+        if (it->visible && !oldEntry.visible)
+            added << qMakePair(it.key(), it.value());
+        else if (it->visible && it->modified != oldEntry.modified)
+            changed << qMakePair(it.key(), it.value());
+        else if (!it->visible && oldEntry.visible)
+            removed << qMakePair(it.key(), oldEntry);
+    }
+
+    for (auto it = oldEntries.constBegin(); it != oldEntries.constEnd(); ++it) {
+        if (it->visible && !entries.contains(it.key()))
+            removed << qMakePair(it.key(), it.value());
+    }
+
+    m_xbelEntries = entries;
+
+    auto toRecentUrl = [](const XbelEntry &entry) {
+        DUrl url(entry.path);
+        url.setScheme(RECENT_SCHEME);
+        return url;
+    };
+
+    // 一次回到主线程更新所有变化
+    DThreadUtil::runInMainThread([ = ]() {
         if (dp.isNull())
             return;
-        const DUrl &url = iter.key();
-        if (!urlList.contains(url)) {
-            DThreadUtil::runInMainThread([this, &iter, url]() {
-                iter = recentNodes.erase(iter);
-
-                DAbstractFileWatcher::ghostSignal(DUrl(RECENT_ROOT),
-                                                  &DAbstractFileWatcher::fileDeleted,
-                                                  url);
-            });
-        } else {
-            auto info = iter.value();
-            if (info) {
-                iter.value()->updateInfo();
-                ++iter;
-            } else {
-                iter = recentNodes.erase(iter);
+
+        for (const QPair<QString, XbelEntry> &item : removed) {
+            const DUrl &recentUrl = toRecentUrl(item.second);
+
+            m_bindPathMaps.remove(recentUrl.path());
+
+            if (recentNodes.remove(recentUrl) > 0)
+                DAbstractFileWatcher::ghostSignal(DUrl(RECENT_ROOT), &DAbstractFileWatcher::fileDeleted, recentUrl);
+        }
+
+        for (const QPair<QString, XbelEntry> &item : added) {
+            const DUrl &recentUrl = toRecentUrl(item.second);
+
+            if (item.second.path != item.first)
+                m_bindPathMaps.insert(recentUrl.path(), item.first);
+
+            if (!recentNodes.contains(recentUrl)) {
+                recentNodes[recentUrl] = new RecentFileInfo(recentUrl);
+                DAbstractFileWatcher::ghostSignal(DUrl(RECENT_ROOT), &DAbstractFileWatcher::subfileCreated, recentUrl);
             }
         }
-        if (dp.isNull())
-            return;
-    }
 
-    m_xbelFileLock.unlock();
+        //如果readtime变更了，需要通知filesystemmodel重新排序
+        for (const QPair<QString, XbelEntry> &item : changed) {
+            const DUrl &recentUrl = toRecentUrl(item.second);
+            const RecentPointer &info = recentNodes.value(recentUrl);
+
+            if (!info)
+                continue;
+
+            //先更新info数据
+            info->updateInfo();
+            DAbstractFileWatcher::ghostSignal(DUrl(RECENT_ROOT), &DAbstractFileWatcher::fileModified, recentUrl);
+        }
+
+        // 解析期间 xbel 再次变化
+        if (m_parsePending)
+            m_changeTimer->start();
+    });
 }
 
 void RecentController::asyncHandleFileChanged()
@@ -661,12 +932,22 @@ void RecentController::asyncHandleFileChanged()
      * This slot always gets triggered multiple times consecutively by the
      * file closed/modified events. The correct fix should be applying a
      * lock to 'recently-used.xbel' whenever writing.
-     * The current solution is setting a timeout, during which no matter
-     * how many handleFileChanged()'s are triggered, only the last one
-     * gets executed.
+     * The current solution is a single shot timer, during which no matter
+     * how many changes are reported, only one parse gets executed.
      * The issue mentioned above is specific to applications that use DTK.
      * Applications using GTK does not trigger file closed/modified events
      * at all for some obscure reasons.
      */
-    QtConcurrent::run(this, &RecentController::handleFileChanged);
+    m_changeTimer->start();
+}
+
+void RecentController::startHandleFileChanged()
+{
+    if (m_parseFuture.isRunning()) {
+        m_parsePending = true;
+        return;
+    }
+
+    m_parsePending = false;
+    m_parseFuture = QtConcurrent::run(this, &RecentController::handleFileChanged);
 }
@@ -8,8 +8,8 @@
 #include "dabstractfilecontroller.h"
 #include "models/recentfileinfo.h"
 
-#include <QWaitCondition>
-#include <QMutex>
+#include <QFuture>
+#include <QHash>
 
 class QFileSystemWatcher;
 class DAbstractFileInfo;
@@ -50,16 +50,31 @@ public:
     mutable QMap<DUrl, RecentPointer> recentNodes;
 
 private:
+    //! recently-used.xbel 中的一条记录，按 href 与上次解析的结果比较
+    struct XbelEntry
+    {
+        QString modified;
+        QString path;   // 绑定路径转换后的地址
+        bool visible = false;   // 文件存在且显示在最近使用中
+    };
+
     static DUrlList realUrlList(const DUrlList &recentUrls);
+    static QHash<QString, bool> checkFilesExist(const QStringList &paths, int timeout);
     void handleFileChanged();
     void asyncHandleFileChanged();
+    void startHandleFileChanged();
 
 private:
     QString m_xbelPath;
+    //! 只在主线程中访问
     QMap<QString, QString> m_bindPathMaps;
     DFileWatcher *m_watcher;
-    QWaitCondition m_condition;
-    QMutex m_xbelFileLock;
+    //! xbel 连续变化时合并为一次解析
+    QTimer *m_changeTimer;
+    QFuture<void> m_parseFuture;
+    bool m_parsePending = false;
+    //! 上次解析的结果，同一时刻只有一个解析线程访问
+    QHash<QString, XbelEntry> m_xbelEntries;
 };
 
 #endif // RECENTCONTROLLER_H
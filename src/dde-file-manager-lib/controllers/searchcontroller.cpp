@@ -27,6 +27,9 @@
 #include <QQueue>
 #include <QtConcurrent>
 
+// 没有新的搜索结果时遍历线程等待的最长时间（毫秒）
+#define SEARCH_RESULT_WAIT_TIMEOUT 50
+
 class SearchFileWatcherPrivate;
 class SearchFileWatcher : public DAbstractFileWatcher
 {
@@ -270,20 +273,24 @@ void SearchDiriterator::doSearch()
 
 DUrl SearchDiriterator::next()
 {
-    if (!childrens.isEmpty()) {
-        QMutexLocker lk(&mutex);
-        const DUrl &url = childrens.dequeue();
-        lk.unlock();
+    QMutexLocker lk(&mutex);
 
-        // 修复bug-51754 增加条件判断，保险箱内的文件不能被检索到
-        if (VaultController::isVaultFile(url.fragment()) && !VaultController::isVaultFile(targetUrl.toLocalFile()))
-            return next();
+    // 搜索还在进行但暂时没有结果时等待新的结果，避免遍历线程反复调用 hasNext 空转
+    if (childrens.isEmpty() && !searchCompleted && !searchStoped)
+        resultsAvailable.wait(&mutex, SEARCH_RESULT_WAIT_TIMEOUT);
 
-        currentFileInfo = DFileService::instance()->createFileInfo(parent, url);
-        return url;
-    }
+    if (childrens.isEmpty())
+        return DUrl();
+
+    const DUrl url = childrens.dequeue();
+    lk.unlock();
+
+    // 修复bug-51754 增加条件判断，保险箱内的文件不能被检索到
+    if (VaultController::isVaultFile(url.fragment()) && !VaultController::isVaultFile(targetUrl.toLocalFile()))
+        return next();
 
-    return DUrl();
+    currentFileInfo = DFileService::instance()->createFileInfo(parent, url);
+    return url;
 }
 
 bool SearchDiriterator::hasNext() const
@@ -329,12 +336,18 @@ void SearchDiriterator::onMatched(const QString &id)
 {
     if (taskId == id) {
         auto results = searchServ->matchedResults(taskId);
+        QList<DUrl> urls;
+        urls.reserve(results.size());
         for (const auto &result : results) {
             DUrl url = rootUrl;
             url.setSearchedFileUrl(result);
-            QMutexLocker lk(&mutex);
-            childrens << url;
+            urls << url;
         }
+
+        // 一次加锁放入整批结果，再唤醒等待结果的遍历线程
+        QMutexLocker lk(&mutex);
+        childrens.append(urls);
+        resultsAvailable.wakeAll();
     }
 }
 
@@ -342,14 +355,19 @@ void SearchDiriterator::onSearchCompleted(const QString &id)
 {
     if (taskId == id) {
         qInfo() << "taskId: " << taskId << "search completed!";
+        QMutexLocker lk(&mutex);
         searchCompleted = true;
+        resultsAvailable.wakeAll();
     }
 }
 
 void SearchDiriterator::onSearchStoped(const QString &id)
 {
-    if (taskId == id)
+    if (taskId == id) {
+        QMutexLocker lk(&mutex);
         searchStoped = true;
+        resultsAvailable.wakeAll();
+    }
 }
 
 SearchController::SearchController(QObject *parent)
@@ -10,6 +10,7 @@
 #include <QSet>
 #include <QPair>
 #include <QQueue>
+#include <QWaitCondition>
 
 class SearchFileWatcher;
 class SearchController : public DAbstractFileController
@@ -98,6 +99,8 @@ public:
     bool searchStoped = false;
     QString taskId;
     mutable QMutex mutex;
+    // 有新的搜索结果或搜索结束时唤醒在 next 中等待的遍历线程
+    QWaitCondition resultsAvailable;
 };
 
 #endif // SEARCHCONTROLLER_H
@@ -15,6 +15,7 @@
 #include "dfmapplication.h"
 
 #include "interfaces/dfmstandardpaths.h"
+#include "interfaces/dfmtrashsummary.h"
 #include "singleton.h"
 #include "shutil/dfmfilelistfile.h"
 
@@ -25,6 +26,8 @@
 #include <QTimer>
 #include <QCoreApplication>
 #include <QThread>
+#include <QMutex>
+#include <QSet>
 
 #include <fileoperations/filejob.h>
 #include "app/define.h"
@@ -40,6 +43,24 @@ COMPARE_FUN_DEFINE(sourceFilePath, TrashFilePath, TrashFileInfo)
 }
 
 static bool kWorking = false; // tmp
+
+namespace {
+// 回收站顶层文件的名称，文件监视器启动后由 TrashManager 增量维护，查询回收站状态时不必再读取目录
+struct TrashState {
+    QMutex mutex;
+    QSet<QString> names;
+    // 维护状态的 TrashManager，为空时表示没有监视回收站
+    const TrashManager *owner = nullptr;
+};
+
+Q_GLOBAL_STATIC(TrashState, trashState)
+
+QStringList trashFileNames()
+{
+    return QDir(DFMStandardPaths::location(DFMStandardPaths::TrashFilesPath))
+           .entryList(QDir::AllEntries | QDir::Hidden | QDir::System | QDir::NoDotAndDotDot);
+}
+}
 class TrashDirIterator : public DDirIterator
 {
 public:
@@ -159,7 +180,6 @@ TrashManager::TrashManager(QObject *parent)
     : DAbstractFileController(parent)
     , m_trashFileWatcher(new DFileWatcher(DFMStandardPaths::location(DFMStandardPaths::TrashFilesPath), this))
 {
-    m_isTrashEmpty = isEmpty();
     QString trashFilePath = DFMStandardPaths::location(DFMStandardPaths::TrashFilesPath);
     //make sure trash file exists
     if (!QFile::exists(trashFilePath))
@@ -168,6 +188,25 @@ TrashManager::TrashManager(QObject *parent)
     connect(m_trashFileWatcher, &DFileWatcher::fileDeleted, this, &TrashManager::trashFilesChanged);
     connect(m_trashFileWatcher, &DFileWatcher::subfileCreated, this, &TrashManager::trashFilesChanged);
     m_trashFileWatcher->startWatcher();
+
+    // 监视器启动后只读取一次回收站目录，之后的变化由 trashFilesChanged 更新
+    const QSet<QString> &names = QSet<QString>::fromList(trashFileNames());
+    QMutexLocker locker(&trashState->mutex);
+    trashState->names = names;
+    trashState->owner = this;
+    m_isTrashEmpty = names.isEmpty();
+}
+
+TrashManager::~TrashManager()
+{
+    if (trashState.isDestroyed())
+        return;
+
+    QMutexLocker locker(&trashState->mutex);
+    if (trashState->owner == this) {
+        trashState->owner = nullptr;
+        trashState->names.clear();
+    }
 }
 
 const DAbstractFileInfoPointer TrashManager::createFileInfo(const QSharedPointer<DFMCreateFileInfoEvent> &event) const
@@ -397,12 +436,16 @@ bool TrashManager::restoreTrashFile(const DUrlList &list, DUrlList *restoreOrigi
         } else {
             //! 存储最终的文件路径
             restoreFileOriginUrlList << DUrl::fromLocalFile(job->getTargetDir());
+
+            if (url.path().lastIndexOf('/') == 0)
+                DFMTrashSummary::instance()->remove(url.fileName());
         }
 
         ok = ok && ret;
     }
     job->setRestoreProgress(0);
     emit job->finished();
+    DFMTrashSummary::instance()->save();
 
     if (!ok && restoreFailedList.count() > 0) {
         emit fileSignalManager->requestShowRestoreFailedDialog(restoreFailedList);
@@ -436,11 +479,20 @@ void TrashManager::cleanTrash(const QObject *sender, bool silent) const
     if (ret) {
         QString infoPaht = info_url.toLocalFile();
         QProcess::execute("rm -r \"" + infoPaht.toUtf8() + "\"");
+        DFMTrashSummary::instance()->clear();
+        DFMTrashSummary::instance()->save();
     }
 }
 
 bool TrashManager::isEmpty()
 {
+    {
+        QMutexLocker locker(&trashState->mutex);
+        // 刚放入回收站的文件可能还没有收到监视器的信号，记录为空时仍读取目录确认，读取空目录的开销很小
+        if (trashState->owner && !trashState->names.isEmpty())
+            return false;
+    }
+
     QDir dir(DFMStandardPaths::location(DFMStandardPaths::TrashFilesPath));
 
     if (!dir.exists())
@@ -453,6 +505,20 @@ bool TrashManager::isEmpty()
     return !iterator.hasNext();
 }
 
+/*!
+ * \brief TrashManager::filesCount 回收站顶层的文件数量
+ */
+int TrashManager::filesCount()
+{
+    {
+        QMutexLocker locker(&trashState->mutex);
+        if (trashState->owner && !trashState->names.isEmpty())
+            return trashState->names.count();
+    }
+
+    return trashFileNames().count();
+}
+
 bool TrashManager::isWorking()
 {
     return ::kWorking;
@@ -460,10 +526,37 @@ bool TrashManager::isWorking()
 
 void TrashManager::trashFilesChanged(const DUrl &url)
 {
-    Q_UNUSED(url);
-    if (m_isTrashEmpty == isEmpty())
+    const QString &trashFilesPath = DFMStandardPaths::location(DFMStandardPaths::TrashFilesPath);
+    const QString &filePath = url.toLocalFile();
+    const QFileInfo info(filePath);
+    bool tracked = false;
+    bool empty = true;
+
+    {
+        QMutexLocker locker(&trashState->mutex);
+
+        if (trashState->owner == this) {
+            if (filePath == trashFilesPath) {
+                trashState->names.clear();
+            } else if (info.absolutePath() == trashFilesPath) {
+                // 创建和删除的信号可能合并或乱序，以文件当前是否存在为准
+                if (info.exists() || info.isSymLink())
+                    trashState->names.insert(info.fileName());
+                else
+                    trashState->names.remove(info.fileName());
+            }
+
+            tracked = true;
+            empty = trashState->names.isEmpty();
+        }
+    }
+
+    if (!tracked)
+        empty = isEmpty();
+
+    if (m_isTrashEmpty == empty)
         return;
 
-    m_isTrashEmpty = isEmpty();
+    m_isTrashEmpty = empty;
     emit fileSignalManager->trashStateChanged();
 }
@@ -22,6 +22,7 @@ class TrashManager : public DAbstractFileController
 
 public:
     explicit TrashManager(QObject *parent = nullptr);
+    ~TrashManager() override;
 
     const DAbstractFileInfoPointer createFileInfo(const QSharedPointer<DFMCreateFileInfoEvent> &event) const override;
 
@@ -46,6 +47,7 @@ public:
     void cleanTrash(const QObject *sender = nullptr, bool silent = false) const;
 
     static bool isEmpty();
+    static int filesCount();
     static bool isWorking();
 public slots:
     void trashFilesChanged(const DUrl &url);
@@ -985,23 +985,36 @@ void VaultController::updateFolderSizeLabel(const qint64 size) noexcept
     m_totalSize = size;
 }
 
+/*!
+ * \brief vaultRootPath 保险箱解密目录（不带末尾的 /），会话内不会变化，只生成一次
+ */
+static const QString &vaultRootPath()
+{
+    static const QString rootPath = [] {
+        QString path = VaultController::makeVaultLocalPath();
+
+        if (path.endsWith('/'))
+            path.chop(1);
+
+        return path;
+    }();
+
+    return rootPath;
+}
+
 bool VaultController::isVaultFile(QString path)
 {
-    bool bVaultFile = false;
-    QString rootPath = makeVaultLocalPath();
+    const QString &rootPath = vaultRootPath();
 
     if (rootPath.isEmpty())
         return false;
 
-    if (rootPath.back() == "/") {
-        rootPath.chop(1);
-    }
-
-    if (path.contains(rootPath) && path.left(6) != "search") {
-        bVaultFile = true;
-    }
+    // 大多数调用传入的是本地路径，前缀匹配即可返回
+    if (path.startsWith(rootPath))
+        return true;
 
-    return bVaultFile;
+    // url 字符串、搜索结果的片段等仍按包含关系判断
+    return path.contains(rootPath) && !path.startsWith("search");
 }
 
 QFileDevice::Permissions VaultController::getPermissions(QString filePath)
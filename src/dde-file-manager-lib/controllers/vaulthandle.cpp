@@ -11,6 +11,7 @@
 #include "singleton.h"
 #include "utils/grouppolicy.h"
 #include "vault/vaultconfig.h"
+#include "dfmapplication.h"
 
 #include <QStandardPaths>
 #include <QProcess>
@@ -111,12 +112,23 @@ int CryFsHandle::runVaultProcess(QString lockBaseDir, QString unlockFileDir, QSt
     QStringList arguments;
     if (isCreate) {
         const QString &algoName = encryptAlgoNameOfGroupPolicy();
-        arguments << QString("--cipher") << algoName << lockBaseDir << unlockFileDir;
+        arguments << QString("--cipher") << algoName;
+
+        // 块大小只能在创建时指定，之后保存在 cryfs.config 中
+        const int blockSize = DFM_NAMESPACE::DFMApplication::genericAttribute(DFM_NAMESPACE::DFMApplication::GA_VaultBlockSize).toInt() * 1024;
+
+        if (blockSize > 0)
+            arguments << QString("--blocksize") << QString::number(blockSize);
+
+        arguments << lockBaseDir << unlockFileDir;
         // 组策略同步设置保险箱加密算法
         GroupPolicy::instance()->setValue(GROUP_POLICY_VAULT_ALGO_NAME, algoName);
         // 记录当前保险箱使用的加密算法,用于同步组策略信息
         VaultConfig config;
         config.set(CONFIG_NODE_NAME, CONFIG_KEY_ALGONAME, QVariant(algoName));
+        // 记录块大小，写入保险箱时按块大小对齐
+        if (blockSize > 0)
+            config.set(CONFIG_NODE_NAME, CONFIG_KEY_BLOCKSIZE, QVariant(blockSize));
     } else {
         arguments << lockBaseDir << unlockFileDir;
         // 每次开锁时，同步组策略中保险箱加密算法
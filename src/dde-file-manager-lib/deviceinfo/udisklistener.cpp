@@ -35,6 +35,7 @@
 #include <QProcess>
 #include <QStorageInfo>
 #include <QUrlQuery>
+#include <QtConcurrent>
 
 
 class UDiskFileWatcher;
@@ -80,6 +81,32 @@ UDiskListener::UDiskListener(QObject *parent):
 UDiskListener::~UDiskListener()
 {
     DFileService::unsetFileUrlHandler(this);
+
+    // 等待枚举线程结束，释放还未加入 m_fsDevMap 的设备
+    m_blockDevicesWatcher->waitForFinished();
+    if (m_fsDevicesWatcher) {
+        m_fsDevicesWatcher->waitForFinished();
+        // 结果按顺序投递，m_fsDevsHandled 之后的都还没有被接管
+        const QList<DBlockDevice *> &devices = m_fsDevicesWatcher->future().results();
+        qDeleteAll(devices.mid(m_fsDevsHandled));
+    }
+}
+
+/*!
+ * \brief 在线程中创建 \a dbusPath 对应的块设备，不是文件系统分区时返回 nullptr
+ *
+ * 创建的对象被移到主线程，由 UDiskListener::addFileSystemDevice 接管
+ */
+static DBlockDevice *createFileSystemDevice(const QString &dbusPath)
+{
+    DBlockDevice *blDev = DDiskManager::createBlockDevice(dbusPath);
+    if (!blDev->hasFileSystem()) {
+        delete blDev;
+        return nullptr;
+    }
+
+    blDev->moveToThread(qApp->thread());
+    return blDev;
 }
 
 void UDiskListener::initDiskManager()
@@ -87,20 +114,60 @@ void UDiskListener::initDiskManager()
     m_diskMgr = new DDiskManager(this);
     m_diskTimer = new QTimer(this);
     m_diskMgr->setWatchChanges(true);
-    QStringList blDevList = m_diskMgr->blockDevices({});
-    for (const QString &str : blDevList) {
-        insertFileSystemDevice(str);
-    }
+
+    // 设备较多（loop、snap、LVM）时逐个查询 UDisks2 很慢，放到线程中进行，结果逐个加入
+    m_blockDevicesWatcher = new QFutureWatcher<QStringList>(this);
+    connect(m_blockDevicesWatcher, &QFutureWatcher<QStringList>::finished, this, [this]() {
+        enumerateFileSystemDevices(m_blockDevicesWatcher->result());
+    });
+    m_blockDevicesWatcher->setFuture(QtConcurrent::run([]() {
+        DDiskManager diskMgr;
+        return diskMgr.blockDevices({});
+    }));
 
 // 以下这段定时器代码可解决打开光驱访问文件后，物理弹出光驱，文管界面却没能卸载光驱设备的问题。
     connect(m_diskTimer, &QTimer::timeout, this, &UDiskListener::loopCheckCD);
 }
 
+void UDiskListener::enumerateFileSystemDevices(const QStringList &dbusPaths)
+{
+    m_fsDevicesWatcher = new QFutureWatcher<DBlockDevice *>(this);
+    connect(m_fsDevicesWatcher, &QFutureWatcher<DBlockDevice *>::resultReadyAt, this, [this](int index) {
+        DBlockDevice *blDev = m_fsDevicesWatcher->resultAt(index);
+        m_fsDevsHandled = index + 1;
+        if (blDev)
+            addFileSystemDevice(blDev->path(), blDev);
+    });
+    connect(m_fsDevicesWatcher, &QFutureWatcher<DBlockDevice *>::finished, this, [this]() {
+        m_removedFsDevs.clear();
+    });
+    m_fsDevicesWatcher->setFuture(QtConcurrent::mapped(dbusPaths, createFileSystemDevice));
+}
+
+/*!
+ * \brief 将文件系统分区 \a blDev 加入 m_fsDevMap，已存在或在枚举期间被移除时删除 \a blDev
+ */
+void UDiskListener::addFileSystemDevice(const QString &dbusPath, DBlockDevice *blDev)
+{
+    if (m_fsDevMap.contains(dbusPath) || m_removedFsDevs.remove(dbusPath)) {
+        delete blDev;
+        return;
+    }
+
+    blDev->setParent(this);
+    blDev->setWatchChanges(true);
+    connect(blDev, &DBlockDevice::idLabelChanged, this, &UDiskListener::fileSystemDeviceIdLabelChanged);
+    m_fsDevMap.insert(dbusPath, blDev);
+}
+
 void UDiskListener::initConnect()
 {
     connect(m_diskMgr, &DDiskManager::fileSystemAdded, this, &UDiskListener::insertFileSystemDevice);
     connect(m_diskMgr, &DDiskManager::fileSystemRemoved, this, [this](const QString & path) {
-        delete m_fsDevMap.take(path);
+        DBlockDevice *blDev = m_fsDevMap.take(path);
+        if (!blDev && (m_blockDevicesWatcher->isRunning() || (m_fsDevicesWatcher && m_fsDevicesWatcher->isRunning())))
+            m_removedFsDevs.insert(path);
+        delete blDev;
     });
     connect(gvfsMountManager, &GvfsMountManager::mount_added, this, &UDiskListener::addMountDiskInfo);
     connect(gvfsMountManager, &GvfsMountManager::mount_removed, this, &UDiskListener::removeMountDiskInfo);
@@ -855,11 +922,13 @@ void UDiskListener::fileSystemDeviceIdLabelChanged(const QString &labelName)
  */
 void UDiskListener::insertFileSystemDevice(const QString dbusPath)
 {
+    if (m_fsDevMap.contains(dbusPath))
+        return;
+
     DBlockDevice *blDev = DDiskManager::createBlockDevice(dbusPath);
     if (blDev->hasFileSystem()) {
-        blDev->setWatchChanges(true);
-        connect(blDev, &DBlockDevice::idLabelChanged, this, &UDiskListener::fileSystemDeviceIdLabelChanged);
-        m_fsDevMap.insert(dbusPath, blDev);
+        m_removedFsDevs.remove(dbusPath);
+        addFileSystemDevice(dbusPath, blDev);
     } else {
         delete blDev;
     }
@@ -17,6 +17,8 @@
 #include <QTimer>
 #include <QXmlStreamReader>
 #include <QDBusPendingReply>
+#include <QFutureWatcher>
+#include <QSet>
 #include "udiskdeviceinfo.h"
 
 
@@ -92,6 +94,8 @@ public:
 private:
     void initDiskManager();
     void initConnect();
+    void enumerateFileSystemDevices(const QStringList &dbusPaths);
+    void addFileSystemDevice(const QString &dbusPath, DBlockDevice *blDev);
 
 signals:
     void volumeAdded(UDiskDeviceInfoPointer device);
@@ -122,6 +126,11 @@ private slots:
 private:
     DDiskManager *m_diskMgr = nullptr;
     QMap<QString, DBlockDevice *> m_fsDevMap;
+    //! 启动时在线程中枚举块设备，避免 UDisks2 的 DBus 调用阻塞界面
+    QFutureWatcher<QStringList> *m_blockDevicesWatcher = nullptr;
+    QFutureWatcher<DBlockDevice *> *m_fsDevicesWatcher = nullptr;
+    int m_fsDevsHandled = 0;
+    QSet<QString> m_removedFsDevs; // 枚举期间被移除的设备
 
     QList<UDiskDeviceInfoPointer> m_list;
     QList<UDiskDeviceInfoPointer> m_mountList;
@@ -29,6 +29,13 @@
 #include <QHBoxLayout>
 #include <QProcessEnvironment>
 
+// 保留的已准备好的预览数量，包括当前文件之前显示过的预览
+#define PREVIEW_PREFETCH_CACHE_SIZE 4
+// 切换文件后等待一段时间再预加载相邻的文件，连续切换时不做无用的预加载
+#define PREVIEW_PREFETCH_DELAY 200
+// 标记预览插件在状态栏中创建的控件，预览不是当前预览时隐藏这些控件
+#define PREVIEW_OWNER_PROPERTY "_dfm_preview_owner"
+
 DFM_BEGIN_NAMESPACE
 
 class FilePreviewDialogStatusBar : public QFrame
@@ -243,6 +250,11 @@ FilePreviewDialog::FilePreviewDialog(const DUrlList &previewUrllist, QWidget *pa
 
     initUI();
 
+    m_prefetchTimer = new QTimer(this);
+    m_prefetchTimer->setSingleShot(true);
+    m_prefetchTimer->setInterval(PREVIEW_PREFETCH_DELAY);
+    connect(m_prefetchTimer, &QTimer::timeout, this, &FilePreviewDialog::prefetchNext);
+
     if (previewUrllist.count() < 2) {
         m_statusBar->preButton()->hide();
         m_statusBar->nextButton()->hide();
@@ -255,6 +267,7 @@ FilePreviewDialog::~FilePreviewDialog()
 {
     m_isSwitch = false;
     emit signalCloseEvent();
+    clearPrefetchedPreviews();
 
     if (m_preview) {
         m_preview->deleteLater();
@@ -304,6 +317,7 @@ void FilePreviewDialog::hideEvent(QHideEvent *event)
 {
     m_isSwitch = false;
     emit signalCloseEvent();
+    clearPrefetchedPreviews();
     if (m_preview) {
         m_preview->contentWidget()->hide();
         m_preview->stop();
@@ -326,6 +340,7 @@ void FilePreviewDialog::closeEvent(QCloseEvent *event)
 {
     m_isSwitch = false;
     emit signalCloseEvent();
+    clearPrefetchedPreviews();
     if (m_preview) {
         m_preview->contentWidget()->hide();
         m_preview->stop();
@@ -480,6 +495,9 @@ void FilePreviewDialog::switchToPage(int index)
         m_isSwitch = true;
     }
 
+    // 还未开始的预加载针对的是切换前的文件
+    m_prefetchTimer->stop();
+
     if (m_preview) {
         m_preview->stop();
     }
@@ -488,6 +506,13 @@ void FilePreviewDialog::switchToPage(int index)
     m_statusBar->preButton()->setEnabled(index > 0);
     m_statusBar->nextButton()->setEnabled(index < m_fileList.count() - 1);
 
+    if (DFMFilePreview *preview = takePrefetchedPreview(m_fileList.at(index))) {
+        setCurrentPreview(preview, m_fileList.at(index), true);
+        startPrefetch();
+        m_isSwitch = false;
+        return;
+    }
+
     const DAbstractFileInfoPointer &info = DFileService::instance()->createFileInfo(this, m_fileList.at(index));
 
     if (!info) {
@@ -514,7 +539,9 @@ void FilePreviewDialog::switchToPage(int index)
 
         if (m_preview && (DFMFilePreviewFactory::isSuitedWithKey(m_preview, key) || DFMFilePreviewFactory::isSuitedWithKey(m_preview, general_key))) {
             if (m_preview->setFileUrl(m_fileList.at(index))) {
+                m_previewUrl = m_fileList.at(index);
                 updateDialog();
+                startPrefetch();
                 m_isSwitch = false;
                 return;
             }
@@ -527,7 +554,7 @@ void FilePreviewDialog::switchToPage(int index)
         }
 
         if (preview) {
-            preview->initialize(this, m_statusBar);
+            initializePreview(preview);
             if (info->canRedirectionFileUrl() && preview->setFileUrl(info->redirectedFileUrl())) {
                 break;
             } else if (preview->setFileUrl(m_fileList.at(index))) {
@@ -542,16 +569,45 @@ void FilePreviewDialog::switchToPage(int index)
     if (!preview) {
         if (qobject_cast<UnknowFilePreview *>(m_preview)) {
             m_preview->setFileUrl(m_fileList.at(index));
+            m_previewUrl = m_fileList.at(index);
             m_statusBar->openButton()->setFocus();
+            startPrefetch();
             m_isSwitch = false;
             return;
         } else {
             preview = new UnknowFilePreview(this);
-            preview->initialize(this, m_statusBar);
+            initializePreview(preview);
             preview->setFileUrl(m_fileList.at(index));
         }
     }
 
+    setCurrentPreview(preview, m_fileList.at(index), false);
+    startPrefetch();
+
+    m_isSwitch = false;
+}
+
+/*!
+ * \brief FilePreviewDialog::initializePreview 初始化预览插件，并记下插件在状态栏中创建的控件
+ */
+void FilePreviewDialog::initializePreview(DFMFilePreview *preview)
+{
+    const QObjectList children = m_statusBar->children();
+
+    preview->initialize(this, m_statusBar);
+
+    for (QObject *child : m_statusBar->children()) {
+        if (child->isWidgetType() && !children.contains(child))
+            child->setProperty(PREVIEW_OWNER_PROPERTY, QVariant::fromValue<QObject *>(preview));
+    }
+}
+
+/*!
+ * \brief FilePreviewDialog::setCurrentPreview 显示新的预览，支持预加载的旧预览保留下来以便切换回去
+ * \param prefetched 预览是预加载的，其控件已被隐藏
+ */
+void FilePreviewDialog::setCurrentPreview(DFMFilePreview *preview, const DUrl &url, bool prefetched)
+{
     bool isUpdateDialog = true;
     if (m_preview && preview && m_preview->metaObject()->className() == QStringLiteral("VideoPreview") &&
             preview->metaObject()->className() != QStringLiteral("VideoPreview"))
@@ -566,7 +622,17 @@ void FilePreviewDialog::switchToPage(int index)
         m_preview->contentWidget()->setVisible(false);
         static_cast<QVBoxLayout *>(layout())->removeWidget(m_preview->contentWidget());
         static_cast<QHBoxLayout *>(m_statusBar->layout())->removeWidget(m_preview->statusBarWidget());
-        m_preview->deleteLater();
+
+        if (m_preview->property("supportPrefetch").toBool() && !m_previewUrl.isEmpty()) {
+            setStatusBarWidgetsVisible(m_preview, false);
+            m_prefetchedPreviews.prepend(qMakePair(m_previewUrl, m_preview));
+
+            while (m_prefetchedPreviews.size() > PREVIEW_PREFETCH_CACHE_SIZE)
+                releasePreview(m_prefetchedPreviews.takeLast().second);
+        } else {
+            m_preview->deleteLater();
+        }
+
         m_preview = nullptr;
     }
 
@@ -575,8 +641,14 @@ void FilePreviewDialog::switchToPage(int index)
     if (QWidget *w = preview->statusBarWidget())
         static_cast<QHBoxLayout *>(m_statusBar->layout())->insertWidget(3, w, 0, preview->statusBarWidgetAlignment());
 
+    if (prefetched) {
+        preview->contentWidget()->show();
+        setStatusBarWidgetsVisible(preview, true);
+    }
+
     m_separator->setVisible(preview->showStatusBarSeparator());
     m_preview = preview;
+    m_previewUrl = url;
 
     if (m_preview && isUpdateDialog)
         updateDialog();
@@ -586,8 +658,144 @@ void FilePreviewDialog::switchToPage(int index)
             updateDialog();
         }
     });
+}
 
-    m_isSwitch = false;
+void FilePreviewDialog::setStatusBarWidgetsVisible(DFMFilePreview *preview, bool visible)
+{
+    for (QObject *child : m_statusBar->children()) {
+        if (child->isWidgetType() && child->property(PREVIEW_OWNER_PROPERTY).value<QObject *>() == preview)
+            static_cast<QWidget *>(child)->setVisible(visible);
+    }
+
+    if (QWidget *w = preview->statusBarWidget())
+        w->setVisible(visible);
+}
+
+void FilePreviewDialog::releasePreview(DFMFilePreview *preview)
+{
+    if (QWidget *w = preview->contentWidget())
+        w->hide();
+
+    setStatusBarWidgetsVisible(preview, false);
+    preview->stop();
+    preview->deleteLater();
+}
+
+/*!
+ * \brief FilePreviewDialog::startPrefetch 当前文件显示后开始预加载相邻的文件
+ */
+void FilePreviewDialog::startPrefetch()
+{
+    m_prefetchStep = 0;
+
+    if (m_fileList.count() > 1)
+        m_prefetchTimer->start();
+}
+
+/*!
+ * \brief FilePreviewDialog::prefetchNext 依次预加载后一个、前一个和后第二个文件，每次只准备一个预览
+ */
+void FilePreviewDialog::prefetchNext()
+{
+    static const int offsets[] = {1, -1, 2};
+
+    while (m_prefetchStep < static_cast<int>(sizeof(offsets) / sizeof(offsets[0]))) {
+        const int index = m_currentPageIndex + offsets[m_prefetchStep++];
+
+        if (index < 0 || index >= m_fileList.count())
+            continue;
+
+        if (prefetchPreview(m_fileList.at(index))) {
+            // 剩下的留到下一次事件循环，不连续占用界面线程
+            m_prefetchTimer->start(0);
+            return;
+        }
+    }
+}
+
+/*!
+ * \brief FilePreviewDialog::prefetchPreview 为文件创建预览但不显示，插件不支持预加载时不创建
+ * \return 是否新准备了预览
+ */
+bool FilePreviewDialog::prefetchPreview(const DUrl &url)
+{
+    if (url == m_previewUrl || !isVisible())
+        return false;
+
+    for (const QPair<DUrl, DFMFilePreview *> &item : m_prefetchedPreviews) {
+        if (item.first == url)
+            return false;
+    }
+
+    const DAbstractFileInfoPointer &info = DFileService::instance()->createFileInfo(this, url);
+
+    if (!info || info->isDesktopFile())
+        return false;
+
+    const QMimeType &mime_type = info->mimeType();
+    QStringList key_list(mime_type.name());
+
+    key_list.append(mime_type.aliases());
+    key_list.append(mime_type.allAncestors());
+
+    for (const QString &key : key_list) {
+        const QString &general_key = generalKey(key);
+        DFMFilePreview *preview = DFMFilePreviewFactory::create(key);
+
+        if (!preview && general_key != key)
+            preview = DFMFilePreviewFactory::create(general_key);
+
+        if (!preview)
+            continue;
+
+        // 与 switchToPage 选择相同的插件，第一个可用的插件不支持预加载时放弃
+        if (!preview->property("supportPrefetch").toBool()) {
+            preview->deleteLater();
+            return false;
+        }
+
+        initializePreview(preview);
+        setStatusBarWidgetsVisible(preview, false);
+
+        if ((info->canRedirectionFileUrl() && preview->setFileUrl(info->redirectedFileUrl()))
+                || preview->setFileUrl(url)) {
+            if (QWidget *w = preview->contentWidget())
+                w->hide();
+
+            m_prefetchedPreviews.prepend(qMakePair(url, preview));
+
+            while (m_prefetchedPreviews.size() > PREVIEW_PREFETCH_CACHE_SIZE)
+                releasePreview(m_prefetchedPreviews.takeLast().second);
+
+            return true;
+        }
+
+        setStatusBarWidgetsVisible(preview, false);
+        preview->deleteLater();
+    }
+
+    return false;
+}
+
+DFMFilePreview *FilePreviewDialog::takePrefetchedPreview(const DUrl &url)
+{
+    for (int i = 0; i < m_prefetchedPreviews.size(); ++i) {
+        if (m_prefetchedPreviews.at(i).first == url)
+            return m_prefetchedPreviews.takeAt(i).second;
+    }
+
+    return nullptr;
+}
+
+void FilePreviewDialog::clearPrefetchedPreviews()
+{
+    if (m_prefetchTimer)
+        m_prefetchTimer->stop();
+
+    for (const QPair<DUrl, DFMFilePreview *> &item : m_prefetchedPreviews)
+        releasePreview(item.second);
+
+    m_prefetchedPreviews.clear();
 }
 
 void FilePreviewDialog::setEntryUrlList(const DUrlList &entryUrlList)
@@ -605,6 +813,7 @@ void FilePreviewDialog::setEntryUrlList(const DUrlList &entryUrlList)
 void FilePreviewDialog::done(int r)
 {
     DAbstractDialog::done(r);
+    clearPrefetchedPreviews();
 
     if (m_preview) {
         m_preview->stop();
@@ -16,6 +16,7 @@
 QT_BEGIN_NAMESPACE
 class QPushButton;
 class QLabel;
+class QTimer;
 QT_END_NAMESPACE
 
 DWIDGET_BEGIN_NAMESPACE
@@ -98,6 +99,16 @@ private:
     void updateDialog();
     bool canNextOrPre();
 
+    void initializePreview(DFMFilePreview *preview);
+    void setCurrentPreview(DFMFilePreview *preview, const DUrl &url, bool prefetched);
+    void setStatusBarWidgetsVisible(DFMFilePreview *preview, bool visible);
+    void releasePreview(DFMFilePreview *preview);
+    void startPrefetch();
+    void prefetchNext();
+    bool prefetchPreview(const DUrl &url);
+    DFMFilePreview *takePrefetchedPreview(const DUrl &url);
+    void clearPrefetchedPreviews();
+
     DUrlList m_fileList;
     DUrlList m_entryUrlList;
 
@@ -111,7 +122,12 @@ private:
     QAtomicInteger<qint64> keyPressTime = {0};
     QAtomicInteger<bool> m_isSwitch = false;
     DFMFilePreview *m_preview = nullptr;
-
+    // m_preview 对应的文件列表中的地址
+    DUrl m_previewUrl;
+    // 已准备好的预览，最近使用的在前
+    QList<QPair<DUrl, DFMFilePreview *>> m_prefetchedPreviews;
+    QTimer *m_prefetchTimer = nullptr;
+    int m_prefetchStep = 0;
 };
 
 DFM_END_NAMESPACE
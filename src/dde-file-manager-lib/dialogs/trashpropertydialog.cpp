@@ -6,6 +6,8 @@
 #include "shutil/fileutils.h"
 #include "dfileservices.h"
 #include "dfilestatisticsjob.h"
+#include "interfaces/dfmtrashsummary.h"
+#include "controllers/trashmanager.h"
 
 #include <DHorizontalLine>
 
@@ -13,6 +15,8 @@
 #include <QHBoxLayout>
 #include <QPainter>
 #include <QWindow>
+#include <QFutureWatcher>
+#include <QtConcurrent>
 
 DWIDGET_USE_NAMESPACE
 DFM_USE_NAMESPACE
@@ -45,8 +49,10 @@ void TrashPropertyDialog::initUI()
     setTitle(tr("Trash"));
 
     const DAbstractFileInfoPointer &fileInfo = DFileService::instance()->createFileInfo(this, m_url);
+    // 整个回收站的文件数量由 TrashManager 维护，不必再读取目录
+    const int fCount = m_url == DUrl::fromTrashFile("/") ? TrashManager::filesCount() : fileInfo->filesCount();
     QIcon trashIcon;
-    if (fileInfo->filesCount() > 0) {
+    if (fCount > 0) {
         trashIcon = QIcon::fromTheme("user-trash-full");
     } else {
         trashIcon = QIcon::fromTheme("user-trash");
@@ -57,7 +63,6 @@ void TrashPropertyDialog::initUI()
     m_iconLabel->setPixmap(trashIcon.pixmap(m_iconLabel->size()));
     m_iconLabel->setAlignment(Qt::AlignCenter);
 
-    const int fCount = fileInfo->filesCount();
     QString itemStr = tr("item");
     if (fCount != 1)
         itemStr = tr("items");
@@ -97,6 +102,26 @@ void TrashPropertyDialog::initUI()
 
 void TrashPropertyDialog::startComputerFolderSize(const DUrl &url)
 {
+    // 整个回收站的大小使用缓存的统计结果，只计算新放入回收站的文件
+    if (url == DUrl::fromTrashFile("/")) {
+        QFutureWatcher<qint64> *watcher = new QFutureWatcher<qint64>(this);
+
+        connect(watcher, &QFutureWatcher<qint64>::finished, this, [this, watcher] {
+            updateFolderSize(watcher->result());
+            watcher->deleteLater();
+        });
+        watcher->setFuture(QtConcurrent::run([] {
+            qint64 size = 0;
+
+            DFMTrashSummary::instance()->summary(nullptr, &size);
+            DFMTrashSummary::instance()->save();
+
+            return size;
+        }));
+
+        return;
+    }
+
     DFileStatisticsJob *worker = new DFileStatisticsJob(this);
 
     connect(worker, &DFileStatisticsJob::finished, worker, &DFileStatisticsJob::deleteLater);
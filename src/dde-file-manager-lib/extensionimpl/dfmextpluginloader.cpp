@@ -75,6 +75,11 @@ bool DFMExtPluginLoader::loadPlugin()
     return ret;
 }
 
+bool DFMExtPluginLoader::isLoaded() const
+{
+    return d->qlib.isLoaded();
+}
+
 bool DFMExtPluginLoader::initialize()
 {
     if (!d->qlib.isLoaded()) {
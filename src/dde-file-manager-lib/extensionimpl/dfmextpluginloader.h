@@ -20,6 +20,7 @@ public:
     virtual ~DFMExtPluginLoader();
     static bool hasSymbol(const QString &fileName);
     bool loadPlugin();
+    bool isLoaded() const;
     bool initialize();
     void shutdown();
     QString fileName() const;
@@ -7,6 +7,7 @@
 #include "dfmstandardpaths.h"
 #include "durl.h"
 #include "dfmglobal.h"
+#include "dfileservices.h"
 
 #include <QDirIterator>
 #include <QDebug>
@@ -53,6 +54,7 @@ bool DFMExtPluginManager::scanPlugins()
         }
     }
     qDebug() << "loader import files name" << d->loaders.keys();
+    d->manifest.save();
     d->currState = DFMExtPluginManager::State::Scanned;
     return true;
 }
@@ -65,6 +67,11 @@ bool DFMExtPluginManager::loadPlugins()
 {
     bool ret = true;
     for (auto val : d->loaders) {
+        // 只提供菜单的插件在第一次弹出相关的菜单时才加载
+        const DFMExtPluginManifest::Entry &entry = d->manifest.entry(val->fileName());
+        if (entry.hasMenu && !entry.hasEmblem)
+            continue;
+
         if (!val->loadPlugin()) {
             ret = false;
             qInfo() << val->errorString();
@@ -82,6 +89,9 @@ bool DFMExtPluginManager::initPlugins()
 {
     bool ret = true;
     for (auto val : d->loaders) {
+        if (!val->isLoaded())
+            continue;
+
         if (!val->initialize()) {
             ret = false;
             qInfo() << val->errorString();
@@ -145,6 +155,59 @@ DFMExtPluginManager::DFMExtMenus DFMExtPluginManager::menus() const
     return menuList;
 }
 
+/*!
+ * \brief menus 获取处理当前目录的 scheme 和所选文件的 mime 类型的右键菜单扩展接口
+ *
+ * 根据插件清单过滤，不相关的插件不会被调用，还未加载的相关插件此时才加载。
+ * \param selected 为空时（空白区域菜单）不按 mime 类型过滤
+ */
+DFMExtPluginManager::DFMExtMenus DFMExtPluginManager::menus(const DUrl &currentUrl, const DUrlList &selected)
+{
+    const QString &scheme = currentUrl.scheme();
+    bool hasMimeTypeFilter = false;
+    QList<DFMExtPluginLoaderPointer> candidates;
+
+    for (auto val : d->loaders) {
+        const DFMExtPluginManifest::Entry &entry = d->manifest.entry(val->fileName());
+
+        if (!entry.hasMenu || !DFMExtPluginManifest::matches(entry, scheme, QStringList()))
+            continue;
+
+        hasMimeTypeFilter = hasMimeTypeFilter || !entry.mimeTypes.isEmpty();
+        candidates << val;
+    }
+
+    // 只有插件限制了 mime 类型时才需要获取所选文件的类型
+    QStringList mimeTypes;
+    if (hasMimeTypeFilter) {
+        for (const DUrl &url : selected) {
+            const DAbstractFileInfoPointer &info = DFileService::instance()->createFileInfo(nullptr, url);
+            if (info && !mimeTypes.contains(info->mimeTypeName()))
+                mimeTypes << info->mimeTypeName();
+        }
+    }
+
+    DFMExtMenus menuList;
+
+    for (const DFMExtPluginLoaderPointer &val : candidates) {
+        if (!DFMExtPluginManifest::matches(d->manifest.entry(val->fileName()), scheme, mimeTypes))
+            continue;
+
+        if (!val->isLoaded() && !d->loadAndInitialize(val))
+            continue;
+
+        QMutexLocker guard(&d->mutex);
+        const DFMExtMenuState &menu = d->menus.value(val->fileName());
+
+        if (menu.first == DFMExtPluginManager::Enable && menu.second)
+            menuList.append(menu.second);
+    }
+
+    d->manifest.save();
+
+    return menuList;
+}
+
 /*!
  * \brief emblemIcons 获取插件内部角标扩展接口
  * \return 返回接口列表
@@ -206,6 +269,7 @@ DFMExtPluginManager::DFMExtPluginManager(QObject *parent)
 
 DFMExtPluginManagerPrivate::DFMExtPluginManagerPrivate(DFMExtPluginManager *qq)
     : QObject(qq), q(qq), pluginDefaultPath(""), pluginPaths({}), currState(DFMExtPluginManager::State::Invalid), emblemIcons({}), menus({}), loaders({})
+    , manifest(DFMStandardPaths::location(DFMStandardPaths::CachePath) + "/extension-plugins.json")
 {
 #ifdef EXTENSIONSDIR
     pluginDefaultPath = EXTENSIONSDIR;
@@ -217,7 +281,8 @@ DFMExtPluginManagerPrivate::DFMExtPluginManagerPrivate(DFMExtPluginManager *qq)
 
 bool DFMExtPluginManagerPrivate::scanPlugin(const QString &path)
 {
-    if (DFMExtPluginLoader::hasSymbol(path)) {
+    // 插件没有变化时直接使用清单中的结果，不需要 dlopen
+    if (manifest.entry(path).valid) {
         DFMExtPluginLoaderPointer autoPointer(new DFMExtPluginLoader(path));
         loaders.insert(path, autoPointer);
         return true;
@@ -225,6 +290,31 @@ bool DFMExtPluginManagerPrivate::scanPlugin(const QString &path)
     return false;
 }
 
+/*!
+ * \brief DFMExtPluginManagerPrivate::loadAndInitialize 加载并初始化延迟加载的插件
+ */
+bool DFMExtPluginManagerPrivate::loadAndInitialize(const DFMExtPluginLoaderPointer &loader)
+{
+    QMutexLocker guard(&loadMutex);
+
+    if (loader->isLoaded())
+        return true;
+
+    if (!loader->loadPlugin()) {
+        qWarning() << "The plugin" << loader->fileName() << "load failed: " << loader->errorString();
+        return false;
+    }
+
+    if (!loader->initialize()) {
+        qWarning() << "The plugin" << loader->fileName() << "init failed: " << loader->errorString();
+        return false;
+    }
+
+    appendExtension(loader->fileName(), loader);
+
+    return true;
+}
+
 void DFMExtPluginManagerPrivate::appendExtension(const QString &libName, const DFMExtPluginLoaderPointer &loader)
 {
     Q_ASSERT(loader);
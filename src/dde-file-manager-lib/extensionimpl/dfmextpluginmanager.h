@@ -6,6 +6,7 @@
 #define DFMEXTPLUGINMANAGER_H
 
 #include "dfmextpluginloader.h"
+#include "durl.h"
 
 #include <QString>
 #include <QObject>
@@ -47,6 +48,7 @@ public:
     bool monitorPlugins();
     bool shutdownPlugins();
     DFMExtMenus menus() const;
+    DFMExtMenus menus(const DUrl &currentUrl, const DUrlList &selected);
     DFMExtEmblemIcons emblemIcons() const;
     DFMExtMenuImplProxy *pluginMenuProxy();
     State state() const;
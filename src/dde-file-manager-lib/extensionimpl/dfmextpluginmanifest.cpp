@@ -0,0 +1,209 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dfmextpluginmanifest.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QDateTime>
+#include <QLibrary>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QSaveFile>
+#include <QDebug>
+
+// 缓存格式变化时增加版本号，旧的缓存会被丢弃
+#define PLUGIN_MANIFEST_VERSION 1
+
+static QStringList toStringList(const QJsonValue &value)
+{
+    QStringList list;
+
+    for (const QJsonValue &v : value.toArray())
+        list << v.toString();
+
+    return list;
+}
+
+DFMExtPluginManifest::DFMExtPluginManifest(const QString &cacheFile)
+    : m_cacheFile(cacheFile)
+{
+
+}
+
+/*!
+ * \brief DFMExtPluginManifest::entry 获取插件的清单，插件或其 json 文件变化时重新读取
+ */
+DFMExtPluginManifest::Entry DFMExtPluginManifest::entry(const QString &pluginPath)
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (!m_loaded)
+        load();
+
+    const QFileInfo info(pluginPath);
+    const QFileInfo manifestInfo(manifestFile(pluginPath));
+    const qint64 manifestModified = manifestInfo.exists() ? manifestInfo.lastModified().toMSecsSinceEpoch() : -1;
+    auto it = m_entries.constFind(pluginPath);
+
+    if (it != m_entries.constEnd() && it->size == info.size()
+            && it->lastModified == info.lastModified().toMSecsSinceEpoch()
+            && it->manifestModified == manifestModified) {
+        return *it;
+    }
+
+    Entry entry = probe(pluginPath);
+
+    entry.size = info.size();
+    entry.lastModified = info.lastModified().toMSecsSinceEpoch();
+    entry.manifestModified = manifestModified;
+
+    if (entry.valid && manifestModified >= 0) {
+        QFile file(manifestInfo.absoluteFilePath());
+
+        if (file.open(QIODevice::ReadOnly)) {
+            const QJsonObject &object = QJsonDocument::fromJson(file.readAll()).object();
+
+            entry.mimeTypes = toStringList(object.value("MimeTypes"));
+            entry.schemes = toStringList(object.value("Schemes"));
+        }
+    }
+
+    m_entries[pluginPath] = entry;
+    m_dirty = true;
+
+    return entry;
+}
+
+/*!
+ * \brief DFMExtPluginManifest::save 清单有变化时写入缓存文件
+ */
+bool DFMExtPluginManifest::save()
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (!m_dirty)
+        return true;
+
+    QJsonObject plugins;
+
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+        // 已删除的插件不再保存
+        if (!QFile::exists(it.key()))
+            continue;
+
+        QJsonObject object;
+
+        object["size"] = it->size;
+        object["lastModified"] = it->lastModified;
+        object["manifestModified"] = it->manifestModified;
+        object["valid"] = it->valid;
+        object["menu"] = it->hasMenu;
+        object["emblem"] = it->hasEmblem;
+        object["MimeTypes"] = QJsonArray::fromStringList(it->mimeTypes);
+        object["Schemes"] = QJsonArray::fromStringList(it->schemes);
+        plugins[it.key()] = object;
+    }
+
+    QJsonObject root;
+
+    root["version"] = PLUGIN_MANIFEST_VERSION;
+    root["plugins"] = plugins;
+
+    QDir().mkpath(QFileInfo(m_cacheFile).absolutePath());
+    QSaveFile file(m_cacheFile);
+
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Failed to save extension plugin manifest:" << file.errorString();
+        return false;
+    }
+
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+
+    if (!file.commit())
+        return false;
+
+    m_dirty = false;
+
+    return true;
+}
+
+/*!
+ * \brief DFMExtPluginManifest::matches 插件是否处理此 scheme 和 mime 类型
+ * \param mimeTypes 为空时不按 mime 类型过滤，否则只要有一个类型匹配即可
+ */
+bool DFMExtPluginManifest::matches(const Entry &entry, const QString &scheme, const QStringList &mimeTypes)
+{
+    if (!entry.schemes.isEmpty() && !entry.schemes.contains(scheme))
+        return false;
+
+    if (entry.mimeTypes.isEmpty() || mimeTypes.isEmpty())
+        return true;
+
+    for (const QString &mimeType : mimeTypes) {
+        for (const QString &type : entry.mimeTypes) {
+            if (type == mimeType || (!type.contains('/') && mimeType.startsWith(type + '/')))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+QString DFMExtPluginManifest::manifestFile(const QString &pluginPath)
+{
+    const QFileInfo info(pluginPath);
+
+    return info.absolutePath() + QDir::separator() + info.baseName() + ".json";
+}
+
+DFMExtPluginManifest::Entry DFMExtPluginManifest::probe(const QString &pluginPath)
+{
+    Entry entry;
+    QLibrary lib(pluginPath);
+
+    if (!lib.load())
+        return entry;
+
+    entry.valid = lib.resolve("dfm_extension_initiliaze") && lib.resolve("dfm_extension_shutdown");
+    entry.hasMenu = lib.resolve("dfm_extension_menu");
+    entry.hasEmblem = lib.resolve("dfm_extension_emblem");
+    lib.unload();
+
+    return entry;
+}
+
+void DFMExtPluginManifest::load()
+{
+    m_loaded = true;
+
+    QFile file(m_cacheFile);
+
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    const QJsonObject &root = QJsonDocument::fromJson(file.readAll()).object();
+
+    if (root.value("version").toInt() != PLUGIN_MANIFEST_VERSION)
+        return;
+
+    const QJsonObject &plugins = root.value("plugins").toObject();
+
+    for (auto it = plugins.constBegin(); it != plugins.constEnd(); ++it) {
+        const QJsonObject &object = it.value().toObject();
+        Entry entry;
+
+        entry.size = static_cast<qint64>(object.value("size").toDouble(-1));
+        entry.lastModified = static_cast<qint64>(object.value("lastModified").toDouble(-1));
+        entry.manifestModified = static_cast<qint64>(object.value("manifestModified").toDouble(-1));
+        entry.valid = object.value("valid").toBool();
+        entry.hasMenu = object.value("menu").toBool();
+        entry.hasEmblem = object.value("emblem").toBool();
+        entry.mimeTypes = toStringList(object.value("MimeTypes"));
+        entry.schemes = toStringList(object.value("Schemes"));
+        m_entries.insert(it.key(), entry);
+    }
+}
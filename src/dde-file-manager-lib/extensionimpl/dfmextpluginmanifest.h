@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DFMEXTPLUGINMANIFEST_H
+#define DFMEXTPLUGINMANIFEST_H
+
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QMutex>
+
+/*!
+ * \brief DFMExtPluginManifest 扩展插件的清单缓存
+ *
+ * 记录每个插件导出的接口以及它处理的 mime 类型和 scheme，插件文件没有变化时不需要 dlopen 就能知道这些信息。
+ * mime 类型和 scheme 来自与插件同名的 json 文件（如 libfoo.so 对应 libfoo.json）：
+ * \code
+ * { "MimeTypes": ["image", "application/pdf"], "Schemes": ["file"] }
+ * \endcode
+ * 只写主类型（如 "image"）时匹配其所有子类型。没有 json 文件或对应的字段为空时表示不限制。
+ */
+class DFMExtPluginManifest
+{
+public:
+    struct Entry {
+        qint64 size = -1;
+        qint64 lastModified = -1;
+        qint64 manifestModified = -1;
+        // 导出了初始化和关闭函数
+        bool valid = false;
+        bool hasMenu = false;
+        bool hasEmblem = false;
+        QStringList mimeTypes;
+        QStringList schemes;
+    };
+
+    explicit DFMExtPluginManifest(const QString &cacheFile);
+
+    Entry entry(const QString &pluginPath);
+    bool save();
+
+    static bool matches(const Entry &entry, const QString &scheme, const QStringList &mimeTypes);
+
+private:
+    static QString manifestFile(const QString &pluginPath);
+    static Entry probe(const QString &pluginPath);
+    void load();
+
+    QString m_cacheFile;
+    QHash<QString, Entry> m_entries;
+    QMutex m_mutex;
+    bool m_loaded = false;
+    bool m_dirty = false;
+};
+
+#endif // DFMEXTPLUGINMANIFEST_H
@@ -4,6 +4,7 @@ HEADERS += \
     $$PWD/private/dfmextmenuimplproxy_p.h \
     $$PWD/dfmextpluginloader.h \
     $$PWD/dfmextpluginmanager.h \
+    $$PWD/dfmextpluginmanifest.h \
     $$PWD/dfmextmenuimplproxy.h \
     $$PWD/dfmextmenuimpl.h \
     $$PWD/dfmextmendefine.h \
@@ -13,6 +14,7 @@ HEADERS += \
 SOURCES += \
     $$PWD/dfmextpluginloader.cpp \
     $$PWD/dfmextpluginmanager.cpp \
+    $$PWD/dfmextpluginmanifest.cpp \
     $$PWD/dfmextmenuimplproxy.cpp \
     $$PWD/dfmextmenuimpl.cpp \
     $$PWD/dfmextactionimpl.cpp
@@ -8,6 +8,7 @@
 #include "dfmextpluginloader.h"
 #include "dfmextpluginmanager.h"
 #include "dfmextmenuimplproxy.h"
+#include "dfmextpluginmanifest.h"
 #include "interfaces/dfilesystemwatcher.h"
 
 #include <QMap>
@@ -36,6 +37,9 @@ class DFMExtPluginManagerPrivate : public QObject
 
     //! pluginName and loader cache
     QMap<QString, DFMExtPluginLoaderPointer> loaders;
+    //! 插件导出的接口及处理的 mime 类型和 scheme，只提供菜单的插件在第一次需要时才加载
+    DFMExtPluginManifest manifest;
+    QMutex loadMutex;
     DFileSystemWatcher *extensionWathcer { nullptr };
     std::once_flag watcherFlag;
     QMutex mutex;
@@ -46,6 +50,7 @@ class DFMExtPluginManagerPrivate : public QObject
 public:
     explicit DFMExtPluginManagerPrivate(DFMExtPluginManager *qq);
     bool scanPlugin(const QString &path);
+    bool loadAndInitialize(const DFMExtPluginLoaderPointer &loader);
     void appendExtension(const QString &libName, const DFMExtPluginLoaderPointer &loader);
     void updateExtensionState(const QString &libName, DFMExtPluginManager::PluginLogicState state);
 
@@ -42,6 +42,8 @@
 #include <QStandardPaths>
 #include <QStorageInfo>
 #include <QRegularExpression>
+#include <QMutex>
+#include <QtConcurrent>
 #include <dgiofile.h>
 
 #include <disomaster.h>
@@ -53,6 +55,8 @@
 QMap<QString, QDrive> GvfsMountManager::Drives = {}; // key is unix-device
 QMap<QString, QVolume> GvfsMountManager::Volumes = {}; // key is unix-device or uuid
 QMap<QString, QMount> GvfsMountManager::Mounts = {}; // key is mount point root uri
+// Mounts 由 GVolumeMonitor 的信号更新，getMounts 可能在其它线程中读取
+static QMutex mountsMutex;
 QMap<QString, QDiskInfo> GvfsMountManager::DiskInfos = {};
 
 QStringList GvfsMountManager::Drives_Keys = {};//key is unix-device
@@ -305,8 +309,11 @@ QMount GvfsMountManager::gMountToqMount(GMount *gmount)
     root = g_mount_get_root(gmount);
     uri = g_file_get_uri(root);
     qMount.setMounted_root_uri(QString(uri));
+    char *path = g_file_get_path(root);
+    qMount.setMounted_root_path(QString(path));
     g_object_unref(root);
     g_free(uri);
+    g_free(path);
 
     default_location = g_mount_get_default_location(gmount);
     if (default_location) {
@@ -530,9 +537,11 @@ void GvfsMountManager::monitor_mount_added(GVolumeMonitor *volume_monitor, GMoun
         if (!NoVolumes_Mounts_Keys.contains(qMount.mounted_root_uri())) {
             NoVolumes_Mounts_Keys.append(qMount.mounted_root_uri());
 
-            QDiskInfo diskInfo = qMountToqDiskinfo(qMount);
+            // 网络挂载查询用量可能很慢，先发出挂载信号，用量在线程中获取后再更新
+            QDiskInfo diskInfo = qMountToqDiskinfo(qMount, false);
             DiskInfos.insert(diskInfo.id(), diskInfo);
             emit gvfsMountManager->mount_added(diskInfo);
+            updateDiskInfoUsageAsync(diskInfo);
         }
     }
 
@@ -542,6 +551,7 @@ void GvfsMountManager::monitor_mount_added(GVolumeMonitor *volume_monitor, GMoun
         RemoteMountsStashManager::stashRemoteMount(file->path(), qMount.name());
     }
 
+    QMutexLocker lk(&mountsMutex);
     Mounts.insert(qMount.mounted_root_uri(), qMount);
 }
 
@@ -568,7 +578,9 @@ void GvfsMountManager::monitor_mount_removed(GVolumeMonitor *volume_monitor, GMo
         NoVolumes_Mounts_Keys.removeOne(qMount.mounted_root_uri());
     }
 
+    mountsMutex.lock();
     bool removed = Mounts.remove(qMount.mounted_root_uri());
+    mountsMutex.unlock();
     if (removed) {
 
         if (volume.isValid()) {
@@ -1097,6 +1109,37 @@ QDiskInfo GvfsMountManager::getDiskInfo(const QString &path, bool bupdate)
     return info;
 }
 
+/*!
+ * \brief GvfsMountManager::getMounts 获取当前挂载的快照
+ *
+ * 快照由 GVolumeMonitor 的信号维护，获取时不调用 GIO，挂载卡住的网络设备时也不会阻塞
+ */
+QList<QMount> GvfsMountManager::getMounts()
+{
+    QMutexLocker lk(&mountsMutex);
+    return Mounts.values();
+}
+
+/*!
+ * \brief GvfsMountManager::updateDiskInfoUsageAsync 在线程中获取磁盘的用量，完成后更新 DiskInfos 并发出 volume_changed
+ */
+void GvfsMountManager::updateDiskInfoUsageAsync(const QDiskInfo &diskInfo)
+{
+    QtConcurrent::run([diskInfo]() {
+        QDiskInfo info = diskInfo;
+        info.updateGvfsFileSystemInfo();
+
+        QTimer::singleShot(0, gvfsMountManager, [info]() {
+            // 获取期间已被卸载
+            if (!DiskInfos.contains(info.id()))
+                return;
+
+            DiskInfos.insert(info.id(), info);
+            emit gvfsMountManager->volume_changed(info);
+        });
+    });
+}
+
 bool GvfsMountManager::isDVD(const QVolume &volume)
 {
     if (volume.drive().isValid() && volume.unix_device().startsWith("/dev/sr")) {
@@ -1230,7 +1273,9 @@ void GvfsMountManager::listMounts()
     for (c = 0, m = mounts; m != nullptr; m = m->next, c++) {
         GMount *mount = static_cast<GMount *>(m->data);
         QMount qMount = gMountToqMount(mount);
+        mountsMutex.lock();
         Mounts.insert(qMount.mounted_root_uri(), qMount);
+        mountsMutex.unlock();
         GVolume *volume = g_mount_get_volume(mount);
         if (volume != nullptr) {
             continue;
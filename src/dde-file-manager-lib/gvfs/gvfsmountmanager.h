@@ -132,6 +132,8 @@ public:
     static void printVolumeMounts();
 
     static QDiskInfo getDiskInfo(const QString& path, bool bupdate = true);
+    static QList<QMount> getMounts();
+    static void updateDiskInfoUsageAsync(const QDiskInfo& diskInfo);
     static bool isDVD(const QVolume& volume);
     static bool isIgnoreUnusedMounts(const QMount& mount);
 
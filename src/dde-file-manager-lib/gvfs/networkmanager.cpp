@@ -27,6 +27,12 @@
 #include <QRegularExpression>
 #include <QTimer>
 #include <QString>
+#include <QtConcurrent>
+
+// 网络邻居和共享列表的有效时间(毫秒)，过期后先显示缓存的列表，同时在后台重新获取
+#define NETWORK_NODES_CACHE_TTL 60000
+
+#define NETWORK_ENUMERATE_ATTRIBUTES "standard::type,standard::target-uri,standard::name,standard::display-name,standard::icon,mountable::can-mount"
 
 DFM_USE_NAMESPACE
 
@@ -95,6 +101,9 @@ QStringList NetworkManager::SupportScheme = {
 QMap<DUrl, NetworkNodeList> NetworkManager::NetworkNodes = {};
 GCancellable *NetworkManager::m_networks_fetching_cancellable = NULL;
 QPointer<QEventLoop> NetworkManager::eventLoop;
+QMap<DUrl, QElapsedTimer> NetworkManager::NetworkNodesUpdated = {};
+QSet<DUrl> NetworkManager::RefreshingUrls = {};
+static QMutex networkNodesRefreshMutex;
 NetworkManager::NetworkManager(QObject *parent) : QObject(parent)
 {
     qDebug() << "Create NetworkManager";
@@ -159,7 +168,7 @@ bool NetworkManager::fetch_networks(gchar *url, DFMEvent *e)
 
     do {
         g_file_enumerate_children_async(network_file,
-                                        "standard::type,standard::target-uri,standard::name,standard::display-name,standard::icon,mountable::can-mount",
+                                        NETWORK_ENUMERATE_ATTRIBUTES,
                                         G_FILE_QUERY_INFO_NONE,
                                         G_PRIORITY_DEFAULT,
                                         m_networks_fetching_cancellable,
@@ -285,55 +294,14 @@ void NetworkManager::network_enumeration_next_files_finished(GObject *source_obj
 
 void NetworkManager::populate_networks(GFileEnumerator *enumerator, GList *detected_networks, gpointer user_data)
 {
-    GList *l;
-    GFile *file;
-    GFile *activatable_file;
-    gchar *uri;
-    GFileType type;
-//    gchar *name;
-
     NetworkNodeList nodeList;
 
-    for (l = detected_networks; l != NULL; l = l->next) {
-        GFileInfo *fileInfo = static_cast<GFileInfo *>(l->data);
-        file = g_file_enumerator_get_child(enumerator, fileInfo);
-        type = g_file_info_get_file_type(fileInfo);
-        if (type == G_FILE_TYPE_SHORTCUT || type == G_FILE_TYPE_MOUNTABLE)
-            uri = g_file_info_get_attribute_as_string(fileInfo, G_FILE_ATTRIBUTE_STANDARD_TARGET_URI);
-        else
-            uri = g_file_get_uri(file);
-
-        activatable_file = g_file_new_for_uri(uri);
-//        name = g_file_info_get_attribute_as_string (fileInfo, G_FILE_ATTRIBUTE_STANDARD_NAME);
-        gchar *display_name = g_file_info_get_attribute_as_string(fileInfo, G_FILE_ATTRIBUTE_STANDARD_DISPLAY_NAME);
-        GIcon *icon = g_file_info_get_icon(fileInfo);
-        gchar *iconPath = g_icon_to_string(icon);
-
-        // URL Cleanup:
-        // blumia: sometimes it will happend in weird Mac mini device with a url format like: `smb://[10.0.61.210]:445/`
-        //         Wikipedia said (haven't take a look at releated RFCs) brackets should only be used with IPv6 addresses.
-        //         Not sure it's a bug of gvfs or Apple, so do a workaround cleanup here.
-        QString uriStr = QString(uri);
-        QRegularExpression re(R"reg((\[)(?:\d+\.){3}\d+(\]))reg");
-        if (re.match(uriStr).hasMatch()) {
-            uriStr.remove('[');
-            uriStr.remove(']');
-        }
-
-        NetworkNode node;
-        node.setUrl(uriStr);
-        node.setDisplayName(QString(display_name));
-        node.setIconType(QString(iconPath));
+    for (GList *l = detected_networks; l != NULL; l = l->next) {
+        const NetworkNode &node = createNetworkNode(enumerator, static_cast<GFileInfo *>(l->data));
 
         qDebug() << node;
 
         nodeList.append(node);
-
-        g_free(uri);
-        g_free(display_name);
-        g_free(iconPath);
-        g_clear_object(&file);
-        g_clear_object(&activatable_file);
     }
 
     DFMUrlBaseEvent *event = static_cast<DFMUrlBaseEvent *>(user_data);
@@ -348,6 +316,10 @@ void NetworkManager::populate_networks(GFileEnumerator *enumerator, GList *detec
 
     NetworkNodes.remove(neturl);
     NetworkNodes.insert(neturl, nodeList);
+    {
+        QMutexLocker lk(&networkNodesRefreshMutex);
+        NetworkNodesUpdated[neturl].start();
+    }
 
     addSmbServerToHistory(neturl);
     bool result = true;
@@ -369,6 +341,117 @@ void NetworkManager::populate_networks(GFileEnumerator *enumerator, GList *detec
     qDebug() << "request NetworkNodeList successfully";
 }
 
+NetworkNode NetworkManager::createNetworkNode(GFileEnumerator *enumerator, GFileInfo *fileInfo)
+{
+    GFile *file = g_file_enumerator_get_child(enumerator, fileInfo);
+    GFileType type = g_file_info_get_file_type(fileInfo);
+    gchar *uri = nullptr;
+
+    if (type == G_FILE_TYPE_SHORTCUT || type == G_FILE_TYPE_MOUNTABLE)
+        uri = g_file_info_get_attribute_as_string(fileInfo, G_FILE_ATTRIBUTE_STANDARD_TARGET_URI);
+    else
+        uri = g_file_get_uri(file);
+
+    gchar *display_name = g_file_info_get_attribute_as_string(fileInfo, G_FILE_ATTRIBUTE_STANDARD_DISPLAY_NAME);
+    GIcon *icon = g_file_info_get_icon(fileInfo);
+    gchar *iconPath = g_icon_to_string(icon);
+
+    // URL Cleanup:
+    // blumia: sometimes it will happend in weird Mac mini device with a url format like: `smb://[10.0.61.210]:445/`
+    //         Wikipedia said (haven't take a look at releated RFCs) brackets should only be used with IPv6 addresses.
+    //         Not sure it's a bug of gvfs or Apple, so do a workaround cleanup here.
+    QString uriStr = QString(uri);
+    QRegularExpression re(R"reg((\[)(?:\d+\.){3}\d+(\]))reg");
+    if (re.match(uriStr).hasMatch()) {
+        uriStr.remove('[');
+        uriStr.remove(']');
+    }
+
+    NetworkNode node;
+    node.setUrl(uriStr);
+    node.setDisplayName(QString(display_name));
+    node.setIconType(QString(iconPath));
+
+    g_free(uri);
+    g_free(display_name);
+    g_free(iconPath);
+    g_clear_object(&file);
+
+    return node;
+}
+
+/*!
+ * \brief NetworkManager::enumerateNetworks 同步获取已经可以访问的地址下的节点，不挂载，用于后台刷新
+ */
+NetworkNodeList NetworkManager::enumerateNetworks(const DUrl &url, bool *ok)
+{
+    NetworkNodeList nodeList;
+    GFile *network_file = g_file_new_for_uri(url.toString().toUtf8().constData());
+    GError *error = nullptr;
+    GFileEnumerator *enumerator = g_file_enumerate_children(network_file, NETWORK_ENUMERATE_ATTRIBUTES,
+                                                            G_FILE_QUERY_INFO_NONE, nullptr, &error);
+
+    *ok = enumerator != nullptr;
+
+    if (enumerator) {
+        while (GFileInfo *fileInfo = g_file_enumerator_next_file(enumerator, nullptr, &error)) {
+            nodeList.append(createNetworkNode(enumerator, fileInfo));
+            g_object_unref(fileInfo);
+        }
+
+        *ok = !error;
+        g_file_enumerator_close(enumerator, nullptr, nullptr);
+        g_object_unref(enumerator);
+    }
+
+    if (error) {
+        qWarning() << "refresh network locations failed:" << url << error->message;
+        g_error_free(error);
+    }
+
+    g_object_unref(network_file);
+
+    return nodeList;
+}
+
+void NetworkManager::updateNetworkNodes(const DUrl &url, const NetworkNodeList &nodes)
+{
+    // 刷新期间缓存被移除(卸载、重新连接等)时不再写回
+    if (NetworkNodes.contains(url))
+        NetworkNodes.insert(url, nodes);
+}
+
+/*!
+ * \brief NetworkManager::refreshNetworksIfExpired 缓存的节点列表过期时在后台重新获取
+ *
+ * 调用者直接使用缓存的列表，打开网络邻居和共享列表不必等待网络。刷新失败时保留原来的列表，
+ * 同样在过期后才再次尝试，连接不上的主机不会被反复访问。
+ */
+void NetworkManager::refreshNetworksIfExpired(const DUrl &url)
+{
+    QMutexLocker lk(&networkNodesRefreshMutex);
+
+    const QElapsedTimer &updated = NetworkNodesUpdated.value(url);
+    if (RefreshingUrls.contains(url) || (updated.isValid() && !updated.hasExpired(NETWORK_NODES_CACHE_TTL)))
+        return;
+
+    RefreshingUrls.insert(url);
+
+    QtConcurrent::run([url] {
+        bool ok = false;
+        const NetworkNodeList &nodes = enumerateNetworks(url, &ok);
+
+        QTimer::singleShot(0, Singleton<NetworkManager>::instance(), [url, nodes, ok] {
+            if (ok)
+                updateNetworkNodes(url, nodes);
+
+            QMutexLocker lk(&networkNodesRefreshMutex);
+            NetworkNodesUpdated[url].start();
+            RefreshingUrls.remove(url);
+        });
+    });
+}
+
 void NetworkManager::restartGVFSD()
 {
     QProcess p;
@@ -19,6 +19,8 @@ extern "C" {
 
 #include <QMutex>
 #include <QWaitCondition>
+#include <QElapsedTimer>
+#include <QSet>
 
 class NetworkNode
 {
@@ -82,6 +84,7 @@ public:
     static void populate_networks (GFileEnumerator *enumerator, GList *detected_networks, gpointer user_data);
     static void restartGVFSD();
     static bool isFetchingNetworks();
+    static void refreshNetworksIfExpired(const DUrl &url);
 
 signals:
     void mountFailed(const DUrl &url);
@@ -91,7 +94,15 @@ public slots:
     static void cancelFeatchNetworks();
 
 private:
+    static NetworkNode createNetworkNode(GFileEnumerator *enumerator, GFileInfo *fileInfo);
+    static NetworkNodeList enumerateNetworks(const DUrl &url, bool *ok);
+    static void updateNetworkNodes(const DUrl &url, const NetworkNodeList &nodes);
+
     static QPointer<QEventLoop> eventLoop;
+    //! 每个地址的节点列表最近一次获取的时间
+    static QMap<DUrl, QElapsedTimer> NetworkNodesUpdated;
+    //! 正在后台刷新的地址
+    static QSet<DUrl> RefreshingUrls;
 };
 
 #endif // NETWORKMANAGER_H
@@ -94,6 +94,16 @@ void QMount::setMounted_root_uri(const QString &mounted_root_uri)
     m_mounted_root_uri = mounted_root_uri;
 }
 
+QString QMount::mounted_root_path() const
+{
+    return m_mounted_root_path;
+}
+
+void QMount::setMounted_root_path(const QString &mounted_root_path)
+{
+    m_mounted_root_path = mounted_root_path;
+}
+
 QDebug operator<<(QDebug dbg, const QMount &mount)
 {
     dbg << "QMount: {"
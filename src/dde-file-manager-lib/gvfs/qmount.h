@@ -41,9 +41,13 @@ public:
     QString mounted_root_uri() const;
     void setMounted_root_uri(const QString &mounted_root_uri);
 
+    QString mounted_root_path() const;
+    void setMounted_root_path(const QString &mounted_root_path);
+
 private:
     QString m_name;
     QString m_mounted_root_uri;
+    QString m_mounted_root_path; // gvfsd-fuse 下的本地路径
     QString m_uuid;
     QString m_default_location;
     QStringList m_icons;
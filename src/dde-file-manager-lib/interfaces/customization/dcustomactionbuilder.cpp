@@ -9,6 +9,7 @@
 #include <QUrl>
 #include <QMenu>
 #include <QFontMetrics>
+#include <QSet>
 
 DCustomActionBuilder::DCustomActionBuilder(QObject *parent)
     : QObject(parent)
@@ -171,8 +172,15 @@ QList<DCustomActionEntry> DCustomActionBuilder::matchActions(const DUrlList &sel
      *action支持类型过滤(类型过滤要加上父类型一起过滤)
     */
 
+    //协议、后缀、类型都相同的文件匹配结果相同，每种组合只需要匹配一次，选中大量文件时不必逐个匹配所有菜单项
+    QSet<QString> matchedKeys;
+
     //具体配置过滤
     for (auto &singleUrl : selects) {
+        //所有菜单项都已被过滤
+        if (oriActions.isEmpty())
+            break;
+
         //协议、后缀
         DAbstractFileInfoPointer fileInfo;
         fileInfo = DFileService::instance()->createFileInfo(nullptr, singleUrl);
@@ -181,6 +189,13 @@ QList<DCustomActionEntry> DCustomActionBuilder::matchActions(const DUrlList &sel
             continue;
         }
 
+        const QString &matchKey = QString("%1\n%2\n%3").arg(singleUrl.scheme())
+                .arg(fileInfo->isDir() ? QString("/") : QFileInfo(singleUrl.toLocalFile()).completeSuffix())
+                .arg(fileInfo->mimeType().name());
+        if (matchedKeys.contains(matchKey))
+            continue;
+        matchedKeys.insert(matchKey);
+
         /*
          * 选中文件类型过滤：
          * fileMimeTypes:包括所有父类型的全量类型集合
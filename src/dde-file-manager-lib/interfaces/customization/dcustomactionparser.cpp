@@ -116,6 +116,7 @@ bool DCustomActionParser::loadDir(const QString &dirPath)
     if (!dir.exists())
         return false;
     m_actionEntry.clear();
+    m_actionIndexValid = false;
 
     m_fileWatcher->removePaths(m_fileWatcher->files());
 
@@ -148,6 +149,34 @@ QList<DCustomActionEntry> DCustomActionParser::getActionFiles(bool onDesktop)
     return ret;
 }
 
+/*!
+    返回在桌面/文管（\a onDesktop）中显示且支持文件组合 \a combo 的菜单项。
+    菜单项在第一次使用时按显示位置和文件组合分组，弹出菜单时不必再遍历所有菜单项。
+*/
+QList<DCustomActionEntry> DCustomActionParser::getActionFiles(bool onDesktop, ComboType combo)
+{
+    if (!m_actionIndexValid) {
+        m_actionIndex[0].clear();
+        m_actionIndex[1].clear();
+
+        static const ComboType combos[] = { BlankSpace, SingleFile, SingleDir, MultiFiles, MultiDirs, FileAndDir };
+        for (const DCustomActionEntry &entry : m_actionEntry) {
+            for (int desktop = 0; desktop < 2; ++desktop) {
+                if (!isActionShouldShow(entry.m_notShowIn, desktop == 1))
+                    continue;
+
+                for (ComboType type : combos) {
+                    if (entry.m_fileCombo & type)
+                        m_actionIndex[desktop][type] << entry;
+                }
+            }
+        }
+        m_actionIndexValid = true;
+    }
+
+    return m_actionIndex[onDesktop ? 1 : 0].value(combo);
+}
+
 /*!
     根据传入的\a actionSetting 解析菜单项，返回返回值为解析成功与否，关键字段缺失会被断定未无效文件，归于失败
 */
@@ -339,6 +368,7 @@ bool DCustomActionParser::parseFile(QList<DCustomActionData> &childrenActions, Q
         tpEntry.m_comment = basicInfos.m_comment;
         tpEntry.m_data = actData;
         m_actionEntry.append(tpEntry);
+        m_actionIndexValid = false;
     }
     else {
         childrenActions.append(actData);
@@ -499,6 +529,7 @@ void DCustomActionParser::delayRefresh()
     m_refreshTimer = new QTimer;
     connect(m_refreshTimer,&QTimer::timeout,this,[this](){
         m_actionEntry.clear();
+        m_actionIndexValid = false;
 
         qInfo() << "loading custom menus" << this;
         loadDir(kCustomMenuPath);
@@ -35,6 +35,7 @@ public:
 
     bool loadDir(const QString &dirPath);
     QList<DCustomActionEntry> getActionFiles(bool onDesktop);
+    QList<DCustomActionEntry> getActionFiles(bool onDesktop, DCustomActionDefines::ComboType combo);
 
     bool parseFile(QSettings &actionSetting);
     bool parseFile(QList<DCustomActionData> &childrenActions
@@ -62,6 +63,9 @@ private:
     QTimer *m_refreshTimer = nullptr;
     QFileSystemWatcher  *m_fileWatcher  = nullptr;
     QList<DCustomActionEntry> m_actionEntry;
+    //! 按显示位置（桌面/文管）和文件组合预先分组的菜单项，配置文件变化后重新生成
+    QHash<int, QList<DCustomActionEntry>> m_actionIndex[2];
+    bool m_actionIndexValid = false;
     QSettings::Format m_customFormat;
     QHash<QString, DCustomActionDefines::ComboType> m_combos;
     QHash<QString, DCustomActionDefines::Separator> m_separtor;
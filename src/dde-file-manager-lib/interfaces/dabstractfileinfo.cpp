@@ -20,6 +20,8 @@
 #include "controllers/vaultcontroller.h"
 #include "dfileservices.h"
 #include "dmimedatabase.h"
+#include "dfmpathkey.h"
+#include "dfmmetrics.h"
 
 #include "app/define.h"
 #include "shutil/mimesappsmanager.h"
@@ -97,7 +99,85 @@ bool compareByString(const QString &str1, const QString &str2, Qt::SortOrder ord
     return ((order == Qt::DescendingOrder) ^ (sortCollator.compare(str1, str2) < 0)) == 0x01;
 }
 
-COMPARE_FUN_DEFINE(fileDisplayName, DisplayName, DAbstractFileInfo)
+/*!
+ * \brief 文件显示名称的排序键
+ *
+ * 排序时每次比较都要对两个字符串做完整的collation，并构造正则判断是否以符号开头。
+ * 排序键在创建节点时生成一次，之后的比较只需要比较分组和字节序列，结果与compareByString一致。
+ */
+class NameSortKey
+{
+public:
+    NameSortKey(const QString &name, const QCollatorSortKey &key)
+        : name(name)
+        , key(key)
+        , group(nameGroup(name))
+    {
+    }
+
+    // 与compareByString的判断顺序一致：符号开头的排在最后，其次是中文开头的
+    static int nameGroup(const QString &name)
+    {
+        return (DFMGlobal::startWithSymbol(name) ? 2 : 0) + (DFMGlobal::startWithHanzi(name) ? 1 : 0);
+    }
+
+    // 非ICU的QCollator不支持数字模式的排序键，此时不使用排序键
+    static bool isUsable()
+    {
+        static const bool usable = [] {
+            DCollator collator;
+            return collator.sortKey("a2").compare(collator.sortKey("a10")) < 0
+                   && collator.sortKey("A").compare(collator.sortKey("a")) == 0;
+        }();
+
+        return usable;
+    }
+
+    const QString name;
+    const QCollatorSortKey key;
+    const int group;
+};
+
+bool compareByDisplayName(const DAbstractFileInfoPointer &info1, const DAbstractFileInfoPointer &info2, Qt::SortOrder order)
+{
+    const QString &name1 = info1->fileDisplayName();
+    const QString &name2 = info2->fileDisplayName();
+    const NameSortKey *key1 = info1->d_func()->nameSortKey.loadAcquire();
+    const NameSortKey *key2 = info2->d_func()->nameSortKey.loadAcquire();
+
+    // 显示名称可能在生成排序键后发生变化（如切换语言），此时排序键已失效
+    if (!key1 || !key2 || key1->name != name1 || key2->name != name2)
+        return compareByString(name1, name2, order);
+
+    if (key1->group != key2->group)
+        return ((order == Qt::DescendingOrder) ^ (key1->group < key2->group)) == 0x01;
+
+    return ((order == Qt::DescendingOrder) ^ (key1->key.compare(key2->key) < 0)) == 0x01;
+}
+
+bool compareFileListByDisplayName(const DAbstractFileInfoPointer &info1, const DAbstractFileInfoPointer &info2, Qt::SortOrder order, bool isMixedSort)
+{
+    if (!info1 || !info2)
+        return false;
+
+    if (!isMixedSort) {
+        bool isDir1 = info1->isDir();
+        bool isDir2 = info2->isDir();
+
+        if (isDir1) {
+            if (!isDir2) return true;
+        } else {
+            if (isDir2) return false;
+        }
+    }
+
+    // 与其它排序方式一致，名称相同时按升序比较的结果返回
+    if (info1->fileDisplayName() == info2->fileDisplayName())
+        return false;
+
+    return compareByDisplayName(info1, info2, order);
+}
+
 COMPARE_FUN_DEFINE(fileSize, Size, DAbstractFileInfo)
 COMPARE_FUN_DEFINE(lastModified, Modified, DAbstractFileInfo)
 COMPARE_FUN_DEFINE(fileTypeDisplayName, Mime, DAbstractFileInfo)
@@ -109,34 +189,99 @@ COMPARE_FUN_DEFINE(lastRead, LastRead, DAbstractFileInfo)
     Q_D(const DAbstractFileInfo);\
     if (d->proxy) return d->proxy->Fun;
 
-QMap<DUrl, DAbstractFileInfo *> DAbstractFileInfoPrivate::urlToFileInfoMap;
-QReadWriteLock *DAbstractFileInfoPrivate::urlToFileInfoMapLock = new QReadWriteLock();
+// url到文件信息的索引分片数，必须是2的幂
+#define FILE_INFO_REGISTRY_SHARD_COUNT 64
+
+namespace {
+/*!
+ * \brief FileInfoRegistry 记录已创建的文件信息，供DAbstractFileInfo::getFileInfo复用
+ *
+ * 只保存指针，不持有对象，文件信息析构时从中移除。
+ * 以驻留的 DFMPathKey 为键，哈希值只在创建键时计算一次，并按哈希值分片，
+ * 每个分片使用独立的锁和哈希表，多个线程同时创建、析构文件信息时只在同一个分片上竞争。
+ */
+class FileInfoRegistry
+{
+public:
+    void insert(const DFMPathKey &key, DAbstractFileInfo *info)
+    {
+        Shard &s = shard(key);
+        QWriteLocker locker(&s.lock);
+
+        s.infos.insert(key, info);
+    }
+
+    // 只有记录的仍是此对象时才移除，同一url可能已被新的文件信息替换
+    void remove(const DFMPathKey &key, const DAbstractFileInfo *info)
+    {
+        Shard &s = shard(key);
+
+        {
+            QReadLocker locker(&s.lock);
+
+            if (s.infos.value(key) != info)
+                return;
+        }
+
+        QWriteLocker locker(&s.lock);
+        auto it = s.infos.find(key);
+
+        if (it != s.infos.end() && it.value() == info)
+            s.infos.erase(it);
+    }
+
+    DAbstractFileInfo *value(const DFMPathKey &key)
+    {
+        Shard &s = shard(key);
+        QReadLocker locker(&s.lock);
+
+        return s.infos.value(key);
+    }
+
+private:
+    struct Shard
+    {
+        QReadWriteLock lock;
+        QHash<DFMPathKey, DAbstractFileInfo *> infos;
+    };
+
+    Shard &shard(const DFMPathKey &key)
+    {
+        return shards[key.hash() & (FILE_INFO_REGISTRY_SHARD_COUNT - 1)];
+    }
+
+    Shard shards[FILE_INFO_REGISTRY_SHARD_COUNT];
+};
+
+FileInfoRegistry *fileInfoRegistry()
+{
+    // 不释放，程序退出时静态对象中的文件信息析构后仍会访问
+    static FileInfoRegistry *registry = new FileInfoRegistry();
+
+    return registry;
+}
+} // namespace
+
 DMimeDatabase DAbstractFileInfoPrivate::mimeDatabase;
 
 DAbstractFileInfoPrivate::DAbstractFileInfoPrivate(const DUrl &url, DAbstractFileInfo *qq, bool hasCache)
     : q_ptr(qq)
     , fileUrl(url)
 {
+    DFM_METRIC_INC("fileInfo.count");
+
     //###(zccrs): 只在主线程中开启缓存，防止不同线程中持有同一对象时的竞争问题
     if (hasCache && (url.isValid() && (QThread::currentThread()) &&  qApp && qApp->thread() && QThread::currentThread() == qApp->thread())) {
-        QWriteLocker locker(urlToFileInfoMapLock);
-        Q_UNUSED(locker)
-
-        urlToFileInfoMap[url] = qq;
+        fileInfoRegistry()->insert(url, qq);
     }
 }
 
 DAbstractFileInfoPrivate::~DAbstractFileInfoPrivate()
 {
-    QReadLocker read_locker(urlToFileInfoMapLock);
-    if (urlToFileInfoMap.value(fileUrl) == q_ptr) {
-        read_locker.unlock();
-        QWriteLocker write_locker(urlToFileInfoMapLock);
-        Q_UNUSED(write_locker)
-        urlToFileInfoMap.remove(fileUrl);
-    } else {
-        read_locker.unlock();
-    }
+    delete nameSortKey.loadAcquire();
+
+    fileInfoRegistry()->remove(fileUrl, q_ptr);
+    DFM_METRIC_ADD("fileInfo.count", -1);
 }
 
 void DAbstractFileInfoPrivate::setUrl(const DUrl &url, bool hasCache)
@@ -145,16 +290,10 @@ void DAbstractFileInfoPrivate::setUrl(const DUrl &url, bool hasCache)
         return;
     }
 
-    if (urlToFileInfoMap.value(fileUrl) == q_ptr) {
-        QWriteLocker locker(urlToFileInfoMapLock);
-        Q_UNUSED(locker)
-        urlToFileInfoMap.remove(fileUrl);
-    }
+    fileInfoRegistry()->remove(fileUrl, q_ptr);
 
     if (hasCache) {
-        QWriteLocker locker(urlToFileInfoMapLock);
-        Q_UNUSED(locker)
-        urlToFileInfoMap[url] = q_ptr;
+        fileInfoRegistry()->insert(url, q_ptr);
     }
     fileUrl = url;
 }
@@ -169,7 +308,7 @@ DAbstractFileInfo *DAbstractFileInfoPrivate::getFileInfo(const DUrl &fileUrl)
     if (!fileUrl.isValid()) {
         return nullptr;
     }
-    return urlToFileInfoMap.value(fileUrl);
+    return fileInfoRegistry()->value(fileUrl);
 }
 
 DAbstractFileInfo::DAbstractFileInfo(const DUrl &url, bool hasCache)
@@ -324,6 +463,22 @@ QString DAbstractFileInfo::fileDisplayPinyinName() const
     return d->pinyinName;
 }
 
+void DAbstractFileInfo::makeDisplayNameSortKey() const
+{
+    Q_D(const DAbstractFileInfo);
+
+    if (d->nameSortKey.loadAcquire() || !FileSortFunction::NameSortKey::isUsable())
+        return;
+
+    thread_local static FileSortFunction::DCollator sortCollator;
+    const QString &name = fileDisplayName();
+    const FileSortFunction::NameSortKey *key = new FileSortFunction::NameSortKey(name, sortCollator.sortKey(name));
+
+    // 可能在多个线程中同时生成，只保留第一个
+    if (!d->nameSortKey.testAndSetOrdered(nullptr, key))
+        delete key;
+}
+
 bool DAbstractFileInfo::canRename() const
 {
     CALL_PROXY(canRename());
@@ -1532,12 +1687,24 @@ bool DAbstractFileInfo::isActive() const
 
 void DAbstractFileInfo::refresh(const bool isForce)
 {
+    d_ptr->refreshVersion.ref();
+
     CALL_PROXY(refresh(isForce));
 #ifdef SW_LABEL
     updateLabelMenuItems();
 #endif
 }
 
+/*!
+ * \brief DAbstractFileInfo::refreshVersion 文件信息的刷新次数，有代理时包含代理对象的刷新次数
+ */
+int DAbstractFileInfo::refreshVersion() const
+{
+    Q_D(const DAbstractFileInfo);
+
+    return d->refreshVersion.load() + (d->proxy ? d->proxy->refreshVersion() : 0);
+}
+
 DAbstractFileInfo::DAbstractFileInfo(DAbstractFileInfoPrivate &dd)
     : d_ptr(&dd)
 {
@@ -48,12 +48,12 @@
             }\
             \
             if ((isDir1 && isDir2 && (value1 == value2)) || (isFile1 && isFile2 && (value1 == value2))) {\
-                return compareByString(info1->fileDisplayName(), info2->fileDisplayName());\
+                return compareByDisplayName(info1, info2);\
             }\
             \
         } else {\
             if (value1 == value2)\
-                return compareByString(info1->fileDisplayName(), info2->fileDisplayName());\
+                return compareByDisplayName(info1, info2);\
         }\
         bool isStrType = typeid(value1) == typeid(QString);\
         if (isStrType)\
@@ -80,6 +80,16 @@ typedef std::function<const DAbstractFileInfoPointer(int)> getFileInfoFun;
 typedef DFMGlobal::MenuAction MenuAction;
 class DAbstractFileInfoPrivate;
 
+namespace FileSortFunction {
+// 按显示名称比较，两个文件都已生成排序键时直接比较排序键，否则回退到compareByString
+bool compareByDisplayName(const DAbstractFileInfoPointer &info1, const DAbstractFileInfoPointer &info2, Qt::SortOrder order = Qt::AscendingOrder);
+// 文件模型对以下排序方式预先计算排序值，需要判断排序函数是否为这些函数
+bool compareFileListBySize(const DAbstractFileInfoPointer &info1, const DAbstractFileInfoPointer &info2, Qt::SortOrder order, bool isMixedSort);
+bool compareFileListByModified(const DAbstractFileInfoPointer &info1, const DAbstractFileInfoPointer &info2, Qt::SortOrder order, bool isMixedSort);
+bool compareFileListByCreated(const DAbstractFileInfoPointer &info1, const DAbstractFileInfoPointer &info2, Qt::SortOrder order, bool isMixedSort);
+bool compareFileListByLastRead(const DAbstractFileInfoPointer &info1, const DAbstractFileInfoPointer &info2, Qt::SortOrder order, bool isMixedSort);
+}
+
 
 #ifdef SW_LABEL
 
@@ -157,6 +167,8 @@ public:
     virtual QString fileDisplayName() const;
     virtual QString fileSharedName() const;
     QString fileDisplayPinyinName() const;
+    // 生成按名称排序使用的排序键，已生成时不做任何事
+    void makeDisplayNameSortKey() const;
 
     virtual bool canRename() const;
     virtual bool canShare() const;
@@ -305,6 +317,8 @@ public:
     bool isActive() const;
     //优化gvfs文件卡，其他文件不改变，只有gvfs文件，传入true为强制刷新
     virtual void refresh(const bool isForce = false);
+    // 每次调用 refresh 后增加，用于判断根据文件信息生成的缓存是否失效
+    int refreshVersion() const;
 
     virtual DUrl goToUrlWhenDeleted() const;
     virtual QString toLocalFile() const;
@@ -375,6 +389,8 @@ protected:
 private:
     Q_DISABLE_COPY(DAbstractFileInfo)
 
+    friend bool FileSortFunction::compareByDisplayName(const DAbstractFileInfoPointer &info1, const DAbstractFileInfoPointer &info2, Qt::SortOrder order);
+
 #ifdef SW_LABEL
 public:
     QString getLabelIcon() const;
@@ -4,10 +4,14 @@
 
 #include "dabstractfilewatcher.h"
 #include "private/dabstractfilewatcher_p.h"
+#include "dfilestatisticsjob.h"
+#include "dfmmetrics.h"
 
 #include <QEvent>
 #include <QDebug>
 
+DFM_USE_NAMESPACE
+
 QList<DAbstractFileWatcher *> DAbstractFileWatcherPrivate::watcherList;
 DAbstractFileWatcherPrivate::DAbstractFileWatcherPrivate(DAbstractFileWatcher *qq)
     : q_ptr(qq)
@@ -55,6 +59,7 @@ DAbstractFileWatcher::~DAbstractFileWatcher()
 {
     stopWatcher();
     DAbstractFileWatcherPrivate::watcherList.removeOne(this);
+    DFM_METRIC_ADD("watcher.count", -1);
 }
 
 DUrl DAbstractFileWatcher::fileUrl() const
@@ -164,6 +169,17 @@ DAbstractFileWatcher::DAbstractFileWatcher(DAbstractFileWatcherPrivate &dd,
 
     d_ptr->url = url;
     DAbstractFileWatcherPrivate::watcherList << this;
+    DFM_METRIC_INC("watcher.count");
+
+    // 文件变化后目录的统计缓存失效
+    connect(this, &DAbstractFileWatcher::subfileCreated, this, &DFileStatisticsJob::invalidateCache);
+    connect(this, &DAbstractFileWatcher::fileDeleted, this, &DFileStatisticsJob::invalidateCache);
+    connect(this, &DAbstractFileWatcher::fileModified, this, &DFileStatisticsJob::invalidateCache);
+    connect(this, &DAbstractFileWatcher::fileClosed, this, &DFileStatisticsJob::invalidateCache);
+    connect(this, &DAbstractFileWatcher::fileMoved, this, [](const DUrl &fromUrl, const DUrl &toUrl) {
+        DFileStatisticsJob::invalidateCache(fromUrl);
+        DFileStatisticsJob::invalidateCache(toUrl);
+    });
 }
 
 #include "moc_dabstractfilewatcher.cpp"
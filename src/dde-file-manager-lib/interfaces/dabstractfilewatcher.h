@@ -38,6 +38,8 @@ signals:
     void subfileCreated(const DUrl &url);
     void fileModified(const DUrl &url);
     void fileClosed(const DUrl &url);
+    //! 系统的事件队列溢出，期间的文件变化可能已丢失，需要重新检查监视的目录
+    void eventsLost();
 
 protected:
     explicit DAbstractFileWatcher(DAbstractFileWatcherPrivate &dd, const DUrl &url, QObject *parent = nullptr);
@@ -0,0 +1,411 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dfanotifywatcher.h"
+#include "private/dfanotifywatcher_p.h"
+
+#include <QApplication>
+#include <QFile>
+#include <QDir>
+#include <QDebug>
+
+#if defined(Q_OS_LINUX)
+#include <sys/fanotify.h>
+#include <sys/statfs.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <limits.h>
+#include <errno.h>
+#endif
+
+// FAN_REPORT_DFID_NAME 需要 5.9 以上的内核头文件，旧的系统上只使用 inotify
+#if defined(Q_OS_LINUX) && defined(FAN_REPORT_DFID_NAME) && defined(FAN_MARK_FILESYSTEM)
+#define FANOTIFY_SUBTREE_SUPPORTED
+#endif
+
+//! 收到事件后等待更多事件的时间（ms）
+#define FANOTIFY_READ_DELAY 10
+//! 每次 read 的缓冲区大小
+#define FANOTIFY_BUFFER_SIZE (64 * 1024)
+
+Q_GLOBAL_STATIC(DFanotifyWatcher, fanotifyWatcher)
+
+static int initFanotify()
+{
+#ifdef FANOTIFY_SUBTREE_SUPPORTED
+    int fd = fanotify_init(FAN_CLASS_NOTIF | FAN_REPORT_DFID_NAME | FAN_CLOEXEC | FAN_NONBLOCK, O_RDONLY | O_CLOEXEC | O_LARGEFILE);
+    if (fd < 0)
+        qInfo() << "fanotify is not available, use inotify to watch files:" << strerror(errno);
+
+    return fd;
+#else
+    return -1;
+#endif
+}
+
+#ifdef FANOTIFY_SUBTREE_SUPPORTED
+static quint64 fsidToKey(const int val[2])
+{
+    return (quint64(quint32(val[0])) << 32) | quint32(val[1]);
+}
+
+static const quint64 kEventMask = FAN_CREATE | FAN_DELETE | FAN_MOVED_FROM | FAN_MOVED_TO
+        | FAN_ATTRIB | FAN_MODIFY | FAN_CLOSE_WRITE | FAN_ONDIR;
+#endif
+
+static QString parentPath(const QString &path)
+{
+    const int index = path.lastIndexOf(QDir::separator());
+
+    return index > 0 ? path.left(index) : QString(QDir::separator());
+}
+
+DFanotifyWatcherPrivate::DFanotifyWatcherPrivate(int fd, DFanotifyWatcher *qq)
+    : q_ptr(qq)
+    , fanotifyFd(fd)
+    , readTimer(qq)
+{
+    if (fanotifyFd < 0)
+        return;
+
+    notifier = new QSocketNotifier(fanotifyFd, QSocketNotifier::Read, qq);
+
+    readTimer.setSingleShot(true);
+    readTimer.setInterval(FANOTIFY_READ_DELAY);
+    qq->connect(&readTimer, SIGNAL(timeout()), q_ptr, SLOT(_q_readFromFanotify()));
+    qq->connect(notifier, SIGNAL(activated(int)), q_ptr, SLOT(_q_scheduleRead()));
+}
+
+DFanotifyWatcherPrivate::~DFanotifyWatcherPrivate()
+{
+    if (fanotifyFd < 0)
+        return;
+
+    notifier->setEnabled(false);
+
+    for (const FileSystemMark &mark : fileSystems)
+        ::close(mark.mountFd);
+
+    ::close(fanotifyFd);
+}
+
+/*!
+ * \brief DFanotifyWatcherPrivate::markFileSystem 为 path 所在的文件系统添加标记，已添加过时只增加引用计数
+ */
+bool DFanotifyWatcherPrivate::markFileSystem(const QString &path, quint64 *fsid)
+{
+#ifdef FANOTIFY_SUBTREE_SUPPORTED
+    const QByteArray &localPath = QFile::encodeName(path);
+
+    struct statfs fs;
+    if (statfs(localPath.constData(), &fs) != 0)
+        return false;
+
+    // glibc 中 fsid_t 的成员名为 __val
+    *fsid = fsidToKey(reinterpret_cast<const int *>(&fs.f_fsid));
+
+    auto it = fileSystems.find(*fsid);
+    if (it != fileSystems.end()) {
+        ++it->refCount;
+        return true;
+    }
+
+    int mountFd = ::open(localPath.constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (mountFd < 0)
+        return false;
+
+    // 没有 CAP_SYS_ADMIN 时返回 EPERM，不支持 fsid 的文件系统返回 ENODEV/EXDEV
+    if (fanotify_mark(fanotifyFd, FAN_MARK_ADD | FAN_MARK_FILESYSTEM, kEventMask, AT_FDCWD, localPath.constData()) != 0) {
+        qInfo() << "fanotify mark failed, use inotify to watch" << path << strerror(errno);
+        ::close(mountFd);
+        return false;
+    }
+
+    FileSystemMark &mark = fileSystems[*fsid];
+    mark.mountFd = mountFd;
+    mark.refCount = 1;
+    mark.markPath = path;
+
+    return true;
+#else
+    Q_UNUSED(path)
+    Q_UNUSED(fsid)
+
+    return false;
+#endif
+}
+
+void DFanotifyWatcherPrivate::unmarkFileSystem(quint64 fsid)
+{
+#ifdef FANOTIFY_SUBTREE_SUPPORTED
+    auto it = fileSystems.find(fsid);
+    if (it == fileSystems.end() || --it->refCount > 0)
+        return;
+
+    fanotify_mark(fanotifyFd, FAN_MARK_REMOVE | FAN_MARK_FILESYSTEM, kEventMask, AT_FDCWD,
+                  QFile::encodeName(it->markPath).constData());
+    ::close(it->mountFd);
+    fileSystems.erase(it);
+#else
+    Q_UNUSED(fsid)
+#endif
+}
+
+/*!
+ * \brief DFanotifyWatcherPrivate::resolveDirectory 将事件中的目录句柄转换为路径，目录已不存在时返回空
+ */
+QString DFanotifyWatcherPrivate::resolveDirectory(quint64 fsid, void *handle) const
+{
+#ifdef FANOTIFY_SUBTREE_SUPPORTED
+    auto it = fileSystems.constFind(fsid);
+    if (it == fileSystems.constEnd())
+        return QString();
+
+    int fd = open_by_handle_at(it->mountFd, static_cast<file_handle *>(handle), O_PATH | O_CLOEXEC);
+    if (fd < 0)
+        return QString();
+
+    char buffer[PATH_MAX];
+    const QByteArray &link = "/proc/self/fd/" + QByteArray::number(fd);
+    ssize_t len = readlink(link.constData(), buffer, sizeof(buffer));
+    ::close(fd);
+
+    if (len <= 0 || len >= static_cast<ssize_t>(sizeof(buffer)))
+        return QString();
+
+    return QFile::decodeName(QByteArray(buffer, static_cast<int>(len)));
+#else
+    Q_UNUSED(fsid)
+    Q_UNUSED(handle)
+
+    return QString();
+#endif
+}
+
+// 需持有 mutex
+bool DFanotifyWatcherPrivate::isPathWatched(const QString &path) const
+{
+    if (subtrees.isEmpty())
+        return false;
+
+    QString current = path;
+    while (!current.isEmpty()) {
+        if (subtrees.contains(current))
+            return true;
+
+        if (current == QDir::separator())
+            break;
+
+        current = parentPath(current);
+    }
+
+    return false;
+}
+
+void DFanotifyWatcherPrivate::flushPendingMove()
+{
+    Q_Q(DFanotifyWatcher);
+
+    if (!hasPendingMove)
+        return;
+
+    // 移出了监视的文件系统，与 inotify 相同只发出移动的源路径
+    hasPendingMove = false;
+    emit q->fileMoved(pendingMovePath, pendingMoveName, QString(), QString(), DFanotifyWatcher::QPrivateSignal());
+}
+
+void DFanotifyWatcherPrivate::_q_scheduleRead()
+{
+    notifier->setEnabled(false);
+    readTimer.start();
+}
+
+void DFanotifyWatcherPrivate::_q_readFromFanotify()
+{
+#ifdef FANOTIFY_SUBTREE_SUPPORTED
+    Q_Q(DFanotifyWatcher);
+
+    notifier->setEnabled(true);
+
+    QByteArray buffer(FANOTIFY_BUFFER_SIZE, Qt::Uninitialized);
+    bool overflowed = false;
+
+    forever {
+        ssize_t len = read(fanotifyFd, buffer.data(), static_cast<size_t>(buffer.size()));
+        if (len <= 0)
+            break;
+
+        auto *meta = reinterpret_cast<fanotify_event_metadata *>(buffer.data());
+        for (; FAN_EVENT_OK(meta, len); meta = FAN_EVENT_NEXT(meta, len)) {
+            if (meta->vers != FANOTIFY_METADATA_VERSION)
+                continue;
+
+            if (meta->mask & FAN_Q_OVERFLOW) {
+                overflowed = true;
+                continue;
+            }
+
+            auto *info = reinterpret_cast<fanotify_event_info_fid *>(meta + 1);
+            if (info->hdr.info_type != FAN_EVENT_INFO_TYPE_DFID_NAME)
+                continue;
+
+            auto *handle = reinterpret_cast<file_handle *>(info->handle);
+            const char *fileName = reinterpret_cast<const char *>(handle->f_handle + handle->handle_bytes);
+            const quint64 fsid = fsidToKey(reinterpret_cast<const int *>(&info->fsid));
+
+            QString path = resolveDirectory(fsid, handle);
+            if (path.isEmpty())
+                continue;
+
+            QString name = QFile::decodeName(fileName);
+            if (name == ".") {
+                name = path.mid(path.lastIndexOf(QDir::separator()) + 1);
+                path = parentPath(path);
+            }
+
+            const QString &filePath = path.endsWith(QDir::separator()) ? path + name : path + QDir::separator() + name;
+
+            QMutexLocker lk(&mutex);
+            // 文件系统标记会收到整个文件系统的事件，只处理监视的目录树中的
+            const bool watched = isPathWatched(path) || subtrees.contains(filePath);
+            lk.unlock();
+
+            if (!(meta->mask & FAN_MOVED_TO))
+                flushPendingMove();
+
+            if (!watched)
+                continue;
+
+            if (meta->mask & FAN_CREATE)
+                emit q->fileCreated(path, name, DFanotifyWatcher::QPrivateSignal());
+
+            if (meta->mask & FAN_MOVED_FROM) {
+                pendingMovePath = path;
+                pendingMoveName = name;
+                hasPendingMove = true;
+            }
+
+            if (meta->mask & FAN_MOVED_TO) {
+                if (hasPendingMove) {
+                    hasPendingMove = false;
+                    emit q->fileMoved(pendingMovePath, pendingMoveName, path, name, DFanotifyWatcher::QPrivateSignal());
+                } else {
+                    emit q->fileCreated(path, name, DFanotifyWatcher::QPrivateSignal());
+                }
+            }
+
+            if (meta->mask & FAN_MODIFY)
+                emit q->fileModified(path, name, DFanotifyWatcher::QPrivateSignal());
+
+            if (meta->mask & FAN_ATTRIB)
+                emit q->fileAttributeChanged(path, name, DFanotifyWatcher::QPrivateSignal());
+
+            if (meta->mask & FAN_CLOSE_WRITE)
+                emit q->fileClosed(path, name, DFanotifyWatcher::QPrivateSignal());
+
+            if (meta->mask & FAN_DELETE)
+                emit q->fileDeleted(path, name, DFanotifyWatcher::QPrivateSignal());
+        }
+    }
+
+    flushPendingMove();
+
+    if (overflowed) {
+        qWarning() << "fanotify event queue overflow, some file events are lost";
+        emit q->eventQueueOverflowed(DFanotifyWatcher::QPrivateSignal());
+    }
+#endif
+}
+
+DFanotifyWatcher::DFanotifyWatcher(QObject *parent)
+    : QObject(parent)
+    , d_ptr(new DFanotifyWatcherPrivate(initFanotify(), this))
+{
+}
+
+DFanotifyWatcher::~DFanotifyWatcher()
+{
+}
+
+DFanotifyWatcher *DFanotifyWatcher::instance()
+{
+    // 可能在文件监视的线程中第一次使用，需移到主线程以读取事件
+    if (!fanotifyWatcher.exists() && !fanotifyWatcher.isDestroyed() && qApp)
+        fanotifyWatcher->moveToThread(qApp->thread());
+
+    return fanotifyWatcher;
+}
+
+bool DFanotifyWatcher::isAvailable() const
+{
+    Q_D(const DFanotifyWatcher);
+
+    return d->fanotifyFd >= 0;
+}
+
+/*!
+ * \brief DFanotifyWatcher::addSubtree 监视 path 目录树中所有文件的变化，需与 removeSubtree 成对调用
+ * \return fanotify 不可用或没有权限时返回 false
+ */
+bool DFanotifyWatcher::addSubtree(const QString &path)
+{
+    Q_D(DFanotifyWatcher);
+
+    if (!isAvailable() || path.isEmpty())
+        return false;
+
+    QMutexLocker lk(&d->mutex);
+
+    auto it = d->subtrees.find(path);
+    if (it != d->subtrees.end()) {
+        ++it.value();
+        return true;
+    }
+
+    quint64 fsid = 0;
+    if (!d->markFileSystem(path, &fsid))
+        return false;
+
+    d->subtrees.insert(path, 1);
+    d->subtreeToFsid.insert(path, fsid);
+
+    return true;
+}
+
+void DFanotifyWatcher::removeSubtree(const QString &path)
+{
+    Q_D(DFanotifyWatcher);
+
+    QMutexLocker lk(&d->mutex);
+
+    auto it = d->subtrees.find(path);
+    if (it == d->subtrees.end() || --it.value() > 0)
+        return;
+
+    d->subtrees.erase(it);
+    d->unmarkFileSystem(d->subtreeToFsid.take(path));
+}
+
+QStringList DFanotifyWatcher::subtrees() const
+{
+    Q_D(const DFanotifyWatcher);
+
+    QMutexLocker lk(&d->mutex);
+
+    return d->subtrees.keys();
+}
+
+/*!
+ * \brief DFanotifyWatcher::isSubtreeWatched path 及其子文件的变化是否已通过 fanotify 监视
+ */
+bool DFanotifyWatcher::isSubtreeWatched(const QString &path) const
+{
+    Q_D(const DFanotifyWatcher);
+
+    QMutexLocker lk(&d->mutex);
+
+    return d->isPathWatched(path);
+}
+
+#include "moc_dfanotifywatcher.cpp"
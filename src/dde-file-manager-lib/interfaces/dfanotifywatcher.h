@@ -0,0 +1,54 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DFANOTIFYWATCHER_H
+#define DFANOTIFYWATCHER_H
+
+#include <QObject>
+
+/*!
+ * \brief DFanotifyWatcher 基于 fanotify 的目录树监视
+ *
+ * 对目录所在的文件系统添加一个标记即可收到整个目录树的变化，不必像 inotify 一样逐个目录添加监视，
+ * 不受 max_user_watches 限制。fanotify 的文件系统标记需要相应的权限，不可用时 addSubtree 返回 false，
+ * 调用者继续使用 DFileSystemWatcher。信号的参数与 DFileSystemWatcher 相同。
+ */
+class DFanotifyWatcherPrivate;
+class DFanotifyWatcher : public QObject
+{
+    Q_OBJECT
+    Q_DECLARE_PRIVATE(DFanotifyWatcher)
+
+public:
+    explicit DFanotifyWatcher(QObject *parent = Q_NULLPTR);
+    ~DFanotifyWatcher();
+
+    static DFanotifyWatcher *instance();
+
+    bool isAvailable() const;
+
+    bool addSubtree(const QString &path);
+    void removeSubtree(const QString &path);
+    QStringList subtrees() const;
+    bool isSubtreeWatched(const QString &path) const;
+
+Q_SIGNALS:
+    void fileDeleted(const QString &path, const QString &name, QPrivateSignal);
+    void fileAttributeChanged(const QString &path, const QString &name, QPrivateSignal);
+    void fileClosed(const QString &path, const QString &name, QPrivateSignal);
+    void fileMoved(const QString &fromPath, const QString &fromName,
+                   const QString &toPath, const QString &toName, QPrivateSignal);
+    void fileCreated(const QString &path, const QString &name, QPrivateSignal);
+    void fileModified(const QString &path, const QString &name, QPrivateSignal);
+    //! 与 DFileSystemWatcher::eventQueueOverflowed 相同
+    void eventQueueOverflowed(QPrivateSignal);
+
+private:
+    QScopedPointer<DFanotifyWatcherPrivate> d_ptr;
+
+    Q_PRIVATE_SLOT(d_func(), void _q_scheduleRead())
+    Q_PRIVATE_SLOT(d_func(), void _q_readFromFanotify())
+};
+
+#endif // DFANOTIFYWATCHER_H
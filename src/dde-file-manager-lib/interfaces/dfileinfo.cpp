@@ -43,11 +43,14 @@
 #include <ddiskmanager.h>
 
 #include <sys/stat.h>
+#include <fcntl.h>
 #include <unistd.h>
 
 DFM_USE_NAMESPACE
 
 #define REQUEST_THUMBNAIL_DEALY 500
+// 每次向标记服务查询的文件数
+#define REQUEST_EP_BATCH_SIZE 200
 
 class RequestEP : public QThread
 {
@@ -68,6 +71,7 @@ public:
 
     void run() override;
     void requestEP(const DUrl &url, DFileInfoPrivate *info);
+    void requestEP(const QList<QPair<DUrl, DFileInfoPrivate *>> &files);
     void cancelRequestEP(DFileInfoPrivate *info);
 
 Q_SIGNALS:
@@ -80,6 +84,119 @@ private:
     explicit RequestEP(QObject *parent = nullptr);
 };
 
+/*!
+ * \brief RequestEPScheduler 收集需要获取扩展属性的文件，延时后一起交给 RequestEP
+ *
+ * 所有文件共用一个定时器，显示大量文件时不必为每个文件创建定时器
+ */
+class RequestEPScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    static RequestEPScheduler *instance();
+
+    void schedule(const DUrl &url, DFileInfoPrivate *info);
+    bool cancel(DFileInfoPrivate *info);
+
+private Q_SLOTS:
+    void startTimer();
+    void flush();
+
+private:
+    explicit RequestEPScheduler(QObject *parent = nullptr);
+
+    QMutex mutex;
+    QList<QPair<DUrl, DFileInfoPrivate *>> pendingFiles;
+    QSet<DFileInfoPrivate *> pendingInfos;
+    QTimer *timer;
+};
+
+RequestEPScheduler::RequestEPScheduler(QObject *parent)
+    : QObject(parent)
+    , timer(new QTimer(this))
+{
+    timer->setSingleShot(true);
+    timer->setInterval(REQUEST_THUMBNAIL_DEALY);
+
+    connect(timer, &QTimer::timeout, this, &RequestEPScheduler::flush);
+}
+
+RequestEPScheduler *RequestEPScheduler::instance()
+{
+    static RequestEPScheduler *scheduler = [] {
+        RequestEPScheduler *epScheduler = new RequestEPScheduler();
+
+        if (qApp)
+            epScheduler->moveToThread(qApp->thread());
+
+        return epScheduler;
+    }();
+
+    return scheduler;
+}
+
+void RequestEPScheduler::schedule(const DUrl &url, DFileInfoPrivate *info)
+{
+    QMutexLocker locker(&mutex);
+
+    if (pendingInfos.contains(info))
+        return;
+
+    pendingInfos << info;
+    pendingFiles << qMakePair(url, info);
+
+    // 只在第一个文件加入时启动定时器，持续滚动时也能按时请求
+    if (pendingFiles.size() == 1)
+        QMetaObject::invokeMethod(this, "startTimer", Qt::QueuedConnection);
+}
+
+bool RequestEPScheduler::cancel(DFileInfoPrivate *info)
+{
+    QMutexLocker locker(&mutex);
+
+    if (!pendingInfos.remove(info))
+        return false;
+
+    for (int i = 0; i < pendingFiles.count(); ++i) {
+        if (pendingFiles.at(i).second == info) {
+            pendingFiles.removeAt(i);
+            break;
+        }
+    }
+
+    return true;
+}
+
+void RequestEPScheduler::startTimer()
+{
+    if (!timer->isActive())
+        timer->start();
+}
+
+void RequestEPScheduler::flush()
+{
+    QMutexLocker locker(&mutex);
+
+    if (pendingFiles.isEmpty())
+        return;
+
+    RequestEP *ep = RequestEP::instance();
+
+    for (const QPair<DUrl, DFileInfoPrivate *> &file : pendingFiles)
+        file.second->requestEP = ep;
+
+    //线程run之前先确保fileinfo未被析构时request不会被取消
+    ep->requestEPCancelLock.lock();
+    ep->isCanceled = false;
+    ep->requestEPCancelLock.unlock();
+
+    ep->requestEP(pendingFiles);
+
+    pendingFiles.clear();
+    pendingInfos.clear();
+}
+
 RequestEP::RequestEP(QObject *parent)
     : QThread(parent)
 {
@@ -122,30 +239,57 @@ void RequestEP::run()
             requestEPFilesLock.unlock();
             return;
         }
-        auto file_info = requestEPFiles.dequeue();
+
+        QList<QPair<DUrl, DFileInfoPrivate *>> files;
+
+        while (!requestEPFiles.isEmpty() && files.size() < REQUEST_EP_BATCH_SIZE)
+            files << requestEPFiles.dequeue();
         requestEPFilesLock.unlock();
 
-        const DUrl &url = file_info.first;
-        const QStringList &tag_list = DFileService::instance()->getTagsThroughFiles(nullptr, {url});
+        QList<DUrl> urls;
 
-        QVariantHash ep;
+        for (const QPair<DUrl, DFileInfoPrivate *> &file_info : files)
+            urls << file_info.first;
 
-        if (!tag_list.isEmpty()) {
-            ep["tag_name_list"] = tag_list;
-        }
+        // 一次查询整批文件的标记及其颜色
+        const QMap<DUrl, QStringList> &file_tags = TagManager::instance()->getTagsOfEachFile(urls);
+        QSet<QString> all_tags;
 
-        QList<QColor> colors;
+        for (const QStringList &tag_list : file_tags)
+            all_tags.unite(tag_list.toSet());
 
-        for (const QColor &color : TagManager::instance()->getTagColor(tag_list)) {
-            colors << color;
-        }
+        const QMap<QString, QColor> &tag_colors = TagManager::instance()->getTagColor(all_tags.toList());
 
-        if (!colors.isEmpty()) {
-            ep["colored"] = QVariant::fromValue(colors);
-        }
+        for (const QPair<DUrl, DFileInfoPrivate *> &file_info : files) {
+            const DUrl &url = file_info.first;
+            const QStringList &tag_list = file_tags.value(url);
+
+            QVariantHash ep;
+
+            if (!tag_list.isEmpty()) {
+                ep["tag_name_list"] = tag_list;
+            }
+
+            QMap<QString, QColor> colors_of_file;
+
+            for (const QString &tag : tag_list) {
+                if (tag_colors.contains(tag))
+                    colors_of_file[tag] = tag_colors.value(tag);
+            }
 
-        QMetaObject::invokeMethod(this, "processEPChanged", Qt::QueuedConnection,
-                                  Q_ARG(DUrl, url), Q_ARG(DFileInfoPrivate *, file_info.second), Q_ARG(QVariantHash, ep));
+            QList<QColor> colors;
+
+            for (const QColor &color : colors_of_file) {
+                colors << color;
+            }
+
+            if (!colors.isEmpty()) {
+                ep["colored"] = QVariant::fromValue(colors);
+            }
+
+            QMetaObject::invokeMethod(this, "processEPChanged", Qt::QueuedConnection,
+                                      Q_ARG(DUrl, url), Q_ARG(DFileInfoPrivate *, file_info.second), Q_ARG(QVariantHash, ep));
+        }
     }
 }
 
@@ -172,6 +316,27 @@ void RequestEP::requestEP(const DUrl &url, DFileInfoPrivate *info)
     }
 }
 
+void RequestEP::requestEP(const QList<QPair<DUrl, DFileInfoPrivate *>> &files)
+{
+    requestEPFilesLock.lockForWrite();
+
+    QSet<DFileInfoPrivate *> requested;
+
+    for (const QPair<DUrl, DFileInfoPrivate *> &file_info : requestEPFiles)
+        requested << file_info.second;
+
+    for (const QPair<DUrl, DFileInfoPrivate *> &file_info : files) {
+        if (!requested.contains(file_info.second))
+            requestEPFiles << file_info;
+    }
+
+    requestEPFilesLock.unlock();
+
+    if (!isRunning()) {
+        start();
+    }
+}
+
 void RequestEP::cancelRequestEP(DFileInfoPrivate *info)
 {
     requestEPCancelLock.lock();
@@ -262,11 +427,7 @@ DFileInfoPrivate::~DFileInfoPrivate()
         getIconTimer->deleteLater();
     }
 
-    if (getEPTimer) {
-        getEPTimer->disconnect(SIGNAL(timeout())); // 导致指针析构问题，UT注意
-        getEPTimer->stop();
-        getEPTimer->deleteLater();
-    }
+    RequestEPScheduler::instance()->cancel(this);
 
     if (requestEP)
         requestEP->cancelRequestEP(this);
@@ -320,6 +481,9 @@ bool DFileInfo::exists() const
 {
     Q_D(const DFileInfo);
 
+    if (d->statAttributes)
+        return true;
+
     return d->fileInfo.exists() || d->fileInfo.isSymLink();
 }
 
@@ -437,7 +601,7 @@ QList<QIcon> DFileInfo::additionalIcon() const
 
     // 添加插件角标
     if (countOfSystemIcon < kMaxEmblemCount)
-        PluginEmblemManager::instance()->getPluginEmblemIconsFromMap(fileUrl(), countOfSystemIcon, icons);
+        PluginEmblemManager::instance()->getPluginEmblemIconsFromMap(fileUrl(), countOfSystemIcon, icons, lastModified().toTime_t());
 
     return icons;
 }
@@ -670,6 +834,9 @@ bool DFileInfo::isFile() const
 {
     Q_D(const DFileInfo);
 
+    if (d->statAttributes)
+        return S_ISREG(d->statAttributes->mode);
+
     return d->fileInfo.isFile();
 }
 
@@ -677,6 +844,9 @@ bool DFileInfo::isDir() const
 {
     Q_D(const DFileInfo);
 
+    if (d->statAttributes)
+        return S_ISDIR(d->statAttributes->mode);
+
     return d->fileInfo.isDir();
 }
 
@@ -684,6 +854,9 @@ bool DFileInfo::isSymLink() const
 {
     Q_D(const DFileInfo);
 
+    if (d->statAttributes)
+        return false;
+
     return d->fileInfo.isSymLink();
 }
 
@@ -731,6 +904,9 @@ uint DFileInfo::ownerId() const
 {
     Q_D(const DFileInfo);
 
+    if (d->statAttributes)
+        return d->statAttributes->ownerId;
+
     return d->fileInfo.ownerId();
 }
 
@@ -745,6 +921,9 @@ uint DFileInfo::groupId() const
 {
     Q_D(const DFileInfo);
 
+    if (d->statAttributes)
+        return d->statAttributes->groupId;
+
     return d->fileInfo.groupId();
 }
 
@@ -772,6 +951,9 @@ qint64 DFileInfo::size() const
 {
     Q_D(const DFileInfo);
 
+    if (d->statAttributes)
+        return d->statAttributes->size;
+
     return d->fileInfo.size();
 }
 
@@ -797,6 +979,9 @@ QDateTime DFileInfo::created() const
 {
     Q_D(const DFileInfo);
 
+    if (d->statAttributes)
+        return QDateTime::fromMSecsSinceEpoch(d->statAttributes->created);
+
     return d->fileInfo.created();
 }
 
@@ -804,6 +989,9 @@ QDateTime DFileInfo::lastModified() const
 {
     Q_D(const DFileInfo);
 
+    if (d->statAttributes)
+        return QDateTime::fromMSecsSinceEpoch(d->statAttributes->lastModified);
+
     if (isSymLink() && !d->fileInfo.exists()) {
         struct stat attrib;
 
@@ -818,6 +1006,9 @@ QDateTime DFileInfo::lastRead() const
 {
     Q_D(const DFileInfo);
 
+    if (d->statAttributes)
+        return QDateTime::fromMSecsSinceEpoch(d->statAttributes->lastRead);
+
     if (isSymLink() && !d->fileInfo.exists()) {
         struct stat attrib;
 
@@ -905,7 +1096,9 @@ void DFileInfo::refresh(const bool isForce)
 
     Q_UNUSED(isForce)
 
+    d->refreshVersion.ref();
     d->fileInfo.refresh();
+    d->statAttributes.reset();
     d->icon = QIcon();
     d->epInitialized = false;
     d->hasThumbnail = -1;
@@ -929,8 +1122,13 @@ void DFileInfo::makeToActive()
 {
     Q_D(DFileInfo);
 
-    if (!d->isLowSpeedFile())
+    if (d->statAttributes) {
+        // 重新与服务器同步一次即可，不必让 QFileInfo 逐项查询
+        d->fileInfo.refresh();
+        loadStatAttributes(false);
+    } else if (!d->isLowSpeedFile()) {
         d->fileInfo.refresh();
+    }
 
     DAbstractFileInfo::makeToActive();
 }
@@ -949,12 +1147,9 @@ void DFileInfo::makeToInactive()
         DThumbnailProvider::instance()->removeInProduceQueue(d->fileInfo, DThumbnailProvider::Large);
     }
 
-    if (d->getEPTimer) {
-        d->getEPTimer->stop();
-        d->getEPTimer->deleteLater();
-        d->requestEP = nullptr;
+    // 尚未开始请求的文件不再请求，下次显示时重新获取
+    if (RequestEPScheduler::instance()->cancel(d))
         d->epInitialized = false;
-    }
 }
 
 QIcon DFileInfo::fileIcon() const
@@ -1093,27 +1288,7 @@ QVariantHash DFileInfo::extraProperties() const
     if (!d->epInitialized) {
         d->epInitialized = true;
 
-        const DUrl &url = fileUrl();
-
-        if (!d->getEPTimer) {
-            d->getEPTimer = new QTimer(qApp);
-            d->getEPTimer->setSingleShot(true);
-            d->getEPTimer->moveToThread(qApp->thread());
-            d->getEPTimer->setInterval(REQUEST_THUMBNAIL_DEALY);
-
-            QObject::connect(d->getEPTimer, &QTimer::timeout, d->getEPTimer, [d, url] {
-                d->requestEP = RequestEP::instance();
-
-                //线程run之前先确保fileinfo未被析构时request不会被取消
-                d->requestEP->requestEPCancelLock.lock();
-                d->requestEP->isCanceled = false;
-                d->requestEP->requestEPCancelLock.unlock();
-
-                d->requestEP->requestEP(url, const_cast<DFileInfoPrivate *>(d));
-            });
-        }
-
-        QMetaObject::invokeMethod(d->getEPTimer, "start", Qt::QueuedConnection);
+        RequestEPScheduler::instance()->schedule(fileUrl(), const_cast<DFileInfoPrivate *>(d));
     }
 
     return d->extraProperties;
@@ -1126,6 +1301,11 @@ quint64 DFileInfo::inode() const
         return d->inode;
     }
 
+    if (d->statAttributes) {
+        d->inode = d->statAttributes->inode;
+        return d->inode;
+    }
+
     struct stat statinfo;
     QByteArray pathArry = d->fileInfo.absoluteFilePath().toUtf8();
     std::string pathStd = pathArry.toStdString();
@@ -1136,6 +1316,53 @@ quint64 DFileInfo::inode() const
     return d->inode;
 }
 
+/*!
+ * \brief DFileInfo::loadStatAttributes 使用一次 statx 读取文件的基本属性，之后 exists、size、时间等不再单独查询。
+ * 用于 nfs、cifs 等网络文件系统，每次 stat 都可能需要与服务器同步
+ * \param dontSync 为 true 时允许使用客户端缓存的属性，适用于刚列出目录的情况
+ * \return 不是普通文件或目录（如符号链接）、不支持 statx 时返回 false，继续使用 QFileInfo
+ */
+bool DFileInfo::loadStatAttributes(bool dontSync)
+{
+    Q_D(DFileInfo);
+
+#ifdef STATX_BASIC_STATS
+    struct statx st;
+    const unsigned int mask = STATX_TYPE | STATX_MODE | STATX_UID | STATX_GID | STATX_SIZE
+                              | STATX_ATIME | STATX_MTIME | STATX_CTIME | STATX_INO | STATX_BTIME;
+    const int flags = AT_SYMLINK_NOFOLLOW | (dontSync ? AT_STATX_DONT_SYNC : AT_STATX_SYNC_AS_STAT);
+
+    if (statx(AT_FDCWD, QFile::encodeName(d->fileInfo.absoluteFilePath()).constData(), flags, mask, &st) != 0
+            || S_ISLNK(st.stx_mode)) {
+        d->statAttributes.reset();
+        return false;
+    }
+
+    auto toMSecs = [](const struct statx_timestamp &time) {
+        return time.tv_sec * 1000 + time.tv_nsec / 1000000;
+    };
+
+    if (!d->statAttributes)
+        d->statAttributes.reset(new DFileStatAttributes());
+
+    d->statAttributes->mode = st.stx_mode;
+    d->statAttributes->ownerId = st.stx_uid;
+    d->statAttributes->groupId = st.stx_gid;
+    d->statAttributes->size = static_cast<qint64>(st.stx_size);
+    d->statAttributes->lastModified = toMSecs(st.stx_mtime);
+    d->statAttributes->lastRead = toMSecs(st.stx_atime);
+    d->statAttributes->created = toMSecs((st.stx_mask & STATX_BTIME) ? st.stx_btime : st.stx_ctime);
+    d->statAttributes->inode = st.stx_ino;
+
+    return true;
+#else
+    Q_UNUSED(dontSync)
+    d->statAttributes.reset();
+
+    return false;
+#endif
+}
+
 DFileInfo::DFileInfo(DFileInfoPrivate &dd)
     : DAbstractFileInfo(dd)
 {
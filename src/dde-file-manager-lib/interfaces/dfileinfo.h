@@ -102,6 +102,8 @@ public:
 
     quint64 inode() const override;
 
+    bool loadStatAttributes(bool dontSync);
+
     // 此函数高频调用，使用 DFileInfo 会降低性能
     static bool fileIsWritable(const QString &path, uint ownerId);
 
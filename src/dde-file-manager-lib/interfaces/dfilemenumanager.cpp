@@ -43,6 +43,7 @@
 #include "customization/dcustomactionbuilder.h"
 #include "customization/dcustomactionparser.h"
 #include "gvfs/gvfsmountmanager.h"
+#include "gvfs/qmount.h"
 #include "extensionimpl/dfmextpluginmanager.h"
 #include "extensionimpl/dfmextmenuimplproxy.h"
 #include "extensionimpl/dfmextmenuimpl.h"
@@ -65,6 +66,7 @@
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QQueue>
+#include <QElapsedTimer>
 #include <QDebug>
 #include <QPushButton>
 #include <QWidgetAction>
@@ -95,6 +97,22 @@ static QQueue<MenuAction> availableUserActionQueue;
 static DFMAdditionalMenu *additionalMenu;
 static DCustomActionParser *customMenuParser = nullptr;
 
+// 默认应用支持的 mime 类型的缓存时间，超时后重新查询，以便默认应用的修改能生效
+#define DEFAULT_APP_MIME_CACHE_TIMEOUT 3000
+static QHash<QString, QStringList> defaultAppMimeTypes;
+static QElapsedTimer defaultAppMimeTypesTimer;
+
+//! 右键时对选中文件只遍历一次，收集菜单需要的信息
+struct SelectionInfo {
+    QList<DAbstractFileInfoPointer> infos;
+    DUrlList redirectedUrls;
+    QSet<MenuAction> disableList;
+    bool hasDir = false;
+    bool allArchive = true;
+    bool systemPathIncluded = false;
+    bool showTagActions = true;
+};
+
 void initData();
 void initActions();
 void clearActions();
@@ -132,6 +150,101 @@ DFMExtMenuImpl *createMenuImpl(QMenu *menu)
     return new DFMExtMenuImpl(menu);
 }
 
+/*!
+ * \brief defaultAppSupportedMimeTypes 获取 mime 类型的默认应用支持的所有 mime 类型
+ *
+ * 查询默认应用需要访问 gio 并解析 desktop 文件，连续右键同类文件时使用缓存
+ */
+QStringList defaultAppSupportedMimeTypes(const QString &mimeType)
+{
+    if (!defaultAppMimeTypesTimer.isValid() || defaultAppMimeTypesTimer.hasExpired(DEFAULT_APP_MIME_CACHE_TIMEOUT)) {
+        defaultAppMimeTypes.clear();
+        defaultAppMimeTypesTimer.start();
+    }
+
+    auto it = defaultAppMimeTypes.constFind(mimeType);
+
+    if (it != defaultAppMimeTypes.constEnd())
+        return it.value();
+
+    const QString &defaultAppDesktopFile = MimesAppsManager::getDefaultAppDesktopFileByMimeType(mimeType);
+    Properties mimeTypeList(defaultAppDesktopFile, "Desktop Entry");
+    QStringList supportedMimeTypes = mimeTypeList.value("MimeType").toString().split(';');
+
+    supportedMimeTypes.removeAll("");
+    defaultAppMimeTypes.insert(mimeType, supportedMimeTypes);
+
+    return supportedMimeTypes;
+}
+
+bool canShowTagActions(const DAbstractFileInfoPointer &info)
+{
+    if (!info || !info->canTag())
+        return false;
+
+    //多选文件中包含一下文件时 则不展示标记信息菜单项
+    return info->fileUrl() != DesktopFileInfo::computerDesktopFileUrl()
+            && info->fileUrl() != DesktopFileInfo::trashDesktopFileUrl()
+            && info->fileUrl() != DesktopFileInfo::homeDesktopFileUrl();
+}
+
+/*!
+ * \brief collectSelection 遍历一次选中的文件，得到禁用的菜单项、是否包含目录、是否都是压缩包等信息
+ *
+ * 结果与分别调用 getDisableActionList 和 whetherShowTagActions 一致
+ */
+SelectionInfo collectSelection(const DUrlList &urls)
+{
+    SelectionInfo selection;
+
+    selection.infos.reserve(urls.size());
+
+    for (const DUrl &url : urls) {
+        const DAbstractFileInfoPointer &fileInfo = fileService->createFileInfo(Q_NULLPTR, url);
+
+        selection.infos << fileInfo;
+
+        //! 保险箱文件的禁用菜单项需要由保险箱的文件信息获取
+        if (VaultController::isVaultFile(url.path())) {
+            const DAbstractFileInfoPointer &vaultInfo = fileService->createFileInfo(Q_NULLPTR, VaultController::localUrlToVault(url));
+
+            if (vaultInfo)
+                selection.disableList += vaultInfo->disableMenuActionList();
+        } else if (fileInfo) {
+            selection.disableList += fileInfo->disableMenuActionList();
+        }
+
+        if (!FileUtils::isArchive(url.path()))
+            selection.allArchive = false;
+
+        if (selection.showTagActions && !canShowTagActions(fileInfo))
+            selection.showTagActions = false;
+
+        if (!fileInfo)
+            continue;
+
+        // fix bug202007010011 优化文件判断效率，提升右键菜单响应速度
+        const DUrl &redirectedUrl = fileInfo->redirectedFileUrl();
+        if (redirectedUrl.isValid())
+            selection.redirectedUrls << redirectedUrl;
+
+        if (!selection.hasDir && fileInfo->isDir())
+            selection.hasDir = true;
+
+        if (!selection.systemPathIncluded && systemPathManager->isSystemPath(fileInfo->fileUrl().toLocalFile()))
+            selection.systemPathIncluded = true;
+    }
+
+    if (DFMGlobal::instance()->clipboardAction() == DFMGlobal::UnknowAction)
+        selection.disableList << MenuAction::Paste;
+
+#ifdef DISABLE_TAG_SUPPORT
+    selection.showTagActions = false;
+#endif // DISABLE_TAG_SUPPORT
+
+    return selection;
+}
+
 }
 
 DFileMenu *DFileMenuManager::createDefaultBookMarkMenu(const QSet<MenuAction> &disableList)
@@ -202,31 +315,23 @@ DFileMenu *DFileMenuManager::createNormalMenu(const DUrl &currentUrl, const DUrl
             urls[i] = VaultController::vaultToLocalUrl(urlList[i]);
     }
 
-    auto dirInUrls = [](const DUrlList &urls) {
-        for (const auto &url: urls) {
-            auto fileInfo = fileService->createFileInfo(nullptr, url);
-            if (fileInfo && fileInfo->isDir())
-                return true;
-        }
-        return false;
-    };
+    const DFileMenuData::SelectionInfo &selection = DFileMenuData::collectSelection(urls);
 
-    DUrlList redirectedUrlList;
     if (urls.length() == 1) {
         QVector<MenuAction> actions = info->menuActionList(DAbstractFileInfo::SingleFile);
         bool isMounted = false;
         if (FileUtils::isSmbShareFolder(currentUrl)) {
-            for (auto gvfsmp : DGioVolumeManager::getMounts()) {//遍历当前挂载
-                auto rootFile = gvfsmp->getRootFile();
-                if (!rootFile)
+            for (const QMount &mount : GvfsMountManager::getMounts()) {//遍历当前挂载的快照
+                const QString &rootPath = mount.mounted_root_path();
+                if (rootPath.isEmpty())
                     continue;
 
-                bool isSmb = FileUtils::isSmbPath(rootFile->path());
+                bool isSmb = FileUtils::isSmbPath(rootPath);
                 if(!isSmb)
                     continue;
                 DUrl mountUrl;
-                QString shareName = FileUtils::smbAttribute(rootFile->path(),FileUtils::SmbAttribute::kShareName);
-                QString shareHost = FileUtils::smbAttribute(rootFile->path(),FileUtils::SmbAttribute::kServer);
+                QString shareName = FileUtils::smbAttribute(rootPath,FileUtils::SmbAttribute::kShareName);
+                QString shareHost = FileUtils::smbAttribute(rootPath,FileUtils::SmbAttribute::kServer);
                 QString name = currentUrl.path().toLower();//共享文件夹名称转小写
                 QString host = currentUrl.host();
                 if(name.startsWith("/"))
@@ -269,14 +374,14 @@ DFileMenu *DFileMenuManager::createNormalMenu(const DUrl &currentUrl, const DUrl
         }
 
         const QMap<MenuAction, QVector<MenuAction> > &subActions = info->subMenuActionList();
-        disableList += DFileMenuManager::getDisableActionList(urls);
+        disableList += selection.disableList;
         const bool &tabAddable = WindowManager::tabAddableByWinId(windowId);
         if (!tabAddable) {
             disableList << MenuAction::OpenInNewTab;
         }
 
         ///###: tag protocol.
-        if (!DFileMenuManager::whetherShowTagActions(urls)) {
+        if (!selection.showTagActions) {
             actions.removeAll(MenuAction::TagInfo);
             actions.removeAll(MenuAction::TagFilesUseColor);
         }
@@ -288,119 +393,55 @@ DFileMenu *DFileMenuManager::createNormalMenu(const DUrl &currentUrl, const DUrl
 
         menu = DFileMenuManager::genereteMenuByKeys(actions, disableList, true, subActions);
     } else {
-        bool isSystemPathIncluded = false;
-        bool isAllCompressedFiles = true;
-//        QMimeType fileMimeType;
-        QStringList supportedMimeTypes;
-        bool mime_displayOpenWith = true;
         //fix bug 35546 【文件管理器】【5.1.2.2-1】【sp2】【sp1】选择多个只读文件夹，删除按钮没有置灰
         //只判断当前选中的文件夹是否是只读文件夹
         if (!info->isWritable() && !info->isFile() && !info->isSymLink()) {
             disableList << MenuAction::Delete;
         }
 
-#if 1   //!fix bug#29264.部分格式的文件在上面的MimesAppsManager::getDefaultAppDesktopFileByMimeType
+        //!fix bug#29264.部分格式的文件在上面的MimesAppsManager::getDefaultAppDesktopFileByMimeType
         //!调用中可以找到app打开，但是在后面的判断是由于该app的supportedMimeTypes中并没有本文件的mimeTypeList支持
         //!导致了无法匹配，matched为false。因此这里加做一次判断，如果本次文件的后缀名与与上面查询app的文件后缀名一样，则直接匹配
 
         //获取当前文件的app
-        if (supportedMimeTypes.isEmpty()) {
-            QMimeType fileMimeType = info->mimeType();
-            QString defaultAppDesktopFile = MimesAppsManager::getDefaultAppDesktopFileByMimeType(fileMimeType.name());
-            QSettings desktopFile(defaultAppDesktopFile, QSettings::IniFormat);
-            desktopFile.setIniCodec("UTF-8");
-            Properties mimeTypeList(defaultAppDesktopFile, "Desktop Entry");
-            supportedMimeTypes = mimeTypeList.value("MimeType").toString().split(';');
-            supportedMimeTypes.removeAll("");
-        }
+        const QStringList &supportedMimeTypes = DFileMenuData::defaultAppSupportedMimeTypes(info->mimeType().name());
+        //! 已经匹配过的 mime 类型，相同类型的文件不再重复匹配
+        QSet<QString> matchedMimeTypes;
 
-        redirectedUrlList.clear();
-        foreach (DUrl url, urls) {
-            const DAbstractFileInfoPointer &file_info = fileService->createFileInfo(Q_NULLPTR, url);
-            // fix bug202007010011 优化文件判断效率，提升右键菜单响应速度
-            auto redirectedUrl = file_info->redirectedFileUrl();
-            if (redirectedUrl.isValid()) {
-                redirectedUrlList << redirectedUrl;
-            }
-
-            if (!FileUtils::isArchive(url.path())) {
-                isAllCompressedFiles = false;
-            }
+        for (const DAbstractFileInfoPointer &file_info : selection.infos) {
+            if (!file_info)
+                continue;
 
-            if (systemPathManager->isSystemPath(file_info->fileUrl().toLocalFile())) {
-                isSystemPathIncluded = true;
-            }
+            //后缀名相同直接匹配
+            if (file_info->suffix() == info->suffix())
+                continue;
 
-            if (!mime_displayOpenWith) {
+            const QMimeType &mimeType = file_info->mimeType();
+            if (matchedMimeTypes.contains(mimeType.name()))
                 continue;
-            }
 
-            QStringList mimeTypeList = { file_info->mimeType().name() };
-            mimeTypeList.append(file_info->mimeType().parentMimeTypes());
+            QStringList mimeTypeList = { mimeType.name() };
+            mimeTypeList.append(mimeType.parentMimeTypes());
             bool matched = false;
 
-            //后缀名相同直接匹配
-            if (file_info->suffix() == info->suffix()) {
-                matched = true;
-            } else {
-                for (const QString &oneMimeType : mimeTypeList) {
-                    if (supportedMimeTypes.contains(oneMimeType)) {
-                        matched = true;
-                        break;
-                    }
+            for (const QString &oneMimeType : mimeTypeList) {
+                if (supportedMimeTypes.contains(oneMimeType)) {
+                    matched = true;
+                    break;
                 }
             }
 
             if (!matched) {
-                mime_displayOpenWith = false;
                 disableList << MenuAction::Open << MenuAction::OpenWith;
                 break;
             }
-        }
-#else  //原来的实现
-        foreach (DUrl url, urls) {
-            const DAbstractFileInfoPointer &fileInfo = fileService->createFileInfo(Q_NULLPTR, url);
-
-            if (!FileUtils::isArchive(url.path())) {
-                isAllCompressedFiles = false;
-            }
-
-            if (systemPathManager->isSystemPath(fileInfo->fileUrl().toLocalFile())) {
-                isSystemPathIncluded = true;
-            }
-
-            if (!mime_displayOpenWith) {
-                continue;
-            }
 
-            if (supportedMimeTypes.isEmpty()) {
-                QMimeType fileMimeType = fileInfo->mimeType();
-                QString defaultAppDesktopFile = MimesAppsManager::getDefaultAppDesktopFileByMimeType(fileMimeType.name());
-                QSettings desktopFile(defaultAppDesktopFile, QSettings::IniFormat);
-                desktopFile.setIniCodec("UTF-8");
-                Properties mimeTypeList(defaultAppDesktopFile, "Desktop Entry");
-                supportedMimeTypes = mimeTypeList.value("MimeType").toString().split(';');
-                supportedMimeTypes.removeAll({});
-            } else {
-                QStringList mimeTypeList = { fileInfo->mimeType().name() };
-                mimeTypeList.append(fileInfo->mimeType().parentMimeTypes());
-                bool matched = false;
-                for (const QString &oneMimeType : mimeTypeList) {
-                    if (supportedMimeTypes.contains(oneMimeType)) {
-                        matched = true;
-                        break;
-                    }
-                }
-                if (!matched) {
-                    mime_displayOpenWith = false;
-                    disableList << MenuAction::Open << MenuAction::OpenWith;
-                }
-            }
+            matchedMimeTypes << mimeType.name();
         }
-#endif
+
         QVector<MenuAction> actions;
 
-        if (isSystemPathIncluded) {
+        if (selection.systemPathIncluded) {
             actions = info->menuActionList(DAbstractFileInfo::MultiFilesSystemPathIncluded);
         } else {
             actions = info->menuActionList(DAbstractFileInfo::MultiFiles);
@@ -410,14 +451,14 @@ DFileMenu *DFileMenuManager::createNormalMenu(const DUrl &currentUrl, const DUrl
             return menu;
         }
 
-        if (isAllCompressedFiles) {
+        if (selection.allArchive) {
             int index = actions.indexOf(MenuAction::Compress);
             actions.insert(index + 1, MenuAction::Decompress);
             actions.insert(index + 2, MenuAction::DecompressHere);
         }
 
         const QMap<MenuAction, QVector<MenuAction> > &subActions  = info->subMenuActionList();
-        disableList += DFileMenuManager::getDisableActionList(urls);
+        disableList += selection.disableList;
         const bool &tabAddable = WindowManager::tabAddableByWinId(windowId);
         if (!tabAddable) {
             disableList << MenuAction::OpenInNewTab;
@@ -430,7 +471,7 @@ DFileMenu *DFileMenuManager::createNormalMenu(const DUrl &currentUrl, const DUrl
         }
 
         ///###: tag protocol.
-        if (!DFileMenuManager::whetherShowTagActions(urls)) {
+        if (!selection.showTagActions) {
             actions.removeAll(MenuAction::TagInfo);
             actions.removeAll(MenuAction::TagFilesUseColor);
         }
@@ -469,7 +510,7 @@ DFileMenu *DFileMenuManager::createNormalMenu(const DUrl &currentUrl, const DUrl
                     }
                 }
 #endif
-                action->setProperty("urls", QVariant::fromValue(redirectedUrlList));
+                action->setProperty("urls", QVariant::fromValue(selection.redirectedUrls));
             }
             openWithMenu->addAction(action);
             connect(action, &QAction::triggered, appController, &AppController::actionOpenFileByApp);
@@ -499,7 +540,7 @@ DFileMenu *DFileMenuManager::createNormalMenu(const DUrl &currentUrl, const DUrl
                     sendToBluetooth->setProperty("urlList", DUrl::toStringList(urls));
                     sendToMountedRemovableDiskMenu->addAction(sendToBluetooth);
                     connect(sendToBluetooth, &QAction::triggered, appController, &AppController::actionSendToBluetooth);
-                    if (dirInUrls(urls))
+                    if (selection.hasDir)
                         sendToBluetooth->setEnabled(false);
                 }
 
@@ -1213,10 +1254,7 @@ void DFileMenuManager::extendCustomMenu(DFileMenu *menu, bool isNormal, const DU
         DFileMenuData::customMenuParser = new DCustomActionParser;
     }
 
-    const QList<DCustomActionEntry> &rootEntry = DFileMenuData::customMenuParser->getActionFiles(onDesktop);
-    qDebug() << "extendCustomMenu " << isNormal << dir << focusFile << "files" << selected.size() << "entrys" << rootEntry.size();
-
-    if (menu == nullptr || rootEntry.isEmpty())
+    if (menu == nullptr || DFileMenuData::customMenuParser->getActionFiles(onDesktop).isEmpty())
         return;
 
     DCustomActionBuilder builder;
@@ -1234,8 +1272,9 @@ void DFileMenuManager::extendCustomMenu(DFileMenu *menu, bool isNormal, const DU
         builder.setFocusFile(focusFile);
     }
 
-    //获取支持的菜单项
-    auto usedEntrys = builder.matchFileCombo(rootEntry, fileCombo);
+    //获取支持的菜单项，菜单项已按显示位置和文件组合分组
+    auto usedEntrys = DFileMenuData::customMenuParser->getActionFiles(onDesktop, fileCombo);
+    qDebug() << "extendCustomMenu " << isNormal << dir << focusFile << "files" << selected.size() << "entrys" << usedEntrys.size();
 
     //匹配类型支持
     usedEntrys = builder.matchActions(selected, usedEntrys);
@@ -1363,8 +1402,14 @@ void DFileMenuManager::extensionPluginCustomMenu(DFileMenu *menu,
         extMenuImpl = extMenuImplPrivate->menuImpl();
     }
 
-    for (auto val : DFMExtPluginManager::instance().menus()) {
-        val->initialize(DFMExtPluginManager::instance().pluginMenuProxy());
+    // 插件只需要初始化一次，不必在每次弹出菜单时调用
+    static QSet<DFMEXT::DFMExtMenuPlugin *> initializedMenus;
+    // 只调用处理当前 scheme 和所选文件类型的插件
+    for (auto val : DFMExtPluginManager::instance().menus(currentUrl, isNormal ? selected : DUrlList())) {
+        if (!initializedMenus.contains(val.data())) {
+            val->initialize(DFMExtPluginManager::instance().pluginMenuProxy());
+            initializedMenus.insert(val.data());
+        }
         if (isNormal) {
             std::list<std::string> newSection;
             for (auto url : selected) { //导出所有的Durl到std::string
@@ -1514,23 +1559,8 @@ bool DFileMenuManager::whetherShowTagActions(const QList<DUrl> &urls)
 #endif // DISABLE_TAG_SUPPORT
 
     for (const DUrl &durl : urls) {
-        const DAbstractFileInfoPointer &info = DFileService::instance()->createFileInfo(nullptr, durl);
-
-        if (!info)
-            return false;
-
-//        bool temp{ DAnythingMonitorFilter::instance()->whetherFilterCurrentPath(info->toLocalFile().toLocal8Bit()) };
-
-        if (!info->canTag()) {
+        if (!DFileMenuData::canShowTagActions(DFileService::instance()->createFileInfo(nullptr, durl)))
             return false;
-        }
-
-        //多选文件中包含一下文件时 则不展示标记信息菜单项
-        if (info->fileUrl() == DesktopFileInfo::computerDesktopFileUrl()
-                || info->fileUrl() == DesktopFileInfo::trashDesktopFileUrl()
-                || info->fileUrl() == DesktopFileInfo::homeDesktopFileUrl()) {
-            return false;
-        }
     }
 
     return true;
@@ -25,6 +25,7 @@
 #include "models/desktopfileinfo.h"
 #include "controllers/pathmanager.h"
 #include "controllers/vaultcontroller.h"
+#include "tag/tagmanager.h"
 #include "dfmstandardpaths.h"
 #include "views/windowmanager.h"
 #include "models/avfsfileinfo.h"
@@ -55,11 +56,17 @@
 #include <QHostInfo>
 #include <QNetworkRequest>
 #include <QNetworkAccessManager>
+#include <QSemaphore>
+#include <QReadWriteLock>
+#include <QVarLengthArray>
 
 #include <sys/stat.h>
 
 DWIDGET_USE_NAMESPACE
 
+// 检查网络挂载是否可访问时最多等待的时间(毫秒)
+static constexpr int GVFS_BUSY_CHECK_TIMEOUT { 2000 };
+
 class DFileServicePrivate
 {
 public:
@@ -67,6 +74,13 @@ public:
     static QMultiHash<const HandlerType, DAbstractFileController *> controllerHash;
     static QHash<const DAbstractFileController *, HandlerType> handlerHash;
     static QMultiHash<const HandlerType, HandlerCreatorType> controllerCreatorHash;
+    //! 按 (scheme, host) 缓存的控制器，依次为该 host 的控制器和不区分 host 的控制器，注册的控制器变化时清空
+    static QHash<HandlerType, QVector<DAbstractFileController *>> controllerCache;
+    static QReadWriteLock controllerCacheLock;
+    //! 控制器在第一次使用 scheme 时才由 creator 创建，可能同时发生在多个线程中
+    static QMutex controllerCreatorLock;
+
+    static void clearControllerCache();
 
     bool m_bcursorbusy = false;
     bool m_bdoingcleartrash = false;
@@ -84,6 +98,15 @@ public:
 QMultiHash<const HandlerType, DAbstractFileController *> DFileServicePrivate::controllerHash;
 QHash<const DAbstractFileController *, HandlerType> DFileServicePrivate::handlerHash;
 QMultiHash<const HandlerType, HandlerCreatorType> DFileServicePrivate::controllerCreatorHash;
+QHash<HandlerType, QVector<DAbstractFileController *>> DFileServicePrivate::controllerCache;
+QReadWriteLock DFileServicePrivate::controllerCacheLock;
+QMutex DFileServicePrivate::controllerCreatorLock(QMutex::Recursive);
+
+void DFileServicePrivate::clearControllerCache()
+{
+    QWriteLocker locker(&controllerCacheLock);
+    controllerCache.clear();
+}
 
 DFileService::DFileService(QObject *parent)
     : QObject(parent)
@@ -100,6 +123,17 @@ DFileService::DFileService(QObject *parent)
         }));
     }
 
+    // 与 fmEvent 中处理的事件一致，其它事件不再经过文件服务
+    setHandledEventTypes({DFMEvent::OpenFile, DFMEvent::OpenFileByApp, DFMEvent::CompressFiles, DFMEvent::DecompressFile,
+                          DFMEvent::DecompressFileHere, DFMEvent::WriteUrlsToClipboard, DFMEvent::RenameFile, DFMEvent::DeleteFiles,
+                          DFMEvent::MoveToTrash, DFMEvent::RestoreFromTrash, DFMEvent::PasteFile, DFMEvent::Mkdir,
+                          DFMEvent::TouchFile, DFMEvent::OpenFileLocation, DFMEvent::AddToBookmark, DFMEvent::RemoveBookmark,
+                          DFMEvent::CreateSymlink, DFMEvent::FileShare, DFMEvent::CancelFileShare, DFMEvent::OpenInTerminal,
+                          DFMEvent::GetChildrens, DFMEvent::CreateFileInfo, DFMEvent::CreateDiriterator, DFMEvent::CreateGetChildrensJob,
+                          DFMEvent::CreateFileWatcher, DFMEvent::CreateFileDevice, DFMEvent::CreateFileHandler, DFMEvent::CreateStorageInfo,
+                          DFMEvent::Tag, DFMEvent::Untag, DFMEvent::GetTagsThroughFiles, DFMEvent::SetFileExtraProperties,
+                          DFMEvent::SetPermission, DFMEvent::OpenFiles, DFMEvent::OpenFilesByApp});
+
     d_ptr->m_tagEditorChangeTimer.setSingleShot(true);
     connect(&d_ptr->m_tagEditorChangeTimer, &QTimer::timeout, this, [ = ] {
         makeTagsOfFiles(nullptr, d_ptr->m_tagEditorFiles, d_ptr->m_tagEditorTags);
@@ -113,26 +147,44 @@ DFileService::~DFileService()
     clearFileUrlHandler(TRASH_SCHEME, "");
 }
 
+static QVector<DAbstractFileController *> controllersOfUrl(DFileService *service, const DUrl &durl)
+{
+    const HandlerType type(durl.scheme(), durl.host());
+
+    {
+        QReadLocker locker(&DFileServicePrivate::controllerCacheLock);
+        auto it = DFileServicePrivate::controllerCache.constFind(type);
+
+        if (it != DFileServicePrivate::controllerCache.constEnd())
+            return *it;
+    }
+
+    // 第一次使用时由 creator 创建控制器，之后才能缓存
+    QVector<DAbstractFileController *> controllers;
+
+    for (DAbstractFileController *controller : service->getHandlerTypeByUrl(durl) + service->getHandlerTypeByUrl(durl, true)) {
+        if (controller && !controllers.contains(controller))
+            controllers << controller;
+    }
+
+    QWriteLocker locker(&DFileServicePrivate::controllerCacheLock);
+    DFileServicePrivate::controllerCache.insert(type, controllers);
+
+    return controllers;
+}
+
 template<typename T>
 QVariant eventProcess(DFileService *service, const QSharedPointer<DFMEvent> &event, T function)
 {
-    QSet<DAbstractFileController *> controller_set;
-    QSet<QString> scheme_set;
+    QVarLengthArray<DAbstractFileController *, 8> controller_set;
 
     for (const DUrl &durl : event->handleUrlList()) {
-        QList<DAbstractFileController *> list = service->getHandlerTypeByUrl(durl);
-        if (!scheme_set.contains(durl.scheme())) {
-            list << service->getHandlerTypeByUrl(durl, true);
-        } else {
-            scheme_set << durl.scheme();
-        }
-
-        for (DAbstractFileController *controller : list) {
-            if (!controller || controller_set.contains(controller)) {
+        for (DAbstractFileController *controller : controllersOfUrl(service, durl)) {
+            if (std::find(controller_set.cbegin(), controller_set.cend(), controller) != controller_set.cend()) {
                 continue;
             }
 
-            controller_set << controller;
+            controller_set.append(controller);
 
             typedef typename std::remove_reference<typename QtPrivate::FunctionPointer<T>::Arguments::Car>::type::Type DFMEventType;
 
@@ -353,7 +405,10 @@ bool DFileService::fmEvent(const QSharedPointer<DFMEvent> &event, QVariant *resu
         const QSharedPointer<DFMCreateGetChildrensJob> &e = event.staticCast<DFMCreateGetChildrensJob>();
 
         if (event->isAccepted()) {
-            result = QVariant::fromValue(new JobController(e->url(), qvariant_cast<DDirIteratorPointer>(result)));
+            JobController *job = new JobController(e->url(), qvariant_cast<DDirIteratorPointer>(result));
+
+            job->setFilters(e->nameFilters(), e->filters());
+            result = QVariant::fromValue(job);
         } else {
             result = QVariant::fromValue(new JobController(e->url(), e->nameFilters(), e->filters()));
         }
@@ -443,8 +498,14 @@ bool DFileService::isRegisted(const QString &scheme, const QString &host)
     return !DFileServicePrivate::controllerCreatorHash.values(type).isEmpty() || !DFileServicePrivate::controllerHash.values(type).isEmpty();
 }
 
+/*!
+ * \brief DFileService::initHandlersByCreators 立即创建所有已注册的控制器
+ *
+ * 文件管理器启动时不再调用，控制器在第一次使用其 scheme 时由 getHandlerTypeByUrl 创建。
+ */
 void DFileService::initHandlersByCreators()
 {
+    QMutexLocker locker(&DFileServicePrivate::controllerCreatorLock);
     QMultiHash<const HandlerType, HandlerCreatorType>::const_iterator begin = DFileServicePrivate::controllerCreatorHash.constBegin();
 
     while (begin != DFileServicePrivate::controllerCreatorHash.constEnd()) {
@@ -465,6 +526,8 @@ void DFileService::clearController(const QString &scheme, const QString &host)
         delete controller;
         controller = nullptr;
     }
+
+    DFileServicePrivate::clearControllerCache();
 }
 
 DFileService *DFileService::instance()
@@ -492,6 +555,7 @@ bool DFileService::setFileUrlHandler(const QString &scheme, const QString &host,
 
     DFileServicePrivate::handlerHash[controller] = type;
     DFileServicePrivate::controllerHash.insertMulti(type, controller);
+    DFileServicePrivate::clearControllerCache();
 
     return true;
 }
@@ -503,6 +567,7 @@ void DFileService::unsetFileUrlHandler(DAbstractFileController *controller)
     }
 
     DFileServicePrivate::controllerHash.remove(DFileServicePrivate::handlerHash.value(controller), controller);
+    DFileServicePrivate::clearControllerCache();
 }
 
 void DFileService::clearFileUrlHandler(const QString &scheme, const QString &host)
@@ -516,12 +581,14 @@ void DFileService::clearFileUrlHandler(const QString &scheme, const QString &hos
                 tempTrash->deleteLater();
                 DFileServicePrivate::controllerHash.remove(handler);
                 DFileServicePrivate::controllerCreatorHash.remove(handler);
+                DFileServicePrivate::clearControllerCache();
                 return;
             }
         }
     }
     DFileServicePrivate::controllerHash.remove(handler);
     DFileServicePrivate::controllerCreatorHash.remove(handler);
+    DFileServicePrivate::clearControllerCache();
 }
 
 bool DFileService::openFile(const QObject *sender, const DUrl &url) const
@@ -835,6 +902,30 @@ bool DFileService::makeTagsOfFiles(const QObject *sender, const DUrlList &urlLis
         }
     }
 
+    // 本地文件的标记一次读取、一次写入，不再逐个文件经过事件和服务
+    const bool allLocalFiles = std::all_of(urlList.begin(), urlList.end(), [](const DUrl & durl) {
+        return durl.isLocalFile() && !VaultController::isVaultFile(durl.toLocalFile());
+    });
+
+    if (allLocalFiles) {
+        const QMap<DUrl, QStringList> &tagsOfEachFile = TagManager::instance()->getTagsOfEachFile(urlList);
+        QMap<DUrl, QStringList> newTagsOfEachFile;
+
+        for (const DUrl &durl : urlList) {
+            QSet<QString> tags_of_file_set = tags_set;
+
+            tags_of_file_set += QSet<QString>::fromList(tagsOfEachFile.value(durl));
+
+            for (const QString &dirty_tag : dirty_tagNames) {
+                tags_of_file_set.remove(dirty_tag);
+            }
+
+            newTagsOfEachFile[durl] = tags_of_file_set.toList();
+        }
+
+        return TagManager::instance()->makeTagsOfEachFile(newTagsOfEachFile);
+    }
+
     bool loopEvent = urlList.length() > 5;
     QList<DFMSetFileTagsEvent *> eventList;
     for (const DUrl &durl : urlList) {
@@ -1048,6 +1139,44 @@ bool DFileService::checkGvfsMountfileBusy(const DUrl &url, const bool showdailog
     return isbusy;
 }
 
+/*!
+ * \brief 在线程中检查网络挂载的根目录是否存在，超时认为不存在
+ *
+ * 卡住的 smb、sftp 挂载上访问根目录可能长时间不返回，上一次的检查还没有返回时直接认为不存在，
+ * 不会为同一个挂载点启动更多的线程
+ */
+static bool gvfsRootFileExists(const DUrl &rootUrl)
+{
+    static QMutex checkingMutex;
+    static QSet<DUrl> checkingUrls;
+
+    {
+        QMutexLocker lk(&checkingMutex);
+        if (checkingUrls.contains(rootUrl))
+            return false;
+        checkingUrls.insert(rootUrl);
+    }
+
+    struct CheckResult {
+        QSemaphore finished;
+        QAtomicInt exists;
+    };
+    QSharedPointer<CheckResult> result(new CheckResult);
+
+    QtConcurrent::run([rootUrl, result]() {
+        const DAbstractFileInfoPointer &rootptr = DFileService::instance()->createFileInfo(nullptr, rootUrl);
+        result->exists.store(rootptr && rootptr->exists());
+
+        {
+            QMutexLocker lk(&checkingMutex);
+            checkingUrls.remove(rootUrl);
+        }
+        result->finished.release();
+    });
+
+    return result->finished.tryAcquire(1, GVFS_BUSY_CHECK_TIMEOUT) && result->exists.load();
+}
+
 bool DFileService::checkGvfsMountfileBusy(const DUrl &rootUrl, const QString &rootFileName, const bool bShowDailog)
 {
     Q_D(DFileService);
@@ -1059,8 +1188,7 @@ bool DFileService::checkGvfsMountfileBusy(const DUrl &rootUrl, const QString &ro
     setCursorBusyState(true);
 
     if (rootFileName.startsWith(SMB_SCHEME) || rootFileName.startsWith(SFTP_SCHEME)) {
-        DAbstractFileInfoPointer rootptr = createFileInfo(nullptr, rootUrl);
-        bool fileExists = rootptr->exists();
+        bool fileExists = gvfsRootFileExists(rootUrl);
         setCursorBusyState(false);
         //文件不存在弹提示框
         if (!fileExists && bShowDailog && FileUtils::isNetworkUrlMounted(rootUrl)) {
@@ -1209,19 +1337,23 @@ void DFileService::onTagEditorChanged(const QStringList &tags, const DUrlList &f
 QList<DAbstractFileController *> DFileService::getHandlerTypeByUrl(const DUrl &fileUrl, bool ignoreHost, bool ignoreScheme)
 {
     HandlerType handlerType(ignoreScheme ? "" : fileUrl.scheme(), ignoreHost ? "" : fileUrl.host());
+    QMutexLocker locker(&DFileServicePrivate::controllerCreatorLock);
 
     if (DFileServicePrivate::controllerCreatorHash.contains(handlerType)) {
-        QList<DAbstractFileController *> list = DFileServicePrivate::controllerHash.values(handlerType);
+        const QList<HandlerCreatorType> creatorList = DFileServicePrivate::controllerCreatorHash.values(handlerType);
 
-        for (const HandlerCreatorType &creator : DFileServicePrivate::controllerCreatorHash.values(handlerType)) {
+        // 先移除，控制器的构造函数中再次访问此 scheme 时不会重复创建
+        DFileServicePrivate::controllerCreatorHash.remove(handlerType);
+
+        for (const HandlerCreatorType &creator : creatorList) {
             DAbstractFileController *controller = (creator.second)();
 
-            setFileUrlHandler(handlerType.first, handlerType.second, controller);
+            // 可能在工作线程中第一次使用，控制器统一属于主线程
+            if (qApp && controller->thread() != qApp->thread())
+                controller->moveToThread(qApp->thread());
 
-            list << controller;
+            setFileUrlHandler(handlerType.first, handlerType.second, controller);
         }
-
-        DFileServicePrivate::controllerCreatorHash.remove(handlerType);
     }
 
     return DFileServicePrivate::controllerHash.values(handlerType);
@@ -1287,7 +1419,11 @@ QString DFileService::getSymlinkFileName(const DUrl &fileUrl, const QDir &target
 
 void DFileService::insertToCreatorHash(const HandlerType &type, const HandlerCreatorType &creator)
 {
+    QMutexLocker locker(&DFileServicePrivate::controllerCreatorLock);
     DFileServicePrivate::controllerCreatorHash.insertMulti(type, creator);
+    locker.unlock();
+
+    DFileServicePrivate::clearControllerCache();
 }
 
 void DFileService::laterRequestSelectFiles(const DFMUrlListBaseEvent &event) const
@@ -5,6 +5,9 @@
 #include "dfilesystemmodel.h"
 #include "dabstractfileinfo.h"
 #include "dfileservices.h"
+#include "dfmtrace.h"
+#include "dfmmetrics.h"
+#include "dfmstartupprofile.h"
 #include "dabstractfilewatcher.h"
 #include "dfmstyleditemdelegate.h"
 #include "dfmapplication.h"
@@ -22,10 +25,15 @@
 //处理自动整理的路径问题
 #include "controllers/mergeddesktopcontroller.h"
 #include "shutil/dfmfilelistfile.h"
+#include "shutil/dfmdragurls.h"
 #include "dfilesystemmodel_p.h"
+#include "dfmdirsnapshotcache.h"
+#include "dfmlistingcache.h"
 #include "dfmsettings.h"
 
 #include <memory>
+#include <algorithm>
+#include <functional>
 #include <QList>
 #include <QMap>
 #include <QDebug>
@@ -35,8 +43,26 @@
 #include <QtConcurrent/QtConcurrent>
 #include <QtGlobal>
 
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <cstring>
+
 #define fileService DFileService::instance()
 #define DEFAULT_COLUMN_COUNT 0
+//遍历结束后新增的文件不超过这个数量时逐个按顺序插入，否则整体排序
+#define INCREMENTAL_INSERT_MIN_COUNT 64
+#define INCREMENTAL_INSERT_MAX_COUNT 1024
+// 超过该数量的列表分段在线程池中排序后再归并
+#define PARALLEL_SORT_MIN_COUNT 10000
+#define PARALLEL_SORT_MAX_THREAD 8
+// 延迟加载属性时在可见区域前后预取的行数
+#define LAZY_ATTRIBUTE_PREFETCH_COUNT 50
+
+// 文件事件合并的时间窗口(ms)
+#define FILE_EVENT_COALESCE_INTERVAL 50
+// 搜索结果批量插入前最多等待的时间（毫秒）
+#define SEARCH_INSERT_INTERVAL 200
 
 static int FindInsertPosInOrderList(const FileSystemNodePointer &needNode,
         const QList<FileSystemNodePointer> &list, const DAbstractFileInfo::CompareFunction &sortFun,
@@ -46,6 +72,7 @@ static int FindInsertPosInOrderList(const FileSystemNodePointer &needNode,
     int begin = 0;
     int end = list.count();
     int row = (begin + end)/2;
+    const bool isMixDirAndFile = DFMApplication::appAttribute(DFMApplication::AA_FileAndDirMixedSort).toBool();
     // 先找到文件还是目录
     forever {
 
@@ -56,7 +83,7 @@ static int FindInsertPosInOrderList(const FileSystemNodePointer &needNode,
             break;
 
         const FileSystemNodePointer &node = list.at(row);
-        if (!sortFun(needNode->fileInfo, node->fileInfo, order, DFMApplication::appAttribute(DFMApplication::AA_FileAndDirMixedSort).toBool())) {
+        if (!sortFun(needNode->fileInfo, node->fileInfo, order, isMixDirAndFile)) {
             begin = row;
             row = (end + begin + 1) / 2;
             if (row >= end)
@@ -69,6 +96,278 @@ static int FindInsertPosInOrderList(const FileSystemNodePointer &needNode,
     return row;
 }
 
+namespace {
+struct NodeSortRange
+{
+    size_t begin;
+    size_t middle;
+    size_t end;
+};
+
+// 排序前为每个节点取出一次的排序值，比较时不再调用文件信息的虚函数
+struct NodeSortKey
+{
+    qint64 value;
+    bool isDir;
+    bool isFile;
+    int index;
+    const FileSystemNode *node;
+};
+
+typedef bool (*CompareFunctionPointer)(const DAbstractFileInfoPointer &, const DAbstractFileInfoPointer &, Qt::SortOrder, bool);
+
+bool isCompareFunction(const DAbstractFileInfo::CompareFunction &sortFun, CompareFunctionPointer fun)
+{
+    const CompareFunctionPointer *target = sortFun.target<CompareFunctionPointer>();
+
+    return target && *target == fun;
+}
+
+bool dateTimeSortValue(const QDateTime &time, qint64 *value)
+{
+    // 无效时间与有效时间的大小关系不能用整数表示，此时使用原排序函数
+    if (!time.isValid())
+        return false;
+
+    *value = time.toMSecsSinceEpoch();
+
+    return true;
+}
+
+/*!
+ * \brief 各排序角色的排序值，只有排序函数是 COMPARE_FUN_DEFINE 生成的默认函数时才能使用排序值代替
+ */
+template<int Role>
+struct NodeSortKeyTraits;
+
+template<>
+struct NodeSortKeyTraits<DFileSystemModel::FileSizeRole>
+{
+    static bool accept(const DAbstractFileInfo::CompareFunction &sortFun)
+    {
+        return isCompareFunction(sortFun, FileSortFunction::compareFileListBySize);
+    }
+
+    static bool value(const DAbstractFileInfoPointer &info, qint64 *value)
+    {
+        *value = info->fileSize();
+
+        return true;
+    }
+};
+
+template<>
+struct NodeSortKeyTraits<DFileSystemModel::FileLastModifiedRole>
+{
+    static bool accept(const DAbstractFileInfo::CompareFunction &sortFun)
+    {
+        return isCompareFunction(sortFun, FileSortFunction::compareFileListByModified);
+    }
+
+    static bool value(const DAbstractFileInfoPointer &info, qint64 *value)
+    {
+        return dateTimeSortValue(info->lastModified(), value);
+    }
+};
+
+template<>
+struct NodeSortKeyTraits<DFileSystemModel::FileCreatedRole>
+{
+    static bool accept(const DAbstractFileInfo::CompareFunction &sortFun)
+    {
+        return isCompareFunction(sortFun, FileSortFunction::compareFileListByCreated);
+    }
+
+    static bool value(const DAbstractFileInfoPointer &info, qint64 *value)
+    {
+        return dateTimeSortValue(info->created(), value);
+    }
+};
+
+template<>
+struct NodeSortKeyTraits<DFileSystemModel::FileLastReadRole>
+{
+    static bool accept(const DAbstractFileInfo::CompareFunction &sortFun)
+    {
+        return isCompareFunction(sortFun, FileSortFunction::compareFileListByLastRead);
+    }
+
+    static bool value(const DAbstractFileInfoPointer &info, qint64 *value)
+    {
+        return dateTimeSortValue(info->lastRead(), value);
+    }
+};
+
+/*!
+ * \brief 按排序值比较，结果与 COMPARE_FUN_DEFINE 生成的函数一致
+ */
+template<bool MixDirAndFile>
+struct NodeSortKeyLessThan
+{
+    Qt::SortOrder order;
+    const bool *isCancel;
+
+    bool operator()(const NodeSortKey &key1, const NodeSortKey &key2) const
+    {
+        if (*isCancel)
+            return false;
+
+        if (!MixDirAndFile) {
+            if (key1.isDir != key2.isDir)
+                return key1.isDir;
+
+            if (key1.value == key2.value && ((key1.isDir && key2.isDir) || (key1.isFile && key2.isFile)))
+                return FileSortFunction::compareByDisplayName(key1.node->fileInfo, key2.node->fileInfo);
+        } else if (key1.value == key2.value) {
+            return FileSortFunction::compareByDisplayName(key1.node->fileInfo, key2.node->fileInfo);
+        }
+
+        return ((order == Qt::DescendingOrder) ^ (key1.value < key2.value)) == 0x01;
+    }
+};
+
+/*!
+ * \brief 稳定排序，元素较多时先把列表分段，在线程池中并行排序各段，再逐轮两两归并，每一轮中的各次归并也是并行的
+ */
+template<typename T, typename LessThan>
+void stableSortParallel(std::vector<T> &items, const LessThan &lessThan, const bool *isCancel)
+{
+    const int chunkCount = items.size() < PARALLEL_SORT_MIN_COUNT
+                           ? 1 : qBound(1, QThread::idealThreadCount(), PARALLEL_SORT_MAX_THREAD);
+
+    if (chunkCount <= 1) {
+        std::stable_sort(items.begin(), items.end(), lessThan);
+        return;
+    }
+
+    QVector<NodeSortRange> ranges;
+
+    for (int i = 0; i < chunkCount; ++i) {
+        const size_t end = items.size() * static_cast<size_t>(i + 1) / static_cast<size_t>(chunkCount);
+        ranges.append({ranges.isEmpty() ? 0 : ranges.last().end, end, end});
+    }
+
+    QtConcurrent::blockingMap(ranges, [&](const NodeSortRange &range) {
+        std::stable_sort(items.begin() + range.begin, items.begin() + range.end, lessThan);
+    });
+
+    // 同一轮中归并的区间互不重叠，可以并行；相邻区间按顺序归并，保证排序稳定
+    while (ranges.size() > 1 && !*isCancel) {
+        QVector<NodeSortRange> merges;
+
+        for (int i = 0; i < ranges.size(); i += 2) {
+            if (i + 1 < ranges.size())
+                merges.append({ranges.at(i).begin, ranges.at(i).end, ranges.at(i + 1).end});
+            else
+                merges.append(ranges.at(i));
+        }
+
+        QtConcurrent::blockingMap(merges, [&](const NodeSortRange &range) {
+            if (range.middle < range.end)
+                std::inplace_merge(items.begin() + range.begin, items.begin() + range.middle, items.begin() + range.end, lessThan);
+        });
+
+        for (NodeSortRange &range : merges)
+            range.middle = range.end;
+
+        ranges = merges;
+    }
+}
+
+/*!
+ * \brief 排序函数是 Role 对应的默认函数时，先取出所有节点的排序值再排序
+ * \return 不能使用排序值时返回false，此时nodes保持不变
+ */
+template<int Role>
+bool sortNodesByKey(std::vector<FileSystemNodePointer> &nodes, const DAbstractFileInfo::CompareFunction &sortFun,
+                    Qt::SortOrder order, bool isMixDirAndFile, const bool *isCancel)
+{
+    typedef NodeSortKeyTraits<Role> Traits;
+
+    if (!Traits::accept(sortFun))
+        return false;
+
+    std::vector<NodeSortKey> keys;
+    keys.reserve(nodes.size());
+
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        const DAbstractFileInfoPointer &info = nodes.at(i)->fileInfo;
+        NodeSortKey key;
+
+        if (!info || !Traits::value(info, &key.value))
+            return false;
+
+        key.isDir = info->isDir();
+        key.isFile = info->isFile();
+        key.index = static_cast<int>(i);
+        key.node = nodes.at(i).data();
+        keys.push_back(key);
+    }
+
+    if (isMixDirAndFile)
+        stableSortParallel(keys, NodeSortKeyLessThan<true> {order, isCancel}, isCancel);
+    else
+        stableSortParallel(keys, NodeSortKeyLessThan<false> {order, isCancel}, isCancel);
+
+    if (*isCancel)
+        return true;
+
+    std::vector<FileSystemNodePointer> sortedNodes;
+    sortedNodes.reserve(nodes.size());
+
+    for (const NodeSortKey &key : keys)
+        sortedNodes.push_back(nodes.at(static_cast<size_t>(key.index)));
+
+    nodes.swap(sortedNodes);
+
+    return true;
+}
+}
+
+/*!
+ * \brief 对节点列表做稳定排序，结果与逐个调用FindInsertPosInOrderList插入一致
+ *
+ * 按大小和时间排序时使用预先取出的排序值比较，其它排序方式每次比较都调用sortFun。
+ * \return 被取消时返回false，此时list保持不变
+ */
+static bool SortNodeList(QList<FileSystemNodePointer> &list, const DAbstractFileInfo::CompareFunction &sortFun,
+                         const Qt::SortOrder &order, const bool *isCancel)
+{
+    if (!sortFun)
+        return false;
+
+    const bool isMixDirAndFile = DFMApplication::appAttribute(DFMApplication::AA_FileAndDirMixedSort).toBool();
+    std::vector<FileSystemNodePointer> nodes(list.begin(), list.end());
+
+    if (!sortNodesByKey<DFileSystemModel::FileSizeRole>(nodes, sortFun, order, isMixDirAndFile, isCancel)
+            && !sortNodesByKey<DFileSystemModel::FileLastModifiedRole>(nodes, sortFun, order, isMixDirAndFile, isCancel)
+            && !sortNodesByKey<DFileSystemModel::FileCreatedRole>(nodes, sortFun, order, isMixDirAndFile, isCancel)
+            && !sortNodesByKey<DFileSystemModel::FileLastReadRole>(nodes, sortFun, order, isMixDirAndFile, isCancel)) {
+        auto lessThan = [&](const FileSystemNodePointer &node1, const FileSystemNodePointer &node2) {
+            // 取消后不再比较，让排序尽快结束
+            if (*isCancel)
+                return false;
+
+            return sortFun(node1->fileInfo, node2->fileInfo, order, isMixDirAndFile);
+        };
+
+        stableSortParallel(nodes, lessThan, isCancel);
+    }
+
+    if (*isCancel)
+        return false;
+
+    QList<FileSystemNodePointer> sortList;
+    sortList.reserve(static_cast<int>(nodes.size()));
+
+    for (FileSystemNodePointer &node : nodes)
+        sortList.append(std::move(node));
+
+    list.swap(sortList);
+
+    return true;
+}
+
 FileSystemNode::FileSystemNode(FileSystemNode *parent,
                    const DAbstractFileInfoPointer &info,
                    DFileSystemModel *dFileSystemModel,
@@ -78,13 +377,15 @@ FileSystemNode::FileSystemNode(FileSystemNode *parent,
         , m_dFileSystemModel(dFileSystemModel)
         , rwLock(lock)
 {
-
+    resetFilterResult();
+    DFM_METRIC_INC("model.nodes");
 }
 
 FileSystemNode::~FileSystemNode()
 {
     visibleChildren.clear();
     children.clear();
+    DFM_METRIC_ADD("model.nodes", -1);
 }
 
 QVariant FileSystemNode::dataByRole(int role)
@@ -137,16 +438,47 @@ QVariant FileSystemNode::dataByRole(int role)
     }
 }
 
+/*!
+ * \brief FileSystemNode::cachedDataByRole 返回缓存的显示文本，缓存失效时调用dataByRole重新生成
+ * \param displayVersion 模型的显示版本号，语言或格式变化时增加
+ */
+QVariant FileSystemNode::cachedDataByRole(int role, int displayVersion)
+{
+    const int refreshVersion = fileInfo->refreshVersion();
+
+    if (displayDataRefreshVersion != refreshVersion || displayDataVersion != displayVersion) {
+        displayDataCache.clear();
+        displayDataRefreshVersion = refreshVersion;
+        displayDataVersion = displayVersion;
+    }
+
+    auto it = displayDataCache.constFind(role);
+
+    if (it != displayDataCache.constEnd())
+        return it.value();
+
+    const QVariant &value = dataByRole(role);
+    displayDataCache.insert(role, value);
+
+    return value;
+}
+
+void FileSystemNode::clearDisplayDataCache()
+{
+    displayDataCache.clear();
+}
+
 void FileSystemNode::setNodeVisible(const FileSystemNodePointer &node, bool visible)
 {
+    const int row = noLockIndexOfChild(node);
+
     if (visible) {
-        if (!visibleChildren.contains(node)) {
+        if (row < 0) {
             visibleChildren.append(node);
+            noLockUpdateRows(visibleChildren.size() - 1);
         }
-    } else {
-        if (visibleChildren.contains(node)) {
-            visibleChildren.removeOne(node);
-        }
+    } else if (row >= 0) {
+        noLockTakeVisibleChild(row);
     }
 }
 
@@ -157,35 +489,25 @@ void FileSystemNode::applyFileFilter(std::shared_ptr<FileFilter> filter)
     // fix bug 54887 【专业版1030】【文管5.2.0.82】搜索结果页多次筛选后，再重置筛选结果，重置搜索界面页面，出现重复搜索界面
     // 点击重置按钮，会触发所有combox的change信号，都会访问visibleChildren资源，因此加锁限制
     rwLock->lockForWrite();
-    visibleChildren.clear();
+    QList<FileSystemNodePointer> list;
+    list.reserve(children.size());
 
     for (auto node : children) {
         if (!node->shouldHideByFilterRule(filter)) {
-            visibleChildren.append(node);
+            list.append(node);
         }
     }
+    noLockSetVisibleChildren(list);
     rwLock->unlock();
 }
 
 void FileSystemNode::sortAllChildren(const DAbstractFileInfo::CompareFunction &sortFun, const Qt::SortOrder &order, const bool *cancel) {
     if (!sortFun)
         return;
-    QList<FileSystemNodePointer> sortList;
-    int row = 0;
     rwLock->lockForWrite();
-    for (const auto & needNode : visibleChildren) {
-        if (*cancel) {
-            rwLock->unlock();
-            return;
-        }
-        row = FindInsertPosInOrderList(needNode, sortList, sortFun, order, cancel);
-        if (*cancel) {
-            rwLock->unlock();
-            return;
-        }
-        sortList.insert(row, needNode);
-    }
-    visibleChildren = sortList;
+    QList<FileSystemNodePointer> sortList = visibleChildren;
+    if (SortNodeList(sortList, sortFun, order, cancel))
+        noLockSetVisibleChildren(sortList);
     rwLock->unlock();
 }
 
@@ -193,53 +515,86 @@ bool FileSystemNode::shouldHideByFilterRule(std::shared_ptr<FileFilter> filter)
 {
     if (!filter) return false;
 
-    if (filter->f_comboValid[SEARCH_RANGE] && !filter->f_includeSubDir) {
+    for (int labelIndex = SEARCH_RANGE; labelIndex < LABEL_COUNT; ++labelIndex) {
+        if (!filter->f_comboValid[labelIndex])
+            continue;
+
+        if (filterVersion[labelIndex] != filter->f_version[labelIndex]) {
+            filterVersion[labelIndex] = filter->f_version[labelIndex];
+
+            if (hideByFilterRule(filter.get(), labelIndex)) {
+                filterHiddenMask |= (1u << labelIndex);
+            } else {
+                filterHiddenMask &= ~(1u << labelIndex);
+            }
+        }
+
+        if (filterHiddenMask & (1u << labelIndex))
+            return true;
+    }
+
+    return false;
+}
+
+void FileSystemNode::resetFilterResult()
+{
+    // -1 不会与任何筛选条件的版本号相同，下次筛选时重新计算
+    std::fill(std::begin(filterVersion), std::end(filterVersion), -1);
+    filterHiddenMask = 0;
+    nameFilterVersion = -1;
+}
+
+bool FileSystemNode::hideByFilterRule(const FileFilter *filter, int labelIndex)
+{
+    switch (labelIndex) {
+    case SEARCH_RANGE: {
+        if (filter->f_includeSubDir)
+            return false;
+
         DUrl parentUrl = fileInfo->parentUrl().isSearchFile() ? fileInfo->parentUrl().searchTargetUrl() : fileInfo->parentUrl();
         QString filePath = dataByRole(DFileSystemModel::FilePathRole).toString();
         // fix bug 44185 【专业版 sp3】【文件管理器】【5.2.0.28-1】多标签操作筛选搜索结果，回退路径时出现空白页面
         filePath.remove(parentUrl.toLocalFile().endsWith("/") ?  parentUrl.toLocalFile() : parentUrl.toLocalFile() + '/');
-        if (filePath.contains('/')) return true;
+        return filePath.contains('/');
     }
-
-    if (filter->f_comboValid[FILE_TYPE]) {
+    case FILE_TYPE: {
         QString fileTypeStr = dataByRole(DFileSystemModel::FileMimeTypeRole).toString();
-        if (!fileTypeStr.startsWith(filter->f_typeString)) return true;
+        return !fileTypeStr.startsWith(filter->f_typeString);
     }
-
-    if (filter->f_comboValid[SIZE_RANGE]) {
+    case SIZE_RANGE: {
         // note: FileSizeInKiloByteRole is the size of Byte, not KB!
         quint64 fileSize = dataByRole(DFileSystemModel::FileSizeInKiloByteRole).toULongLong();
         quint32 blockSize = 1 << 10;
         quint64 lower = filter->f_sizeRange.first * blockSize;
         quint64 upper = filter->f_sizeRange.second * blockSize;
         // filter file size in Bytes, not Kilobytes
-        if (fileSize < lower || fileSize > upper) return true;
+        return fileSize < lower || fileSize > upper;
     }
-
-    if (filter->f_comboValid[DATE_RANGE]) {
+    case DATE_RANGE: {
         QDateTime filemtime = dataByRole(DFileSystemModel::FileLastModifiedDateTimeRole).toDateTime();
-        if (filemtime < filter->f_dateRangeStart || filemtime > filter->f_dateRangeEnd) return true;
+        return filemtime < filter->f_dateRangeStart || filemtime > filter->f_dateRangeEnd;
     }
-
-    if (filter->f_comboValid[ACCESS_DATE_RANGE]) {
+    case ACCESS_DATE_RANGE: {
         QDateTime filemtime = dataByRole(DFileSystemModel::FileLastReadDateTimeRole).toDateTime();
-        if (filemtime < filter->f_accessDateRangeStart || filemtime > filter->f_accessDateRangeEnd) return true;
+        return filemtime < filter->f_accessDateRangeStart || filemtime > filter->f_accessDateRangeEnd;
     }
-
-    if (filter->f_comboValid[CREATE_DATE_RANGE]) {
+    case CREATE_DATE_RANGE: {
         QDateTime filemtime = dataByRole(DFileSystemModel::FileCreatedDateTimeRole).toDateTime();
-        if (filemtime < filter->f_createDateRangeStart || filemtime > filter->f_createDateRangeEnd) return true;
+        return filemtime < filter->f_createDateRangeStart || filemtime > filter->f_createDateRangeEnd;
+    }
+    default:
+        return false;
     }
-
-    return false;
 }
 
 void FileSystemNode::noLockInsertChildren(int index, const DUrl &url, const FileSystemNodePointer &node)
 {
     // fix bug 105595
-    if (!children.contains(url)) {
-        children[url] = node;
+    const DFMPathKey key(url);
+    if (!children.contains(key)) {
+        children.insert(key, node);
         visibleChildren.insert(index, node);
+        noLockUpdateRows(index);
     }
 }
 
@@ -275,9 +630,11 @@ int FileSystemNode::insertChildren(const DUrl &url, const FileSystemNodePointer
 void FileSystemNode::noLockAppendChildren(const DUrl &url, const FileSystemNodePointer &node)
 {
     // fix bug 105595
-    if (!children.contains(url)) {
-        children[url] = node;
+    const DFMPathKey key(url);
+    if (!children.contains(key)) {
+        children.insert(key, node);
         visibleChildren.append(node);
+        noLockUpdateRows(visibleChildren.size() - 1);
     }
 }
 
@@ -316,7 +673,9 @@ FileSystemNodePointer FileSystemNode::takeNodeByUrl(const DUrl &url)
 {
     rwLock->lockForWrite();
     FileSystemNodePointer node = children.take(url);
-    visibleChildren.removeOne(node);
+    const int row = noLockIndexOfChild(node);
+    if (row >= 0)
+        noLockTakeVisibleChild(row);
     rwLock->unlock();
 
     return node;
@@ -327,12 +686,13 @@ FileSystemNodePointer FileSystemNode::takeNodeByIndex(const int index, const boo
     rwLock->lockForWrite();
     FileSystemNodePointer node;
     if (index >= 0 && visibleChildren.size() > index) {
-        node = visibleChildren.takeAt(index);
+        node = noLockTakeVisibleChild(index);
+        const DFMPathKey key(node->fileInfo->fileUrl());
 
         if (*isCache && !fileInfo->fileUrl().isSearchFile())
-            removeCacheChildren.insert(node->fileInfo->fileUrl(), node);
+            removeCacheChildren.insert(key, node);
 
-        children.remove(node->fileInfo->fileUrl());
+        children.remove(key);
     } else {
         qWarning() << "index [" << index << "] out of range [" << visibleChildren.size() << "]";
     }
@@ -343,21 +703,20 @@ FileSystemNodePointer FileSystemNode::takeNodeByIndex(const int index, const boo
 
 int FileSystemNode::indexOfChild(const FileSystemNodePointer &node)
 {
-    rwLock->lockForRead();
-    int index = visibleChildren.indexOf(node);
-    rwLock->unlock();
+    QReadLocker rl(rwLock);
 
-    return index;
+    return noLockIndexOfChild(node);
 }
 
 int FileSystemNode::indexOfChild(const DUrl &url)
 {
-    rwLock->lockForRead();
-    const FileSystemNodePointer &node = children.value(url);
-    int index = visibleChildren.indexOf(node);
-    rwLock->unlock();
+    QReadLocker rl(rwLock);
+
+    auto it = children.constFind(url);
+    if (it == children.constEnd())
+        return -1;
 
-    return index;
+    return noLockIndexOfChild(it.value());
 }
 
 int FileSystemNode::childrenCount()
@@ -393,9 +752,9 @@ DUrlList FileSystemNode::getChildrenUrlList()
     return list;
 }
 
-QHash<DUrl, FileSystemNodePointer> FileSystemNode::getChildrenMap() const
+QHash<DFMPathKey, FileSystemNodePointer> FileSystemNode::getChildrenMap() const
 {
-    QHash<DUrl, FileSystemNodePointer> map;
+    QHash<DFMPathKey, FileSystemNodePointer> map;
     rwLock->lockForRead();
     map = children;
     rwLock->unlock();
@@ -406,12 +765,12 @@ QHash<DUrl, FileSystemNodePointer> FileSystemNode::getChildrenMap() const
 void FileSystemNode::setChildrenList(const QList<FileSystemNodePointer> &list)
 {
     rwLock->lockForWrite();
-    visibleChildren = list;
+    noLockSetVisibleChildren(list);
 
     rwLock->unlock();
 }
 
-void FileSystemNode::setChildrenMap(const QHash<DUrl, FileSystemNodePointer> &map)
+void FileSystemNode::setChildrenMap(const QHash<DFMPathKey, FileSystemNodePointer> &map)
 {
     rwLock->lockForWrite();
     children = map;
@@ -421,7 +780,7 @@ void FileSystemNode::setChildrenMap(const QHash<DUrl, FileSystemNodePointer> &ma
 void FileSystemNode::clearChildren()
 {
     rwLock->lockForWrite();
-    visibleChildren.clear();
+    noLockSetVisibleChildren(QList<FileSystemNodePointer>());
     children.clear();
     rwLock->unlock();
 }
@@ -478,33 +837,79 @@ const FileSystemNodePointer FileSystemNode::getFileSystemNode(FileSystemNode *pa
     return tmpNode1;
 }
 
-void FileSystemNode::setChildren(const QHash<DUrl, FileSystemNodePointer> &map, const QList<FileSystemNodePointer> &list, bool &isInsertCache, const DAbstractFileInfo::CompareFunction &sortFun, const Qt::SortOrder &order, const bool &isCancel)
+void FileSystemNode::setChildren(const QHash<DFMPathKey, FileSystemNodePointer> &map, const QList<FileSystemNodePointer> &list, bool &isInsertCache, const DAbstractFileInfo::CompareFunction &sortFun, const Qt::SortOrder &order, const bool &isCancel)
 {
     rwLock->lockForWrite();
     // 加入刚插入的，删除已移除的文件，再赋值
     isInsertCache = false;
     children = map;
-    visibleChildren = list;
+    noLockSetVisibleChildren(list);
     int row = 0;
-    for (auto fileUrl : insertCacheChildren.keys()) {
-        if (children.contains(fileUrl))
+    for (auto it = insertCacheChildren.constBegin(); it != insertCacheChildren.constEnd(); ++it) {
+        if (children.contains(it.key()))
             continue;
-        const FileSystemNodePointer &node = insertCacheChildren.value(fileUrl);
-        children[fileUrl] = node;
+        const FileSystemNodePointer &node = it.value();
+        children.insert(it.key(), node);
         row = FindInsertPosInOrderList(node, visibleChildren, sortFun, order, &isCancel);
         visibleChildren.insert(row, node);
     }
 
     insertCacheChildren.clear();
 
-    for (auto fileUrl : removeCacheChildren.keys()) {
-        children.remove(fileUrl);
-        visibleChildren.removeOne(removeCacheChildren.value(fileUrl));
+    for (auto it = removeCacheChildren.constBegin(); it != removeCacheChildren.constEnd(); ++it) {
+        children.remove(it.key());
+        if (visibleChildren.removeOne(it.value()) && it.value())
+            it.value()->visibleRow = -1;
     }
     removeCacheChildren.clear();
+    // 插入和删除缓存的节点后统一更新位置
+    noLockUpdateRows(0);
     rwLock->unlock();
 }
 
+int FileSystemNode::noLockIndexOfChild(const FileSystemNodePointer &node) const
+{
+    if (node) {
+        const int row = node->visibleRow;
+        if (row < 0)
+            return -1;
+
+        if (row < visibleChildren.size() && visibleChildren.at(row) == node)
+            return row;
+    }
+
+    return visibleChildren.indexOf(node);
+}
+
+void FileSystemNode::noLockUpdateRows(int from)
+{
+    for (int i = qMax(from, 0); i < visibleChildren.size(); ++i) {
+        if (const FileSystemNodePointer &node = visibleChildren.at(i))
+            node->visibleRow = i;
+    }
+}
+
+void FileSystemNode::noLockSetVisibleChildren(const QList<FileSystemNodePointer> &list)
+{
+    for (const FileSystemNodePointer &node : visibleChildren) {
+        if (node)
+            node->visibleRow = -1;
+    }
+
+    visibleChildren = list;
+    noLockUpdateRows(0);
+}
+
+FileSystemNodePointer FileSystemNode::noLockTakeVisibleChild(int row)
+{
+    FileSystemNodePointer node = visibleChildren.takeAt(row);
+    if (node)
+        node->visibleRow = -1;
+    noLockUpdateRows(row);
+
+    return node;
+}
+
 FileNodeManagerThread::FileNodeManagerThread(DFileSystemModel *parent)
     : QThread(parent)
     , waitTimer(new QTimer(this))
@@ -524,14 +929,18 @@ void FileNodeManagerThread::start()
     QThread::start();
 }
 
-void FileNodeManagerThread::addFile(const DAbstractFileInfoPointer &info, bool append, bool isEnd)
+void FileNodeManagerThread::addFiles(const QList<DAbstractFileInfoPointer> &infoList, bool append, bool isEnd)
 {
     QMutexLocker lk(&mutex);
     if (!enable)
         return;
 
-    if (info)
-        fileQueue.enqueue(qMakePair(append ? AppendFile : AddFile, info));
+    for (const DAbstractFileInfoPointer &info : infoList) {
+        if (info)
+            fileQueue.enqueue(qMakePair(append ? AppendFile : AddFile, info));
+    }
+
+    DFM_METRIC_SET("model.fileQueue", fileQueue.count());
 
     if (isEnd)
         jobFinisded = true;
@@ -625,10 +1034,13 @@ void FileNodeManagerThread::run()
     // 缓存需要批量插入的文件信息列表
     QList<DAbstractFileInfoPointer> backlogFileInfoList;
     QList<DAbstractFileInfoPointer> backlogDirInfoList;
+    // 遍历结束后新增的需要排序的文件
+    QList<FileSystemNodePointer> pendingNodeList;
     // 使用计时器避免文件在批量插入列表中等待太久
-    QTime timerOfFileList, timerOfDirList;
+    QTime timerOfFileList, timerOfDirList, timerOfPendingList;
 
     auto insertInfoList = [&](int index, const QList<DAbstractFileInfoPointer> &list) {
+        DFM_TRACE_SPAN("model", "insertRows");
         DThreadUtil::runInThread(&semaphore, model()->thread(), model(), &DFileSystemModel::beginInsertRows,
                                  model()->createIndex(rootNode, 0), index, index + list.count() - 1);
 
@@ -705,6 +1117,84 @@ void FileNodeManagerThread::run()
         return true;
     };
 
+    // 新增的文件较少时通过二分查找逐个插入到排序的位置，只通知插入的行；较多时整体排序一次
+    auto disposePendingNodeList = [&](const DAbstractFileInfo::CompareFunction &compareFun) {
+        if (pendingNodeList.isEmpty())
+            return true;
+
+        const Qt::SortOrder order = model()->sortOrder();
+        const int incrementalCount = qBound(INCREMENTAL_INSERT_MIN_COUNT, rootNode->childrenCount() / 16, INCREMENTAL_INSERT_MAX_COUNT);
+
+        if (pendingNodeList.count() <= incrementalCount) {
+            for (const FileSystemNodePointer &node : pendingNodeList) {
+                if (!enable)
+                    return false;
+
+                const DUrl &url = node->fileInfo->fileUrl();
+                if (rootNode->childContains(url))
+                    continue;
+
+                const int row = rootNode->insertChildren(url, node, compareFun, order, false);
+                DThreadUtil::runInThread(&semaphore, model()->thread(), model(), &DFileSystemModel::beginInsertRows,
+                                         model()->createIndex(rootNode, 0), row, row);
+
+                if (!enable)
+                    return false;
+
+                bool isCache = false;
+                rootNode->insertChildren(row, url, node, &isCache);
+                DThreadUtil::runInThread(&semaphore, model()->thread(), model(), &DFileSystemModel::endInsertRows);
+            }
+        } else {
+            isInsertCache = true;
+            const QList<FileSystemNodePointer> &oldChildren = rootNode->getChildrenList();
+            QHash<DFMPathKey, FileSystemNodePointer> children = rootNode->getChildrenMap();
+            QList<FileSystemNodePointer> newChildren;
+            for (const FileSystemNodePointer &node : pendingNodeList) {
+                const DUrl &url = node->fileInfo->fileUrl();
+                const DFMPathKey key(url);
+                if (!children.contains(key)) {
+                    children.insert(key, node);
+                    newChildren.append(node);
+                }
+            }
+
+            // 已有的文件是有序的，只排序新增的文件，再合并两个有序列表
+            model()->sortByMySelf(newChildren, compareFun);
+            const bool isMixDirAndFile = DFMApplication::appAttribute(DFMApplication::AA_FileAndDirMixedSort).toBool();
+            QList<FileSystemNodePointer> visibleChildren;
+            visibleChildren.reserve(oldChildren.count() + newChildren.count());
+            int oldIndex = 0;
+            int newIndex = 0;
+            while (oldIndex < oldChildren.count() || newIndex < newChildren.count()) {
+                if (newIndex >= newChildren.count()
+                        || (oldIndex < oldChildren.count() && (!compareFun
+                            || !compareFun(newChildren.at(newIndex)->fileInfo, oldChildren.at(oldIndex)->fileInfo, order, isMixDirAndFile)))) {
+                    visibleChildren.append(oldChildren.at(oldIndex++));
+                } else {
+                    visibleChildren.append(newChildren.at(newIndex++));
+                }
+            }
+            const bool isCancel = !enable;
+            rootNode->setChildren(children, visibleChildren, isInsertCache, compareFun, order, isCancel);
+
+            if (!enable)
+                return false;
+
+            DThreadUtil::runInThread(&semaphore, model()->thread(), model(), &DFileSystemModel::beginInsertRows,
+                                     model()->createIndex(rootNode, 0), 0, rootNode->childrenCount() - 1);
+
+            if (!enable)
+                return false;
+
+            DThreadUtil::runInThread(&semaphore, model()->thread(), model(), &DFileSystemModel::endInsertRows);
+        }
+
+        pendingNodeList.clear();
+
+        return enable.load();
+    };
+
     auto removeInList = [&](QList<DAbstractFileInfoPointer> &list, const DUrl & url) {
         for (int i = 0; i < list.count(); ++i) {
             if (list.at(i)->fileUrl() == url) {
@@ -717,10 +1207,10 @@ void FileNodeManagerThread::run()
         return false;
     };
 begin:
-    QList<FileSystemNodePointer> visibleChildren;
-    QHash<DUrl, FileSystemNodePointer> children;
     DAbstractFileInfo::CompareFunction compareFun{nullptr};
     bool tempjobFinisded = jobFinisded;
+    // 搜索结果会持续到达，与遍历结束后新增的文件一样先缓存再批量插入，避免每个结果都同步到界面线程插入一行
+    const bool isSearchRoot = rootNode->fileInfo && rootNode->fileInfo->fileUrl().isSearchFile();
     while (!fileQueue.isEmpty() || !jobFinisded) {
         if (!enable) {
             return;
@@ -738,11 +1228,6 @@ begin:
 
         const QPair<EventType, DAbstractFileInfoPointer> &v = dequeueFileQueue();
         const DAbstractFileInfoPointer &fileInfo = v.second;
-        if (tempjobFinisded && visibleChildren.isEmpty() && !isFileQueueEmpty()) {
-            isInsertCache = true;
-            visibleChildren = rootNode->getChildrenList();
-            children = rootNode->getChildrenMap();
-        }
         if (!fileInfo) {
             continue;
         }
@@ -760,18 +1245,16 @@ begin:
                 FileSystemNodePointer node = model()->createNode(rootNode.data(), fileInfo);
                 row = 0;
                 if (!node->shouldHideByFilterRule(model()->advanceSearchFilter())) {
-                    if (!rootNode->fileInfo->fileUrl().isSearchFile() && tempjobFinisded &&
-                            (!isFileQueueEmpty() || !visibleChildren.isEmpty())) {
-                        bool cancel = enable;
-                        children[fileInfo->fileUrl()] = node;
-                        visibleChildren.append(node);
-                        if (isFileQueueEmpty()) {
-                            model()->sortByMySelf(visibleChildren, compareFun);
-                            rootNode->setChildren(children, visibleChildren, isInsertCache,
-                                                  compareFun, model()->sortOrder(), cancel);
-                        } else {
-                            continue;
+                    if (isSearchRoot || tempjobFinisded) {
+                        // 遍历结束后新增的文件先缓存，队列处理完或者等待太久时再插入
+                        if (pendingNodeList.isEmpty())
+                            timerOfPendingList.start();
+                        pendingNodeList.append(node);
+                        if ((isFileQueueEmpty() || timerOfPendingList.elapsed() > (isSearchRoot ? SEARCH_INSERT_INTERVAL : 1000))
+                                && !disposePendingNodeList(compareFun)) {
+                            return;
                         }
+                        continue;
                     } else {
                        row = rootNode->insertChildren(fileInfo->fileUrl(), node, compareFun, model()->sortOrder());
                     }
@@ -808,18 +1291,8 @@ begin:
                 if (!enable)
                     return;
 
-                int refreshRow = row;
-                int refreshEndRow = row;
-                // 搜索目录还是走以前的逻辑
-                if (!rootNode->fileInfo->fileUrl().isSearchFile() && tempjobFinisded && isFileQueueEmpty()) {
-                    refreshRow = 0;
-                    refreshEndRow = rootNode->childrenCount() - 1;
-                } else if (!rootNode->fileInfo->fileUrl().isSearchFile() && tempjobFinisded && !isFileQueueEmpty()){
-                    continue;
-                }
-
                 DThreadUtil::runInThread(&semaphore, model()->thread(), model(), &DFileSystemModel::beginInsertRows,
-                                         model()->createIndex(rootNode, 0), refreshRow, refreshEndRow);
+                                         model()->createIndex(rootNode, 0), row, row);
 
                 if (!enable)
                     return;
@@ -828,6 +1301,14 @@ begin:
             }
         } else {
             // 先尝试从待插入列表中删除
+            auto pendingIt = std::find_if(pendingNodeList.begin(), pendingNodeList.end(), [&fileUrl](const FileSystemNodePointer &node) {
+                return node->fileInfo->fileUrl() == fileUrl;
+            });
+            if (pendingIt != pendingNodeList.end()) {
+                pendingNodeList.erase(pendingIt);
+                continue;
+            }
+
             if (fileInfo->isFile()) {
                 if (removeInList(backlogFileInfoList, fileUrl)) {
                     continue;
@@ -857,6 +1338,7 @@ begin:
     }
 
     // 退出前确保所有文件都被处理
+    disposePendingNodeList(compareFun);
     disposeBacklogFileList();
     disposeBacklogDirList();
 
@@ -883,11 +1365,19 @@ DFileSystemModelPrivate::DFileSystemModelPrivate(DFileSystemModel *qq)
 
     columnCompact = DFMApplication::instance()->appAttribute(DFMApplication::AA_ViewComppactMode).toBool();
 
+    fileEventTimer = new QTimer(qq);
+    fileEventTimer->setSingleShot(true);
+    fileEventTimer->setInterval(FILE_EVENT_COALESCE_INTERVAL);
+    qq->connect(fileEventTimer, &QTimer::timeout, qq, [this] {
+        _q_processFileEvent();
+    });
+
     qq->connect(rootNodeManager, &FileNodeManagerThread::finished, qq, [this, qq] {
         // 在此线程结束时判断是否需要将model的状态设置为空闲
         if (!jobController || !jobController->isRunning())
         {
             qq->setState(DFileSystemModel::Idle);
+            saveDirSnapshot();
         }
         //当遍历文件的耗时超过JobController::m_timeCeiling时，
         //onJobFinished函数中拿到的文件不足，因为rootNodeManager还要处理剩余文件
@@ -905,37 +1395,30 @@ DFileSystemModelPrivate::~DFileSystemModelPrivate()
 
 bool DFileSystemModelPrivate::passNameFilters(const FileSystemNodePointer &node) const
 {
-    if (nameFilters.isEmpty())
+    if (nameFilterMatcher.isEmpty())
         return true;
- 
+
     if (!node || !node->fileInfo)
         return true;
 
-    // 大量的过滤规则场景时，框选会出现卡顿，在性能较差的平台上较明显
-    const DUrl fileUrl = node->fileInfo->fileUrl();
-    if (nameFiltersMatchResultMap.contains(fileUrl))
-        return nameFiltersMatchResultMap.value(fileUrl, false);
+    // 大量的过滤规则场景时，框选会出现卡顿，在性能较差的平台上较明显，所以结果记录在节点上
+    if (node->nameFilterVersion == nameFilterVersion)
+        return node->nameFilterPassed;
 
     // Check the name regularexpression filters
-    if (!(node->fileInfo->isDir() && (filters & QDir::Dirs))) {
-        const Qt::CaseSensitivity caseSensitive = (filters & QDir::CaseSensitive) ? Qt::CaseSensitive : Qt::CaseInsensitive;
-        const QString &fileDisplayName = node->fileInfo->fileDisplayName();
-        QRegExp re("", caseSensitive, QRegExp::Wildcard);
-
-        for (int i = 0; i < nameFilters.size(); ++i) {
-            re.setPattern(nameFilters.at(i));
-            if (re.exactMatch(fileDisplayName)) {
-                nameFiltersMatchResultMap[fileUrl] = true;
-                return true;
-            }
-        }
+    node->nameFilterPassed = (node->fileInfo->isDir() && (filters & QDir::Dirs))
+                             || nameFilterMatcher.matches(node->fileInfo->fileDisplayName());
+    node->nameFilterVersion = nameFilterVersion;
 
-        nameFiltersMatchResultMap[fileUrl] = false;
-        return false;
-    }
+    return node->nameFilterPassed;
+}
 
-    nameFiltersMatchResultMap[fileUrl] = true;
-    return true;
+void DFileSystemModelPrivate::updateNameFilterMatcher()
+{
+    const Qt::CaseSensitivity caseSensitive = (filters & QDir::CaseSensitive) ? Qt::CaseSensitive : Qt::CaseInsensitive;
+
+    nameFilterMatcher = DFMNameFilterMatcher(nameFilters, caseSensitive);
+    ++nameFilterVersion;
 }
 
 bool DFileSystemModelPrivate::passFileFilters(const DAbstractFileInfoPointer &info) const
@@ -986,10 +1469,7 @@ void DFileSystemModelPrivate::_q_onFileCreated(const DUrl &fileUrl, bool isPickU
         return;
     }
 //    rootNodeManager->addFile(info);
-    mutex.lock();
-    fileEventQueue.enqueue(qMakePair(AddFile, fileUrl));
-    mutex.unlock();
-    q->metaObject()->invokeMethod(q, QT_STRINGIFY(_q_processFileEvent), Qt::QueuedConnection);
+    enqueueFileEvent(AddFile, fileUrl);
 
 //    if (!_q_processFileEvent_runing.load()) {
 //        queueWLock.lockForWrite();
@@ -1008,8 +1488,6 @@ void DFileSystemModelPrivate::_q_onFileCreated(const DUrl &fileUrl, bool isPickU
 
 void DFileSystemModelPrivate::_q_onFileDeleted(const DUrl &fileUrl)
 {
-    Q_Q(DFileSystemModel);
-
 //    rootNodeManager->removeFile(DFileService::instance()->createFileInfo(q, fileUrl));
     //当文件删除时，删除隐藏文件集中的隐藏
     QString absort = fileUrl.path().left(fileUrl.path().length() - fileUrl.fileName().length());
@@ -1019,10 +1497,7 @@ void DFileSystemModelPrivate::_q_onFileDeleted(const DUrl &fileUrl)
         flf.save();
     }
 
-    mutex.lock();
-    fileEventQueue.enqueue(qMakePair(RmFile, fileUrl));
-    mutex.unlock();
-    q->metaObject()->invokeMethod(q, QT_STRINGIFY(_q_processFileEvent), Qt::QueuedConnection);
+    enqueueFileEvent(RmFile, fileUrl);
 //    if (!_q_processFileEvent_runing.load()) {
 //        while (!laterFileEventQueue.isEmpty()) {
 //            fileEventQueue.enqueue(laterFileEventQueue.dequeue());
@@ -1035,164 +1510,652 @@ void DFileSystemModelPrivate::_q_onFileDeleted(const DUrl &fileUrl)
 }
 
 void DFileSystemModelPrivate::_q_onFileUpdated(const DUrl &fileUrl)
+{
+    enqueueFileEvent(UpdateFile, fileUrl);
+}
+
+void DFileSystemModelPrivate::updateFileNode(const DUrl &fileUrl)
 {
     Q_Q(DFileSystemModel);
 
     //fix 31327， 监控./.hidden文件更改
     //bug#30019 task#40201 补充
-    if ((fileUrl.fileName() == ".hidden") && !(q->filters() & QDir::Hidden)) {
-        q->refresh();
+    if (fileUrl.fileName() == ".hidden") {
+        // 文件被其他进程修改时修改时间可能不变（如同一时刻写入两次），丢弃缓存以重新解析
+        DFMFileListFile::invalidate(fileUrl.parentUrl().path());
+        if (!(q->filters() & QDir::Hidden))
+            q->refresh();
+    }
+
+    const FileSystemNodePointer &node = rootNode;
+
+    if (!node) {
+        return;
+    }
+
+    const QModelIndex &index = q->index(fileUrl);
+
+    if (!index.isValid()) {
+        return;
+    }
+
+    if (const DAbstractFileInfoPointer &fileInfo = q->fileInfo(index)) {
+        fileInfo->refresh(true);
+    }
+
+    if (const FileSystemNodePointer &fileNode = q->getNodeByIndex(index)) {
+        fileNode->resetFilterResult();
+        fileNode->clearDisplayDataCache();
+    }
+
+    resetLazyAttributes(index);
+    q->parent()->parent()->update(index);
+//    emit q->dataChanged(index, index);
+    //recentfile变更需要调整排序
+    if (fileUrl.isRecentFile()) {
+        //fileinfo已在recentcontroller中更新，只需要重排序
+        q->sort();
+    }
+}
+
+void DFileSystemModelPrivate::_q_onFileUpdated(const DUrl &fileUrl, const int &isExternalSource)
+{
+    Q_Q(DFileSystemModel);
+
+    const FileSystemNodePointer &node = rootNode;
+    //fix 27828 文件属性改变刷新一次缓存数据,这里只是刷缓存数据
+    if (!node) {
+        return;
+    }
+
+    const QModelIndex &index = q->index(fileUrl);
+
+    if (!index.isValid()) {
+        return;
+    }
+
+    if (const DAbstractFileInfoPointer &fileInfo = q->fileInfo(index)) {
+        if (isExternalSource) {
+            fileInfo->refresh(fileInfo->isGvfsMountFile());
+        }
+    }
+
+    if (const FileSystemNodePointer &fileNode = q->getNodeByIndex(index)) {
+        fileNode->resetFilterResult();
+        fileNode->clearDisplayDataCache();
+    }
+
+    resetLazyAttributes(index);
+    q->parent()->parent()->update(index);
+//    emit q->dataChanged(index, index);
+}
+
+void DFileSystemModelPrivate::_q_onFileRename(const DUrl &from, const DUrl &to)
+{
+    Q_Q(DFileSystemModel);
+
+    //如果被重命名的目录是root目录，则不刷新该目录,而是直接退回到上层目录
+    bool isLocalFile = from.isLocalFile() || (from.isVaultFile() || to.isVaultFile());
+    if (isLocalFile && from.path() == rootNode->dataByRole(DFileSystemModel::Roles::FilePathRole).toString()) {
+        QString trashPath = DFMStandardPaths::location(DFMStandardPaths::TrashPath);
+        bool isMoveToTrash = to.toLocalFile().contains(trashPath);
+        if (!isMoveToTrash && !to.toLocalFile().isEmpty()) {
+            // re-enter directory if tab root directory renamed.
+            DFileView *fileview = static_cast<DFileView *>(q->parent()->parent());
+            fileSignalManager->requestRedirectTabUrl(fileview->rootUrl(), to);
+        }
+
+        return;
+    }
+    _q_onFileDeleted(from);
+    _q_onFileCreated(to);
+}
+
+void DFileSystemModelPrivate::_q_processFileEvent()
+{
+    Q_Q(DFileSystemModel);
+    //处理异步正在执行此函数，但是当前类释放了
+    QPointer<DFileSystemModel> me = q;
+    if (_q_processFileEvent_runing.load()) {
+        return;
+    }
+
+    // CAS
+    bool expect = false;
+    _q_processFileEvent_runing.compare_exchange_strong(expect, true);
+
+    while (checkFileEventQueue()) {
+        if (!q->isDesktop)  //紧急修复，由于修复bug#33209添加了一次事件循环的处理，导致桌面的自动排列在删除，恢复文件时显示异常
+            qApp->processEvents();
+
+        if (me.isNull()) { // 当前窗口被关闭以后，me 指针指向的窗口会马上被析构，后面的流程不需要再走了
+            return;
+        }
+        mutex.lock();
+        const QList<QPair<EventType, DUrl>> &events = coalesceFileEvents(fileEventQueue);
+        fileEventQueue.clear();
+        mutex.unlock();
+
+        QList<DAbstractFileInfoPointer> addInfoList;
+        QList<DUrl> removeUrlList;
+
+        for (const QPair<EventType, DUrl> &event : events) {
+            const DUrl &fileUrl = event.second;
+
+            if (event.first == UpdateFile) {
+                updateFileNode(fileUrl);
+
+                if (me.isNull()) {
+                    return;
+                }
+
+                continue;
+            }
+
+            const DUrl &rootUrl = q->rootUrl();
+
+            // 在时间窗口内创建后又删除的文件不在列表中，无需处理
+            if (event.first == RmFile && rootNode && fileUrl != rootUrl
+                    && rootUrl.scheme() != BURN_SCHEME && !rootNode->childContains(fileUrl)) {
+                continue;
+            }
+
+            const DAbstractFileInfoPointer &info = DFileService::instance()->createFileInfo(q, fileUrl);
+
+            if (!info) {
+                continue;
+            }
+            if (event.first != AddFile) {
+                info->refresh(info->isGvfsMountFile());
+            }
+            const DAbstractFileInfoPointer rootinfo = fileService->createFileInfo(q, rootUrl);
+            DUrl nparentUrl(info->parentUrl());
+            DUrl nfileUrl(fileUrl);
+
+            if (rootUrl.scheme() == BURN_SCHEME) {
+                QRegularExpression burn_rxp("^(.*?)/(" BURN_SEG_ONDISC "|" BURN_SEG_STAGING ")(.*)$");
+                QString rxp_after(QString("\\1/%1\\3").arg(rootUrl.burnIsOnDisc() ? BURN_SEG_ONDISC : BURN_SEG_STAGING));
+                nfileUrl.setPath(nfileUrl.path().replace(burn_rxp, rxp_after));
+                nparentUrl.setPath(nparentUrl.path().replace(burn_rxp, rxp_after));
+                if (!nparentUrl.path().endsWith('/') && rootUrl.path().endsWith("/")) {
+                    nparentUrl.setPath(nparentUrl.path() + "/");
+                }
+            }
+
+            if (nfileUrl == rootUrl) {
+                if (event.first == RmFile) {
+                    //! close tab if root url deleted.
+                    emit fileSignalManager->requestCloseTab(nfileUrl);
+                    //! return to parent.
+                    emit q->rootUrlDeleted(rootUrl);
+                }
+
+                // It must be refreshed when the root url itself is deleted or newly created
+                q->refresh();
+                continue;
+            }
+            if (nparentUrl != rootUrl) {
+                continue;
+            }
+            // Will refreshing the file info meta data
+            info->refresh();
+            if (event.first == AddFile) {
+                addInfoList << info;
+            } else {// rm file event
+                // q->update();/*解决文管多窗口删除文件的时候，文官会崩溃的问题*/
+                // todo: 此处引起效率变低，暂时注释
+                removeUrlList << fileUrl;
+            }
+        }
+
+        removeFiles(removeUrlList);
+        addFiles(addInfoList);
+
+        if (me.isNull()) {
+            return;
+        }
+    }
+    _q_processFileEvent_runing.store(false);
+}
+
+void DFileSystemModelPrivate::enqueueFileEvent(EventType type, const DUrl &fileUrl)
+{
+    mutex.lock();
+    //队列不为空时已经有待处理的调用，短时间内的大量文件事件合并成一次处理
+    const bool isIdle = fileEventQueue.isEmpty();
+    fileEventQueue.enqueue(qMakePair(type, fileUrl));
+    DFM_TRACE_COUNTER("model", "fileEventQueue", fileEventQueue.count());
+    DFM_METRIC_SET("model.fileEventQueue", fileEventQueue.count());
+    mutex.unlock();
+    if (isIdle)
+        fileEventTimer->metaObject()->invokeMethod(fileEventTimer, "start", Qt::QueuedConnection);
+}
+
+QList<QPair<DFileSystemModelPrivate::EventType, DUrl>> DFileSystemModelPrivate::coalesceFileEvents(const QList<QPair<EventType, DUrl>> &events)
+{
+    QList<QPair<EventType, DUrl>> list;
+    QHash<DUrl, int> eventIndex;
+    int invalidCount = 0;
+
+    for (const QPair<EventType, DUrl> &event : events) {
+        const int index = eventIndex.value(event.second, -1);
+
+        if (index < 0) {
+            eventIndex[event.second] = list.size();
+            list << event;
+            continue;
+        }
+
+        // 已有的创建或删除事件都会重新读取文件信息，不需要再单独处理修改
+        if (event.first == UpdateFile)
+            continue;
+
+        // 创建和删除以最后一次为准，并按最后一次的顺序处理
+        list[index].second = DUrl();
+        ++invalidCount;
+        eventIndex[event.second] = list.size();
+        list << event;
+    }
+
+    if (invalidCount > 0) {
+        list.erase(std::remove_if(list.begin(), list.end(), [](const QPair<EventType, DUrl> &event) {
+            return event.second.isEmpty();
+        }), list.end());
+    }
+
+    return list;
+}
+
+void DFileSystemModelPrivate::addFiles(const QList<DAbstractFileInfoPointer> &infoList)
+{
+    Q_Q(DFileSystemModel);
+
+    if (infoList.isEmpty())
+        return;
+
+    if (infoList.size() == 1) {
+        q->addFile(infoList.first());
+        q->selectAndRenameFile(infoList.first()->fileUrl());
+
+        return;
+    }
+
+    const FileSystemNodePointer parentNode = rootNode;
+
+    if (!parentNode)
+        return;
+
+    QList<QPair<DUrl, FileSystemNodePointer>> nodeList;
+    bool hasOrderly = false;
+
+    for (const DAbstractFileInfoPointer &info : infoList) {
+        const DUrl &fileUrl = info->fileUrl();
+
+        if (parentNode->childContains(fileUrl)) {
+            updateFileNode(fileUrl);
+            continue;
+        }
+
+        if (!parentNode->populatedChildren)
+            continue;
+
+        nodeList << qMakePair(fileUrl, q->createNode(parentNode.data(), info));
+        hasOrderly = hasOrderly || info->hasOrderly();
+    }
+
+    if (!nodeList.isEmpty()) {
+        // 新文件作为连续的一段插入到末尾，再整体排序一次，不再逐个查找插入位置
+        const int first = parentNode->childrenCount();
+
+        q->beginInsertRows(q->createIndex(parentNode, 0), first, first + nodeList.size() - 1);
+
+        for (int i = 0; i < nodeList.size(); ++i) {
+            parentNode->insertChildren(first + i, nodeList.at(i).first, nodeList.at(i).second, rootNodeManager->isInsertCaches());
+        }
+
+        q->endInsertRows();
+
+        if (hasOrderly && q->enabledSort())
+            q->sort();
+    }
+
+    for (const DAbstractFileInfoPointer &info : infoList) {
+        q->selectAndRenameFile(info->fileUrl());
+    }
+}
+
+void DFileSystemModelPrivate::removeFiles(const QList<DUrl> &urlList)
+{
+    Q_Q(DFileSystemModel);
+
+    const FileSystemNodePointer parentNode = rootNode;
+
+    if (urlList.isEmpty() || !parentNode || !parentNode->populatedChildren)
+        return;
+
+    QList<int> rows;
+
+    for (const DUrl &url : urlList) {
+        int row = parentNode->indexOfChild(url);
+
+        if (row >= 0)
+            rows << row;
+    }
+
+    // 从后往前删除，前面的行号不受影响
+    std::sort(rows.begin(), rows.end(), std::greater<int>());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+
+    const QModelIndex &parentIndex = q->createIndex(parentNode, 0);
+
+    currentRemove = true;
+
+    for (int i = 0; i < rows.size();) {
+        const int last = rows.at(i);
+        int first = last;
+
+        while (++i < rows.size() && rows.at(i) == first - 1)
+            first = rows.at(i);
+
+        if (q->beginRemoveRows(parentIndex, first, last)) {
+            for (int row = last; row >= first; --row) {
+                Q_UNUSED(parentNode->takeNodeByIndex(row, rootNodeManager->isInsertCaches()));
+            }
+            q->endRemoveRows();
+        }
+    }
+
+    currentRemove = false;
+}
+
+void DFileSystemModelPrivate::_q_onAttributesResolved(int first, int last)
+{
+    Q_Q(DFileSystemModel);
+
+    if (!rootNode)
+        return;
+
+    const QModelIndex &parentIndex = q->createIndex(rootNode, 0);
+    last = qMin(last, q->rowCount(parentIndex) - 1);
+
+    if (first > last)
+        return;
+
+    emit q->dataChanged(q->index(first, 0, parentIndex), q->index(last, q->columnCount(parentIndex) - 1, parentIndex));
+}
+
+/*!
+ * \brief DFileSystemModelPrivate::_q_onEventsLost 监视器的事件队列溢出后，在后台重新扫描当前目录
+ *
+ * 不重新加载整个目录，只比较模型中已有文件的 inode 和修改时间，将差异作为文件事件处理。
+ */
+void DFileSystemModelPrivate::_q_onEventsLost()
+{
+    Q_Q(DFileSystemModel);
+
+    if (!rootNode || !rootNode->fileInfo->fileUrl().isLocalFile())
+        return;
+
+    // 扫描期间再次溢出时，结束后再扫描一次
+    if (rescanFuture.isRunning()) {
+        rescanPending = true;
+        return;
+    }
+
+    rescanPending = false;
+
+    const QHash<DFMPathKey, FileSystemNodePointer> &children = rootNode->getChildrenMap();
+    QHash<QString, QPair<quint64, qint64>> snapshot;
+
+    snapshot.reserve(children.size());
+
+    for (auto it = children.constBegin(); it != children.constEnd(); ++it) {
+        const DAbstractFileInfoPointer &info = it.value()->fileInfo;
+
+        if (info)
+            snapshot.insert(info->fileUrl().fileName(), qMakePair(info->inode(), info->lastModified().toMSecsSinceEpoch()));
+    }
+
+    rescanFuture = QtConcurrent::run(QThreadPool::globalInstance(), q, &DFileSystemModel::rescanDirectory,
+                                     rootNode->fileInfo->fileUrl().toLocalFile(), snapshot);
+}
+
+void DFileSystemModelPrivate::_q_onRescanFinished()
+{
+    QMutexLocker locker(&rescanMutex);
+    const QString path = rescanPath;
+    const QStringList created = rescanCreated;
+    const QStringList removed = rescanRemoved;
+    const QStringList changed = rescanChanged;
+
+    rescanCreated.clear();
+    rescanRemoved.clear();
+    rescanChanged.clear();
+    locker.unlock();
+
+    // 扫描期间切换了目录
+    if (!rootNode || rootNode->fileInfo->fileUrl().toLocalFile() != path)
+        return;
+
+    const QString &prefix = path.endsWith(QDir::separator()) ? path : path + QDir::separator();
+
+    qInfo() << "rescan dir after file events lost, dir = " << path << ", created = " << created.size()
+            << ", removed = " << removed.size() << ", changed = " << changed.size();
+
+    for (const QString &name : removed)
+        enqueueFileEvent(RmFile, DUrl::fromLocalFile(prefix + name));
+
+    for (const QString &name : created)
+        _q_onFileCreated(DUrl::fromLocalFile(prefix + name));
+
+    for (const QString &name : changed)
+        _q_onFileUpdated(DUrl::fromLocalFile(prefix + name));
+
+    if (rescanPending)
+        _q_onEventsLost();
+}
+
+bool DFileSystemModelPrivate::isLazyAttributeRole(int role)
+{
+    switch (role) {
+    case DFileSystemModel::FileLastModifiedRole:
+    case DFileSystemModel::FileLastModifiedDateTimeRole:
+    case DFileSystemModel::FileSizeRole:
+    case DFileSystemModel::FileSizeInKiloByteRole:
+    case DFileSystemModel::FileMimeTypeRole:
+    case DFileSystemModel::FileCreatedRole:
+        return true;
+    default:
+        return false;
     }
+}
+
+void DFileSystemModelPrivate::resetLazyAttributes(const QModelIndex &index)
+{
+    Q_Q(DFileSystemModel);
+
+    if (!lazyAttributes)
+        return;
+
+    const FileSystemNodePointer &node = q->getNodeByIndex(index);
+
+    if (!node)
+        return;
+
+    QMutexLocker locker(&attributeMutex);
+    node->lazyAttributeData.clear();
+    node->lazyAttributeResolved = false;
+    locker.unlock();
+
+    q->requestAttributes(index.row(), index.row());
+}
+
+void DFileSystemModelPrivate::saveDirSnapshot()
+{
+    Q_Q(DFileSystemModel);
 
-    const FileSystemNodePointer &node = rootNode;
+    if (q->isDesktop || !rootNode || !rootNode->populatedChildren || state != DFileSystemModel::Idle || listingStale)
+        return;
 
-    if (!node) {
+    // 本地目录保存在内存中，低速设备的目录保存到磁盘
+    const bool inMemory = DFMDirSnapshotCache::canCache(rootNode->fileInfo);
+
+    if (!inMemory && !DFMListingCache::canCache(rootNode->fileInfo->fileUrl()))
         return;
-    }
 
-    const QModelIndex &index = q->index(fileUrl);
+    // 遍历或插入文件尚未结束时列表不完整
+    if ((jobController && !jobController->isFinished()) || rootNodeManager->isRunning() || updateChildrenFuture.isRunning())
+        return;
 
-    if (!index.isValid()) {
+    // 筛选后的列表不完整
+    if (advanceSearchFilter && advanceSearchFilter->filterEnabled)
         return;
-    }
 
-    if (const DAbstractFileInfoPointer &fileInfo = q->fileInfo(index)) {
-        fileInfo->refresh(true);
+    QList<DAbstractFileInfoPointer> infoList;
+    const QHash<DFMPathKey, FileSystemNodePointer> &children = rootNode->getChildrenMap();
+
+    infoList.reserve(children.size());
+
+    for (const FileSystemNodePointer &node : children) {
+        infoList << node->fileInfo;
     }
 
-    q->parent()->parent()->update(index);
-//    emit q->dataChanged(index, index);
-    //recentfile变更需要调整排序
-    if (fileUrl.isRecentFile()) {
-        //fileinfo已在recentcontroller中更新，只需要重排序
-        q->sort();
+    if (inMemory) {
+        DFMDirSnapshotCache::instance()->insert(rootNode->fileInfo->fileUrl(), filters, infoList);
+    } else {
+        DFMListingCache::save(rootNode->fileInfo->fileUrl(), filters, infoList);
     }
 }
 
-void DFileSystemModelPrivate::_q_onFileUpdated(const DUrl &fileUrl, const int &isExternalSource)
+bool DFileSystemModelPrivate::loadDirSnapshot(const FileSystemNodePointer &parentNode)
 {
     Q_Q(DFileSystemModel);
 
-    const FileSystemNodePointer &node = rootNode;
-    //fix 27828 文件属性改变刷新一次缓存数据,这里只是刷缓存数据
-    if (!node) {
-        return;
-    }
+    if (q->isDesktop || parentNode != rootNode || !DFMDirSnapshotCache::canCache(parentNode->fileInfo))
+        return false;
 
-    const QModelIndex &index = q->index(fileUrl);
+    QList<DAbstractFileInfoPointer> infoList;
 
-    if (!index.isValid()) {
-        return;
-    }
+    if (!DFMDirSnapshotCache::instance()->snapshot(parentNode->fileInfo->fileUrl(), filters, &infoList))
+        return false;
 
-    if (const DAbstractFileInfoPointer &fileInfo = q->fileInfo(index)) {
-        if (isExternalSource) {
-            fileInfo->refresh(fileInfo->isGvfsMountFile());
-        }
+    qInfo() << "fetchMore use the snapshot of dir = " << parentNode->fileInfo->fileUrl() << ", file count = " << infoList.size();
+
+    lazyAttributes = false;
+    parentNode->fileInfo->makeToActive();
+    if (watcher) {
+        watcher->startWatcher();
     }
+    parentNode->populatedChildren = true;
 
-    q->parent()->parent()->update(index);
-//    emit q->dataChanged(index, index);
+    q->setState(DFileSystemModel::Busy);
+
+    childrenUpdated = false;
+    effectFilter = filters;
+    // 快照由文件监视器保持更新，直接作为完整的文件列表
+    q->updateChildrenOnNewThread(infoList);
+
+    return true;
 }
 
-void DFileSystemModelPrivate::_q_onFileRename(const DUrl &from, const DUrl &to)
+bool DFileSystemModelPrivate::loadListingCache(const FileSystemNodePointer &parentNode, QList<DAbstractFileInfoPointer> *infoList)
 {
     Q_Q(DFileSystemModel);
 
-    //如果被重命名的目录是root目录，则不刷新该目录,而是直接退回到上层目录
-    bool isLocalFile = from.isLocalFile() || (from.isVaultFile() || to.isVaultFile());
-    if (isLocalFile && from.path() == rootNode->dataByRole(DFileSystemModel::Roles::FilePathRole).toString()) {
-        QString trashPath = DFMStandardPaths::location(DFMStandardPaths::TrashPath);
-        bool isMoveToTrash = to.toLocalFile().contains(trashPath);
-        if (!isMoveToTrash && !to.toLocalFile().isEmpty()) {
-            // re-enter directory if tab root directory renamed.
-            DFileView *fileview = static_cast<DFileView *>(q->parent()->parent());
-            fileSignalManager->requestRedirectTabUrl(fileview->rootUrl(), to);
-        }
+    if (q->isDesktop || parentNode != rootNode || !DFMListingCache::canCache(parentNode->fileInfo->fileUrl()))
+        return false;
 
-        return;
+    // 筛选后的列表不完整，不能与缓存比较差异
+    if (advanceSearchFilter && advanceSearchFilter->filterEnabled)
+        return false;
+
+    if (!DFMListingCache::load(parentNode->fileInfo->fileUrl(), filters, infoList))
+        return false;
+
+    qInfo() << "fetchMore use the listing cache of dir = " << parentNode->fileInfo->fileUrl() << ", file count = " << infoList->size();
+
+    staleUrls.clear();
+    staleUrls.reserve(infoList->size());
+
+    for (const DAbstractFileInfoPointer &info : *infoList) {
+        staleUrls.insert(info->fileUrl());
     }
-    _q_onFileDeleted(from);
-    _q_onFileCreated(to);
+
+    revalidateInfoList.clear();
+    listingStale = true;
+
+    return true;
 }
 
-void DFileSystemModelPrivate::_q_processFileEvent()
+static bool isListingEntryChanged(const DAbstractFileInfoPointer &cachedInfo, const DAbstractFileInfoPointer &info)
+{
+    return cachedInfo->isDir() != info->isDir()
+            || cachedInfo->size() != info->size()
+            || cachedInfo->lastModified() != info->lastModified();
+}
+
+/*!
+ * \brief DFileSystemModelPrivate::applyRevalidatedChildren 用重新遍历的结果更新缓存的列表
+ *
+ * 只比较来自缓存的文件，遍历期间由文件监视器加入的文件保持不变。
+ * 属性变化的文件重新插入，避免在界面线程中刷新文件信息。
+ */
+void DFileSystemModelPrivate::applyRevalidatedChildren()
 {
     Q_Q(DFileSystemModel);
-    //处理异步正在执行此函数，但是当前类释放了
-    QPointer<DFileSystemModel> me = q;
-    if (_q_processFileEvent_runing.load()) {
+
+    const QList<DAbstractFileInfoPointer> infoList = revalidateInfoList;
+
+    revalidateInfoList.clear();
+    listingStale = false;
+
+    if (!rootNode)
         return;
-    }
 
-    // CAS
-    bool expect = false;
-    _q_processFileEvent_runing.compare_exchange_strong(expect, true);
+    QHash<DUrl, DAbstractFileInfoPointer> freshInfos;
 
-    while (checkFileEventQueue()) {
-        if (!q->isDesktop)  //紧急修复，由于修复bug#33209添加了一次事件循环的处理，导致桌面的自动排列在删除，恢复文件时显示异常
-            qApp->processEvents();
+    freshInfos.reserve(infoList.size());
 
-        if (me.isNull()) { // 当前窗口被关闭以后，me 指针指向的窗口会马上被析构，后面的流程不需要再走了
-            return;
-        }
-        mutex.lock();
-        const QPair<EventType, DUrl> &event = fileEventQueue.dequeue();
-        mutex.unlock();
-        const DUrl &fileUrl = event.second;
-        const DAbstractFileInfoPointer &info = DFileService::instance()->createFileInfo(q, fileUrl);
+    for (const DAbstractFileInfoPointer &info : infoList) {
+        if (info)
+            freshInfos.insert(info->fileUrl(), info);
+    }
 
-        if (!info) {
-            continue;
-        }
-        if (event.first != AddFile) {
-            info->refresh(info->isGvfsMountFile());
-        }
-        const DUrl &rootUrl = q->rootUrl();
-        const DAbstractFileInfoPointer rootinfo = fileService->createFileInfo(q, rootUrl);
-        DUrl nparentUrl(info->parentUrl());
-        DUrl nfileUrl(fileUrl);
-
-        if (rootUrl.scheme() == BURN_SCHEME) {
-            QRegularExpression burn_rxp("^(.*?)/(" BURN_SEG_ONDISC "|" BURN_SEG_STAGING ")(.*)$");
-            QString rxp_after(QString("\\1/%1\\3").arg(rootUrl.burnIsOnDisc() ? BURN_SEG_ONDISC : BURN_SEG_STAGING));
-            nfileUrl.setPath(nfileUrl.path().replace(burn_rxp, rxp_after));
-            nparentUrl.setPath(nparentUrl.path().replace(burn_rxp, rxp_after));
-            if (!nparentUrl.path().endsWith('/') && rootUrl.path().endsWith("/")) {
-                nparentUrl.setPath(nparentUrl.path() + "/");
-            }
-        }
+    const QHash<DFMPathKey, FileSystemNodePointer> &children = rootNode->getChildrenMap();
+    QList<DUrl> removedUrls;
+    QList<DAbstractFileInfoPointer> addedInfos;
 
-        if (nfileUrl == rootUrl) {
-            if (event.first == RmFile) {
-                //! close tab if root url deleted.
-                emit fileSignalManager->requestCloseTab(nfileUrl);
-                //! return to parent.
-                emit q->rootUrlDeleted(rootUrl);
-            }
+    for (auto it = children.constBegin(); it != children.constEnd(); ++it) {
+        const DUrl &url = it.value()->fileInfo->fileUrl();
 
-            // It must be refreshed when the root url itself is deleted or newly created
-            q->refresh();
-            continue;
-        }
-        if (nparentUrl != rootUrl) {
+        if (!staleUrls.contains(url))
             continue;
-        }
-        // Will refreshing the file info meta data
-        info->refresh();
-        if (event.first == AddFile) {
-            q->addFile(info);
-            q->selectAndRenameFile(fileUrl);
-        } else {// rm file event
-            // q->update();/*解决文管多窗口删除文件的时候，文官会崩溃的问题*/
-            // todo: 此处引起效率变低，暂时注释
-            q->remove(fileUrl);
-        }
-        if (me.isNull()) {
-            return;
+
+        const DAbstractFileInfoPointer &info = freshInfos.value(url);
+
+        if (!info) {
+            removedUrls << url;
+        } else if (isListingEntryChanged(it.value()->fileInfo, info)) {
+            removedUrls << url;
+            addedInfos << info;
         }
     }
-    _q_processFileEvent_runing.store(false);
+
+    for (auto it = freshInfos.constBegin(); it != freshInfos.constEnd(); ++it) {
+        if (!children.contains(it.key()))
+            addedInfos << it.value();
+    }
+
+    staleUrls.clear();
+
+    qInfo() << "revalidate the listing cache of dir = " << rootNode->fileInfo->fileUrl()
+            << ", removed = " << removedUrls.size() << ", added = " << addedInfos.size();
+
+    removeFiles(removedUrls);
+    addFiles(addedInfos);
+
+    q->setState(DFileSystemModel::Idle);
+    saveDirSnapshot();
 }
 
 bool DFileSystemModelPrivate::checkFileEventQueue()
@@ -1209,6 +2172,7 @@ DFileSystemModel::DFileSystemModel(DFileViewHelper *parent)
 {
     qRegisterMetaType<State>(QT_STRINGIFY(State));
     qRegisterMetaType<DAbstractFileInfoPointer>(QT_STRINGIFY(DAbstractFileInfoPointer));
+    qRegisterMetaType<QList<DAbstractFileInfoPointer>>(QT_STRINGIFY(QList<DAbstractFileInfoPointer>));
 
     m_smForDragEvent = new QSharedMemory();
 }
@@ -1217,6 +2181,8 @@ DFileSystemModel::~DFileSystemModel()
 {
     Q_D(DFileSystemModel);
 
+    d->saveDirSnapshot();
+
     d->needQuitUpdateChildren = true;
 
     isNeedToBreakBusyCase = true; // 清场的时候，必须让其他资源线程跳出相关流程
@@ -1243,6 +2209,12 @@ DFileSystemModel::~DFileSystemModel()
         d->updateChildrenFuture.waitForFinished();
     }
 
+    d->attributeMutex.lock();
+    d->attributeRanges.clear();
+    d->attributeMutex.unlock();
+    d->attributeFuture.waitForFinished();
+    d->rescanFuture.waitForFinished();
+
     if (d->watcher) {
         d->watcher->deleteLater();
     }
@@ -1413,6 +2385,8 @@ bool DFileSystemModel::hasChildren(const QModelIndex &parent) const
 
 QVariant DFileSystemModel::data(const QModelIndex &index, int role) const
 {
+    Q_D(const DFileSystemModel);
+
     if (!index.isValid() || index.model() != this) {
         return QVariant();
     }
@@ -1423,6 +2397,12 @@ QVariant DFileSystemModel::data(const QModelIndex &index, int role) const
         return QVariant();
     }
 
+    if (d->lazyAttributes && DFileSystemModelPrivate::isLazyAttributeRole(role)) {
+        // 属性还未在后台读取时先返回空值，读取完成后会发出dataChanged
+        QMutexLocker locker(&d->attributeMutex);
+        return indexNode->lazyAttributeData.value(role);
+    }
+
     switch (role) {
     case Qt::EditRole:
     case Qt::DisplayRole: {
@@ -1455,14 +2435,16 @@ QVariant DFileSystemModel::data(const QModelIndex &index, int role) const
         }
         break;
     case Qt::TextAlignmentRole:
-    case FileLastModifiedRole:
     case FileLastModifiedDateTimeRole:
-    case FileSizeRole:
     case FileSizeInKiloByteRole:
-    case FileMimeTypeRole:
-    case FileCreatedRole:
     case FilePinyinName:
         return indexNode->dataByRole(role);
+    case FileLastModifiedRole:
+    case FileSizeRole:
+    case FileMimeTypeRole:
+    case FileCreatedRole:
+        // 绘制和滚动时会反复获取这些格式化的文本，使用节点中的缓存
+        return indexNode->cachedDataByRole(role, d->displayVersion);
     case Qt::ToolTipRole: {
         const QList<int> column_role_list = parent()->columnRoleList();
 
@@ -1688,9 +2670,14 @@ void DFileSystemModel::fetchMore(const QModelIndex &parent)
     if (!releaseJobController()) {
         return;
     }
+    if (d->loadDirSnapshot(parentNode)) {
+        return;
+    }
+
     qInfo() << "fetchMore start traverse all files in current dir = " << parentNode->fileInfo->fileUrl();
     d->jobController = fileService->getChildrenJob(this, parentNode->fileInfo->fileUrl(), QStringList(), d->filters,
                                                    QDirIterator::NoIteratorFlags, false, parentNode->fileInfo->isGvfsMountFile());
+    d->lazyAttributes = parentNode->fileInfo->isGvfsMountFile();
 
     if (!d->jobController) {
         return;
@@ -1714,9 +2701,30 @@ void DFileSystemModel::fetchMore(const QModelIndex &parent)
         d->rootNodeManager->stop();
     }
 
-    connect(d->jobController, &JobController::addChildren, this, &DFileSystemModel::onJobAddChildren, Qt::QueuedConnection);
-    connect(d->jobController, &JobController::finished, this, &DFileSystemModel::onJobFinished, Qt::QueuedConnection);
-    connect(d->jobController, &JobController::childrenUpdated, this, &DFileSystemModel::updateChildrenOnNewThread, Qt::DirectConnection);
+    QList<DAbstractFileInfoPointer> cachedInfoList;
+    const bool revalidate = d->loadListingCache(parentNode, &cachedInfoList);
+
+    if (revalidate) {
+        // 遍历结果不直接插入，全部收集后与缓存的列表比较差异
+        const JobController *job = d->jobController.data();
+
+        connect(d->jobController, &JobController::addChildrenList, this, [this, job](const QList<DAbstractFileInfoPointer> &infoList) {
+            Q_D(DFileSystemModel);
+
+            if (d->listingStale && d->jobController.data() == job)
+                d->revalidateInfoList << infoList;
+        }, Qt::QueuedConnection);
+        connect(d->jobController, &JobController::finished, this, [this, job] {
+            Q_D(DFileSystemModel);
+
+            if (d->listingStale && d->jobController.data() == job)
+                d->applyRevalidatedChildren();
+        }, Qt::QueuedConnection);
+    } else {
+        connect(d->jobController, &JobController::addChildren, this, &DFileSystemModel::onJobAddChildren, Qt::QueuedConnection);
+        connect(d->jobController, &JobController::finished, this, &DFileSystemModel::onJobFinished, Qt::QueuedConnection);
+        connect(d->jobController, &JobController::childrenUpdated, this, &DFileSystemModel::updateChildrenOnNewThread, Qt::DirectConnection);
+    }
     /// make root file to active
     d->rootNode->fileInfo->makeToActive();
     /// start file watcher
@@ -1730,10 +2738,39 @@ void DFileSystemModel::fetchMore(const QModelIndex &parent)
     d->childrenUpdated = false;
     // 设置当前已经生效的筛选器
     d->effectFilter = d->filters;
+
+    if (revalidate) {
+        // 先显示缓存的列表，状态保持为Busy直到重新遍历结束
+        updateChildren(cachedInfoList);
+    }
+
     d->jobController->start();
     d->rootNodeManager->setEnable(true);
 }
 
+/*!
+ * \brief DFileSystemModel::isSelectable 与 flags() 中 Qt::ItemIsSelectable 和 Qt::ItemIsEnabled 的结果一致
+ *
+ * 不查询能否重命名、写入和拖放等耗时的属性，用于大量选中时过滤选中的索引
+ */
+bool DFileSystemModel::isSelectable(const QModelIndex &index) const
+{
+    Q_D(const DFileSystemModel);
+
+    if (!index.isValid())
+        return false;
+
+    const FileSystemNodePointer &indexNode = getNodeByIndex(index);
+
+    if (!indexNode)
+        return true;
+
+    if (!d->passNameFilters(indexNode) || index.column() != 0)
+        return false;
+
+    return !(indexNode->fileInfo->fileItemDisableFlags() & (Qt::ItemIsSelectable | Qt::ItemIsEnabled));
+}
+
 Qt::ItemFlags DFileSystemModel::flags(const QModelIndex &index) const
 {
     Q_D(const DFileSystemModel);
@@ -1922,31 +2959,9 @@ QMimeData *DFileSystemModel::mimeData(const QModelIndexList &indexes) const
 //    FOR_DRAGEVENT = urls;
 //    qDebug() << "Set FOR_DRAGEVENT urls FOR_DRAGEVENT count = " << FOR_DRAGEVENT.length();
     m_smForDragEvent->setKey(DRAG_EVENT_URLS);
-    //qDebug() << DRAG_EVENT_URLS;
-    if (m_smForDragEvent->isAttached()) {
-        if (!m_smForDragEvent->detach()) {
-            return data;
-        }
-    }
-    QBuffer buffer;
-    buffer.open(QBuffer::ReadWrite);
-    QDataStream out(&buffer);
-    out << urls;
-    //int size = static_cast<int>(buffer.size());
-    //fix task 21485 分配一个固定的5M内存
-    bool bcanwrite = m_smForDragEvent->create(5 * 1024 * 1024);
-    if (bcanwrite || m_smForDragEvent->error() == QSharedMemory::AlreadyExists) {
-        //因为创建失败，就没有连接内存，所以写失败
-        if (!bcanwrite) {
-            m_smForDragEvent->attach();
-        }
-        m_smForDragEvent->lock();
-        char *to = static_cast<char *>(m_smForDragEvent->data());
-        const char *from = buffer.data().data();
-        memcpy(to, from, qMin(static_cast<size_t>(buffer.size()), static_cast<size_t>(m_smForDragEvent->size())));
-        m_smForDragEvent->unlock();
-        qDebug() << " write mem finish. " << m_smForDragEvent->errorString() << m_smForDragEvent->size();
-    }
+    //fix task 21485 至少分配一个固定的5M内存
+    if (DFMDragUrls::write(m_smForDragEvent, urls))
+        qDebug() << " write mem finish. " << urls.size() << m_smForDragEvent->size();
     return data;
 }
 
@@ -1970,6 +2985,11 @@ QModelIndex DFileSystemModel::setRootUrl(const DUrl &fileUrl)
         isFirstRun = false;
     }
     qDebug() << fileUrl;
+    // 离开当前目录前保存快照
+    d->saveDirSnapshot();
+    d->listingStale = false;
+    d->staleUrls.clear();
+    d->revalidateInfoList.clear();
     //非回收站还原规则
     if (!fileUrl.isTrashFile()) {
         d->filters = m_filters;
@@ -2043,6 +3063,8 @@ QModelIndex DFileSystemModel::setRootUrl(const DUrl &fileUrl)
                 this, SLOT(_q_onFileRename(DUrl, DUrl)));
         connect(d->watcher, SIGNAL(fileModified(DUrl)),
                 this, SLOT(_q_onFileUpdated(DUrl)));
+        connect(d->watcher, SIGNAL(eventsLost()),
+                this, SLOT(_q_onEventsLost()));
     }
 
     return index(fileUrl);
@@ -2111,8 +3133,8 @@ void DFileSystemModel::setNameFilters(const QStringList &nameFilters)
         return;
     }
 
-    d->nameFiltersMatchResultMap.clear();
     d->nameFilters = nameFilters;
+    d->updateNameFilterMatcher();
 
     emitAllDataChanged();
 }
@@ -2126,8 +3148,8 @@ void DFileSystemModel::setFilters(QDir::Filters filters)
         return;
     }
 
-    d->nameFiltersMatchResultMap.clear();
     d->filters = filters;
+    d->updateNameFilterMatcher();
 
     refresh();
 }
@@ -2146,6 +3168,9 @@ void DFileSystemModel::setAdvanceSearchFilter(const QMap<int, QVariant> &formDat
         return;
     }
 
+    // 记录修改前的条件，只让发生变化的条件失效
+    const FileFilter oldFilter = *advanceSearchFilter();
+
     advanceSearchFilter()->filterRule = formData;
 
     advanceSearchFilter()->f_comboValid[SEARCH_RANGE] = true;
@@ -2214,6 +3239,21 @@ void DFileSystemModel::setAdvanceSearchFilter(const QMap<int, QVariant> &formDat
     calDateFilter(ACCESS_DATE_RANGE, advanceSearchFilter()->f_accessDateRangeStart, advanceSearchFilter()->f_accessDateRangeEnd);
     calDateFilter(CREATE_DATE_RANGE, advanceSearchFilter()->f_createDateRangeStart, advanceSearchFilter()->f_createDateRangeEnd);
 
+    const FileFilter *filter = advanceSearchFilter().get();
+    const bool changed[LABEL_COUNT] = {
+        oldFilter.f_includeSubDir != filter->f_includeSubDir,
+        oldFilter.f_typeString != filter->f_typeString,
+        oldFilter.f_sizeRange != filter->f_sizeRange,
+        oldFilter.f_dateRangeStart != filter->f_dateRangeStart || oldFilter.f_dateRangeEnd != filter->f_dateRangeEnd,
+        oldFilter.f_accessDateRangeStart != filter->f_accessDateRangeStart || oldFilter.f_accessDateRangeEnd != filter->f_accessDateRangeEnd,
+        oldFilter.f_createDateRangeStart != filter->f_createDateRangeStart || oldFilter.f_createDateRangeEnd != filter->f_createDateRangeEnd
+    };
+
+    for (int labelIndex = SEARCH_RANGE; labelIndex < LABEL_COUNT; ++labelIndex) {
+        if (changed[labelIndex])
+            ++advanceSearchFilter()->f_version[labelIndex];
+    }
+
     if (updateView) {
         applyAdvanceSearchFilter();
     }
@@ -2542,6 +3582,174 @@ void DFileSystemModel::stopCurrentJob()
     setState(Idle);
 }
 
+void DFileSystemModel::requestAttributes(int first, int last)
+{
+    Q_D(DFileSystemModel);
+
+    if (!d->lazyAttributes || !d->rootNode)
+        return;
+
+    first = qMax(0, first - LAZY_ATTRIBUTE_PREFETCH_COUNT);
+    last = qMin(d->rootNode->childrenCount() - 1, last + LAZY_ATTRIBUTE_PREFETCH_COUNT);
+
+    if (first > last)
+        return;
+
+    QMutexLocker locker(&d->attributeMutex);
+    d->attributeRanges.append(qMakePair(first, last));
+
+    if (d->attributeResolving)
+        return;
+
+    d->attributeResolving = true;
+    d->attributeFuture = QtConcurrent::run(QThreadPool::globalInstance(), this, &DFileSystemModel::resolveAttributes);
+}
+
+bool DFileSystemModel::isLazyAttributes() const
+{
+    Q_D(const DFileSystemModel);
+
+    return d->lazyAttributes;
+}
+
+bool DFileSystemModel::isListingStale() const
+{
+    Q_D(const DFileSystemModel);
+
+    return d->listingStale;
+}
+
+void DFileSystemModel::resolveAttributes()
+{
+    Q_D(DFileSystemModel);
+
+    static const QList<int> roles {FileLastModifiedRole, FileLastModifiedDateTimeRole, FileSizeRole,
+                                   FileSizeInKiloByteRole, FileMimeTypeRole, FileCreatedRole};
+
+    forever {
+        QPair<int, int> range;
+
+        d->attributeMutex.lock();
+        if (d->attributeRanges.isEmpty()) {
+            d->attributeResolving = false;
+            d->attributeMutex.unlock();
+            return;
+        }
+        // 优先处理最新的请求，滚动后之前的可见区域已不再重要
+        range = d->attributeRanges.takeLast();
+        d->attributeMutex.unlock();
+
+        const FileSystemNodePointer rootNode = d->rootNode;
+
+        if (!rootNode)
+            continue;
+
+        int changedFirst = -1;
+        int changedLast = -1;
+
+        for (int row = range.first; row <= range.second && !isNeedToBreakBusyCase; ++row) {
+            const FileSystemNodePointer &node = rootNode->getNodeByIndex(row);
+
+            if (!node)
+                break;
+
+            d->attributeMutex.lock();
+            const bool resolved = node->lazyAttributeResolved;
+            d->attributeMutex.unlock();
+
+            if (resolved)
+                continue;
+
+            QHash<int, QVariant> data;
+
+            for (int role : roles)
+                data[role] = node->dataByRole(role);
+
+            d->attributeMutex.lock();
+            node->lazyAttributeData = data;
+            node->lazyAttributeResolved = true;
+            d->attributeMutex.unlock();
+
+            if (changedFirst < 0)
+                changedFirst = row;
+
+            changedLast = row;
+        }
+
+        if (changedFirst >= 0)
+            QMetaObject::invokeMethod(this, "_q_onAttributesResolved", Qt::QueuedConnection,
+                                      Q_ARG(int, changedFirst), Q_ARG(int, changedLast));
+    }
+}
+
+/*!
+ * \brief DFileSystemModel::rescanDirectory 在线程中重新读取目录，与 snapshot 比较得到新增、删除和变化的文件
+ */
+void DFileSystemModel::rescanDirectory(const QString &path, const QHash<QString, QPair<quint64, qint64>> &snapshot)
+{
+    Q_D(DFileSystemModel);
+
+    QStringList created, removed, changed;
+    DIR *dir = opendir(QFile::encodeName(path).constData());
+
+    // 目录本身被删除时由监视器发出删除事件
+    if (!dir)
+        return;
+
+    const bool showHidden = d->filters & QDir::Hidden;
+    QSet<QString> found;
+
+    found.reserve(snapshot.size());
+
+    while (dirent *entry = readdir(dir)) {
+        if (isNeedToBreakBusyCase)
+            break;
+
+        if (!strcmp(entry->d_name, ".") || !strcmp(entry->d_name, ".."))
+            continue;
+
+        if (!showHidden && entry->d_name[0] == '.')
+            continue;
+
+        // 与 DFileInfo 一致，跟随符号链接取 inode 和修改时间
+        struct stat st;
+        if (fstatat(dirfd(dir), entry->d_name, &st, 0) != 0
+                && fstatat(dirfd(dir), entry->d_name, &st, AT_SYMLINK_NOFOLLOW) != 0)
+            continue;
+
+        const QString &name = QFile::decodeName(entry->d_name);
+        const qint64 mtime = qint64(st.st_mtim.tv_sec) * 1000 + st.st_mtim.tv_nsec / 1000000;
+
+        found.insert(name);
+
+        auto it = snapshot.constFind(name);
+
+        if (it == snapshot.constEnd())
+            created << name;
+        else if (it->first != st.st_ino || it->second != mtime)
+            changed << name;
+    }
+
+    closedir(dir);
+
+    if (isNeedToBreakBusyCase)
+        return;
+
+    for (auto it = snapshot.constBegin(); it != snapshot.constEnd(); ++it) {
+        if (!found.contains(it.key()))
+            removed << it.key();
+    }
+
+    QMutexLocker locker(&d->rescanMutex);
+    d->rescanPath = path;
+    d->rescanCreated = created;
+    d->rescanRemoved = removed;
+    d->rescanChanged = changed;
+    locker.unlock();
+
+    QMetaObject::invokeMethod(this, "_q_onRescanFinished", Qt::QueuedConnection);
+}
+
 void DFileSystemModel::updateChildren(QList<DAbstractFileInfoPointer> list)
 {
     Q_D(DFileSystemModel);
@@ -2558,7 +3766,7 @@ void DFileSystemModel::updateChildren(QList<DAbstractFileInfoPointer> list)
 
     node->clearChildren();
 
-    QHash<DUrl, FileSystemNodePointer> fileHash;
+    QHash<DFMPathKey, FileSystemNodePointer> fileHash;
     QList<FileSystemNodePointer> fileList;
 
     fileHash.reserve(list.size());
@@ -2593,8 +3801,12 @@ void DFileSystemModel::updateChildren(QList<DAbstractFileInfoPointer> list)
         // qDebug() << "update node url = " << fileInfo->filePath();
         const FileSystemNodePointer &chileNode = createNode(node.data(), fileInfo);
         //当文件路径和名称都相同的情况下，fileHash在赋值，会释放，fileList保存的普通指针就是悬空指针
-        if (!chileNode->shouldHideByFilterRule(advanceSearchFilter()) && !fileHash[fileInfo->fileUrl()]) {
-            fileHash[fileInfo->fileUrl()] = chileNode;
+        if (chileNode->shouldHideByFilterRule(advanceSearchFilter()))
+            continue;
+
+        FileSystemNodePointer &hashNode = fileHash[DFMPathKey(fileInfo->fileUrl())];
+        if (!hashNode) {
+            hashNode = chileNode;
             fileList << chileNode;
             if (fileInfo->fileUrl().scheme() == SEARCH_SCHEME)
                 emit showFilterButton();
@@ -2680,6 +3892,8 @@ void DFileSystemModel::refresh(const DUrl &fileUrl)
 //        return;
 
     node->populatedChildren = false;
+    // 刷新时必须重新遍历目录
+    DFMDirSnapshotCache::instance()->remove(node->fileInfo->fileUrl());
 
     const QModelIndex &index = createIndex(node, 0);
     if (beginRemoveRows(index, 0, rowCount(index) - 1)) {
@@ -2704,6 +3918,16 @@ void DFileSystemModel::update()
     emit dataChanged(rootIndex.child(0, 0), rootIndex.child(rootIndex.row() - 1, 0));
 }
 
+/*!
+ * \brief DFileSystemModel::clearDisplayCache 使所有节点缓存的显示文本失效，语言或区域设置变化时调用
+ */
+void DFileSystemModel::clearDisplayCache()
+{
+    Q_D(DFileSystemModel);
+
+    ++d->displayVersion;
+}
+
 void DFileSystemModel::toggleHiddenFiles(const DUrl &fileUrl)
 {
     Q_D(DFileSystemModel);
@@ -2877,6 +4101,8 @@ const FileSystemNodePointer DFileSystemModel::createNode(FileSystemNode *parent,
     FileSystemNodePointer node(new FileSystemNode(parent, info, this, lock));
 
     node->fileInfo->setColumnCompact(d->columnCompact);
+    // 提前生成名称排序键，排序和插入新文件时不必每次比较都做collation
+    node->fileInfo->makeDisplayNameSortKey();
 //        d->urlToNode[info->fileUrl()] = node;
 
     return node;
@@ -2928,12 +4154,13 @@ void DFileSystemModel::setState(DFileSystemModel::State state)
     emit stateChanged(state);
 }
 
-void DFileSystemModel::onJobAddChildren(const DAbstractFileInfoPointer fileInfo, const bool isEnd)
+void DFileSystemModel::onJobAddChildren(const QList<DAbstractFileInfoPointer> &infoList, const bool isEnd)
 {
     Q_D(DFileSystemModel);
 
-    d->rootNodeManager->addFile(fileInfo, FileNodeManagerThread::AddFile, isEnd);
-    if (fileInfo && fileInfo->fileUrl().scheme() == SEARCH_SCHEME)
+    DFMStartupProfile::mark("firstListingBatch");
+    d->rootNodeManager->addFiles(infoList, FileNodeManagerThread::AddFile, isEnd);
+    if (!infoList.isEmpty() && infoList.first()->fileUrl().scheme() == SEARCH_SCHEME)
         emit showFilterButton();
 }
 
@@ -2943,6 +4170,7 @@ void DFileSystemModel::onJobFinished()
 
     if (d->childrenUpdated && !d->rootNodeManager->isRunning()) {
         setState(Idle);
+        const_cast<DFileSystemModelPrivate *>(d)->saveDirSnapshot();
     }
 }
 
@@ -2956,7 +4184,7 @@ void DFileSystemModel::addFile(const DAbstractFileInfoPointer &fileInfo)
     FileSystemNodePointer node = createNode(parentNode.data(), fileInfo);
 
     if (parentNode->childContains(fileUrl)) {
-        d_ptr->_q_onFileUpdated(fileUrl);
+        d_ptr->updateFileNode(fileUrl);
         return;
     }
 
@@ -3029,7 +4257,7 @@ void DFileSystemModel::selectAndRenameFile(const DUrl &fileUrl)
         auto realFileUrl = MergedDesktopController::convertToRealPath(fileUrl);
         if (AppController::selectionAndRenameFile.first == realFileUrl) {
             quint64 windowId = AppController::selectionAndRenameFile.second;
-            if (windowId != parent()->windowId()) {
+            if (!parent()->isModelWindow(windowId)) {
                 return;
             }
 
@@ -3043,7 +4271,7 @@ void DFileSystemModel::selectAndRenameFile(const DUrl &fileUrl)
         if (AppController::selectionAndRenameFile.first == url) {
             quint64 windowId = AppController::selectionAndRenameFile.second;
 
-            if (windowId != parent()->windowId()) {
+            if (!parent()->isModelWindow(windowId)) {
                 return;
             }
 
@@ -3059,7 +4287,7 @@ void DFileSystemModel::selectAndRenameFile(const DUrl &fileUrl)
         } else if (AppController::selectionFile.first == fileUrl) {
             quint64 windowId = AppController::selectionFile.second;
 
-            if (windowId != parent()->windowId()) {
+            if (!parent()->isModelWindow(windowId)) {
                 return;
             }
 
@@ -3075,7 +4303,7 @@ void DFileSystemModel::selectAndRenameFile(const DUrl &fileUrl)
     } else if (AppController::selectionAndRenameFile.first == fileUrl) {
         quint64 windowId = AppController::selectionAndRenameFile.second;
 
-        if (windowId != parent()->windowId()) {
+        if (!parent()->isModelWindow(windowId)) {
             return;
         }
 
@@ -3091,7 +4319,7 @@ void DFileSystemModel::selectAndRenameFile(const DUrl &fileUrl)
     } else if (AppController::selectionFile.first == fileUrl) {
         quint64 windowId = AppController::selectionFile.second;
 
-        if (windowId != parent()->windowId()) {
+        if (!parent()->isModelWindow(windowId)) {
             return;
         }
 
@@ -3106,7 +4334,7 @@ void DFileSystemModel::selectAndRenameFile(const DUrl &fileUrl)
 
     } else if (AppController::multiSelectionFilesCache.second != 0) {
         quint64 winId{ AppController::multiSelectionFilesCache.second };
-        if (winId == parent()->windowId() || AppController::flagForDDesktopRenameBar) { //###: flagForDDesktopRenameBar is false usually.
+        if (parent()->isModelWindow(winId) || AppController::flagForDDesktopRenameBar) { //###: flagForDDesktopRenameBar is false usually.
 
             if (!AppController::multiSelectionFilesCache.first.isEmpty()) {
 
@@ -3154,17 +4382,8 @@ bool DFileSystemModel::beginRemoveRows(const QModelIndex &parent, int first, int
 void DFileSystemModel::sortByMySelf(QList<FileSystemNodePointer> &list, const DAbstractFileInfo::CompareFunction &sortFun)
 {
     Q_D(DFileSystemModel);
-    QList<FileSystemNodePointer> sortList;
-    int row = 0;
-    for (const auto & needNode : list) {
-        if (isNeedToBreakBusyCase)
-            return;
-        row = FindInsertPosInOrderList(needNode, sortList, sortFun, d->srotOrder, &isNeedToBreakBusyCase);
-        if (isNeedToBreakBusyCase)
-            return;
-        sortList.insert(row, needNode);
-    }
-    list = sortList;
+
+    SortNodeList(list, sortFun, d->srotOrder, &isNeedToBreakBusyCase);
 }
 
 void DFileSystemModel::endRemoveRows()
@@ -53,8 +53,10 @@ typedef struct fileFilter {
     QDateTime f_createDateRangeStart;
     QDateTime f_createDateRangeEnd;
     QString f_typeString;
-    bool f_includeSubDir;
-    bool f_comboValid[LABEL_COUNT];
+    bool f_includeSubDir = false;
+    bool f_comboValid[LABEL_COUNT] = {};
+    // 每个筛选条件的版本号，条件变化时递增，节点据此判断缓存的筛选结果是否失效
+    int f_version[LABEL_COUNT] = {};
 } FileFilter;
 
 Q_DECLARE_METATYPE(FileFilter)
@@ -140,6 +142,7 @@ public:
     void fetchMore(const QModelIndex &parent) override;
 
     Qt::ItemFlags flags(const QModelIndex &index) const override;
+    bool isSelectable(const QModelIndex &index) const;
 
     Qt::DropActions supportedDragActions() const override;
     Qt::DropActions supportedDropActions() const override;
@@ -196,6 +199,12 @@ public:
     int columnActiveRole(int column) const;
     void stopCurrentJob();
 
+    // 延迟加载属性时，请求在后台读取这些行及前后预取行的大小、时间、类型等属性
+    void requestAttributes(int first, int last);
+    bool isLazyAttributes() const;
+    // 当前显示的是低速设备上缓存的列表，后台重新遍历完成前可能与实际不符
+    bool isListingStale() const;
+
 //    static QList<QUrl> m_urlForDragEvent;
 
 public slots:
@@ -204,6 +213,7 @@ public slots:
     /// warning: only refresh current url
     void refresh(const DUrl &fileUrl = DUrl());
     void update();
+    void clearDisplayCache();
     void toggleHiddenFiles(const DUrl &fileUrl);
 
     void setEnabledSort(bool enabledSort);
@@ -242,7 +252,7 @@ private:
     void clear();
 
     void setState(State state);
-    void onJobAddChildren(const DAbstractFileInfoPointer fileInfo, const bool isEnd);
+    void onJobAddChildren(const QList<DAbstractFileInfoPointer> &infoList, const bool isEnd);
     void onJobFinished();
     void addFile(const DAbstractFileInfoPointer &fileInfo);
 
@@ -254,6 +264,8 @@ private:
     void endRemoveRows();
     //fix bug释放jobcontroller
     bool releaseJobController();
+    void resolveAttributes();
+    void rescanDirectory(const QString &path, const QHash<QString, QPair<quint64, qint64>> &snapshot);
     QDir::Filters m_filters; //仅记录非回收站文件过滤规则
     bool isFirstRun = true; //判断是否首次运行
     bool isNeedToBreakBusyCase = false; // 停止那些忙的流程 // bug 26972, 27384
@@ -277,6 +289,9 @@ private:
     Q_PRIVATE_SLOT(d_func(), void _q_onFileUpdated(const DUrl &fileUrl, const int isExternalSource))
     Q_PRIVATE_SLOT(d_func(), void _q_onFileRename(const DUrl &from, const DUrl &to))
     Q_PRIVATE_SLOT(d_func(), void _q_processFileEvent())
+    Q_PRIVATE_SLOT(d_func(), void _q_onAttributesResolved(int first, int last))
+    Q_PRIVATE_SLOT(d_func(), void _q_onEventsLost())
+    Q_PRIVATE_SLOT(d_func(), void _q_onRescanFinished())
 
     Q_DECLARE_PRIVATE(DFileSystemModel)
     Q_DISABLE_COPY(DFileSystemModel)
@@ -7,13 +7,17 @@
 
 #include "dfilesystemmodel.h"
 #include "interfaces/durl.h"
+#include "interfaces/dfmpathkey.h"
+#include "interfaces/dfmnamefiltermatcher.h"
 #include "interfaces/dfileviewhelper.h"
 #include "shutil/fileutils.h"
 #include "deviceinfo/udisklistener.h"
 #include "shutil/dfmfilelistfile.h"
 
 #include <QReadWriteLock>
+#include <QSet>
 #include <QQueue>
+#include <QTimer>
 
 class FileSystemNode : public QSharedData
 {
@@ -25,10 +29,14 @@ public:
 
     ~FileSystemNode();
     QVariant dataByRole(int role);
+    QVariant cachedDataByRole(int role, int displayVersion);
+    void clearDisplayDataCache();
     void setNodeVisible(const FileSystemNodePointer &node, bool visible);
     void sortAllChildren(const DAbstractFileInfo::CompareFunction &sortFun, const Qt::SortOrder &order, const bool *cancel);
     void applyFileFilter(std::shared_ptr<FileFilter> filter);
     bool shouldHideByFilterRule(std::shared_ptr<FileFilter> filter);
+    // 文件信息变化后清除缓存的筛选结果
+    void resetFilterResult();
     void noLockInsertChildren(int index, const DUrl &url, const FileSystemNodePointer &node);
     void insertChildren(int index, const DUrl &url, const FileSystemNodePointer &node, const bool *isCache);
     int insertChildren(const DUrl &url, const FileSystemNodePointer &node, const DAbstractFileInfo::CompareFunction &sortFun,
@@ -45,15 +53,15 @@ public:
     int childrenCount();
     QList<FileSystemNodePointer> getChildrenList() const;
     DUrlList getChildrenUrlList();
-    QHash<DUrl, FileSystemNodePointer> getChildrenMap() const;
+    QHash<DFMPathKey, FileSystemNodePointer> getChildrenMap() const;
     void setChildrenList(const QList<FileSystemNodePointer> &list);
-    void setChildrenMap(const QHash<DUrl, FileSystemNodePointer> &map);
+    void setChildrenMap(const QHash<DFMPathKey, FileSystemNodePointer> &map);
     void clearChildren();
     bool childContains(const DUrl &url);
     void addFileSystemNode(const FileSystemNodePointer &node);
     void removeFileSystemNode(const FileSystemNodePointer &node);
     const FileSystemNodePointer getFileSystemNode(FileSystemNode *parent);
-    void setChildren(const QHash<DUrl, FileSystemNodePointer> &map,
+    void setChildren(const QHash<DFMPathKey, FileSystemNodePointer> &map,
                      const QList<FileSystemNodePointer> &list, bool &isInsertCache,
                      const DAbstractFileInfo::CompareFunction &sortFun,
                      const Qt::SortOrder &order, const bool &isCancel);
@@ -61,11 +69,38 @@ public:
     DAbstractFileInfoPointer fileInfo;
     FileSystemNode *parent = Q_NULLPTR;
     bool populatedChildren = false;
+    // 延迟加载属性时在后台读取的属性，由DFileSystemModelPrivate::attributeMutex保护
+    QHash<int, QVariant> lazyAttributeData;
+    bool lazyAttributeResolved = false;
+    // 名称过滤的结果，nameFilterVersion 与模型的版本号相同时有效
+    int nameFilterVersion = -1;
+    bool nameFilterPassed = true;
 private:
-    QHash<DUrl, FileSystemNodePointer> children;
+    // 格式化后的大小、时间、类型等显示文本，只在界面线程中访问
+    // 文件信息的刷新次数或模型的显示版本号变化后失效
+    QHash<int, QVariant> displayDataCache;
+    int displayDataRefreshVersion = -1;
+    int displayDataVersion = -1;
+
+    bool hideByFilterRule(const FileFilter *filter, int labelIndex);
+
+    // 缓存每个筛选条件的结果，只有版本号变化的条件才重新计算
+    int filterVersion[LABEL_COUNT];
+    quint32 filterHiddenMask = 0;
+
+    // 查找子节点在 visibleChildren 中的位置，节点记录的位置有效时不需要遍历列表
+    int noLockIndexOfChild(const FileSystemNodePointer &node) const;
+    // 更新 from 之后的子节点记录的位置
+    void noLockUpdateRows(int from);
+    void noLockSetVisibleChildren(const QList<FileSystemNodePointer> &list);
+    FileSystemNodePointer noLockTakeVisibleChild(int row);
+
+    QHash<DFMPathKey, FileSystemNodePointer> children;
     //fix bug 31225,if children clear,another thread useing visibleChildren will crush,so use FileSystemNodePointer
     QList<FileSystemNodePointer> visibleChildren;
-    QMap<DUrl, FileSystemNodePointer> removeCacheChildren, insertCacheChildren;
+    QHash<DFMPathKey, FileSystemNodePointer> removeCacheChildren, insertCacheChildren;
+    // 此节点在父节点 visibleChildren 中的位置，不可见时为-1
+    int visibleRow = -1;
     DFileSystemModel *m_dFileSystemModel = nullptr;
     QReadWriteLock *rwLock = nullptr;
 };
@@ -191,7 +226,7 @@ public:
     {
         return static_cast<DFileSystemModel *>(parent());
     }
-    void addFile(const DAbstractFileInfoPointer &info, bool append, bool isEnd);
+    void addFiles(const QList<DAbstractFileInfoPointer> &infoList, bool append, bool isEnd);
     void removeFile(const DAbstractFileInfoPointer &info);
     void setRootNode(const FileSystemNodePointer &node);
     void setEnable(bool enable);
@@ -224,7 +259,8 @@ class DFileSystemModelPrivate
 public:
     enum EventType {
         AddFile,
-        RmFile
+        RmFile,
+        UpdateFile
     };
     explicit DFileSystemModelPrivate(DFileSystemModel *qq);
     ~DFileSystemModelPrivate();
@@ -233,6 +269,7 @@ public:
     DFileSystemModelPrivate &operator=(DFileSystemModelPrivate &) = delete;
 
     bool passNameFilters(const FileSystemNodePointer &node) const;
+    void updateNameFilterMatcher();
     bool passFileFilters(const DAbstractFileInfoPointer &info) const;
 
     void _q_onFileCreated(const DUrl &fileUrl, bool isPickUpQueue = false);
@@ -243,7 +280,28 @@ public:
 
     /// add/rm file event
     void _q_processFileEvent();
+    void enqueueFileEvent(EventType type, const DUrl &fileUrl);
+    // 合并同一文件的多个事件：重复的修改只保留一次，创建和删除以最后一次为准
+    static QList<QPair<EventType, DUrl>> coalesceFileEvents(const QList<QPair<EventType, DUrl>> &events);
+    void updateFileNode(const DUrl &fileUrl);
+    // 批量插入/删除，相邻的行合并成一次 beginInsertRows/beginRemoveRows
+    void addFiles(const QList<DAbstractFileInfoPointer> &infoList);
+    void removeFiles(const QList<DUrl> &urlList);
+    void _q_onAttributesResolved(int first, int last);
+    // 文件事件丢失后重新扫描当前目录，只应用与模型中的文件不同的部分
+    void _q_onEventsLost();
+    void _q_onRescanFinished();
+
+    static bool isLazyAttributeRole(int role);
+    // 文件属性变化后清除已读取的属性，重新在后台读取
+    void resetLazyAttributes(const QModelIndex &index);
     bool checkFileEventQueue();
+    // 当前目录完整遍历后保存快照，供后退或其它标签页打开同一目录时直接使用
+    void saveDirSnapshot();
+    bool loadDirSnapshot(const FileSystemNodePointer &parentNode);
+    // 低速设备的目录先显示磁盘上缓存的列表，后台重新遍历完成后应用差异
+    bool loadListingCache(const FileSystemNodePointer &parentNode, QList<DAbstractFileInfoPointer> *infoList);
+    void applyRevalidatedChildren();
 
     DFileSystemModel *q_ptr;
 
@@ -280,6 +338,8 @@ public:
     std::atomic<bool> _q_processFileEvent_runing;
     QQueue<QPair<EventType, DUrl>> fileEventQueue;
     QQueue<QPair<EventType, DUrl>> laterFileEventQueue;
+    // 文件事件在一个时间窗口内累积后再统一处理，避免大量文件变化时逐个刷新界面
+    QTimer *fileEventTimer = nullptr;
 
     bool enabledSort = true;
 
@@ -291,7 +351,30 @@ public:
 
     // 每列包含多个role时，存储此列活跃的role
     QMap<int, int> columnActiveRole;
-    mutable QMap<DUrl, bool> nameFiltersMatchResultMap;
+    // 由 nameFilters 编译得到，过滤规则或大小写设置变化时重新编译并增加版本号
+    DFMNameFilterMatcher nameFilterMatcher;
+    int nameFilterVersion = 0;
+    // 节点缓存的显示文本的版本号，语言或区域设置变化时增加
+    int displayVersion = 0;
+
+    // 低速目录（如smb）中只为可见行在后台读取大小、时间、类型等属性，避免在界面线程中访问文件
+    bool lazyAttributes = false;
+    mutable QMutex attributeMutex;
+    QList<QPair<int, int>> attributeRanges;
+    bool attributeResolving = false;
+    QFuture<void> attributeFuture;
+
+    // 当前显示的是缓存的列表，正在后台重新遍历
+    bool listingStale = false;
+    QSet<DUrl> staleUrls;
+    QList<DAbstractFileInfoPointer> revalidateInfoList;
+
+    // 事件队列溢出后按 (名称, inode, 修改时间) 重新比较当前目录
+    QFuture<void> rescanFuture;
+    bool rescanPending = false;
+    QMutex rescanMutex;
+    QString rescanPath;
+    QStringList rescanCreated, rescanRemoved, rescanChanged;
 
     Q_DECLARE_PUBLIC(DFileSystemModel)
 };
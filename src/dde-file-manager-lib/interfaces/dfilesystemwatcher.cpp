@@ -17,13 +17,21 @@
 #include <unistd.h>
 #endif
 
+//! 收到事件后等待更多事件的时间（ms）
+#define INOTIFY_READ_DELAY 10
+
 DFileSystemWatcherPrivate::DFileSystemWatcherPrivate(int fd, DFileSystemWatcher *qq)
     : q_ptr(qq)
     , inotifyFd(fd)
     , notifier(fd, QSocketNotifier::Read, qq)
+    , readTimer(qq)
 {
     fcntl(inotifyFd, F_SETFD, FD_CLOEXEC);
-    qq->connect(&notifier, SIGNAL(activated(int)), q_ptr, SLOT(_q_readFromInotify()));
+
+    readTimer.setSingleShot(true);
+    readTimer.setInterval(INOTIFY_READ_DELAY);
+    qq->connect(&readTimer, SIGNAL(timeout()), q_ptr, SLOT(_q_readFromInotify()));
+    qq->connect(&notifier, SIGNAL(activated(int)), q_ptr, SLOT(_q_scheduleRead()));
 }
 
 DFileSystemWatcherPrivate::~DFileSystemWatcherPrivate()
@@ -35,7 +43,7 @@ DFileSystemWatcherPrivate::~DFileSystemWatcherPrivate()
     ::close(inotifyFd);
 }
 
-QStringList DFileSystemWatcherPrivate::addPaths(const QStringList &paths, QStringList *files, QStringList *directories)
+QStringList DFileSystemWatcherPrivate::addPaths(const QStringList &paths, QSet<QString> *files, QSet<QString> *directories)
 {
     QStringList p = paths;
     QMutableListIterator<QString> it(p);
@@ -81,9 +89,9 @@ QStringList DFileSystemWatcherPrivate::addPaths(const QStringList &paths, QStrin
 
         int id = isDir ? -wd : wd;
         if (id < 0) {
-            directories->append(path);
+            directories->insert(path);
         } else {
-            files->append(path);
+            files->insert(path);
         }
 
         pathToID.insert(path, id);
@@ -93,7 +101,7 @@ QStringList DFileSystemWatcherPrivate::addPaths(const QStringList &paths, QStrin
     return p;
 }
 
-QStringList DFileSystemWatcherPrivate::removePaths(const QStringList &paths, QStringList *files, QStringList *directories)
+QStringList DFileSystemWatcherPrivate::removePaths(const QStringList &paths, QSet<QString> *files, QSet<QString> *directories)
 {
     QStringList p = paths;
     QMutableListIterator<QString> it(p);
@@ -116,20 +124,29 @@ QStringList DFileSystemWatcherPrivate::removePaths(const QStringList &paths, QSt
         }
 
         if (id < 0) {
-            directories->removeAll(path);
+            directories->remove(path);
         } else {
-            files->removeAll(path);
+            files->remove(path);
         }
     }
 
     return p;
 }
 
+void DFileSystemWatcherPrivate::_q_scheduleRead()
+{
+    // 大量文件变化时不必每个事件都唤醒一次，读取后再重新启用
+    notifier.setEnabled(false);
+    readTimer.start();
+}
+
 void DFileSystemWatcherPrivate::_q_readFromInotify()
 {
     Q_Q(DFileSystemWatcher);
 //    qDebug() << "QInotifyFileSystemWatcherEngine::readFromInotify";
 
+    notifier.setEnabled(true);
+
     int buffSize = 0;
     // fix task#36123 【自测】【桌面专业版】【SP2】【wayland】【文件管理器】 文件管理器概率出现卡死
     if (ioctl(inotifyFd, FIONREAD, (char *) &buffSize) <0 || buffSize == 0)
@@ -146,6 +163,7 @@ void DFileSystemWatcherPrivate::_q_readFromInotify()
     QMultiMap<int, QString> cookieToFilePath;
     QMultiMap<int, QString> cookieToFileName;
     QSet<int> hasMoveFromByCookie;
+    bool overflowed = false;
 #ifdef QT_DEBUG
     int exist_count = 0;
 #endif
@@ -155,6 +173,12 @@ void DFileSystemWatcherPrivate::_q_readFromInotify()
 
         at += sizeof(inotify_event) + event->len;
 
+        // 大量文件同时变化（如解压、rsync）时队列溢出，wd 为 -1
+        if (event->mask & IN_Q_OVERFLOW) {
+            overflowed = true;
+            continue;
+        }
+
         int id = event->wd;
         paths = idToPath.values(id);
         if (paths.empty()) {
@@ -333,6 +357,12 @@ void DFileSystemWatcherPrivate::_q_readFromInotify()
             if (event.mask & IN_MOVED_TO) {
 //                qDebug() << "IN_MOVED_TO" << filePath << name;
 
+                // 被监听的文件被替换（写入临时文件后重命名）时，重新监听新的文件
+                if (!name.isEmpty() && pathToID.contains(filePath)) {
+                    q->removePath(filePath);
+                    q->addPath(filePath);
+                }
+
                 if (!hasMoveFromByCookie.contains(event.cookie))
                 emit q->fileMoved(QString(), QString(), path, name, DFileSystemWatcher::QPrivateSignal());
             }
@@ -357,6 +387,12 @@ void DFileSystemWatcherPrivate::_q_readFromInotify()
             }
         }
     }
+
+    // 先发出读到的事件，再通知监听者重新检查目录
+    if (overflowed) {
+        qWarning() << "inotify event queue overflow, some file events are lost";
+        emit q->eventQueueOverflowed(DFileSystemWatcher::QPrivateSignal());
+    }
 }
 
 void DFileSystemWatcherPrivate::onFileChanged(const QString &path, bool removed)
@@ -366,7 +402,7 @@ void DFileSystemWatcherPrivate::onFileChanged(const QString &path, bool removed)
         return;
     }
     if (removed) {
-        files.removeAll(path);
+        files.remove(path);
     }
 //    emit q->fileChanged(path, DFileSystemWatcher::QPrivateSignal());
 }
@@ -378,7 +414,7 @@ void DFileSystemWatcherPrivate::onDirectoryChanged(const QString &path, bool rem
         return;
     }
     if (removed) {
-        directories.removeAll(path);
+        directories.remove(path);
     }
 //    emit q->directoryChanged(path, DFileSystemWatcher::QPrivateSignal());
 }
@@ -650,7 +686,7 @@ QStringList DFileSystemWatcher::directories() const
     if (!d)
         return QStringList();
 
-    return d->directories;
+    return d->directories.toList();
 }
 
 QStringList DFileSystemWatcher::files() const
@@ -660,7 +696,19 @@ QStringList DFileSystemWatcher::files() const
     if (!d)
         return QStringList();
 
-    return d->files;
+    return d->files.toList();
+}
+
+/*!
+    Returns true if \a path is a file or directory being watched.
+
+    Unlike files() and directories(), this does not copy the watched paths.
+*/
+bool DFileSystemWatcher::isWatched(const QString &path) const
+{
+    Q_D(const DFileSystemWatcher);
+
+    return d && (d->directories.contains(path) || d->files.contains(path));
 }
 
 #include "moc_dfilesystemwatcher.cpp"
@@ -25,6 +25,7 @@ public:
 
     QStringList files() const;
     QStringList directories() const;
+    bool isWatched(const QString &path) const;
 
 Q_SIGNALS:
     void fileDeleted(const QString &path, const QString &name, QPrivateSignal);
@@ -37,9 +38,12 @@ Q_SIGNALS:
 
     //! 当挂载的文件系统被卸载时发送卸载卸载信号
     void fileSystemUMount(const QString &path, const QString &name, QPrivateSignal);
+    //! 内核的事件队列溢出，丢失了事件，不能确定是哪些目录发生了变化
+    void eventQueueOverflowed(QPrivateSignal);
 private:
     QScopedPointer<DFileSystemWatcherPrivate> d_ptr;
 
+    Q_PRIVATE_SLOT(d_func(), void _q_scheduleRead())
     Q_PRIVATE_SLOT(d_func(), void _q_readFromInotify())
 };
 
@@ -387,6 +387,17 @@ quint64 DFileViewHelper::windowId() const
     return WindowManager::getWindowId(parent());
 }
 
+/*!
+ * \brief Return true if events of the window \a windowId should be handled by the model of this view.
+ *
+ * By default only the window of this view is accepted. Views sharing one model
+ * with other views override it to accept the windows of those views too.
+ */
+bool DFileViewHelper::isModelWindow(quint64 windowId) const
+{
+    return windowId == this->windowId();
+}
+
 /*!
  * \brief Return true if index is transparent; otherwise return false.
  * \param index
@@ -435,12 +446,12 @@ bool DFileViewHelper::isTransparent(const QModelIndex &index) const
 
     //判断该文件是否被剪切
     if (DFMGlobal::instance()->clipboardAction() == DFMGlobal::CutAction && (isTrashFile || fileInfo->canRename())) {
-        if (DFMGlobal::instance()->clipboardFileUrlList().contains(fileUrl))
+        if (DFMGlobal::instance()->isClipboardFile(fileUrl))
             return true;
 
         //链接文件只判断url，不判断inode，因为链接文件的inode与源文件的inode是一致的
         if (!fileInfo->isSymLink()) {
-            if (DFMGlobal::instance()->clipboardFileInodeList().contains(fileInfo->inode()))
+            if (DFMGlobal::instance()->isClipboardFileInode(fileInfo->inode()))
                 return true;
         }
     }
@@ -7,6 +7,7 @@
 
 #include "dfileservices.h"
 #include "dfilesystemwatcher.h"
+#include "dfanotifywatcher.h"
 
 #include "private/dfilesystemwatcher_p.h"
 #include "../vault/vaultglobaldefine.h"
@@ -47,13 +48,15 @@ public:
 
     QString path;
     QStringList watchFileList;
+    //! 已由 fanotify 监视整个目录树的路径，不占用 inotify 的监视
+    QStringList subtreePathList;
 
-    static QMap<QString, int> filePathToWatcherCount;
+    static QHash<QString, int> filePathToWatcherCount;
 
     Q_DECLARE_PUBLIC(DFileWatcher)
 };
 
-QMap<QString, int> DFileWatcherPrivate::filePathToWatcherCount;
+QHash<QString, int> DFileWatcherPrivate::filePathToWatcherCount;
 Q_GLOBAL_STATIC(DFileSystemWatcher, watcher_file_private)
 
 bool isPathWatched(const QString &path);
@@ -84,9 +87,7 @@ QStringList parentPathList(const QString &path)
 
 bool isPathWatched(const QString &path)
 {
-    QFileInfo fi(path);
-    return (fi.isDir() && watcher_file_private->directories().contains(path)) ||
-           (fi.isFile() && watcher_file_private->files().contains(path));
+    return watcher_file_private->isWatched(path);
 }
 
 bool DFileWatcherPrivate::start()
@@ -96,10 +97,18 @@ bool DFileWatcherPrivate::start()
     started = true;
 
     bool pathAdded = false;
+    DFanotifyWatcher *subtreeWatcher = DFanotifyWatcher::instance();
     foreach (const QString &path, parentPathList(this->path)) {
         if (watchFileList.contains(path))
             continue;
 
+        if (subtreeWatcher->isSubtreeWatched(path)) {
+            pathAdded = true;
+            watchFileList << path;
+            subtreePathList << path;
+            continue;
+        }
+
         if (filePathToWatcherCount.value(path, -1) <= 0 || !isPathWatched(path)) {
             if (QFile::exists(path)) {
                 bool shouldAddToPath = true;
@@ -140,6 +149,25 @@ bool DFileWatcherPrivate::start()
                q, &DFileWatcher::onFileClosed);
     q->connect(watcher_file_private, &DFileSystemWatcher::fileSystemUMount,
                q, &DFileWatcher::onFileSystemUMount);
+    q->connect(watcher_file_private, &DFileSystemWatcher::eventQueueOverflowed,
+               q, &DFileWatcher::onEventQueueOverflowed);
+
+    if (!subtreePathList.isEmpty()) {
+        q->connect(subtreeWatcher, &DFanotifyWatcher::fileDeleted,
+                   q, &DFileWatcher::onFileDeleted);
+        q->connect(subtreeWatcher, &DFanotifyWatcher::fileAttributeChanged,
+                   q, &DFileWatcher::onFileAttributeChanged);
+        q->connect(subtreeWatcher, &DFanotifyWatcher::fileMoved,
+                   q, &DFileWatcher::onFileMoved);
+        q->connect(subtreeWatcher, &DFanotifyWatcher::fileCreated,
+                   q, &DFileWatcher::onFileCreated);
+        q->connect(subtreeWatcher, &DFanotifyWatcher::fileModified,
+                   q, &DFileWatcher::onFileModified);
+        q->connect(subtreeWatcher, &DFanotifyWatcher::fileClosed,
+                   q, &DFileWatcher::onFileClosed);
+        q->connect(subtreeWatcher, &DFanotifyWatcher::eventQueueOverflowed,
+                   q, &DFileWatcher::onEventQueueOverflowed);
+    }
 
     q->connect(fileSignalManager, &FileSignalManager::fileMoved,
                q, &DFileWatcher::onFileMoved);
@@ -156,6 +184,14 @@ bool DFileWatcherPrivate::stop()
 //    q->disconnect(watcher_file_private, 0, q, 0);//避免0值警告
     q->disconnect(watcher_file_private, nullptr, q, nullptr);
 
+    if (!subtreePathList.isEmpty()) {
+        q->disconnect(DFanotifyWatcher::instance(), nullptr, q, nullptr);
+
+        for (const QString &path : subtreePathList)
+            watchFileList.removeOne(path);
+        subtreePathList.clear();
+    }
+
     bool ok = true;
 
     for (auto it = watchFileList.begin(); it != watchFileList.end();) {
@@ -232,9 +268,9 @@ void DFileWatcherPrivate::_q_handleFileDeleted(const QString &path, const QStrin
     //则需要发出当前目录也被删除的事件
     // fix 99280
     // 原判断会造成误删 例如删除 /media/uos/vfat时，会将 /media/uos/vfat1一起删除了
-    const QUrl &currentUrl = QUrl(path);
-    const QUrl &thisPathUrl = QUrl(this->path);
-    if (currentUrl.isParentOf(thisPathUrl)) {
+    // 每个 watcher 都会收到所有事件，直接比较路径，不解析 QUrl
+    const QString &parentPrefix = path.endsWith(QDir::separator()) ? path : path + QDir::separator();
+    if (this->path.startsWith(parentPrefix)) {
         emit q->fileDeleted(DUrl::fromLocalFile(this->path));
         return;
     }
@@ -267,6 +303,9 @@ bool DFileWatcherPrivate::_q_handleFileMoved(const QString &from, const QString
         emit q->fileDeleted(DUrl::fromLocalFile(from));
     } else if (watchFileList.contains(from)) {
         emit q->fileDeleted(url);
+    } else if (to == this->path) {
+        // 其它文件被重命名为监听的文件，即文件被原子地替换
+        emit q->fileModified(url);
     } else if (toParent == this->path) {
         emit q->subfileCreated(DUrl::fromLocalFile(to));
     } else {
@@ -278,7 +317,7 @@ bool DFileWatcherPrivate::_q_handleFileMoved(const QString &from, const QString
 
 void DFileWatcherPrivate::_q_handleFileCreated(const QString &path, const QString &parentPath)
 {
-    if (watchFileList.contains(path)) {
+    if (watchFileList.contains(path) && !subtreePathList.contains(path)) {
         bool result = watcher_file_private->addPath(path);
         if (!result) {
             qWarning() << Q_FUNC_INFO << "add to watcher failed, file path =" << path;
@@ -405,6 +444,11 @@ void DFileWatcher::onFileSystemUMount(const QString &path, const QString &name)
     d_func()->watchFileList.removeOne(path);
 }
 
+void DFileWatcher::onEventQueueOverflowed()
+{
+    emit eventsLost();
+}
+
 QStringList DFileWatcher::getMonitorFiles()
 {
     QStringList list;
@@ -414,7 +458,7 @@ QStringList DFileWatcher::getMonitorFiles()
 
     list << "---------------------------";
 
-    QMap<QString, int>::const_iterator i = DFileWatcherPrivate::filePathToWatcherCount.constBegin();
+    QHash<QString, int>::const_iterator i = DFileWatcherPrivate::filePathToWatcherCount.constBegin();
 
     while (i != DFileWatcherPrivate::filePathToWatcherCount.constEnd()) {
         list << QString("%1, %2").arg(i.key()).arg(i.value());
@@ -28,6 +28,7 @@ private slots:
 
     //! 处理文件系统卸载事件如U盘、Cryfs加密保险箱
     void onFileSystemUMount(const QString &path, const QString &name);
+    void onEventQueueOverflowed();
 
 private:
     Q_DECLARE_PRIVATE(DFileWatcher)
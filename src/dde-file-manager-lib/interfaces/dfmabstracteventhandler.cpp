@@ -41,4 +41,9 @@ bool DFMAbstractEventHandler::fmEventFilter(const QSharedPointer<DFMEvent> &even
     return false;
 }
 
+void DFMAbstractEventHandler::setHandledEventTypes(const QList<int> &types)
+{
+    DFMEventDispatcher::instance()->setHandledEventTypes(this, types);
+}
+
 DFM_END_NAMESPACE
@@ -22,6 +22,9 @@ protected:
     virtual bool fmEvent(const QSharedPointer<DFMEvent> &event, QVariant *resultData = 0);
     virtual bool fmEventFilter(const QSharedPointer<DFMEvent> &event, DFMAbstractEventHandler *target = 0, QVariant *resultData = 0);
 
+    //! 声明只处理这些类型的事件（DFMEvent::Type），未声明时接收所有事件
+    void setHandledEventTypes(const QList<int> &types);
+
     friend class DFMEventDispatcher;
 };
 
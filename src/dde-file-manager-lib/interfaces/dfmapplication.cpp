@@ -13,6 +13,8 @@
 #endif
 
 #include "dfmsettings.h"
+#include "dfmtrace.h"
+#include "dfmmemoryaccounting.h"
 #include "utils.h"
 #include "searchservice/searchservice.h"
 #include "rlog/rlog.h"
@@ -98,6 +100,9 @@ void DFMApplicationPrivate::_q_onSettingsValueChanged(const QString &group, cons
         case DFMApplication::GA_ShowCsdCrumbBarClickableArea:
             Q_EMIT self->csdClickableAreaAttributeChanged(value.toBool());
             break;
+        case DFMApplication::GA_MemorySoftLimit:
+            DFMMemoryAccounting::setSoftLimit(value.toLongLong() * 1024 * 1024);
+            break;
         case DFMApplication::GA_AlwaysShowOfflineRemoteConnections:
             gsGlobal->sync();   // cause later invocations may update the config file, so sync the config before.
             //smb挂载聚合功能实现后，这里无需刷新计算机界面以及调用stashCurrentMounts();
@@ -362,6 +367,9 @@ DFMApplication::DFMApplication(DFMApplicationPrivate *dd, QObject *parent)
         connect(asGlobal, &DFMSettings::valueChanged,
                 this, &DFMApplication::onSettingsValueChanged);
     }
+
+    DFMTrace::startFromEnvironment();
+    DFMMemoryAccounting::setSoftLimit(genericAttribute(GA_MemorySoftLimit).toLongLong() * 1024 * 1024);
 }
 
 void DFMApplication::onSettingsValueChanged(const QString &group, const QString &key, const QVariant &value)
@@ -50,6 +50,7 @@ public:
         GA_AutoMount, // 自动挂载硬盘设备
         GA_AutoMountAndOpen, // 自动挂载并打开硬盘设备
         GA_MTPShowBottomInfo, // mtp 挂载时显示底部数据统计
+        GA_MTPShowThumbnail, // mtp 挂载时生成文件的缩略图
         GA_AlwaysShowOfflineRemoteConnections, // 始终显示离线的远程挂载（目前只包括 smb 挂载常驻）
         GA_MergeTheEntriesOfSambaSharedFolders, // 合并显示Samba共享目录入口
         GA_OverrideFileChooserDialog, // 将DDE文件管理器作为应用选择文件时的对话框
@@ -63,6 +64,17 @@ public:
         GA_ShowFileSystemTagOnDiskIcon, // 在磁盘图标上显示文件系统信息
         GA_ShowDeleteConfirmDialog, // 显示删除确认对话框
         GA_HideLoopPartitions, // 隐藏 loop 分区
+        GA_CopyVerifyMode, // 复制后校验目标文件（0 不校验，1 快速校验，2 SHA-256 校验）
+        GA_CopyPageCachePolicy, // 复制时的页缓存策略（0 自动，1 保留页缓存，2 丢弃页缓存）
+        GA_CopyPreserveHardLinks, // 复制时保留源文件之间的硬链接
+        GA_CopyDeltaTransfer, // 替换已存在的大文件时只写入不同的数据块
+        GA_CopyIdenticalFilePolicy, // 复制到已存在的文件时跳过相同的文件（0 不跳过，1 比较大小和修改时间，2 再抽样比较内容，3 再比较全部内容）
+        GA_FullTextStoreMode, // 全文索引中保存的文件内容（0 不保存，1 保存摘要，2 保存全文）
+        GA_FullTextIndexBufferSize, // 建立全文索引时的内存缓存大小（MB）
+        GA_TagStorageMode, // 标记的保存方式（0 只保存在数据库，1 同时保存在文件的扩展属性中）
+        GA_HiddenViewMemoryBudget, // 后台标签视图的内存预算（MB），超出后释放最久未激活的视图，小于 0 时不释放
+        GA_MemorySoftLimit, // 常驻内存的软上限（MB），超出后清空各类缓存，小于等于 0 时不限制
+        GA_VaultBlockSize, // 创建保险箱时 cryfs 的块大小（KB），大块减少大文件的块数量和加解密开销，小于等于 0 时使用 cryfs 的默认值
     };
 
     Q_ENUM(GenericAttribute)
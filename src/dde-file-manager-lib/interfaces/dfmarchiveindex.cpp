@@ -0,0 +1,641 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dfmarchiveindex.h"
+#include "dfmmemoryaccounting.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QtEndian>
+#include <QDebug>
+
+#include <sys/stat.h>
+#include <zlib.h>
+
+// 缓存的总开销按文件数量计算，超过此数量的压缩包不建立索引
+#define ARCHIVE_INDEX_MAX_COST 500000
+// 每个索引项的估算内存占用，用于内存统计
+#define ARCHIVE_INDEX_ENTRY_ESTIMATED_SIZE 160
+// 中央目录超过此大小的 zip 不建立索引
+#define ZIP_MAX_CENTRAL_DIRECTORY_LEN 256 * 1024 * 1024
+#define ZIP_END_OF_CENTRAL_DIRECTORY_LEN 22
+#define ZIP_CENTRAL_DIRECTORY_ENTRY_LEN 46
+#define TAR_BLOCK_LEN 512
+#define TAR_READ_BUFFER_LEN 128 * 1024
+// GNU 长文件名、pax 扩展头等元数据记录的最大长度
+#define TAR_MAX_META_LEN 1024 * 1024
+
+static quint16 readU16(const QByteArray &data, int pos)
+{
+    return qFromLittleEndian<quint16>(reinterpret_cast<const uchar *>(data.constData() + pos));
+}
+
+static quint32 readU32(const QByteArray &data, int pos)
+{
+    return qFromLittleEndian<quint32>(reinterpret_cast<const uchar *>(data.constData() + pos));
+}
+
+static quint64 readU64(const QByteArray &data, int pos)
+{
+    return qFromLittleEndian<quint64>(reinterpret_cast<const uchar *>(data.constData() + pos));
+}
+
+static bool isZipFile(const QString &fileName)
+{
+    return fileName.endsWith(".zip", Qt::CaseInsensitive) || fileName.endsWith(".jar", Qt::CaseInsensitive);
+}
+
+static bool isTarFile(const QString &fileName)
+{
+    return fileName.endsWith(".tar", Qt::CaseInsensitive) || fileName.endsWith(".tar.gz", Qt::CaseInsensitive)
+            || fileName.endsWith(".tgz", Qt::CaseInsensitive);
+}
+
+static qint64 dosTimeToSecs(quint16 time, quint16 date)
+{
+    const QDateTime dateTime(QDate((date >> 9) + 1980, (date >> 5) & 0xf, date & 0x1f),
+                             QTime(time >> 11, (time >> 5) & 0x3f, (time & 0x1f) * 2));
+
+    return dateTime.isValid() ? dateTime.toMSecsSinceEpoch() / 1000 : 0;
+}
+
+/*!
+ * \brief tarNumber 解析 tar 文件头中的数字字段，支持八进制和 GNU 的 base-256 编码
+ */
+static qint64 tarNumber(const char *field, int len)
+{
+    qint64 value = 0;
+
+    if (field[0] & 0x80) {
+        value = field[0] & 0x7f;
+
+        for (int i = 1; i < len; ++i)
+            value = (value << 8) | static_cast<uchar>(field[i]);
+
+        return value;
+    }
+
+    int i = 0;
+
+    while (i < len && (field[i] == ' ' || field[i] == '\0'))
+        ++i;
+
+    for (; i < len && field[i] >= '0' && field[i] <= '7'; ++i)
+        value = (value << 3) | (field[i] - '0');
+
+    return value;
+}
+
+static bool tarChecksumValid(const char *header)
+{
+    qint64 sum = 0;
+
+    for (int i = 0; i < TAR_BLOCK_LEN; ++i)
+        sum += (i >= 148 && i < 156) ? ' ' : static_cast<uchar>(header[i]);
+
+    return sum == tarNumber(header + 148, 8);
+}
+
+static QByteArray tarString(const char *field, int len)
+{
+    return QByteArray(field, static_cast<int>(qstrnlen(field, static_cast<uint>(len))));
+}
+
+DFMArchiveIndex *DFMArchiveIndex::instance()
+{
+    static DFMArchiveIndex index;
+
+    return &index;
+}
+
+/*!
+ * \brief DFMArchiveIndex::canIndex 是否支持为此压缩包建立索引，只根据文件名判断
+ */
+bool DFMArchiveIndex::canIndex(const QString &archivePath)
+{
+    const QString &fileName = QFileInfo(archivePath).fileName();
+
+    return isZipFile(fileName) || isTarFile(fileName);
+}
+
+/*!
+ * \brief DFMArchiveIndex::splitPath 把压缩包内文件的路径拆分为压缩包的路径和压缩包内的相对路径
+ * \return 路径中的第一个文件是支持建立索引的压缩包时返回 true
+ */
+bool DFMArchiveIndex::splitPath(const QString &path, QString *archivePath, QString *innerPath)
+{
+    const QStringList &items = path.split('/', QString::SkipEmptyParts);
+    QString prefix;
+
+    for (int i = 0; i < items.size(); ++i) {
+        prefix += '/' + items.at(i);
+
+        const QFileInfo info(prefix);
+
+        if (info.isDir())
+            continue;
+
+        if (!info.isFile() || !canIndex(prefix))
+            return false;
+
+        if (archivePath)
+            *archivePath = prefix;
+
+        if (innerPath)
+            *innerPath = QStringList(items.mid(i + 1)).join('/');
+
+        return true;
+    }
+
+    return false;
+}
+
+/*!
+ * \brief DFMArchiveIndex::entry 获取压缩包内文件的信息，不包括压缩包本身
+ */
+bool DFMArchiveIndex::entry(const QString &path, Entry *entry)
+{
+    QString archivePath;
+    QString innerPath;
+
+    if (!splitPath(path, &archivePath, &innerPath) || innerPath.isEmpty())
+        return false;
+
+    const IndexPointer &index = this->index(archivePath);
+
+    if (!index)
+        return false;
+
+    auto it = index->entries.constFind(innerPath);
+
+    if (it == index->entries.constEnd())
+        return false;
+
+    if (entry)
+        *entry = *it;
+
+    return true;
+}
+
+/*!
+ * \brief DFMArchiveIndex::entries 获取压缩包内目录的文件列表，dirPath 为压缩包本身时获取根目录
+ */
+bool DFMArchiveIndex::entries(const QString &dirPath, QList<Entry> *entries)
+{
+    QString archivePath;
+    QString innerPath;
+
+    if (!splitPath(dirPath, &archivePath, &innerPath))
+        return false;
+
+    const IndexPointer &index = this->index(archivePath);
+
+    if (!index)
+        return false;
+
+    auto it = index->entries.constFind(innerPath);
+
+    if (it == index->entries.constEnd() || !it->isDir)
+        return false;
+
+    if (entries) {
+        const QString &prefix = innerPath.isEmpty() ? innerPath : innerPath + '/';
+
+        for (const QString &name : index->children.value(innerPath))
+            *entries << index->entries.value(prefix + name);
+    }
+
+    return true;
+}
+
+void DFMArchiveIndex::clear()
+{
+    QMutexLocker locker(&m_mutex);
+
+    m_cache.clear();
+    m_failed.clear();
+}
+
+int DFMArchiveIndex::count() const
+{
+    QMutexLocker locker(&m_mutex);
+
+    return m_cache.count();
+}
+
+int DFMArchiveIndex::totalCost() const
+{
+    QMutexLocker locker(&m_mutex);
+
+    return m_cache.totalCost();
+}
+
+DFMArchiveIndex::DFMArchiveIndex()
+{
+    m_cache.setMaxCost(ARCHIVE_INDEX_MAX_COST);
+
+    DFMMemoryAccounting::registerSubsystem("archiveIndex", [this] {
+        return static_cast<qint64>(totalCost()) * ARCHIVE_INDEX_ENTRY_ESTIMATED_SIZE;
+    }, [this] {
+        clear();
+    });
+}
+
+DFMArchiveIndex::IndexPointer DFMArchiveIndex::index(const QString &archivePath)
+{
+    const QFileInfo info(archivePath);
+    const qint64 size = info.size();
+    const qint64 modified = info.lastModified().toMSecsSinceEpoch();
+
+    {
+        QMutexLocker locker(&m_mutex);
+
+        if (m_failed.value(archivePath, qMakePair(-1LL, -1LL)) == qMakePair(size, modified))
+            return IndexPointer();
+
+        const IndexPointer &index = cachedIndex(archivePath, size, modified);
+
+        if (index)
+            return index;
+    }
+
+    QMutexLocker buildLocker(&m_buildMutex);
+
+    {
+        // 等待期间可能已由其它线程建立
+        QMutexLocker locker(&m_mutex);
+        const IndexPointer &index = cachedIndex(archivePath, size, modified);
+
+        if (index || m_failed.value(archivePath, qMakePair(-1LL, -1LL)) == qMakePair(size, modified))
+            return index;
+    }
+
+    QSharedPointer<Index> index(new Index);
+
+    index->archiveSize = size;
+    index->archiveModified = modified;
+
+    bool ok = isZipFile(info.fileName()) ? parseZip(archivePath, index.data()) : parseTar(archivePath, index.data());
+
+    if (ok && index->entries.size() >= ARCHIVE_INDEX_MAX_COST)
+        ok = false;
+
+    QMutexLocker locker(&m_mutex);
+
+    if (!ok) {
+        qDebug() << "archive index is not available, fall back to avfs:" << archivePath;
+        m_failed.insert(archivePath, qMakePair(size, modified));
+
+        return IndexPointer();
+    }
+
+    Entry root;
+
+    root.isDir = true;
+    root.name = info.fileName();
+    root.lastModified = modified / 1000;
+    index->entries.insert(QString(), root);
+
+    for (auto it = index->children.constBegin(); it != index->children.constEnd(); ++it)
+        index->entries[it.key()].childCount = it->size();
+
+    m_cache.insert(archivePath, new IndexPointer(index), index->entries.size());
+
+    return index;
+}
+
+/*!
+ * \brief DFMArchiveIndex::cachedIndex 获取缓存的索引，压缩包变化时丢弃旧的索引。调用时需持有 m_mutex
+ */
+DFMArchiveIndex::IndexPointer DFMArchiveIndex::cachedIndex(const QString &archivePath, qint64 size, qint64 modified)
+{
+    IndexPointer *index = m_cache.object(archivePath);
+
+    if (!index)
+        return IndexPointer();
+
+    if ((*index)->archiveSize == size && (*index)->archiveModified == modified)
+        return *index;
+
+    m_cache.remove(archivePath);
+
+    return IndexPointer();
+}
+
+bool DFMArchiveIndex::parseZip(const QString &archivePath, Index *index)
+{
+    QFile file(archivePath);
+
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    const qint64 size = file.size();
+
+    if (size < ZIP_END_OF_CENTRAL_DIRECTORY_LEN)
+        return false;
+
+    // 中央目录结束记录位于文件末尾，之后最多有64K的注释
+    const qint64 tailLen = qMin<qint64>(size, ZIP_END_OF_CENTRAL_DIRECTORY_LEN + 0xffff);
+
+    if (!file.seek(size - tailLen))
+        return false;
+
+    const QByteArray &tail = file.read(tailLen);
+    int pos = tail.size() - ZIP_END_OF_CENTRAL_DIRECTORY_LEN;
+
+    while (pos >= 0 && readU32(tail, pos) != 0x06054b50)
+        --pos;
+
+    if (pos < 0)
+        return false;
+
+    quint64 count = readU16(tail, pos + 10);
+    quint64 directorySize = readU32(tail, pos + 12);
+    quint64 directoryOffset = readU32(tail, pos + 16);
+
+    // zip64 的数量和偏移记录在 zip64 中央目录结束记录中
+    if (count == 0xffff || directorySize == 0xffffffff || directoryOffset == 0xffffffff) {
+        const qint64 locatorPos = size - tailLen + pos - 20;
+
+        if (locatorPos < 0 || !file.seek(locatorPos))
+            return false;
+
+        const QByteArray &locator = file.read(20);
+
+        if (locator.size() != 20 || readU32(locator, 0) != 0x07064b50)
+            return false;
+
+        if (!file.seek(static_cast<qint64>(readU64(locator, 8))))
+            return false;
+
+        const QByteArray &record = file.read(56);
+
+        if (record.size() != 56 || readU32(record, 0) != 0x06064b50)
+            return false;
+
+        count = readU64(record, 32);
+        directorySize = readU64(record, 40);
+        directoryOffset = readU64(record, 48);
+    }
+
+    if (directorySize > ZIP_MAX_CENTRAL_DIRECTORY_LEN || directoryOffset + directorySize > static_cast<quint64>(size))
+        return false;
+
+    if (!file.seek(static_cast<qint64>(directoryOffset)))
+        return false;
+
+    const QByteArray &directory = file.read(static_cast<qint64>(directorySize));
+
+    if (static_cast<quint64>(directory.size()) != directorySize)
+        return false;
+
+    pos = 0;
+
+    for (quint64 i = 0; i < count; ++i) {
+        if (pos + ZIP_CENTRAL_DIRECTORY_ENTRY_LEN > directory.size() || readU32(directory, pos) != 0x02014b50)
+            return false;
+
+        const int nameLen = readU16(directory, pos + 28);
+        const int extraLen = readU16(directory, pos + 30);
+        const int commentLen = readU16(directory, pos + 32);
+        const int next = pos + ZIP_CENTRAL_DIRECTORY_ENTRY_LEN + nameLen + extraLen + commentLen;
+
+        if (next > directory.size())
+            return false;
+
+        Entry entry;
+        quint64 fileSize = readU32(directory, pos + 24);
+
+        entry.lastModified = dosTimeToSecs(readU16(directory, pos + 12), readU16(directory, pos + 14));
+
+        if (fileSize == 0xffffffff) {
+            int extraPos = pos + ZIP_CENTRAL_DIRECTORY_ENTRY_LEN + nameLen;
+            const int extraEnd = extraPos + extraLen;
+
+            while (extraPos + 4 <= extraEnd) {
+                const int id = readU16(directory, extraPos);
+                const int len = readU16(directory, extraPos + 2);
+
+                if (id == 0x0001 && len >= 8 && extraPos + 12 <= extraEnd) {
+                    fileSize = readU64(directory, extraPos + 4);
+                    break;
+                }
+
+                extraPos += 4 + len;
+            }
+        }
+
+        entry.size = static_cast<qint64>(fileSize);
+
+        // 由 unix 系统创建时外部属性的高16位为 st_mode
+        if ((readU16(directory, pos + 4) >> 8) == 3) {
+            const uint mode = readU32(directory, pos + 38) >> 16;
+
+            entry.mode = mode & 07777;
+            entry.isDir = S_ISDIR(mode);
+            entry.isSymLink = S_ISLNK(mode);
+        }
+
+        const QByteArray &name = directory.mid(pos + ZIP_CENTRAL_DIRECTORY_ENTRY_LEN, nameLen);
+
+        if (name.endsWith('/'))
+            entry.isDir = true;
+
+        if (entry.isDir)
+            entry.size = 0;
+
+        if (!addEntry(index, name, entry))
+            return false;
+
+        pos = next;
+    }
+
+    return true;
+}
+
+/*!
+ * \brief DFMArchiveIndex::parseTar 读取 tar 的文件头，gzip 压缩的 tar 需要完整解压一遍，未压缩的 tar 直接跳过文件内容
+ */
+bool DFMArchiveIndex::parseTar(const QString &archivePath, Index *index)
+{
+    gzFile file = gzopen(QFile::encodeName(archivePath).constData(), "rb");
+
+    if (!file)
+        return false;
+
+    gzbuffer(file, TAR_READ_BUFFER_LEN);
+
+    char header[TAR_BLOCK_LEN];
+    QByteArray longName;
+    QByteArray paxPath;
+    qint64 paxSize = -1;
+    qint64 paxModified = -1;
+    bool ok = false;
+
+    forever {
+        if (gzread(file, header, TAR_BLOCK_LEN) != TAR_BLOCK_LEN)
+            break;
+
+        // 结束标记为全0的块
+        if (header[0] == '\0') {
+            ok = true;
+            break;
+        }
+
+        if (!tarChecksumValid(header))
+            break;
+
+        const char type = header[156];
+        qint64 size = tarNumber(header + 124, 12);
+
+        if (type == 'L' || type == 'K' || type == 'x' || type == 'g') {
+            if (size > TAR_MAX_META_LEN)
+                break;
+
+            const int dataLen = static_cast<int>((size + TAR_BLOCK_LEN - 1) / TAR_BLOCK_LEN * TAR_BLOCK_LEN);
+            QByteArray data(dataLen, '\0');
+
+            if (gzread(file, data.data(), static_cast<unsigned>(dataLen)) != dataLen)
+                break;
+
+            data.truncate(static_cast<int>(size));
+
+            if (type == 'L') {
+                longName = tarString(data.constData(), data.size());
+            } else if (type == 'x') {
+                // pax 扩展头的每条记录为 "长度 键=值\n"
+                int pos = 0;
+
+                while (pos < data.size()) {
+                    const int space = data.indexOf(' ', pos);
+                    const int len = space > pos ? data.mid(pos, space - pos).toInt() : 0;
+
+                    if (len <= 0 || pos + len > data.size())
+                        break;
+
+                    const QByteArray &record = data.mid(space + 1, pos + len - space - 2);
+                    const int equal = record.indexOf('=');
+                    const QByteArray &key = record.left(equal);
+                    const QByteArray &value = record.mid(equal + 1);
+
+                    if (key == "path")
+                        paxPath = value;
+                    else if (key == "size")
+                        paxSize = value.toLongLong();
+                    else if (key == "mtime")
+                        paxModified = static_cast<qint64>(value.toDouble());
+
+                    pos += len;
+                }
+            }
+
+            continue;
+        }
+
+        QByteArray name = !paxPath.isEmpty() ? paxPath : longName;
+
+        if (name.isEmpty()) {
+            name = tarString(header, 100);
+
+            // POSIX ustar 格式的文件名前缀
+            if (memcmp(header + 257, "ustar\0", 6) == 0 && header[345] != '\0')
+                name = tarString(header + 345, 155) + '/' + name;
+        }
+
+        if (paxSize >= 0)
+            size = paxSize;
+
+        Entry entry;
+
+        entry.size = (type == '5') ? 0 : size;
+        entry.lastModified = paxModified >= 0 ? paxModified : tarNumber(header + 136, 12);
+        entry.mode = static_cast<uint>(tarNumber(header + 100, 8)) & 07777;
+        entry.isDir = type == '5';
+        entry.isSymLink = type == '2';
+
+        // 跳过卷标等不是文件的记录
+        if (type != 'V' && type != 'M' && !addEntry(index, name, entry))
+            break;
+
+        longName.clear();
+        paxPath.clear();
+        paxSize = -1;
+        paxModified = -1;
+
+        // 硬链接、符号链接和目录没有内容
+        if (type == '1' || type == '2' || type == '5')
+            size = 0;
+
+        const qint64 dataLen = (size + TAR_BLOCK_LEN - 1) / TAR_BLOCK_LEN * TAR_BLOCK_LEN;
+
+        if (dataLen > 0 && gzseek(file, static_cast<z_off_t>(dataLen), SEEK_CUR) < 0)
+            break;
+    }
+
+    gzclose(file);
+
+    return ok && !index->entries.isEmpty();
+}
+
+/*!
+ * \brief DFMArchiveIndex::addEntry 加入一个文件并补全压缩包中没有单独记录的上级目录
+ * \return 文件名不是 UTF-8 编码时返回 false，此时 avfs 中的文件名与索引不一致，不能使用索引
+ */
+bool DFMArchiveIndex::addEntry(Index *index, const QByteArray &rawName, Entry entry)
+{
+    const QString &name = QString::fromUtf8(rawName);
+
+    if (name.toUtf8() != rawName)
+        return false;
+
+    QStringList items;
+
+    for (const QString &item : name.split('/', QString::SkipEmptyParts)) {
+        if (item == ".")
+            continue;
+
+        // 指向压缩包以外的路径，avfs 中不可见
+        if (item == "..")
+            return true;
+
+        items << item;
+    }
+
+    if (items.isEmpty())
+        return true;
+
+    QString parent;
+
+    for (int i = 0; i < items.size() - 1; ++i) {
+        const QString &dir = parent.isEmpty() ? items.at(i) : parent + '/' + items.at(i);
+
+        if (!index->entries.contains(dir)) {
+            Entry dirEntry;
+
+            dirEntry.name = items.at(i);
+            dirEntry.isDir = true;
+            dirEntry.lastModified = entry.lastModified;
+            index->entries.insert(dir, dirEntry);
+            index->children[parent] << dirEntry.name;
+        }
+
+        parent = dir;
+    }
+
+    entry.name = items.last();
+
+    const QString &path = items.join('/');
+    auto it = index->entries.find(path);
+
+    if (it == index->entries.end()) {
+        index->children[parent] << entry.name;
+        index->entries.insert(path, entry);
+    } else if (!it->isDir || entry.isDir) {
+        // 同名的记录以后出现的为准（如追加到 tar 中的文件）
+        *it = entry;
+    }
+
+    return true;
+}
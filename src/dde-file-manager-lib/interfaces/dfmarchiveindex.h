@@ -0,0 +1,77 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DFMARCHIVEINDEX_H
+#define DFMARCHIVEINDEX_H
+
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QCache>
+#include <QMutex>
+#include <QSharedPointer>
+
+/*!
+ * \brief DFMArchiveIndex 压缩包的目录索引缓存
+ *
+ * 读取 zip 的中央目录或 tar（包括 tar.gz）的文件头，建立压缩包内的目录结构。
+ * 浏览压缩包时文件列表和文件信息直接从索引中获取，不必经过 avfs 的 FUSE 层反复解析压缩包，
+ * avfs 只用于读取文件内容。索引按压缩包的路径缓存，压缩包的大小或修改时间变化时重新建立。
+ * 不支持的格式或文件名不是 UTF-8 编码的压缩包不建立索引，仍然使用 avfs。
+ */
+class DFMArchiveIndex
+{
+public:
+    struct Entry {
+        QString name;
+        qint64 size = 0;
+        // 修改时间，自1970年起的秒数
+        qint64 lastModified = 0;
+        // st_mode 中的权限位，压缩包中没有记录时为0
+        uint mode = 0;
+        bool isDir = false;
+        bool isSymLink = false;
+        // 目录包含的文件数量
+        int childCount = 0;
+    };
+
+    static DFMArchiveIndex *instance();
+    static bool canIndex(const QString &archivePath);
+    static bool splitPath(const QString &path, QString *archivePath, QString *innerPath);
+
+    bool entry(const QString &path, Entry *entry);
+    bool entries(const QString &dirPath, QList<Entry> *entries);
+    void clear();
+
+    int count() const;
+    int totalCost() const;
+
+private:
+    DFMArchiveIndex();
+
+    struct Index {
+        qint64 archiveSize = -1;
+        qint64 archiveModified = -1;
+        // 键为压缩包内的相对路径，根目录为空字符串
+        QHash<QString, Entry> entries;
+        QHash<QString, QStringList> children;
+    };
+    typedef QSharedPointer<const Index> IndexPointer;
+
+    IndexPointer index(const QString &archivePath);
+    IndexPointer cachedIndex(const QString &archivePath, qint64 size, qint64 modified);
+
+    static bool parseZip(const QString &archivePath, Index *index);
+    static bool parseTar(const QString &archivePath, Index *index);
+    static bool addEntry(Index *index, const QByteArray &rawName, Entry entry);
+
+    mutable QMutex m_mutex;
+    // 建立索引时持有，避免同时为同一个压缩包创建的大量文件信息重复解析
+    QMutex m_buildMutex;
+    QCache<QString, IndexPointer> m_cache;
+    // 无法建立索引的压缩包及其大小和修改时间
+    QHash<QString, QPair<qint64, qint64>> m_failed;
+};
+
+#endif // DFMARCHIVEINDEX_H
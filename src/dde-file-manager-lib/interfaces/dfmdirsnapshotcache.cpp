@@ -0,0 +1,197 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dfmdirsnapshotcache.h"
+#include "dfileservices.h"
+#include "dabstractfilewatcher.h"
+#include "dfmmetrics.h"
+#include "dfmmemoryaccounting.h"
+
+// 缓存的总文件数上限
+#define SNAPSHOT_CACHE_MAX_COST 200000
+// 每个快照的基础开销，限制缓存的目录数量（每个快照都占用一个文件监视器）
+#define SNAPSHOT_BASE_COST 500
+// 每个文件在快照中的估算开销（字节），文件信息本身已计入 fileInfo
+#define SNAPSHOT_ENTRY_ESTIMATED_SIZE 96
+
+static bool passSnapshotFilters(const DAbstractFileInfoPointer &info, QDir::Filters filters)
+{
+    if (!info || !info->exists())
+        return false;
+
+    if (!filters.testFlag(QDir::Hidden) && info->isHidden())
+        return false;
+
+    if (info->isDir())
+        return filters.testFlag(QDir::Dirs) || filters.testFlag(QDir::AllDirs);
+
+    return filters.testFlag(QDir::Files);
+}
+
+DFMDirSnapshotCache::Snapshot::~Snapshot()
+{
+    if (watcher) {
+        watcher->stopWatcher();
+        watcher->deleteLater();
+    }
+}
+
+DFMDirSnapshotCache *DFMDirSnapshotCache::instance()
+{
+    static DFMDirSnapshotCache cache;
+
+    return &cache;
+}
+
+/*!
+ * \brief DFMDirSnapshotCache::canCache 只缓存本地目录，远程目录的文件监视不可靠
+ */
+bool DFMDirSnapshotCache::canCache(const DAbstractFileInfoPointer &dirInfo)
+{
+    return dirInfo && dirInfo->fileUrl().isLocalFile() && !dirInfo->isGvfsMountFile() && dirInfo->isDir();
+}
+
+/*!
+ * \brief DFMDirSnapshotCache::snapshot 获取目录的快照
+ * \param filters 快照必须以相同的过滤条件生成
+ * \return 没有可用的快照时返回false
+ */
+bool DFMDirSnapshotCache::snapshot(const DUrl &dirUrl, QDir::Filters filters, QList<DAbstractFileInfoPointer> *infoList)
+{
+    Snapshot *snapshot = m_cache.object(dirUrl);
+
+    if (!snapshot || snapshot->filters != filters) {
+        DFM_METRIC_INC("dirSnapshot.cacheMiss");
+        return false;
+    }
+
+    DFM_METRIC_INC("dirSnapshot.cacheHit");
+
+    if (infoList)
+        *infoList = snapshot->infos.values();
+
+    return true;
+}
+
+bool DFMDirSnapshotCache::insert(const DUrl &dirUrl, QDir::Filters filters, const QList<DAbstractFileInfoPointer> &infoList)
+{
+    const int cost = infoList.size() + SNAPSHOT_BASE_COST;
+
+    if (cost > m_cache.maxCost()) {
+        m_cache.remove(dirUrl);
+
+        return false;
+    }
+
+    // 已有快照时复用其文件监视器
+    Snapshot *snapshot = m_cache.take(dirUrl);
+
+    if (!snapshot) {
+        DAbstractFileWatcher *watcher = DFileService::instance()->createFileWatcher(this, dirUrl, this);
+
+        if (!watcher)
+            return false;
+
+        if (!watcher->startWatcher()) {
+            watcher->deleteLater();
+
+            return false;
+        }
+
+        snapshot = new Snapshot();
+        snapshot->watcher = watcher;
+
+        connect(watcher, &DAbstractFileWatcher::subfileCreated, this, [this, dirUrl](const DUrl &url) {
+            onFileCreated(dirUrl, url);
+        });
+        connect(watcher, &DAbstractFileWatcher::fileDeleted, this, [this, dirUrl](const DUrl &url) {
+            onFileDeleted(dirUrl, url);
+        });
+        connect(watcher, &DAbstractFileWatcher::fileMoved, this, [this, dirUrl](const DUrl &fromUrl, const DUrl &toUrl) {
+            onFileMoved(dirUrl, fromUrl, toUrl);
+        });
+    }
+
+    snapshot->filters = filters;
+    snapshot->infos.clear();
+    snapshot->infos.reserve(infoList.size());
+
+    for (const DAbstractFileInfoPointer &info : infoList) {
+        snapshot->infos.insert(info->fileUrl(), info);
+    }
+
+    return m_cache.insert(dirUrl, snapshot, cost);
+}
+
+void DFMDirSnapshotCache::remove(const DUrl &dirUrl)
+{
+    m_cache.remove(dirUrl);
+}
+
+void DFMDirSnapshotCache::clear()
+{
+    m_cache.clear();
+}
+
+int DFMDirSnapshotCache::count() const
+{
+    return m_cache.count();
+}
+
+int DFMDirSnapshotCache::totalCost() const
+{
+    return m_cache.totalCost();
+}
+
+DFMDirSnapshotCache::DFMDirSnapshotCache(QObject *parent)
+    : QObject(parent)
+{
+    m_cache.setMaxCost(SNAPSHOT_CACHE_MAX_COST);
+
+    DFMMemoryAccounting::registerSubsystem("dirSnapshot", [this] {
+        return static_cast<qint64>(totalCost()) * SNAPSHOT_ENTRY_ESTIMATED_SIZE;
+    }, [this] {
+        clear();
+    });
+}
+
+void DFMDirSnapshotCache::onFileCreated(const DUrl &dirUrl, const DUrl &fileUrl)
+{
+    Snapshot *snapshot = m_cache.object(dirUrl);
+
+    if (!snapshot)
+        return;
+
+    const DAbstractFileInfoPointer &info = DFileService::instance()->createFileInfo(this, fileUrl);
+
+    // 快照的开销在插入时确定，此后新增的文件不再计入，下次保存快照时更新
+    if (passSnapshotFilters(info, snapshot->filters))
+        snapshot->infos.insert(fileUrl, info);
+}
+
+void DFMDirSnapshotCache::onFileDeleted(const DUrl &dirUrl, const DUrl &fileUrl)
+{
+    if (fileUrl == dirUrl) {
+        remove(dirUrl);
+
+        return;
+    }
+
+    if (Snapshot *snapshot = m_cache.object(dirUrl))
+        snapshot->infos.remove(fileUrl);
+}
+
+void DFMDirSnapshotCache::onFileMoved(const DUrl &dirUrl, const DUrl &fromUrl, const DUrl &toUrl)
+{
+    if (fromUrl == dirUrl) {
+        remove(dirUrl);
+
+        return;
+    }
+
+    onFileDeleted(dirUrl, fromUrl);
+
+    if (toUrl.parentUrl() == dirUrl)
+        onFileCreated(dirUrl, toUrl);
+}
@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DFMDIRSNAPSHOTCACHE_H
+#define DFMDIRSNAPSHOTCACHE_H
+
+#include "dabstractfileinfo.h"
+
+#include <QObject>
+#include <QCache>
+#include <QDir>
+
+class DAbstractFileWatcher;
+
+/*!
+ * \brief DFMDirSnapshotCache 进程内共享的目录列表快照缓存
+ *
+ * 目录遍历完成后保存其文件列表，快照由各自的文件监视器保持更新。
+ * 后退或在新标签页打开同一目录时直接使用快照，不必重新遍历。
+ * 缓存按文件数量限制总大小，超出时淘汰最久未使用的快照。
+ */
+class DFMDirSnapshotCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    static DFMDirSnapshotCache *instance();
+    static bool canCache(const DAbstractFileInfoPointer &dirInfo);
+
+    bool snapshot(const DUrl &dirUrl, QDir::Filters filters, QList<DAbstractFileInfoPointer> *infoList);
+    bool insert(const DUrl &dirUrl, QDir::Filters filters, const QList<DAbstractFileInfoPointer> &infoList);
+    void remove(const DUrl &dirUrl);
+    void clear();
+
+    int count() const;
+    int totalCost() const;
+
+private:
+    explicit DFMDirSnapshotCache(QObject *parent = nullptr);
+
+    void onFileCreated(const DUrl &dirUrl, const DUrl &fileUrl);
+    void onFileDeleted(const DUrl &dirUrl, const DUrl &fileUrl);
+    void onFileMoved(const DUrl &dirUrl, const DUrl &fromUrl, const DUrl &toUrl);
+
+    class Snapshot
+    {
+    public:
+        ~Snapshot();
+
+        QDir::Filters filters;
+        QHash<DUrl, DAbstractFileInfoPointer> infos;
+        DAbstractFileWatcher *watcher = nullptr;
+    };
+
+    QCache<DUrl, Snapshot> m_cache;
+};
+
+#endif // DFMDIRSNAPSHOTCACHE_H
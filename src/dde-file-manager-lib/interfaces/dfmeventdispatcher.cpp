@@ -6,11 +6,24 @@
 #include "dfmabstracteventhandler.h"
 
 #include <QList>
-#include <QtConcurrentRun>
+#include <QHash>
+#include <QSet>
+#include <QVector>
+#include <QReadWriteLock>
+#include <QThread>
+#include <QRunnable>
+#include <QThreadPool>
+#include <QFutureInterface>
 #include <QFutureWatcher>
 #include <QCoreApplication>
 #include <QDebug>
 
+#include <unistd.h>
+
+// 慢速的 gvfs 调用和批量任务使用独立的线程，不会占满处理本地事件的线程
+#define BULK_EVENT_THREAD_COUNT 2
+#define GVFS_EVENT_THREAD_COUNT 4
+
 DFM_BEGIN_NAMESPACE
 
 class DFMEventDispatcherPrivate
@@ -98,6 +111,10 @@ int DFMEventFuture::waitForFinishedWithEventLoop(QEventLoop::ProcessEventsFlags
 
 QVariant DFMEventFuture::result() const
 {
+    // 排队时被取消的事件没有结果
+    if (m_future.isCanceled() && m_future.resultCount() == 0)
+        return QVariant();
+
     return m_future.result();
 }
 
@@ -107,10 +124,120 @@ void DFMEventFuture::operator =(const DFMEventFuture &other)
 }
 
 namespace DFMEventDispatcherData {
-static QList<DFMAbstractEventHandler *> eventHandler;
-static QList<DFMAbstractEventHandler *> eventFilter;
+static QVector<DFMAbstractEventHandler *> eventHandler;
+static QVector<DFMAbstractEventHandler *> eventFilter;
+//! 声明了可处理的事件类型的处理者，未声明的处理者接收所有事件
+static QHash<DFMAbstractEventHandler *, QSet<int>> handledTypes;
+//! 按事件类型缓存的处理者，保持安装的顺序，处理者变化时清空
+static QHash<int, QVector<DFMAbstractEventHandler *>> handlersOfType;
+static QReadWriteLock lock;
+
+static QVector<DFMAbstractEventHandler *> handlers(int type)
+{
+    {
+        QReadLocker locker(&lock);
+        auto it = handlersOfType.constFind(type);
+
+        if (it != handlersOfType.constEnd())
+            return *it;
+    }
+
+    QWriteLocker locker(&lock);
+    QVector<DFMAbstractEventHandler *> list;
+
+    for (DFMAbstractEventHandler *handler : eventHandler) {
+        auto it = handledTypes.constFind(handler);
+
+        if (it == handledTypes.constEnd() || it->contains(type))
+            list << handler;
+    }
+
+    handlersOfType.insert(type, list);
+
+    return list;
+}
+
+static QThreadPool *createThreadPool(int maxThreadCount)
+{
+    QThreadPool *pool = new QThreadPool();
+
+    pool->setMaxThreadCount(maxThreadCount);
+
+    return pool;
+}
+
+static QThreadPool *threadPool()
+{
+    static QThreadPool *pool = createThreadPool(qMax(4, QThread::idealThreadCount()));
+    return pool;
+}
+
+static QThreadPool *bulkThreadPool()
+{
+    static QThreadPool *pool = createThreadPool(BULK_EVENT_THREAD_COUNT);
+    return pool;
+}
+
+static QThreadPool *gvfsThreadPool()
+{
+    static QThreadPool *pool = createThreadPool(GVFS_EVENT_THREAD_COUNT);
+    return pool;
+}
+
+//! 当前线程正在处理的异步事件，处理者据此检查事件是否已被取消
+static thread_local QFutureInterface<QVariant> *currentEvent = nullptr;
+
+static bool isGvfsEvent(const QSharedPointer<DFMEvent> &event)
+{
+    static const QString gvfsPath = QString("/run/user/%1/gvfs/").arg(getuid());
+
+    for (const DUrl &url : event->handleUrlList()) {
+        if (url.isLocalFile() ? url.path().startsWith(gvfsPath)
+                : (url.scheme() == SMB_SCHEME || url.scheme() == FTP_SCHEME || url.scheme() == SFTP_SCHEME
+                   || url.scheme() == NETWORK_SCHEME || url.scheme() == MTP_SCHEME || url.scheme() == DAV_SCHEME)) {
+            return true;
+        }
+    }
 
-Q_GLOBAL_STATIC(QThreadPool, threadPool)
+    return false;
+}
+
+class EventRunnable : public QRunnable
+{
+public:
+    EventRunnable(DFMEventDispatcher *dispatcher, const QSharedPointer<DFMEvent> &event, DFMAbstractEventHandler *target)
+        : m_dispatcher(dispatcher)
+        , m_event(event)
+        , m_target(target)
+    {
+        m_promise.reportStarted();
+    }
+
+    QFuture<QVariant> future()
+    {
+        return m_promise.future();
+    }
+
+    void run() override
+    {
+        // 排队期间被取消时不再处理
+        if (!m_promise.isCanceled()) {
+            currentEvent = &m_promise;
+            const QVariant &result = m_dispatcher->processEvent(m_event, m_target);
+            currentEvent = nullptr;
+
+            m_promise.reportResult(result);
+        }
+
+        m_promise.reportFinished();
+    }
+
+private:
+    QFutureInterface<QVariant> m_promise;
+    DFMEventDispatcher *m_dispatcher;
+    QSharedPointer<DFMEvent> m_event;
+    DFMAbstractEventHandler *m_target;
+};
 }
 
 class DFMEventDispatcher_ : public DFMEventDispatcher {};
@@ -134,8 +261,14 @@ QVariant DFMEventDispatcher::processEvent(const QSharedPointer<DFMEvent> &event,
     d->setState(Busy);
 
     QVariant result;
+    QVector<DFMAbstractEventHandler *> filters;
+
+    {
+        QReadLocker locker(&DFMEventDispatcherData::lock);
+        filters = DFMEventDispatcherData::eventFilter;
+    }
 
-    for (DFMAbstractEventHandler *handler : DFMEventDispatcherData::eventFilter) {
+    for (DFMAbstractEventHandler *handler : filters) {
         if (!handler)
             continue;
         if (handler->fmEventFilter(event, target, &result))
@@ -145,7 +278,7 @@ QVariant DFMEventDispatcher::processEvent(const QSharedPointer<DFMEvent> &event,
     if (target) {
         target->fmEvent(event, &result);
     } else {
-        for (DFMAbstractEventHandler *handler : DFMEventDispatcherData::eventHandler) {
+        for (DFMAbstractEventHandler *handler : DFMEventDispatcherData::handlers(event->type())) {
             if (handler->fmEvent(event, &result))
                 return result;
         }
@@ -156,28 +289,57 @@ QVariant DFMEventDispatcher::processEvent(const QSharedPointer<DFMEvent> &event,
     return result;
 }
 
-DFMEventFuture DFMEventDispatcher::processEventAsync(const QSharedPointer<DFMEvent> &event, DFMAbstractEventHandler *target)
+/*!
+ * \brief DFMEventDispatcher::processEventAsync 在固定数量的线程中处理事件
+ * \param priority 交互事件优先于普通事件，批量事件和 gvfs 上的事件使用各自的线程
+ *
+ * 在事件线程中再次异步处理事件时直接处理，避免等待被占满的线程
+ */
+DFMEventFuture DFMEventDispatcher::processEventAsync(const QSharedPointer<DFMEvent> &event, DFMAbstractEventHandler *target, Priority priority)
 {
-    QThreadPool *pool = DFMEventDispatcherData::threadPool;
+    if (DFMEventDispatcherData::currentEvent) {
+        QFutureInterface<QVariant> promise;
+
+        promise.reportStarted();
+        promise.reportResult(processEvent(event, target));
+        promise.reportFinished();
 
-    if (pool->maxThreadCount() <= pool->activeThreadCount()) {
-        pool->setMaxThreadCount(pool->maxThreadCount() + 2);
+        return DFMEventFuture(promise.future());
     }
 
-    return DFMEventFuture(QtConcurrent::run(pool, this, static_cast<QVariant(DFMEventDispatcher::*)(const QSharedPointer<DFMEvent>&, DFMAbstractEventHandler *)>(&DFMEventDispatcher::processEvent), event, target));
+    DFMEventDispatcherData::EventRunnable *runnable = new DFMEventDispatcherData::EventRunnable(this, event, target);
+    const QFuture<QVariant> &future = runnable->future();
+
+    if (DFMEventDispatcherData::isGvfsEvent(event)) {
+        DFMEventDispatcherData::gvfsThreadPool()->start(runnable, priority == InteractivePriority ? 1 : 0);
+    } else if (priority == BulkPriority) {
+        DFMEventDispatcherData::bulkThreadPool()->start(runnable);
+    } else {
+        DFMEventDispatcherData::threadPool()->start(runnable, priority == InteractivePriority ? 1 : 0);
+    }
+
+    return DFMEventFuture(future);
 }
 
 QVariant DFMEventDispatcher::processEventWithEventLoop(const QSharedPointer<DFMEvent> &event, DFMAbstractEventHandler *target)
 {
-    const DFMEventFuture &future = processEventAsync(event, target);
+    // 调用者在等待结果，按交互事件处理
+    const DFMEventFuture &future = processEventAsync(event, target, InteractivePriority);
 
     future.waitForFinishedWithEventLoop();
 
     return future.result();
 }
 
+bool DFMEventDispatcher::isCurrentEventCanceled()
+{
+    return DFMEventDispatcherData::currentEvent && DFMEventDispatcherData::currentEvent->isCanceled();
+}
+
 void DFMEventDispatcher::installEventFilter(DFMAbstractEventHandler *handler)
 {
+    QWriteLocker locker(&DFMEventDispatcherData::lock);
+
     if (!DFMEventDispatcherData::eventFilter.contains(handler)) {
         DFMEventDispatcherData::eventFilter.append(handler);
     }
@@ -185,6 +347,8 @@ void DFMEventDispatcher::installEventFilter(DFMAbstractEventHandler *handler)
 
 void DFMEventDispatcher::removeEventFilter(DFMAbstractEventHandler *handler)
 {
+    QWriteLocker locker(&DFMEventDispatcherData::lock);
+
     DFMEventDispatcherData::eventFilter.removeOne(handler);
 }
 
@@ -203,13 +367,29 @@ DFMEventDispatcher::DFMEventDispatcher()
 
 void DFMEventDispatcher::installEventHandler(DFMAbstractEventHandler *handler)
 {
-    if (!DFMEventDispatcherData::eventHandler.contains(handler))
+    QWriteLocker locker(&DFMEventDispatcherData::lock);
+
+    if (!DFMEventDispatcherData::eventHandler.contains(handler)) {
         DFMEventDispatcherData::eventHandler.append(handler);
+        DFMEventDispatcherData::handlersOfType.clear();
+    }
 }
 
 void DFMEventDispatcher::removeEventHandler(DFMAbstractEventHandler *handler)
 {
+    QWriteLocker locker(&DFMEventDispatcherData::lock);
+
     DFMEventDispatcherData::eventHandler.removeOne(handler);
+    DFMEventDispatcherData::handledTypes.remove(handler);
+    DFMEventDispatcherData::handlersOfType.clear();
+}
+
+void DFMEventDispatcher::setHandledEventTypes(DFMAbstractEventHandler *handler, const QList<int> &types)
+{
+    QWriteLocker locker(&DFMEventDispatcherData::lock);
+
+    DFMEventDispatcherData::handledTypes[handler] = QSet<int>::fromList(types);
+    DFMEventDispatcherData::handlersOfType.clear();
 }
 
 DFM_END_NAMESPACE
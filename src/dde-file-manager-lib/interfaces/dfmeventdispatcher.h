@@ -57,6 +57,14 @@ public:
 
     Q_ENUM(State)
 
+    //! 异步事件的优先级
+    enum Priority {
+        InteractivePriority,    // 用户正在等待的操作
+        NormalPriority,
+        BulkPriority            // 大量文件的后台操作
+    };
+    Q_ENUM(Priority)
+
     static DFMEventDispatcher *instance();
     ~DFMEventDispatcher();
 
@@ -66,7 +74,8 @@ public:
     {
         return processEvent(dMakeEventPointer<T>(std::forward<Args>(args)...));
     }
-    DFMEventFuture processEventAsync(const QSharedPointer<DFMEvent> &event, DFMAbstractEventHandler *target = nullptr);
+    DFMEventFuture processEventAsync(const QSharedPointer<DFMEvent> &event, DFMAbstractEventHandler *target = nullptr,
+                                     Priority priority = NormalPriority);
     template<class T, typename... Args>
     DFMEventFuture processEventAsync(Args&&... args)
     {
@@ -82,6 +91,9 @@ public:
     void installEventFilter(DFMAbstractEventHandler *handler);
     void removeEventFilter(DFMAbstractEventHandler *handler);
 
+    //! 在异步处理的事件中调用，事件的 DFMEventFuture 被取消后返回 true，耗时的处理者应尽早结束
+    static bool isCurrentEventCanceled();
+
     State state() const;
 
 signals:
@@ -95,6 +107,8 @@ private:
 
     void installEventHandler(DFMAbstractEventHandler *handler);
     void removeEventHandler(DFMAbstractEventHandler *handler);
+    //! 处理者只会收到 types 中类型的事件，事件按类型直接找到对应的处理者
+    void setHandledEventTypes(DFMAbstractEventHandler *handler, const QList<int> &types);
 
     friend class DFMAbstractEventHandler;
 
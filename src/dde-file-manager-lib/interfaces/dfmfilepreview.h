@@ -13,6 +13,12 @@ class DUrl;
 
 DFM_BEGIN_NAMESPACE
 
+/*!
+ * \brief DFMFilePreview 文件预览插件的接口
+ *
+ * 插件对象的 "supportPrefetch" 属性为 true 时，预览窗口会在后台为相邻的文件提前创建预览，
+ * 这要求 setFileUrl 能在内容控件还未显示时调用，且不会播放或修改文件。
+ */
 class DFMFilePreview : public QObject
 {
     Q_OBJECT
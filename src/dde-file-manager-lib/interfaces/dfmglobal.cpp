@@ -36,6 +36,7 @@
 #include "drootfilemanager.h"
 #include "plugins/schemepluginmanager.h"
 #include "extensionimpl/dfmextpluginmanager.h"
+#include "dfmstartupprofile.h"
 #include "plugins/pluginemblemmanager.h"
 #include "vault/vaultdbusresponse.h"
 
@@ -69,6 +70,7 @@
 #include <QRegularExpression>
 #include <QPainterPath>
 #include <QMutex>
+#include <QSet>
 #include <QMimeType>
 #include <QMimeDatabase>
 
@@ -102,20 +104,160 @@ extern "C"
 
 #define CURRENT_URL_KEY "uos/remote-copied-files"
 
+/*!
+ * \brief The ClipboardMimeData class 文件管理器写入剪贴板的数据
+ *
+ * 只保存 url 列表，其它程序请求 text/uri-list、text/plain 和 x-special/gnome-copied-files 时才转换为对应的格式。
+ * 本进程是剪贴板的所有者时 QClipboard 返回的就是此对象，直接使用其中的列表，不需要再解析。
+ */
+class ClipboardMimeData : public QMimeData
+{
+public:
+    ClipboardMimeData(const QList<QUrl> &urls, DFMGlobal::ClipboardAction action)
+        : m_urls(urls)
+        , m_action(action)
+    {
+
+    }
+
+    QList<QUrl> fileUrls() const
+    {
+        return m_urls;
+    }
+
+    DFMGlobal::ClipboardAction action() const
+    {
+        return m_action;
+    }
+
+    QStringList formats() const override
+    {
+        QStringList list = QMimeData::formats();
+
+        for (const QString &format : deferredFormats()) {
+            if (!list.contains(format))
+                list << format;
+        }
+
+        return list;
+    }
+
+    bool hasFormat(const QString &mimeType) const override
+    {
+        return deferredFormats().contains(mimeType) || QMimeData::hasFormat(mimeType);
+    }
+
+protected:
+    QVariant retrieveData(const QString &mimeType, QVariant::Type type) const override
+    {
+        if (mimeType == "text/uri-list") {
+            // QMimeData::urls() 请求列表，直接返回，其它程序请求时才生成文本
+            if (type == QVariant::List) {
+                QVariantList list;
+
+                list.reserve(m_urls.size());
+
+                for (const QUrl &url : m_urls)
+                    list << url;
+
+                return list;
+            }
+
+            if (m_uriList.isEmpty()) {
+                for (const QUrl &url : m_urls)
+                    m_uriList.append(url.toEncoded()).append("\r\n");
+            }
+
+            return m_uriList;
+        }
+
+        if (mimeType == "text/plain") {
+            if (m_text.isNull()) {
+                QStringList paths;
+
+                for (const QUrl &url : m_urls) {
+                    const QString &path = url.toLocalFile();
+
+                    if (!path.isEmpty())
+                        paths << path;
+                }
+
+                m_text = paths.join('\n');
+            }
+
+            return m_text;
+        }
+
+        if (mimeType == "x-special/gnome-copied-files") {
+            if (m_copiedFiles.isEmpty()) {
+                m_copiedFiles = (m_action == DFMGlobal::CutAction) ? "cut" : "copy";
+
+                for (const QUrl &url : m_urls)
+                    m_copiedFiles.append("\n").append(url.toString().toUtf8());
+            }
+
+            return m_copiedFiles;
+        }
+
+        return QMimeData::retrieveData(mimeType, type);
+    }
+
+private:
+    static QStringList deferredFormats()
+    {
+        return QStringList {"text/uri-list", "text/plain", "x-special/gnome-copied-files"};
+    }
+
+    QList<QUrl> m_urls;
+    DFMGlobal::ClipboardAction m_action;
+    mutable QByteArray m_uriList;
+    mutable QString m_text;
+    mutable QByteArray m_copiedFiles;
+};
+
 namespace GlobalData {
 static QList<QUrl> clipboardFileUrls;
 static QMutex clipboardFileUrlsMutex;
 static QList<quint64> clipbordFileinode;
+// 剪贴板中文件的哈希表和 inode 在第一次查询时才生成，剪贴板中有大量文件时其变化不再逐个查询文件
+static QSet<QUrl> clipboardFileUrlSet;
+static QSet<quint64> clipboardFileInodeSet;
+static bool clipboardFilesIndexed = false;
 static QAtomicInt remoteCurrentCount = 0;
 static DFMGlobal::ClipboardAction clipboardAction = DFMGlobal::UnknowAction;
 
+// 调用时需持有 clipboardFileUrlsMutex
+void indexClipboardFiles()
+{
+    if (clipboardFilesIndexed)
+        return;
+
+    clipboardFilesIndexed = true;
+    clipboardFileUrlSet.reserve(clipboardFileUrls.size());
+
+    for (const QUrl &url : clipboardFileUrls) {
+        clipboardFileUrlSet.insert(url);
+
+        //链接文件的inode不加入clipbordFileinode，只用url判断clip，避免多个同源链接文件的逻辑误判
+        struct stat statInfo;
+        if (lstat(url.path().toLocal8Bit().constData(), &statInfo) != 0 || S_ISLNK(statInfo.st_mode))
+            continue;
+
+        clipbordFileinode << statInfo.st_ino;
+        clipboardFileInodeSet.insert(statInfo.st_ino);
+    }
+}
+
 void onClipboardDataChanged()
 {
     {
         QMutexLocker lk(&clipboardFileUrlsMutex);
         clipboardFileUrls.clear();
+        clipbordFileinode.clear();
+        clipboardFileUrlSet.clear();
+        clipboardFileInodeSet.clear();
+        clipboardFilesIndexed = false;
     }
-    clipbordFileinode.clear();
     const QMimeData *mimeData = qApp->clipboard()->mimeData();
     if (!mimeData || mimeData->formats().isEmpty()) {
         qWarning() << "get null mimeData from QClipBoard or remote formats is null!";
@@ -133,6 +275,15 @@ void onClipboardDataChanged()
         clipboardAction = DFMGlobal::RemoteCopiedAction;
         return;
     }
+    // 本进程写入的数据直接使用其中的列表
+    if (const ClipboardMimeData *data = dynamic_cast<const ClipboardMimeData *>(mimeData)) {
+        clipboardAction = data->action();
+
+        QMutexLocker lk(&clipboardFileUrlsMutex);
+        clipboardFileUrls = data->fileUrls();
+        return;
+    }
+
     const QByteArray &data = mimeData->data("x-special/gnome-copied-files");
 
     if (data.startsWith("cut")) {
@@ -143,23 +294,15 @@ void onClipboardDataChanged()
         clipboardAction = DFMGlobal::UnknowAction;
     }
 
-    for (QUrl &_url : mimeData->urls()) {
+    QList<QUrl> urls = mimeData->urls();
+
+    for (QUrl &_url : urls) {
         if (_url.scheme().isEmpty())
             _url.setScheme("file");
-        {
-            QMutexLocker lk(&clipboardFileUrlsMutex);
-            clipboardFileUrls << _url;
-        }
-        //链接文件的inode不加入clipbordFileinode，只用url判断clip，避免多个同源链接文件的逻辑误判
-        const DAbstractFileInfoPointer &fileInfo = DFileService::instance()->createFileInfo(nullptr, DUrl(_url));
-        if (!fileInfo || fileInfo->isSymLink())
-            continue;
-
-        struct stat statInfo;
-        int fileStat = stat(_url.path().toStdString().c_str(), &statInfo);
-        if (0 == fileStat)
-            clipbordFileinode << statInfo.st_ino;
     }
+
+    QMutexLocker lk(&clipboardFileUrlsMutex);
+    clipboardFileUrls = urls;
 }
 
 class DFMGlobalPrivate : public DFMGlobal {};
@@ -218,8 +361,11 @@ void DFMGlobal::setUrlsToClipboard(const QList<QUrl> &list, DFMGlobal::Clipboard
     if (action == UnknowAction)
         return;
 
+    // 没有附加的数据时，url 列表的各种格式在被请求时才生成
+    const bool deferred = !mimeData;
+
     if (!mimeData)
-        mimeData = new QMimeData;
+        mimeData = new ClipboardMimeData(list, action);
 
     QByteArray ba = (action == DFMGlobal::CutAction) ? "cut" : "copy";
     QString text;
@@ -228,11 +374,22 @@ void DFMGlobal::setUrlsToClipboard(const QList<QUrl> &list, DFMGlobal::Clipboard
 
     int maxIconsNum = 3;
     for (const QUrl &qurl : list) {
-        ba.append("\n");
-        ba.append(qurl.toString());
+        // 延迟生成时只需要前几个文件的图标
+        if (deferred && maxIconsNum <= 0)
+            break;
+
+        if (!deferred) {
+            ba.append("\n");
+            ba.append(qurl.toString());
+        }
 
         const QString &path = qurl.toLocalFile();
-        const DAbstractFileInfoPointer &info = DFileService::instance()->createFileInfo(nullptr, DUrl(qurl));
+        const DAbstractFileInfoPointer &info = maxIconsNum > 0 ? DFileService::instance()->createFileInfo(nullptr, DUrl(qurl))
+                                                               : DAbstractFileInfoPointer();
+
+        if (!path.isEmpty() && !deferred) {
+            text += path + '\n';
+        }
 
         if (!info)
             continue;
@@ -263,16 +420,14 @@ void DFMGlobal::setUrlsToClipboard(const QList<QUrl> &list, DFMGlobal::Clipboard
             }
             stream << iconList << icon;
         }
-
-        if (!path.isEmpty()) {
-            text += path + '\n';
-        }
     }
 
-    mimeData->setText(text.endsWith('\n') ? text.left(text.length() - 1) : text);
-    mimeData->setData("x-special/gnome-copied-files", ba);
+    if (!deferred) {
+        mimeData->setText(text.endsWith('\n') ? text.left(text.length() - 1) : text);
+        mimeData->setData("x-special/gnome-copied-files", ba);
+        mimeData->setUrls(list);
+    }
     mimeData->setData("x-dfm-copied/file-icons", iconBa);
-    mimeData->setUrls(list);
     // fix bug 63441
     // 如果是剪切操作，则禁止跨用户的粘贴操作
     if (DFMGlobal::CutAction == action) {
@@ -307,6 +462,9 @@ const QList<QUrl> DFMGlobal::fetchUrlsFromClipboard()
 {
     if (qApp->clipboard()) {
         const QMimeData *mimeData = qApp->clipboard()->mimeData();
+        if (const ClipboardMimeData *data = dynamic_cast<const ClipboardMimeData *>(mimeData)) {
+            return data->fileUrls();
+        }
         if (mimeData) {
             return mimeData->urls();
         }
@@ -319,6 +477,9 @@ DFMGlobal::ClipboardAction DFMGlobal::fetchClipboardAction()
 {
     if (qApp->clipboard()) {
         const QMimeData *mimeData = qApp->clipboard()->mimeData();
+        if (const ClipboardMimeData *data = dynamic_cast<const ClipboardMimeData *>(mimeData)) {
+            return data->action();
+        }
         if (mimeData) {
             QByteArray ba = mimeData->data("x-special/gnome-copied-files");
             QString tStr(ba);
@@ -677,9 +838,28 @@ QList<QUrl> DFMGlobal::clipboardFileUrlList() const
 
 QList<quint64> DFMGlobal::clipboardFileInodeList() const
 {
+    QMutexLocker lk(&GlobalData::clipboardFileUrlsMutex);
+    GlobalData::indexClipboardFiles();
+
     return  GlobalData::clipbordFileinode;
 }
 
+bool DFMGlobal::isClipboardFile(const QUrl &url) const
+{
+    QMutexLocker lk(&GlobalData::clipboardFileUrlsMutex);
+    GlobalData::indexClipboardFiles();
+
+    return GlobalData::clipboardFileUrlSet.contains(url);
+}
+
+bool DFMGlobal::isClipboardFileInode(quint64 inode) const
+{
+    QMutexLocker lk(&GlobalData::clipboardFileUrlsMutex);
+    GlobalData::indexClipboardFiles();
+
+    return GlobalData::clipboardFileInodeSet.contains(inode);
+}
+
 DFMGlobal::ClipboardAction DFMGlobal::clipboardAction() const
 {
     return GlobalData::clipboardAction;
@@ -1225,6 +1405,7 @@ bool DFMGlobal::autoInitExtPluginManager()
     if (!mutex.tryLock())
         return false;
 
+    const qint64 beginTime = DFMStartupProfile::elapsed();
 
     if (DFMExtPluginManager::instance().state() == DFMExtPluginManager::State::Invalid) {
         qInfo() << "extPluginPath:" << DFMExtPluginManager::instance().pluginPaths();
@@ -1244,6 +1425,7 @@ bool DFMGlobal::autoInitExtPluginManager()
 
     if (DFMExtPluginManager::instance().state() == DFMExtPluginManager::State::Initialized) {
         qInfo() << "extPlugin initialization has been successful!";
+        DFMStartupProfile::record("extensionPlugins", beginTime);
         mutex.unlock();
         return true;
     }
@@ -91,6 +91,15 @@
 #define ASYN_CALL_SLOT(obj, fun, args...) \
     TIMER_SINGLESHOT_CONNECT_TYPE(obj, 0, {obj->fun(args);}, Qt::QueuedConnection, obj, args)
 
+// 热点循环中（逐个文件处理时）的日志，release 构建中在编译时去掉，需要时可定义 DFM_HOT_PATH_LOG 保留
+#if defined(QT_NO_DEBUG) && !defined(DFM_HOT_PATH_LOG)
+#define dfmHotDebug QT_NO_QDEBUG_MACRO
+#define dfmHotInfo QT_NO_QDEBUG_MACRO
+#else
+#define dfmHotDebug qDebug
+#define dfmHotInfo qInfo
+#endif
+
 #ifdef QT_STRINGIFY
 #undef QT_STRINGIFY
 #endif
@@ -331,6 +340,8 @@ public:
 
     QList<QUrl> clipboardFileUrlList() const;
     QList<quint64> clipboardFileInodeList() const;
+    bool isClipboardFile(const QUrl &url) const;
+    bool isClipboardFileInode(quint64 inode) const;
     ClipboardAction clipboardAction() const;
     QIcon standardIcon(Icon iconType) const;
 
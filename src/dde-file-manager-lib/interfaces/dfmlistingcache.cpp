@@ -0,0 +1,205 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dfmlistingcache.h"
+#include "dgvfsfileinfo.h"
+#include "dstorageinfo.h"
+#include "dfmstandardpaths.h"
+#include "shutil/fileutils.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QDebug>
+#include <QMutex>
+#include <QDataStream>
+#include <QSaveFile>
+#include <QCryptographicHash>
+#include <QRegularExpression>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+DFM_USE_NAMESPACE
+
+#define LISTING_CACHE_VERSION 1
+// 缓存文件数量上限，超出时删除最久未更新的
+#define LISTING_CACHE_MAX_COUNT 200
+// 文件过多的目录不缓存
+#define LISTING_CACHE_MAX_FILE_COUNT 50000
+
+static QString listingCacheDir()
+{
+    return DFMStandardPaths::location(DFMStandardPaths::CachePath) + "/listing";
+}
+
+/*!
+ * \brief DFMListingCache::canCache 只缓存低速设备上遍历结果为DGvfsFileInfo的目录
+ */
+bool DFMListingCache::canCache(const DUrl &dirUrl)
+{
+    if (!dirUrl.isLocalFile())
+        return false;
+
+    const QString &path = dirUrl.toLocalFile();
+
+    return DStorageInfo::isLowSpeedDevice(path) && FileUtils::isGvfsMountFile(path, true);
+}
+
+/*!
+ * \brief DFMListingCache::cacheKey 挂载设备标识加上目录在设备内的路径，重新挂载后不变
+ */
+QString DFMListingCache::cacheKey(const DUrl &dirUrl)
+{
+    const QString &path = dirUrl.toLocalFile();
+    const QRegularExpression regExp("^/run/user/\\d+/gvfs/(?<mount>[^/]+)(?<path>.*)$");
+    const QRegularExpressionMatch &match = regExp.match(path);
+
+    QString mount;
+    QString subPath;
+
+    if (match.hasMatch()) {
+        // gvfs的挂载目录名包含协议、主机和共享名，如 smb-share:server=host,share=docs
+        mount = match.captured("mount");
+        subPath = match.captured("path");
+    } else {
+        const DStorageInfo info(path);
+
+        mount = QString::fromLocal8Bit(info.device());
+        subPath = path.mid(info.rootPath().length());
+    }
+
+    while (subPath.endsWith(QDir::separator()))
+        subPath.chop(1);
+
+    if (!subPath.startsWith(QDir::separator()))
+        subPath.prepend(QDir::separator());
+
+    return mount + subPath;
+}
+
+/*!
+ * \brief DFMListingCache::load 读取缓存的文件列表，创建文件信息时不访问设备
+ * \param filters 缓存必须以相同的过滤条件生成
+ * \return 没有可用的缓存时返回false
+ */
+bool DFMListingCache::load(const DUrl &dirUrl, QDir::Filters filters, QList<DAbstractFileInfoPointer> *infoList)
+{
+    const QString &key = cacheKey(dirUrl);
+    QFile file(cacheFilePath(key));
+
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&file);
+    int version = 0;
+
+    in >> version;
+
+    if (version != LISTING_CACHE_VERSION)
+        return false;
+
+    QString fileKey;
+    int fileFilters = 0;
+    int count = 0;
+
+    in >> fileKey >> fileFilters >> count;
+
+    // 缓存文件名是key的哈希值，需要确认是同一个目录
+    if (in.status() != QDataStream::Ok || fileKey != key || QDir::Filters(QFlag(fileFilters)) != filters
+            || count < 0 || count > LISTING_CACHE_MAX_FILE_COUNT)
+        return false;
+
+    const QString &dirPath = dirUrl.toLocalFile();
+    QList<DAbstractFileInfoPointer> list;
+
+    list.reserve(count);
+
+    for (int i = 0; i < count; ++i) {
+        QString fileName;
+
+        in >> fileName;
+
+        DAbstractFileInfoPointer info(new DGvfsFileInfo(DUrl::fromLocalFile(dirPath + QDir::separator() + fileName), in));
+
+        if (in.status() != QDataStream::Ok) {
+            qWarning() << "Failed on read the listing cache:" << file.fileName();
+            return false;
+        }
+
+        list << info;
+    }
+
+    if (infoList)
+        *infoList = list;
+
+    return true;
+}
+
+/*!
+ * \brief DFMListingCache::save 在调用线程中序列化文件列表，在线程池中写入文件
+ */
+void DFMListingCache::save(const DUrl &dirUrl, QDir::Filters filters, const QList<DAbstractFileInfoPointer> &infoList)
+{
+    if (infoList.size() > LISTING_CACHE_MAX_FILE_COUNT) {
+        remove(dirUrl);
+        return;
+    }
+
+    // 只有DGvfsFileInfo能够不访问设备而恢复，其它类型的文件（如desktop文件）在重新遍历后再显示
+    QList<const DGvfsFileInfo *> gvfsInfoList;
+
+    gvfsInfoList.reserve(infoList.size());
+
+    for (const DAbstractFileInfoPointer &info : infoList) {
+        if (const DGvfsFileInfo *gvfsInfo = dynamic_cast<const DGvfsFileInfo *>(info.constData()))
+            gvfsInfoList << gvfsInfo;
+    }
+
+    const QString &key = cacheKey(dirUrl);
+    QByteArray data;
+    QDataStream out(&data, QIODevice::WriteOnly);
+
+    out << int(LISTING_CACHE_VERSION) << key << int(filters) << gvfsInfoList.size();
+
+    for (const DGvfsFileInfo *gvfsInfo : gvfsInfoList) {
+        out << gvfsInfo->fileName();
+        gvfsInfo->saveCaches(out);
+    }
+
+    const QString &filePath = cacheFilePath(key);
+
+    QtConcurrent::run(QThreadPool::globalInstance(), [filePath, data] {
+        QDir().mkpath(QFileInfo(filePath).absolutePath());
+
+        QSaveFile file(filePath);
+        if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit()) {
+            qWarning() << "Failed on save the listing cache:" << file.fileName() << file.errorString();
+            return;
+        }
+
+        pruneCacheFiles();
+    });
+}
+
+void DFMListingCache::remove(const DUrl &dirUrl)
+{
+    QFile::remove(cacheFilePath(cacheKey(dirUrl)));
+}
+
+QString DFMListingCache::cacheFilePath(const QString &key)
+{
+    return listingCacheDir() + QDir::separator() + QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Md5).toHex();
+}
+
+void DFMListingCache::pruneCacheFiles()
+{
+    static QMutex mutex;
+    QMutexLocker locker(&mutex);
+
+    const QFileInfoList &fileList = QDir(listingCacheDir()).entryInfoList(QDir::Files, QDir::Time);
+
+    // 按修改时间从新到旧排列
+    for (int i = LISTING_CACHE_MAX_COUNT; i < fileList.size(); ++i) {
+        QFile::remove(fileList.at(i).absoluteFilePath());
+    }
+}
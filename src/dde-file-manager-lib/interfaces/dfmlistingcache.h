@@ -0,0 +1,33 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DFMLISTINGCACHE_H
+#define DFMLISTINGCACHE_H
+
+#include "dabstractfileinfo.h"
+
+#include <QDir>
+
+/*!
+ * \brief DFMListingCache 低速设备（smb、mtp等）目录列表的持久化缓存
+ *
+ * 目录遍历完成后将文件列表及其属性保存到磁盘，按挂载设备和设备内的路径区分。
+ * 再次打开目录时先显示缓存的列表，同时在后台重新遍历，完成后用结果更新列表。
+ */
+class DFMListingCache
+{
+public:
+    static bool canCache(const DUrl &dirUrl);
+    static QString cacheKey(const DUrl &dirUrl);
+
+    static bool load(const DUrl &dirUrl, QDir::Filters filters, QList<DAbstractFileInfoPointer> *infoList);
+    static void save(const DUrl &dirUrl, QDir::Filters filters, const QList<DAbstractFileInfoPointer> &infoList);
+    static void remove(const DUrl &dirUrl);
+
+private:
+    static QString cacheFilePath(const QString &key);
+    static void pruneCacheFiles();
+};
+
+#endif // DFMLISTINGCACHE_H
@@ -0,0 +1,221 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dfmmemoryaccounting.h"
+#include "dfmmetrics.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QMutex>
+#include <QTimer>
+#include <QDebug>
+
+#include <algorithm>
+
+#include <unistd.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+// 检查常驻内存是否超过软上限的间隔（毫秒）
+#define MEMORY_CHECK_INTERVAL 30000
+// 各类对象的估算大小（字节），包含其私有数据和常用的缓存字段
+#define FILE_INFO_ESTIMATED_SIZE 1024
+#define MODEL_NODE_ESTIMATED_SIZE 256
+#define SEARCH_RESULT_ESTIMATED_SIZE 320
+
+namespace {
+struct Subsystem
+{
+    QString name;
+    DFMMemoryAccounting::Estimator estimator;
+    DFMMemoryAccounting::Trimmer trimmer;
+};
+
+class MemoryRegistry
+{
+public:
+    MemoryRegistry()
+    {
+        // 没有独立缓存的对象按存活数量估算，数量由各自的构造和析构函数维护
+        addCounter("fileInfo", "fileInfo.count", FILE_INFO_ESTIMATED_SIZE);
+        addCounter("modelNodes", "model.nodes", MODEL_NODE_ESTIMATED_SIZE);
+        addCounter("searchResults", "search.results", SEARCH_RESULT_ESTIMATED_SIZE);
+    }
+
+    void add(const Subsystem &subsystem)
+    {
+        QMutexLocker locker(&mutex);
+
+        subsystems << subsystem;
+    }
+
+    QList<Subsystem> all()
+    {
+        QMutexLocker locker(&mutex);
+
+        return subsystems;
+    }
+
+    QMutex mutex;
+    QList<Subsystem> subsystems;
+    qint64 softLimit = 0;
+    QTimer *timer = nullptr;
+
+private:
+    void addCounter(const QString &name, const char *counterName, qint64 size)
+    {
+        DFMMetrics::Counter *counter = DFMMetrics::counter(counterName);
+        Subsystem subsystem;
+
+        subsystem.name = name;
+        subsystem.estimator = [counter, size] {
+            return qMax<qint64>(0, counter->load()) * size;
+        };
+        subsystems << subsystem;
+    }
+};
+
+MemoryRegistry *memoryRegistry()
+{
+    // 不释放，注册的估算函数可能在程序退出时仍被调用
+    static MemoryRegistry *registry = new MemoryRegistry();
+
+    return registry;
+}
+} // namespace
+
+/*!
+ * \brief DFMMemoryAccounting::registerSubsystem 注册子系统，同名的子系统会分别统计
+ * \param trimmer 为空时表示此子系统不能被清理
+ */
+void DFMMemoryAccounting::registerSubsystem(const QString &name, const Estimator &estimator, const Trimmer &trimmer)
+{
+    Subsystem subsystem;
+
+    subsystem.name = name;
+    subsystem.estimator = estimator;
+    subsystem.trimmer = trimmer;
+    memoryRegistry()->add(subsystem);
+}
+
+/*!
+ * \brief DFMMemoryAccounting::usage 各子系统的估算占用、合计值和常驻内存，单位均为字节
+ */
+QVariantMap DFMMemoryAccounting::usage()
+{
+    QVariantMap map;
+    qint64 total = 0;
+
+    // 不在锁内调用估算函数，避免与子系统自身的锁嵌套
+    for (const Subsystem &subsystem : memoryRegistry()->all()) {
+        const qint64 bytes = subsystem.estimator();
+
+        map[subsystem.name] = map.value(subsystem.name).toLongLong() + bytes;
+        total += bytes;
+    }
+
+    map["total"] = total;
+    map["rss"] = residentSize();
+    map["softLimit"] = softLimit();
+
+    return map;
+}
+
+/*!
+ * \brief DFMMemoryAccounting::residentSize 进程当前的常驻内存（字节），读取失败时返回 -1
+ */
+qint64 DFMMemoryAccounting::residentSize()
+{
+    QFile file("/proc/self/statm");
+
+    if (!file.open(QIODevice::ReadOnly))
+        return -1;
+
+    // 第二个字段为常驻的页数
+    const QList<QByteArray> &fields = file.readAll().simplified().split(' ');
+
+    if (fields.size() < 2)
+        return -1;
+
+    return fields.at(1).toLongLong() * sysconf(_SC_PAGESIZE);
+}
+
+/*!
+ * \brief DFMMemoryAccounting::setSoftLimit 设置常驻内存的软上限，小于等于0时不限制，必须在主线程中调用
+ */
+void DFMMemoryAccounting::setSoftLimit(qint64 bytes)
+{
+    MemoryRegistry *registry = memoryRegistry();
+
+    registry->softLimit = bytes;
+
+    if (bytes <= 0) {
+        if (registry->timer)
+            registry->timer->stop();
+
+        return;
+    }
+
+    if (!registry->timer) {
+        registry->timer = new QTimer(qApp);
+        registry->timer->setInterval(MEMORY_CHECK_INTERVAL);
+        QObject::connect(registry->timer, &QTimer::timeout, [] {
+            DFMMemoryAccounting::trim();
+        });
+    }
+
+    registry->timer->start();
+}
+
+qint64 DFMMemoryAccounting::softLimit()
+{
+    return memoryRegistry()->softLimit;
+}
+
+/*!
+ * \brief DFMMemoryAccounting::trim 常驻内存超过软上限时从占用最大的子系统开始清理，直到回落到上限以下
+ * \param force 为 true 时不检查上限，清理所有子系统
+ * \return 清理的子系统个数
+ */
+int DFMMemoryAccounting::trim(bool force)
+{
+    const qint64 limit = softLimit();
+    const qint64 rss = residentSize();
+
+    if (!force && (limit <= 0 || rss <= limit))
+        return 0;
+
+    QList<QPair<qint64, Trimmer>> trimmers;
+
+    for (const Subsystem &subsystem : memoryRegistry()->all()) {
+        if (subsystem.trimmer)
+            trimmers << qMakePair(subsystem.estimator(), subsystem.trimmer);
+    }
+
+    std::stable_sort(trimmers.begin(), trimmers.end(), [](const QPair<qint64, Trimmer> &a, const QPair<qint64, Trimmer> &b) {
+        return a.first > b.first;
+    });
+
+    int count = 0;
+
+    for (const auto &trimmer : trimmers) {
+        if (trimmer.first <= 0)
+            break;
+
+        trimmer.second();
+        ++count;
+#ifdef __GLIBC__
+        // 把释放的内存还给系统，否则常驻内存不会下降
+        malloc_trim(0);
+#endif
+
+        if (!force && residentSize() <= limit)
+            break;
+    }
+
+    qInfo() << "memory trimmed: rss" << rss << "limit" << limit << "subsystems" << count << "rss now" << residentSize();
+
+    return count;
+}
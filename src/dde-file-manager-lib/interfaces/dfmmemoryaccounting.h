@@ -0,0 +1,41 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DFMMEMORYACCOUNTING_H
+#define DFMMEMORYACCOUNTING_H
+
+#include <QString>
+#include <QVariantMap>
+
+#include <functional>
+
+/*!
+ * \brief DFMMemoryAccounting 按子系统统计内存占用，常驻内存超过软上限时清空缓存
+ *
+ * 各缓存在创建时注册一个估算函数（返回当前大约占用的字节数）和一个可选的清理函数。usage 返回
+ * 每个子系统的估算值以及进程当前的常驻内存，可以通过 DFMMetrics::snapshot 导出，用于发现持续增长的子系统。
+ * 设置软上限后定时检查常驻内存，超过时按估算值从大到小调用清理函数，直到回落到上限以下。
+ * \code
+ * DFMMemoryAccounting::registerSubsystem("thumbnail", [d] { return d->cacheCost() * 1024; },
+ *                                        [d] { d->clearCache(); });
+ * \endcode
+ * 估算函数和清理函数都在主线程中调用，需要自行保证线程安全。
+ */
+class DFMMemoryAccounting
+{
+public:
+    typedef std::function<qint64()> Estimator;
+    typedef std::function<void()> Trimmer;
+
+    static void registerSubsystem(const QString &name, const Estimator &estimator, const Trimmer &trimmer = Trimmer());
+
+    static QVariantMap usage();
+    static qint64 residentSize();
+
+    static void setSoftLimit(qint64 bytes);
+    static qint64 softLimit();
+    static int trim(bool force = false);
+};
+
+#endif // DFMMEMORYACCOUNTING_H
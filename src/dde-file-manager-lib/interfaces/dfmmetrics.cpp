@@ -0,0 +1,77 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dfmmetrics.h"
+#include "dfmmemoryaccounting.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QThreadPool>
+
+namespace {
+class MetricsRegistry
+{
+public:
+    DFMMetrics::Counter *counter(const char *name)
+    {
+        QMutexLocker locker(&mutex);
+        DFMMetrics::Counter *&counter = counters[QByteArray(name)];
+
+        if (!counter)
+            counter = new DFMMetrics::Counter(0);
+
+        return counter;
+    }
+
+    QVariantMap snapshot()
+    {
+        QMutexLocker locker(&mutex);
+        QVariantMap map;
+
+        for (auto it = counters.constBegin(); it != counters.constEnd(); ++it)
+            map[QString::fromLatin1(it.key())] = static_cast<qlonglong>(it.value()->load());
+
+        return map;
+    }
+
+private:
+    QMutex mutex;
+    QHash<QByteArray, DFMMetrics::Counter *> counters;
+};
+
+MetricsRegistry *metricsRegistry()
+{
+    // 不释放，埋点中的局部静态变量保存着计数器的指针，程序退出时仍可能被访问
+    static MetricsRegistry *registry = new MetricsRegistry();
+
+    return registry;
+}
+} // namespace
+
+/*!
+ * \brief DFMMetrics::counter 获取名称对应的计数器，不存在时创建，返回的指针一直有效
+ */
+DFMMetrics::Counter *DFMMetrics::counter(const char *name)
+{
+    return metricsRegistry()->counter(name);
+}
+
+/*!
+ * \brief DFMMetrics::snapshot 所有计数器的当前值，另外附带全局线程池的使用情况和各子系统的内存占用
+ */
+QVariantMap DFMMetrics::snapshot()
+{
+    QVariantMap map = metricsRegistry()->snapshot();
+    QThreadPool *pool = QThreadPool::globalInstance();
+
+    map["threadPool.active"] = pool->activeThreadCount();
+    map["threadPool.max"] = pool->maxThreadCount();
+
+    const QVariantMap &memory = DFMMemoryAccounting::usage();
+
+    for (auto it = memory.constBegin(); it != memory.constEnd(); ++it)
+        map["memory." + it.key()] = it.value();
+
+    return map;
+}
@@ -0,0 +1,42 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DFMMETRICS_H
+#define DFMMETRICS_H
+
+#include <QAtomicInteger>
+#include <QVariantMap>
+
+/*!
+ * \brief DFMMetrics 运行时的性能计数器，用于监控缓存命中率、队列长度、文件监视器数量和拷贝吞吐量等
+ *
+ * 每个计数器是一个按名称注册的原子整数，注册后不会释放。埋点宏在第一次执行时查找计数器并保存在
+ * 局部静态变量中，之后只是一次 relaxed 原子操作。snapshot 返回所有计数器的当前值，dde-desktop
+ * 通过 DBus 接口的 GetMetrics 导出。
+ * \code
+ * if (cache.contains(key)) {
+ *     DFM_METRIC_INC("mime.cacheHit");
+ *     ...
+ * }
+ * \endcode
+ * 名称使用 "模块.名称" 的形式，命中率等比值由采集端根据计数计算。
+ */
+class DFMMetrics
+{
+public:
+    typedef QAtomicInteger<qint64> Counter;
+
+    static Counter *counter(const char *name);
+    static QVariantMap snapshot();
+};
+
+// 计数器增加 value，用于累计值（如命中次数）和可增减的数量（如监视器个数）
+#define DFM_METRIC_ADD(name, value) \
+    do { static DFMMetrics::Counter *dfmMetricCounter = DFMMetrics::counter(name); dfmMetricCounter->fetchAndAddRelaxed(value); } while (false)
+#define DFM_METRIC_INC(name) DFM_METRIC_ADD(name, 1)
+// 计数器设置为当前值，用于队列长度等
+#define DFM_METRIC_SET(name, value) \
+    do { static DFMMetrics::Counter *dfmMetricCounter = DFMMetrics::counter(name); dfmMetricCounter->store(value); } while (false)
+
+#endif // DFMMETRICS_H
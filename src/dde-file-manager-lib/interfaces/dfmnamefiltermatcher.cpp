@@ -0,0 +1,147 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dfmnamefiltermatcher.h"
+
+static bool hasWildcard(const QString &text)
+{
+    for (const QChar &c : text) {
+        if (c == '*' || c == '?' || c == '[')
+            return true;
+    }
+
+    return false;
+}
+
+DFMNameFilterMatcher::DFMNameFilterMatcher()
+{
+
+}
+
+DFMNameFilterMatcher::DFMNameFilterMatcher(const QStringList &patterns, Qt::CaseSensitivity cs)
+    : m_empty(patterns.isEmpty())
+    , m_caseSensitivity(cs)
+{
+    QStringList others;
+
+    for (const QString &pattern : patterns) {
+        if (pattern == "*") {
+            m_matchAll = true;
+        } else if (pattern.startsWith("*.") && !hasWildcard(pattern.mid(2))) {
+            m_suffixes << (cs == Qt::CaseInsensitive ? pattern.mid(2).toLower() : pattern.mid(2));
+        } else if (!hasWildcard(pattern)) {
+            m_names << (cs == Qt::CaseInsensitive ? pattern.toLower() : pattern);
+        } else {
+            const QString &rx = wildcardToRegularExpression(pattern);
+
+            if (!rx.isEmpty())
+                others << rx;
+        }
+    }
+
+    if (!others.isEmpty()) {
+        QRegularExpression::PatternOptions options = QRegularExpression::DotMatchesEverythingOption;
+
+        if (cs == Qt::CaseInsensitive)
+            options |= QRegularExpression::CaseInsensitiveOption;
+
+        m_regExp.setPattern("\\A(?:" + others.join('|') + ")\\z");
+        m_regExp.setPatternOptions(options);
+        m_regExp.optimize();
+    }
+}
+
+bool DFMNameFilterMatcher::isEmpty() const
+{
+    return m_empty;
+}
+
+/*!
+ * \brief DFMNameFilterMatcher::matches 文件名是否匹配任意一条规则，没有规则时总是匹配
+ */
+bool DFMNameFilterMatcher::matches(const QString &name) const
+{
+    if (m_empty || m_matchAll)
+        return true;
+
+    if (!m_suffixes.isEmpty() || !m_names.isEmpty()) {
+        const QString &key = m_caseSensitivity == Qt::CaseInsensitive ? name.toLower() : name;
+
+        if (m_names.contains(key))
+            return true;
+
+        // "*" 可以匹配包含点号的任意字符，所以每个点号之后的部分都可能是规则中的后缀
+        if (!m_suffixes.isEmpty()) {
+            for (int i = key.indexOf('.'); i >= 0; i = key.indexOf('.', i + 1)) {
+                if (m_suffixes.contains(key.mid(i + 1)))
+                    return true;
+            }
+        }
+    }
+
+    return !m_regExp.pattern().isEmpty() && m_regExp.match(name).hasMatch();
+}
+
+/*!
+ * \brief DFMNameFilterMatcher::wildcardToRegularExpression 按 QRegExp::Wildcard 的语义把通配符转换为正则表达式
+ *
+ * 反斜杠不是转义字符；[!...] 表示不在集合中的字符，[^...] 中的 ^ 是普通字符。
+ * 规则无效时返回空字符串。
+ */
+QString DFMNameFilterMatcher::wildcardToRegularExpression(const QString &pattern)
+{
+    QString rx;
+    const int size = pattern.size();
+
+    for (int i = 0; i < size; ++i) {
+        const QChar &c = pattern.at(i);
+
+        if (c == '*') {
+            rx += ".*";
+        } else if (c == '?') {
+            rx += '.';
+        } else if (c == '[') {
+            int j = i + 1;
+
+            if (j < size && pattern.at(j) == '!')
+                ++j;
+
+            // 紧跟在 [ 之后的 ] 是集合中的字符
+            if (j < size && pattern.at(j) == ']')
+                ++j;
+
+            while (j < size && pattern.at(j) != ']')
+                ++j;
+
+            // 与 QRegExp 相同，没有闭合的 [ 使整条规则无效
+            if (j >= size)
+                return QString();
+
+            int k = i + 1;
+
+            rx += '[';
+
+            if (pattern.at(k) == '!') {
+                rx += '^';
+                ++k;
+            }
+
+            for (; k < j; ++k) {
+                const QChar &s = pattern.at(k);
+
+                if (s == '\\' || s == '[' || s == ']' || s == '^')
+                    rx += '\\';
+
+                rx += s;
+            }
+
+            rx += ']';
+            i = j;
+        } else {
+            rx += QRegularExpression::escape(QString(c));
+        }
+    }
+
+    return rx;
+}
@@ -0,0 +1,41 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DFMNAMEFILTERMATCHER_H
+#define DFMNAMEFILTERMATCHER_H
+
+#include <QString>
+#include <QStringList>
+#include <QSet>
+#include <QRegularExpression>
+
+/*!
+ * \brief DFMNameFilterMatcher 预先编译的文件名通配符过滤规则
+ *
+ * 规则与 QRegExp::Wildcard 的语义相同（整个文件名匹配，支持 *、? 和 [...]）。
+ * 最常见的 "*.jpg" 这类后缀规则和不含通配符的规则放入哈希表中查找，
+ * 其余规则合并为一个正则表达式，匹配一个文件名只需遍历一次文件名中的点号和执行一次正则匹配。
+ */
+class DFMNameFilterMatcher
+{
+public:
+    DFMNameFilterMatcher();
+    explicit DFMNameFilterMatcher(const QStringList &patterns, Qt::CaseSensitivity cs = Qt::CaseInsensitive);
+
+    bool isEmpty() const;
+    bool matches(const QString &name) const;
+
+    static QString wildcardToRegularExpression(const QString &pattern);
+
+private:
+    bool m_empty = true;
+    bool m_matchAll = false;
+    Qt::CaseSensitivity m_caseSensitivity = Qt::CaseInsensitive;
+    // "*.ext" 规则的后缀（不含点号），不区分大小写时为小写
+    QSet<QString> m_suffixes;
+    QSet<QString> m_names;
+    QRegularExpression m_regExp;
+};
+
+#endif // DFMNAMEFILTERMATCHER_H
@@ -0,0 +1,183 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dfmpathkey.h"
+
+#include <QHash>
+#include <QMutex>
+
+// 分片以减少多个线程同时驻留路径时的锁竞争，必须是2的幂
+#define PATH_KEY_POOL_SHARD_COUNT 16
+
+struct DFMPathKeyData
+{
+    QAtomicInt ref;
+    uint hash;
+    QByteArray path;
+};
+
+namespace {
+class PathKeyPool
+{
+public:
+    DFMPathKeyData *acquire(const QByteArray &path)
+    {
+        const uint hash = qHash(path);
+        Shard &s = shard(hash);
+        QMutexLocker locker(&s.lock);
+        DFMPathKeyData *&data = s.keys[path];
+
+        if (!data) {
+            data = new DFMPathKeyData;
+            data->hash = hash;
+            // 与哈希表的键共享同一份数据
+            data->path = s.keys.find(path).key();
+        }
+
+        data->ref.ref();
+
+        return data;
+    }
+
+    void release(DFMPathKeyData *data)
+    {
+        // 引用计数大于1时不会归零，无需加锁；归零只在锁内发生，保证不会与 acquire 竞争
+        for (int ref = data->ref.loadAcquire(); ref > 1; ref = data->ref.loadAcquire()) {
+            if (data->ref.testAndSetOrdered(ref, ref - 1))
+                return;
+        }
+
+        Shard &s = shard(data->hash);
+        QMutexLocker locker(&s.lock);
+
+        if (!data->ref.deref()) {
+            s.keys.remove(data->path);
+            delete data;
+        }
+    }
+
+    int count()
+    {
+        int count = 0;
+
+        for (Shard &s : shards) {
+            QMutexLocker locker(&s.lock);
+            count += s.keys.size();
+        }
+
+        return count;
+    }
+
+private:
+    struct Shard
+    {
+        QMutex lock;
+        QHash<QByteArray, DFMPathKeyData *> keys;
+    };
+
+    Shard &shard(uint hash)
+    {
+        return shards[hash & (PATH_KEY_POOL_SHARD_COUNT - 1)];
+    }
+
+    Shard shards[PATH_KEY_POOL_SHARD_COUNT];
+};
+
+PathKeyPool *pathKeyPool()
+{
+    // 不释放，程序退出时静态对象中保存的键析构后仍会访问
+    static PathKeyPool *pool = new PathKeyPool();
+
+    return pool;
+}
+} // namespace
+
+DFMPathKey::DFMPathKey() noexcept
+{
+
+}
+
+DFMPathKey::DFMPathKey(const DUrl &url)
+    : DFMPathKey(url.isLocalFile() ? url.toLocalFile().toUtf8() : url.toString().toUtf8())
+{
+
+}
+
+DFMPathKey::DFMPathKey(const QByteArray &data)
+{
+    if (!data.isEmpty())
+        d = pathKeyPool()->acquire(data);
+}
+
+DFMPathKey::DFMPathKey(const DFMPathKey &other) noexcept
+    : d(other.d)
+{
+    if (d)
+        d->ref.ref();
+}
+
+DFMPathKey::DFMPathKey(DFMPathKey &&other) noexcept
+    : d(other.d)
+{
+    other.d = nullptr;
+}
+
+DFMPathKey::~DFMPathKey()
+{
+    if (d)
+        pathKeyPool()->release(d);
+}
+
+DFMPathKey DFMPathKey::fromLocalFile(const QString &path)
+{
+    return DFMPathKey(path.toUtf8());
+}
+
+DFMPathKey &DFMPathKey::operator=(const DFMPathKey &other) noexcept
+{
+    DFMPathKey copy(other);
+
+    qSwap(d, copy.d);
+
+    return *this;
+}
+
+DFMPathKey &DFMPathKey::operator=(DFMPathKey &&other) noexcept
+{
+    qSwap(d, other.d);
+
+    return *this;
+}
+
+bool DFMPathKey::isLocalFile() const
+{
+    // 其它 url 的字符串以 scheme 开头
+    return d && d->path.startsWith('/');
+}
+
+QByteArray DFMPathKey::path() const
+{
+    return d ? d->path : QByteArray();
+}
+
+DUrl DFMPathKey::toUrl() const
+{
+    if (!d)
+        return DUrl();
+
+    if (isLocalFile())
+        return DUrl::fromLocalFile(QString::fromUtf8(d->path));
+
+    return DUrl(QString::fromUtf8(d->path));
+}
+
+uint DFMPathKey::hash() const
+{
+    return d ? d->hash : 0;
+}
+
+int DFMPathKey::poolCount()
+{
+    return pathKeyPool()->count();
+}
@@ -0,0 +1,61 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DFMPATHKEY_H
+#define DFMPATHKEY_H
+
+#include "durl.h"
+
+#include <QByteArray>
+
+struct DFMPathKeyData;
+
+/*!
+ * \brief DFMPathKey 驻留（intern）的文件路径键，用于模型、缓存等热点路径中的哈希表
+ *
+ * qHash(DUrl) 和 DUrl::operator== 需要逐个取出 scheme、path、query 等组件，每次都会构造多个 QString。
+ * DFMPathKey 把本地文件的路径（其它 url 为完整的 url 字符串）以 UTF-8 保存在全局的字符串池中，
+ * 相同的路径共享同一份数据，哈希值在驻留时计算一次。比较只需比较指针，qHash 直接返回保存的哈希值。
+ * 只在需要 DUrl 的接口处通过 toUrl 转换回来。
+ */
+class DFMPathKey
+{
+public:
+    DFMPathKey() noexcept;
+    DFMPathKey(const DUrl &url);
+    DFMPathKey(const DFMPathKey &other) noexcept;
+    DFMPathKey(DFMPathKey &&other) noexcept;
+    ~DFMPathKey();
+
+    static DFMPathKey fromLocalFile(const QString &path);
+
+    DFMPathKey &operator=(const DFMPathKey &other) noexcept;
+    DFMPathKey &operator=(DFMPathKey &&other) noexcept;
+
+    bool isNull() const { return !d; }
+    bool isLocalFile() const;
+    QByteArray path() const;
+    DUrl toUrl() const;
+    uint hash() const;
+
+    bool operator==(const DFMPathKey &other) const { return d == other.d; }
+    bool operator!=(const DFMPathKey &other) const { return d != other.d; }
+
+    // 池中的字符串数量，用于测试
+    static int poolCount();
+
+private:
+    explicit DFMPathKey(const QByteArray &data);
+
+    DFMPathKeyData *d = nullptr;
+};
+
+Q_DECLARE_TYPEINFO(DFMPathKey, Q_MOVABLE_TYPE);
+
+inline uint qHash(const DFMPathKey &key, uint seed = 0)
+{
+    return key.hash() ^ seed;
+}
+
+#endif // DFMPATHKEY_H
@@ -16,6 +16,9 @@
 #include <QFile>
 #include <QDir>
 #include <QTimer>
+#include <QSaveFile>
+#include <QFutureWatcher>
+#include <QtConcurrent/QtConcurrentRun>
 
 DFM_BEGIN_NAMESPACE
 
@@ -29,6 +32,11 @@ public:
     bool settingFileIsDirty = false;
 
     QTimer *syncTimer = nullptr;
+    //! 后台写入配置文件的任务，同一时间只有一个
+    QFuture<QByteArray> writeFuture;
+    bool writePending = false;
+    //! 最近一次写入或读取的配置文件内容，文件变化时内容相同则不需要重新加载
+    QByteArray lastFileContent;
 
     QString fallbackFile;
     QString settingFile;
@@ -75,7 +83,11 @@ public:
 
     void fromJsonFile(const QString &fileName, Data *data);
     void fromJson(const QByteArray &json, Data *data);
-    QByteArray toJson(const Data &data);
+    static QByteArray toJson(const Data &data);
+    static bool writeSettingFile(const QString &fileName, const QByteArray &json);
+
+    void syncInBackground();
+    bool waitForWrite();
 
     void makeSettingFileToDirty(bool dirty)
     {
@@ -140,6 +152,10 @@ void DFMSettingsPrivate::fromJsonFile(const QString &fileName, Data *data)
 
     const QByteArray &json = file.readAll();
 
+    if (fileName == settingFile) {
+        lastFileContent = json;
+    }
+
     if (json.isEmpty()) {
         return;
     }
@@ -198,12 +214,116 @@ QByteArray DFMSettingsPrivate::toJson(const Data &data)
     return QJsonDocument(root_object).toJson();
 }
 
+/*!
+ * \brief DFMSettingsPrivate::writeSettingFile 先写入临时文件再重命名，其它进程不会读到写了一半的配置
+ */
+bool DFMSettingsPrivate::writeSettingFile(const QString &fileName, const QByteArray &json)
+{
+    QSaveFile file(fileName);
+
+    if (!file.open(QFile::WriteOnly)) {
+        qWarning() << file.errorString();
+        return false;
+    }
+
+    if (file.write(json) != json.size()) {
+        file.cancelWriting();
+        return false;
+    }
+
+    return file.commit();
+}
+
+/*!
+ * \brief DFMSettingsPrivate::syncInBackground 在线程池中序列化并写入配置
+ *
+ * 视图模式、图标大小等在浏览时频繁修改，避免在界面线程中生成 json 和写文件。
+ * 写入过程中的修改会合并到下一次写入。
+ */
+void DFMSettingsPrivate::syncInBackground()
+{
+    if (!settingFileIsDirty) {
+        return;
+    }
+
+    if (writeFuture.isRunning()) {
+        writePending = true;
+        return;
+    }
+
+    // QHash 是隐式共享的，复制一份快照交给后台线程
+    const Data data = writableData;
+    const QString fileName = settingFile;
+
+    makeSettingFileToDirty(false);
+
+    QFutureWatcher<QByteArray> *watcher = new QFutureWatcher<QByteArray>(q_ptr);
+
+    QObject::connect(watcher, &QFutureWatcher<QByteArray>::finished, q_ptr, [this, watcher] {
+        const QByteArray &json = watcher->result();
+
+        watcher->deleteLater();
+
+        // 写入失败时保留脏标记，等待下一次同步
+        if (json.isNull()) {
+            makeSettingFileToDirty(true);
+        } else {
+            lastFileContent = json;
+        }
+
+        if (writePending) {
+            writePending = false;
+            syncInBackground();
+        }
+    });
+
+    writeFuture = QtConcurrent::run([data, fileName] {
+        const QByteArray &json = toJson(data);
+
+        return writeSettingFile(fileName, json) ? json : QByteArray();
+    });
+    watcher->setFuture(writeFuture);
+}
+
+/*!
+ * \brief DFMSettingsPrivate::waitForWrite 等待后台写入完成
+ * \return 最近一次后台写入是否成功
+ */
+bool DFMSettingsPrivate::waitForWrite()
+{
+    // 没有启动过后台写入
+    if (writeFuture.isCanceled()) {
+        return true;
+    }
+
+    writeFuture.waitForFinished();
+
+    const bool ok = !writeFuture.result().isNull();
+
+    writeFuture = QFuture<QByteArray>();
+
+    return ok;
+}
+
 void DFMSettingsPrivate::_q_onFileChanged(const DUrl &url)
 {
     if (url.toLocalFile() != settingFile) {
         return;
     }
 
+    // 自己写入或内容没有变化时不需要重新加载
+    if (writeFuture.isRunning()) {
+        return;
+    }
+
+    {
+        QFile file(settingFile);
+
+        if (file.open(QFile::ReadOnly) && file.readAll() == lastFileContent) {
+            return;
+        }
+    }
+
     const auto old_values = writableData.values;
 
     writableData.values.clear();
@@ -309,7 +429,7 @@ DFMSettings::~DFMSettings()
         d->syncTimer->stop();
     }
 
-    if (d->settingFileIsDirty) {
+    if (d->settingFileIsDirty || d->writeFuture.isRunning()) {
         sync();
     }
 }
@@ -638,24 +758,22 @@ bool DFMSettings::sync()
 {
     Q_D(DFMSettings);
 
+    // 后台写入失败时需要重新写入
+    if (!d->waitForWrite()) {
+        d->settingFileIsDirty = true;
+    }
+
     if (!d->settingFileIsDirty) {
         return true;
     }
 
     const QByteArray &json = d->toJson(d->writableData);
-
-    QFile file(d->settingFile);
-
-    if (!file.open(QFile::WriteOnly)) {
-        return false;
-    }
-
-    bool ok = file.write(json) == json.size();
+    bool ok = d->writeSettingFile(d->settingFile, json);
 
     if (ok) {
+        d->lastFileContent = json;
         d->makeSettingFileToDirty(false);
     }
-    file.close();
 
     return ok;
 }
@@ -697,7 +815,9 @@ void DFMSettings::setAutoSync(bool autoSync)
             d->syncTimer->setSingleShot(true);
             d->syncTimer->setInterval(1000);
 
-            connect(d->syncTimer, &QTimer::timeout, this, &DFMSettings::sync);
+            connect(d->syncTimer, &QTimer::timeout, this, [d] {
+                d->syncInBackground();
+            });
         }
     } else {
         if (d->syncTimer) {
@@ -0,0 +1,237 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dfmstartupprofile.h"
+#include "app/define.h"
+#include "utils/rlog/rlog.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QMutex>
+#include <QAtomicInt>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTextStream>
+#include <QDebug>
+
+#include <time.h>
+#include <unistd.h>
+
+namespace {
+struct StartupPhase
+{
+    QString name;
+    qint64 beginTime;
+    qint64 duration;
+};
+
+struct StartupProfile
+{
+    QMutex mutex;
+    QElapsedTimer timer;
+    QList<StartupPhase> phases;
+    qint64 lastMark = 0;
+    // 进程启动到进入 main 的耗时，-1 表示无法获取
+    qint64 preMain = -1;
+    bool print = false;
+};
+
+Q_GLOBAL_STATIC(StartupProfile, profile)
+
+// 0: 未开始，1: 记录中，2: 已结束
+QAtomicInt profileState;
+
+/*!
+ * \brief processAge 进程启动后经过的毫秒数，由 /proc/self/stat 中的启动时刻计算，精度为一个时钟周期
+ */
+qint64 processAge()
+{
+    QFile file("/proc/self/stat");
+
+    if (!file.open(QIODevice::ReadOnly))
+        return -1;
+
+    // 进程名可能包含空格，从最后一个 ')' 之后开始解析，启动时刻是第22个字段
+    const QByteArray &stat = file.readAll();
+    const QList<QByteArray> &fields = stat.mid(stat.lastIndexOf(')') + 2).split(' ');
+
+    if (fields.size() < 20)
+        return -1;
+
+    struct timespec now;
+
+    if (clock_gettime(CLOCK_BOOTTIME, &now) != 0)
+        return -1;
+
+    const qint64 startTime = fields.at(19).toLongLong() * 1000 / sysconf(_SC_CLK_TCK);
+
+    return now.tv_sec * 1000 + now.tv_nsec / 1000000 - startTime;
+}
+} // namespace
+
+/*!
+ * \brief DFMStartupProfile::start 在 main 的开始处调用，开始记录启动阶段
+ */
+void DFMStartupProfile::start()
+{
+    QMutexLocker locker(&profile->mutex);
+
+    if (profileState.load() != 0)
+        return;
+
+    profile->timer.start();
+    profile->preMain = processAge();
+    profileState.store(1);
+}
+
+/*!
+ * \brief DFMStartupProfile::mark 记录阶段 phase 结束，阶段的耗时为与上一次 mark 的间隔
+ */
+void DFMStartupProfile::mark(const QString &phase)
+{
+    if (profileState.load() != 1)
+        return;
+
+    QMutexLocker locker(&profile->mutex);
+
+    for (const StartupPhase &p : profile->phases) {
+        if (p.name == phase)
+            return;
+    }
+
+    const qint64 now = profile->timer.elapsed();
+    StartupPhase p;
+
+    p.name = phase;
+    p.beginTime = profile->lastMark;
+    p.duration = now - profile->lastMark;
+    profile->phases << p;
+    profile->lastMark = now;
+}
+
+/*!
+ * \brief DFMStartupProfile::record 记录不在主流程上的阶段，不影响 mark 的计时
+ * \param beginTime 阶段开始时的 elapsed()
+ */
+void DFMStartupProfile::record(const QString &phase, qint64 beginTime)
+{
+    if (profileState.load() != 1)
+        return;
+
+    QMutexLocker locker(&profile->mutex);
+
+    for (const StartupPhase &p : profile->phases) {
+        if (p.name == phase)
+            return;
+    }
+
+    StartupPhase p;
+
+    p.name = phase;
+    p.beginTime = beginTime;
+    p.duration = profile->timer.elapsed() - beginTime;
+    profile->phases << p;
+}
+
+bool DFMStartupProfile::contains(const QString &phase)
+{
+    if (profileState.load() != 1)
+        return false;
+
+    QMutexLocker locker(&profile->mutex);
+
+    for (const StartupPhase &p : profile->phases) {
+        if (p.name == phase)
+            return true;
+    }
+
+    return false;
+}
+
+/*!
+ * \brief DFMStartupProfile::finish 结束记录并上报，只有第一次调用有效
+ */
+void DFMStartupProfile::finish()
+{
+    if (!profileState.testAndSetOrdered(1, 2))
+        return;
+
+    const QVariantMap &phaseMap = phases();
+    qint64 total = 0;
+    bool print = false;
+
+    {
+        QMutexLocker locker(&profile->mutex);
+        total = profile->timer.elapsed();
+        print = profile->print;
+    }
+
+    QVariantMap data;
+
+    data.insert("type", true);
+    data.insert("total", total);
+    data.insert("phases", phaseMap);
+    rlog->commit("AppStartup", data);
+
+    qInfo() << "startup phases:" << phaseMap << "total:" << total;
+
+    if (!print)
+        return;
+
+    QTextStream out(stdout);
+
+    out << QJsonDocument(QJsonObject::fromVariantMap(data)).toJson(QJsonDocument::Compact) << endl;
+    QMetaObject::invokeMethod(qApp, "quit", Qt::QueuedConnection);
+}
+
+bool DFMStartupProfile::isFinished()
+{
+    return profileState.load() == 2;
+}
+
+/*!
+ * \brief DFMStartupProfile::setPrintEnabled 结束时把结果以 json 输出到标准输出并退出程序，用于 --startup-profile
+ */
+void DFMStartupProfile::setPrintEnabled(bool enable)
+{
+    QMutexLocker locker(&profile->mutex);
+
+    profile->print = enable;
+}
+
+qint64 DFMStartupProfile::elapsed()
+{
+    if (profileState.load() == 0)
+        return 0;
+
+    return profile->timer.elapsed();
+}
+
+/*!
+ * \brief DFMStartupProfile::phases 已记录的阶段，值为包含开始时刻 begin 和耗时 duration（毫秒）的 map
+ */
+QVariantMap DFMStartupProfile::phases()
+{
+    QMutexLocker locker(&profile->mutex);
+    QVariantMap map;
+
+    if (profile->preMain >= 0) {
+        QVariantMap phase;
+
+        phase.insert("begin", -profile->preMain);
+        phase.insert("duration", profile->preMain);
+        map.insert("preMain", phase);
+    }
+
+    for (const StartupPhase &p : profile->phases) {
+        QVariantMap phase;
+
+        phase.insert("begin", p.beginTime);
+        phase.insert("duration", p.duration);
+        map.insert(p.name, phase);
+    }
+
+    return map;
+}
@@ -0,0 +1,37 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DFMSTARTUPPROFILE_H
+#define DFMSTARTUPPROFILE_H
+
+#include <QString>
+#include <QVariantMap>
+
+/*!
+ * \brief DFMStartupProfile 记录文件管理器启动过程中各阶段的耗时
+ *
+ * main 中调用 start 后开始记录，mark 记录一个阶段结束，耗时为与上一个阶段结束的间隔；
+ * 不在主流程上的阶段（如在其它线程加载插件）用 record 记录开始时刻和耗时。
+ * 每个阶段只记录第一次。第一次绘制文件列表（或超时）时调用 finish，
+ * 通过 rlog 的 AppStartup 上报各阶段的耗时，使用 --startup-profile 启动时同时输出到标准输出并退出。
+ * 没有调用 start 的进程（如 dde-desktop）中所有调用都不做任何事。
+ */
+class DFMStartupProfile
+{
+public:
+    static void start();
+    static void mark(const QString &phase);
+    static void record(const QString &phase, qint64 beginTime);
+    static bool contains(const QString &phase);
+    static void finish();
+    static bool isFinished();
+
+    static void setPrintEnabled(bool enable);
+
+    // main 开始后经过的毫秒数
+    static qint64 elapsed();
+    static QVariantMap phases();
+};
+
+#endif // DFMSTARTUPPROFILE_H
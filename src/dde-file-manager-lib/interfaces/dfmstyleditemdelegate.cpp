@@ -7,6 +7,9 @@
 #include "dfilesystemmodel.h"
 #include "pixmapiconextend.h"
 #include "private/dstyleditemdelegate_p.h"
+#include "dfmmemoryaccounting.h"
+
+#include <DGuiApplicationHelper>
 
 #include <QDebug>
 #include <QAbstractItemView>
@@ -15,6 +18,15 @@
 #include <QGuiApplication>
 #include <QThreadStorage>
 #include <QPainterPath>
+#include <QCache>
+#include <QThread>
+
+// 文本排版缓存的最大条目数，足够覆盖一屏以上的文件
+#define TEXT_CACHE_MAX_COUNT 2000
+// 图标位图缓存的大小（KB）
+#define ICON_PIXMAP_CACHE_MAX_COST (32 * 1024)
+
+DGUI_USE_NAMESPACE
 
 DFMStyledItemDelegate::DFMStyledItemDelegate(DFileViewHelper *parent)
     : DFMStyledItemDelegate(*new DFMStyledItemDelegatePrivate(this), parent)
@@ -206,6 +218,36 @@ void DFMStyledItemDelegate::initStyleOption(QStyleOptionViewItem *option, const
     parent()->initStyleOption(option, index);
 }
 
+/*!
+ * \brief DFMStyledItemDelegate::clearTextCache 清空文本排版缓存，字体、图标大小或主题变化后调用
+ */
+void DFMStyledItemDelegate::clearTextCache()
+{
+    Q_D(DFMStyledItemDelegate);
+
+    d->textGeometryCache.clear();
+    d->elidedTextCache.clear();
+}
+
+/*!
+ * \brief DFMStyledItemDelegate::elideText 带缓存的 DFMGlobal::elideText
+ */
+QString DFMStyledItemDelegate::elideText(const QString &text, const QSizeF &size, QTextOption::WrapMode wordWrap,
+                                         const QFont &font, Qt::TextElideMode mode, qreal lineHeight) const
+{
+    Q_D(const DFMStyledItemDelegate);
+
+    const QString &key = DFMStyledItemDelegatePrivate::textCacheKey(text, size, wordWrap, font, mode, lineHeight, 0);
+
+    if (const QString *elided = d->elidedTextCache.object(key))
+        return *elided;
+
+    const QString &elided = DFMGlobal::elideText(text, size, wordWrap, font, mode, lineHeight);
+    d->elidedTextCache.insert(key, new QString(elided));
+
+    return elided;
+}
+
 QList<QRectF> DFMStyledItemDelegate::getCornerGeometryList(const QRectF &baseRect, const QSizeF &cornerSize) const
 {
     QList<QRectF> list;
@@ -231,7 +273,40 @@ QPixmap DFMStyledItemDelegate::getIconPixmap(const QIcon &icon, const QSize &siz
     if (size.width() <= 0 || size.height() <= 0)
         return QPixmap();
 
-    return PixmapIconExtend(icon).pixmapExtend(size, pixelRatio, mode, state);
+    // 只有主题图标在各个文件、窗口之间共用，缩略图等图标不缓存
+    if (icon.name().isEmpty() || QThread::currentThread() != qApp->thread())
+        return PixmapIconExtend(icon).pixmapExtend(size, pixelRatio, mode, state);
+
+    static QCache<QString, QPixmap> *cache = [] {
+        QCache<QString, QPixmap> *pixmapCache = new QCache<QString, QPixmap>(ICON_PIXMAP_CACHE_MAX_COST);
+
+        // 深浅色主题切换后同名图标的内容不同
+        QObject::connect(DGuiApplicationHelper::instance(), &DGuiApplicationHelper::themeTypeChanged, qApp, [pixmapCache] {
+            pixmapCache->clear();
+        });
+        // 只在主线程中访问，估算和清理也在主线程中调用
+        DFMMemoryAccounting::registerSubsystem("iconPixmap", [pixmapCache] {
+            return static_cast<qint64>(pixmapCache->totalCost()) * 1024;
+        }, [pixmapCache] {
+            pixmapCache->clear();
+        });
+
+        return pixmapCache;
+    }();
+
+    // QIcon::fromTheme 返回的同名图标共享数据，cacheKey 相同；图标被修改后 cacheKey 随之变化
+    const QString &key = QStringLiteral("%1:%2:%3:%4:%5:%6:%7").arg(size.width()).arg(size.height()).arg(pixelRatio)
+                         .arg(mode).arg(state).arg(icon.cacheKey()).arg(QIcon::themeName());
+
+    if (const QPixmap *pixmap = cache->object(key))
+        return *pixmap;
+
+    const QPixmap &pixmap = PixmapIconExtend(icon).pixmapExtend(size, pixelRatio, mode, state);
+
+    if (!pixmap.isNull())
+        cache->insert(key, new QPixmap(pixmap), qMax(1, pixmap.width() * pixmap.height() * pixmap.depth() / 8 / 1024));
+
+    return pixmap;
 }
 
 void DFMStyledItemDelegate::paintDragIcon(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index, const QSize &size) const
@@ -335,6 +410,19 @@ void DFMStyledItemDelegatePrivate::init()
     q->connect(model, SIGNAL(rowsRemoved(QModelIndex, int, int)), SLOT(_q_onRowsRemoved(QModelIndex, int, int)));
 
     textLineHeight = q->parent()->parent()->fontMetrics().lineSpacing();
+
+    textGeometryCache.setMaxCost(TEXT_CACHE_MAX_COUNT);
+    elidedTextCache.setMaxCost(TEXT_CACHE_MAX_COUNT);
+
+    q->connect(DGuiApplicationHelper::instance(), &DGuiApplicationHelper::themeTypeChanged, q, &DFMStyledItemDelegate::clearTextCache);
+    q->connect(qApp, &QGuiApplication::fontChanged, q, &DFMStyledItemDelegate::clearTextCache);
+}
+
+QString DFMStyledItemDelegatePrivate::textCacheKey(const QString &text, const QSizeF &size, QTextOption::WrapMode wordWrap,
+                                                   const QFont &font, Qt::TextElideMode mode, qreal lineHeight, int flags)
+{
+    return QStringLiteral("%1:%2:%3:%4:%5:%6:%7\n").arg(size.width()).arg(size.height()).arg(wordWrap)
+            .arg(mode).arg(lineHeight).arg(flags).arg(font.key()) + text;
 }
 
 void DFMStyledItemDelegatePrivate::_q_onRowsInserted(const QModelIndex &parent, int first, int last)
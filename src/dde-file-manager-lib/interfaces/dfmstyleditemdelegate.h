@@ -61,6 +61,8 @@ public:
                            Qt::TextElideMode mode = Qt::ElideMiddle, int flags = Qt::AlignCenter,
                            const QColor &shadowColor = QColor()) const;
 
+    void clearTextCache();
+
     static void paintCircleList(QPainter *painter, QRectF boundingRect, qreal diameter, const QList<QColor> &colors, const QColor &borderColor);
     static QPixmap getIconPixmap(const QIcon &icon, const QSize &size, qreal pixelRatio, QIcon::Mode mode = QIcon::Normal, QIcon::State state = QIcon::Off);
     void paintDragIcon(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index, const QSize &size) const;
@@ -72,6 +74,8 @@ protected:
     virtual void initTextLayout(const QModelIndex &index, QTextLayout *layout) const;
     void initStyleOption(QStyleOptionViewItem *option, const QModelIndex &index) const override;
     QList<QRectF> getCornerGeometryList(const QRectF &baseRect, const QSizeF &cornerSize) const;
+    QString elideText(const QString &text, const QSizeF &size, QTextOption::WrapMode wordWrap,
+                      const QFont &font, Qt::TextElideMode mode, qreal lineHeight) const;
 
     static void paintIcon(QPainter *painter, const QIcon &icon, const QRectF &rect, Qt::Alignment alignment = Qt::AlignCenter,
                           QIcon::Mode mode = QIcon::Normal, QIcon::State state = QIcon::Off);
@@ -0,0 +1,196 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dfmtrace.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QSaveFile>
+#include <QMutex>
+#include <QVector>
+#include <QDebug>
+
+#include <unistd.h>
+#include <sys/syscall.h>
+
+// 最多记录的事件数，超过后丢弃新的事件，避免忘记停止时占用过多内存
+#define TRACE_MAX_EVENT_COUNT 1000000
+
+QAtomicInt DFMTrace::enabled;
+
+namespace {
+struct TraceEvent
+{
+    const char *category;
+    const char *name;
+    char phase;
+    qint64 time;
+    // 区间为持续的时间，计数器为计数值
+    qint64 value;
+    qint64 tid;
+};
+
+struct TraceRecorder
+{
+    QMutex mutex;
+    QElapsedTimer timer;
+    QString filePath;
+    QVector<TraceEvent> events;
+    int droppedCount = 0;
+};
+
+Q_GLOBAL_STATIC(TraceRecorder, recorder)
+
+qint64 currentThreadId()
+{
+    static thread_local qint64 tid = static_cast<qint64>(syscall(SYS_gettid));
+
+    return tid;
+}
+
+void record(const char *category, const char *name, char phase, qint64 time, qint64 value)
+{
+    const qint64 tid = currentThreadId();
+    QMutexLocker locker(&recorder->mutex);
+
+    // 等待锁期间可能已经停止
+    if (!DFMTrace::isEnabled())
+        return;
+
+    if (recorder->events.size() >= TRACE_MAX_EVENT_COUNT) {
+        ++recorder->droppedCount;
+        return;
+    }
+
+    TraceEvent event;
+
+    event.category = category;
+    event.name = name;
+    event.phase = phase;
+    event.time = time;
+    event.value = value;
+    event.tid = tid;
+    recorder->events.append(event);
+}
+
+QByteArray escaped(const char *str)
+{
+    QByteArray data(str);
+
+    return data.replace('\\', "\\\\").replace('"', "\\\"");
+}
+} // namespace
+
+/*!
+ * \brief DFMTrace::start 开始记录，已经开始时返回 false
+ * \param filePath 停止时写入的 json 文件
+ */
+bool DFMTrace::start(const QString &filePath)
+{
+    QMutexLocker locker(&recorder->mutex);
+
+    if (isEnabled() || filePath.isEmpty())
+        return false;
+
+    recorder->filePath = filePath;
+    recorder->events.clear();
+    recorder->events.reserve(4096);
+    recorder->droppedCount = 0;
+    recorder->timer.start();
+    enabled.storeRelease(1);
+    qInfo() << "start tracing to" << filePath;
+
+    return true;
+}
+
+/*!
+ * \brief DFMTrace::stop 停止记录并把事件写入开始时指定的文件
+ */
+bool DFMTrace::stop()
+{
+    QVector<TraceEvent> events;
+    QString filePath;
+    int droppedCount = 0;
+
+    {
+        QMutexLocker locker(&recorder->mutex);
+
+        if (!isEnabled())
+            return false;
+
+        enabled.store(0);
+        events.swap(recorder->events);
+        filePath = recorder->filePath;
+        droppedCount = recorder->droppedCount;
+    }
+
+    QSaveFile file(filePath);
+
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "failed to write trace file:" << file.errorString();
+        return false;
+    }
+
+    const QByteArray &pid = QByteArray::number(QCoreApplication::applicationPid());
+
+    file.write("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    file.write("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" + pid + ",\"args\":{\"name\":\""
+               + escaped(QCoreApplication::applicationName().toUtf8().constData()) + "\"}}");
+
+    for (const TraceEvent &event : events) {
+        QByteArray line = ",{\"cat\":\"" + escaped(event.category) + "\",\"name\":\"" + escaped(event.name)
+                          + "\",\"ph\":\"" + event.phase + "\",\"pid\":" + pid
+                          + ",\"tid\":" + QByteArray::number(event.tid) + ",\"ts\":" + QByteArray::number(event.time);
+
+        if (event.phase == 'X')
+            line += ",\"dur\":" + QByteArray::number(event.value) + "}";
+        else
+            line += ",\"args\":{\"value\":" + QByteArray::number(event.value) + "}}";
+
+        file.write(line);
+    }
+
+    file.write("]}");
+
+    if (!file.commit())
+        return false;
+
+    qInfo() << "tracing stopped," << events.size() << "events written to" << filePath << "dropped:" << droppedCount;
+
+    return true;
+}
+
+/*!
+ * \brief DFMTrace::startFromEnvironment 设置了环境变量 DFM_TRACE_FILE 时开始记录，程序退出时写入文件
+ */
+bool DFMTrace::startFromEnvironment()
+{
+    const QString &filePath = QString::fromLocal8Bit(qgetenv("DFM_TRACE_FILE"));
+
+    if (filePath.isEmpty() || !start(filePath))
+        return false;
+
+    qAddPostRoutine([] {
+        DFMTrace::stop();
+    });
+
+    return true;
+}
+
+void DFMTrace::counter(const char *category, const char *name, qint64 value)
+{
+    record(category, name, 'C', now(), value);
+}
+
+void DFMTrace::complete(const char *category, const char *name, qint64 beginTime)
+{
+    const qint64 endTime = now();
+
+    record(category, name, 'X', beginTime, endTime - beginTime);
+}
+
+qint64 DFMTrace::now()
+{
+    return recorder->timer.nsecsElapsed() / 1000;
+}
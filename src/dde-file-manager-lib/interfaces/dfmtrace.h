@@ -0,0 +1,81 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DFMTRACE_H
+#define DFMTRACE_H
+
+#include <QAtomicInt>
+#include <QString>
+
+/*!
+ * \brief DFMTrace 记录耗时区间和计数器，导出为 Chrome trace（Perfetto 也能打开）的 json 文件
+ *
+ * 未开启时每个埋点只读取一次原子变量。开启的方式：
+ * \list
+ *   \li 启动前设置环境变量 DFM_TRACE_FILE=/tmp/dfm-trace.json，程序退出时写入文件；
+ *   \li 运行时调用 start/stop，dde-desktop 通过 DBus 接口的 StartTrace/StopTrace 调用。
+ * \endlist
+ * 埋点的分类和名称必须是生命周期与程序相同的字符串（字符串常量、QMetaObject::className 等），记录时不拷贝。
+ * \code
+ * void DFileCopyMoveJobPrivate::doCopyFile(...)
+ * {
+ *     DFM_TRACE_SPAN("copy", "doCopyFile");
+ *     ...
+ * }
+ * \endcode
+ */
+class DFMTrace
+{
+public:
+    static bool isEnabled()
+    {
+        return enabled.load();
+    }
+
+    static bool start(const QString &filePath);
+    static bool stop();
+    static bool startFromEnvironment();
+
+    static void counter(const char *category, const char *name, qint64 value);
+    static void complete(const char *category, const char *name, qint64 beginTime);
+    // 开始记录后经过的微秒数
+    static qint64 now();
+
+private:
+    static QAtomicInt enabled;
+};
+
+class DFMTraceSpan
+{
+public:
+    DFMTraceSpan(const char *category, const char *name)
+        : m_category(category)
+        , m_name(DFMTrace::isEnabled() ? name : nullptr)
+        , m_beginTime(m_name ? DFMTrace::now() : 0)
+    {
+
+    }
+
+    ~DFMTraceSpan()
+    {
+        if (m_name)
+            DFMTrace::complete(m_category, m_name, m_beginTime);
+    }
+
+private:
+    Q_DISABLE_COPY(DFMTraceSpan)
+
+    const char *m_category;
+    const char *m_name;
+    qint64 m_beginTime;
+};
+
+#define DFM_TRACE_CONCAT_IMPL(a, b) a##b
+#define DFM_TRACE_CONCAT(a, b) DFM_TRACE_CONCAT_IMPL(a, b)
+// 记录当前作用域的耗时
+#define DFM_TRACE_SPAN(category, name) DFMTraceSpan DFM_TRACE_CONCAT(dfmTraceSpan, __LINE__)(category, name)
+#define DFM_TRACE_COUNTER(category, name, value) \
+    do { if (DFMTrace::isEnabled()) DFMTrace::counter(category, name, value); } while (false)
+
+#endif // DFMTRACE_H
@@ -0,0 +1,197 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dfmtrashsummary.h"
+#include "dfmstandardpaths.h"
+#include "shutil/fileutils.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QDebug>
+
+#include <sys/stat.h>
+
+// 缓存格式变化时增加版本号，旧的缓存会被丢弃
+#define TRASH_SUMMARY_VERSION 1
+
+DFMTrashSummary::DFMTrashSummary(const QString &trashFilesPath, const QString &cacheFile)
+    : m_trashFilesPath(trashFilesPath)
+    , m_cacheFile(cacheFile)
+{
+
+}
+
+DFMTrashSummary *DFMTrashSummary::instance()
+{
+    static DFMTrashSummary summary(DFMStandardPaths::location(DFMStandardPaths::TrashFilesPath),
+                                   DFMStandardPaths::location(DFMStandardPaths::CachePath) + "/trash-summary.json");
+
+    return &summary;
+}
+
+/*!
+ * \brief DFMTrashSummary::summary 获取回收站顶层的文件数量和所有文件的总大小
+ * \return 回收站目录不存在时返回 false
+ */
+bool DFMTrashSummary::summary(int *count, qint64 *size)
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (!m_loaded)
+        load();
+
+    refresh();
+
+    qint64 total = 0;
+
+    for (const Entry &entry : m_entries)
+        total += entry.size;
+
+    if (count)
+        *count = m_entries.size();
+
+    if (size)
+        *size = total;
+
+    return QFileInfo::exists(m_trashFilesPath);
+}
+
+/*!
+ * \brief DFMTrashSummary::remove 文件已从回收站还原或删除
+ */
+void DFMTrashSummary::remove(const QString &name)
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (m_entries.remove(name) > 0)
+        m_dirty = true;
+}
+
+/*!
+ * \brief DFMTrashSummary::clear 回收站已清空
+ */
+void DFMTrashSummary::clear()
+{
+    QMutexLocker locker(&m_mutex);
+
+    m_loaded = true;
+    m_dirty = m_dirty || !m_entries.isEmpty();
+    m_entries.clear();
+}
+
+/*!
+ * \brief DFMTrashSummary::save 统计结果有变化时写入缓存文件
+ */
+bool DFMTrashSummary::save()
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (!m_dirty)
+        return true;
+
+    QJsonObject entries;
+
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+        QJsonObject object;
+
+        object["inode"] = static_cast<qint64>(it->inode);
+        object["lastModified"] = it->lastModified;
+        object["size"] = it->size;
+        entries[it.key()] = object;
+    }
+
+    QJsonObject root;
+
+    root["version"] = TRASH_SUMMARY_VERSION;
+    root["entries"] = entries;
+
+    QDir().mkpath(QFileInfo(m_cacheFile).absolutePath());
+    QSaveFile file(m_cacheFile);
+
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Failed to save trash summary:" << file.errorString();
+        return false;
+    }
+
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+
+    if (!file.commit())
+        return false;
+
+    m_dirty = false;
+
+    return true;
+}
+
+void DFMTrashSummary::load()
+{
+    m_loaded = true;
+
+    QFile file(m_cacheFile);
+
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    const QJsonObject &root = QJsonDocument::fromJson(file.readAll()).object();
+
+    if (root.value("version").toInt() != TRASH_SUMMARY_VERSION)
+        return;
+
+    const QJsonObject &entries = root.value("entries").toObject();
+
+    for (auto it = entries.constBegin(); it != entries.constEnd(); ++it) {
+        const QJsonObject &object = it.value().toObject();
+        Entry entry;
+
+        entry.inode = static_cast<quint64>(object.value("inode").toDouble());
+        entry.lastModified = static_cast<qint64>(object.value("lastModified").toDouble(-1));
+        entry.size = static_cast<qint64>(object.value("size").toDouble());
+        m_entries.insert(it.key(), entry);
+    }
+}
+
+/*!
+ * \brief DFMTrashSummary::refresh 与回收站顶层目录对比，只统计有变化的文件
+ */
+void DFMTrashSummary::refresh()
+{
+    const QStringList &names = QDir(m_trashFilesPath).entryList(QDir::AllEntries | QDir::System
+                                                                 | QDir::NoDotAndDotDot | QDir::Hidden);
+    QHash<QString, Entry> entries;
+
+    entries.reserve(names.size());
+
+    for (const QString &name : names) {
+        const QString &path = m_trashFilesPath + QDir::separator() + name;
+        struct stat st;
+
+        if (::lstat(path.toLocal8Bit().constData(), &st) != 0)
+            continue;
+
+        Entry entry;
+
+        entry.inode = st.st_ino;
+        entry.lastModified = static_cast<qint64>(st.st_mtim.tv_sec) * 1000 + st.st_mtim.tv_nsec / 1000000;
+
+        auto it = m_entries.constFind(name);
+
+        if (it != m_entries.constEnd() && it->inode == entry.inode && it->lastModified == entry.lastModified) {
+            entries.insert(name, *it);
+            continue;
+        }
+
+        entry.size = S_ISDIR(st.st_mode) ? FileUtils::totalSize(path) : st.st_size;
+        entries.insert(name, entry);
+        m_dirty = true;
+    }
+
+    if (entries.size() != m_entries.size())
+        m_dirty = true;
+
+    m_entries = entries;
+}
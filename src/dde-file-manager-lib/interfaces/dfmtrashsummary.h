@@ -0,0 +1,50 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DFMTRASHSUMMARY_H
+#define DFMTRASHSUMMARY_H
+
+#include <QString>
+#include <QHash>
+#include <QMutex>
+
+/*!
+ * \brief DFMTrashSummary 回收站的文件数量和总大小
+ *
+ * 按回收站 files 目录下的顶层文件记录各自的大小并保存到缓存文件中。
+ * 统计时只读取一遍顶层目录，与上次相比新放入回收站的文件才计算大小，已还原或删除的文件直接去掉，
+ * 不必每次打开回收站属性都遍历整个回收站。顶层文件的 inode 或修改时间变化时重新计算它的大小。
+ */
+class DFMTrashSummary
+{
+public:
+    explicit DFMTrashSummary(const QString &trashFilesPath, const QString &cacheFile);
+
+    static DFMTrashSummary *instance();
+
+    bool summary(int *count, qint64 *size);
+    void remove(const QString &name);
+    void clear();
+    bool save();
+
+private:
+    struct Entry {
+        quint64 inode = 0;
+        qint64 lastModified = -1;
+        qint64 size = 0;
+    };
+
+    void load();
+    void refresh();
+
+    QString m_trashFilesPath;
+    QString m_cacheFile;
+    // 键为回收站顶层文件的文件名
+    QHash<QString, Entry> m_entries;
+    QMutex m_mutex;
+    bool m_loaded = false;
+    bool m_dirty = false;
+};
+
+#endif // DFMTRASHSUMMARY_H
@@ -33,6 +33,7 @@
 #endif
 
 #include <QDateTime>
+#include <QDataStream>
 #include <QDir>
 #include <QPainter>
 #include <QApplication>
@@ -43,6 +44,12 @@
 #include <sys/stat.h>
 #include <unistd.h>
 
+#undef signals
+extern "C" {
+#include <gio/gio.h>
+}
+#define signals public
+
 DFM_USE_NAMESPACE
 
 
@@ -151,6 +158,67 @@ DGvfsFileInfo::DGvfsFileInfo(const QFileInfo &fileInfo, const QMimeType &mimetyp
 
 }
 
+DGvfsFileInfo::DGvfsFileInfo(const DUrl &fileUrl, QDataStream &cachesStream)
+    : DFileInfo(*new DGvfsFileInfoPrivate(fileUrl, this, false))
+{
+    Q_D(DGvfsFileInfo);
+
+    qint64 modifyTime = -1;
+    qint64 readTime = -1;
+    QString mimeTypeName;
+
+    cachesStream >> d->cacheCanRename >> d->cacheIsSymLink >> d->cacheCanWrite >> d->cacheIsDir
+                 >> modifyTime >> readTime >> d->cacheFileSize >> d->ownerid >> d->inode >> mimeTypeName;
+
+    d->cacheFileExists = 1;
+    d->cacheModifyTime = static_cast<long>(modifyTime);
+    d->cacheReadTime = static_cast<long>(readTime);
+
+    if (!mimeTypeName.isEmpty()) {
+        d->mimeType = DMimeDatabase().mimeTypeForName(mimeTypeName);
+        d->mimeTypeMode = QMimeDatabase::MatchExtension;
+    }
+}
+
+DGvfsFileInfo::DGvfsFileInfo(const DUrl &fileUrl, GFileInfo *gfileInfo)
+    : DFileInfo(*new DGvfsFileInfoPrivate(fileUrl, this, false))
+{
+    Q_D(DGvfsFileInfo);
+
+    auto boolAttribute = [gfileInfo](const char *attribute) -> qint8 {
+        if (!g_file_info_has_attribute(gfileInfo, attribute))
+            return -1;
+
+        return g_file_info_get_attribute_boolean(gfileInfo, attribute) ? 1 : 0;
+    };
+
+    d->cacheFileExists = 1;
+    d->cacheCanRename = boolAttribute(G_FILE_ATTRIBUTE_ACCESS_CAN_RENAME);
+    d->cacheCanWrite = boolAttribute(G_FILE_ATTRIBUTE_ACCESS_CAN_WRITE);
+    d->cacheIsSymLink = g_file_info_get_is_symlink(gfileInfo) ? 1 : 0;
+    d->cacheIsDir = g_file_info_get_file_type(gfileInfo) == G_FILE_TYPE_DIRECTORY ? 1 : 0;
+    d->cacheFileSize = g_file_info_get_size(gfileInfo);
+    d->cacheModifyTime = static_cast<long>(g_file_info_get_attribute_uint64(gfileInfo, G_FILE_ATTRIBUTE_TIME_MODIFIED));
+    d->cacheReadTime = g_file_info_has_attribute(gfileInfo, G_FILE_ATTRIBUTE_TIME_ACCESS)
+                       ? static_cast<long>(g_file_info_get_attribute_uint64(gfileInfo, G_FILE_ATTRIBUTE_TIME_ACCESS))
+                       : d->cacheModifyTime;
+    d->inode = g_file_info_get_attribute_uint64(gfileInfo, G_FILE_ATTRIBUTE_UNIX_INODE);
+    // smb等不提供uid，与refreshCachesByStat失败时一致
+    d->ownerid = g_file_info_has_attribute(gfileInfo, G_FILE_ATTRIBUTE_UNIX_UID)
+                 ? static_cast<int>(g_file_info_get_attribute_uint32(gfileInfo, G_FILE_ATTRIBUTE_UNIX_UID))
+                 : static_cast<int>(getuid());
+
+    // gvfs的content-type按文件名推断，不读取文件内容
+    const char *contentType = g_file_info_get_content_type(gfileInfo);
+    if (contentType) {
+        const QMimeType &mimetype = DMimeDatabase().mimeTypeForName(QString::fromUtf8(contentType));
+        if (mimetype.isValid()) {
+            d->mimeType = mimetype;
+            d->mimeTypeMode = QMimeDatabase::MatchExtension;
+        }
+    }
+}
+
 DGvfsFileInfo::~DGvfsFileInfo()
 {
 
@@ -401,6 +469,19 @@ void DGvfsFileInfo::refreshCachesByStat()
     d->cacheReadTime = statinfo.st_atim.tv_sec;
 }
 
+/*!
+ * \brief DGvfsFileInfo::saveCaches 保存已缓存的属性，用于持久化的目录列表缓存
+ */
+void DGvfsFileInfo::saveCaches(QDataStream &cachesStream) const
+{
+    Q_D(const DGvfsFileInfo);
+
+    cachesStream << d->cacheCanRename << d->cacheIsSymLink << d->cacheCanWrite << d->cacheIsDir
+                 << static_cast<qint64>(d->cacheModifyTime) << static_cast<qint64>(d->cacheReadTime)
+                 << d->cacheFileSize << d->ownerid << d->inode
+                 << (d->mimeType.isValid() ? d->mimeType.name() : QString());
+}
+
 bool DGvfsFileInfo::canDragCompress() const
 {
     // gvfs（smb/ftp/sftp/手机）文件不支持拖拽压缩
@@ -531,7 +612,7 @@ QList<QIcon> DGvfsFileInfo::additionalIcon() const
         if (exists()) {
             // 添加插件角标
             if (icons.size() < kMaxEmblemCount)
-                PluginEmblemManager::instance()->getPluginEmblemIconsFromMap(fileUrl(), icons.size(), icons);
+                PluginEmblemManager::instance()->getPluginEmblemIconsFromMap(fileUrl(), icons.size(), icons, lastModified().toTime_t());
             return icons;
         }
     }
@@ -553,7 +634,7 @@ QList<QIcon> DGvfsFileInfo::additionalIcon() const
 
     // 添加插件角标
     if (icons.size() < kMaxEmblemCount)
-        PluginEmblemManager::instance()->getPluginEmblemIconsFromMap(fileUrl(), icons.size(), icons);
+        PluginEmblemManager::instance()->getPluginEmblemIconsFromMap(fileUrl(), icons.size(), icons, lastModified().toTime_t());
 
     return icons;
 }
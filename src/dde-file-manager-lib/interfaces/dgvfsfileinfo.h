@@ -8,6 +8,12 @@
 
 #include "dfileinfo.h"
 
+QT_BEGIN_NAMESPACE
+class QDataStream;
+QT_END_NAMESPACE
+
+typedef struct _GFileInfo GFileInfo;
+
 class DGvfsFileInfoPrivate;
 class DGvfsFileInfo : public DFileInfo
 {
@@ -17,6 +23,10 @@ public:
     explicit DGvfsFileInfo(const DUrl &fileUrl, const QMimeType &mimetype, bool hasCache = true);
     explicit DGvfsFileInfo(const QFileInfo &fileInfo, bool hasCache = true);
     explicit DGvfsFileInfo(const QFileInfo &fileInfo, const QMimeType &mimetype, bool hasCache = true);
+    // 使用saveCaches保存的属性创建，构造时不访问文件
+    explicit DGvfsFileInfo(const DUrl &fileUrl, QDataStream &cachesStream);
+    // 使用枚举目录时一并取得的属性创建，构造时不访问文件
+    explicit DGvfsFileInfo(const DUrl &fileUrl, GFileInfo *gfileInfo);
     ~DGvfsFileInfo() override;
 
     bool exists() const override;
@@ -39,6 +49,7 @@ public:
     QList<QIcon> additionalIcon() const override;
 
     void refreshCachesByStat();
+    void saveCaches(QDataStream &cachesStream) const;
 
     /**
      * @brief canDragCompress 是否支持拖拽压缩
@@ -435,9 +435,6 @@ public:
 
     QPointer<ExpandedItem> expandedItem;
 
-    //    mutable QHash<QString, QString> elideMap;
-    //    mutable QHash<QString, QString> wordWrapMap;
-    //    mutable QHash<QString, int> textHeightMap;
     mutable QModelIndex expandedIndex;
     mutable QModelIndex lastAndExpandedInde;
 
@@ -451,6 +448,8 @@ public:
     mutable bool drawTextBackgroundOnLast = true;
 
     QTextDocument *document = nullptr;
+    // 正在绘制的缓存图块，绘制到此设备时不是拖拽模式
+    mutable const QPaintDevice *itemTileDevice = nullptr;
 
     static int textObjectType;
     static FileTagObjectInterface *textObjectInterface;
@@ -551,7 +550,8 @@ void DIconItemDelegate::paint(QPainter *painter,
 
     bool isCanvas = parent()->property("isCanvasViewHelper").toBool();
     /// judgment way of the whether drag model(another way is: painter.devType() != 1)
-    bool isDragMode = (static_cast<QPaintDevice *>(parent()->parent()->viewport()) != painter->device());
+    bool isDragMode = (static_cast<QPaintDevice *>(parent()->parent()->viewport()) != painter->device())
+                      && (d->itemTileDevice != painter->device());
     bool isEnabled = option.state & QStyle::State_Enabled;
     bool hasFocus = option.state & QStyle::State_HasFocus;
 
@@ -811,6 +811,15 @@ void DIconItemDelegate::paint(QPainter *painter,
     painter->setOpacity(1);
 }
 
+void DIconItemDelegate::paintItemTile(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    Q_D(const DIconItemDelegate);
+
+    d->itemTileDevice = painter->device();
+    paint(painter, option, index);
+    d->itemTileDevice = nullptr;
+}
+
 bool DIconItemDelegate::helpEvent(QHelpEvent *event, QAbstractItemView *view, const QStyleOptionViewItem &option, const QModelIndex &index)
 {
     if (event->type() == QEvent::ToolTip) {
@@ -1307,9 +1316,7 @@ void DIconItemDelegate::updateItemSizeHint()
 {
     Q_D(DIconItemDelegate);
 
-    //    d->elideMap.clear();
-    //    d->wordWrapMap.clear();
-    //    d->textHeightMap.clear();
+    clearTextCache();
     d->textLineHeight = parent()->parent()->fontMetrics().lineSpacing();
 
     int width = parent()->parent()->iconSize().width() + 30;
@@ -1417,7 +1424,31 @@ QList<QRectF> DIconItemDelegate::drawText(const QModelIndex &index, QPainter *pa
 
     const_cast<DIconItemDelegatePrivate *>(d)->drawTextBackgroundOnLast = background != Qt::NoBrush;
 
-    return DFMStyledItemDelegate::drawText(index, painter, layout, boundingRect, radius, background, wordWrap, mode, flags, shadowColor);
+    if (painter)
+        return DFMStyledItemDelegate::drawText(index, painter, layout, boundingRect, radius, background, wordWrap, mode, flags, shadowColor);
+
+    // 只计算区域时结果仅与文本、标记颜色和排版参数有关，缓存相对位置，避免每次都重新折行
+    QString key = DFMStyledItemDelegatePrivate::textCacheKey(layout->text(), boundingRect.size(), wordWrap,
+                                                             layout->font(), mode, d->textLineHeight, flags);
+    const QVariantHash &ep = index.data(DFileSystemModel::ExtraProperties).toHash();
+
+    for (const QColor &color : qvariant_cast<QList<QColor>>(ep.value("colored")))
+        key.prepend(color.name(QColor::HexArgb));
+
+    QList<QRectF> lines;
+
+    if (const QList<QRectF> *cacheLines = d->textGeometryCache.object(key)) {
+        lines = *cacheLines;
+    } else {
+        lines = DFMStyledItemDelegate::drawText(index, painter, layout, QRectF(QPointF(0, 0), boundingRect.size()),
+                                                radius, background, wordWrap, mode, flags, shadowColor);
+        d->textGeometryCache.insert(key, new QList<QRectF>(lines));
+    }
+
+    for (QRectF &line : lines)
+        line.translate(boundingRect.topLeft());
+
+    return lines;
 }
 
 void DIconItemDelegate::onEditWidgetFocusOut()
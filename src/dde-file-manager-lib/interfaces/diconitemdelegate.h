@@ -30,6 +30,10 @@ public:
     void paint(QPainter *painter,
                const QStyleOptionViewItem &option,
                const QModelIndex &index) const override;
+    //! 绘制到视图缓存的图块中，按在视图上的样式绘制而不是拖拽的样式
+    void paintItemTile(QPainter *painter,
+                       const QStyleOptionViewItem &option,
+                       const QModelIndex &index) const;
 
     QSize sizeHint(const QStyleOptionViewItem &, const QModelIndex &) const override;
     QWidget *createEditor(QWidget *parent, const QStyleOptionViewItem &, const QModelIndex &index) const override;
@@ -292,9 +292,9 @@ void DListItemDelegate::paint(QPainter *painter,
                     if(VaultController::isVaultFile(strInfo))
                         strInfo = VaultController::localPathToVirtualPath(index.data(rol).toString());
                 }
-                const QString &text = DFMGlobal::elideText(strInfo, rec.size(),
-                                                           QTextOption::NoWrap, opt.font,
-                                                           Qt::ElideRight, d->textLineHeight);
+                const QString &text = elideText(strInfo, rec.size(),
+                                                QTextOption::NoWrap, opt.font,
+                                                Qt::ElideRight, d->textLineHeight);
 
                 painter->drawText(rec, Qt::Alignment(tmp_index.data(Qt::TextAlignmentRole).toInt()), text);
             } else {
@@ -337,17 +337,17 @@ void DListItemDelegate::drawNotStringData(const QStyleOptionViewItem &opt, int l
     if (data.canConvert<QPair<QString, QString>>()) {
         QPair<QString, QString> name_path = qvariant_cast<QPair<QString, QString>>(data);
 
-        const QString &file_name = DFMGlobal::elideText(name_path.first.remove('\n'),
-                                                        QSize(rect.width(), rect.height() / 2), QTextOption::NoWrap,
-                                                        opt.font, Qt::ElideRight,
-                                                        lineHeight);
+        const QString &file_name = elideText(name_path.first.remove('\n'),
+                                             QSize(rect.width(), rect.height() / 2), QTextOption::NoWrap,
+                                             opt.font, Qt::ElideRight,
+                                             lineHeight);
         painter->setPen(sortRoleIndexByColumnChildren == 0 ? active_color : normal_color);
         painter->drawText(rect.adjusted(0, 0, 0, -rect.height() / 2), Qt::AlignBottom, file_name);
 
-        const QString &file_path = DFMGlobal::elideText(name_path.second.remove('\n'),
-                                                        QSize(rect.width(), rect.height() / 2), QTextOption::NoWrap,
-                                                        opt.font, Qt::ElideRight,
-                                                        lineHeight);
+        const QString &file_path = elideText(name_path.second.remove('\n'),
+                                             QSize(rect.width(), rect.height() / 2), QTextOption::NoWrap,
+                                             opt.font, Qt::ElideRight,
+                                             lineHeight);
 
         painter->setPen(sortRoleIndexByColumnChildren == 1 ? active_color : normal_color);
         painter->drawText(rect.adjusted(0, rect.height() / 2, 0, 0), Qt::AlignTop, file_path);
@@ -356,25 +356,25 @@ void DListItemDelegate::drawNotStringData(const QStyleOptionViewItem &opt, int l
 
         const QPair<QString, QPair<QString, QString>> &dst = qvariant_cast<QPair<QString, QPair<QString, QString>>>(data);
 
-        const QString &date = DFMGlobal::elideText(dst.first, QSize(rect.width(), rect.height() / 2),
-                                                   QTextOption::NoWrap, opt.font,
-                                                   Qt::ElideRight, lineHeight);
+        const QString &date = elideText(dst.first, QSize(rect.width(), rect.height() / 2),
+                                        QTextOption::NoWrap, opt.font,
+                                        Qt::ElideRight, lineHeight);
 
         painter->setPen(sortRoleIndexByColumnChildren == 0 ? active_color : normal_color);
         painter->drawText(new_rect.adjusted(0, 0, 0, -new_rect.height() / 2), Qt::AlignBottom, date, &new_rect);
 
         new_rect = QRect(rect.left(), rect.top(), new_rect.width(), rect.height());
 
-        const QString &size = DFMGlobal::elideText(dst.second.first, QSize(new_rect.width() / 2, new_rect.height() / 2),
-                                                   QTextOption::NoWrap, opt.font,
-                                                   Qt::ElideRight, lineHeight);
+        const QString &size = elideText(dst.second.first, QSize(new_rect.width() / 2, new_rect.height() / 2),
+                                        QTextOption::NoWrap, opt.font,
+                                        Qt::ElideRight, lineHeight);
 
         painter->setPen(sortRoleIndexByColumnChildren == 1 ? active_color : normal_color);
         painter->drawText(new_rect.adjusted(0, new_rect.height() / 2, 0, 0), Qt::AlignTop | Qt::AlignLeft, size);
 
-        const QString &type = DFMGlobal::elideText(dst.second.second, QSize(new_rect.width() / 2, new_rect.height() / 2),
-                                                   QTextOption::NoWrap, opt.font,
-                                                   Qt::ElideLeft, lineHeight);
+        const QString &type = elideText(dst.second.second, QSize(new_rect.width() / 2, new_rect.height() / 2),
+                                        QTextOption::NoWrap, opt.font,
+                                        Qt::ElideLeft, lineHeight);
         painter->setPen(sortRoleIndexByColumnChildren == 2 ? active_color : normal_color);
         painter->drawText(new_rect.adjusted(0, new_rect.height() / 2, 0, 0), Qt::AlignTop | Qt::AlignRight, type);
     }
@@ -624,6 +624,7 @@ void DListItemDelegate::updateItemSizeHint()
 {
     Q_D(DListItemDelegate);
 
+    clearTextCache();
     d->textLineHeight = parent()->parent()->fontMetrics().lineSpacing();
     d->itemSizeHint = QSize(-1, qMax(int(parent()->parent()->iconSize().height() * 1.1), d->textLineHeight));
 }
@@ -766,20 +767,20 @@ void DListItemDelegate::paintFileName(QPainter *painter, const QStyleOptionViewI
             if (suffix == ".")
                 break;
 
-            file_name = DFMGlobal::elideText(index.data(DFileSystemModel::FileBaseNameRole).toString().remove('\n'),
-                                             QSize(rect.width() - option.fontMetrics.width(suffix), rect.height()), QTextOption::WrapAtWordBoundaryOrAnywhere,
-                                             option.font, Qt::ElideRight,
-                                             textLineHeight);
+            file_name = elideText(index.data(DFileSystemModel::FileBaseNameRole).toString().remove('\n'),
+                                  QSize(rect.width() - option.fontMetrics.width(suffix), rect.height()), QTextOption::WrapAtWordBoundaryOrAnywhere,
+                                  option.font, Qt::ElideRight,
+                                  textLineHeight);
             bool showSuffix{ DFMApplication::instance()->genericAttribute(DFMApplication::GA_ShowedFileSuffix).toBool() };
             if (showSuffix)
                 file_name.append(suffix);
         } while (false);
 
         if (file_name.isEmpty()) {
-            file_name = DFMGlobal::elideText(index.data(role).toString().remove('\n'),
-                                             rect.size(), QTextOption::WrapAtWordBoundaryOrAnywhere,
-                                             option.font, Qt::ElideRight,
-                                             textLineHeight);
+            file_name = elideText(index.data(role).toString().remove('\n'),
+                                  rect.size(), QTextOption::WrapAtWordBoundaryOrAnywhere,
+                                  option.font, Qt::ElideRight,
+                                  textLineHeight);
         }
 
         painter->drawText(rect, Qt::Alignment(index.data(Qt::TextAlignmentRole).toInt()), file_name);
@@ -5,9 +5,122 @@
 #include "dmimedatabase.h"
 #include "shutil/fileutils.h"
 #include "dstorageinfo.h"
+#include "dfmmetrics.h"
+#include "dfmmemoryaccounting.h"
 #include "controllers/vaultcontroller.h"
 
 #include <QFileInfo>
+#include <QReadWriteLock>
+#include <QCache>
+#include <QMutex>
+#include <QFile>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+// 内容检测结果缓存的文件数量上限
+#define MIME_CACHE_MAX_COUNT 50000
+// 每条缓存的估算开销（字节），QMimeType 共享数据，只计算键和节点
+#define MIME_CACHE_ENTRY_ESTIMATED_SIZE 128
+
+namespace {
+// 同一个文件（设备号、inode、名称相同）的同一个版本（修改时间、大小相同）检测结果不变
+struct MimeCacheKey
+{
+    quint64 device = 0;
+    quint64 inode = 0;
+    qint64 modifyTime = 0;
+    qint64 size = 0;
+    // 硬链接的inode相同但名称可能不同，按名称匹配的结果也不同
+    uint nameHash = 0;
+    int mode = 0;
+
+    bool operator==(const MimeCacheKey &other) const
+    {
+        return device == other.device && inode == other.inode && modifyTime == other.modifyTime
+                && size == other.size && nameHash == other.nameHash && mode == other.mode;
+    }
+};
+
+inline uint qHash(const MimeCacheKey &key, uint seed = 0)
+{
+    return ::qHash(key.inode, seed) ^ ::qHash(key.device) ^ ::qHash(key.modifyTime) ^ ::qHash(key.size)
+            ^ key.nameHash ^ static_cast<uint>(key.mode);
+}
+
+class MimeCache
+{
+public:
+    static MimeCache *instance()
+    {
+        static MimeCache cache;
+
+        return &cache;
+    }
+
+    bool value(const MimeCacheKey &key, QMimeType *mimeType)
+    {
+        QMutexLocker locker(&mutex);
+        const QMimeType *cached = cache.object(key);
+
+        if (!cached)
+            return false;
+
+        *mimeType = *cached;
+
+        return true;
+    }
+
+    void insert(const MimeCacheKey &key, const QMimeType &mimeType)
+    {
+        QMutexLocker locker(&mutex);
+
+        cache.insert(key, new QMimeType(mimeType));
+    }
+
+private:
+    MimeCache()
+        : cache(MIME_CACHE_MAX_COUNT)
+    {
+        DFMMemoryAccounting::registerSubsystem("mime", [this] {
+            QMutexLocker locker(&mutex);
+            return static_cast<qint64>(cache.size()) * MIME_CACHE_ENTRY_ESTIMATED_SIZE;
+        }, [this] {
+            QMutexLocker locker(&mutex);
+            cache.clear();
+        });
+    }
+
+    QMutex mutex;
+    QCache<MimeCacheKey, QMimeType> cache;
+};
+
+/*!
+ * \brief makeMimeCacheKey 只缓存本地的普通文件，远程文件stat本身就很慢，而且使用扩展名检测
+ */
+bool makeMimeCacheKey(const QFileInfo &fileInfo, QMimeDatabase::MatchMode mode, MimeCacheKey *key)
+{
+    static const QString gvfsPath = QString("/run/user/%1/gvfs/").arg(getuid());
+    const QString &filePath = fileInfo.absoluteFilePath();
+
+    if (filePath.startsWith(gvfsPath))
+        return false;
+
+    struct stat statInfo;
+
+    if (::stat(QFile::encodeName(filePath).constData(), &statInfo) != 0 || !S_ISREG(statInfo.st_mode))
+        return false;
+
+    key->device = static_cast<quint64>(statInfo.st_dev);
+    key->inode = static_cast<quint64>(statInfo.st_ino);
+    key->modifyTime = static_cast<qint64>(statInfo.st_mtim.tv_sec) * 1000000000 + statInfo.st_mtim.tv_nsec;
+    key->size = static_cast<qint64>(statInfo.st_size);
+    key->nameHash = qHash(fileInfo.fileName());
+    key->mode = mode;
+
+    return true;
+}
+} // namespace
 
 DFM_BEGIN_NAMESPACE
 
@@ -21,7 +134,35 @@ QMimeType DMimeDatabase::mimeTypeForFile(const QString &fileName, QMimeDatabase:
     return mimeTypeForFile(QFileInfo(fileName), mode);
 }
 
+/*!
+ * \brief DMimeDatabase::mimeTypeForFile 需要检测文件内容时，同一文件的同一版本只检测一次
+ */
 QMimeType DMimeDatabase::mimeTypeForFile(const QFileInfo &fileInfo, QMimeDatabase::MatchMode mode) const
+{
+    // 只按扩展名检测时不读取文件，不需要缓存
+    if (mode == QMimeDatabase::MatchExtension)
+        return detectMimeTypeForFile(fileInfo, mode);
+
+    MimeCacheKey key;
+
+    if (!makeMimeCacheKey(fileInfo, mode, &key))
+        return detectMimeTypeForFile(fileInfo, mode);
+
+    QMimeType result;
+
+    if (MimeCache::instance()->value(key, &result)) {
+        DFM_METRIC_INC("mime.cacheHit");
+        return result;
+    }
+
+    DFM_METRIC_INC("mime.cacheMiss");
+    result = detectMimeTypeForFile(fileInfo, mode);
+    MimeCache::instance()->insert(key, result);
+
+    return result;
+}
+
+QMimeType DMimeDatabase::detectMimeTypeForFile(const QFileInfo &fileInfo, QMimeDatabase::MatchMode mode) const
 {
     // 如果是低速设备，则先从扩展名去获取mime信息；对于本地文件，保持默认的获取策略
     QMimeType result;
@@ -79,10 +220,10 @@ QMimeType DMimeDatabase::mimeTypeForFile(const QFileInfo &fileInfo, QMimeDatabas
     if (officeSuffixList.contains(fileInfo.suffix()) && wrongMimeTypeNames.contains(result.name())) {
         QList<QMimeType> results = QMimeDatabase::mimeTypesForFileName(fileInfo.fileName());
         if (!results.isEmpty()) {
-            return results.first();
+            return sharedMimeType(results.first());
         }
     }
-    return result;
+    return sharedMimeType(result);
 }
 
 QMimeType DMimeDatabase::mimeTypeForFile(const QString &fileName, QMimeDatabase::MatchMode mode, const QString& inod, const bool isgvfs) const
@@ -104,7 +245,7 @@ QMimeType DMimeDatabase::mimeTypeForFile(const QFileInfo &fileInfo, QMimeDatabas
         return inodmimetypecache.value(inod);
     }
     if (fileInfo.isDir()) {
-        return QMimeDatabase::mimeTypeForFile(QFileInfo("/home"), mode);
+        return sharedMimeType(QMimeDatabase::mimeTypeForFile(QFileInfo("/home"), mode));
     }
     QMimeType result;
     QString path = fileInfo.path();
@@ -158,12 +299,14 @@ QMimeType DMimeDatabase::mimeTypeForFile(const QFileInfo &fileInfo, QMimeDatabas
     if (officeSuffixList.contains(fileInfo.suffix()) && wrongMimeTypeNames.contains(result.name())) {
         QList<QMimeType> results = QMimeDatabase::mimeTypesForFileName(fileInfo.fileName());
         if (!results.isEmpty()) {
+            results.first() = sharedMimeType(results.first());
             if (cancache) {
                 const_cast<DMimeDatabase *>(this)->inodmimetypecache.insert(inod,results.first());
             }
             return results.first();
         }
     }
+    result = sharedMimeType(result);
     if (cancache) {
         const_cast<DMimeDatabase *>(this)->inodmimetypecache.insert(inod,result);
     }
@@ -175,7 +318,45 @@ QMimeType DMimeDatabase::mimeTypeForUrl(const QUrl &url) const
     if (url.isLocalFile())
         return mimeTypeForFile(url.toLocalFile());
 
-    return QMimeDatabase::mimeTypeForUrl(url);
+    return sharedMimeType(QMimeDatabase::mimeTypeForUrl(url));
+}
+
+QMimeType DMimeDatabase::mimeTypeForName(const QString &nameOrAlias) const
+{
+    return sharedMimeType(QMimeDatabase::mimeTypeForName(nameOrAlias));
+}
+
+/*!
+ * \brief DMimeDatabase::sharedMimeType 返回类型表中同名的QMimeType
+ *
+ * QMimeDatabase每次查询都会创建新的QMimeType，其描述、图标名等信息在首次访问时各自加载，
+ * 大目录中每个文件都会保存一份。通过类型表共享后，每个文件只持有指向共享数据的指针。
+ */
+QMimeType DMimeDatabase::sharedMimeType(const QMimeType &mimeType)
+{
+    if (!mimeType.isValid())
+        return mimeType;
+
+    static QReadWriteLock lock;
+    static QHash<QString, QMimeType> mimeTypes;
+
+    const QString &name = mimeType.name();
+
+    {
+        QReadLocker locker(&lock);
+        auto it = mimeTypes.constFind(name);
+
+        if (it != mimeTypes.constEnd())
+            return it.value();
+    }
+
+    QWriteLocker locker(&lock);
+    auto it = mimeTypes.find(name);
+
+    if (it == mimeTypes.end())
+        it = mimeTypes.insert(name, mimeType);
+
+    return it.value();
 }
 
 DFM_END_NAMESPACE
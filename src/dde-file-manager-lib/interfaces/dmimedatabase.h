@@ -23,8 +23,14 @@ public:
     QMimeType mimeTypeForFile(const QString &fileName, MatchMode mode, const QString& inod,const bool isgvfs = false) const;
     QMimeType mimeTypeForFile(const QFileInfo &fileInfo, MatchMode mode, const QString& inod,const bool isgvfs = false) const;
     QMimeType mimeTypeForUrl(const QUrl &url) const;
+    QMimeType mimeTypeForName(const QString &nameOrAlias) const;
+
+    // 相同类型的文件共享同一个QMimeType，类型的描述、图标等信息只加载一次
+    static QMimeType sharedMimeType(const QMimeType &mimeType);
 
 private:
+    QMimeType detectMimeTypeForFile(const QFileInfo &fileInfo, MatchMode mode) const;
+
     QHash<QString, QMimeType> inodmimetypecache;
 };
 
@@ -21,7 +21,6 @@
 #include "models/dfmrootfileinfo.h"
 #include "utils.h"
 #include "dfmapplication.h"
-#include "plugins/schemepluginmanager.h"
 #include "utils/grouppolicy.h"
 #include "controllers/dfmrootcontroller.h"
 #include "shutil/smbintegrationswitcher.h"
@@ -163,9 +162,6 @@ void DRootFileManager::startQuryRootFile()
     if (!d_ptr->bstartonce) {
         d_ptr->bstartonce = true;
 
-        //NOTE [XIAO] 加载插件
-        SchemePluginManager::instance()->loadSchemePlugin();
-
         DAbstractFileWatcher *devicesWatcher = DFileService::instance()->createFileWatcher(nullptr, DUrl(DFMROOT_ROOT), this);
         Q_CHECK_PTR(devicesWatcher);
         if (d_ptr->m_rootFileWatcher) {
@@ -209,18 +205,6 @@ void DRootFileManager::startQuryRootFile()
 
     lk.unlock();
 
-    connect(d_ptr->m_jobcontroller, &JobController::addChildren, this, [this](const DAbstractFileInfoPointer & chi) {
-        if (!chi)
-            return;
-        QMutexLocker locker(&d_ptr->rootfileMtx);
-        if (!d_ptr->rootfilelist.contains(chi->fileUrl()) && chi->exists()) {
-            d_ptr->rootfilelist.insert(chi->fileUrl(), chi);
-            d_ptr->m_rootChanged = true;
-            locker.unlock();
-            emit rootFileChange(chi); // 其实中间结果没有必要,直接拿最终结果就行了,但保留接口，以后便于扩展
-        }
-    }, Qt::DirectConnection);
-
     connect(d_ptr->m_jobcontroller, &JobController::addChildrenList, this, [this](QList<DAbstractFileInfoPointer> ch) {
         for (auto chi : ch) {
             QMutexLocker locker(&d_ptr->rootfileMtx);
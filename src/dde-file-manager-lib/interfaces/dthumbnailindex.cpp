@@ -0,0 +1,403 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dthumbnailindex.h"
+#include "dfmstandardpaths.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QSaveFile>
+#include <QThread>
+#include <QThreadPool>
+#include <QVector>
+#include <QtConcurrent>
+
+#include <algorithm>
+
+// 缩略图的总大小和数量上限，超出时删除最久未访问的缩略图直到低于上限的 80%
+#define THUMBNAIL_INDEX_MAX_SIZE (512 * 1024 * 1024)
+#define THUMBNAIL_INDEX_MAX_COUNT 100000
+#define THUMBNAIL_INDEX_LOW_WATER_PERCENT 80
+// 索引变化次数达到此值时在后台保存
+#define THUMBNAIL_INDEX_SAVE_INTERVAL 1000
+#define THUMBNAIL_INDEX_FILE_NAME "dfm-thumbnail.index"
+#define THUMBNAIL_INDEX_MAGIC 0x44465449
+#define THUMBNAIL_INDEX_VERSION 1
+// 键为缩略图文件名的 md5 值加所在目录的序号
+#define THUMBNAIL_INDEX_KEY_SIZE 17
+
+DFM_BEGIN_NAMESPACE
+
+Q_GLOBAL_STATIC(QThreadPool, thumbnailIndexThreadPool)
+
+static quint32 currentTime()
+{
+    return QDateTime::currentDateTimeUtc().toTime_t();
+}
+
+DThumbnailIndex::DThumbnailIndex(const QString &rootPath)
+    : m_rootPath(rootPath)
+    , m_directories({"small", "normal", "large", "fail"})
+    , m_maxSize(THUMBNAIL_INDEX_MAX_SIZE)
+    , m_maxCount(THUMBNAIL_INDEX_MAX_COUNT)
+{
+    // 没有可用的索引时需扫描缩略图目录
+    m_needRebuild = !load();
+}
+
+DThumbnailIndex::~DThumbnailIndex()
+{
+    if (!thumbnailIndexThreadPool.isDestroyed())
+        thumbnailIndexThreadPool->waitForDone();
+
+    save();
+}
+
+DThumbnailIndex *DThumbnailIndex::instance()
+{
+    static DThumbnailIndex index(DFMStandardPaths::location(DFMStandardPaths::ThumbnailPath));
+    static bool initialized = [] {
+        // 启动后检查一次缩略图目录的大小
+        index.scheduleGarbageCollection();
+
+        return true;
+    }();
+    Q_UNUSED(initialized)
+
+    return &index;
+}
+
+/*!
+ * \brief DThumbnailIndex::check 检查缩略图是否与源文件一致，并更新其访问时间
+ */
+DThumbnailIndex::State DThumbnailIndex::check(const QString &thumbnailPath, uint sourceModified)
+{
+    QByteArray key;
+
+    if (!makeKey(thumbnailPath, &key))
+        return Unindexed;
+
+    QMutexLocker locker(&m_mutex);
+
+    auto it = m_entries.find(key);
+
+    if (it == m_entries.end() || it->sourceModified == 0)
+        return Unindexed;
+
+    if (it->sourceModified != sourceModified)
+        return Stale;
+
+    it->lastAccess = currentTime();
+
+    return Valid;
+}
+
+/*!
+ * \brief DThumbnailIndex::insert 记录新生成或已验证的缩略图
+ * \param sourceModified 源文件的修改时间，为0时表示未知
+ */
+void DThumbnailIndex::insert(const QString &thumbnailPath, uint sourceModified, qint64 fileSize)
+{
+    QByteArray key;
+
+    if (!makeKey(thumbnailPath, &key))
+        return;
+
+    QMutexLocker locker(&m_mutex);
+
+    Entry &entry = m_entries[key];
+
+    m_totalSize += fileSize - entry.fileSize;
+    entry.sourceModified = sourceModified;
+    entry.fileSize = static_cast<quint32>(fileSize);
+    entry.lastAccess = currentTime();
+
+    entryChanged();
+}
+
+void DThumbnailIndex::remove(const QString &thumbnailPath)
+{
+    QByteArray key;
+
+    if (!makeKey(thumbnailPath, &key))
+        return;
+
+    QMutexLocker locker(&m_mutex);
+
+    auto it = m_entries.find(key);
+
+    if (it == m_entries.end())
+        return;
+
+    m_totalSize -= it->fileSize;
+    m_entries.erase(it);
+
+    entryChanged();
+}
+
+int DThumbnailIndex::count() const
+{
+    QMutexLocker locker(&m_mutex);
+
+    return m_entries.count();
+}
+
+qint64 DThumbnailIndex::totalSize() const
+{
+    QMutexLocker locker(&m_mutex);
+
+    return m_totalSize;
+}
+
+void DThumbnailIndex::setLimits(qint64 maxSize, int maxCount)
+{
+    QMutexLocker locker(&m_mutex);
+
+    m_maxSize = maxSize;
+    m_maxCount = maxCount;
+}
+
+/*!
+ * \brief DThumbnailIndex::scheduleGarbageCollection 在后台线程中以最低优先级清理缩略图并保存索引
+ */
+void DThumbnailIndex::scheduleGarbageCollection()
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (!m_gcScheduled)
+        startBackgroundTask();
+}
+
+/*!
+ * \brief DThumbnailIndex::collectGarbage 删除最久未访问的缩略图，直到总大小和数量都低于上限
+ */
+void DThumbnailIndex::collectGarbage()
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (m_totalSize <= m_maxSize && m_entries.count() <= m_maxCount)
+        return;
+
+    const qint64 targetSize = m_maxSize * THUMBNAIL_INDEX_LOW_WATER_PERCENT / 100;
+    const int targetCount = m_maxCount * THUMBNAIL_INDEX_LOW_WATER_PERCENT / 100;
+
+    QVector<QPair<quint32, QByteArray>> entries;
+    entries.reserve(m_entries.count());
+
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it)
+        entries.append(qMakePair(it->lastAccess, it.key()));
+
+    std::sort(entries.begin(), entries.end(), [](const QPair<quint32, QByteArray> &left, const QPair<quint32, QByteArray> &right) {
+        return left.first < right.first;
+    });
+
+    QStringList removedFiles;
+
+    for (const QPair<quint32, QByteArray> &entry : entries) {
+        if (m_totalSize <= targetSize && m_entries.count() <= targetCount)
+            break;
+
+        m_totalSize -= m_entries.take(entry.second).fileSize;
+        removedFiles << keyToPath(entry.second);
+    }
+
+    locker.unlock();
+
+    for (const QString &file : removedFiles)
+        QFile::remove(file);
+}
+
+/*!
+ * \brief DThumbnailIndex::rebuild 按缩略图目录中的文件重建索引，源文件的修改时间在下次使用缩略图时验证
+ */
+void DThumbnailIndex::rebuild()
+{
+    QHash<QByteArray, Entry> entries;
+    qint64 totalSize = 0;
+
+    for (const QString &directory : m_directories) {
+        QDirIterator iterator(m_rootPath + QDir::separator() + directory, {"*.png"}, QDir::Files | QDir::NoDotAndDotDot);
+
+        while (iterator.hasNext()) {
+            const QString &path = iterator.next();
+            QByteArray key;
+
+            if (!makeKey(path, &key))
+                continue;
+
+            const QFileInfo &info = iterator.fileInfo();
+            Entry entry;
+            entry.fileSize = static_cast<quint32>(info.size());
+            entry.lastAccess = info.lastModified().toTime_t();
+            entries.insert(key, entry);
+            totalSize += entry.fileSize;
+        }
+    }
+
+    QMutexLocker locker(&m_mutex);
+
+    // 保留扫描期间加入的记录
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+        auto old = entries.find(it.key());
+
+        if (old != entries.end())
+            totalSize -= old->fileSize;
+
+        entries.insert(it.key(), it.value());
+        totalSize += it->fileSize;
+    }
+
+    m_entries = entries;
+    m_totalSize = totalSize;
+    m_needRebuild = false;
+}
+
+bool DThumbnailIndex::load()
+{
+    QFile file(m_rootPath + QDir::separator() + THUMBNAIL_INDEX_FILE_NAME);
+
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream stream(&file);
+    quint32 magic = 0;
+    quint32 version = 0;
+    qint32 count = 0;
+
+    stream >> magic >> version >> count;
+
+    if (magic != THUMBNAIL_INDEX_MAGIC || version != THUMBNAIL_INDEX_VERSION || count < 0 || count > THUMBNAIL_INDEX_MAX_COUNT * 2)
+        return false;
+
+    QHash<QByteArray, Entry> entries;
+    qint64 totalSize = 0;
+    char key[THUMBNAIL_INDEX_KEY_SIZE];
+
+    entries.reserve(count);
+
+    for (qint32 i = 0; i < count; ++i) {
+        Entry entry;
+
+        if (stream.readRawData(key, THUMBNAIL_INDEX_KEY_SIZE) != THUMBNAIL_INDEX_KEY_SIZE)
+            return false;
+
+        stream >> entry.sourceModified >> entry.fileSize >> entry.lastAccess;
+
+        if (stream.status() != QDataStream::Ok)
+            return false;
+
+        entries.insert(QByteArray(key, THUMBNAIL_INDEX_KEY_SIZE), entry);
+        totalSize += entry.fileSize;
+    }
+
+    QMutexLocker locker(&m_mutex);
+
+    m_entries = entries;
+    m_totalSize = totalSize;
+
+    return true;
+}
+
+bool DThumbnailIndex::save()
+{
+    QMutexLocker locker(&m_mutex);
+    const QHash<QByteArray, Entry> entries = m_entries;
+    m_changeCount = 0;
+    locker.unlock();
+
+    if (!QDir().mkpath(m_rootPath))
+        return false;
+
+    QSaveFile file(m_rootPath + QDir::separator() + THUMBNAIL_INDEX_FILE_NAME);
+
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    QDataStream stream(&file);
+
+    stream << quint32(THUMBNAIL_INDEX_MAGIC) << quint32(THUMBNAIL_INDEX_VERSION) << qint32(entries.count());
+
+    for (auto it = entries.constBegin(); it != entries.constEnd(); ++it) {
+        stream.writeRawData(it.key().constData(), THUMBNAIL_INDEX_KEY_SIZE);
+        stream << it->sourceModified << it->fileSize << it->lastAccess;
+    }
+
+    return file.commit();
+}
+
+bool DThumbnailIndex::makeKey(const QString &thumbnailPath, QByteArray *key) const
+{
+    const int nameStart = thumbnailPath.lastIndexOf('/') + 1;
+    const int directoryStart = thumbnailPath.lastIndexOf('/', nameStart - 2) + 1;
+
+    if (nameStart <= 0 || directoryStart <= 0 || directoryStart - 1 != m_rootPath.size()
+            || !thumbnailPath.startsWith(m_rootPath))
+        return false;
+
+    const int directory = m_directories.indexOf(thumbnailPath.mid(directoryStart, nameStart - directoryStart - 1));
+    const int suffix = thumbnailPath.indexOf('.', nameStart);
+
+    if (directory < 0 || suffix - nameStart != 32)
+        return false;
+
+    *key = QByteArray::fromHex(thumbnailPath.midRef(nameStart, 32).toLatin1());
+
+    if (key->size() != THUMBNAIL_INDEX_KEY_SIZE - 1)
+        return false;
+
+    key->append(static_cast<char>(directory));
+
+    return true;
+}
+
+QString DThumbnailIndex::keyToPath(const QByteArray &key) const
+{
+    return m_rootPath + QDir::separator() + m_directories.value(key.at(key.size() - 1))
+           + QDir::separator() + QString::fromLatin1(key.left(key.size() - 1).toHex()) + ".png";
+}
+
+// 需持有 m_mutex
+void DThumbnailIndex::entryChanged()
+{
+    ++m_changeCount;
+
+    if (m_gcScheduled)
+        return;
+
+    if (m_changeCount < THUMBNAIL_INDEX_SAVE_INTERVAL && m_totalSize <= m_maxSize && m_entries.count() <= m_maxCount)
+        return;
+
+    startBackgroundTask();
+}
+
+// 需持有 m_mutex
+void DThumbnailIndex::startBackgroundTask()
+{
+    m_gcScheduled = true;
+
+    QThreadPool *pool = thumbnailIndexThreadPool;
+    pool->setMaxThreadCount(1);
+
+    QtConcurrent::run(pool, [this] {
+        QThread::currentThread()->setPriority(QThread::IdlePriority);
+
+        QMutexLocker locker(&m_mutex);
+        const bool needRebuild = m_needRebuild;
+        locker.unlock();
+
+        if (needRebuild)
+            rebuild();
+
+        collectGarbage();
+        save();
+
+        locker.relock();
+        m_gcScheduled = false;
+    });
+}
+
+DFM_END_NAMESPACE
@@ -0,0 +1,77 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DTHUMBNAILINDEX_H
+#define DTHUMBNAILINDEX_H
+
+#include <dfmglobal.h>
+
+#include <QHash>
+#include <QMutex>
+#include <QStringList>
+
+DFM_BEGIN_NAMESPACE
+
+/*!
+ * \brief DThumbnailIndex 缩略图目录的索引
+ *
+ * 记录每个缩略图对应的源文件修改时间、缩略图文件大小和最近访问时间，判断缩略图是否过期时不必读取图片。
+ * 缩略图总大小或数量超出上限时，在后台以最低优先级删除最久未访问的缩略图。
+ */
+class DThumbnailIndex
+{
+public:
+    enum State {
+        Unindexed,  // 索引中没有此缩略图或不知道其源文件的修改时间
+        Valid,      // 缩略图与源文件的修改时间一致
+        Stale       // 源文件已被修改
+    };
+
+    explicit DThumbnailIndex(const QString &rootPath);
+    ~DThumbnailIndex();
+
+    static DThumbnailIndex *instance();
+
+    State check(const QString &thumbnailPath, uint sourceModified);
+    void insert(const QString &thumbnailPath, uint sourceModified, qint64 fileSize);
+    void remove(const QString &thumbnailPath);
+
+    int count() const;
+    qint64 totalSize() const;
+    void setLimits(qint64 maxSize, int maxCount);
+
+    void scheduleGarbageCollection();
+    void collectGarbage();
+    void rebuild();
+
+    bool load();
+    bool save();
+
+private:
+    struct Entry {
+        quint32 sourceModified = 0;
+        quint32 fileSize = 0;
+        quint32 lastAccess = 0;
+    };
+
+    bool makeKey(const QString &thumbnailPath, QByteArray *key) const;
+    QString keyToPath(const QByteArray &key) const;
+    void entryChanged();
+    void startBackgroundTask();
+
+    QString m_rootPath;
+    QStringList m_directories;
+    QHash<QByteArray, Entry> m_entries;
+    qint64 m_totalSize = 0;
+    qint64 m_maxSize;
+    int m_maxCount;
+    int m_changeCount = 0;
+    bool m_needRebuild = false;
+    bool m_gcScheduled = false;
+    mutable QMutex m_mutex;
+};
+
+DFM_END_NAMESPACE
+
+#endif // DTHUMBNAILINDEX_H
@@ -3,30 +3,41 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "dthumbnailprovider.h"
+#include "dthumbnailindex.h"
 #include "dfmstandardpaths.h"
 #include "dmimedatabase.h"
 #include "shutil/fileutils.h"
+#include "shutil/dfmembeddedpreview.h"
+#include "shutil/dfmimagedownscaler.h"
 #include "app/define.h"
 #include "singleton.h"
 #include "shutil/mimetypedisplaymanager.h"
 #include "fileoperations/filejob.h"
 #include "dfmapplication.h"
+#include "dmounttable.h"
+#include "ddeviceaccessscheduler.h"
+#include "dfmtrace.h"
+#include "dfmmetrics.h"
+#include "dfmmemoryaccounting.h"
 
 #include <QUrl>
 #include <QCryptographicHash>
 #include <QDir>
 #include <QDateTime>
 #include <QImageReader>
-#include <QQueue>
+#include <QVector>
+#include <QCache>
 #include <QMimeType>
 #include <QReadWriteLock>
-#include <QWaitCondition>
+#include <QThreadPool>
+#include <QThreadStorage>
 #include <QPainter>
 #include <QDirIterator>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QProcess>
+#include <QTimer>
 #include <QDebug>
 #include <QtConcurrent>
 
@@ -42,12 +53,105 @@
 DFM_BEGIN_NAMESPACE
 
 #define FORMAT ".png"
+// 已解码缩略图的缓存上限，单位为KB
+#define THUMBNAIL_IMAGE_CACHE_MAX_COST (64 * 1024)
+// 等待缩略图工具回复的超时时间
+#define THUMBNAIL_TOOL_TIMEOUT 30000
+// 网络设备上的文件最多读取的字节数，以及请求停止多久后才开始生成
+#define THUMBNAIL_REMOTE_MAX_READ_BYTES (4 * 1024 * 1024)
+#define THUMBNAIL_REMOTE_DEFER_INTERVAL 500
+// 保存缩略图时的 PNG 质量，对应 zlib 的压缩级别 1，缩略图很小，压缩得更紧凑节省的空间不多
+#define THUMBNAIL_PNG_QUALITY 80
 //#define CREATE_VEDIO_THUMB "CreateVedioThumbnail"
 inline QByteArray dataToMd5Hex(const QByteArray &data)
 {
     return QCryptographicHash::hash(data, QCryptographicHash::Md5).toHex();
 }
 
+/*!
+ * \brief The ThumbnailToolServer class 以常驻模式运行的缩略图工具进程
+ *
+ * 进程只能在创建它的线程中使用，每个生成线程各自持有，线程退出时进程随之结束。
+ */
+class ThumbnailToolServer
+{
+public:
+    explicit ThumbnailToolServer(const QString &tool);
+
+    bool request(int size, const QString &filePath, QByteArray *output, QString *error);
+
+private:
+    bool waitForBytes(qint64 count);
+
+    QString m_tool;
+    QProcess m_process;
+};
+
+ThumbnailToolServer::ThumbnailToolServer(const QString &tool)
+    : m_tool(tool)
+{
+    m_process.setStandardErrorFile(QProcess::nullDevice());
+}
+
+/*!
+ * \brief ThumbnailToolServer::request 请求生成缩略图
+ * \param output 生成成功时为base64编码的png图片
+ * \param error 工具无法生成此文件的缩略图时为错误信息
+ * \return 工具进程无法启动或无响应时返回false
+ */
+bool ThumbnailToolServer::request(int size, const QString &filePath, QByteArray *output, QString *error)
+{
+    if (m_process.state() != QProcess::Running) {
+        m_process.start(m_tool, {"--server"});
+
+        if (!m_process.waitForStarted(THUMBNAIL_TOOL_TIMEOUT))
+            return false;
+    }
+
+    const QByteArray &path = QFile::encodeName(filePath);
+    m_process.write(QByteArray::number(size) + ' ' + QByteArray::number(path.size()) + '\n' + path);
+
+    while (!m_process.canReadLine()) {
+        if (!waitForBytes(m_process.bytesAvailable() + 1))
+            return false;
+    }
+
+    const QList<QByteArray> &header = m_process.readLine().trimmed().split(' ');
+    bool ok = false;
+    const qint64 length = header.value(1).toLongLong(&ok);
+
+    if (header.size() != 2 || !ok || !waitForBytes(length)) {
+        m_process.kill();
+        m_process.waitForFinished();
+
+        return false;
+    }
+
+    const QByteArray &data = m_process.read(length);
+
+    if (header.first() == "0")
+        *output = data;
+    else
+        *error = QString::fromLocal8Bit(data);
+
+    return true;
+}
+
+bool ThumbnailToolServer::waitForBytes(qint64 count)
+{
+    while (m_process.bytesAvailable() < count) {
+        // 进程无响应时结束它，下次请求时重新启动
+        if (!m_process.waitForReadyRead(THUMBNAIL_TOOL_TIMEOUT)) {
+            m_process.kill();
+            m_process.waitForFinished();
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
 class DThumbnailProviderPrivate
 {
 public:
@@ -58,44 +162,102 @@ public:
     QString sizeToFilePath(DThumbnailProvider::Size size) const;
 
     DThumbnailProvider *q_ptr;
-    QString errorString;
-    // 5MB
-    qint64 defaultSizeLimit = 1024 * 1024 * 20;
-    QHash<QMimeType, qint64> sizeLimitHash;
+
+    struct DevicePolicy {
+        qint64 defaultSizeLimit = 1024 * 1024 * 20;
+        QHash<QMimeType, qint64> sizeLimitHash;
+        // 大于0时只从文件头部或内嵌预览图生成缩略图，每个文件最多读取的字节数
+        qint64 maxReadBytes = 0;
+        // 请求停止一段时间后才开始生成，避免滚动视图时读取大量文件
+        bool deferred = false;
+    };
+
+    DevicePolicy devicePolicies[DThumbnailProvider::DeviceClassCount];
     DMimeDatabase mimeDatabase;
 
     static QSet<QString> hasThumbnailMimeHash;
+    static QReadWriteLock hasThumbnailMimeLock;
+
+    typedef QPair<QString, DThumbnailProvider::Size> ProduceKey;
 
     struct ProduceInfo {
         QFileInfo fileInfo;
         DThumbnailProvider::Size size;
-        DThumbnailProvider::CallBack callback;
+        DThumbnailProvider::Priority priority;
+        // 同一文件的多次请求合并为一个任务，生成结束后依次回调
+        QList<DThumbnailProvider::CallBack> callbacks;
+        bool producing = false;
+        // 在 deferredInfos 中等待视图空闲
+        bool deferred = false;
+        // 在 produceHeap 中的位置，不在堆中时为-1
+        int heapIndex = -1;
+        // 同一优先级的任务按加入的顺序生成
+        quint64 sequence = 0;
     };
 
-    QQueue<ProduceInfo> produceQueue;
-    QQueue<QString> m_produceAbsoluteFilePathQueue;
-    QSet<QPair<QString, DThumbnailProvider::Size>> discardedProduceInfos;
+    static bool produceBefore(const ProduceInfo &left, const ProduceInfo &right);
+    void pushProduceInfo(const QSharedPointer<ProduceInfo> &info);
+    void removeProduceInfo(const QSharedPointer<ProduceInfo> &info);
+    void updateProduceInfo(const QSharedPointer<ProduceInfo> &info);
+    void siftUp(int index);
+    void siftDown(int index);
+    QSharedPointer<ProduceInfo> takeProduceInfo();
+    void startDeferredInfos();
+    void startWorker();
+    void processProduceQueue();
+    QString thumbnailTool(const QString &mimeName);
+    bool requestToolServer(const QString &tool, int size, const QString &filePath, QByteArray *output, QString *error);
+    void insertImageCache(const QString &key, const QImage &image) const;
+
+    // 等待生成和正在生成的任务
+    QHash<ProduceKey, QSharedPointer<ProduceInfo>> produceInfos;
+    // 等待生成的任务按优先级组成的二叉堆
+    QVector<QSharedPointer<ProduceInfo>> produceHeap;
+    quint64 produceSequence = 0;
+    // 网络设备上等待视图空闲后再生成的任务
+    QList<QSharedPointer<ProduceInfo>> deferredInfos;
+    QTimer *deferTimer = nullptr;
 
     bool running = true;
+    int activeWorkerCount = 0;
 
-    QWaitCondition waitCondition;
+    // 需在 workerPool 之后析构，生成线程退出时才能结束各自的工具进程
+    QThreadStorage<QHash<QString, QSharedPointer<ThumbnailToolServer>>> toolServers;
+    QThreadPool workerPool;
     QReadWriteLock dataReadWriteLock;
+    QThreadStorage<QString> errorString;
+
+    // 各个视图和窗口共用的已解码缩略图，以缩略图文件和源文件的修改时间为键
+    mutable QCache<QString, QImage> imageCache;
+    mutable QMutex imageCacheMutex;
 
     QHash<QString, QString> keyToThumbnailTool;
+    // 支持常驻模式的工具
+    QSet<QString> serverThumbnailTools;
+    QMutex thumbnailToolMutex;
+    // 外部库提供的缩略图接口不保证线程安全，需串行调用
+    QMutex externalProviderMutex;
 
     Q_DECLARE_PUBLIC(DThumbnailProvider)
 };
 
 QSet<QString> DThumbnailProviderPrivate::hasThumbnailMimeHash;
+QReadWriteLock DThumbnailProviderPrivate::hasThumbnailMimeLock;
 
 DThumbnailProviderPrivate::DThumbnailProviderPrivate(DThumbnailProvider *qq)
     : q_ptr(qq)
+    , imageCache(THUMBNAIL_IMAGE_CACHE_MAX_COST)
 {
-
+    // 每个核心一个生成线程，解码大图时不再只占用一个核心
+    workerPool.setMaxThreadCount(qMax(QThread::idealThreadCount(), 1));
 }
 
 void DThumbnailProviderPrivate::init()
 {
+    Q_Q(DThumbnailProvider);
+
+    QHash<QMimeType, qint64> &sizeLimitHash = devicePolicies[DThumbnailProvider::LocalDevice].sizeLimitHash;
+
     sizeLimitHash.reserve(28);
     sizeLimitHash.insert(mimeDatabase.mimeTypeForName("text/plain"), 1024 * 1024);
     sizeLimitHash.insert(mimeDatabase.mimeTypeForName("application/pdf"), INT64_MAX);
@@ -113,9 +275,35 @@ void DThumbnailProviderPrivate::init()
     sizeLimitHash.insert(mimeDatabase.mimeTypeForName("image/jpeg"), 1024 * 1024 * 30);
     sizeLimitHash.insert(mimeDatabase.mimeTypeForName("image/png"), 1024 * 1024 * 30);
     sizeLimitHash.insert(mimeDatabase.mimeTypeForName("image/pipeg"), 1024 * 1024 * 30);
+    // RAW 文件只读取内嵌的预览图
+    for (const QString &rawType : {"image/x-canon-cr2", "image/x-nikon-nef", "image/x-sony-arw", "image/x-olympus-orf",
+                                   "image/x-panasonic-rw2", "image/x-pentax-pef", "image/x-fuji-raf"}) {
+        sizeLimitHash.insert(mimeDatabase.mimeTypeForName(rawType), 1024 * 1024 * 80);
+    }
 
     // High file limit size only for FLAC files.
     sizeLimitHash.insert(mimeDatabase.mimeTypeForName("audio/flac"), INT64_MAX);
+
+    // 网络设备上只解码较小的文件，JPEG 和 RAW 文件只读取内嵌的预览图，文本文件只读取开头部分，不限制文件大小
+    DevicePolicy &remotePolicy = devicePolicies[DThumbnailProvider::RemoteDevice];
+    remotePolicy.defaultSizeLimit = 1024 * 1024 * 2;
+    remotePolicy.maxReadBytes = THUMBNAIL_REMOTE_MAX_READ_BYTES;
+    remotePolicy.deferred = true;
+    remotePolicy.sizeLimitHash.insert(mimeDatabase.mimeTypeForName("text/plain"), INT64_MAX);
+    remotePolicy.sizeLimitHash.insert(mimeDatabase.mimeTypeForName("image/jpeg"), INT64_MAX);
+    remotePolicy.sizeLimitHash.insert(mimeDatabase.mimeTypeForName("image/png"), 1024 * 1024 * 4);
+    for (const QString &rawType : {"image/x-canon-cr2", "image/x-nikon-nef", "image/x-sony-arw", "image/x-olympus-orf",
+                                   "image/x-panasonic-rw2", "image/x-pentax-pef", "image/x-fuji-raf", "image/x-adobe-dng"}) {
+        remotePolicy.sizeLimitHash.insert(mimeDatabase.mimeTypeForName(rawType), INT64_MAX);
+    }
+
+    deferTimer = new QTimer(q);
+    deferTimer->setSingleShot(true);
+    deferTimer->setInterval(THUMBNAIL_REMOTE_DEFER_INTERVAL);
+    QObject::connect(deferTimer, &QTimer::timeout, q, [this] {
+        QWriteLocker locker(&dataReadWriteLock);
+        startDeferredInfos();
+    });
 }
 
 QString DThumbnailProviderPrivate::sizeToFilePath(DThumbnailProvider::Size size) const
@@ -131,6 +319,202 @@ QString DThumbnailProviderPrivate::sizeToFilePath(DThumbnailProvider::Size size)
     return ""; //默认返回空字符 warning项
 }
 
+bool DThumbnailProviderPrivate::produceBefore(const DThumbnailProviderPrivate::ProduceInfo &left, const DThumbnailProviderPrivate::ProduceInfo &right)
+{
+    if (left.priority != right.priority)
+        return left.priority < right.priority;
+
+    return left.sequence < right.sequence;
+}
+
+/*!
+ * \brief DThumbnailProviderPrivate::pushProduceInfo 加入待生成的任务，以下操作均需持有 dataReadWriteLock
+ */
+void DThumbnailProviderPrivate::pushProduceInfo(const QSharedPointer<DThumbnailProviderPrivate::ProduceInfo> &info)
+{
+    info->sequence = produceSequence++;
+    info->heapIndex = produceHeap.size();
+    produceHeap.append(info);
+    siftUp(info->heapIndex);
+}
+
+void DThumbnailProviderPrivate::removeProduceInfo(const QSharedPointer<DThumbnailProviderPrivate::ProduceInfo> &info)
+{
+    const int index = info->heapIndex;
+
+    if (index < 0)
+        return;
+
+    info->heapIndex = -1;
+
+    const QSharedPointer<ProduceInfo> last = produceHeap.takeLast();
+
+    if (index == produceHeap.size())
+        return;
+
+    produceHeap[index] = last;
+    last->heapIndex = index;
+    updateProduceInfo(last);
+}
+
+/*!
+ * \brief DThumbnailProviderPrivate::updateProduceInfo 任务的优先级改变后调整其在堆中的位置
+ */
+void DThumbnailProviderPrivate::updateProduceInfo(const QSharedPointer<DThumbnailProviderPrivate::ProduceInfo> &info)
+{
+    if (info->heapIndex < 0)
+        return;
+
+    siftUp(info->heapIndex);
+    siftDown(info->heapIndex);
+}
+
+void DThumbnailProviderPrivate::siftUp(int index)
+{
+    const QSharedPointer<ProduceInfo> info = produceHeap.at(index);
+
+    while (index > 0) {
+        const int parent = (index - 1) / 2;
+
+        if (!produceBefore(*info, *produceHeap.at(parent)))
+            break;
+
+        produceHeap[index] = produceHeap.at(parent);
+        produceHeap.at(index)->heapIndex = index;
+        index = parent;
+    }
+
+    produceHeap[index] = info;
+    info->heapIndex = index;
+}
+
+void DThumbnailProviderPrivate::siftDown(int index)
+{
+    const QSharedPointer<ProduceInfo> info = produceHeap.at(index);
+    const int size = produceHeap.size();
+
+    forever {
+        int child = index * 2 + 1;
+
+        if (child >= size)
+            break;
+
+        if (child + 1 < size && produceBefore(*produceHeap.at(child + 1), *produceHeap.at(child)))
+            ++child;
+
+        if (!produceBefore(*produceHeap.at(child), *info))
+            break;
+
+        produceHeap[index] = produceHeap.at(child);
+        produceHeap.at(index)->heapIndex = index;
+        index = child;
+    }
+
+    produceHeap[index] = info;
+    info->heapIndex = index;
+}
+
+/*!
+ * \brief DThumbnailProviderPrivate::takeProduceInfo 取出优先级最高的待生成任务
+ */
+QSharedPointer<DThumbnailProviderPrivate::ProduceInfo> DThumbnailProviderPrivate::takeProduceInfo()
+{
+    if (produceHeap.isEmpty())
+        return QSharedPointer<ProduceInfo>();
+
+    const QSharedPointer<ProduceInfo> info = produceHeap.first();
+    removeProduceInfo(info);
+
+    return info;
+}
+
+/*!
+ * \brief DThumbnailProviderPrivate::startDeferredInfos 视图空闲后开始生成网络设备上的文件，需持有 dataReadWriteLock
+ */
+void DThumbnailProviderPrivate::startDeferredInfos()
+{
+    if (!running)
+        return;
+
+    for (const QSharedPointer<ProduceInfo> &info : deferredInfos) {
+        info->deferred = false;
+        pushProduceInfo(info);
+        startWorker();
+    }
+
+    deferredInfos.clear();
+}
+
+void DThumbnailProviderPrivate::insertImageCache(const QString &key, const QImage &image) const
+{
+    QMutexLocker locker(&imageCacheMutex);
+
+    imageCache.insert(key, new QImage(image), qMax(1, image.width() * image.height() * image.depth() / 8 / 1024));
+}
+
+bool DThumbnailProviderPrivate::requestToolServer(const QString &tool, int size, const QString &filePath, QByteArray *output, QString *error)
+{
+    QMutexLocker locker(&thumbnailToolMutex);
+
+    if (!serverThumbnailTools.contains(tool))
+        return false;
+
+    locker.unlock();
+
+    QSharedPointer<ThumbnailToolServer> &server = toolServers.localData()[tool];
+
+    if (!server)
+        server.reset(new ThumbnailToolServer(tool));
+
+    return server->request(size, filePath, output, error);
+}
+
+/*!
+ * \brief DThumbnailProviderPrivate::startWorker 生成线程不足时启动新的线程，需持有 dataReadWriteLock
+ */
+void DThumbnailProviderPrivate::startWorker()
+{
+    if (activeWorkerCount >= workerPool.maxThreadCount())
+        return;
+
+    ++activeWorkerCount;
+    QtConcurrent::run(&workerPool, [this] {
+        processProduceQueue();
+    });
+}
+
+void DThumbnailProviderPrivate::processProduceQueue()
+{
+    Q_Q(DThumbnailProvider);
+
+    forever {
+        QWriteLocker locker(&dataReadWriteLock);
+
+        const QSharedPointer<ProduceInfo> task = running ? takeProduceInfo() : QSharedPointer<ProduceInfo>();
+
+        // 队列为空时线程退出，有新任务时再启动
+        if (!task) {
+            --activeWorkerCount;
+            return;
+        }
+
+        task->producing = true;
+        locker.unlock();
+
+        const QString &thumbnail = q->createThumbnail(task->fileInfo, task->size);
+
+        locker.relock();
+        produceInfos.remove(qMakePair(task->fileInfo.absoluteFilePath(), task->size));
+        const QList<DThumbnailProvider::CallBack> callbacks = task->callbacks;
+        locker.unlock();
+
+        for (const DThumbnailProvider::CallBack &callback : callbacks) {
+            if (callback)
+                callback(thumbnail);
+        }
+    }
+}
+
 class DFileThumbnailProviderPrivate : public DThumbnailProvider {};
 Q_GLOBAL_STATIC(DFileThumbnailProviderPrivate, ftpGlobal)
 
@@ -139,6 +523,22 @@ DThumbnailProvider *DThumbnailProvider::instance()
     return ftpGlobal;
 }
 
+/*!
+ * \brief DThumbnailProvider::deviceClass 按文件所在的挂载点区分生成策略
+ */
+DThumbnailProvider::DeviceClass DThumbnailProvider::deviceClass(const QString &filePath)
+{
+    switch (DMountTable::instance()->mountClass(filePath)) {
+    case DMountTable::LowSpeedGvfsMount:
+    case DMountTable::NetworkMount:
+        return RemoteDevice;
+    default:
+        break;
+    }
+
+    return LocalDevice;
+}
+
 bool DThumbnailProvider::hasThumbnail(const QFileInfo &info) const
 {
     Q_D(const DThumbnailProvider);
@@ -159,7 +559,12 @@ bool DThumbnailProvider::hasThumbnail(const QFileInfo &info) const
     if (mime.name().startsWith("video/") && FileUtils::isGvfsMountFile(info.absoluteFilePath()))
         return false;
 
-    if (fileSize > sizeLimit(mime) && !mime.name().startsWith("video/"))
+    // MTP 设备串行处理请求，读取文件生成缩略图会拖慢目录的遍历和文件的拷贝
+    if (!DDeviceAccessScheduler::deviceOf(info.absoluteFilePath()).isEmpty()
+            && !DFMApplication::genericAttribute(DFMApplication::GA_MTPShowThumbnail).toBool())
+        return false;
+
+    if (fileSize > sizeLimit(mime, deviceClass(info.absoluteFilePath())) && !mime.name().startsWith("video/"))
         return false;
 
     return hasThumbnail(mime);
@@ -192,10 +597,15 @@ bool DThumbnailProvider::hasThumbnail(const QMimeType &mimeType) const
         return false;
     }
 
+    QReadLocker locker(&DThumbnailProviderPrivate::hasThumbnailMimeLock);
+
     if (DThumbnailProviderPrivate::hasThumbnailMimeHash.contains(mime))
         return true;
 
+    locker.unlock();
+
     if (Q_LIKELY(mime.startsWith("image") || mime.startsWith("audio/") || mime.startsWith("video/"))) {
+        QWriteLocker writeLocker(&DThumbnailProviderPrivate::hasThumbnailMimeLock);
         DThumbnailProviderPrivate::hasThumbnailMimeHash.insert(mime);
         return true;
     }
@@ -205,6 +615,7 @@ bool DThumbnailProvider::hasThumbnail(const QMimeType &mimeType) const
                  || mime == "application/vnd.rn-realmedia"
                  || mime == "application/vnd.ms-asf"
                  || mime == "application/mxf")) {
+        QWriteLocker writeLocker(&DThumbnailProviderPrivate::hasThumbnailMimeLock);
         DThumbnailProviderPrivate::hasThumbnailMimeHash.insert(mime);
 
         return true;
@@ -239,14 +650,40 @@ QPixmap DThumbnailProvider::thumbnailPixmap(const QFileInfo &info, Size size) co
     const QString thumbnailName = dataToMd5Hex((QUrl::fromLocalFile(absoluteFilePath).
                                                 toString(QUrl::FullyEncoded) + QString::number(inode)).toLocal8Bit()) + FORMAT;
     QString thumbnail = d->sizeToFilePath(size) + QDir::separator() + thumbnailName;
+    const uint lastModified = info.lastModified().toTime_t();
+    const QString &cacheKey = thumbnail + QLatin1Char(':') + QString::number(lastModified);
+    DThumbnailIndex *thumbnailIndex = DThumbnailIndex::instance();
+    const DThumbnailIndex::State state = thumbnailIndex->check(thumbnail, lastModified);
+
+    // 源文件已被修改，不必读取缩略图即可判断其已过期
+    if (state == DThumbnailIndex::Stale) {
+        QFile::remove(thumbnail);
+        thumbnailIndex->remove(thumbnail);
+
+        emit thumbnailChanged(absoluteFilePath, QString());
+
+        return QPixmap();
+    }
+
+    QMutexLocker cacheLocker(&d->imageCacheMutex);
+
+    if (const QImage *image = d->imageCache.object(cacheKey)) {
+        DFM_METRIC_INC("thumbnail.cacheHit");
+        return QPixmap::fromImage(*image);
+    }
+
+    cacheLocker.unlock();
+    DFM_METRIC_INC("thumbnail.cacheMiss");
 
     if (!QFile::exists(thumbnail)) {
+        thumbnailIndex->remove(thumbnail);
         return QPixmap();
     }
 
     QImageReader ir(thumbnail, QByteArray(FORMAT).mid(1));
     if (!ir.canRead()) {
         QFile::remove(thumbnail);
+        thumbnailIndex->remove(thumbnail);
         emit thumbnailChanged(absoluteFilePath, QString());
         return QPixmap();
     }
@@ -254,14 +691,23 @@ QPixmap DThumbnailProvider::thumbnailPixmap(const QFileInfo &info, Size size) co
 
     const QImage image = ir.read();
 
-    if (!image.isNull() && image.text(QT_STRINGIFY(Thumb::MTime)).toInt() != (int)info.lastModified().toTime_t()) {
+    if (!image.isNull() && image.text(QT_STRINGIFY(Thumb::MTime)).toInt() != (int)lastModified) {
         QFile::remove(thumbnail);
+        thumbnailIndex->remove(thumbnail);
 
         emit thumbnailChanged(absoluteFilePath, QString());
 
         return QPixmap();
     }
 
+    if (!image.isNull()) {
+        d->insertImageCache(cacheKey, image);
+
+        // 之前未记录的缩略图已验证过修改时间，以后不必再读取图片验证
+        if (state == DThumbnailIndex::Unindexed)
+            thumbnailIndex->insert(thumbnail, lastModified, ir.device()->size());
+    }
+
     return QPixmap::fromImage(image);
 }
 
@@ -275,11 +721,70 @@ static QString generalKey(const QString &key)
     return key;
 }
 
+/*!
+ * \brief DThumbnailProviderPrivate::thumbnailTool 获取生成指定类型缩略图的外部工具
+ */
+QString DThumbnailProviderPrivate::thumbnailTool(const QString &mimeName)
+{
+    // 多个线程同时生成缩略图，工具列表只初始化一次
+    QMutexLocker locker(&thumbnailToolMutex);
+
+    if (keyToThumbnailTool.isEmpty()) {
+        keyToThumbnailTool["Initialized"] = QString();
+
+        for (const QString &path : QString(TOOLDIR).split(":")) {
+            const QString &thumbnail_tool_path = path + QDir::separator() + "/thumbnail";
+            QDirIterator dir(thumbnail_tool_path, {"*.json"}, QDir::NoDotAndDotDot | QDir::Files);
+
+            while (dir.hasNext()) {
+                const QString &file_path = dir.next();
+                const QFileInfo &file_info = dir.fileInfo();
+
+                QFile file(file_path);
+
+                if (!file.open(QFile::ReadOnly)) {
+                    continue;
+                }
+
+                const QJsonDocument document = QJsonDocument::fromJson(file.readAll());
+                file.close();
+
+                const QStringList keys = document.object().toVariantMap().value("Keys").toStringList();
+                const QString &tool_file_path = file_info.absoluteDir().filePath(file_info.baseName());
+
+                if (!QFile::exists(tool_file_path)) {
+                    continue;
+                }
+
+                if (document.object().value("Server").toBool())
+                    serverThumbnailTools << tool_file_path;
+
+                for (const QString &key : keys) {
+                    if (keyToThumbnailTool.contains(key))
+                        continue;
+
+                    keyToThumbnailTool[key] = tool_file_path;
+                }
+            }
+        }
+    }
+
+    const QString &tool = keyToThumbnailTool.value(mimeName);
+
+    if (!tool.isEmpty())
+        return tool;
+
+    return keyToThumbnailTool.value(generalKey(mimeName));
+}
+
 QString DThumbnailProvider::createThumbnail(const QFileInfo &info, DThumbnailProvider::Size size)
 {
+    DFM_TRACE_SPAN("thumbnail", "createThumbnail");
     Q_D(DThumbnailProvider);
 
-    d->errorString.clear();
+    // 多个线程同时生成缩略图，错误信息按线程保存
+    QString &errorString = d->errorString.localData();
+    errorString.clear();
 
     const QString &absolutePath = info.absolutePath();
     const QString &absoluteFilePath = info.absoluteFilePath();
@@ -292,12 +797,16 @@ QString DThumbnailProvider::createThumbnail(const QFileInfo &info, DThumbnailPro
     }
 
     if (!hasThumbnail(info)) {
-        d->errorString = QStringLiteral("This file has not support thumbnail: ") + absoluteFilePath;
+        errorString = QStringLiteral("This file has not support thumbnail: ") + absoluteFilePath;
 
         //!Warnning: Do not store thumbnails to the fail path
         return QString();
     }
 
+    // MTP 设备上等目录遍历完成后再读取文件
+    const DDeviceAccessScheduler::Access deviceAccess(DDeviceAccessScheduler::deviceOf(absoluteFilePath),
+                                                      DDeviceAccessScheduler::ThumbnailPriority);
+
     const QString fileUrl = QUrl::fromLocalFile(absoluteFilePath).toString(QUrl::FullyEncoded);
     struct stat st;
     ulong inode = 0;
@@ -309,16 +818,14 @@ QString DThumbnailProvider::createThumbnail(const QFileInfo &info, DThumbnailPro
 
     // the file is in fail path
     QString thumbnail = DFMStandardPaths::location(DFMStandardPaths::ThumbnailFailPath) + QDir::separator() + thumbnailName;
+    const uint lastModified = info.lastModified().toTime_t();
 
-    //    if (QFile::exists(thumbnail)) {
-    //        QImage image(thumbnail);
+    // 源文件修改前不再重复生成失败过的缩略图
+    if (DThumbnailIndex::instance()->check(thumbnail, lastModified) == DThumbnailIndex::Valid) {
+        errorString = QStringLiteral("Failed to create thumbnail before: ") + absoluteFilePath;
 
-    //        if (image.text(QT_STRINGIFY(Thumb::MTime)).toInt() != (int)info.lastModified().toTime_t()) {
-    //            QFile::remove(thumbnail);
-    //        } else {
-    //            return QString();
-    //        }
-    //    }// end
+        return QString();
+    }
 
     QMimeType mime = d->mimeDatabase.mimeTypeForFile(info);
     QScopedPointer<QImage> image(new QImage());
@@ -328,10 +835,13 @@ QString DThumbnailProvider::createThumbnail(const QFileInfo &info, DThumbnailPro
 
     //! 新增djvu格式文件缩略图预览
     if (mime.name().contains("image/vnd.djvu")) {
-        thumbnail = DTK_GUI_NAMESPACE::DThumbnailProvider::instance()->createThumbnail(info, (DTK_GUI_NAMESPACE::DThumbnailProvider::Size)size);
-        d->errorString = DTK_GUI_NAMESPACE::DThumbnailProvider::instance()->errorString();
+        {
+            QMutexLocker locker(&d->externalProviderMutex);
+            thumbnail = DTK_GUI_NAMESPACE::DThumbnailProvider::instance()->createThumbnail(info, (DTK_GUI_NAMESPACE::DThumbnailProvider::Size)size);
+            errorString = DTK_GUI_NAMESPACE::DThumbnailProvider::instance()->errorString();
+        }
 
-        if (d->errorString.isEmpty()) {
+        if (errorString.isEmpty()) {
             emit createThumbnailFinished(absoluteFilePath, thumbnail);
             emit thumbnailChanged(absoluteFilePath, thumbnail);
 
@@ -349,7 +859,7 @@ QString DThumbnailProvider::createThumbnail(const QFileInfo &info, DThumbnailPro
             process.start(readerBinary, arguments);
 
             if (!process.waitForFinished()) {
-                d->errorString = process.errorString();
+                errorString = process.errorString();
 
                 goto _return;
             }
@@ -358,9 +868,9 @@ QString DThumbnailProvider::createThumbnail(const QFileInfo &info, DThumbnailPro
                 const QString &error = process.readAllStandardError();
 
                 if (error.isEmpty()) {
-                    d->errorString = QString("get thumbnail failed from the \"%1\" application").arg(readerBinary);
+                    errorString = QString("get thumbnail failed from the \"%1\" application").arg(readerBinary);
                 } else {
-                    d->errorString = error;
+                    errorString = error;
                 }
 
                 goto _return;
@@ -373,7 +883,7 @@ QString DThumbnailProvider::createThumbnail(const QFileInfo &info, DThumbnailPro
                 Q_ASSERT(!output.isEmpty());
 
                 if (image->loadFromData(output, "png")) {
-                    d->errorString.clear();
+                    errorString.clear();
                 }
                 file.close();
             }
@@ -387,11 +897,25 @@ QString DThumbnailProvider::createThumbnail(const QFileInfo &info, DThumbnailPro
         //! fix bug #53200 QImageReader构造时不传format参数，会造成没有读取不了真实的文件 类型比如将png图标后缀修改为jpg，读取的类型不对
 
         QString mimeType = d->mimeDatabase.mimeTypeForFile(info, QMimeDatabase::MatchContent).name();
+        const qint64 maxReadBytes = d->devicePolicies[deviceClass(absoluteFilePath)].maxReadBytes;
+
+        // 相机 RAW 文件内嵌的预览图和足够大的 EXIF 缩略图可直接使用，不必解码完整的图片
+        // 多数 RAW 格式基于 TIFF，只按内容判断时会被识别为 image/tiff
+        if (DFMEmbeddedPreview::loadPreview(absoluteFilePath, DFMEmbeddedPreview::isRawImage(mime.name()) ? mime.name() : mimeType,
+                                            size, image.data(), maxReadBytes))
+            goto _return;
+
+        // 网络设备上的文件没有可用的预览图时，不读取整个大文件
+        if (maxReadBytes > 0 && info.size() > maxReadBytes) {
+            errorString = QStringLiteral("No embedded preview in the remote file: ") + absoluteFilePath;
+            goto _return;
+        }
+
         QString suffix = mimeType.replace("image/", "");
 
         QImageReader reader(absoluteFilePath, suffix.toLatin1());
         if (!reader.canRead()) {
-            d->errorString = reader.errorString();
+            errorString = reader.errorString();
             goto _return;
         }
 
@@ -400,30 +924,33 @@ QString DThumbnailProvider::createThumbnail(const QFileInfo &info, DThumbnailPro
         //fix 读取损坏icns文件（可能任意损坏的image类文件也有此情况）在arm平台上会导致递归循环的问题
         //这里先对损坏文件（imagesize无效）做处理，不再尝试读取其image数据
         if (!imageSize.isValid()) {
-            d->errorString = "Fail to read image file attribute data:" + info.absoluteFilePath();
+            errorString = "Fail to read image file attribute data:" + info.absoluteFilePath();
             goto _return;
         }
 
-        if (imageSize.width() > size || imageSize.height() > size || mime.name() == "image/svg+xml") {
+        // JPEG 等支持缩放读取的格式在解码时缩小（JPEG 在 DCT 域缩放），
+        // 其它格式由 QImageReader 在解码后做整张图片的平滑缩放，改为解码后用 DFMImageDownscaler 缩小
+        if ((imageSize.width() > size || imageSize.height() > size || mime.name() == "image/svg+xml")
+                && reader.supportsOption(QImageIOHandler::ScaledSize)) {
             reader.setScaledSize(reader.size().scaled(size, size, Qt::KeepAspectRatio));
         }
 
         reader.setAutoTransform(true);
 
         if (!reader.read(image.data())) {
-            d->errorString = reader.errorString();
+            errorString = reader.errorString();
             goto _return;
         }
 
         if (image->width() > size || image->height() > size) {
-            image->operator =(image->scaled(size, size, Qt::KeepAspectRatio));
+            image->operator =(DFMImageDownscaler::downscale(*image, size));
         }
     } else if (mime.name() == "text/plain") {
         //FIXME(zccrs): This should be done using the image plugin?
         QFile file(absoluteFilePath);
 
         if (!file.open(QIODevice::ReadOnly)) {
-            d->errorString = file.errorString();
+            errorString = file.errorString();
             goto _return;
         }
 
@@ -452,19 +979,19 @@ QString DThumbnailProvider::createThumbnail(const QFileInfo &info, DThumbnailPro
         QScopedPointer<poppler::document> doc(poppler::document::load_from_file(absoluteFilePath.toStdString()));
 
         if (!doc || doc->is_locked()) {
-            d->errorString = QStringLiteral("Cannot read this pdf file: ") + absoluteFilePath;
+            errorString = QStringLiteral("Cannot read this pdf file: ") + absoluteFilePath;
             goto _return;
         }
 
         if (doc->pages() < 1) {
-            d->errorString = QStringLiteral("This stream is invalid");
+            errorString = QStringLiteral("This stream is invalid");
             goto _return;
         }
 
         QScopedPointer<const poppler::page> page(doc->create_page(0));
 
         if (!page) {
-            d->errorString = QStringLiteral("Cannot get this page at index 0");
+            errorString = QStringLiteral("Cannot get this page at index 0");
             goto _return;
         }
 
@@ -475,7 +1002,7 @@ QString DThumbnailProvider::createThumbnail(const QFileInfo &info, DThumbnailPro
         poppler::image imageData = pr.render_page(page.data(), 72, 72, -1, -1, -1, size);
 
         if (!imageData.is_valid()) {
-            d->errorString = QStringLiteral("Render error");
+            errorString = QStringLiteral("Render error");
             goto _return;
         }
 
@@ -484,7 +1011,7 @@ QString DThumbnailProvider::createThumbnail(const QFileInfo &info, DThumbnailPro
 
         switch (format) {
         case poppler::image::format_invalid:
-            d->errorString = QStringLiteral("Image format is invalid");
+            errorString = QStringLiteral("Image format is invalid");
             goto _return;
         case poppler::image::format_mono:
             img = QImage((uchar *)imageData.data(), imageData.width(), imageData.height(), QImage::Format_Mono);
@@ -500,7 +1027,7 @@ QString DThumbnailProvider::createThumbnail(const QFileInfo &info, DThumbnailPro
         }
 
         if (img.isNull()) {
-            d->errorString = QStringLiteral("Render error");
+            errorString = QStringLiteral("Render error");
             goto _return;
         }
 
@@ -518,16 +1045,16 @@ QString DThumbnailProvider::createThumbnail(const QFileInfo &info, DThumbnailPro
                      QIODevice::ReadOnly);
 
         if (!ffmpeg.waitForFinished()) {
-            d->errorString = ffmpeg.errorString();
+            errorString = ffmpeg.errorString();
             goto _return;
         }
 
         const QByteArray output = ffmpeg.readAllStandardOutput();
 
         if (image->loadFromData(output)) {
-            d->errorString.clear();
+            errorString.clear();
         } else {
-            d->errorString = QString("load image failed from the ffmpeg application");
+            errorString = QString("load image failed from the ffmpeg application");
         }
     } else {
         //显式调用库函数getMovieCover获取视频缩略图，以兼容文管旧版本
@@ -539,7 +1066,9 @@ QString DThumbnailProvider::createThumbnail(const QFileInfo &info, DThumbnailPro
             if(func){//存在导出函数getMovieCover
                 auto url = QUrl::fromLocalFile(absoluteFilePath);
                 QImage img;
+                QMutexLocker locker(&d->externalProviderMutex);
                 func(url,absolutePath,&img);//调用getMovieCover生成缩略图
+                locker.unlock();
                 if(!img.isNull()){
                     *image = img;
                     thumnailCreatedByMovieLib = true;
@@ -547,91 +1076,64 @@ QString DThumbnailProvider::createThumbnail(const QFileInfo &info, DThumbnailPro
             }
         }
         if(thumnailCreatedByMovieLib){//调用库函数getMovieCover提取缩略图成功
-            d->errorString.clear();
+            errorString.clear();
         }else{//若调用库函数getMovieCover提取缩略图失败，下面走旧逻辑
-            thumbnail = DTK_GUI_NAMESPACE::DThumbnailProvider::instance()->createThumbnail(info, (DTK_GUI_NAMESPACE::DThumbnailProvider::Size)size);
-            d->errorString = DTK_GUI_NAMESPACE::DThumbnailProvider::instance()->errorString();
-            if (d->errorString.isEmpty()) {
+            {
+                QMutexLocker locker(&d->externalProviderMutex);
+                thumbnail = DTK_GUI_NAMESPACE::DThumbnailProvider::instance()->createThumbnail(info, (DTK_GUI_NAMESPACE::DThumbnailProvider::Size)size);
+                errorString = DTK_GUI_NAMESPACE::DThumbnailProvider::instance()->errorString();
+            }
+            if (errorString.isEmpty()) {
                 emit createThumbnailFinished(absoluteFilePath, thumbnail);
                 emit thumbnailChanged(absoluteFilePath, thumbnail);
                 return thumbnail;
             } else { // fallback to thumbnail tool
-                if (d->keyToThumbnailTool.isEmpty()) {
-                    d->keyToThumbnailTool["Initialized"] = QString();
-
-                    for (const QString &path : QString(TOOLDIR).split(":")) {
-                        const QString &thumbnail_tool_path = path + QDir::separator() + "/thumbnail";
-                        QDirIterator dir(thumbnail_tool_path, {"*.json"}, QDir::NoDotAndDotDot | QDir::Files);
-
-                        while (dir.hasNext()) {
-                            const QString &file_path = dir.next();
-                            const QFileInfo &file_info = dir.fileInfo();
-
-                            QFile file(file_path);
-
-                            if (!file.open(QFile::ReadOnly)) {
-                                continue;
-                            }
+                const QString &tool = d->thumbnailTool(mime.name());
 
-                            const QJsonDocument document = QJsonDocument::fromJson(file.readAll());
-                            file.close();
-
-                            const QStringList keys = document.object().toVariantMap().value("Keys").toStringList();
-                            const QString &tool_file_path = file_info.absoluteDir().filePath(file_info.baseName());
-
-                            if (!QFile::exists(tool_file_path)) {
-                                continue;
-                            }
-
-                            for (const QString &key : keys) {
-                                if (d->keyToThumbnailTool.contains(key))
-                                    continue;
-
-                                d->keyToThumbnailTool[key] = tool_file_path;
-                            }
-                        }
-                    }
+                if (tool.isEmpty()) {
+                    return thumbnail;
                 }
 
-                QString mime_name = mime.name();
-                QString tool = d->keyToThumbnailTool.value(mime_name);
+                QByteArray output;
+                QString toolError;
 
-                if (tool.isEmpty()) {
-                    mime_name = generalKey(mime_name);
-                    tool = d->keyToThumbnailTool.value(mime_name);
-                }
+                // 常驻的工具进程无响应时再单独启动进程生成
+                if (d->requestToolServer(tool, size, absoluteFilePath, &output, &toolError)) {
+                    if (!toolError.isEmpty()) {
+                        errorString = toolError;
 
-                if (tool.isEmpty()) {
-                    return thumbnail;
-                }
+                        goto _return;
+                    }
+                } else {
+                    QProcess process;
+                    process.start(tool, {QString::number(size), absoluteFilePath}, QIODevice::ReadOnly);
 
-                QProcess process;
-                process.start(tool, {QString::number(size), absoluteFilePath}, QIODevice::ReadOnly);
+                    if (!process.waitForFinished()) {
+                        errorString = process.errorString();
 
-                if (!process.waitForFinished()) {
-                    d->errorString = process.errorString();
+                        goto _return;
+                    }
 
-                    goto _return;
-                }
+                    if (process.exitCode() != 0) {
+                        const QString &error = process.readAllStandardError();
 
-                if (process.exitCode() != 0) {
-                    const QString &error = process.readAllStandardError();
+                        if (error.isEmpty()) {
+                            errorString = QString("get thumbnail failed from the \"%1\" application").arg(tool);
+                        } else {
+                            errorString = error;
+                        }
 
-                    if (error.isEmpty()) {
-                        d->errorString = QString("get thumbnail failed from the \"%1\" application").arg(tool);
-                    } else {
-                        d->errorString = error;
+                        goto _return;
                     }
 
-                    goto _return;
+                    output = process.readAllStandardOutput();
                 }
 
-                const QByteArray output = process.readAllStandardOutput();
                 const QByteArray png_data = QByteArray::fromBase64(output);
                 Q_ASSERT(!png_data.isEmpty());
 
                 if (image->loadFromData(png_data, "png")) {
-                    d->errorString.clear();
+                    errorString.clear();
                 } else {
                     //过滤video tool的其他输出信息
                     QString processResult(output);
@@ -639,9 +1141,9 @@ QString DThumbnailProvider::createThumbnail(const QFileInfo &info, DThumbnailPro
                     const QByteArray pngData = QByteArray::fromBase64(processResult.toUtf8());
                     Q_ASSERT(!pngData.isEmpty());
                     if (image->loadFromData(pngData, "png")) {
-                        d->errorString.clear();
+                        errorString.clear();
                     } else {
-                        d->errorString = QString("load png image failed from the \"%1\" application").arg(tool);
+                        errorString = QString("load png image failed from the \"%1\" application").arg(tool);
                     }
                 }
             }
@@ -650,7 +1152,7 @@ QString DThumbnailProvider::createThumbnail(const QFileInfo &info, DThumbnailPro
 
 _return:
     // successful
-    if (d->errorString.isEmpty()) {
+    if (errorString.isEmpty()) {
         thumbnail = d->sizeToFilePath(size) + QDir::separator() + thumbnailName;
     } else {
         //fail
@@ -658,17 +1160,22 @@ _return:
     }
 
     image->setText(QT_STRINGIFY(Thumb::URL), fileUrl);
-    image->setText(QT_STRINGIFY(Thumb::MTime), QString::number(info.lastModified().toTime_t()));
+    image->setText(QT_STRINGIFY(Thumb::MTime), QString::number(lastModified));
 
     // create path
     QFileInfo(thumbnail).absoluteDir().mkpath(".");
 
     *image = image->scaled(size, size, Qt::KeepAspectRatio);
-    if (!image->save(thumbnail, Q_NULLPTR, 50)) {
-        d->errorString = QStringLiteral("Can not save image to ") + thumbnail;
+    if (!image->save(thumbnail, Q_NULLPTR, THUMBNAIL_PNG_QUALITY)) {
+        errorString = QStringLiteral("Can not save image to ") + thumbnail;
+    } else {
+        DThumbnailIndex::instance()->insert(thumbnail, lastModified, QFileInfo(thumbnail).size());
     }
 
-    if (d->errorString.isEmpty()) {
+    if (errorString.isEmpty()) {
+        // 新生成的缩略图即将被显示，直接放入缓存，避免再从磁盘读取
+        d->insertImageCache(thumbnail + QLatin1Char(':') + QString::number(lastModified), *image);
+
         emit createThumbnailFinished(absoluteFilePath, thumbnail);
         emit thumbnailChanged(absoluteFilePath, thumbnail);
 
@@ -681,82 +1188,131 @@ _return:
     return QString();
 }
 
-void DThumbnailProvider::appendToProduceQueue(const QFileInfo &info, DThumbnailProvider::Size size, DThumbnailProvider::CallBack callback)
+/*!
+ * \brief DThumbnailProvider::appendToProduceQueue 将文件加入缩略图生成队列
+ * \param priority 可见的文件优先于预取的文件生成，同一文件的请求合并为一个任务
+ */
+void DThumbnailProvider::appendToProduceQueue(const QFileInfo &info, DThumbnailProvider::Size size, DThumbnailProvider::CallBack callback, Priority priority)
 {
-    DThumbnailProviderPrivate::ProduceInfo produceInfo;
+    Q_D(DThumbnailProvider);
 
-    produceInfo.fileInfo = info;
-    produceInfo.size = size;
-    produceInfo.callback = callback;
+    const DThumbnailProviderPrivate::ProduceKey key(info.absoluteFilePath(), size);
+    const bool deferred = d->devicePolicies[deviceClass(info.absoluteFilePath())].deferred;
 
-    Q_D(DThumbnailProvider);
+    QWriteLocker locker(&d->dataReadWriteLock);
+
+    if (!d->running)
+        return;
+
+    QSharedPointer<DThumbnailProviderPrivate::ProduceInfo> &produceInfo = d->produceInfos[key];
 
-    if (isRunning()) {
-        QWriteLocker locker(&d->dataReadWriteLock);
-        // fix bug 62540 这里在没生成缩略图的情况下，（触发刷新，文件大小改变）同一个文件会多次生成缩略图的情况,
-        // 缓存当前队列中生成的缩略图文件的路劲没有就加入队里生成
-        if (!d->m_produceAbsoluteFilePathQueue.contains(info.absoluteFilePath())) {
-            d->produceQueue.append(std::move(produceInfo));
-            d->m_produceAbsoluteFilePathQueue << info.absoluteFilePath();
+    // fix bug 62540 这里在没生成缩略图的情况下，（触发刷新，文件大小改变）同一个文件会多次生成缩略图的情况,
+    // 已在队列中或正在生成的文件不再重复生成，只追加回调
+    if (produceInfo) {
+        produceInfo->callbacks << callback;
+
+        if (!produceInfo->producing && priority < produceInfo->priority) {
+            produceInfo->priority = priority;
+            d->updateProduceInfo(produceInfo);
         }
-        locker.unlock();
-        d->waitCondition.wakeAll();
     } else {
-        // fix bug 62540 这里在没生成缩略图的情况下，（触发刷新，文件大小改变）同一个文件会多次生成缩略图的情况,
-        // 缓存当前队列中生成的缩略图文件的路劲没有就加入队里生成
-        if (!d->m_produceAbsoluteFilePathQueue.contains(info.absoluteFilePath())) {
-            d->produceQueue.append(std::move(produceInfo));
-            d->m_produceAbsoluteFilePathQueue << info.absoluteFilePath();
+        produceInfo.reset(new DThumbnailProviderPrivate::ProduceInfo());
+        produceInfo->fileInfo = info;
+        produceInfo->size = size;
+        produceInfo->priority = priority;
+        produceInfo->callbacks << callback;
+
+        if (deferred) {
+            produceInfo->deferred = true;
+            d->deferredInfos << produceInfo;
+        } else {
+            d->pushProduceInfo(produceInfo);
         }
-        start();
     }
+
+    // 视图仍在请求网络设备上的文件时继续等待
+    if (deferred) {
+        QMetaObject::invokeMethod(d->deferTimer, "start", Qt::QueuedConnection);
+        return;
+    }
+
+    d->startWorker();
 }
 
+/*!
+ * \brief DThumbnailProvider::removeInProduceQueue 取消尚未开始生成的任务，如文件已滚动出可见区域
+ */
 void DThumbnailProvider::removeInProduceQueue(const QFileInfo &info, DThumbnailProvider::Size size)
 {
     Q_D(DThumbnailProvider);
 
-    if (isRunning()) {
-        QWriteLocker locker(&d->dataReadWriteLock);
-        Q_UNUSED(locker)
-    }
+    QWriteLocker locker(&d->dataReadWriteLock);
+
+    auto it = d->produceInfos.find(qMakePair(info.absoluteFilePath(), size));
 
-    d->discardedProduceInfos.insert(qMakePair(info.absoluteFilePath(), size));
+    // 正在生成的任务无法中断，生成结束后照常回调
+    if (it != d->produceInfos.end() && !it.value()->producing) {
+        if (it.value()->deferred)
+            d->deferredInfos.removeOne(it.value());
+        else
+            d->removeProduceInfo(it.value());
+
+        d->produceInfos.erase(it);
+    }
 }
 
 QString DThumbnailProvider::errorString() const
 {
     Q_D(const DThumbnailProvider);
 
-    return d->errorString;
+    return d->errorString.localData();
+}
+
+qint64 DThumbnailProvider::defaultSizeLimit(DeviceClass deviceClass) const
+{
+    Q_D(const DThumbnailProvider);
+
+    return d->devicePolicies[deviceClass].defaultSizeLimit;
+}
+
+void DThumbnailProvider::setDefaultSizeLimit(qint64 size, DeviceClass deviceClass)
+{
+    Q_D(DThumbnailProvider);
+
+    d->devicePolicies[deviceClass].defaultSizeLimit = size;
 }
 
-qint64 DThumbnailProvider::defaultSizeLimit() const
+qint64 DThumbnailProvider::sizeLimit(const QMimeType &mimeType, DeviceClass deviceClass) const
 {
     Q_D(const DThumbnailProvider);
 
-    return d->defaultSizeLimit;
+    const DThumbnailProviderPrivate::DevicePolicy &policy = d->devicePolicies[deviceClass];
+
+    return policy.sizeLimitHash.value(mimeType, policy.defaultSizeLimit);
 }
 
-void DThumbnailProvider::setDefaultSizeLimit(qint64 size)
+void DThumbnailProvider::setSizeLimit(const QMimeType &mimeType, qint64 size, DeviceClass deviceClass)
 {
     Q_D(DThumbnailProvider);
 
-    d->defaultSizeLimit = size;
+    d->devicePolicies[deviceClass].sizeLimitHash[mimeType] = size;
 }
 
-qint64 DThumbnailProvider::sizeLimit(const QMimeType &mimeType) const
+/*!
+ * \brief DThumbnailProvider::maxReadBytes 只从文件头部或内嵌预览图生成缩略图时每个文件最多读取的字节数，为0时不限制
+ */
+qint64 DThumbnailProvider::maxReadBytes(DeviceClass deviceClass) const
 {
     Q_D(const DThumbnailProvider);
 
-    return d->sizeLimitHash.value(mimeType, d->defaultSizeLimit);
+    return d->devicePolicies[deviceClass].maxReadBytes;
 }
 
-void DThumbnailProvider::setSizeLimit(const QMimeType &mimeType, qint64 size)
+void DThumbnailProvider::setMaxReadBytes(qint64 size, DeviceClass deviceClass)
 {
     Q_D(DThumbnailProvider);
 
-    d->sizeLimitHash[mimeType] = size;
+    d->devicePolicies[deviceClass].maxReadBytes = size;
 }
 
 DThumbnailProvider::DThumbnailProvider(QObject *parent)
@@ -764,6 +1320,18 @@ DThumbnailProvider::DThumbnailProvider(QObject *parent)
     , d_ptr(new DThumbnailProviderPrivate(this))
 {
     d_func()->init();
+
+    DThumbnailProviderPrivate *d = d_func();
+
+    // 图片缓存的开销以 KB 为单位
+    DFMMemoryAccounting::registerSubsystem("thumbnail", [d] {
+        QMutexLocker locker(&d->imageCacheMutex);
+        return static_cast<qint64>(d->imageCache.totalCost()) * 1024;
+    }, [d] {
+        QMutexLocker locker(&d->imageCacheMutex);
+        d->imageCache.clear();
+    });
+
     m_libMovieViewer = new QLibrary("libimageviewer.so");
     m_libMovieViewer->load();
 }
@@ -772,8 +1340,14 @@ DThumbnailProvider::~DThumbnailProvider()
 {
     Q_D(DThumbnailProvider);
 
+    QWriteLocker locker(&d->dataReadWriteLock);
     d->running = false;
-    d->waitCondition.wakeAll();
+    d->produceInfos.clear();
+    d->produceHeap.clear();
+    d->deferredInfos.clear();
+    locker.unlock();
+
+    d->workerPool.waitForDone();
     wait();
 
     if(m_libMovieViewer && m_libMovieViewer->isLoaded()){
@@ -783,43 +1357,18 @@ DThumbnailProvider::~DThumbnailProvider()
     }
 }
 
+/*!
+ * \brief DThumbnailProvider::run 缩略图由线程池生成，直接启动此线程时作为其中一个生成线程处理队列
+ */
 void DThumbnailProvider::run()
 {
     Q_D(DThumbnailProvider);
 
-    forever {
-        QWriteLocker locker(&d->dataReadWriteLock);
-
-        if (d->produceQueue.isEmpty()) {
-            d->waitCondition.wait(&d->dataReadWriteLock);
-        }
-
-        if (!d->running)
-            return;
-
-        const DThumbnailProviderPrivate::ProduceInfo &task = d->produceQueue.dequeue();
-        const QPair<QString, DThumbnailProvider::Size> &tmpKey = qMakePair(task.fileInfo.absoluteFilePath(), task.size);
-
-        if (d->discardedProduceInfos.contains(tmpKey)) {
-            d->discardedProduceInfos.remove(tmpKey);
-            //fix 62540 去除缓存
-            d->m_produceAbsoluteFilePathQueue.removeOne(task.fileInfo.absoluteFilePath());
-            locker.unlock();
-            continue;
-        }
-
-        locker.unlock();
-
-        const QString &thumbnail = createThumbnail(task.fileInfo, task.size);
+    QWriteLocker locker(&d->dataReadWriteLock);
+    ++d->activeWorkerCount;
+    locker.unlock();
 
-        locker.relock();
-        //fix 62540 生成结束了去除缓存
-        d->m_produceAbsoluteFilePathQueue.removeOne(task.fileInfo.absoluteFilePath());
-        locker.unlock();
-
-        if (task.callback)
-            task.callback(thumbnail);
-    }
+    d->processProduceQueue();
 }
 
 DFM_END_NAMESPACE
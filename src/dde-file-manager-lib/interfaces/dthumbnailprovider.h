@@ -31,6 +31,19 @@ public:
         Large = 256,
     };
 
+    enum Priority {
+        VisiblePriority,    // 正在显示的文件
+        PrefetchPriority    // 预取即将显示的文件，所有可见的文件生成后才生成
+    };
+
+    enum DeviceClass {
+        LocalDevice,        // 本地磁盘及其它可快速读取的设备
+        RemoteDevice,       // smb、ftp、mtp 等网络或低速设备，只读取文件头部和内嵌预览图，且延后生成
+        DeviceClassCount
+    };
+
+    static DeviceClass deviceClass(const QString &filePath);
+
     static DThumbnailProvider *instance();
 
     bool hasThumbnail(const QFileInfo &info) const;
@@ -40,16 +53,19 @@ public:
 
     typedef std::function<void(const QString &)> CallBack;
     QString createThumbnail(const QFileInfo &info, Size size);
-    void appendToProduceQueue(const QFileInfo &info, Size size, CallBack callback = 0);
+    void appendToProduceQueue(const QFileInfo &info, Size size, CallBack callback = 0, Priority priority = VisiblePriority);
     void removeInProduceQueue(const QFileInfo &info, Size size);
 
     QString errorString() const;
 
-    qint64 defaultSizeLimit() const;
-    void setDefaultSizeLimit(qint64 size);
+    qint64 defaultSizeLimit(DeviceClass deviceClass = LocalDevice) const;
+    void setDefaultSizeLimit(qint64 size, DeviceClass deviceClass = LocalDevice);
+
+    qint64 sizeLimit(const QMimeType &mimeType, DeviceClass deviceClass = LocalDevice) const;
+    void setSizeLimit(const QMimeType &mimeType, qint64 size, DeviceClass deviceClass = LocalDevice);
 
-    qint64 sizeLimit(const QMimeType &mimeType) const;
-    void setSizeLimit(const QMimeType &mimeType, qint64 size);
+    qint64 maxReadBytes(DeviceClass deviceClass) const;
+    void setMaxReadBytes(qint64 size, DeviceClass deviceClass);
 
 signals:
     void thumbnailChanged(const QString &sourceFilePath, const QString &thumbnailPath) const;
@@ -9,6 +9,7 @@
 #include "dmimedatabase.h"
 
 #include <QPointer>
+#include <QAtomicPointer>
 
 QT_BEGIN_NAMESPACE
 class QReadWriteLock;
@@ -16,6 +17,10 @@ QT_END_NAMESPACE
 
 DFM_USE_NAMESPACE
 
+namespace FileSortFunction {
+class NameSortKey;
+}
+
 class DAbstractFileInfoPrivate
 {
 public:
@@ -36,12 +41,15 @@ public:
 
     bool columnCompact = false;
 
+    // 按名称排序使用的排序键，只生成一次，生成后不再修改
+    mutable QAtomicPointer<const FileSortFunction::NameSortKey> nameSortKey;
+    // 刷新次数，子类重写 refresh 且不调用基类实现时需要自行增加
+    QAtomicInt refreshVersion;
+
     Q_DECLARE_PUBLIC(DAbstractFileInfo)
 
 private:
     DUrl fileUrl;
-    static QReadWriteLock *urlToFileInfoMapLock;
-    static QMap<DUrl, DAbstractFileInfo*> urlToFileInfoMap;
 };
 
 #endif // DABSTRACTFILEINFO_P_H
@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DFANOTIFYWATCHER_P_H
+#define DFANOTIFYWATCHER_P_H
+
+#include "dfanotifywatcher.h"
+
+#include <QSocketNotifier>
+#include <QTimer>
+#include <QHash>
+#include <QMutex>
+
+class DFanotifyWatcherPrivate
+{
+    Q_DECLARE_PUBLIC(DFanotifyWatcher)
+
+public:
+    DFanotifyWatcherPrivate(int fd, DFanotifyWatcher *qq);
+    ~DFanotifyWatcherPrivate();
+
+    //! 已添加标记的文件系统
+    struct FileSystemMark
+    {
+        int mountFd = -1;   // 用于 open_by_handle_at 解析事件中的目录
+        int refCount = 0;
+        QString markPath;
+    };
+
+    bool markFileSystem(const QString &path, quint64 *fsid);
+    void unmarkFileSystem(quint64 fsid);
+    QString resolveDirectory(quint64 fsid, void *handle) const;
+    bool isPathWatched(const QString &path) const;
+    void flushPendingMove();
+
+    DFanotifyWatcher *q_ptr;
+
+    int fanotifyFd;
+    QSocketNotifier *notifier = nullptr;
+    //! 与 DFileSystemWatcher 相同，收到事件后延迟读取以便一次处理更多事件
+    QTimer readTimer;
+
+    //! 监视的目录树及其引用计数，按路径逐级向上查找
+    QHash<QString, int> subtrees;
+    QHash<QString, quint64> subtreeToFsid;
+    QHash<quint64, FileSystemMark> fileSystems;
+    mutable QMutex mutex;
+
+    //! fanotify 的移动事件没有 cookie，等待紧随其后的 FAN_MOVED_TO 配对
+    QString pendingMovePath, pendingMoveName;
+    bool hasPendingMove = false;
+
+    // private slots
+    void _q_scheduleRead();
+    void _q_readFromFanotify();
+};
+
+#endif // DFANOTIFYWATCHER_P_H
@@ -15,6 +15,21 @@
 
 class DFileInfo;
 class RequestEP;
+
+// statx 一次取得的属性，网络文件系统上代替 QFileInfo 的多次查询，符号链接不使用
+struct DFileStatAttributes
+{
+    quint32 mode = 0;
+    uint ownerId = 0;
+    uint groupId = 0;
+    qint64 size = 0;
+    // 毫秒，created 在文件系统不提供创建时间时为元数据修改时间，与 QFileInfo::created 一致
+    qint64 lastModified = 0;
+    qint64 lastRead = 0;
+    qint64 created = 0;
+    quint64 inode = 0;
+};
+
 class DFileInfoPrivate : public DAbstractFileInfoPrivate
 {
 public:
@@ -35,10 +50,10 @@ public:
     mutable qint8 hasThumbnail = -1;
     mutable qint8 lowSpeedFile = -1;
     mutable quint64 inode = 0;
+    QScopedPointer<DFileStatAttributes> statAttributes;
 
     mutable QVariantHash extraProperties;
     mutable bool epInitialized = false;
-    mutable QPointer<QTimer> getEPTimer;
     mutable QPointer<RequestEP> requestEP;
 };
 
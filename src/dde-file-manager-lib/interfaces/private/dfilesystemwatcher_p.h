@@ -8,8 +8,10 @@
 #include "dfilesystemwatcher.h"
 
 #include <QSocketNotifier>
+#include <QTimer>
 #include <QHash>
 #include <QMap>
+#include <QSet>
 
 class DFileSystemWatcherPrivate
 {
@@ -19,18 +21,22 @@ public:
     DFileSystemWatcherPrivate(int fd, DFileSystemWatcher *qq);
     ~DFileSystemWatcherPrivate();
 
-    QStringList addPaths(const QStringList &paths, QStringList *files, QStringList *directories);
-    QStringList removePaths(const QStringList &paths, QStringList *files, QStringList *directories);
+    QStringList addPaths(const QStringList &paths, QSet<QString> *files, QSet<QString> *directories);
+    QStringList removePaths(const QStringList &paths, QSet<QString> *files, QSet<QString> *directories);
 
     DFileSystemWatcher *q_ptr;
 
-    QStringList files, directories;
+    //! 每个事件都要查找，使用 QSet 避免监视的路径较多时逐个比较
+    QSet<QString> files, directories;
     int inotifyFd;
     QHash<QString, int> pathToID;
     QMultiHash<int, QString> idToPath;
     QSocketNotifier notifier;
+    //! 收到事件后延迟读取，期间内核合并相同的连续事件，一次读取更多的事件
+    QTimer readTimer;
 
     // private slots
+    void _q_scheduleRead();
     void _q_readFromInotify();
 
 private:
@@ -7,6 +7,8 @@
 
 #include "dfmstyleditemdelegate.h"
 
+#include <QCache>
+
 class DFMStyledItemDelegatePrivate
 {
 public:
@@ -17,10 +19,16 @@ public:
     void _q_onRowsInserted(const QModelIndex &parent, int first, int last);
     void _q_onRowsRemoved(const QModelIndex &parent, int first, int last);
 
+    static QString textCacheKey(const QString &text, const QSizeF &size, QTextOption::WrapMode wordWrap,
+                                const QFont &font, Qt::TextElideMode mode, qreal lineHeight, int flags);
+
     DFMStyledItemDelegate *q_ptr;
     mutable QModelIndex editingIndex;
     QSize itemSizeHint;
     int textLineHeight = -1;
+    // 文本折行省略的结果缓存，滚动、框选和重绘时同一文件名不再重复排版，缩放和主题变化时清空
+    mutable QCache<QString, QList<QRectF>> textGeometryCache;
+    mutable QCache<QString, QString> elidedTextCache;
 
     Q_DECLARE_PUBLIC(DFMStyledItemDelegate)
 };
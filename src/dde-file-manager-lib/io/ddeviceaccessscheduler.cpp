@@ -0,0 +1,170 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ddeviceaccessscheduler.h"
+#include "app/define.h"
+
+#include <QElapsedTimer>
+
+// 低优先级的请求每次最多让出设备的时间
+static const int kMaxYieldTime = 2000;
+
+DFM_BEGIN_NAMESPACE
+
+DDeviceAccessScheduler::DDeviceAccessScheduler()
+{
+
+}
+
+DDeviceAccessScheduler *DDeviceAccessScheduler::instance()
+{
+    static DDeviceAccessScheduler scheduler;
+
+    return &scheduler;
+}
+
+/*!
+ * \brief DDeviceAccessScheduler::deviceOf 例如 /run/user/1000/gvfs/mtp:host=xxx/内部存储/DCIM 返回 /run/user/1000/gvfs/mtp:host=xxx
+ */
+QString DDeviceAccessScheduler::deviceOf(const QString &path)
+{
+    const int pos = path.indexOf(QStringLiteral(MTP_STAGING));
+
+    if (pos < 0)
+        return QString();
+
+    const int end = path.indexOf('/', pos + static_cast<int>(strlen(MTP_STAGING)));
+
+    return end < 0 ? path : path.left(end);
+}
+
+void DDeviceAccessScheduler::begin(const QString &device, DDeviceAccessScheduler::Priority priority)
+{
+    if (device.isEmpty())
+        return;
+
+    QMutexLocker locker(&m_mutex);
+
+    ++m_devices[device].active[priority];
+}
+
+void DDeviceAccessScheduler::end(const QString &device, DDeviceAccessScheduler::Priority priority)
+{
+    if (device.isEmpty())
+        return;
+
+    QMutexLocker locker(&m_mutex);
+
+    auto it = m_devices.find(device);
+
+    if (it == m_devices.end())
+        return;
+
+    if (--it->active[priority] <= 0) {
+        it->active[priority] = 0;
+
+        bool idle = true;
+
+        for (int count : it->active)
+            idle = idle && count == 0;
+
+        if (idle)
+            m_devices.erase(it);
+    }
+
+    m_changed.wakeAll();
+}
+
+/*!
+ * \brief DDeviceAccessScheduler::yield 在两次读写之间调用，设备上有更高优先级的请求时等待它们完成
+ */
+void DDeviceAccessScheduler::yield(const QString &device, DDeviceAccessScheduler::Priority priority)
+{
+    if (device.isEmpty())
+        return;
+
+    QMutexLocker locker(&m_mutex);
+    QElapsedTimer timer;
+
+    timer.start();
+
+    while (hasHigherPriority(m_devices.value(device), priority)) {
+        const qint64 remaining = kMaxYieldTime - timer.elapsed();
+
+        if (remaining <= 0)
+            break;
+
+        m_changed.wait(&m_mutex, static_cast<unsigned long>(remaining));
+    }
+}
+
+/*!
+ * \brief DDeviceAccessScheduler::joinListing 加入对目录的遍历
+ * \param owner 为 true 时调用者负责遍历并调用 finishListing，否则调用 waitListing 等待结果
+ */
+DDeviceAccessScheduler::ListingPointer DDeviceAccessScheduler::joinListing(const QString &dirPath, bool *owner)
+{
+    QMutexLocker locker(&m_mutex);
+
+    ListingPointer &listing = m_listings[dirPath];
+
+    *owner = !listing;
+
+    if (!listing)
+        listing.reset(new Listing());
+
+    return listing;
+}
+
+void DDeviceAccessScheduler::finishListing(const QString &dirPath, const DDeviceAccessScheduler::ListingPointer &listing, bool complete)
+{
+    QMutexLocker locker(&m_mutex);
+
+    listing->finished = true;
+    listing->complete = complete;
+
+    if (m_listings.value(dirPath) == listing)
+        m_listings.remove(dirPath);
+
+    m_changed.wakeAll();
+}
+
+/*!
+ * \brief DDeviceAccessScheduler::waitListing 等待其它请求遍历完成
+ * \return 遍历已结束返回true，结果不完整时（遍历被中止）listing->complete 为 false
+ */
+bool DDeviceAccessScheduler::waitListing(const DDeviceAccessScheduler::ListingPointer &listing, int msecs)
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (!listing->finished)
+        m_changed.wait(&m_mutex, static_cast<unsigned long>(msecs));
+
+    return listing->finished;
+}
+
+DDeviceAccessScheduler::Access::Access(const QString &device, DDeviceAccessScheduler::Priority priority)
+    : m_device(device)
+    , m_priority(priority)
+{
+    DDeviceAccessScheduler::instance()->yield(m_device, m_priority);
+    DDeviceAccessScheduler::instance()->begin(m_device, m_priority);
+}
+
+DDeviceAccessScheduler::Access::~Access()
+{
+    DDeviceAccessScheduler::instance()->end(m_device, m_priority);
+}
+
+bool DDeviceAccessScheduler::hasHigherPriority(const DDeviceAccessScheduler::Device &device, DDeviceAccessScheduler::Priority priority) const
+{
+    for (int i = 0; i < priority; ++i) {
+        if (device.active[i] > 0)
+            return true;
+    }
+
+    return false;
+}
+
+DFM_END_NAMESPACE
@@ -0,0 +1,86 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DDEVICEACCESSSCHEDULER_H
+#define DDEVICEACCESSSCHEDULER_H
+
+#include "dabstractfileinfo.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QSharedPointer>
+
+DFM_BEGIN_NAMESPACE
+
+/*!
+ * \brief DDeviceAccessScheduler 按优先级调度对 MTP 设备的访问
+ *
+ * gvfs 对同一个 MTP 设备的请求是串行处理的，列出目录、生成缩略图和拷贝文件会互相等待。
+ * 同一设备上按“列出可见目录 > 缩略图 > 拷贝”的顺序调度：有更高优先级的请求进行中时，
+ * 低优先级的请求在开始前和两次读写之间让出设备，拷贝最多让出 kMaxYieldTime 毫秒，避免一直得不到执行。
+ * 同一目录同时被多次列出时只遍历一次，其它请求等待并复用遍历的结果。
+ */
+class DDeviceAccessScheduler
+{
+public:
+    enum Priority {
+        ListingPriority,
+        ThumbnailPriority,
+        CopyPriority,
+        PriorityCount
+    };
+
+    struct Listing {
+        QList<DAbstractFileInfoPointer> infoList;
+        bool finished = false;
+        bool complete = false;
+    };
+
+    typedef QSharedPointer<Listing> ListingPointer;
+
+    // 构造时让出设备给更高优先级的请求并开始访问，析构时结束访问
+    class Access
+    {
+    public:
+        Access(const QString &device, Priority priority);
+        ~Access();
+
+    private:
+        QString m_device;
+        Priority m_priority;
+
+        Q_DISABLE_COPY(Access)
+    };
+
+    static DDeviceAccessScheduler *instance();
+    // 返回路径所在的 MTP 设备在 gvfs 中的挂载目录，不是 MTP 设备时返回空
+    static QString deviceOf(const QString &path);
+
+    void begin(const QString &device, Priority priority);
+    void end(const QString &device, Priority priority);
+    void yield(const QString &device, Priority priority);
+
+    ListingPointer joinListing(const QString &dirPath, bool *owner);
+    void finishListing(const QString &dirPath, const ListingPointer &listing, bool complete);
+    bool waitListing(const ListingPointer &listing, int msecs);
+
+private:
+    DDeviceAccessScheduler();
+
+    struct Device {
+        int active[PriorityCount] = {};
+    };
+
+    bool hasHigherPriority(const Device &device, Priority priority) const;
+
+    QHash<QString, Device> m_devices;
+    QHash<QString, ListingPointer> m_listings;
+    QMutex m_mutex;
+    QWaitCondition m_changed;
+};
+
+DFM_END_NAMESPACE
+
+#endif // DDEVICEACCESSSCHEDULER_H
@@ -6,19 +6,25 @@
 #include "private/dfilecopymovejob_p.h"
 
 #include "dfileservices.h"
+#include "dfmtrace.h"
+#include "dfmmetrics.h"
 #include "dabstractfileinfo.h"
 #include "dfiledevice.h"
 #include "dfilehandler.h"
 #include "ddiriterator.h"
 #include "dfilestatisticsjob.h"
 #include "dlocalfiledevice.h"
+#include "dlocalfilehandler.h"
 #include "models/trashfileinfo.h"
 #include "controllers/vaultcontroller.h"
+#include "vault/vaultconfig.h"
 #include "controllers/masteredmediacontroller.h"
 #include "controllers/avfsfilecontroller.h"
 #include "interfaces/dfmstandardpaths.h"
 #include "shutil/fileutils.h"
 #include "dgiofiledevice.h"
+#include "dstorageusagecache.h"
+#include "ddeviceaccessscheduler.h"
 #include "deviceinfo/udisklistener.h"
 #include "app/define.h"
 #include "dialogs/dialogmanager.h"
@@ -27,6 +33,8 @@
 #include <QTimer>
 #include <QLoggingCategory>
 #include <QProcess>
+#include <QCryptographicHash>
+#include <QtMath>
 #include <QtConcurrent/QtConcurrent>
 #include <qplatformdefs.h>
 
@@ -35,12 +43,19 @@
 #include <fcntl.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/sysmacros.h>
 #include <sys/mman.h>
 #include <inttypes.h>
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <fts.h>
+#include <dirent.h>
+#ifdef Q_OS_LINUX
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#include <linux/fs.h>
+#endif
 
 #undef signals
 extern "C" {
@@ -68,10 +83,57 @@ Q_LOGGING_CATEGORY(fileJob, "file.job", QtInfoMsg)
 #define BIG_FILE_SIZE 500 * 1024 * 1024
 #define THREAD_SLEEP_TIME 200
 #define COPY_FILE_STORE_NUM 2000
+#define KERNEL_COPY_BLOCK_LEN 1024 * 1024 * 8
+#define WRITE_QUEUE_MAX_COUNT 300
+#define COPY_BUFFER_POOL_NUM 64
+#define ADAPTIVE_BLOCK_MIN_LEN 64 * 1024
+#define ADAPTIVE_BLOCK_MAX_LEN 16 * 1024 * 1024
+#define ADAPTIVE_BLOCK_WINDOW_MS 500
+#define REMOTE_SMALL_FILE_SIZE 1024 * 1024 * 4
+#define REMOTE_COPY_STREAM_NUM 4
+// 写入保险箱时的初始块大小和同时拷贝的文件数量，cryfs 可以并行处理多个 FUSE 请求
+#define VAULT_COPY_BLOCK_LEN 4 * 1024 * 1024
+#define VAULT_COPY_STREAM_NUM 4
+// 没有记录块大小的保险箱使用 cryfs 的默认块大小
+#define VAULT_DEFAULT_BLOCK_SIZE 16 * 1024
+#define JOURNAL_PROGRESS_STEP 32 * 1024 * 1024
+#define JOURNAL_TAIL_CHECK_LEN 64 * 1024
+#define BACKGROUND_SPEED_LIMIT 20 * 1024 * 1024
+#define SPEED_SMOOTH_TIME_MS 3000
+#define WRITEBACK_WINDOW_LEN 8 * 1024 * 1024
+//自动页缓存策略下，大于这个大小的文件才丢弃页缓存
+#define PAGE_CACHE_DROP_FILE_SIZE 16 * 1024 * 1024
+#define REMOVE_DIRENT_BUFFER_LEN 32 * 1024
+//判断目标文件是否与源文件相同时，抽样比较的数据块个数和大小
+#define IDENTICAL_SAMPLE_COUNT 5
+#define IDENTICAL_SAMPLE_LEN 64 * 1024
+//增量替换已存在的文件时，源文件的最小大小和比较的块大小
+#define DELTA_TRANSFER_MIN_SIZE 64 * 1024 * 1024
+#define DELTA_TRANSFER_BLOCK_LEN 1024 * 1024
+//大于这个大小的文件写入前预先分配空间
+#define PREALLOCATE_MIN_SIZE 1024 * 1024
+//检查剩余空间时使用的容量缓存的有效时间和等待查询的超时时间，卡住的网络挂载不会阻塞任务
+#define FREE_SPACE_MAX_AGE 1000
+#define FREE_SPACE_QUERY_TIMEOUT 3000
+#ifndef IOPRIO_CLASS_SHIFT
+#define IOPRIO_CLASS_SHIFT 13
+#endif
+#ifndef IOPRIO_CLASS_IDLE
+#define IOPRIO_CLASS_IDLE 3
+#endif
+#ifndef IOPRIO_WHO_PROCESS
+#define IOPRIO_WHO_PROCESS 1
+#endif
+#ifndef RENAME_NOREPLACE
+#define RENAME_NOREPLACE (1 << 0)
+#endif
 QQueue<DFileCopyMoveJob*> DFileCopyMoveJobPrivate::CopyLargeFileOnDiskQueue;
 QMutex DFileCopyMoveJobPrivate::CopyLargeFileOnDiskMutex;
 DUrlList DFileCopyMoveJobPrivate::copyingFiles;
 QMutex DFileCopyMoveJobPrivate::copyingFilesMutex;
+QMap<QString, QList<DFileCopyMoveJob *>> DFileCopyMoveJobPrivate::deviceJobQueues;
+QMutex DFileCopyMoveJobPrivate::deviceJobMutex;
+QWaitCondition DFileCopyMoveJobPrivate::deviceJobCondition;
 
 static long qt_gettid()
 {
@@ -102,17 +164,6 @@ static QT_PREPEND_NAMESPACE(qint64) qt_gettid()
 }
 #endif
 
-static QByteArray fileReadAll(const QString &file_path)
-{
-    QFile file(file_path);
-
-    if (file.open(QIODevice::ReadOnly)) {
-        return file.readAll();
-    }
-
-    return QByteArray();
-}
-
 class ElapsedTimer
 {
 public:
@@ -169,6 +220,7 @@ DFileCopyMoveJobPrivate::DFileCopyMoveJobPrivate(DFileCopyMoveJob *qq)
     , updateSpeedElapsedTimer(new ElapsedTimer())
 {
     m_pool.setMaxThreadCount(FileUtils::getCpuProcessCount());
+    m_prefetchPool.setMaxThreadCount(FileUtils::getCpuProcessCount());
 }
 
 DFileCopyMoveJobPrivate::~DFileCopyMoveJobPrivate()
@@ -188,6 +240,10 @@ DFileCopyMoveJobPrivate::~DFileCopyMoveJobPrivate()
         updateSpeedTimer = nullptr;
     }
     stopAllDeviceOperation();
+    clearCopyBufferPool();
+    //预读任务会访问此对象，析构前必须全部结束
+    m_prefetchPool.clear();
+    m_prefetchPool.waitForDone();
 }
 
 QString DFileCopyMoveJobPrivate::errorToString(DFileCopyMoveJob::Error error)
@@ -238,78 +294,39 @@ QString DFileCopyMoveJobPrivate::errorToString(DFileCopyMoveJob::Error error)
     return QString();
 }
 
-qint64 DFileCopyMoveJobPrivate::getWriteBytes(long tid)
+qint64 DFileCopyMoveJobPrivate::getCompletedDataSize() const
 {
-    QFile file(QStringLiteral("/proc/self/task/%1/io").arg(tid));
-
-    if (!file.open(QIODevice::ReadOnly)) {
-        qWarning() << "Failed on open the" << file.fileName() << ", will be not update the job speed and progress";
-
-        return 0;
-    }
-
-    const QByteArray &line_head = QByteArrayLiteral("write_bytes: ");
-    const QByteArray &all_data = file.readAll();
-
-    file.close();
-
-    QTextStream text_stream(all_data);
-
-    while (!text_stream.atEnd()) {
-        const QByteArray &line = text_stream.readLine().toLatin1();
-
-        if (line.startsWith(line_head)) {
-            bool ok = false;
-            qint64 size = line.mid(line_head.size()).toLongLong(&ok);
-
-            if (!ok) {
-                qWarning() << "Failed to convert to qint64, line string=" << line;
-
-                return 0;
-            }
-
-//            qCDebug(fileJob(), "Did Write size on block device: %lld", size);
-
-            return size;
-        }
-    }
-
-    qWarning() << "Failed to find \"" << line_head << "\" from the" << file.fileName();
-
-    return 0;
+    return completedDataSize;
 }
 
-qint64 DFileCopyMoveJobPrivate::getWriteBytes() const
+DFileCopyMoveJobPrivate::ProgressCounter &DFileCopyMoveJobPrivate::ProgressCounter::operator+=(qint64 size)
 {
-    return getWriteBytes(tid);
+    m_slots[slotIndex()].value.fetchAndAddRelaxed(size);
+    return *this;
 }
 
-qint64 DFileCopyMoveJobPrivate::getSectorsWritten() const
+DFileCopyMoveJobPrivate::ProgressCounter &DFileCopyMoveJobPrivate::ProgressCounter::operator=(qint64 size)
 {
-    const QByteArray data = fileReadAll(targetSysDevPath + "/stat");
-    //fix: 删除文件时出现报错(回收箱和光驱处理删除文件)，获取data为空指针
-    if (data == nullptr) {
-        return 0;
-    } else {
-        return data.simplified().split(' ').value(6).toLongLong();
-    }
+    m_slots[0].value.store(size);
+    for (int i = 1; i < SlotCount; ++i)
+        m_slots[i].value.store(0);
+    return *this;
 }
 
-qint64 DFileCopyMoveJobPrivate::getCompletedDataSize() const
+DFileCopyMoveJobPrivate::ProgressCounter::operator qint64() const
 {
-    if (canUseWriteBytes) {
-        return getWriteBytes();
-    }
-
-    if (targetDeviceStartSectorsWritten >= 0) {
-        if ((getSectorsWritten() == 0) && (targetDeviceStartSectorsWritten > 0)) {
-            return 0;
-        } else {
-            return (getSectorsWritten() - targetDeviceStartSectorsWritten) * targetLogSecionSize;
-        }
-    }
+    qint64 total = 0;
+    for (const Slot &slot : m_slots)
+        total += slot.value.load();
+    return total;
+}
 
-    return completedDataSize;
+int DFileCopyMoveJobPrivate::ProgressCounter::slotIndex()
+{
+    // 每个线程第一次累加时分配一个槽，线程数超过槽的数量时共用
+    static QAtomicInt nextIndex;
+    thread_local const int index = nextIndex.fetchAndAddRelaxed(1) % SlotCount;
+    return index;
 }
 
 void DFileCopyMoveJobPrivate::setState(DFileCopyMoveJob::State s)
@@ -608,10 +625,12 @@ bool DFileCopyMoveJobPrivate::checkFreeSpace(qint64 needSize)
         return true;
     }
 
-    targetStorageInfo.refresh();
+    const DStorageUsageCache::Usage &usage = DStorageUsageCache::instance()->usage(targetStorageInfo.rootPath(),
+                                                                                  FREE_SPACE_MAX_AGE,
+                                                                                  FREE_SPACE_QUERY_TIMEOUT);
 
     // invalid size info
-    if (targetStorageInfo.bytesTotal() <= 0) {
+    if (!usage.isValid() || usage.bytesTotal <= 0) {
         return true;
     }
 
@@ -621,8 +640,306 @@ bool DFileCopyMoveJobPrivate::checkFreeSpace(qint64 needSize)
     if (fs_type == "iso9660") {
         return true;
     } else {
-        return targetStorageInfo.bytesAvailable() >= needSize;
+        return usage.bytesAvailable >= needSize;
+    }
+}
+
+/*!
+ * \brief DFileCopyMoveJobPrivate::canLinkToDestination 设置了 LinkToDestination 时，
+ * 同一文件系统中的普通文件以硬链接代替复制，不占用额外的磁盘空间，也不需要读写文件内容
+ */
+bool DFileCopyMoveJobPrivate::canLinkToDestination(const DAbstractFileInfoPointer &fromInfo, const DAbstractFileInfoPointer &toInfo) const
+{
+    if (!fileHints.testFlag(DFileCopyMoveJob::LinkToDestination) || !fromInfo || !toInfo)
+        return false;
+
+    if (!fromInfo->fileUrl().isLocalFile() || !toInfo->fileUrl().isLocalFile() || fromInfo->isGvfsMountFile())
+        return false;
+
+    struct stat sourceStat;
+    struct stat targetDirStat;
+
+    if (lstat(QFile::encodeName(fromInfo->fileUrl().toLocalFile()).constData(), &sourceStat) != 0 || !S_ISREG(sourceStat.st_mode))
+        return false;
+
+    if (stat(QFile::encodeName(toInfo->parentUrl().toLocalFile()).constData(), &targetDirStat) != 0)
+        return false;
+
+    return sourceStat.st_dev == targetDirStat.st_dev;
+}
+
+bool DFileCopyMoveJobPrivate::linkToDestination(const DAbstractFileInfoPointer &fromInfo, const DAbstractFileInfoPointer &toInfo)
+{
+    const QByteArray &fromPath = QFile::encodeName(fromInfo->fileUrl().toLocalFile());
+    const QByteArray &toPath = QFile::encodeName(toInfo->fileUrl().toLocalFile());
+
+    // 没有权限创建硬链接（如 fs.protected_hardlinks 的限制）时复制文件
+    if (::link(fromPath.constData(), toPath.constData()) != 0) {
+        qCDebug(fileJob()) << "link failed, copy the file:" << fromPath << strerror(errno);
+        return false;
+    }
+
+    const qint64 size = fromInfo->size();
+
+    countrefinesize(size <= 0 ? FileUtils::getMemoryPageSize() : size);
+    needUpdateProgress = true;
+
+    return true;
+}
+
+/*!
+ * \brief DFileCopyMoveJobPrivate::isIdenticalFile 大小和修改时间都相同的普通文件视为相同，按照策略再比较文件数据。
+ * 目标为 FAT 文件系统时修改时间只精确到2秒
+ */
+bool DFileCopyMoveJobPrivate::isIdenticalFile(const DAbstractFileInfoPointer &fromInfo, const DAbstractFileInfoPointer &toInfo)
+{
+    if (m_identicalFilePolicy == DFileCopyMoveJob::NoSkipIdentical || !fromInfo || !toInfo)
+        return false;
+
+    if (!fromInfo->isFile() || fromInfo->isSymLink() || !toInfo->isFile() || toInfo->isSymLink())
+        return false;
+
+    const qint64 size = fromInfo->size();
+
+    if (size != toInfo->size())
+        return false;
+
+    qint64 modifyWindow = 0;
+
+    if (directoryStack.count() > 0 && directoryStack.top().targetStorageInfo.isValid()) {
+        const QString &fsType = directoryStack.top().targetStorageInfo.fileSystemType();
+
+        if (fsType == "vfat" || fsType == "exfat" || fsType == "msdos")
+            modifyWindow = 2;
+    }
+
+    const qint64 fromTime = fromInfo->lastModified().toMSecsSinceEpoch() / 1000;
+    const qint64 toTime = toInfo->lastModified().toMSecsSinceEpoch() / 1000;
+
+    if (qAbs(fromTime - toTime) > modifyWindow)
+        return false;
+
+    if (m_identicalFilePolicy == DFileCopyMoveJob::SkipSameSizeAndTime)
+        return true;
+
+    // 只比较能够直接读取的文件，远程文件仍然重新拷贝
+    if (!fromInfo->fileUrl().isLocalFile() || !toInfo->fileUrl().isLocalFile())
+        return false;
+
+    return compareFileData(fromInfo->fileUrl().toLocalFile(), toInfo->fileUrl().toLocalFile(), size,
+                           m_identicalFilePolicy == DFileCopyMoveJob::SkipSameContent);
+}
+
+bool DFileCopyMoveJobPrivate::compareFileData(const QString &fromPath, const QString &toPath, qint64 size, bool fullContent)
+{
+    QFile fromFile(fromPath);
+    QFile toFile(toPath);
+
+    if (!fromFile.open(QIODevice::ReadOnly) || !toFile.open(QIODevice::ReadOnly))
+        return false;
+
+    // 文件较小时抽样与全部比较的数据量相当，直接比较全部内容
+    if (!fullContent && size > static_cast<qint64>(IDENTICAL_SAMPLE_COUNT) * IDENTICAL_SAMPLE_LEN) {
+        for (int i = 0; i < IDENTICAL_SAMPLE_COUNT; ++i) {
+            const qint64 pos = (size - IDENTICAL_SAMPLE_LEN) * i / (IDENTICAL_SAMPLE_COUNT - 1);
+
+            if (!fromFile.seek(pos) || !toFile.seek(pos))
+                return false;
+
+            const QByteArray &fromData = fromFile.read(IDENTICAL_SAMPLE_LEN);
+
+            if (fromData.size() != IDENTICAL_SAMPLE_LEN || fromData != toFile.read(IDENTICAL_SAMPLE_LEN))
+                return false;
+        }
+
+        return true;
+    }
+
+    qint64 pos = 0;
+
+    while (pos < size) {
+        if (!stateCheck())
+            return false;
+
+        const QByteArray &fromData = fromFile.read(MAX_BUFFER_LEN);
+
+        if (fromData.isEmpty() || fromData != toFile.read(MAX_BUFFER_LEN))
+            return false;
+
+        pos += fromData.size();
+    }
+
+    return true;
+}
+
+/*!
+ * \brief DFileCopyMoveJobPrivate::deltaCopyFile 增量替换已存在的目标文件
+ *
+ * 在网络目录或者较慢的移动设备上替换虚拟机镜像等只修改了少量数据的大文件时，
+ * 按固定大小的块同时读取源文件和目标文件，只写入不同的块，最后把目标文件截断或者扩展到源文件的大小。
+ * 源文件在比较过程中发生变化或者读写出错时返回false，由调用者重新完整拷贝。
+ */
+bool DFileCopyMoveJobPrivate::deltaCopyFile(const DAbstractFileInfoPointer &fromInfo, const DAbstractFileInfoPointer &toInfo,
+                                            const QSharedPointer<DFileHandler> &handler)
+{
+    const qint64 size = fromInfo->size();
+
+    if (size < DELTA_TRANSFER_MIN_SIZE || !toInfo->exists() || toInfo->size() <= 0)
+        return false;
+
+    const QByteArray &fromPath = fromInfo->fileUrl().toLocalFile().toLocal8Bit();
+    const QByteArray &toPath = toInfo->fileUrl().toLocalFile().toLocal8Bit();
+
+    if (fromPath.isEmpty() || toPath.isEmpty())
+        return false;
+
+    const int fromFd = ::open(fromPath.constData(), O_RDONLY | O_CLOEXEC);
+
+    if (fromFd < 0)
+        return false;
+
+    const int toFd = ::open(toPath.constData(), O_RDWR | O_CLOEXEC);
+
+    if (toFd < 0) {
+        ::close(fromFd);
+        return false;
+    }
+
+    struct stat fromStat;
+    struct stat toStat;
+    bool ok = fstat(fromFd, &fromStat) == 0 && fstat(toFd, &toStat) == 0 && S_ISREG(toStat.st_mode)
+            && fromStat.st_size == size
+            && (fromStat.st_dev != toStat.st_dev || fromStat.st_ino != toStat.st_ino);
+    const qint64 toSize = ok ? toStat.st_size : 0;
+    qint64 offset = 0;
+    qint64 writtenSize = 0;
+
+    beginJob(JobInfo::Copy, fromInfo->fileUrl(), toInfo->fileUrl());
+
+    while (ok && offset < size) {
+        if (Q_UNLIKELY(!stateCheck())) {
+            ok = false;
+            break;
+        }
+
+        const int len = static_cast<int>(qMin<qint64>(DELTA_TRANSFER_BLOCK_LEN, size - offset));
+        const int toLen = static_cast<int>(qBound<qint64>(0, toSize - offset, len));
+        QByteArray fromData(len, Qt::Uninitialized);
+        QByteArray toData(toLen, Qt::Uninitialized);
+        // 目标文件的块在另一个线程中读取，与源文件的读取重叠
+        QFuture<ssize_t> toRead;
+
+        if (toLen > 0) {
+            toRead = QtConcurrent::run([toFd, &toData, offset]() {
+                return pread(toFd, toData.data(), static_cast<size_t>(toData.size()), offset);
+            });
+        }
+
+        const ssize_t fromReadSize = pread(fromFd, fromData.data(), static_cast<size_t>(len), offset);
+        const ssize_t toReadSize = toLen > 0 ? toRead.result() : 0;
+
+        if (fromReadSize != len || toReadSize != toLen) {
+            ok = false;
+            break;
+        }
+
+        if (toLen != len || memcmp(fromData.constData(), toData.constData(), static_cast<size_t>(len)) != 0) {
+            if (pwrite(toFd, fromData.constData(), static_cast<size_t>(len), offset) != len) {
+                ok = false;
+                break;
+            }
+
+            writtenSize += len;
+        }
+
+        throttleRead(len);
+
+        offset += len;
+        currentJobDataSizeInfo.second += len;
+        completedDataSize += len;
+        completedDataSizeOnBlockDevice += len;
+        countrefinesize(len);
+    }
+
+    if (ok && toSize != size)
+        ok = ftruncate(toFd, size) == 0;
+
+    // 比较过程中源文件被修改时，已写入的数据可能不一致
+    struct stat endStat;
+    if (ok)
+        ok = fstat(fromFd, &endStat) == 0 && endStat.st_size == fromStat.st_size
+                && endStat.st_mtim.tv_sec == fromStat.st_mtim.tv_sec && endStat.st_mtim.tv_nsec == fromStat.st_mtim.tv_nsec;
+
+    if (ok && writtenSize > 0 && (m_isEveryReadAndWritesSnc || m_syncPolicy == DFileCopyMoveJob::FileSync))
+        ok = fdatasync(toFd) == 0;
+
+    if (ok) {
+        finalizeTargetFile(toInfo->isGvfsMountFile() ? -1 : toFd, fromInfo, toInfo, handler);
+        qCDebug(fileJob()) << "delta transfer wrote" << writtenSize << "of" << size << "bytes to" << toInfo->fileUrl();
+    } else {
+        // 回退到完整拷贝，撤销已经计入的进度
+        currentJobDataSizeInfo.second -= offset;
+        completedDataSize += -offset;
+        completedDataSizeOnBlockDevice += -offset;
+        countrefinesize(-offset);
+        qCDebug(fileJob()) << "delta transfer failed at" << offset << "of" << toInfo->fileUrl() << strerror(errno);
+    }
+
+    ::close(fromFd);
+    ::close(toFd);
+    endJob();
+
+    return ok;
+}
+
+QString DFileCopyMoveJobPrivate::copiedHardLinkTarget(const DAbstractFileInfoPointer &fromInfo, QPair<quint64, quint64> *key)
+{
+    if (!fileHints.testFlag(DFileCopyMoveJob::PreserveHardLinks) || !fromInfo)
+        return QString();
+
+    if (!fromInfo->fileUrl().isLocalFile() || fromInfo->isGvfsMountFile())
+        return QString();
+
+    struct stat sourceStat;
+
+    if (lstat(QFile::encodeName(fromInfo->fileUrl().toLocalFile()).constData(), &sourceStat) != 0
+            || !S_ISREG(sourceStat.st_mode) || sourceStat.st_nlink <= 1)
+        return QString();
+
+    *key = qMakePair(static_cast<quint64>(sourceStat.st_dev), static_cast<quint64>(sourceStat.st_ino));
+
+    QMutexLocker locker(&m_copiedHardLinksMutex);
+
+    return m_copiedHardLinks.value(*key);
+}
+
+bool DFileCopyMoveJobPrivate::linkToCopiedHardLink(const QString &copiedPath, const DAbstractFileInfoPointer &fromInfo, const DAbstractFileInfoPointer &toInfo)
+{
+    if (!toInfo->fileUrl().isLocalFile())
+        return false;
+
+    const QByteArray &toPath = QFile::encodeName(toInfo->fileUrl().toLocalFile());
+
+    // 目标不支持硬链接、跨文件系统或目标已存在时复制文件
+    if (::linkat(AT_FDCWD, QFile::encodeName(copiedPath).constData(), AT_FDCWD, toPath.constData(), 0) != 0) {
+        qCDebug(fileJob()) << "linkat failed, copy the file:" << toPath << strerror(errno);
+        return false;
     }
+
+    const qint64 size = fromInfo->size();
+
+    countrefinesize(size <= 0 ? FileUtils::getMemoryPageSize() : size);
+    needUpdateProgress = true;
+
+    return true;
+}
+
+void DFileCopyMoveJobPrivate::recordCopiedHardLink(const QPair<quint64, quint64> &key, const QString &targetPath)
+{
+    QMutexLocker locker(&m_copiedHardLinksMutex);
+
+    if (!m_copiedHardLinks.contains(key))
+        m_copiedHardLinks.insert(key, targetPath);
 }
 
 QString DFileCopyMoveJobPrivate::formatFileName(const QString &name) const
@@ -650,8 +967,16 @@ QString DFileCopyMoveJobPrivate::formatFileName(const QString &name) const
     return name;
 }
 
-QString DFileCopyMoveJobPrivate::getNewFileName(const DAbstractFileInfoPointer sourceFileInfo, const DAbstractFileInfoPointer targetDirectory)
+/*!
+ * \brief DFileCopyMoveJobPrivate::getNewFileName 生成目标目录中不存在的副本名称
+ * \param existingNames 目标目录中已有的文件名，不为空时先在其中查找，只对找到的名称查询一次文件是否存在，
+ * 生成的名称会加入其中
+ */
+QString DFileCopyMoveJobPrivate::getNewFileName(const DAbstractFileInfoPointer sourceFileInfo, const DAbstractFileInfoPointer targetDirectory,
+                                                QSet<QString> *existingNames)
 {
+    static const QRegularExpression splitVolume7z(".7z.[0-9]{3,10}$");
+
     const QString &copy_text = QCoreApplication::translate("DFileCopyMoveJob", "copy",
                                                            "Extra name added to new file name when used for file name.");
 
@@ -660,16 +985,17 @@ QString DFileCopyMoveJobPrivate::getNewFileName(const DAbstractFileInfoPointer s
     QString suffix = sourceFileInfo->suffix();
     QString filename = sourceFileInfo->fileName();
     //在7z分卷压缩后的名称特殊处理7z.003
-    if (filename.contains(QRegularExpression(".7z.[0-9]{3,10}$"))) {
-        file_base_name = filename.left(filename.indexOf(QRegularExpression(".7z.[0-9]{3,10}$")));
-        suffix = filename.mid(filename.indexOf(QRegularExpression(".7z.[0-9]{3,10}$")) + 1);
+    const int splitVolumeIndex = filename.indexOf(splitVolume7z);
+    if (splitVolumeIndex >= 0) {
+        file_base_name = filename.left(splitVolumeIndex);
+        suffix = filename.mid(splitVolumeIndex + 1);
     }
 
     int number = 0;
 
     QString new_file_name;
 
-    do {
+    forever {
         new_file_name = number > 0 ? QString("%1(%2 %3)").arg(file_base_name, copy_text).arg(number) : QString("%1(%2)").arg(file_base_name, copy_text);
 
         if (!suffix.isEmpty()) {
@@ -677,12 +1003,63 @@ QString DFileCopyMoveJobPrivate::getNewFileName(const DAbstractFileInfoPointer s
         }
 
         ++number;
+
+        if (existingNames && existingNames->contains(new_file_name))
+            continue;
+
+        // 读取目录之后可能有其它程序创建了同名文件，文件名不区分大小写的文件系统也需要以实际结果为准
         target_file_info = DFileService::instance()->createFileInfo(nullptr, targetDirectory->getUrlByChildFileName(new_file_name), false);
-    } while (target_file_info->exists());
+
+        if (!target_file_info->exists())
+            break;
+
+        if (existingNames)
+            existingNames->insert(new_file_name);
+    }
+
+    if (existingNames)
+        existingNames->insert(new_file_name);
 
     return new_file_name;
 }
 
+/*!
+ * \brief DFileCopyMoveJobPrivate::getNonExistsFileName 使用目标目录的文件名快照生成副本名称
+ *
+ * 在同一目录中多次生成副本名称时（如多次粘贴到源文件所在的目录），不再对每个候选名称查询文件是否存在，
+ * 这在 smb 等远程目录中非常耗时。非本地目录仍逐个查询。
+ */
+QString DFileCopyMoveJobPrivate::getNonExistsFileName(const DAbstractFileInfoPointer sourceFileInfo, const DAbstractFileInfoPointer targetDirectory)
+{
+    const QString &dirPath = targetDirectory->fileUrl().isLocalFile() ? targetDirectory->fileUrl().toLocalFile() : QString();
+
+    if (dirPath.isEmpty())
+        return getNewFileName(sourceFileInfo, targetDirectory);
+
+    QMutexLocker locker(&m_targetDirNamesMutex);
+    auto it = m_targetDirNames.find(dirPath);
+
+    if (it == m_targetDirNames.end()) {
+        QSet<QString> names;
+        DIR *dir = opendir(dirPath.toLocal8Bit().constData());
+
+        if (dir) {
+            struct dirent *ent = nullptr;
+
+            while ((ent = readdir(dir))) {
+                if (strcmp(ent->d_name, ".") != 0 && strcmp(ent->d_name, "..") != 0)
+                    names.insert(QString::fromLocal8Bit(ent->d_name));
+            }
+
+            closedir(dir);
+        }
+
+        it = m_targetDirNames.insert(dirPath, names);
+    }
+
+    return getNewFileName(sourceFileInfo, targetDirectory, &it.value());
+}
+
 bool DFileCopyMoveJobPrivate::doProcess(const DUrl &from, const DAbstractFileInfoPointer source_info, const DAbstractFileInfoPointer target_info, const bool isNew)
 {
 //    Q_Q(DFileCopyMoveJob);
@@ -827,7 +1204,13 @@ bool DFileCopyMoveJobPrivate::doProcess(const DUrl &from, const DAbstractFileInf
                 handler->setPermissions(fileInfo->fileUrl(), QFileDevice::ReadUser | QFileDevice::WriteUser | QFileDevice::ExeUser);
             }
 
-            ok = mergeDirectory(handler, fileInfo, DAbstractFileInfoPointer(nullptr));
+            //本地目录先通过目录描述符并行删除，没能删除的文件再按照以前的方式逐个处理并提示错误
+            if (fileInfo->fileUrl().isLocalFile() && !fileInfo->isGvfsMountFile()) {
+                TreeRemover remover(this, &m_pool, fileHints.testFlag(DFileCopyMoveJob::ForceDeleteFile));
+                ok = remover.remove(fileInfo->fileUrl().toLocalFile());
+            }
+            if (!ok && stateCheck())
+                ok = mergeDirectory(handler, fileInfo, DAbstractFileInfoPointer(nullptr));
             if (ok) {
                 joinToCompletedDirectoryList(from, DUrl(), size);
             }
@@ -923,10 +1306,30 @@ create_new_file_info:
         bool target_is_file = new_file_info->isFile() || new_file_info->isSymLink();
         //如果目标目录有相同名称的文件，但是拷贝的是目录，或者相反，就直接创建一个新的名称
         if (source_is_file != target_is_file) {
-            file_name = handle ? handle->getNonExistsFileName(source_info, target_info)
-                        : getNewFileName(source_info, target_info);
+            file_name = handle ? handle->getNonExistsFileName(q_ptr, source_info, target_info)
+                        : getNonExistsFileName(source_info, target_info);
             goto create_new_file_info;
         }
+        //续传时，上次已经拷贝完成的文件直接计入完成，未拷贝完的文件和已经创建的目录不再弹出冲突对话框
+        if (mode == DFileCopyMoveJob::CopyMode && m_copyJournal.isOpen()) {
+            const CopyJournal::State journalState = m_copyJournal.state(from, new_file_info->fileUrl());
+            if (source_info->isFile() && journalState == CopyJournal::CompletedState
+                    && new_file_info->size() == source_info->size()) {
+                joinToCompletedFileList(from, new_file_info->fileUrl(), source_info->size());
+                countrefinesize(source_info->size() <= 0 ? FileUtils::getMemoryPageSize() : source_info->size());
+                return true;
+            }
+            if ((source_info->isFile() && journalState == CopyJournal::InFlightState)
+                    || (source_info->isDir() && journalState == CopyJournal::DirectoryState)) {
+                goto journal_resume;
+            }
+        }
+        //目标文件与源文件相同时直接跳过，不再弹出冲突对话框，也不重新拷贝
+        if (mode == DFileCopyMoveJob::CopyMode && isIdenticalFile(source_info, new_file_info)) {
+            qCDebug(fileJob()) << "skip the identical file:" << new_file_info->fileUrl();
+            skipFileSize += source_info->size() <= 0 ? FileUtils::getMemoryPageSize() : source_info->size();
+            return true;
+        }
         DFileCopyMoveJob::Error errortype =  target_is_file ?
                                              DFileCopyMoveJob::FileExistsError : DFileCopyMoveJob::DirectoryExistsError;
         isErrorOccur = true;
@@ -985,8 +1388,8 @@ create_new_file_info:
             // 回收站的同名文件是以uuid形式存在的，如果这里使用source_info去构建副本的话，就会造成
             // file_name的值为uuid（副本）的情况，因此修改为new_file_info，getNonExistsFileName
             // 接口中只会使用到new_file_info的filename相关属性，因此对非回收站的文件也不会存在影响
-            file_name = handle ? handle->getNonExistsFileName(new_file_info, target_info)
-                        : getNewFileName(new_file_info, target_info);
+            file_name = handle ? handle->getNonExistsFileName(q_ptr, new_file_info, target_info)
+                        : getNonExistsFileName(new_file_info, target_info);
             goto create_new_file_info;
         default:
             //当前错误处理完成
@@ -1003,6 +1406,7 @@ create_new_file_info:
         }
     }
 
+journal_resume:
     //当前错误处理完成
     if (isErrorOccur) {
         errorQueueHandled();
@@ -1050,8 +1454,12 @@ process_file:
     if (source_info->isFile()) {
         bool ok = false;
         qint64 size = source_info->size();
+        const bool linkToDestination = mode == DFileCopyMoveJob::CopyMode && canLinkToDestination(source_info, new_file_info);
+        // 同一 inode 的其它链接已经复制过时，在目标中创建硬链接，不需要额外的空间
+        QPair<quint64, quint64> hardLinkKey(0, 0);
+        const QString &copiedHardLink = mode == DFileCopyMoveJob::CopyMode ? copiedHardLinkTarget(source_info, &hardLinkKey) : QString();
 
-        while (!checkFreeSpace(size)) {
+        while (!linkToDestination && copiedHardLink.isEmpty() && !checkFreeSpace(size)) {
             isErrorOccur = true;
             //错误队列处理
             errorQueueHandling();
@@ -1115,21 +1523,41 @@ process_file:
         }
 
         if (mode == DFileCopyMoveJob::CopyMode) {
-            if (new_file_info->isSymLink() || fileHints.testFlag(DFileCopyMoveJob::RemoveDestination)) {
+            bool deltaTarget = false;
+
+            // 已存在的目标可能是源文件的硬链接，覆盖写入会修改源文件，必须先删除
+            if (new_file_info->isSymLink() || fileHints.testFlag(DFileCopyMoveJob::RemoveDestination)
+                    || (linkToDestination && new_file_info->exists())) {
                 if (!removeFile(handler, new_file_info)) {
                     return false;
                 }
             } else if (new_file_info->exists()) {
                 // 复制文件时，如果需要覆盖，必须添加可写入权限
                 handler->setPermissions(new_file_info->fileUrl(), QFileDevice::WriteUser | QFileDevice::ReadUser);
+                deltaTarget = fileHints.testFlag(DFileCopyMoveJob::DeltaTransfer);
+            }
+
+            ok = (linkToDestination && this->linkToDestination(source_info, new_file_info))
+                    || (!copiedHardLink.isEmpty() && linkToCopiedHardLink(copiedHardLink, source_info, new_file_info));
+
+            // 覆盖已存在的大文件时先尝试只写入不同的块，失败时再完整拷贝
+            if (!ok && deltaTarget) {
+                ok = deltaCopyFile(source_info, new_file_info, handler);
+
+                if (!ok && !stateCheck())
+                    return false;
             }
 
-            ok = copyFile(source_info, new_file_info, handler);
+            if (!ok)
+                ok = copyFile(source_info, new_file_info, handler);
+
+            if (ok && hardLinkKey.second != 0 && copiedHardLink.isEmpty())
+                recordCopiedHardLink(hardLinkKey, new_file_info->fileUrl().toLocalFile());
         } else {
             // 光盘中的文件不能进行写操作，因此复制它
             const QString &sourcePath = source_info->fileUrl().toLocalFile();
             if (deviceListener->isFileFromDisc(sourcePath)) {
-                qInfo() << "canRename : " << source_info->canRename();
+                dfmHotInfo() << "canRename : " << source_info->canRename();
                 ok = copyFile(source_info, new_file_info, handler);
             } else {
                 ok = renameFile(handler, source_info, new_file_info);
@@ -1181,6 +1609,7 @@ process_file:
         const QDateTime si_last_modified = source_info->lastModified();
 
         if (mode == DFileCopyMoveJob::CopyMode) {
+            m_copyJournal.recordDirectory(from, new_file_info->fileUrl());
             ok = mergeDirectory(handler, source_info, new_file_info);
         } else if (!handler->rename(source_info->fileUrl(), new_file_info->fileUrl())) { // 尝试直接rename操作
             qCDebug(fileJob(), "Failed on rename, Well be copy and delete the directory");
@@ -1278,6 +1707,8 @@ bool DFileCopyMoveJobPrivate::mergeDirectory(const QSharedPointer<DFileHandler>
 
     if (enter_dir) {
         enterDirectory(fromInfo->fileUrl(), toInfo->fileUrl());
+        //在当前线程处理此目录时，后台并行预读它的子目录
+        prefetchSubDirectories(fromInfo->fileUrl());
     }
 
     //目录没有执行权限时不能正确的遍历到子文件的信息，后续删除或剪切复制逻辑无法成立
@@ -1332,7 +1763,10 @@ bool DFileCopyMoveJobPrivate::mergeDirectory(const QSharedPointer<DFileHandler>
                 copyinfo->toinfo = toInfo;
                 copyinfo->frominfo = fromInfo;
                 writeQueueEnqueue(copyinfo);
-            } else if (m_refineStat == DFileCopyMoveJob::RefineLocal) {
+            } else if (m_refineStat == DFileCopyMoveJob::RefineLocal
+                       || (m_refineStat == DFileCopyMoveJob::NoRefine && mode == DFileCopyMoveJob::CopyMode && m_isTagGvfsFile)
+                       || isVaultPoolCopy()) {
+                //子文件可能还在线程池中拷贝，等全部完成后再设置目录权限
                 QSharedPointer<DirSetPermissonInfo> dirinfo(new DirSetPermissonInfo);
                 dirinfo->handler = handler;
                 dirinfo->target = toInfo->fileUrl();
@@ -1354,7 +1788,12 @@ bool DFileCopyMoveJobPrivate::mergeDirectory(const QSharedPointer<DFileHandler>
 
     //  光盘中的目录不能被删除
     if (!fromInfo->canRename() || deviceListener->isFileFromDisc(fromInfo->fileUrl().toLocalFile())) {
-        qInfo() << "canReaname : " << fromInfo->canRename();
+        dfmHotInfo() << "canReaname : " << fromInfo->canRename();
+        return true;
+    }
+    // 子文件可能还在线程池中移动，全部完成后再删除
+    if (isVaultPoolCopy()) {
+        m_pendingRemoveDirs << qMakePair(handler, fromInfo);
         return true;
     }
     // 完成操作后删除原目录
@@ -1363,6 +1802,7 @@ bool DFileCopyMoveJobPrivate::mergeDirectory(const QSharedPointer<DFileHandler>
 
 bool DFileCopyMoveJobPrivate::doCopyFile(const DAbstractFileInfoPointer fromInfo, const DAbstractFileInfoPointer toInfo, const QSharedPointer<DFileHandler> &handler, int blockSize)
 {
+    DFM_TRACE_SPAN("copy", "doCopyFile");
     //多线程拷贝时发送当前拷贝信息
     if (m_refineStat != DFileCopyMoveJob::NoRefine){
         sendCopyInfo(fromInfo, toInfo);
@@ -1372,7 +1812,10 @@ bool DFileCopyMoveJobPrivate::doCopyFile(const DAbstractFileInfoPointer fromInfo
 
     QSharedPointer<DFileDevice> fromDevice = nullptr;
     if (fromInfo->isGvfsMountFile()) {
-        fromDevice.reset(new DGIOFileDevice(fromInfo->fileUrl()));
+        DGIOFileDevice *gioDevice = new DGIOFileDevice(fromInfo->fileUrl());
+        //多于一块的远程文件在后台预读，下一块数据的网络往返与写入目标文件同时进行
+        gioDevice->setReadAhead(fromInfo->size() > MAX_BUFFER_LEN);
+        fromDevice.reset(gioDevice);
     } else {
         DLocalFileDevice *localDevice = new DLocalFileDevice();
         localDevice->setFileUrl(fromInfo->fileUrl());
@@ -1395,6 +1838,9 @@ bool DFileCopyMoveJobPrivate::doCopyFile(const DAbstractFileInfoPointer fromInfo
         return handleUnknowUrlError(fromInfo, toInfo);
 
     bool isErrorOccur = false;
+    StreamChecksum source_checksum(m_verifyMode);
+    WritebackThrottle writeback;
+    qint64 resumeOffset = 0;
 open_file: {
         DFileCopyMoveJob::Action action = DFileCopyMoveJob::NoAction;
 
@@ -1446,8 +1892,15 @@ open_file: {
             return false;
         }
 
+        //断点续传，校验通过后从日志记录的位置继续拷贝，目标文件不能被截断
+        source_checksum.reset(m_verifyMode);
+        writeback = WritebackThrottle();
+        resumeOffset = resumeFromJournal(fromInfo, toInfo, fromDevice, toDevice, source_checksum);
+        const QIODevice::OpenMode toOpenMode = resumeOffset > 0 ? QIODevice::OpenMode(QIODevice::ReadWrite)
+                                                                : QIODevice::OpenMode(QIODevice::WriteOnly | QIODevice::Truncate);
+
         do {
-            if (toDevice->open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            if (toDevice->open(toOpenMode)) {
                 action = DFileCopyMoveJob::NoAction;
             } else {
                 qCDebug(fileJob()) << "open error:" << toInfo->fileUrl() << QThread::currentThreadId();
@@ -1517,23 +1970,29 @@ open_file: {
                 return false;
             }
         }
-    }
 
-#ifdef Q_OS_LINUX
-    // 开启读取优化，告诉内核，我们将顺序读取此文件
-
-    if (fromDevice->handle() > 0) {
-        posix_fadvise(fromDevice->handle(), 0, 0, POSIX_FADV_SEQUENTIAL);
+        if (resumeOffset > 0 && !toDevice->seek(resumeOffset)) {
+            const QString &errorStr = toDevice->errorString();
+            fromDevice->close();
+            toDevice->close();
+            return handleUnknowError(fromInfo, toInfo, errorStr);
+        }
     }
 
-    if (toDevice->handle() > 0) {
-        posix_fadvise(toDevice->handle(), 0, 0, POSIX_FADV_SEQUENTIAL);
-    }
-#endif
+    // 开启读取优化，告诉内核，我们将顺序读取此文件，按照页缓存策略决定是否丢弃读写过的数据
+    adviseCopyPageCache(fromDevice->handle(), toDevice->handle(), fromInfo->size(), writeback);
 
     currentJobDataSizeInfo.first = fromInfo->size();
     currentJobFileHandle = toDevice->handle();
-    uLong source_checksum = adler32(0L, nullptr, 0);
+    if (resumeOffset > 0) {
+        qCInfo(fileJob()) << "resume copy" << fromInfo->fileUrl() << "from" << resumeOffset;
+        currentJobDataSizeInfo.second += resumeOffset;
+        completedDataSize += resumeOffset;
+        completedDataSizeOnBlockDevice += resumeOffset;
+        countrefinesize(resumeOffset);
+    }
+    m_copyJournal.recordProgress(fromInfo->fileUrl(), toInfo->fileUrl(), resumeOffset);
+    qint64 journalPos = resumeOffset;
     DGIOFileDevice *fromgio = qobject_cast<DGIOFileDevice *>(fromDevice.data());
     DGIOFileDevice *togio = qobject_cast<DGIOFileDevice *>(toDevice.data());
     if (fromgio) {
@@ -1543,23 +2002,63 @@ open_file: {
         saveCurrentDevice(toInfo->fileUrl(),toDevice);
     }
 
-    qint64 block_Size = fromInfo->size() > MAX_BUFFER_LEN ? MAX_BUFFER_LEN : fromInfo->size();
+    //块大小根据目标设备类型和拷贝速度动态调整
+    qint64 block_Size = qMin(m_blockSizeController.blockSize(), fromInfo->size());
+    qint64 buffer_Size = block_Size;
+    m_blockSizeController.beginFile();
 
-    char *data = new char[block_Size + 1];
+    char *data = new char[buffer_Size + 1];
 
-    Q_FOREVER {
-        qint64 current_pos = fromDevice->pos();
-    read_data:
-        if (Q_UNLIKELY(!stateCheck())) {
-            cleanDoCopyFileSource(data, fromInfo, toInfo, fromDevice, toDevice);
-            return false;
-        }
+    // 本地文件之间优先由内核完成拷贝，不支持或中途失败时由下面的读写流程接着拷贝剩余的数据
+    const bool isKernelCopied = resumeOffset <= 0 && doCopyFileByKernel(fromInfo, toInfo, fromDevice, toDevice);
 
-        qint64 size_read = fromDevice->read(data, block_Size);
+    //预先分配剩余数据的空间，空间不足时在写入前报错
+    if (!isKernelCopied) {
+        DFileCopyMoveJob::Action action = DFileCopyMoveJob::NoAction;
+        do {
+            if (preallocateTargetFile(toDevice->handle(), toDevice->pos(), fromInfo->size())) {
+                action = DFileCopyMoveJob::NoAction;
+            } else {
+                isErrorOccur = true;
+                //错误队列处理
+                errorQueueHandling();
+                action = setAndhandleError(DFileCopyMoveJob::NotEnoughSpaceError, fromInfo, toInfo, QString());
+            }
+            //防止卡死
+            if (action == DFileCopyMoveJob::RetryAction) {
+                QThread::msleep(THREAD_SLEEP_TIME);
+            }
+        } while (action == DFileCopyMoveJob::RetryAction && this->isRunning());
+        //当前错误处理完成
+        if (isErrorOccur) {
+            errorQueueHandled(action == DFileCopyMoveJob::SkipAction ||
+                              action == DFileCopyMoveJob::NoAction);
+            isErrorOccur = false;
+        }
+        if (action == DFileCopyMoveJob::SkipAction) {
+            cleanDoCopyFileSource(data, fromInfo, toInfo, fromDevice, toDevice);
+            return true;
+        } else if (action != DFileCopyMoveJob::NoAction) {
+            cleanDoCopyFileSource(data, fromInfo, toInfo, fromDevice, toDevice);
+            return false;
+        }
+    }
+
+    while (!isKernelCopied) {
+        qint64 current_pos = fromDevice->pos();
+    read_data:
+        if (Q_UNLIKELY(!stateCheck())) {
+            cleanDoCopyFileSource(data, fromInfo, toInfo, fromDevice, toDevice);
+            return false;
+        }
+
+        qint64 size_read = fromDevice->read(data, block_Size);
         if (Q_UNLIKELY(!stateCheck())) {
             cleanDoCopyFileSource(data, fromInfo, toInfo, fromDevice, toDevice);
             return false;
         }
+        //限速和后台模式
+        throttleRead(size_read);
 
         if (Q_UNLIKELY(size_read <= 0)) {
             if (size_read == 0 && fromDevice->atEnd()) {
@@ -1663,10 +2162,9 @@ open_file: {
             }
         }
 
-        //fix 修复vfat格式u盘卡死问题，写入数据后立刻同步
-        if (m_isEveryReadAndWritesSnc && size_write > 0) {
-            toDevice->inherits("");
-            toDevice->syncToDisk(m_isVfat);
+        if (size_write > 0) {
+            syncAfterWrite(toDevice, writeback);
+            writeback.read(fromDevice->handle(), fromDevice->pos());
         }
         countrefinesize(size_write);
 
@@ -1745,44 +2243,55 @@ open_file: {
         completedDataSizeOnBlockDevice += size_write;
 
         if (Q_LIKELY(!fileHints.testFlag(DFileCopyMoveJob::DontIntegrityChecking))) {
-            source_checksum = adler32(source_checksum, reinterpret_cast<Bytef *>(data), static_cast<uInt>(size_read));
+            source_checksum.addData(data, size_read);
+        }
+
+        const qint64 next_Size = qMin(m_blockSizeController.update(size_read), fromInfo->size());
+        if (next_Size > buffer_Size) {
+            delete[] data;
+            buffer_Size = next_Size;
+            data = new char[buffer_Size + 1];
         }
+        block_Size = next_Size;
 
+        //定期记录拷贝位置，任务中断后可以从这里继续
+        if (m_copyJournal.isOpen() && toDevice->pos() - journalPos >= JOURNAL_PROGRESS_STEP) {
+            journalPos = toDevice->pos();
+            m_copyJournal.recordProgress(fromInfo->fileUrl(), toInfo->fileUrl(), journalPos);
+        }
     }
     delete[] data;
     data = nullptr;
 
-    // 拷贝完成后同步一下，避免长时间等待系统同步
-    toDevice->syncToDisk(m_isVfat);
+    // 拷贝完成后同步一下，避免长时间等待系统同步。有描述符的本地文件按照同步策略处理
+    if (toDevice->handle() <= 0 || m_isEveryReadAndWritesSnc)
+        toDevice->syncToDisk(m_isVfat);
 
+    releaseCopyPageCache(fromDevice->handle(), toDevice->handle(), writeback);
+    //对文件加权
+    const bool finalized = finalizeTargetFile(toDevice->handle(), fromInfo, toInfo, handler);
     fromDevice->close();
     toDevice->close();
+    if (!finalized)
+        finalizeTargetFile(-1, fromInfo, toInfo, handler);
+    if (m_syncPolicy == DFileCopyMoveJob::FileSync)
+        syncFileInBackground(toInfo->fileUrl().toLocalFile());
     countrefinesize(fromInfo->size() <= 0 ? FileUtils::getMemoryPageSize() : 0);
 
-    //对文件加权
-    handler->setFileTime(toInfo->fileUrl(), fromInfo->lastRead(), fromInfo->lastModified());
-
-    QFileDevice::Permissions permissions = fromInfo->permissions();
-    //! use stat function to read vault file permission.
-    QString path = fromInfo->fileUrl().path();
-    if (VaultController::isVaultFile(path)) {
-        permissions = VaultController::getPermissions(path);
-    } else if (deviceListener->isFileFromDisc(fromInfo->path())) { // fix bug 52610: 从光盘中复制出来的文件权限为只读，与 ubuntu 策略保持一致，拷贝出来权限为 rw-rw-r--
-        permissions |= MasteredMediaController::getPermissionsCopyToLocal();
-    }
-    //权限为0000时，源文件已经被删除，无需修改新建的文件的权限为0000
-    if (permissions != 0000)
-        handler->setPermissions(toInfo->fileUrl(), permissions);
-
 
     if (Q_UNLIKELY(!stateCheck())) {
         return false;
     }
 
     if (fileHints.testFlag(DFileCopyMoveJob::DontIntegrityChecking)) {
+        m_copyJournal.recordCompleted(fromInfo->fileUrl(), toInfo->fileUrl());
         return true;
     }
 
+    //校验时从磁盘读取目标文件，而不是读取刚刚写入的页缓存
+    if (m_verifyMode != DFileCopyMoveJob::NoVerify && !toInfo->isGvfsMountFile())
+        dropPageCache(toInfo->fileUrl().toLocalFile());
+
     DFileCopyMoveJob::Action action = DFileCopyMoveJob::NoAction;
 
     do {
@@ -1816,7 +2325,7 @@ open_file: {
     //校验数据完整性
 
     char *data1 = new char[blockSize + 1];
-    ulong target_checksum = adler32(0L, nullptr, 0);
+    StreamChecksum target_checksum(m_verifyMode);
 
     qint64 elapsed_time_checksum = 0;
 
@@ -1859,7 +2368,7 @@ open_file: {
             }
         }
 
-        target_checksum = adler32(target_checksum, reinterpret_cast<Bytef *>(data1), static_cast<uInt>(size));
+        target_checksum.addData(data1, size);
 
         if (Q_UNLIKELY(!stateCheck())) {
             delete [] data1;
@@ -1868,16 +2377,21 @@ open_file: {
     }
     delete [] data1;
 
+    const QByteArray &source_result = source_checksum.result();
+    const QByteArray &target_result = target_checksum.result();
+
     qCDebug(fileJob(), "Time spent of integrity check of the file: %lld", updateSpeedElapsedTimer->elapsed() - elapsed_time_checksum);
 
-    if (source_checksum != target_checksum) {
-        qCWarning(fileJob(), "Failed on file integrity checking, source file: 0x%lx, target file: 0x%lx", source_checksum, target_checksum);
+    if (source_result != target_result) {
+        qCWarning(fileJob(), "Failed on file integrity checking, source file: %s, target file: %s", source_result.constData(), target_result.constData());
         isErrorOccur = true;
         //错误队列处理
         errorQueueHandling();
         DFileCopyMoveJob::Action action = setAndhandleError(DFileCopyMoveJob::IntegrityCheckingError, fromInfo, toInfo);
 
         if (action == DFileCopyMoveJob::RetryAction) {
+            //目标文件的数据不可信，重试时从头开始拷贝
+            m_copyJournal.recordProgress(fromInfo->fileUrl(), toInfo->fileUrl(), 0);
             goto open_file;
         }
 
@@ -1899,7 +2413,8 @@ open_file: {
         errorQueueHandled();
         isErrorOccur = false;
     }
-    qCDebug(fileJob(), "adler value: 0x%lx", source_checksum);
+    qCDebug(fileJob(), "checksum value: %s", source_result.constData());
+    m_copyJournal.recordCompleted(fromInfo->fileUrl(), toInfo->fileUrl());
 
     return true;
 }
@@ -2033,17 +2548,9 @@ open_file:{
         }
     }
 
-#ifdef Q_OS_LINUX
-    // 开启读取优化，告诉内核，我们将顺序读取此文件
-
-    if (fromDevice->handle() > 0) {
-        posix_fadvise(fromDevice->handle(), 0, 0, POSIX_FADV_SEQUENTIAL);
-    }
-
-    if (toDevice->handle() > 0) {
-        posix_fadvise(toDevice->handle(), 0, 0, POSIX_FADV_SEQUENTIAL);
-    }
-#endif
+    // 开启读取优化，告诉内核，我们将顺序读取此文件，按照页缓存策略决定是否丢弃读写过的数据
+    WritebackThrottle pageCache;
+    adviseCopyPageCache(fromDevice->handle(), toDevice->handle(), fromInfo->size(), pageCache);
 
     currentJobDataSizeInfo.first = fromInfo->size();
     currentJobFileHandle = toDevice->handle();
@@ -2060,8 +2567,30 @@ open_file:{
     uLong source_checksum = adler32(0L, nullptr, 0);
     char *data = new char[block_Size + 1];
 
-    Q_FOREVER {
+    // 本地文件之间优先由内核完成拷贝，不支持或中途失败时由下面的读写流程接着拷贝剩余的数据
+    const bool isKernelCopied = doCopyFileByKernel(fromInfo, toInfo, fromDevice, toDevice);
+    const HoleScanner holes(!isKernelCopied && isKeepHoles() ? fromInfo->fileUrl().toLocalFile() : QString());
+
+    while (!isKernelCopied) {
         qint64 current_pos = fromDevice->pos();
+        //跳过空洞，目标文件中对应的位置不写入数据，进度按照文件的逻辑大小计算
+        if (holes.isSparse()) {
+            const qint64 dataPos = holes.nextData(current_pos);
+            if (dataPos > current_pos) {
+                if (!fromDevice->seek(dataPos) || !toDevice->seek(dataPos)) {
+                    cleanCopySources(data, fromDevice, toDevice, isErrorOccur);
+                    return handleUnknowError(fromInfo, toInfo, toDevice->errorString());
+                }
+                const qint64 holeSize = dataPos - current_pos;
+                currentJobDataSizeInfo.second += holeSize;
+                completedDataSize += holeSize;
+                completedDataSizeOnBlockDevice += holeSize;
+                countrefinesize(holeSize);
+                current_pos = dataPos;
+                if (dataPos >= fromInfo->size())
+                    break;
+            }
+        }
     read_data:
         if (Q_UNLIKELY(!stateCheck())) {
             cleanCopySources(data, fromDevice, toDevice, isErrorOccur);
@@ -2073,6 +2602,8 @@ open_file:{
             cleanCopySources(data, fromDevice, toDevice, isErrorOccur);
             return false;
         }
+        //限速和后台模式
+        throttleRead(size_read);
 
         if (Q_UNLIKELY(size_read <= 0)) {
             if (size_read == 0 && fromDevice->atEnd()) {
@@ -2210,25 +2741,18 @@ open_file:{
         }
     }
     delete[] data;
+    //文件末尾是空洞时没有写入数据，需要把目标文件扩展到源文件的大小
+    if (holes.isSparse() && !toDevice->resize(fromInfo->size()))
+        qCWarning(fileJob()) << "failed to resize the sparse file:" << toInfo->fileUrl() << toDevice->errorString();
+    releaseCopyPageCache(fromDevice->handle(), toDevice->handle(), pageCache);
+    //对文件加权
+    const bool finalized = finalizeTargetFile(toDevice->handle(), fromInfo, toInfo, handler);
     fromDevice->close();
     toDevice->close();
+    if (!finalized)
+        finalizeTargetFile(-1, fromInfo, toInfo, handler);
     countrefinesize(fromInfo->size() <= 0 ? FileUtils::getMemoryPageSize() : 0);
 
-    //对文件加权
-    handler->setFileTime(toInfo->fileUrl(), fromInfo->lastRead(), fromInfo->lastModified());
-
-    QFileDevice::Permissions permissions = fromInfo->permissions();
-    //! use stat function to read vault file permission.
-    QString path = fromInfo->fileUrl().path();
-    if (VaultController::isVaultFile(path)) {
-        permissions = VaultController::getPermissions(path);
-    } else if (deviceListener->isFileFromDisc(fromInfo->path())) { // fix bug 52610: 从光盘中复制出来的文件权限为只读，与 ubuntu 策略保持一致，拷贝出来权限为 rw-rw-r--
-        permissions |= MasteredMediaController::getPermissionsCopyToLocal();
-    }
-    //权限为0000时，源文件已经被删除，无需修改新建的文件的权限为0000
-    if (permissions != 0000)
-        handler->setPermissions(toInfo->fileUrl(), permissions);
-
     if (Q_UNLIKELY(!stateCheck())) {
         return false;
     }
@@ -2381,9 +2905,15 @@ bool DFileCopyMoveJobPrivate::doThreadPoolCopyFile()
     const QSharedPointer<DFileHandler> handler = threadInfo->handler;
 
     saveCopyFileUrl(toInfo->fileUrl());
-    bool ok = doCopySmallFilesOnDisk(fromInfo, toInfo, threadInfo->fromDevice, threadInfo->toDevice, threadInfo->handler);
+    bool ok = threadInfo->isRemote ? doCopyFile(fromInfo, toInfo, handler)
+              : doCopySmallFilesOnDisk(fromInfo, toInfo, threadInfo->fromDevice, threadInfo->toDevice, threadInfo->handler);
     removeCopyFileUrl(toInfo->fileUrl());
 
+    if (ok && threadInfo->removeSource && getLastErrorAction() != DFileCopyMoveJob::SkipAction) {
+        handler->setFileTime(toInfo->fileUrl(), fromInfo->lastRead(), fromInfo->lastModified());
+        ok = doRemoveFile(handler, fromInfo, toInfo);
+    }
+
     removeCurrentDevice(fromInfo->fileUrl());
     removeCurrentDevice(toInfo->fileUrl());
     if (!ok)
@@ -2393,6 +2923,7 @@ bool DFileCopyMoveJobPrivate::doThreadPoolCopyFile()
 
 bool DFileCopyMoveJobPrivate::doCopyFileOnBlock(const DAbstractFileInfoPointer fromInfo, const DAbstractFileInfoPointer toInfo, const QSharedPointer<DFileHandler> &handler, int blockSize)
 {
+    DFM_TRACE_SPAN("copy", "doCopyFileOnBlock");
     DFileCopyMoveJob::Action action = DFileCopyMoveJob::NoAction;
     int fromfd = -1;
 
@@ -2436,26 +2967,21 @@ bool DFileCopyMoveJobPrivate::doCopyFileOnBlock(const DAbstractFileInfoPointer f
         q_ptr->stop();
         return false;
     }
-#ifdef Q_OS_LINUX
-    // 开启读取优化，告诉内核，我们将顺序读取此文件
-
-    if (fromfd > 0) {
-        posix_fadvise(fromfd, 0, 0, POSIX_FADV_SEQUENTIAL);
-    }
-
-#endif
-    qint64 size_block = fromInfo->size() > MAX_BUFFER_LEN ? MAX_BUFFER_LEN : fromInfo->size();
-    size_block = blockSize;
+    // 开启读取优化，告诉内核，我们将顺序读取此文件，目标文件的页缓存在写线程中处理
+    WritebackThrottle readCache;
+    adviseCopyPageCache(fromfd, -1, fromInfo->size(), readCache);
+    //缓存池中每个buffer的大小为MAX_BUFFER_LEN
+    qint64 size_block = qMin<qint64>(blockSize, MAX_BUFFER_LEN);
     FileCopyInfoPointer copyinfo(new FileCopyInfo());
     copyinfo->handler = handler;
     copyinfo->frominfo = fromInfo;
     copyinfo->toinfo = toInfo;
     lseek(fromfd, 0, SEEK_SET);
     qint64 current_pos = 0;
+    const HoleScanner holes(isKeepHoles() ? fromInfo->fileUrl().toLocalFile() : QString());
     while (true) {
-        while(checkWritQueueCount()) {
-            QThread::msleep(1);
-        }
+        //写队列满了就等待写线程消费，不再轮询
+        waitWriteQueueNotFull();
         copyinfo->currentpos = current_pos;
 
         if (Q_UNLIKELY(!stateCheck())) {
@@ -2463,6 +2989,20 @@ bool DFileCopyMoveJobPrivate::doCopyFileOnBlock(const DAbstractFileInfoPointer f
             return false;
         }
 
+        //跳过空洞，写线程按照每块数据的位置写入，进度按照文件的逻辑大小计算
+        if (holes.isSparse()) {
+            const qint64 dataPos = holes.nextData(current_pos);
+            if (dataPos > current_pos) {
+                completedProgressDataSize += dataPos - current_pos;
+                countrefinesize(dataPos - current_pos);
+                current_pos = dataPos;
+                copyinfo->currentpos = current_pos;
+                if (current_pos >= fromInfo->size())
+                    break;
+                lseek(fromfd, current_pos, SEEK_SET);
+            }
+        }
+
         if (skipReadFileDealWriteThread(fromInfo->fileUrl()))
         {
             completedProgressDataSize += fromInfo->size() <= 0
@@ -2472,19 +3012,27 @@ bool DFileCopyMoveJobPrivate::doCopyFileOnBlock(const DAbstractFileInfoPointer f
             close(fromfd);
             return true;
         }
-        char *buffer = new char[size_block + 1];
+        //从缓存池中取buffer，缓存池用完时等待写线程归还，保证内存占用有上限
+        char *buffer = acquireCopyBuffer();
+        if (Q_UNLIKELY(!buffer)) {
+            close(fromfd);
+            return false;
+        }
         qint64 size_read = read(fromfd, buffer, static_cast<size_t>(size_block));
 
         if (Q_UNLIKELY(!stateCheck())) {
-            delete[]  buffer;
+            releaseCopyBuffer(buffer);
             close(fromfd);
             return false;
         }
+        //限速和后台模式
+        throttleRead(size_read);
 
         if (Q_UNLIKELY(size_read <= 0)) {
             if (size_read == 0 && current_pos == fromInfo->size()) {
                 copyinfo->buffer = buffer;
                 copyinfo->size = size_read;
+                releaseCopyPageCache(fromfd, -1, readCache);
                 break;
             }
 
@@ -2499,7 +3047,7 @@ bool DFileCopyMoveJobPrivate::doCopyFileOnBlock(const DAbstractFileInfoPointer f
             case DFileCopyMoveJob::RetryAction: {
                 if (!lseek(fromfd, current_pos, SEEK_SET)) {
                     setError(DFileCopyMoveJob::UnknowError, "");
-                    delete[]  buffer;
+                    releaseCopyBuffer(buffer);
                     close(fromfd);
                     q_ptr->stop();
                     return false;
@@ -2514,12 +3062,12 @@ bool DFileCopyMoveJobPrivate::doCopyFileOnBlock(const DAbstractFileInfoPointer f
                         ? FileUtils::getMemoryPageSize() : fromInfo->size() - current_pos;
                 countrefinesize(fromInfo->size() <= 0
                                 ? FileUtils::getMemoryPageSize() : fromInfo->size() - current_pos);
-                delete[]  buffer;
+                releaseCopyBuffer(buffer);
                 return true;
             default:
                 close(fromfd);
                 q_ptr->stop();
-                delete[]  buffer;
+                releaseCopyBuffer(buffer);
                 return false;
             }
         } else {
@@ -2531,6 +3079,7 @@ bool DFileCopyMoveJobPrivate::doCopyFileOnBlock(const DAbstractFileInfoPointer f
             tmpinfo->buffer = buffer;
             tmpinfo->size = size_read;
             current_pos += size_read;
+            readCache.read(fromfd, current_pos);
 
             writeQueueEnqueue(tmpinfo);
             if (!m_isWriteThreadStart.load()) {
@@ -2656,6 +3205,20 @@ bool DFileCopyMoveJobPrivate::doRenameFile(const QSharedPointer<DFileHandler> &h
 
     qCDebug(fileJob(), "Failed on rename, Well be copy and delete the file");
 
+    // 移动到保险箱时在线程池中拷贝，拷贝完成后在线程中删除源文件
+    if (canCopyVaultFileInPool(oldInfo)) {
+        if (!stateCheck())
+            return false;
+        QSharedPointer<ThreadCopyInfo> threadInfo(new ThreadCopyInfo);
+        threadInfo->fromInfo = oldInfo;
+        threadInfo->toInfo = newInfo;
+        threadInfo->handler = handler;
+        threadInfo->isRemote = true;
+        threadInfo->removeSource = true;
+        copyFileInPool(threadInfo);
+        return true;
+    }
+
     // 先复制再删除
     if (!doCopyFile(oldInfo, newInfo, handler)) {
         return false;
@@ -2752,6 +3315,20 @@ bool DFileCopyMoveJobPrivate::copyFile(const DAbstractFileInfoPointer fromInfo,
     }
     beginJob(JobInfo::Copy, fromInfo->fileUrl(), toInfo->fileUrl());
     bool ok = true;
+    //拷贝小文件到网络目录时，在线程池中同时打开多个文件流，
+    //使一个文件的打开、设置属性等往返请求和其它文件的数据传输重叠；拷贝到保险箱时同样并行写入多个文件
+    if (canCopyRemoteFileInPool(fromInfo) || canCopyVaultFileInPool(fromInfo)) {
+        if (!stateCheck())
+            return false;
+        QSharedPointer<ThreadCopyInfo> threadInfo(new ThreadCopyInfo);
+        threadInfo->fromInfo = fromInfo;
+        threadInfo->toInfo = toInfo;
+        threadInfo->handler = handler;
+        threadInfo->isRemote = true;
+        copyFileInPool(threadInfo);
+        endJob();
+        return ok;
+    }
     if (m_refineStat == DFileCopyMoveJob::NoRefine) {
          saveCopyFileUrl(toInfo->fileUrl());
          ok = doCopyFile(fromInfo, toInfo, handler, blockSize);
@@ -2806,6 +3383,36 @@ bool DFileCopyMoveJobPrivate::copyFile(const DAbstractFileInfoPointer fromInfo,
     return ok;
 }
 
+bool DFileCopyMoveJobPrivate::canCopyRemoteFileInPool(const DAbstractFileInfoPointer &fromInfo) const
+{
+    // 剪切时拷贝完成后要立即删除源文件，只有拷贝可以异步进行
+    return m_refineStat == DFileCopyMoveJob::NoRefine && mode == DFileCopyMoveJob::CopyMode
+            && m_isTagGvfsFile && fromInfo && fromInfo->size() >= 0 && fromInfo->size() < REMOTE_SMALL_FILE_SIZE;
+}
+
+/*!
+ * \brief DFileCopyMoveJobPrivate::isVaultPoolCopy 写入保险箱的文件在线程池中并行拷贝
+ */
+bool DFileCopyMoveJobPrivate::isVaultPoolCopy() const
+{
+    return m_isVaultTarget && m_refineStat == DFileCopyMoveJob::NoRefine;
+}
+
+bool DFileCopyMoveJobPrivate::canCopyVaultFileInPool(const DAbstractFileInfoPointer &fromInfo) const
+{
+    return isVaultPoolCopy() && fromInfo && !fromInfo->isSymLink() && fromInfo->size() >= 0;
+}
+
+void DFileCopyMoveJobPrivate::copyFileInPool(const QSharedPointer<ThreadCopyInfo> &threadInfo)
+{
+    {
+        QMutexLocker lk(&m_threadMutex);
+        m_threadInfos << threadInfo;
+    }
+    QtConcurrent::run(&m_pool, this, static_cast<bool(DFileCopyMoveJobPrivate::*)()>
+                      (&DFileCopyMoveJobPrivate::doThreadPoolCopyFile));
+}
+
 bool DFileCopyMoveJobPrivate::removeFile(const QSharedPointer<DFileHandler> &handler, const DAbstractFileInfoPointer fileInfo)
 {
     beginJob(JobInfo::Remove, fileInfo->fileUrl(), DUrl());
@@ -2826,6 +3433,103 @@ bool DFileCopyMoveJobPrivate::renameFile(const QSharedPointer<DFileHandler> &han
     return ok;
 }
 
+/*!
+ * \brief DFileCopyMoveJobPrivate::bulkRenameOnSameDevice 盘内剪切时批量重命名源文件
+ * 使用目录描述符和renameat2(RENAME_NOREPLACE)，目标存在时直接返回EEXIST，不再逐个创建文件信息判断是否存在，
+ * 重命名成功的文件记录到m_bulkRenamedUrls，冲突和失败的文件在批量重命名结束后走逐个处理的流程，统一弹出冲突对话框
+ */
+void DFileCopyMoveJobPrivate::bulkRenameOnSameDevice()
+{
+    m_bulkRenamedUrls.clear();
+#ifdef SYS_renameat2
+    if (mode != DFileCopyMoveJob::CutMode || !targetUrl.isLocalFile() || m_isTagGvfsFile || !m_fileNameList.isEmpty())
+        return;
+
+    //回收站中的文件名需要转换，走以前的流程
+    const QString &trashPath = DFMStandardPaths::location(DFMStandardPaths::TrashPath);
+    QString targetPath = targetUrl.toLocalFile();
+    if (targetPath.startsWith(trashPath))
+        return;
+    if (!targetPath.endsWith('/'))
+        targetPath.append('/');
+
+    int targetFd = open(targetPath.toLocal8Bit().constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (targetFd < 0)
+        return;
+    struct stat targetStat;
+    if (fstat(targetFd, &targetStat) != 0) {
+        close(targetFd);
+        return;
+    }
+
+    QHash<QString, int> sourceDirFds;
+    int renamedCount = 0;
+    for (const DUrl &source : sourceUrlList) {
+        if (!stateCheck())
+            break;
+        if (!source.isLocalFile())
+            continue;
+        const QString &sourcePath = source.toLocalFile();
+        const int index = sourcePath.lastIndexOf('/');
+        if (sourcePath.startsWith(trashPath) || index < 0 || index == sourcePath.length() - 1)
+            continue;
+        //在同一个目录内剪切不需要做任何操作，由以前的流程跳过
+        const QString &parentPath = sourcePath.left(index + 1);
+        if (parentPath == targetPath)
+            continue;
+
+        auto dirFd = sourceDirFds.find(parentPath);
+        if (dirFd == sourceDirFds.end())
+            dirFd = sourceDirFds.insert(parentPath, open(parentPath.toLocal8Bit().constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+        if (dirFd.value() < 0)
+            continue;
+
+        const QByteArray &name = sourcePath.mid(index + 1).toLocal8Bit();
+        struct stat sourceStat;
+        if (fstatat(dirFd.value(), name.constData(), &sourceStat, AT_SYMLINK_NOFOLLOW) != 0 || sourceStat.st_dev != targetStat.st_dev)
+            continue;
+        //设备文件等特殊文件由以前的流程报错
+        if (!S_ISREG(sourceStat.st_mode) && !S_ISDIR(sourceStat.st_mode) && !S_ISLNK(sourceStat.st_mode))
+            continue;
+
+        if (syscall(SYS_renameat2, dirFd.value(), name.constData(), targetFd, name.constData(), RENAME_NOREPLACE) != 0) {
+            //内核不支持renameat2时全部走以前的流程
+            if (errno == ENOSYS)
+                break;
+            //目标已存在或者其它错误，留给以前的流程弹出冲突对话框或者错误提示
+            continue;
+        }
+
+        const DUrl &targetFileUrl = DUrl::fromLocalFile(targetPath + sourcePath.mid(index + 1));
+        m_bulkRenamedUrls.insert(source, targetFileUrl);
+        completedDataSize += sourceStat.st_size;
+        if (S_ISDIR(sourceStat.st_mode)) {
+            completedDirectoryList << qMakePair(source, targetFileUrl);
+            countrefinesize(m_currentDirSize <= 0 ? FileUtils::getMemoryPageSize() : m_currentDirSize);
+        } else {
+            completedFileList << qMakePair(source, targetFileUrl);
+            countrefinesize(sourceStat.st_size <= 0 ? FileUtils::getMemoryPageSize() : sourceStat.st_size);
+        }
+        ++renamedCount;
+    }
+
+    for (int fd : sourceDirFds) {
+        if (fd >= 0)
+            close(fd);
+    }
+    close(targetFd);
+
+    if (renamedCount > 0) {
+        m_isNeedShowProgress = true;
+        //批量完成后只通知一次
+        completedFilesCount += renamedCount;
+        Q_EMIT q_ptr->completedFilesCountChanged(completedFilesCount);
+        needUpdateProgress = true;
+    }
+    qCDebug(fileJob(), "bulk renamed %d of %d files", renamedCount, sourceUrlList.count());
+#endif
+}
+
 bool DFileCopyMoveJobPrivate::linkFile(const QSharedPointer<DFileHandler> &handler, const DAbstractFileInfoPointer fileInfo, const QString &linkPath)
 {
     beginJob(JobInfo::Link, DUrl(linkPath), fileInfo->fileUrl());
@@ -2947,19 +3651,11 @@ void DFileCopyMoveJobPrivate::updateCopyProgress()
 {
     // 网络文件使用统计线程的值获取总大小. 非网络文件使用 fts_* 系统 API 统计函数同步统计总大小
     bool fromLocal = (m_isFileOnDiskUrls && targetUrl.isValid());
-    const qint64 totalSize = fromLocal ? totalsize : fileStatistics->totalProgressSize();
-    //通过getCompletedDataSize取出的已传输的数据大小后期会远超实际数据大小，这种情况下直接使用completedDataSize
-    qint64 dataSize(getCompletedDataSize());
-    // completedDataSize 可能一直为 0
-    if (dataSize > completedDataSize && completedDataSize > 0) {
-        dataSize = completedDataSize;
-    }
-
-    dataSize += completedProgressDataSize;
-    dataSize -= m_gvfsFileInnvliadProgress;
-
-    //优化
-    dataSize = m_bDestLocal ? m_refineCopySize : dataSize;
+    // 本地文件统计完成前使用统计线程当前的大小
+    const qint64 totalSize = (fromLocal && m_isCountSizeOver) ? totalsize : fileStatistics->totalProgressSize();
+    //已传输的数据大小由拷贝线程累加，这里只读取计数
+    qint64 dataSize = m_bDestLocal ? m_refineCopySize
+                                   : getCompletedDataSize() + completedProgressDataSize - m_gvfsFileInnvliadProgress;
 
     dataSize += skipFileSize;
 
@@ -2970,7 +3666,7 @@ void DFileCopyMoveJobPrivate::updateCopyProgress()
         qreal realProgress = qreal(dataSize) / totalSize;
         if (realProgress > lastProgress)
             lastProgress = realProgress;
-        qCDebug(fileJob(), "completed data size: %lld, total data size: %lld,m_refineCopySize = %lld", dataSize, totalSize, completedProgressDataSize);
+        qCDebug(fileJob(), "completed data size: %lld, total data size: %lld,m_refineCopySize = %lld", dataSize, totalSize, qint64(completedProgressDataSize));
     } else {
         //预设一个总大小，让前期进度平滑一些（目前阈值取1mb）
         qreal virtualSize = totalSize < 1000000 ? 1000000 : totalSize;
@@ -3028,7 +3724,19 @@ void DFileCopyMoveJobPrivate::updateSpeed()
     if (time == 0)
         return;
 
-    qint64 speed = total_size / time * 1000;
+    // 速度使用指数加权平均，时间间隔越长新的采样权重越大，暂停后恢复时不会突然跳变
+    const qint64 interval = time - m_lastSpeedTime;
+    if (m_lastSpeedTime <= 0 || interval < 0) {
+        m_smoothedSpeed = qreal(total_size) / time * 1000;
+    } else if (interval > 0) {
+        const qreal currentSpeed = qreal(total_size - m_lastSpeedSize) / interval * 1000;
+        const qreal alpha = 1 - qExp(-qreal(interval) / SPEED_SMOOTH_TIME_MS);
+        m_smoothedSpeed += alpha * (currentSpeed - m_smoothedSpeed);
+    }
+    m_lastSpeedTime = time;
+    m_lastSpeedSize = total_size;
+
+    qint64 speed = qMax<qint64>(0, qRound64(m_smoothedSpeed));
 
     // 如果进度已经是100%，则不应该再有速度波动
     if (fileStatistics->isFinished() && total_size >= fileStatistics->totalSize()) {
@@ -3058,7 +3766,6 @@ void DFileCopyMoveJobPrivate::_q_updateProgress()
 
 void DFileCopyMoveJobPrivate::countrefinesize(const qint64 &size)
 {
-    QMutexLocker lock(&m_refineMutex);
     m_refineCopySize += size;
 }
 
@@ -3094,19 +3801,41 @@ bool DFileCopyMoveJobPrivate::checkWritQueueEmpty()
 bool DFileCopyMoveJobPrivate::checkWritQueueCount()
 {
     QMutexLocker lk(&m_copyInfoQueueMutex);
-    return m_writeFileQueue.count() > 300;
+    return m_writeFileQueue.count() > WRITE_QUEUE_MAX_COUNT;
+}
+
+void DFileCopyMoveJobPrivate::waitWriteQueueNotFull()
+{
+    QMutexLocker lk(&m_copyInfoQueueMutex);
+    while (m_writeFileQueue.count() > WRITE_QUEUE_MAX_COUNT && state != DFileCopyMoveJob::StoppedState) {
+        m_writeQueueNotFullCondition.wait(&m_copyInfoQueueMutex, THREAD_SLEEP_TIME);
+    }
+}
+
+void DFileCopyMoveJobPrivate::waitWriteQueueNotEmpty()
+{
+    QMutexLocker lk(&m_copyInfoQueueMutex);
+    while (m_writeFileQueue.isEmpty() && checkRefineCopyProccessSate(DFileCopyMoveJob::ReadFileProccessOver)
+           && state != DFileCopyMoveJob::StoppedState) {
+        m_writeQueueNotEmptyCondition.wait(&m_copyInfoQueueMutex, THREAD_SLEEP_TIME);
+    }
 }
 
 QSharedPointer<DFileCopyMoveJobPrivate::FileCopyInfo> DFileCopyMoveJobPrivate::writeQueueDequeue()
 {
     QMutexLocker lk(&m_copyInfoQueueMutex);
-    return m_writeFileQueue.dequeue();
+    FileCopyInfoPointer info = m_writeFileQueue.dequeue();
+    m_writeQueueNotFullCondition.wakeOne();
+    return info;
 }
 
 void DFileCopyMoveJobPrivate::writeQueueEnqueue(const QSharedPointer<DFileCopyMoveJobPrivate::FileCopyInfo> &copyinfo)
 {
     QMutexLocker lk(&m_copyInfoQueueMutex);
     m_writeFileQueue.enqueue(copyinfo);
+    DFM_TRACE_COUNTER("copy", "writeQueue", m_writeFileQueue.count());
+    DFM_METRIC_SET("copy.writeQueue", m_writeFileQueue.count());
+    m_writeQueueNotEmptyCondition.wakeOne();
 }
 
 void DFileCopyMoveJobPrivate::errorQueueHandling()
@@ -3152,7 +3881,7 @@ void DFileCopyMoveJobPrivate::errorQueueHandled(const bool &isNotCancel)
 void DFileCopyMoveJobPrivate::releaseCopyInfo(const DFileCopyMoveJobPrivate::FileCopyInfoPointer &info)
 {
     if (info->buffer) {
-        delete [] info->buffer;
+        releaseCopyBuffer(info->buffer);
         info->buffer = nullptr;
     }
     for (auto fd : m_writeOpenFd) {
@@ -3162,33 +3891,451 @@ void DFileCopyMoveJobPrivate::releaseCopyInfo(const DFileCopyMoveJobPrivate::Fil
     m_writeOpenFd.clear();
 }
 
-bool DFileCopyMoveJobPrivate::writeRefineThread()
+char *DFileCopyMoveJobPrivate::acquireCopyBuffer()
 {
-    bool ok = true;
-    while (checkRefineCopyProccessSate(DFileCopyMoveJob::ReadFileProccessOver)) {
-        ok = writeToFileByQueue();
-        if (!ok) {
-            break;
+    QMutexLocker lk(&m_copyBufferMutex);
+    while (m_freeCopyBuffers.isEmpty() && m_copyBufferCount >= COPY_BUFFER_POOL_NUM) {
+        if (state == DFileCopyMoveJob::StoppedState)
+            return nullptr;
+        m_copyBufferCondition.wait(&m_copyBufferMutex, THREAD_SLEEP_TIME);
+    }
+
+    if (!m_freeCopyBuffers.isEmpty())
+        return m_freeCopyBuffers.pop();
+
+    // 按页对齐，目标文件以O_DIRECT打开时也可以直接写入
+    void *buffer = nullptr;
+    if (posix_memalign(&buffer, static_cast<size_t>(FileUtils::getMemoryPageSize()), MAX_BUFFER_LEN) != 0) {
+        qCWarning(fileJob()) << "failed to alloc copy buffer!";
+        return nullptr;
+    }
+    ++m_copyBufferCount;
+
+    return static_cast<char *>(buffer);
+}
+
+void DFileCopyMoveJobPrivate::releaseCopyBuffer(char *buffer)
+{
+    if (!buffer)
+        return;
+
+    QMutexLocker lk(&m_copyBufferMutex);
+    m_freeCopyBuffers.push(buffer);
+    m_copyBufferCondition.wakeOne();
+}
+
+void DFileCopyMoveJobPrivate::clearCopyBufferPool()
+{
+    QMutexLocker lk(&m_copyBufferMutex);
+    while (!m_freeCopyBuffers.isEmpty()) {
+        free(m_freeCopyBuffers.pop());
+        --m_copyBufferCount;
+    }
+}
+
+qint64 DFileCopyMoveJobPrivate::BlockSizeController::defaultBlockSize(bool isNetwork, bool isRemovable)
+{
+    // 网络文件每次请求的往返耗时较大，使用大块减少请求次数
+    if (isNetwork)
+        return 4 * MAX_BUFFER_LEN;
+    // 移动设备的写缓存较小，从小一些的块开始
+    if (isRemovable)
+        return MAX_BUFFER_LEN / 2;
+
+    return MAX_BUFFER_LEN;
+}
+
+void DFileCopyMoveJobPrivate::BlockSizeController::reset(qint64 initSize)
+{
+    QMutexLocker lk(&m_mutex);
+    const qint64 blockSize = qBound<qint64>(ADAPTIVE_BLOCK_MIN_LEN, initSize, ADAPTIVE_BLOCK_MAX_LEN);
+    m_blockSize.store(qMax(m_alignment, blockSize / m_alignment * m_alignment));
+    m_direction = 1;
+    m_lastThroughput = 0;
+    restartWindow();
+}
+
+void DFileCopyMoveJobPrivate::BlockSizeController::setAlignment(qint64 alignment)
+{
+    QMutexLocker lk(&m_mutex);
+    m_alignment = qMax<qint64>(1, alignment);
+}
+
+void DFileCopyMoveJobPrivate::BlockSizeController::beginFile()
+{
+    QMutexLocker lk(&m_mutex);
+    restartWindow();
+}
+
+void DFileCopyMoveJobPrivate::BlockSizeController::restartWindow()
+{
+    m_windowBytes = 0;
+    m_windowTimer.start();
+}
+
+qint64 DFileCopyMoveJobPrivate::BlockSizeController::update(qint64 size)
+{
+    //拷贝网络小文件时会在多个线程中调用
+    QMutexLocker lk(&m_mutex);
+    m_windowBytes += size;
+    const qint64 elapsed = m_windowTimer.elapsed();
+    if (elapsed < ADAPTIVE_BLOCK_WINDOW_MS)
+        return m_blockSize.load();
+
+    // 窗口时间过长说明中途暂停了或者在等待错误处理，这次的速度不可信
+    if (elapsed > ADAPTIVE_BLOCK_WINDOW_MS * 20) {
+        restartWindow();
+        return m_blockSize.load();
+    }
+
+    const qreal throughput = qreal(m_windowBytes) / elapsed;
+    int step = m_direction;
+    if (m_lastThroughput > 0) {
+        if (throughput < m_lastThroughput * 0.9) {
+            // 上次调整后变慢了，退回去并停止调整；已稳定时变慢说明环境变了，重新开始增大
+            step = m_direction != 0 ? -m_direction : 1;
+            m_direction = m_direction != 0 ? 0 : 1;
+        } else if (throughput < m_lastThroughput * 1.1) {
+            // 速度变化不明显，保持当前块大小
+            step = 0;
+            m_direction = 0;
+        }
+    }
+    m_lastThroughput = throughput;
+
+    qint64 blockSize = m_blockSize.load();
+    if (step > 0) {
+        blockSize = qMin<qint64>(blockSize * 2, ADAPTIVE_BLOCK_MAX_LEN);
+    } else if (step < 0) {
+        blockSize = qMax<qint64>(blockSize / 2, ADAPTIVE_BLOCK_MIN_LEN);
+    }
+    blockSize = qMax(m_alignment, blockSize / m_alignment * m_alignment);
+    if (blockSize != m_blockSize.load())
+        qCDebug(fileJob(), "adaptive block size: %lld, throughput: %.2f bytes/ms", blockSize, throughput);
+    m_blockSize.store(blockSize);
+
+    restartWindow();
+    return blockSize;
+}
+
+qint64 DFileCopyMoveJobPrivate::BlockSizeController::blockSize() const
+{
+    return m_blockSize.load();
+}
+
+/*!
+ * \brief DFileCopyMoveJobPrivate::CopyJournal::open 打开拷贝日志，读取上次任务中断前留下的记录
+ * \param filePath 日志文件路径
+ * \return 是否可以写入日志
+ */
+bool DFileCopyMoveJobPrivate::CopyJournal::open(const QString &filePath)
+{
+    QMutexLocker lk(&m_mutex);
+
+    if (m_file.isOpen())
+        m_file.close();
+    m_records.clear();
+    m_file.setFileName(filePath);
+
+    // 每行一条记录：类型 偏移 源文件 目标文件，后面的记录覆盖前面的
+    if (m_file.open(QIODevice::ReadOnly)) {
+        while (!m_file.atEnd()) {
+            const QByteArrayList &fields = m_file.readLine().trimmed().split(' ');
+            if (fields.size() != 4 || fields.at(0).size() != 1)
+                continue;
+
+            Record record;
+            record.offset = fields.at(1).toLongLong();
+            switch (fields.at(0).at(0)) {
+            case 'D':
+                record.state = DirectoryState;
+                break;
+            case 'P':
+                record.state = InFlightState;
+                break;
+            case 'F':
+                record.state = CompletedState;
+                break;
+            default:
+                continue;
+            }
+            m_records.insert(fields.at(2) + ' ' + fields.at(3), record);
         }
+        m_file.close();
+        qCInfo(fileJob()) << "load copy journal" << filePath << "records:" << m_records.size();
     }
-    if (ok && stateCheck()) {
-        ok = writeToFileByQueue();
-    } else {
-        q_ptr->stop();
+
+    QDir().mkpath(QFileInfo(filePath).absolutePath());
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qCWarning(fileJob()) << "failed to open copy journal" << filePath << m_file.errorString();
+        m_records.clear();
+        return false;
     }
-    cancelReadFileDealWriteThread();
-    qInfo() << "write thread finish!";
+
+    m_isOpen = true;
     return true;
 }
 
-//为考虑线程之间的同步问题（错误同步，假如，读线程出错了，
-//1.重试时写线程是不是要全部停住(已暂停)
-//2.重试失败，跳过当前文件应该怎么处理（加入一个跳过写入队列，写线程检查当前的写队列，移除都所有的要移除的选项）
-//3.重试失败，直接退出拷贝怎么处理（处理所有的写入队列，清理掉）。
-//写线程出错时，1.弹出提示框时，是否要暂停读线程2.点击跳过应该怎么处理，清理掉有相同的文件描述符的写队列、关闭文件读文件是否要暂停3.关闭拷贝时，要怎么处理）
-bool DFileCopyMoveJobPrivate::writeToFileByQueue()
+/*!
+ * \brief DFileCopyMoveJobPrivate::CopyJournal::close 关闭拷贝日志
+ * \param removeFile 任务已经完成，不再需要续传时删除日志文件
+ */
+void DFileCopyMoveJobPrivate::CopyJournal::close(bool removeFile)
 {
-    while (!checkWritQueueEmpty()) {
+    QMutexLocker lk(&m_mutex);
+
+    m_isOpen = false;
+    m_records.clear();
+    if (m_file.isOpen())
+        m_file.close();
+    if (removeFile && !m_file.fileName().isEmpty())
+        m_file.remove();
+}
+
+bool DFileCopyMoveJobPrivate::CopyJournal::isOpen() const
+{
+    return m_isOpen.load();
+}
+
+void DFileCopyMoveJobPrivate::CopyJournal::recordDirectory(const DUrl &from, const DUrl &to)
+{
+    writeRecord('D', from, to, 0);
+}
+
+void DFileCopyMoveJobPrivate::CopyJournal::recordProgress(const DUrl &from, const DUrl &to, qint64 offset)
+{
+    writeRecord('P', from, to, offset);
+}
+
+void DFileCopyMoveJobPrivate::CopyJournal::recordCompleted(const DUrl &from, const DUrl &to)
+{
+    writeRecord('F', from, to, 0);
+}
+
+DFileCopyMoveJobPrivate::CopyJournal::State DFileCopyMoveJobPrivate::CopyJournal::state(const DUrl &from, const DUrl &to) const
+{
+    if (!isOpen())
+        return NoState;
+
+    QMutexLocker lk(&m_mutex);
+
+    return m_records.value(recordKey(from, to)).state;
+}
+
+qint64 DFileCopyMoveJobPrivate::CopyJournal::resumeOffset(const DUrl &from, const DUrl &to) const
+{
+    if (!isOpen())
+        return 0;
+
+    QMutexLocker lk(&m_mutex);
+
+    const Record &record = m_records.value(recordKey(from, to));
+    return record.state == InFlightState ? record.offset : 0;
+}
+
+QByteArray DFileCopyMoveJobPrivate::CopyJournal::recordKey(const DUrl &from, const DUrl &to)
+{
+    // 编码后的url中不会有空格和换行
+    return from.toEncoded() + ' ' + to.toEncoded();
+}
+
+void DFileCopyMoveJobPrivate::CopyJournal::writeRecord(char type, const DUrl &from, const DUrl &to, qint64 offset)
+{
+    if (!isOpen())
+        return;
+
+    QMutexLocker lk(&m_mutex);
+
+    const QByteArray &key = recordKey(from, to);
+    Record record;
+    record.state = type == 'D' ? DirectoryState : (type == 'P' ? InFlightState : CompletedState);
+    record.offset = offset;
+    m_records.insert(key, record);
+
+    // 每条记录立即写入内核，进程崩溃后也不会丢失
+    m_file.write(QByteArray(1, type) + ' ' + QByteArray::number(offset) + ' ' + key + '\n');
+    m_file.flush();
+}
+
+void DFileCopyMoveJobPrivate::SpeedLimiter::setLimit(qint64 bytesPerSecond)
+{
+    QMutexLocker lk(&m_mutex);
+
+    m_limit = qMax<qint64>(0, bytesPerSecond);
+    m_timer.invalidate();
+}
+
+qint64 DFileCopyMoveJobPrivate::SpeedLimiter::limit() const
+{
+    return m_limit.load();
+}
+
+/*!
+ * \brief DFileCopyMoveJobPrivate::SpeedLimiter::consume 令牌桶限速，每秒生成limit个令牌，最多积攒1秒
+ * \param size 本次读取的数据大小
+ * \return 令牌不足时需要等待的毫秒数
+ */
+qint64 DFileCopyMoveJobPrivate::SpeedLimiter::consume(qint64 size)
+{
+    const qint64 limit = m_limit.load();
+    if (limit <= 0 || size <= 0)
+        return 0;
+
+    QMutexLocker lk(&m_mutex);
+
+    if (!m_timer.isValid()) {
+        m_timer.start();
+        m_tokens = limit;
+    } else {
+        const qint64 elapsed = qMin<qint64>(m_timer.nsecsElapsed(), 1000000000);
+        m_timer.restart();
+        m_tokens = qMin(limit, m_tokens + elapsed * limit / 1000000000);
+    }
+
+    m_tokens -= size;
+
+    return m_tokens >= 0 ? 0 : -m_tokens * 1000 / limit;
+}
+
+// 校验值计算使用单独的线程池，避免和全局线程池中长时间运行的写线程互相等待
+Q_GLOBAL_STATIC(QThreadPool, checksumThreadPool)
+
+DFileCopyMoveJobPrivate::StreamChecksum::StreamChecksum(DFileCopyMoveJob::VerifyMode mode)
+{
+    reset(mode);
+}
+
+DFileCopyMoveJobPrivate::StreamChecksum::~StreamChecksum()
+{
+    m_pending.waitForFinished();
+}
+
+void DFileCopyMoveJobPrivate::StreamChecksum::reset(DFileCopyMoveJob::VerifyMode mode)
+{
+    m_pending.waitForFinished();
+    // NoVerify 时按照以前的完整性校验使用 adler32
+    m_mode = mode == DFileCopyMoveJob::Sha256Verify ? mode : DFileCopyMoveJob::FastVerify;
+    m_adler = adler32(0L, nullptr, 0);
+    m_sha256.reset();
+}
+
+/*!
+ * rief DFileCopyMoveJobPrivate::StreamChecksum::addData 把一块数据交给工作线程计算校验值，
+ * 调用者可以马上复用自己的缓存读取下一块数据，同一时刻最多只有一块数据在计算
+ * \param data 数据
+ * \param size 数据大小
+ */
+void DFileCopyMoveJobPrivate::StreamChecksum::addData(const char *data, qint64 size)
+{
+    if (!data || size <= 0)
+        return;
+
+    const QByteArray block(data, static_cast<int>(size));
+    m_pending.waitForFinished();
+    m_pending = QtConcurrent::run(checksumThreadPool(), [this, block]() {
+        update(block);
+    });
+}
+
+QByteArray DFileCopyMoveJobPrivate::StreamChecksum::result()
+{
+    m_pending.waitForFinished();
+
+    if (m_mode == DFileCopyMoveJob::Sha256Verify)
+        return m_sha256.result().toHex();
+
+    return QByteArray::number(static_cast<qulonglong>(m_adler), 16);
+}
+
+void DFileCopyMoveJobPrivate::StreamChecksum::update(const QByteArray &data)
+{
+    if (m_mode == DFileCopyMoveJob::Sha256Verify) {
+        m_sha256.addData(data);
+    } else {
+        m_adler = adler32(m_adler, reinterpret_cast<const Bytef *>(data.constData()), static_cast<uInt>(data.size()));
+    }
+}
+
+DFileCopyMoveJobPrivate::HoleScanner::HoleScanner(const QString &path)
+{
+#ifdef Q_OS_LINUX
+    if (path.isEmpty())
+        return;
+
+    const QByteArray &localPath = path.toLocal8Bit();
+    struct stat st;
+    // 实际占用的空间小于文件大小时才是稀疏文件
+    if (stat(localPath.constData(), &st) != 0 || !S_ISREG(st.st_mode)
+            || static_cast<qint64>(st.st_blocks) * 512 >= static_cast<qint64>(st.st_size))
+        return;
+
+    m_fd = ::open(localPath.constData(), O_RDONLY);
+    m_size = st.st_size;
+#else
+    Q_UNUSED(path);
+#endif
+}
+
+DFileCopyMoveJobPrivate::HoleScanner::~HoleScanner()
+{
+    if (m_fd >= 0)
+        ::close(m_fd);
+}
+
+bool DFileCopyMoveJobPrivate::HoleScanner::isSparse() const
+{
+    return m_fd >= 0;
+}
+
+qint64 DFileCopyMoveJobPrivate::HoleScanner::nextData(qint64 pos) const
+{
+#if defined(Q_OS_LINUX) && defined(SEEK_DATA)
+    if (m_fd < 0 || pos >= m_size)
+        return pos;
+
+    const off_t dataPos = lseek(m_fd, pos, SEEK_DATA);
+    if (dataPos >= 0)
+        return qMax<qint64>(pos, dataPos);
+
+    // pos之后没有数据了
+    if (errno == ENXIO)
+        return m_size;
+#endif
+    // 文件系统不支持时当作没有空洞
+    return pos;
+}
+
+bool DFileCopyMoveJobPrivate::writeRefineThread()
+{
+    //写线程运行在全局线程池中，创建时可能继承了任务线程的后台优先级
+    resetIoPriority();
+    bool ok = true;
+    while (checkRefineCopyProccessSate(DFileCopyMoveJob::ReadFileProccessOver)) {
+        ok = writeToFileByQueue();
+        if (!ok) {
+            break;
+        }
+        //队列为空时阻塞等待读线程放入数据，避免空转
+        waitWriteQueueNotEmpty();
+    }
+    if (ok && stateCheck()) {
+        ok = writeToFileByQueue();
+    } else {
+        q_ptr->stop();
+    }
+    cancelReadFileDealWriteThread();
+    qInfo() << "write thread finish!";
+    return true;
+}
+
+//为考虑线程之间的同步问题（错误同步，假如，读线程出错了，
+//1.重试时写线程是不是要全部停住(已暂停)
+//2.重试失败，跳过当前文件应该怎么处理（加入一个跳过写入队列，写线程检查当前的写队列，移除都所有的要移除的选项）
+//3.重试失败，直接退出拷贝怎么处理（处理所有的写入队列，清理掉）。
+//写线程出错时，1.弹出提示框时，是否要暂停读线程2.点击跳过应该怎么处理，清理掉有相同的文件描述符的写队列、关闭文件读文件是否要暂停3.关闭拷贝时，要怎么处理）
+bool DFileCopyMoveJobPrivate::writeToFileByQueue()
+{
+    while (!checkWritQueueEmpty()) {
         auto info = writeQueueDequeue();
         if (Q_UNLIKELY(!stateCheck())) {
             releaseCopyInfo(info);
@@ -3221,6 +4368,13 @@ bool DFileCopyMoveJobPrivate::writeToFileByQueue()
             do {
                 std::string path = info->toinfo->fileUrl().path().toStdString();
                 toFd = open(path.c_str(), m_openFlag, 0777);
+                bool isNoSpace = false;
+                //预先分配整个文件的空间，空间不足时在写入前报错
+                if (toFd > -1 && !preallocateTargetFile(toFd, 0, info->frominfo->size())) {
+                    close(toFd);
+                    toFd = -1;
+                    isNoSpace = true;
+                }
                 if (toFd > -1) {
                     m_writeOpenFd.insert(info->toinfo->fileUrl(), toFd);
                     saveCopyFileUrl(info->toinfo->fileUrl());
@@ -3235,6 +4389,10 @@ bool DFileCopyMoveJobPrivate::writeToFileByQueue()
                     errorstr = (!info->toinfo->exists() || info->toinfo->isWritable()) ?
                                qApp->translate("DFileCopyMoveJob", "Failed to open the file, cause: Permission denied") :
                                QString("Failed to open the file!");
+                    if (isNoSpace) {
+                        errortype = DFileCopyMoveJob::NotEnoughSpaceError;
+                        errorstr = QString();
+                    }
                     isErrorOccur = true;
                     //错误队列处理
                     errorQueueHandling();
@@ -3268,6 +4426,11 @@ bool DFileCopyMoveJobPrivate::writeToFileByQueue()
         }
 
         bool bSkiped = false;
+        //稀疏文件跳过了空洞，写入前移动到这块数据的位置
+        if (info->size > 0 && fileHints.testFlag(DFileCopyMoveJob::SparseFile)
+                && lseek(toFd, 0, SEEK_CUR) != info->currentpos) {
+            lseek(toFd, info->currentpos, SEEK_SET);
+        }
 
 write_data: {
             qint64 size_write = write(toFd, info->buffer, static_cast<size_t>(info->size));
@@ -3424,33 +4587,37 @@ write_data: {
             completedDataSizeOnBlockDevice += size_write;
 
             countrefinesize(size_write);
+            if (!m_writebackThrottles.contains(toFd))
+                m_writebackThrottles[toFd].setDropCache(isDropPageCache(info->frominfo->size()));
+            WritebackThrottle &writeback = m_writebackThrottles[toFd];
+            if (m_syncPolicy == DFileCopyMoveJob::FileSystemSync || m_syncPolicy == DFileCopyMoveJob::FileSync
+                    || writeback.isDropCache())
+                writeback.written(toFd, info->currentpos + size_write);
             if (info->buffer) {
-                delete [] info->buffer;
+                releaseCopyBuffer(info->buffer);
                 info->buffer = nullptr;
             }
         }
         //关闭文件并加权
         if (info->closeflag) {
-            //异步执行同步
-            syncfs(toFd);
-
+            //稀疏文件末尾是空洞时没有写入数据，需要把目标文件扩展到源文件的大小
+            if (fileHints.testFlag(DFileCopyMoveJob::SparseFile) && info->currentpos > lseek(toFd, 0, SEEK_END)
+                    && ftruncate(toFd, info->currentpos) != 0) {
+                qCWarning(fileJob()) << "failed to resize the sparse file:" << info->toinfo->fileUrl() << strerror(errno);
+            }
+            //按照同步策略在后台同步这个文件，以前每个文件都同步整个文件系统
+            releaseCopyPageCache(-1, toFd, m_writebackThrottles.value(toFd));
+            m_writebackThrottles.remove(toFd);
+            QSharedPointer<DFileHandler> handler = info->handler ? info->handler :
+                                                   QSharedPointer<DFileHandler>(DFileService::instance()->createFileHandler(nullptr, info->frominfo->fileUrl()));
+            const bool finalized = finalizeTargetFile(toFd, info->frominfo, info->toinfo, handler);
             close(toFd);
+            if (!finalized)
+                finalizeTargetFile(-1, info->frominfo, info->toinfo, handler);
+            if (m_syncPolicy == DFileCopyMoveJob::FileSync)
+                syncFileInBackground(info->toinfo->fileUrl().toLocalFile());
             removeCopyFileUrl(info->toinfo->fileUrl());
             m_writeOpenFd.remove(info->toinfo->fileUrl());
-            QSharedPointer<DFileHandler> handler = info->handler ? info->handler :
-                                                   QSharedPointer<DFileHandler>(DFileService::instance()->createFileHandler(nullptr, info->frominfo->fileUrl()));
-            handler->setFileTime(info->toinfo->fileUrl(), info->frominfo->lastRead(), info->frominfo->lastModified());
-
-            QFileDevice::Permissions permissions = info->frominfo->permissions();
-            //! use stat function to read vault file permission.
-            QString path = info->frominfo->fileUrl().path();
-            if (VaultController::isVaultFile(path)) {
-                permissions = VaultController::getPermissions(path);
-            } else if (deviceListener->isFileFromDisc(info->frominfo->path())) { // fix bug 52610: 从光盘中复制出来的文件权限为只读，与 ubuntu 策略保持一致，拷贝出来权限为 rw-rw-r--
-                permissions |= MasteredMediaController::getPermissionsCopyToLocal();
-            }
-            if (permissions != 0000)
-                handler->setPermissions(info->toinfo->fileUrl(), permissions);
         }
     }
     qDebug() << "write queue over!";
@@ -3473,16 +4640,23 @@ void DFileCopyMoveJobPrivate::cancelReadFileDealWriteThread()
         removeCopyFileUrl(m_writeOpenFd.key(fd));
     }
     m_writeOpenFd.clear();
+    m_writebackThrottles.clear();
     while (!m_writeFileQueue.isEmpty()) {
         auto info = m_writeFileQueue.dequeue();
-        if (info->buffer)
-            delete[] info->buffer;
+        if (info->buffer) {
+            releaseCopyBuffer(info->buffer);
+            info->buffer = nullptr;
+        }
     }
+    m_writeQueueNotFullCondition.wakeAll();
 }
 
 void DFileCopyMoveJobPrivate::setRefineCopyProccessSate(const DFileCopyMoveJob::RefineCopyProccessSate &stat)
 {
     m_copyRefineFlag = stat;
+    //读线程结束时唤醒等待数据的写线程
+    QMutexLocker lk(&m_copyInfoQueueMutex);
+    m_writeQueueNotEmptyCondition.wakeAll();
 }
 
 bool DFileCopyMoveJobPrivate::checkRefineCopyProccessSate(const DFileCopyMoveJob::RefineCopyProccessSate &stat)
@@ -3536,6 +4710,7 @@ DFileCopyMoveJob::~DFileCopyMoveJob()
     Q_D(DFileCopyMoveJob);
     //停止清理掉自己的大文件拷贝
     copyBigFileOnDiskJobRun();
+    d->releaseDevices();
 
     d->stopAllDeviceOperation();
 
@@ -3649,6 +4824,13 @@ qint64 DFileCopyMoveJob::totalDataSize() const
     return d->fileStatistics->totalSize();
 }
 
+qint64 DFileCopyMoveJob::currentBlockSize() const
+{
+    Q_D(const DFileCopyMoveJob);
+
+    return d->m_blockSizeController.blockSize();
+}
+
 int DFileCopyMoveJob::totalFilesCount() const
 {
     Q_D(const DFileCopyMoveJob);
@@ -3682,6 +4864,128 @@ bool DFileCopyMoveJob::isCanShowProgress() const
     return d->m_isNeedShowProgress;
 }
 
+qint64 DFileCopyMoveJob::speedLimit() const
+{
+    Q_D(const DFileCopyMoveJob);
+
+    return d->m_speedLimit;
+}
+
+void DFileCopyMoveJob::setSpeedLimit(qint64 bytesPerSecond)
+{
+    Q_D(DFileCopyMoveJob);
+
+    d->m_speedLimit = qMax<qint64>(0, bytesPerSecond);
+    // 后台模式下没有设置限速时使用默认的限速
+    d->m_speedLimiter.setLimit(d->m_speedLimit > 0 ? d->m_speedLimit
+                               : (d->m_isBackgroundMode ? BACKGROUND_SPEED_LIMIT : 0));
+}
+
+bool DFileCopyMoveJob::isBackgroundMode() const
+{
+    Q_D(const DFileCopyMoveJob);
+
+    return d->m_isBackgroundMode;
+}
+
+void DFileCopyMoveJob::setBackgroundMode(bool background)
+{
+    Q_D(DFileCopyMoveJob);
+
+    qInfo() << "job" << this << "background mode:" << background;
+    d->m_isBackgroundMode = background;
+    setSpeedLimit(d->m_speedLimit);
+}
+
+QString DFileCopyMoveJob::journalFile() const
+{
+    Q_D(const DFileCopyMoveJob);
+
+    return d->m_journalFilePath;
+}
+
+void DFileCopyMoveJob::setJournalFile(const QString &filePath)
+{
+    Q_D(DFileCopyMoveJob);
+    Q_ASSERT(d->state != RunningState);
+
+    d->m_journalFilePath = filePath;
+}
+
+DFileCopyMoveJob::SyncPolicy DFileCopyMoveJob::syncPolicy() const
+{
+    Q_D(const DFileCopyMoveJob);
+
+    return d->m_syncPolicy;
+}
+
+void DFileCopyMoveJob::setSyncPolicy(SyncPolicy policy)
+{
+    Q_D(DFileCopyMoveJob);
+    Q_ASSERT(d->state != RunningState);
+
+    d->m_syncPolicy = policy;
+}
+
+DFileCopyMoveJob::PageCachePolicy DFileCopyMoveJob::pageCachePolicy() const
+{
+    Q_D(const DFileCopyMoveJob);
+
+    return d->m_pageCachePolicy;
+}
+
+void DFileCopyMoveJob::setPageCachePolicy(PageCachePolicy policy)
+{
+    Q_D(DFileCopyMoveJob);
+    Q_ASSERT(d->state != RunningState);
+
+    d->m_pageCachePolicy = policy;
+}
+
+DFileCopyMoveJob::IdenticalFilePolicy DFileCopyMoveJob::identicalFilePolicy() const
+{
+    Q_D(const DFileCopyMoveJob);
+
+    return d->m_identicalFilePolicy;
+}
+
+void DFileCopyMoveJob::setIdenticalFilePolicy(IdenticalFilePolicy policy)
+{
+    Q_D(DFileCopyMoveJob);
+    Q_ASSERT(d->state != RunningState);
+
+    d->m_identicalFilePolicy = policy;
+}
+
+DFileCopyMoveJob::VerifyMode DFileCopyMoveJob::verifyMode() const
+{
+    Q_D(const DFileCopyMoveJob);
+
+    return d->m_verifyMode;
+}
+
+void DFileCopyMoveJob::setVerifyMode(VerifyMode mode)
+{
+    Q_D(DFileCopyMoveJob);
+    Q_ASSERT(d->state != RunningState);
+
+    d->m_verifyMode = mode;
+}
+
+QString DFileCopyMoveJob::defaultJournalFile(const DUrlList &sourceUrls, const DUrl &targetUrl)
+{
+    // 相同的源文件和目标目录使用同一个日志，再次执行同样的拷贝时就可以续传
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    for (const DUrl &url : sourceUrls) {
+        hash.addData(url.toEncoded());
+        hash.addData("\n");
+    }
+    hash.addData(targetUrl.toEncoded());
+
+    return DFMStandardPaths::location(DFMStandardPaths::CachePath) + "/copyjournal/"
+            + QString::fromLatin1(hash.result().toHex()) + ".journal";
+}
+
 void DFileCopyMoveJob::setRefine(const RefineState &refinestat)
 {
     Q_D(DFileCopyMoveJob);
@@ -3713,6 +5017,12 @@ void DFileCopyMoveJobPrivate::waitRefineThreadFinish()
     {
         info->handler->setPermissions(info->target, info->permission);
     }
+    // 有文件被跳过或移动失败时目录不为空，保留源目录
+    for (const auto &dir : m_pendingRemoveDirs) {
+        if (!dir.first->rmdir(dir.second->fileUrl()))
+            qCDebug(fileJob()) << "keep source directory:" << dir.second->fileUrl() << dir.first->errorString();
+    }
+    m_pendingRemoveDirs.clear();
 }
 
 void DFileCopyMoveJobPrivate::setLastErrorAction(const DFileCopyMoveJob::Action &action)
@@ -3918,25 +5228,816 @@ DFileCopyMoveJob::GvfsRetryType DFileCopyMoveJobPrivate::gvfsFileRetry(char *dat
     return DFileCopyMoveJob::GvfsRetryDefault;
 }
 /*!
- * \brief DFileCopyMoveJobPrivate::readAheadSourceFile 预读源文件
- * \param fromInfo 源文件的文件信息
+ * \brief DFileCopyMoveJobPrivate::resumeFromJournal 根据拷贝日志判断文件是否可以续传
+ * 断点之前的一段数据在源文件和目标文件中一致时才续传，开启完整性校验时还需要计算断点之前数据的校验值
+ * \param fromInfo 源文件信息
+ * \param toInfo 目标文件信息
+ * \param fromDevice 已经以只读方式打开的源文件
+ * \param toDevice 还没有打开的目标文件
+ * \param checksum 断点之前数据的校验值
+ * \return 续传的位置，返回0时从头开始拷贝
  */
-void DFileCopyMoveJobPrivate::readAheadSourceFile(const DAbstractFileInfoPointer &fromInfo)
+qint64 DFileCopyMoveJobPrivate::resumeFromJournal(const DAbstractFileInfoPointer &fromInfo, const DAbstractFileInfoPointer &toInfo,
+                                                 const QSharedPointer<DFileDevice> &fromDevice, const QSharedPointer<DFileDevice> &toDevice,
+                                                 StreamChecksum &checksum)
 {
-    if (!fromInfo)
-        return;
-    std::string stdStr = fromInfo->fileUrl().path().toUtf8().toStdString();
-    int fromfd = open(stdStr.data(), O_RDONLY);
-    if (-1 != fromfd) {
-        readahead(fromfd, 0, static_cast<size_t>(fromInfo->size()));
-        close(fromfd);
+    const qint64 offset = m_copyJournal.resumeOffset(fromInfo->fileUrl(), toInfo->fileUrl());
+    if (offset <= 0 || offset > fromInfo->size() || !toInfo->exists() || offset > toInfo->size())
+        return 0;
+
+    // 网络文件一次可能读不满
+    auto readFully = [](const QSharedPointer<DFileDevice> &device, char *data, qint64 size) {
+        qint64 total = 0;
+        while (total < size) {
+            const qint64 len = device->read(data + total, size - total);
+            if (len <= 0)
+                break;
+            total += len;
+        }
+        return total;
+    };
+
+    const qint64 tailSize = qMin<qint64>(offset, JOURNAL_TAIL_CHECK_LEN);
+    QByteArray fromTail(static_cast<int>(tailSize), Qt::Uninitialized);
+    QByteArray toTail(static_cast<int>(tailSize), Qt::Uninitialized);
+    bool isTailSame = false;
+    if (toDevice->open(QIODevice::ReadOnly)) {
+        isTailSame = fromDevice->seek(offset - tailSize) && toDevice->seek(offset - tailSize)
+                && readFully(fromDevice, fromTail.data(), tailSize) == tailSize
+                && readFully(toDevice, toTail.data(), tailSize) == tailSize
+                && fromTail == toTail;
+        toDevice->close();
+    }
+
+    if (isTailSame && !fileHints.testFlag(DFileCopyMoveJob::DontIntegrityChecking)) {
+        isTailSame = fromDevice->seek(0);
+        QByteArray data(MAX_BUFFER_LEN, Qt::Uninitialized);
+        qint64 pos = 0;
+        while (isTailSame && pos < offset) {
+            const qint64 size = readFully(fromDevice, data.data(), qMin<qint64>(data.size(), offset - pos));
+            if (size <= 0 || !stateCheck()) {
+                isTailSame = false;
+                break;
+            }
+            checksum.addData(data.constData(), size);
+            pos += size;
+        }
+    }
+
+    if (!isTailSame || !fromDevice->seek(offset)) {
+        qCInfo(fileJob()) << "can not resume copy, copy from the beginning:" << fromInfo->fileUrl();
+        checksum.reset(m_verifyMode);
+        fromDevice->seek(0);
+        return 0;
     }
+
+    return offset;
 }
+
 /*!
- * \brief DFileCopyMoveJobPrivate::handleUnknowUrlError 阻塞处理UnknowUrlError的错误
- * \param fromInfo 源文件的文件信息
- * \param toInfo 目标文件的文件信息
- * \return
+ * \brief DFileCopyMoveJobPrivate::throttleRead 读取数据后按照限速等待，后台模式时降低当前线程的io优先级
+ * \param size 读取的数据大小
+ */
+void DFileCopyMoveJobPrivate::throttleRead(qint64 size)
+{
+    applyIoPriority();
+    DDeviceAccessScheduler::instance()->yield(m_accessDevice, DDeviceAccessScheduler::CopyPriority);
+
+    qint64 waitTime = m_speedLimiter.consume(size);
+    // 分段等待，及时响应暂停、停止和限速修改
+    while (waitTime > 0 && state == DFileCopyMoveJob::RunningState) {
+        const qint64 sleepTime = qMin<qint64>(waitTime, 100);
+        QThread::msleep(static_cast<unsigned long>(sleepTime));
+        waitTime -= sleepTime;
+        if (m_speedLimiter.limit() <= 0)
+            break;
+    }
+}
+
+void DFileCopyMoveJobPrivate::applyIoPriority()
+{
+#ifdef Q_OS_LINUX
+    // 优先级是线程属性，每个读线程在读取时按照任务当前的模式设置一次
+    thread_local long currentPriority = syscall(SYS_ioprio_get, IOPRIO_WHO_PROCESS, 0);
+    const long priority = m_isBackgroundMode ? IOPRIO_CLASS_IDLE << IOPRIO_CLASS_SHIFT : 0;
+    if (currentPriority == priority)
+        return;
+
+    if (syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, 0, priority) != 0)
+        qCWarning(fileJob()) << "failed to set io priority:" << strerror(errno);
+    //设置失败时不再重试
+    currentPriority = priority;
+#endif
+}
+
+void DFileCopyMoveJobPrivate::resetIoPriority()
+{
+#ifdef Q_OS_LINUX
+    syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, 0, 0);
+#endif
+}
+
+/*!
+ * \brief DFileCopyMoveJobPrivate::dropPageCache 把文件的脏页写回磁盘后丢弃页缓存，
+ * 之后读取文件时数据从磁盘读取
+ * \param path 本地文件路径
+ */
+void DFileCopyMoveJobPrivate::dropPageCache(const QString &path)
+{
+    if (path.isEmpty())
+        return;
+
+    const int fd = ::open(path.toLocal8Bit().constData(), O_RDONLY);
+    if (fd < 0)
+        return;
+
+    // 只有干净的页才会被丢弃
+    fdatasync(fd);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    ::close(fd);
+}
+
+bool DFileCopyMoveJobPrivate::isKeepHoles() const
+{
+    return fileHints.testFlag(DFileCopyMoveJob::SparseFile) && fileHints.testFlag(DFileCopyMoveJob::DontIntegrityChecking);
+}
+
+/*!
+ * \brief DFileCopyMoveJobPrivate::isDropPageCache 自动策略下，只有整个任务的数据量超过物理内存的四分之一时
+ * 才丢弃大文件的页缓存，拷贝少量数据时保留缓存，之后打开目标文件更快
+ * \param fileSize 当前拷贝的文件大小
+ * \return 是否丢弃页缓存
+ */
+bool DFileCopyMoveJobPrivate::isDropPageCache(qint64 fileSize) const
+{
+    switch (m_pageCachePolicy) {
+    case DFileCopyMoveJob::KeepPageCache:
+        return false;
+    case DFileCopyMoveJob::DropPageCache:
+        return true;
+    default:
+        break;
+    }
+
+    if (fileSize < PAGE_CACHE_DROP_FILE_SIZE)
+        return false;
+
+    static const qint64 physicalMemory = qint64(sysconf(_SC_PHYS_PAGES)) * sysconf(_SC_PAGESIZE);
+    if (physicalMemory <= 0)
+        return false;
+
+    //统计没有完成时使用统计任务当前的结果
+    const qint64 jobSize = m_isCountSizeOver ? totalsize : (fileStatistics ? fileStatistics->totalSize() : 0);
+    return qMax(jobSize, fileSize) > physicalMemory / 4;
+}
+
+bool DFileCopyMoveJobPrivate::adviseCopyPageCache(int fromFd, int toFd, qint64 fileSize, WritebackThrottle &throttle) const
+{
+    const bool drop = isDropPageCache(fileSize);
+    throttle.setDropCache(drop);
+#ifdef Q_OS_LINUX
+    if (fromFd > 0) {
+        posix_fadvise(fromFd, 0, 0, POSIX_FADV_SEQUENTIAL);
+        if (drop)
+            posix_fadvise(fromFd, 0, 0, POSIX_FADV_NOREUSE);
+    }
+
+    if (toFd > 0)
+        posix_fadvise(toFd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#else
+    Q_UNUSED(fromFd);
+    Q_UNUSED(toFd);
+#endif
+    return drop;
+}
+
+void DFileCopyMoveJobPrivate::releaseCopyPageCache(int fromFd, int toFd, const WritebackThrottle &throttle) const
+{
+#ifdef Q_OS_LINUX
+    if (!throttle.isDropCache())
+        return;
+
+    if (fromFd > 0)
+        posix_fadvise(fromFd, 0, 0, POSIX_FADV_DONTNEED);
+
+    // 只有干净的页才会被丢弃，先等待剩余的数据回写完成
+    if (toFd > 0) {
+        sync_file_range(toFd, 0, 0, SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER);
+        posix_fadvise(toFd, 0, 0, POSIX_FADV_DONTNEED);
+    }
+#else
+    Q_UNUSED(fromFd);
+    Q_UNUSED(toFd);
+    Q_UNUSED(throttle);
+#endif
+}
+
+void DFileCopyMoveJobPrivate::WritebackThrottle::written(int fd, qint64 pos)
+{
+#ifdef Q_OS_LINUX
+    if (fd < 0 || pos - m_flushedPos < WRITEBACK_WINDOW_LEN)
+        return;
+
+    // 开始回写新写入的数据，不等待
+    sync_file_range(fd, m_flushedPos, pos - m_flushedPos, SYNC_FILE_RANGE_WRITE);
+    // 等待上一段数据回写完成，页缓存中最多留下两段脏数据
+    if (m_waitPos < m_flushedPos) {
+        sync_file_range(fd, m_waitPos, m_flushedPos - m_waitPos,
+                        SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER);
+        // 回写完成后这一段已经是干净页，可以直接丢弃
+        if (m_dropCache)
+            posix_fadvise(fd, m_waitPos, m_flushedPos - m_waitPos, POSIX_FADV_DONTNEED);
+    }
+    m_waitPos = m_flushedPos;
+    m_flushedPos = pos;
+#else
+    Q_UNUSED(fd);
+    Q_UNUSED(pos);
+#endif
+}
+
+void DFileCopyMoveJobPrivate::WritebackThrottle::read(int fd, qint64 pos)
+{
+#ifdef Q_OS_LINUX
+    if (!m_dropCache || fd <= 0 || pos - m_readDroppedPos < WRITEBACK_WINDOW_LEN)
+        return;
+
+    // 源文件读过的数据不会再用到
+    posix_fadvise(fd, m_readDroppedPos, pos - m_readDroppedPos, POSIX_FADV_DONTNEED);
+    m_readDroppedPos = pos;
+#else
+    Q_UNUSED(fd);
+    Q_UNUSED(pos);
+#endif
+}
+
+void DFileCopyMoveJobPrivate::WritebackThrottle::setDropCache(bool drop)
+{
+    m_dropCache = drop;
+}
+
+bool DFileCopyMoveJobPrivate::WritebackThrottle::isDropCache() const
+{
+    return m_dropCache;
+}
+
+#ifdef SYS_getdents64
+struct LinuxDirent64 {
+    quint64 d_ino;
+    qint64 d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[1];
+};
+#endif
+
+DFileCopyMoveJobPrivate::TreeRemover::TreeRemover(DFileCopyMoveJobPrivate *d, QThreadPool *pool, bool force)
+    : m_d(d)
+    , m_pool(pool)
+    , m_force(force)
+    , m_startCount(d->completedFilesCount)
+{
+}
+
+bool DFileCopyMoveJobPrivate::TreeRemover::remove(const QString &path)
+{
+#ifdef SYS_getdents64
+    const QByteArray &localPath = QDir::cleanPath(path).toLocal8Bit();
+    const int index = localPath.lastIndexOf('/');
+    if (index < 0 || index == localPath.length() - 1)
+        return false;
+
+    int parentFd = open(index == 0 ? "/" : localPath.left(index).constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (parentFd < 0)
+        return false;
+    bool ok = removeDirectory(parentFd, localPath.mid(index + 1), true);
+    close(parentFd);
+    //根目录由调用者计入完成的数量
+    if (ok)
+        m_removedCount += -1;
+    syncProgress();
+
+    return ok;
+#else
+    Q_UNUSED(path);
+    return false;
+#endif
+}
+
+qint64 DFileCopyMoveJobPrivate::TreeRemover::removedCount() const
+{
+    return m_removedCount;
+}
+
+bool DFileCopyMoveJobPrivate::TreeRemover::removeDirectory(int parentFd, const QByteArray &name, bool fanOut)
+{
+    int fd = openat(parentFd, name.constData(), O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+    //强制删除时给没有权限的目录加上权限
+    if (fd < 0 && errno == EACCES && m_force && fchmodat(parentFd, name.constData(), S_IRWXU, 0) == 0)
+        fd = openat(parentFd, name.constData(), O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+
+    bool ok = removeChildren(fd, fanOut);
+    if (ok) {
+        ok = unlinkEntry(parentFd, name.constData(), AT_REMOVEDIR);
+        //边读边删时目录项可能漏读，重新读取一次
+        if (!ok && errno == ENOTEMPTY && lseek(fd, 0, SEEK_SET) == 0)
+            ok = removeChildren(fd, fanOut) && unlinkEntry(parentFd, name.constData(), AT_REMOVEDIR);
+    }
+    close(fd);
+
+    return ok;
+}
+
+bool DFileCopyMoveJobPrivate::TreeRemover::removeChildren(int dirFd, bool fanOut)
+{
+#ifdef SYS_getdents64
+    QByteArray buffer(REMOVE_DIRENT_BUFFER_LEN, Qt::Uninitialized);
+    QList<QFuture<bool>> futures;
+    bool ok = true;
+
+    while (!isStopped()) {
+        const long length = syscall(SYS_getdents64, dirFd, buffer.data(), buffer.size());
+        if (length <= 0) {
+            ok = ok && length == 0;
+            break;
+        }
+
+        for (long pos = 0; pos < length;) {
+            const LinuxDirent64 *entry = reinterpret_cast<const LinuxDirent64 *>(buffer.constData() + pos);
+            pos += entry->d_reclen;
+            const char *name = entry->d_name;
+            if (strcmp(name, ".") == 0 || strcmp(name, "..") == 0)
+                continue;
+
+            bool isDir = entry->d_type == DT_DIR;
+            //只有文件系统不提供类型时才需要stat
+            if (entry->d_type == DT_UNKNOWN) {
+                struct stat st;
+                if (fstatat(dirFd, name, &st, AT_SYMLINK_NOFOLLOW) != 0) {
+                    ok = false;
+                    continue;
+                }
+                isDir = S_ISDIR(st.st_mode);
+            }
+
+            if (!isDir) {
+                ok = unlinkEntry(dirFd, name, 0) && ok;
+            } else if (fanOut) {
+                QByteArray childName(name);
+                futures << QtConcurrent::run(m_pool, [this, dirFd, childName]() {
+                    return removeDirectory(dirFd, childName, false);
+                });
+            } else {
+                ok = removeDirectory(dirFd, QByteArray(name), false) && ok;
+            }
+
+            if (fanOut)
+                syncProgress();
+        }
+    }
+
+    //等待子目录删除完成，期间在任务线程中更新进度
+    for (QFuture<bool> &future : futures) {
+        while (!future.isFinished()) {
+            syncProgress();
+            isStopped();
+            QThread::msleep(20);
+        }
+        ok = future.result() && ok;
+    }
+
+    return ok && !isStopped();
+#else
+    Q_UNUSED(dirFd);
+    Q_UNUSED(fanOut);
+    return false;
+#endif
+}
+
+bool DFileCopyMoveJobPrivate::TreeRemover::unlinkEntry(int dirFd, const char *name, int flags)
+{
+    int ret = unlinkat(dirFd, name, flags);
+    //强制删除时给没有写权限的目录加上权限后重试
+    if (ret != 0 && errno == EACCES && m_force && fchmod(dirFd, S_IRWXU) == 0)
+        ret = unlinkat(dirFd, name, flags);
+    if (ret != 0)
+        return false;
+
+    m_removedCount += 1;
+    return true;
+}
+
+bool DFileCopyMoveJobPrivate::TreeRemover::isStopped()
+{
+    //任务线程中处理暂停和停止，工作线程暂停时等待任务线程恢复
+    if (QThread::currentThread() == m_d->q_ptr)
+        return !m_d->stateCheck();
+
+    while (m_d->state.load() == DFileCopyMoveJob::PausedState)
+        QThread::msleep(THREAD_SLEEP_TIME);
+
+    return m_d->state.load() == DFileCopyMoveJob::StoppedState;
+}
+
+void DFileCopyMoveJobPrivate::TreeRemover::syncProgress()
+{
+    //只在任务线程中调用
+    m_d->completedFilesCount = m_startCount + int(m_removedCount);
+}
+
+void DFileCopyMoveJobPrivate::syncAfterWrite(const QSharedPointer<DFileDevice> &toDevice, WritebackThrottle &throttle)
+{
+    if ((m_syncPolicy == DFileCopyMoveJob::FileSystemSync || m_syncPolicy == DFileCopyMoveJob::FileSync
+         || throttle.isDropCache()) && toDevice->handle() > 0) {
+        throttle.written(toDevice->handle(), toDevice->pos());
+        return;
+    }
+
+    //fix 修复vfat格式u盘卡死问题，写入数据后立刻同步
+    if (m_isEveryReadAndWritesSnc)
+        toDevice->syncToDisk(m_isVfat);
+}
+
+/*!
+ * \brief DFileCopyMoveJobPrivate::syncFileInBackground 在后台线程中把文件的数据同步到磁盘，
+ * 同步和后面文件的拷贝同时进行，任务结束前等待所有的同步完成
+ * \param path 本地文件路径
+ */
+void DFileCopyMoveJobPrivate::syncFileInBackground(const QString &path)
+{
+    if (path.isEmpty())
+        return;
+
+    QtConcurrent::run(&m_syncPool, [path]() {
+        const int fd = ::open(path.toLocal8Bit().constData(), O_RDONLY);
+        if (fd < 0)
+            return;
+        if (fdatasync(fd) != 0)
+            qCWarning(fileJob()) << "failed to sync file:" << path << strerror(errno);
+        ::close(fd);
+    });
+}
+
+int DFileCopyMoveJobPrivate::syncTargetFileSystem()
+{
+    m_syncPool.waitForDone();
+
+    const QString &rootPath = targetRootPath.isEmpty() ? targetUrl.toLocalFile() : targetRootPath;
+    const int fd = ::open(rootPath.toLocal8Bit().constData(), O_RDONLY | O_DIRECTORY);
+    if (fd < 0) {
+        qCWarning(fileJob()) << "failed to open the target file system:" << rootPath << strerror(errno);
+        return -1;
+    }
+
+    // 只同步目标文件系统，不影响其它磁盘上的脏数据
+    const int ret = syncfs(fd);
+    if (ret != 0)
+        qCWarning(fileJob()) << "failed to sync the target file system:" << rootPath << strerror(errno);
+    ::close(fd);
+
+    return ret;
+}
+
+/*!
+ * \brief DFileCopyMoveJobPrivate::readAheadSourceFile 预读源文件
+ * \param fromInfo 源文件的文件信息
+ */
+void DFileCopyMoveJobPrivate::readAheadSourceFile(const DAbstractFileInfoPointer &fromInfo)
+{
+    //丢弃页缓存时不整个预读，顺序读取的预读已经足够
+    if (!fromInfo || isDropPageCache(fromInfo->size()))
+        return;
+    std::string stdStr = fromInfo->fileUrl().path().toUtf8().toStdString();
+    int fromfd = open(stdStr.data(), O_RDONLY);
+    if (-1 != fromfd) {
+        readahead(fromfd, 0, static_cast<size_t>(fromInfo->size()));
+        close(fromfd);
+    }
+}
+static QFileDevice::Permissions copyTargetPermissions(const DAbstractFileInfoPointer &fromInfo)
+{
+    QFileDevice::Permissions permissions = fromInfo->permissions();
+    //! use stat function to read vault file permission.
+    QString path = fromInfo->fileUrl().path();
+    if (VaultController::isVaultFile(path)) {
+        permissions = VaultController::getPermissions(path);
+    } else if (deviceListener->isFileFromDisc(fromInfo->path())) { // fix bug 52610: 从光盘中复制出来的文件权限为只读，与 ubuntu 策略保持一致，拷贝出来权限为 rw-rw-r--
+        permissions |= MasteredMediaController::getPermissionsCopyToLocal();
+    }
+
+    return permissions;
+}
+
+static timespec toTimespec(const QDateTime &time)
+{
+    timespec spec;
+
+    if (!time.isValid()) {
+        spec.tv_sec = 0;
+        spec.tv_nsec = UTIME_OMIT;
+        return spec;
+    }
+
+    const qint64 msecs = time.toMSecsSinceEpoch();
+
+    spec.tv_sec = static_cast<time_t>(msecs / 1000);
+    spec.tv_nsec = static_cast<long>(msecs % 1000) * 1000000;
+
+    return spec;
+}
+
+/*!
+ * \brief DFileCopyMoveJobPrivate::finalizeTargetFile 拷贝完数据后设置目标文件的访问、修改时间和权限
+ * 目标文件还未关闭时直接通过描述符设置，不用再按路径查找文件。gvfs 中的文件通过一次 g_file_set_attributes_from_info
+ * 设置所有属性，避免经过 fuse 多次往返。以 root 运行时同时保留文件的所有者。都失败时按路径设置
+ * \param fd 目标文件的描述符，小于等于0时按路径设置
+ * \return gvfs 中的文件关闭时才完成上传，会更新修改时间，传入有效的描述符时返回 false，需要关闭后再调用一次
+ */
+bool DFileCopyMoveJobPrivate::finalizeTargetFile(int fd, const DAbstractFileInfoPointer &fromInfo, const DAbstractFileInfoPointer &toInfo,
+                                                 const QSharedPointer<DFileHandler> &handler)
+{
+    const QFileDevice::Permissions permissions = copyTargetPermissions(fromInfo);
+    const QDateTime &lastRead = fromInfo->lastRead();
+    const QDateTime &lastModified = fromInfo->lastModified();
+    //权限为0000时，源文件已经被删除，无需修改新建的文件的权限为0000
+    bool timeDone = false;
+    bool permissionsDone = permissions == 0000;
+
+    if (toInfo->isGvfsMountFile()) {
+        if (fd > 0)
+            return false;
+
+        GFile *file = g_file_new_for_path(toInfo->fileUrl().toLocalFile().toLocal8Bit().constData());
+        GFileInfo *info = g_file_info_new();
+        GError *error = nullptr;
+
+        if (lastRead.isValid())
+            g_file_info_set_attribute_uint64(info, G_FILE_ATTRIBUTE_TIME_ACCESS, static_cast<guint64>(lastRead.toMSecsSinceEpoch() / 1000));
+        if (lastModified.isValid())
+            g_file_info_set_attribute_uint64(info, G_FILE_ATTRIBUTE_TIME_MODIFIED, static_cast<guint64>(lastModified.toMSecsSinceEpoch() / 1000));
+        if (!permissionsDone)
+            g_file_info_set_attribute_uint32(info, G_FILE_ATTRIBUTE_UNIX_MODE, DLocalFileHandler::toUnixMode(permissions));
+
+        // 部分后端（如 mtp）不支持设置权限，此时只报告错误，不再重复设置
+        if (!g_file_set_attributes_from_info(file, info, G_FILE_QUERY_INFO_NOFOLLOW_SYMLINKS, nullptr, &error) && error) {
+            qCDebug(fileJob()) << "failed to set the attributes of" << toInfo->fileUrl() << error->message;
+            g_error_free(error);
+        }
+
+        g_object_unref(info);
+        g_object_unref(file);
+
+        return true;
+    }
+
+    if (fd > 0) {
+        const timespec times[2] = { toTimespec(lastRead), toTimespec(lastModified) };
+
+        timeDone = futimens(fd, times) == 0;
+
+        if (geteuid() == 0 && fchown(fd, fromInfo->ownerId(), fromInfo->groupId()) != 0)
+            qCDebug(fileJob()) << "failed to change the owner of" << toInfo->fileUrl() << strerror(errno);
+
+        if (!permissionsDone)
+            permissionsDone = fchmod(fd, DLocalFileHandler::toUnixMode(permissions)) == 0;
+    }
+
+    if (!timeDone)
+        handler->setFileTime(toInfo->fileUrl(), lastRead, lastModified);
+
+    if (!permissionsDone)
+        handler->setPermissions(toInfo->fileUrl(), permissions);
+
+    return true;
+}
+
+/*!
+ * \brief DFileCopyMoveJobPrivate::preallocateTargetFile 按源文件的大小为目标文件预先分配空间
+ * 追加写入时文件系统逐块分配空间，在 FAT 和机械硬盘上容易产生碎片，FAT 的分配表也要反复更新。
+ * 使用 FALLOC_FL_KEEP_SIZE，文件大小仍随写入增长，中断的拷贝不会留下末尾全是零的文件。
+ * 文件系统不支持时（如 exFAT）不做处理，glibc 的 posix_fallocate 在这种情况下逐块写入来模拟，反而更慢
+ * \param fd 目标文件的描述符
+ * \param offset 开始分配的位置
+ * \param size 源文件的大小
+ * \return 剩余空间不足时返回false
+ */
+bool DFileCopyMoveJobPrivate::preallocateTargetFile(int fd, qint64 offset, qint64 size)
+{
+#ifdef Q_OS_LINUX
+    //保留空洞的文件不能预分配
+    if (fd <= 0 || size - offset < PREALLOCATE_MIN_SIZE || fileHints.testFlag(DFileCopyMoveJob::SparseFile))
+        return true;
+
+    if (fallocate(fd, FALLOC_FL_KEEP_SIZE, static_cast<off_t>(offset), static_cast<off_t>(size - offset)) == 0)
+        return true;
+
+    if (errno == ENOSPC) {
+        qCWarning(fileJob()) << "not enough space to preallocate" << size - offset << "bytes";
+        return false;
+    }
+
+    return true;
+#else
+    Q_UNUSED(fd);
+    Q_UNUSED(offset);
+    Q_UNUSED(size);
+    return true;
+#endif
+}
+/*!
+ * \brief DFileCopyMoveJobPrivate::doCopyFileByKernel 本地文件之间的内核拷贝，依次尝试 reflink(FICLONE)、
+ * copy_file_range 和 sendfile，数据不经过用户态的缓存。此函数不弹出错误处理，失败时把文件指针调整到已拷贝的
+ * 位置，由调用者的读写流程接着拷贝并处理错误。需要校验完整性时要读取数据计算校验和，不走此流程
+ * \param fromInfo 源文件的信息
+ * \param toInfo 目标文件的信息
+ * \param fromDevice 源文件的iodevice（已打开）
+ * \param toDevice 目标文件的iodevice（已打开）
+ * \return 文件已经全部拷贝完成返回true，需要继续使用读写流程拷贝返回false
+ */
+bool DFileCopyMoveJobPrivate::doCopyFileByKernel(const DAbstractFileInfoPointer &fromInfo, const DAbstractFileInfoPointer &toInfo,
+                                                 const QSharedPointer<DFileDevice> &fromDevice, const QSharedPointer<DFileDevice> &toDevice)
+{
+#ifdef Q_OS_LINUX
+    if (!fileHints.testFlag(DFileCopyMoveJob::DontIntegrityChecking))
+        return false;
+
+    if (!fromInfo || !toInfo || fromInfo->isGvfsMountFile() || toInfo->isGvfsMountFile())
+        return false;
+
+    const int fromFd = fromDevice->handle();
+    const int toFd = toDevice->handle();
+    const qint64 size = fromInfo->size();
+    if (fromFd <= 0 || toFd <= 0 || size <= 0)
+        return false;
+
+#ifdef FICLONE
+    // 同一个支持写时复制的文件系统（btrfs、xfs等）上直接共享数据块
+    if (ioctl(toFd, FICLONE, fromFd) == 0) {
+        currentJobDataSizeInfo.second += size;
+        completedDataSize += size;
+        completedDataSizeOnBlockDevice += size;
+        countrefinesize(size);
+        return true;
+    }
+#endif
+
+    // reflink 不需要额外的空间，不能成功时才预先分配；空间不足时由读写流程报错
+    if (!preallocateTargetFile(toFd, 0, size))
+        return false;
+
+    bool useCopyFileRange = true;
+    bool isCopied = false;
+    off_t offset = 0;
+    WritebackThrottle writeback;
+    adviseCopyPageCache(fromFd, toFd, size, writeback);
+    const HoleScanner holes(isKeepHoles() ? fromInfo->fileUrl().toLocalFile() : QString());
+
+    while (offset < size) {
+        if (Q_UNLIKELY(!stateCheck()))
+            break;
+
+        //跳过空洞，进度按照文件的逻辑大小计算
+        if (holes.isSparse()) {
+            const qint64 dataOffset = holes.nextData(offset);
+            if (dataOffset > offset) {
+                const qint64 holeSize = dataOffset - offset;
+                currentJobDataSizeInfo.second += holeSize;
+                completedDataSize += holeSize;
+                completedDataSizeOnBlockDevice += holeSize;
+                countrefinesize(holeSize);
+                offset = static_cast<off_t>(dataOffset);
+                if (offset >= size)
+                    break;
+                // sendfile写入目标文件当前的位置
+                if (!useCopyFileRange)
+                    lseek(toFd, offset, SEEK_SET);
+            }
+        }
+
+        const size_t len = static_cast<size_t>(qMin<qint64>(KERNEL_COPY_BLOCK_LEN, size - offset));
+        ssize_t size_write = -1;
+
+        if (useCopyFileRange) {
+            off_t outOffset = offset;
+            size_write = copy_file_range(fromFd, &offset, toFd, &outOffset, len, 0);
+            // 内核或者文件系统不支持时改用 sendfile
+            if (size_write < 0 && !isCopied && (errno == EXDEV || errno == ENOSYS
+                                                || errno == EOPNOTSUPP || errno == EINVAL)) {
+                useCopyFileRange = false;
+                lseek(toFd, offset, SEEK_SET);
+                continue;
+            }
+        } else {
+            size_write = sendfile(toFd, fromFd, &offset, len);
+        }
+
+        // 出错或者源文件被截断，剩余的数据交给读写流程去处理
+        if (size_write <= 0) {
+            qCDebug(fileJob()) << "kernel copy stopped at" << offset << "of" << fromInfo->fileUrl() << strerror(errno);
+            break;
+        }
+        isCopied = true;
+
+        if (m_syncPolicy == DFileCopyMoveJob::FileSystemSync || m_syncPolicy == DFileCopyMoveJob::FileSync
+                || writeback.isDropCache())
+            writeback.written(toFd, offset);
+        else if (m_isEveryReadAndWritesSnc)
+            toDevice->syncToDisk(m_isVfat);
+        writeback.read(fromFd, offset);
+        throttleRead(size_write);
+
+        currentJobDataSizeInfo.second += size_write;
+        completedDataSize += size_write;
+        completedDataSizeOnBlockDevice += size_write;
+        countrefinesize(size_write);
+    }
+
+    if (offset >= size) {
+        //文件末尾是空洞时没有写入数据，需要把目标文件扩展到源文件的大小
+        if (holes.isSparse() && ftruncate(toFd, size) != 0)
+            qCWarning(fileJob()) << "failed to resize the sparse file:" << toInfo->fileUrl() << strerror(errno);
+        return true;
+    }
+
+    if (!fromDevice->seek(offset) || !toDevice->seek(offset))
+        qCWarning(fileJob()) << "failed to seek after kernel copy:" << fromInfo->fileUrl() << toDevice->errorString();
+
+    return false;
+#else
+    Q_UNUSED(fromInfo);
+    Q_UNUSED(toInfo);
+    Q_UNUSED(fromDevice);
+    Q_UNUSED(toDevice);
+    return false;
+#endif
+}
+/*!
+ * \brief DFileCopyMoveJobPrivate::prefetchDirectory 遍历目录并读取每个子项的属性，使其进入内核的目录项和inode缓存，
+ * 之后任务线程再遍历此目录时就不用等待磁盘
+ * \param path 目录的本地路径
+ * \return 子目录的路径
+ */
+QStringList DFileCopyMoveJobPrivate::prefetchDirectory(const QString &path)
+{
+    QStringList subDirs;
+    DIR *dir = opendir(path.toLocal8Bit().constData());
+    if (!dir)
+        return subDirs;
+
+    const int dirFd = dirfd(dir);
+    struct dirent *ent = nullptr;
+    while ((ent = readdir(dir)) && state != DFileCopyMoveJob::StoppedState) {
+        if (strcmp(ent->d_name, ".") == 0 || strcmp(ent->d_name, "..") == 0)
+            continue;
+
+        struct stat st;
+        if (fstatat(dirFd, ent->d_name, &st, AT_SYMLINK_NOFOLLOW) == 0 && S_ISDIR(st.st_mode))
+            subDirs << path + QDir::separator() + QString::fromLocal8Bit(ent->d_name);
+    }
+    closedir(dir);
+
+    return subDirs;
+}
+
+/*!
+ * \brief DFileCopyMoveJobPrivate::prefetchSubDirectories 在预读线程池中并行预读目录的每个子目录。
+ * 只预读本地磁盘上的源文件，目录的创建、冲突处理和遍历顺序依然在任务线程中完成
+ * \param url 目录的url
+ */
+void DFileCopyMoveJobPrivate::prefetchSubDirectories(const DUrl &url)
+{
+    if (!m_isFileOnDiskUrls || !url.isLocalFile() || state == DFileCopyMoveJob::StoppedState)
+        return;
+
+    const QString &path = url.toLocalFile();
+    {
+        //已经进入此目录，不用再记录它是否被预读过
+        QMutexLocker lk(&m_prefetchMutex);
+        m_prefetchedDirs.remove(path);
+    }
+
+    QtConcurrent::run(&m_prefetchPool, [this, path]() {
+        for (const QString &subDir : prefetchDirectory(path)) {
+            {
+                QMutexLocker lk(&m_prefetchMutex);
+                if (m_prefetchedDirs.contains(subDir))
+                    continue;
+                m_prefetchedDirs.insert(subDir);
+            }
+            QtConcurrent::run(&m_prefetchPool, [this, subDir]() {
+                prefetchDirectory(subDir);
+            });
+        }
+    });
+}
+
+/*!
+ * \brief DFileCopyMoveJobPrivate::handleUnknowUrlError 阻塞处理UnknowUrlError的错误
+ * \param fromInfo 源文件的文件信息
+ * \param toInfo 目标文件的文件信息
+ * \return
  */
 bool DFileCopyMoveJobPrivate::handleUnknowUrlError(const DAbstractFileInfoPointer &fromInfo, const DAbstractFileInfoPointer &toInfo)
 {
@@ -4016,8 +6117,8 @@ void DFileCopyMoveJobPrivate::initRefineState()
     // 不是优化就直接退出
     if (m_refineStat == DFileCopyMoveJob::NoRefine)
         return;
-    // 不是拷贝mode就直接为NoRefine，走以前
-    if (mode != DFileCopyMoveJob::CopyMode) {
+    // 不是拷贝mode或者需要校验拷贝结果时直接为NoRefine，走以前
+    if (mode != DFileCopyMoveJob::CopyMode || m_verifyMode != DFileCopyMoveJob::NoVerify) {
         m_refineStat = DFileCopyMoveJob::NoRefine;
         return;
     }
@@ -4053,6 +6154,129 @@ void DFileCopyMoveJobPrivate::removeCopyFileUrl(const DUrl &url)
     copyingFiles.removeOne(url);
 }
 
+/*!
+ * \brief DFileCopyMoveJobPrivate::spindleDeviceKey 获取文件所在的机械硬盘
+ * \param path 本地文件路径
+ * \return 机械硬盘在/sys中的路径，固态硬盘、网络文件等不需要排队的设备返回空
+ */
+QString DFileCopyMoveJobPrivate::spindleDeviceKey(const QString &path)
+{
+    struct stat st;
+    if (path.isEmpty() || stat(path.toLocal8Bit().constData(), &st) != 0)
+        return QString();
+
+    QString sysPath = QFileInfo(QString("/sys/dev/block/%1:%2").arg(major(st.st_dev)).arg(minor(st.st_dev))).canonicalFilePath();
+    if (sysPath.isEmpty())
+        return QString();
+
+    // 分区使用所在磁盘的队列属性，同一个磁盘的不同分区共用一个磁头
+    if (QFile::exists(sysPath + "/partition"))
+        sysPath = QFileInfo(sysPath).path();
+
+    QFile rotational(sysPath + "/queue/rotational");
+    if (!rotational.open(QIODevice::ReadOnly) || rotational.readAll().trimmed() != "1")
+        return QString();
+
+    return sysPath;
+}
+
+/*!
+ * \brief DFileCopyMoveJobPrivate::deviceSchedulerKeys 获取当前任务读写的机械硬盘
+ * 盘内剪切只是重命名，不需要排队
+ */
+QStringList DFileCopyMoveJobPrivate::deviceSchedulerKeys() const
+{
+    if (!targetUrl.isValid() || !targetUrl.isLocalFile())
+        return QStringList();
+
+    struct stat targetStat;
+    const bool targetStatOk = stat(targetUrl.toLocalFile().toLocal8Bit().constData(), &targetStat) == 0;
+
+    QStringList keys;
+    bool isAllRename = mode == DFileCopyMoveJob::CutMode && targetStatOk;
+    for (const DUrl &url : sourceUrlList) {
+        if (!url.isLocalFile())
+            continue;
+        const QString &path = url.toLocalFile();
+        struct stat sourceStat;
+        if (stat(path.toLocal8Bit().constData(), &sourceStat) != 0 || !targetStatOk || sourceStat.st_dev != targetStat.st_dev)
+            isAllRename = false;
+
+        const QString &key = spindleDeviceKey(path);
+        if (!key.isEmpty() && !keys.contains(key))
+            keys << key;
+    }
+
+    if (isAllRename)
+        return QStringList();
+
+    const QString &targetKey = spindleDeviceKey(targetUrl.toLocalFile());
+    if (!targetKey.isEmpty() && !keys.contains(targetKey))
+        keys << targetKey;
+
+    return keys;
+}
+
+/*!
+ * \brief DFileCopyMoveJobPrivate::waitForDevices 与使用相同机械硬盘的其它任务排队，
+ * 所有设备上排在前面的任务都结束后才开始拷贝，不同设备上的任务并行执行
+ * \return 任务被停止时返回false
+ */
+bool DFileCopyMoveJobPrivate::waitForDevices()
+{
+    m_deviceKeys = deviceSchedulerKeys();
+    if (m_deviceKeys.isEmpty())
+        return true;
+
+    QMutexLocker lk(&deviceJobMutex);
+    // 一次加入所有设备的队列，各个队列中任务的先后顺序一致，不会互相等待
+    for (const QString &key : m_deviceKeys)
+        deviceJobQueues[key] << q_ptr;
+
+    auto isFirstJob = [this] {
+        for (const QString &key : m_deviceKeys) {
+            if (deviceJobQueues.value(key).first() != q_ptr)
+                return false;
+        }
+        return true;
+    };
+
+    if (!isFirstJob()) {
+        qInfo() << "job queued, wait for other jobs on" << m_deviceKeys;
+        m_isDeviceQueued = true;
+        lk.unlock();
+        setState(DFileCopyMoveJob::QueuedState);
+        lk.relock();
+
+        while (!isFirstJob() && state != DFileCopyMoveJob::StoppedState)
+            deviceJobCondition.wait(&deviceJobMutex);
+
+        m_isDeviceQueued = false;
+        lk.unlock();
+        // 排队时被暂停的任务继续保持暂停
+        if (state == DFileCopyMoveJob::QueuedState)
+            setState(DFileCopyMoveJob::RunningState);
+    }
+
+    return state != DFileCopyMoveJob::StoppedState;
+}
+
+void DFileCopyMoveJobPrivate::releaseDevices()
+{
+    if (m_deviceKeys.isEmpty())
+        return;
+
+    QMutexLocker lk(&deviceJobMutex);
+    for (const QString &key : m_deviceKeys) {
+        QList<DFileCopyMoveJob *> &jobs = deviceJobQueues[key];
+        jobs.removeAll(q_ptr);
+        if (jobs.isEmpty())
+            deviceJobQueues.remove(key);
+    }
+    m_deviceKeys.clear();
+    deviceJobCondition.wakeAll();
+}
+
 //! 用于保存回收站剪切出去的文件在回收站的原始路径
 void DFileCopyMoveJob::setCurTrashData(QVariant fileNameList)
 {
@@ -4196,6 +6420,21 @@ void DFileCopyMoveJob::stop()
         d->m_errorQueue.clear();
         d->m_errorCondition.wakeAll();
     }
+    //唤醒阻塞在写队列上的读写线程
+    {
+        QMutexLocker lk(&d->m_copyInfoQueueMutex);
+        d->m_writeQueueNotEmptyCondition.wakeAll();
+        d->m_writeQueueNotFullCondition.wakeAll();
+    }
+    {
+        QMutexLocker lk(&d->m_copyBufferMutex);
+        d->m_copyBufferCondition.wakeAll();
+    }
+    //唤醒排队等待设备的任务
+    {
+        QMutexLocker lk(&DFileCopyMoveJobPrivate::deviceJobMutex);
+        DFileCopyMoveJobPrivate::deviceJobCondition.wakeAll();
+    }
 
     d->stopAllDeviceOperation();
 
@@ -4217,7 +6456,8 @@ void DFileCopyMoveJob::togglePause()
     d->fileStatistics->togglePause();
 
     if (d->state == PausedState) {
-        d->setState(RunningState);
+        //还在排队时恢复为排队状态
+        d->setState(d->m_isDeviceQueued ? QueuedState : RunningState);
         d->waitCondition.wakeAll();
     } else {
         d->setState(PausedState);
@@ -4255,7 +6495,18 @@ DFileCopyMoveJob::DFileCopyMoveJob(DFileCopyMoveJobPrivate *dd, QObject *parent)
     dd->fileStatistics = new DFileStatisticsJob(this);
     dd->updateSpeedTimer = new QTimer(this);
 
-    connect(dd->fileStatistics, &DFileStatisticsJob::finished, this, &DFileCopyMoveJob::fileStatisticsFinished, Qt::DirectConnection);
+    // 本地文件的统计与拷贝同时进行，统计完成时先记录总大小再通知
+    connect(dd->fileStatistics, &DFileStatisticsJob::finished, this, [this] {
+        Q_D(DFileCopyMoveJob);
+
+        if (d->m_isFileOnDiskUrls && d->targetUrl.isValid() && !d->m_isCountSizeOver) {
+            d->totalsize = d->fileStatistics->totalProgressSize();
+            d->totalfilecount = d->fileStatistics->filesCount();
+            d->m_isCountSizeOver = true;
+        }
+
+        Q_EMIT fileStatisticsFinished();
+    }, Qt::DirectConnection);
     connect(dd->updateSpeedTimer, SIGNAL(timeout()), this, SLOT(_q_updateProgress()), Qt::DirectConnection);
 }
 
@@ -4276,12 +6527,14 @@ void DFileCopyMoveJob::run()
         d->mode = CopyMode;
     }
 
-    // 本地文件使用 countAllCopyFile 统计大小非常快, 因此不必开辟线程去统计大小. 同步等待文件大小统计完成
-    // 网络文件使用以下方式反而会更慢, 因此使用线程统计类
+    // 本地文件与属性对话框使用同样的统计方式：多个线程读取本地目录，没有变化的目录使用缓存
+    // 统计与拷贝同时进行，统计完成前按照统计到的大小显示模糊进度，剩余空间在拷贝每个文件前检查
+    // 网络文件在 start 中开始统计
     if (d->targetUrl.isValid() && d->m_isFileOnDiskUrls) {
-        d->totalsize = FileUtils::totalSize(d->sourceUrlList,d->m_currentDirSize,d->totalfilecount);
-        d->m_isCountSizeOver = true;
-        emit fileStatisticsFinished();
+        d->m_isCountSizeOver = false;
+        // 统计时每个目录按一页计算
+        d->m_currentDirSize = static_cast<qint32>(FileUtils::getMemoryPageSize());
+        d->fileStatistics->start(d->sourceUrlList);
     }
 
     d->completedDirectoryList.clear();
@@ -4289,8 +6542,14 @@ void DFileCopyMoveJob::run()
     d->targetUrlList.clear();
     d->completedDataSize = 0;
     d->completedDataSizeOnBlockDevice = 0;
+    d->m_lastSpeedTime = 0;
+    d->m_lastSpeedSize = 0;
+    d->m_smoothedSpeed = 0;
     d->completedFilesCount = 0;
     d->tid = qt_gettid();
+    //断点续传只支持拷贝，剪切时源文件会被删除
+    if (d->mode == CopyMode && !d->m_journalFilePath.isEmpty())
+        d->m_copyJournal.open(d->m_journalFilePath);
 
     DAbstractFileInfoPointer target_info;
     bool mayExecSync = false;
@@ -4321,13 +6580,16 @@ void DFileCopyMoveJob::run()
         d->canUseWriteBytes = 0;
         d->targetIsRemovable = 0;
         d->targetLogSecionSize = 512;
-        d->targetDeviceStartSectorsWritten = -1;
         d->targetSysDevPath.clear();
         d->targetRootPath.clear();
         d->m_isTagGvfsFile = target_info->isGvfsMountFile();
 
         //检查是否需要每次读写都去同步
         d->checkTagetNeedSync();
+        //从 MTP 设备拷贝或者拷贝到 MTP 设备时，在两次读写之间把设备让给目录遍历和缩略图
+        d->m_accessDevice = DDeviceAccessScheduler::deviceOf(d->targetUrl.toLocalFile());
+        if (d->m_accessDevice.isEmpty() && !d->sourceUrlList.isEmpty())
+            d->m_accessDevice = DDeviceAccessScheduler::deviceOf(d->sourceUrlList.first().toLocalFile());
         //检查目标目录是否是块设备
         d->checkTagetIsFromBlockDevice();
 
@@ -4380,10 +6642,6 @@ void DFileCopyMoveJob::run()
                                     qCWarning(fileJob());
                                 }
 
-                                if (d->targetIsRemovable) {
-                                    d->targetDeviceStartSectorsWritten = d->getSectorsWritten();
-                                }
-
                                 qCDebug(fileJob(), "Block device path: \"%s\", Sys dev path: \"%s\", Is removable: %d, Log-Sec: %d",
                                         qPrintable(dev_path), qPrintable(d->targetSysDevPath), bool(d->targetIsRemovable), d->targetLogSecionSize);
                             } else {
@@ -4398,6 +6656,26 @@ void DFileCopyMoveJob::run()
                 qCDebug(fileJob(), "canUseWriteBytes = %d, targetIsRemovable = %d", bool(d->canUseWriteBytes), bool(d->targetIsRemovable));
             }
         }
+
+        //根据目标设备类型确定初始的读写块大小，拷贝过程中再根据速度调整
+        const bool isNetworkTarget = d->m_isTagGvfsFile || DStorageInfo::isLowSpeedDevice(d->targetUrl.toLocalFile())
+                || (targetStorageInfo && !targetStorageInfo->isLocalDevice());
+        const bool isRemovableTarget = d->targetIsRemovable || d->m_isTagFromBlockDevice;
+        //拷贝到移动设备时需要在任务结束前把数据同步到设备，用户才可以安全移除
+        if (d->m_syncPolicy == AutoSync)
+            d->m_syncPolicy = (isRemovableTarget && !d->m_bDestLocal) ? FileSystemSync : NoSync;
+        d->m_blockSizeController.reset(DFileCopyMoveJobPrivate::BlockSizeController::defaultBlockSize(isNetworkTarget, isRemovableTarget));
+
+        //写入保险箱时按 cryfs 的块大小对齐写入，避免 cryfs 读出不完整的块再重新加密
+        d->m_isVaultTarget = targetStorageInfo && targetStorageInfo->fileSystemType() == "fuse.cryfs"
+                && VaultController::isVaultFile(d->targetUrl.toLocalFile());
+        if (d->m_isVaultTarget) {
+            const qint64 vaultBlockSize = VaultConfig().get(CONFIG_NODE_NAME, CONFIG_KEY_BLOCKSIZE, QVariant(VAULT_DEFAULT_BLOCK_SIZE)).toLongLong();
+            d->m_blockSizeController.setAlignment(vaultBlockSize);
+            d->m_blockSizeController.reset(VAULT_COPY_BLOCK_LEN);
+            //每次同步都要等待 cryfs 写出所有的块，由 cryfs 自己负责落盘
+            d->m_syncPolicy = NoSync;
+        }
     } else if (d->mode == CopyMode || d->mode == CutMode) {
         d->setError(UnknowError, "Invalid target url");
         goto end;
@@ -4406,13 +6684,34 @@ void DFileCopyMoveJob::run()
         qCDebug(fileJob(), "remove mode");
     }
     //初始化优化状态
+    //开启校验时不能跳过完整性校验
+    if (d->m_verifyMode != NoVerify)
+        d->fileHints.setFlag(DontIntegrityChecking, false);
     d->initRefineState();
+    //限制同时打开的网络文件流数量
+    if (d->m_refineStat == NoRefine && d->m_isTagGvfsFile)
+        d->m_pool.setMaxThreadCount(REMOTE_COPY_STREAM_NUM);
+    else if (d->isVaultPoolCopy())
+        d->m_pool.setMaxThreadCount(VAULT_COPY_STREAM_NUM);
+    //等待同一个机械硬盘上的其它任务完成
+    if (!d->waitForDevices())
+        goto end;
+    //盘内剪切先批量重命名，冲突的文件在后面逐个处理
+    d->bulkRenameOnSameDevice();
 
     for (DUrl &source : d->sourceUrlList) {
         if (!d->stateCheck()) {
             goto end;
         }
 
+        //批量重命名已经完成的文件不再逐个处理
+        const auto &renamed = d->m_bulkRenamedUrls.constFind(source);
+        if (renamed != d->m_bulkRenamedUrls.constEnd()) {
+            d->targetUrlList << renamed.value();
+            Q_EMIT finished(source, renamed.value());
+            continue;
+        }
+
         // fix: 搜索列表中的文件路径需要转化为原始路径
         if (source.isSearchFile()) {
             source = source.searchedFileUrl();
@@ -4477,48 +6776,61 @@ void DFileCopyMoveJob::run()
         d->setError(NoError);
 
 end:
+    //遍历已经结束，不再需要预读目录
+    d->m_prefetchPool.clear();
+    d->m_prefetchPool.waitForDone();
+    d->m_prefetchedDirs.clear();
+    //本地文件已经拷贝完成时不再需要统计
+    if (d->m_isFileOnDiskUrls && d->fileStatistics->isRunning()) {
+        d->fileStatistics->stop();
+        d->fileStatistics->wait();
+    }
     //设置优化拷贝线程结束
     d->setRefineCopyProccessSate(ReadFileProccessOver);
     //等待线程池结束,等待异步写线程结束
     d->waitRefineThreadFinish();
 
-    if (!d->m_bDestLocal && d->targetIsRemovable && mayExecSync &&
+    if ((d->m_syncPolicy == FileSystemSync || d->m_syncPolicy == FileSync) && mayExecSync &&
             d->state != DFileCopyMoveJob::StoppedState) { //主动取消时state已经被设置为stop了
-        // 任务完成后执行 sync 同步数据到硬盘, 同时将状态改为 SleepState，用于定时器更新进度和速度信息
-        if (d->m_isVfat) {
-            d->setState(IOWaitState);
-            int syncRet = 0;
-            d->m_syncResult = QtConcurrent::run([me, &d, &syncRet]() {
-                //! 外设或远程设备在同步数据时发送sendDataSyncing信号在拷贝任务对话框中显示数据同步种与即将完成
-                Q_EMIT me->sendDataSyncing(tr("Syncing data"), tr("Please wait"));
-                qInfo() << "sync to block disk and target path = " << d->targetRootPath;
-                syncRet = QProcess::execute("sync", {"-f", d->targetRootPath});
-            });
-            // 检测同步时是否被停止，若停止则立即跳出
-            while (!d->m_syncResult.isFinished()) {
-                if (d->state == DFileCopyMoveJob::StoppedState) {
-                    qDebug() << "stop sync";
-                    goto end;
-                }
-                QThread::msleep(10);
+        // 任务完成后同步目标文件系统, 同时将状态改为 SleepState，用于定时器更新进度和速度信息
+        d->setState(IOWaitState);
+        int syncRet = 0;
+        d->m_syncResult = QtConcurrent::run([me, &d, &syncRet]() {
+            //! 外设或远程设备在同步数据时发送sendDataSyncing信号在拷贝任务对话框中显示数据同步种与即将完成
+            Q_EMIT me->sendDataSyncing(tr("Syncing data"), tr("Please wait"));
+            qInfo() << "sync to block disk and target path = " << d->targetRootPath;
+            syncRet = d->syncTargetFileSystem();
+        });
+        // 检测同步时是否被停止，若停止则立即跳出
+        while (!d->m_syncResult.isFinished()) {
+            if (d->state == DFileCopyMoveJob::StoppedState) {
+                qDebug() << "stop sync";
+                goto end;
             }
+            QThread::msleep(10);
+        }
 
-            // 同步结果检查只针对拷贝
-            if (d->mode == CopyMode && syncRet != 0) {
-                DFileCopyMoveJob::Action action = d->setAndhandleError(DFileCopyMoveJob::OpenError, target_info, DAbstractFileInfoPointer(nullptr),
-                                                                       "Failed to synchronize to disk u!");
+        // 同步结果检查只针对拷贝
+        if (d->mode == CopyMode && syncRet != 0) {
+            DFileCopyMoveJob::Action action = d->setAndhandleError(DFileCopyMoveJob::OpenError, target_info, DAbstractFileInfoPointer(nullptr),
+                                                                   "Failed to synchronize to disk u!");
 
-                if (action == DFileCopyMoveJob::RetryAction) {
-                    goto end;
-                }
-            }
-            // 恢复状态
-            if (d->state == IOWaitState) {
-                d->setState(RunningState);
+            if (action == DFileCopyMoveJob::RetryAction) {
+                goto end;
             }
         }
+        // 恢复状态
+        if (d->state == IOWaitState) {
+            d->setState(RunningState);
+        }
     }
 
+    //任务完成后删除拷贝日志，被取消或者出错中断时保留，用于下次续传
+    d->m_copyJournal.close(d->state != StoppedState);
+    //让出设备给排队的任务
+    d->releaseDevices();
+    d->resetIoPriority();
+
     d->fileStatistics->stop();
     d->setState(StoppedState);
 
@@ -4531,6 +6843,11 @@ end:
 
     }
 
+    DFM_METRIC_INC("copy.jobs");
+    DFM_METRIC_ADD("copy.bytes", d->completedDataSize);
+    DFM_METRIC_ADD("copy.files", d->completedFilesCount);
+    DFM_METRIC_ADD("copy.msecs", QDateTime::currentMSecsSinceEpoch() - timesec);
+
     qInfo() << "job finished, error:" << error() << ", message:" << errorString() << QDateTime::currentMSecsSinceEpoch() - timesec;
 }
 
@@ -4544,9 +6861,9 @@ QString DFileCopyMoveJob::Handle::getNewFileName(DFileCopyMoveJob *job, const DA
     return job->d_func()->formatFileName(sourceInfo->fileName());
 }
 
-QString DFileCopyMoveJob::Handle::getNonExistsFileName(const DAbstractFileInfoPointer sourceInfo, const DAbstractFileInfoPointer targetDirectory)
+QString DFileCopyMoveJob::Handle::getNonExistsFileName(DFileCopyMoveJob *job, const DAbstractFileInfoPointer sourceInfo, const DAbstractFileInfoPointer targetDirectory)
 {
-    return DFileCopyMoveJobPrivate::getNewFileName(sourceInfo, targetDirectory);
+    return job->d_func()->getNonExistsFileName(sourceInfo, targetDirectory);
 }
 
 DFM_END_NAMESPACE
@@ -41,7 +41,8 @@ public:
         RunningState,
         PausedState,
         SleepState,
-        IOWaitState // 可能会长时间等待io的状态
+        IOWaitState, // 可能会长时间等待io的状态
+        QueuedState // 等待同一个磁盘上的其它任务完成
     };
 
     Q_ENUM(State)
@@ -62,6 +63,40 @@ public:
 
     Q_ENUM(RefineCopyProccessSate)
 
+    enum VerifyMode {
+        NoVerify, // 按照 DontIntegrityChecking 决定是否校验
+        FastVerify, // adler32 校验
+        Sha256Verify // SHA-256 校验
+    };
+
+    Q_ENUM(VerifyMode)
+
+    enum SyncPolicy {
+        AutoSync, // 根据目标设备决定，移动设备使用 FileSystemSync，其它不主动同步
+        NoSync, // 不主动同步，由系统回写
+        FileSystemSync, // 拷贝过程中分段回写，任务结束时只同步目标文件系统
+        FileSync // 拷贝过程中分段回写，每个文件写完后在后台同步这个文件
+    };
+
+    Q_ENUM(SyncPolicy)
+
+    enum PageCachePolicy {
+        AutoPageCache, // 拷贝的数据量超过物理内存的四分之一时，大文件读写后丢弃页缓存
+        KeepPageCache, // 保留页缓存，由系统回收
+        DropPageCache // 源文件顺序读取且不重复使用，目标文件回写后立刻丢弃页缓存
+    };
+
+    Q_ENUM(PageCachePolicy)
+
+    enum IdenticalFilePolicy {
+        NoSkipIdentical, // 目标文件已存在时按照冲突处理
+        SkipSameSizeAndTime, // 大小和修改时间都相同时跳过，不打开文件
+        SkipSameSamples, // 大小和修改时间都相同，且抽样比较的数据块也相同时跳过
+        SkipSameContent // 大小和修改时间都相同，且全部内容相同时跳过
+    };
+
+    Q_ENUM(IdenticalFilePolicy)
+
 
     enum Error {
         NoError,
@@ -106,7 +141,11 @@ public:
         DontIntegrityChecking = 0x40, // 复制文件时不进行完整性校验
         DontFormatFileName = 0x80, // 不要自动处理文件名中的非法字符
         DontSortInode = 0x100, // 不要对目录中的文件按inode排序
-        ForceDeleteFile = 0x200 // 强制删除文件夹(去除文件夹的只读权限)
+        ForceDeleteFile = 0x200, // 强制删除文件夹(去除文件夹的只读权限)
+        SparseFile = 0x400, // 复制本地的稀疏文件时保留文件中的空洞
+        LinkToDestination = 0x800, // 源文件与目标在同一文件系统时创建硬链接，不复制数据（用于光盘暂存区）
+        PreserveHardLinks = 0x1000, // 源文件中互为硬链接的文件只复制一次，其余的在目标中创建硬链接
+        DeltaTransfer = 0x2000 // 替换已存在的大文件时只写入与源文件不同的数据块
     };
 
     Q_ENUM(FileHint)
@@ -144,7 +183,7 @@ public:
                                    const DAbstractFileInfoPointer sourceInfo,
                                    const DAbstractFileInfoPointer targetInfo) = 0;
         virtual QString getNewFileName(DFileCopyMoveJob *job, const DAbstractFileInfoPointer sourceInfo);
-        virtual QString getNonExistsFileName(const DAbstractFileInfoPointer sourceInfo,
+        virtual QString getNonExistsFileName(DFileCopyMoveJob *job, const DAbstractFileInfoPointer sourceInfo,
                                              const DAbstractFileInfoPointer targetDirectory);
     };
 
@@ -169,12 +208,36 @@ public:
     bool fileStatisticsIsFinished() const;
     qint64 totalDataSize() const;
     int totalFilesCount() const;
+    //当前拷贝使用的读写块大小
+    qint64 currentBlockSize() const;
     QList<QPair<DUrl, DUrl> > completedFiles() const;
     QList<QPair<DUrl, DUrl> > completedDirectorys() const;
     //获取当前是否可以显示进度条
     bool isCanShowProgress() const;
 
     void setRefine(const RefineState &refinestat);
+    //每秒最多读取的字节数，0为不限速，任务运行时可以修改
+    qint64 speedLimit() const;
+    void setSpeedLimit(qint64 bytesPerSecond);
+    //后台模式使用空闲io优先级并且默认限速，减少对桌面的影响
+    bool isBackgroundMode() const;
+    void setBackgroundMode(bool background);
+    //断点续传的拷贝日志文件，为空时不记录日志
+    QString journalFile() const;
+    void setJournalFile(const QString &filePath);
+    static QString defaultJournalFile(const DUrlList &sourceUrls, const DUrl &targetUrl);
+    //拷贝完成后绕过页缓存重新读取目标文件，和源文件的校验值比较
+    VerifyMode verifyMode() const;
+    void setVerifyMode(VerifyMode mode);
+    //拷贝到目标设备的数据如何同步到磁盘，任务开始后返回实际使用的策略
+    SyncPolicy syncPolicy() const;
+    void setSyncPolicy(SyncPolicy policy);
+    //拷贝时源文件和目标文件的页缓存如何处理，避免大量拷贝把其它程序的缓存挤出内存
+    PageCachePolicy pageCachePolicy() const;
+    void setPageCachePolicy(PageCachePolicy policy);
+    //复制到已存在的目录树时，和源文件相同的目标文件直接跳过，不再重新拷贝
+    IdenticalFilePolicy identicalFilePolicy() const;
+    void setIdenticalFilePolicy(IdenticalFilePolicy policy);
 
     void setCurTrashData(QVariant fileNameList);
     //设置当前拷贝显示了进度条
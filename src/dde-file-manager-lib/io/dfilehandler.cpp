@@ -30,6 +30,74 @@ QString DFileHandler::errorString() const
     return d->errorString;
 }
 
+static DUrl childUrl(const DUrl &dirUrl, const QString &name)
+{
+    DUrl url = dirUrl;
+    const QString &path = dirUrl.path();
+
+    url.setPath(path.endsWith('/') ? path + name : path + '/' + name);
+
+    return url;
+}
+
+QStringList DFileHandler::mkdirBatch(const DUrl &dirUrl, const QStringList &names)
+{
+    QStringList errors;
+
+    for (const QString &name : names)
+        errors << (mkdir(childUrl(dirUrl, name)) ? QString() : errorString());
+
+    return errors;
+}
+
+/*!
+ * \brief DFileHandler::linkBatch 批量创建符号链接
+ * \param targetAndNames 链接指向的路径和链接的文件名
+ */
+QStringList DFileHandler::linkBatch(const DUrl &dirUrl, const QList<QPair<QString, QString>> &targetAndNames)
+{
+    QStringList errors;
+
+    for (const auto &item : targetAndNames)
+        errors << (link(item.first, childUrl(dirUrl, item.second)) ? QString() : errorString());
+
+    return errors;
+}
+
+QStringList DFileHandler::removeBatch(const DUrl &dirUrl, const QStringList &names)
+{
+    QStringList errors;
+
+    for (const QString &name : names)
+        errors << (remove(childUrl(dirUrl, name)) ? QString() : errorString());
+
+    return errors;
+}
+
+/*!
+ * \brief DFileHandler::renameBatch 在同一目录中批量重命名，按顺序执行
+ * \param names 原文件名和新文件名
+ */
+QStringList DFileHandler::renameBatch(const DUrl &dirUrl, const QList<QPair<QString, QString>> &names)
+{
+    QStringList errors;
+
+    for (const auto &item : names)
+        errors << (rename(childUrl(dirUrl, item.first), childUrl(dirUrl, item.second)) ? QString() : errorString());
+
+    return errors;
+}
+
+QStringList DFileHandler::setPermissionsBatch(const DUrl &dirUrl, const QList<QPair<QString, QFileDevice::Permissions>> &permissions)
+{
+    QStringList errors;
+
+    for (const auto &item : permissions)
+        errors << (setPermissions(childUrl(dirUrl, item.first), item.second) ? QString() : errorString());
+
+    return errors;
+}
+
 DFileHandler::DFileHandler()
     : DFileHandler(*new DFileHandlerPrivate(this))
 {
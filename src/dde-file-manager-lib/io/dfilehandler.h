@@ -28,6 +28,14 @@ public:
     virtual bool setPermissions(const DUrl &url, QFileDevice::Permissions permissions) = 0;
     virtual bool setFileTime(const DUrl &url, const QDateTime &accessDateTime, const QDateTime &lastModifiedTime) = 0;
 
+    // 批量操作 dirUrl 目录中的文件，参数中的名称都是相对于此目录的文件名。
+    // 返回与参数一一对应的错误信息，成功的项为空字符串。默认实现逐个调用上面的函数
+    virtual QStringList mkdirBatch(const DUrl &dirUrl, const QStringList &names);
+    virtual QStringList linkBatch(const DUrl &dirUrl, const QList<QPair<QString, QString>> &targetAndNames);
+    virtual QStringList removeBatch(const DUrl &dirUrl, const QStringList &names);
+    virtual QStringList renameBatch(const DUrl &dirUrl, const QList<QPair<QString, QString>> &names);
+    virtual QStringList setPermissionsBatch(const DUrl &dirUrl, const QList<QPair<QString, QFileDevice::Permissions>> &permissions);
+
 protected:
     DFileHandler();
     explicit DFileHandler(DFileHandlerPrivate &dd);
@@ -7,16 +7,178 @@
 #include "dabstractfileinfo.h"
 #include "dstorageinfo.h"
 #include "shutil/fileutils.h"
+#include "dfmstandardpaths.h"
 #include <models/trashfileinfo.h>
 
 #include <QMutex>
 #include <QQueue>
 #include <QTimer>
 #include <QWaitCondition>
-
+#include <QMetaMethod>
+#include <QFile>
+#include <QFileInfo>
+#include <QSet>
+#include <QThreadPool>
+#include <QtConcurrent>
+#include <QReadWriteLock>
+#include <QDataStream>
+#include <QSaveFile>
+#include <QDateTime>
+#include <QVector>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+//缓存的目录数量上限，超过后不再缓存新的目录
+#define DIRECTORY_SIZE_CACHE_MAX_COUNT 500000
+#define DIRECTORY_SIZE_CACHE_VERSION 1
+//修改时间距离现在不超过这个时间（毫秒）的目录不缓存
+#define DIRECTORY_SIZE_CACHE_MIN_AGE 2000
 
 DFM_BEGIN_NAMESPACE
 
+// 目录中直接包含的文件的统计结果，目录的设备、inode、修改时间和状态改变时间都没有变化时才有效。
+// 每一级目录单独缓存，目录树中只有变化的目录需要重新读取
+struct CachedDirectory
+{
+    quint64 device = 0;
+    quint64 inode = 0;
+    qint64 modifyTime = 0;
+    qint64 changeTime = 0;
+
+    qint64 size = 0;
+    qint64 progressSize = 0;
+    int files = 0;
+    int directories = 0;
+    QList<QByteArray> subDirectories;
+
+    void setStamp(const struct stat &st)
+    {
+        device = st.st_dev;
+        inode = st.st_ino;
+        modifyTime = qint64(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+        changeTime = qint64(st.st_ctim.tv_sec) * 1000000000 + st.st_ctim.tv_nsec;
+    }
+
+    bool isSameStamp(const CachedDirectory &other) const
+    {
+        return device == other.device && inode == other.inode
+                && modifyTime == other.modifyTime && changeTime == other.changeTime;
+    }
+};
+
+QDataStream &operator<<(QDataStream &out, const CachedDirectory &dir)
+{
+    return out << dir.device << dir.inode << dir.modifyTime << dir.changeTime
+               << dir.size << dir.progressSize << dir.files << dir.directories << dir.subDirectories;
+}
+
+QDataStream &operator>>(QDataStream &in, CachedDirectory &dir)
+{
+    return in >> dir.device >> dir.inode >> dir.modifyTime >> dir.changeTime
+              >> dir.size >> dir.progressSize >> dir.files >> dir.directories >> dir.subDirectories;
+}
+
+// 本地统计使用的目录大小缓存，第一次使用时从缓存目录中读取，统计任务结束后保存
+class DirectorySizeCache
+{
+public:
+    DirectorySizeCache();
+
+    bool find(const QByteArray &path, CachedDirectory &dir);
+    void insert(const QByteArray &path, const CachedDirectory &dir);
+    void remove(const QByteArray &path);
+    void save();
+
+private:
+    static QString cacheFilePath();
+
+    QReadWriteLock m_lock;
+    QHash<QByteArray, CachedDirectory> m_directories;
+    bool m_isDirty = false;
+    QMutex m_saveMutex;
+};
+
+Q_GLOBAL_STATIC(DirectorySizeCache, directorySizeCache)
+// 所有统计任务共用的本地统计线程，同时打开多个属性对话框或复制任务时线程数不会成倍增加
+Q_GLOBAL_STATIC(QThreadPool, localStatisticsThreadPool)
+
+DirectorySizeCache::DirectorySizeCache()
+{
+    QFile file(cacheFilePath());
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    QDataStream in(&file);
+    int version = 0;
+    in >> version;
+    if (version != DIRECTORY_SIZE_CACHE_VERSION)
+        return;
+
+    in >> m_directories;
+    if (in.status() != QDataStream::Ok)
+        m_directories.clear();
+}
+
+/*!
+ * \brief DirectorySizeCache::find 查找目录的缓存，dir中传入目录当前的状态，缓存有效时返回缓存的统计结果
+ */
+bool DirectorySizeCache::find(const QByteArray &path, CachedDirectory &dir)
+{
+    QReadLocker lk(&m_lock);
+    auto it = m_directories.constFind(path);
+    if (it == m_directories.constEnd() || !it->isSameStamp(dir))
+        return false;
+
+    dir = it.value();
+    return true;
+}
+
+void DirectorySizeCache::insert(const QByteArray &path, const CachedDirectory &dir)
+{
+    QWriteLocker lk(&m_lock);
+    if (m_directories.size() >= DIRECTORY_SIZE_CACHE_MAX_COUNT && !m_directories.contains(path))
+        return;
+
+    m_directories.insert(path, dir);
+    m_isDirty = true;
+}
+
+void DirectorySizeCache::remove(const QByteArray &path)
+{
+    QWriteLocker lk(&m_lock);
+    if (m_directories.remove(path) > 0)
+        m_isDirty = true;
+}
+
+void DirectorySizeCache::save()
+{
+    QMutexLocker saveLocker(&m_saveMutex);
+    QByteArray data;
+    {
+        QReadLocker lk(&m_lock);
+        if (!m_isDirty)
+            return;
+
+        QDataStream out(&data, QIODevice::WriteOnly);
+        out << int(DIRECTORY_SIZE_CACHE_VERSION) << m_directories;
+        m_isDirty = false;
+    }
+
+    QSaveFile file(cacheFilePath());
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit())
+        qWarning() << "Failed on save the directory size cache:" << file.fileName() << file.errorString();
+}
+
+QString DirectorySizeCache::cacheFilePath()
+{
+    return DFMStandardPaths::location(DFMStandardPaths::CachePath) + "/directory-size.cache";
+}
+
 class DFileStatisticsJobPrivate
 {
 public:
@@ -30,6 +192,15 @@ public:
 
     void processFile(const DUrl &url, QQueue<DUrl> &directoryQueue);
 
+    // 本地目录不创建文件信息，直接读取目录项，多个线程同时统计
+    bool canCountLocalDirectories(const QQueue<DUrl> &directoryQueue) const;
+    void countLocalDirectories(QQueue<DUrl> &directoryQueue);
+    void countLocalWorker();
+    void finishLocalDirectory(int item, const QList<QByteArray> &subDirectories);
+    void countLocalDirectory(const QByteArray &path, QList<QByteArray> &subDirectories);
+    void addCachedDirectory(const QByteArray &path, const CachedDirectory &dir, QList<QByteArray> &subDirectories);
+    static QSet<QByteArray> skippedMountPoints(DFileStatisticsJob::FileHints hints);
+
     DFileStatisticsJob *q_ptr;
     QTimer *notifyDataTimer;
 
@@ -44,6 +215,16 @@ public:
     QAtomicInteger<qint64> totalProgressSize = 0;
     QAtomicInt filesCount = 0;
     QAtomicInt directoryCount = 0;
+
+    //本地统计时待读取的目录及其所属的顶层目录的序号，所有线程共享
+    QMutex localQueueMutex;
+    QWaitCondition localQueueCondition;
+    QQueue<QPair<int, QByteArray>> localDirectoryQueue;
+    //每个顶层目录中还没有读完的目录数，为0时这个目录统计完成
+    QVector<int> localPendingDirectories;
+    int busyLocalWorkers = 0;
+    //不进入的proc和avfsd挂载点
+    QSet<QByteArray> localSkippedMounts;
 };
 
 DFileStatisticsJobPrivate::DFileStatisticsJobPrivate(DFileStatisticsJob *qq)
@@ -224,6 +405,275 @@ void DFileStatisticsJobPrivate::processFile(const DUrl &url, QQueue<DUrl> &direc
 
 }
 
+bool DFileStatisticsJobPrivate::canCountLocalDirectories(const QQueue<DUrl> &directoryQueue) const
+{
+    //跟随链接时需要解析链接的目标，有人关心每个文件时需要逐个发送信号，这两种情况使用以前的流程
+    if (fileHints.testFlag(DFileStatisticsJob::FollowSymlink)
+            || q_ptr->isSignalConnected(QMetaMethod::fromSignal(&DFileStatisticsJob::fileFound))
+            || q_ptr->isSignalConnected(QMetaMethod::fromSignal(&DFileStatisticsJob::directoryFound))) {
+        return false;
+    }
+
+    for (const DUrl &url : directoryQueue) {
+        if (url.isLocalFile())
+            return true;
+    }
+
+    return false;
+}
+
+/*!
+ * \brief DFileStatisticsJobPrivate::countLocalDirectories 统计本地目录，按照cpu核数启动统计线程，
+ * 每个线程从共享的队列中取目录，读到的子目录再放回队列，队列为空且没有线程在读取目录时结束。
+ * 选中的每个顶层目录同时开始统计，一个目录统计完成时立即通知当前的统计结果，不必等所有目录都统计完
+ * \param directoryQueue 待统计的目录，统计完成后只剩下非本地的目录
+ */
+void DFileStatisticsJobPrivate::countLocalDirectories(QQueue<DUrl> &directoryQueue)
+{
+    localSkippedMounts = skippedMountPoints(fileHints);
+    localDirectoryQueue.clear();
+    localPendingDirectories.clear();
+    busyLocalWorkers = 0;
+
+    QQueue<DUrl> otherDirectories;
+    for (const DUrl &url : directoryQueue) {
+        if (!url.isLocalFile()) {
+            otherDirectories << url;
+            continue;
+        }
+
+        localDirectoryQueue.enqueue(qMakePair(localPendingDirectories.size(), QFile::encodeName(url.toLocalFile())));
+        localPendingDirectories << 1;
+    }
+    directoryQueue = otherDirectories;
+
+    // 当前线程也参与统计，共用的线程都在忙时由当前线程完成所有统计
+    const int workerCount = qBound(1, QThread::idealThreadCount(), 8);
+    QThreadPool *pool = localStatisticsThreadPool;
+    pool->setMaxThreadCount(workerCount);
+    QList<QFuture<void>> workers;
+    for (int i = 1; i < workerCount; ++i)
+        workers << QtConcurrent::run(pool, [this] { countLocalWorker(); });
+
+    countLocalWorker();
+
+    for (QFuture<void> &worker : workers)
+        worker.waitForFinished();
+
+    directorySizeCache->save();
+}
+
+void DFileStatisticsJobPrivate::countLocalWorker()
+{
+    QList<QByteArray> subDirectories;
+
+    forever {
+        QPair<int, QByteArray> directory;
+        {
+            QMutexLocker lk(&localQueueMutex);
+            while (localDirectoryQueue.isEmpty() && busyLocalWorkers > 0)
+                localQueueCondition.wait(&localQueueMutex);
+
+            if (localDirectoryQueue.isEmpty())
+                return;
+
+            directory = localDirectoryQueue.dequeue();
+            ++busyLocalWorkers;
+        }
+
+        if (stateCheck())
+            countLocalDirectory(directory.second, subDirectories);
+
+        finishLocalDirectory(directory.first, subDirectories);
+        subDirectories.clear();
+    }
+}
+
+/*!
+ * \brief DFileStatisticsJobPrivate::finishLocalDirectory 一个目录读取完成，把子目录放回队列
+ * \param item 目录所属的顶层目录的序号，这个顶层目录中的目录都读完时通知当前的统计结果
+ */
+void DFileStatisticsJobPrivate::finishLocalDirectory(int item, const QList<QByteArray> &subDirectories)
+{
+    QMutexLocker lk(&localQueueMutex);
+    bool itemFinished = false;
+
+    //停止后丢弃剩余的目录，其它线程也会退出
+    if (state == DFileStatisticsJob::StoppedState) {
+        localDirectoryQueue.clear();
+    } else {
+        for (const QByteArray &path : subDirectories)
+            localDirectoryQueue.enqueue(qMakePair(item, path));
+
+        int &pending = localPendingDirectories[item];
+        pending += subDirectories.size() - 1;
+        itemFinished = pending == 0;
+    }
+    --busyLocalWorkers;
+    localQueueCondition.wakeAll();
+    lk.unlock();
+
+    if (itemFinished)
+        Q_EMIT q_ptr->dataNotify(totalSize, filesCount, directoryCount);
+}
+
+/*!
+ * \brief DFileStatisticsJobPrivate::countLocalDirectory 读取一个目录中的所有目录项，readdir给出类型的目录项不用stat，
+ * 只有普通文件需要获取大小，统计的结果在目录读完后一次性累加，减少线程之间的竞争
+ * \param path 目录的本地路径
+ * \param subDirectories 返回需要继续统计的子目录
+ */
+void DFileStatisticsJobPrivate::countLocalDirectory(const QByteArray &path, QList<QByteArray> &subDirectories)
+{
+    // 目录没有变化时直接使用缓存的结果，不读取目录项
+    CachedDirectory cached;
+    struct stat dirStat;
+    const bool hasStamp = ::lstat(path.constData(), &dirStat) == 0;
+    if (hasStamp) {
+        cached.setStamp(dirStat);
+        if (directorySizeCache->find(path, cached)) {
+            addCachedDirectory(path, cached, subDirectories);
+            return;
+        }
+    }
+
+    const int dirFd = ::open(path.constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dirFd < 0) {
+        qWarning() << "Failed on open directory:" << path << strerror(errno);
+        return;
+    }
+
+    DIR *dir = fdopendir(dirFd);
+    if (!dir) {
+        ::close(dirFd);
+        return;
+    }
+
+    const qint64 pageSize = FileUtils::getMemoryPageSize();
+    qint64 &size = cached.size;
+    qint64 &progressSize = cached.progressSize;
+    int &files = cached.files;
+    int &directories = cached.directories;
+
+    while (struct dirent *entry = readdir(dir)) {
+        const char *name = entry->d_name;
+        if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0')))
+            continue;
+
+        unsigned char type = entry->d_type;
+        qint64 fileSize = 0;
+#ifdef STATX_TYPE
+        struct statx stx;
+        //只需要类型和大小，网络文件系统上也不需要同步属性
+        if (type == DT_UNKNOWN || type == DT_REG) {
+            if (statx(dirFd, name, AT_SYMLINK_NOFOLLOW | AT_STATX_DONT_SYNC, STATX_TYPE | STATX_SIZE, &stx) != 0)
+                continue;
+            type = IFTODT(stx.stx_mode);
+            fileSize = static_cast<qint64>(stx.stx_size);
+        }
+#else
+        struct stat st;
+        if (type == DT_UNKNOWN || type == DT_REG) {
+            if (fstatat(dirFd, name, &st, AT_SYMLINK_NOFOLLOW) != 0)
+                continue;
+            type = IFTODT(st.st_mode);
+            fileSize = st.st_size;
+        }
+#endif
+        switch (type) {
+        case DT_DIR: {
+            progressSize += pageSize;
+            ++directories;
+            cached.subDirectories << QByteArray(name);
+            break;
+        }
+        case DT_REG:
+            // ###(zccrs): skip the file,os file
+            if ((path == "/proc" && qstrcmp(name, "kcore") == 0) || (path == "/dev" && qstrcmp(name, "core") == 0)) {
+                ++files;
+                break;
+            }
+            size += fileSize;
+            progressSize += fileSize <= 0 ? pageSize : fileSize;
+            ++files;
+            break;
+        case DT_LNK: {
+            // 链接到文件时和以前一样计算链接目标的大小，进度按照一页计算
+            struct stat target;
+            if (fstatat(dirFd, name, &target, 0) == 0 && S_ISREG(target.st_mode)) {
+                QByteArray targetPath(PATH_MAX, '\0');
+                const ssize_t len = readlinkat(dirFd, name, targetPath.data(), PATH_MAX);
+                targetPath.resize(len > 0 ? int(len) : 0);
+                if (targetPath != "/proc/kcore" && targetPath != "/dev/core")
+                    size += target.st_size;
+            }
+            progressSize += pageSize;
+            ++files;
+            break;
+        }
+        default:
+            //设备文件、管道等特殊文件只计数
+            ++files;
+            break;
+        }
+    }
+
+    closedir(dir);
+
+    //使用读取目录之前的状态，读取过程中目录发生变化时下次会重新读取。
+    //文件系统的时间精度有限，刚修改过的目录再次修改时时间可能不变，这种目录不缓存
+    if (hasStamp && QDateTime::currentMSecsSinceEpoch() - cached.changeTime / 1000000 > DIRECTORY_SIZE_CACHE_MIN_AGE)
+        directorySizeCache->insert(path, cached);
+    addCachedDirectory(path, cached, subDirectories);
+}
+
+void DFileStatisticsJobPrivate::addCachedDirectory(const QByteArray &path, const CachedDirectory &dir, QList<QByteArray> &subDirectories)
+{
+    if (dir.size > 0) {
+        totalSize += dir.size;
+        Q_EMIT q_ptr->sizeChanged(totalSize);
+    }
+    totalProgressSize += dir.progressSize;
+    filesCount += dir.files;
+    directoryCount += dir.directories;
+
+    for (const QByteArray &name : dir.subDirectories) {
+        const QByteArray subPath = path.endsWith('/') ? path + name : path + '/' + name;
+        if (!localSkippedMounts.contains(subPath))
+            subDirectories << subPath;
+    }
+}
+
+/*!
+ * \brief DFileStatisticsJobPrivate::skippedMountPoints 读取挂载信息，找出默认不统计的proc和avfsd挂载点
+ * \param hints 统计的选项
+ * \return 挂载点的本地路径
+ */
+QSet<QByteArray> DFileStatisticsJobPrivate::skippedMountPoints(DFileStatisticsJob::FileHints hints)
+{
+    QSet<QByteArray> mountPoints;
+    QFile mounts("/proc/self/mounts");
+    if (!mounts.open(QIODevice::ReadOnly))
+        return mountPoints;
+
+    for (const QByteArray &line : mounts.readAll().split('\n')) {
+        const QList<QByteArray> fields = line.split(' ');
+        if (fields.size() < 2)
+            continue;
+
+        const QByteArray &device = fields.at(0);
+        if ((device == "proc" && !hints.testFlag(DFileStatisticsJob::DontSkipPROCStorage))
+                || (device == "avfsd" && !hints.testFlag(DFileStatisticsJob::DontSkipAVFSDStorage))) {
+            // 挂载点中的空白字符被转义为八进制
+            QByteArray mountPoint = fields.at(1);
+            mountPoint.replace("\\040", " ").replace("\\011", "\t").replace("\\012", "\n").replace("\\134", "\\");
+            mountPoints << mountPoint;
+        }
+    }
+
+    return mountPoints;
+}
+
 DFileStatisticsJob::DFileStatisticsJob(QObject *parent)
     : QThread(parent)
     , d_ptr(new DFileStatisticsJobPrivate(this))
@@ -287,6 +737,21 @@ int DFileStatisticsJob::directorysCount(bool includeSelf) const
     }
 }
 
+/*!
+ * \brief DFileStatisticsJob::invalidateCache 文件发生变化时清除文件所在目录的统计缓存，
+ * 修改文件的内容不会改变目录的修改时间，需要通过文件变化的通知清除
+ * \param url 发生变化的文件或目录
+ */
+void DFileStatisticsJob::invalidateCache(const DUrl &url)
+{
+    if (!url.isLocalFile())
+        return;
+
+    const QString &path = url.toLocalFile();
+    directorySizeCache->remove(QFile::encodeName(path));
+    directorySizeCache->remove(QFile::encodeName(QFileInfo(path).absolutePath()));
+}
+
 void DFileStatisticsJob::start(const DUrlList &sourceUrls)
 {
     if (isRunning()) {
@@ -429,6 +894,12 @@ void DFileStatisticsJob::run()
         return;
     }
 
+    // 选中的文件已统计完，先通知一次，目录的统计结果随后陆续更新
+    Q_EMIT dataNotify(d->totalSize, d->filesCount, d->directoryCount);
+
+    if (d->canCountLocalDirectories(directory_queue))
+        d->countLocalDirectories(directory_queue);
+
     while (!directory_queue.isEmpty()) {
         const DUrl &directory_url = directory_queue.dequeue();
         const DDirIteratorPointer &iterator = DFileService::instance()->createDirIterator(nullptr, directory_url, QStringList(),
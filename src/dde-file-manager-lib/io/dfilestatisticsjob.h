@@ -55,6 +55,9 @@ public:
     int filesCount() const;
     int directorysCount(bool includeSelf = true) const;
 
+    // 本地目录的统计结果会被缓存，文件变化时清除对应目录的缓存
+    static void invalidateCache(const DUrl &url);
+
 public Q_SLOTS:
     void start(const DUrlList &sourceUrls);
     void stop();
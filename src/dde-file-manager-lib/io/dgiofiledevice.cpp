@@ -8,8 +8,148 @@
 #include "private/dfiledevice_p.h"
 #include "dabstractfilewatcher.h"
 
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+
+//预读时每次请求的大小和环形缓冲区中的块数
+#define READ_AHEAD_BLOCK_LEN 1024 * 1024
+#define READ_AHEAD_BLOCK_COUNT 4
+
 DFM_BEGIN_NAMESPACE
 
+/*!
+ * \brief DGIOReadAhead 在后台线程中顺序读取远程文件，读取的数据放在预先分配的环形缓冲区中
+ *
+ * 同步读取时每一块数据都要等待一次网络往返，期间不能写入目标文件。预读线程在调用者处理当前数据时
+ * 就发出下一个请求，缓冲区满时才等待。GIO 的流同一时间只允许一个未完成的操作，所以预读期间
+ * 只有此线程使用输入流
+ */
+class DGIOReadAhead : public QThread
+{
+public:
+    DGIOReadAhead(GInputStream *stream, GCancellable *cancellable, qint64 pos)
+        : m_stream(stream)
+        , m_cancellable(cancellable)
+        , m_pos(pos)
+        , m_buffer(new char[static_cast<size_t>(READ_AHEAD_BLOCK_LEN) * READ_AHEAD_BLOCK_COUNT])
+    {
+        g_object_ref(m_stream);
+        start();
+    }
+
+    ~DGIOReadAhead() override
+    {
+        {
+            QMutexLocker locker(&m_mutex);
+            m_stop = true;
+            m_condition.wakeAll();
+        }
+        //正在进行的请求完成后线程才会退出，流才能被其它操作使用
+        wait();
+        g_object_unref(m_stream);
+        delete[] m_buffer;
+    }
+
+    qint64 read(char *data, qint64 maxlen, QString *errorString)
+    {
+        QMutexLocker locker(&m_mutex);
+
+        while (m_filled == 0 && !m_finished)
+            m_condition.wait(&m_mutex);
+
+        if (m_filled == 0) {
+            //缓冲区中的数据读完后才报告错误
+            if (!m_errorString.isEmpty()) {
+                *errorString = m_errorString;
+                return -1;
+            }
+
+            return 0;
+        }
+
+        const qint64 size = qMin(maxlen, m_lengths[m_readIndex] - m_readOffset);
+
+        memcpy(data, m_buffer + static_cast<qint64>(m_readIndex) * READ_AHEAD_BLOCK_LEN + m_readOffset, static_cast<size_t>(size));
+        m_readOffset += size;
+        m_pos += size;
+
+        if (m_readOffset == m_lengths[m_readIndex]) {
+            m_readIndex = (m_readIndex + 1) % READ_AHEAD_BLOCK_COUNT;
+            m_readOffset = 0;
+            --m_filled;
+            m_condition.wakeAll();
+        }
+
+        return size;
+    }
+
+    //调用者读到的位置，流的位置已经超前
+    qint64 pos() const
+    {
+        QMutexLocker locker(&m_mutex);
+
+        return m_pos;
+    }
+
+protected:
+    void run() override
+    {
+        forever {
+            int index = 0;
+
+            {
+                QMutexLocker locker(&m_mutex);
+
+                while (m_filled == READ_AHEAD_BLOCK_COUNT && !m_stop)
+                    m_condition.wait(&m_mutex);
+
+                if (m_stop)
+                    break;
+
+                index = m_writeIndex;
+            }
+
+            GError *error = nullptr;
+            const gssize size = g_input_stream_read(m_stream, m_buffer + static_cast<qint64>(index) * READ_AHEAD_BLOCK_LEN,
+                                                    READ_AHEAD_BLOCK_LEN, m_cancellable, &error);
+            QMutexLocker locker(&m_mutex);
+
+            if (error || size <= 0) {
+                if (error) {
+                    m_errorString = QString::fromLocal8Bit(error->message);
+                    g_error_free(error);
+                }
+
+                m_finished = true;
+                m_condition.wakeAll();
+                break;
+            }
+
+            m_lengths[index] = size;
+            m_writeIndex = (m_writeIndex + 1) % READ_AHEAD_BLOCK_COUNT;
+            ++m_filled;
+            m_condition.wakeAll();
+        }
+    }
+
+private:
+    GInputStream *m_stream;
+    GCancellable *m_cancellable;
+    qint64 m_pos;
+    char *m_buffer;
+    qint64 m_lengths[READ_AHEAD_BLOCK_COUNT] = {};
+    int m_readIndex = 0;
+    qint64 m_readOffset = 0;
+    int m_writeIndex = 0;
+    int m_filled = 0;
+    bool m_finished = false;
+    bool m_stop = false;
+    QString m_errorString;
+    mutable QMutex m_mutex;
+    QWaitCondition m_condition;
+};
+
 class DGIOFileDevicePrivate : public DFileDevicePrivate
 {
 public:
@@ -24,6 +164,11 @@ public:
     GIOStream *total_stream = nullptr;
     GCancellable *m_writeCancel = nullptr;
     GCancellable *m_readCancel = nullptr;
+    bool readAheadEnabled = false;
+    DGIOReadAhead *readAhead = nullptr;
+
+    // 停止预读，之后才能在当前线程使用输入流
+    void stopReadAhead();
 };
 
 DGIOFileDevicePrivate::DGIOFileDevicePrivate(DGIOFileDevice *qq)
@@ -46,6 +191,21 @@ DGIOFileDevicePrivate::~DGIOFileDevicePrivate()
     }
 }
 
+void DGIOFileDevicePrivate::stopReadAhead()
+{
+    if (!readAhead)
+        return;
+
+    const qint64 pos = readAhead->pos();
+
+    delete readAhead;
+    readAhead = nullptr;
+
+    //流已经读到了预读的位置，回到调用者读到的位置
+    if (input_stream && g_seekable_can_seek(G_SEEKABLE(input_stream)))
+        g_seekable_seek(G_SEEKABLE(input_stream), pos, G_SEEK_SET, nullptr, nullptr);
+}
+
 DGIOFileDevice::DGIOFileDevice(const DUrl &url, QObject *parent)
     : DFileDevice(*new DGIOFileDevicePrivate(this), parent)
 {
@@ -183,6 +343,9 @@ void DGIOFileDevice::close()
 
     Q_D(DGIOFileDevice);
 
+    delete d->readAhead;
+    d->readAhead = nullptr;
+
     if (d->total_stream) {
         g_io_stream_close(d->total_stream, nullptr, nullptr);
         g_object_unref(d->total_stream);
@@ -281,6 +444,9 @@ qint64 DGIOFileDevice::pos() const
 {
     Q_D(const DGIOFileDevice);
 
+    if (d->readAhead)
+        return d->readAhead->pos();
+
     if (d->input_stream)
         return g_seekable_tell(G_SEEKABLE(d->input_stream));
 
@@ -293,6 +459,9 @@ bool DGIOFileDevice::seek(qint64 pos)
 
     GError *error = nullptr;
 
+    delete d->readAhead;
+    d->readAhead = nullptr;
+
     if (d->input_stream) {
         if (!g_seekable_seek(G_SEEKABLE(d->input_stream), pos, G_SEEK_SET, nullptr, &error)) {
             if (error) {
@@ -364,6 +533,13 @@ void DGIOFileDevice::closeWriteReadFailed(const bool bwrite)
 
 
     Q_D(DGIOFileDevice);
+    //断网时预读线程可能一直阻塞在读取中，先取消再等待它退出
+    if (d->readAhead) {
+        g_cancellable_cancel(d->m_readCancel);
+        delete d->readAhead;
+        d->readAhead = nullptr;
+        g_cancellable_reset(d->m_readCancel);
+    }
     if (d->total_stream) {
         g_io_stream_close(d->total_stream, nullptr, nullptr);
         g_object_unref(d->total_stream);
@@ -403,10 +579,34 @@ void DGIOFileDevice::cancelAllOperate()
     qDebug() << "stop all cancels" << this << QThread::currentThreadId();
 }
 
+void DGIOFileDevice::setReadAhead(bool enable)
+{
+    Q_D(DGIOFileDevice);
+
+    d->readAheadEnabled = enable;
+
+    if (!enable)
+        d->stopReadAhead();
+}
+
 qint64 DGIOFileDevice::readData(char *data, qint64 maxlen)
 {
     Q_D(DGIOFileDevice);
 
+    //读写打开的流不预读，写入需要使用同一个流
+    if (d->readAheadEnabled && !d->total_stream && !d->output_stream) {
+        if (!d->readAhead)
+            d->readAhead = new DGIOReadAhead(d->input_stream, d->m_readCancel, g_seekable_tell(G_SEEKABLE(d->input_stream)));
+
+        QString errorString;
+        const qint64 size = d->readAhead->read(data, maxlen, &errorString);
+
+        if (size < 0)
+            setErrorString(errorString);
+
+        return size;
+    }
+
     GError *error = nullptr;
 
     qint64 size = g_input_stream_read(d->input_stream, data, static_cast<gsize>(maxlen), d->m_readCancel, &error);
@@ -34,6 +34,9 @@ public:
     void closeWriteReadFailed(const bool bwrite) override;
     void cancelAllOperate() override;
 
+    // 顺序读取远程文件时在后台线程中预读后面的数据，打开前设置
+    void setReadAhead(bool enable);
+
 protected:
     qint64 readData(char *data, qint64 maxlen) override;
     qint64 writeData(const char *data, qint64 len) override;
@@ -0,0 +1,225 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "djobprogresschannel.h"
+
+#include <QDebug>
+
+#include <atomic>
+#include <cstring>
+
+#include <sys/mman.h>
+#include <sys/eventfd.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define PROGRESS_BLOCK_MAGIC 0x4446504b // "DFPK"
+#define PROGRESS_BLOCK_VERSION 1
+// 当前文件路径的最大字节数，更长的路径被截断
+#define PROGRESS_FILE_PATH_MAX 4096
+// 读取文件名时与写入冲突的最大重试次数，超过后返回上一次的文件名
+#define PROGRESS_SEQLOCK_RETRY 64
+
+DFM_BEGIN_NAMESPACE
+
+struct DJobProgressBlock {
+    quint32 magic;
+    quint32 version;
+    std::atomic<qint64> totalBytes;
+    std::atomic<qint64> processedBytes;
+    std::atomic<qint32> totalFiles;
+    std::atomic<qint32> processedFiles;
+    std::atomic<qint32> state;
+    // 奇数表示正在写入文件名
+    std::atomic<quint32> fileSequence;
+    std::atomic<quint32> fileLength;
+    char filePath[PROGRESS_FILE_PATH_MAX];
+};
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2, "progress counters must be lock free to be shared between processes");
+
+DJobProgressChannel::DJobProgressChannel(int memoryFd, int eventFd, DJobProgressBlock *block, bool writable)
+    : m_memoryFd(memoryFd)
+    , m_eventFd(eventFd)
+    , m_block(block)
+    , m_writable(writable)
+{
+}
+
+DJobProgressChannel::~DJobProgressChannel()
+{
+    munmap(m_block, sizeof(DJobProgressBlock));
+    ::close(m_memoryFd);
+    ::close(m_eventFd);
+}
+
+QSharedPointer<DJobProgressChannel> DJobProgressChannel::create()
+{
+    int memoryFd = memfd_create("dfm-job-progress", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (memoryFd < 0) {
+        qWarning() << "memfd_create failed:" << strerror(errno);
+        return nullptr;
+    }
+
+    // 封住大小，读取方映射后不会因为文件被截断而访问越界
+    if (ftruncate(memoryFd, sizeof(DJobProgressBlock)) != 0
+            || fcntl(memoryFd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL) != 0) {
+        qWarning() << "prepare progress block failed:" << strerror(errno);
+        ::close(memoryFd);
+        return nullptr;
+    }
+
+    void *address = mmap(nullptr, sizeof(DJobProgressBlock), PROT_READ | PROT_WRITE, MAP_SHARED, memoryFd, 0);
+    if (address == MAP_FAILED) {
+        qWarning() << "map progress block failed:" << strerror(errno);
+        ::close(memoryFd);
+        return nullptr;
+    }
+
+    int eventFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (eventFd < 0) {
+        qWarning() << "eventfd failed:" << strerror(errno);
+        munmap(address, sizeof(DJobProgressBlock));
+        ::close(memoryFd);
+        return nullptr;
+    }
+
+    // memfd的内容初始为0，原子量全为0即是初始值
+    DJobProgressBlock *block = static_cast<DJobProgressBlock *>(address);
+    block->magic = PROGRESS_BLOCK_MAGIC;
+    block->version = PROGRESS_BLOCK_VERSION;
+
+    return QSharedPointer<DJobProgressChannel>(new DJobProgressChannel(memoryFd, eventFd, block, true));
+}
+
+QSharedPointer<DJobProgressChannel> DJobProgressChannel::open(int memoryFd, int eventFd)
+{
+    struct stat st;
+    if (memoryFd < 0 || eventFd < 0 || fstat(memoryFd, &st) != 0
+            || st.st_size < static_cast<off_t>(sizeof(DJobProgressBlock))) {
+        qWarning() << "invalid progress channel" << memoryFd << eventFd;
+        return nullptr;
+    }
+
+    void *address = mmap(nullptr, sizeof(DJobProgressBlock), PROT_READ, MAP_SHARED, memoryFd, 0);
+    if (address == MAP_FAILED) {
+        qWarning() << "map progress block failed:" << strerror(errno);
+        return nullptr;
+    }
+
+    DJobProgressBlock *block = static_cast<DJobProgressBlock *>(address);
+    if (block->magic != PROGRESS_BLOCK_MAGIC || block->version != PROGRESS_BLOCK_VERSION) {
+        qWarning() << "unknown progress block" << block->magic << block->version;
+        munmap(address, sizeof(DJobProgressBlock));
+        return nullptr;
+    }
+
+    const int memoryFdCopy = fcntl(memoryFd, F_DUPFD_CLOEXEC, 0);
+    const int eventFdCopy = fcntl(eventFd, F_DUPFD_CLOEXEC, 0);
+
+    return QSharedPointer<DJobProgressChannel>(new DJobProgressChannel(memoryFdCopy, eventFdCopy, block, false));
+}
+
+int DJobProgressChannel::memoryFd() const
+{
+    return m_memoryFd;
+}
+
+int DJobProgressChannel::eventFd() const
+{
+    return m_eventFd;
+}
+
+void DJobProgressChannel::setTotal(qint64 bytes, int files)
+{
+    Q_ASSERT(m_writable);
+
+    m_block->totalBytes.store(bytes, std::memory_order_relaxed);
+    m_block->totalFiles.store(files, std::memory_order_relaxed);
+}
+
+void DJobProgressChannel::setProcessedBytes(qint64 bytes)
+{
+    Q_ASSERT(m_writable);
+
+    m_block->processedBytes.store(bytes, std::memory_order_relaxed);
+}
+
+void DJobProgressChannel::setProcessedFiles(int files)
+{
+    Q_ASSERT(m_writable);
+
+    m_block->processedFiles.store(files, std::memory_order_relaxed);
+}
+
+void DJobProgressChannel::setCurrentFile(const QString &filePath)
+{
+    Q_ASSERT(m_writable);
+
+    const QByteArray &data = filePath.toUtf8();
+    const quint32 length = static_cast<quint32>(qMin(data.size(), PROGRESS_FILE_PATH_MAX));
+    const quint32 sequence = m_block->fileSequence.load(std::memory_order_relaxed);
+
+    m_block->fileSequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    memcpy(m_block->filePath, data.constData(), length);
+    m_block->fileLength.store(length, std::memory_order_relaxed);
+
+    m_block->fileSequence.store(sequence + 2, std::memory_order_release);
+}
+
+void DJobProgressChannel::setState(int state)
+{
+    Q_ASSERT(m_writable);
+
+    m_block->state.store(state, std::memory_order_release);
+
+    const quint64 one = 1;
+    if (write(m_eventFd, &one, sizeof(one)) != sizeof(one) && errno != EAGAIN)
+        qWarning() << "notify progress state failed:" << strerror(errno);
+}
+
+DJobProgressChannel::Snapshot DJobProgressChannel::snapshot() const
+{
+    Snapshot snapshot;
+
+    snapshot.totalBytes = m_block->totalBytes.load(std::memory_order_relaxed);
+    snapshot.processedBytes = m_block->processedBytes.load(std::memory_order_relaxed);
+    snapshot.totalFiles = m_block->totalFiles.load(std::memory_order_relaxed);
+    snapshot.processedFiles = m_block->processedFiles.load(std::memory_order_relaxed);
+    snapshot.state = m_block->state.load(std::memory_order_acquire);
+
+    char filePath[PROGRESS_FILE_PATH_MAX];
+
+    for (int i = 0; i < PROGRESS_SEQLOCK_RETRY; ++i) {
+        const quint32 begin = m_block->fileSequence.load(std::memory_order_acquire);
+        if (begin & 1)
+            continue;
+
+        const quint32 length = qMin<quint32>(m_block->fileLength.load(std::memory_order_relaxed), PROGRESS_FILE_PATH_MAX);
+        memcpy(filePath, m_block->filePath, length);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_block->fileSequence.load(std::memory_order_relaxed) == begin) {
+            snapshot.currentFile = QString::fromUtf8(filePath, static_cast<int>(length));
+            break;
+        }
+    }
+
+    return snapshot;
+}
+
+quint64 DJobProgressChannel::takeStateEvents() const
+{
+    quint64 count = 0;
+
+    if (read(m_eventFd, &count, sizeof(count)) != sizeof(count))
+        return 0;
+
+    return count;
+}
+
+DFM_END_NAMESPACE
@@ -0,0 +1,67 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DJOBPROGRESSCHANNEL_H
+#define DJOBPROGRESSCHANNEL_H
+
+#include <dfmglobal.h>
+
+#include <QSharedPointer>
+#include <QString>
+
+DFM_BEGIN_NAMESPACE
+
+struct DJobProgressBlock;
+
+/*!
+ * \brief DJobProgressChannel 守护进程任务与界面之间的共享内存进度
+ *
+ * 任务进程用 create() 创建一块 memfd 内存和一个 eventfd，通过 DBus 把两个文件描述符交给界面；
+ * 界面用 open() 映射同一块内存，按自己的刷新频率读取 snapshot()。字节数和文件数是原子计数，
+ * 当前文件名用顺序锁保护，只有状态变化时才写 eventfd。无论处理多少文件，DBus 上都只有建立通道的一次调用。
+ */
+class DJobProgressChannel
+{
+public:
+    struct Snapshot {
+        qint64 totalBytes = 0;
+        qint64 processedBytes = 0;
+        int totalFiles = 0;
+        int processedFiles = 0;
+        int state = 0;
+        QString currentFile;
+    };
+
+    ~DJobProgressChannel();
+
+    //! 任务一侧，创建可写的通道
+    static QSharedPointer<DJobProgressChannel> create();
+    //! 界面一侧，只读地映射任务创建的通道，传入的文件描述符会被复制
+    static QSharedPointer<DJobProgressChannel> open(int memoryFd, int eventFd);
+
+    int memoryFd() const;
+    int eventFd() const;
+
+    void setTotal(qint64 bytes, int files);
+    void setProcessedBytes(qint64 bytes);
+    void setProcessedFiles(int files);
+    void setCurrentFile(const QString &filePath);
+    void setState(int state);
+
+    Snapshot snapshot() const;
+    //! 读出未处理的状态变化次数，没有变化时返回 0，不阻塞
+    quint64 takeStateEvents() const;
+
+private:
+    DJobProgressChannel(int memoryFd, int eventFd, DJobProgressBlock *block, bool writable);
+
+    int m_memoryFd = -1;
+    int m_eventFd = -1;
+    DJobProgressBlock *m_block = nullptr;
+    bool m_writable = false;
+};
+
+DFM_END_NAMESPACE
+
+#endif // DJOBPROGRESSCHANNEL_H
@@ -17,6 +17,8 @@
 
 #include <unistd.h>
 #include <utime.h>
+#include <fcntl.h>
+#include <sys/stat.h>
 #include <cstdio>
 
 DFM_BEGIN_NAMESPACE
@@ -184,4 +186,158 @@ bool DLocalFileHandler::setFileTime(const DUrl &url, const QDateTime &accessDate
     return false;
 }
 
+QStringList DLocalFileHandler::mkdirBatch(const DUrl &dirUrl, const QStringList &names)
+{
+    QStringList errors;
+    int dirFd = openDirectory(dirUrl, names.size(), &errors);
+
+    if (dirFd < 0)
+        return errors;
+
+    for (const QString &name : names)
+        errors << (::mkdirat(dirFd, QFile::encodeName(name).constData(), 0777) == 0 ? QString() : QString::fromLocal8Bit(strerror(errno)));
+
+    ::close(dirFd);
+
+    return errors;
+}
+
+QStringList DLocalFileHandler::linkBatch(const DUrl &dirUrl, const QList<QPair<QString, QString>> &targetAndNames)
+{
+    QStringList errors;
+    int dirFd = openDirectory(dirUrl, targetAndNames.size(), &errors);
+
+    if (dirFd < 0)
+        return errors;
+
+    for (const auto &item : targetAndNames) {
+        const bool ok = ::symlinkat(QFile::encodeName(item.first).constData(), dirFd, QFile::encodeName(item.second).constData()) == 0;
+        errors << (ok ? QString() : QString::fromLocal8Bit(strerror(errno)));
+    }
+
+    ::close(dirFd);
+
+    return errors;
+}
+
+/*!
+ * \brief DLocalFileHandler::removeBatch 批量删除文件或空目录
+ */
+QStringList DLocalFileHandler::removeBatch(const DUrl &dirUrl, const QStringList &names)
+{
+    QStringList errors;
+    int dirFd = openDirectory(dirUrl, names.size(), &errors);
+
+    if (dirFd < 0)
+        return errors;
+
+    const bool isMtpStaging = dirUrl.path().contains(MTP_STAGING) && dirUrl.path().startsWith(MOBILE_ROOT_PATH);
+
+    for (const QString &name : names) {
+        const QByteArray &fileName = QFile::encodeName(name);
+
+        if (isMtpStaging)
+            fileSignalManager->requestCloseMediaInfo(dirUrl.path() + '/' + name);
+
+        // 与 remove 一致，目录需要使用 AT_REMOVEDIR 删除
+        int ret = ::unlinkat(dirFd, fileName.constData(), 0);
+
+        if (ret != 0 && errno == EISDIR)
+            ret = ::unlinkat(dirFd, fileName.constData(), AT_REMOVEDIR);
+
+        errors << (ret == 0 ? QString() : QString::fromLocal8Bit(strerror(errno)));
+    }
+
+    ::close(dirFd);
+
+    return errors;
+}
+
+QStringList DLocalFileHandler::renameBatch(const DUrl &dirUrl, const QList<QPair<QString, QString>> &names)
+{
+    QStringList errors;
+    int dirFd = openDirectory(dirUrl, names.size(), &errors);
+
+    if (dirFd < 0)
+        return errors;
+
+    for (const auto &item : names) {
+        const bool ok = ::renameat(dirFd, QFile::encodeName(item.first).constData(), dirFd, QFile::encodeName(item.second).constData()) == 0;
+        errors << (ok ? QString() : QString::fromLocal8Bit(strerror(errno)));
+    }
+
+    ::close(dirFd);
+
+    return errors;
+}
+
+QStringList DLocalFileHandler::setPermissionsBatch(const DUrl &dirUrl, const QList<QPair<QString, QFileDevice::Permissions>> &permissions)
+{
+    QStringList errors;
+    int dirFd = openDirectory(dirUrl, permissions.size(), &errors);
+
+    if (dirFd < 0)
+        return errors;
+
+    for (const auto &item : permissions) {
+        const bool ok = ::fchmodat(dirFd, QFile::encodeName(item.first).constData(), toUnixMode(item.second), 0) == 0;
+        errors << (ok ? QString() : QString::fromLocal8Bit(strerror(errno)));
+    }
+
+    ::close(dirFd);
+
+    return errors;
+}
+
+uint DLocalFileHandler::toUnixMode(QFileDevice::Permissions permissions)
+{
+    uint mode = 0;
+
+    if (permissions & (QFileDevice::ReadOwner | QFileDevice::ReadUser))
+        mode |= S_IRUSR;
+    if (permissions & (QFileDevice::WriteOwner | QFileDevice::WriteUser))
+        mode |= S_IWUSR;
+    if (permissions & (QFileDevice::ExeOwner | QFileDevice::ExeUser))
+        mode |= S_IXUSR;
+    if (permissions & QFileDevice::ReadGroup)
+        mode |= S_IRGRP;
+    if (permissions & QFileDevice::WriteGroup)
+        mode |= S_IWGRP;
+    if (permissions & QFileDevice::ExeGroup)
+        mode |= S_IXGRP;
+    if (permissions & QFileDevice::ReadOther)
+        mode |= S_IROTH;
+    if (permissions & QFileDevice::WriteOther)
+        mode |= S_IWOTH;
+    if (permissions & QFileDevice::ExeOther)
+        mode |= S_IXOTH;
+
+    return mode;
+}
+
+/*!
+ * \brief DLocalFileHandler::openDirectory 打开批量操作所在的目录，之后的操作都相对于此描述符，不用每次解析完整的路径
+ * \param count 失败时为每一项填充同样的错误信息
+ */
+int DLocalFileHandler::openDirectory(const DUrl &dirUrl, int count, QStringList *errors)
+{
+    Q_ASSERT(dirUrl.isLocalFile());
+
+    int dirFd = ::open(QFile::encodeName(dirUrl.toLocalFile()).constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+    if (dirFd >= 0)
+        return dirFd;
+
+    const QString &error = QString::fromLocal8Bit(strerror(errno));
+
+    for (int i = 0; i < count; ++i)
+        *errors << error;
+
+    Q_D(DFileHandler);
+
+    d->setErrorString(error);
+
+    return -1;
+}
+
 DFM_END_NAMESPACE
@@ -24,6 +24,17 @@ public:
     bool rename(const DUrl &url, const DUrl &newUrl) override;
     bool setPermissions(const DUrl &url, QFileDevice::Permissions permissions) override;
     bool setFileTime(const DUrl &url, const QDateTime &accessDateTime, const QDateTime &lastModifiedTime) override;
+
+    QStringList mkdirBatch(const DUrl &dirUrl, const QStringList &names) override;
+    QStringList linkBatch(const DUrl &dirUrl, const QList<QPair<QString, QString>> &targetAndNames) override;
+    QStringList removeBatch(const DUrl &dirUrl, const QStringList &names) override;
+    QStringList renameBatch(const DUrl &dirUrl, const QList<QPair<QString, QString>> &names) override;
+    QStringList setPermissionsBatch(const DUrl &dirUrl, const QList<QPair<QString, QFileDevice::Permissions>> &permissions) override;
+
+    static uint toUnixMode(QFileDevice::Permissions permissions);
+
+private:
+    int openDirectory(const DUrl &dirUrl, int count, QStringList *errors);
 };
 
 DFM_END_NAMESPACE
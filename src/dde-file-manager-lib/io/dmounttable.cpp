@@ -0,0 +1,359 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dmounttable.h"
+#include "durl.h"
+
+#include <QCoreApplication>
+#include <QSocketNotifier>
+#include <QFile>
+#include <QVector>
+#include <QDebug>
+
+#include <fcntl.h>
+
+// 保留的已被替换的索引数量，挂载表很少变化，查询耗时远小于连续替换这么多次索引的时间
+#define MOUNT_TABLE_RETIRED_COUNT 8
+#define MOUNT_INFO_PATH "/proc/self/mountinfo"
+
+DFM_BEGIN_NAMESPACE
+
+class DMountTable::Snapshot
+{
+public:
+    struct Node {
+        QString name;
+        QVector<int> children;
+        int entry = -1;
+    };
+
+    Snapshot()
+        : nodes(1) {}
+
+    void insert(const MountEntry &entry);
+    int lookup(const QString &path, int *subPathPos) const;
+
+    // nodes[0] 为根目录
+    QVector<Node> nodes;
+    QVector<MountEntry> entries;
+};
+
+void DMountTable::Snapshot::insert(const DMountTable::MountEntry &entry)
+{
+    const QString &path = entry.mountPoint;
+    int node = 0;
+
+    for (const QStringRef &name : path.splitRef('/', QString::SkipEmptyParts)) {
+        int child = -1;
+
+        for (int index : nodes.at(node).children) {
+            if (nodes.at(index).name == name) {
+                child = index;
+                break;
+            }
+        }
+
+        if (child < 0) {
+            child = nodes.size();
+            nodes.append(Node());
+            nodes[child].name = name.toString();
+            nodes[node].children.append(child);
+        }
+
+        node = child;
+    }
+
+    // 同一位置多次挂载时后挂载的覆盖之前的
+    nodes[node].entry = entries.size();
+    entries.append(entry);
+}
+
+/*!
+ * \brief DMountTable::Snapshot::lookup 查找路径所在的挂载点
+ * \param subPathPos 路径中挂载点之后部分的起始位置
+ * \return 挂载点在 entries 中的位置，路径无法按字面值判断时返回-1
+ */
+int DMountTable::Snapshot::lookup(const QString &path, int *subPathPos) const
+{
+    if (!path.startsWith('/') || path.contains(QLatin1String("/..")))
+        return -1;
+
+    int node = 0;
+    int found = nodes.at(0).entry;
+    int foundPos = 0;
+    int pos = 0;
+    const int size = path.size();
+
+    while (pos < size) {
+        if (path.at(pos) == '/') {
+            ++pos;
+            continue;
+        }
+
+        int end = path.indexOf('/', pos);
+
+        if (end < 0)
+            end = size;
+
+        const QStringRef &name = path.midRef(pos, end - pos);
+        pos = end;
+
+        if (name == QLatin1String("."))
+            continue;
+
+        int child = -1;
+
+        for (int index : nodes.at(node).children) {
+            if (nodes.at(index).name == name) {
+                child = index;
+                break;
+            }
+        }
+
+        if (child < 0)
+            break;
+
+        node = child;
+
+        if (nodes.at(node).entry >= 0) {
+            found = nodes.at(node).entry;
+            foundPos = end;
+        }
+    }
+
+    if (subPathPos)
+        *subPathPos = foundPos;
+
+    return found;
+}
+
+// mountinfo 中的空格、制表符、换行和反斜杠被转义为八进制
+static QByteArray unescapeMountField(const QByteArray &field)
+{
+    if (!field.contains('\\'))
+        return field;
+
+    QByteArray result;
+    result.reserve(field.size());
+
+    for (int i = 0; i < field.size(); ++i) {
+        const char ch = field.at(i);
+
+        if (ch == '\\' && i + 3 < field.size()
+                && field.at(i + 1) >= '0' && field.at(i + 1) <= '7'
+                && field.at(i + 2) >= '0' && field.at(i + 2) <= '7'
+                && field.at(i + 3) >= '0' && field.at(i + 3) <= '7') {
+            result.append(static_cast<char>((field.at(i + 1) - '0') * 64
+                                            + (field.at(i + 2) - '0') * 8
+                                            + (field.at(i + 3) - '0')));
+            i += 3;
+        } else {
+            result.append(ch);
+        }
+    }
+
+    return result;
+}
+
+static bool isLowSpeedGvfsScheme(const QStringRef &scheme)
+{
+    return scheme == QLatin1String(MTP_SCHEME)
+           || scheme == QLatin1String(GPHOTO2_SCHEME)
+           || scheme == QLatin1String("gphoto")
+           || scheme == QLatin1String("smb-share")
+           || scheme == QLatin1String(SMB_SCHEME)
+           || scheme == QLatin1String(SFTP_SCHEME)
+           || scheme == QLatin1String(FTP_SCHEME);
+}
+
+static bool isNetworkFileSystem(const QByteArray &fileSystemType)
+{
+    return fileSystemType == "nfs"
+           || fileSystemType == "nfs4"
+           || fileSystemType == "cifs"
+           || fileSystemType == "smb3"
+           || fileSystemType == "smbfs"
+           || fileSystemType == "ceph"
+           || fileSystemType == "fuse.sshfs";
+}
+
+DMountTable *DMountTable::instance()
+{
+    static DMountTable *table = [] {
+        DMountTable *mountTable = new DMountTable();
+
+        // 挂载表的变化通知需要在有事件循环的线程中处理
+        if (QCoreApplication *app = QCoreApplication::instance()) {
+            mountTable->moveToThread(app->thread());
+            QMetaObject::invokeMethod(mountTable, "startWatcher", Qt::QueuedConnection);
+        }
+
+        return mountTable;
+    }();
+
+    return table;
+}
+
+bool DMountTable::isValid() const
+{
+    return m_snapshot.loadAcquire();
+}
+
+/*!
+ * \brief DMountTable::findMount 查找路径所在的挂载点
+ * \param subPath 路径中挂载点之后的部分
+ * \return 没有可用的索引或路径中含有".."时返回false
+ */
+bool DMountTable::findMount(const QString &path, DMountTable::MountEntry *entry, QString *subPath) const
+{
+    const Snapshot *snapshot = m_snapshot.loadAcquire();
+
+    if (!snapshot)
+        return false;
+
+    int subPathPos = 0;
+    const int index = snapshot->lookup(path, &subPathPos);
+
+    if (index < 0)
+        return false;
+
+    if (entry)
+        *entry = snapshot->entries.at(index);
+
+    if (subPath)
+        *subPath = path.mid(subPathPos);
+
+    return true;
+}
+
+DMountTable::MountClass DMountTable::mountClass(const QString &path) const
+{
+    const Snapshot *snapshot = m_snapshot.loadAcquire();
+
+    if (!snapshot)
+        return UnknownMount;
+
+    int subPathPos = 0;
+    const int index = snapshot->lookup(path, &subPathPos);
+
+    if (index < 0)
+        return UnknownMount;
+
+    const MountEntry &entry = snapshot->entries.at(index);
+
+    if (entry.fileSystemType == "fuse.gvfsd-fuse") {
+        // gvfs 的各个设备挂载在同一个 fuse 目录下，目录名以协议开头，如 smb-share:server=...
+        int start = subPathPos;
+
+        while (start < path.size() && path.at(start) == '/')
+            ++start;
+
+        int end = path.indexOf('/', start);
+
+        if (end < 0)
+            end = path.size();
+
+        const int colon = path.midRef(start, end - start).indexOf(':');
+
+        if (colon > 0 && isLowSpeedGvfsScheme(path.midRef(start, colon)))
+            return LowSpeedGvfsMount;
+
+        return GvfsMount;
+    }
+
+    if (entry.device.startsWith("/dev/"))
+        return LocalDeviceMount;
+
+    if (isNetworkFileSystem(entry.fileSystemType))
+        return NetworkMount;
+
+    return OtherMount;
+}
+
+/*!
+ * \brief DMountTable::loadFromData 使用 mountinfo 格式的数据重新生成索引
+ */
+bool DMountTable::loadFromData(const QByteArray &mountInfo)
+{
+    Snapshot *snapshot = new Snapshot();
+
+    for (const QByteArray &line : mountInfo.split('\n')) {
+        const QList<QByteArray> &fields = line.split(' ');
+
+        // 格式: ID 父ID 主:次设备号 根 挂载点 挂载选项 [可选字段...] - 文件系统类型 设备 超级块选项
+        const int separator = fields.indexOf("-", 6);
+
+        if (fields.size() < 6 || separator < 0 || separator + 2 >= fields.size())
+            continue;
+
+        MountEntry entry;
+        entry.mountPoint = QFile::decodeName(unescapeMountField(fields.at(4)));
+        entry.fileSystemType = fields.at(separator + 1);
+        entry.device = unescapeMountField(fields.at(separator + 2));
+
+        snapshot->insert(entry);
+    }
+
+    if (snapshot->entries.isEmpty()) {
+        delete snapshot;
+
+        return false;
+    }
+
+    setSnapshot(snapshot);
+
+    return true;
+}
+
+void DMountTable::refresh()
+{
+    QFile file(MOUNT_INFO_PATH);
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "failed to read mount info:" << file.errorString();
+
+        return;
+    }
+
+    loadFromData(file.readAll());
+}
+
+DMountTable::DMountTable(QObject *parent)
+    : QObject(parent)
+{
+    refresh();
+}
+
+void DMountTable::startWatcher()
+{
+    if (m_notifier)
+        return;
+
+    // 挂载表变化时内核对此文件发出 POLLPRI
+    int fd = open(MOUNT_INFO_PATH, O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0)
+        return;
+
+    m_notifier = new QSocketNotifier(fd, QSocketNotifier::Exception, this);
+    connect(m_notifier, &QSocketNotifier::activated, this, &DMountTable::refresh);
+
+    // 避免遗漏创建索引到开始监视之间的变化
+    refresh();
+}
+
+void DMountTable::setSnapshot(const DMountTable::Snapshot *snapshot)
+{
+    QMutexLocker locker(&m_updateMutex);
+
+    const Snapshot *old = m_snapshot.fetchAndStoreOrdered(snapshot);
+
+    if (old)
+        m_retiredSnapshots.append(old);
+
+    while (m_retiredSnapshots.size() > MOUNT_TABLE_RETIRED_COUNT)
+        delete m_retiredSnapshots.takeFirst();
+}
+
+DFM_END_NAMESPACE
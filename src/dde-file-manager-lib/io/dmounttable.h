@@ -0,0 +1,75 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DMOUNTTABLE_H
+#define DMOUNTTABLE_H
+
+#include <dfmglobal.h>
+
+#include <QObject>
+#include <QAtomicPointer>
+#include <QMutex>
+
+QT_BEGIN_NAMESPACE
+class QSocketNotifier;
+QT_END_NAMESPACE
+
+DFM_BEGIN_NAMESPACE
+
+/*!
+ * \brief DMountTable 挂载点索引
+ *
+ * 解析 /proc/self/mountinfo 生成按路径分量组织的前缀树，查询路径所在的挂载点只需逐级匹配路径分量，
+ * 查询时不加锁。挂载表变化时（udisks 挂载、gvfs 启动等）由内核通知重新生成索引。
+ * 查询按路径的字面值进行，不解析符号链接。
+ */
+class DMountTable : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum MountClass {
+        UnknownMount,       // 没有可用的索引或路径不是规范的绝对路径
+        LocalDeviceMount,   // 块设备
+        GvfsMount,          // gvfs 挂载的其它设备
+        LowSpeedGvfsMount,  // gvfs 挂载的手机、smb、ftp等低速设备
+        NetworkMount,       // 内核挂载的 nfs、cifs 等网络文件系统
+        OtherMount          // tmpfs、proc、fuse 等
+    };
+
+    struct MountEntry {
+        QString mountPoint;
+        QByteArray device;
+        QByteArray fileSystemType;
+    };
+
+    static DMountTable *instance();
+
+    bool isValid() const;
+    bool findMount(const QString &path, MountEntry *entry, QString *subPath = nullptr) const;
+    MountClass mountClass(const QString &path) const;
+
+    bool loadFromData(const QByteArray &mountInfo);
+
+public Q_SLOTS:
+    void refresh();
+
+private:
+    explicit DMountTable(QObject *parent = nullptr);
+
+    Q_INVOKABLE void startWatcher();
+
+    class Snapshot;
+    void setSnapshot(const Snapshot *snapshot);
+
+    QAtomicPointer<const Snapshot> m_snapshot;
+    // 被替换的索引延后释放，避免正在查询的线程访问已释放的内存
+    QList<const Snapshot *> m_retiredSnapshots;
+    QMutex m_updateMutex;
+    QSocketNotifier *m_notifier = nullptr;
+};
+
+DFM_END_NAMESPACE
+
+#endif // DMOUNTTABLE_H
@@ -6,6 +6,7 @@
 #include <sys/stat.h>
 
 #include "dstorageinfo.h"
+#include "dmounttable.h"
 #include "controllers/vaultcontroller.h"
 #include "dfmglobal.h"
 
@@ -300,6 +301,19 @@ bool DStorageInfo::inSameDevice(const DUrl &url1, const DUrl &url2, PathHints hi
 
 bool DStorageInfo::isLocalDevice(const QString &path, const bool &isEx)
 {
+    const DMountTable::MountClass mountClass = DMountTable::instance()->mountClass(path);
+
+    if (mountClass != DMountTable::UnknownMount) {
+        if (mountClass == DMountTable::GvfsMount || mountClass == DMountTable::LowSpeedGvfsMount)
+            return false;
+
+        // 保险箱路径直接返回真
+        if (VaultController::isVaultFile(path))
+            return true;
+
+        return mountClass == DMountTable::LocalDeviceMount;
+    }
+
     static QRegularExpression regExp("^/run/user/\\d+/gvfs/.+$",
                                      QRegularExpression::DotMatchesEverythingOption
                                      | QRegularExpression::DontCaptureOption
@@ -322,6 +336,11 @@ bool DStorageInfo::isLocalDevice(const QString &path, const bool &isEx)
 
 bool DStorageInfo::isLowSpeedDevice(const QString &path)
 {
+    const DMountTable::MountClass mountClass = DMountTable::instance()->mountClass(path);
+
+    if (mountClass != DMountTable::UnknownMount)
+        return mountClass == DMountTable::LowSpeedGvfsMount;
+
     static QMutex mutex;
     QMutexLocker lk(&mutex);
     static QRegularExpression regExp("^/run/user/\\d+/gvfs/(?<scheme>\\w+(-?)\\w+):\\S*",
@@ -350,6 +369,11 @@ bool DStorageInfo::isLowSpeedDevice(const QString &path)
 
 bool DStorageInfo::isCdRomDevice(const QString &path)
 {
+    DMountTable::MountEntry entry;
+
+    if (DMountTable::instance()->findMount(path, &entry))
+        return entry.device.startsWith("/dev/sr");
+
     return DStorageInfo(path).device().startsWith("/dev/sr");
 }
 
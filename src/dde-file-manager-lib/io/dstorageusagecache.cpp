@@ -0,0 +1,108 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dstorageusagecache.h"
+#include "dstorageinfo.h"
+
+#include <QtConcurrent>
+
+// 卡住的挂载点各占用一个线程，其余挂载点仍可查询
+#define STORAGE_USAGE_QUERY_THREADS 4
+
+DFM_BEGIN_NAMESPACE
+
+DStorageUsageCache *DStorageUsageCache::instance()
+{
+    static DStorageUsageCache *cache = new DStorageUsageCache();
+
+    return cache;
+}
+
+DStorageUsageCache::DStorageUsageCache(QObject *parent)
+    : QObject(parent)
+{
+    m_pool.setMaxThreadCount(STORAGE_USAGE_QUERY_THREADS);
+}
+
+/*!
+ * \brief DStorageUsageCache::usage 获取挂载点的容量
+ * \param maxAge 缓存的有效时间(毫秒)，过期时在后台重新查询
+ * \param waitMsec 需要重新查询时最多等待的时间(毫秒)，超时返回上一次的结果
+ * \return 还没有结果时返回无效的 Usage
+ */
+DStorageUsageCache::Usage DStorageUsageCache::usage(const QString &mountPoint, int maxAge, int waitMsec)
+{
+    QMutexLocker lk(&m_mutex);
+    const Entry &entry = m_entries[mountPoint];
+
+    if (entry.updated.isValid() && !entry.updated.hasExpired(maxAge))
+        return entry.usage;
+
+    if (!entry.querying)
+        startQuery(mountPoint);
+
+    // 等待期间锁被释放，其它线程可能插入新的挂载点，每次都重新查找
+    QElapsedTimer timer;
+    timer.start();
+    while (m_entries.value(mountPoint).querying) {
+        const qint64 remaining = waitMsec - timer.elapsed();
+        if (remaining <= 0 || !m_finished.wait(&m_mutex, static_cast<unsigned long>(remaining)))
+            break;
+    }
+
+    return m_entries.value(mountPoint).usage;
+}
+
+/*!
+ * \brief DStorageUsageCache::invalidate 挂载点的内容变化后使缓存失效，下一次获取时重新查询
+ */
+void DStorageUsageCache::invalidate(const QString &mountPoint)
+{
+    QMutexLocker lk(&m_mutex);
+    auto it = m_entries.find(mountPoint);
+
+    if (it != m_entries.end())
+        it->updated.invalidate();
+}
+
+void DStorageUsageCache::startQuery(const QString &mountPoint)
+{
+    m_entries[mountPoint].querying = true;
+
+    QtConcurrent::run(&m_pool, [this, mountPoint] {
+        DStorageInfo info(mountPoint);
+        Usage usage;
+
+        if (info.isValid()) {
+            usage.bytesTotal = info.bytesTotal();
+            usage.bytesAvailable = info.bytesAvailable();
+            usage.fileSystemType = info.fileSystemType();
+        }
+
+        finishQuery(mountPoint, usage);
+    });
+}
+
+void DStorageUsageCache::finishQuery(const QString &mountPoint, const Usage &usage)
+{
+    bool changed = false;
+
+    {
+        QMutexLocker lk(&m_mutex);
+        Entry &entry = m_entries[mountPoint];
+
+        changed = entry.usage.bytesTotal != usage.bytesTotal
+                  || entry.usage.bytesAvailable != usage.bytesAvailable
+                  || entry.usage.fileSystemType != usage.fileSystemType;
+        entry.usage = usage;
+        entry.updated.start();
+        entry.querying = false;
+        m_finished.wakeAll();
+    }
+
+    if (changed)
+        Q_EMIT usageChanged(mountPoint);
+}
+
+DFM_END_NAMESPACE
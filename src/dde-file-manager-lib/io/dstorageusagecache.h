@@ -0,0 +1,67 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DSTORAGEUSAGECACHE_H
+#define DSTORAGEUSAGECACHE_H
+
+#include <dfmglobal.h>
+
+#include <QObject>
+#include <QHash>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QThreadPool>
+#include <QElapsedTimer>
+
+DFM_BEGIN_NAMESPACE
+
+/*!
+ * \brief DStorageUsageCache 按挂载点缓存的容量信息
+ *
+ * 查询容量（statvfs 或 gvfs 的 query_filesystem_info）在卡住的 nfs、smb 挂载上可能长时间不返回，
+ * 查询统一在独立的线程池中进行，调用者总是拿到最近一次的结果。同一挂载点同时只有一个查询，
+ * 卡住的挂载点不会占用更多线程，也不会阻塞其它挂载点。查询完成后发出 usageChanged。
+ */
+class DStorageUsageCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Usage {
+        qint64 bytesTotal = -1;
+        qint64 bytesAvailable = -1;
+        QByteArray fileSystemType;
+
+        bool isValid() const { return bytesTotal >= 0; }
+    };
+
+    static DStorageUsageCache *instance();
+
+    Usage usage(const QString &mountPoint, int maxAge, int waitMsec = 0);
+    void invalidate(const QString &mountPoint);
+
+Q_SIGNALS:
+    void usageChanged(const QString &mountPoint);
+
+private:
+    explicit DStorageUsageCache(QObject *parent = nullptr);
+
+    struct Entry {
+        Usage usage;
+        QElapsedTimer updated; // 无效表示还没有结果或已失效
+        bool querying = false;
+    };
+
+    void startQuery(const QString &mountPoint);
+    void finishQuery(const QString &mountPoint, const Usage &usage);
+
+    QHash<QString, Entry> m_entries;
+    QMutex m_mutex;
+    QWaitCondition m_finished;
+    QThreadPool m_pool;
+};
+
+DFM_END_NAMESPACE
+
+#endif // DSTORAGEUSAGECACHE_H
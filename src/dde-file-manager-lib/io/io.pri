@@ -9,6 +9,10 @@ HEADERS += \
     $$PWD/dlocalfilehandler.h \
     $$PWD/dfilestatisticsjob.h \
     $$PWD/dstorageinfo.h \
+    $$PWD/dmounttable.h \
+    $$PWD/ddeviceaccessscheduler.h \
+    $$PWD/dstorageusagecache.h \
+    $$PWD/djobprogresschannel.h \
     $$PWD/dgiofiledevice.h
 
 SOURCES += \
@@ -20,6 +24,10 @@ SOURCES += \
     $$PWD/dlocalfilehandler.cpp \
     $$PWD/dfilestatisticsjob.cpp \
     $$PWD/dstorageinfo.cpp \
+    $$PWD/dmounttable.cpp \
+    $$PWD/ddeviceaccessscheduler.cpp \
+    $$PWD/dstorageusagecache.cpp \
+    $$PWD/djobprogresschannel.cpp \
     $$PWD/dgiofiledevice.cpp
 
 include(private/private.pri)
@@ -17,6 +17,10 @@
 #include <QMutex>
 #include <QFuture>
 #include <QQueue>
+#include <QSet>
+#include <QHash>
+#include <QFile>
+#include <QCryptographicHash>
 #include <QFileDevice>
 
 #include <fcntl.h>
@@ -94,6 +98,10 @@ public:
         DAbstractFileInfoPointer toInfo;
         QSharedPointer<DFileDevice> fromDevice = nullptr;
         QSharedPointer<DFileDevice> toDevice = nullptr;
+        // 拷贝到网络目录的小文件或保险箱中的文件，使用doCopyFile拷贝
+        bool isRemote = false;
+        // 移动到保险箱时拷贝完成后删除源文件
+        bool removeSource = false;
     };
 
     struct DirSetPermissonInfo {
@@ -102,20 +110,203 @@ public:
         DUrl target;
     };
 
+    // 根据拷贝速度在64KiB~16MiB之间动态调整读写的块大小
+    class BlockSizeController
+    {
+    public:
+        // 不同类型目标设备的初始块大小
+        static qint64 defaultBlockSize(bool isNetwork, bool isRemovable);
+
+        void reset(qint64 initSize);
+        // 块大小保持为 alignment 的整数倍，用于按 cryfs 的块大小写入保险箱
+        void setAlignment(qint64 alignment);
+        // 开始拷贝一个新文件，重新开始统计速度
+        void beginFile();
+        // 记录一次读写的数据大小，每个统计窗口结束时根据速度变化调整块大小
+        qint64 update(qint64 size);
+        qint64 blockSize() const;
+
+    private:
+        void restartWindow();
+
+        QMutex m_mutex;
+        QAtomicInteger<qint64> m_blockSize = 1048576;
+        int m_direction = 1; // 1增大，-1减小，0保持
+        qreal m_lastThroughput = 0;
+        qint64 m_windowBytes = 0;
+        QElapsedTimer m_windowTimer;
+        qint64 m_alignment = 1;
+    };
+
+    // 拷贝日志，记录已经完成的文件和正在拷贝的文件的位置，任务中断后再次拷贝时可以续传
+    class CopyJournal
+    {
+    public:
+        enum State {
+            NoState,
+            DirectoryState, // 目录已经创建
+            InFlightState, // 文件正在拷贝
+            CompletedState // 文件拷贝完成
+        };
+
+        bool open(const QString &filePath);
+        void close(bool removeFile);
+        bool isOpen() const;
+
+        void recordDirectory(const DUrl &from, const DUrl &to);
+        void recordProgress(const DUrl &from, const DUrl &to, qint64 offset);
+        void recordCompleted(const DUrl &from, const DUrl &to);
+
+        State state(const DUrl &from, const DUrl &to) const;
+        // 正在拷贝的文件上次写入的位置
+        qint64 resumeOffset(const DUrl &from, const DUrl &to) const;
+
+    private:
+        struct Record {
+            State state = NoState;
+            qint64 offset = 0;
+        };
+
+        static QByteArray recordKey(const DUrl &from, const DUrl &to);
+        void writeRecord(char type, const DUrl &from, const DUrl &to, qint64 offset);
+
+        mutable QMutex m_mutex;
+        QFile m_file;
+        QHash<QByteArray, Record> m_records;
+        QAtomicInteger<bool> m_isOpen = false;
+    };
+
+    // 令牌桶限速，多个读线程共用
+    class SpeedLimiter
+    {
+    public:
+        // 每秒最多读取的字节数，0为不限速
+        void setLimit(qint64 bytesPerSecond);
+        qint64 limit() const;
+        // 消耗读取数据大小的令牌，返回需要等待的毫秒数
+        qint64 consume(qint64 size);
+
+    private:
+        QMutex m_mutex;
+        QAtomicInteger<qint64> m_limit = 0;
+        qint64 m_tokens = 0;
+        QElapsedTimer m_timer;
+    };
+
+    // 流式计算校验值，数据交给工作线程计算，和文件的读写同时进行
+    class StreamChecksum
+    {
+    public:
+        explicit StreamChecksum(DFileCopyMoveJob::VerifyMode mode = DFileCopyMoveJob::FastVerify);
+        ~StreamChecksum();
+
+        void reset(DFileCopyMoveJob::VerifyMode mode);
+        // 复制一份数据后返回，上一块数据还没有计算完时先等待
+        void addData(const char *data, qint64 size);
+        // 等待所有数据计算完成，返回16进制的校验值
+        QByteArray result();
+
+    private:
+        void update(const QByteArray &data);
+
+        DFileCopyMoveJob::VerifyMode m_mode = DFileCopyMoveJob::FastVerify;
+        ulong m_adler = 0;
+        QCryptographicHash m_sha256 { QCryptographicHash::Sha256 };
+        QFuture<void> m_pending;
+    };
+
+    // 查找稀疏文件中的空洞，使用单独的文件描述符，不影响读取文件的位置
+    class HoleScanner
+    {
+    public:
+        // 文件不是稀疏文件时不打开文件
+        explicit HoleScanner(const QString &path);
+        ~HoleScanner();
+
+        bool isSparse() const;
+        // pos在空洞中时返回空洞结束的位置，后面全是空洞时返回文件大小，否则返回pos
+        qint64 nextData(qint64 pos) const;
+
+    private:
+        Q_DISABLE_COPY(HoleScanner)
+
+        int m_fd = -1;
+        qint64 m_size = 0;
+    };
+
+    // 拷贝数据量的计数，每个线程累加到自己的槽中，拷贝线程之间不需要加锁，也不竞争同一个缓存行，读取时把所有槽相加
+    class ProgressCounter
+    {
+    public:
+        ProgressCounter &operator+=(qint64 size);
+        // 只在没有线程累加时使用
+        ProgressCounter &operator=(qint64 size);
+        operator qint64() const;
+
+    private:
+        enum { SlotCount = 16, CacheLineSize = 64 };
+
+        struct Slot {
+            QAtomicInteger<qint64> value;
+            char padding[CacheLineSize - sizeof(QAtomicInteger<qint64>)];
+        };
+
+        static int slotIndex();
+
+        Slot m_slots[SlotCount];
+    };
+
+    // 写入数据后分段启动回写并等待上一段回写完成，限制页缓存中目标文件的脏数据，结束时同步不需要等很久
+    class WritebackThrottle
+    {
+    public:
+        // fd 为目标文件的描述符，pos 为已经写入的位置
+        void written(int fd, qint64 pos);
+        // fd 为源文件的描述符，pos 为已经读取的位置，丢弃页缓存时把读过的数据从缓存中去掉
+        void read(int fd, qint64 pos);
+        // 丢弃回写完成的目标数据和读过的源数据的页缓存
+        void setDropCache(bool drop);
+        bool isDropCache() const;
+
+    private:
+        qint64 m_flushedPos = 0;
+        qint64 m_waitPos = 0;
+        qint64 m_readDroppedPos = 0;
+        bool m_dropCache = false;
+    };
+
+    // 通过目录描述符删除本地目录树，使用getdents64读取目录项，d_type可以确定类型时不再stat，
+    // 根目录下的子目录分发到线程池中并行删除，删除的数量累加到计数中
+    class TreeRemover
+    {
+    public:
+        TreeRemover(DFileCopyMoveJobPrivate *d, QThreadPool *pool, bool force);
+        // 返回false时目录中还有没能删除的文件，由调用者按照以前的方式逐个处理并提示错误
+        bool remove(const QString &path);
+        qint64 removedCount() const;
+
+    private:
+        bool removeDirectory(int parentFd, const QByteArray &name, bool fanOut);
+        bool removeChildren(int dirFd, bool fanOut);
+        bool unlinkEntry(int dirFd, const char *name, int flags);
+        bool isStopped();
+        void syncProgress();
+
+        DFileCopyMoveJobPrivate *m_d;
+        QThreadPool *m_pool;
+        bool m_force;
+        int m_startCount;
+        ProgressCounter m_removedCount;
+        Q_DISABLE_COPY(TreeRemover)
+    };
+
     typedef QSharedPointer<FileCopyInfo> FileCopyInfoPointer;
 
     explicit DFileCopyMoveJobPrivate(DFileCopyMoveJob *qq);
     ~DFileCopyMoveJobPrivate();
 
     static QString errorToString(DFileCopyMoveJob::Error error);
-    // 返回当前线程已经往block设备写入的数据，返回的是本次和上次间隔时间内写入的大小
-    static qint64 getWriteBytes(long tid);
-    qint64 getWriteBytes() const;
-    // 返回当前目标设备已写入扇区总数
-    // /sys/dev/block/[x:x]/stat 的第7个字段
-    // https://www.kernel.org/doc/Documentation/iostats.txt
-    qint64 getSectorsWritten() const;
-    // 返回已写入数据大小，根据多种情况，用不同的方式获取此数据
+    // 返回已写入数据大小，由拷贝线程在写入后累加
     qint64 getCompletedDataSize() const;
 
     void setState(DFileCopyMoveJob::State s);
@@ -130,9 +321,17 @@ public:
     bool stateCheck();
     bool checkFileSize(qint64 size) const;
     bool checkFreeSpace(qint64 needSize);
+    bool canLinkToDestination(const DAbstractFileInfoPointer &fromInfo, const DAbstractFileInfoPointer &toInfo) const;
+    bool linkToDestination(const DAbstractFileInfoPointer &fromInfo, const DAbstractFileInfoPointer &toInfo);
+    // 设置了 PreserveHardLinks 时，返回与源文件为同一 inode 且已经复制过的目标文件，key 为源文件的(设备号, inode)
+    QString copiedHardLinkTarget(const DAbstractFileInfoPointer &fromInfo, QPair<quint64, quint64> *key);
+    bool linkToCopiedHardLink(const QString &copiedPath, const DAbstractFileInfoPointer &fromInfo, const DAbstractFileInfoPointer &toInfo);
+    void recordCopiedHardLink(const QPair<quint64, quint64> &key, const QString &targetPath);
     QString formatFileName(const QString &name) const;
 
-    static QString getNewFileName(const DAbstractFileInfoPointer sourceFileInfo, const DAbstractFileInfoPointer targetDirectory);
+    static QString getNewFileName(const DAbstractFileInfoPointer sourceFileInfo, const DAbstractFileInfoPointer targetDirectory,
+                                  QSet<QString> *existingNames = nullptr);
+    QString getNonExistsFileName(const DAbstractFileInfoPointer sourceFileInfo, const DAbstractFileInfoPointer targetDirectory);
 
     bool doProcess(const DUrl &from, const DAbstractFileInfoPointer source_info, const DAbstractFileInfoPointer target_info, const bool isNew = false);
     bool mergeDirectory(const QSharedPointer<DFileHandler> &handler, const DAbstractFileInfoPointer fromInfo, const DAbstractFileInfoPointer toInfo);
@@ -140,6 +339,14 @@ public:
     bool doCopySmallFilesOnDisk(const DAbstractFileInfoPointer fromInfo, const DAbstractFileInfoPointer toInfo,
                                 const QSharedPointer<DFileDevice> &fromDevice, const QSharedPointer<DFileDevice> &toDevice,
                                 const QSharedPointer<DFileHandler> &handler);
+    //本地文件之间使用内核拷贝（reflink/copy_file_range/sendfile）
+    bool doCopyFileByKernel(const DAbstractFileInfoPointer &fromInfo, const DAbstractFileInfoPointer &toInfo,
+                            const QSharedPointer<DFileDevice> &fromDevice, const QSharedPointer<DFileDevice> &toDevice);
+    //写入前按源文件的大小预先分配目标文件的空间，空间不足时返回false
+    bool preallocateTargetFile(int fd, qint64 offset, qint64 size);
+    //关闭目标文件前通过描述符设置时间和权限，gvfs 中的文件一次设置所有属性
+    bool finalizeTargetFile(int fd, const DAbstractFileInfoPointer &fromInfo, const DAbstractFileInfoPointer &toInfo,
+                            const QSharedPointer<DFileHandler> &handler);
     //线程池中拷贝大量小文件
     bool doThreadPoolCopyFile();
     //拷贝文件到块设备（除光驱和系统所在的磁盘）
@@ -148,6 +355,8 @@ public:
                       const DAbstractFileInfoPointer &toInfo = DAbstractFileInfoPointer(nullptr));
     bool doRenameFile(const QSharedPointer<DFileHandler> &handler, const DAbstractFileInfoPointer oldInfo, const DAbstractFileInfoPointer newInfo);
     bool doLinkFile(const QSharedPointer<DFileHandler> &handler, const DAbstractFileInfoPointer fileInfo, const QString &linkPath);
+    //盘内剪切时通过目录描述符批量重命名，冲突和失败的文件留给逐个处理的流程
+    void bulkRenameOnSameDevice();
 
     /**
      * @brief convertTrashFile 对回收站根目录下的文件进行转换，将其移动到上级expunged目录下
@@ -157,6 +366,11 @@ public:
 
     bool process(const DUrl from, const DAbstractFileInfoPointer target_info);
     bool process(const DUrl from, const DAbstractFileInfoPointer source_info, const DAbstractFileInfoPointer target_info, const bool isNew = false);
+    //是否可以在线程池中并行拷贝到网络目录
+    bool canCopyRemoteFileInPool(const DAbstractFileInfoPointer &fromInfo) const;
+    bool isVaultPoolCopy() const;
+    bool canCopyVaultFileInPool(const DAbstractFileInfoPointer &fromInfo) const;
+    void copyFileInPool(const QSharedPointer<ThreadCopyInfo> &threadInfo);
     bool copyFile(const DAbstractFileInfoPointer fromInfo, const DAbstractFileInfoPointer toInfo, const QSharedPointer<DFileHandler> &handler, int blockSize = 1048576);
     bool removeFile(const QSharedPointer<DFileHandler> &handler, const DAbstractFileInfoPointer fileInfo);
     bool renameFile(const QSharedPointer<DFileHandler> &handler, const DAbstractFileInfoPointer oldInfo, const DAbstractFileInfoPointer newInfo);
@@ -186,6 +400,10 @@ public:
     void checkTagetIsFromBlockDevice();//检查目标文件是否是块设备
     bool checkWritQueueEmpty();
     bool checkWritQueueCount();
+    //写队列满时阻塞读线程，直到写线程取走数据或任务停止
+    void waitWriteQueueNotFull();
+    //写队列为空时阻塞写线程，直到有新的数据、读线程结束或任务停止
+    void waitWriteQueueNotEmpty();
     QSharedPointer<FileCopyInfo> writeQueueDequeue();
     void writeQueueEnqueue(const QSharedPointer<FileCopyInfo> &copyinfo);
     //错误队列处理
@@ -194,6 +412,12 @@ public:
     void errorQueueHandled(const bool &isNotCancel = true);
     //清理当前拷贝信息
     void releaseCopyInfo(const FileCopyInfoPointer &info);
+    //从拷贝缓存池中取一个按页对齐的buffer（大小为MAX_BUFFER_LEN），缓存池用完时阻塞等待归还，任务停止时返回nullptr
+    char *acquireCopyBuffer();
+    //归还buffer到拷贝缓存池
+    void releaseCopyBuffer(char *buffer);
+    //释放拷贝缓存池中空闲的buffer
+    void clearCopyBufferPool();
     /**
      * @brief setCutTrashData    保存剪切回收站文件路径
      * @param fileNameList       文件路径
@@ -224,6 +448,39 @@ public:
     DFileCopyMoveJob::GvfsRetryType gvfsFileRetry(char * data, bool &isErrorOccur, qint64 &currentPos, const DAbstractFileInfoPointer &fromInfo, const DAbstractFileInfoPointer &toInfo,
                                                   QSharedPointer<DFileDevice> &fromDevice, QSharedPointer<DFileDevice> &toDevice);
     void readAheadSourceFile(const DAbstractFileInfoPointer &fromInfo);
+    //读取数据后限速，后台模式时降低读线程的io优先级
+    void throttleRead(qint64 size);
+    void applyIoPriority();
+    static void resetIoPriority();
+    // 丢弃文件的页缓存，校验时重新从磁盘读取
+    static void dropPageCache(const QString &path);
+    // 按照页缓存策略判断拷贝这个文件时是否丢弃页缓存
+    bool isDropPageCache(qint64 fileSize) const;
+    // 设置源文件和目标文件的页缓存建议，返回是否丢弃页缓存
+    bool adviseCopyPageCache(int fromFd, int toFd, qint64 fileSize, WritebackThrottle &throttle) const;
+    // 文件拷贝结束后丢弃剩余的页缓存
+    void releaseCopyPageCache(int fromFd, int toFd, const WritebackThrottle &throttle) const;
+    // 是否需要保留源文件中的空洞，需要校验完整性时要读取全部数据，不跳过空洞
+    bool isKeepHoles() const;
+    // 按照相同文件策略判断已存在的目标文件是否与源文件相同
+    bool isIdenticalFile(const DAbstractFileInfoPointer &fromInfo, const DAbstractFileInfoPointer &toInfo);
+    // 比较两个文件的数据，fullContent 为 false 时只比较均匀分布的几个数据块
+    bool compareFileData(const QString &fromPath, const QString &toPath, qint64 size, bool fullContent);
+    // 设置了 DeltaTransfer 时按块比较源文件与已存在的目标文件，只写入不同的块，返回false时需要完整拷贝
+    bool deltaCopyFile(const DAbstractFileInfoPointer &fromInfo, const DAbstractFileInfoPointer &toInfo,
+                       const QSharedPointer<DFileHandler> &handler);
+    // 写入数据后按照同步策略回写，目标文件没有描述符时按照以前的方式同步
+    void syncAfterWrite(const QSharedPointer<DFileDevice> &toDevice, WritebackThrottle &throttle);
+    // 在后台同步文件，不阻塞拷贝
+    void syncFileInBackground(const QString &path);
+    // 同步目标所在的文件系统，返回0表示成功
+    int syncTargetFileSystem();
+    //根据拷贝日志续传文件，返回续传的位置
+    qint64 resumeFromJournal(const DAbstractFileInfoPointer &fromInfo, const DAbstractFileInfoPointer &toInfo,
+                             const QSharedPointer<DFileDevice> &fromDevice, const QSharedPointer<DFileDevice> &toDevice,
+                             StreamChecksum &checksum);
+    QStringList prefetchDirectory(const QString &path);
+    void prefetchSubDirectories(const DUrl &url);
     bool handleUnknowUrlError(const DAbstractFileInfoPointer &fromInfo,const DAbstractFileInfoPointer &toInfo);
     bool handleUnknowError(const DAbstractFileInfoPointer &fromInfo, const DAbstractFileInfoPointer &toInfo, const QString &errorStr);
     void sendCopyInfo(const DAbstractFileInfoPointer &fromInfo,const DAbstractFileInfoPointer &toInfo);
@@ -235,7 +492,26 @@ public:
     void saveCopyFileUrl(const DUrl &url);
     void removeCopyFileUrl(const DUrl &url);
 
+    //同一个机械硬盘上的任务排队执行
+    static QString spindleDeviceKey(const QString &path);
+    QStringList deviceSchedulerKeys() const;
+    bool waitForDevices();
+    void releaseDevices();
+
 public:
+    //! 目录预读的线程池和已经预读过的目录
+    QThreadPool m_prefetchPool;
+    QSet<QString> m_prefetchedDirs;
+    QMutex m_prefetchMutex;
+
+    //! 生成副本名称时目标目录中已有的文件名，每个目录只读取一次，之后随生成的名称更新
+    QHash<QString, QSet<QString>> m_targetDirNames;
+    QMutex m_targetDirNamesMutex;
+
+    //! 已复制的多链接源文件，key 为源文件的(设备号, inode)，value 为第一次复制的目标路径
+    QHash<QPair<quint64, quint64>, QString> m_copiedHardLinks;
+    QMutex m_copiedHardLinksMutex;
+
     //! 剪切回收站文件路径
     QQueue<QString> m_fileNameList;
 
@@ -272,14 +548,12 @@ public:
     QFuture<void> m_writeResult, m_syncResult;
 
 
-    // 是否可以使用 /pric/[pid]/task/[tid]/io 文件中的的 writeBytes 字段的值作为判断已写入数据的依据
+    // 目标是否是ext系列的本地文件系统
     qint8 canUseWriteBytes : 1;
     // 目标磁盘设备是不是可移除或者热插拔设备
     qint8 targetIsRemovable : 1;
     // 逻辑扇区大小
     qint16 targetLogSecionSize = 512;
-    // 记录任务开始时目标磁盘设备已写入扇区数
-    qint64 targetDeviceStartSectorsWritten;
     // /sys/dev/block/x:x
     QString targetSysDevPath;
     // 目标设备所挂载的根目录
@@ -293,19 +567,25 @@ public:
     QStack<DirectoryInfo> directoryStack;
     QList<QPair<DUrl, DUrl>> completedFileList;
     QList<QPair<DUrl, DUrl>> completedDirectoryList;
+    //批量重命名已经完成的源文件和目标文件
+    QHash<DUrl, DUrl> m_bulkRenamedUrls;
     int completedFilesCount = 0;
     int totalMoveFilesCount = 1;
-    qint64 completedDataSize = 0;
-    qint64 completedProgressDataSize = 0;
+    ProgressCounter completedDataSize;
+    ProgressCounter completedProgressDataSize;
     //跳过文件大小统计
     qint64 skipFileSize = 0;
     // 已经写入到block设备的总大小
-    qint64 completedDataSizeOnBlockDevice = 0;
+    ProgressCounter completedDataSizeOnBlockDevice;
     QPair<qint64 /*total*/, qint64 /*writed*/> currentJobDataSizeInfo;
     int currentJobFileHandle = -1;
     ElapsedTimer *updateSpeedElapsedTimer = nullptr;
     QTimer *updateSpeedTimer = nullptr;
     int timeOutCount = 0;
+    // 上次计算速度时的时间和数据量，以及平滑后的速度
+    qint64 m_lastSpeedTime = 0;
+    qint64 m_lastSpeedSize = 0;
+    qreal m_smoothedSpeed = 0;
     QAtomicInteger<bool> needUpdateProgress = false;
     QAtomicInteger<bool> countStatisticsFinished = false;
     // 线程id
@@ -321,12 +601,13 @@ public:
     //优化盘内拷贝，启用的线程池
     QThreadPool m_pool;
     QAtomicInteger<bool> m_bDestLocal = false;
-    qint64 m_refineCopySize = 0;
-    QMutex m_refineMutex;
+    ProgressCounter m_refineCopySize;
     //是否需要显示进度条
     QAtomicInteger<bool> m_isNeedShowProgress = false;
     //是否需要每读写一次同步
     bool m_isEveryReadAndWritesSnc = false;
+    //源文件或者目标所在的 MTP 设备，为空时不需要让出设备
+    QString m_accessDevice;
     QAtomicInteger<bool> m_isVfat = false;
     QAtomicInt m_openFlag = O_CREAT | O_WRONLY | O_TRUNC;
     //分断拷贝的线程数量
@@ -340,6 +621,13 @@ public:
     QAtomicInteger<bool> m_isTagGvfsFile = false;
     //拷贝信息的队列锁
     QMutex m_copyInfoQueueMutex;
+    QWaitCondition m_writeQueueNotEmptyCondition;
+    QWaitCondition m_writeQueueNotFullCondition;
+    //读写线程之间复用的拷贝缓存池
+    QStack<char *> m_freeCopyBuffers;
+    int m_copyBufferCount = 0;
+    QMutex m_copyBufferMutex;
+    QWaitCondition m_copyBufferCondition;
     QMutex m_skipFileQueueMutex;
     //当前拷贝的device
     QMap<DUrl,QSharedPointer<DFileDevice>> m_currentDevice;
@@ -370,12 +658,45 @@ public:
     //打开写入文件的fd
     QMap<DUrl,int> m_writeOpenFd;
     QList<QSharedPointer<DirSetPermissonInfo>> m_dirPermissonList;
+    //目标是保险箱（cryfs）
+    QAtomicInteger<bool> m_isVaultTarget = false;
+    //剪切到保险箱时，目录中的文件在线程池中移动完成后再删除的源目录，子目录在前
+    QList<QPair<QSharedPointer<DFileHandler>, DAbstractFileInfoPointer>> m_pendingRemoveDirs;
 
     qint64 m_gvfsFileInnvliadProgress = 0;
 
+    //doCopyFile中使用的读写块大小
+    BlockSizeController m_blockSizeController;
+    //限速和后台模式
+    QAtomicInteger<qint64> m_speedLimit = 0;
+    QAtomicInteger<bool> m_isBackgroundMode = false;
+    SpeedLimiter m_speedLimiter;
+    //拷贝后校验目标文件的方式
+    DFileCopyMoveJob::VerifyMode m_verifyMode = DFileCopyMoveJob::NoVerify;
+    //同步策略，AutoSync 在任务开始时根据目标设备确定
+    DFileCopyMoveJob::SyncPolicy m_syncPolicy = DFileCopyMoveJob::AutoSync;
+    //页缓存策略
+    DFileCopyMoveJob::PageCachePolicy m_pageCachePolicy = DFileCopyMoveJob::AutoPageCache;
+    //相同文件策略，设置后已存在且相同的目标文件直接跳过
+    DFileCopyMoveJob::IdenticalFilePolicy m_identicalFilePolicy = DFileCopyMoveJob::NoSkipIdentical;
+    //后台同步文件的线程池
+    QThreadPool m_syncPool;
+    //写线程中每个目标文件的回写状态
+    QHash<int, WritebackThrottle> m_writebackThrottles;
+    //断点续传的拷贝日志
+    QString m_journalFilePath;
+    CopyJournal m_copyJournal;
+
     static DUrlList copyingFiles;
     static QMutex copyingFilesMutex;
 
+    //! 每个机械硬盘上排队的任务，排在第一个的任务可以执行
+    static QMap<QString, QList<DFileCopyMoveJob *>> deviceJobQueues;
+    static QMutex deviceJobMutex;
+    static QWaitCondition deviceJobCondition;
+    QStringList m_deviceKeys;
+    QAtomicInteger<bool> m_isDeviceQueued = false;
+
     Q_DECLARE_PUBLIC(DFileCopyMoveJob)
 };
 
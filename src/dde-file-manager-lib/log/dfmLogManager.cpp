@@ -33,6 +33,8 @@ void DFMLogManager::initFilterAppender()
                 "%{time}{yyyy-MM-dd, HH:mm:ss.zzz} [%{type:-7}] [%{file:-20} %{function:-35} %{line}] %{message}\n");
     m_filterAppender->setLogFilesLimit(5);
     m_filterAppender->setDatePattern(FilterAppender::DailyRollover);
+    // 拷贝、搜索等热点路径中的日志不再等待文件写入
+    m_filterAppender->setAsync(true);
     logger->registerAppender(m_filterAppender);
 }
 
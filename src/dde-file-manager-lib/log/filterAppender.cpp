@@ -5,17 +5,205 @@
 #include <QDateTime>
 #include <QDir>
 #include <QFileInfo>
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QCoreApplication>
+#include <QSet>
 
 #include "filterAppender.h"
 
 DCORE_USE_NAMESPACE
 
+// 异步写入的环形缓冲区容量，必须是2的幂
+#define LOG_RING_CAPACITY 8192
+// 缓冲区中的日志达到此数量时立即唤醒写入线程，否则按间隔写入
+#define LOG_RING_WAKE_THRESHOLD (LOG_RING_CAPACITY / 4)
+#define LOG_FLUSH_INTERVAL 100
+// 同一位置的日志在每个时间窗口（毫秒）内最多写入的条数，错误和致命错误不限制
+#define LOG_RATE_WINDOW 1000
+#define LOG_RATE_LIMIT 100
+#define LOG_RATE_BUCKET_MAX 4096
+
+struct LogRecord
+{
+    QDateTime timeStamp;
+    Logger::LogLevel logLevel = Logger::Debug;
+    const char *file = nullptr;
+    int line = 0;
+    const char *function = nullptr;
+    QString category;
+    QString message;
+};
+
+/*!
+ * \brief FilterLogWriter 异步写入日志的后台线程
+ *
+ * AbstractAppender::write 在锁内调用 append，因此只有一个生产者，环形缓冲区的读写位置只需原子变量，
+ * 调用线程写入日志时不需要等待文件 IO。
+ */
+class FilterLogWriter : public QThread
+{
+public:
+    explicit FilterLogWriter(FilterAppender *appender)
+        : m_appender(appender)
+        , m_records(LOG_RING_CAPACITY)
+    {
+        QMutexLocker locker(writersMutex());
+
+        writers()->insert(this);
+    }
+
+    ~FilterLogWriter() override
+    {
+        QMutexLocker locker(writersMutex());
+
+        writers()->remove(this);
+    }
+
+    bool push(LogRecord &record, bool wait)
+    {
+        const quint32 head = m_head.load();
+
+        // 写入线程自身产生的日志不能等待，否则缓冲区满时会死锁
+        if (QThread::currentThread() == this)
+            wait = false;
+
+        while (head - m_tail.loadAcquire() >= LOG_RING_CAPACITY) {
+            if (!wait) {
+                m_dropped.fetchAndAddRelaxed(1);
+                return false;
+            }
+
+            wakeUp();
+            QThread::yieldCurrentThread();
+        }
+
+        qSwap(m_records[static_cast<int>(head & (LOG_RING_CAPACITY - 1))], record);
+        m_head.storeRelease(head + 1);
+
+        if (head + 1 - m_tail.loadAcquire() >= LOG_RING_WAKE_THRESHOLD)
+            wakeUp();
+
+        return true;
+    }
+
+    void flush()
+    {
+        if (QThread::currentThread() == this)
+            return;
+
+        while (m_tail.loadAcquire() != m_head.loadAcquire()) {
+            wakeUp();
+            QThread::yieldCurrentThread();
+        }
+    }
+
+    void stop()
+    {
+        {
+            QMutexLocker locker(&m_mutex);
+            m_quit = true;
+            m_condition.wakeOne();
+        }
+
+        wait();
+    }
+
+    static void flushAll()
+    {
+        QMutexLocker locker(writersMutex());
+
+        for (FilterLogWriter *writer : *writers())
+            writer->flush();
+    }
+
+protected:
+    void run() override
+    {
+        forever {
+            drain();
+
+            QMutexLocker locker(&m_mutex);
+
+            if (m_quit)
+                break;
+
+            m_condition.wait(&m_mutex, LOG_FLUSH_INTERVAL);
+        }
+
+        drain();
+    }
+
+private:
+    void wakeUp()
+    {
+        QMutexLocker locker(&m_mutex);
+
+        m_condition.wakeOne();
+    }
+
+    void drain()
+    {
+        quint32 tail = m_tail.load();
+
+        while (tail != m_head.loadAcquire()) {
+            LogRecord &record = m_records[static_cast<int>(tail & (LOG_RING_CAPACITY - 1))];
+
+            m_appender->writeRecord(record.timeStamp, record.logLevel, record.file, record.line,
+                                    record.function, record.category, record.message);
+            // 释放字符串，避免缓冲区中长期持有大量内存
+            record.category.clear();
+            record.message.clear();
+            m_tail.storeRelease(++tail);
+        }
+
+        const int dropped = m_dropped.fetchAndStoreRelaxed(0);
+
+        if (dropped > 0) {
+            m_appender->writeRecord(QDateTime::currentDateTime(), Logger::Warning, __FILE__, __LINE__, Q_FUNC_INFO,
+                                    QString(), QString("%1 log messages dropped, the log buffer is full").arg(dropped));
+        }
+    }
+
+    static QMutex *writersMutex()
+    {
+        static QMutex mutex;
+
+        return &mutex;
+    }
+
+    static QSet<FilterLogWriter *> *writers()
+    {
+        static QSet<FilterLogWriter *> set;
+
+        return &set;
+    }
+
+    FilterAppender *m_appender;
+    QVector<LogRecord> m_records;
+    QAtomicInteger<quint32> m_head;
+    QAtomicInteger<quint32> m_tail;
+    QAtomicInt m_dropped;
+
+    QMutex m_mutex;
+    QWaitCondition m_condition;
+    bool m_quit = false;
+};
+
 FilterAppender::FilterAppender(const QString &fileName)
     : FileAppender(fileName)
     , m_frequency(MinutelyRollover)
     , m_logFilesLimit(0)
     , m_logSizeLimit(1024 * 1024 * 20)
-{}
+{
+    m_rateTimer.start();
+}
+
+FilterAppender::~FilterAppender()
+{
+    setAsync(false);
+}
 
 void FilterAppender::append(const QDateTime &timeStamp, Logger::LogLevel logLevel, const char *file, int line,
                             const char *function, const QString &category, const QString &message)
@@ -29,6 +217,35 @@ void FilterAppender::append(const QDateTime &timeStamp, Logger::LogLevel logLeve
     }
     locker.unlock();
 
+    QString text = message;
+
+    if (!passRateLimit(logLevel, file, line, &text))
+        return;
+
+    if (!m_writer) {
+        writeRecord(timeStamp, logLevel, file, line, function, category, text);
+        return;
+    }
+
+    LogRecord record;
+
+    record.timeStamp = timeStamp;
+    record.logLevel = logLevel;
+    record.file = file;
+    record.line = line;
+    record.function = function;
+    record.category = category;
+    record.message = text;
+    m_writer->push(record, logLevel >= Logger::Warning);
+
+    // 致命错误之后进程会退出，先把之前的日志写完
+    if (logLevel == Logger::Fatal)
+        m_writer->flush();
+}
+
+void FilterAppender::writeRecord(const QDateTime &timeStamp, Logger::LogLevel logLevel, const char *file, int line,
+                                 const char *function, const QString &category, const QString &message)
+{
     if (!m_rollOverTime.isNull() && QDateTime::currentDateTime() > m_rollOverTime)
         rollOver();
 
@@ -38,6 +255,77 @@ void FilterAppender::append(const QDateTime &timeStamp, Logger::LogLevel logLeve
     FileAppender::append(timeStamp, logLevel, file, line, function, category, message);
 }
 
+/*!
+ * \brief FilterAppender::passRateLimit 同一位置的日志在时间窗口内超过上限时不再写入，
+ * 下一个窗口的第一条日志中注明被省略的条数
+ */
+bool FilterAppender::passRateLimit(Logger::LogLevel logLevel, const char *file, int line, QString *message)
+{
+    if (logLevel >= Logger::Error)
+        return true;
+
+    // 没有位置信息时按内容区分
+    const QPair<quintptr, int> key(reinterpret_cast<quintptr>(file), file ? line : static_cast<int>(qHash(*message)));
+
+    if (m_rateBuckets.size() >= LOG_RATE_BUCKET_MAX && !m_rateBuckets.contains(key))
+        m_rateBuckets.clear();
+
+    RateBucket &bucket = m_rateBuckets[key];
+    const qint64 now = m_rateTimer.elapsed();
+
+    if (bucket.count == 0 || now - bucket.windowStart >= LOG_RATE_WINDOW) {
+        if (bucket.suppressed > 0)
+            message->append(QString(" [%1 similar messages suppressed]").arg(bucket.suppressed));
+
+        bucket.windowStart = now;
+        bucket.count = 0;
+        bucket.suppressed = 0;
+    }
+
+    if (++bucket.count > LOG_RATE_LIMIT) {
+        ++bucket.suppressed;
+        return false;
+    }
+
+    return true;
+}
+
+void FilterAppender::setAsync(bool async)
+{
+    if (async == isAsync())
+        return;
+
+    if (async) {
+        m_writer = new FilterLogWriter(this);
+        m_writer->start(QThread::LowPriority);
+
+        // 程序退出前写完缓冲区中的日志
+        static bool postRoutineAdded = false;
+
+        if (!postRoutineAdded) {
+            postRoutineAdded = true;
+            qAddPostRoutine(&FilterLogWriter::flushAll);
+        }
+    } else {
+        FilterLogWriter *writer = m_writer;
+
+        m_writer = nullptr;
+        writer->stop();
+        delete writer;
+    }
+}
+
+bool FilterAppender::isAsync() const
+{
+    return m_writer;
+}
+
+void FilterAppender::flush()
+{
+    if (m_writer)
+        m_writer->flush();
+}
+
 
 FilterAppender::DatePattern FilterAppender::datePattern() const
 {
@@ -6,9 +6,13 @@
 #define FILTERAPPENDER_H
 
 #include <QDateTime>
+#include <QElapsedTimer>
+#include <QHash>
 
 #include <FileAppender.h>
 
+class FilterLogWriter;
+
 /*!
  * \brief The RollingFileAppender(modifed as FilterAppender) class extends FileAppender so that the underlying file is rolled over at a user chosen frequency.
  *
@@ -46,6 +50,7 @@ public:
     };
 
     explicit FilterAppender(const QString &fileName = QString());
+    ~FilterAppender() override;
 
     DatePattern datePattern() const;
     void setDatePattern(DatePattern datePattern);
@@ -79,11 +84,29 @@ public:
      */
     void clearFilters();
 
+    /**
+     * @brief setAsync      设置是否异步写入
+     * 异步写入时调用线程只把日志放入环形缓冲区，由后台线程格式化并写入文件。缓冲区满时丢弃调试和信息日志，
+     * 警告及以上级别的日志等待写入，致命错误在返回前写完所有日志
+     */
+    void setAsync(bool async);
+    bool isAsync() const;
+
+    /**
+     * @brief flush         等待缓冲区中的日志全部写入文件
+     */
+    void flush();
+
 protected:
     virtual void append(const QDateTime &timeStamp, DTK_CORE_NAMESPACE::Logger::LogLevel logLevel, const char *file, int line,
                         const char *function, const QString &category, const QString &message);
 
 private:
+    friend class FilterLogWriter;
+
+    void writeRecord(const QDateTime &timeStamp, DTK_CORE_NAMESPACE::Logger::LogLevel logLevel, const char *file, int line,
+                     const char *function, const QString &category, const QString &message);
+    bool passRateLimit(DTK_CORE_NAMESPACE::Logger::LogLevel logLevel, const char *file, int line, QString *message);
     void rollOver();
     void computeRollOverTime();
     void computeFrequency();
@@ -101,6 +124,17 @@ private:
 
     QStringList m_filters; //! 过滤字段
     mutable QMutex m_filterMutex;
+
+    //! 重复日志限流，按调用位置统计，只在 AbstractAppender::write 的锁内访问
+    struct RateBucket {
+        qint64 windowStart = 0;
+        int count = 0;
+        int suppressed = 0;
+    };
+    QHash<QPair<quintptr, int>, RateBucket> m_rateBuckets;
+    QElapsedTimer m_rateTimer;
+
+    FilterLogWriter *m_writer = nullptr;
 };
 
 #endif // FILTERAPPENDER_H
@@ -3,60 +3,122 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "dfmmediainfo.h"
+#include "dfmmediainfocache.h"
 #include "MediaInfo/MediaInfo.h"
 #include <QApplication>
-#include <QTimer>
-#include <QQueue>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QFutureWatcher>
 #include <QMutex>
+#include <QSharedPointer>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent>
 
 #define MediaInfo_State_Finished 10000
+// 同时解析媒体文件的线程数
+#define MEDIAINFO_READ_THREAD_COUNT 2
+// 解析一个文件的最长时间，超时后放弃，以免一直占用解析线程
+#define MEDIAINFO_READ_TIMEOUT 30000
+#define MEDIAINFO_READ_POLL_INTERVAL 20
 using namespace MediaInfoLib;
-Q_GLOBAL_STATIC(QQueue<MediaInfo *>, queueDestoryMediaInfo)
+Q_GLOBAL_STATIC(QThreadPool, mediaInfoThreadPool)
 
 DFM_BEGIN_NAMESPACE
+namespace {
+struct MediaInfoResult
+{
+    bool finished = false;
+    QHash<QString, QString> values;
+};
+
+// 解析完成后保存的信息，Value() 只能取得这些信息
+const QList<QPair<stream_t, QStringList>> &mediaInfoKeys()
+{
+    static const QList<QPair<stream_t, QStringList>> keys {
+        {Stream_General, {"Duration", "Format", "OverallBitRate", "Title", "Performer", "Album"}},
+        {Stream_Video, {"Duration", "Width", "Height", "Format", "CodecID", "BitRate", "FrameRate"}},
+        {Stream_Audio, {"Duration", "Format", "CodecID", "BitRate", "SamplingRate", "Channel(s)"}},
+        {Stream_Image, {"Width", "Height", "Format", "BitDepth"}}
+    };
+
+    return keys;
+}
+
+QString mediaInfoKey(int type, const QString &key)
+{
+    return QString::number(type) + '/' + key;
+}
+
+/*!
+ * \brief readMediaInfo 在解析线程中读取媒体信息，结果按文件的路径、大小和修改时间缓存
+ * \param canceled 不为0时停止解析并关闭文件
+ */
+MediaInfoResult readMediaInfo(const QString &file, const QSharedPointer<QAtomicInt> &canceled)
+{
+    MediaInfoResult result;
+    const QFileInfo info(file);
+    const qint64 size = info.size();
+    const uint modified = info.lastModified().toTime_t();
+
+    if (DFMMediaInfoCache::instance()->find(file, size, modified, &result.values)) {
+        result.finished = true;
+        return result;
+    }
+
+    if (canceled->load())
+        return result;
+
+    MediaInfo mediaInfo;
+    mediaInfo.Option(__T("Thread"), __T("1")); // open file in thread..
+    mediaInfo.Option(__T("Inform"), __T("Text"));
+    mediaInfo.Open(file.toStdWString());
+
+    QElapsedTimer timer;
+    timer.start();
+
+    while (!canceled->load() && timer.elapsed() < MEDIAINFO_READ_TIMEOUT) {
+        if (mediaInfo.State_Get() == MediaInfo_State_Finished) {
+            result.finished = true;
+            break;
+        }
+
+        QThread::msleep(MEDIAINFO_READ_POLL_INTERVAL);
+    }
+
+    if (result.finished) {
+        for (const QPair<stream_t, QStringList> &keys : mediaInfoKeys()) {
+            for (const QString &key : keys.second) {
+                const QString &value = QString::fromStdWString(mediaInfo.Get(keys.first, 0, key.toStdWString()));
+
+                if (!value.isEmpty())
+                    result.values.insert(mediaInfoKey(keys.first, key), value);
+            }
+        }
+
+        DFMMediaInfoCache::instance()->insert(file, size, modified, result.values);
+    }
+
+    // 由于当远程文件夹下存在大量图片文件时，关闭和析构mediainfo对象耗时会很长，在解析线程中完成以免造成文管卡
+    mediaInfo.Close();
+
+    return result;
+}
+} // namespace
+
 class DFMMediaInfoPrivate : public QSharedData
 {
 public:
     DFMMediaInfoPrivate(DFMMediaInfo *qq, const QString &file) : q_ptr(qq)
         , m_isStopStat(false)
+        , m_canceled(new QAtomicInt(0))
     {
-        m_isWorking.store(false);
         m_file = file;
-        m_mediaInfo = new MediaInfo;
-        m_timer = new QTimer(qq);
     }
 
     ~DFMMediaInfoPrivate()
     {
-        if (m_timer)
-            m_timer->stop();
-        if (m_mediaInfo) {
-            // 由于当远程文件夹下存在大量图片文件时，析构mediainfo对象耗时会很长，造成文管卡
-            // 所以将对象添加到队列中，开启线程去释放对象
-            static QMutex lock;
-            lock.lock();
-            queueDestoryMediaInfo->enqueue(m_mediaInfo);
-            lock.unlock();
-
-            static bool isRunning = false;
-            if (!isRunning) {
-                isRunning = true;
-                std::thread thread(
-                []() {
-                    while (!queueDestoryMediaInfo->isEmpty()) {
-                        lock.lock();
-                        MediaInfo *mediaInfo = queueDestoryMediaInfo->dequeue();
-                        lock.unlock();
-
-                        // 这里会很慢
-                        delete mediaInfo;
-                        mediaInfo = nullptr;
-                    }
-                    isRunning = false;
-                });
-                thread.detach();
-            }
-        }
+        m_canceled->store(1);
     }
 
     /**
@@ -68,54 +130,42 @@ public:
         if (m_isStopStat.load())
             return;
         Q_Q(DFMMediaInfo);
-        if (m_isWorking.load())
+        if (m_watcher)
             return;
-//        m_isWorking.store(true);
-        m_mediaInfo->Option(__T("Thread"), __T("1")); // open file in thread..
-        m_mediaInfo->Option(__T("Inform"), __T("Text"));
-        if (m_mediaInfo->Open(m_file.toStdWString()) == 0) { // 可能耗时
-            m_timer->setInterval(200);
-            m_timer->start();
-            QObject::connect(m_timer, &QTimer::timeout, q, [this]() {
-                if (m_mediaInfo) {
-                    if (m_mediaInfo->State_Get() == MediaInfo_State_Finished) {
-                        emit q_ptr->Finished();
-                        m_timer->stop();
-                        return ;
-                    }
-                    //                if (m_mediaInfo->Count_Get(Stream_Image)>0)
-                    //                    emit q_ptr->typeFinished("image");
-                    //                if (m_mediaInfo->Count_Get(Stream_Video)>0)
-                    //                    emit q_ptr->typeFinished("video");
-                    //                if (m_mediaInfo->Count_Get(Stream_Audio)>0)
-                    //                    emit q_ptr->typeFinished("audio");
-                }
-            });
-        }
-        m_isWorking.store(false);
-    }
 
-    QString Inform()
-    {
-        //m_mediaInfo->Option(__T("Inform"), __T("Text"));
-        qDebug() << "state:" << m_mediaInfo->State_Get(); // 10000 is ok?
-        QString info = QString::fromStdWString(m_mediaInfo->Inform());
-        return info;
+        QThreadPool *pool = mediaInfoThreadPool;
+        pool->setMaxThreadCount(MEDIAINFO_READ_THREAD_COUNT);
+
+        m_watcher = new QFutureWatcher<MediaInfoResult>(q);
+        QObject::connect(m_watcher, &QFutureWatcher<MediaInfoResult>::finished, q, [this]() {
+            const MediaInfoResult &result = m_watcher->result();
+
+            if (!result.finished || m_isStopStat.load())
+                return;
+
+            m_values = result.values;
+            emit q_ptr->Finished();
+        });
+
+        const QString file = m_file;
+        const QSharedPointer<QAtomicInt> canceled = m_canceled;
+        m_watcher->setFuture(QtConcurrent::run(pool, [file, canceled]() {
+            return readMediaInfo(file, canceled);
+        }));
     }
 
     QString Value(const QString &key, stream_t type)
     {
-        QString info = QString::fromStdWString(m_mediaInfo->Get(type, 0, key.toStdWString()));
-        return info;
+        return m_values.value(mediaInfoKey(type, key));
     }
 
 private:
-    std::atomic<bool>    m_isWorking;
     std::atomic<bool>    m_isStopStat;
     QMutex m_mutex;
     QString m_file;
-    MediaInfo     *m_mediaInfo {nullptr};
-    QTimer        *m_timer {nullptr};
+    QSharedPointer<QAtomicInt> m_canceled;
+    QHash<QString, QString> m_values;
+    QFutureWatcher<MediaInfoResult> *m_watcher {nullptr};
     DFMMediaInfo *q_ptr{ nullptr };
     Q_DECLARE_PUBLIC(DFMMediaInfo)
 };
@@ -132,6 +182,9 @@ DFMMediaInfo::~DFMMediaInfo()
 
 }
 
+/*!
+ * \brief DFMMediaInfo::Value 解析完成后取得媒体信息，只能取得时长、分辨率和编码等常用信息
+ */
 QString DFMMediaInfo::Value(const QString &key, MeidiaType meidiaType/* = General*/)
 {
     Q_D(DFMMediaInfo);
@@ -150,10 +203,8 @@ void DFMMediaInfo::stopReadInfo()
     Q_D(DFMMediaInfo);
     QMutexLocker lk(&d->m_mutex);
     d->m_isStopStat.store(true);
-    if (d->m_timer)
-        d->m_timer->stop();
-    if (d->m_mediaInfo)
-        d->m_mediaInfo->Close();
+    // 解析线程检查到后关闭文件
+    d->m_canceled->store(1);
 }
 
 DFM_END_NAMESPACE
@@ -0,0 +1,223 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dfmmediainfocache.h"
+#include "dfmstandardpaths.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QThread>
+#include <QThreadPool>
+#include <QVector>
+#include <QtConcurrent>
+
+#include <algorithm>
+
+// 缓存的条目数上限，超出时删除最久未访问的条目直到低于上限的 80%
+#define MEDIAINFO_CACHE_MAX_COUNT 20000
+#define MEDIAINFO_CACHE_LOW_WATER_PERCENT 80
+// 缓存变化次数达到此值时在后台保存
+#define MEDIAINFO_CACHE_SAVE_INTERVAL 100
+#define MEDIAINFO_CACHE_FILE_NAME "dfm-mediainfo.cache"
+#define MEDIAINFO_CACHE_MAGIC 0x44464d49
+#define MEDIAINFO_CACHE_VERSION 1
+
+DFM_BEGIN_NAMESPACE
+
+Q_GLOBAL_STATIC(QThreadPool, mediaInfoCacheThreadPool)
+
+static quint32 currentTime()
+{
+    return QDateTime::currentDateTimeUtc().toTime_t();
+}
+
+DFMMediaInfoCache::DFMMediaInfoCache(const QString &filePath)
+    : m_filePath(filePath)
+    , m_maxCount(MEDIAINFO_CACHE_MAX_COUNT)
+{
+    load();
+}
+
+DFMMediaInfoCache::~DFMMediaInfoCache()
+{
+    if (!mediaInfoCacheThreadPool.isDestroyed())
+        mediaInfoCacheThreadPool->waitForDone();
+
+    if (m_changeCount > 0)
+        save();
+}
+
+DFMMediaInfoCache *DFMMediaInfoCache::instance()
+{
+    static DFMMediaInfoCache cache(DFMStandardPaths::location(DFMStandardPaths::ThumbnailPath)
+                                   + QDir::separator() + MEDIAINFO_CACHE_FILE_NAME);
+
+    return &cache;
+}
+
+/*!
+ * \brief DFMMediaInfoCache::find 查找文件的媒体信息，文件大小或修改时间与缓存不一致时视为没有缓存
+ */
+bool DFMMediaInfoCache::find(const QString &path, qint64 size, uint modified, QHash<QString, QString> *values)
+{
+    QMutexLocker locker(&m_mutex);
+
+    auto it = m_entries.find(path);
+
+    if (it == m_entries.end() || it->size != size || it->modified != modified)
+        return false;
+
+    it->lastAccess = currentTime();
+
+    if (values)
+        *values = it->values;
+
+    return true;
+}
+
+void DFMMediaInfoCache::insert(const QString &path, qint64 size, uint modified, const QHash<QString, QString> &values)
+{
+    QMutexLocker locker(&m_mutex);
+
+    Entry &entry = m_entries[path];
+
+    entry.size = size;
+    entry.modified = modified;
+    entry.lastAccess = currentTime();
+    entry.values = values;
+
+    if (m_entries.count() > m_maxCount)
+        removeLeastRecentlyUsed(path);
+
+    if (++m_changeCount < MEDIAINFO_CACHE_SAVE_INTERVAL || m_saveScheduled)
+        return;
+
+    m_saveScheduled = true;
+
+    QThreadPool *pool = mediaInfoCacheThreadPool;
+    pool->setMaxThreadCount(1);
+
+    QtConcurrent::run(pool, [this] {
+        QThread::currentThread()->setPriority(QThread::IdlePriority);
+
+        save();
+
+        QMutexLocker locker(&m_mutex);
+        m_saveScheduled = false;
+    });
+}
+
+int DFMMediaInfoCache::count() const
+{
+    QMutexLocker locker(&m_mutex);
+
+    return m_entries.count();
+}
+
+void DFMMediaInfoCache::setMaxCount(int maxCount)
+{
+    QMutexLocker locker(&m_mutex);
+
+    m_maxCount = maxCount;
+
+    if (m_entries.count() > m_maxCount)
+        removeLeastRecentlyUsed();
+}
+
+bool DFMMediaInfoCache::load()
+{
+    QFile file(m_filePath);
+
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream stream(&file);
+    quint32 magic = 0;
+    quint32 version = 0;
+    qint32 count = 0;
+
+    stream >> magic >> version >> count;
+
+    if (magic != MEDIAINFO_CACHE_MAGIC || version != MEDIAINFO_CACHE_VERSION || count < 0 || count > MEDIAINFO_CACHE_MAX_COUNT * 2)
+        return false;
+
+    QHash<QString, Entry> entries;
+
+    entries.reserve(count);
+
+    for (qint32 i = 0; i < count; ++i) {
+        QString path;
+        Entry entry;
+
+        stream >> path >> entry.size >> entry.modified >> entry.lastAccess >> entry.values;
+
+        if (stream.status() != QDataStream::Ok)
+            return false;
+
+        entries.insert(path, entry);
+    }
+
+    QMutexLocker locker(&m_mutex);
+
+    m_entries = entries;
+
+    return true;
+}
+
+bool DFMMediaInfoCache::save()
+{
+    QMutexLocker locker(&m_mutex);
+    const QHash<QString, Entry> entries = m_entries;
+    m_changeCount = 0;
+    locker.unlock();
+
+    if (!QDir().mkpath(QFileInfo(m_filePath).absolutePath()))
+        return false;
+
+    QSaveFile file(m_filePath);
+
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    QDataStream stream(&file);
+
+    stream << quint32(MEDIAINFO_CACHE_MAGIC) << quint32(MEDIAINFO_CACHE_VERSION) << qint32(entries.count());
+
+    for (auto it = entries.constBegin(); it != entries.constEnd(); ++it)
+        stream << it.key() << it->size << it->modified << it->lastAccess << it->values;
+
+    return file.commit();
+}
+
+// 需持有 m_mutex，不删除 keepPath 的条目
+void DFMMediaInfoCache::removeLeastRecentlyUsed(const QString &keepPath)
+{
+    const int targetCount = m_maxCount * MEDIAINFO_CACHE_LOW_WATER_PERCENT / 100;
+
+    QVector<QPair<quint32, QString>> entries;
+    entries.reserve(m_entries.count());
+
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it)
+        entries.append(qMakePair(it->lastAccess, it.key()));
+
+    std::sort(entries.begin(), entries.end(), [](const QPair<quint32, QString> &left, const QPair<quint32, QString> &right) {
+        return left.first < right.first;
+    });
+
+    for (const QPair<quint32, QString> &entry : entries) {
+        if (m_entries.count() <= targetCount)
+            break;
+
+        if (entry.second == keepPath)
+            continue;
+
+        m_entries.remove(entry.second);
+    }
+}
+
+DFM_END_NAMESPACE
@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DFMMEDIAINFOCACHE_H
+#define DFMMEDIAINFOCACHE_H
+
+#include "dfmglobal.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+
+DFM_BEGIN_NAMESPACE
+
+/*!
+ * \brief DFMMediaInfoCache 媒体文件信息的缓存
+ *
+ * 按文件路径保存已解析的时长、分辨率等信息，文件大小或修改时间变化后缓存失效。
+ * 缓存保存在缩略图目录中，与缩略图索引一起跨进程复用，条目数超出上限时删除最久未访问的条目。
+ */
+class DFMMediaInfoCache
+{
+public:
+    explicit DFMMediaInfoCache(const QString &filePath);
+    ~DFMMediaInfoCache();
+
+    static DFMMediaInfoCache *instance();
+
+    bool find(const QString &path, qint64 size, uint modified, QHash<QString, QString> *values);
+    void insert(const QString &path, qint64 size, uint modified, const QHash<QString, QString> &values);
+
+    int count() const;
+    void setMaxCount(int maxCount);
+
+    bool load();
+    bool save();
+
+private:
+    struct Entry {
+        qint64 size = 0;
+        quint32 modified = 0;
+        quint32 lastAccess = 0;
+        QHash<QString, QString> values;
+    };
+
+    void removeLeastRecentlyUsed(const QString &keepPath = QString());
+
+    QString m_filePath;
+    QHash<QString, Entry> m_entries;
+    int m_maxCount;
+    int m_changeCount = 0;
+    bool m_saveScheduled = false;
+    mutable QMutex m_mutex;
+};
+
+DFM_END_NAMESPACE
+
+#endif // DFMMEDIAINFOCACHE_H
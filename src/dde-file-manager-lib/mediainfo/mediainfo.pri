@@ -1,8 +1,10 @@
 HEADERS += \
-    $$PWD/dfmmediainfo.h
+    $$PWD/dfmmediainfo.h \
+    $$PWD/dfmmediainfocache.h
 
 SOURCES += \
-    $$PWD/dfmmediainfo.cpp
+    $$PWD/dfmmediainfo.cpp \
+    $$PWD/dfmmediainfocache.cpp
 
 # make the 'stdlib.h' not exist errors go away when adding the setting QMAKE_CFLAGS_ISYSTEM=-I
 QMAKE_CFLAGS_ISYSTEM=-I
@@ -13,6 +13,7 @@
 #include <QFileInfo>
 #include <QStandardPaths>
 #include <QIcon>
+#include <QMimeDatabase>
 
 class AVFSFileInfoPrivate : public DAbstractFileInfoPrivate
 {
@@ -21,15 +22,178 @@ public:
         : DAbstractFileInfoPrivate(url, qq, true)
     {
     }
+
+    // 信息来自压缩包的索引，不经过 avfs
+    bool indexed = false;
+    DFMArchiveIndex::Entry entry;
 };
 
 AVFSFileInfo::AVFSFileInfo(const DUrl &avfsUrl):
     DAbstractFileInfo(*new AVFSFileInfoPrivate(avfsUrl, this))
 {
+    Q_D(AVFSFileInfo);
+
+    DFMArchiveIndex::Entry entry;
+
+    if (DFMArchiveIndex::instance()->entry(avfsUrl.path(), &entry) && canUseIndexEntry(entry)) {
+        d->indexed = true;
+        d->entry = entry;
+        return;
+    }
+
+    setProxy(DAbstractFileInfoPointer(new DFileInfo(realFileUrl(avfsUrl))));
+}
+
+AVFSFileInfo::AVFSFileInfo(const DUrl &avfsUrl, const DFMArchiveIndex::Entry &entry):
+    DAbstractFileInfo(*new AVFSFileInfoPrivate(avfsUrl, this))
+{
+    Q_D(AVFSFileInfo);
+
+    if (canUseIndexEntry(entry)) {
+        d->indexed = true;
+        d->entry = entry;
+        return;
+    }
 
     setProxy(DAbstractFileInfoPointer(new DFileInfo(realFileUrl(avfsUrl))));
 }
 
+bool AVFSFileInfo::exists() const
+{
+    Q_D(const AVFSFileInfo);
+
+    return d->indexed || DAbstractFileInfo::exists();
+}
+
+bool AVFSFileInfo::isFile() const
+{
+    Q_D(const AVFSFileInfo);
+
+    if (d->indexed)
+        return !d->entry.isDir;
+
+    return DAbstractFileInfo::isFile();
+}
+
+bool AVFSFileInfo::isSymLink() const
+{
+    Q_D(const AVFSFileInfo);
+
+    if (d->indexed)
+        return d->entry.isSymLink;
+
+    return DAbstractFileInfo::isSymLink();
+}
+
+bool AVFSFileInfo::isHidden() const
+{
+    Q_D(const AVFSFileInfo);
+
+    if (d->indexed)
+        return d->entry.name.startsWith('.');
+
+    return DAbstractFileInfo::isHidden();
+}
+
+bool AVFSFileInfo::isReadable() const
+{
+    Q_D(const AVFSFileInfo);
+
+    return d->indexed || DAbstractFileInfo::isReadable();
+}
+
+DAbstractFileInfo::FileType AVFSFileInfo::fileType() const
+{
+    Q_D(const AVFSFileInfo);
+
+    if (d->indexed)
+        return d->entry.isDir ? Directory : RegularFile;
+
+    return DAbstractFileInfo::fileType();
+}
+
+QFile::Permissions AVFSFileInfo::permissions() const
+{
+    Q_D(const AVFSFileInfo);
+
+    if (!d->indexed)
+        return DAbstractFileInfo::permissions();
+
+    // 压缩包中没有记录权限时按普通文件和目录的默认权限显示
+    const uint mode = d->entry.mode ? d->entry.mode : (d->entry.isDir ? 0755 : 0644);
+    const uint owner = (mode >> 6) & 07;
+    const uint group = (mode >> 3) & 07;
+    const uint other = mode & 07;
+
+    return QFile::Permissions((owner << 12) | (owner << 8) | (group << 4) | other);
+}
+
+qint64 AVFSFileInfo::size() const
+{
+    Q_D(const AVFSFileInfo);
+
+    if (d->indexed)
+        return d->entry.size;
+
+    return DAbstractFileInfo::size();
+}
+
+int AVFSFileInfo::filesCount() const
+{
+    Q_D(const AVFSFileInfo);
+
+    if (d->indexed)
+        return d->entry.childCount;
+
+    return DAbstractFileInfo::filesCount();
+}
+
+QDateTime AVFSFileInfo::created() const
+{
+    Q_D(const AVFSFileInfo);
+
+    if (d->indexed)
+        return lastModified();
+
+    return DAbstractFileInfo::created();
+}
+
+QDateTime AVFSFileInfo::lastModified() const
+{
+    Q_D(const AVFSFileInfo);
+
+    if (d->indexed)
+        return QDateTime::fromMSecsSinceEpoch(d->entry.lastModified * 1000);
+
+    return DAbstractFileInfo::lastModified();
+}
+
+QDateTime AVFSFileInfo::lastRead() const
+{
+    Q_D(const AVFSFileInfo);
+
+    if (d->indexed)
+        return lastModified();
+
+    return DAbstractFileInfo::lastRead();
+}
+
+QMimeType AVFSFileInfo::mimeType(QMimeDatabase::MatchMode mode) const
+{
+    Q_D(const AVFSFileInfo);
+
+    if (!d->indexed)
+        return DAbstractFileInfo::mimeType(mode);
+
+    // 读取内容需要经过 avfs 解压，只根据文件名判断
+    QMimeDatabase db;
+
+    if (d->entry.isDir)
+        return db.mimeTypeForName("inode/directory");
+
+    return db.mimeTypeForFile(d->entry.name, QMimeDatabase::MatchExtension);
+}
+
 bool AVFSFileInfo::canRename() const
 {
     return false;
@@ -78,6 +242,9 @@ bool AVFSFileInfo::canIteratorDir() const
 bool AVFSFileInfo::isDir() const
 {
     Q_D(const AVFSFileInfo);
+
+    if (d->indexed)
+        return d->entry.isDir;
     //Temporarily just support one lay arch file parser
     QString realFilePath = realFileUrl(fileUrl()).toLocalFile();
     if (FileUtils::isArchive(realFilePath)) {
@@ -148,6 +315,17 @@ DUrl AVFSFileInfo::realFileUrl(const DUrl &avfsUrl)
     return DUrl::fromLocalFile(iterPath);
 }
 
+/*!
+ * \brief AVFSFileInfo::canUseIndexEntry 压缩包中的压缩包需要通过 avfs 进入，不使用索引中的信息
+ */
+bool AVFSFileInfo::canUseIndexEntry(const DFMArchiveIndex::Entry &entry)
+{
+    if (entry.isDir)
+        return true;
+
+    return !FileUtils::isArchiveByMimetype(QMimeDatabase().mimeTypeForFile(entry.name, QMimeDatabase::MatchExtension).name());
+}
+
 DUrl AVFSFileInfo::realDirUrl(const DUrl &avfsUrl)
 {
     QString avfsPath = avfsUrl.path();
@@ -6,12 +6,28 @@
 #define AVFSFILEINFO_H
 
 #include "interfaces/dabstractfileinfo.h"
+#include "interfaces/dfmarchiveindex.h"
 
 class AVFSFileInfoPrivate;
 class AVFSFileInfo : public DAbstractFileInfo
 {
 public:
     explicit AVFSFileInfo(const DUrl &avfsUrl);
+    AVFSFileInfo(const DUrl &avfsUrl, const DFMArchiveIndex::Entry &entry);
+
+    bool exists() const override;
+    bool isFile() const override;
+    bool isSymLink() const override;
+    bool isHidden() const override;
+    bool isReadable() const override;
+    FileType fileType() const override;
+    QFile::Permissions permissions() const override;
+    qint64 size() const override;
+    int filesCount() const override;
+    QDateTime created() const override;
+    QDateTime lastModified() const override;
+    QDateTime lastRead() const override;
+    QMimeType mimeType(QMimeDatabase::MatchMode mode = QMimeDatabase::MatchDefault) const override;
 
     bool canRename() const override;
     bool isWritable() const override;
@@ -26,6 +42,7 @@ public:
 
     static DUrl realFileUrl(const DUrl &avfsUrl);
     static DUrl realDirUrl(const DUrl &avfsUrl);
+    static bool canUseIndexEntry(const DFMArchiveIndex::Entry &entry);
 protected:
     explicit AVFSFileInfo(AVFSFileInfoPrivate &dd);
 
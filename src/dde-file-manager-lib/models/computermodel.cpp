@@ -25,10 +25,12 @@
 #include "shutil/fileutils.h"
 #include "shutil/smbintegrationswitcher.h"
 #include "vault/vaulthelper.h"
+#include "io/dstorageusagecache.h"
 #include "computermodel.h"
 #include "utils.h"
 
 #include <QtConcurrent>
+#include <QTimer>
 
 //#define SPLIT_APP_ENTRY // enable it to split appentry and disks
 
@@ -45,6 +47,12 @@ ComputerModel::ComputerModel(QObject *parent)
     // 光驱事件
     connect(this, &ComputerModel::opticalChanged, this, &ComputerModel::onOpticalChanged, Qt::QueuedConnection);
 
+    // 容量在后台查询完成后刷新显示
+    connect(DFM_NAMESPACE::DStorageUsageCache::instance(), &DFM_NAMESPACE::DStorageUsageCache::usageChanged, this, [this]() {
+        if (rowCount() > 0)
+            emit dataChanged(index(0, 0), index(rowCount() - 1, 0), {DataRoles::SizeInUseRole, DataRoles::SizeTotalRole});
+    });
+
 #ifdef ENABLE_ASYNCINIT
     m_initThread.first = false;
     m_initThread.second = QtConcurrent::run([=](){
@@ -147,27 +155,29 @@ ComputerModel::ComputerModel(QObject *parent)
             }
         });
 
+        // 已经获取到根目录信息时推迟到事件循环中添加，不阻塞计算机页面的首次绘制
         if (DRootFileManager::instance()->isRootFileInited()) {
-
-            QList<DAbstractFileInfoPointer> ch = rootFileManager->getRootFile();
-            if (!g_isFileDialogMode) {
-                DFMAppEntryController appEntryController;
-                ch << appEntryController.getChildren({});
-            }
-            qDebug() << "get root file now" << ch.size();
-            rootInit(ch);
+            QTimer::singleShot(0, this, [this, rootInit]() {
+                QList<DAbstractFileInfoPointer> ch = rootFileManager->getRootFile();
+                if (!g_isFileDialogMode) {
+                    DFMAppEntryController appEntryController;
+                    ch << appEntryController.getChildren({});
+                }
+                qDebug() << "get root file now" << ch.size();
+                rootInit(ch);
 
 #ifdef ENABLE_ASYNCINIT
-            //线程退出
-            if (m_initThread.first)
-                return;
+                //线程退出
+                if (m_initThread.first)
+                    return;
 #endif
-            // 根据系统类型，判断是否启用保险柜
-            if ( VaultHelper::isVaultEnabled() ) {
-                // 保险柜
-                addItem(makeSplitterUrl(FileVault));
-                addItem(VaultController::makeVaultUrl());
-            }
+                // 根据系统类型，判断是否启用保险柜
+                if ( VaultHelper::isVaultEnabled() ) {
+                    // 保险柜
+                    addItem(makeSplitterUrl(FileVault));
+                    addItem(VaultController::makeVaultUrl());
+                }
+            });
         }
         //使用分区工具，不显示磁盘问题，再刷一次
         DRootFileManager::instance()->startQuryRootFile();
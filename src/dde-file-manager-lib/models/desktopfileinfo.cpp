@@ -11,12 +11,31 @@
 #include "shutil/fileutils.h"
 #include "interfaces/dfmstandardpaths.h"
 #include "interfaces/dfileservices.h"
+#include "interfaces/dfmmetrics.h"
 #include "interfaces/dfmstandardpaths.h"
 
 #include "singleton.h"
 
 #include <QSettings>
 #include <QLocale>
+#include <QDateTime>
+#include <QMutex>
+
+// 解析结果缓存的最大数量，超出后清空重新缓存
+#define DESKTOP_INFO_CACHE_MAX 1024
+
+namespace {
+struct DesktopInfoCacheEntry
+{
+    qint64 lastModified = -1;
+    qint64 size = -1;
+    QString locale;
+    QMap<QString, QVariant> info;
+};
+
+QMutex desktopInfoCacheMutex;
+QHash<QString, DesktopInfoCacheEntry> desktopInfoCache;
+}
 
 class DesktopFileInfoPrivate : public DFileInfoPrivate
 {
@@ -207,6 +226,24 @@ QString DesktopFileInfo::suffixOfRename() const
 
 QMap<QString, QVariant> DesktopFileInfo::getDesktopFileInfo(const DUrl &fileUrl)
 {
+    //! 桌面上的 desktop 文件在每次刷新、拖拽时都会重新创建文件信息，文件未变化时使用上次解析的结果
+    const QFileInfo fileInfo(fileUrl.path());
+    const qint64 lastModified = fileInfo.lastModified().toMSecsSinceEpoch();
+    const QString &locale = QLocale::system().name();
+
+    if (fileInfo.exists()) {
+        QMutexLocker locker(&desktopInfoCacheMutex);
+        auto it = desktopInfoCache.constFind(fileUrl.path());
+
+        if (it != desktopInfoCache.constEnd() && it->lastModified == lastModified
+                && it->size == fileInfo.size() && it->locale == locale) {
+            DFM_METRIC_INC("desktopInfo.cacheHit");
+            return it->info;
+        }
+    }
+
+    DFM_METRIC_INC("desktopInfo.cacheMiss");
+
     QMap<QString, QVariant> map;
     QSettings settings(fileUrl.path(), QSettings::IniFormat);
 
@@ -250,6 +287,20 @@ QMap<QString, QVariant> DesktopFileInfo::getDesktopFileInfo(const DUrl &fileUrl)
     map["DeepinID"] = desktop.value("X-Deepin-AppID", settings.value("X-Deepin-AppID")).toString();
     map["DeepinVendor"] = desktop.value("X-Deepin-Vendor", settings.value("X-Deepin-Vendor")).toString();
 
+    if (fileInfo.exists()) {
+        QMutexLocker locker(&desktopInfoCacheMutex);
+
+        if (desktopInfoCache.size() >= DESKTOP_INFO_CACHE_MAX)
+            desktopInfoCache.clear();
+
+        DesktopInfoCacheEntry &entry = desktopInfoCache[fileUrl.path()];
+
+        entry.lastModified = lastModified;
+        entry.size = fileInfo.size();
+        entry.locale = locale;
+        entry.info = map;
+    }
+
     return map;
 }
 
@@ -287,7 +338,7 @@ QSet<MenuAction> DesktopFileInfo::disableMenuActionList() const
     Q_D(const DesktopFileInfo);
     if (d->deepinID == "dde-trash") {
         QSet<MenuAction> actions;
-        if (FileUtils::filesCount(DFMStandardPaths::location(DFMStandardPaths::TrashFilesPath)) <= 0)
+        if (TrashManager::isEmpty())
             actions << MenuAction::ClearTrash;
         return actions;
     }
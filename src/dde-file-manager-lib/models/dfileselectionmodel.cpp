@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "dfileselectionmodel.h"
+#include "dfilesystemmodel.h"
 
 #include <QDebug>
 using namespace FileManagerSelectionModel;
@@ -51,17 +52,63 @@ QModelIndexList DFileSelectionModel::selectedIndexes() const
 {
     if (m_selectedList.isEmpty()) {
         if (m_currentCommand != QItemSelectionModel::SelectionFlags(Current | Rows | ClearAndSelect)) {
-            m_selectedList = QItemSelectionModel::selectedIndexes();
+            m_selectedList = indexesOf(QItemSelectionModel::selection());
         } else {
-            for (const QItemSelectionRange &range : m_selection) {
-                m_selectedList << range.indexes();
-            }
+            m_selectedList = indexesOf(m_selection);
         }
     }
 
     return m_selectedList;
 }
 
+/*!
+ * \brief DFileSelectionModel::indexesOf 按行区间生成选中的索引
+ *
+ * 选中的内容始终以行区间保存（全选后取消部分选中也只是拆分区间），只有在使用时才生成索引。
+ * QItemSelection::indexes() 会对每个索引调用 flags()，其中查询的重命名、写入和拖放属性在选中大量文件时非常耗时，
+ * 这里对 DFileSystemModel 只判断能否选中。
+ */
+QModelIndexList DFileSelectionModel::indexesOf(const QItemSelection &selection) const
+{
+    const DFileSystemModel *fileModel = qobject_cast<const DFileSystemModel *>(model());
+    QModelIndexList list;
+    int count = 0;
+
+    for (const QItemSelectionRange &range : selection) {
+        if (range.isValid())
+            count += range.height() * range.width();
+    }
+
+    list.reserve(count);
+
+    for (const QItemSelectionRange &range : selection) {
+        if (!range.isValid())
+            continue;
+
+        const QModelIndex &parent = range.parent();
+
+        for (int row = range.top(); row <= range.bottom(); ++row) {
+            for (int column = range.left(); column <= range.right(); ++column) {
+                const QModelIndex &index = model()->index(row, column, parent);
+
+                if (fileModel) {
+                    if (fileModel->isSelectable(index))
+                        list << index;
+
+                    continue;
+                }
+
+                const Qt::ItemFlags flags = model()->flags(index);
+
+                if (flags.testFlag(Qt::ItemIsSelectable) && flags.testFlag(Qt::ItemIsEnabled))
+                    list << index;
+            }
+        }
+    }
+
+    return list;
+}
+
 void DFileSelectionModel::select(const QItemSelection &selection, QItemSelectionModel::SelectionFlags command)
 {
     if (!command.testFlag(NoUpdate))
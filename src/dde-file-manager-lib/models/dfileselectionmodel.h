@@ -26,6 +26,7 @@ protected:
 
 private:
     void updateSelecteds();
+    QModelIndexList indexesOf(const QItemSelection &selection) const;
 
     mutable QModelIndexList m_selectedList;
 
@@ -13,6 +13,7 @@
 #include "dfmapplication.h"
 #include "dfmsettings.h"
 #include "utils.h"
+#include "io/dstorageusagecache.h"
 
 #include <dgiofile.h>
 #include <dgiofileinfo.h>
@@ -37,6 +38,10 @@
 
 DFM_USE_NAMESPACE
 
+// 容量缓存的有效时间，界面总是使用缓存的结果，过期后在后台刷新
+static constexpr int USAGE_CACHE_MAX_AGE { 5000 };
+static constexpr int USAGE_FIRST_QUERY_WAIT { 50 };
+
 QMap<QString, DiskInfoStr> DFMRootFileInfo::DiskInfoMap = QMap<QString, DiskInfoStr>();
 
 DFMRootFileInfo::DFMRootFileInfo(const DUrl &url) :
@@ -76,7 +81,6 @@ DFMRootFileInfo::DFMRootFileInfo(const DUrl &url) :
                 QString mpurl = mp->getRootFile()->path();
                 d_ptr->backer_url = mpurl;
                 d_ptr->gmnt = mp;
-                d_ptr->gfsi = mp->getRootFile()->createFileSystemInfo();
             }
         }
     } else if (suffix() == SUFFIX_UDISKS) {
@@ -499,10 +503,13 @@ QVariantHash DFMRootFileInfo::extraProperties() const
     QVariantHash ret;
     ret["fsFreeSize"] = 0;
     if (suffix() == SUFFIX_GVFSMP) {
-        if (d->gfsi) {
-            ret["fsUsed"] = d->gfsi->fsTotalBytes() - d->gfsi->fsFreeBytes();
-            ret["fsSize"] = d->gfsi->fsTotalBytes();
-            ret["fsType"] = d->gfsi->fsType();
+        if (!d->backer_url.isEmpty()) {
+            const DStorageUsageCache::Usage &usage = DStorageUsageCache::instance()->usage(d->backer_url, USAGE_CACHE_MAX_AGE);
+            if (usage.isValid()) {
+                ret["fsUsed"] = quint64(usage.bytesTotal - usage.bytesAvailable);
+                ret["fsSize"] = quint64(usage.bytesTotal);
+                ret["fsType"] = QString(usage.fileSystemType);
+            }
         }
         ret["rooturi"] = d->gmnt && d->gmnt->getRootFile() ? d->gmnt->getRootFile()->uri() : "";
         ret["mounted"] = true;
@@ -511,9 +518,12 @@ QVariantHash DFMRootFileInfo::extraProperties() const
         if (d->mps.empty()) {
             ret["fsUsed"] = ~0ULL;
         } else {
-            QStorageInfo si(d->mps.front());
-            ret["fsUsed"] = quint64(d->size) - quint64(si.bytesAvailable());
-            ret["fsFreeSize"] = quint64(si.bytesAvailable());
+            // 容量在后台查询，这里只取最近一次的结果，首次查询时稍作等待避免界面闪烁
+            const DStorageUsageCache::Usage &usage = DStorageUsageCache::instance()->usage(d->mps.front(), USAGE_CACHE_MAX_AGE,
+                                                                                          USAGE_FIRST_QUERY_WAIT);
+            const quint64 available = usage.isValid() ? quint64(usage.bytesAvailable) : 0;
+            ret["fsUsed"] = usage.isValid() ? quint64(d->size) - available : 0;
+            ret["fsFreeSize"] = available;
         }
         ret["fsSize"] = quint64(d->size);
         ret["fsType"] = d->fs;
@@ -17,7 +17,6 @@ public:
     QSharedPointer<DBlockDevice> blk;
     QSharedPointer<DBlockDevice> ctblk;
     QExplicitlySharedDataPointer<DGioMount> gmnt;
-    QExplicitlySharedDataPointer<DGioFileInfo> gfsi;
     QString backer_url;
     QByteArrayList mps; /* mountpoints */
     qulonglong size;
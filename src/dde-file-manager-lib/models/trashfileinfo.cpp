@@ -19,7 +19,7 @@
 #include "desktopfileinfo.h"
 
 #include <QMimeType>
-#include <QSettings>
+#include <QFile>
 #include <QIcon>
 
 namespace FileSortFunction {
@@ -28,6 +28,68 @@ COMPARE_FUN_DEFINE(sourceFilePath, SourceFilePath, TrashFileInfo)
 }
 
 
+/*!
+ * \brief TrashFileInfoPrivate::ensureInfo 读取 .trashinfo（只读取一次）
+ *
+ * 遍历回收站时会为每个文件创建文件信息，大部分只用来过滤隐藏文件或者一直不显示，
+ * 所以不在构造时读取，只在需要显示名称、原始路径或按删除时间排序时读取。
+ */
+void TrashFileInfoPrivate::ensureInfo() const
+{
+    QMutexLocker locker(&infoMutex);
+
+    if (infoLoaded)
+        return;
+
+    TrashFileInfoPrivate *d = const_cast<TrashFileInfoPrivate *>(this);
+
+    d->infoLoaded = true;
+    d->updateInfo();
+}
+
+/*!
+ * \brief TrashFileInfoPrivate::readTrashInfo 一次读取 .trashinfo 中的所有字段
+ *
+ * .trashinfo 只有 [Trash Info] 一个分组，直接按行解析，不需要为每个文件创建 QSettings。
+ * TagNameList 按逗号拆分，QSettings 会把含逗号的值解析为列表，多个标记时会丢失。
+ */
+bool TrashFileInfoPrivate::readTrashInfo(const QString &location, QByteArray *path, QString *deletionDate, QString *tagNameList)
+{
+    QFile file(location);
+
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    bool inGroup = false;
+
+    for (const QByteArray &rawLine : file.readAll().split('\n')) {
+        const QByteArray &line = rawLine.trimmed();
+
+        if (line.startsWith('[')) {
+            inGroup = line == "[Trash Info]";
+            continue;
+        }
+
+        const int index = line.indexOf('=');
+
+        if (!inGroup || index <= 0)
+            continue;
+
+        const QByteArray &key = line.left(index).trimmed();
+        const QByteArray &value = line.mid(index + 1).trimmed();
+
+        if (key == "Path") {
+            *path = value;
+        } else if (key == "DeletionDate") {
+            *deletionDate = QString::fromUtf8(value);
+        } else if (key == "TagNameList") {
+            *tagNameList = QString::fromUtf8(value);
+        }
+    }
+
+    return true;
+}
+
 void TrashFileInfoPrivate::updateInfo()
 {
     const QString &filePath = proxy->absoluteFilePath();
@@ -35,25 +97,22 @@ void TrashFileInfoPrivate::updateInfo()
     const QString &fileBaseName = filePath.mid(basePath.size());
 
     QString location(DFMStandardPaths::location(DFMStandardPaths::TrashInfosPath) + fileBaseName + ".trashinfo");
-    if (QFile::exists(location)) {
-        QSettings setting(location, QSettings::NativeFormat);
+    QByteArray path;
+    QString date;
+    QString tag_name_list;
 
-        setting.beginGroup("Trash Info");
-        setting.setIniCodec("utf-8");
-
-        originalFilePath = QByteArray::fromPercentEncoding(setting.value("Path").toByteArray()) + filePath.mid(basePath.size() + fileBaseName.size());
+    if (readTrashInfo(location, &path, &date, &tag_name_list)) {
+        originalFilePath = QString::fromUtf8(QByteArray::fromPercentEncoding(path)) + filePath.mid(basePath.size() + fileBaseName.size());
 
         displayName = originalFilePath.mid(originalFilePath.lastIndexOf('/') + 1);
 
-        deletionDate = QDateTime::fromString(setting.value("DeletionDate").toString(), Qt::ISODate);
+        deletionDate = QDateTime::fromString(date, Qt::ISODate);
         displayDeletionDate = deletionDate.toString(DAbstractFileInfo::dateTimeFormat());
 
         if (displayDeletionDate.isEmpty()) {
-            displayDeletionDate = setting.value("DeletionDate").toString();
+            displayDeletionDate = date;
         }
 
-        const QString &tag_name_list = setting.value("TagNameList").toString();
-
         if (!tag_name_list.isEmpty()) {
             tagNameList = tag_name_list.split(",");
         }
@@ -88,19 +147,18 @@ void TrashFileInfoPrivate::inheritParentTrashInfo()
         restPath += "/" + str;
     }
 
-    if (QFile::exists(DFMStandardPaths::location(DFMStandardPaths::TrashInfosPath) + QDir::separator() + name + ".trashinfo")) {
-        QSettings setting(DFMStandardPaths::location(DFMStandardPaths::TrashInfosPath) + QDir::separator() + name + ".trashinfo", QSettings::NativeFormat);
+    QByteArray path;
+    QString date;
+    QString tag_name_list;
 
-        setting.beginGroup("Trash Info");
-        setting.setIniCodec("utf-8");
+    if (readTrashInfo(DFMStandardPaths::location(DFMStandardPaths::TrashInfosPath) + QDir::separator() + name + ".trashinfo", &path, &date, &tag_name_list)) {
+        originalFilePath = QString::fromUtf8(QByteArray::fromPercentEncoding(path)) + restPath;
 
-        originalFilePath = QByteArray::fromPercentEncoding(setting.value("Path").toByteArray()) + restPath;
-
-        deletionDate = QDateTime::fromString(setting.value("DeletionDate").toString(), Qt::ISODate);
+        deletionDate = QDateTime::fromString(date, Qt::ISODate);
         displayDeletionDate = deletionDate.toString(DAbstractFileInfo::dateTimeFormat());
 
         if (displayDeletionDate.isEmpty()) {
-            displayDeletionDate = setting.value("DeletionDate").toString();
+            displayDeletionDate = date;
         }
     }
 }
@@ -108,8 +166,6 @@ void TrashFileInfoPrivate::inheritParentTrashInfo()
 TrashFileInfo::TrashFileInfo(const DUrl &url)
     : DAbstractFileInfo(*new TrashFileInfoPrivate(url, this))
 {
-    Q_D(TrashFileInfo);
-
     const QString &trashFilesPath = DFMStandardPaths::location(DFMStandardPaths::TrashFilesPath);
 
     if (!QDir().mkpath(trashFilesPath)) {
@@ -117,7 +173,6 @@ TrashFileInfo::TrashFileInfo(const DUrl &url)
     }
 
     setProxy(DAbstractFileInfoPointer(new DFileInfo(trashFilesPath + url.path())));
-    d->updateInfo();
 }
 
 bool TrashFileInfo::exists() const
@@ -162,6 +217,8 @@ QString TrashFileInfo::fileDisplayName() const
         DesktopFileInfo dfi(f);
         return dfi.fileDisplayName();
     }
+
+    d->ensureInfo();
     return d->displayName;
 }
 
@@ -268,6 +325,10 @@ QList<int> TrashFileInfo::userColumnRoles() const
 QVariant TrashFileInfo::userColumnData(int userColumnRole) const
 {
     Q_D(const TrashFileInfo);
+
+    if (userColumnRole > DFileSystemModel::FileUserRole && userColumnRole <= DFileSystemModel::FileUserRole + 4)
+        d->ensureInfo();
+
     if (userColumnRole == DFileSystemModel::FileUserRole + 1) {
         QString sourcePath;
         if (d->originalFilePath.isEmpty()) {
@@ -399,6 +460,7 @@ bool TrashFileInfo::makeAbsolute()
 DUrl TrashFileInfo::originUrl() const
 {
     Q_D(const TrashFileInfo);
+    d->ensureInfo();
 
     return DUrl::fromLocalFile(d->originalFilePath);
 }
@@ -466,6 +528,7 @@ DAbstractFileInfo::CompareFunction TrashFileInfo::compareFunByColumn(int columnR
 bool TrashFileInfo::restore(QSharedPointer<FileJob> job) const
 {
     Q_D(const TrashFileInfo);
+    d->ensureInfo();
 
     if (d->originalFilePath.isEmpty()) {
         qDebug() << "OriginalFile path ie empty.";
@@ -499,6 +562,7 @@ bool TrashFileInfo::restore(QSharedPointer<FileJob> job) const
 QDateTime TrashFileInfo::deletionDate() const
 {
     Q_D(const TrashFileInfo);
+    d->ensureInfo();
 
     return d->deletionDate;
 }
@@ -506,6 +570,7 @@ QDateTime TrashFileInfo::deletionDate() const
 QString TrashFileInfo::sourceFilePath() const
 {
     Q_D(const TrashFileInfo);
+    d->ensureInfo();
 
     return d->originalFilePath;
 }
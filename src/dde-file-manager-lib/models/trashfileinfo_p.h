@@ -7,7 +7,8 @@
 
 #include "private/dabstractfileinfo_p.h"
 #include "trashfileinfo.h"
-#
+
+#include <QMutex>
 
 class TrashFileInfoPrivate : public DAbstractFileInfoPrivate
 {
@@ -25,8 +26,15 @@ public:
     QDateTime deletionDate;
     QStringList tagNameList;
 
+    // .trashinfo 在第一次用到显示名称、原始路径、删除时间等信息时才读取
+    mutable QMutex infoMutex;
+    bool infoLoaded = false;
+
+    void ensureInfo() const;
     void updateInfo();
     void inheritParentTrashInfo();
+
+    static bool readTrashInfo(const QString &location, QByteArray *path, QString *deletionDate, QString *tagNameList);
 };
 
 
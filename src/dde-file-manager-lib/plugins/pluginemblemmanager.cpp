@@ -11,9 +11,9 @@ PluginEmblemManager *PluginEmblemManager::instance()
     return &instance;
 }
 
-void PluginEmblemManager::getPluginEmblemIconsFromMap(const DUrl &fileUrl, int systemIconCount, QList<QIcon> &icons)
+void PluginEmblemManager::getPluginEmblemIconsFromMap(const DUrl &fileUrl, int systemIconCount, QList<QIcon> &icons, uint modified)
 {
-    d->getPluginEmblemIconsFromMap(fileUrl, systemIconCount, icons);
+    d->getPluginEmblemIconsFromMap(fileUrl, systemIconCount, icons, modified);
 }
 
 void PluginEmblemManager::clearEmblemIconsMap()
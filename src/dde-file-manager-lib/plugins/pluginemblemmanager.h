@@ -16,8 +16,8 @@ class PluginEmblemManager : public QObject
     Q_OBJECT
 public:
     static PluginEmblemManager *instance();
-    // 从缓存获取插件角标
-    void getPluginEmblemIconsFromMap(const DUrl &fileUrl, int systemIconCount, QList<QIcon> &icons);
+    // 从缓存获取插件角标，缓存不存在或已过期时在子线程中向插件获取，获取完成后发送 updatePluginEmblem
+    void getPluginEmblemIconsFromMap(const DUrl &fileUrl, int systemIconCount, QList<QIcon> &icons, uint modified = 0);
     // 清空缓存的角标
     void clearEmblemIconsMap();
 
@@ -41,6 +41,7 @@ void PluginManager::loadPlugin()
 {
     Q_D(PluginManager);
     QStringList pluginChildDirs;
+    d->pluginsLoaded = true;
     d->expandInfoInterfaces.clear();
     d->viewInterfaces.clear();
     d->previewInterfaces.clear();
@@ -85,33 +86,46 @@ void PluginManager::loadPlugin()
     qDebug() << "view size:" << d->viewInterfaces.size();
 }
 
+void PluginManager::ensurePluginsLoaded()
+{
+    Q_D(PluginManager);
+
+    if (!d->pluginsLoaded)
+        loadPlugin();
+}
+
 QList<PropertyDialogExpandInfoInterface *> PluginManager::getExpandInfoInterfaces()
 {
     Q_D(PluginManager);
+    ensurePluginsLoaded();
     return d->expandInfoInterfaces;
 }
 
 QList<ViewInterface *> PluginManager::getViewInterfaces()
 {
     Q_D(PluginManager);
+    ensurePluginsLoaded();
     return d->viewInterfaces;
 }
 
 QMap<QString, ViewInterface *> PluginManager::getViewInterfacesMap()
 {
     Q_D(PluginManager);
+    ensurePluginsLoaded();
     return d->viewInterfacesMap;
 }
 
 QList<PreviewInterface *> PluginManager::getPreviewInterfaces()
 {
     Q_D(PluginManager);
+    ensurePluginsLoaded();
     return d->previewInterfaces;
 }
 
 ViewInterface *PluginManager::getViewInterfaceByScheme(const QString &scheme)
 {
     Q_D(PluginManager);
+    ensurePluginsLoaded();
     if (d->viewInterfacesMap.contains(scheme)) {
         return d->viewInterfacesMap.value(scheme);
     }
@@ -24,6 +24,8 @@ public:
     QList<ViewInterface*> viewInterfaces;
     QMap<QString, ViewInterface*> viewInterfacesMap;
     QList<PreviewInterface*> previewInterfaces;
+    // 插件在第一次使用时才加载
+    bool pluginsLoaded = false;
 
 private:
     PluginManager* q_ptr {nullptr};
@@ -59,6 +61,8 @@ private:
     explicit PluginManager(QObject *parent = nullptr);
     ~PluginManager();
 
+    void ensurePluginsLoaded();
+
     QScopedPointer<PluginManagerPrivate> d_ptr;
     Q_DECLARE_PRIVATE(PluginManager)
 };
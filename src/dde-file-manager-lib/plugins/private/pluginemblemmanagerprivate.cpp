@@ -13,14 +13,27 @@
 #include <QTimerEvent>
 #include <QApplication>
 #include <QTimer>
+#include <QDateTime>
 
 static const int kEmblemUpdateTime { 300 };
+// 每次从队列中取出并向插件获取角标的文件个数
+static const int kEmblemBatchSize { 64 };
+// 缓存的角标超过此时间(ms)后，绘制时重新向插件获取，获取完成前继续使用缓存
+static const int kEmblemExpireTime { 3000 };
+// 缓存的文件个数上限，超出时清空缓存
+static const int kEmblemCacheMaxCount { 10000 };
 
 USING_DFMEXT_NAMESPACE
 
 PluginEmblemManagerPrivate::PluginEmblemManagerPrivate(PluginEmblemManager *qq)
     : q(qq)
 {
+    // 在主线程中创建通知定时器，子线程中只通过invokeMethod启动
+    updateTimer = new QTimer(this);
+    updateTimer->setSingleShot(true);
+    updateTimer->setInterval(kEmblemUpdateTime);
+    connect(updateTimer, &QTimer::timeout, this, &PluginEmblemManagerPrivate::updateTimerTimeout);
+
     // 开启获取插件角标线程
     startWork();
     // 运行时增加插件，恢复线程刷新角标
@@ -47,33 +60,47 @@ PluginEmblemManagerPrivate::~PluginEmblemManagerPrivate()
     }
 }
 
-void PluginEmblemManagerPrivate::getPluginEmblemIconsFromMap(const DUrl &fileUrl, int systemIconCount, QList<QIcon> &icons)
+void PluginEmblemManagerPrivate::getPluginEmblemIconsFromMap(const DUrl &fileUrl, int systemIconCount, QList<QIcon> &icons, uint modified)
 {
     // 如果插件中没有实现角标类，直接返回
     if (!bHaveEmblemObj)
         return;
 
-    // 获取插件角标前，更新下缓存的角标
-    asyncUpdateEmblemIconsFromPlugin(fileUrl, systemIconCount);
+    // 此函数在绘制时调用，只读取缓存，不直接调用插件接口
+    const QString &strFilePath = fileUrl.toLocalFile();
+    QStringList listPath;
+    bool bNeedUpdate = true;
 
-    QString strFilePath = fileUrl.toLocalFile();
-    if (mapIcons.contains(strFilePath)) {
-        QList<QIcon> newIcons = {QIcon(), QIcon(), QIcon(), QIcon()};
-        for (int i = 0; i < qMin(kMaxEmblemCount, icons.size()); ++i) {
-            newIcons[i] = icons.at(i);
-        }
-        QList<QString> listPath = mapIcons[strFilePath];
-        for (int i = systemIconCount; i < kMaxEmblemCount; ++i) {
-            if (!listPath[i].isEmpty()) {
-                // 优先从主题中拿角标，如果主题中没有，则认为是本地路径
-                QIcon icon = QIcon::fromTheme(listPath[i]);
-                if (!icon.isNull()) {
-                    newIcons[i] = icon;
-                }
+    mutexMap.lock();
+    auto it = mapIcons.constFind(strFilePath);
+    if (it != mapIcons.constEnd()) {
+        listPath = it->icons;
+        bNeedUpdate = it->modified != modified || it->systemIconCount != systemIconCount
+                || QDateTime::currentMSecsSinceEpoch() - it->updateTime > kEmblemExpireTime;
+    }
+    mutexMap.unlock();
+
+    // 缓存不存在或已过期时，在子线程中更新缓存的角标，更新完成后再刷新视图
+    if (bNeedUpdate)
+        asyncUpdateEmblemIconsFromPlugin(strFilePath, systemIconCount, modified);
+
+    if (listPath.isEmpty())
+        return;
+
+    QList<QIcon> newIcons = {QIcon(), QIcon(), QIcon(), QIcon()};
+    for (int i = 0; i < qMin(kMaxEmblemCount, icons.size()); ++i) {
+        newIcons[i] = icons.at(i);
+    }
+    for (int i = systemIconCount; i < kMaxEmblemCount; ++i) {
+        if (!listPath[i].isEmpty()) {
+            // 优先从主题中拿角标，如果主题中没有，则认为是本地路径
+            QIcon icon = QIcon::fromTheme(listPath[i]);
+            if (!icon.isNull()) {
+                newIcons[i] = icon;
             }
         }
-        icons = newIcons;
     }
+    icons = newIcons;
 }
 
 void PluginEmblemManagerPrivate::clearEmblemIconsMap()
@@ -83,16 +110,23 @@ void PluginEmblemManagerPrivate::clearEmblemIconsMap()
     mutexMap.unlock();
 }
 
-void PluginEmblemManagerPrivate::asyncUpdateEmblemIconsFromPlugin(const DUrl &fileUrl, int systemIconCount)
+void PluginEmblemManagerPrivate::asyncUpdateEmblemIconsFromPlugin(const QString &filePath, int systemIconCount, uint modified)
 {
-    QPair<QString, int> pair(fileUrl.toLocalFile(), systemIconCount);
-    if (!filePathQueue.contains(pair)) {
-        mutexQueue.lock();
-        filePathQueue.enqueue(pair);
-        mutexQueue.unlock();
-        pathQueueNotEmpty.wakeAll();
+    if (systemIconCount >= kMaxEmblemCount)
+        return;
 
+    mutexQueue.lock();
+    // 文件已在队列中时不再重复排队
+    if (!pendingFilePaths.contains(filePath)) {
+        PluginEmblemRequest request;
+        request.filePath = filePath;
+        request.systemIconCount = systemIconCount;
+        request.modified = modified;
+        pendingFilePaths.insert(filePath);
+        filePathQueue.enqueue(request);
+        pathQueueNotEmpty.wakeAll();
     }
+    mutexQueue.unlock();
 }
 
 void PluginEmblemManagerPrivate::run()
@@ -110,9 +144,7 @@ void PluginEmblemManagerPrivate::run()
     }
 
     while (bWork) {
-        QPair<QString, int> data;
-        data.first = "";
-        data.second = -1;
+        QList<PluginEmblemRequest> requests;
         mutexQueue.lock();
         while (filePathQueue.isEmpty()) {
             if (!bWork) {
@@ -121,31 +153,38 @@ void PluginEmblemManagerPrivate::run()
             }
             pathQueueNotEmpty.wait(&mutexQueue);
         }
-        data = filePathQueue.dequeue();
+        // 一次取出一批文件，获取完成后统一写入缓存并通知刷新
+        while (!filePathQueue.isEmpty() && requests.size() < kEmblemBatchSize)
+            requests.append(filePathQueue.dequeue());
         mutexQueue.unlock();
-        if (data.first == "" || data.second == -1)
-            continue;
-
-        // 角标总数小于kMaxEmblemCount时，加载插件角标
-        if (data.second < kMaxEmblemCount) {
-
-            QStringList newIcons = {QString(), QString(), QString(), QString()};
-            bool bHaveIcon = false;
-
-            // 遍历角标插件对象
-            for (auto plugin : DFMExtPluginManager::instance().emblemIcons()) {
-                if (!plugin)
-                    continue;
-                // 获得插件中通过emblemIcons接口设置的角标
-                getEmblemIcons(plugin, data, bHaveIcon, newIcons);
-                // 获取插件中通过locationEmblemIcons接口设置的角标
-                getLocationEmblemIcons(plugin, data, bHaveIcon, newIcons);
-            }
 
-            // 将从插件中拿到的角标缓存到容器
-            cacheEmblemToMap(bHaveIcon, data, newIcons);
+        updateEmblemIconsFromPlugin(requests);
+    }
+}
+
+void PluginEmblemManagerPrivate::updateEmblemIconsFromPlugin(const QList<PluginEmblemRequest> &requests)
+{
+    QList<QStringList> listIcons;
+
+    for (const PluginEmblemRequest &data : requests) {
+        QStringList newIcons = {QString(), QString(), QString(), QString()};
+        bool bHaveIcon = false;
+
+        // 遍历角标插件对象
+        for (auto plugin : DFMExtPluginManager::instance().emblemIcons()) {
+            if (!plugin)
+                continue;
+            // 获得插件中通过emblemIcons接口设置的角标
+            getEmblemIcons(plugin, data, bHaveIcon, newIcons);
+            // 获取插件中通过locationEmblemIcons接口设置的角标
+            getLocationEmblemIcons(plugin, data, bHaveIcon, newIcons);
         }
+
+        listIcons.append(bHaveIcon ? newIcons : QStringList());
     }
+
+    // 将从插件中拿到的角标缓存到容器
+    cacheEmblemToMap(requests, listIcons);
 }
 
 void PluginEmblemManagerPrivate::startWork()
@@ -164,15 +203,15 @@ void PluginEmblemManagerPrivate::stopWork()
     wait();
 }
 
-void PluginEmblemManagerPrivate::getEmblemIcons(QSharedPointer<DFMExtEmblemIconPlugin> plugin, const QPair<QString, int> &data,
+void PluginEmblemManagerPrivate::getEmblemIcons(QSharedPointer<DFMExtEmblemIconPlugin> plugin, const PluginEmblemRequest &data,
                                                    bool &bHaveIcon, QStringList &newIcons)
 {
-    DFMExtEmblemIconPlugin::IconsType emblems = plugin->emblemIcons(data.first.toStdString());
+    DFMExtEmblemIconPlugin::IconsType emblems = plugin->emblemIcons(data.filePath.toStdString());
     if (!emblems.empty()) {
         bHaveIcon = true;
         size_t len = emblems.size() < kMaxEmblemCount ? emblems.size() : kMaxEmblemCount;
         for (int i = 0, pos = 0; i < static_cast<int>(len); ++i) {
-            pos = data.second + i;
+            pos = data.systemIconCount + i;
             if (pos < newIcons.size()) {
                 QString iconPath = QString::fromStdString(emblems[static_cast<size_t>(i)]);
                 if (!iconPath.isEmpty()) {
@@ -183,9 +222,9 @@ void PluginEmblemManagerPrivate::getEmblemIcons(QSharedPointer<DFMExtEmblemIconP
     }
 }
 
-void PluginEmblemManagerPrivate::getLocationEmblemIcons(QSharedPointer<DFMExtEmblemIconPlugin> plugin, const QPair<QString, int> &data, bool &bHaveIcon, QStringList &newIcons)
+void PluginEmblemManagerPrivate::getLocationEmblemIcons(QSharedPointer<DFMExtEmblemIconPlugin> plugin, const PluginEmblemRequest &data, bool &bHaveIcon, QStringList &newIcons)
 {
-    DFMExtEmblem icon = plugin->locationEmblemIcons(data.first.toStdString(), data.second);
+    DFMExtEmblem icon = plugin->locationEmblemIcons(data.filePath.toStdString(), data.systemIconCount);
     std::vector<DFMExtEmblemIconLayout> veIcon = icon.emblems();
     if (!veIcon.empty()) { // 拿到了角标
         bHaveIcon = true;
@@ -203,41 +242,37 @@ void PluginEmblemManagerPrivate::getLocationEmblemIcons(QSharedPointer<DFMExtEmb
     }
 }
 
-void PluginEmblemManagerPrivate::cacheEmblemToMap(bool &bHaveIcon, const QPair<QString, int> &data, const QStringList &newIcons)
+void PluginEmblemManagerPrivate::cacheEmblemToMap(const QList<PluginEmblemRequest> &requests, const QList<QStringList> &newIcons)
 {
-    if (bHaveIcon) {
-        bool bSame = true;
-        mutexMap.lock();
-        if (mapIcons.contains(data.first)) {
-            QStringList oldIcons = mapIcons[data.first];
-            int size = oldIcons.size();
-            for (int i = 0; i < size; ++i) {
-                if (oldIcons[i] != newIcons[i]) {
-                    bSame = false;
-                    mapIcons.insert(data.first, newIcons);
-                    break;
-                }
-            }
-        } else {
-            mapIcons.insert(data.first, newIcons);
+    bool bSame = true;
+    const qint64 updateTime = QDateTime::currentMSecsSinceEpoch();
+
+    mutexMap.lock();
+    if (mapIcons.size() + requests.size() > kEmblemCacheMaxCount)
+        mapIcons.clear();
+
+    for (int i = 0; i < requests.size(); ++i) {
+        const PluginEmblemRequest &data = requests.at(i);
+        PluginEmblemCache &cache = mapIcons[data.filePath];
+        // 没有设置过角标的文件也缓存结果，避免每次绘制都向插件获取
+        if (cache.icons != newIcons.at(i))
             bSame = false;
-        }
-        mutexMap.unlock();
-
-        // 插件角标有变化，通知更新
-        if (!bSame) {
-            if (updateTimer) {
-                QMetaObject::invokeMethod(updateTimer, "start", Qt::QueuedConnection);
-            } else {
-                updateTimer = new QTimer(this);
-                updateTimer->moveToThread(qApp->thread());
-                updateTimer->setSingleShot(true);
-                updateTimer->setInterval(kEmblemUpdateTime);
-                connect(updateTimer, &QTimer::timeout, this, &PluginEmblemManagerPrivate::updateTimerTimeout);
-                QMetaObject::invokeMethod(updateTimer, "start", Qt::QueuedConnection);
-            }
-        }
+        cache.modified = data.modified;
+        cache.systemIconCount = data.systemIconCount;
+        cache.updateTime = updateTime;
+        cache.icons = newIcons.at(i);
     }
+    mutexMap.unlock();
+
+    // 缓存写入后再移出队列，避免写入前绘制时重复排队
+    mutexQueue.lock();
+    for (const PluginEmblemRequest &data : requests)
+        pendingFilePaths.remove(data.filePath);
+    mutexQueue.unlock();
+
+    // 插件角标有变化，通知更新
+    if (!bSame)
+        QMetaObject::invokeMethod(updateTimer, "start", Qt::QueuedConnection);
 }
 
 void PluginEmblemManagerPrivate::setFilePath(const QString &iconPath, QStringList &newIcons, int index)
@@ -10,6 +10,8 @@
 
 #include <QThread>
 #include <QQueue>
+#include <QHash>
+#include <QSet>
 #include <QMutex>
 #include <QWaitCondition>
 
@@ -19,6 +21,26 @@ END_DFMEXT_NAMESPACE
 
 class QTimer;
 class PluginEmblemManager;
+
+// 插件角标的缓存，文件修改时间或系统角标个数变化后重新向插件获取
+struct PluginEmblemCache
+{
+    uint modified = 0;
+    int systemIconCount = -1;
+    // 向插件获取角标的时间，超过一定时间后重新获取
+    qint64 updateTime = 0;
+    // 为空时表示插件没有为此文件设置角标
+    QStringList icons;
+};
+
+// 待向插件获取角标的文件
+struct PluginEmblemRequest
+{
+    QString filePath;
+    int systemIconCount = -1;
+    uint modified = 0;
+};
+
 class PluginEmblemManagerPrivate : public QThread
 {
     Q_OBJECT
@@ -27,7 +49,7 @@ public:
     ~PluginEmblemManagerPrivate() override;
 
     // 从缓存获取插件角标
-    void getPluginEmblemIconsFromMap(const DUrl &fileUrl, int systemIconCount, QList<QIcon> &icons);
+    void getPluginEmblemIconsFromMap(const DUrl &fileUrl, int systemIconCount, QList<QIcon> &icons, uint modified);
 
     // 清空缓存的角标
     void clearEmblemIconsMap();
@@ -40,18 +62,20 @@ private slots:
 
 private:
     // 异步调用插件接口更新角标
-    void asyncUpdateEmblemIconsFromPlugin(const DUrl &fileUrl, int systemIconCount);
+    void asyncUpdateEmblemIconsFromPlugin(const QString &filePath, int systemIconCount, uint modified);
     void run() override;
     void startWork();
     void stopWork();
     // 获得插件中通过emblemIcons接口设置的角标
-    void getEmblemIcons(QSharedPointer<DFMEXT::DFMExtEmblemIconPlugin> plugin, const QPair<QString, int> &data,
+    void getEmblemIcons(QSharedPointer<DFMEXT::DFMExtEmblemIconPlugin> plugin, const PluginEmblemRequest &data,
                                 bool &bHaveIcon, QStringList &newIcons);
     // 获取插件中通过locationEmblemIcons接口设置的角标
-    void getLocationEmblemIcons(QSharedPointer<DFMEXT::DFMExtEmblemIconPlugin> plugin, const QPair<QString, int> &data,
+    void getLocationEmblemIcons(QSharedPointer<DFMEXT::DFMExtEmblemIconPlugin> plugin, const PluginEmblemRequest &data,
                                   bool &bHaveIcon, QStringList &newIcons);
-    // 将从插件中获取到的角标缓存到容器
-    void cacheEmblemToMap(bool &bHaveIcon, const QPair<QString, int> &data, const QStringList &newIcons);
+    // 向插件获取一批文件的角标
+    void updateEmblemIconsFromPlugin(const QList<PluginEmblemRequest> &requests);
+    // 将从插件中获取到的一批角标缓存到容器
+    void cacheEmblemToMap(const QList<PluginEmblemRequest> &requests, const QList<QStringList> &newIcons);
     // 设置文件路径
     void setFilePath(const QString &iconPath, QStringList &newIcons, int index);
 
@@ -59,9 +83,10 @@ private:
     PluginEmblemManager *const q {};
     friend class PluginEmblemManager;
     // 缓存角标路径（key:文件路径  value:角标路径）
-    QMap<QString, QStringList> mapIcons {};
-    // 缓存文件路径
-    QQueue<QPair<QString, int>> filePathQueue {};
+    QHash<QString, PluginEmblemCache> mapIcons {};
+    // 缓存待获取角标的文件，同一文件只排队一次
+    QQueue<PluginEmblemRequest> filePathQueue {};
+    QSet<QString> pendingFilePaths {};
     bool bWork { false };
     mutable QMutex mutexMap;
     mutable QMutex mutexQueue;
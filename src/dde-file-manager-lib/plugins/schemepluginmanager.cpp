@@ -22,6 +22,11 @@ QString SchemePluginManager::schemePluginDir()
 }
 void SchemePluginManager::loadSchemePlugin()
 {
+    // 只加载一次，重复加载会重复添加插件
+    if (schemePluginLoaded)
+        return;
+    schemePluginLoaded = true;
+
     qWarning() << schemePluginDir();
     QDir pluginDir(schemePluginDir());
     qWarning() << pluginDir.entryList(QDir::Files);
@@ -48,5 +53,7 @@ void SchemePluginManager::unloadSchemePlugin(QString schemeName)
 }
 SchemePluginList SchemePluginManager::schemePlugins()
 {
+    // 第一次使用时才加载插件
+    loadSchemePlugin();
     return schemePluginList;
 }
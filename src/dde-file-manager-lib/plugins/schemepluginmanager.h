@@ -28,6 +28,7 @@ private:
 
     SchemePluginList schemePluginList;
     SchemePluginPathList schemePluginPahtList;
+    bool schemePluginLoaded = false;
 };
 
 #endif // SCHEMEPLUGINMANAGER_H
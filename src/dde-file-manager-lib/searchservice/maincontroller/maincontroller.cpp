@@ -4,17 +4,52 @@
 
 #include "maincontroller.h"
 #include "fulltext/fulltextsearcher.h"
+#include "dfmapplication.h"
+#include "interfaces/dfileservices.h"
+#include "interfaces/dfilesystemwatcher.h"
 
 #include <QFileSystemWatcher>
+#include <QLockFile>
 #include <QApplication>
 #include <QtConcurrent>
+#include <QStandardPaths>
+#include <QTimer>
 #include <QUrl>
 #include <QDir>
 #include <QDebug>
 
+namespace {
+static int kIndexUpdateDelay = 5000;   // 文件变化后更新全文索引的延迟（ms）
+static int kMaxSessionCount = 8;   // 保留最近搜索结果的目录数量上限
+static int kMaxSessionResults = 100000;   // 每个目录保留的搜索结果数量上限
+static int kIndexMaintainerRetryInterval = 60 * 1000;   // 未能成为索引维护者时重试的间隔（ms）
+}
+
+/*!
+ * \brief indexMaintainerLock 同一用户的多个进程（文管、桌面等）共用磁盘上的全文索引，只由持有此锁的进程维护
+ *
+ * 锁在进程退出时释放，进程内的所有 MainController 共用。
+ */
+static QLockFile *indexMaintainerLock()
+{
+    static QLockFile *lock = [] {
+        const QString &configPath = QStandardPaths::standardLocations(QStandardPaths::ConfigLocation).first()
+                + "/deepin/dde-file-manager";
+        QDir().mkpath(configPath);
+
+        static QLockFile file(configPath + "/index-maintainer.lock");
+        // 持有锁的进程一直运行，锁不会因时间过期，持有锁的进程不存在时其它进程可以接手
+        file.setStaleLockTime(0);
+        return &file;
+    }();
+
+    return lock;
+}
+
 MainController::MainController(QObject *parent)
     : QObject(parent)
 {
+    initIndexUpdater();
 }
 
 MainController::~MainController()
@@ -36,6 +71,8 @@ void MainController::stop(QString taskId)
         taskManager[taskId] = nullptr;
         taskManager.remove(taskId);
     }
+
+    taskSessions.remove(taskId);
 }
 
 bool MainController::doSearchTask(QString taskId, const DUrl &url, const QString &keyword)
@@ -52,20 +89,85 @@ bool MainController::doSearchTask(QString taskId, const DUrl &url, const QString
     connect(task, &TaskCommander::matched, this, &MainController::matched, Qt::DirectConnection);
     connect(task, &TaskCommander::finished, this, &MainController::onFinished, Qt::DirectConnection);
 
+    // 关键字在上一次的基础上变长时，先从上一次的结果中过滤出结果，完整的搜索在后台继续
+    TaskSession &session = taskSessions[taskId];
+    session.url = url;
+    session.pending = refineResults(url, keyword);
+    session.delivered = session.pending.toSet();
+    if (!session.pending.isEmpty())
+        emit matched(taskId);
+
     if (task->start())
         return true;
 
     qWarning() << "fail to start task " << task << task->taskID();
+    taskSessions.remove(taskId);
     task->deleteSelf();
     return false;
 }
 
 QList<DUrl> MainController::getResults(QString taskId)
 {
-    if (taskManager.contains(taskId))
-        return taskManager[taskId]->getResults();
+    auto it = taskSessions.find(taskId);
+    if (it == taskSessions.end()) {
+        if (taskManager.contains(taskId))
+            return taskManager[taskId]->getResults();
+
+        return {};
+    }
+
+    QList<DUrl> results = std::move(it->pending);
+    it->pending.clear();
+
+    if (taskManager.contains(taskId)) {
+        QList<DUrl> newResults;
+        for (const DUrl &url : taskManager[taskId]->getResults()) {
+            // 已从上一次的结果中给出
+            if (!it->delivered.contains(url))
+                newResults << url;
+        }
 
-    return {};
+        auto session = searchSessions.find(it->url);
+        if (session != searchSessions.end() && session->results.count() < kMaxSessionResults)
+            session->results += newResults;
+
+        results += newResults;
+    }
+
+    return results;
+}
+
+/*!
+ * \brief MainController::refineResults 记录 url 目录的本次搜索，关键字包含上一次的关键字时返回从上一次结果中过滤出的结果
+ *
+ * 文件名包含新关键字时必然包含旧关键字，因此过滤出的结果是完整结果的子集。
+ * 带通配符的关键字无法这样判断，桌面文件等显示名称与文件名不同的结果也不参与过滤，都只由完整的搜索给出。
+ */
+QList<DUrl> MainController::refineResults(const DUrl &url, const QString &keyword)
+{
+    auto isWildcard = [](const QString &key) {
+        return key.contains('*') || key.contains('?');
+    };
+
+    QList<DUrl> results;
+    auto it = searchSessions.find(url);
+    if (it != searchSessions.end() && !it->keyword.isEmpty() && !isWildcard(it->keyword) && !isWildcard(keyword)
+            && keyword.contains(it->keyword, Qt::CaseInsensitive)) {
+        for (const DUrl &result : it->results) {
+            const QString &fileName = result.fileName();
+            if (!fileName.endsWith(".desktop") && fileName.contains(keyword, Qt::CaseInsensitive))
+                results << result;
+        }
+    }
+
+    if (it == searchSessions.end() && searchSessions.count() >= kMaxSessionCount)
+        searchSessions.erase(searchSessions.begin());
+
+    SearchSession &session = searchSessions[url];
+    session.keyword = keyword;
+    session.results = results;
+
+    return results;
 }
 
 void MainController::createFullTextIndex()
@@ -78,6 +180,127 @@ void MainController::createFullTextIndex()
     }
 }
 
+/*!
+ * \brief MainController::initIndexUpdater 监听文件的变化，及时更新全文索引
+ *
+ * 文管自身的文件操作和常用目录中的文件变化会在防抖后更新到索引中，其它位置的变化由搜索前定期的完整检查发现。
+ */
+void MainController::initIndexUpdater()
+{
+    indexUpdateTimer = new QTimer(this);
+    indexUpdateTimer->setSingleShot(true);
+    indexUpdateTimer->setInterval(kIndexUpdateDelay);
+    connect(indexUpdateTimer, &QTimer::timeout, this, &MainController::updateFullTextIndex);
+
+    DFileService *service = DFileService::instance();
+    connect(service, &DFileService::fileCopied, this, [this](const DUrl &, const DUrl &target) {
+        addChangedFile(target);
+    });
+    connect(service, &DFileService::fileDeleted, this, [this](const DUrl &url) {
+        addChangedFile(url);
+    });
+    connect(service, &DFileService::fileMovedToTrash, this, [this](const DUrl &from, const DUrl &) {
+        addChangedFile(from);
+    });
+    connect(service, &DFileService::fileRenamed, this, [this](const DUrl &from, const DUrl &to) {
+        addChangedFile(from);
+        addChangedFile(to);
+    });
+
+    fileWatcher = new DFileSystemWatcher(this);
+    connect(fileWatcher, &DFileSystemWatcher::fileCreated, this, &MainController::onFileChanged);
+    connect(fileWatcher, &DFileSystemWatcher::fileDeleted, this, &MainController::onFileChanged);
+    connect(fileWatcher, &DFileSystemWatcher::fileClosed, this, &MainController::onFileChanged);
+    connect(fileWatcher, &DFileSystemWatcher::fileMoved, this, [this](const QString &fromPath, const QString &fromName,
+                                                                     const QString &toPath, const QString &toName) {
+        onFileChanged(fromPath, fromName);
+        if (!toPath.isEmpty())
+            onFileChanged(toPath, toName);
+    });
+
+    indexMaintainerTimer = new QTimer(this);
+    indexMaintainerTimer->setInterval(kIndexMaintainerRetryInterval);
+    connect(indexMaintainerTimer, &QTimer::timeout, this, &MainController::isIndexMaintainer);
+
+    if (!isIndexMaintainer())
+        indexMaintainerTimer->start();
+}
+
+/*!
+ * \brief MainController::isIndexMaintainer 当前进程是否负责维护全文索引
+ *
+ * 第一次成为维护者时开始监听常用目录的文件变化。其它进程不监听文件变化，也不写入索引，
+ * 搜索时读取的是维护者更新后的同一份索引。维护者退出后，其它进程在下次检查时接手。
+ */
+bool MainController::isIndexMaintainer()
+{
+    if (isWatchingChanges)
+        return true;
+
+    QLockFile *lock = indexMaintainerLock();
+    if (!lock->isLocked()) {
+        if (!lock->tryLock(0))
+            return false;
+
+        qInfo() << "maintain full-text index in this process";
+    }
+
+    isWatchingChanges = true;
+    indexMaintainerTimer->stop();
+
+    QStringList paths;
+    for (auto location : { QStandardPaths::HomeLocation, QStandardPaths::DesktopLocation,
+                           QStandardPaths::DocumentsLocation, QStandardPaths::DownloadLocation }) {
+        const QString &path = QStandardPaths::writableLocation(location);
+        if (!path.isEmpty() && !paths.contains(path))
+            paths << path;
+    }
+    fileWatcher->addPaths(paths);
+
+    return true;
+}
+
+void MainController::addChangedFile(const DUrl &url)
+{
+    if (!url.isLocalFile() || !DFMApplication::genericAttribute(DFMApplication::GA_IndexFullTextSearch).toBool())
+        return;
+
+    // 其它进程维护索引时，文件的变化由它监听到并更新
+    if (!isIndexMaintainer())
+        return;
+
+    changedFiles.insert(url.toLocalFile());
+
+    // 文件持续变化时每隔 kIndexUpdateDelay 最多更新一次
+    if (!indexUpdateTimer->isActive())
+        indexUpdateTimer->start();
+}
+
+void MainController::onFileChanged(const QString &path, const QString &name)
+{
+    addChangedFile(DUrl::fromLocalFile(name.isEmpty() ? path : path + QDir::separator() + name));
+}
+
+void MainController::updateFullTextIndex()
+{
+    if (changedFiles.isEmpty())
+        return;
+
+    // 上一次更新还未完成
+    if (indexUpdateFuture.isRunning()) {
+        indexUpdateTimer->start();
+        return;
+    }
+
+    const QStringList files = changedFiles.toList();
+    changedFiles.clear();
+
+    indexUpdateFuture = QtConcurrent::run([files]() {
+        FullTextSearcher searcher(DUrl(), "");
+        searcher.updateIndex(files);
+    });
+}
+
 void MainController::onFinished(QString taskId)
 {
     if (taskManager.contains(taskId))
@@ -8,12 +8,16 @@
 #include "task/taskcommander.h"
 
 #include <QHash>
+#include <QSet>
 #include <QFuture>
 
 QT_BEGIN_NAMESPACE
 class QFileSystemWatcher;
+class QTimer;
 QT_END_NAMESPACE
 
+class DFileSystemWatcher;
+
 class MainController : public QObject
 {
     Q_OBJECT
@@ -28,17 +32,49 @@ private:
     bool doSearchTask(QString taskId, const DUrl &url, const QString &keyword);
     QList<DUrl> getResults(QString taskId);
     void createFullTextIndex();
+    void initIndexUpdater();
+    bool isIndexMaintainer();
+    void addChangedFile(const DUrl &url);
+    QList<DUrl> refineResults(const DUrl &url, const QString &keyword);
 
 private slots:
     void onFinished(QString taskId);
+    void onFileChanged(const QString &path, const QString &name);
+    void updateFullTextIndex();
 
 signals:
     void matched(QString taskId);
     void searchCompleted(QString taskId);
 
 private:
+    //! 搜索目录最近一次搜索的关键字和已得到的结果
+    struct SearchSession
+    {
+        QString keyword;
+        QList<DUrl> results;
+    };
+
+    //! 搜索任务的目录、先于搜索给出的结果和已给出的结果
+    struct TaskSession
+    {
+        DUrl url;
+        QList<DUrl> pending;
+        QSet<DUrl> delivered;
+    };
+
     QHash<QString, TaskCommander *> taskManager;
+    QHash<DUrl, SearchSession> searchSessions;
+    QHash<QString, TaskSession> taskSessions;
     QFuture<void> indexFuture;
+
+    //! 等待更新到全文索引的文件，防抖后批量更新
+    QSet<QString> changedFiles;
+    QTimer *indexUpdateTimer = nullptr;
+    DFileSystemWatcher *fileWatcher = nullptr;
+    QFuture<void> indexUpdateFuture;
+    //! 未能成为全文索引的维护者时定期重试
+    QTimer *indexMaintainerTimer = nullptr;
+    bool isWatchingChanges = false;
 };
 
 #endif   // MAINCONTROLLER_H
@@ -10,9 +10,34 @@
 
 #ifndef DISABLE_QUICK_SEARCH
 #include "anything/anythingsearcher.h"
+#include "interfaces/dfmtrace.h"
+#include "interfaces/dfmmetrics.h"
 #endif
 
 #include <QtConcurrent>
+#include <QFileInfo>
+#include <QDateTime>
+
+#include <algorithm>
+
+namespace {
+static int kMaxResultCount = 100000;   // 搜索结果数量上限，达到后停止所有搜索项
+
+//! 文件名与关键字的匹配程度，值越小越靠前
+enum MatchLevel {
+    kExactMatch,
+    kPrefixMatch,
+    kOtherMatch
+};
+
+struct RankedResult
+{
+    DUrl url;
+    int level;
+    int depth;
+    qint64 modified;
+};
+}
 
 TaskCommanderPrivate::TaskCommanderPrivate(TaskCommander *parent)
     : QObject(parent),
@@ -22,10 +47,13 @@ TaskCommanderPrivate::TaskCommanderPrivate(TaskCommander *parent)
 
 TaskCommanderPrivate::~TaskCommanderPrivate()
 {
+    DFM_METRIC_ADD("search.results", -resultSet.count());
 }
 
 void TaskCommanderPrivate::working(AbstractSearcher *searcher)
 {
+    // 按搜索器的类型区分
+    DFM_TRACE_SPAN("search", searcher->metaObject()->className());
     searcher->search();
 }
 
@@ -43,20 +71,109 @@ AbstractSearcher *TaskCommanderPrivate::createFileNameSearcher(const DUrl &url,
     return new IteratorSearcher(url, keyword, q);
 }
 
+/*!
+ * \brief TaskCommanderPrivate::rankResults 按匹配程度排序，数量超过 maxCount 时只保留最靠前的部分
+ *
+ * 依次比较文件名与关键字的匹配程度（完全相同、前缀相同、其它）、路径深度和修改时间（新的在前）。
+ */
+QList<DUrl> TaskCommanderPrivate::rankResults(const QList<DUrl> &results, const QString &keyword, int maxCount)
+{
+    if (maxCount <= 0)
+        return {};
+
+    QVector<RankedResult> ranked;
+    ranked.reserve(results.count());
+    for (const DUrl &url : results) {
+        const QString &fileName = url.fileName();
+        int level = kOtherMatch;
+        if (fileName.compare(keyword, Qt::CaseInsensitive) == 0 || QFileInfo(fileName).completeBaseName().compare(keyword, Qt::CaseInsensitive) == 0)
+            level = kExactMatch;
+        else if (fileName.startsWith(keyword, Qt::CaseInsensitive))
+            level = kPrefixMatch;
+
+        const QString &path = url.path();
+        const qint64 modified = url.isLocalFile() ? QFileInfo(path).lastModified().toMSecsSinceEpoch() : 0;
+        ranked.append({ url, level, path.count('/'), modified });
+    }
+
+    auto lessThan = [](const RankedResult &a, const RankedResult &b) {
+        if (a.level != b.level)
+            return a.level < b.level;
+        if (a.depth != b.depth)
+            return a.depth < b.depth;
+        return a.modified > b.modified;
+    };
+
+    // 只需要前 maxCount 个时部分排序
+    if (ranked.count() > maxCount) {
+        std::partial_sort(ranked.begin(), ranked.begin() + maxCount, ranked.end(), lessThan);
+        ranked.resize(maxCount);
+    } else {
+        std::sort(ranked.begin(), ranked.end(), lessThan);
+    }
+
+    QList<DUrl> sorted;
+    sorted.reserve(ranked.count());
+    for (const RankedResult &result : ranked)
+        sorted << result.url;
+
+    return sorted;
+}
+
 void TaskCommanderPrivate::onUnearthed(AbstractSearcher *searcher)
 {
     Q_ASSERT(searcher);
 
-    if (allSearchers.contains(searcher) && searcher->hasItem()) {
-        auto results = searcher->takeAll();
-        QWriteLocker lk(&rwLock);
-        bool isEmpty = resultList.isEmpty();
+    if (!allSearchers.contains(searcher) || !searcher->hasItem())
+        return;
+
+    const QList<DUrl> &results = searcher->takeAll();
+
+    // 去除其它搜索项已给出的结果
+    QList<DUrl> candidates;
+    int remaining = 0;
+    {
+        QReadLocker lk(&rwLock);
+        QSet<DUrl> batch;
+        for (const DUrl &url : results) {
+            if (!resultSet.contains(url) && !batch.contains(url)) {
+                batch.insert(url);
+                candidates << url;
+            }
+        }
+        remaining = kMaxResultCount - resultSet.count();
+    }
+
+    // 在搜索线程中排序，每批结果按匹配程度的顺序推送到界面
+    const QList<DUrl> &ranked = rankResults(candidates, keyword, remaining);
 
-        resultList += results;
-        //回到主线程发送信号
-        if (isEmpty)
-            QMetaObject::invokeMethod(q, "matched", Qt::QueuedConnection, Q_ARG(QString, taskId));
+    QWriteLocker lk(&rwLock);
+    bool isEmpty = resultList.isEmpty();
+    const int oldCount = resultSet.count();
+
+    for (const DUrl &url : ranked) {
+        if (resultSet.count() >= kMaxResultCount)
+            break;
+
+        // 排序期间其它搜索项可能给出了相同的结果
+        if (resultSet.contains(url))
+            continue;
+
+        resultSet.insert(url);
+        resultList << url;
     }
+
+    DFM_METRIC_ADD("search.results", resultSet.count() - oldCount);
+
+    // 结果已足够，停止所有搜索项
+    if (resultSet.count() >= kMaxResultCount) {
+        for (auto s : allSearchers)
+            s->stop();
+    }
+
+    //回到主线程发送信号
+    if (isEmpty && !resultList.isEmpty())
+        QMetaObject::invokeMethod(q, "matched", Qt::QueuedConnection, Q_ARG(QString, taskId));
 }
 
 void TaskCommanderPrivate::onFinished()
@@ -79,6 +196,7 @@ TaskCommander::TaskCommander(QString taskId, const DUrl &url, const QString &key
       d(new TaskCommanderPrivate(this))
 {
     d->taskId = taskId;
+    d->keyword = keyword;
     createSearcher(url, keyword);
 }
 
@@ -89,7 +207,7 @@ QString TaskCommander::taskID() const
 
 QList<DUrl> TaskCommander::getResults() const
 {
-    QReadLocker lk(&d->rwLock);
+    QWriteLocker lk(&d->rwLock);
     return std::move(d->resultList);
 }
 
@@ -11,6 +11,7 @@
 #include <QFutureWatcher>
 #include <QUrl>
 #include <QReadWriteLock>
+#include <QSet>
 
 class TaskCommanderPrivate : public QObject
 {
@@ -24,6 +25,7 @@ public:
 private:
     static void working(AbstractSearcher *searcher);
     AbstractSearcher *createFileNameSearcher(const DUrl &url, const QString &keyword);
+    static QList<DUrl> rankResults(const QList<DUrl> &results, const QString &keyword, int maxCount);
 
 private slots:
     void onUnearthed(AbstractSearcher *searcher);
@@ -33,10 +35,13 @@ private:
     TaskCommander *q = nullptr;
     volatile bool isWorking = false;
     QString taskId;
+    QString keyword;
 
     //当前所有的搜索结果和新数据缓冲区
     QReadWriteLock rwLock;
     QList<DUrl> resultList;
+    //! 已得到的结果，用于去除不同搜索项的重复结果
+    QSet<DUrl> resultSet;
 
     bool deleted = false;
     bool finished = false;   //保证结束信号只发一次
@@ -13,7 +13,8 @@
 
 namespace {
 static int kEmitInterval = 50;   // 推送时间间隔（ms）
-static qint32 kMaxCount = 100;   // 最大搜索结果数量
+static qint32 kFirstPageCount = 100;   // 第一次请求的搜索结果数量，尽快给出结果
+static qint32 kMaxPageCount = 2000;   // 每次请求的搜索结果数量上限，避免单次 DBus 数据过大
 static qint64 kMaxTime = 500;   // 最大搜索时间（ms）
 }
 
@@ -60,13 +61,15 @@ bool AnythingSearcher::search()
 
     uint32_t startOffset = 0;
     uint32_t endOffset = 0;
+    qint32 pageCount = kFirstPageCount;
     QHash<QString, QSet<QString>> hiddenFileHash;
+    // 分页获取结果，每页处理完后再请求下一页，结果足够（由 TaskCommander 停止）或取消时不再请求
     while (!searchDirList.isEmpty()) {
         //中断
         if (status.loadAcquire() != kRuning)
             return false;
 
-        const auto &reply = anythingInterface->search(kMaxCount, kMaxTime, startOffset, endOffset, searchDirList.first(), keyword, true);
+        const auto &reply = anythingInterface->search(pageCount, kMaxTime, startOffset, endOffset, searchDirList.first(), keyword, true);
         auto results = reply.argumentAt<0>();
         if (reply.error().type() != QDBusError::NoError) {
             qWarning() << "deepin-anything search failed:"
@@ -79,6 +82,8 @@ bool AnythingSearcher::search()
 
         startOffset = reply.argumentAt<1>();
         endOffset = reply.argumentAt<2>();
+        // 已给出第一页后逐渐增大每页的数量，减少 DBus 调用的次数
+        pageCount = qMin(pageCount * 2, kMaxPageCount);
 
         for (auto &item : results) {
             // 中断
@@ -101,6 +106,12 @@ bool AnythingSearcher::search()
             tryNotify();
         }
 
+        // 第一页的结果立即推送
+        if (lastEmit == 0 && hasItem()) {
+            lastEmit = notifyTimer.elapsed();
+            emit unearthed(this);
+        }
+
         // 当前目录已经搜索到了结尾
         if (startOffset >= endOffset) {
             startOffset = endOffset = 0;
@@ -140,7 +151,7 @@ void AnythingSearcher::tryNotify()
     int cur = notifyTimer.elapsed();
     if (hasItem() && (cur - lastEmit) > kEmitInterval) {
         lastEmit = cur;
-        qDebug() << "unearthed, current spend:" << cur;
+        dfmHotDebug() << "unearthed, current spend:" << cur;
         emit unearthed(this);
     }
 }
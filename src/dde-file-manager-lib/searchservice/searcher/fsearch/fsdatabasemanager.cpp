@@ -0,0 +1,309 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "fsdatabasemanager.h"
+#include "interfaces/dfilesystemwatcher.h"
+
+#include <QApplication>
+#include <QThread>
+#include <QThreadPool>
+#include <QTimer>
+#include <QtConcurrent>
+#include <QDebug>
+
+namespace {
+static int kMaxDatabaseCount = 4;   // 常驻内存的数据库数量上限
+static int kMaxWatchCount = 8192;   // 每个数据库监视的目录数量上限
+static int kRebuildDelay = 3000;   // 文件变化后重建数据库的延迟（ms）
+static qint64 kMaxUnwatchedAge = 10 * 60 * 1000;   // 未能完全监视的数据库的有效时间（ms）
+}
+
+Q_GLOBAL_STATIC(FsDatabaseManager, fsDatabaseManager)
+Q_GLOBAL_STATIC(QThreadPool, fsDatabaseThreadPool)
+
+static void freeDatabase(Database *db)
+{
+    db_clear(db);
+    db_free(db);
+}
+
+FsDatabaseManager::FsDatabaseManager(QObject *parent)
+    : QObject(parent)
+{
+    config = static_cast<FsearchConfig *>(calloc(1, sizeof(FsearchConfig)));
+    config_load_default(config);
+    config->locations = nullptr;
+
+    watcher = new DFileSystemWatcher(this);
+    connect(watcher, &DFileSystemWatcher::fileCreated, this, &FsDatabaseManager::onFileChanged);
+    connect(watcher, &DFileSystemWatcher::fileDeleted, this, &FsDatabaseManager::onFileChanged);
+    connect(watcher, &DFileSystemWatcher::fileMoved, this, &FsDatabaseManager::onFileMoved);
+    connect(watcher, &DFileSystemWatcher::eventQueueOverflowed, this, &FsDatabaseManager::onEventQueueOverflowed);
+
+    rebuildTimer = new QTimer(this);
+    rebuildTimer->setSingleShot(true);
+    rebuildTimer->setInterval(kRebuildDelay);
+    connect(rebuildTimer, &QTimer::timeout, this, &FsDatabaseManager::rebuildDirtyDatabases);
+}
+
+FsDatabaseManager::~FsDatabaseManager()
+{
+    working = false;
+
+    if (!fsDatabaseThreadPool.isDestroyed())
+        fsDatabaseThreadPool->waitForDone();
+
+    config_free(config);
+}
+
+FsDatabaseManager *FsDatabaseManager::instance()
+{
+    // 在搜索线程中创建，需移到主线程以接收文件变化
+    if (!fsDatabaseManager.exists() && qApp)
+        fsDatabaseManager->moveToThread(qApp->thread());
+
+    return fsDatabaseManager;
+}
+
+/*!
+ * \brief FsDatabaseManager::database 获取 path 目录的数据库，不存在时在当前线程中建立
+ * \param state 为 false 时中断建立数据库
+ * \return 使用期间持有返回值，重建后旧的数据库在不再使用时释放
+ */
+QSharedPointer<Database> FsDatabaseManager::database(const QString &path, bool *state)
+{
+    QMutexLocker lk(&mutex);
+
+    auto it = databases.find(path);
+    if (it != databases.end()) {
+        it->lastUsed = ++useCounter;
+
+        if (!it->fullyWatched && !it->rebuilding && !it->dirty && it->age.elapsed() > kMaxUnwatchedAge) {
+            it->dirty = true;
+            scheduleRebuild();
+        }
+
+        return it->db;
+    }
+    lk.unlock();
+
+    QStringList directories;
+    bool fullyWatched = false;
+    Database *db = buildDatabase(path, state, &directories, &fullyWatched);
+    if (!db)
+        return QSharedPointer<Database>();
+
+    QSharedPointer<Database> ptr(db, freeDatabase);
+
+    lk.relock();
+
+    // 其它搜索同时建立了同一目录的数据库
+    it = databases.find(path);
+    if (it != databases.end())
+        return it->db;
+
+    if (databases.count() >= kMaxDatabaseCount) {
+        auto oldest = databases.begin();
+        for (auto iter = databases.begin(); iter != databases.end(); ++iter) {
+            if (iter->lastUsed < oldest->lastUsed)
+                oldest = iter;
+        }
+        databases.erase(oldest);
+    }
+
+    DatabaseInfo &info = databases[path];
+    info.db = ptr;
+    info.directories = directories;
+    info.fullyWatched = fullyWatched;
+    info.age.start();
+    info.lastUsed = ++useCounter;
+
+    QMetaObject::invokeMethod(this, "updateWatchedDirectories", Qt::QueuedConnection);
+
+    return ptr;
+}
+
+void FsDatabaseManager::onFileChanged(const QString &path, const QString &name)
+{
+    // 隐藏文件不在数据库中
+    if (name.startsWith('.'))
+        return;
+
+    markDirty(path);
+}
+
+void FsDatabaseManager::onFileMoved(const QString &fromPath, const QString &fromName, const QString &toPath, const QString &toName)
+{
+    onFileChanged(fromPath, fromName);
+
+    if (!toPath.isEmpty())
+        onFileChanged(toPath, toName);
+}
+
+void FsDatabaseManager::onEventQueueOverflowed()
+{
+    // 不知道哪些目录发生了变化，全部重建
+    QMutexLocker lk(&mutex);
+    for (auto it = databases.begin(); it != databases.end(); ++it)
+        it->dirty = true;
+
+    if (!databases.isEmpty())
+        scheduleRebuild();
+}
+
+/*!
+ * \brief FsDatabaseManager::updateWatchedDirectories 按当前的数据库更新监视的目录，需在主线程中调用
+ */
+void FsDatabaseManager::updateWatchedDirectories()
+{
+    QSet<QString> wanted;
+
+    QMutexLocker lk(&mutex);
+    for (const DatabaseInfo &info : databases)
+        wanted.unite(info.directories.toSet());
+    lk.unlock();
+
+    const QStringList &current = watcher->directories();
+    QStringList removed;
+    for (const QString &dir : current) {
+        if (!wanted.contains(dir))
+            removed << dir;
+    }
+
+    if (!removed.isEmpty())
+        watcher->removePaths(removed);
+
+    for (const QString &dir : current)
+        wanted.remove(dir);
+
+    if (!wanted.isEmpty())
+        watcher->addPaths(wanted.toList());
+}
+
+void FsDatabaseManager::startRebuildTimer()
+{
+    // 文件持续变化时每隔 kRebuildDelay 最多重建一次
+    if (!rebuildTimer->isActive())
+        rebuildTimer->start();
+}
+
+void FsDatabaseManager::rebuildDirtyDatabases()
+{
+    QThreadPool *pool = fsDatabaseThreadPool;
+    pool->setMaxThreadCount(1);
+
+    QMutexLocker lk(&mutex);
+    for (auto it = databases.begin(); it != databases.end(); ++it) {
+        if (!it->dirty || it->rebuilding)
+            continue;
+
+        it->dirty = false;
+        it->rebuilding = true;
+
+        const QString path = it.key();
+        QtConcurrent::run(pool, [this, path] {
+            QThread::currentThread()->setPriority(QThread::IdlePriority);
+
+            QStringList directories;
+            bool fullyWatched = false;
+            Database *db = buildDatabase(path, &working, &directories, &fullyWatched);
+
+            QMutexLocker locker(&mutex);
+            auto it = databases.find(path);
+            if (it == databases.end()) {
+                // 重建期间数据库已被移除
+                if (db)
+                    freeDatabase(db);
+                return;
+            }
+
+            if (db) {
+                it->db = QSharedPointer<Database>(db, freeDatabase);
+                it->directories = directories;
+                it->fullyWatched = fullyWatched;
+                it->age.restart();
+            }
+
+            it->rebuilding = false;
+            if (it->dirty)
+                scheduleRebuild();
+
+            QMetaObject::invokeMethod(this, "updateWatchedDirectories", Qt::QueuedConnection);
+        });
+    }
+}
+
+/*!
+ * \brief FsDatabaseManager::buildDatabase 遍历目录建立数据库，同时按广度优先收集需要监视的目录
+ */
+Database *FsDatabaseManager::buildDatabase(const QString &path, bool *state, QStringList *directories, bool *fullyWatched)
+{
+    QMutexLocker lk(&buildMutex);
+
+    const QByteArray &localPath = path.toLocal8Bit();
+    Database *db = db_new();
+    if (!db_location_add(db, localPath.data(), config, state, nullptr)) {
+        db_free(db);
+        return nullptr;
+    }
+
+    if (!*state) {
+        freeDatabase(db);
+        return nullptr;
+    }
+
+    db_build_initial_entries_list(db);
+
+    *directories = { path };
+    *fullyWatched = true;
+
+    DynamicArray *entries = db_get_entries(db);
+    BTreeNode *node = db_get_num_entries(db) > 0 ? static_cast<BTreeNode *>(darray_get_item(entries, 0)) : nullptr;
+    if (!node)
+        return db;
+
+    QList<QPair<BTreeNode *, QString>> queue { qMakePair(btree_node_get_root(node), path == "/" ? QString() : path) };
+    while (!queue.isEmpty() && *fullyWatched) {
+        const QPair<BTreeNode *, QString> current = queue.takeFirst();
+
+        for (BTreeNode *child = current.first->children; child; child = child->next) {
+            if (!child->is_dir)
+                continue;
+
+            if (directories->count() >= kMaxWatchCount) {
+                *fullyWatched = false;
+                break;
+            }
+
+            const QString &childPath = current.second + "/" + QString::fromUtf8(child->name);
+            *directories << childPath;
+            queue << qMakePair(child, childPath);
+        }
+    }
+
+    return db;
+}
+
+void FsDatabaseManager::markDirty(const QString &filePath)
+{
+    bool changed = false;
+
+    QMutexLocker lk(&mutex);
+    for (auto it = databases.begin(); it != databases.end(); ++it) {
+        const QString &root = it.key();
+        if (filePath == root || root == "/" || filePath.startsWith(root + "/")) {
+            it->dirty = true;
+            changed = true;
+        }
+    }
+
+    if (changed)
+        scheduleRebuild();
+}
+
+// 需持有 mutex
+void FsDatabaseManager::scheduleRebuild()
+{
+    QMetaObject::invokeMethod(this, "startRebuildTimer", Qt::QueuedConnection);
+}
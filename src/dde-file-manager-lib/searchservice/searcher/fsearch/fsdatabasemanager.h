@@ -0,0 +1,76 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef FSDATABASEMANAGER_H
+#define FSDATABASEMANAGER_H
+
+extern "C" {
+#include "fsearch/fsearch.h"
+}
+
+#include <QObject>
+#include <QHash>
+#include <QMutex>
+#include <QElapsedTimer>
+#include <QSharedPointer>
+#include <QStringList>
+
+class QTimer;
+class DFileSystemWatcher;
+
+/*!
+ * \brief FsDatabaseManager 常驻内存的 fsearch 文件名数据库
+ *
+ * 每个搜索目录的数据库在第一次搜索时建立，之后的搜索直接使用，不必重新遍历磁盘。
+ * 通过 inotify 监视数据库中的目录，发生文件的创建、删除和移动后在后台线程中重建数据库，
+ * 重建完成前继续使用旧的数据库。目录过多无法全部监视时，数据库超过一定时间后在下次搜索时重建。
+ */
+class FsDatabaseManager : public QObject
+{
+    Q_OBJECT
+public:
+    explicit FsDatabaseManager(QObject *parent = nullptr);
+    ~FsDatabaseManager() override;
+
+    static FsDatabaseManager *instance();
+
+    QSharedPointer<Database> database(const QString &path, bool *state);
+
+private slots:
+    void onFileChanged(const QString &path, const QString &name);
+    void onFileMoved(const QString &fromPath, const QString &fromName, const QString &toPath, const QString &toName);
+    void onEventQueueOverflowed();
+    void updateWatchedDirectories();
+    void startRebuildTimer();
+    void rebuildDirtyDatabases();
+
+private:
+    struct DatabaseInfo
+    {
+        QSharedPointer<Database> db;
+        QStringList directories;
+        bool fullyWatched = false;
+        bool dirty = false;
+        bool rebuilding = false;
+        QElapsedTimer age;
+        quint64 lastUsed = 0;
+    };
+
+    Database *buildDatabase(const QString &path, bool *state, QStringList *directories, bool *fullyWatched);
+    void markDirty(const QString &filePath);
+    void scheduleRebuild();
+
+    FsearchConfig *config = nullptr;
+    QHash<QString, DatabaseInfo> databases;
+    quint64 useCounter = 0;
+    mutable QMutex mutex;
+    //! db_build_initial_entries_list 使用了全局变量，同一时刻只能建立一个数据库
+    QMutex buildMutex;
+    bool working = true;
+
+    DFileSystemWatcher *watcher = nullptr;
+    QTimer *rebuildTimer = nullptr;
+};
+
+#endif   // FSDATABASEMANAGER_H
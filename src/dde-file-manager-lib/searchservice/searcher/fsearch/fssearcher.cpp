@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "fssearcher.h"
+#include "fsdatabasemanager.h"
 #include "utils/searchhelper.h"
 #include "interfaces/dfileservices.h"
 #include "controllers/vaultcontroller.h"
@@ -23,11 +24,7 @@ FsSearcher::FsSearcher(const DUrl &url, const QString &key, QObject *parent)
 FsSearcher::~FsSearcher()
 {
     if (app) {
-        if (app->db) {
-            db_clear(app->db);
-            db_free(app->db);
-        }
-
+        // 数据库由 FsDatabaseManager 持有
         if (app->pool)
             fsearch_thread_pool_free(app->pool);
         config_free(app->config);
@@ -58,21 +55,19 @@ bool FsSearcher::search()
         return false;
 
     searchUrl = DUrl::fromLocalFile(info->absoluteFilePath());
-    auto searchPath = info->absoluteFilePath().toLocal8Bit();
-    load_database(app, searchPath.data(), &isWorking);//加载数据库
-    if (!isWorking) return false;
+    // 使用常驻内存的数据库，只在第一次搜索该目录时遍历磁盘
+    const QSharedPointer<Database> db = FsDatabaseManager::instance()->database(info->absoluteFilePath(), &isWorking);
+    if (!isWorking || !db) return false;
     Q_ASSERT(app && app->search);
 
     db_search_results_clear(app->search);
-    Database *db = app->db;
-    if (!db_try_lock(db)) {
-        return true;
-    }
+    // 其它搜索正在使用同一数据库时等待其完成
+    db_lock(db.data());
 
-    if (app->search) {
+    if (app->search && db_get_entries(db.data()) && db_get_num_entries(db.data()) > 0) {
         db_search_update(app->search,
-                         db_get_entries(db),
-                         db_get_num_entries(db),
+                         db_get_entries(db.data()),
+                         db_get_num_entries(db.data()),
                          kMaxCount,
                          FsearchFilter::FSEARCH_FILTER_NONE,
                          keyword.toLocal8Bit().data(),
@@ -87,7 +82,7 @@ bool FsSearcher::search()
         waitCondition.wait(&conditionMtx);
         conditionMtx.unlock();
     }
-    db_unlock(db);
+    db_unlock(db.data());
 
     //检查是否还有数据
     if (status.testAndSetRelease(kRuning, kCompleted)) {
@@ -136,7 +131,7 @@ void FsSearcher::tryNotify()
     int cur = notifyTimer.elapsed();
     if (hasItem() && (cur - lastEmit) > kEmitInterval) {
         lastEmit = cur;
-        qDebug() << "unearthed, current spend:" << cur;
+        dfmHotDebug() << "unearthed, current spend:" << cur;
         emit unearthed(this);
     }
 }
@@ -15,6 +15,7 @@
 // Lucune++ headers
 #include <FileUtils.h>
 #include <FilterIndexReader.h>
+#include <LogByteSizeMergePolicy.h>
 #include <FuzzyQuery.h>
 #include <QueryWrapperFilter.h>
 
@@ -26,6 +27,9 @@
 #include <QDir>
 #include <QTime>
 #include <QUrl>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent>
 
 #include <dirent.h>
 #include <exception>
@@ -37,11 +41,44 @@ const char *const kSupportFiles = "(rtf)|(odt)|(ods)|(odp)|(odg)|(docx)|(xlsx)|(
                                   "(xls)|(xlsb)|(doc)|(dot)|(wps)|(ppt)|(pps)|(txt)|(pdf)|(dps)";
 static int kMaxResultNum = 100000;   // 最大搜索结果数
 static int kEmitInterval = 50;   // 推送时间间隔
+static int kParseQueueSize = 1024;   // 等待解析的文件数量上限
+static int kWriteQueueSize = 64;   // 等待写入索引的文档数量上限
+static int kWriteBatchSize = 32;   // 每次写入索引的文档数量
+static double kMinRAMBufferSize = 16;   // 索引写入磁盘前在内存中缓存的大小下限（MB）
+static double kMaxRAMBufferSize = 512;   // 索引写入磁盘前在内存中缓存的大小上限（MB）
+static int kMergeFactor = 10;   // 同一层级的段数量达到此值时合并
+static double kMaxMergeSize = 512;   // 大于此值的段不再参与增量合并（MB）
+static double kMaxDeletedRatio = 0.2;   // 已删除的文档超过此比例时清理索引
+static int kSnippetLength = 512;   // 保存摘要时的摘要长度
+static qint64 kConsistencyCheckInterval = 30 * 60 * 1000;   // 搜索前完整检查索引的最小间隔（ms）
+static int kHitBatchSize = 256;   // 每批检查的搜索结果数量
+
+//! 持有 IndexReader 的引用，析构时释放
+struct ReaderRef
+{
+    explicit ReaderRef(const Lucene::IndexReaderPtr &reader)
+        : reader(reader) {}
+    ~ReaderRef()
+    {
+        try {
+            reader->decRef();
+        } catch (...) {
+            qWarning() << "Error: release index reader";
+        }
+    }
+
+    Lucene::IndexReaderPtr reader;
+};
 }
 
 using namespace Lucene;
 
 bool FullTextSearcherPrivate::isIndexCreating = false;
+QMutex FullTextSearcherPrivate::indexMutex;
+QHash<QString, qint64> FullTextSearcherPrivate::checkedTimes;
+QMutex FullTextSearcherPrivate::readerMutex;
+IndexReaderPtr FullTextSearcherPrivate::sharedReader;
+
 FullTextSearcherPrivate::FullTextSearcherPrivate(FullTextSearcher *parent)
     : QObject(parent),
       q(parent)
@@ -54,10 +91,40 @@ FullTextSearcherPrivate::~FullTextSearcherPrivate()
 
 IndexWriterPtr FullTextSearcherPrivate::newIndexWriter(bool create)
 {
-    return newLucene<IndexWriter>(FSDirectory::open(indexStorePath().toStdWString()),
-                                  newLucene<ChineseAnalyzer>(),
-                                  create,
-                                  IndexWriter::MaxFieldLengthLIMITED);
+    IndexWriterPtr writer = newLucene<IndexWriter>(FSDirectory::open(indexStorePath().toStdWString()),
+                                                   sharedAnalyzer(),
+                                                   create,
+                                                   IndexWriter::MaxFieldLengthLIMITED);
+
+    // 缓存越大，写入磁盘的段越少，之后需要合并的次数也越少
+    const double bufferSize = DFMApplication::genericAttribute(DFMApplication::GA_FullTextIndexBufferSize).toDouble();
+    writer->setRAMBufferSizeMB(qBound(kMinRAMBufferSize, bufferSize, kMaxRAMBufferSize));
+
+    // 按段的大小合并，较大的段不再反复参与合并
+    LogByteSizeMergePolicyPtr policy = newLucene<LogByteSizeMergePolicy>(writer);
+    policy->setMergeFactor(kMergeFactor);
+    policy->setMaxMergeMB(kMaxMergeSize);
+    writer->setMergePolicy(policy);
+
+    return writer;
+}
+
+/*!
+ * \brief FullTextSearcherPrivate::closeIndexWriter 提交并关闭增量更新的索引
+ *
+ * 增量更新不优化索引，只在已删除的文档超过 kMaxDeletedRatio 时清理，避免每次更新都重写整个索引。
+ */
+void FullTextSearcherPrivate::closeIndexWriter(const IndexWriterPtr &writer)
+{
+    writer->commit();
+
+    const int maxDoc = writer->maxDoc();
+    if (maxDoc > 0 && double(maxDoc - writer->numDocs()) / maxDoc > kMaxDeletedRatio) {
+        qInfo() << "expunge deleted documents:" << maxDoc - writer->numDocs();
+        writer->expungeDeletes();
+    }
+
+    writer->close();
 }
 
 IndexReaderPtr FullTextSearcherPrivate::newIndexReader()
@@ -65,7 +132,75 @@ IndexReaderPtr FullTextSearcherPrivate::newIndexReader()
     return IndexReader::open(FSDirectory::open(indexStorePath().toStdWString()), true);
 }
 
-void FullTextSearcherPrivate::doIndexTask(const IndexReaderPtr &reader, const IndexWriterPtr &writer, const QString &path, TaskType type)
+/*!
+ * \brief FullTextSearcherPrivate::runIndexPipeline 并行建立或更新索引
+ *
+ * 当前线程遍历目录，把需要索引的文件放入解析队列；每个 CPU 核心一个解析线程，提取文档内容后放入写入队列；
+ * 单独的写入线程批量写入索引。队列有容量上限，某一环节较慢时其它环节等待。
+ */
+void FullTextSearcherPrivate::runIndexPipeline(const IndexReaderPtr &reader, const IndexWriterPtr &writer, const QString &path, TaskType type)
+{
+    BlockingQueue<IndexJob> parseQueue(kParseQueueSize);
+    BlockingQueue<IndexJob> writeQueue(kWriteQueueSize);
+
+    const int parserCount = qMax(1, QThread::idealThreadCount());
+    QAtomicInt runningParsers = parserCount;
+    QThreadPool pool;
+    pool.setMaxThreadCount(parserCount + 1);
+
+    for (int i = 0; i < parserCount; ++i) {
+        QtConcurrent::run(&pool, [&] {
+            for (QList<IndexJob> jobs = parseQueue.pop(); !jobs.isEmpty(); jobs = parseQueue.pop()) {
+                IndexJob &job = jobs.first();
+
+                // 中断后只取出剩余的文件，不再解析
+                if (status.loadAcquire() != AbstractSearcher::kRuning)
+                    continue;
+
+                if (job.type != kDeleteIndex) {
+                    try {
+                        job.doc = fileDocument(job.file);
+                    } catch (const std::exception &e) {
+                        qWarning() << "Error: parse document" << QString(e.what()) << " file: " << job.file;
+                        continue;
+                    } catch (...) {
+                        qWarning() << "Error: parse document" << " file: " << job.file;
+                        continue;
+                    }
+                }
+
+                writeQueue.push(job);
+            }
+
+            // 最后一个解析线程结束后关闭写入队列
+            if (runningParsers.fetchAndSubOrdered(1) == 1)
+                writeQueue.close();
+        });
+    }
+
+    QtConcurrent::run(&pool, [&] {
+        for (QList<IndexJob> jobs = writeQueue.pop(kWriteBatchSize); !jobs.isEmpty(); jobs = writeQueue.pop(kWriteBatchSize)) {
+            if (status.loadAcquire() != AbstractSearcher::kRuning)
+                continue;
+
+            for (const IndexJob &job : jobs)
+                indexDocs(writer, job.file, job.type, job.doc);
+        }
+    });
+
+    try {
+        doIndexTask(reader, &parseQueue, path, type);
+    } catch (...) {
+        parseQueue.close();
+        pool.waitForDone();
+        throw;
+    }
+
+    parseQueue.close();
+    pool.waitForDone();
+}
+
+void FullTextSearcherPrivate::doIndexTask(const IndexReaderPtr &reader, BlockingQueue<IndexJob> *queue, const QString &path, TaskType type)
 {
     if (status.loadAcquire() != AbstractSearcher::kRuning)
         return;
@@ -109,7 +244,7 @@ void FullTextSearcherPrivate::doIndexTask(const IndexReaderPtr &reader, const In
 
         const bool is_dir = S_ISDIR(st.st_mode);
         if (is_dir) {
-            doIndexTask(reader, writer, fn, type);
+            doIndexTask(reader, queue, fn, type);
         } else {
             QFileInfo info(fn);
             QString suffix = info.suffix();
@@ -117,12 +252,12 @@ void FullTextSearcherPrivate::doIndexTask(const IndexReaderPtr &reader, const In
             if (suffixRegExp.exactMatch(suffix)) {
                 switch (type) {
                 case kCreate:
-                    indexDocs(writer, fn, kAddIndex);
+                    queue->push({ fn, kAddIndex, DocumentPtr() });
                     break;
                 case kUpdate:
                     IndexType type;
                     if (checkUpdate(reader, fn, type)) {
-                        indexDocs(writer, fn, type);
+                        queue->push({ fn, type, DocumentPtr() });
                         isUpdated = true;
                     }
                     break;
@@ -135,7 +270,11 @@ void FullTextSearcherPrivate::doIndexTask(const IndexReaderPtr &reader, const In
         closedir(dir);
 }
 
-void FullTextSearcherPrivate::indexDocs(const IndexWriterPtr &writer, const QString &file, IndexType type)
+/*!
+ * \brief FullTextSearcherPrivate::indexDocs 写入索引
+ * \param doc 已解析的文档，为空时在当前线程中解析
+ */
+void FullTextSearcherPrivate::indexDocs(const IndexWriterPtr &writer, const QString &file, IndexType type, const DocumentPtr &doc)
 {
     Q_ASSERT(writer);
 
@@ -144,7 +283,7 @@ void FullTextSearcherPrivate::indexDocs(const IndexWriterPtr &writer, const QStr
         case kAddIndex: {
             qDebug() << "Adding [" << file << "]";
             // 添加
-            writer->addDocument(fileDocument(file));
+            writer->addDocument(doc ? doc : fileDocument(file));
             break;
         }
         case kUpdateIndex: {
@@ -152,7 +291,7 @@ void FullTextSearcherPrivate::indexDocs(const IndexWriterPtr &writer, const QStr
             // 定义一个更新条件
             TermPtr term = newLucene<Term>(L"path", file.toStdWString());
             // 更新
-            writer->updateDocument(term, fileDocument(file));
+            writer->updateDocument(term, doc ? doc : fileDocument(file));
             break;
         }
         case kDeleteIndex: {
@@ -216,7 +355,7 @@ void FullTextSearcherPrivate::tryNotify()
     int cur = notifyTimer.elapsed();
     if (q->hasItem() && (cur - lastEmit) > kEmitInterval) {
         lastEmit = cur;
-        qDebug() << "unearthed, current spend:" << cur;
+        dfmHotDebug() << "unearthed, current spend:" << cur;
         emit q->unearthed(q);
     }
 }
@@ -232,9 +371,15 @@ DocumentPtr FullTextSearcherPrivate::fileDocument(const QString &file)
     QString modifyTime = info.lastModified().toString("yyyyMMddHHmmss");
     doc->add(newLucene<Field>(L"modified", modifyTime.toStdWString(), Field::STORE_YES, Field::INDEX_NOT_ANALYZED));
 
-    // file contents
+    // file contents，搜索只用到索引，默认不保存全文以减小索引
     QString contents = DocParser::convertFile(file.toStdString()).c_str();
-    doc->add(newLucene<Field>(L"contents", contents.toStdWString(), Field::STORE_YES, Field::INDEX_ANALYZED));
+    const int storeMode = DFMApplication::genericAttribute(DFMApplication::GA_FullTextStoreMode).toInt();
+    doc->add(newLucene<Field>(L"contents", contents.toStdWString(),
+                              storeMode == kStoreContents ? Field::STORE_YES : Field::STORE_NO,
+                              Field::INDEX_ANALYZED));
+
+    if (storeMode == kStoreSnippet)
+        doc->add(newLucene<Field>(L"snippet", contents.left(kSnippetLength).toStdWString(), Field::STORE_YES, Field::INDEX_NO));
 
     return doc;
 }
@@ -260,6 +405,8 @@ bool FullTextSearcherPrivate::createIndex(const QString &path)
         }
     }
 
+    QMutexLocker lk(&indexMutex);
+
     try {
         // record spending
         QTime timer;
@@ -267,10 +414,14 @@ bool FullTextSearcherPrivate::createIndex(const QString &path)
         IndexWriterPtr writer = newIndexWriter(true);
         qDebug() << "Indexing to directory: " << indexStorePath();
         writer->deleteAll();
-        doIndexTask(nullptr, writer, path, kCreate);
+        runIndexPipeline(nullptr, writer, path, kCreate);
+        // 只在重建全部索引后优化，增量更新时参见 closeIndexWriter
         writer->optimize();
         writer->close();
 
+        checkedTimes.clear();
+        checkedTimes.insert(path, QDateTime::currentMSecsSinceEpoch());
+
         qInfo() << "create index spending: " << timer.elapsed();
         status.storeRelease(AbstractSearcher::kCompleted);
         return true;
@@ -286,21 +437,105 @@ bool FullTextSearcherPrivate::createIndex(const QString &path)
     return false;
 }
 
+/*!
+ * \brief FullTextSearcherPrivate::updateIndex 遍历目录检查索引是否与文件一致
+ *
+ * 文件的变化由 updateFiles 及时更新到索引中，此处只作为定期的一致性检查，
+ * 目录或其上级目录在 kConsistencyCheckInterval 内检查过时直接返回。
+ */
 bool FullTextSearcherPrivate::updateIndex(const QString &path)
 {
     QString tmpPath = path;
     if (tmpPath.startsWith("/data/home"))
         tmpPath = tmpPath.remove(0, 5);
 
+    QMutexLocker lk(&indexMutex);
+
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    for (auto it = checkedTimes.constBegin(); it != checkedTimes.constEnd(); ++it) {
+        const QString &checkedPath = it.key();
+        const bool covered = checkedPath == tmpPath || checkedPath == "/"
+                || tmpPath.startsWith(checkedPath + "/");
+
+        if (covered && now - it.value() < kConsistencyCheckInterval)
+            return true;
+    }
+
     try {
         IndexReaderPtr reader = newIndexReader();
         IndexWriterPtr writer = newIndexWriter();
 
-        doIndexTask(reader, writer, tmpPath, kUpdate);
+        runIndexPipeline(reader, writer, tmpPath, kUpdate);
 
-        writer->close();
+        closeIndexWriter(writer);
+        reader->close();
+
+        if (status.loadAcquire() == AbstractSearcher::kRuning)
+            checkedTimes.insert(tmpPath, now);
+
+        return true;
+    } catch (const LuceneException &e) {
+        qWarning() << "Error: " << __FUNCTION__ << QString::fromStdWString(e.getError());
+    } catch (const std::exception &e) {
+        qWarning() << "Error: " << __FUNCTION__ << QString(e.what());
+    } catch (...) {
+        qWarning() << "Error: " << __FUNCTION__;
+    }
+
+    return false;
+}
+
+/*!
+ * \brief FullTextSearcherPrivate::updateFiles 按文件的变化更新索引
+ * \param files 被创建、修改、删除或移动的文件和目录，不存在的文件及其下的文件从索引中删除
+ */
+bool FullTextSearcherPrivate::updateFiles(const QStringList &files)
+{
+    //准备状态切运行中，否则直接返回
+    if (!status.testAndSetRelease(AbstractSearcher::kReady, AbstractSearcher::kRuning))
+        return false;
+
+    static QRegExp folderRegExp(kFilterFolders);
+    static QRegExp suffixRegExp(kSupportFiles);
+
+    QMutexLocker lk(&indexMutex);
+
+    try {
+        IndexReaderPtr reader = newIndexReader();
+        IndexWriterPtr writer = newIndexWriter();
+        QStringList dirs;
+
+        for (const QString &file : files) {
+            if (status.loadAcquire() != AbstractSearcher::kRuning)
+                break;
+
+            // 与遍历目录时的过滤条件一致
+            if ((folderRegExp.exactMatch(file) && !file.startsWith("/run/user"))
+                    || (file.contains("/.") && !file.contains("/.local")))
+                continue;
+
+            QFileInfo info(file);
+            if (!info.exists()) {
+                indexDocs(writer, file, kDeleteIndex);
+                // 被删除或移走的目录下的文件
+                writer->deleteDocuments(newLucene<PrefixQuery>(newLucene<Term>(L"path", (file + "/").toStdWString())));
+            } else if (info.isDir()) {
+                dirs << file;
+            } else if (suffixRegExp.exactMatch(info.suffix())) {
+                IndexType type;
+                if (checkUpdate(reader, file, type))
+                    indexDocs(writer, file, type);
+            }
+        }
+
+        // 新建或移入的目录
+        for (const QString &dir : dirs)
+            runIndexPipeline(reader, writer, dir, kUpdate);
+
+        closeIndexWriter(writer);
         reader->close();
 
+        status.storeRelease(AbstractSearcher::kCompleted);
         return true;
     } catch (const LuceneException &e) {
         qWarning() << "Error: " << __FUNCTION__ << QString::fromStdWString(e.getError());
@@ -310,6 +545,7 @@ bool FullTextSearcherPrivate::updateIndex(const QString &path)
         qWarning() << "Error: " << __FUNCTION__;
     }
 
+    status.storeRelease(AbstractSearcher::kCompleted);
     return false;
 }
 
@@ -325,12 +561,12 @@ bool FullTextSearcherPrivate::doSearch(const QString &path, const QString &keywo
         isDelDataPrefix = true;
     }
 
+    QStringList invalidFiles;
+
     try {
-        IndexWriterPtr writer = newIndexWriter();
-        IndexReaderPtr reader = newIndexReader();
-        SearcherPtr searcher = newLucene<IndexSearcher>(reader);
-        AnalyzerPtr analyzer = newLucene<ChineseAnalyzer>();
-        QueryParserPtr parser = newLucene<QueryParser>(LuceneVersion::LUCENE_CURRENT, L"contents", analyzer);
+        ReaderRef readerRef(acquireReader());
+        SearcherPtr searcher = newLucene<IndexSearcher>(readerRef.reader);
+        QueryParserPtr parser = newLucene<QueryParser>(LuceneVersion::LUCENE_CURRENT, L"contents", sharedAnalyzer());
         //设定第一个* 可以匹配
         parser->setAllowLeadingWildcard(true);
         QueryPtr query = parser->parse(keyword.toStdWString());
@@ -344,54 +580,64 @@ bool FullTextSearcherPrivate::doSearch(const QString &path, const QString &keywo
         Collection<ScoreDocPtr> scoreDocs = topDocs->scoreDocs;
 
         QHash<QString, QSet<QString>> hiddenFileHash;
-        for (auto scoreDoc : scoreDocs) {
-            //中断
-            if (status.loadAcquire() != AbstractSearcher::kRuning)
-                return false;
+        QVector<SearchHit> hits;
+        hits.reserve(kHitBatchSize);
+
+        for (int begin = 0; begin < scoreDocs.size(); begin += kHitBatchSize) {
+            hits.clear();
 
-            DocumentPtr doc = searcher->doc(scoreDoc->doc);
-            String resultPath = doc->get(L"path");
+            const int end = qMin(begin + kHitBatchSize, scoreDocs.size());
+            for (int i = begin; i < end; ++i) {
+                DocumentPtr doc = searcher->doc(scoreDocs[i]->doc);
+                SearchHit hit;
+                hit.path = doc->get(L"path");
+                hit.storeTime = doc->get(L"modified");
+
+                if (!hit.path.empty())
+                    hits.append(hit);
+            }
+
+            // 并行检查一批结果对应的文件是否已经变化
+            QtConcurrent::blockingMap(hits, checkHit);
+
+            for (SearchHit &hit : hits) {
+                //中断
+                if (status.loadAcquire() != AbstractSearcher::kRuning)
+                    return false;
 
-            if (!resultPath.empty()) {
-                QFileInfo info(QString::fromStdWString(resultPath));
                 // delete invalid index
-                if (!info.exists()) {
-                    indexDocs(writer, info.absoluteFilePath(), kDeleteIndex);
+                if (hit.state == SearchHit::kRemoved) {
+                    invalidFiles << QString::fromStdWString(hit.path);
                     continue;
                 }
 
-                QString modifyTime = info.lastModified().toString("yyyyMMddHHmmss");
-                String storeTime = doc->get(L"modified");
-                if (modifyTime.toStdWString() != storeTime) {
+                if (hit.state == SearchHit::kModified)
                     continue;
-                } else {
-                    if (!SearchHelper::isHiddenFile(StringUtils::toUTF8(resultPath).c_str(), hiddenFileHash, searchPath)) {
-                        if (isDelDataPrefix)
-                            resultPath.insert(0, L"/data");
-
-                        DUrl fileUrl;
-                        QString filePath = StringUtils::toUTF8(resultPath).c_str();
-                        // 由于回收站和保险箱文件的菜单，特殊处理
-                        if (VaultController::isVaultFile(searchPath)) {
-                            fileUrl = VaultController::localToVault(filePath);
-                        } else if (searchPath.startsWith(DFMStandardPaths::location(DFMStandardPaths::TrashFilesPath))) {
-                            fileUrl = DUrl::fromTrashFile(filePath.remove(DFMStandardPaths::location(DFMStandardPaths::TrashFilesPath)));
-                        } else {
-                            fileUrl = DUrl::fromLocalFile(filePath);
-                        }
-
-                        QMutexLocker lk(&mutex);
-                        allResults.append(fileUrl);
+
+                String &resultPath = hit.path;
+                if (!SearchHelper::isHiddenFile(StringUtils::toUTF8(resultPath).c_str(), hiddenFileHash, searchPath)) {
+                    if (isDelDataPrefix)
+                        resultPath.insert(0, L"/data");
+
+                    DUrl fileUrl;
+                    QString filePath = StringUtils::toUTF8(resultPath).c_str();
+                    // 由于回收站和保险箱文件的菜单，特殊处理
+                    if (VaultController::isVaultFile(searchPath)) {
+                        fileUrl = VaultController::localToVault(filePath);
+                    } else if (searchPath.startsWith(DFMStandardPaths::location(DFMStandardPaths::TrashFilesPath))) {
+                        fileUrl = DUrl::fromTrashFile(filePath.remove(DFMStandardPaths::location(DFMStandardPaths::TrashFilesPath)));
+                    } else {
+                        fileUrl = DUrl::fromLocalFile(filePath);
                     }
 
-                    //推送
-                    tryNotify();
+                    QMutexLocker lk(&mutex);
+                    allResults.append(fileUrl);
                 }
+
+                //推送
+                tryNotify();
             }
         }
-
-        reader->close();
-        writer->close();
     } catch (const LuceneException &e) {
         qWarning() << "Error: " << __FUNCTION__ << QString::fromStdWString(e.getError());
     } catch (const std::exception &e) {
@@ -400,9 +646,74 @@ bool FullTextSearcherPrivate::doSearch(const QString &path, const QString &keywo
         qWarning() << "Error: " << __FUNCTION__;
     }
 
+    // 只在有无效索引时打开 IndexWriter
+    if (!invalidFiles.isEmpty()) {
+        QMutexLocker lk(&indexMutex);
+
+        try {
+            IndexWriterPtr writer = newIndexWriter();
+            for (const QString &file : invalidFiles)
+                indexDocs(writer, file, kDeleteIndex);
+            writer->close();
+        } catch (const LuceneException &e) {
+            qWarning() << "Error: " << __FUNCTION__ << QString::fromStdWString(e.getError());
+        } catch (...) {
+            qWarning() << "Error: " << __FUNCTION__;
+        }
+    }
+
     return true;
 }
 
+/*!
+ * \brief FullTextSearcherPrivate::acquireReader 获取共享的 IndexReader，索引变化后重新打开
+ *
+ * 返回的 IndexReader 已增加引用计数，使用完后需调用 decRef，由 ReaderRef 负责。
+ */
+IndexReaderPtr FullTextSearcherPrivate::acquireReader()
+{
+    QMutexLocker lk(&readerMutex);
+
+    try {
+        if (!sharedReader) {
+            sharedReader = newIndexReader();
+        } else if (!sharedReader->isCurrent()) {
+            IndexReaderPtr reader = sharedReader->reopen();
+            if (reader != sharedReader) {
+                sharedReader->decRef();
+                sharedReader = reader;
+            }
+        }
+    } catch (const LuceneException &e) {
+        // 索引被重建时重新打开
+        qWarning() << "Error: " << __FUNCTION__ << QString::fromStdWString(e.getError());
+        if (sharedReader)
+            sharedReader->decRef();
+        sharedReader = newIndexReader();
+    }
+
+    sharedReader->incRef();
+    return sharedReader;
+}
+
+AnalyzerPtr FullTextSearcherPrivate::sharedAnalyzer()
+{
+    static AnalyzerPtr analyzer = newLucene<ChineseAnalyzer>();
+    return analyzer;
+}
+
+void FullTextSearcherPrivate::checkHit(SearchHit &hit)
+{
+    QFileInfo info(QString::fromStdWString(hit.path));
+    if (!info.exists()) {
+        hit.state = SearchHit::kRemoved;
+        return;
+    }
+
+    const QString &modifyTime = info.lastModified().toString("yyyyMMddHHmmss");
+    hit.state = modifyTime.toStdWString() == hit.storeTime ? SearchHit::kValid : SearchHit::kModified;
+}
+
 QString FullTextSearcherPrivate::dealKeyword(const QString &keyword)
 {
     static QRegExp cnReg("^[\u4e00-\u9fa5]");
@@ -461,6 +772,15 @@ bool FullTextSearcher::createIndex(const QString &path)
     return res;
 }
 
+bool FullTextSearcher::updateIndex(const QStringList &files)
+{
+    // 索引不存在时等待创建索引
+    if (d->isIndexCreating || !IndexReader::indexExists(FSDirectory::open(d->indexStorePath().toStdWString())))
+        return false;
+
+    return d->updateFiles(files);
+}
+
 bool FullTextSearcher::isSupport(const DUrl &url)
 {
     if (!url.isValid())
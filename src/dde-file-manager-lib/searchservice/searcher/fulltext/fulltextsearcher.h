@@ -20,6 +20,7 @@ class FullTextSearcher : public AbstractSearcher
 private:
     explicit FullTextSearcher(const DUrl &url, const QString &key, QObject *parent = nullptr);
     bool createIndex(const QString &path);
+    bool updateIndex(const QStringList &files);
     bool search() override;
     void stop() override;
     bool hasItem() const override;
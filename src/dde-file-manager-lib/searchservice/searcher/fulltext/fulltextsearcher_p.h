@@ -11,9 +11,72 @@
 
 #include <QStandardPaths>
 #include <QApplication>
+#include <QHash>
 #include <QMutex>
+#include <QWaitCondition>
+#include <QQueue>
 #include <QTime>
 
+/*!
+ * \brief BlockingQueue 有容量上限的阻塞队列
+ *
+ * 队列满时阻塞生产者，使遍历目录、解析文档和写入索引的速度相互制约，避免解析结果堆积占用大量内存。
+ */
+template<typename T>
+class BlockingQueue
+{
+public:
+    explicit BlockingQueue(int capacity)
+        : capacity(capacity) {}
+
+    //! 队列已关闭时返回 false
+    bool push(const T &value)
+    {
+        QMutexLocker lk(&mutex);
+        while (queue.size() >= capacity && !closed)
+            notFull.wait(&mutex);
+
+        if (closed)
+            return false;
+
+        queue.enqueue(value);
+        notEmpty.wakeOne();
+        return true;
+    }
+
+    //! 取出最多 maxCount 个元素，队列已关闭且为空时返回空列表
+    QList<T> pop(int maxCount = 1)
+    {
+        QMutexLocker lk(&mutex);
+        while (queue.isEmpty() && !closed)
+            notEmpty.wait(&mutex);
+
+        QList<T> values;
+        while (!queue.isEmpty() && values.size() < maxCount)
+            values << queue.dequeue();
+
+        notFull.wakeAll();
+        return values;
+    }
+
+    //! 关闭后不再接受新元素，已有的元素仍可取出
+    void close()
+    {
+        QMutexLocker lk(&mutex);
+        closed = true;
+        notFull.wakeAll();
+        notEmpty.wakeAll();
+    }
+
+private:
+    QMutex mutex;
+    QWaitCondition notFull;
+    QWaitCondition notEmpty;
+    QQueue<T> queue;
+    int capacity;
+    bool closed = false;
+};
+
 class FullTextSearcher;
 class FullTextSearcherPrivate : public QObject
 {
@@ -40,15 +103,47 @@ public:
     };
     Q_ENUM(IndexType)
 
+    //! 与 GA_FullTextStoreMode 对应
+    enum StoreMode {
+        kStoreNone,
+        kStoreSnippet,
+        kStoreContents
+    };
+
+    struct SearchHit
+    {
+        enum State {
+            kValid,
+            kModified,
+            kRemoved
+        };
+
+        Lucene::String path;
+        Lucene::String storeTime;
+        State state = kValid;
+    };
+
+    struct IndexJob
+    {
+        QString file;
+        IndexType type;
+        Lucene::DocumentPtr doc;
+    };
+
     explicit FullTextSearcherPrivate(FullTextSearcher *parent);
     ~FullTextSearcherPrivate();
 
 private:
     Lucene::IndexWriterPtr newIndexWriter(bool create = false);
+    void closeIndexWriter(const Lucene::IndexWriterPtr &writer);
     Lucene::IndexReaderPtr newIndexReader();
+    Lucene::IndexReaderPtr acquireReader();
+    static Lucene::AnalyzerPtr sharedAnalyzer();
+    static void checkHit(SearchHit &hit);
 
     bool createIndex(const QString &path);
     bool updateIndex(const QString &path);
+    bool updateFiles(const QStringList &files);
     bool doSearch(const QString &path, const QString &keyword);
     inline static QString indexStorePath()
     {
@@ -59,8 +154,9 @@ private:
 
     Lucene::DocumentPtr fileDocument(const QString &file);
     QString dealKeyword(const QString &keyword);
-    void doIndexTask(const Lucene::IndexReaderPtr &reader, const Lucene::IndexWriterPtr &writer, const QString &path, TaskType type);
-    void indexDocs(const Lucene::IndexWriterPtr &writer, const QString &file, IndexType type);
+    void runIndexPipeline(const Lucene::IndexReaderPtr &reader, const Lucene::IndexWriterPtr &writer, const QString &path, TaskType type);
+    void doIndexTask(const Lucene::IndexReaderPtr &reader, BlockingQueue<IndexJob> *queue, const QString &path, TaskType type);
+    void indexDocs(const Lucene::IndexWriterPtr &writer, const QString &file, IndexType type, const Lucene::DocumentPtr &doc = Lucene::DocumentPtr());
     bool checkUpdate(const Lucene::IndexReaderPtr &reader, const QString &file, IndexType &type);
     void tryNotify();
 
@@ -69,6 +165,13 @@ private:
     QList<DUrl> allResults;
     mutable QMutex mutex;
     static bool isIndexCreating;
+    //! 同一时刻只能有一个 IndexWriter
+    static QMutex indexMutex;
+    //! 各目录最近一次完整检查索引的时间，需持有 indexMutex
+    static QHash<QString, qint64> checkedTimes;
+    //! 所有搜索共享的 IndexReader，索引变化后重新打开
+    static QMutex readerMutex;
+    static Lucene::IndexReaderPtr sharedReader;
 
     //计时
     QTime notifyTimer;
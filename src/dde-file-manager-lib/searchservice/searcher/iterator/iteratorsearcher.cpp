@@ -5,19 +5,40 @@
 #include "iteratorsearcher.h"
 #include "utils/searchhelper.h"
 #include "interfaces/dfileservices.h"
+#include "controllers/pathmanager.h"
+#include "app/define.h"
+#include "singleton.h"
 
 #include <QDebug>
+#include <QFile>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include <deque>
+#include <dirent.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/stat.h>
 
 namespace {
 const int kEmitInterval = 50;   // 推送时间间隔（ms）
 const char *const kFilterFolders = "^/(boot|dev|proc|sys|run|lib|usr).*$";
+const int kMaxWorkerCount = 8;   // 并行遍历的线程数量上限
+const int kIdleWait = 200;   // 没有可遍历的目录时的等待时间（us）
 }
 
+struct DirectoryQueue
+{
+    QMutex mutex;
+    std::deque<QByteArray> dirs;
+};
+
 IteratorSearcher::IteratorSearcher(const DUrl &url, const QString &key, QObject *parent)
     : AbstractSearcher(url, RegularExpression::checkWildcardAndToRegularExpression(key), parent)
+    , matcher(key)
 {
     searchPathList << url;
-    regex = QRegularExpression(keyword, QRegularExpression::CaseInsensitiveOption);
 }
 
 bool IteratorSearcher::search()
@@ -60,14 +81,23 @@ QList<DUrl> IteratorSearcher::takeAll()
 void IteratorSearcher::tryNotify()
 {
     int cur = notifyTimer.elapsed();
-    if (hasItem() && (cur - lastEmit) > kEmitInterval) {
-        lastEmit = cur;
-        qDebug() << "IteratorSearcher unearthed, current spend:" << cur;
+    int last = lastEmit.loadAcquire();
+    // 并行遍历时多个线程同时调用，只有一个线程推送
+    if (hasItem() && (cur - last) > kEmitInterval && lastEmit.testAndSetRelease(last, cur)) {
+        dfmHotDebug() << "IteratorSearcher unearthed, current spend:" << cur;
         emit unearthed(this);
     }
 }
 
 void IteratorSearcher::doSearch()
+{
+    if (searchUrl.isLocalFile())
+        parallelSearch();
+    else
+        iterateSearch();
+}
+
+void IteratorSearcher::iterateSearch()
 {
     forever {
         if (searchPathList.isEmpty() || status.loadAcquire() != kRuning)
@@ -105,8 +135,7 @@ void IteratorSearcher::doSearch()
                     searchPathList << fileUrl;
             }
 
-            QRegularExpressionMatch match = regex.match(info->fileDisplayName());
-            if (match.hasMatch()) {
+            if (matcher.matches(info->fileDisplayName())) {
                 const auto &fileUrl = info->fileUrl();
                 {
                     QMutexLocker lk(&mutex);
@@ -121,3 +150,150 @@ void IteratorSearcher::doSearch()
         iterator.clear();
     }
 }
+
+void IteratorSearcher::parallelSearch()
+{
+    const int workerCount = qBound(1, QThread::idealThreadCount(), kMaxWorkerCount);
+
+    directoryQueues.clear();
+    for (int i = 0; i < workerCount; ++i)
+        directoryQueues << QSharedPointer<DirectoryQueue>::create();
+
+    visitedDirectories.clear();
+    pendingDirectories.storeRelease(1);
+    directoryQueues.first()->dirs.push_back(QFile::encodeName(searchUrl.toLocalFile()));
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(workerCount);
+
+    for (int i = 0; i < workerCount; ++i) {
+        QtConcurrent::run(&pool, [this, i] {
+            QByteArray dirPath;
+            while (status.loadAcquire() == kRuning) {
+                if (!takeDirectory(i, &dirPath)) {
+                    // 其它线程遍历完当前的目录后可能还有新的子目录
+                    if (pendingDirectories.loadAcquire() == 0)
+                        return;
+
+                    QThread::usleep(kIdleWait);
+                    continue;
+                }
+
+                scanDirectory(dirPath, directoryQueues.at(i).data());
+                pendingDirectories.deref();
+            }
+        });
+    }
+
+    pool.waitForDone();
+    directoryQueues.clear();
+}
+
+/*!
+ * \brief IteratorSearcher::takeDirectory 优先从自己队列的尾部取目录，队列为空时从其它线程队列的头部取
+ */
+bool IteratorSearcher::takeDirectory(int worker, QByteArray *dirPath)
+{
+    const int count = directoryQueues.count();
+    for (int i = 0; i < count; ++i) {
+        DirectoryQueue *queue = directoryQueues.at((worker + i) % count).data();
+        QMutexLocker lk(&queue->mutex);
+        if (queue->dirs.empty())
+            continue;
+
+        if (i == 0) {
+            *dirPath = queue->dirs.back();
+            queue->dirs.pop_back();
+        } else {
+            *dirPath = queue->dirs.front();
+            queue->dirs.pop_front();
+        }
+        return true;
+    }
+
+    return false;
+}
+
+void IteratorSearcher::scanDirectory(const QByteArray &dirPath, DirectoryQueue *queue)
+{
+    const QString &dirFilePath = QFile::decodeName(dirPath);
+
+    // 仅在过滤目录下进行搜索时，过滤目录下的内容才能被检索，QRegExp 不能在多个线程中同时使用
+    static const QRegularExpression reg(kFilterFolders);
+    if (!reg.match(searchUrl.toLocalFile()).hasMatch() && reg.match(dirFilePath).hasMatch())
+        return;
+
+    DIR *dir = opendir(dirPath.constData());
+    if (!dir)
+        return;
+
+    struct stat st;
+    if (fstat(dirfd(dir), &st) == 0) {
+        QMutexLocker lk(&visitedMutex);
+        const auto &key = qMakePair(quint64(st.st_dev), quint64(st.st_ino));
+        if (visitedDirectories.contains(key)) {
+            closedir(dir);
+            return;
+        }
+        visitedDirectories.insert(key);
+    }
+
+    const QByteArray &prefix = dirPath.endsWith('/') ? dirPath : dirPath + '/';
+    while (struct dirent *entry = readdir(dir)) {
+        //中断
+        if (status.loadAcquire() != kRuning)
+            break;
+
+        // 与 QDir 不含 Hidden 的过滤条件一致，同时排除 . 和 ..
+        if (entry->d_name[0] == '.')
+            continue;
+
+        unsigned char type = entry->d_type;
+        if (type == DT_UNKNOWN || type == DT_LNK) {
+            // 失效的链接不在结果中
+            const int flags = type == DT_UNKNOWN ? AT_SYMLINK_NOFOLLOW : 0;
+            if (fstatat(dirfd(dir), entry->d_name, &st, flags) != 0)
+                continue;
+
+            if (type == DT_UNKNOWN)
+                type = S_ISDIR(st.st_mode) ? DT_DIR : DT_REG;
+        }
+
+        const QByteArray &path = prefix + entry->d_name;
+        const bool isDir = type == DT_DIR;
+
+        // 将目录添加到待搜索目录中，不进入链接的目录
+        if (isDir) {
+            pendingDirectories.ref();
+            QMutexLocker lk(&queue->mutex);
+            queue->dirs.push_back(path);
+        }
+
+        // 只有匹配的文件才解码路径
+        if (matchFile(QByteArray::fromRawData(entry->d_name, static_cast<int>(strlen(entry->d_name))), path, isDir)) {
+            const DUrl &fileUrl = DUrl::fromLocalFile(QFile::decodeName(path));
+            {
+                QMutexLocker lk(&mutex);
+                allResults << fileUrl;
+            }
+
+            //推送
+            tryNotify();
+        }
+    }
+
+    closedir(dir);
+}
+
+/*!
+ * \brief IteratorSearcher::matchFile 用显示名称匹配关键字，只有显示名称与文件名不同的文件才创建文件信息
+ */
+bool IteratorSearcher::matchFile(const QByteArray &fileName, const QByteArray &filePath, bool isDir) const
+{
+    if (fileName.endsWith(".desktop") || (isDir && systemPathManager->isSystemPath(QFile::decodeName(filePath)))) {
+        const auto &info = DFileService::instance()->createFileInfo(nullptr, DUrl::fromLocalFile(QFile::decodeName(filePath)));
+        return info && matcher.matches(info->fileDisplayName());
+    }
+
+    return matcher.matches(fileName.constData(), fileName.size());
+}
@@ -6,11 +6,22 @@
 #define ITERATORSEARCHER_H
 
 #include "abstractsearcher.h"
+#include "utils/keywordmatcher.h"
 
 #include <QTime>
 #include <QMutex>
-#include <QRegularExpression>
+#include <QSharedPointer>
+#include <QVector>
+#include <QSet>
 
+struct DirectoryQueue;
+
+/*!
+ * \brief IteratorSearcher 遍历目录搜索文件名
+ *
+ * 本地目录由多个线程并行遍历，每个线程有自己的待搜索目录队列，空闲时从其它线程的队列取目录。
+ * 直接读取目录项匹配文件名，只在需要显示名称时创建文件信息。非本地目录通过 DFileService 逐个遍历。
+ */
 class IteratorSearcher : public AbstractSearcher
 {
     Q_OBJECT
@@ -26,17 +37,30 @@ private:
     QList<DUrl> takeAll() override;
     void tryNotify();
     void doSearch();
+    void iterateSearch();
+    void parallelSearch();
+    void scanDirectory(const QByteArray &dirPath, DirectoryQueue *queue);
+    bool takeDirectory(int worker, QByteArray *dirPath);
+    bool matchFile(const QByteArray &fileName, const QByteArray &filePath, bool isDir) const;
 
 private:
     QAtomicInt status = kReady;
     QList<DUrl> allResults;
     mutable QMutex mutex;
     QList<DUrl> searchPathList;
-    QRegularExpression regex;
+    KeywordMatcher matcher;
+
+    //! 并行遍历时每个线程的待搜索目录
+    QVector<QSharedPointer<DirectoryQueue>> directoryQueues;
+    //! 已入队但未遍历完的目录数量
+    QAtomicInt pendingDirectories = 0;
+    //! 已遍历的目录（设备号，inode），避免挂载点和链接形成的循环
+    QSet<QPair<quint64, quint64>> visitedDirectories;
+    QMutex visitedMutex;
 
     //计时
     QTime notifyTimer;
-    int lastEmit = 0;
+    QAtomicInt lastEmit = 0;
 };
 
 #endif   // ITERATORSEARCHER_H
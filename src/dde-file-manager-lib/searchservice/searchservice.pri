@@ -14,8 +14,10 @@ HEADERS += \
     $$PWD/searcher/iterator/iteratorsearcher.h \
     $$PWD/searcher/abstractsearcher.h \
     $$PWD/utils/searchhelper.h \
+    $$PWD/utils/keywordmatcher.h \
     $$PWD/searchservice.h \
     $$PWD/searcher/fsearch/fssearcher.h \
+    $$PWD/searcher/fsearch/fsdatabasemanager.h \
 #    -----------fsearch source---------------
     $$3RDPART_DIR/fsearch/query.h \
     $$3RDPART_DIR/fsearch/array.h \
@@ -39,8 +41,10 @@ SOURCES += \
     $$PWD/searcher/iterator/iteratorsearcher.cpp \
     $$PWD/searcher/abstractsearcher.cpp \
     $$PWD/utils/searchhelper.cpp \
+    $$PWD/utils/keywordmatcher.cpp \
     $$PWD/searchservice.cpp \
     $$PWD/searcher/fsearch/fssearcher.cpp \
+    $$PWD/searcher/fsearch/fsdatabasemanager.cpp \
 #    -----------fsearch source---------------
     $$3RDPART_DIR/fsearch/array.c \
     $$3RDPART_DIR/fsearch/btree.c \
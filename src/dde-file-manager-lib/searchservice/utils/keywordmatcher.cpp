@@ -0,0 +1,164 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "keywordmatcher.h"
+#include "searchhelper.h"
+
+#include <QFile>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+static inline char foldAscii(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + ('a' - 'A')) : c;
+}
+
+static inline bool equalsFolded(const char *data, const char *literal, int length)
+{
+    for (int i = 0; i < length; ++i) {
+        if (foldAscii(data[i]) != literal[i])
+            return false;
+    }
+
+    return true;
+}
+
+#if defined(__SSE2__)
+static inline __m128i foldAscii(__m128i v)
+{
+    // 大于等于0x80的字节按有符号数比较时为负数，不会被当作大写字母
+    const __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('A' - 1)),
+                                        _mm_cmplt_epi8(v, _mm_set1_epi8('Z' + 1)));
+
+    return _mm_add_epi8(v, _mm_and_si128(upper, _mm_set1_epi8('a' - 'A')));
+}
+#elif defined(__ARM_NEON)
+static inline uint8x16_t foldAscii(uint8x16_t v)
+{
+    const uint8x16_t upper = vandq_u8(vcgeq_u8(v, vdupq_n_u8('A')), vcleq_u8(v, vdupq_n_u8('Z')));
+
+    return vaddq_u8(v, vandq_u8(upper, vdupq_n_u8('a' - 'A')));
+}
+#endif
+
+KeywordMatcher::KeywordMatcher(const QString &keyword)
+    : m_keyword(keyword)
+{
+    bool literal = !keyword.isEmpty() && !keyword.contains('*') && !keyword.contains('?') && !keyword.contains('[');
+
+    // 非 ASCII 字符只按字节比较，有大小写之分的字符（如希腊字母）交给正则表达式
+    for (int i = 0; literal && i < keyword.size(); ++i) {
+        const QChar &c = keyword.at(i);
+
+        if (c.unicode() >= 0x80 && (c.toLower() != c || c.toUpper() != c))
+            literal = false;
+    }
+
+    if (literal) {
+        m_literal = QFile::encodeName(keyword);
+
+        for (char &c : m_literal)
+            c = foldAscii(c);
+    } else {
+        m_regex = QRegularExpression(RegularExpression::checkWildcardAndToRegularExpression(keyword),
+                                     QRegularExpression::CaseInsensitiveOption);
+    }
+}
+
+bool KeywordMatcher::isLiteral() const
+{
+    return !m_literal.isEmpty();
+}
+
+bool KeywordMatcher::matches(const QString &fileName) const
+{
+    if (isLiteral())
+        return fileName.contains(m_keyword, Qt::CaseInsensitive);
+
+    return m_regex.match(fileName).hasMatch();
+}
+
+/*!
+ * \brief KeywordMatcher::matches 匹配目录项中的文件名，只有使用正则表达式时才需要解码为 QString
+ */
+bool KeywordMatcher::matches(const char *fileName, int length) const
+{
+    if (isLiteral())
+        return indexOfLiteral(fileName, length, m_literal) >= 0;
+
+    return m_regex.match(QFile::decodeName(QByteArray::fromRawData(fileName, length))).hasMatch();
+}
+
+/*!
+ * \brief KeywordMatcher::indexOfLiteral 在 data 中查找 literal，data 中的 ASCII 字母按小写比较
+ * \param literal 已转为小写的关键字
+ * \return 第一次出现的位置，没有找到时返回-1
+ */
+int KeywordMatcher::indexOfLiteral(const char *data, int length, const QByteArray &literal)
+{
+    const int size = literal.size();
+
+    if (size == 0)
+        return 0;
+
+    const char *needle = literal.constData();
+    const char first = needle[0];
+    const char last = needle[size - 1];
+    int i = 0;
+
+#if defined(__SSE2__)
+    const __m128i vFirst = _mm_set1_epi8(first);
+    const __m128i vLast = _mm_set1_epi8(last);
+
+    // 同时比较16个位置的首字节和尾字节，读取范围不超过 data 的末尾
+    for (; i + size - 1 + 16 <= length; i += 16) {
+        const __m128i head = foldAscii(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i)));
+        const __m128i tail = foldAscii(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i + size - 1)));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(head, vFirst),
+                                                                               _mm_cmpeq_epi8(tail, vLast))));
+
+        while (mask) {
+            const int offset = __builtin_ctz(mask);
+
+            if (equalsFolded(data + i + offset + 1, needle + 1, size - 2))
+                return i + offset;
+
+            mask &= mask - 1;
+        }
+    }
+#elif defined(__ARM_NEON)
+    const uint8x16_t vFirst = vdupq_n_u8(static_cast<uint8_t>(first));
+    const uint8x16_t vLast = vdupq_n_u8(static_cast<uint8_t>(last));
+
+    for (; i + size - 1 + 16 <= length; i += 16) {
+        const uint8x16_t head = foldAscii(vld1q_u8(reinterpret_cast<const uint8_t *>(data + i)));
+        const uint8x16_t tail = foldAscii(vld1q_u8(reinterpret_cast<const uint8_t *>(data + i + size - 1)));
+        const uint8x16_t eq = vandq_u8(vceqq_u8(head, vFirst), vceqq_u8(tail, vLast));
+        // 每个字节的比较结果压缩为4位
+        uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+
+        while (mask) {
+            const int offset = __builtin_ctzll(mask) >> 2;
+
+            if (equalsFolded(data + i + offset + 1, needle + 1, size - 2))
+                return i + offset;
+
+            mask &= ~(0xFULL << (offset * 4));
+        }
+    }
+#endif
+
+    for (; i + size <= length; ++i) {
+        if (foldAscii(data[i]) == first && foldAscii(data[i + size - 1]) == last
+                && equalsFolded(data + i + 1, needle + 1, size - 2)) {
+            return i;
+        }
+    }
+
+    return -1;
+}
@@ -0,0 +1,37 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef KEYWORDMATCHER_H
+#define KEYWORDMATCHER_H
+
+#include <QString>
+#include <QByteArray>
+#include <QRegularExpression>
+
+/*!
+ * \brief KeywordMatcher 用搜索关键字匹配文件名，不区分大小写
+ *
+ * 不含通配符的关键字按子串匹配，直接在文件名的原始字节上查找：先用 SIMD 指令比较关键字的首尾字节，
+ * 只有首尾都相同的位置才逐字节比较，ASCII 字母在比较时转为小写。
+ * 含通配符或含有区分大小写的非 ASCII 字符的关键字仍然使用正则表达式。
+ */
+class KeywordMatcher
+{
+public:
+    explicit KeywordMatcher(const QString &keyword = QString());
+
+    bool isLiteral() const;
+    bool matches(const QString &fileName) const;
+    bool matches(const char *fileName, int length) const;
+
+    static int indexOfLiteral(const char *data, int length, const QByteArray &literal);
+
+private:
+    QString m_keyword;
+    // 转为小写的关键字，按文件名的编码保存，为空时使用正则表达式
+    QByteArray m_literal;
+    QRegularExpression m_regex;
+};
+
+#endif // KEYWORDMATCHER_H
@@ -4,51 +4,92 @@
 
 #include "checknetwork.h"
 
+#include <QElapsedTimer>
+#include <QHash>
+
 #include <netdb.h>
 #include <sys/socket.h>
 #include <arpa/inet.h>
 #include <unistd.h>
+#include <poll.h>
+#include <errno.h>
+
+// 可以连接的结果的有效时间(毫秒)
+#define REACHABLE_CACHE_TTL 30000
+// 连接不上的结果的有效时间(毫秒)，期间直接返回失败，不再等待连接超时
+#define UNREACHABLE_CACHE_TTL 5000
+// 建立连接的超时时间(毫秒)
+#define CONNECT_TIMEOUT 1200
+
+struct HostReachability {
+    bool reachable = false;
+    QElapsedTimer checked;
+};
 
 static QMap<QString,bool> m_networkConnected;
+static QMutex reachabilityMutex;
+static QHash<QString, HostReachability> reachabilityCache;
+
+static bool connectWithTimeout(const addrinfo *addr, int timeout)
+{
+    int handle = socket(addr->ai_family, addr->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC, addr->ai_protocol);
+    if (handle == -1)
+        return false;
+
+    bool connected = ::connect(handle, addr->ai_addr, addr->ai_addrlen) == 0;
+    if (!connected && errno == EINPROGRESS) {
+        pollfd fds { handle, POLLOUT, 0 };
+        if (poll(&fds, 1, timeout) == 1) {
+            int error = 0;
+            socklen_t length = sizeof(error);
+            connected = getsockopt(handle, SOL_SOCKET, SO_ERROR, &error, &length) == 0 && error == 0;
+        }
+    }
+
+    close(handle);
+    return connected;
+}
+
 CheckNetwork::CheckNetwork(QObject *parent) : QObject(parent)
 {
 
 }
 
+/*!
+ * \brief CheckNetwork::isHostAndPortConnect 检查主机的端口是否可以连接
+ *
+ * 结果按主机和端口缓存，连接不上的结果缓存的时间较短，期间访问同一主机直接失败，不必每次等待连接超时
+ */
 bool CheckNetwork::isHostAndPortConnect(const QString &host, const QString &port)
 {
+    const QString &key = host + "_" + port;
+
+    {
+        QMutexLocker lk(&reachabilityMutex);
+        const HostReachability &cached = reachabilityCache.value(key);
+        if (cached.checked.isValid()
+                && !cached.checked.hasExpired(cached.reachable ? REACHABLE_CACHE_TTL : UNREACHABLE_CACHE_TTL))
+            return cached.reachable;
+    }
+
     addrinfo *result;
     addrinfo hints{};
     hints.ai_family = AF_UNSPEC;   // either IPv4 or IPv6
     hints.ai_socktype = SOCK_STREAM;
-    char addressString[INET6_ADDRSTRLEN];
-    const char *retval = nullptr;
-    if (0 != getaddrinfo(host.toUtf8().toStdString().c_str(), port.toUtf8().toStdString().c_str(), &hints, &result)) {
-        return false;
-    }
-    for (addrinfo *addr = result; addr != nullptr; addr = addr->ai_next) {
-        int handle = socket(addr->ai_family, addr->ai_socktype, addr->ai_protocol);
-        if (handle == -1) {
-            continue;
-        }
-        if (::connect(handle, addr->ai_addr, addr->ai_addrlen) != -1) {
-            switch(addr->ai_family) {
-                case AF_INET:
-                    retval = inet_ntop(addr->ai_family, &(reinterpret_cast<sockaddr_in *>(addr->ai_addr)->sin_addr), addressString, INET6_ADDRSTRLEN);
-                    break;
-                case AF_INET6:
-                    retval = inet_ntop(addr->ai_family, &(reinterpret_cast<sockaddr_in6 *>(addr->ai_addr)->sin6_addr), addressString, INET6_ADDRSTRLEN);
-                    break;
-                default:
-                    // unknown family
-                    retval = nullptr;
-            }
-            close(handle);
-            break;
-        }
+    bool reachable = false;
+    if (0 == getaddrinfo(host.toUtf8().toStdString().c_str(), port.toUtf8().toStdString().c_str(), &hints, &result)) {
+        for (addrinfo *addr = result; addr != nullptr && !reachable; addr = addr->ai_next)
+            reachable = connectWithTimeout(addr, CONNECT_TIMEOUT);
+
+        freeaddrinfo(result);
     }
-    freeaddrinfo(result);
-    return retval != nullptr;
+
+    QMutexLocker lk(&reachabilityMutex);
+    HostReachability &entry = reachabilityCache[key];
+    entry.reachable = reachable;
+    entry.checked.start();
+
+    return reachable;
 }
 
 bool CheckNetwork::isHostAndPortConnectV2(const QString &host, quint16 port, int timeout, bool fast)
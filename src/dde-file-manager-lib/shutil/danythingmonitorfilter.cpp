@@ -4,6 +4,7 @@
 
 #include <map>
 #include <memory>
+#include <vector>
 #include <utility>
 #include <functional>
 
@@ -18,6 +19,7 @@
 #include <QFileInfo>
 #include <QJsonObject>
 #include <QTextStream>
+#include <QReadWriteLock>
 
 
 namespace detail {
@@ -61,6 +63,89 @@ static QString restoreEscapedChar(const QString &value)
     return tempValue;
 }
 
+/*!
+ * \brief PathPrefixTrie 按字节保存白名单和黑名单路径的前缀树
+ *
+ * 查找时沿路径的字节逐层向下，经过的每个节点都是路径的一个前缀，
+ * 因此判断一个路径是否以名单中的某一项开头只需遍历一次路径，且不需要分配内存。
+ */
+class PathPrefixTrie
+{
+public:
+    enum Flag {
+        White = 0x1,
+        Black = 0x2
+    };
+
+    PathPrefixTrie()
+    {
+        clear();
+    }
+
+    void clear()
+    {
+        m_nodes.clear();
+        m_nodes.push_back(Node());
+    }
+
+    void insert(const QByteArray &path, Flag flag)
+    {
+        int index = 0;
+
+        for (const char ch : path) {
+            int child = m_nodes[static_cast<size_t>(index)].firstChild;
+
+            while (child >= 0 && m_nodes[static_cast<size_t>(child)].ch != ch)
+                child = m_nodes[static_cast<size_t>(child)].nextSibling;
+
+            if (child < 0) {
+                Node node;
+                node.ch = ch;
+                node.nextSibling = m_nodes[static_cast<size_t>(index)].firstChild;
+                child = static_cast<int>(m_nodes.size());
+                m_nodes.push_back(node);
+                m_nodes[static_cast<size_t>(index)].firstChild = child;
+            }
+
+            index = child;
+        }
+
+        m_nodes[static_cast<size_t>(index)].flags |= flag;
+    }
+
+    // 返回名单中所有为 path 前缀的项的标记，遇到黑名单时提前返回
+    int prefixFlags(const char *path, int length) const
+    {
+        int index = 0;
+        int flags = m_nodes.front().flags;
+
+        for (int i = 0; i < length && !(flags & Black); ++i) {
+            int child = m_nodes[static_cast<size_t>(index)].firstChild;
+
+            while (child >= 0 && m_nodes[static_cast<size_t>(child)].ch != path[i])
+                child = m_nodes[static_cast<size_t>(child)].nextSibling;
+
+            if (child < 0)
+                break;
+
+            index = child;
+            flags |= m_nodes[static_cast<size_t>(index)].flags;
+        }
+
+        return flags;
+    }
+
+private:
+    struct Node {
+        char ch = 0;
+        int flags = 0;
+        int firstChild = -1;
+        int nextSibling = -1;
+    };
+
+    std::vector<Node> m_nodes;
+};
+
 }
 
 
@@ -81,6 +166,8 @@ public:
 
     void read_setting();
     void get_home_path_of_all_users();
+    // 将白名单和黑名单编译到前缀树中
+    void build_path_trie();
 
     DAnythingMonitorFilter *q_ptr{ nullptr };
 
@@ -88,6 +175,8 @@ public:
     std::unique_ptr<QList<QString>> m_black_list{ nullptr };
     std::unique_ptr<QList<QString>> m_white_list{ nullptr };
     std::unique_ptr<dde_file_manager::DFMSettings> m_fm_setting{ nullptr };
+    detail::PathPrefixTrie m_path_trie{};
+    QReadWriteLock m_path_trie_lock{};
 };
 
 DAnythingMonitorFilterPrivate::DAnythingMonitorFilterPrivate(DAnythingMonitorFilter *const q_q)
@@ -97,33 +186,46 @@ m_white_list{ new QList<QString> },
 m_fm_setting{ dde_file_manager::DFMApplication::genericSetting() }
 {
     this->read_setting();
+
+    ///###: rebuild the path trie when the configure is changed.
+    QObject::connect(m_fm_setting.get(), &dde_file_manager::DFMSettings::valueChanged, q_q,
+                     [this](const QString &group, const QString &key, const QVariant &value) {
+        Q_UNUSED(key)
+        Q_UNUSED(value)
+
+        if (group == "AnythingMonitorFilterPath")
+            this->read_setting();
+    });
 }
 
 bool DAnythingMonitorFilterPrivate::whetherFilterThePath(const QByteArray &local_path)
 {
-    QString local_file{ QString::fromLocal8Bit(local_path) };
+    const char *data{ local_path.constData() };
+    int length{ local_path.size() };
 
     //从数据盘进入主目录的路径在判断之前需要先处理成/home路径
-    if (local_file.startsWith("/data/home/"))
-        local_file.remove(0, sizeof("/data") - 1);
-
-    bool result{ false };
+    if (local_path.startsWith("/data/home/")) {
+        data += sizeof("/data") - 1;
+        length -= static_cast<int>(sizeof("/data") - 1);
+    }
 
-    for (const QString &path : *m_white_list) {
+    QReadLocker locker{ &m_path_trie_lock };
+    int flags{ m_path_trie.prefixFlags(data, length) };
 
-        if (local_file == path || local_file.startsWith(path)) {
-            result = true;
-        }
-    }
+    ///###: the path is monitored when it is under the white-list and not under the black-list.
+    return (flags & detail::PathPrefixTrie::White) && !(flags & detail::PathPrefixTrie::Black);
+}
 
-    for (const QString &path : *m_black_list) {
+void DAnythingMonitorFilterPrivate::build_path_trie()
+{
+    QWriteLocker locker{ &m_path_trie_lock };
+    m_path_trie.clear();
 
-        if (local_file == path || local_file.startsWith(path)) {
-            result = false;
-        }
-    }
+    for (const QString &path : *m_white_list)
+        m_path_trie.insert(path.toLocal8Bit(), detail::PathPrefixTrie::White);
 
-    return result;
+    for (const QString &path : *m_black_list)
+        m_path_trie.insert(path.toLocal8Bit(), detail::PathPrefixTrie::Black);
 }
 
 void DAnythingMonitorFilterPrivate::get_home_path_of_all_users()
@@ -272,6 +374,8 @@ void DAnythingMonitorFilterPrivate::read_setting()
     reserve_dir(std::ref(m_white_list));
     reserve_dir(std::ref(m_black_list));
 
+    this->build_path_trie();
+
 
 #ifdef QT_DEBUG
     qDebug() << "white-list: " << *m_white_list;
@@ -5,9 +5,74 @@
 #include "desktopfile.h"
 #include "properties.h"
 #include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
 #include <QSettings>
+#include <QLocale>
+#include <QDataStream>
+#include <QHash>
+#include <QMutex>
 #include <QDebug>
 
+// 解析结果缓存的最大数量，超出后清空重新缓存
+#define DESKTOP_FILE_CACHE_MAX 4096
+
+namespace {
+struct DesktopFileCacheEntry
+{
+    qint64 lastModified = -1;
+    qint64 size = -1;
+    QString locale;
+    DesktopFile desktopFile;
+};
+
+/*!
+ * \brief The DesktopFileCache class 进程内共享的 desktop 文件解析结果
+ *
+ * 桌面图标、文件服务和打开方式等会反复构造同一个 desktop 文件，文件的修改时间、大小以及系统语言
+ * （本地化的名称在解析时确定）都没有变化时直接复制已解析的内容
+ */
+class DesktopFileCache
+{
+public:
+    bool find(const QFileInfo &info, const QString &locale, DesktopFile &file)
+    {
+        QMutexLocker locker(&mutex);
+        auto it = entries.constFind(info.absoluteFilePath());
+
+        if (it == entries.constEnd() || it->lastModified != info.lastModified().toMSecsSinceEpoch()
+                || it->size != info.size() || it->locale != locale) {
+            return false;
+        }
+
+        file = it->desktopFile;
+
+        return true;
+    }
+
+    void insert(const QFileInfo &info, const QString &locale, const DesktopFile &file)
+    {
+        QMutexLocker locker(&mutex);
+
+        if (entries.size() >= DESKTOP_FILE_CACHE_MAX)
+            entries.clear();
+
+        DesktopFileCacheEntry &entry = entries[info.absoluteFilePath()];
+
+        entry.lastModified = info.lastModified().toMSecsSinceEpoch();
+        entry.size = info.size();
+        entry.locale = locale;
+        entry.desktopFile = file;
+    }
+
+private:
+    QMutex mutex;
+    QHash<QString, DesktopFileCacheEntry> entries;
+};
+
+Q_GLOBAL_STATIC(DesktopFileCache, desktopFileCache)
+}
+
 /**
  * @brief Loads desktop file
  * @param fileName
@@ -16,10 +81,31 @@ DesktopFile::DesktopFile(const QString &fileName)
     : m_fileName(fileName)
 {
     // File validity
-    if (m_fileName.isEmpty() || !QFile::exists(fileName)) {
+    if (m_fileName.isEmpty()) {
         return;
     }
 
+    const QFileInfo info(fileName);
+
+    if (!info.exists()) {
+        return;
+    }
+
+    const QString &locale = QLocale::system().name();
+
+    if (desktopFileCache->find(info, locale, *this)) {
+        // 缓存中的文件名可能是其它写法的同一路径
+        m_fileName = fileName;
+        return;
+    }
+
+    load();
+    desktopFileCache->insert(info, locale, *this);
+}
+
+void DesktopFile::load()
+{
+    const QString &fileName = m_fileName;
     QSettings settings(fileName, QSettings::IniFormat);
     settings.beginGroup("Desktop Entry");
     // Loads .desktop file (read from 'Desktop Entry' group)
@@ -159,3 +245,21 @@ QStringList DesktopFile::getMimeType() const
     return m_mimeType;
 }
 //---------------------------------------------------------------------------
+
+QDataStream &operator<<(QDataStream &out, const DesktopFile &file)
+{
+    out << file.m_fileName << file.m_name << file.m_genericName << file.m_localName
+        << file.m_exec << file.m_icon << file.m_type << file.m_categories << file.m_mimeType
+        << file.m_deepinId << file.m_deepinVendor << file.m_noDisplay << file.m_hidden;
+
+    return out;
+}
+
+QDataStream &operator>>(QDataStream &in, DesktopFile &file)
+{
+    in >> file.m_fileName >> file.m_name >> file.m_genericName >> file.m_localName
+       >> file.m_exec >> file.m_icon >> file.m_type >> file.m_categories >> file.m_mimeType
+       >> file.m_deepinId >> file.m_deepinVendor >> file.m_noDisplay >> file.m_hidden;
+
+    return in;
+}
@@ -7,6 +7,8 @@
 
 #include <QStringList>
 
+class QDataStream;
+
 /**
  * @class DesktopFile
  * @brief Represents a linux desktop file
@@ -29,7 +31,13 @@ public:
   bool getNoShow() const;
   QStringList getCategories() const;
   QStringList getMimeType() const;
+
+  // 用于 MimesAppsManager 的应用索引缓存
+  friend QDataStream &operator<<(QDataStream &out, const DesktopFile &file);
+  friend QDataStream &operator>>(QDataStream &in, DesktopFile &file);
 private:
+  void load();
+
   QString m_fileName;
   QString m_name;
   QString m_genericName;
@@ -0,0 +1,131 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dfmdragurls.h"
+
+#include <QSharedMemory>
+#include <QDebug>
+
+#include <cstring>
+#include <limits>
+
+static constexpr quint32 DRAGURLSMAGIC{ 0x44555253 }; // "DURS"
+//! 与之前相同至少分配 5M，url 较多时按需增大
+static constexpr int DRAGURLSMINSIZE{ 5 * 1024 * 1024 };
+
+namespace {
+struct DragUrlsHeader
+{
+    quint32 magic;
+    quint32 count;
+    quint32 dataSize;
+};
+}
+
+bool DFMDragUrls::write(QSharedMemory *sm, const QList<QUrl> &urls)
+{
+    if (!sm)
+        return false;
+
+    QList<QByteArray> encodedUrls;
+    encodedUrls.reserve(urls.size());
+    qint64 dataSize = 0;
+    for (const QUrl &url : urls) {
+        encodedUrls << url.toString().toUtf8();
+        dataSize += static_cast<qint64>(sizeof(quint32)) + encodedUrls.last().size();
+    }
+
+    const qint64 size = static_cast<qint64>(sizeof(DragUrlsHeader)) + dataSize;
+    if (size > std::numeric_limits<int>::max())
+        return false;
+
+    if (sm->isAttached() && !sm->detach())
+        return false;
+
+    bool created = sm->create(qMax(DRAGURLSMINSIZE, static_cast<int>(size)));
+    if (!created) {
+        //因为创建失败，就没有连接内存，所以写失败
+        if (sm->error() != QSharedMemory::AlreadyExists || !sm->attach())
+            return false;
+    }
+
+    sm->lock();
+    char *to = static_cast<char *>(sm->data());
+    DragUrlsHeader header { DRAGURLSMAGIC, 0, 0 };
+    bool ok = sm->size() >= size;
+    // 已有的内存段不够大时只写入空的头部，目标会改为从 QMimeData 读取
+    if (ok) {
+        header.count = static_cast<quint32>(encodedUrls.size());
+        header.dataSize = static_cast<quint32>(dataSize);
+
+        char *pos = to + sizeof(DragUrlsHeader);
+        for (const QByteArray &url : encodedUrls) {
+            const quint32 length = static_cast<quint32>(url.size());
+            memcpy(pos, &length, sizeof(length));
+            pos += sizeof(length);
+            memcpy(pos, url.constData(), length);
+            pos += length;
+        }
+    } else {
+        header.magic = 0;
+        qWarning() << "drag urls need" << size << "bytes, but shared memory size is" << sm->size();
+    }
+    if (sm->size() >= static_cast<int>(sizeof(DragUrlsHeader)))
+        memcpy(to, &header, sizeof(header));
+    sm->unlock();
+
+    return ok;
+}
+
+bool DFMDragUrls::read(const QString &key, QList<QUrl> &urls)
+{
+    QSharedMemory sm;
+    sm.setKey(key);
+
+    if (!sm.attach(QSharedMemory::ReadOnly)) {
+        qDebug() << "FQSharedMemory attach failed." << sm.errorString();
+        return false;
+    }
+
+    bool ok = false;
+    QList<QUrl> result;
+
+    sm.lock();
+    const char *from = static_cast<const char *>(sm.constData());
+    const qint64 size = sm.size();
+    DragUrlsHeader header { 0, 0, 0 };
+    if (size >= static_cast<qint64>(sizeof(header))) {
+        memcpy(&header, from, sizeof(header));
+        ok = header.magic == DRAGURLSMAGIC
+             && static_cast<qint64>(sizeof(header)) + header.dataSize <= size;
+    }
+
+    if (ok) {
+        const char *pos = from + sizeof(header);
+        const char *end = pos + header.dataSize;
+        result.reserve(static_cast<int>(qMin<quint32>(header.count, header.dataSize / sizeof(quint32))));
+        for (quint32 i = 0; i < header.count; ++i) {
+            quint32 length = 0;
+            if (end - pos < static_cast<qint64>(sizeof(length))) {
+                ok = false;
+                break;
+            }
+            memcpy(&length, pos, sizeof(length));
+            pos += sizeof(length);
+            if (end - pos < static_cast<qint64>(length)) {
+                ok = false;
+                break;
+            }
+            result << QUrl(QString::fromUtf8(pos, static_cast<int>(length)));
+            pos += length;
+        }
+    }
+    sm.unlock();
+    sm.detach();
+
+    if (ok)
+        urls = result;
+
+    return ok;
+}
@@ -0,0 +1,24 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <QList>
+#include <QUrl>
+
+class QSharedMemory;
+
+/*!
+ * \brief DFMDragUrls 通过共享内存在拖拽的源和目标之间传递文件 url
+ *
+ * 源把 url 写入一个共享内存段，依次为 url 的数量和每个带长度前缀的 UTF-8 字符串；目标以只读方式连接，
+ * 直接在共享内存中解析，不经过 QDataStream，也不复制整个内存段。
+ * 共享内存不可用或内容无效时返回 false，调用者改为从 QMimeData 中读取 url。
+ */
+class DFMDragUrls
+{
+public:
+    static bool write(QSharedMemory *sm, const QList<QUrl> &urls);
+    static bool read(const QString &key, QList<QUrl> &urls);
+};
@@ -0,0 +1,471 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dfmembeddedpreview.h"
+
+#include <QFile>
+#include <QBuffer>
+#include <QImageReader>
+#include <QImageIOHandler>
+#include <QTransform>
+#include <QSet>
+#include <QtEndian>
+
+#include <algorithm>
+#include <cstring>
+
+// 解析的 IFD 数量和每个 IFD 的条目数上限，避免损坏的文件导致长时间解析
+#define TIFF_MAX_IFD_COUNT 32
+#define TIFF_MAX_ENTRY_COUNT 1024
+#define TIFF_MAX_SUB_IFD_COUNT 8
+// EXIF 缩略图与原图的宽高比相差超过此值时认为缩略图带有黑边
+#define EXIF_THUMBNAIL_RATIO_TOLERANCE 0.02
+// 查找 EXIF 时最多跳过的 JPEG 段数量
+#define JPEG_MAX_SEGMENT_COUNT 32
+
+namespace {
+
+struct PreviewData {
+    qint64 offset = 0;
+    qint64 length = 0;
+};
+
+/*!
+ * \brief The TiffParser class 解析 TIFF 结构（EXIF 及多数相机 RAW 格式）中的 JPEG 预览图位置
+ */
+class TiffParser
+{
+public:
+    TiffParser(QIODevice *device, qint64 base)
+        : m_device(device)
+        , m_base(base) {}
+
+    bool parse();
+
+    QList<PreviewData> previews;
+    quint16 orientation = 1;
+
+private:
+    bool read(qint64 offset, char *data, int size);
+    bool readU16(qint64 offset, quint16 *value);
+    bool readU32(qint64 offset, quint32 *value);
+    bool readValue(qint64 entry, quint16 type, quint32 *value);
+    void parseIfd(quint32 offset, bool isFirst, int depth);
+
+    QIODevice *m_device;
+    qint64 m_base;
+    bool m_littleEndian = true;
+    QSet<quint32> m_parsedIfds;
+};
+
+bool TiffParser::parse()
+{
+    char header[2];
+
+    if (!read(0, header, 2))
+        return false;
+
+    if (header[0] == 'I' && header[1] == 'I')
+        m_littleEndian = true;
+    else if (header[0] == 'M' && header[1] == 'M')
+        m_littleEndian = false;
+    else
+        return false;
+
+    quint16 magic = 0;
+    quint32 ifd = 0;
+
+    if (!readU16(2, &magic) || !readU32(4, &ifd))
+        return false;
+
+    // 42 为标准 TIFF，0x4f52、0x5352 为 Olympus ORF，0x55 为 Panasonic RW2
+    if (magic != 42 && magic != 0x4f52 && magic != 0x5352 && magic != 0x55)
+        return false;
+
+    parseIfd(ifd, true, 0);
+
+    return true;
+}
+
+bool TiffParser::read(qint64 offset, char *data, int size)
+{
+    if (!m_device->seek(m_base + offset))
+        return false;
+
+    return m_device->read(data, size) == size;
+}
+
+bool TiffParser::readU16(qint64 offset, quint16 *value)
+{
+    uchar data[2];
+
+    if (!read(offset, reinterpret_cast<char *>(data), 2))
+        return false;
+
+    *value = m_littleEndian ? qFromLittleEndian<quint16>(data) : qFromBigEndian<quint16>(data);
+
+    return true;
+}
+
+bool TiffParser::readU32(qint64 offset, quint32 *value)
+{
+    uchar data[4];
+
+    if (!read(offset, reinterpret_cast<char *>(data), 4))
+        return false;
+
+    *value = m_littleEndian ? qFromLittleEndian<quint32>(data) : qFromBigEndian<quint32>(data);
+
+    return true;
+}
+
+// 读取只有一个值的 SHORT 或 LONG 类型条目
+bool TiffParser::readValue(qint64 entry, quint16 type, quint32 *value)
+{
+    if (type == 3) {
+        quint16 shortValue = 0;
+
+        if (!readU16(entry + 8, &shortValue))
+            return false;
+
+        *value = shortValue;
+
+        return true;
+    }
+
+    if (type == 4 || type == 13)
+        return readU32(entry + 8, value);
+
+    return false;
+}
+
+void TiffParser::parseIfd(quint32 offset, bool isFirst, int depth)
+{
+    while (offset > 0 && m_parsedIfds.size() < TIFF_MAX_IFD_COUNT && !m_parsedIfds.contains(offset)) {
+        m_parsedIfds.insert(offset);
+
+        quint16 count = 0;
+
+        if (!readU16(offset, &count) || count > TIFF_MAX_ENTRY_COUNT)
+            return;
+
+        quint32 compression = 0;
+        quint32 stripOffset = 0;
+        quint32 stripLength = 0;
+        quint32 jpegOffset = 0;
+        quint32 jpegLength = 0;
+        QList<quint32> subIfds;
+
+        for (int i = 0; i < count; ++i) {
+            const qint64 entry = offset + 2 + i * 12;
+            quint16 tag = 0;
+            quint16 type = 0;
+            quint32 valueCount = 0;
+
+            if (!readU16(entry, &tag) || !readU16(entry + 2, &type) || !readU32(entry + 4, &valueCount))
+                return;
+
+            switch (tag) {
+            case 0x0103: // Compression
+                readValue(entry, type, &compression);
+                break;
+            case 0x0111: // StripOffsets
+                if (valueCount == 1)
+                    readValue(entry, type, &stripOffset);
+                break;
+            case 0x0117: // StripByteCounts
+                if (valueCount == 1)
+                    readValue(entry, type, &stripLength);
+                break;
+            case 0x0201: // JPEGInterchangeFormat
+                readValue(entry, type, &jpegOffset);
+                break;
+            case 0x0202: // JPEGInterchangeFormatLength
+                readValue(entry, type, &jpegLength);
+                break;
+            case 0x0112: // Orientation
+                if (isFirst) {
+                    quint32 value = 1;
+
+                    if (readValue(entry, type, &value))
+                        orientation = static_cast<quint16>(value);
+                }
+                break;
+            case 0x014a: { // SubIFDs
+                quint32 value = 0;
+
+                if (!readU32(entry + 8, &value))
+                    break;
+
+                if (valueCount == 1) {
+                    subIfds << value;
+                    break;
+                }
+
+                for (quint32 j = 0; j < valueCount && j < TIFF_MAX_SUB_IFD_COUNT; ++j) {
+                    quint32 subIfd = 0;
+
+                    if (readU32(value + j * 4, &subIfd))
+                        subIfds << subIfd;
+                }
+                break;
+            }
+            default:
+                break;
+            }
+        }
+
+        if (jpegOffset > 0 && jpegLength > 0) {
+            PreviewData preview;
+            preview.offset = m_base + jpegOffset;
+            preview.length = jpegLength;
+            previews << preview;
+        }
+
+        // 6、7 为 JPEG 压缩，只有一个数据块时可直接作为 JPEG 文件解码
+        if ((compression == 6 || compression == 7) && stripOffset > 0 && stripLength > 0) {
+            PreviewData preview;
+            preview.offset = m_base + stripOffset;
+            preview.length = stripLength;
+            previews << preview;
+        }
+
+        if (depth < 2) {
+            for (quint32 subIfd : subIfds)
+                parseIfd(subIfd, false, depth + 1);
+        }
+
+        isFirst = false;
+
+        if (!readU32(offset + 2 + count * 12, &offset))
+            return;
+    }
+}
+
+// 返回 JPEG 文件中 EXIF 数据的 TIFF 头的位置，没有 EXIF 时返回-1
+qint64 findExifOffset(QIODevice *device)
+{
+    uchar data[4];
+
+    if (!device->seek(0) || device->read(reinterpret_cast<char *>(data), 2) != 2 || data[0] != 0xff || data[1] != 0xd8)
+        return -1;
+
+    qint64 pos = 2;
+
+    for (int i = 0; i < JPEG_MAX_SEGMENT_COUNT; ++i) {
+        if (!device->seek(pos) || device->read(reinterpret_cast<char *>(data), 4) != 4 || data[0] != 0xff)
+            return -1;
+
+        const uchar marker = data[1];
+
+        // SOS 之后为图像数据
+        if (marker == 0xda || marker == 0xd9)
+            return -1;
+
+        if (marker == 0xe1) {
+            char identifier[6];
+
+            if (device->read(identifier, 6) == 6 && memcmp(identifier, "Exif\0\0", 6) == 0)
+                return pos + 10;
+        }
+
+        pos += 2 + qFromBigEndian<quint16>(data + 2);
+    }
+
+    return -1;
+}
+
+// Fujifilm RAF 文件头中记录了 JPEG 预览图的位置
+bool findRafPreview(QIODevice *device, PreviewData *preview)
+{
+    uchar data[8];
+
+    if (!device->seek(0) || device->read(16) != "FUJIFILMCCD-RAW ")
+        return false;
+
+    if (!device->seek(84) || device->read(reinterpret_cast<char *>(data), 8) != 8)
+        return false;
+
+    preview->offset = qFromBigEndian<quint32>(data);
+    preview->length = qFromBigEndian<quint32>(data + 4);
+
+    return true;
+}
+
+QImageIOHandler::Transformations exifTransformation(quint16 orientation)
+{
+    switch (orientation) {
+    case 2:
+        return QImageIOHandler::TransformationMirror;
+    case 3:
+        return QImageIOHandler::TransformationRotate180;
+    case 4:
+        return QImageIOHandler::TransformationFlip;
+    case 5:
+        return QImageIOHandler::TransformationFlipAndRotate90;
+    case 6:
+        return QImageIOHandler::TransformationRotate90;
+    case 7:
+        return QImageIOHandler::TransformationMirrorAndRotate90;
+    case 8:
+        return QImageIOHandler::TransformationRotate270;
+    default:
+        return QImageIOHandler::TransformationNone;
+    }
+}
+
+// 与 QImageReader::setAutoTransform 的处理顺序一致
+void applyTransformation(QImage *image, QImageIOHandler::Transformations transformation)
+{
+    if (transformation == QImageIOHandler::TransformationNone)
+        return;
+
+    if (transformation == QImageIOHandler::TransformationRotate270) {
+        *image = image->transformed(QTransform().rotate(270));
+
+        return;
+    }
+
+    *image = image->mirrored(transformation & QImageIOHandler::TransformationMirror,
+                             transformation & QImageIOHandler::TransformationFlip);
+
+    if (transformation & QImageIOHandler::TransformationRotate90)
+        *image = image->transformed(QTransform().rotate(90));
+}
+
+}
+
+bool DFMEmbeddedPreview::isRawImage(const QString &mimeType)
+{
+    static const QSet<QString> rawMimeTypes {
+        "image/x-adobe-dng",
+        "image/x-canon-cr2",
+        "image/x-nikon-nef",
+        "image/x-nikon-nrw",
+        "image/x-sony-arw",
+        "image/x-sony-sr2",
+        "image/x-sony-srf",
+        "image/x-olympus-orf",
+        "image/x-panasonic-rw",
+        "image/x-panasonic-rw2",
+        "image/x-panasonic-raw",
+        "image/x-panasonic-raw2",
+        "image/x-pentax-pef",
+        "image/x-samsung-srw",
+        "image/x-kodak-dcr",
+        "image/x-kodak-kdc",
+        "image/x-fuji-raf"
+    };
+
+    return rawMimeTypes.contains(mimeType);
+}
+
+/*!
+ * \brief DFMEmbeddedPreview::loadPreview 解码文件中内嵌的预览图
+ * \param size 缩略图的尺寸，预览图将被缩小到此尺寸以内
+ * \param maxReadBytes 大于0时跳过超出此大小的预览图，避免从网络设备读取过多数据
+ * \return 对于 JPEG 文件，EXIF 缩略图小于 size 或与原图宽高比不同时返回false
+ */
+bool DFMEmbeddedPreview::loadPreview(const QString &filePath, const QString &mimeType, int size, QImage *image, qint64 maxReadBytes)
+{
+    const bool raw = isRawImage(mimeType);
+
+    if (!raw && mimeType != "image/jpeg")
+        return false;
+
+    QFile file(filePath);
+
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QList<PreviewData> previews;
+    QImageIOHandler::Transformations transformation = QImageIOHandler::TransformationNone;
+
+    if (mimeType == "image/x-fuji-raf") {
+        PreviewData preview;
+
+        if (findRafPreview(&file, &preview))
+            previews << preview;
+    } else {
+        const qint64 base = raw ? 0 : findExifOffset(&file);
+
+        if (base < 0)
+            return false;
+
+        TiffParser parser(&file, base);
+
+        if (!parser.parse())
+            return false;
+
+        previews = parser.previews;
+        transformation = exifTransformation(parser.orientation);
+    }
+
+    // RAW 文件中通常有多个尺寸的预览图，优先使用最大的
+    std::sort(previews.begin(), previews.end(), [](const PreviewData &left, const PreviewData &right) {
+        return left.length > right.length;
+    });
+
+    QSize originalSize;
+
+    if (!raw)
+        originalSize = QImageReader(filePath, "jpeg").size();
+
+    for (const PreviewData &preview : previews) {
+        if (preview.offset <= 0 || preview.offset + preview.length > file.size())
+            continue;
+
+        if (maxReadBytes > 0 && preview.length > maxReadBytes)
+            continue;
+
+        if (!file.seek(preview.offset))
+            continue;
+
+        QByteArray data = file.read(preview.length);
+
+        if (!data.startsWith("\xff\xd8"))
+            continue;
+
+        QBuffer buffer(&data);
+        buffer.open(QIODevice::ReadOnly);
+
+        QImageReader reader(&buffer, "jpeg");
+        const QSize &previewSize = reader.size();
+
+        if (!previewSize.isValid())
+            continue;
+
+        if (!raw) {
+            if (qMax(previewSize.width(), previewSize.height()) < size)
+                continue;
+
+            if (originalSize.isValid()) {
+                const qreal originalRatio = qreal(originalSize.width()) / originalSize.height();
+                const qreal previewRatio = qreal(previewSize.width()) / previewSize.height();
+
+                if (qAbs(originalRatio - previewRatio) > originalRatio * EXIF_THUMBNAIL_RATIO_TOLERANCE)
+                    continue;
+            }
+        }
+
+        // JPEG 解码时由 libjpeg 直接按比例缩小
+        if (previewSize.width() > size || previewSize.height() > size)
+            reader.setScaledSize(previewSize.scaled(size, size, Qt::KeepAspectRatio));
+
+        // 预览图的方向以所在文件记录的为准
+        reader.setAutoTransform(false);
+
+        QImage result;
+
+        if (!reader.read(&result))
+            continue;
+
+        applyTransformation(&result, transformation);
+        *image = result;
+
+        return true;
+    }
+
+    return false;
+}
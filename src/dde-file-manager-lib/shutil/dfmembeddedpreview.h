@@ -0,0 +1,24 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DFMEMBEDDEDPREVIEW_H
+#define DFMEMBEDDEDPREVIEW_H
+
+#include <QString>
+#include <QImage>
+
+/*!
+ * \brief DFMEmbeddedPreview 读取图片文件中内嵌的预览图
+ *
+ * JPEG 文件的 EXIF 中通常带有小尺寸的缩略图，相机 RAW 文件中通常带有全尺寸或中等尺寸的 JPEG 预览图。
+ * 生成缩略图时直接解码这些预览图，不必解码完整的图片。
+ */
+class DFMEmbeddedPreview
+{
+public:
+    static bool isRawImage(const QString &mimeType);
+    static bool loadPreview(const QString &filePath, const QString &mimeType, int size, QImage *image, qint64 maxReadBytes = 0);
+};
+
+#endif // DFMEMBEDDEDPREVIEW_H
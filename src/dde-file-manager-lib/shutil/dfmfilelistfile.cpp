@@ -15,6 +15,92 @@
 #include <QSaveFile>
 #include <QTemporaryFile>
 #include <QFileSystemWatcher>
+#include <QHash>
+#include <QMutex>
+
+#include <sys/stat.h>
+
+// 缓存的 .hidden 文件数的上限，超出时删除任意一项
+#define FILE_LIST_CACHE_MAX_COUNT 4096
+
+namespace {
+// 已解析的 .hidden 文件，文件的修改时间、大小或 inode 变化后缓存失效
+struct CachedFileList {
+    qint64 mtimeSec = 0;
+    qint64 mtimeNsec = 0;
+    qint64 size = 0;
+    quint64 inode = 0;
+    QSet<QString> names;
+};
+
+class FileListCache
+{
+public:
+    static FileListCache *instance()
+    {
+        static FileListCache cache;
+        return &cache;
+    }
+
+    bool find(const QString &path, const struct stat &st, QSet<QString> *names)
+    {
+        QMutexLocker locker(&m_mutex);
+
+        auto it = m_entries.constFind(path);
+        if (it == m_entries.constEnd() || !isSameFile(*it, st))
+            return false;
+
+        *names = it->names;
+        return true;
+    }
+
+    void insert(const QString &path, const struct stat &st, const QSet<QString> &names)
+    {
+        CachedFileList entry;
+        entry.mtimeSec = st.st_mtim.tv_sec;
+        entry.mtimeNsec = st.st_mtim.tv_nsec;
+        entry.size = st.st_size;
+        entry.inode = st.st_ino;
+        entry.names = names;
+
+        QMutexLocker locker(&m_mutex);
+
+        if (m_entries.count() >= FILE_LIST_CACHE_MAX_COUNT && !m_entries.contains(path))
+            m_entries.erase(m_entries.begin());
+
+        m_entries.insert(path, entry);
+    }
+
+    void remove(const QString &path)
+    {
+        QMutexLocker locker(&m_mutex);
+
+        m_entries.remove(path);
+    }
+
+    void clear()
+    {
+        QMutexLocker locker(&m_mutex);
+
+        m_entries.clear();
+    }
+
+private:
+    static bool isSameFile(const CachedFileList &entry, const struct stat &st)
+    {
+        return entry.mtimeSec == st.st_mtim.tv_sec && entry.mtimeNsec == st.st_mtim.tv_nsec
+               && entry.size == st.st_size && entry.inode == st.st_ino;
+    }
+
+    QHash<QString, CachedFileList> m_entries;
+    QMutex m_mutex;
+};
+
+bool statFile(const QString &path, struct stat *st)
+{
+    return ::stat(QFile::encodeName(path).constData(), st) == 0 && S_ISREG(st->st_mode);
+}
+}
 
 class DFMFileListFilePrivate
 {
@@ -31,6 +117,7 @@ public:
     bool loadFileWithoutCreateHidden(const QString &path);
     bool loadFileWithCreateHidden(const QString &path);
     bool parseData(const QByteArray &data);
+    void updateCache(const QString &path) const;
     void setStatus(const DFMFileListFile::Status &newStatus) const;
 
 protected:
@@ -126,6 +213,12 @@ bool DFMFileListFilePrivate::loadFile()
 
 bool DFMFileListFilePrivate::loadFileWithoutCreateHidden(const QString &path)
 {
+    // 在读取前获取文件状态，读取期间文件被修改时缓存会在下次读取时失效
+    struct stat st;
+    const bool hasStat = statFile(path, &st);
+    if (hasStat && FileListCache::instance()->find(path, st, &fileListSet))
+        return true;
+
     bool ret = false;
 
     GFile *gfile = g_file_new_for_path(path.toLocal8Bit().data());
@@ -140,6 +233,8 @@ bool DFMFileListFilePrivate::loadFileWithoutCreateHidden(const QString &path)
             if (contents && len > 0) {
                 parseData(contents);
             }
+            if (hasStat)
+                FileListCache::instance()->insert(path, st, fileListSet);
             ret = true;
         } else {
             if (error)
@@ -161,6 +256,12 @@ bool DFMFileListFilePrivate::loadFileWithoutCreateHidden(const QString &path)
 
 bool DFMFileListFilePrivate::loadFileWithCreateHidden(const QString &path)
 {
+    // 在读取前获取文件状态，读取期间文件被修改时缓存会在下次读取时失效
+    struct stat st;
+    const bool hasStat = statFile(path, &st);
+    if (hasStat && FileListCache::instance()->find(path, st, &fileListSet))
+        return true;
+
     bool ret = false;
 
     GError *error = nullptr;
@@ -182,6 +283,8 @@ bool DFMFileListFilePrivate::loadFileWithCreateHidden(const QString &path)
             if (contents && len > 0) {
                 parseData(contents);
             }
+            if (hasStat)
+                FileListCache::instance()->insert(path, st, fileListSet);
             ret = true;
         } else {
             g_error_free(error);
@@ -202,6 +305,18 @@ bool DFMFileListFilePrivate::parseData(const QByteArray &data)
     return true;
 }
 
+void DFMFileListFilePrivate::updateCache(const QString &path) const
+{
+    struct stat st;
+
+    if (!statFile(path, &st)) {
+        FileListCache::instance()->remove(path);
+        return;
+    }
+
+    FileListCache::instance()->insert(path, st, fileListSet);
+}
+
 void DFMFileListFilePrivate::setStatus(const DFMFileListFile::Status &newStatus) const
 {
     if (newStatus == DFMFileListFile::NoError || this->status == DFMFileListFile::NoError) {
@@ -249,12 +364,15 @@ bool DFMFileListFile::save() const
         //!导致界面无法实时响应文件显示隐藏
         QFile sf(filePath());
         if (!sf.open(QIODevice::WriteOnly)) {
+            FileListCache::instance()->remove(filePath());
             d->setStatus(DFMFileListFile::AccessError);
             return false;
         }
         ok = d->write(sf);
         sf.close();
         if (ok) {
+            // 写入的内容就是当前的集合，下次读取时无需重新解析
+            d->updateCache(filePath());
             return true;
         } else {
             d->setStatus(DFMFileListFile::AccessError);
@@ -293,6 +411,19 @@ QSet<QString> DFMFileListFile::getHiddenFiles()
     return d->fileListSet;
 }
 
+/*!
+ * \brief DFMFileListFile::invalidate 丢弃目录下 .hidden 文件的解析缓存，dirPath 为空时丢弃全部缓存
+ */
+void DFMFileListFile::invalidate(const QString &dirPath)
+{
+    if (dirPath.isEmpty()) {
+        FileListCache::instance()->clear();
+        return;
+    }
+
+    FileListCache::instance()->remove(QDir(dirPath).absoluteFilePath(".hidden"));
+}
+
 // Should we show the "Hide this file" checkbox?
 bool DFMFileListFile::supportHideByFile(const QString &fileFullPath)
 {
@@ -37,6 +37,7 @@ public:
 
     static bool supportHideByFile(const QString &fileFullPath);
     static bool canHideByFile(const QString &fileFullPath);
+    static void invalidate(const QString &dirPath = QString());
 
 public slots:
     bool reload();
@@ -0,0 +1,106 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dfmimagedownscaler.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// 每个通道取 2x2 像素的平均值
+static inline quint32 averagePixels(quint32 a, quint32 b, quint32 c, quint32 d)
+{
+    quint32 result = 0;
+
+    for (int shift = 0; shift < 32; shift += 8) {
+        const quint32 sum = ((a >> shift) & 0xff) + ((b >> shift) & 0xff) + ((c >> shift) & 0xff) + ((d >> shift) & 0xff);
+
+        result |= ((sum + 2) >> 2) << shift;
+    }
+
+    return result;
+}
+
+/*!
+ * \brief DFMImageDownscaler::downscale 按比例缩小图片，使宽高都不超过 size
+ */
+QImage DFMImageDownscaler::downscale(const QImage &image, int size)
+{
+    if (image.isNull() || (image.width() <= size && image.height() <= size))
+        return image;
+
+    const QSize &target = image.size().scaled(size, size, Qt::KeepAspectRatio);
+    QImage result = image;
+
+    // 带透明通道的图片按预乘后的颜色平均，避免透明像素的颜色渗到边缘
+    if (result.format() != QImage::Format_RGB32 && result.format() != QImage::Format_ARGB32_Premultiplied)
+        result = result.convertToFormat(result.hasAlphaChannel() ? QImage::Format_ARGB32_Premultiplied : QImage::Format_RGB32);
+
+    while (result.width() >= target.width() * 2 && result.height() >= target.height() * 2)
+        result = halve(result);
+
+    if (result.size() != target)
+        result = result.scaled(target, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+
+    return result;
+}
+
+/*!
+ * \brief DFMImageDownscaler::halve 宽高各减半，每个像素为原图中 2x2 像素的平均值
+ * \param image 格式为 Format_RGB32 或 Format_ARGB32_Premultiplied 的图片，宽高为奇数时忽略最后一列或一行
+ */
+QImage DFMImageDownscaler::halve(const QImage &image)
+{
+    const int width = image.width() / 2;
+    const int height = image.height() / 2;
+
+    if (width <= 0 || height <= 0)
+        return image;
+
+    QImage result(width, height, image.format());
+
+    if (result.isNull())
+        return image;
+
+    for (int y = 0; y < height; ++y) {
+        const quint32 *row0 = reinterpret_cast<const quint32 *>(image.constScanLine(y * 2));
+        const quint32 *row1 = reinterpret_cast<const quint32 *>(image.constScanLine(y * 2 + 1));
+        quint32 *out = reinterpret_cast<quint32 *>(result.scanLine(y));
+        int x = 0;
+
+#if defined(__SSE2__)
+        // 每次把源图两行中的各8个像素合成4个像素，两次求平均的进位误差不超过1
+        for (; x + 4 <= width; x += 4) {
+            const __m128i v0 = _mm_avg_epu8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(row0 + x * 2)),
+                                            _mm_loadu_si128(reinterpret_cast<const __m128i *>(row1 + x * 2)));
+            const __m128i v1 = _mm_avg_epu8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(row0 + x * 2 + 4)),
+                                            _mm_loadu_si128(reinterpret_cast<const __m128i *>(row1 + x * 2 + 4)));
+            const __m128i even = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(v0), _mm_castsi128_ps(v1), _MM_SHUFFLE(2, 0, 2, 0)));
+            const __m128i odd = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(v0), _mm_castsi128_ps(v1), _MM_SHUFFLE(3, 1, 3, 1)));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + x), _mm_avg_epu8(even, odd));
+        }
+#elif defined(__ARM_NEON)
+        // vld2q 读取时把偶数列和奇数列的像素分开
+        for (; x + 4 <= width; x += 4) {
+            const uint32x4x2_t p0 = vld2q_u32(row0 + x * 2);
+            const uint32x4x2_t p1 = vld2q_u32(row1 + x * 2);
+            const uint8x16_t h0 = vrhaddq_u8(vreinterpretq_u8_u32(p0.val[0]), vreinterpretq_u8_u32(p0.val[1]));
+            const uint8x16_t h1 = vrhaddq_u8(vreinterpretq_u8_u32(p1.val[0]), vreinterpretq_u8_u32(p1.val[1]));
+
+            vst1q_u32(out + x, vreinterpretq_u32_u8(vrhaddq_u8(h0, h1)));
+        }
+#endif
+
+        for (; x < width; ++x)
+            out[x] = averagePixels(row0[x * 2], row0[x * 2 + 1], row1[x * 2], row1[x * 2 + 1]);
+    }
+
+    result.setDotsPerMeterX(image.dotsPerMeterX());
+    result.setDotsPerMeterY(image.dotsPerMeterY());
+
+    return result;
+}
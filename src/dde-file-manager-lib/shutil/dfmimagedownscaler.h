@@ -0,0 +1,23 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DFMIMAGEDOWNSCALER_H
+#define DFMIMAGEDOWNSCALER_H
+
+#include <QImage>
+
+/*!
+ * \brief DFMImageDownscaler 生成缩略图时缩小解码后的图片
+ *
+ * 先用 SIMD 指令对图片做多次宽高减半的 2x2 平均（盒式滤波），直到尺寸小于目标尺寸的两倍，
+ * 剩余的非整数倍缩放交给 QImage::scaled 的平滑缩放，此时图片已经很小。
+ */
+class DFMImageDownscaler
+{
+public:
+    static QImage downscale(const QImage &image, int size);
+    static QImage halve(const QImage &image);
+};
+
+#endif // DFMIMAGEDOWNSCALER_H
@@ -160,6 +160,8 @@ static const std::map<QString, QString> StrTableOfEscapeChar{
 };
 
 
+///###: the statements of TagFiles and ChangeFilesName are executed for every file in a batch,
+///###: so they are prepared once and the values are bound, the others are still formatted by QString::arg.
 static const std::multimap<DSqliteHandle::SqlType, QString> SqlTypeWithStrs {
     {
         DSqliteHandle::SqlType::BeforeTagFiles, "SELECT COUNT(tag_property.tag_name) AS counter "
@@ -172,44 +174,59 @@ static const std::multimap<DSqliteHandle::SqlType, QString> SqlTypeWithStrs {
 
     {
         DSqliteHandle::SqlType::TagFiles, "SELECT COUNT (tag_with_file.file_name) AS counter "
-        "FROM tag_with_file WHERE tag_with_file.file_name = \'%1\' "
-        "AND tag_with_file.tag_name = \'%2\'"
+        "FROM tag_with_file WHERE tag_with_file.file_name = :file_name "
+        "AND tag_with_file.tag_name = :tag_name"
     },
-    {DSqliteHandle::SqlType::TagFiles, "INSERT INTO tag_with_file (file_name, tag_name) VALUES (\'%1\', \'%2\')"},
+    {DSqliteHandle::SqlType::TagFiles, "INSERT INTO tag_with_file (file_name, tag_name) VALUES (:file_name, :tag_name)"},
     {
-        DSqliteHandle::SqlType::TagFiles, "DELETE FROM tag_with_file WHERE tag_with_file.tag_name = \'%1\' "
-        "AND tag_with_file.file_name = \'%2\'"
+        DSqliteHandle::SqlType::TagFiles, "DELETE FROM tag_with_file WHERE tag_with_file.tag_name = :tag_name "
+        "AND tag_with_file.file_name = :file_name"
     },
-    {DSqliteHandle::SqlType::TagFiles, "DELETE FROM file_property WHERE file_property.file_name = \'%1\'"},
+    {DSqliteHandle::SqlType::TagFiles, "DELETE FROM file_property WHERE file_property.file_name = :file_name"},
     {
         DSqliteHandle::SqlType::TagFiles, "SELECT tag_with_file.tag_name FROM tag_with_file "
-        "WHERE tag_with_file.file_name = \'%1\'"
+        "WHERE tag_with_file.file_name = :file_name"
     },
     {
-        DSqliteHandle::SqlType::TagFiles, "UPDATE file_property SET tag_1 = \'%1\', tag_2 = \'%2\', tag_3 = \'%3\' "
-        "WHERE file_property.file_name = \'%4\'"
+        DSqliteHandle::SqlType::TagFiles, "UPDATE file_property SET tag_1 = :tag_1, tag_2 = :tag_2, tag_3 = :tag_3 "
+        "WHERE file_property.file_name = :file_name"
     },
     {
         DSqliteHandle::SqlType::TagFiles, "SELECT COUNT (file_property.file_name) AS counter "
-        "FROM file_property WHERE file_property.file_name = \'%1\'"
+        "FROM file_property WHERE file_property.file_name = :file_name"
     },
     {
         DSqliteHandle::SqlType::TagFiles, "INSERT INTO file_property (file_name, tag_1, tag_2, tag_3) "
-        "VALUES(\'%1\', \'%2\', \'%3\', \'%4\')"
+        "VALUES(:file_name, :tag_1, :tag_2, :tag_3)"
     },
 
     {
-        DSqliteHandle::SqlType::ChangeFilesName, "UPDATE file_property SET file_name = \'%1\' "
-        "WHERE file_property.file_name = \'%2\'"
+        DSqliteHandle::SqlType::ChangeFilesName, "UPDATE file_property SET file_name = :new_name "
+        "WHERE file_property.file_name = :old_name"
+    },
+    {
+        DSqliteHandle::SqlType::ChangeFilesName, "UPDATE tag_with_file SET file_name = :new_name "
+        "WHERE tag_with_file.file_name = :old_name"
     },
+    ///###: the descendants of a renamed directory are renamed by one statement.
+    ///###: "old_name/" < file_name < "old_name0" matches all the names beginning with "old_name/",
+    ///###: it does not need to escape the wildcards of LIKE and works with the binary collation.
     {
-        DSqliteHandle::SqlType::ChangeFilesName, "UPDATE tag_with_file SET file_name = \'%1\' "
-        "WHERE tag_with_file.file_name = \'%2\'"
+        DSqliteHandle::SqlType::ChangeFilesName, "UPDATE file_property SET file_name = :new_name || substr(file_property.file_name, length(:old_name) + 1) "
+        "WHERE file_property.file_name > :lower_bound AND file_property.file_name < :upper_bound"
+    },
+    {
+        DSqliteHandle::SqlType::ChangeFilesName, "UPDATE tag_with_file SET file_name = :new_name || substr(tag_with_file.file_name, length(:old_name) + 1) "
+        "WHERE tag_with_file.file_name > :lower_bound AND tag_with_file.file_name < :upper_bound"
     },
 
     {
         DSqliteHandle::SqlType::ChangeFilesName2, "SELECT tag_with_file.tag_name FROM tag_with_file "
-        "WHERE tag_with_file.file_name = \'%1\'"
+        "WHERE tag_with_file.file_name = :file_name"
+    },
+    {
+        DSqliteHandle::SqlType::ChangeFilesName2, "SELECT tag_with_file.file_name, tag_with_file.tag_name FROM tag_with_file "
+        "WHERE tag_with_file.file_name > :lower_bound AND tag_with_file.file_name < :upper_bound"
     },
 
     {
@@ -340,7 +357,9 @@ static const std::multimap<DSqliteHandle::SqlType, QString> SqlTypeWithStrs {
 
 DSqliteHandle::DSqliteHandle(QObject *const parent)
     : QObject{ parent },
-      m_sqlDatabasePtr{ new QSqlDatabase }
+      m_sqlDatabasePtr{ new QSqlDatabase },
+      ///###: every handle has its own connection, so the reader and the writer do not share one.
+      m_connectionName{ QString{ "%1_%2" }.arg(CONNECTIONNAME).arg(reinterpret_cast<quintptr>(this), 0, 16) }
 {
     std::lock_guard<std::mutex> raiiLock{ m_mutex };
     std::map<QString, std::multimap<QString, QString>> partionsAndMounPoints{ DSqliteHandle::queryPartionsInfoOfDevices() };
@@ -663,6 +682,20 @@ QVariant DSqliteHandle::disposeClientData(const QMap<QString, QList<QString>> &f
 
             break;
         }
+        case 14: {
+            std::lock_guard<std::mutex> raii_lock{ m_mutex };
+            QMap<QString, QVariant> file_and_tags{ this->execSqlstr<DSqliteHandle::SqlType::GetTagsOfEachFile, QMap<QString, QVariant>>(filesAndTags) };
+            var.setValue(file_and_tags);
+
+            break;
+        }
+        case 15: { ///###: tag every file with its own tags.
+            std::lock_guard<std::mutex> raii_lock{ m_mutex };
+            bool value{ this->execSqlstr<DSqliteHandle::SqlType::TagEachFile, bool>(filesAndTags) };
+            var.setValue(value);
+
+            break;
+        }
         default:
             break;
         }
@@ -686,6 +719,26 @@ DSqliteHandle::ReturnCode DSqliteHandle::checkDBFileExist(const QString &path, c
     return ReturnCode::NoExist;
 }
 
+bool DSqliteHandle::openSqlDatabase()
+{
+    if (!m_sqlDatabasePtr || !m_sqlDatabasePtr->open()) {
+        return false;
+    }
+
+    ///###: in WAL mode the readers are not blocked while the writer is committing,
+    ///###: and "synchronous = NORMAL" only syncs at checkpoint but never corrupts the db.
+    QSqlQuery sqlQuery{ *m_sqlDatabasePtr };
+
+    for (const QString &pragma : { QString{ "PRAGMA journal_mode = WAL" }, QString{ "PRAGMA synchronous = NORMAL" } }) {
+
+        if (!sqlQuery.exec(pragma)) {
+            qWarning() << sqlQuery.lastError().text();
+        }
+    }
+
+    return true;
+}
+
 void DSqliteHandle::initializeConnect()
 {
     QObject::connect(deviceListener, &UDiskListener::mountAdded, this, &DSqliteHandle::onMountAdded);
@@ -701,13 +754,13 @@ void DSqliteHandle::connectToSqlite(const QString &path, const QString &db_name)
                 m_sqlDatabasePtr->close();
             }
 
-            if (QSqlDatabase::contains(CONNECTIONNAME))
+            if (QSqlDatabase::contains(m_connectionName))
             {
                 m_sqlDatabasePtr.reset(nullptr);
-                QSqlDatabase::removeDatabase(CONNECTIONNAME);
+                QSqlDatabase::removeDatabase(m_connectionName);
             }
 
-            m_sqlDatabasePtr = std::unique_ptr<QSqlDatabase>{new QSqlDatabase{ QSqlDatabase::addDatabase(R"foo(QSQLITE)foo", CONNECTIONNAME)} };
+            m_sqlDatabasePtr = std::unique_ptr<QSqlDatabase>{new QSqlDatabase{ QSqlDatabase::addDatabase(R"foo(QSQLITE)foo", m_connectionName)} };
             QString DBName{path + QString{"/"} + db_name};
 
             ///###: for debugging.
@@ -721,7 +774,7 @@ void DSqliteHandle::connectToSqlite(const QString &path, const QString &db_name)
     if (code == DSqliteHandle::ReturnCode::NoExist) {
         initDatabasePtr();
 
-        if (m_sqlDatabasePtr->open()) {
+        if (this->openSqlDatabase()) {
             if (m_sqlDatabasePtr->transaction()) {
                 QSqlQuery sqlQuery{ *m_sqlDatabasePtr };
 
@@ -892,6 +945,14 @@ void DSqliteHandle::connectToShareSqlite(const QString &path, const QString &db_
     }
 }
 
+static void prepareSqlQuery(QSqlQuery &sqlQuery, const QString &sql)
+{
+    ///###: if failed, the following exec() will fail too and print the error of each row.
+    if (!sqlQuery.prepare(sql)) {
+        qWarning() << sqlQuery.lastError().text();
+    }
+}
+
 ///###:this is also a auxiliary function. do not need a mutex.
 template<>
 bool DSqliteHandle::helpExecSql<DSqliteHandle::SqlType::TagFiles, QMap<QString,
@@ -905,37 +966,23 @@ bool DSqliteHandle::helpExecSql<DSqliteHandle::SqlType::TagFiles, QMap<QString,
         std::multimap<DSqliteHandle::SqlType, QString>::const_iterator itr{ itrOfSqlForDeleting.first };
         ++itr; ++itr;
         QSqlQuery sqlQuery{ *m_sqlDatabasePtr };
-
+        prepareSqlQuery(sqlQuery, itr->second);
 
         for (; cbeg != cend; ++cbeg) {
 
             for (const QString &tagName : cbeg.value()) {
-                QString sql{ itr->second.arg(tagName) };
-                sql = sql.arg(cbeg.key());
-
-                if (!m_flag.load(std::memory_order_acquire)) {
-
-                    ///###: delete redundant item in tag_with_file.
-                    if (!sqlQuery.exec(sql)) {
-                        qWarning() << sqlQuery.lastError().text();
-                        continue;
-                    }
-
-                } else {
-
-                    DSqliteHandle::ReturnCode code{ this->checkDBFileExist(mountPoint) };
 
-                    if (code == DSqliteHandle::ReturnCode::Exist) {
-
-                        if (!sqlQuery.exec(sql)) {
-                            qWarning() << sqlQuery.lastError().text();
-                            continue;
-                        }
+                if (!this->isCurrentDBAvailable(mountPoint)) {
+                    return false;
+                }
 
-                    } else {
+                sqlQuery.bindValue(":tag_name", tagName);
+                sqlQuery.bindValue(":file_name", cbeg.key());
 
-                        return false;
-                    }
+                ///###: delete redundant item in tag_with_file.
+                if (!sqlQuery.exec()) {
+                    qWarning() << sqlQuery.lastError().text();
+                    continue;
                 }
             }
         }
@@ -959,36 +1006,23 @@ bool DSqliteHandle::helpExecSql<DSqliteHandle::SqlType::TagFiles2, QMap<QString,
         std::multimap<DSqliteHandle::SqlType, QString>::const_iterator itr{ itrOfSqlForDeleting.first };
         ++itr;
         QSqlQuery sqlQuery{ *m_sqlDatabasePtr };
+        prepareSqlQuery(sqlQuery, itr->second);
 
         for (; cbeg != cend; ++cbeg) {
 
             for (const QString &tagName : cbeg.value()) {
-                QString sql{ itr->second.arg(cbeg.key()) };
-                sql = sql.arg(tagName);
-
-                if (!m_flag.load(std::memory_order_acquire)) {
-
-                    ///###: tag files
-                    if (!sqlQuery.exec(sql)) {
-                        qWarning() << sqlQuery.lastError().text();
-                        continue;
-                    }
-
-                } else {
-
-                    DSqliteHandle::ReturnCode code{ this->checkDBFileExist(mountPoint) };
 
-                    if (code == DSqliteHandle::ReturnCode::Exist) {
-
-                        if (!sqlQuery.exec(sql)) {
-                            qWarning() << sqlQuery.lastError().text();
-                            continue;
-                        }
+                if (!this->isCurrentDBAvailable(mountPoint)) {
+                    return false;
+                }
 
-                    } else {
+                sqlQuery.bindValue(":file_name", cbeg.key());
+                sqlQuery.bindValue(":tag_name", tagName);
 
-                        return false;
-                    }
+                ///###: tag files
+                if (!sqlQuery.exec()) {
+                    qWarning() << sqlQuery.lastError().text();
+                    continue;
                 }
             }
         }
@@ -1012,98 +1046,61 @@ bool DSqliteHandle::helpExecSql<DSqliteHandle::SqlType::TagFiles3, QList<QString
             std::multimap<DSqliteHandle::SqlType, QString>::const_iterator> itrOfSqlForDeleting{ SqlTypeWithStrs.equal_range(DSqliteHandle::SqlType::TagFiles) };
         std::multimap<DSqliteHandle::SqlType, QString>::const_iterator itr{ itrOfSqlForDeleting.first };
         ++itr; ++itr; ++itr; ++itr;
-        QSqlQuery sqlQuery{ *m_sqlDatabasePtr };
+
+        std::multimap<DSqliteHandle::SqlType, QString>::const_iterator itrForDelRowInFileProperty{ itr };
+        --itrForDelRowInFileProperty;
+        std::multimap<DSqliteHandle::SqlType, QString>::const_iterator itrForUpdating{ itr };
+        ++itrForUpdating;
+        std::multimap<DSqliteHandle::SqlType, QString>::const_iterator itrForCounterFileInFP{ itrForUpdating };
+        ++itrForCounterFileInFP;
+        std::multimap<DSqliteHandle::SqlType, QString>::const_iterator itrForInsertRowInFP{ itrForCounterFileInFP };
+        ++itrForInsertRowInFP;
+
+        ///###: every statement is prepared once for the whole batch, only the values are bound for each file.
+        QSqlQuery queryForGettingTag{ *m_sqlDatabasePtr };
+        QSqlQuery queryForDelRowInFileProperty{ *m_sqlDatabasePtr };
+        QSqlQuery queryForUpdatingFileProperty{ *m_sqlDatabasePtr };
+        QSqlQuery queryOfCountingFileInFP{ *m_sqlDatabasePtr };
+        QSqlQuery queryForInsertRowInFP{ *m_sqlDatabasePtr };
+        prepareSqlQuery(queryForGettingTag, itr->second);
+        prepareSqlQuery(queryForDelRowInFileProperty, itrForDelRowInFileProperty->second);
+        prepareSqlQuery(queryForUpdatingFileProperty, itrForUpdating->second);
+        prepareSqlQuery(queryOfCountingFileInFP, itrForCounterFileInFP->second);
+        prepareSqlQuery(queryForInsertRowInFP, itrForInsertRowInFP->second);
 
         for (; cbeg != cend; ++cbeg) {
-            QString sqlForGettingTag{ itr->second.arg(*cbeg) };
             std::vector<QString> leftTags{};
 
-            if (!m_flag.load(std::memory_order_acquire)) {
-
-                if (sqlQuery.exec(sqlForGettingTag)) {
-
-                    while (sqlQuery.next()) {
-                        QString tagName{ sqlQuery.value("tag_name").toString() };
-                        leftTags.push_back(tagName);
-                    }
-                }
-
-            } else {
-
-                DSqliteHandle::ReturnCode code{ this->checkDBFileExist(mountPoint) };
-
-                if (code == DSqliteHandle::ReturnCode::Exist) {
+            if (!this->isCurrentDBAvailable(mountPoint)) {
+                return false;
+            }
 
-                    if (sqlQuery.exec(sqlForGettingTag)) {
+            queryForGettingTag.bindValue(":file_name", *cbeg);
 
-                        while (sqlQuery.next()) {
-                            QString tagName{ sqlQuery.value("tag_name").toString() };
-                            leftTags.push_back(tagName);
-                        }
-                    }
+            if (queryForGettingTag.exec()) {
 
-                } else {
-                    return false;
+                while (queryForGettingTag.next()) {
+                    QString tagName{ queryForGettingTag.value("tag_name").toString() };
+                    leftTags.push_back(tagName);
                 }
             }
 
             if (leftTags.empty()) {
-                std::multimap<DSqliteHandle::SqlType, QString>::const_iterator itrForDelRowInFileProperty{itr};
-                --itrForDelRowInFileProperty;
-                QString sqlForDelRowInFileProperty{ itrForDelRowInFileProperty->second.arg(*cbeg) };
-
-
-                if (!m_flag.load(std::memory_order_acquire)) {
-
-                    if (!sqlQuery.exec(sqlForDelRowInFileProperty)) {
-                        qWarning() << sqlQuery.lastError().text();
-                        continue;
-                    }
-
-                } else {
-
-                    DSqliteHandle::ReturnCode code{ this->checkDBFileExist(mountPoint) };
-
-                    if (code == DSqliteHandle::ReturnCode::Exist) {
-
-                        if (!sqlQuery.exec(sqlForDelRowInFileProperty)) {
-                            qWarning() << sqlQuery.lastError().text();
-                            continue;
-                        }
+                queryForDelRowInFileProperty.bindValue(":file_name", *cbeg);
 
-                    } else {
-                        return false;
-                    }
+                if (!queryForDelRowInFileProperty.exec()) {
+                    qWarning() << queryForDelRowInFileProperty.lastError().text();
+                    continue;
                 }
 
             } else {
-
-                std::multimap<DSqliteHandle::SqlType, QString>::const_iterator itrForCounterFileInFP{ itr };
-                ++itrForCounterFileInFP; ++itrForCounterFileInFP;
-                QString sqlOfCountingFileInFP{ itrForCounterFileInFP->second.arg(*cbeg) };
-
                 int cnter{ 0 };
+                queryOfCountingFileInFP.bindValue(":file_name", *cbeg);
 
-                if (!m_flag.load(std::memory_order_acquire)) {
-
-                    if (sqlQuery.exec(sqlOfCountingFileInFP)) {
-
-                        if (sqlQuery.next()) {
-                            cnter =  sqlQuery.value("counter").toInt();
-                        }
-                    }
-
-                } else {
-                    DSqliteHandle::ReturnCode code{ this->checkDBFileExist(mountPoint) };
-
-                    if (code == DSqliteHandle::ReturnCode::Exist) {
-
-                        if (sqlQuery.exec(sqlOfCountingFileInFP)) {
-                            cnter = sqlQuery.value("counter").toInt();
-                        }
+                if (queryOfCountingFileInFP.exec()) {
 
-                    } else {
-                        return false;
+                    if (queryOfCountingFileInFP.next()) {
+                        cnter = queryOfCountingFileInFP.value("counter").toInt();
                     }
                 }
 
@@ -1117,77 +1114,16 @@ bool DSqliteHandle::helpExecSql<DSqliteHandle::SqlType::TagFiles3, QList<QString
                     }
                 }
 
+                std::size_t sizeOfTags{ leftTags.size() };
+                QSqlQuery &sqlQuery{ cnter > 0 ? queryForUpdatingFileProperty : queryForInsertRowInFP };
+                sqlQuery.bindValue(":file_name", *cbeg);
+                sqlQuery.bindValue(":tag_1", leftTags[sizeOfTags - 3]);
+                sqlQuery.bindValue(":tag_2", leftTags[sizeOfTags - 2]);
+                sqlQuery.bindValue(":tag_3", leftTags[sizeOfTags - 1]);
 
-                if (cnter > 0) {
-                    std::multimap<DSqliteHandle::SqlType, QString>::const_iterator itrForUpdating{itr};
-                    ++itrForUpdating;
-
-                    std::size_t sizeOfTags{ leftTags.size() };
-
-                    QString sqlForUpdatingFileProperty{itrForUpdating->second.arg(leftTags[sizeOfTags - 3])};
-                    sqlForUpdatingFileProperty = sqlForUpdatingFileProperty.arg(leftTags[sizeOfTags - 2]);
-                    sqlForUpdatingFileProperty = sqlForUpdatingFileProperty.arg(leftTags[sizeOfTags - 1]);
-                    sqlForUpdatingFileProperty = sqlForUpdatingFileProperty.arg(*cbeg);
-
-                    if (!m_flag.load(std::memory_order_acquire)) {
-
-                        if (!sqlQuery.exec(sqlForUpdatingFileProperty)) {
-                            qWarning() << sqlQuery.lastError().text();
-                            continue;
-                        }
-
-                    } else {
-
-                        DSqliteHandle::ReturnCode code{ this->checkDBFileExist(mountPoint) };
-
-                        if (code == DSqliteHandle::ReturnCode::Exist) {
-
-                            if (!sqlQuery.exec(sqlForUpdatingFileProperty)) {
-                                qWarning() << sqlQuery.lastError().text();
-                                continue;
-                            }
-
-                        } else {
-                            return false;
-                        }
-
-                    }
-
-                } else {
-
-                    std::multimap<DSqliteHandle::SqlType, QString>::const_iterator itrForInsertRowInFP{ itr };
-                    ++itrForInsertRowInFP;
-                    ++itrForInsertRowInFP;
-                    ++itrForInsertRowInFP;
-                    std::size_t sizeOfTags{ leftTags.size() };
-                    QString sqlForInsertRowInFP{ itrForInsertRowInFP->second.arg(*cbeg) };
-                    sqlForInsertRowInFP = sqlForInsertRowInFP.arg(leftTags[sizeOfTags - 3]);
-                    sqlForInsertRowInFP = sqlForInsertRowInFP.arg(leftTags[sizeOfTags - 2]);
-                    sqlForInsertRowInFP = sqlForInsertRowInFP.arg(leftTags[sizeOfTags - 1]);
-
-
-                    if (!m_flag.load(std::memory_order_acquire)) {
-
-                        if (!sqlQuery.exec(sqlForInsertRowInFP)) {
-                            qWarning() << sqlQuery.lastError().text();
-                            continue;
-                        }
-
-                    } else {
-
-                        DSqliteHandle::ReturnCode code{ this->checkDBFileExist(mountPoint) };
-
-                        if (code == DSqliteHandle::ReturnCode::Exist) {
-
-                            if (!sqlQuery.exec(sqlForInsertRowInFP)) {
-                                qWarning() << sqlQuery.lastError().text();
-                                continue;
-                            }
-
-                        } else {
-                            return false;
-                        }
-                    }
+                if (!sqlQuery.exec()) {
+                    qWarning() << sqlQuery.lastError().text();
+                    continue;
                 }
             }
         }
@@ -2088,41 +2024,46 @@ bool DSqliteHandle::helpExecSql<DSqliteHandle::SqlType::DeleteTags3, QList<QStri
 
 
 
-template<>
-bool DSqliteHandle::helpExecSql<DSqliteHandle::SqlType::ChangeFilesName, std::map<QString, QString>>(const std::map<QString, QString> &sqlStrs, const QString &mountPoint)
+template<> ///###: ------------------------------------------------------------------------------------------------------------> <OldFileName, NewFileName>
+bool DSqliteHandle::helpExecSql<DSqliteHandle::SqlType::ChangeFilesName, std::map<QString, QString>>(const std::map<QString, QString> &oldAndNewNames, const QString &mountPoint)
 {
-    if (!sqlStrs.empty() && !mountPoint.isEmpty()) {
-        std::map<QString, QString>::const_iterator sqlCBeg{ sqlStrs.cbegin() };
-        std::map<QString, QString>::const_iterator sqlCEnd{ sqlStrs.cend() };
-        QSqlQuery sqlQuery{ *m_sqlDatabasePtr };
-
-        for (; sqlCBeg != sqlCEnd; ++sqlCBeg) {
-
-            if (!m_flag.load(std::memory_order_consume)) {
+    if (!oldAndNewNames.empty() && !mountPoint.isEmpty()) {
+        std::pair<std::multimap<DSqliteHandle::SqlType, QString>::const_iterator,
+            std::multimap<DSqliteHandle::SqlType, QString>::const_iterator> range{ SqlTypeWithStrs.equal_range(DSqliteHandle::SqlType::ChangeFilesName) };
+        std::map<QString, QString>::const_iterator nameCBeg{ oldAndNewNames.cbegin() };
+        std::map<QString, QString>::const_iterator nameCEnd{ oldAndNewNames.cend() };
+        QSqlQuery queryForUpdatingFileProperty{ *m_sqlDatabasePtr };
+        QSqlQuery queryForUpdatingTagWithFile{ *m_sqlDatabasePtr };
+        QSqlQuery queryForUpdatingChildrenOfFileProperty{ *m_sqlDatabasePtr };
+        QSqlQuery queryForUpdatingChildrenOfTagWithFile{ *m_sqlDatabasePtr };
+        prepareSqlQuery(queryForUpdatingFileProperty, range.first->second);
+        prepareSqlQuery(queryForUpdatingTagWithFile, (++range.first)->second);
+        prepareSqlQuery(queryForUpdatingChildrenOfFileProperty, (++range.first)->second);
+        prepareSqlQuery(queryForUpdatingChildrenOfTagWithFile, (++range.first)->second);
+
+        for (; nameCBeg != nameCEnd; ++nameCBeg) {
+
+            if (!this->isCurrentDBAvailable(mountPoint)) {
+                return false;
+            }
 
-                if (!sqlQuery.exec(sqlCBeg->first)) {
-                    qWarning() << sqlQuery.lastError().text();
-                }
+            for (QSqlQuery *sqlQuery : { &queryForUpdatingFileProperty, &queryForUpdatingTagWithFile }) {
+                sqlQuery->bindValue(":new_name", nameCBeg->second);
+                sqlQuery->bindValue(":old_name", nameCBeg->first);
 
-                if (!sqlQuery.exec(sqlCBeg->second)) {
-                    qWarning() << sqlQuery.lastError().text();
+                if (!sqlQuery->exec()) {
+                    qWarning() << sqlQuery->lastError().text();
                 }
+            }
 
-            } else {
-                DSqliteHandle::ReturnCode code{this->checkDBFileExist(mountPoint)};
-
-                if (code == DSqliteHandle::ReturnCode::Exist) {
-
-                    if (!sqlQuery.exec(sqlCBeg->first)) {
-                        qWarning() << sqlQuery.lastError().text();
-                    }
-
-                    if (!sqlQuery.exec(sqlCBeg->second)) {
-                        qWarning() << sqlQuery.lastError().text();
-                    }
+            for (QSqlQuery *sqlQuery : { &queryForUpdatingChildrenOfFileProperty, &queryForUpdatingChildrenOfTagWithFile }) {
+                sqlQuery->bindValue(":new_name", nameCBeg->second);
+                sqlQuery->bindValue(":old_name", nameCBeg->first);
+                sqlQuery->bindValue(":lower_bound", nameCBeg->first + QChar('/'));
+                sqlQuery->bindValue(":upper_bound", nameCBeg->first + QChar('0'));
 
-                } else {
-                    return false;
+                if (!sqlQuery->exec()) {
+                    qWarning() << sqlQuery->lastError().text();
                 }
             }
         }
@@ -2142,37 +2083,37 @@ QMap<QString, QList<QString>> DSqliteHandle::helpExecSql<DSqliteHandle::SqlType:
             std::multimap<DSqliteHandle::SqlType, QString>::const_iterator> range{ SqlTypeWithStrs.equal_range(SqlType::ChangeFilesName2) };
         std::map<QString, QString>::const_iterator file_beg{ files.cbegin() };
         std::map<QString, QString>::const_iterator file_end{ files.cend() };
-        QSqlQuery sql_query{ *m_sqlDatabasePtr };
 
+        if (m_flag.load(std::memory_order_consume) && this->checkDBFileExist(mount_point) != DSqliteHandle::ReturnCode::Exist) {
+            return file_with_tags;
+        }
 
-        if (!m_flag.load(std::memory_order_consume)) {
+        QSqlQuery sql_query{ *m_sqlDatabasePtr };
+        QSqlQuery query_for_children{ *m_sqlDatabasePtr };
+        prepareSqlQuery(sql_query, range.first->second);
+        prepareSqlQuery(query_for_children, (++range.first)->second);
 
-            for (; file_beg != file_end; ++file_beg) {
+        for (; file_beg != file_end; ++file_beg) {
+            sql_query.bindValue(":file_name", file_beg->first);
 
-                if (sql_query.exec(range.first->second.arg(file_beg->first))) {
+            if (sql_query.exec()) {
 
-                    while (sql_query.next()) {
-                        QString tag_name{ sql_query.value("tag_name").toString() };
-                        file_with_tags[file_beg->first].push_back(tag_name);
-                    }
+                while (sql_query.next()) {
+                    QString tag_name{ sql_query.value("tag_name").toString() };
+                    file_with_tags[file_beg->first].push_back(tag_name);
                 }
             }
 
-        } else {
-
-            DSqliteHandle::ReturnCode code{this->checkDBFileExist(mount_point)};
-
-            if (code == DSqliteHandle::ReturnCode::Exist) {
+            ///###: the tagged files in the directory.
+            query_for_children.bindValue(":lower_bound", file_beg->first + QChar('/'));
+            query_for_children.bindValue(":upper_bound", file_beg->first + QChar('0'));
 
-                for (; file_beg != file_end; ++file_beg) {
+            if (query_for_children.exec()) {
 
-                    if (sql_query.exec(range.first->second.arg(file_beg->first))) {
-
-                        while (sql_query.next()) {
-                            QString tag_name{ sql_query.value("tag_name").toString() };
-                            file_with_tags[file_beg->first].push_back(tag_name);
-                        }
-                    }
+                while (query_for_children.next()) {
+                    QString file_name{ query_for_children.value("file_name").toString() };
+                    QString tag_name{ query_for_children.value("tag_name").toString() };
+                    file_with_tags[file_name].push_back(tag_name);
                 }
             }
         }
@@ -2382,7 +2323,7 @@ QMap<QString, QList<QString>> DSqliteHandle::helpExecSql<DSqliteHandle::SqlType:
                     if (code == DSqliteHandle::ReturnCode::NoExist || code == DSqliteHandle::ReturnCode::Exist) {
                         this->connectToShareSqlite(partion_itr_beg->second);
 
-                        if (m_sqlDatabasePtr && m_sqlDatabasePtr->open()) {
+                        if (m_sqlDatabasePtr && this->openSqlDatabase()) {
                             QSqlQuery sql_query{ *m_sqlDatabasePtr };
 
                             for (const QString &tag_name : tag_names) {
@@ -2512,7 +2453,7 @@ bool DSqliteHandle::execSqlstr<DSqliteHandle::SqlType::TagFiles, bool>(const QMa
                     }
                 }
 
-                if (m_sqlDatabasePtr && m_sqlDatabasePtr->open() && m_sqlDatabasePtr->transaction()) {
+                if (m_sqlDatabasePtr && this->openSqlDatabase() && m_sqlDatabasePtr->transaction()) {
                     bool valueOfDelRedundant{ true };
 
                     if (!decreased.isEmpty()) {
@@ -2605,7 +2546,7 @@ bool DSqliteHandle::execSqlstr<DSqliteHandle::SqlType::TagFiles, bool>(const QMa
             if (code == DSqliteHandle::ReturnCode::Exist || code == DSqliteHandle::ReturnCode::NoExist) {
                 this->connectToShareSqlite(unixDeviceAndMountPoint.second);
 
-                if (m_sqlDatabasePtr && m_sqlDatabasePtr->open() && m_sqlDatabasePtr->transaction()) {
+                if (m_sqlDatabasePtr && this->openSqlDatabase() && m_sqlDatabasePtr->transaction()) {
 
                     bool valueOfInsertNew{ true };
                     valueOfInsertNew = this->helpExecSql<DSqliteHandle::SqlType::TagFiles2, QMap<QString, QList<QString>>,
@@ -2648,6 +2589,146 @@ bool DSqliteHandle::execSqlstr<DSqliteHandle::SqlType::TagFiles, bool>(const QMa
 
 
 
+///###: every file has its own tags, the difference between the current tags and the given tags is applied.
+///###: the files in the same partion are changed in one transaction, the statements are prepared once for the whole batch.
+template<>
+bool DSqliteHandle::execSqlstr<DSqliteHandle::SqlType::TagEachFile, bool>(const QMap<QString, QList<QString>> &filesAndTags)
+{
+    if (filesAndTags.isEmpty()) {
+        return false;
+    }
+
+    bool result{ true };
+    ///###: <mount-point path, <the file without mount-point, file>>
+    QMap<QString, QMap<QString, QString>> filesInSpecifyPartion{};
+    QMap<QString, QList<QString>>::const_iterator cbeg{ filesAndTags.cbegin() };
+    QMap<QString, QList<QString>>::const_iterator cend{ filesAndTags.cend() };
+
+    for (; cbeg != cend; ++cbeg) {
+        QPair<QString, QString> unixDeviceAndMountPoint{ DSqliteHandle::getMountPointOfFile(DUrl::fromLocalFile(cbeg.key()), m_partionsOfDevices) };
+
+        if (unixDeviceAndMountPoint.second.isEmpty()) {
+            result = false;
+            continue;
+        }
+
+        filesInSpecifyPartion[unixDeviceAndMountPoint.second][this->remove_mount_point(cbeg.key(), unixDeviceAndMountPoint.second)] = cbeg.key();
+    }
+
+    std::pair<std::multimap<DSqliteHandle::SqlType, QString>::const_iterator,
+        std::multimap<DSqliteHandle::SqlType, QString>::const_iterator> range{ SqlTypeWithStrs.equal_range(DSqliteHandle::SqlType::TagFiles) };
+    std::multimap<DSqliteHandle::SqlType, QString>::const_iterator itrForGettingTag{ std::next(range.first, 4) };
+    QMap<QString, QVariant> files_were_tagged{};
+    QMap<QString, QVariant> files_were_untagged{};
+    QMap<QString, QMap<QString, QString>>::const_iterator partionItrBeg{ filesInSpecifyPartion.cbegin() };
+    QMap<QString, QMap<QString, QString>>::const_iterator partionItrEnd{ filesInSpecifyPartion.cend() };
+
+    for (; partionItrBeg != partionItrEnd; ++partionItrBeg) {
+        const QString &mountPoint{ partionItrBeg.key() };
+        DSqliteHandle::ReturnCode code{ this->checkDBFileExist(mountPoint) };
+
+        if (code != DSqliteHandle::ReturnCode::Exist && code != DSqliteHandle::ReturnCode::NoExist) {
+            qWarning("A partion was unmounted just now!");
+            result = false;
+            continue;
+        }
+
+        this->connectToShareSqlite(mountPoint);
+
+        if (!(m_sqlDatabasePtr && this->openSqlDatabase() && m_sqlDatabasePtr->transaction())) {
+            this->closeSqlDatabase();
+            result = false;
+            continue;
+        }
+
+        QSqlQuery queryForGettingTag{ *m_sqlDatabasePtr };
+        prepareSqlQuery(queryForGettingTag, itrForGettingTag->second);
+
+        QMap<QString, QList<QString>> forDecreasing{};
+        QMap<QString, QList<QString>> forIncreasing{};
+        QMap<QString, QVariant> tagged_in_partion{};
+        QMap<QString, QVariant> untagged_in_partion{};
+        QMap<QString, QString>::const_iterator fileItrBeg{ partionItrBeg.value().cbegin() };
+        QMap<QString, QString>::const_iterator fileItrEnd{ partionItrBeg.value().cend() };
+
+        for (; fileItrBeg != fileItrEnd; ++fileItrBeg) {
+            const QList<QString> &tags{ filesAndTags[fileItrBeg.value()] };
+            QList<QString> currentTags{};
+
+            queryForGettingTag.bindValue(":file_name", fileItrBeg.key());
+
+            if (queryForGettingTag.exec()) {
+
+                while (queryForGettingTag.next()) {
+                    currentTags.push_back(queryForGettingTag.value("tag_name").toString());
+                }
+            }
+
+            QList<QString> decreased{};
+            QList<QString> increased{};
+
+            for (const QString &tag_name : currentTags) {
+                if (!tags.contains(tag_name)) {
+                    decreased.push_back(tag_name);
+                }
+            }
+
+            for (const QString &tag_name : tags) {
+                if (!currentTags.contains(tag_name) && !increased.contains(tag_name)) {
+                    increased.push_back(tag_name);
+                }
+            }
+
+            if (!decreased.isEmpty()) {
+                forDecreasing[fileItrBeg.key()] = decreased;
+                untagged_in_partion[fileItrBeg.value()] = QVariant{ decreased };
+            }
+
+            if (!increased.isEmpty()) {
+                forIncreasing[fileItrBeg.key()] = increased;
+                tagged_in_partion[fileItrBeg.value()] = QVariant{ tags };
+            }
+        }
+
+        bool valueOfDelRedundant{ forDecreasing.isEmpty() || this->helpExecSql<DSqliteHandle::SqlType::TagFiles, QMap<QString, QList<QString>>,
+                                  bool>(forDecreasing, mountPoint) };
+        bool valueOfInsertNew{ forIncreasing.isEmpty() || this->helpExecSql<DSqliteHandle::SqlType::TagFiles2, QMap<QString, QList<QString>>,
+                               bool>(forIncreasing, mountPoint) };
+        QList<QString> files{ forDecreasing.keys() };
+
+        for (const QString &file : forIncreasing.keys()) {
+            if (!forDecreasing.contains(file)) {
+                files << file;
+            }
+        }
+
+        bool valueOfUpdating{ files.isEmpty() || this->helpExecSql<DSqliteHandle::SqlType::TagFiles3, QList<QString>,
+                              bool>(files, mountPoint) };
+
+        if (!(valueOfDelRedundant && valueOfInsertNew && valueOfUpdating && m_sqlDatabasePtr->commit())) {
+            m_sqlDatabasePtr->rollback();
+            this->closeSqlDatabase();
+            result = false;
+            continue;
+        }
+
+        this->closeSqlDatabase();
+        files_were_tagged.unite(tagged_in_partion);
+        files_were_untagged.unite(untagged_in_partion);
+    }
+
+    if (!files_were_untagged.isEmpty()) {
+        emit untagFiles(files_were_untagged);
+    }
+
+    if (!files_were_tagged.isEmpty()) {
+        emit filesWereTagged(files_were_tagged);
+    }
+
+    return result;
+}
+
+
 template<>
 bool DSqliteHandle::execSqlstr<DSqliteHandle::SqlType::TagFilesThroughColor, bool>(const QMap<QString, QList<QString>> &filesAndTags)
 {
@@ -2665,7 +2746,7 @@ bool DSqliteHandle::execSqlstr<DSqliteHandle::SqlType::TagFilesThroughColor, boo
         this->connectToShareSqlite("/home", ".__main.db");
         bool the_result{ true };
 
-        if (m_sqlDatabasePtr && m_sqlDatabasePtr->open() && m_sqlDatabasePtr->transaction()) {
+        if (m_sqlDatabasePtr && this->openSqlDatabase() && m_sqlDatabasePtr->transaction()) {
             the_result = this->helpExecSql<DSqliteHandle::SqlType::TagFilesThroughColor3, QString, bool>(filesAndTags.cbegin().key(), "/home");
         }
 
@@ -2742,7 +2823,7 @@ bool DSqliteHandle::execSqlstr<DSqliteHandle::SqlType::TagFilesThroughColor, boo
                     }
 
                     if (!sqlStrs.empty()) {
-                        if (m_sqlDatabasePtr->open() && m_sqlDatabasePtr->transaction()) {
+                        if (this->openSqlDatabase() && m_sqlDatabasePtr->transaction()) {
                             bool value = this->helpExecSql<DSqliteHandle::SqlType::TagFilesThroughColor,
                                  std::list<std::tuple<QString, QString, QString, QString, QString, QString>>, bool>(sqlStrs, cbeg.key());
 
@@ -2833,7 +2914,7 @@ bool DSqliteHandle::execSqlstr<DSqliteHandle::SqlType::UntagSamePartionFiles, bo
                         }
                     }
 
-                    if (!sqlForDeletingRowOfTagWithFile.empty() && m_sqlDatabasePtr->open()
+                    if (!sqlForDeletingRowOfTagWithFile.empty() && this->openSqlDatabase()
                             && m_sqlDatabasePtr->transaction()) {
                         bool resultOfDeleteRowInTagWithFile{ this->helpExecSql<DSqliteHandle::SqlType::UntagSamePartionFiles,
                                                              std::list<QString>, bool>(sqlForDeletingRowOfTagWithFile, unixDeviceAndMountPoint.second) };
@@ -2972,7 +3053,7 @@ bool DSqliteHandle::execSqlstr<DSqliteHandle::SqlType::DeleteFiles, bool>(const
             if (code == DSqliteHandle::ReturnCode::NoExist || code == DSqliteHandle::ReturnCode::Exist) {
                 this->connectToShareSqlite(itr_partion_and_files->first);
 
-                if (m_sqlDatabasePtr && m_sqlDatabasePtr->open()) {
+                if (m_sqlDatabasePtr && this->openSqlDatabase()) {
                     QMap<QString, QList<QString>> file_and_tags_partion{
                         this->helpExecSql<DSqliteHandle::SqlType::DeleteFiles2,
                         std::list<QString>, QMap<QString, QList<QString>>>(itr_partion_and_files->second, itr_partion_and_files->first)
@@ -3007,7 +3088,7 @@ bool DSqliteHandle::execSqlstr<DSqliteHandle::SqlType::DeleteFiles, bool>(const
             if (code == DSqliteHandle::ReturnCode::NoExist || code == DSqliteHandle::ReturnCode::Exist) {
                 this->connectToShareSqlite(itr_partion_and_files->first);
 
-                if (m_sqlDatabasePtr && m_sqlDatabasePtr->open() && m_sqlDatabasePtr->transaction()) {
+                if (m_sqlDatabasePtr && this->openSqlDatabase() && m_sqlDatabasePtr->transaction()) {
 
                     bool result{ this->helpExecSql<DSqliteHandle::SqlType::DeleteFiles,
                                  std::list<QString>, bool>(itr_partion_and_files->second, itr_partion_and_files->first) };
@@ -3050,7 +3131,7 @@ bool DSqliteHandle::execSqlstr<DSqliteHandle::SqlType::DeleteTags, bool>(const Q
         bool the_result{ true };
         QList<QString> the_tags_for_deleting{ filesAndTags.keys() };
 
-        if (m_sqlDatabasePtr && m_sqlDatabasePtr->open() && m_sqlDatabasePtr->transaction()) {
+        if (m_sqlDatabasePtr && this->openSqlDatabase() && m_sqlDatabasePtr->transaction()) {
             the_result = this->helpExecSql<DSqliteHandle::SqlType::DeleteTags3, QList<QString>, bool>(the_tags_for_deleting, "/home");
         }
 
@@ -3100,7 +3181,7 @@ bool DSqliteHandle::execSqlstr<DSqliteHandle::SqlType::DeleteTags, bool>(const Q
                             bool flagForDeleteInTagWithFile{ false };
                             bool flagForUpdatingFileProperty{ false };
 
-                            if (m_sqlDatabasePtr && m_sqlDatabasePtr->open() && m_sqlDatabasePtr->transaction()) {
+                            if (m_sqlDatabasePtr && this->openSqlDatabase() && m_sqlDatabasePtr->transaction()) {
                                 flagForDeleteInTagWithFile = this->helpExecSql<DSqliteHandle::SqlType::DeleteTags,
                                 std::list<QString>, bool>(sqlStrs, mountPointItr->second);
 
@@ -3153,9 +3234,6 @@ bool DSqliteHandle::execSqlstr<DSqliteHandle::SqlType::ChangeFilesName, bool>(co
     if (!filesAndTags.isEmpty()) {
         QMap<QString, QList<QString>>::const_iterator cbeg{ filesAndTags.cbegin() };
         QMap<QString, QList<QString>>::const_iterator cend{ filesAndTags.cend() };
-        std::pair<std::multimap<DSqliteHandle::SqlType, QString>::const_iterator,
-            std::multimap<DSqliteHandle::SqlType, QString>::const_iterator> range{ SqlTypeWithStrs.equal_range(DSqliteHandle::SqlType::ChangeFilesName) };
-
         std::map<QString, std::map<QString, QString>> partionsAndFileNames{};
 
         for (; cbeg != cend; ++cbeg) {
@@ -3177,7 +3255,7 @@ bool DSqliteHandle::execSqlstr<DSqliteHandle::SqlType::ChangeFilesName, bool>(co
             if (code == DSqliteHandle::ReturnCode::NoExist || code == DSqliteHandle::ReturnCode::Exist) {
                 this->connectToShareSqlite(partion_and_file_names.first);
 
-                if (m_sqlDatabasePtr && m_sqlDatabasePtr->open()) {
+                if (m_sqlDatabasePtr && this->openSqlDatabase()) {
                     QMap<QString, QList<QString>> file_with_tags{
                         this->helpExecSql<DSqliteHandle::SqlType::ChangeFilesName2, std::map<QString, QString>,
                         QMap<QString, QList<QString>>>(partion_and_file_names.second, partion_and_file_names.first)
@@ -3197,110 +3275,92 @@ bool DSqliteHandle::execSqlstr<DSqliteHandle::SqlType::ChangeFilesName, bool>(co
         }
 
 
-        std::map<QString, std::map<QString, QString>> sqlForChangingFilesName{};
         std::map<QString, std::map<QString, QString>> partionsAndFileNames_backup{ partionsAndFileNames };
 
         if (!partionsAndFileNames.empty()) {
-            std::map<QString, std::map<QString, QString>>::const_iterator partionBeg{ partionsAndFileNames.cbegin() };
-            std::map<QString, std::map<QString, QString>>::const_iterator partionEnd{ partionsAndFileNames.cend() };
-
-            for (; partionBeg != partionEnd; ++partionBeg) {
-
-                for (const std::pair<QString, QString> &oldAndNewName : partionBeg->second) {
-                    std::map<DSqliteHandle::SqlType, QString>::const_iterator rangeBeg{ range.first };
-                    QString updateFileProperty{ rangeBeg->second.arg(oldAndNewName.second)};
-                    updateFileProperty = updateFileProperty.arg(oldAndNewName.first);
-
-                    QString updateTagWithFile{ (++rangeBeg)->second.arg(oldAndNewName.second) };
-                    updateTagWithFile = updateTagWithFile.arg(oldAndNewName.first);
-                    sqlForChangingFilesName[partionBeg->first].emplace(updateFileProperty, updateTagWithFile);
-                }
-            }
-
-            if (!sqlForChangingFilesName.empty()) {
-                bool result{ true };
+            ///###: the names are bound to the prepared statements in helpExecSql, one transaction for each partion.
+            bool result{ true };
 
-                for (const std::pair<QString, std::map<QString, QString>> &mountPointAndSqls : sqlForChangingFilesName) {
-                    DSqliteHandle::ReturnCode code{ this->checkDBFileExist(mountPointAndSqls.first) };
+            for (const std::pair<QString, std::map<QString, QString>> &mountPointAndNames : partionsAndFileNames) {
+                DSqliteHandle::ReturnCode code{ this->checkDBFileExist(mountPointAndNames.first) };
 
-                    if (code == DSqliteHandle::ReturnCode::NoExist || code == DSqliteHandle::ReturnCode::Exist) {
-                        this->connectToShareSqlite(mountPointAndSqls.first);
+                if (code == DSqliteHandle::ReturnCode::NoExist || code == DSqliteHandle::ReturnCode::Exist) {
+                    this->connectToShareSqlite(mountPointAndNames.first);
 
-                        if (m_sqlDatabasePtr && m_sqlDatabasePtr->open() && m_sqlDatabasePtr->transaction()) {
-                            bool resultOfExecSql{ this->helpExecSql<DSqliteHandle::SqlType::ChangeFilesName,
-                                                  std::map<QString, QString>, bool>(mountPointAndSqls.second, mountPointAndSqls.first) };
+                    if (m_sqlDatabasePtr && this->openSqlDatabase() && m_sqlDatabasePtr->transaction()) {
+                        bool resultOfExecSql{ this->helpExecSql<DSqliteHandle::SqlType::ChangeFilesName,
+                                              std::map<QString, QString>, bool>(mountPointAndNames.second, mountPointAndNames.first) };
 
-                            if (!(resultOfExecSql && m_sqlDatabasePtr->commit())) {
-                                m_sqlDatabasePtr->rollback();
-                                result = false;
+                        if (!(resultOfExecSql && m_sqlDatabasePtr->commit())) {
+                            m_sqlDatabasePtr->rollback();
+                            result = false;
 
-                                partionsAndFileNames_backup.erase(mountPointAndSqls.first);
-                                file_with_tags_in_partion.remove(mountPointAndSqls.first);
-                            }
+                            partionsAndFileNames_backup.erase(mountPointAndNames.first);
+                            file_with_tags_in_partion.remove(mountPointAndNames.first);
                         }
                     }
                 }
+            }
 
-                this->closeSqlDatabase();
+            this->closeSqlDatabase();
 
-                QMap<QString, QList<QString>> file_with_tags_new{};
+            QMap<QString, QList<QString>> file_with_tags_new{};
 
-                for (const std::pair<QString, std::map<QString, QString>> &mount_point_and_file_names : partionsAndFileNames_backup) {
-                    std::map<QString, QString> new_and_old_names{};
+            for (const std::pair<QString, std::map<QString, QString>> &mount_point_and_file_names : partionsAndFileNames_backup) {
+                std::map<QString, QString> new_and_old_names{};
 
-                    for (const std::pair<QString, QString> &old_and_new_name : mount_point_and_file_names.second) {
-                        new_and_old_names[old_and_new_name.second] = old_and_new_name.first;
-                    }
+                for (const std::pair<QString, QString> &old_and_new_name : mount_point_and_file_names.second) {
+                    new_and_old_names[old_and_new_name.second] = old_and_new_name.first;
+                }
 
-                    DSqliteHandle::ReturnCode code{ this->checkDBFileExist(mount_point_and_file_names.first) };
+                DSqliteHandle::ReturnCode code{ this->checkDBFileExist(mount_point_and_file_names.first) };
 
-                    if (code == DSqliteHandle::ReturnCode::NoExist || code == DSqliteHandle::ReturnCode::Exist) {
-                        this->connectToShareSqlite(mount_point_and_file_names.first);
+                if (code == DSqliteHandle::ReturnCode::NoExist || code == DSqliteHandle::ReturnCode::Exist) {
+                    this->connectToShareSqlite(mount_point_and_file_names.first);
 
-                        if (m_sqlDatabasePtr && m_sqlDatabasePtr->open()) {
-                            QMap<QString, QList<QString>> file_with_tags{
-                                this->helpExecSql<DSqliteHandle::SqlType::ChangeFilesName2, std::map<QString, QString>,
-                                QMap<QString, QList<QString>>>(new_and_old_names, mount_point_and_file_names.first)
-                            };
+                    if (m_sqlDatabasePtr && this->openSqlDatabase()) {
+                        QMap<QString, QList<QString>> file_with_tags{
+                            this->helpExecSql<DSqliteHandle::SqlType::ChangeFilesName2, std::map<QString, QString>,
+                            QMap<QString, QList<QString>>>(new_and_old_names, mount_point_and_file_names.first)
+                        };
 
-                            using namespace impl;
-                            file_with_tags_new += file_with_tags;
-                        }
+                        using namespace impl;
+                        file_with_tags_new += file_with_tags;
                     }
                 }
+            }
 
-                QMap<QString, QList<QString>> file_with_tags_old{};
-                QMap<QString, QMap<QString, QList<QString>>>::const_iterator itr_beg{ file_with_tags_in_partion.cbegin() };
-                QMap<QString, QMap<QString, QList<QString>>>::const_iterator itr_end{ file_with_tags_in_partion.cend() };
+            QMap<QString, QList<QString>> file_with_tags_old{};
+            QMap<QString, QMap<QString, QList<QString>>>::const_iterator itr_beg{ file_with_tags_in_partion.cbegin() };
+            QMap<QString, QMap<QString, QList<QString>>>::const_iterator itr_end{ file_with_tags_in_partion.cend() };
 
-                for (; itr_beg != itr_end; ++itr_beg) {
-                    using namespace impl;
-                    file_with_tags_old += itr_beg.value();
-                }
+            for (; itr_beg != itr_end; ++itr_beg) {
+                using namespace impl;
+                file_with_tags_old += itr_beg.value();
+            }
 
-                QMap<QString, QVariant> file_with_tags_var{};
-                QMap<QString, QList<QString>>::iterator file_with_tags_beg{ file_with_tags_old.begin() };
-                QMap<QString, QList<QString>>::iterator file_with_tags_end{ file_with_tags_old.end() };
+            QMap<QString, QVariant> file_with_tags_var{};
+            QMap<QString, QList<QString>>::iterator file_with_tags_beg{ file_with_tags_old.begin() };
+            QMap<QString, QList<QString>>::iterator file_with_tags_end{ file_with_tags_old.end() };
 
-                for (; file_with_tags_beg != file_with_tags_end; ++file_with_tags_beg) {
-                    file_with_tags_var[file_with_tags_beg.key()] = QVariant{ file_with_tags_beg.value() };
-                }
+            for (; file_with_tags_beg != file_with_tags_end; ++file_with_tags_beg) {
+                file_with_tags_var[file_with_tags_beg.key()] = QVariant{ file_with_tags_beg.value() };
+            }
 
-                emit untagFiles(file_with_tags_var);
+            emit untagFiles(file_with_tags_var);
 
-                file_with_tags_var.clear();
-                file_with_tags_beg = file_with_tags_new.begin();
-                file_with_tags_end = file_with_tags_new.end();
+            file_with_tags_var.clear();
+            file_with_tags_beg = file_with_tags_new.begin();
+            file_with_tags_end = file_with_tags_new.end();
 
-                for (; file_with_tags_beg != file_with_tags_end; ++file_with_tags_beg) {
-                    file_with_tags_var[file_with_tags_beg.key()] = QVariant{ file_with_tags_beg.value() };
-                }
+            for (; file_with_tags_beg != file_with_tags_end; ++file_with_tags_beg) {
+                file_with_tags_var[file_with_tags_beg.key()] = QVariant{ file_with_tags_beg.value() };
+            }
 
-                emit filesWereTagged(file_with_tags_var);
-                this->closeSqlDatabase();
+            emit filesWereTagged(file_with_tags_var);
+            this->closeSqlDatabase();
 
-                return result;
-            }
+            return result;
         }
     }
 
@@ -3323,7 +3383,7 @@ bool DSqliteHandle::execSqlstr<DSqliteHandle::SqlType::ChangeTagsName, bool>(con
         this->connectToShareSqlite("/home", ".__main.db");
         bool the_result{ true };
 
-        if (m_sqlDatabasePtr && m_sqlDatabasePtr->open() && m_sqlDatabasePtr->transaction()) {
+        if (m_sqlDatabasePtr && this->openSqlDatabase() && m_sqlDatabasePtr->transaction()) {
             the_result = this->helpExecSql<DSqliteHandle::SqlType::ChangeTagsName2, QMap<QString, QList<QString>>, bool>(filesAndTags, "/home");
         }
 
@@ -3374,7 +3434,7 @@ bool DSqliteHandle::execSqlstr<DSqliteHandle::SqlType::ChangeTagsName, bool>(con
                             bool resultOfChangeNameOfTag{ true };
                             bool flagOfTransaction{ true };
 
-                            if (m_sqlDatabasePtr && m_sqlDatabasePtr->open()) {
+                            if (m_sqlDatabasePtr && this->openSqlDatabase()) {
                                 flagOfTransaction = m_sqlDatabasePtr->transaction();
 
                                 if (flagOfTransaction) {
@@ -3443,7 +3503,7 @@ QList<QString> DSqliteHandle::execSqlstr<DSqliteHandle::SqlType::GetTagsThroughF
             this->connectToShareSqlite(partionAndMountPoint.second);
 
             ///###: no transaction.
-            if (m_sqlDatabasePtr->open()) {
+            if (this->openSqlDatabase()) {
                 tags = this->helpExecSql<DSqliteHandle::SqlType::GetTagsThroughFile,
                 QString, QList<QString>>(sqlForGetTagsThroughFile, partionAndMountPoint.second);
             }
@@ -3489,7 +3549,7 @@ QList<QString> DSqliteHandle::execSqlstr<DSqliteHandle::SqlType::GetFilesThrough
                         if (code == DSqliteHandle::ReturnCode::NoExist || code == DSqliteHandle::ReturnCode::Exist) {
                             this->connectToShareSqlite(mountPointItr->second);
 
-                            if (m_sqlDatabasePtr && m_sqlDatabasePtr->open()) {
+                            if (m_sqlDatabasePtr && this->openSqlDatabase()) {
 
                                 QList<QString> filesOfPartion{ this->helpExecSql<DSqliteHandle::SqlType::GetFilesThroughTag,
                                                                QString, QList<QString>>(sqlForGetFilesThroughTag, mountPointItr->second) };
@@ -3561,6 +3621,32 @@ QList<QString> DSqliteHandle::execSqlstr<DSqliteHandle::SqlType::GetSameTagsOfDi
 }
 
 
+///###: query the tags of every file in one request, the result contains all the given files.
+template<>
+QMap<QString, QVariant> DSqliteHandle::execSqlstr<DSqliteHandle::SqlType::GetTagsOfEachFile, QMap<QString, QVariant>>(const QMap<QString, QList<QString>> &filesAndTags)
+{
+    QMap<QString, QVariant> file_and_tags{};
+    QMap<QString, QList<QString>>::const_iterator cbeg{ filesAndTags.cbegin() };
+    QMap<QString, QList<QString>>::const_iterator cend{ filesAndTags.cend() };
+
+    for (; cbeg != cend; ++cbeg) {
+        QMap<QString, QList<QString>> file{};
+        file.insert(cbeg.key(), cbeg.value());
+
+        QList<QString> tags_names{ this->execSqlstr<DSqliteHandle::SqlType::GetTagsThroughFile, QList<QString>>(file) };
+        QList<QString> tags_names_backup{};
+        std::transform(tags_names.begin(), tags_names.end(), std::back_inserter(tags_names_backup),
+        [](const QString & tag_name) {
+            return Tag::restore_escaped_en_skim(tag_name);
+        });
+
+        file_and_tags[Tag::restore_escaped_en_skim(cbeg.key())] = QVariant{ tags_names_backup };
+    }
+
+    return file_and_tags;
+}
+
+
 template<>
 QMap<QString, QVariant> DSqliteHandle::execSqlstr<DSqliteHandle::SqlType::GetAllTags, QMap<QString, QVariant>>(const QMap<QString, QList<QString>> &filesAndTags)
 {
@@ -3572,7 +3658,7 @@ QMap<QString, QVariant> DSqliteHandle::execSqlstr<DSqliteHandle::SqlType::GetAll
             std::multimap<DSqliteHandle::SqlType, QString>::const_iterator> range{ SqlTypeWithStrs.equal_range(DSqliteHandle::SqlType::GetAllTags) };
         this->connectToShareSqlite("/home", ".__main.db");
 
-        if (m_sqlDatabasePtr && m_sqlDatabasePtr->open()) {
+        if (m_sqlDatabasePtr && this->openSqlDatabase()) {
             QSqlQuery sql_query{ *m_sqlDatabasePtr };
 
             if (sql_query.exec(range.first->second)) {
@@ -3604,7 +3690,7 @@ QMap<QString, QVariant> DSqliteHandle::execSqlstr<DSqliteHandle::SqlType::GetTag
             std::multimap<DSqliteHandle::SqlType, QString>::const_iterator> range{ SqlTypeWithStrs.equal_range(DSqliteHandle::SqlType::GetTagColor) };
         this->connectToShareSqlite("/home", ".__main.db");
 
-        if (m_sqlDatabasePtr && m_sqlDatabasePtr->open()) {
+        if (m_sqlDatabasePtr && this->openSqlDatabase()) {
             QMap<QString, QList<QString>>::const_iterator c_beg{ fileAndTags.cbegin() };
             QMap<QString, QList<QString>>::const_iterator c_end{ fileAndTags.cend() };
             QString sql_str{ range.first->second };
@@ -3637,7 +3723,7 @@ bool DSqliteHandle::execSqlstr<DSqliteHandle::SqlType::ChangeTagColor, bool>(con
             std::multimap<DSqliteHandle::SqlType, QString>::const_iterator> range{ SqlTypeWithStrs.equal_range(DSqliteHandle::SqlType::ChangeTagColor) };
         this->connectToShareSqlite("/home", ".__main.db");
 
-        if (m_sqlDatabasePtr && m_sqlDatabasePtr->open() && m_sqlDatabasePtr->transaction()) {
+        if (m_sqlDatabasePtr && this->openSqlDatabase() && m_sqlDatabasePtr->transaction()) {
             QMap<QString, QList<QString>>::const_iterator c_beg{ filesAndTags.cbegin() };
             QMap<QString, QList<QString>>::const_iterator c_end{ filesAndTags.cend() };
             QSqlQuery sql_query{ *m_sqlDatabasePtr };
@@ -3678,7 +3764,7 @@ bool DSqliteHandle::execSqlstr<DSqliteHandle::SqlType::BeforeTagFiles, bool>(con
                   std::multimap<DSqliteHandle::SqlType, QString>::const_iterator> range{ SqlTypeWithStrs.equal_range(DSqliteHandle::SqlType::BeforeTagFiles) };
         this->connectToShareSqlite("/home", ".__main.db");
 
-        if (m_sqlDatabasePtr && m_sqlDatabasePtr->open() && m_sqlDatabasePtr->transaction()) {
+        if (m_sqlDatabasePtr && this->openSqlDatabase() && m_sqlDatabasePtr->transaction()) {
 
             QMap<QString, QList<QString>>::const_iterator c_beg{ filesAndTags.cbegin() };
             QMap<QString, QList<QString>>::const_iterator c_end{ filesAndTags.cend() };
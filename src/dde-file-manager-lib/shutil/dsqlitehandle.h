@@ -87,7 +87,11 @@ public:
 
         GetAllTags,
         GetTagColor,
-        ChangeTagColor
+        ChangeTagColor,
+
+        GetTagsOfEachFile,
+
+        TagEachFile
     };
 
     enum class ReturnCode : std::size_t {
@@ -125,6 +129,8 @@ private slots:
 private:
     static QString restoreEscapedChar(const QString &value);
 
+    bool openSqlDatabase();
+
     inline void closeSqlDatabase()noexcept
     {
         if (m_sqlDatabasePtr && m_sqlDatabasePtr->isOpen()) {
@@ -172,6 +178,12 @@ private:
 
     void initializeConnect();
 
+    ///###: when a device is mounted/unmounted, the db file may be gone in the middle of a batch.
+    inline bool isCurrentDBAvailable(const QString &mountPoint)
+    {
+        return !m_flag.load(std::memory_order_acquire) || this->checkDBFileExist(mountPoint) == ReturnCode::Exist;
+    }
+
     /**
      * @brief connectToSqlite 创建数据库连接
      * 旧逻辑，正常连接数据库的逻辑
@@ -191,6 +203,7 @@ private:
 
     std::unique_ptr<std::map<QString, std::multimap<QString, QString>>> m_partionsOfDevices{ nullptr };
     std::unique_ptr<QSqlDatabase> m_sqlDatabasePtr{ nullptr };
+    QString m_connectionName{};
     std::atomic<bool> m_flag{ false };
     std::mutex m_mutex{};
 
@@ -209,6 +222,9 @@ bool DSqliteHandle::execSqlstr<DSqliteHandle::SqlType::TagFiles, bool>(const QMa
 template<>
 bool DSqliteHandle::execSqlstr<DSqliteHandle::SqlType::TagFilesThroughColor, bool>(const QMap<QString, QList<QString>> &filesAndTags);
 
+template<> ///###: <file, <tagName>>, the tags of every file are replaced by the given tags.
+bool DSqliteHandle::execSqlstr<DSqliteHandle::SqlType::TagEachFile, bool>(const QMap<QString, QList<QString>> &filesAndTags);
+
 ///###: query
 template<>
 QList<QString> DSqliteHandle::execSqlstr<DSqliteHandle::SqlType::GetTagsThroughFile, QList<QString>>(const QMap<QString, QList<QString>> &filesAndTags);
@@ -216,6 +232,9 @@ QList<QString> DSqliteHandle::execSqlstr<DSqliteHandle::SqlType::GetTagsThroughF
 template<>
 QList<QString> DSqliteHandle::execSqlstr<DSqliteHandle::SqlType::GetSameTagsOfDiffFiles, QList<QString>>(const QMap<QString, QList<QString>> &filesAndTags);
 
+template<> ///###: ---------------------------------------------------------> <file, <tagName>>
+QMap<QString, QVariant> DSqliteHandle::execSqlstr<DSqliteHandle::SqlType::GetTagsOfEachFile, QMap<QString, QVariant>>(const QMap<QString, QList<QString>> &filesAndTags);
+
 template<>
 QList<QString> DSqliteHandle::execSqlstr<DSqliteHandle::SqlType::GetFilesThroughTag, QList<QString>>(const QMap<QString, QList<QString>> &filesAndTags);
 
@@ -310,9 +329,9 @@ bool DSqliteHandle::helpExecSql<DSqliteHandle::SqlType::DeleteTags3, QList<QStri
 
 
 ///###: change file(s) name.
-template<>
+template<> ///###: --------------------------------------------------------> <OldFileName, NewFileName>
 bool DSqliteHandle::helpExecSql<DSqliteHandle::SqlType::ChangeFilesName,
-     std::map<QString, QString>, bool>(const std::map<QString, QString> &sqlStrs, const QString &mountPoint);
+     std::map<QString, QString>, bool>(const std::map<QString, QString> &oldAndNewNames, const QString &mountPoint);
 
 template<>
 QMap<QString, QList<QString>> DSqliteHandle::helpExecSql<DSqliteHandle::SqlType::ChangeFilesName2, std::map<QString, QString>,
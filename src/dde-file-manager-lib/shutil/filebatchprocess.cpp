@@ -6,14 +6,78 @@
 #include "filebatchprocess.h"
 #include "dfmeventdispatcher.h"
 
+#include "fileutils.h"
 #include "controllers/filecontroller.h"
 
 #include <QDebug>
 #include <QByteArray>
+#include <QSet>
+#include <QHash>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <errno.h>
+#include <sys/syscall.h>
+
+#ifndef RENAME_NOREPLACE
+#define RENAME_NOREPLACE (1 << 0)
+#endif
+
+// 批量重命名出现名称交换时，先把文件移到此前缀开头的临时名称
+#define BULK_RENAME_TEMP_PREFIX ".dfm-batch-rename-"
 
 std::once_flag FileBatchProcess::flag;
 const static QString MIMETYPE_APP_DESKTOP = "application/x-desktop";
 
+namespace  {
+struct BulkRenameEntry
+{
+    DUrl from;
+    DUrl to;
+    QByteArray fromName;
+    QByteArray toName;
+    QByteArray tempName;
+};
+
+// 目标已存在时失败（EEXIST），不会覆盖其它文件；内核不支持时 errno 为 ENOSYS
+int renameNoReplace(int dirFd, const QByteArray &fromName, const QByteArray &toName)
+{
+#ifdef SYS_renameat2
+    return static_cast<int>(syscall(SYS_renameat2, dirFd, fromName.constData(), dirFd, toName.constData(), RENAME_NOREPLACE));
+#else
+    Q_UNUSED(dirFd)
+    Q_UNUSED(fromName)
+    Q_UNUSED(toName)
+    errno = ENOSYS;
+    return -1;
+#endif
+}
+
+QSet<QByteArray> dirNameSnapshot(int dirFd)
+{
+    QSet<QByteArray> names;
+    int fd = dup(dirFd);
+
+    if (fd < 0)
+        return names;
+
+    DIR *dir = fdopendir(fd);
+
+    if (!dir) {
+        close(fd);
+        return names;
+    }
+
+    while (struct dirent *ent = readdir(dir))
+        names.insert(QByteArray(ent->d_name));
+
+    closedir(dir);
+
+    return names;
+}
+}
+
 QSharedMap<DUrl, DUrl> FileBatchProcess::replaceText(const QList<DUrl>& originUrls, const QPair<QString, QString> &pair) const
 {
     if(originUrls.isEmpty() == true) { //###: here, judge whether there are fileUrls in originUrls.
@@ -206,6 +270,7 @@ QMap<DUrl, DUrl> FileBatchProcess::batchProcessFile(const QSharedMap<DUrl, DUrl>
     // 实现批量回退
     DFMEventDispatcher::instance()->processEvent<DFMSaveOperatorEvent>();
 
+    QMap<DUrl, DUrl> pending;
     bool checkHideRule = false;
     for (; beg != end; ++beg) {
         DUrl currentName{ beg.key() };
@@ -221,9 +286,45 @@ QMap<DUrl, DUrl> FileBatchProcess::batchProcessFile(const QSharedMap<DUrl, DUrl>
                 break;
         }
 
+        pending[currentName] = hopedName;
+    }
+
+    // 同一目录下的本地文件直接批量重命名，不再逐个分发重命名事件
+    cache = bulkRenameLocalFiles(pending);
+
+    for (auto it = cache.constBegin(); it != cache.constEnd(); ++it) {
+        DFMEventDispatcher::instance()->processEvent<DFMSaveOperatorEvent>(dMakeEventPointer<DFMRenameEvent>(nullptr, it.key(), it.value()),
+                                                                           dMakeEventPointer<DFMRenameEvent>(nullptr, it.value(), it.key()));
+        emit DFileService::instance()->fileRenamed(it.key(), it.value());
+        pending.remove(it.key());
+    }
+
+    // 重命名的文件在剪贴板中时替换剪贴板中的路径，所有文件只需处理一次
+    if (!cache.isEmpty()) {
+        QList<QUrl> clipUrls = DFMGlobal::fetchUrlsFromClipboard();
+        bool needReset = false;
+
+        for (QUrl &clipUrl : clipUrls) {
+            if (!clipUrl.isLocalFile())
+                continue;
+
+            const DUrl &newUrl = cache.value(DUrl::fromLocalFile(clipUrl.toLocalFile()));
+
+            if (newUrl.isValid()) {
+                clipUrl = newUrl;
+                needReset = true;
+            }
+        }
+
+        if (needReset)
+            DFMGlobal::setUrlsToClipboard(clipUrls, DFMGlobal::fetchClipboardAction());
+    }
+
+    // 批量重命名未处理的文件（如桌面文件、跨目录、名称冲突）仍走原来的流程，由其提示错误
+    for (auto it = pending.constBegin(); it != pending.constEnd(); ++it) {
        ///###: just cache files that rename successfully.
-       if (DFileService::instance()->renameFile(nullptr, currentName, hopedName, false, false) == true ) {
-           cache[currentName] = hopedName;
+       if (DFileService::instance()->renameFile(nullptr, it.key(), it.value(), false, false) == true ) {
+           cache[it.key()] = it.value();
        }
     }
 
@@ -232,3 +333,121 @@ QMap<DUrl, DUrl> FileBatchProcess::batchProcessFile(const QSharedMap<DUrl, DUrl>
 
     return cache;
 }
+
+/*!
+ * \brief FileBatchProcess::bulkRenameLocalFiles 在目录的文件描述符上直接批量重命名同一目录下的本地文件
+ *
+ * 先读取目录中的文件名快照校验所有目标名称，与目录中其它文件或本批中其它目标同名的文件不处理。
+ * 目标名称是本批中另一个文件的源名称时（如交换名称），先把所有文件移到临时名称再改为目标名称。
+ * 重命名使用 RENAME_NOREPLACE，快照之后新出现的同名文件也不会被覆盖。
+ * \return 重命名成功的文件，其余的由调用者逐个重命名
+ */
+QMap<DUrl, DUrl> FileBatchProcess::bulkRenameLocalFiles(const QMap<DUrl, DUrl> &map)
+{
+    QMap<DUrl, DUrl> renamed;
+    QHash<QString, QList<BulkRenameEntry>> groups;
+
+    for (auto it = map.constBegin(); it != map.constEnd(); ++it) {
+        if (!it.key().isLocalFile() || !it.value().isLocalFile())
+            continue;
+
+        const QString &fromPath = it.key().toLocalFile();
+        const QString &toPath = it.value().toLocalFile();
+        const int index = fromPath.lastIndexOf('/');
+
+        if (index < 0 || toPath.lastIndexOf('/') != index || !toPath.startsWith(fromPath.left(index + 1)))
+            continue;
+
+        // mtp、ftp 等需要通过 gio 或复制的方式重命名
+        if (FileUtils::isGvfsMountFile(fromPath))
+            continue;
+
+        const DAbstractFileInfoPointer &info = DFileService::instance()->createFileInfo(nullptr, it.key());
+
+        // 桌面文件修改的是文件中的名称
+        if (!info || (info->isDesktopFile() && !info->isSymLink()))
+            continue;
+
+        BulkRenameEntry entry;
+
+        entry.from = it.key();
+        entry.to = it.value();
+        entry.fromName = QFile::encodeName(fromPath.mid(index + 1));
+        entry.toName = QFile::encodeName(toPath.mid(index + 1));
+        groups[fromPath.left(index + 1)] << entry;
+    }
+
+    for (auto group = groups.begin(); group != groups.end(); ++group) {
+        int dirFd = open(QFile::encodeName(group.key()).constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+        if (dirFd < 0)
+            continue;
+
+        const QSet<QByteArray> &existingNames = dirNameSnapshot(dirFd);
+        QSet<QByteArray> sourceNames;
+        QSet<QByteArray> targetNames;
+        QList<BulkRenameEntry> entries;
+        bool twoPhase = false;
+
+        for (const BulkRenameEntry &entry : group.value())
+            sourceNames << entry.fromName;
+
+        for (const BulkRenameEntry &entry : group.value()) {
+            if (!existingNames.contains(entry.fromName) || targetNames.contains(entry.toName)
+                    || (existingNames.contains(entry.toName) && !sourceNames.contains(entry.toName))) {
+                continue;
+            }
+
+            if (sourceNames.contains(entry.toName))
+                twoPhase = true;
+
+            targetNames << entry.toName;
+            entries << entry;
+        }
+
+        bool supported = true;
+
+        if (twoPhase) {
+            const QByteArray &tempPrefix = QByteArray(BULK_RENAME_TEMP_PREFIX) + QByteArray::number(getpid()) + '-';
+            QList<BulkRenameEntry> moved;
+
+            for (int i = 0; i < entries.size(); ++i) {
+                BulkRenameEntry &entry = entries[i];
+
+                entry.tempName = tempPrefix + QByteArray::number(i);
+
+                if (renameNoReplace(dirFd, entry.fromName, entry.tempName) == 0) {
+                    moved << entry;
+                } else if (errno == ENOSYS) {
+                    supported = false;
+                    break;
+                }
+            }
+
+            for (const BulkRenameEntry &entry : moved) {
+                if (supported && renameNoReplace(dirFd, entry.tempName, entry.toName) == 0) {
+                    renamed[entry.from] = entry.to;
+                } else if (renameNoReplace(dirFd, entry.tempName, entry.fromName) != 0) {
+                    qWarning() << "failed to restore the file in batch rename:" << entry.from << "it is left as" << entry.tempName;
+                }
+            }
+        } else {
+            for (const BulkRenameEntry &entry : entries) {
+                if (renameNoReplace(dirFd, entry.fromName, entry.toName) == 0) {
+                    renamed[entry.from] = entry.to;
+                } else if (errno == ENOSYS) {
+                    supported = false;
+                    break;
+                }
+            }
+        }
+
+        close(dirFd);
+
+        // 内核不支持 renameat2 时全部交给调用者逐个重命名
+        if (!supported)
+            break;
+    }
+
+    return renamed;
+}
@@ -65,6 +65,8 @@ public:
 
 
 private:
+    static QMap<DUrl, DUrl> bulkRenameLocalFiles(const QMap<DUrl, DUrl> &map);
+
     ////###: there flag is very important.
     static std::once_flag flag;
 };
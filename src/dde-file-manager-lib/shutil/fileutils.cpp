@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "gvfs/gvfsmountmanager.h"
+#include "gvfs/qmount.h"
 
 #include "fileutils.h"
 #include "smbintegrationswitcher.h"
@@ -65,6 +66,10 @@ extern "C" {
 }
 #define signals public
 
+// 应用不支持一次打开多个文件时，立即启动的个数和之后每次启动的间隔（毫秒）
+#define LAUNCH_APP_BURST_COUNT 4
+#define LAUNCH_APP_INTERVAL 150
+
 DFM_USE_NAMESPACE
 DCORE_USE_NAMESPACE
 
@@ -859,6 +864,108 @@ bool FileUtils::openFile(const QString &filePath, const QString &desktopFile)
     return result;
 }
 
+namespace {
+// 按默认打开方式分组的文件，保持第一次出现的顺序
+struct OpenFileGroup {
+    QString desktopFile;
+    QStringList urls;
+};
+
+/*!
+ * \brief groupFilesByDefaultApp 查找每个文件的默认打开方式，打开方式相同的文件分为一组
+ *
+ * 同一 mimetype 的默认应用和推荐应用只查询一次。
+ * \param mimeTypes 文件 url 对应的 mimetype，用于添加到最近使用
+ */
+QList<OpenFileGroup> groupFilesByDefaultApp(const QStringList &filePaths, QHash<QString, QString> *mimeTypes)
+{
+    QList<OpenFileGroup> groups;
+    QHash<QString, int> groupIndex;
+    QHash<QString, QString> defaultApps;
+    QHash<QString, QString> recommendApps;
+
+    for (const QString &filePath : filePaths) {
+        const DUrl &fileUrl = DUrl::fromLocalFile(filePath);
+        /*********************************************************/
+        //解决空文本文件转其他非文本格式时打开仍然是文本方式打开的问题
+        //QString mimetype = getFileMimetype(filePath);
+        DAbstractFileInfoPointer info = DFileService::instance()->createFileInfo(nullptr, DUrl(FILE_ROOT + filePath));
+        QString mimetype;
+        if (info && info->size() == 0 && info->exists()) {
+            mimetype = info->mimeType().name();
+        } else {
+            mimetype = FileUtils::getFileMimetype(filePath);
+        }
+        mimeTypes->insert(fileUrl.toString(), mimetype);
+        /*********************************************************/
+        bool isOpenNow = false;
+        auto defaultApp = defaultApps.constFind(mimetype);
+        if (defaultApp == defaultApps.constEnd())
+            defaultApp = defaultApps.insert(mimetype, MimesAppsManager::getDefaultAppDesktopFileByMimeType(mimetype));
+        QString defaultDesktopFile = defaultApp.value();
+        if (defaultDesktopFile.isEmpty()) {
+            if (FileUtils::isSmbUnmountedFile(fileUrl)) {
+                mimetype = QString("inode/directory");
+                defaultDesktopFile = MimesAppsManager::getDefaultAppDesktopFileByMimeType(mimetype);
+                isOpenNow = true;
+                mimetype = QString();
+            } else {
+                qDebug() << "no default application for" << filePath;
+                continue;
+            }
+        }
+
+        if (!isOpenNow && FileUtils::isFileManagerSelf(defaultDesktopFile) && mimetype != "inode/directory") {
+            auto recommendApp = recommendApps.constFind(mimetype);
+            if (recommendApp == recommendApps.constEnd()) {
+                QStringList apps = mimeAppsManager->getRecommendedApps(fileUrl);
+                apps.removeOne(defaultDesktopFile);
+                recommendApp = recommendApps.insert(mimetype, apps.isEmpty() ? QString() : apps.first());
+            }
+            defaultDesktopFile = recommendApp.value();
+            if (defaultDesktopFile.isEmpty()) {
+                qDebug() << "no default application for" << filePath;
+                continue;
+            }
+        }
+
+        auto index = groupIndex.constFind(defaultDesktopFile);
+        if (index == groupIndex.constEnd()) {
+            index = groupIndex.insert(defaultDesktopFile, groups.count());
+            OpenFileGroup group;
+            group.desktopFile = defaultDesktopFile;
+            groups << group;
+        }
+        groups[index.value()].urls << fileUrl.toString();
+    }
+
+    return groups;
+}
+
+// 每个应用只启动一次，打开这一组的全部文件
+bool launchFileGroups(const QList<OpenFileGroup> &groups, const QHash<QString, QString> &mimeTypes)
+{
+    bool result = false;
+
+    for (const OpenFileGroup &group : groups) {
+        if (!FileUtils::launchApp(group.desktopFile, group.urls))
+            continue;
+
+        // workaround since DTK apps doesn't support the recent file spec.
+        // spec: https://www.freedesktop.org/wiki/Specifications/desktop-bookmark-spec/
+        // the correct approach: let the app add it to the recent list.
+        // addToRecentFile(DUrl::fromLocalFile(filePath), mimetype);
+        const DesktopFile df(group.desktopFile);
+        for (const QString &tmp : group.urls)
+            FileUtils::addRecentFile(DUrl::fromUserInput(tmp).toLocalFile(), df, mimeTypes.value(tmp));
+
+        result = true;
+    }
+
+    return result;
+}
+}
+
 bool FileUtils::openFiles(const QStringList &filePaths)
 {
     QStringList rePath = filePaths;
@@ -873,63 +980,22 @@ bool FileUtils::openFiles(const QStringList &filePaths)
     if (rePath.isEmpty())
         return ret;
 
-    const QString filePath = rePath.first();
+    // 按文件各自的默认打开方式分组，每个应用只启动一次
+    QHash<QString, QString> mimeTypes;
+    const QList<OpenFileGroup> &groups = groupFilesByDefaultApp(rePath, &mimeTypes);
 
-    /*********************************************************/
-    //解决空文本文件转其他非文本格式时打开仍然是文本方式打开的问题
-    //QString mimetype = getFileMimetype(filePath);
-    DAbstractFileInfoPointer info = DFileService::instance()->createFileInfo(nullptr, DUrl(FILE_ROOT + filePath));
-    QString mimetype;
-    if (info && info->size() == 0 && info->exists()) {
-        mimetype = info->mimeType().name();
-    } else {
-        mimetype = getFileMimetype(filePath);
-    }
-    /*********************************************************/
-    bool isOpenNow = false;
-    QString defaultDesktopFile = MimesAppsManager::getDefaultAppDesktopFileByMimeType(mimetype);
-    if (defaultDesktopFile.isEmpty()) {
-        if (isSmbUnmountedFile(DUrl::fromLocalFile(filePath))) {
-            mimetype = QString("inode/directory");
-            defaultDesktopFile = MimesAppsManager::getDefaultAppDesktopFileByMimeType(mimetype);
-            isOpenNow = true;
-            mimetype = QString();
-        } else {
-            qDebug() << "no default application for" << filePath;
-            return false;
-        }
-    }
-
-    if (!isOpenNow && isFileManagerSelf(defaultDesktopFile) && mimetype != "inode/directory") {
-        QStringList recommendApps = mimeAppsManager->getRecommendedApps(DUrl::fromLocalFile(filePath));
-        recommendApps.removeOne(defaultDesktopFile);
-        if (recommendApps.count() > 0) {
-            defaultDesktopFile = recommendApps.first();
-        } else {
-            qDebug() << "no default application for" << rePath;
-            return false;
-        }
-    }
+    //未找到默认打开应用，需要返回false，让上层逻辑走选择默认打开程序的流程
+    if (groups.isEmpty())
+        return false;
 
-    QStringList appAgrs;
-    for (const QString &tmp : rePath)
-        appAgrs << DUrl::fromLocalFile(tmp).toString();
-    bool result = launchApp(defaultDesktopFile, appAgrs);
+    bool result = launchFileGroups(groups, mimeTypes);
     if (result) {
-        // workaround since DTK apps doesn't support the recent file spec.
-        // spec: https://www.freedesktop.org/wiki/Specifications/desktop-bookmark-spec/
-        // the correct approach: let the app add it to the recent list.
-        // addToRecentFile(DUrl::fromLocalFile(filePath), mimetype);
-        for (const QString &tmp : rePath) {
-            QString file_path = DUrl::fromLocalFile(tmp).toLocalFile();
-            DesktopFile df(defaultDesktopFile);
-            addRecentFile(file_path, df, mimetype);
-        }
         return result;
     } else if (isSmbUnmountedFile(DUrl::fromLocalFile(rePath[0]))) {
         return false;
     }
 
+    const QString filePath = rePath.first();
     if (mimeAppsManager->getDefaultAppByFileName(filePath) == "org.gnome.font-viewer.desktop") {
         QProcess::startDetached("gio", QStringList() << "open" << rePath);
         QTimer::singleShot(200, [ = ] {
@@ -964,79 +1030,18 @@ bool FileUtils::openEnterFiles(const QStringList &filePaths)
     //fix bug 33136 在选中3过文件，mimetype有3种不同，但是用enter键打开，这里只处理了
     //第一个文件的mimetype，根据mimetype，选定desktop，传入了3个文件地址，所以后面两个
     //打开失败，处理所有的文件的mimetype，相同的就用同一个desktop启动
-    QHash<QString, QStringList> openinfo;
-    QHash<QString, QString> mimetypeinfo;
-    foreach (const QString &filePath, rePath) {
-        /*********************************************************/
-        //解决空文本文件转其他非文本格式时打开仍然是文本方式打开的问题
-        //QString mimetype = getFileMimetype(filePath);
-        DAbstractFileInfoPointer info = DFileService::instance()->createFileInfo(nullptr, DUrl(FILE_ROOT + filePath));
-        QString mimetype;
-        if (info && info->size() == 0 && info->exists()) {
-            mimetype = info->mimeType().name();
-        } else {
-            mimetype = getFileMimetype(filePath);
-        }
-        mimetypeinfo.insert(DUrl::fromLocalFile(filePath).toString(), mimetype);
-        /*********************************************************/
-        bool isOpenNow = false;
-        QString defaultDesktopFile = MimesAppsManager::getDefaultAppDesktopFileByMimeType(mimetype);
-        if (defaultDesktopFile.isEmpty()) {
-            if (isSmbUnmountedFile(DUrl::fromLocalFile(filePath))) {
-                mimetype = QString("inode/directory");
-                defaultDesktopFile = MimesAppsManager::getDefaultAppDesktopFileByMimeType(mimetype);
-                isOpenNow = true;
-                mimetype = QString();
-            } else {
-                qDebug() << "no default application for" << filePath;
-                continue;
-            }
-        }
-
-        if (!isOpenNow && isFileManagerSelf(defaultDesktopFile) && mimetype != "inode/directory") {
-            QStringList recommendApps = mimeAppsManager->getRecommendedApps(DUrl::fromLocalFile(filePath));
-            recommendApps.removeOne(defaultDesktopFile);
-            if (recommendApps.count() > 0) {
-                defaultDesktopFile = recommendApps.first();
-            } else {
-                qDebug() << "no default application for" << rePath;
-                continue;
-            }
-        }
-        if (!defaultDesktopFile.isEmpty()) {
-            QStringList value = openinfo.contains(defaultDesktopFile) ? openinfo.value(defaultDesktopFile) : QStringList();
-            value << DUrl::fromLocalFile(filePath).toString();
-            openinfo.insert(defaultDesktopFile, value);
-        }
-    }
+    QHash<QString, QString> mimeTypes;
+    const QList<OpenFileGroup> &groups = groupFilesByDefaultApp(rePath, &mimeTypes);
 
     //未找到默认打开应用，需要返回false，让上层逻辑走选择默认打开程序的流程
-    if (openinfo.isEmpty()) {
+    if (groups.isEmpty()) {
         return false;
     } else if (isSmbUnmountedFile(DUrl::fromLocalFile(rePath[0]))) {
         return false;
     }
 
-    QStringList appAgrs;
-    for (const QString &tmp : rePath)
-        appAgrs << DUrl::fromLocalFile(tmp).toString();
-    bool result = false;
-    foreach (const QString &defaultDesktopFile, openinfo.keys()) {
-        bool temresult = launchApp(defaultDesktopFile, openinfo.value(defaultDesktopFile));
-        if (temresult) {
-            // workaround since DTK apps doesn't support the recent file spec.
-            // spec: https://www.freedesktop.org/wiki/Specifications/desktop-bookmark-spec/
-            // the correct approach: let the app add it to the recent list.
-            // addToRecentFile(DUrl::fromLocalFile(filePath), mimetype);
-            for (const QString &tmp : openinfo.value(defaultDesktopFile)) {
-                QString filePath = DUrl::fromUserInput(tmp).toLocalFile();
-                DesktopFile df(defaultDesktopFile);
-                addRecentFile(filePath, df, mimetypeinfo.value(tmp));
-            }
-            result = true;
-        }
-    }
     //只要一次成功就返回
+    bool result = launchFileGroups(groups, mimeTypes);
     if (result) {
         return result;
     }
@@ -1084,6 +1089,27 @@ bool FileUtils::launchApp(const QString &desktopFile, const QStringList &filePat
         }
     }
 
+    // Exec 中没有 %F/%U 的应用每个文件会启动一个进程，超出一批的文件按间隔逐个启动，避免同时创建大量进程
+    if (newList.count() > LAUNCH_APP_BURST_COUNT) {
+        const QString &exec = DesktopFile(desktopFile).getExec();
+        if (!exec.contains("%F") && !exec.contains("%U")) {
+            bool ok = false;
+            for (int i = 0; i < newList.count(); ++i) {
+                const QStringList args {newList.at(i)};
+                if (i < LAUNCH_APP_BURST_COUNT) {
+                    ok = launchAppByDBus(desktopFile, args) || launchAppByGio(desktopFile, args) || ok;
+                    continue;
+                }
+
+                QTimer::singleShot((i - LAUNCH_APP_BURST_COUNT + 1) * LAUNCH_APP_INTERVAL, qApp, [desktopFile, args] {
+                    if (!launchAppByDBus(desktopFile, args))
+                        launchAppByGio(desktopFile, args);
+                });
+            }
+            return ok;
+        }
+    }
+
     bool ok = launchAppByDBus(desktopFile, newList);
     if (!ok) {
         ok = launchAppByGio(desktopFile, newList);
@@ -1919,20 +1945,20 @@ qint32 FileUtils::getCpuProcessCount()
     return cpuProcessCount;
 }
 /**
- * @brief jugment file is mount 通过gioqt获取所有的挂载点，对比当前的url是否在挂载点中，只判断了smb和ftp
+ * @brief jugment file is mount 通过挂载快照获取所有的挂载点，对比当前的url是否在挂载点中，只判断了smb和ftp
  * @param url file url
  */
 bool FileUtils::isNetworkUrlMounted(const DUrl &url)
 {
-    for (auto gvfsmp : DGioVolumeManager::getMounts()) {
-        auto rootFile = gvfsmp->getRootFile();
-        if (!rootFile || (!rootFile->uri().contains(SMB_SCHEME)
-                && !rootFile->uri().contains(FTP_SCHEME)))
+    // 使用 GvfsMountManager 的挂载快照，不在界面线程中调用 GIO
+    for (const QMount &mount : GvfsMountManager::getMounts()) {
+        if (mount.mounted_root_path().isEmpty() || (!mount.mounted_root_uri().contains(SMB_SCHEME)
+                && !mount.mounted_root_uri().contains(FTP_SCHEME)))
             continue;
 
         DUrl mountUrl;
         mountUrl.setScheme(DFMROOT_SCHEME);
-        mountUrl.setPath("/" + QUrl::toPercentEncoding(rootFile->path()) + "." SUFFIX_GVFSMP);
+        mountUrl.setPath("/" + QUrl::toPercentEncoding(mount.mounted_root_path()) + "." SUFFIX_GVFSMP);
         if (mountUrl == url)
             return true;
     }
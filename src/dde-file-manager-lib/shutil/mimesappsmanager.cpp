@@ -20,6 +20,9 @@
 #include <QDateTime>
 #include <QThread>
 #include <QStandardPaths>
+#include <QSaveFile>
+#include <QLocale>
+#include <QDataStream>
 #include <QDebug>
 
 #include <QJsonDocument>
@@ -52,6 +55,91 @@ QMap<QString, DesktopFile> MimesAppsManager::AudioMimeApps = {};
 
 QMap<QString, DesktopFile> MimesAppsManager::DesktopObjs = {};
 
+// 应用索引缓存的格式，格式变化时需增加版本号
+#define MIME_APPS_INDEX_MAGIC 0x444d4149
+#define MIME_APPS_INDEX_VERSION 1
+
+namespace {
+//! 应用索引中一个 desktop 文件的记录，文件的修改时间和大小不变时直接使用解析好的内容
+struct DesktopFileRecord
+{
+    qint64 lastModified = -1;
+    qint64 size = -1;
+    qint64 created = -1;
+    DesktopFile desktopFile;
+};
+
+QDataStream &operator<<(QDataStream &out, const DesktopFileRecord &record)
+{
+    return out << record.lastModified << record.size << record.created << record.desktopFile;
+}
+
+QDataStream &operator>>(QDataStream &in, DesktopFileRecord &record)
+{
+    return in >> record.lastModified >> record.size >> record.created >> record.desktopFile;
+}
+
+/*!
+ * \brief loadMimeAppsIndex 读取应用索引缓存
+ *
+ * 缓存文件以内存映射的方式读取，版本或系统语言（本地化的应用名称与语言有关）不一致时丢弃
+ */
+QHash<QString, DesktopFileRecord> loadMimeAppsIndex(const QString &indexFile)
+{
+    QHash<QString, DesktopFileRecord> records;
+    QFile file(indexFile);
+
+    if (!file.open(QIODevice::ReadOnly) || file.size() <= 0)
+        return records;
+
+    uchar *data = file.map(0, file.size());
+
+    if (!data)
+        return records;
+
+    const QByteArray &content = QByteArray::fromRawData(reinterpret_cast<const char *>(data), static_cast<int>(file.size()));
+    QDataStream in(content);
+    quint32 magic = 0;
+    qint32 version = 0;
+    QString locale;
+
+    in.setVersion(QDataStream::Qt_5_6);
+    in >> magic >> version >> locale;
+
+    if (magic == MIME_APPS_INDEX_MAGIC && version == MIME_APPS_INDEX_VERSION && locale == QLocale::system().name()) {
+        in >> records;
+
+        if (in.status() != QDataStream::Ok) {
+            qWarning() << "invalid mime apps index:" << indexFile;
+            records.clear();
+        }
+    }
+
+    file.unmap(data);
+
+    return records;
+}
+
+void saveMimeAppsIndex(const QString &indexFile, const QHash<QString, DesktopFileRecord> &records)
+{
+    QDir().mkpath(QFileInfo(indexFile).absolutePath());
+    QSaveFile file(indexFile);
+
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "failed to save mime apps index:" << file.errorString();
+        return;
+    }
+
+    QDataStream out(&file);
+
+    out.setVersion(QDataStream::Qt_5_6);
+    out << quint32(MIME_APPS_INDEX_MAGIC) << qint32(MIME_APPS_INDEX_VERSION) << QLocale::system().name() << records;
+
+    if (!file.commit())
+        qWarning() << "failed to save mime apps index:" << file.errorString();
+}
+}
+
 MimeAppsWorker::MimeAppsWorker(QObject *parent): QObject(parent)
 {
     m_fileSystemWatcher = new QFileSystemWatcher;
@@ -577,6 +665,11 @@ QString MimesAppsManager::getDesktopIconsCacheFile()
     return QString("%1/%2").arg(DFMStandardPaths::location(DFMStandardPaths::CachePath), "DesktopIcons.json");
 }
 
+QString MimesAppsManager::getMimeAppsIndexFile()
+{
+    return QString("%1/%2").arg(DFMStandardPaths::location(DFMStandardPaths::CachePath), "MimeApps.cache");
+}
+
 QStringList MimesAppsManager::getDesktopFiles()
 {
       QStringList desktopFiles;
@@ -615,7 +708,15 @@ void MimesAppsManager::initMimeTypeApps()
     DDE_MimeTypes.clear();
 
     QMap<QString, QSet<QString>> mimeAppsSet;
+    QHash<QString, qint64> createdTimes;
     loadDDEMimeTypes();
+
+    //! 只重新解析新增或修改过的 desktop 文件，其余的使用索引缓存中的内容
+    const QString &indexFile = getMimeAppsIndexFile();
+    const QHash<QString, DesktopFileRecord> &cachedRecords = loadMimeAppsIndex(indexFile);
+    QHash<QString, DesktopFileRecord> records;
+    int parsedCount = 0;
+
     foreach (QString desktopFolder, getApplicationsFolders()) {
         QDirIterator it(desktopFolder, QStringList("*.desktop"),
                         QDir::Files | QDir::NoDotAndDotDot,
@@ -623,45 +724,53 @@ void MimesAppsManager::initMimeTypeApps()
         while (it.hasNext()) {
           it.next();
           QString filePath = it.filePath();
-          DesktopFile desktopFile(filePath);
+          const QFileInfo &fileInfo = it.fileInfo();
+          DesktopFileRecord record = cachedRecords.value(filePath);
+
+          if (record.lastModified != fileInfo.lastModified().toMSecsSinceEpoch() || record.size != fileInfo.size()) {
+              record.lastModified = fileInfo.lastModified().toMSecsSinceEpoch();
+              record.size = fileInfo.size();
+              record.created = fileInfo.created().toMSecsSinceEpoch();
+              record.desktopFile = DesktopFile(filePath);
+              ++parsedCount;
+          }
+
+          records.insert(filePath, record);
+          createdTimes.insert(filePath, record.created);
+
+          const DesktopFile &desktopFile = record.desktopFile;
           DesktopFiles.append(filePath);
           DesktopObjs.insert(filePath, desktopFile);
           QStringList mimeTypes = desktopFile.getMimeType();
-          QString fileName = QFileInfo(filePath).fileName();
+          QString fileName = fileInfo.fileName();
           if (DDE_MimeTypes.contains(fileName)){
               mimeTypes.append(DDE_MimeTypes.value(fileName));
           }
 
           foreach (QString mimeType, mimeTypes) {
               if (!mimeType.isEmpty()){
-                  QSet<QString> apps;
-                  if (mimeAppsSet.contains(mimeType)){
-                      apps = mimeAppsSet.value(mimeType);
-                      apps.insert(filePath);
-                  }else{
-                      apps.insert(filePath);
-                  }
-                  mimeAppsSet.insert(mimeType, apps);
+                  mimeAppsSet[mimeType].insert(filePath);
               }
           }
         }
     }
 
+    // 有文件被解析或删除时更新索引缓存
+    if (parsedCount > 0 || records.size() != cachedRecords.size())
+        saveMimeAppsIndex(indexFile, records);
+
+    qDebug() << "desktop files:" << records.size() << "parsed:" << parsedCount;
+
     foreach (QString key, mimeAppsSet.keys()) {
         QSet<QString> apps = mimeAppsSet.value(key);
         QStringList orderApps;
         if (apps.count() > 1){
-            QFileInfoList fileInfos;
-            foreach (QString app, apps) {
-                QFileInfo info(app);
-                fileInfos.append(info);
-            }
+            orderApps = apps.toList();
 
-            std::sort(fileInfos.begin(), fileInfos.end(), MimesAppsManager::lessByDateTime);
-
-            foreach (QFileInfo info, fileInfos) {
-                orderApps.append(info.absoluteFilePath());
-            }
+            // 创建时间已记录在索引中，排序时不用再读取文件信息
+            std::sort(orderApps.begin(), orderApps.end(), [&createdTimes](const QString &f1, const QString &f2) {
+                return createdTimes.value(f1) < createdTimes.value(f2);
+            });
         }else{
             orderApps.append(apps.toList());
         }
@@ -712,7 +821,7 @@ void MimesAppsManager::initMimeTypeApps()
         const QString path = QString("%1/%2").arg(mimeInfoCacheRootPath,desktop);
         if(!QFile::exists(path))
             continue;
-        DesktopFile df(path);
+        const DesktopFile &df = DesktopObjs.contains(path) ? DesktopObjs.value(path) : DesktopFile(path);
         AudioMimeApps.insert(path, df);
     }
 
@@ -720,7 +829,7 @@ void MimesAppsManager::initMimeTypeApps()
         const QString path = QString("%1/%2").arg(mimeInfoCacheRootPath,desktop);
         if(!QFile::exists(path))
             continue;
-        DesktopFile df(path);
+        const DesktopFile &df = DesktopObjs.contains(path) ? DesktopObjs.value(path) : DesktopFile(path);
         ImageMimeApps.insert(path, df);
     }
 
@@ -728,7 +837,7 @@ void MimesAppsManager::initMimeTypeApps()
         const QString path = QString("%1/%2").arg(mimeInfoCacheRootPath,desktop);
         if(!QFile::exists(path))
             continue;
-        DesktopFile df(path);
+        const DesktopFile &df = DesktopObjs.contains(path) ? DesktopObjs.value(path) : DesktopFile(path);
         TextMimeApps.insert(path, df);
     }
 
@@ -736,7 +845,7 @@ void MimesAppsManager::initMimeTypeApps()
         const QString path = QString("%1/%2").arg(mimeInfoCacheRootPath,desktop);
         if(!QFile::exists(path))
             continue;
-        DesktopFile df(path);
+        const DesktopFile &df = DesktopObjs.contains(path) ? DesktopObjs.value(path) : DesktopFile(path);
         VideoMimeApps.insert(path, df);
     }
 
@@ -79,6 +79,17 @@ HEADERS += \
     $$PWD/interfaces/ddiriterator.h \
     $$PWD/interfaces/private/dstyleditemdelegate_p.h \
     $$PWD/interfaces/dfilesystemmodel.h \
+    $$PWD/interfaces/dfmdirsnapshotcache.h \
+    $$PWD/interfaces/dfmpathkey.h \
+    $$PWD/interfaces/dfmtrace.h \
+    $$PWD/interfaces/dfmmetrics.h \
+    $$PWD/interfaces/dfmstartupprofile.h \
+    $$PWD/interfaces/dfmmemoryaccounting.h \
+    $$PWD/interfaces/dfmarchiveindex.h \
+    $$PWD/interfaces/dfmtrashsummary.h \
+    $$PWD/interfaces/dfmnamefiltermatcher.h \
+    $$PWD/interfaces/dthumbnailindex.h \
+    $$PWD/interfaces/dfmlistingcache.h \
     $$PWD/app/define.h \
     $$PWD/interfaces/dabstractfilecontroller.h \
     $$PWD/interfaces/dabstractfileinfo.h \
@@ -91,6 +102,8 @@ HEADERS += \
     $$PWD/interfaces/private/dfileinfo_p.h \
     $$PWD/interfaces/dfilesystemwatcher.h \
     $$PWD/interfaces/private/dfilesystemwatcher_p.h \
+    $$PWD/interfaces/dfanotifywatcher.h \
+    $$PWD/interfaces/private/dfanotifywatcher_p.h \
     $$PWD/interfaces/dabstractfilewatcher.h \
     $$PWD/interfaces/dfilewatcher.h \
     $$PWD/interfaces/private/dabstractfilewatcher_p.h \
@@ -171,6 +184,8 @@ HEADERS += \
     $$PWD/controllers/dfmrecentcrumbcontroller.h \
     $$PWD/views/dfmadvancesearchbar.h \
     $$PWD/shutil/dfmregularexpression.h \
+    $$PWD/shutil/dfmembeddedpreview.h \
+    $$PWD/shutil/dfmimagedownscaler.h \
     $$PWD/controllers/mergeddesktopcontroller.h \
     $$PWD/models/mergeddesktopfileinfo.h \
     $$PWD/controllers/dfmmdcrumbcontrooler.h \
@@ -206,6 +221,7 @@ HEADERS += \
     $$PWD/plugins/dfmadditionalmenu.h \
     $$PWD/dialogs/connecttoserverdialog.h \
     $$PWD/shutil/dfmfilelistfile.h \
+    $$PWD/shutil/dfmdragurls.h \
     $$PWD/views/dfmsplitter.h \
     $$PWD/dbus/dbussysteminfo.h \
     $$PWD/models/deviceinfoparser.h \
@@ -331,6 +347,17 @@ SOURCES += \
     $$PWD/interfaces/durl.cpp \
     $$PWD/interfaces/dfilemenu.cpp \
     $$PWD/interfaces/dfilesystemmodel.cpp \
+    $$PWD/interfaces/dfmdirsnapshotcache.cpp \
+    $$PWD/interfaces/dfmpathkey.cpp \
+    $$PWD/interfaces/dfmtrace.cpp \
+    $$PWD/interfaces/dfmmetrics.cpp \
+    $$PWD/interfaces/dfmstartupprofile.cpp \
+    $$PWD/interfaces/dfmmemoryaccounting.cpp \
+    $$PWD/interfaces/dfmarchiveindex.cpp \
+    $$PWD/interfaces/dfmtrashsummary.cpp \
+    $$PWD/interfaces/dfmnamefiltermatcher.cpp \
+    $$PWD/interfaces/dthumbnailindex.cpp \
+    $$PWD/interfaces/dfmlistingcache.cpp \
     $$PWD/app/define.cpp \
     $$PWD/interfaces/dabstractfilecontroller.cpp \
     $$PWD/interfaces/dabstractfileinfo.cpp \
@@ -339,6 +366,7 @@ SOURCES += \
     $$PWD/interfaces/dfmevent.cpp \
     $$PWD/interfaces/dfileinfo.cpp \
     $$PWD/interfaces/dfilesystemwatcher.cpp \
+    $$PWD/interfaces/dfanotifywatcher.cpp \
     $$PWD/interfaces/dabstractfilewatcher.cpp \
     $$PWD/interfaces/dfilewatcher.cpp \
     $$PWD/interfaces/dfileproxywatcher.cpp \
@@ -419,6 +447,8 @@ SOURCES += \
     $$PWD/controllers/dfmrecentcrumbcontroller.cpp \
     $$PWD/views/dfmadvancesearchbar.cpp \
     $$PWD/shutil/dfmregularexpression.cpp \
+    $$PWD/shutil/dfmembeddedpreview.cpp \
+    $$PWD/shutil/dfmimagedownscaler.cpp \
     $$PWD/models/mergeddesktopfileinfo.cpp \
     $$PWD/controllers/dfmmdcrumbcontrooler.cpp \
     $$PWD/controllers/mergeddesktopcontroller.cpp \
@@ -452,6 +482,7 @@ SOURCES += \
     $$PWD/plugins/dfmadditionalmenu.cpp \
     $$PWD/dialogs/connecttoserverdialog.cpp \
     $$PWD/shutil/dfmfilelistfile.cpp \
+    $$PWD/shutil/dfmdragurls.cpp \
     $$PWD/views/dfmsplitter.cpp \
     $$PWD/dbus/dbussysteminfo.cpp \
     $$PWD/models/deviceinfoparser.cpp \
@@ -13,6 +13,9 @@
 #include "shutil/dsqlitehandle.h"
 #include "app/filesignalmanager.h"
 #include "controllers/appcontroller.h"
+#include "app/define.h"
+#include "deviceinfo/udisklistener.h"
+#include "interfaces/dfmapplication.h"
 #endif
 #include "controllers/tagmanagerdaemoncontroller.h"
 
@@ -25,6 +28,7 @@
 #include <QDebug>
 #include <QVariant>
 #include <QStorageInfo>
+#include <QTimer>
 
 TagManager::TagManager()
     : QObject{ nullptr }
@@ -44,8 +48,35 @@ TagManager::TagManager()
 }
 
 #ifndef DDE_ANYTHINGMONITOR
+//! 只更新已有扩展属性的文件，其余文件的标记仍以数据库为准
+static void updateTagsInXattr(const QList<DUrl> &files, const std::function<void(QStringList &)> &update)
+{
+    for (const DUrl &url : files) {
+        const QString &file = url.toLocalFile();
+        QStringList tags{};
+
+        if (!Tag::readTagsFromXattr(file, tags)) {
+            continue;
+        }
+
+        update(tags);
+        Tag::writeTagsToXattr(file, tags);
+    }
+}
+
 QMap<QString, QString> TagManager::getAllTags()
 {
+    if (ensureTagIndex()) {
+        QReadLocker locker{ &tagIndexLock };
+        QMap<QString, QString> string_dual{};
+
+        for (auto it = tagIndex.tagColors.cbegin(); it != tagIndex.tagColors.cend(); ++it) {
+            string_dual[it.key()] = it.value();
+        }
+
+        return string_dual;
+    }
+
     QMap<QString, QVariant> placeholder_container{ { QString{" "}, QVariant{ QList<QString>{ QString{" "} } } } };
     QVariant var{ TagManagerDaemonController::instance()->disposeClientData(placeholder_container, Tag::ActionType::GetAllTags) };
     placeholder_container = var.toMap();
@@ -66,6 +97,29 @@ QList<QString> TagManager::getTagsThroughFiles(const QList<DUrl> &files)
     QMap<QString, QVariant> string_var{};
 
     if (!files.isEmpty()) {
+        //! 与服务相同，返回路径最小的文件的标记
+        QString first_file{ files.first().toLocalFile() };
+
+        for (const DUrl &url : files) {
+            const QString &local_file = url.toLocalFile();
+
+            if (local_file < first_file) {
+                first_file = local_file;
+            }
+        }
+
+        if (isXattrStorageEnabled()) {
+            QStringList tags{};
+
+            if (Tag::readTagsFromXattr(first_file, tags) && !tags.isEmpty()) {
+                return tags;
+            }
+        }
+
+        if (ensureTagIndex()) {
+            QReadLocker locker{ &tagIndexLock };
+            return tagIndex.tagsOfFile(first_file);
+        }
 
         for (const DUrl &url : files) {
             string_var[url.toLocalFile()] = QVariant{ QList<QString>{} };
@@ -78,11 +132,83 @@ QList<QString> TagManager::getTagsThroughFiles(const QList<DUrl> &files)
     return QList<QString> {};
 }
 
+/*!
+ * \brief TagManager::getTagsOfEachFile 一次请求获取多个文件各自的标记
+ * \return 每个文件对应的标记，没有标记的文件对应空列表
+ */
+QMap<DUrl, QStringList> TagManager::getTagsOfEachFile(const QList<DUrl> &files)
+{
+    QMap<DUrl, QStringList> file_and_tags{ getTagsOfEachFileInDatabase(files) };
+
+    if (!files.isEmpty() && isXattrStorageEnabled()) {
+        mergeTagsFromXattr(files, file_and_tags);
+    }
+
+    return file_and_tags;
+}
+
+QMap<DUrl, QStringList> TagManager::getTagsOfEachFileInDatabase(const QList<DUrl> &files)
+{
+    QMap<DUrl, QStringList> file_and_tags{};
+
+    if (files.isEmpty())
+        return file_and_tags;
+
+    if (ensureTagIndex()) {
+        QReadLocker locker{ &tagIndexLock };
+
+        for (const DUrl &url : files) {
+            file_and_tags[url] = tagIndex.tagsOfFile(url.toLocalFile());
+        }
+
+        return file_and_tags;
+    }
+
+    QMap<QString, QVariant> string_var{};
+
+    for (const DUrl &url : files) {
+        string_var[url.toLocalFile()] = QVariant{ QList<QString>{} };
+    }
+
+    QVariant var{ TagManagerDaemonController::instance()->disposeClientData(string_var, Tag::ActionType::GetTagsOfEachFile) };
+
+    if (var.type() == QVariant::Map) {
+        const QVariantMap &var_map = var.toMap();
+
+        for (auto it = var_map.cbegin(); it != var_map.cend(); ++it) {
+            file_and_tags[DUrl::fromLocalFile(it.key())] = it.value().toStringList();
+        }
+
+        return file_and_tags;
+    }
+
+    // 旧版本的服务不支持批量查询，逐个获取
+    for (const DUrl &url : files) {
+        file_and_tags[url] = getTagsThroughFiles({url});
+    }
+
+    return file_and_tags;
+}
+
 QMap<QString, QColor> TagManager::getTagColor(const QList<QString> &tags) const
 {
     QMap<QString, QColor> tag_and_color{};
 
     if (!tags.isEmpty()) {
+        if (ensureTagIndex()) {
+            QReadLocker locker{ &tagIndexLock };
+
+            for (const QString &tag_name : tags) {
+                auto it = tagIndex.tagColors.constFind(tag_name);
+
+                if (it != tagIndex.tagColors.cend()) {
+                    tag_and_color[tag_name] = Tag::NamesWithColors[it.value()];
+                }
+            }
+
+            return tag_and_color;
+        }
+
         QMap<QString, QVariant> string_var{};
 
         for (const QString &tag_name : tags) {
@@ -131,6 +257,11 @@ QList<QString> TagManager::getFilesThroughTag(const QString &tagName)
     QList<QString> file_list{};
 
     if (!tagName.isEmpty()) {
+        if (ensureTagIndex()) {
+            QReadLocker locker{ &tagIndexLock };
+            return tagIndex.tagFiles.value(tagName).toList();
+        }
+
         QMap<QString, QVariant> string_var{ {tagName,  QVariant{QList<QString>{ QString{" "} }}} };
         QVariant var{ TagManagerDaemonController::instance()->disposeClientData(string_var, Tag::ActionType::GetFilesThroughTag) };
         file_list = var.toStringList();
@@ -192,30 +323,23 @@ QString TagManager::randomColor() const
 
 bool TagManager::makeFilesTags(const QList<QString> &tags, const QList<DUrl> &files)
 {
-    bool result{ true };
-
-    if (!tags.isEmpty() && !files.isEmpty()) {
-        QMap<QString, QVariant> tag_and_file{};
-
-        for (const QString &tag_name : tags) {
-            QString color_name;
+    bool result{ makeFilesTagsInDatabase(tags, files) };
 
-            // for default tags
-            for (const QString &color : Tag::ColorName) {
-                if (tag_name == Tag::ActualAndFakerName().value(color)) {
-                    color_name = color;
-                    break;
-                }
-            }
+    if (result && !tags.isEmpty() && isXattrStorageEnabled()) {
+        for (const DUrl &url : files) {
+            Tag::writeTagsToXattr(url.toLocalFile(), tags);
+        }
+    }
 
-            if (color_name.isEmpty()) {
-                color_name = tagColorMap.contains(tag_name) ? tagColorMap[tag_name] : randomColor();
-            }
+    return result;
+}
 
-            tag_and_file[tag_name] = QVariant{QList<QString>{ color_name }};
-        }
+bool TagManager::makeFilesTagsInDatabase(const QList<QString> &tags, const QList<DUrl> &files)
+{
+    bool result{ true };
 
-        QVariant insert_tags_var{ TagManagerDaemonController::instance()->disposeClientData(tag_and_file, Tag::ActionType::BeforeMakeFilesTags) };
+    if (!tags.isEmpty() && !files.isEmpty()) {
+        bool insert_tags{ insertTagsInDatabase(tags) };
         QMap<QString, QVariant> file_and_tag{};
 
         for (const DUrl &url : files) {
@@ -224,11 +348,11 @@ bool TagManager::makeFilesTags(const QList<QString> &tags, const QList<DUrl> &fi
 
         QVariant tag_files_var{};
 
-        if (insert_tags_var.toBool()) {
+        if (insert_tags) {
             tag_files_var = TagManagerDaemonController::instance()->disposeClientData(file_and_tag, Tag::ActionType::MakeFilesTags);
         }
 
-        if (insert_tags_var.toBool()) {
+        if (insert_tags) {
 
             if (!tag_files_var.toBool()) {
                 qWarning() << "Create tags successfully! But failed to tag files";
@@ -240,6 +364,86 @@ bool TagManager::makeFilesTags(const QList<QString> &tags, const QList<DUrl> &fi
     return result;
 }
 
+bool TagManager::insertTagsInDatabase(const QList<QString> &tags)
+{
+    QMap<QString, QVariant> tag_and_file{};
+
+    for (const QString &tag_name : tags) {
+        QString color_name;
+
+        // for default tags
+        for (const QString &color : Tag::ColorName) {
+            if (tag_name == Tag::ActualAndFakerName().value(color)) {
+                color_name = color;
+                break;
+            }
+        }
+
+        if (color_name.isEmpty()) {
+            color_name = tagColorMap.contains(tag_name) ? tagColorMap[tag_name] : randomColor();
+        }
+
+        tag_and_file[tag_name] = QVariant{QList<QString>{ color_name }};
+    }
+
+    QVariant insert_tags_var{ TagManagerDaemonController::instance()->disposeClientData(tag_and_file, Tag::ActionType::BeforeMakeFilesTags) };
+    return insert_tags_var.toBool();
+}
+
+/*!
+ * \brief TagManager::makeTagsOfEachFile 一次请求设置多个文件各自的标记
+ * \param filesAndTags 文件及其完整的标记，标记为空时清除文件的标记
+ *
+ * 服务在一个事务中写入同一分区的全部文件，旧版本的服务不支持时逐个文件设置
+ */
+bool TagManager::makeTagsOfEachFile(const QMap<DUrl, QStringList> &filesAndTags)
+{
+    if (filesAndTags.isEmpty()) {
+        return true;
+    }
+
+    QList<QString> all_tags{};
+    QMap<QString, QVariant> file_and_tags{};
+
+    for (auto it = filesAndTags.cbegin(); it != filesAndTags.cend(); ++it) {
+        for (const QString &tag : it.value()) {
+            if (!all_tags.contains(tag)) {
+                all_tags << tag;
+            }
+        }
+
+        file_and_tags[it.key().toLocalFile()] = QVariant{ it.value() };
+    }
+
+    if (!all_tags.isEmpty() && !insertTagsInDatabase(all_tags)) {
+        return false;
+    }
+
+    const QVariant &var = TagManagerDaemonController::instance()->disposeClientData(file_and_tags, Tag::ActionType::MakeTagsOfEachFile);
+    bool result{ var.toBool() };
+
+    if (!var.isValid()) {
+        result = true;
+
+        for (auto it = filesAndTags.cbegin(); it != filesAndTags.cend(); ++it) {
+            if (it.value().isEmpty()) {
+                const QStringList &tags = getTagsThroughFiles({ it.key() });
+                result = (tags.isEmpty() || removeTagsOfFiles(tags, { it.key() })) && result;
+            } else {
+                result = makeFilesTagsInDatabase(it.value(), { it.key() }) && result;
+            }
+        }
+    }
+
+    if (result && isXattrStorageEnabled()) {
+        for (auto it = filesAndTags.cbegin(); it != filesAndTags.cend(); ++it) {
+            Tag::writeTagsToXattr(it.key().toLocalFile(), it.value());
+        }
+    }
+
+    return result;
+}
+
 bool TagManager::changeTagColor(const QString &tagName, const QString &new_tag_color)
 {
     bool result{ true };
@@ -266,6 +470,14 @@ bool TagManager::removeTagsOfFiles(const QList<QString> &tags, const QList<DUrl>
 
         QVariant var{ TagManagerDaemonController::instance()->disposeClientData(file_and_tag, Tag::ActionType::RemoveTagsOfFiles) };
         result = var.toBool();
+
+        if (result && isXattrStorageEnabled()) {
+            updateTagsInXattr(files, [&tags](QStringList & file_tags) {
+                for (const QString &tag : tags) {
+                    file_tags.removeAll(tag);
+                }
+            });
+        }
     }
 
     return result;
@@ -277,13 +489,28 @@ bool TagManager::deleteTags(const QList<QString> &tags)
 
     if (!tags.isEmpty()) {
         QMap<QString, QVariant> tag_and_placeholder{};
+        QList<DUrl> tagged_files{};
 
         for (const QString &tag_name : tags) {
             tag_and_placeholder[tag_name] = QVariant{ QList<QString>{} };
+
+            if (isXattrStorageEnabled()) {
+                for (const QString &file : getFilesThroughTag(tag_name)) {
+                    tagged_files << DUrl::fromLocalFile(file);
+                }
+            }
         }
 
         QVariant var{ TagManagerDaemonController::instance()->disposeClientData(tag_and_placeholder, Tag::ActionType::DeleteTags) };
         result = var.toBool();
+
+        if (result && !tagged_files.isEmpty()) {
+            updateTagsInXattr(tagged_files, [&tags](QStringList & file_tags) {
+                for (const QString &tag : tags) {
+                    file_tags.removeAll(tag);
+                }
+            });
+        }
     }
 
     return result;
@@ -383,11 +610,20 @@ void TagManager::init_connect()noexcept
     });
 
     connect(TagManagerDaemonController::instance(), &TagManagerDaemonController::addNewTags, this, [ = ](const QVariant & new_tags) {
+        // 新标记的颜色不在信号中，重新加载
+        invalidateTagIndex();
 
         emit this->addNewTag(new_tags.toStringList());
     });
 
     connect(TagManagerDaemonController::instance(), &TagManagerDaemonController::deleteTags, this, [ = ](const QVariant & be_deleted_tags) {
+        updateTagIndex([&be_deleted_tags](TagIndex & index) {
+            for (const QString &tag : be_deleted_tags.toStringList()) {
+                index.removeTag(Tag::restore_escaped_en_skim(tag));
+            }
+
+            return true;
+        });
 
         emit this->deleteTag(be_deleted_tags.toStringList());
     });
@@ -402,6 +638,14 @@ void TagManager::init_connect()noexcept
             old_and_new[c_beg.key()] = c_beg.value().toString();
         }
 
+        updateTagIndex([&old_and_new](TagIndex & index) {
+            for (auto it = old_and_new.cbegin(); it != old_and_new.cend(); ++it) {
+                index.tagColors[Tag::restore_escaped_en_skim(it.key())] = it.value();
+            }
+
+            return true;
+        });
+
         emit this->changeTagColor(old_and_new);
     });
 
@@ -414,6 +658,14 @@ void TagManager::init_connect()noexcept
             old_and_new[c_beg.key()] = c_beg.value().toString();
         }
 
+        updateTagIndex([&old_and_new](TagIndex & index) {
+            for (auto it = old_and_new.cbegin(); it != old_and_new.cend(); ++it) {
+                index.renameTag(Tag::restore_escaped_en_skim(it.key()), Tag::restore_escaped_en_skim(it.value()));
+            }
+
+            return true;
+        });
+
         emit this->changeTagName(old_and_new);
     });
 
@@ -426,6 +678,33 @@ void TagManager::init_connect()noexcept
             file_and_tags[the_beg.key()] = the_beg.value().toStringList();
         }
 
+        updateTagIndex([&file_and_tags](TagIndex & index) {
+            for (auto it = file_and_tags.cbegin(); it != file_and_tags.cend(); ++it) {
+                const QString &file = Tag::restore_escaped_en_skim(it.key());
+
+                // 重命名等信号中的路径是相对于挂载点的，无法对应到索引中的文件
+                if (!file.startsWith('/')) {
+                    return false;
+                }
+
+                QList<QString> tags{};
+
+                for (const QString &tag_name : it.value()) {
+                    const QString &tag = Tag::restore_escaped_en_skim(tag_name);
+
+                    if (!index.tagIds.contains(tag)) {
+                        return false;
+                    }
+
+                    tags << tag;
+                }
+
+                index.addTags(file, tags);
+            }
+
+            return true;
+        });
+
         emit this->filesWereTagged(file_and_tags);
     });
 
@@ -438,19 +717,367 @@ void TagManager::init_connect()noexcept
             file_and_tags[the_beg.key()] = the_beg.value().toStringList();
         }
 
+        updateTagIndex([&file_and_tags](TagIndex & index) {
+            for (auto it = file_and_tags.cbegin(); it != file_and_tags.cend(); ++it) {
+                const QString &file = Tag::restore_escaped_en_skim(it.key());
+
+                // 重命名等信号中的路径是相对于挂载点的，无法对应到索引中的文件
+                if (!file.startsWith('/')) {
+                    return false;
+                }
+
+                QList<QString> tags{};
+
+                for (const QString &tag_name : it.value()) {
+                    const QString &tag = Tag::restore_escaped_en_skim(tag_name);
+
+                    tags << tag;
+                }
+
+                index.removeTags(file, tags);
+            }
+
+            return true;
+        });
+
         emit this->untagFiles(file_and_tags);
     });
 }
 
+    // 挂载点变化后数据库中的文件路径随之变化
+    connect(deviceListener, &UDiskListener::mountAdded, this, &TagManager::invalidateTagIndex);
+    connect(deviceListener, &UDiskListener::mountRemoved, this, &TagManager::invalidateTagIndex);
+}
+
+int TagManager::TagIndex::tagId(const QString &tag)
+{
+    auto it = tagIds.constFind(tag);
+
+    if (it != tagIds.cend()) {
+        return it.value();
+    }
+
+    int id = tagNames.size();
+    tagNames.append(tag);
+    tagIds.insert(tag, id);
+
+    return id;
+}
+
+QList<QString> TagManager::TagIndex::tagsOfFile(const QString &file) const
+{
+    QList<QString> tags{};
+    auto it = fileTags.constFind(file);
+
+    if (it == fileTags.cend()) {
+        return tags;
+    }
+
+    const QBitArray &bits = it.value();
+
+    for (int id = 0; id < bits.size(); ++id) {
+        if (bits.testBit(id)) {
+            tags << tagNames[id];
+        }
+    }
+
+    return tags;
+}
+
+void TagManager::TagIndex::addTags(const QString &file, const QList<QString> &tags)
+{
+    QBitArray &bits = fileTags[file];
+
+    for (const QString &tag : tags) {
+        int id = tagId(tag);
+
+        if (bits.size() <= id) {
+            bits.resize(id + 1);
+        }
+
+        bits.setBit(id);
+        tagFiles[tag].insert(file);
+    }
+}
+
+void TagManager::TagIndex::removeTags(const QString &file, const QList<QString> &tags)
+{
+    auto it = fileTags.find(file);
+
+    if (it == fileTags.end()) {
+        return;
+    }
+
+    for (const QString &tag : tags) {
+        auto id_it = tagIds.constFind(tag);
+
+        if (id_it == tagIds.cend()) {
+            continue;
+        }
+
+        if (id_it.value() < it.value().size()) {
+            it.value().clearBit(id_it.value());
+        }
+
+        tagFiles[tag].remove(file);
+    }
+
+    if (it.value().count(true) == 0) {
+        fileTags.erase(it);
+    }
+}
+
+void TagManager::TagIndex::removeTag(const QString &tag)
+{
+    auto id_it = tagIds.find(tag);
+
+    if (id_it == tagIds.end()) {
+        return;
+    }
+
+    int id = id_it.value();
+    tagIds.erase(id_it);
+    tagNames[id].clear();
+    tagColors.remove(tag);
+
+    for (const QString &file : tagFiles.take(tag)) {
+        auto it = fileTags.find(file);
+
+        if (it == fileTags.end()) {
+            continue;
+        }
+
+        if (id < it.value().size()) {
+            it.value().clearBit(id);
+        }
+
+        if (it.value().count(true) == 0) {
+            fileTags.erase(it);
+        }
+    }
+}
+
+void TagManager::TagIndex::renameTag(const QString &old_name, const QString &new_name)
+{
+    auto id_it = tagIds.find(old_name);
+
+    if (id_it == tagIds.end() || old_name == new_name) {
+        return;
+    }
+
+    int id = id_it.value();
+    tagIds.erase(id_it);
+    tagIds.insert(new_name, id);
+    tagNames[id] = new_name;
+
+    if (tagColors.contains(old_name)) {
+        tagColors[new_name] = tagColors.take(old_name);
+    }
+
+    if (tagFiles.contains(old_name)) {
+        tagFiles[new_name] = tagFiles.take(old_name);
+    }
+}
+
+/*!
+ * \brief TagManager::ensureTagIndex 需要时从服务加载全部标记
+ * \return 索引可用时返回 true，否则调用者仍向服务查询
+ */
+bool TagManager::ensureTagIndex() const
+{
+    {
+        QReadLocker locker{ &tagIndexLock };
+
+        if (tagIndexState != IndexState::Dirty) {
+            return tagIndexState == IndexState::Loaded;
+        }
+    }
+
+    QMutexLocker load_locker{ &tagIndexLoadMutex };
+    quint64 version{ 0 };
+
+    {
+        QReadLocker locker{ &tagIndexLock };
+
+        if (tagIndexState != IndexState::Dirty) {
+            return tagIndexState == IndexState::Loaded;
+        }
+
+        version = tagIndexVersion;
+    }
+
+    // 加载期间不持有写锁，以免阻塞信号的处理
+    TagIndex index{};
+    bool loaded = loadTagIndex(index);
+
+    QWriteLocker locker{ &tagIndexLock };
+
+    if (!loaded) {
+        tagIndexState = IndexState::Unavailable;
+        return false;
+    }
+
+    tagIndex = std::move(index);
+
+    // 加载期间索引已经变化，此次的结果可能遗漏了变化，下次查询时重新加载
+    tagIndexState = version == tagIndexVersion ? IndexState::Loaded : IndexState::Dirty;
+
+    return true;
+}
+
+bool TagManager::loadTagIndex(TagIndex &index) const
+{
+    QMap<QString, QVariant> placeholder_container{ { QString{" "}, QVariant{ QList<QString>{ QString{" "} } } } };
+    const QVariant &tags_var = TagManagerDaemonController::instance()->disposeClientData(placeholder_container, Tag::ActionType::GetAllTags);
+
+    // 服务不可用或回复的格式不符时不使用索引
+    if (tags_var.type() != QVariant::Map) {
+        return false;
+    }
+
+    const QVariantMap &tag_and_color = tags_var.toMap();
+
+    for (auto it = tag_and_color.cbegin(); it != tag_and_color.cend(); ++it) {
+        if (it.value().type() != QVariant::String) {
+            return false;
+        }
+
+        index.tagId(it.key());
+        index.tagColors[it.key()] = it.value().toString();
+    }
+
+    for (auto it = tag_and_color.cbegin(); it != tag_and_color.cend(); ++it) {
+        QMap<QString, QVariant> string_var{ {it.key(),  QVariant{QList<QString>{ QString{" "} }}} };
+        const QVariant &files_var = TagManagerDaemonController::instance()->disposeClientData(string_var, Tag::ActionType::GetFilesThroughTag);
+
+        if (!files_var.canConvert<QStringList>()) {
+            return false;
+        }
+
+        for (const QString &file : files_var.toStringList()) {
+            index.addTags(file, { it.key() });
+        }
+    }
+
+    return true;
+}
+
+void TagManager::invalidateTagIndex()
+{
+    QWriteLocker locker{ &tagIndexLock };
+
+    ++tagIndexVersion;
+    tagIndexState = IndexState::Dirty;
+    tagIndex = TagIndex{};
+}
+
+void TagManager::updateTagIndex(const std::function<bool(TagIndex &)> &update)
+{
+    QWriteLocker locker{ &tagIndexLock };
+
+    ++tagIndexVersion;
+
+    if (tagIndexState == IndexState::Loaded && update(tagIndex)) {
+        return;
+    }
+
+    tagIndexState = IndexState::Dirty;
+    tagIndex = TagIndex{};
+}
+
+bool TagManager::isXattrStorageEnabled()
+{
+    return DFMApplication::genericAttribute(DFMApplication::GA_TagStorageMode).toInt() == 1;
+}
+
+void TagManager::mergeTagsFromXattr(const QList<DUrl> &files, QMap<DUrl, QStringList> &fileAndTags)
+{
+    QMap<QString, QStringList> changed_files{};
+
+    for (const DUrl &url : files) {
+        QStringList tags{};
+
+        if (!Tag::readTagsFromXattr(url.toLocalFile(), tags) || tags.isEmpty()) {
+            continue;
+        }
+
+        QStringList &tags_in_database = fileAndTags[url];
+
+        if (tags.toSet() != tags_in_database.toSet()) {
+            tags_in_database = tags;
+            changed_files[url.toLocalFile()] = tags;
+        }
+    }
+
+    if (changed_files.isEmpty()) {
+        return;
+    }
+
+    QMutexLocker locker{ &xattrReindexMutex };
+    bool scheduled{ !pendingXattrReindex.isEmpty() };
+
+    for (auto it = changed_files.cbegin(); it != changed_files.cend(); ++it) {
+        pendingXattrReindex[it.key()] = it.value();
+    }
+
+    // 查询可能在绘制或其他线程中，写入数据库在 TagManager 的线程中进行
+    if (!scheduled) {
+        QTimer::singleShot(0, this, [this] {
+            reindexFilesFromXattr();
+        });
+    }
+}
+
+void TagManager::reindexFilesFromXattr()
+{
+    QMap<QString, QStringList> file_and_tags{};
+
+    {
+        QMutexLocker locker{ &xattrReindexMutex };
+        file_and_tags.swap(pendingXattrReindex);
+    }
+
+    // 标记相同的文件一次写入
+    QMap<QStringList, QList<DUrl>> tags_and_files{};
+
+    for (auto it = file_and_tags.cbegin(); it != file_and_tags.cend(); ++it) {
+        QStringList tags{ it.value() };
+        tags.sort();
+        tags_and_files[tags] << DUrl::fromLocalFile(it.key());
+    }
+
+    for (auto it = tags_and_files.cbegin(); it != tags_and_files.cend(); ++it) {
+        makeFilesTagsInDatabase(it.key(), it.value());
+    }
+}
+
 
 bool TagManager::changeTagName(const QPair<QString, QString> &oldAndNewName)
 {
     bool result{ true };
 
     if (!oldAndNewName.first.isEmpty() && !oldAndNewName.second.isEmpty()) {
+        QList<DUrl> tagged_files{};
+
+        if (isXattrStorageEnabled()) {
+            for (const QString &file : getFilesThroughTag(oldAndNewName.first)) {
+                tagged_files << DUrl::fromLocalFile(file);
+            }
+        }
+
         QMap<QString, QVariant> tag_name{ {oldAndNewName.first, QVariant{oldAndNewName.second}} };
         QVariant var{ TagManagerDaemonController::instance()->disposeClientData(tag_name, Tag::ActionType::ChangeTagName) };
         result = var.toBool();
+
+        if (result && !tagged_files.isEmpty()) {
+            updateTagsInXattr(tagged_files, [&oldAndNewName](QStringList & file_tags) {
+                for (QString &tag : file_tags) {
+                    if (tag == oldAndNewName.first) {
+                        tag = oldAndNewName.second;
+                    }
+                }
+            });
+        }
     }
 
     return result;
@@ -469,6 +1096,16 @@ bool TagManager::makeFilesTagThroughColor(const QString &color, const QList<DUrl
 
         QVariant var{ TagManagerDaemonController::instance()->disposeClientData(local_url_and_tag, Tag::ActionType::MakeFilesTagThroughColor) };
         result = var.toBool();
+
+        if (result && isXattrStorageEnabled()) {
+            const QString &tag_name = Tag::ColorsWithNames[color];
+
+            updateTagsInXattr(files, [&tag_name](QStringList & file_tags) {
+                if (!file_tags.contains(tag_name)) {
+                    file_tags << tag_name;
+                }
+            });
+        }
     }
 
     return result;
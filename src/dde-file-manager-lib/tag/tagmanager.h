@@ -19,8 +19,14 @@
 #include <interfaces/durl.h>
 
 #include <QMap>
+#include <QSet>
+#include <QHash>
 #include <QList>
+#include <QMutex>
 #include <QDebug>
+#include <QVector>
+#include <QBitArray>
+#include <QReadWriteLock>
 
 
 
@@ -89,6 +95,7 @@ public:
     QMap<QString, QString> getAllTags();
 
     QList<QString> getTagsThroughFiles(const QList<DUrl>& files);
+    QMap<DUrl, QStringList> getTagsOfEachFile(const QList<DUrl> &files);
 
     QMap<QString, QColor> getTagColor(const QList<QString>& tags) const;
     QString getTagColorName(const QString &tag) const;
@@ -106,6 +113,7 @@ public:
 
     ///###:modify
     bool makeFilesTags(const QList<QString>& tags, const QList<DUrl>& files);
+    bool makeTagsOfEachFile(const QMap<DUrl, QStringList> &filesAndTags);
 
     bool changeTagColor(const QString& tagName, const QString& new_tag_color);
 
@@ -143,8 +151,58 @@ signals:
 private:
     void init_connect()noexcept;
 
+    //! 标记的内存索引，由数据库中的全部标记建立，此后根据服务的信号更新，绘制时的查询只需查找哈希表
+    struct TagIndex
+    {
+        QVector<QString> tagNames;              // 下标为标记的 id，删除的标记留空
+        QHash<QString, int> tagIds;
+        QHash<QString, QString> tagColors;      // 标记对应的颜色名称
+        QHash<QString, QBitArray> fileTags;     // 文件对应的标记 id 位图
+        QHash<QString, QSet<QString>> tagFiles;
+
+        int tagId(const QString &tag);
+        QList<QString> tagsOfFile(const QString &file) const;
+        void addTags(const QString &file, const QList<QString> &tags);
+        void removeTags(const QString &file, const QList<QString> &tags);
+        void removeTag(const QString &tag);
+        void renameTag(const QString &old_name, const QString &new_name);
+    };
+
+    enum class IndexState {
+        Dirty,          // 需要重新加载
+        Loaded,
+        Unavailable     // 服务不可用或回复格式不符，查询仍请求服务
+    };
+
+    //! 返回 false 时不能使用索引
+    bool ensureTagIndex() const;
+    bool loadTagIndex(TagIndex &index) const;
+    void invalidateTagIndex();
+    //! update 返回 false 表示无法增量更新，索引将重新加载
+    void updateTagIndex(const std::function<bool(TagIndex &)> &update);
+
+    //! 标记同时保存在扩展属性中时，文件的标记以扩展属性为准，数据库作为按标记查询文件的索引
+    static bool isXattrStorageEnabled();
+    QMap<DUrl, QStringList> getTagsOfEachFileInDatabase(const QList<DUrl> &files);
+    bool makeFilesTagsInDatabase(const QList<QString> &tags, const QList<DUrl> &files);
+    //! 在数据库中创建还不存在的标记，新标记使用默认或随机的颜色
+    bool insertTagsInDatabase(const QList<QString> &tags);
+    //! 扩展属性与数据库不一致的文件（如在文件管理器之外移动的文件）稍后按扩展属性写入数据库
+    void mergeTagsFromXattr(const QList<DUrl> &files, QMap<DUrl, QStringList> &fileAndTags);
+    void reindexFilesFromXattr();
+
 private:
     QMap<QString, QString> tagColorMap;
+
+    mutable TagIndex tagIndex;
+    mutable IndexState tagIndexState{ IndexState::Dirty };
+    //! 每次变化递增，加载期间有变化时加载的结果只使用一次
+    quint64 tagIndexVersion{ 0 };
+    mutable QReadWriteLock tagIndexLock;
+    mutable QMutex tagIndexLoadMutex;
+
+    QMap<QString, QStringList> pendingXattrReindex;
+    QMutex xattrReindexMutex;
 #endif
 };
 
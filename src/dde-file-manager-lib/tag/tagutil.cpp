@@ -6,6 +6,11 @@
 
 
 #include <QDebug>
+#include <QFile>
+
+#include <sys/xattr.h>
+#include <errno.h>
+#include <string.h>
 
 namespace Tag
 {
@@ -144,5 +149,66 @@ QString restore_escaped_en_skim(const QString &source) noexcept
     return QString::fromLocal8Bit(local8bits_str);
 }
 
+
+const char *const TagsXattrName{ "user.deepin.tags" };
+
+bool readTagsFromXattr(const QString &file, QStringList &tags) noexcept
+{
+    const QByteArray &path = QFile::encodeName(file);
+    QByteArray value(256, Qt::Uninitialized);
+    ssize_t size = ::getxattr(path.constData(), TagsXattrName, value.data(), static_cast<size_t>(value.size()));
+
+    if (size < 0 && errno == ERANGE) {
+        size = ::getxattr(path.constData(), TagsXattrName, nullptr, 0);
+
+        if (size > 0) {
+            value.resize(static_cast<int>(size));
+            size = ::getxattr(path.constData(), TagsXattrName, value.data(), static_cast<size_t>(value.size()));
+        }
+    }
+
+    // ENODATA: 没有标记，ENOTSUP: 文件系统不支持
+    if (size < 0) {
+        return false;
+    }
+
+    value.resize(static_cast<int>(size));
+    tags.clear();
+
+    for (const QByteArray &tag : value.split('\0')) {
+        if (!tag.isEmpty()) {
+            tags << QString::fromUtf8(tag);
+        }
+    }
+
+    return true;
+}
+
+bool writeTagsToXattr(const QString &file, const QStringList &tags) noexcept
+{
+    const QByteArray &path = QFile::encodeName(file);
+
+    if (tags.isEmpty()) {
+        return ::removexattr(path.constData(), TagsXattrName) == 0 || errno == ENODATA;
+    }
+
+    QByteArray value{};
+
+    for (const QString &tag : tags) {
+        if (!value.isEmpty()) {
+            value.append('\0');
+        }
+
+        value.append(tag.toUtf8());
+    }
+
+    if (::setxattr(path.constData(), TagsXattrName, value.constData(), static_cast<size_t>(value.size()), 0) != 0) {
+        qDebug() << "failed to write the tags to the extended attribute of" << file << strerror(errno);
+        return false;
+    }
+
+    return true;
+}
+
 }
 
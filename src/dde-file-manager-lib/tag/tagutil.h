@@ -10,6 +10,7 @@
 #include <QColor>
 #include <QObject>
 #include <QString>
+#include <QStringList>
 
 #include <vector>
 
@@ -30,7 +31,9 @@ enum class ActionType : std::size_t {
     GetAllTags = 10,
     BeforeMakeFilesTags,
     GetTagsColor,
-    ChangeTagColor
+    ChangeTagColor,
+    GetTagsOfEachFile,
+    MakeTagsOfEachFile
 };
 
 extern const QMap<QString, QString> ColorsWithNames;
@@ -45,6 +48,17 @@ extern std::vector<QString> ColorName;
 extern QString escaping_en_skim(const QString &source) noexcept;
 extern QString restore_escaped_en_skim(const QString &source) noexcept;
 
+//! 标记保存在文件的扩展属性中，标记之间以 '\0' 分隔
+extern const char *const TagsXattrName;
+
+/*!
+ * \brief readTagsFromXattr 读取文件扩展属性中的标记
+ * \return 文件没有此扩展属性或文件系统不支持时返回 false
+ */
+extern bool readTagsFromXattr(const QString &file, QStringList &tags) noexcept;
+//! 标记为空时移除扩展属性
+extern bool writeTagsToXattr(const QString &file, const QStringList &tags) noexcept;
+
 
 
 }
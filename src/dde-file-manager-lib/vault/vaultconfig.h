@@ -11,6 +11,7 @@
 #define CONFIG_VAULT_VERSION                    "new"
 #define CONFIG_VAULT_VERSION_1050               "1050"
 #define CONFIG_KEY_ALGONAME                     "algoName"
+#define CONFIG_KEY_BLOCKSIZE                    "blockSize"
 #define CONFIG_KEY_ENCRYPTION_METHOD            "encryption_method"
 #define CONFIG_METHOD_VALUE_KEY                 "key_encryption"
 #define CONFIG_METHOD_VALUE_TRANSPARENT         "transparent_encryption"
@@ -76,9 +76,30 @@
 #include <DHorizontalLine>
 #include <QHostInfo>
 #include <QNetworkInterface>
+#include <QScrollBar>
+#include <QPointer>
+
+// 后台标签切换后检查内存预算的延时（毫秒）
+#define HIDDEN_VIEW_BUDGET_CHECK_DELAY 5000
+// 估算的每个视图本身（控件、文件监视器等）占用的内存（KB）
+#define HIDDEN_VIEW_BASE_COST 2048
+// 估算的每个文件节点（文件信息、模型节点、缩略图）占用的内存（KB）
+#define HIDDEN_VIEW_NODE_COST 8
 
 DWIDGET_USE_NAMESPACE
 
+namespace {
+struct HiddenTab
+{
+    QPointer<DFileManagerWindow> window;
+    QPointer<Tab> tab;
+};
+
+// 所有窗口中视图还在的后台标签，越靠前的越久没有被激活
+Q_GLOBAL_STATIC(QList<HiddenTab>, hiddenTabs)
+bool hiddenViewCheckScheduled = false;
+} // namespace
+
 std::unique_ptr<RecordRenameBarState>  DFileManagerWindow::renameBarState{ nullptr };
 std::atomic<bool> DFileManagerWindow::flagForNewWindowFromTab{ false };
 bool vaultMoveState = true;
@@ -456,6 +477,142 @@ bool DFileManagerWindowPrivate::cdForTab(Tab *tab, const DUrl &fileUrl)
     return ok;
 }
 
+void DFileManagerWindowPrivate::updateHiddenTabs()
+{
+    Q_Q(DFileManagerWindow);
+
+    Tab *current = tabBar->currentTab();
+
+    forgetHiddenTab(current);
+
+    for (int i = 0; i < tabBar->count(); ++i) {
+        Tab *tab = tabBar->tabAt(i);
+
+        if (tab == current || !tab->fileView())
+            continue;
+
+        bool found = false;
+
+        for (const HiddenTab &hidden : *hiddenTabs) {
+            if (hidden.tab == tab) {
+                found = true;
+                break;
+            }
+        }
+
+        if (!found)
+            hiddenTabs->append({q, tab});
+    }
+
+    if (!hiddenViewCheckScheduled) {
+        hiddenViewCheckScheduled = true;
+        QTimer::singleShot(HIDDEN_VIEW_BUDGET_CHECK_DELAY, qApp, &DFileManagerWindowPrivate::checkHiddenViewBudget);
+    }
+}
+
+void DFileManagerWindowPrivate::forgetHiddenTab(Tab *tab)
+{
+    for (auto it = hiddenTabs->begin(); it != hiddenTabs->end();) {
+        if (!it->tab || it->tab == tab)
+            it = hiddenTabs->erase(it);
+        else
+            ++it;
+    }
+}
+
+/*!
+ * \brief DFileManagerWindowPrivate::hibernateTab 释放后台标签的视图，只保留地址、选中项和滚动位置
+ */
+bool DFileManagerWindowPrivate::hibernateTab(Tab *tab)
+{
+    if (!tab || tab == tabBar->currentTab())
+        return false;
+
+    DFileView *fileView = dynamic_cast<DFileView *>(tab->fileView());
+
+    // 搜索和高级搜索的结果重建的代价较大，正在加载或有操作的视图也不释放
+    if (!fileView || fileView->viewState() != DFMBaseView::ViewIdle
+            || fileView->rootUrl().isSearchFile() || isAdvanceSearchView.contains(fileView)) {
+        return false;
+    }
+
+    qInfo() << "release the view of background tab:" << tab->currentUrl();
+
+    tab->hibernate(fileView->selectedUrls(), fileView->verticalScrollBar()->value());
+    viewStackLayout->removeWidget(fileView->widget());
+    fileView->setDestroyFlag(true);
+    fileView->deleteLater();
+    tab->setFileView(nullptr);
+
+    return true;
+}
+
+bool DFileManagerWindowPrivate::restoreTab(Tab *tab)
+{
+    if (!tab->isHibernated())
+        return false;
+
+    const DUrlList selectedUrls = tab->hibernatedSelection();
+    const int scrollValue = tab->hibernatedScrollValue();
+
+    // 目录在后台时可能已被删除或卸载
+    if (!cdForTab(tab, tab->currentUrl()))
+        return cdForTab(tab, DUrl::fromLocalFile(QDir::homePath()));
+
+    if (DFileView *fileView = dynamic_cast<DFileView *>(tab->fileView()))
+        fileView->restoreViewState(selectedUrls, scrollValue);
+
+    return true;
+}
+
+qint64 DFileManagerWindowPrivate::estimatedViewCost(DFMBaseView *view)
+{
+    DFileView *fileView = dynamic_cast<DFileView *>(view);
+
+    if (!fileView)
+        return 0;
+
+    return HIDDEN_VIEW_BASE_COST + static_cast<qint64>(fileView->model()->rowCount(fileView->rootIndex())) * HIDDEN_VIEW_NODE_COST;
+}
+
+/*!
+ * \brief DFileManagerWindowPrivate::checkHiddenViewBudget 后台视图估算占用的内存超出预算时，从最久未激活的开始释放
+ *
+ * 预算来自 GA_HiddenViewMemoryBudget（MB），小于 0 时不释放。
+ */
+void DFileManagerWindowPrivate::checkHiddenViewBudget()
+{
+    hiddenViewCheckScheduled = false;
+
+    const int budget = DFMApplication::genericAttribute(DFMApplication::GA_HiddenViewMemoryBudget).toInt();
+
+    if (budget < 0)
+        return;
+
+    qint64 total = 0;
+
+    for (auto it = hiddenTabs->begin(); it != hiddenTabs->end();) {
+        if (!it->window || !it->tab || !it->tab->fileView()) {
+            it = hiddenTabs->erase(it);
+            continue;
+        }
+
+        total += estimatedViewCost(it->tab->fileView());
+        ++it;
+    }
+
+    for (auto it = hiddenTabs->begin(); it != hiddenTabs->end() && total > budget * 1024LL;) {
+        const qint64 cost = estimatedViewCost(it->tab->fileView());
+
+        if (it->window->d_func()->hibernateTab(it->tab)) {
+            total -= cost;
+            it = hiddenTabs->erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
 void DFileManagerWindowPrivate::initAdvanceSearchBar()
 {
     if (advanceSearchBar) return;
@@ -689,19 +846,23 @@ void DFileManagerWindow::onRequestCloseTab(const int index, const bool &remainSt
 
     DFMBaseView *view = tab->fileView();
 
+    d->forgetHiddenTab(tab);
     d->isAdvanceSearchView.removeAll(view);
     if (d->advanceSearchBar && d->isAdvanceSearchBarVisible()) {
         d->advanceSearchBar->resetForm(true);
     }
 
-    d->viewStackLayout->removeWidget(view->widget());
-    view->deleteLater();
+    // 后台标签的视图可能已被释放
+    if (view) {
+        d->viewStackLayout->removeWidget(view->widget());
+        view->deleteLater();
 
-    // delete 之后某些逻辑任然被误触发, 设置标志让 view 自己能判断这种情况
-    // 若 QObject 更直接的方式判断, 可以直接修改
-    DFileView *dfileview = dynamic_cast<DFileView *>(view);
-    if (dfileview) {
-        dfileview->setDestroyFlag(true);
+        // delete 之后某些逻辑任然被误触发, 设置标志让 view 自己能判断这种情况
+        // 若 QObject 更直接的方式判断, 可以直接修改
+        DFileView *dfileview = dynamic_cast<DFileView *>(view);
+        if (dfileview) {
+            dfileview->setDestroyFlag(true);
+        }
     }
 
     d->toolbar->removeNavStackAt(index);
@@ -833,6 +994,10 @@ void DFileManagerWindow::onCurrentTabChanged(int tabIndex)
 
     if (tab) {
         d->toolbar->switchHistoryStack(tabIndex);
+        d->updateHiddenTabs();
+
+        // 视图在后台时被释放了，按保存的状态重新创建
+        const bool restored = !tab->fileView() && d->restoreTab(tab);
 
         if (!tab->fileView()) {
             return;
@@ -840,7 +1005,8 @@ void DFileManagerWindow::onCurrentTabChanged(int tabIndex)
 
         switchToView(tab->fileView());
         // bug 32988 进入标签先刷新一次，解决保险箱重命名文件夹，在标签目录下出现重复文件夹
-        tab->fileView()->refresh();
+        if (!restored)
+            tab->fileView()->refresh();
 
 //        if (currentUrl().isSearchFile()) {
 //            if (!d->toolbar->getSearchBar()->isVisible()) {
@@ -1607,7 +1773,8 @@ void DFileManagerWindow::onRequestRedirectUrl(const DUrl &tabRootUrl, const DUrl
     if (tabCount > 1) {
         for (int i = 0; i < tabCount; i++) {
             Tab *tab = d->tabBar->tabAt(i);
-            if (tabRootUrl == tab->fileView()->rootUrl()) {
+            const DUrl &tabUrl = tab->fileView() ? tab->fileView()->rootUrl() : tab->currentUrl();
+            if (tabRootUrl == tabUrl) {
                 onRequestCloseTab(i, false);
                 openNewTab(newUrl);
                 d->tabBar->setCurrentIndex(curIndex);
@@ -1629,8 +1796,9 @@ void DFileManagerWindow::onRequestCloseTabByUrl(const DUrl &rootUrl)
     int originIndex = tabBar->currentIndex();
     for (int i = tabBar->count() - 1; i >= 0 && tabBar->count() > 1; i--) {
         Tab *tab = tabBar->tabAt(i);
-        if (tab->fileView()) {
-            DUrl tabUrl = tab->fileView()->rootUrl();
+        // 视图已被释放的后台标签使用其保存的地址
+        DUrl tabUrl = tab->fileView() ? tab->fileView()->rootUrl() : tab->currentUrl();
+        if (tab->fileView() || tab->isHibernated()) {
             if (FileUtils::isAncestorUrl(rootUrl, tabUrl)) {
                 onRequestCloseTab(i, false);
             }
@@ -55,6 +55,14 @@ public:
      */
     DFileManagerWindowPrivate::vaultRemove moveVaultPath();
 
+    //! 后台标签的视图生命周期：超出内存预算时释放最久未激活的后台视图，重新激活时按保存的状态恢复
+    void updateHiddenTabs();
+    void forgetHiddenTab(Tab *tab);
+    bool hibernateTab(Tab *tab);
+    bool restoreTab(Tab *tab);
+    static qint64 estimatedViewCost(DFMBaseView *view);
+    static void checkHiddenViewBudget();
+
     QFrame *centralWidget{ nullptr };//中央区域（所有的除顶部区域）
     DFMSideBar *sideBar{ nullptr };
     QFrame *rightView { nullptr };
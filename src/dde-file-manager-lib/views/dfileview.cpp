@@ -23,6 +23,7 @@
 #include "dfmopticalmediawidget.h"
 #include "io/dstorageinfo.h"
 #include "app/define.h"
+#include "interfaces/dfmstartupprofile.h"
 #include "app/filesignalmanager.h"
 
 #include "interfaces/dfmglobal.h"
@@ -42,6 +43,7 @@
 
 #include "shutil/fileutils.h"
 #include "shutil/mimesappsmanager.h"
+#include "shutil/dfmdragurls.h"
 #include "fileoperations/filejob.h"
 #include "deviceinfo/udisklistener.h"
 
@@ -86,6 +88,8 @@ DWIDGET_USE_NAMESPACE
 #define ICON_Y_OFFSET 10
 #define ICON_WIDTH_OFFSET -20
 #define ICON_HEIGHT_OFFSET -20
+// 框选时项的边缘需要进入框选区域的距离
+#define ICON_SELECTION_MARGIN (ICON_X_OFFSET + 3)
 
 #define DRAGICON_SIZE 96   // 拖拽聚合默认icon边长(size来自ui需求)
 #define DRAGICON_OUTLINE 30   //增加外圈范围，防止旋转后部分图片的角绘制不到
@@ -283,9 +287,12 @@ DFMBaseView::ViewState DFileView::viewState() const
 QList<DUrl> DFileView::selectedUrls() const
 {
     QModelIndex rootIndex = this->rootIndex();
+    const QModelIndexList &indexes = selectedIndexes();
     DUrlList list;
 
-    for (const QModelIndex &index : selectedIndexes()) {
+    list.reserve(indexes.size());
+
+    for (const QModelIndex &index : indexes) {
         if (index.parent() != rootIndex)
             continue;
 
@@ -712,6 +719,20 @@ void DFileView::select(const QList<DUrl> &list)
         scrollTo(firstIndex, PositionAtTop);
 }
 
+void DFileView::restoreViewState(const DUrlList &selectedUrls, int scrollValue)
+{
+    D_D(DFileView);
+
+    if (model()->state() == DFileSystemModel::Idle) {
+        select(selectedUrls);
+        verticalScrollBar()->setValue(scrollValue);
+        return;
+    }
+
+    d->preSelectionUrls << selectedUrls;
+    d->preScrollValue = scrollValue;
+}
+
 void DFileView::selectAllAfterCutOrCopy(const QList<DUrl> &list)
 {
     QModelIndex firstIndex;
@@ -1410,6 +1431,8 @@ void DFileView::updateModelActiveIndex()
     const RandeIndex &rande = randeList.first();
     DAbstractFileWatcher *fileWatcher = model()->fileWatcher();
 
+    model()->requestAttributes(rande.first, rande.second);
+
     for (int i = d->visibleIndexRande.first; i < rande.first; ++i) {
         const DAbstractFileInfoPointer &fileInfo = model()->fileInfo(model()->index(i, 0));
 
@@ -1438,7 +1461,8 @@ void DFileView::updateModelActiveIndex()
         if (fileInfo) {
             fileInfo->makeToActive();
 
-            if (!fileInfo->exists() && fileInfo->filePath().isEmpty()) {
+            // 先判断路径，避免在低速目录中为每个可见文件访问一次文件系统
+            if (fileInfo->filePath().isEmpty() && !fileInfo->exists()) {
                 m_isRemovingCase = true;
                 model()->removeRow(i, rootIndex());
             } else if (fileWatcher) {
@@ -2166,30 +2190,10 @@ void DFileView::setSelection(const QRect &rect, QItemSelectionModel::SelectionFl
             QItemSelection oldSelection = d->currentSelection;
 
             if (isIconViewMode()) {   //图标模式
-                DFileSystemModel *pModel = model();
-                if (pModel) {
-                    // ListView中的文件摆放逻辑是一列多行，所以行的数量就是文件的数量
-                    int nRowNum = pModel->rowCount();
-
-                    QPoint offset(-horizontalOffset() + ICON_X_OFFSET, ICON_Y_OFFSET);
+                if (model()) {
                     // 判断文件是否在鼠标框选区域内(注意：rect只是view的框选位置，并不是画布的框选位置，所以加上滚动偏移)
-                    QRect actualRect(MIN(rect.left(), rect.right()), MIN(rect.top(), rect.bottom()) + verticalOffset(), abs(rect.width()), abs(rect.height()));
-                    // 用来存放鼠标框选中的文件项
-                    QVector<QModelIndex> selectItems;
-                    for (int i = 0; i < nRowNum; ++i) {
-                        const QModelIndex &index = pModel->index(i, 0);
-                        const QRect &itemRect = rectForIndex(index);
-                        QRect realItemRect((itemRect.topLeft() + offset), itemRect.bottomRight() + offset + QPoint(ICON_HEIGHT_OFFSET, ICON_WIDTH_OFFSET));
-                        if (!(actualRect.left() > realItemRect.right() - 3
-                              || actualRect.top() > realItemRect.bottom() - 3
-                              || realItemRect.left() + 3 > actualRect.right()
-                              || realItemRect.top() + 3 > actualRect.bottom())) {
-                            if (!oldSelection.contains(index)) {
-                                QItemSelectionRange selectionRange(index);
-                                oldSelection.push_back(selectionRange);
-                            }
-                        }
-                    }
+                    QRect actualRect(MIN(rect.left(), rect.right()) + horizontalOffset(), MIN(rect.top(), rect.bottom()) + verticalOffset(), abs(rect.width()), abs(rect.height()));
+                    oldSelection.merge(d->iconModeSelection(actualRect), QItemSelectionModel::Select);
                     selectionModel()->select(oldSelection, QItemSelectionModel::ClearAndSelect);
                     return;
                 }
@@ -2239,34 +2243,11 @@ void DFileView::setSelection(const QRect &rect, QItemSelectionModel::SelectionFl
         // sp4-task:文管框选内容不正确问题
         // 判断是否是图标模式
         if (isIconViewMode()) {
-            DFileSystemModel *pModel = model();
-            if (pModel) {
-                // ListView中的文件摆放逻辑是一列多行，所以行的数量就是文件的数量
-                int nRowNum = pModel->rowCount();
-
-                QPoint offset(-horizontalOffset() + ICON_X_OFFSET, ICON_Y_OFFSET);
+            if (model()) {
                 // 判断文件是否在鼠标框选区域内(注意：rect只是view的框选位置，并不是画布的框选位置，所以加上滚动偏移)
-                QRect actualRect(MIN(rect.left(), rect.right()), MIN(rect.top(), rect.bottom()) + verticalOffset(), abs(rect.width()), abs(rect.height()));
-                // 用来存放鼠标框选中的文件项
-                QVector<QModelIndex> selectItems;
-                for (int i = 0; i < nRowNum; ++i) {
-                    const QModelIndex &index = pModel->index(i, 0);
-                    const QRect &itemRect = rectForIndex(index);
-                    QRect realItemRect((itemRect.topLeft() + offset), itemRect.bottomRight() + offset + QPoint(ICON_HEIGHT_OFFSET, ICON_WIDTH_OFFSET));
-                    if (!(actualRect.left() > realItemRect.right() - 3
-                          || actualRect.top() > realItemRect.bottom() - 3
-                          || realItemRect.left() + 3 > actualRect.right()
-                          || realItemRect.top() + 3 > actualRect.bottom()))
-                        selectItems.push_back(index);
-                }
-                // 取消上一次选中项的选中状态
-                clearSelection();
-                // 将当前选中项设置成选中状态
-                QVector<QModelIndex>::const_iterator itr = selectItems.begin();
-                for (; itr != selectItems.end(); ++itr) {
-                    // 将文件设置选中状态
-                    selectionModel()->select(*itr, QItemSelectionModel::Select);
-                }
+                QRect actualRect(MIN(rect.left(), rect.right()) + horizontalOffset(), MIN(rect.top(), rect.bottom()) + verticalOffset(), abs(rect.width()), abs(rect.height()));
+                // 取消上一次选中项的选中状态，并一次选中框选区域覆盖的所有项
+                selectionModel()->select(d->iconModeSelection(actualRect), QItemSelectionModel::ClearAndSelect);
             }
             return;
         }
@@ -2356,6 +2337,20 @@ QModelIndex DFileView::moveCursor(QAbstractItemView::CursorAction cursorAction,
 
         break;
 
+    case MoveUp:
+    case MoveDown:
+        // 图标模式下的项按固定的网格排列，上下移动一行就是移动一行的列数
+        if (isIconViewMode()) {
+            const int columnCount = d->iconModeColumnCount();
+            const int row = current.row() + (cursorAction == MoveUp ? -columnCount : columnCount);
+
+            index = (row >= 0 && row < count()) ? current.sibling(row, current.column()) : current;
+        } else {
+            index = DListView::moveCursor(cursorAction, modifiers);
+        }
+
+        break;
+
     default:
         index = DListView::moveCursor(cursorAction, modifiers);
         break;
@@ -2481,6 +2476,14 @@ bool DFileView::event(QEvent *e)
     case QEvent::FontChange:
         // blumia: to trigger DIconItemDelegate::updateItemSizeHint() to update its `d->itemSizeHint` ...
         emit iconSizeChanged(iconSize());
+        break;
+    case QEvent::LanguageChange:
+    case QEvent::LocaleChange:
+        if (DFileSystemModel *fileModel = model()) {
+            fileModel->clearDisplayCache();
+            viewport()->update();
+        }
+        break;
     default:
         break;
     }
@@ -2537,6 +2540,13 @@ bool DFileView::eventFilter(QObject *obj, QEvent *event)
 void DFileView::paintEvent(QPaintEvent *e)
 {
     DListView::paintEvent(e);
+
+    // 启动后第一次绘制出文件列表时结束启动计时
+    if (!DFMStartupProfile::isFinished() && DFMStartupProfile::contains("firstListingBatch")) {
+        DFMStartupProfile::mark("firstPaint");
+        DFMStartupProfile::finish();
+    }
+
     if (bShowViewSelectBox) {
         QPainter painter(viewport());
         QColor color = palette().color(QPalette::ColorGroup::Active, QPalette::ColorRole::Highlight);
@@ -3744,6 +3754,11 @@ void DFileView::onModelStateChanged(int state)
 
         d->preSelectionUrls.clear();
 
+        if (d->preScrollValue >= 0) {
+            verticalScrollBar()->setValue(d->preScrollValue);
+            d->preScrollValue = -1;
+        }
+
         delayUpdateStatusBar();
         updateContentLabel();
 
@@ -3867,29 +3882,10 @@ void DFileView::refresh()
 
 bool DFileView::fetchDragEventUrlsFromSharedMemory()
 {
-    QSharedMemory sm;
-    sm.setKey(DRAG_EVENT_URLS);
-
-    if (!sm.isAttached()) {
-        if (!sm.attach()) {
-            qDebug() << "FQSharedMemory detach failed.";
-            return false;
-        }
-    }
-
-    QBuffer buffer;
-    QDataStream in(&buffer);
-    QList<QUrl> urls;
-
-    sm.lock();
-    //用缓冲区得到共享内存关联后得到的数据和数据大小
-    buffer.setData(static_cast<char *>(const_cast<void *>(sm.constData())), sm.size());
-    buffer.open(QBuffer::ReadOnly);   //设置读取模式
-    in >> m_urlsForDragEvent;   //使用数据流从缓冲区获得共享内存的数据，然后输出到字符串中
-    qInfo() << "drop file urls = " << m_urlsForDragEvent << "to current url = " << rootUrl();
-    sm.unlock();   //解锁
-    sm.detach();   //与共享内存空间分离
+    if (!DFMDragUrls::read(DRAG_EVENT_URLS, m_urlsForDragEvent))
+        return false;
 
+    qInfo() << "drop file count = " << m_urlsForDragEvent.size() << "to current url = " << rootUrl();
     return true;
 }
 
@@ -3958,6 +3954,76 @@ int DFileViewPrivate::iconModeColumnCount(int itemWidth) const
     return qMax((contentWidth - horizontalMargin - 1) / itemWidth, 1);
 }
 
+/*!
+ * \brief DFileViewPrivate::iconModeSelection 图标模式下与框选区域相交的项
+ *
+ * 图标模式下的项按固定的网格排列，位置与 visualRect 一致，由框选区域直接计算出覆盖的行和列，
+ * 只遍历被覆盖的行，不需要获取每个项的位置。
+ * \param rect 内容坐标中的框选区域
+ */
+QItemSelection DFileViewPrivate::iconModeSelection(const QRect &rect) const
+{
+    Q_Q(const DFileView);
+
+    QItemSelection selection;
+    const int count = q->count();
+    const QSize &itemSize = q->itemSizeHint();
+    const int itemWidth = itemSize.width() + ICON_VIEW_SPACING * 2;
+    const int itemHeight = itemSize.height() + ICON_VIEW_SPACING * 2;
+    const int columnCount = iconModeColumnCount(itemWidth);
+
+    if (count <= 0 || rect.isEmpty() || itemSize.width() <= 0 || itemSize.height() <= 0)
+        return selection;
+
+    // 向下取整的除法，被除数可能为负数
+    auto floorDiv = [](int value, int step) {
+        return value >= 0 ? value / step : -((-value + step - 1) / step);
+    };
+    // 网格中第 n 个格子的项在 [n * step + first, n * step + last] 范围内，求与 [begin, end] 相交的格子
+    auto cellRange = [floorDiv](int begin, int end, int step, int first, int last, int *from, int *to) {
+        *from = -floorDiv(last - begin, step);
+        *to = floorDiv(end - first, step);
+    };
+
+    const int itemLeft = ICON_VIEW_SPACING + ICON_SELECTION_MARGIN;
+    const int itemRight = ICON_VIEW_SPACING + itemSize.width() - 1 - ICON_SELECTION_MARGIN;
+    const int itemTop = ICON_VIEW_SPACING + ICON_SELECTION_MARGIN;
+    const int itemBottom = ICON_VIEW_SPACING + itemSize.height() - 1 - ICON_SELECTION_MARGIN;
+    int beginColumn, endColumn, beginRow, endRow;
+
+    cellRange(rect.left(), rect.right(), itemWidth, itemLeft, itemRight, &beginColumn, &endColumn);
+    cellRange(rect.top(), rect.bottom(), itemHeight, itemTop, itemBottom, &beginRow, &endRow);
+
+    beginColumn = qMax(beginColumn, 0);
+    endColumn = qMin(endColumn, columnCount - 1);
+    beginRow = qMax(beginRow, 0);
+    endRow = qMin(endRow, (count - 1) / columnCount);
+
+    if (beginColumn > endColumn || beginRow > endRow)
+        return selection;
+
+    const QModelIndex &rootIndex = q->rootIndex();
+
+    // 覆盖整行时相邻的行是连续的，合并为一个区间
+    if (endColumn - beginColumn + 1 == columnCount) {
+        selection.append(QItemSelectionRange(rootIndex.child(beginRow * columnCount, 0),
+                                             rootIndex.child(qMin((endRow + 1) * columnCount, count) - 1, 0)));
+        return selection;
+    }
+
+    for (int row = beginRow; row <= endRow; ++row) {
+        const int first = row * columnCount + beginColumn;
+        const int last = qMin(row * columnCount + endColumn, count - 1);
+
+        if (first > last)
+            break;
+
+        selection.append(QItemSelectionRange(rootIndex.child(first, 0), rootIndex.child(last, 0)));
+    }
+
+    return selection;
+}
+
 QVariant DFileViewPrivate::fileViewStateValue(const DUrl &url, const QString &key, const QVariant &defalutValue)
 {
     return DFMApplication::appObtuselySetting()->value("FileViewState", url).toMap().value(key, defalutValue);
@@ -4118,13 +4184,14 @@ QPixmap DFileViewPrivate::renderToPixmap(const QModelIndexList &indexes) const
             scale = windowHandle->devicePixelRatio();
     }
 
-    //将当前按住的index剔除
-    QModelIndexList indexesWithoutPressed = indexes;
-    auto needRemove = [=](const QModelIndex &index) {
-        return index.row() == m_currentPressedIndex.row();
-    };
-    indexesWithoutPressed.erase(std::remove_if(indexesWithoutPressed.begin(), indexesWithoutPressed.end(), needRemove),
-                                indexesWithoutPressed.end());
+    //将当前按住的index剔除，只取需要绘制的 DRAGICON_MAX 个
+    QModelIndexList indexesWithoutPressed;
+    for (const QModelIndex &index : indexes) {
+        if (indexesWithoutPressed.length() >= DRAGICON_MAX)
+            break;
+        if (index.row() != m_currentPressedIndex.row())
+            indexesWithoutPressed << index;
+    }
 
     QRect pixRect(0, 0, DRAGICON_SIZE + DRAGICON_OUTLINE * 2, DRAGICON_SIZE + DRAGICON_OUTLINE * 2);
     QPixmap pixmap(pixRect.size() * scale);
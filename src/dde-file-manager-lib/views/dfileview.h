@@ -151,6 +151,9 @@ public:
 
     void cancelDrag();
 
+    // 恢复释放前保存的选中项和滚动位置，目录还在加载时等加载完成后再恢复
+    void restoreViewState(const DUrlList &selectedUrls, int scrollValue);
+
 public slots:
     bool cd(const DUrl &url);
     bool cdUp();
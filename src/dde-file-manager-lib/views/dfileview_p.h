@@ -31,6 +31,7 @@ public:
         : q_ptr(qq) {}
 
     int iconModeColumnCount(int itemWidth = 0) const;
+    QItemSelection iconModeSelection(const QRect &rect) const;
     QVariant fileViewStateValue(const DUrl &url, const QString &key, const QVariant &defalutValue);
     void setFileViewStateValue(const DUrl &url, const QString &key, const QVariant &value);
     void updateHorizontalScrollBarPosition();
@@ -99,6 +100,8 @@ public:
     QMap<QString, bool> columnForRoleHiddenMap;
 
     DUrlList preSelectionUrls;
+    // 目录加载完成后恢复的滚动位置，小于 0 时不恢复
+    int preScrollValue = -1;
 
     /// Saved before sorting
     DUrlList oldSelectedUrls;
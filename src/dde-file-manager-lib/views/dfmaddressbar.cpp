@@ -29,6 +29,11 @@
 #include <QWidgetAction>
 #include <QDebug>
 
+// 补全项合并到列表中的间隔（毫秒）
+#define COMPLETION_FLUSH_INTERVAL 50
+// 补全列表的最大条数，超过后停止列出目录
+#define COMPLETION_MAX_COUNT 2000
+
 DWIDGET_USE_NAMESPACE
 
 DFM_BEGIN_NAMESPACE
@@ -481,6 +486,10 @@ void DFMAddressBar::initConnections()
     });
 
     connect(pauseButton, &DIconButton::clicked, this, &DFMAddressBar::pauseButtonClicked);
+
+    completionFlushTimer.setSingleShot(true);
+    completionFlushTimer.setInterval(COMPLETION_FLUSH_INTERVAL);
+    connect(&completionFlushTimer, &QTimer::timeout, this, &DFMAddressBar::flushCompleterModel);
 }
 
 void DFMAddressBar::initData()
@@ -553,6 +562,8 @@ void DFMAddressBar::doComplete()
 void DFMAddressBar::clearCompleterModel()
 {
     isHistoryInCompleterModel = false;
+    pendingCompletions.clear();
+    completionFlushTimer.stop();
     completerModel.setStringList(QStringList());
 }
 
@@ -633,6 +644,8 @@ void DFMAddressBar::updateCompletionState(const QString &text)
                 appendToCompleterModel(list);
             });
             connect(crumbController, &DFMCrumbInterface::completionListTransmissionCompleted, this, [this]() {
+                flushCompleterModel();
+
                 if (urlCompleter->completionCount() > 0) {
                     if (urlCompleter->popup()->isHidden())
                         doComplete();
@@ -687,6 +700,12 @@ void DFMAddressBar::updateCompletionState(const QString &text)
     return;
 }
 
+/*!
+ * \brief DFMAddressBar::appendToCompleterModel 缓存后台列出的目录，定时合并到补全列表中
+ *
+ * 大目录或远程目录会分多批返回，每批都直接插入时 QCompleter 会对整个列表重新过滤，输入会卡顿。
+ * 补全项达到上限后停止列出目录。
+ */
 void DFMAddressBar::appendToCompleterModel(const QStringList &stringList)
 {
     for (const QString &str : stringList) {
@@ -694,13 +713,42 @@ void DFMAddressBar::appendToCompleterModel(const QStringList &stringList)
         if (str.isEmpty())
             continue;
 
-        if (completerModel.insertRow(completerModel.rowCount())) {
-            QModelIndex index = completerModel.index(completerModel.rowCount() - 1, 0);
-            completerModel.setData(index, str);
-        } else {
-            qWarning("Failed to append some data to completerModel.");
+        if (completerModel.rowCount() + pendingCompletions.size() >= COMPLETION_MAX_COUNT) {
+            if (crumbController)
+                crumbController->cancelCompletionListTransmission();
+            break;
         }
+
+        pendingCompletions << str;
     }
+
+    if (!pendingCompletions.isEmpty() && !completionFlushTimer.isActive())
+        completionFlushTimer.start();
+}
+
+void DFMAddressBar::flushCompleterModel()
+{
+    completionFlushTimer.stop();
+
+    if (pendingCompletions.isEmpty())
+        return;
+
+    const int row = completerModel.rowCount();
+
+    if (!completerModel.insertRows(row, pendingCompletions.size())) {
+        qWarning("Failed to append some data to completerModel.");
+        pendingCompletions.clear();
+        return;
+    }
+
+    //! 先阻塞信号写入数据再统一通知，QCompleter 只需要重新过滤一次
+    completerModel.blockSignals(true);
+    for (int i = 0; i < pendingCompletions.size(); ++i)
+        completerModel.setData(completerModel.index(row + i, 0), pendingCompletions.at(i));
+    completerModel.blockSignals(false);
+
+    pendingCompletions.clear();
+    emit completerModel.dataChanged(completerModel.index(row, 0), completerModel.index(completerModel.rowCount() - 1, 0));
 }
 
 void DFMAddressBar::insertCompletion(const QString &completion)
@@ -87,6 +87,7 @@ private:
     void clearCompleterModel();
     void updateCompletionState(const QString &text);
     void appendToCompleterModel(const QStringList &stringList);
+    void flushCompleterModel();
 
     int lastPressedKey = Qt::Key_D; // just an init value
     int lastPreviousKey = Qt::Key_Control; //记录上前一个按钮
@@ -100,6 +101,9 @@ private:
     int selectPosStart = 0;
     int selectLength = 0;
     QStringListModel completerModel;
+    //! 等待合并到 completerModel 中的补全项，避免逐条插入时 QCompleter 反复重新过滤
+    QStringList pendingCompletions;
+    QTimer completionFlushTimer;
     DCompleterListView *completerView;
     QStringList historyList;
     QAction *indicator = nullptr;
@@ -56,6 +56,7 @@
 #include <ddiskdevice.h>
 #include <dblockdevice.h>
 #include <QMenu>
+#include <QTimer>
 #include <QtConcurrent>
 
 #include <algorithm>
@@ -885,14 +886,23 @@ void DFMSideBar::initBookmarkConnection()
         }
     });
 
+    connect(bookmarkManager, &BookMarkManager::reachabilityChanged, this,
+    [this](const DUrl & url, bool reachable) {
+        int index = findItem(url, groupName(Bookmark));
+        if (index >= 0)
+            DFMSideBarBookmarkItemHandler::setItemReachable(m_sidebarModel->itemFromIndex(index), reachable);
+    });
+
     bookmarkManager->refreshBookmark();
 }
 
 void DFMSideBar::initDeviceConnection()
 {
-    // 已经初始化了就直接拿结果
+    // 已经初始化了就直接拿结果，放到事件循环中执行，不阻塞窗口的首次绘制
     if (DRootFileManager::instance()->isRootFileInited()) {
-        rootFileResult();
+        QTimer::singleShot(0, this, [this]() {
+            rootFileResult();
+        });
     }
 
     // 获取遍历结果进行显示
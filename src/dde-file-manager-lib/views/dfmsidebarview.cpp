@@ -11,6 +11,7 @@
 #include "accessibility/ac-lib-file-manager.h"
 #include "plugins/schemepluginmanager.h"
 #include "shutil/fileutils.h"
+#include "shutil/dfmdragurls.h"
 #include "rlog/rlog.h"
 
 #include <QDebug>
@@ -561,29 +562,7 @@ void DFMSideBarView::onRowCountChanged()
 
 bool DFMSideBarView::fetchDragEventUrlsFromSharedMemory()
 {
-    QSharedMemory sm;
-    sm.setKey(DRAG_EVENT_URLS);
-
-    if (!sm.isAttached()) {
-        if (!sm.attach()) {
-            qDebug() << "FQSharedMemory detach failed.";
-            return false;
-        }
-    }
-
-    QBuffer buffer;
-    QDataStream in(&buffer);
-    QList<QUrl> urls;
-
-    sm.lock();
-    //用缓冲区得到共享内存关联后得到的数据和数据大小
-    buffer.setData((char *)sm.constData(), sm.size());
-    buffer.open(QBuffer::ReadOnly);   //设置读取模式
-    in >> m_urlsForDragEvent;   //使用数据流从缓冲区获得共享内存的数据，然后输出到字符串中
-    sm.unlock();   //解锁
-    sm.detach();   //与共享内存空间分离
-
-    return true;
+    return DFMDragUrls::read(DRAG_EVENT_URLS, m_urlsForDragEvent);
 }
 
 bool DFMSideBarView::checkOpTime()
@@ -84,10 +84,34 @@ void Tab::setFileView(DFMBaseView *view)
     m_fileView = view;
 
     if (view) {
+        m_hibernated = false;
+        m_hibernatedSelection.clear();
         setCurrentUrl(view->rootUrl());
     }
 }
 
+void Tab::hibernate(const DUrlList &selectedUrls, int scrollValue)
+{
+    m_hibernated = true;
+    m_hibernatedSelection = selectedUrls;
+    m_hibernatedScrollValue = scrollValue;
+}
+
+bool Tab::isHibernated() const
+{
+    return m_hibernated;
+}
+
+DUrlList Tab::hibernatedSelection() const
+{
+    return m_hibernatedSelection;
+}
+
+int Tab::hibernatedScrollValue() const
+{
+    return m_hibernatedScrollValue;
+}
+
 DUrl Tab::currentUrl() const
 {
     return m_url;
@@ -42,6 +42,11 @@ public:
     void setFileView(DFMBaseView *view);
     DUrl currentUrl() const;
     void setCurrentUrl(const DUrl &url);
+    // 后台标签的视图被释放时保存其状态，重新激活时据此恢复
+    void hibernate(const DUrlList &selectedUrls, int scrollValue);
+    bool isHibernated() const;
+    DUrlList hibernatedSelection() const;
+    int hibernatedScrollValue() const;
 
     void setFixedSize(QSize size);
     void setGeometry(QRect rect);
@@ -100,6 +105,9 @@ private:
     bool m_borderLeft{ false };
     DFMBaseView *m_fileView{ nullptr };
     DUrl m_url{};
+    bool m_hibernated{ false };
+    DUrlList m_hibernatedSelection{};
+    int m_hibernatedScrollValue{ 0 };
 };
 
 class TabCloseButton: public QGraphicsObject
@@ -18,6 +18,7 @@
 #include "dialogs/dialogmanager.h"
 
 #include "utils/rlog/rlog.h"
+#include "interfaces/dfmstartupprofile.h"
 
 #include "qobjecthelper.h"
 
@@ -220,6 +221,7 @@ void WindowManager::showNewWindow(const DUrl &url, const bool &isNewWindow)
     QX11Info::setAppTime(QX11Info::appUserTime());
     DFileManagerWindow *window = new DFileManagerWindow(url.isEmpty() ? DFMApplication::instance()->appUrlAttribute(DFMApplication::AA_UrlOfNewWindow) : url);
     loadWindowState(window);
+    DFMStartupProfile::mark("firstWindow");
     // fix bug 59239 drag事件的接受者的drop事件和发起drag事件的发起者的mousemove事件处理完成才能
     // 析构本窗口，所以去掉属性Qt::WA_DeleteOnClose
 
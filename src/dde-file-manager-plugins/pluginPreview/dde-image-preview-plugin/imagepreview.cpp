@@ -26,6 +26,8 @@ DFM_USE_NAMESPACE
 ImagePreview::ImagePreview(QObject *parent)
     : DFMFilePreview(parent)
 {
+    // 内容在后台加载，可以为相邻的文件提前创建预览
+    setProperty("supportPrefetch", true);
 }
 
 ImagePreview::~ImagePreview()
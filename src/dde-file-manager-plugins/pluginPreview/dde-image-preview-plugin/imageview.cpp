@@ -15,19 +15,71 @@
 #include <QLabel>
 #include <QDebug>
 #include <QMovie>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include "shutil/dfmembeddedpreview.h"
 
 #define MIN_SIZE QSize(400, 300)
+// 内嵌预览图的最小尺寸，小于此尺寸时不作为占位图显示
+#define EMBEDDED_PREVIEW_MIN_SIZE 128
+
+// 同一时刻只解码一张图片，切换文件后排队中的旧任务在开始时即退出
+Q_GLOBAL_STATIC(QThreadPool, imageDecodeThreadPool)
+
+/*!
+ * \brief decodeImage 在后台线程中按显示尺寸解码图片
+ *
+ * 结果0为 JPEG 文件内嵌的预览图，用于在解码完成前占位；结果1为按显示尺寸解码的图片。
+ * 支持缩放解码的格式（如 JPEG）只解码所需的尺寸，不必解码完整的图片。
+ */
+static void decodeImage(QFutureInterface<QImage> interface, const QString &fileName, const QByteArray &format, const QSize &size)
+{
+    if (!interface.isCanceled() && (format == "jpeg" || format == "jpg")) {
+        QImage preview;
+
+        if (DFMEmbeddedPreview::loadPreview(fileName, "image/jpeg", EMBEDDED_PREVIEW_MIN_SIZE, &preview))
+            interface.reportResult(preview, 0);
+    }
+
+    if (!interface.isCanceled()) {
+        QImageReader reader(fileName, format);
+        const QSize &sourceSize = reader.size();
+
+        if (sourceSize.isValid())
+            reader.setScaledSize(sourceSize.scaled(size, Qt::KeepAspectRatio));
+
+        QImage image = reader.read();
+
+        if (!image.isNull() && (image.width() > size.width() || image.height() > size.height()))
+            image = image.scaled(size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+
+        if (!interface.isCanceled())
+            interface.reportResult(image, 1);
+    }
+
+    interface.reportFinished();
+}
 
 ImageView::ImageView(const QString &fileName, const QByteArray &format, QWidget *parent)
     : QLabel(parent)
 {
+    connect(&m_decodeWatcher, &QFutureWatcher<QImage>::resultReadyAt, this, &ImageView::onImageDecoded);
+
     setFile(fileName, format);
     setMinimumSize(MIN_SIZE);
     setAlignment(Qt::AlignCenter);
 }
 
+ImageView::~ImageView()
+{
+    cancelDecode();
+}
+
 void ImageView::setFile(const QString &fileName, const QByteArray &format)
 {
+    cancelDecode();
+
     if (format == QByteArrayLiteral("gif")) {
         if (movie) {
             movie->stop(); // blumia: we need to stop it first before we load a new file
@@ -53,23 +105,72 @@ void ImageView::setFile(const QString &fileName, const QByteArray &format)
         tmpMovie->deleteLater();
     }
 
+    // 只读取文件头获取图片尺寸，解码在后台线程中进行
     QImageReader reader(fileName, format);
 
     m_sourceSize = reader.size();
 
     const QSize &dsize = qApp->desktop()->size();
     qreal device_pixel_ratio = this->devicePixelRatioF();
+    const QSize maxSize(static_cast<int>(dsize.width() * 0.7 * device_pixel_ratio),
+                        static_cast<int>(dsize.height() * 0.8 * device_pixel_ratio));
 
-    QPixmap pixmap = QPixmap::fromImageReader(&reader).scaled(QSize(qMin(static_cast<int>(dsize.width() * 0.7 * device_pixel_ratio), m_sourceSize.width()),
-                                                                    qMin(static_cast<int>(dsize.height() * 0.8 * device_pixel_ratio), m_sourceSize.height())),
-                                                              Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    if (m_sourceSize.isValid()) {
+        m_displaySize = m_sourceSize.scaled(m_sourceSize.boundedTo(maxSize), Qt::KeepAspectRatio);
 
-    pixmap.setDevicePixelRatio(device_pixel_ratio);
+        // 解码完成前显示同样大小的空白图片，避免预览窗口的尺寸跳动
+        QPixmap placeholder(m_displaySize);
+        placeholder.fill(Qt::transparent);
+        placeholder.setDevicePixelRatio(device_pixel_ratio);
+        setPixmap(placeholder);
+    } else {
+        m_displaySize = maxSize;
+        clear();
+    }
 
-    setPixmap(pixmap);
+    QThreadPool *pool = imageDecodeThreadPool;
+    pool->setMaxThreadCount(1);
+
+    QFutureInterface<QImage> interface;
+    interface.reportStarted();
+    m_decodeWatcher.setFuture(interface.future());
+
+    QtConcurrent::run(pool, decodeImage, interface, fileName, format, m_displaySize);
 }
 
 QSize ImageView::sourceSize() const
 {
     return m_sourceSize;
 }
+
+/*!
+ * \brief ImageView::cancelDecode 取消正在进行的解码，切换到下一个文件时不再显示旧文件的结果
+ */
+void ImageView::cancelDecode()
+{
+    m_decodeWatcher.cancel();
+    m_decodeWatcher.setFuture(QFuture<QImage>());
+}
+
+void ImageView::onImageDecoded(int index)
+{
+    // 已得到按显示尺寸解码的图片时不再显示内嵌预览图
+    if (index == 0 && m_decodeWatcher.future().resultCount() > 1)
+        return;
+
+    const QImage &image = m_decodeWatcher.resultAt(index);
+
+    if (image.isNull())
+        return;
+
+    qreal device_pixel_ratio = this->devicePixelRatioF();
+    QPixmap pixmap = QPixmap::fromImage(image);
+
+    // 内嵌预览图尺寸较小，放大到显示尺寸占位
+    if (index == 0 && m_sourceSize.isValid())
+        pixmap = pixmap.scaled(m_displaySize, Qt::KeepAspectRatio, Qt::FastTransformation);
+
+    pixmap.setDevicePixelRatio(device_pixel_ratio);
+
+    setPixmap(pixmap);
+}
@@ -6,18 +6,27 @@
 #define IMAGEVIEW_H
 
 #include <QLabel>
+#include <QFutureWatcher>
+#include <QImage>
 
 class ImageView : public QLabel
 {
     Q_OBJECT
 public:
     explicit ImageView(const QString &fileName, const QByteArray &format, QWidget *parent = nullptr);
+    ~ImageView() override;
 
     void setFile(const QString &fileName, const QByteArray &format);
     QSize sourceSize() const;
 
 private:
+    void cancelDecode();
+    void onImageDecoded(int index);
+
     QSize m_sourceSize;
+    //! 按显示尺寸解码后的大小，已乘以设备像素比
+    QSize m_displaySize;
+    QFutureWatcher<QImage> m_decodeWatcher;
     QMovie *movie = nullptr;
 };
 
@@ -4,7 +4,7 @@
 #
 #-------------------------------------------------
 
-QT       += core gui widgets multimedia dtkwidget
+QT       += core gui widgets multimedia concurrent dtkwidget
 
 TARGET = dde-music-preview-plugin
 TEMPLATE = lib
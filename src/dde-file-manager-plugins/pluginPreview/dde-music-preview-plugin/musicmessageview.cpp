@@ -15,6 +15,13 @@
 #include <QTime>
 #include <QFileInfo>
 #include <QTextCodec>
+#include <QBuffer>
+#include <QCache>
+#include <QCryptographicHash>
+#include <QImageReader>
+#include <QMutex>
+#include <QThreadPool>
+#include <QtConcurrent>
 
 #include <unicode/ucnv.h>
 #include <unicode/ucsdet.h>
@@ -22,6 +29,114 @@
 #include <taglib/fileref.h>
 #include <taglib/taglib.h>
 #include <taglib/tpropertymap.h>
+#include <taglib/mpegfile.h>
+#include <taglib/id3v2tag.h>
+#include <taglib/attachedpictureframe.h>
+#include <taglib/flacfile.h>
+#include <taglib/flacpicture.h>
+#include <taglib/mp4file.h>
+#include <taglib/mp4coverart.h>
+
+// 解码后的封面缓存的大小（KB），同一专辑的歌曲共用一个封面
+#define MUSIC_COVER_CACHE_SIZE (16 * 1024)
+
+Q_GLOBAL_STATIC(QThreadPool, musicInfoThreadPool)
+
+namespace {
+class CoverCache
+{
+public:
+    CoverCache()
+        : images(MUSIC_COVER_CACHE_SIZE)
+    {
+    }
+
+    QMutex mutex;
+    QCache<QByteArray, QImage> images;
+};
+}
+
+Q_GLOBAL_STATIC(CoverCache, musicCoverCache)
+
+/*!
+ * \brief embeddedCoverData 读取音频文件内嵌的封面图片数据，优先使用封面类型的图片
+ */
+static QByteArray embeddedCoverData(const QString &path)
+{
+    TagLib::FileRef f(path.toLocal8Bit());
+    TagLib::ByteVector data;
+
+    if (TagLib::MPEG::File *file = dynamic_cast<TagLib::MPEG::File *>(f.file())) {
+        if (file->ID3v2Tag()) {
+            for (TagLib::ID3v2::Frame *frame : file->ID3v2Tag()->frameListMap()["APIC"]) {
+                auto picture = static_cast<TagLib::ID3v2::AttachedPictureFrame *>(frame);
+
+                if (data.isEmpty() || picture->type() == TagLib::ID3v2::AttachedPictureFrame::FrontCover)
+                    data = picture->picture();
+            }
+        }
+    } else if (TagLib::FLAC::File *file = dynamic_cast<TagLib::FLAC::File *>(f.file())) {
+        for (TagLib::FLAC::Picture *picture : file->pictureList()) {
+            if (data.isEmpty() || picture->type() == TagLib::FLAC::Picture::FrontCover)
+                data = picture->data();
+        }
+    } else if (TagLib::MP4::File *file = dynamic_cast<TagLib::MP4::File *>(f.file())) {
+        if (file->tag() && file->tag()->contains("covr")) {
+            const TagLib::MP4::CoverArtList &covers = file->tag()->item("covr").toCoverArtList();
+
+            if (!covers.isEmpty())
+                data = covers.front().data();
+        }
+    }
+
+    return QByteArray(data.data(), static_cast<int>(data.size()));
+}
+
+/*!
+ * \brief loadCover 在后台线程中读取内嵌的封面并按显示尺寸解码
+ *
+ * 解码后的封面按图片数据的哈希值缓存，浏览同一专辑的歌曲时不必重复解码。没有内嵌封面时返回空图片。
+ */
+static QImage loadCover(const QString &path, const QSize &size)
+{
+    const QByteArray &data = embeddedCoverData(path);
+
+    if (data.isEmpty())
+        return QImage();
+
+    QByteArray key = QCryptographicHash::hash(data, QCryptographicHash::Md5);
+    key.append(QByteArray::number(size.width()) + 'x' + QByteArray::number(size.height()));
+
+    {
+        QMutexLocker locker(&musicCoverCache->mutex);
+
+        if (QImage *image = musicCoverCache->images.object(key))
+            return *image;
+    }
+
+    QBuffer buffer;
+    buffer.setData(data);
+
+    // 支持缩放解码的格式（如 JPEG）只解码所需的尺寸
+    QImageReader reader(&buffer);
+    const QSize &sourceSize = reader.size();
+
+    if (sourceSize.isValid())
+        reader.setScaledSize(sourceSize.scaled(size, Qt::KeepAspectRatio));
+
+    QImage image = reader.read();
+
+    if (image.isNull())
+        return image;
+
+    if (image.width() > size.width() || image.height() > size.height())
+        image = image.scaled(size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+
+    QMutexLocker locker(&musicCoverCache->mutex);
+    musicCoverCache->images.insert(key, new QImage(image), qMax(1, image.bytesPerLine() * image.height() / 1024));
+
+    return image;
+}
 
 MusicMessageView::MusicMessageView(const QString &uri, QWidget *parent) :
     QFrame(parent),
@@ -29,6 +144,30 @@ MusicMessageView::MusicMessageView(const QString &uri, QWidget *parent) :
 {
     initUI();
     localeCodes.insert("zh_CN", "GB18030");
+
+    // 先显示文件名，标签和封面在后台线程中读取
+    m_title = QFileInfo(QUrl(m_uri).toLocalFile()).baseName();
+
+    QThreadPool *pool = musicInfoThreadPool;
+    pool->setMaxThreadCount(2);
+
+    connect(&m_metaWatcher, &QFutureWatcher<MediaMeta>::finished, this, &MusicMessageView::onMetaLoaded);
+    connect(&m_coverWatcher, &QFutureWatcher<QImage>::finished, this, &MusicMessageView::onCoverLoaded);
+
+    m_metaWatcher.setFuture(QtConcurrent::run(pool, [this] {
+        return tagOpenMusicFile(m_uri);
+    }));
+
+    const QString &path = QUrl(m_uri).toLocalFile();
+    const QSize &coverSize = m_imgLabel->size() * m_imgLabel->devicePixelRatioF();
+
+    m_coverWatcher.setFuture(QtConcurrent::run(pool, loadCover, path, coverSize));
+}
+
+MusicMessageView::~MusicMessageView()
+{
+    // 读取标签的任务使用了此对象的成员，需等待其结束；读取封面的任务不依赖此对象
+    m_metaWatcher.waitForFinished();
 }
 
 void MusicMessageView::initUI()
@@ -120,32 +259,64 @@ void MusicMessageView::updateElidedText()
 
 void MusicMessageView::mediaStatusChanged(QMediaPlayer::MediaStatus status)
 {
-    if (status == QMediaPlayer::BufferedMedia || status == QMediaPlayer::LoadedMedia) {
-        MediaMeta meta = tagOpenMusicFile(m_uri);
+    if (status == QMediaPlayer::BufferedMedia || status == QMediaPlayer::LoadedMedia || status == QMediaPlayer::InvalidMedia) {
+        // 播放器读取的封面只在 taglib 没有读到封面时使用
+        if (status != QMediaPlayer::InvalidMedia)
+            m_playerCover = m_player->metaData(QMediaMetaData::CoverArtImage).value<QImage>();
+
+        m_playerLoaded = true;
+        m_player->deleteLater();
+
+        updateCover();
+    }
+}
+
+void MusicMessageView::onMetaLoaded()
+{
+    const MediaMeta &meta = m_metaWatcher.result();
+
+    if (!meta.title.isEmpty())
         m_title = meta.title;
-        if (m_title.isEmpty()) {
-            QFileInfo file(m_uri);
-            QString fileName = file.baseName();
-            m_title = fileName;
-        }
-        m_artist = meta.artist;
-        if (m_artist.isEmpty())
-            m_artist = QString(tr("unknown artist"));
 
-        m_album = meta.album;
-        if (m_album.isEmpty())
-            m_album = QString(tr("unknown album"));
+    m_artist = meta.artist;
+    if (m_artist.isEmpty())
+        m_artist = QString(tr("unknown artist"));
 
-        QImage img = m_player->metaData(QMediaMetaData::CoverArtImage).value<QImage>();
-        if (img.isNull()) {
-            img = QImage(":/icons/icons/default_music_cover.png");
-        }
-        m_imgLabel->setCoverPixmap(QPixmap::fromImage(img).scaled(m_imgLabel->size(), Qt::KeepAspectRatio));
+    m_album = meta.album;
+    if (m_album.isEmpty())
+        m_album = QString(tr("unknown album"));
 
-        m_player->deleteLater();
+    updateElidedText();
+}
+
+void MusicMessageView::onCoverLoaded()
+{
+    const QImage &img = m_coverWatcher.result();
+
+    if (img.isNull()) {
+        m_coverState = CoverMissing;
+        updateCover();
+        return;
+    }
+
+    m_coverState = CoverLoaded;
+    m_imgLabel->setCoverPixmap(QPixmap::fromImage(img));
+}
+
+/*!
+ * \brief MusicMessageView::updateCover 没有内嵌封面时，在播放器读取完文件信息后显示其读取的封面或默认封面
+ */
+void MusicMessageView::updateCover()
+{
+    if (m_coverState != CoverMissing || !m_playerLoaded)
+        return;
 
-        updateElidedText();
+    QImage img = m_playerCover;
+    if (img.isNull()) {
+        img = QImage(":/icons/icons/default_music_cover.png");
     }
+    m_imgLabel->setCoverPixmap(QPixmap::fromImage(img).scaled(m_imgLabel->size(), Qt::KeepAspectRatio));
+    m_playerCover = QImage();
 }
 
 void MusicMessageView::resizeEvent(QResizeEvent *event)
@@ -7,6 +7,8 @@
 
 #include <QFrame>
 #include <QMediaPlayer>
+#include <QFutureWatcher>
+#include <QImage>
 class QLabel;
 class Cover;
 
@@ -25,6 +27,7 @@ class MusicMessageView : public QFrame
     Q_OBJECT
 public:
     explicit MusicMessageView(const QString &uri = "", QWidget *parent = nullptr);
+    ~MusicMessageView() override;
     void initUI();
     void updateElidedText();
 
@@ -65,7 +68,17 @@ private:
      */
     void characterEncodingTransform(MediaMeta &meta, void *obj);
 
+    void onMetaLoaded();
+    void onCoverLoaded();
+    void updateCover();
+
 private:
+    enum CoverState {
+        CoverPending,   // 正在读取内嵌的封面
+        CoverLoaded,    // 已显示内嵌的封面
+        CoverMissing    // 文件中没有 taglib 能读取的封面，使用播放器读取的封面或默认封面
+    };
+
     QString m_uri;
     QLabel *m_titleLabel;
     QLabel *m_artistLabel;
@@ -76,6 +89,11 @@ private:
 
 
     QMediaPlayer *m_player;
+    QFutureWatcher<MediaMeta> m_metaWatcher;
+    QFutureWatcher<QImage> m_coverWatcher;
+    CoverState m_coverState { CoverPending };
+    bool m_playerLoaded { false };
+    QImage m_playerCover;
 
     QString m_title;
     QString m_artist;
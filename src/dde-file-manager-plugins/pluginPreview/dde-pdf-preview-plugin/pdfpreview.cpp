@@ -16,7 +16,8 @@ DFM_USE_NAMESPACE
 PDFPreview::PDFPreview(QObject *parent)
     : DFMFilePreview(parent)
 {
-
+    // 文档在后台线程中加载，可以为相邻的文件提前创建预览
+    setProperty("supportPrefetch", true);
 }
 
 PDFPreview::~PDFPreview()
@@ -26,6 +26,14 @@
 
 #include "pdfwidget_p.h"
 
+// 页面列表右侧的留白
+#define PAGE_LIST_RIGHT_SPACING 40
+
+static inline quint64 tileKey(int index, int width, int tile)
+{
+    return (quint64(index) << 32) | (quint64(width & 0xffff) << 16) | quint64(tile & 0xffff);
+}
+
 PdfWidget::PdfWidget(const QString &file, QWidget *parent) :
     QWidget(parent),
     d_ptr(new PdfWidgetPrivate(this))
@@ -132,12 +140,13 @@ void PdfWidget::initUI()
     d->mainLayout->setSpacing(0);
     d->mainLayout->addWidget(d->thumbListWidget);
     d->mainLayout->addWidget(d->pageListWidget);
-    d->mainLayout->addSpacing(40);
+    d->mainLayout->addSpacing(PAGE_LIST_RIGHT_SPACING);
 
     setLayout(d->mainLayout);
 
     initEmptyPages();
 
+    d->pdfInitWorker->setVisiblePages(0, DISPLAT_PAGE_NUM - 1, pageWidth());
     loadThumbAsync(0);
     loadPageAsync(0);
 }
@@ -225,30 +234,28 @@ void PdfWidget::onpageAdded(int index, QImage img)
 {
     Q_D(PdfWidget);
 
-    d->pageMap.insert(index, img);
-
     QListWidgetItem* item = d->pageListWidget->item(index);
-    QWidget* w = d->pageListWidget->itemWidget(item);
 
-    if(!w){
-        img = img.scaled(d->pageListWidget->width(), img.height(), Qt::KeepAspectRatio, Qt::SmoothTransformation);
-        QImage page(d->pageListWidget->width(), img.height() + 4, QImage::Format_ARGB32_Premultiplied);
-        page.fill(Qt::white);
-        QPainter p(&page);
-        p.drawImage((page.width() - img.width())/2, 2, img);
-        if(index < (d->doc->pages() - 1)){
-            QPen pen(QColor(0, 0, 0 , 20));
-            p.setPen(pen);
-            p.drawLine(0, page.height() - 1, page.width(), page.height() - 1);
-        }
+    if(!item){
+        return;
+    }
+
+    d->pageMap.insert(index, img);
 
-        QLabel* pageLabel = new QLabel(this);
-        pageLabel->setPixmap(QPixmap::fromImage(page));
+    //! 占位图或其它宽度的页面已显示时替换为新的页面
+    const QPixmap &page = composePage(index, img);
+    QLabel* pageLabel = qobject_cast<QLabel*>(d->pageListWidget->itemWidget(item));
 
+    if(!pageLabel){
+        pageLabel = new QLabel(this);
         d->pageListWidget->setItemWidget(item, pageLabel);
-        item->setSizeHint(page.size());
     }
 
+    pageLabel->setPixmap(page);
+    item->setSizeHint(page.size());
+
+    releaseDistantPages(index);
+
     if(d->pageScrollBar->maximum() == 0){
         d->pageScrollBar->hide();
     } else {
@@ -294,6 +301,8 @@ void PdfWidget::startLoadCurrentPages()
     if(item)
     {
         int row = d->pageListWidget->row(item);
+        //! 滚动经过的页面不再渲染
+        d->pdfInitWorker->setVisiblePages(row, row + DISPLAT_PAGE_NUM - 1, pageWidth());
         loadPageAsync(row);
     }
 }
@@ -343,6 +352,9 @@ void PdfWidget::resizeEvent(QResizeEvent *event)
     d->pageScrollBar->move(event->size().width() - d->pageScrollBar->width(), 30);
 
     resizeCurrentPage();
+
+    //! 宽度改变后按新的宽度重新渲染可见的页面
+    d->pageWorkTimer->start();
 }
 
 void PdfWidget::renderBorder(QImage &img)
@@ -466,23 +478,12 @@ int PdfWidget::resizeCurrentPage()
 
             QLabel* label = qobject_cast<QLabel*>(w);
 
-            QImage img = d->pageMap.value(index);
-            img = img.scaled(d->pageListWidget->width(), img.height(), Qt::KeepAspectRatio, Qt::SmoothTransformation);
-            QImage page(d->pageListWidget->width(), img.height() + 4, QImage::Format_ARGB32_Premultiplied);
-            page.fill(Qt::white);
-
-            QPainter p(&page);
-            p.drawImage((page.width() - img.width()) / 2, 2, img);
-
-            if(index < (d->doc->pages() - 1)){
-                QPen pen(QColor(0, 0, 0 , 20));
-                p.setPen(pen);
-                p.drawLine(0, page.height() - 1, page.width(), page.height() - 1);
+            if(label){
+                const QPixmap &page = composePage(index, d->pageMap.value(index));
+                label->setPixmap(page);
+                item->setSizeHint(page.size());
             }
 
-            label->setPixmap(QPixmap::fromImage(page));
-            item->setSizeHint(page.size());
-
             index ++;
         } else {
             index ++;
@@ -493,11 +494,78 @@ int PdfWidget::resizeCurrentPage()
     return currentRow;
 }
 
+/*!
+ * \brief PdfWidget::pageWidth 页面的显示宽度，也是渲染页面时的宽度
+ */
+int PdfWidget::pageWidth() const
+{
+    Q_D(const PdfWidget);
+
+    //! 按布局计算，页面列表尚未显示时其宽度还不正确
+    return qMax(1, width() - d->thumbListWidget->width() - PAGE_LIST_RIGHT_SPACING);
+}
+
+QPixmap PdfWidget::composePage(int index, const QImage &img) const
+{
+    Q_D(const PdfWidget);
+
+    const int width = pageWidth();
+    //! 低分辨率的占位图放大到页面宽度显示
+    const QImage &scaledImg = img.width() == width ? img : img.scaledToWidth(width, Qt::SmoothTransformation);
+    QImage page(width, scaledImg.height() + 4, QImage::Format_ARGB32_Premultiplied);
+    page.fill(Qt::white);
+
+    QPainter p(&page);
+    p.drawImage((page.width() - scaledImg.width()) / 2, 2, scaledImg);
+
+    if(index < (d->doc->pages() - 1)){
+        QPen pen(QColor(0, 0, 0 , 20));
+        p.setPen(pen);
+        p.drawLine(0, page.height() - 1, page.width(), page.height() - 1);
+    }
+
+    return QPixmap::fromImage(page);
+}
+
+/*!
+ * \brief PdfWidget::releaseDistantPages 释放离当前位置较远的页面，重新滚动到这些页面时从分块缓存中恢复
+ */
+void PdfWidget::releaseDistantPages(int currentRow)
+{
+    Q_D(PdfWidget);
+
+    if(d->pageMap.size() <= MAX_DISPLAYED_PAGE_NUM){
+        return;
+    }
+
+    for(auto it = d->pageMap.begin(); it != d->pageMap.end();){
+        if(qAbs(it.key() - currentRow) <= MAX_DISPLAYED_PAGE_NUM / 2){
+            ++it;
+            continue;
+        }
+
+        //! 保留列表项的尺寸，滚动条位置不受影响
+        QListWidgetItem* item = d->pageListWidget->item(it.key());
+        if(item){
+            d->pageListWidget->removeItemWidget(item);
+        }
+
+        d->pdfInitWorker->releasePage(it.key());
+        it = d->pageMap.erase(it);
+    }
+}
+
 PdfInitWorker::PdfInitWorker(QSharedPointer<poppler::document> doc, QObject *parent):
     QObject(parent),
+    m_tileCache(PAGE_TILE_CACHE_MAX_COST),
     m_doc(doc)
 {
+    m_renderPool.setMaxThreadCount(qMax(QThread::idealThreadCount(), 1));
+}
 
+PdfInitWorker::~PdfInitWorker()
+{
+    m_renderPool.waitForDone();
 }
 
 void PdfInitWorker::startGetPageThumb(int index)
@@ -506,64 +574,143 @@ void PdfInitWorker::startGetPageThumb(int index)
     while(counter < DISPLAY_THUMB_NUM){
         counter++;
 
+        QMutexLocker locker(&m_mutex);
+
         //Skip for indexed thumb we got
         if(m_gotThumbIndexes.contains(index)){
             index ++;
             continue;
         }
 
-        QImage img = getRenderedPageImage(index);
+        locker.unlock();
 
-        if(img.isNull()){
+        QSharedPointer<poppler::page> page = QSharedPointer<poppler::page>(m_doc->create_page(index));
+
+        if(!page || page->page_rect().width() <= 0 || page->page_rect().height() <= 0){
+            break;
+        }
+
+        //! 直接按缩略图的尺寸渲染，不必渲染完整的页面再缩小
+        const qreal scale = qMin(DEFAULT_THUMB_SIZE.width() / page->page_rect().width(),
+                                 DEFAULT_THUMB_SIZE.height() / page->page_rect().height());
+        QImage thumb = renderPageImage(index, scale);
+
+        if(thumb.isNull()){
             break;
-        } else{
-            QImage thumb = getPageThumb(img);
-            emit thumbAdded(index, thumb);
-            m_gotThumbIndexes << index;
-            index ++;
         }
 
+        emit thumbAdded(index, thumb);
+
+        locker.relock();
+        m_gotThumbIndexes << index;
+        index ++;
     }
 }
 
+/*!
+ * \brief PdfInitWorker::startGetPageImage 渲染从 index 开始的可见页面，先发送低分辨率的占位图，再发送按页面宽度渲染的页面
+ */
 void PdfInitWorker::startGetPageImage(int index)
 {
-    int counter = 0;
-    while(counter < DISPLAT_PAGE_NUM){
-        counter++;
+    QMutexLocker locker(&m_mutex);
+    const int width = m_visibleWidth;
+    locker.unlock();
+
+    const int last = qMin(index + DISPLAT_PAGE_NUM, m_doc->pages());
+
+    for(int i = index; width > 0 && i < last; i++){
+        //! 已显示过或分块已缓存的页面不需要占位图
+        locker.relock();
+        const bool skip = m_gotPageWidths.contains(i) || m_tileCache.contains(tileKey(i, width, 0));
+        locker.unlock();
+
+        if(skip || !isPageWanted(i, width)){
+            continue;
+        }
+
+        QSharedPointer<poppler::page> page = QSharedPointer<poppler::page>(m_doc->create_page(i));
 
+        if(!page || page->page_rect().width() <= 0){
+            continue;
+        }
+
+        QImage placeholder = renderPageImage(i, qreal(width) / PAGE_PLACEHOLDER_SCALE / page->page_rect().width());
+
+        if(!placeholder.isNull()){
+            emit pageAdded(i, placeholder);
+        }
+    }
+
+    for(int i = index; i < last; i++){
         //Skip for indexed page we got
-        if(m_gotPageIndexes.contains(index)){
-            index ++;
+        if(gotPageWidth(i) == width || !isPageWanted(i, width)){
             continue;
         }
 
-        QImage img = getRenderedPageImage(index);
+        QImage img = renderPage(i, width);
 
+        //! 渲染失败或已被取消
         if(img.isNull()){
-            break;
-        } else {
-            emit pageAdded(index, img);
-            m_gotPageIndexes << index;
-            index ++;
+            continue;
         }
+
+        locker.relock();
+        m_gotPageWidths.insert(i, width);
+        locker.unlock();
+
+        emit pageAdded(i, img);
     }
 }
 
-QImage PdfInitWorker::getPageThumb(const QImage &img) const
+/*!
+ * \brief PdfInitWorker::setVisiblePages 设置需要显示的页面和宽度，其它页面尚未开始渲染的分块被取消
+ */
+void PdfInitWorker::setVisiblePages(int first, int last, int width)
 {
-    QImage newImg = img;
-    return newImg.scaled(DEFAULT_THUMB_SIZE, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    QMutexLocker locker(&m_mutex);
+
+    m_visibleFirst = first;
+    m_visibleLast = last;
+    m_visibleWidth = width;
+}
+
+/*!
+ * \brief PdfInitWorker::releasePage 页面已从界面中释放，再次可见时需重新发送
+ */
+void PdfInitWorker::releasePage(int index)
+{
+    QMutexLocker locker(&m_mutex);
+
+    m_gotPageWidths.remove(index);
 }
 
 QImage PdfInitWorker::getRenderedPageImage(const int &index) const
 {
-    QImage img;
+    QSharedPointer<poppler::page> page = QSharedPointer<poppler::page>(m_doc->create_page(index));
+
+    if (!page) {
+        return QImage();
+    }
+
+    if(page->page_rect().width() * page->page_rect().height() > 1920 * 1080 * 3){
+        qDebug () << "This pdf page is tool large, ignore...";
+        return QImage();
+    }
+
+    return renderPageImage(index, 1.0);
+}
 
+/*!
+ * \brief PdfInitWorker::renderPageImage 按比例渲染页面
+ * \param scale 相对于72dpi的缩放比例
+ * \param rect 渲染的区域，为空时渲染整个页面
+ */
+QImage PdfInitWorker::renderPageImage(const int &index, qreal scale, const QRect &rect) const
+{
     QSharedPointer<poppler::page> page = QSharedPointer<poppler::page>(m_doc->create_page(index));
 
     if (!page) {
-        return img;
+        return QImage();
     }
 
     poppler::page_renderer pr;
@@ -572,61 +719,135 @@ QImage PdfInitWorker::getRenderedPageImage(const int &index) const
 
     if(!pr.can_render()){
         qDebug () << "Cannot render page";
-        return img;
+        return QImage();
     }
 
-    if(page->page_rect().width() * page->page_rect().height() > 1920 * 1080 * 3){
+    const double resolution = 72.0 * scale;
+    poppler::image imageData = rect.isNull() ? pr.render_page(page.data(), resolution, resolution)
+                                             : pr.render_page(page.data(), resolution, resolution,
+                                                              rect.x(), rect.y(), rect.width(), rect.height());
+
+    if (!imageData.is_valid()) {
+        qDebug () << "Render error";
+        return QImage();
+    }
+
+    return toImage(imageData);
+}
+
+/*!
+ * \brief PdfInitWorker::renderPage 按宽度分块渲染页面，分块在线程池中并行渲染并缓存
+ * \return 页面已不可见或渲染失败时返回空图片
+ */
+QImage PdfInitWorker::renderPage(int index, int width)
+{
+    //! 没有可用的宽度时按原始尺寸渲染
+    if(width <= 0){
+        return getRenderedPageImage(index);
+    }
+
+    QSharedPointer<poppler::page> page = QSharedPointer<poppler::page>(m_doc->create_page(index));
+
+    if(!page || page->page_rect().width() <= 0 || page->page_rect().height() <= 0){
+        return QImage();
+    }
+
+    const qreal scale = width / page->page_rect().width();
+    const int height = qCeil(page->page_rect().height() * scale);
+
+    if(qint64(width) * height > 1920 * 1080 * 3){
         qDebug () << "This pdf page is tool large, ignore...";
-        return img;
+        return QImage();
     }
 
-    poppler::image imageData = pr.render_page(page.data());
+    const int tileCount = (height + PAGE_TILE_HEIGHT - 1) / PAGE_TILE_HEIGHT;
+    QList<QFuture<QImage>> tiles;
 
-    if (!imageData.is_valid()) {
-        qDebug () << "Render error";
-        return img;
+    for(int i = 0; i < tileCount; i++){
+        tiles << QtConcurrent::run(&m_renderPool, [=]() -> QImage {
+            const quint64 key = tileKey(index, width, i);
+
+            QMutexLocker locker(&m_mutex);
+
+            if(const QImage *tile = m_tileCache.object(key)){
+                return *tile;
+            }
+
+            locker.unlock();
+
+            //! 页面已滚动出可见区域时不再渲染
+            if(!isPageWanted(index, width)){
+                return QImage();
+            }
+
+            const QRect tileRect(0, i * PAGE_TILE_HEIGHT, width, qMin(PAGE_TILE_HEIGHT, height - i * PAGE_TILE_HEIGHT));
+            const QImage tile = renderPageImage(index, scale, tileRect);
+
+            if(!tile.isNull()){
+                locker.relock();
+                m_tileCache.insert(key, new QImage(tile), qMax(1, tile.width() * tile.height() * tile.depth() / 8 / 1024));
+            }
+
+            return tile;
+        }));
     }
 
-    poppler::image::format_enum format = imageData.format();
+    QImage img(width, height, QImage::Format_ARGB32_Premultiplied);
+    img.fill(Qt::white);
+
+    QPainter painter(&img);
+
+    for(int i = 0; i < tiles.size(); i++){
+        const QImage &tile = tiles.at(i).result();
+
+        if(tile.isNull()){
+            return QImage();
+        }
+
+        painter.drawImage(0, i * PAGE_TILE_HEIGHT, tile);
+    }
+
+    return img;
+}
+
+bool PdfInitWorker::isPageWanted(int index, int width) const
+{
+    QMutexLocker locker(&m_mutex);
+
+    return index >= m_visibleFirst && index <= m_visibleLast && width == m_visibleWidth;
+}
+
+int PdfInitWorker::gotPageWidth(int index) const
+{
+    QMutexLocker locker(&m_mutex);
 
-    switch (format) {
+    return m_gotPageWidths.value(index, -1);
+}
+
+/*!
+ * \brief PdfInitWorker::toImage 按行复制 poppler 渲染的图片数据
+ */
+QImage PdfInitWorker::toImage(const poppler::image &imageData)
+{
+    const uchar *data = reinterpret_cast<const uchar *>(imageData.const_data());
+
+    switch (imageData.format()) {
     case poppler::image::format_invalid:
         qDebug ()  << "Image format is invalid";
-        return img;
+        return QImage();
     case poppler::image::format_mono:
-        img = QImage((uchar*)imageData.data(), imageData.width(), imageData.height(), QImage::Format_Mono);
-        break;
+        return QImage(data, imageData.width(), imageData.height(), imageData.bytes_per_row(), QImage::Format_Mono).copy();
     case poppler::image::format_rgb24:
-        img = QImage((uchar*)imageData.data(),imageData.width(),imageData.height(),QImage::Format_ARGB6666_Premultiplied);
-        break;
+        return QImage(data, imageData.width(), imageData.height(), imageData.bytes_per_row(), QImage::Format_RGB888).copy();
     case poppler::image::format_argb32:
-    {
-        //Note that this format has problem that QImage cannot parse it normally
-        img = QImage(imageData.width(), imageData.height(), QImage::Format_ARGB32_Premultiplied);
-        img.fill(Qt::white);
-        int w = imageData.width();
-        int h = imageData.height();
-        int offset = imageData.bytes_per_row() / imageData.width();
-
-        char* pdata = imageData.data();
-
-        for(int y = 0; y < h; y ++){
-            for(int x = 0; x < w; x++){
-                uchar b = static_cast<uchar> (pdata[(x * offset) + (y * w * offset)]);
-                uchar g = static_cast<uchar> (pdata[(x * offset) + (y * w * offset) + 1]);
-                uchar r = static_cast<uchar> (pdata[(x * offset) + (y * w * offset) + 2]);
-                uchar a = static_cast<uchar> (pdata[(x * offset) + (y * w * offset) + 3]);
-
-                img.setPixelColor(x, y, QColor((int)r, (int)g, (int)b, (int)a));
-            }
-        }
-        break;
-    }
+        //! 与 QImage::Format_ARGB32 的内存布局相同，转换格式时复制数据
+        return QImage(data, imageData.width(), imageData.height(), imageData.bytes_per_row(), QImage::Format_ARGB32)
+                .convertToFormat(QImage::Format_ARGB32_Premultiplied);
     default:
         break;
     }
 
-    return img;
+    return QImage();
 }
 
 DListWidget::DListWidget(QWidget *parent):
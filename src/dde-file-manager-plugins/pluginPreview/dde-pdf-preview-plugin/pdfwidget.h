@@ -10,6 +10,10 @@
 #include <QListWidget>
 #include <QLabel>
 #include <QFuture>
+#include <QCache>
+#include <QSet>
+#include <QMutex>
+#include <QThreadPool>
 
 #include "poppler-document.h"
 #include "poppler-page.h"
@@ -20,6 +24,14 @@
 #define DEFAULT_PAGE_SIZE QSize(800, 1200)
 #define DISPLAY_THUMB_NUM 10
 #define DISPLAT_PAGE_NUM 5
+// 页面按此高度分块渲染
+#define PAGE_TILE_HEIGHT 256
+// 已渲染分块的缓存上限，单位为KB
+#define PAGE_TILE_CACHE_MAX_COST (64 * 1024)
+// 占位图的宽度为页面宽度的几分之一
+#define PAGE_PLACEHOLDER_SCALE 4
+// 最多保留的已显示页面数量，离当前位置较远的页面被释放
+#define MAX_DISPLAYED_PAGE_NUM (DISPLAT_PAGE_NUM * 4)
 
 class PdfWidgetPrivate;
 class PdfInitWorker;
@@ -71,6 +83,9 @@ private:
     void initEmptyPages();
 
     int resizeCurrentPage();
+    int pageWidth() const;
+    QPixmap composePage(int index, const QImage &img) const;
+    void releaseDistantPages(int currentRow);
 
     QSharedPointer<PdfWidgetPrivate> d_ptr;
     QFuture<void> threadPage;
@@ -83,22 +98,43 @@ class PdfInitWorker: public QObject
     Q_OBJECT
 public:
     explicit PdfInitWorker(QSharedPointer<poppler::document> doc, QObject *parent = nullptr);
+    ~PdfInitWorker() override;
 
     void startGetPageThumb(int index);
     void startGetPageImage(int index);
 
+    void setVisiblePages(int first, int last, int width);
+    void releasePage(int index);
+
 signals:
+    //! 同一页面可能先后收到低分辨率的占位图和正式的页面
     void pageAdded(const int &index, const QImage &img);
     void thumbAdded(const int &index, const QImage &img);
 
 private:
-    QImage getPageThumb(const QImage &img) const;
     QImage getRenderedPageImage(const int &index) const;
+    QImage renderPageImage(const int &index, qreal scale, const QRect &rect = QRect()) const;
+    QImage renderPage(int index, int width);
+    bool isPageWanted(int index, int width) const;
+    int gotPageWidth(int index) const;
+    static QImage toImage(const poppler::image &imageData);
+
+    QSet<int> m_gotThumbIndexes;
+    //! 已显示的页面及其渲染时的宽度
+    QHash<int, int> m_gotPageWidths;
+
+    //! 需要显示的页面，其它页面尚未开始的渲染被取消
+    int m_visibleFirst = 0;
+    int m_visibleLast = DISPLAT_PAGE_NUM - 1;
+    int m_visibleWidth = 0;
+    mutable QMutex m_mutex;
 
-    QList<int> m_gotThumbIndexes;
-    QList<int> m_gotPageIndexes;
+    //! 以页面、宽度和分块序号为键
+    QCache<quint64, QImage> m_tileCache;
 
     QSharedPointer<poppler::document> m_doc;
+    //! 需最先析构，等待渲染分块的线程结束
+    QThreadPool m_renderPool;
 };
 
 class DListWidget: public QListWidget
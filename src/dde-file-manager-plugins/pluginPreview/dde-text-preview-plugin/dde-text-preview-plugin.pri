@@ -1,11 +1,13 @@
 SOURCES += \
     $$PWD/textpreview.cpp \
     $$PWD/textpreviewplugin.cpp \
-    $$PWD/textbrowseredit.cpp
+    $$PWD/textbrowseredit.cpp \
+    $$PWD/textlineindex.cpp
 
 HEADERS += \
     textpreview.h \
     $$PWD/textpreviewplugin.h \
-    $$PWD/textbrowseredit.h
+    $$PWD/textbrowseredit.h \
+    $$PWD/textlineindex.h
 
 
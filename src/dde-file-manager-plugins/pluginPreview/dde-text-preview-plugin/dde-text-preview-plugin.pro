@@ -4,7 +4,7 @@
 #
 #-------------------------------------------------
 
-QT       += core gui widgets
+QT       += core gui widgets concurrent
 
 TARGET = dde-text-preview-plugin
 TEMPLATE = lib
@@ -3,8 +3,10 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "textbrowseredit.h"
+#include "textlineindex.h"
 
 #include <QScrollBar>
+#include <QResizeEvent>
 #include <QDebug>
 #include <QTextCodec>
 #include <algorithm>
@@ -25,6 +27,14 @@ TextBrowserEdit::~TextBrowserEdit()
 
 void TextBrowserEdit::setFileData(std::vector<char> &data)
 {
+    if (lineIndex) {
+        delete lineIndex;
+        lineIndex = nullptr;
+        lineScrollBar->hide();
+        setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+        setLineWrapMode(QPlainTextEdit::WidgetWidth);
+    }
+
     clear();
     fileData = data;
     std::vector<char>::iterator temp = fileData.begin();
@@ -33,8 +43,43 @@ void TextBrowserEdit::setFileData(std::vector<char> &data)
     lastPosition = verticalScrollBar()->sliderPosition();
 }
 
+/*!
+ * \brief TextBrowserEdit::setFilePath 以分页模式显示大文件，文件映射到内存中，只读取可见的行
+ */
+bool TextBrowserEdit::setFilePath(const QString &filePath)
+{
+    if (!lineIndex) {
+        lineIndex = new TextLineIndex(this);
+        connect(lineIndex, &TextLineIndex::lineCountChanged, this, &TextBrowserEdit::updateLineScrollBar, Qt::QueuedConnection);
+        connect(lineIndex, &TextLineIndex::codecChanged, this, &TextBrowserEdit::updatePagedText, Qt::QueuedConnection);
+    }
+
+    if (!lineIndex->open(filePath))
+        return false;
+
+    if (!lineScrollBar) {
+        lineScrollBar = new QScrollBar(Qt::Vertical, this);
+        connect(lineScrollBar, &QScrollBar::valueChanged, this, &TextBrowserEdit::updatePagedText);
+    }
+
+    fileData.clear();
+    setLineWrapMode(QPlainTextEdit::NoWrap);
+    setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    lineScrollBar->setValue(0);
+    updateLineScrollBar();
+    updatePagedText();
+
+    return true;
+}
+
 void TextBrowserEdit::wheelEvent(QWheelEvent *e)
 {
+    if (lineIndex) {
+        lineScrollBar->setValue(lineScrollBar->value() - e->angleDelta().y() / 40);
+        e->accept();
+        return;
+    }
+
     QPoint numDegrees = e->angleDelta();
     if (numDegrees.y() < 0) {
         int sbValue = verticalScrollBar()->value();
@@ -48,6 +93,17 @@ void TextBrowserEdit::wheelEvent(QWheelEvent *e)
     QPlainTextEdit::wheelEvent(e);
 }
 
+void TextBrowserEdit::resizeEvent(QResizeEvent *e)
+{
+    QPlainTextEdit::resizeEvent(e);
+
+    if (!lineIndex)
+        return;
+
+    updateLineScrollBar();
+    updatePagedText();
+}
+
 void TextBrowserEdit::scrollbarValueChange(int value)
 {
     if(verticalScrollBar()->maximum() <= value){
@@ -68,6 +124,47 @@ void TextBrowserEdit::sliderPositionValueChange(int position)
     lastPosition = position;
 }
 
+void TextBrowserEdit::updatePagedText()
+{
+    if (!lineIndex)
+        return;
+
+    const int count = visibleLineCount();
+    const int horizontalValue = horizontalScrollBar()->value();
+
+    setPlainText(lineIndex->lines(lineScrollBar->value(), count));
+    displayedLineCount = document()->blockCount();
+    horizontalScrollBar()->setValue(horizontalValue);
+}
+
+/*!
+ * \brief TextBrowserEdit::updateLineScrollBar 后台扫描到更多行时扩大滚动范围
+ */
+void TextBrowserEdit::updateLineScrollBar()
+{
+    if (!lineIndex)
+        return;
+
+    const int count = visibleLineCount();
+    const qint64 lineCount = lineIndex->lineCount();
+    const QRect &rect = contentsRect();
+    const int scrollBarWidth = lineScrollBar->sizeHint().width();
+
+    lineScrollBar->setGeometry(rect.right() - scrollBarWidth + 1, rect.top(), scrollBarWidth, rect.height());
+    lineScrollBar->setPageStep(count);
+    lineScrollBar->setRange(0, static_cast<int>(qBound<qint64>(0, lineCount - count, INT_MAX)));
+    lineScrollBar->setVisible(lineCount > count);
+
+    // 打开文件时可见的行可能尚未扫描到
+    if (displayedLineCount < count && lineScrollBar->value() + displayedLineCount < lineCount)
+        updatePagedText();
+}
+
+int TextBrowserEdit::visibleLineCount() const
+{
+    return viewport()->height() / qMax(1, fontMetrics().lineSpacing()) + 1;
+}
+
 int TextBrowserEdit::verifyEndOfStrIntegrity(const char *s, int l)
 {
     int len = 0, i = 0;
@@ -9,6 +9,8 @@
 
 #include <vector>
 
+class QScrollBar;
+class TextLineIndex;
 class TextBrowserEdit : public QPlainTextEdit
 {
     Q_OBJECT
@@ -18,22 +20,35 @@ public:
     virtual ~TextBrowserEdit() override;
 
     void setFileData(std::vector<char> &data);
+    bool setFilePath(const QString &filePath);
 
 protected:
     void wheelEvent(QWheelEvent *e) override;
+    void resizeEvent(QResizeEvent *e) override;
 
 private slots:
     void scrollbarValueChange(int value);
 
     void sliderPositionValueChange(int position);
 
+    void updatePagedText();
+
+    void updateLineScrollBar();
+
 private:
     int verifyEndOfStrIntegrity(const char *s, int l);
 
     void appendText(std::vector<char>::iterator &data);
 
+    int visibleLineCount() const;
+
     std::vector<char> fileData;
 
     int lastPosition {0};
+
+    //! 大文件映射到内存中，只显示可见的行
+    TextLineIndex *lineIndex {nullptr};
+    QScrollBar *lineScrollBar {nullptr};
+    int displayedLineCount {0};
 };
 #endif   // TEXTBROWSER_H
@@ -0,0 +1,227 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "textlineindex.h"
+
+#include <QTextCodec>
+#include <QtConcurrent>
+
+#include <cstring>
+
+//! 每隔多少行记录一次行首位置
+constexpr int kLineCheckpointInterval { 64 };
+//! 超出此长度的行被拆分，单位为字节
+constexpr int kMaxLineLength { 4096 };
+//! 打开文件时用于猜测编码的数据大小
+constexpr int kCodecSampleSize { 64 * 1024 };
+//! 每扫描这么多数据更新一次行数
+constexpr qint64 kIndexReportSize { 4 * 1024 * 1024 };
+
+TextLineIndex::TextLineIndex(QObject *parent)
+    : QObject(parent)
+{
+}
+
+TextLineIndex::~TextLineIndex()
+{
+    close();
+}
+
+bool TextLineIndex::open(const QString &filePath)
+{
+    close();
+
+    file.setFileName(filePath);
+
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    dataSize = file.size();
+    data = dataSize > 0 ? file.map(0, dataSize) : nullptr;
+
+    if (!data) {
+        file.close();
+        return false;
+    }
+
+    // 先按文件开头的内容猜测编码，扫描整个文件时再修正
+    const char *sample = reinterpret_cast<const char *>(data);
+    const int sampleSize = static_cast<int>(qMin<qint64>(dataSize, kCodecSampleSize));
+    QTextCodec *utf8Codec = QTextCodec::codecForName("UTF-8");
+    QTextCodec *codec = QTextCodec::codecForUtfText(QByteArray::fromRawData(sample, sampleSize), nullptr);
+
+    if (!codec) {
+        QTextCodec::ConverterState state;
+        utf8Codec->toUnicode(sample, sampleSize, &state);
+        codec = state.invalidChars > 0 ? QTextCodec::codecForName("GBK") : utf8Codec;
+    }
+
+    textCodec = codec;
+    checkpoints.clear();
+    indexedLineCount = 0;
+    finished = false;
+    stopped = false;
+
+    indexFuture = QtConcurrent::run([this] {
+        buildIndex();
+    });
+
+    return true;
+}
+
+void TextLineIndex::close()
+{
+    stopped = true;
+    indexFuture.waitForFinished();
+
+    if (data) {
+        file.unmap(const_cast<uchar *>(data));
+        data = nullptr;
+    }
+
+    file.close();
+    dataSize = 0;
+}
+
+/*!
+ * \brief TextLineIndex::lineCount 已扫描到的行数，扫描结束前会继续增加
+ */
+qint64 TextLineIndex::lineCount() const
+{
+    QMutexLocker locker(&mutex);
+
+    return indexedLineCount;
+}
+
+bool TextLineIndex::isFinished() const
+{
+    QMutexLocker locker(&mutex);
+
+    return finished;
+}
+
+QTextCodec *TextLineIndex::codec() const
+{
+    QMutexLocker locker(&mutex);
+
+    return textCodec;
+}
+
+/*!
+ * \brief TextLineIndex::lines 读取从 first 开始的 count 行，只访问这些行所在的内存页
+ */
+QString TextLineIndex::lines(qint64 first, int count) const
+{
+    QMutexLocker locker(&mutex);
+
+    if (checkpoints.isEmpty() || first < 0 || count <= 0)
+        return QString();
+
+    const int checkpoint = static_cast<int>(qMin<qint64>(first / kLineCheckpointInterval, checkpoints.size() - 1));
+    qint64 line = qint64(checkpoint) * kLineCheckpointInterval;
+    qint64 pos = checkpoints.at(checkpoint);
+    QTextCodec *codec = textCodec;
+
+    locker.unlock();
+
+    while (line < first && pos < dataSize) {
+        pos = nextLineStart(pos);
+        ++line;
+    }
+
+    QString text;
+
+    for (int i = 0; i < count && pos < dataSize; ++i) {
+        const qint64 next = nextLineStart(pos);
+        qint64 end = next;
+
+        if (end > pos && data[end - 1] == '\n')
+            --end;
+
+        if (end > pos && data[end - 1] == '\r')
+            --end;
+
+        if (i > 0)
+            text.append(QLatin1Char('\n'));
+
+        text.append(codec->toUnicode(reinterpret_cast<const char *>(data + pos), static_cast<int>(end - pos)));
+        pos = next;
+    }
+
+    return text;
+}
+
+qint64 TextLineIndex::nextLineStart(qint64 pos) const
+{
+    const qint64 limit = qMin(dataSize, pos + kMaxLineLength);
+    const void *found = memchr(data + pos, '\n', static_cast<size_t>(limit - pos));
+
+    if (found)
+        return static_cast<const uchar *>(found) - data + 1;
+
+    if (limit >= dataSize)
+        return dataSize;
+
+    // 过长的行按固定长度拆分，不拆开 UTF-8 字符
+    qint64 end = limit;
+
+    for (int i = 0; i < 3 && end > pos + 1 && (data[end] & 0xc0) == 0x80; ++i)
+        --end;
+
+    return end;
+}
+
+void TextLineIndex::buildIndex()
+{
+    QTextCodec *utf8Codec = QTextCodec::codecForName("UTF-8");
+    QTextCodec::ConverterState state;
+    bool checkUtf8 = codec() == utf8Codec;
+    qint64 checkedPos = 0;
+
+    QVector<qint64> pending;
+    qint64 pos = 0;
+    qint64 line = 0;
+    qint64 reportPos = 0;
+
+    while (pos < dataSize && !stopped) {
+        if (line % kLineCheckpointInterval == 0)
+            pending << pos;
+
+        pos = nextLineStart(pos);
+        ++line;
+
+        if (pos < reportPos && pos < dataSize)
+            continue;
+
+        reportPos = pos + kIndexReportSize;
+
+        // 文件后面出现无效的 UTF-8 字符时改用 GBK
+        if (checkUtf8) {
+            utf8Codec->toUnicode(reinterpret_cast<const char *>(data + checkedPos), static_cast<int>(pos - checkedPos), &state);
+            checkedPos = pos;
+
+            if (state.invalidChars > 0) {
+                checkUtf8 = false;
+
+                QMutexLocker locker(&mutex);
+                textCodec = QTextCodec::codecForName("GBK");
+                locker.unlock();
+
+                emit codecChanged();
+            }
+        }
+
+        QMutexLocker locker(&mutex);
+        checkpoints += pending;
+        indexedLineCount = line;
+        locker.unlock();
+
+        pending.clear();
+
+        emit lineCountChanged(line);
+    }
+
+    QMutexLocker locker(&mutex);
+    finished = true;
+}
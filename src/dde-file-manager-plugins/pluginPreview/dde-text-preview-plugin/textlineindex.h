@@ -0,0 +1,64 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef TEXTLINEINDEX_H
+#define TEXTLINEINDEX_H
+
+#include <QObject>
+#include <QFile>
+#include <QFuture>
+#include <QMutex>
+#include <QVector>
+
+QT_BEGIN_NAMESPACE
+class QTextCodec;
+QT_END_NAMESPACE
+
+/*!
+ * \brief TextLineIndex 映射到内存中的文本文件的行索引
+ *
+ * 在后台线程中扫描文件建立行索引，每隔若干行记录一次行首位置，读取指定范围的行时只需从最近的记录开始查找。
+ * 扫描的同时检查文件是否为 UTF-8 编码，发现无效字符时改用 GBK。过长的行按固定长度拆分为多行。
+ */
+class TextLineIndex : public QObject
+{
+    Q_OBJECT
+public:
+    explicit TextLineIndex(QObject *parent = nullptr);
+    ~TextLineIndex() override;
+
+    bool open(const QString &filePath);
+    void close();
+
+    qint64 lineCount() const;
+    bool isFinished() const;
+    QTextCodec *codec() const;
+
+    QString lines(qint64 first, int count) const;
+
+signals:
+    //! 在后台线程中发出
+    void lineCountChanged(qint64 count);
+    void codecChanged();
+
+private:
+    qint64 nextLineStart(qint64 pos) const;
+    void buildIndex();
+
+    QFile file;
+    const uchar *data { nullptr };
+    qint64 dataSize { 0 };
+
+    //! 每隔 kLineCheckpointInterval 行的行首位置
+    QVector<qint64> checkpoints;
+    qint64 indexedLineCount { 0 };
+    bool finished { false };
+    QTextCodec *textCodec { nullptr };
+    mutable QMutex mutex;
+
+    QAtomicInteger<bool> stopped { false };
+    QFuture<void> indexFuture;
+};
+
+#endif   // TEXTLINEINDEX_H
@@ -16,6 +16,9 @@
 
 using namespace std;
 
+//! 超出此大小的文件以分页模式显示
+constexpr qint64 kPagedFileSize { 1024 * 1024 * 5 };
+
 TextPreview::TextPreview(QObject *parent)
     : DFMFilePreview(parent)
 {
@@ -32,7 +35,9 @@ bool TextPreview::setFileUrl(const DUrl &url)
 
     selectUrl = url;
 
-    device.open(url.path().toLocal8Bit().data(), ios::binary);
+    const QString &filePath = url.path();
+
+    device.open(filePath.toLocal8Bit().data(), ios::binary);
 
     if (!device.is_open()) {
         qInfo() << "File open failed";
@@ -51,6 +56,18 @@ bool TextPreview::setFileUrl(const DUrl &url)
 
     titleStr = QFileInfo(url.toLocalFile()).fileName();
 
+    // 大文件不读入内存，映射后只显示可见的行
+    if (QFileInfo(filePath).size() > kPagedFileSize) {
+        device.close();
+
+        if (!textBrowser->setFilePath(filePath))
+            return false;
+
+        Q_EMIT titleChanged();
+
+        return true;
+    }
+
     long len = device.seekg(0, ios::end).tellg();
     if (len <= 0)
         return false;
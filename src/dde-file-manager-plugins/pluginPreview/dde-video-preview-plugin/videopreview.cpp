@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "videopreview.h"
+#include "dthumbnailprovider.h"
 
 #include <player_widget.h>
 #include <player_engine.h>
@@ -157,16 +158,14 @@ VideoPreview::VideoPreview(QObject *parent)
     // 经确认，该函数已废弃，屏蔽后不影响使用
     //   dmr::CompositingManager::get().overrideCompositeMode(true);
 
-    playerWidget = new VideoWidget(this);
+    playerWidget = VideoWidget::acquire(this);
     statusBar = new VideoStatusBar(this);
 }
 
 VideoPreview::~VideoPreview()
 {
-    if (playerWidget) {
-        playerWidget->hide();
-        delete playerWidget.data();
-    }
+    if (playerWidget)
+        playerWidget->release();
 
     if (statusBar) {
         statusBar->hide();
@@ -189,7 +188,15 @@ bool VideoPreview::setFileUrl(const DUrl &url)
     playerWidget->title->setText(info.title);
     playerWidget->title->adjustSize();
     statusBar->slider->setMaximum(static_cast<int>(info.duration));
-    videoUrl = QUrl::fromLocalFile(url.toLocalFile());
+
+    const QUrl &newVideoUrl = QUrl::fromLocalFile(url.toLocalFile());
+
+    // 播放器开始输出画面前先显示缩略图缓存中的首帧，缩略图不存在时不在此生成
+    if (newVideoUrl != videoUrl)
+        playerWidget->showStill(DFM_NAMESPACE::DThumbnailProvider::instance()->thumbnailPixmap(QFileInfo(url.toLocalFile()),
+                                                                                             DFM_NAMESPACE::DThumbnailProvider::Large));
+
+    videoUrl = newVideoUrl;
 
     return true;
 }
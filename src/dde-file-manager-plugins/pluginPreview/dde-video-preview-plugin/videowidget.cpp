@@ -7,11 +7,18 @@
 
 #include <player_engine.h>
 
+#include <QPointer>
+
 DWIDGET_USE_NAMESPACE
+
+// 预览关闭后保留一个播放器，下次预览视频时不必重新初始化播放器
+static QPointer<VideoWidget> idleVideoWidget;
+
 VideoWidget::VideoWidget(VideoPreview *preview)
    : dmr::PlayerWidget(nullptr)
    , p(preview)
    , title(new QLabel(this))
+   , still(new QLabel(this))
 {
    setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
 
@@ -23,10 +30,99 @@ VideoWidget::VideoWidget(VideoPreview *preview)
    DAnchorsBase::setAnchor(title, Qt::AnchorHorizontalCenter, this, Qt::AnchorHorizontalCenter);
 
    engine().setBackendProperty("keep-open", "yes");
+   // 只在已知稳定的平台上使用硬件解码
+   engine().setBackendProperty("hwdec", "auto-safe");
+
+   still->setAlignment(Qt::AlignCenter);
+   still->setAutoFillBackground(true);
+   QPalette stillPalette = still->palette();
+   stillPalette.setColor(QPalette::Window, Qt::black);
+   still->setPalette(stillPalette);
+   still->hide();
+
+   // 播放进度变化说明已经输出了画面
+   connect(&engine(), &dmr::PlayerEngine::elapsedChanged, this, [this] {
+       if (engine().elapsed() > 0)
+           hideStill();
+   });
+}
+
+/*!
+ * \brief VideoWidget::acquire 取得空闲的播放器，没有时创建新的播放器
+ */
+VideoWidget *VideoWidget::acquire(VideoPreview *preview)
+{
+   VideoWidget *widget = idleVideoWidget.data();
+
+   if (!widget)
+       return new VideoWidget(preview);
+
+   idleVideoWidget.clear();
+   widget->p = preview;
+
+   return widget;
+}
+
+/*!
+ * \brief VideoWidget::release 预览不再使用播放器时停止播放，并留作下次预览使用
+ */
+void VideoWidget::release()
+{
+   engine().stop();
+   hideStill();
+   title->clear();
+   hide();
+   setParent(nullptr);
+   p = nullptr;
+
+   if (idleVideoWidget) {
+       deleteLater();
+       return;
+   }
+
+   idleVideoWidget = this;
+
+   static bool cleanup = [] {
+       qAddPostRoutine([] {
+           delete idleVideoWidget.data();
+       });
+
+       return true;
+   }();
+   Q_UNUSED(cleanup)
+}
+
+void VideoWidget::showStill(const QPixmap &pixmap)
+{
+   stillPixmap = pixmap;
+
+   if (stillPixmap.isNull()) {
+       hideStill();
+       return;
+   }
+
+   still->setGeometry(rect());
+   still->setPixmap(stillPixmap.scaled(size(), Qt::KeepAspectRatio, Qt::SmoothTransformation));
+   still->show();
+   still->raise();
+   title->raise();
+}
+
+void VideoWidget::hideStill()
+{
+   if (stillPixmap.isNull() && still->isHidden())
+       return;
+
+   stillPixmap = QPixmap();
+   still->clear();
+   still->hide();
 }
 
 QSize VideoWidget::sizeHint() const
 {
+   if (!p)
+       return dmr::PlayerWidget::sizeHint();
+
    QSize screen_size;
 
    if (window()->windowHandle()) {
@@ -41,7 +137,18 @@ QSize VideoWidget::sizeHint() const
 
 void VideoWidget::mouseReleaseEvent(QMouseEvent *event)
 {
-   p->pause();
+   if (p)
+       p->pause();
 
    dmr::PlayerWidget::mouseReleaseEvent(event);
 }
+
+void VideoWidget::resizeEvent(QResizeEvent *event)
+{
+   dmr::PlayerWidget::resizeEvent(event);
+
+   if (!stillPixmap.isNull()) {
+       still->setGeometry(rect());
+       still->setPixmap(stillPixmap.scaled(size(), Qt::KeepAspectRatio, Qt::SmoothTransformation));
+   }
+}
@@ -10,6 +10,7 @@
 #include <danchors.h>
 
 #include <QLabel>
+#include <QPixmap>
 
 class VideoPreview;
 
@@ -18,12 +19,22 @@ class VideoWidget : public dmr::PlayerWidget
 public:
     explicit VideoWidget(VideoPreview *preview);
 
+    static VideoWidget *acquire(VideoPreview *preview);
+    void release();
+
+    void showStill(const QPixmap &pixmap);
+    void hideStill();
+
     QSize sizeHint() const override;
 
     void mouseReleaseEvent(QMouseEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
 
     VideoPreview *p;
     QLabel *title;
+    // 播放器开始输出画面前显示的首帧缩略图
+    QLabel *still;
+    QPixmap stillPixmap;
 };
 
 #endif // PLAYERWIDGET_H
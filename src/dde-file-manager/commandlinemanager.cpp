@@ -55,6 +55,8 @@ void CommandLineManager::initOptions()
                                         "directory");
     QCommandLineOption openWithDialog(QStringList() << "o" << "open", "open with dialog");
     QCommandLineOption openHomeOption(QStringList() << "O" << "open-home", "open home");
+    QCommandLineOption startupProfileOption(QStringList() << "startup-profile",
+                                            "print the startup phase timing as json after the first window is painted, then quit");
 
     addOption(newWindowOption);
     addOption(backendOption);
@@ -67,6 +69,7 @@ void CommandLineManager::initOptions()
     addOption(workingDirOption);
     addOption(openWithDialog);
     addOption(openHomeOption);
+    addOption(startupProfileOption);
 }
 
 void CommandLineManager::addOption(const QCommandLineOption &option)
@@ -31,6 +31,7 @@
 #include "shutil/fileutils.h"
 #include "utils/utils.h"
 #include "utils/rlog/rlog.h"
+#include "interfaces/dfmstartupprofile.h"
 #include "app/filesignalmanager.h"
 
 #include "tag/tagmanager.h"
@@ -42,6 +43,9 @@
 #include <QFileSystemWatcher>
 #include <QProcess>
 
+// 启动后一直没有绘制文件列表时，超过此时间（毫秒）上报已记录的启动阶段
+#define STARTUP_PROFILE_TIMEOUT 10000
+
 class FileManagerAppGlobal : public FileManagerApp {};
 Q_GLOBAL_STATIC(FileManagerAppGlobal, fmaGlobal)
 
@@ -70,9 +74,7 @@ void FileManagerApp::initApp()
 
     /*add plugin path*/
     DFMGlobal::autoLoadDefaultPlugins();
-
-    /*init plugin manager */
-    DFMGlobal::initPluginManager();
+    DFMStartupProfile::mark("plugins");
 
     /*init searchHistoryManager */
     DFMGlobal::initSearchHistoryManager();
@@ -94,9 +96,11 @@ void FileManagerApp::initApp()
 
     /*init fileService */
     DFMGlobal::initFileService();
+    DFMStartupProfile::mark("controllers");
 
     /*init deviceListener */
     DFMGlobal::initDeviceListener();
+    DFMStartupProfile::mark("udiskListener");
 
     /*init mimeAppsManager*/
     DFMGlobal::initMimesAppsManager();
@@ -107,21 +111,12 @@ void FileManagerApp::initApp()
     /*init mimeTypeDisplayManager */
     DFMGlobal::initMimeTypeDisplayManager();
 
-    /*init networkManager */
-    DFMGlobal::initNetworkManager();
-
     /*init gvfsMountManager */
     DFMGlobal::initGvfsMountManager();
 
-    /*init secretManger */
-    DFMGlobal::initSecretManager();
-
     /*init userShareManager */
     DFMGlobal::initUserShareManager();
 
-    /*init controllers for different scheme*/
-    fileService->initHandlersByCreators();
-
     /*init operator revocation*/
     DFMGlobal::initOperatorRevocation();
 
@@ -130,9 +125,6 @@ void FileManagerApp::initApp()
     /*init thumbnail connection*/
     DFMGlobal::initThumbnailConnection();
 
-    /*init bluetooth manager*/
-    DFMGlobal::initBluetoothManager();
-
     /*init rootfile manager*/
     DFMGlobal::initRootFileManager();
 
@@ -142,6 +134,7 @@ void FileManagerApp::initApp()
     DFMGlobal::initRlogManager();
 
     QThreadPool::globalInstance()->setMaxThreadCount(MAX_THREAD_COUNT);
+    DFMStartupProfile::mark("services");
 }
 
 void FileManagerApp::initView()
@@ -164,11 +157,12 @@ void FileManagerApp::lazyRunTask()
 {
     QTimer::singleShot(1500, initService);
 
-    // report app startup event
-    QTimer::singleShot(500, this, [=](){
-        QVariantMap data;
-        data.insert("type", true);
-        rlog->commit("AppStartup", data);
+    // 窗口显示后再初始化网络、蓝牙等非本地文件的服务
+    QTimer::singleShot(500, initNonLocalService);
+
+    // 启动事件在第一次绘制文件列表时随各阶段的耗时一起上报，没有窗口（-d）或一直没有绘制时超时后上报
+    QTimer::singleShot(STARTUP_PROFILE_TIMEOUT, this, [](){
+        DFMStartupProfile::finish();
     });
 }
 
@@ -196,6 +190,23 @@ void FileManagerApp::initService()
     }
 }
 
+/*!
+ * \brief FileManagerApp::initNonLocalService 初始化只有访问非本地文件时才需要的服务
+ *
+ * 各 scheme 的控制器、视图和预览插件在第一次使用时才创建或加载，启动时只访问 file://。
+ */
+void FileManagerApp::initNonLocalService()
+{
+    /*init networkManager */
+    DFMGlobal::initNetworkManager();
+
+    /*init secretManger */
+    DFMGlobal::initSecretManager();
+
+    /*init bluetooth manager*/
+    DFMGlobal::initBluetoothManager();
+}
+
 void FileManagerApp::show(const DUrl &url)
 {
     m_windowManager->showNewWindow(url);
@@ -28,6 +28,7 @@ public:
     void initManager();
     void initTranslation();
     static void initService();
+    static void initNonLocalService();
 
 private:
     void initApp();
@@ -31,7 +31,9 @@
 #include "accessible/accessiblelist.h"
 #include "dfmapplication.h"
 #include "views/dfilemanagerwindow.h"
+#include "views/windowmanager.h"
 #include "rlog/rlog.h"
+#include "dfmstartupprofile.h"
 
 #include <QApplication>
 #include <QDebug>
@@ -42,8 +44,10 @@
 #include <QLocalSocket>
 #include <QPixmapCache>
 #include <QSurfaceFormat>
+#include <QTimer>
 
 #include <pwd.h>
+#include <malloc.h>
 #include <DApplicationSettings>
 #include <QtConcurrent>
 #include <QMediaPlayer>
@@ -59,6 +63,9 @@
 
 #define fileManagerApp FileManagerApp::instance()
 
+// 后台驻留进程初始化完成后，等待异步初始化结束再回收内存（毫秒）
+#define RESIDENT_TRIM_MEMORY_DELAY 10000
+
 // blumia: DDE not yet got fully support about session management, so when logout or shutdown,
 //         the config file won't save. On mips64el, sw, arm, there will be a "warm-up" process
 //         running in the background (dde-file-manager -d) and the file manager instance will
@@ -115,10 +122,29 @@ void handleEnvOfOpenAsAdmin()
     }
 }
 
+/*!
+ * \brief trimIdleMemory 后台驻留进程（-d）在打开窗口前一直空闲，初始化过程中产生的缓存和空闲堆内存归还给系统
+ */
+static void trimIdleMemory()
+{
+    if (!WindowManager::instance()->getWindows().isEmpty())
+        return;
+
+    QPixmapCache::clear();
+#ifdef ENABLE_JEMALLOC
+    const QByteArray &purge = "arena." + QByteArray::number(MALLCTL_ARENAS_ALL) + ".purge";
+    mallctl(purge.constData(), nullptr, nullptr, nullptr, 0);
+#else
+    malloc_trim(0);
+#endif
+}
+
 DWIDGET_USE_NAMESPACE
 
 int main(int argc, char *argv[])
 {
+    DFMStartupProfile::start();
+
 #ifdef ENABLE_JEMALLOC
     // fix bug 89285
     // 设置background_thread=true，让jemalloc后台回收脏数据
@@ -195,6 +221,8 @@ int main(int argc, char *argv[])
 
     LogUtil::registerLogger();
     CommandLineManager::instance()->process();
+    DFMStartupProfile::setPrintEnabled(CommandLineManager::instance()->isSet("startup-profile"));
+    DFMStartupProfile::mark("application");
 
     //使用异步加载win相关的插件
     auto windPluginLoader = QtConcurrent::run([]() {
@@ -218,6 +246,7 @@ int main(int argc, char *argv[])
     // init application object
     DFMApplication fmApp;
     Q_UNUSED(fmApp)
+    DFMStartupProfile::mark("dfmApplication");
 
     // init pixmap cache size limit, 20MB * devicePixelRatio
     QPixmapCache::setCacheLimit(static_cast<int>(20 * 1024 * app.devicePixelRatio()));
@@ -269,6 +298,7 @@ int main(int argc, char *argv[])
         qInfo() << "RLog init start!";
         rlog->init();
         qInfo() << "RLog init finished!";
+        DFMStartupProfile::mark("singleInstance");
 
         // init app
         Q_UNUSED(FileManagerApp::instance())
@@ -280,6 +310,7 @@ int main(int argc, char *argv[])
         if (CommandLineManager::instance()->isSet("d")) {
             fileManagerApp;
             app.setQuitOnLastWindowClosed(true);
+            QTimer::singleShot(RESIDENT_TRIM_MEMORY_DELAY, &app, &trimIdleMemory);
         } else {
             CommandLineManager::instance()->processCommand();
         }
@@ -75,3 +75,24 @@ char *toBase64(const unsigned char *data, int size, int options)
 
     return tmp;
 }
+
+bool readRequest(std::istream &input, int *size, std::string *path)
+{
+    size_t length = 0;
+
+    if (!(input >> *size >> length) || input.get() != '\n')
+        return false;
+
+    path->assign(length, '\0');
+
+    return length == 0 || input.read(&(*path)[0], static_cast<std::streamsize>(length));
+}
+
+std::string formatResponse(int status, const char *data)
+{
+    std::stringstream stream;
+
+    stream << status << ' ' << strlen(data) << '\n' << data;
+
+    return stream.str();
+}
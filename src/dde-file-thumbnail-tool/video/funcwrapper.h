@@ -5,6 +5,9 @@
 #ifndef FUNCWRAPPER_H
 #define FUNCWRAPPER_H
 
+#include <istream>
+#include <string>
+
 enum Base64Option {
     Base64Encoding = 0,
     Base64UrlEncoding = 1,
@@ -15,5 +18,9 @@ enum Base64Option {
 
 char *toBase64(const unsigned char *data, int size, int options);
 
+// 常驻模式的协议：请求为"尺寸 路径长度\n路径"，回复为"状态 数据长度\n数据"，状态为0时数据为base64编码的png图片，否则为错误信息
+bool readRequest(std::istream &input, int *size, std::string *path);
+std::string formatResponse(int status, const char *data);
+
 #endif // FUNCWRAPPER_H
 
@@ -10,8 +10,57 @@
 #include <sstream>
 #include <cstring>
 
+#include <unistd.h>
+
+// 常驻模式：从标准输入依次读取请求，复用已加载的库处理多个文件，避免每个文件都启动一次进程
+static int runServer()
+{
+    // 协议数据使用原标准输出，库输出到标准输出的信息转到标准错误，避免与协议数据混在一起
+    int protocolFd = dup(STDOUT_FILENO);
+
+    if (protocolFd < 0 || dup2(STDERR_FILENO, STDOUT_FILENO) < 0)
+        return -1;
+
+    FILE *output = fdopen(protocolFd, "w");
+
+    if (!output)
+        return -1;
+
+    ffmpegthumbnailer::VideoThumbnailer vt(0, false, true, 20, false);
+    int size = 0;
+    std::string path;
+
+    while (readRequest(std::cin, &size, &path)) {
+        std::string response;
+
+        try {
+            std::vector<uint8_t> imageData;
+
+            vt.setThumbnailSize(size);
+            vt.generateThumbnail(path, ThumbnailerImageTypeEnum::Png, imageData);
+
+            char *base64_data = toBase64(imageData.data(), static_cast<int>(imageData.size()), Base64Encoding);
+            response = formatResponse(0, base64_data);
+            delete[] base64_data;
+        } catch (std::exception &e) {
+            response = formatResponse(1, e.what());
+        }
+
+        if (fwrite(response.data(), 1, response.size(), output) != response.size() || fflush(output) != 0)
+            break;
+    }
+
+    fclose(output);
+
+    return 0;
+}
+
 int main(int argc, char *argv[])
 {
+    if (argc == 2 && strcmp(argv[1], "--server") == 0) {
+        return runServer();
+    }
+
     if (argc != 3) {
         return -1;
     }
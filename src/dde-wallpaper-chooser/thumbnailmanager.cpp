@@ -13,34 +13,52 @@
 #include <QUrl>
 #include <QtConcurrent>
 #include <QImageReader>
+#include <QFileInfo>
 
-static QPixmap ThumbnailImage(const QString &path, qreal scale)
+static constexpr int MAXRUNNINGREQUESTS{ 4 };
+
+//! 在线程中执行，只使用 QImage
+static QImage ThumbnailImage(const QString &path, const QString &cacheFile, qreal scale)
 {
     QUrl url = QUrl::fromPercentEncoding(path.toUtf8());
     QString realPath = url.toLocalFile();
 
-    ThumbnailManager * tnm = ThumbnailManager::instance(scale);
-
     const qreal ratio = scale;
 
+    // 缓存比壁纸新时直接使用
+    const QFileInfo cacheInfo(cacheFile);
+    if (cacheInfo.exists() && cacheInfo.lastModified() >= QFileInfo(realPath).lastModified()) {
+        QImage image(cacheFile);
+        if (!image.isNull()) {
+            image.setDevicePixelRatio(ratio);
+            return image;
+        }
+    }
+
+    const QSize size(static_cast<int>(ItemWidth * ratio), static_cast<int>(ItemHeight * ratio));
+
     QImageReader imageReader(realPath);
     imageReader.setDecideFormatFromContent(true);
-    QImage image = imageReader.read();
+    // 直接按缩略图的大小解码，不必完整解码大尺寸的壁纸
+    const QSize imageSize = imageReader.size();
+    if (imageSize.isValid())
+        imageReader.setScaledSize(imageSize.scaled(size, Qt::KeepAspectRatioByExpanding));
 
-    QPixmap pix = QPixmap::fromImage(image.scaled(QSize(static_cast<int>(ItemWidth * ratio), static_cast<int>(ItemHeight * ratio)),
-                                                             Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation));
-
-    const QRect r(0, 0, static_cast<int>(ItemWidth * ratio), static_cast<int>(ItemHeight * ratio));
-    const QSize size(static_cast<int>(ItemWidth * ratio), static_cast<int>(ItemHeight * ratio));
+    QImage image = imageReader.read();
+    if (image.isNull())
+        return image;
 
-    if (pix.width() > ItemWidth * ratio || pix.height() > ItemHeight * ratio)
-        pix = pix.copy(QRect(pix.rect().center() - r.center(), size));
+    image = image.scaled(size, Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
 
-    pix.setDevicePixelRatio(ratio);
+    const QRect r(0, 0, size.width(), size.height());
+    if (image.width() > size.width() || image.height() > size.height())
+        image = image.copy(QRect(image.rect().center() - r.center(), size));
 
-    tnm->replace(path, pix);
+    QFile::remove(cacheFile);
+    image.save(cacheFile);
 
-    return pix;
+    image.setDevicePixelRatio(ratio);
+    return image;
 }
 
 ThumbnailManager::ThumbnailManager(qreal scale)
@@ -50,15 +68,20 @@ ThumbnailManager::ThumbnailManager(qreal scale)
     const QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
     m_cacheDir = cacheDir + QDir::separator() + qApp->applicationVersion() + QDir::separator() + QString::number(scale);
 
-    connect(&m_futureWatcher, &QFutureWatcher<QPixmap>::finished, this, &ThumbnailManager::onProcessFinished, Qt::QueuedConnection);
-
     QDir::root().mkpath(m_cacheDir);
 }
 
 ThumbnailManager::~ThumbnailManager()
 {
-    if (!m_queuedRequests.isEmpty())
-        emit findAborted(m_queuedRequests);
+    QQueue<QString> aborted;
+    for (QFutureWatcher<QImage> *watcher : m_runningRequests.keys()) {
+        if (!watcher->isCanceled())
+            aborted << m_runningRequests.value(watcher);
+    }
+    aborted << m_queuedRequests;
+
+    if (!aborted.isEmpty())
+        emit findAborted(aborted);
 }
 
 void ThumbnailManager::clear()
@@ -70,19 +93,18 @@ void ThumbnailManager::clear()
 
 void ThumbnailManager::find(const QString &key)
 {
-    QString file = QDir(m_cacheDir).absoluteFilePath(key);
-    const QPixmap pixmap(file);
-    if (!pixmap.isNull())
-    {
-        emit thumbnailFounded(key, pixmap);
+    // 列表每次滚动都会重新查找显示的壁纸，已在生成的不再排队
+    if (m_queuedRequests.contains(key))
         return;
+
+    for (auto it = m_runningRequests.cbegin(); it != m_runningRequests.cend(); ++it) {
+        if (it.value() == key && !it.key()->isCanceled())
+            return;
     }
 
+    // 读取缓存也在线程中进行
     m_queuedRequests << key;
-
-    // first item, start
-    if (m_queuedRequests.size() == 1)
-        processNextReq();
+    processNextReq();
 }
 
 void ThumbnailManager::remove(const QString &key)
@@ -105,7 +127,8 @@ bool ThumbnailManager::replace(const QString &key, const QPixmap &pixmap)
 
 void ThumbnailManager::stop()
 {
-    m_futureWatcher.cancel();
+    for (QFutureWatcher<QImage> *watcher : m_runningRequests.keys())
+        watcher->cancel();
     m_queuedRequests.clear();
 }
 
@@ -128,22 +151,26 @@ ThumbnailManager *ThumbnailManager::instance(qreal scale)
 
 void ThumbnailManager::processNextReq()
 {
-    Q_ASSERT(m_futureWatcher.isFinished());
+    while (m_runningRequests.size() < MAXRUNNINGREQUESTS && !m_queuedRequests.isEmpty()) {
+        const QString item = m_queuedRequests.dequeue();
 
-    const QString &item = m_queuedRequests.front();
+        auto watcher = new QFutureWatcher<QImage>(this);
+        connect(watcher, &QFutureWatcher<QImage>::finished, this, &ThumbnailManager::onProcessFinished, Qt::QueuedConnection);
+        m_runningRequests.insert(watcher, item);
 
-    QFuture<QPixmap> future = QtConcurrent::run(ThumbnailImage, item, m_scale);
-    m_futureWatcher.setFuture(future);
+        QFuture<QImage> future = QtConcurrent::run(ThumbnailImage, item, QDir(m_cacheDir).absoluteFilePath(item), m_scale);
+        watcher->setFuture(future);
+    }
 }
 
 void ThumbnailManager::onProcessFinished()
 {
-    if (m_futureWatcher.isCanceled()) return;
-
-    emit thumbnailFounded(m_queuedRequests.front(), m_futureWatcher.result());
+    auto watcher = static_cast<QFutureWatcher<QImage> *>(sender());
+    const QString item = m_runningRequests.take(watcher);
+    watcher->deleteLater();
 
-    m_queuedRequests.pop_front();
+    if (!watcher->isCanceled())
+        emit thumbnailFounded(item, QPixmap::fromImage(watcher->result()));
 
-    if (!m_queuedRequests.isEmpty())
-        processNextReq();
+    processNextReq();
 }
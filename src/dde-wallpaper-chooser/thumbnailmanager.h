@@ -9,6 +9,7 @@
 #include <QQueue>
 #include <QFutureWatcher>
 #include <QPixmap>
+#include <QHash>
 
 class ThumbnailManager : public QObject
 {
@@ -38,9 +39,10 @@ private slots:
     void onProcessFinished();
 
 private:
+    //! 等待生成的缩略图，同时生成的数量有限，超出的排队
     QQueue<QString> m_queuedRequests;
+    QHash<QFutureWatcher<QImage> *, QString> m_runningRequests;
     QString m_cacheDir;
-    QFutureWatcher<QPixmap> m_futureWatcher;
     qreal m_scale;
 };
 
@@ -7,10 +7,23 @@
 #include <tag/tagmanager.h>
 #include <shutil/danythingmonitorfilter.h>
 
+//! 合并事件的时间窗口(毫秒)
+static constexpr int FLUSH_INTERVAL{ 500 };
+//! 合并的事件达到此数量时立即提交，避免单次请求过大超时
+static constexpr int MAX_PENDING_EVENTS{ 4096 };
+
 TagHandle::TagHandle(QObject *const parent)
 : DASInterface{ parent } 
 {
+    m_flushTimer.setSingleShot(true);
+    m_flushTimer.setInterval(FLUSH_INTERVAL);
+
+    QObject::connect(&m_flushTimer, &QTimer::timeout, this, &TagHandle::flushPendingEvents);
+}
 
+TagHandle::~TagHandle()
+{
+    flushPendingEvents();
 }
 
 void TagHandle::onFileCreate(const QByteArrayList &files)
@@ -23,19 +36,27 @@ void TagHandle::onFileCreate(const QByteArrayList &files)
 void TagHandle::onFileDelete(const QByteArrayList &files)
 {
     if (!files.isEmpty()) {
-        QList<DUrl> url_list{};
+
+        // 删除须在之前的重命名之后提交
+        if (!m_pendingRenamedFiles.isEmpty()) {
+            flushPendingEvents();
+        }
 
         for (const QByteArray &byte_array : files) {
             bool result{ DAnythingMonitorFilter::instance()->whetherFilterCurrentPath(byte_array) };
 
             if (result) {
                 DUrl url{ DUrl::fromLocalFile(byte_array) };
-                url_list.push_back(url);
+                m_pendingDeletedFiles.push_back(url);
             }
 
         }
 
-        TagManager::deleteFiles(url_list);
+        if (m_pendingDeletedFiles.size() >= MAX_PENDING_EVENTS) {
+            flushPendingEvents();
+        } else if (!m_pendingDeletedFiles.isEmpty() && !m_flushTimer.isActive()) {
+            m_flushTimer.start();
+        }
     }
 }
 
@@ -44,12 +65,61 @@ void TagHandle::onFileRename(const QList<QPair<QByteArray, QByteArray>> &files)
 {
     if (!files.isEmpty()) {
 
+        if (!m_pendingDeletedFiles.isEmpty()) {
+            flushPendingEvents();
+        }
+
         for (const QPair<QByteArray, QByteArray> &names : files) {
             bool result{ DAnythingMonitorFilter::instance()->whetherFilterCurrentPath(names.second) };
 
             if (result) {
-                TagManager::changeFilesName({ names });
+                // 服务按旧的文件名排序处理一次请求中的重命名，有先后依赖的重命名分开提交
+                if (isRenameConflicted(names.first, names.second)) {
+                    flushPendingEvents();
+                }
+
+                m_pendingRenamedFiles.push_back(names);
             }
         }
+
+        if (m_pendingRenamedFiles.size() >= MAX_PENDING_EVENTS) {
+            flushPendingEvents();
+        } else if (!m_pendingRenamedFiles.isEmpty() && !m_flushTimer.isActive()) {
+            m_flushTimer.start();
+        }
+    }
+}
+
+void TagHandle::flushPendingEvents()
+{
+    m_flushTimer.stop();
+
+    if (!m_pendingDeletedFiles.isEmpty()) {
+        TagManager::deleteFiles(m_pendingDeletedFiles);
+        m_pendingDeletedFiles.clear();
+    }
+
+    if (!m_pendingRenamedFiles.isEmpty()) {
+        // 目录中的文件由服务按路径前缀一并更新
+        TagManager::changeFilesName(m_pendingRenamedFiles);
+        m_pendingRenamedFiles.clear();
+    }
+}
+
+static bool isSameOrChildPath(const QByteArray &path, const QByteArray &parent)
+{
+    return path.startsWith(parent) && (path.size() == parent.size() || path.at(parent.size()) == '/');
+}
+
+bool TagHandle::isRenameConflicted(const QByteArray &oldName, const QByteArray &newName) const
+{
+    for (const QPair<QByteArray, QByteArray> &names : m_pendingRenamedFiles) {
+        if (isSameOrChildPath(oldName, names.second) || isSameOrChildPath(names.second, oldName)
+                || isSameOrChildPath(oldName, names.first) || isSameOrChildPath(names.first, oldName)
+                || isSameOrChildPath(newName, names.first) || isSameOrChildPath(names.first, newName)) {
+            return true;
+        }
     }
+
+    return false;
 }
@@ -6,6 +6,9 @@
 #define TAGHANDLE_H
 
 #include <dasinterface.h>
+#include <durl.h>
+
+#include <QTimer>
 
 
 using namespace DAS_NAMESPACE;
@@ -16,7 +19,7 @@ class TagHandle : public DASInterface
 
 public:
     explicit TagHandle(QObject *const parent = nullptr);
-    virtual ~TagHandle() = default;
+    virtual ~TagHandle();
 
     TagHandle(const TagHandle &other) = delete;
     TagHandle &operator=(const TagHandle &other) = delete;
@@ -25,6 +28,15 @@ public:
     virtual void onFileCreate(const QByteArrayList &files) override;
     virtual void onFileDelete(const QByteArrayList &files) override;
     virtual void onFileRename(const QList<QPair<QByteArray, QByteArray>> &files) override;
+
+private:
+    //! 一段时间内的事件合并为一次对标记数据库的更新，删除与重命名按照事件的顺序提交
+    void flushPendingEvents();
+    bool isRenameConflicted(const QByteArray &oldName, const QByteArray &newName) const;
+
+    QTimer m_flushTimer;
+    QList<DUrl> m_pendingDeletedFiles;
+    QList<QPair<QByteArray, QByteArray>> m_pendingRenamedFiles;
 };
 
 #endif // TAGHANDLE_H
@@ -15,17 +15,23 @@
 #include <QTimer>
 #include <QException>
 #include <QPainterPath>
+#include <QSocketNotifier>
+#include <QElapsedTimer>
 
 #include "app/define.h"
 #include "dfileservices.h"
 #include "dabstractfileinfo.h"
 #include "shutil/fileutils.h"
+#include "io/djobprogresschannel.h"
 
 DWIDGET_USE_NAMESPACE
 
 #define MSG_LABEL_WITH 350
 #define SPEED_LABEL_WITH 100
 #define PausedState 2
+#define QueuedState 5
+// 轮询共享内存进度的间隔(毫秒)
+#define PROGRESS_CHANNEL_POLL_INTERVAL 500
 
 DFMElidedLable::DFMElidedLable(QWidget *parent)
     : QLabel(parent)
@@ -90,6 +96,7 @@ private:
     QCheckBox *m_chkboxNotAskAgain;
     DIconButton *m_btnStop;
     DIconButton *m_btnPause;
+    DIconButton *m_btnBackground;
     QPushButton *m_btnCoexist;
     QPushButton *m_btnSkip;
     QPushButton *m_btnReplace;
@@ -99,6 +106,13 @@ private:
     bool m_isEnableHover;
     QAtomicInteger<bool> m_handlingError = false;
     QAtomicInteger<bool> m_isPauseState = false;
+    bool m_isBackgroundEnable = false;
+
+    QSharedPointer<DFM_NAMESPACE::DJobProgressChannel> m_progressChannel;
+    QTimer *m_progressChannelTimer = nullptr;
+    QSocketNotifier *m_progressStateNotifier = nullptr;
+    QElapsedTimer m_progressSpeedTimer;
+    qint64 m_lastProcessedBytes = 0;
 
     DFMTaskWidget *q_ptr;
     Q_DECLARE_PUBLIC(DFMTaskWidget)
@@ -266,9 +280,18 @@ void DFMTaskWidgetPrivate::initUI()
     m_btnPause->setFixedSize(24, 24);
     m_btnPause->setFlat(true);
 
-
+    // 后台模式：降低io优先级并限速
+    m_btnBackground = new DIconButton(q);
+    m_btnBackground->setIcon(QIcon::fromTheme("dfm_task_background"));
+    m_btnBackground->setIconSize({24, 24});
+    m_btnBackground->setFixedSize(24, 24);
+    m_btnBackground->setFlat(true);
+    m_btnBackground->setCheckable(true);
+    m_btnBackground->setToolTip(DFMTaskWidget::tr("Run in background"));
 
     normalLayout->addStretch();
+    normalLayout->addWidget(m_btnBackground, Qt::AlignRight);
+    normalLayout->addSpacing(10);
     normalLayout->addWidget(m_btnPause, Qt::AlignRight);
     normalLayout->addSpacing(10);
     normalLayout->addWidget(m_btnStop, Qt::AlignRight);
@@ -280,6 +303,7 @@ void DFMTaskWidgetPrivate::initUI()
 
     m_lbErrorMsg->setVisible(false);
     m_btnPause->setVisible(false);
+    m_btnBackground->setVisible(false);
     m_btnStop->setVisible(false);
     m_widConfict->setVisible(false);
     m_widButton->setVisible(false);
@@ -315,6 +339,9 @@ void DFMTaskWidgetPrivate::initConnection()
     QObject::connect(m_btnPause, &QPushButton::clicked, q, [q]() {
         emit q->butonClicked(DFMTaskWidget::PAUSE);
     });
+    QObject::connect(m_btnBackground, &QPushButton::clicked, q, [q]() {
+        emit q->butonClicked(DFMTaskWidget::BACKGROUND);
+    });
     QObject::connect(m_btnStop, &QPushButton::clicked, q, [q, this]() {
         m_widConfict->hide();
         m_widButton->hide();
@@ -478,6 +505,15 @@ void DFMTaskWidget::setHoverEnable(bool enable)
     d->m_isEnableHover = enable;
 }
 
+void DFMTaskWidget::setBackgroundEnable(bool enable)
+{
+    Q_D(DFMTaskWidget);
+    d->m_isBackgroundEnable = enable;
+    if (!enable) {
+        d->m_btnBackground->setVisible(false);
+    }
+}
+
 void DFMTaskWidget::hideButton(DFMTaskWidget::BUTTON bt, bool hidden/*=true*/)
 {
     Q_D(DFMTaskWidget);
@@ -510,6 +546,7 @@ void DFMTaskWidget::onMouseHover(bool hover)
     Q_D(DFMTaskWidget);
     if (d->m_isEnableHover) {
         d->m_btnPause->setVisible(hover);
+        d->m_btnBackground->setVisible(hover && d->m_isBackgroundEnable);
         d->m_btnStop->setVisible(hover);
 
         d->m_lbSpeed->setHidden(hover);
@@ -564,6 +601,9 @@ QAbstractButton *DFMTaskWidget::getButton(DFMTaskWidget::BUTTON bt)
     case CHECKBOX_NOASK:
         btn = d->m_chkboxNotAskAgain;
         break;
+    case BACKGROUND:
+        btn = d->m_btnBackground;
+        break;
     }
 
     return btn;
@@ -627,6 +667,54 @@ void DFMTaskWidget::paintEvent(QPaintEvent *event)
     QWidget::paintEvent(event);
 }
 
+void DFMTaskWidget::setProgressChannel(const QSharedPointer<DFM_NAMESPACE::DJobProgressChannel> &channel)
+{
+    Q_D(DFMTaskWidget);
+
+    delete d->m_progressChannelTimer;
+    d->m_progressChannelTimer = nullptr;
+    delete d->m_progressStateNotifier;
+    d->m_progressStateNotifier = nullptr;
+    d->m_progressChannel = channel;
+
+    if (!channel)
+        return;
+
+    d->m_lastProcessedBytes = 0;
+    d->m_progressSpeedTimer.start();
+
+    auto update = [this] {
+        Q_D(DFMTaskWidget);
+        const DFM_NAMESPACE::DJobProgressChannel::Snapshot &snapshot = d->m_progressChannel->snapshot();
+
+        if (snapshot.totalBytes > 0)
+            onProgressChanged(static_cast<qreal>(snapshot.processedBytes) / snapshot.totalBytes, snapshot.processedBytes);
+
+        const qint64 elapsed = d->m_progressSpeedTimer.restart();
+        if (elapsed > 0)
+            onSpeedUpdated((snapshot.processedBytes - d->m_lastProcessedBytes) * 1000 / elapsed);
+        d->m_lastProcessedBytes = snapshot.processedBytes;
+
+        if (!snapshot.currentFile.isEmpty())
+            d->m_lbSrcPath->setText(snapshot.currentFile);
+    };
+
+    d->m_progressChannelTimer = new QTimer(this);
+    d->m_progressChannelTimer->setInterval(PROGRESS_CHANNEL_POLL_INTERVAL);
+    connect(d->m_progressChannelTimer, &QTimer::timeout, this, update);
+    d->m_progressChannelTimer->start();
+
+    d->m_progressStateNotifier = new QSocketNotifier(channel->eventFd(), QSocketNotifier::Read, this);
+    connect(d->m_progressStateNotifier, &QSocketNotifier::activated, this, [this, update] {
+        Q_D(DFMTaskWidget);
+
+        if (d->m_progressChannel->takeStateEvents() > 0) {
+            onStateChanged(d->m_progressChannel->snapshot().state);
+            update();
+        }
+    });
+}
+
 void DFMTaskWidget::onProgressChanged(qreal progress, qint64 writeData)
 {
     Q_UNUSED(writeData);
@@ -658,6 +746,11 @@ void DFMTaskWidget::onSpeedUpdated(qint64 speed)
 void DFMTaskWidget::onStateChanged(int state)
 {
     Q_D(DFMTaskWidget);
+    //等待同一个磁盘上的其它任务完成
+    if (state == QueuedState) {
+        d->m_lbSpeed->setText(tr("Queued"));
+        d->m_lbRmTime->setText(tr("Waiting for other tasks on the same disk"));
+    }
     if ((PausedState == state) == d->m_isPauseState) {
         return;
     }
@@ -7,7 +7,13 @@
 #include <QAbstractButton>
 #include <QLabel>
 #include <QWidget>
+#include <QSharedPointer>
 #include <durl.h>
+#include <dfmglobal.h>
+
+DFM_BEGIN_NAMESPACE
+class DJobProgressChannel;
+DFM_END_NAMESPACE
 
 class DFMElidedLable : public QLabel
 {
@@ -29,7 +35,8 @@ public:
         SKIP,
         REPLACE,
         COEXIST,
-        CHECKBOX_NOASK
+        CHECKBOX_NOASK,
+        BACKGROUND
     };
     explicit DFMTaskWidget(QWidget *parent = nullptr);
     virtual ~DFMTaskWidget();
@@ -43,11 +50,15 @@ public:
     void setButtonText(BUTTON bt, const QString &text);
     void setHoverEnable(bool enable);
     void hideButton(BUTTON bt, bool hidden = true);
+    // 是否支持切换后台模式，只有文件拷贝任务支持
+    void setBackgroundEnable(bool enable);
     void setHandleingError(const bool &handleing);
     bool isHandleingError() const;
     QAbstractButton *getButton(BUTTON bt);
 
     void progressStart();
+    // 从守护进程任务的共享内存读取进度，按界面的刷新频率轮询，状态变化时立即更新
+    void setProgressChannel(const QSharedPointer<DFM_NAMESPACE::DJobProgressChannel> &channel);
 
 protected:
     void onMouseHover(bool hover);
@@ -360,6 +360,9 @@ DFileCopyMoveJob::Handle *DTaskDialog::addTaskJob(DFileCopyMoveJob *job, const b
     }
 
     wid->setTaskId(QString::number(quintptr(job), 16));
+    // 删除任务不需要后台模式
+    wid->setBackgroundEnable(job->targetUrl().isValid());
+    wid->getButton(DFMTaskWidget::BACKGROUND)->setChecked(job->isBackgroundMode());
 
     // 判断任务是否属于保险箱任务,如果是，记录到容器
     if (isHaveVaultTask(job->sourceUrlList(), job->targetUrl())) {
@@ -388,6 +391,10 @@ DFileCopyMoveJob::Handle *DTaskDialog::addTaskJob(DFileCopyMoveJob *job, const b
             emit job->togglePause();
             emit paused(job->sourceUrlList(), job->targetUrl());
             break;
+        case DFMTaskWidget::BACKGROUND:
+            job->setBackgroundMode(!job->isBackgroundMode());
+            wid->getButton(DFMTaskWidget::BACKGROUND)->setChecked(job->isBackgroundMode());
+            break;
         case DFMTaskWidget::STOP:
 
 //                this->closeEvent(&event);
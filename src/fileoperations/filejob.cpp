@@ -50,6 +50,7 @@
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QLibrary>
+#include <QtConcurrent>
 
 #include <fcntl.h>
 #include <unistd.h>
@@ -547,6 +548,8 @@ DUrlList FileJob::doMoveToTrash(const DUrlList &files)
 
     if (canNotMoveToTrashList.size() > 0) {
         emit requestCanNotMoveToTrashDialogShowed(canNotMoveToTrashList);
+    } else if (m_isInSameDisk) {
+        list = doMoveToTrashInBatch(files);
     } else {
         list = doMove(files, DUrl::fromLocalFile(DFMStandardPaths::location(DFMStandardPaths::TrashFilesPath)));
     }
@@ -3325,7 +3328,7 @@ bool FileJob::moveDirToTrash(const QString &dir, QString *targetPath)
     return true;
 }
 
-QString FileJob::getNotExistsTrashFileName(const QString &fileName)
+QString FileJob::getNotExistsTrashFileName(const QString &fileName, QSet<QString> *reservedNames)
 {
     QByteArray name = fileName.toUtf8();
 
@@ -3349,15 +3352,24 @@ QString FileJob::getNotExistsTrashFileName(const QString &fileName)
     QString trashpath = DFMStandardPaths::location(DFMStandardPaths::TrashFilesPath) + "/" ;
 
     while (true) {
-        QFileInfo info(trashpath + name + suffix);
-        // QFile::exists ==> If the file is a symlink that points to a non-existing file, false is returned.
-        if (!info.isSymLink() && !info.exists()) {
-            break;
+        //批量移动时使用预先读取的回收站文件名，不再逐个判断文件是否存在
+        if (reservedNames) {
+            if (!reservedNames->contains(QString::fromUtf8(name + suffix)))
+                break;
+        } else {
+            QFileInfo info(trashpath + name + suffix);
+            // QFile::exists ==> If the file is a symlink that points to a non-existing file, false is returned.
+            if (!info.isSymLink() && !info.exists()) {
+                break;
+            }
         }
 
         name = QCryptographicHash::hash(name, QCryptographicHash::Md5).toHex();
     }
 
+    if (reservedNames)
+        reservedNames->insert(QString::fromUtf8(name + suffix));
+
     return QString::fromUtf8(name + suffix);
 }
 
@@ -3407,27 +3419,166 @@ bool FileJob::writeTrashInfo(const QString &fileBaseName, const QString &path, c
         return false;
     }
 
+    // save the file tag info
+    const QStringList tag_name_list = TagManager::instance()->getTagsThroughFiles({DUrl::fromLocalFile(path)});
+    qint64 size = metadata.write(trashInfoData(path, time, tag_name_list));
+
+    metadata.close();
+
+    if (size < 0) {
+        qDebug() << "write file " << metadata.fileName() << "error:" << metadata.errorString();
+    }
+
+    return size > 0;
+}
+
+QByteArray FileJob::trashInfoData(const QString &path, const QString &time, const QStringList &tagNames)
+{
     QByteArray data;
 
     data.append("[Trash Info]\n");
     data.append("Path=").append(path.toUtf8().toPercentEncoding("/")).append("\n");
     data.append("DeletionDate=").append(time).append("\n");
 
-    // save the file tag info
-    const QStringList tag_name_list = TagManager::instance()->getTagsThroughFiles({DUrl::fromLocalFile(path)});
+    if (!tagNames.isEmpty())
+        data.append("TagNameList=").append(tagNames.join(",")).append("\n");
 
-    if (!tag_name_list.isEmpty())
-        data.append("TagNameList=").append(tag_name_list.join(",")).append("\n");
+    return data;
+}
 
-    qint64 size = metadata.write(data);
+DUrlList FileJob::doMoveToTrashInBatch(const DUrlList &files)
+{
+    qDebug() << "Do move to trash in batch is started" << files.size();
+    jobPrepared();
 
-    metadata.close();
+    m_noPermissonUrls.clear();
+    m_allCount = files.size();
+    m_finishedCount = 0;
+    m_isCanShowProgress = true;
 
-    if (size < 0) {
-        qDebug() << "write file " << metadata.fileName() << "error:" << metadata.errorString();
+    const QString &trashFilesPath = DFMStandardPaths::location(DFMStandardPaths::TrashFilesPath);
+    const QString &trashInfosPath = DFMStandardPaths::location(DFMStandardPaths::TrashInfosPath);
+
+    //一次读取回收站中已有的名称，为所有文件预留不重复的名称
+    QSet<QString> reservedNames;
+    for (const QString &name : QDir(trashFilesPath).entryList(QDir::AllEntries | QDir::Hidden | QDir::System | QDir::NoDotAndDotDot))
+        reservedNames << name;
+    for (const QString &name : QDir(trashInfosPath).entryList(QStringList("*.trashinfo"), QDir::Files | QDir::Hidden | QDir::System))
+        reservedNames << name.left(name.length() - int(strlen(".trashinfo")));
+
+    struct TrashItem {
+        int index;
+        QString srcPath;
+        QString targetPath;
+        QString infoPath;
+        bool ok;
+    };
+    QVector<TrashItem> items;
+    QStringList symlinks;
+    QVector<int> symlinkIndexes;
+    DUrlList list;
+    list.reserve(files.size());
+
+    const QString delTime = QDateTime::currentDateTime().toString(Qt::ISODate);
+
+    for (const DUrl &url : files) {
+        QString srcPath = url.toLocalFile();
+        if (srcPath.isEmpty() || m_isAborted)
+            continue;
+        const QFileInfo srcInfo(srcPath);
+        if (!srcInfo.exists() && !srcInfo.isSymLink())
+            continue;
+        if (VaultController::isVaultFile(srcPath)) { //! vault file could not move to trash
+            qDebug() << "vault file could not move to trash : " << srcPath;
+            continue;
+        }
+        if (url.path().startsWith(trashFilesPath))
+            continue;
+        if (!canMove(srcPath)) {
+            m_noPermissonUrls << url;
+            continue;
+        }
+        //链接文件需要重新创建，走以前的流程
+        if (srcInfo.isSymLink()) {
+            symlinks << srcPath;
+            symlinkIndexes << list.size();
+            list << DUrl();
+            continue;
+        }
+        if (!srcInfo.canonicalFilePath().isEmpty())
+            srcPath = srcInfo.canonicalFilePath();
+
+        const QString &baseName = getNotExistsTrashFileName(srcPath, &reservedNames);
+        items << TrashItem{list.size(), srcPath, trashFilesPath + "/" + baseName, trashInfosPath + "/" + baseName + ".trashinfo", false};
+        list << DUrl();
     }
 
-    return size > 0;
+    //所有文件的标记一次查询
+    DUrlList itemUrls;
+    for (const TrashItem &item : items)
+        itemUrls << DUrl::fromLocalFile(item.srcPath);
+    const QMap<DUrl, QStringList> &tagsOfEachFile = TagManager::instance()->getTagsOfEachFile(itemUrls);
+
+    //集中写入所有的trashinfo
+    for (TrashItem &item : items) {
+        QFile metadata(item.infoPath);
+        if (!metadata.open(QIODevice::WriteOnly)) {
+            qDebug() << metadata.fileName() << "file open error:" << metadata.errorString();
+            continue;
+        }
+        const QStringList &tagNames = tagsOfEachFile.value(DUrl::fromLocalFile(item.srcPath));
+        item.ok = metadata.write(trashInfoData(item.srcPath, delTime, tagNames)) > 0;
+        metadata.close();
+        if (!item.ok)
+            QFile::remove(item.infoPath);
+    }
+
+    if (!items.isEmpty())
+        m_trashFileName = items.first().srcPath;
+
+    //顶层文件之间相互独立，并行重命名
+    QtConcurrent::blockingMap(items, [this](TrashItem &item) {
+        if (!item.ok)
+            return;
+        item.ok = !m_isAborted && ::rename(item.srcPath.toLocal8Bit().constData(), item.targetPath.toLocal8Bit().constData()) == 0;
+    });
+
+    for (TrashItem &item : items) {
+        if (!item.ok && QFileInfo::exists(item.infoPath) && !m_isAborted) {
+            //重命名失败时和以前一样尝试使用mv
+            item.ok = QProcess::execute("mv -T \"" + item.srcPath.toUtf8() + "\" \"" + item.targetPath.toUtf8() + "\"") == 0;
+            if (!item.ok) {
+                qDebug() << "Unable to trash file:" << item.srcPath;
+                m_noPermissonUrls << DUrl::fromLocalFile(item.srcPath);
+            }
+        }
+        if (item.ok) {
+            list[item.index] = DUrl::fromLocalFile(item.targetPath);
+            ++m_finishedCount;
+        } else {
+            QFile::remove(item.infoPath);
+        }
+    }
+
+    for (int i = 0; i < symlinks.size() && !m_isAborted; ++i) {
+        QString targetPath;
+        handleSymlinkFile(symlinks.at(i), trashFilesPath, &targetPath);
+        if (!targetPath.isEmpty())
+            list[symlinkIndexes.at(i)] = DUrl::fromLocalFile(targetPath);
+        ++m_finishedCount;
+    }
+
+    if (!m_noPermissonUrls.isEmpty()) {
+        DFMUrlListBaseEvent noPermissionEvent(nullptr, m_noPermissonUrls);
+        noPermissionEvent.setWindowId(static_cast<quint64>(getWindowId()));
+        emit fileSignalManager->requestShowNoPermissionDialog(noPermissionEvent);
+    }
+    m_noPermissonUrls.clear();
+    m_finishedCount = 0;
+    m_allCount = 1;
+
+    qDebug() << "Do move to trash in batch is done" << items.size() + symlinks.size();
+    return list;
 }
 
 bool FileJob::checkDiskSpaceAvailable(const DUrlList &files, const DUrl &destination)
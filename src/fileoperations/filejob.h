@@ -7,6 +7,7 @@
 
 #include <QObject>
 #include <QMap>
+#include <QSet>
 #include <QElapsedTimer>
 #include <QUrl>
 #include "durl.h"
@@ -269,6 +270,9 @@ private:
     bool moveDirToTrash(const QString &dir, QString *targetPath = nullptr);
     bool moveFileToTrash(const QString &file, QString *targetPath = nullptr);
     bool writeTrashInfo(const QString &fileBaseName, const QString &path, const QString &time);
+    static QByteArray trashInfoData(const QString &path, const QString &time, const QStringList &tagNames);
+    //同一个磁盘上批量移动到回收站，先为所有文件预留名称并写入trashinfo，再并行重命名
+    DUrlList doMoveToTrashInBatch(const DUrlList &files);
 
     //check disk space available before do copy/move job
     bool checkDiskSpaceAvailable(const DUrlList &files, const DUrl &destination);
@@ -278,7 +282,7 @@ private:
 
     bool checkFat32FileOutof4G(const QString &srcFile, const QString &tarDir);
 
-    QString getNotExistsTrashFileName(const QString &fileName);
+    QString getNotExistsTrashFileName(const QString &fileName, QSet<QString> *reservedNames = nullptr);
     bool checkUseGvfsFileOperation(const DUrlList &files, const DUrl &destination);
     bool checkUseGvfsFileOperation(const QString &path);
 
@@ -12,6 +12,7 @@
 #include <QJsonObject>
 #include <QTimer>
 #include <QDir>
+#include <QDateTime>
 #include <QDebug>
 
 #include <unistd.h>
@@ -182,6 +183,56 @@ void UserShareManager::startSambaServiceAsync()
     QObject::connect(watcher, &QDBusPendingCallWatcher::finished, this, &UserShareManager::callFinishedSlot);
 }
 
+/*!
+ * \brief UserShareManager::startNetUsershareAsync 异步执行 net usershare，不阻塞界面。
+ * 执行完成后共享目录的文件变化会触发 updateUserShareInfo 更新共享信息
+ */
+void UserShareManager::startNetUsershareAsync(const QStringList &args)
+{
+    QProcess *process = new QProcess(this);
+
+    connect(process, static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
+            process, [process](int exitCode) {
+        if (exitCode != 0)
+            qWarning() << "net usershare failed:" << process->arguments() << process->readAllStandardError();
+        process->deleteLater();
+    });
+    connect(process, &QProcess::errorOccurred, process, [process](QProcess::ProcessError error) {
+        // 启动失败时不会发出 finished 信号
+        if (error == QProcess::FailedToStart) {
+            qWarning() << "net usershare failed to start:" << process->errorString();
+            process->deleteLater();
+        }
+    });
+    process->start("net", QStringList() << "usershare" << args);
+}
+
+QMap<QString, QString> UserShareManager::parseUserShareFile(const QString &filePath)
+{
+    QMap<QString, QString> info;
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qDebug() << "Readonly" << filePath << "failed";
+        return info;
+    }
+    QTextStream in(&file);
+    while (!in.atEnd()) {
+        // Read new line
+        QString line = in.readLine();
+        // Skip empty line or line with invalid format
+        if (line.trimmed().isEmpty()) {
+            continue;
+        }
+        if (line.contains("=")) {
+            int index = line.indexOf("=");
+            QString key = line.mid(0, index);
+            QString value = line.mid(index + 1);
+            info.insert(key, value);
+        }
+    }
+    return info;
+}
+
 void UserShareManager::writeCacheToFile(const QString &path, const QString &content)
 {
     QFile file(path);
@@ -285,30 +336,20 @@ void UserShareManager::updateUserShareInfo(bool sendSignal)
     QDir d(UserSharePath());
     // 修复BUG-46217 增加筛选条件，将以"."开头的文件筛选出来
     QFileInfoList infolist = d.entryInfoList(QDir::Files | QDir::Hidden);
+    QHash<QString, UserShareFileCache> fileCache;
     foreach (const QFileInfo &f, infolist) {
         ShareInfo shareInfo;
-        QMap<QString, QString> info;
         QString fpath = f.absoluteFilePath();
-        QFile file(fpath);
-        if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-            qDebug() << "Readonly" << fpath << "failed";
-            return;
-        }
-        QTextStream in(&file);
-        while (!in.atEnd()) {
-            // Read new line
-            QString line = in.readLine();
-            // Skip empty line or line with invalid format
-            if (line.trimmed().isEmpty()) {
-                continue;
-            }
-            if (line.contains("=")) {
-                int index = line.indexOf("=");
-                QString key = line.mid(0, index);
-                QString value = line.mid(index + 1);
-                info.insert(key, value);
-            }
+        // 只重新读取新增或有修改的共享文件
+        UserShareFileCache cache = m_userShareFiles.value(fpath);
+        const qint64 lastModified = f.lastModified().toMSecsSinceEpoch();
+        if (cache.lastModified != lastModified || cache.size != f.size()) {
+            cache.lastModified = lastModified;
+            cache.size = f.size();
+            cache.fields = parseUserShareFile(fpath);
         }
+        fileCache.insert(fpath, cache);
+        const QMap<QString, QString> &info = cache.fields;
         QString shareName = info.value("sharename").toLower();
         QString sharePath = info.value("path");
         QString share_acl = info.value("usershare_acl");
@@ -339,6 +380,8 @@ void UserShareManager::updateUserShareInfo(bool sendSignal)
             }
         }
     }
+    // 已删除的共享文件随之从缓存中移除
+    m_userShareFiles = fileCache;
 
     foreach (ShareInfo info, m_shareInfos.values()) {
         if (info.isValid() && !oldShareInfos.contains(info.shareName())) {
@@ -498,13 +541,7 @@ void UserShareManager::removeFiledeleteUserShareByPath(const QString &path)
     if (shareName.isEmpty()) {
         return;
     }
-    QString cmd = "net";
-    QStringList args;
-    args << "usershare" << "delete"
-         << shareName;
-    QProcess p;
-    p.start(cmd, args);
-    p.waitForFinished();
+    startNetUsershareAsync(QStringList() << "delete" << shareName);
 }
 
 void UserShareManager::onFileDeleted(const QString &filePath)
@@ -570,11 +607,5 @@ void UserShareManager::deleteUserShareByShareName(const QString &shareName)
         return;
     }
 
-    QString cmd = "net";
-    QStringList args;
-    args << "usershare" << "delete"
-         << shareName;
-    QProcess p;
-    p.start(cmd, args);
-    p.waitForFinished();
+    startNetUsershareAsync(QStringList() << "delete" << shareName);
 }
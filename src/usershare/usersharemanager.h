@@ -6,6 +6,7 @@
 #define USERSHAREMANAGER_H
 
 #include <QObject>
+#include <QHash>
 
 #include "dfmglobal.h"
 #include "shareinfo.h"
@@ -80,7 +81,15 @@ private:
     void saveUserShareInfoPathNames();
     void updateFileAttributeInfo(const QString &filePath) const;
     void startSambaServiceAsync();
+    void startNetUsershareAsync(const QStringList &args);
+    static QMap<QString, QString> parseUserShareFile(const QString &filePath);
 
+    // 共享目录中每个文件解析后的内容，文件没有变化时不再重新读取
+    struct UserShareFileCache {
+        qint64 lastModified = -1;
+        qint64 size = -1;
+        QMap<QString, QString> fields;
+    };
 
     DFileWatcherManager *m_fileMonitor = NULL;
     QTimer* m_shareInfosChangedTimer = NULL;
@@ -88,6 +97,7 @@ private:
     QMap<QString, ShareInfo> m_shareInfos = {};
     QMap<QString, QString> m_sharePathByFilePath = {};
     QMap<QString, QStringList> m_sharePathToNames = {};
+    QHash<QString, UserShareFileCache> m_userShareFiles;
     UserShareInterface* m_userShareInterface = NULL;
     ShareInfo m_currentInfo;
 };
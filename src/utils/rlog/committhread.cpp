@@ -8,6 +8,13 @@
 #include <QJsonObject>
 #include <QJsonDocument>
 #include <QApplication>
+#include <QTimer>
+
+// 批量写入的间隔（毫秒）和每批的数量，达到数量时立即写入
+#define RLOG_BATCH_INTERVAL 2000
+#define RLOG_BATCH_SIZE 64
+// 等待写入的数据上限，超出后丢弃
+#define RLOG_QUEUE_MAX 1024
 
 CommitLog::CommitLog(QObject *parent)
     : QObject(parent)
@@ -16,19 +23,86 @@ CommitLog::CommitLog(QObject *parent)
 
 CommitLog::~CommitLog()
 {
+    // 在提交线程结束时析构，写完队列中剩余的数据
+    flush();
+
     if (m_library.isLoaded())
         m_library.unload();
     qInfo() << " - destroyed";
 }
 
-void CommitLog::commit(const QVariant &args)
+/*!
+ * \brief CommitLog::setCommonData 设置每条数据都要附带的公共字段，必须在移动到提交线程之前调用
+ */
+void CommitLog::setCommonData(const QJsonObject &data)
 {
-    if (args.isNull() || !args.isValid())
+    m_commonData = data;
+}
+
+/*!
+ * \brief CommitLog::enqueue 把数据加入队列，可以在任意线程中调用
+ */
+void CommitLog::enqueue(const QJsonObject &data)
+{
+    QMutexLocker locker(&m_queueMutex);
+
+    if (m_queue.size() >= RLOG_QUEUE_MAX) {
+        ++m_dropped;
         return;
-    const QJsonObject &dataObj = QJsonObject::fromVariantHash(args.toHash());
-    QJsonDocument doc(dataObj);
-    const QByteArray &sendData = doc.toJson(QJsonDocument::Compact);
-    m_writeEventLog(sendData.data());
+    }
+
+    m_queue << data;
+
+    if (m_queue.size() == 1)
+        QMetaObject::invokeMethod(this, "scheduleFlush", Qt::QueuedConnection);
+    else if (m_queue.size() == RLOG_BATCH_SIZE)
+        QMetaObject::invokeMethod(this, "flush", Qt::QueuedConnection);
+}
+
+/*!
+ * \brief CommitLog::flush 为队列中的数据添加公共字段并写入，在提交线程中调用
+ */
+void CommitLog::flush()
+{
+    QList<QJsonObject> batch;
+    int dropped = 0;
+
+    {
+        QMutexLocker locker(&m_queueMutex);
+
+        batch.swap(m_queue);
+        qSwap(dropped, m_dropped);
+    }
+
+    if (m_flushTimer)
+        m_flushTimer->stop();
+
+    if (dropped > 0)
+        qWarning() << "rlog: the commit queue is full," << dropped << "reports dropped";
+
+    if (!m_writeEventLog)
+        return;
+
+    for (QJsonObject &dataObj : batch) {
+        for (auto it = m_commonData.constBegin(); it != m_commonData.constEnd(); ++it)
+            dataObj.insert(it.key(), it.value());
+
+        const QByteArray &sendData = QJsonDocument(dataObj).toJson(QJsonDocument::Compact);
+        m_writeEventLog(sendData.data());
+    }
+}
+
+void CommitLog::scheduleFlush()
+{
+    if (!m_flushTimer) {
+        m_flushTimer = new QTimer(this);
+        m_flushTimer->setSingleShot(true);
+        m_flushTimer->setInterval(RLOG_BATCH_INTERVAL);
+        connect(m_flushTimer, &QTimer::timeout, this, &CommitLog::flush);
+    }
+
+    if (!m_flushTimer->isActive())
+        m_flushTimer->start();
 }
 
 bool CommitLog::init()
@@ -7,7 +7,17 @@
 
 #include <QObject>
 #include <QLibrary>
+#include <QJsonObject>
+#include <QMutex>
 
+class QTimer;
+
+/*!
+ * \brief CommitLog 在提交线程中写入上报数据
+ *
+ * 上报数据由 enqueue 放入有界队列，每个批次只通知提交线程一次，由提交线程按间隔或在积累到一定数量后
+ * 批量添加公共字段并写入，界面操作中只需要一次加锁入队。队列满时丢弃新的数据。
+ */
 class CommitLog : public QObject
 {
     Q_OBJECT
@@ -17,14 +27,27 @@ public:
 
     explicit CommitLog(QObject *parent = nullptr);
     ~CommitLog();
+
+    void setCommonData(const QJsonObject &data);
+    void enqueue(const QJsonObject &data);
+
 public slots:
-    void commit(const QVariant &args);
+    void flush();
     bool init();
 
+private slots:
+    void scheduleFlush();
+
 private:
     QLibrary m_library;
     InitEventLog m_initEventLog = nullptr;
     WriteEventLog m_writeEventLog = nullptr;
+
+    QJsonObject m_commonData;
+    QMutex m_queueMutex;
+    QList<QJsonObject> m_queue;
+    int m_dropped = 0;
+    QTimer *m_flushTimer = nullptr;
 };
 
 #endif   // COMMITTHREAD_H
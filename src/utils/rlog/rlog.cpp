@@ -34,13 +34,8 @@ void RLog::commit(const QString &type, const QVariantMap &args)
         qInfo() << "Error: Log data object is not registed.";
         return;
     }
-    QJsonObject jsonObject = interface->prepareData(args);
-
-    const QStringList &keys = m_commonData.keys();
-    foreach (const QString &key, keys) {
-        jsonObject.insert(key, m_commonData.value(key));   //add common data for each log commit
-    }
-    emit appendArgs(jsonObject.toVariantHash());   //Send log data to the thread
+    // 公共字段由提交线程按批次添加，这里只需入队
+    m_commitLog->enqueue(interface->prepareData(args));
 }
 
 RLog *RLog::instance()
@@ -76,8 +71,8 @@ void RLog::init()
     if (!m_commitLog->init())
         return;
 
+    m_commitLog->setCommonData(m_commonData);
     m_commitThread = new QThread();
-    connect(this, &RLog::appendArgs, m_commitLog, &CommitLog::commit);
     connect(m_commitThread, &QThread::finished, [&]() {
         m_commitLog->deleteLater();
     });
@@ -25,9 +25,6 @@ public:
 protected:
     explicit RLog(QObject *parent = nullptr);
 
-signals:
-    void appendArgs(const QVariant &args);
-
 private:
     QJsonObject m_commonData;
     QHash<QString, ReportDataInterface *> m_logDataObj;
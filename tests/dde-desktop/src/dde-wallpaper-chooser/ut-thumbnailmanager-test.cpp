@@ -16,10 +16,14 @@
 #include <QObject>
 #include <QTimer>
 #include <QtConcurrent>
+#include <QTemporaryDir>
+#include <QImage>
+#include <QUrl>
 
 #define private public
 
 #include "../dde-wallpaper-chooser/thumbnailmanager.h"
+#include "../dde-wallpaper-chooser/constants.h"
 #include "stubext.h"
 
 
@@ -79,14 +83,12 @@ TEST_F(ThumbnailManagerTest, remove_byfilepath)
 
 TEST_F(ThumbnailManagerTest, processnextreq_byfuture)
 {
-    ASSERT_TRUE(m_manager->m_futureWatcher.isFinished());
     m_manager->m_queuedRequests << "test";
-    QFuture<QPixmap> future1 = m_manager->m_futureWatcher.future();
-    future1.waitForFinished();
     m_manager->processNextReq();
-    QFuture<QPixmap> future2 = m_manager->m_futureWatcher.future();
-    EXPECT_NE(future1, future2);
-    future2.waitForFinished();
+    EXPECT_TRUE(m_manager->m_queuedRequests.isEmpty());
+    ASSERT_EQ(m_manager->m_runningRequests.size(), 1);
+    EXPECT_EQ(m_manager->m_runningRequests.values().first(), QString("test"));
+    m_manager->m_runningRequests.keys().first()->waitForFinished();
 }
 
 TEST_F(ThumbnailManagerTest, find_bysize_singnal)
@@ -96,24 +98,43 @@ TEST_F(ThumbnailManagerTest, find_bysize_singnal)
     {
         m_manager->m_queuedRequests.clear();
         stub_ext::StubExt stu;
-        stu.set_lamda(ADDR(QPixmap, isNull), [](){return false;});
-        stu.set_lamda(ADDR(ThumbnailManager, thumbnailFounded), [&bjudge](){bjudge = true;});
-        m_manager->find(test);
-        EXPECT_TRUE(bjudge);
-        ASSERT_TRUE(m_manager->m_queuedRequests.isEmpty());
-    }
-
-    {
-        m_manager->m_queuedRequests.clear();
-        stub_ext::StubExt stu;
-        bjudge = false;
-        stu.set_lamda(ADDR(QPixmap, isNull), [](){return true;});
         stu.set_lamda(ADDR(ThumbnailManager, processNextReq), [&bjudge](){bjudge = true;});
         m_manager->find(test);
         ASSERT_EQ(m_manager->m_queuedRequests.size(), 1);
         EXPECT_EQ(m_manager->m_queuedRequests.first(), test);
         EXPECT_TRUE(bjudge);
-    }
-}
 
+        // 已在排队的不重复添加
+        m_manager->find(test);
+        EXPECT_EQ(m_manager->m_queuedRequests.size(), 1);
+        m_manager->m_queuedRequests.clear();
+    }
 
+    {
+        QTemporaryDir dir;
+        ASSERT_TRUE(dir.isValid());
+        const QString path = dir.filePath("wallpaper.png");
+        QImage image(QSize(800, 600), QImage::Format_ARGB32);
+        image.fill(Qt::green);
+        ASSERT_TRUE(image.save(path));
+
+        const QString key = QUrl::toPercentEncoding(QUrl::fromLocalFile(path).toString());
+        QPixmap founded;
+        QObject::connect(m_manager, &ThumbnailManager::thumbnailFounded, [&](const QString &k, const QPixmap &pixmap) {
+            if (k == key)
+                founded = pixmap;
+        });
+
+        // 第一次生成并写入缓存，第二次从缓存读取
+        for (int round = 0; round < 2; ++round) {
+            founded = QPixmap();
+            m_manager->find(key);
+            for (int i = 0; i < 100 && founded.isNull(); ++i)
+                QTest::qWait(20);
+            ASSERT_FALSE(founded.isNull());
+            EXPECT_EQ(founded.size(), QSize(static_cast<int>(ItemWidth * 2.1), static_cast<int>(ItemHeight * 2.1)));
+            EXPECT_TRUE(QFile::exists(QDir(m_manager->m_cacheDir).absoluteFilePath(key)));
+        }
+        m_manager->remove(key);
+    }
+}
@@ -16,17 +16,11 @@ namespace  {
 
           virtual void SetUp() override
           {
-              QVector<bool> bk(200, false);
               m_grid = new GridCore();
-              m_grid->m_cellStatus.insert(1, bk);
-              m_grid->m_cellStatus.insert(2, bk);
-              QMap<QString, GPos> map1;
-              QMap<GPos, QString> map2;
-              map1.insert("string",QPoint(10, 10));
-              map2.insert(QPoint(10,10), "string");
-              m_grid->itemGrids.insert(1, map1);
-              m_grid->gridItems.insert(1, map2);
               m_grid->screensCoordInfo.insert(1, {10, 10});
+              m_grid->screens.insert(1, GridScreen(200));
+              m_grid->screens.insert(2, GridScreen(200));
+              m_grid->screens[1].insert(m_grid->toIndex(1, QPoint(10, 10)), "string");
           }
 
           virtual void TearDown() override
@@ -39,6 +33,45 @@ namespace  {
 }
 
 
+TEST(GridScreenTest, test_findfree)
+{
+    GridScreen cells(130);
+    EXPECT_EQ(130, cells.freeCount());
+    EXPECT_FALSE(cells.isFull());
+
+    for (int i = 0; i < 130; ++i) {
+        if (i != 64 && i != 129)
+            EXPECT_TRUE(cells.insert(i, QString::number(i)));
+    }
+
+    EXPECT_EQ(2, cells.freeCount());
+    EXPECT_EQ(64, cells.findFree());
+    EXPECT_EQ(129, cells.findFree(65));
+    EXPECT_EQ(-1, cells.findFree(130));
+    EXPECT_EQ(64, cells.findFreeBackward(128));
+    EXPECT_EQ(129, cells.findFreeBackward(200));
+    EXPECT_EQ(-1, cells.findFreeBackward(63));
+    EXPECT_EQ(QList<GIndex>({64, 129}), cells.freeIndexes());
+
+    // 已占用的栅格和已存在的图标都不能再插入
+    EXPECT_FALSE(cells.insert(1, "new"));
+    EXPECT_FALSE(cells.insert(64, "1"));
+    EXPECT_FALSE(cells.insert(130, "new"));
+
+    EXPECT_TRUE(cells.insert(64, "64"));
+    EXPECT_TRUE(cells.insert(129, "129"));
+    EXPECT_TRUE(cells.isFull());
+    EXPECT_EQ(-1, cells.findFree());
+    EXPECT_EQ("64", cells.items().value(64));
+
+    EXPECT_EQ(5, cells.remove("5"));
+    EXPECT_EQ(-1, cells.indexOf("5"));
+    EXPECT_EQ(QList<GIndex>({5}), cells.freeIndexes());
+    EXPECT_EQ("6", cells.takeAt(6));
+    EXPECT_EQ(QString(), cells.takeAt(6));
+    EXPECT_EQ(128, cells.itemCount());
+}
+
 TEST_F(GridCoreTest, test_additem)
 {
     int start = m_grid->overlapItems.size();
@@ -46,18 +79,20 @@ TEST_F(GridCoreTest, test_additem)
     int end = m_grid->overlapItems.size();
     EXPECT_NE(start, end);
 
-    int fitem = m_grid->itemGrids.value(1).size();
-    int fgrid = m_grid->gridItems.value(1).size();
     m_grid->addItem(1, 1, "string");
-    EXPECT_NE(fgrid, m_grid->gridItems.value(1).size());
+    EXPECT_EQ(1, m_grid->screens.value(1).indexOf("string"));
+    EXPECT_EQ(1, m_grid->screens.value(1).itemCount());
 
-    m_grid->m_cellStatus[1] = QVector<bool>{};
+    m_grid->screens[1] = GridScreen();
     m_grid->addItem(1, 1, "test01");
-    m_grid->gridItems.remove(1);
-    m_grid->m_cellStatus[1] = QVector<bool>{0, 0, 0};
+    EXPECT_TRUE(m_grid->overlapItems.contains("test01"));
+    m_grid->screens[1] = GridScreen(3);
     m_grid->addItem(1, 1, "test01");
-    EXPECT_EQ(m_grid->m_cellStatus.value(1)[1], true);
+    EXPECT_TRUE(m_grid->screens.value(1).isUsed(1));
 
+    m_grid->addItem(1, 1, "test02");
+    EXPECT_EQ("test02", m_grid->screens.value(1).item(1));
+    EXPECT_FALSE(m_grid->screens.value(1).contains("test01"));
 }
 
 TEST_F(GridCoreTest, test_findemptyforward)
@@ -69,11 +104,15 @@ TEST_F(GridCoreTest, test_findemptyforward)
     EXPECT_EQ(gtemp1, 2);
     EXPECT_EQ(gtemp2, 0);
 
-    m_grid->m_cellStatus.remove(1);
+    m_grid->screens.remove(1);
     GIndex index = m_grid->findEmptyForward(1, 1, 1);
     EXPECT_EQ(index, 1);
 
-    m_grid->m_cellStatus.insert(1, QVector<bool>{1,1,1});
+    GridScreen cells(3);
+    cells.insert(0, "a");
+    cells.insert(1, "b");
+    cells.insert(2, "c");
+    m_grid->screens.insert(1, cells);
     GIndex index1 = m_grid->findEmptyForward(1, 1, 1);
     EXPECT_EQ(0, index1);
 }
@@ -83,17 +122,15 @@ TEST_F(GridCoreTest, test_reloacleforward)
    QStringList slist = m_grid->reloacleForward(2, 1, 4);
    EXPECT_TRUE(slist.empty());
 
-   QStringList slistf = m_grid->reloacleForward(1, 110, 110);
+   QStringList slistf = m_grid->reloacleForward(1, 111, 111);
    EXPECT_TRUE(slistf.size() == 0);
 
-   auto position = m_grid->toPos(1, 1);
-   QMap<QPoint, QString> map;
    QString test("test01");
-   map.insert(position, test);
-   m_grid->gridItems.insert(1, map);
+   m_grid->screens[1].insert(1, test);
    QStringList strlist = m_grid->reloacleForward(1, 1, 1);
 
    EXPECT_EQ(strlist[0], test);
+   EXPECT_EQ(1, m_grid->screens.value(1).indexOf(test));
 }
 
 TEST_F(GridCoreTest, test_countemptypostion)
@@ -102,7 +139,8 @@ TEST_F(GridCoreTest, test_countemptypostion)
     QList<GIndex> list2 = m_grid->emptyPostion(1);
 
     EXPECT_TRUE(list1.empty());
-    EXPECT_EQ(200, list2.size());
+    EXPECT_EQ(199, list2.size());
+    EXPECT_FALSE(list2.contains(110));
 }
 
 TEST_F(GridCoreTest,test_toindexnandpos)
@@ -112,6 +150,7 @@ TEST_F(GridCoreTest,test_toindexnandpos)
     GPos pos = m_grid->pos(1,"string");
     EXPECT_EQ(index, 110);
     EXPECT_EQ(topos, QPoint(2,5));
+    EXPECT_EQ(pos, m_grid->toPos(1, 110));
 
     m_grid->screensCoordInfo.insert(1, QPair<int,int>(10, 10));
     const GPos mypos = m_grid->pos(1,"test01");
@@ -124,27 +163,16 @@ TEST_F(GridCoreTest,test_toindexnandpos)
 TEST_F(GridCoreTest,test_removeitem)
 {
     m_grid->removeItem(1,"string");
-    if(m_grid->gridItems.contains(1) || m_grid->itemGrids.contains(1))
-    {
-        auto tempItemGridsItor = m_grid->itemGrids.find(1);
-
-        auto pos = tempItemGridsItor.value().take("string");
-        auto index = m_grid->toIndex(1, pos);
-        auto cellStatusItor = m_grid->m_cellStatus.find(1);
-        EXPECT_FALSE(cellStatusItor.value()[index]);
-    }
-    m_grid->gridItems.remove(1);
-    m_grid->itemGrids.remove(1);
-    m_grid->removeItem(1, "test");//覆盖打印信息
+    EXPECT_FALSE(m_grid->screens.value(1).contains("string"));
+    EXPECT_FALSE(m_grid->screens.value(1).isUsed(110));
+
+    m_grid->screens[1].insert(1, "string");
+    m_grid->removeItem(1, GPos(0, 1));
+    EXPECT_FALSE(m_grid->screens.value(1).isUsed(1));
 
-    QMap<QPoint, QString> map;
-    QMap<QString, QPoint> map1;
-    map.insert(QPoint(1, 1),"string");
-    map1.insert("string", QPoint(1, 1));
-    m_grid->gridItems.insert(1, map);
-    m_grid->itemGrids.insert(1, map1);
-    m_grid->m_cellStatus.remove(1);
-    m_grid->removeItem(1,"string");//覆盖打印信息
+    m_grid->screens.remove(1);
+    m_grid->removeItem(1, "test");//覆盖打印信息
+    m_grid->removeItem(1, 1);//覆盖打印信息
 }
 
 TEST_F(GridCoreTest, test_reloacle)
@@ -163,38 +191,40 @@ TEST_F(GridCoreTest, test_reloacle)
 
 TEST_F(GridCoreTest, test_findemptybackward)
 {
-    m_grid->m_cellStatus.remove(1);
+    m_grid->screens.remove(1);
     GIndex index = m_grid->findEmptyBackward(1, 1, 1);
     EXPECT_EQ(1, index);
 
-    m_grid->m_cellStatus.insert(1, QVector<bool>{1, 0});
+    GridScreen cells(2);
+    cells.insert(0, "a");
+    m_grid->screens.insert(1, cells);
     GIndex index1 = m_grid->findEmptyBackward(1, 1, 0);
     EXPECT_EQ(1, index1);
 
     GIndex index2 = m_grid->findEmptyBackward(1, 1, 1);
     EXPECT_EQ(1, index2);
 
-    m_grid->m_cellStatus[1] = QVector<bool>{1, 1, 1};
+    GridScreen full(3);
+    full.insert(0, "a");
+    full.insert(1, "b");
+    full.insert(2, "c");
+    m_grid->screens[1] = full;
     GIndex index3 = m_grid->findEmptyBackward(1, 1, 1);
     EXPECT_EQ(2, index3);
 }
 
 TEST_F(GridCoreTest, test_reloacleBackward)
 {
-    m_grid->gridItems.remove(1);
+    m_grid->screens.remove(1);
     QStringList strlist = m_grid->reloacleBackward(1, 1, 1);
 
     EXPECT_EQ(QStringList(), strlist);
 
-    auto position = m_grid->toPos(1, 1);
-    QMap<QPoint, QString> map;
     QString test("test01");
-
-    map[position] = test;
-    m_grid->gridItems.insert(1, map);
+    GridScreen cells(200);
+    cells.insert(1, test);
+    m_grid->screens.insert(1, cells);
     QStringList strlist1 = m_grid->reloacleBackward(1, 1, 1);
 
     EXPECT_EQ(test, strlist1[0]);
 }
-
-
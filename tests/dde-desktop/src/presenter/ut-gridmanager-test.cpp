@@ -69,24 +69,20 @@ TEST_F(GridManagerTest, test_remove)
             fd.close();
         }
     }
-    QMap<QString, QPoint> map;
-
-    QPoint point = m_grid->position(m_canvasGridView->m_screenNum, string);
-    m_grid->d->m_itemGrids.remove(m_canvasGridView->m_screenNum);
-    ret = m_grid->d->remove(m_canvasGridView->m_screenNum, point, string);
-    if (m_grid->d->m_itemGrids.contains(m_canvasGridView->m_screenNum) && !m_grid->d->m_itemGrids.value(m_canvasGridView->m_screenNum).contains(string)) {
-        EXPECT_FALSE(ret);
-    }
-
-    point = m_grid->position(m_canvasGridView->m_screenNum, string);
-    map[string] = point;
-    m_grid->d->m_itemGrids.insert(m_canvasGridView->m_screenNum, map);
-
-    m_grid->d->m_cellStatus.remove(m_canvasGridView->m_screenNum);
-    ret = m_grid->remove(m_canvasGridView->m_screenNum, point, string);
-
-    if (!m_grid->d->m_cellStatus.contains(m_canvasGridView->m_screenNum)) {
-        EXPECT_FALSE(ret);
+    int screenNum = m_canvasGridView->m_screenNum;
+    QPoint point = m_grid->position(screenNum, string);
+    m_grid->d->m_screens.remove(screenNum);
+    ret = m_grid->d->remove(screenNum, point, string);
+    EXPECT_FALSE(ret);
+
+    point = m_grid->position(screenNum, string);
+    m_grid->d->m_screens.insert(screenNum, GridScreen(m_grid->d->cellCount(screenNum)));
+    m_grid->d->m_screens[screenNum].insert(m_grid->d->indexOfGridPos(screenNum, point), string);
+    ret = m_grid->remove(screenNum, point, string);
+
+    if (m_grid->d->isValid(screenNum, point)) {
+        EXPECT_TRUE(ret);
+        EXPECT_FALSE(m_grid->d->screenCells(screenNum).contains(string));
     }
 
 }
@@ -98,16 +94,6 @@ TEST_F(GridManagerTest, test_rangeitems)
     DUrlList urllist = m_canvasGridView->selectedUrls();
     QStringList strlist;
     for (auto str : urllist) strlist << str.toString();
-    auto item = m_grid->d->m_itemGrids.value(m_canvasGridView->m_screenNum);
-    QPoint point;
-    QMap<QString, QPoint> mp;
-
-    for (auto str : strlist) {
-        point = m_grid->position(m_canvasGridView->m_screenNum, str);
-        mp[str] = point;
-        m_grid->d->m_itemGrids.insert(m_canvasGridView->m_screenNum, mp);
-    }
-
     strlist << QString("test");
     strlist = m_grid->d->rangeItems(m_canvasGridView->m_screenNum, strlist);
 
@@ -115,11 +101,12 @@ TEST_F(GridManagerTest, test_rangeitems)
     int Mn = INT_MIN;
 
     foreach (auto item, strlist) {
-        if (m_grid->d->m_itemGrids.contains(m_canvasGridView->m_screenNum) && m_grid->d->m_itemGrids.value(m_canvasGridView->m_screenNum).contains(item)) {
-            if (m_grid->d->m_itemGrids.value(m_canvasGridView->m_screenNum).value(item).x() < Mn) {
+        int index = m_grid->d->screenCells(m_canvasGridView->m_screenNum).indexOf(item);
+        if (index >= 0) {
+            if (index < Mn) {
                 issort = false;
             }
-            Mn = m_grid->d->m_itemGrids.value(m_canvasGridView->m_screenNum).value(item).x();
+            Mn = index;
          }
     }
 
@@ -182,7 +169,7 @@ TEST_F(GridManagerTest, test_forwardfindempty)
     QList<DUrl> list;
     QString url = m_grid->firstItemId(m_canvasGridView->m_screenNum);
     DUrl temp = DUrl(url);
-    QPoint fpoint =  m_grid->d->m_itemGrids.value(m_canvasGridView->m_screenNum).value(url);
+    QPoint fpoint =  m_grid->d->itemPos(m_canvasGridView->m_screenNum, url);
     list << temp;
     QPair<int, QPoint> empty;
     QPair<int, QPoint> emptypoint = m_grid->forwardFindEmpty(m_canvasGridView->m_screenNum, fpoint);
@@ -219,7 +206,11 @@ TEST_F(GridManagerTest, test_sortmaindesktopfile)
 
 TEST_F(GridManagerTest, test_takeemptypos)
 {
-    m_grid->d->m_cellStatus.insert(m_canvasGridView->screenNum(), {1,1,1});
+    GridScreen fullCells(3);
+    fullCells.insert(0, "a");
+    fullCells.insert(1, "b");
+    fullCells.insert(2, "c");
+    m_grid->d->m_screens.insert(m_canvasGridView->screenNum(), fullCells);
     QPair<int, QPoint> temp;
     temp = m_grid->d->takeEmptyPos();
     QPair<int, QPoint> compare;
@@ -241,20 +232,14 @@ TEST_F(GridManagerTest, test_add)
     DUrlList ulist =  m_canvasGridView->selectedUrls();
     QStringList strlist;
     QPoint point;
-    QMap<QString, QPoint> mapitem;
-    QMap<QPoint, QString> mapgrid;
     for (auto str : ulist) strlist << str.toString();
 
     for (auto str : strlist) {
         point = m_grid->position(m_canvasGridView->m_screenNum, str);
-        mapitem[str] = point;
-        mapgrid[point] = str;
-        m_grid->d->m_itemGrids.insert(m_canvasGridView->m_screenNum, mapitem);
-        m_grid->d->m_gridItems.insert(m_canvasGridView->m_screenNum, mapgrid);
+        bool exist = m_grid->d->screenCells(m_canvasGridView->m_screenNum).contains(str);
         ret = m_grid->d->add(m_canvasGridView->m_screenNum, point, str);
-        m_grid->d->m_itemGrids.clear();
         m_grid->dump();
-        if (m_grid->d->m_itemGrids.value(m_canvasGridView->m_screenNum).contains(str)) {
+        if (exist) {
             EXPECT_FALSE(ret);
         }
         ret = m_grid->d->add(m_canvasGridView->m_screenNum, point, str);
@@ -269,7 +254,6 @@ TEST_F(GridManagerTest, test_add)
 TEST_F(GridManagerTest, test_addtooverlap)
 {
     QString test("test");
-    QMap<QString, QPoint> map;
     int result;
     result = m_grid->addToOverlap(test);
     EXPECT_EQ(result, 0);
@@ -278,8 +262,9 @@ TEST_F(GridManagerTest, test_addtooverlap)
     result = m_grid->addToOverlap(test);
     EXPECT_EQ(result, 1);
 
-    map.insert(test, QPoint());
-    m_grid->d->m_itemGrids.insert(m_canvasGridView->m_screenNum, map);
+    GridScreen cells(1);
+    cells.insert(0, test);
+    m_grid->d->m_screens.insert(m_canvasGridView->m_screenNum, cells);
     m_grid->d->m_overlapItems.clear();
     result = m_grid->addToOverlap(test);
     EXPECT_EQ(-1, result);
@@ -329,13 +314,14 @@ TEST_F(GridManagerTest, test_getemptyposmorearg)
 {
    QPair<int, QPoint> emptypos;
    QPoint point;
-   m_grid->d->m_screenFullStatus[m_canvasGridView->m_screenNum] = true;
+   GridScreen fullCells(1);
+   fullCells.insert(0, "test");
+   m_grid->d->m_screens[m_canvasGridView->m_screenNum] = fullCells;
    bool judge = m_grid->d->getEmptyPos(m_canvasGridView->m_screenNum, true, point);
    EXPECT_EQ(QPoint(), point);
    EXPECT_FALSE(judge);
 
-   m_grid->d->m_screenFullStatus[m_canvasGridView->m_screenNum] = false;
-   m_grid->d->m_cellStatus[m_canvasGridView->m_screenNum] = {0};
+   m_grid->d->m_screens[m_canvasGridView->m_screenNum] = GridScreen(1);
    judge = m_grid->d->getEmptyPos(m_canvasGridView->m_screenNum, true, point);
    EXPECT_TRUE(judge);
    judge = m_grid->d->getEmptyPos(m_canvasGridView->m_screenNum, false, point);
@@ -848,6 +848,45 @@ TEST_F(ScreenSignal, process_displayModeChanged)
     EXPECT_EQ(d->m_events.begin().key(),AbstractScreenManager::Mode);
 }
 
+TEST_F(ScreenSignal, dispatch_unchanged_layout)
+{
+    QEventLoop loop;
+    init(&loop);
+    m_lastMode = displayMode();
+    d->m_layout = d->currentLayout();
+
+    appendEvent(Screen);
+    appendEvent(AvailableGeometry);
+    d->m_eventShot.stop();
+    this->processEvent();
+
+    EXPECT_TRUE(d->m_events.isEmpty());
+    EXPECT_FALSE(sreenDisplayChanged);
+    EXPECT_FALSE(sreenChanged);
+    EXPECT_FALSE(sreenGeometryChanged);
+    EXPECT_FALSE(sreenAvailableGeometryChanged);
+}
+
+TEST_F(ScreenSignal, dispatch_geometry_only)
+{
+    QEventLoop loop;
+    init(&loop);
+    m_lastMode = displayMode();
+    d->m_layout = d->currentLayout();
+    if (d->m_layout.geometries.isEmpty())
+        return;
+
+    // 屏幕组成不变，只有区域变化时不重建
+    d->m_layout.geometries[0] = QRect();
+    appendEvent(Screen);
+    d->m_eventShot.stop();
+    this->processEvent();
+
+    EXPECT_FALSE(sreenDisplayChanged);
+    EXPECT_FALSE(sreenChanged);
+    EXPECT_TRUE(sreenGeometryChanged);
+}
+
 TEST_F(ScreenSignal, emit_PrimaryChanged)
 {
     ASSERT_TRUE(d->m_events.isEmpty());
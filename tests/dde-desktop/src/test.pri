@@ -12,6 +12,7 @@ SOURCES += \
     $$PWD/view/ut_backgroundwidget_test.cpp \
     $$PWD/view/ut_canvasgridview_test.cpp \
     $$PWD/view/ut_canvasviewmanager_test.cpp\
+    $$PWD/view/ut_desktopsnapshot_test.cpp \
     $$PWD/ut-desktop-test.cpp \
     $$PWD/util/ut-util-test.cpp \
     $$PWD/util/ut-desktopinfo-test.cpp \
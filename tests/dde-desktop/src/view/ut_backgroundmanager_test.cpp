@@ -10,6 +10,8 @@
 #include <QScopedPointer>
 #include <QGuiApplication>
 #include <QScreen>
+#include <QTemporaryDir>
+#include <QTest>
 
 #define private public
 #define protected public
@@ -222,6 +224,36 @@ TEST_F(BackgroundManagerTest, onResetBackgroundImage)
     EXPECT_EQ(oldImages, newImages);
 }
 
+TEST_F(BackgroundManagerTest, onResetBackgroundImage_cache)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString path = dir.filePath("background.png");
+    QImage image(QSize(64, 32), QImage::Format_ARGB32);
+    image.fill(Qt::blue);
+    ASSERT_TRUE(image.save(path));
+
+    for (ScreenPointer sp : m_manager->m_backgroundMap.keys())
+        m_manager->m_backgroundImagePath[sp->name()] = path;
+
+    // 在线程中加载，相同几何的屏幕只加载一次
+    m_manager->onResetBackgroundImage();
+    EXPECT_LE(m_manager->m_loadingPixmaps.size(), m_manager->m_backgroundMap.size());
+    for (int i = 0; i < 100 && !m_manager->m_loadingPixmaps.isEmpty(); ++i)
+        QTest::qWait(20);
+    ASSERT_TRUE(m_manager->m_loadingPixmaps.isEmpty());
+
+    for (ScreenPointer sp : m_manager->m_backgroundMap.keys()) {
+        QPixmap pix = m_manager->m_backgroundMap.value(sp)->pixmap();
+        EXPECT_EQ(sp->handleGeometry().size(), pix.size());
+        EXPECT_TRUE(m_manager->m_pixmapCache.contains(m_manager->m_requestedPixmaps.value(sp->name())));
+    }
+
+    // 再次设置时直接使用缓存
+    m_manager->onResetBackgroundImage();
+    EXPECT_TRUE(m_manager->m_loadingPixmaps.isEmpty());
+}
+
 TEST_F(BackgroundManagerTest, onRestBackgroundManager)
 {
     bool unknow = m_manager->m_preview || m_manager->isEnabled();
@@ -213,6 +213,25 @@ TEST_F(CanvasGridViewTest, TEST_CanvasGridViewTest_visualRect){
     //    ASSERT_TRUE(tempRec == tgRect);
 }
 
+TEST_F(CanvasGridViewTest, TEST_CanvasGridViewTest_visualRegionForSelection){
+    ASSERT_NE(m_canvasGridView, nullptr);
+    auto utModel = m_canvasGridView->model();
+    ASSERT_NE(utModel, nullptr);
+
+    QItemSelection selection;
+    QRegion expected;
+    for (const QString &oneUrl : GridManager::instance()->itemIds(1)) {
+        auto tempIndex = utModel->index(DUrl(oneUrl));
+        if (!tempIndex.isValid())
+            continue;
+        selection.push_back(QItemSelectionRange(tempIndex));
+        expected = expected.united(QRegion(m_canvasGridView->visualRect(tempIndex)));
+    }
+
+    EXPECT_EQ(expected, m_canvasGridView->visualRegionForSelection(selection));
+    EXPECT_TRUE(m_canvasGridView->visualRegionForSelection(QItemSelection()).isEmpty());
+}
+
 #ifndef __arm__
 TEST_F(CanvasGridViewTest, TEST_CanvasGridViewTest_canvansScreenName){
     ASSERT_NE(m_canvasGridView, nullptr);
@@ -335,6 +354,48 @@ TEST_F(CanvasGridViewTest, CanvasGridViewTest_paintEvent)
     vp->dodgeTargetGrid = nullptr;
 }
 
+TEST_F(CanvasGridViewTest, CanvasGridViewTest_paintItemTile)
+{
+    ASSERT_NE(m_canvasGridView, nullptr);
+    waitData(m_canvasGridView);
+
+    QString urlPath = "file://" + path + '/' + CanvasGridViewTest::tstFile;
+    auto index = m_canvasGridView->model()->index(DUrl(urlPath));
+    ASSERT_TRUE(index.isValid());
+    if (!GridManager::instance()->contains(m_canvasGridView->screenNum(), urlPath))
+        return;
+
+    m_canvasGridView->clearSelection();
+    CanvasViewPrivate *vp = m_canvasGridView->d.data();
+    vp->_debug_show_grid = false;
+    vp->dodgeAnimationing = false;
+
+    QPaintEvent event(m_canvasGridView->visualRect(index));
+    m_canvasGridView->paintEvent(&event);
+    if (!vp->fileViewHelper->isPaintFile())
+        return;
+
+    const QString key = m_canvasGridView->model()->getUrlByIndex(index).toString();
+    ASSERT_TRUE(vp->itemTiles.contains(key));
+    qint64 cacheKey = vp->itemTiles.value(key).pixmap.cacheKey();
+
+    // 未变化时复用图块
+    m_canvasGridView->paintEvent(&event);
+    EXPECT_EQ(cacheKey, vp->itemTiles.value(key).pixmap.cacheKey());
+
+    // 整体状态变化后重新绘制
+    vp->itemTileContext.clear();
+    m_canvasGridView->paintEvent(&event);
+    EXPECT_NE(cacheKey, vp->itemTiles.value(key).pixmap.cacheKey());
+
+    // 区域外的图标不绘制
+    vp->itemTiles.clear();
+    QRect rect = m_canvasGridView->visualRect(index);
+    QPaintEvent outside(rect.translated(rect.width() * 2, 0));
+    m_canvasGridView->paintEvent(&outside);
+    EXPECT_FALSE(vp->itemTiles.contains(key));
+}
+
 #ifndef __arm__
 TEST_F(CanvasGridViewTest, CanvasGridViewTest_mousePressEvent){
     ASSERT_NE(m_canvasGridView, nullptr);
@@ -2425,6 +2486,27 @@ TEST(CanvasGridView, currentChanged_inputMethod)
     EXPECT_TRUE(view.testAttribute(Qt::WA_InputMethodEnabled));
 }
 
+TEST(CanvasGridView, sharedModel)
+{
+    CanvasGridView *owner = new CanvasGridView("");
+    CanvasGridView shared("", nullptr, owner->model());
+
+    EXPECT_EQ(owner->model(), shared.model());
+    EXPECT_EQ(owner, shared.modelOwner());
+
+    // 共用 model 的画布由持有 model 的画布统一刷新
+    shared.delayModelRefresh(1000);
+    EXPECT_TRUE(owner->m_refreshTimer);
+    EXPECT_FALSE(shared.m_refreshTimer);
+
+    shared.takeModelOwnership();
+    EXPECT_EQ(&shared, shared.modelOwner());
+
+    QPointer<DFileSystemModel> model = shared.model();
+    delete owner;
+    EXPECT_TRUE(model);
+}
+
 TEST(CanvasGridViewTest_end, endTest)
 {
     auto path = QStandardPaths::writableLocation(QStandardPaths::DesktopLocation);
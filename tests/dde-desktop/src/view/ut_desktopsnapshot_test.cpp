@@ -0,0 +1,50 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+#include <QTest>
+#include <QFile>
+#include <QColor>
+
+#include "view/desktopsnapshot.h"
+
+TEST(DesktopSnapshotTest, save_and_load)
+{
+    const QString screen("ut_desktopsnapshot/screen");
+    const QString path = DesktopSnapshot::filePath(screen);
+    QFile::remove(path);
+    EXPECT_FALSE(path.endsWith(screen));
+    EXPECT_TRUE(DesktopSnapshot::load(screen).isEmpty());
+
+    QPixmap tile(QSize(40, 60));
+    tile.setDevicePixelRatio(2);
+    tile.fill(Qt::red);
+
+    DesktopSnapshot snapshot;
+    snapshot.context = "ut_context";
+    snapshot.items.append({QPoint(1, 2), "file:///tmp/a.txt", tile});
+    DesktopSnapshot::save(screen, snapshot);
+
+    // 在线程中写入
+    for (int i = 0; i < 100 && !QFile::exists(path); ++i)
+        QTest::qWait(20);
+
+    DesktopSnapshot loaded = DesktopSnapshot::load(screen);
+    ASSERT_EQ(1, loaded.items.size());
+    EXPECT_EQ(snapshot.context, loaded.context);
+    EXPECT_EQ(QPoint(1, 2), loaded.items.first().pos);
+    EXPECT_EQ(QString("file:///tmp/a.txt"), loaded.items.first().file);
+    EXPECT_EQ(tile.size(), loaded.items.first().tile.size());
+    EXPECT_EQ(2, loaded.items.first().tile.devicePixelRatio());
+    EXPECT_EQ(QColor(Qt::red), loaded.items.first().tile.toImage().pixelColor(0, 0));
+
+    // 损坏的快照不可用
+    QFile file(path);
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    file.write("broken");
+    file.close();
+    EXPECT_TRUE(DesktopSnapshot::load(screen).isEmpty());
+
+    QFile::remove(path);
+}
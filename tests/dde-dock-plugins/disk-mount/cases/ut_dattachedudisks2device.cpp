@@ -3,6 +3,9 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "dattachedudisks2device.h"
+#define private public
+#include "diskusagerefresher.h"
+#undef private
 
 #include <ddiskmanager.h>
 #include <dblockdevice.h>
@@ -145,8 +148,10 @@ TEST_F(TestDAttachedUdisks2Device, dummy_blkdevice_not_Valid_storage_is_ok)
 {
     Stub stub;
     stub.set(ADDR(DBlockDevice,isValid), isValid_false_stub);
-    stub.set(ADDR(QStorageInfo,isValid), isValid_true_stub);
-    stub.set(ADDR(QStorageInfo,bytesTotal), size_1KB_stub);
+
+    DiskUsageRefresher::Usage usage;
+    usage.bytesTotal = 1024;
+    DiskUsageRefresher::instance()->updateUsage(getDummyMountPoint(), true, usage);
 
     QString name = mUdisks2Device->displayName();
     EXPECT_TRUE(name.contains("1 KB"));
@@ -156,9 +161,12 @@ TEST_F(TestDAttachedUdisks2Device, dummy_blkdevice_not_Valid_storage_is_ok)
 TEST_F(TestDAttachedUdisks2Device, dummy_deviceUsage_can_get)
 {
     Stub stub;
-    stub.set(ADDR(QStorageInfo,isValid), isValid_true_stub);
     stub.set(ADDR(DBlockDevice, size), size_2KB_stub);
-    stub.set(ADDR(QStorageInfo,bytesAvailable), size_1KB_stub);
+
+    DiskUsageRefresher::Usage usage;
+    usage.bytesFree = 1024;
+    usage.bytesTotal = 4096;
+    DiskUsageRefresher::instance()->updateUsage(getDummyMountPoint(), true, usage);
 
     QPair<quint64, quint64> useage = mUdisks2Device->deviceUsage();
     QPair<quint64, quint64> values = QPair<quint64, quint64>(1024, 2*1024);
@@ -167,8 +175,7 @@ TEST_F(TestDAttachedUdisks2Device, dummy_deviceUsage_can_get)
 
 TEST_F(TestDAttachedUdisks2Device, dummy_deviceUsage_cannot_get)
 {
-    Stub stub;
-    stub.set(ADDR(QStorageInfo,isValid), isValid_false_stub);
+    DiskUsageRefresher::instance()->updateUsage(getDummyMountPoint(), false, DiskUsageRefresher::Usage());
 
     QPair<quint64, quint64> useage = mUdisks2Device->deviceUsage();
     QPair<quint64, quint64> values = QPair<quint64, quint64>(0, 0);
@@ -177,8 +184,7 @@ TEST_F(TestDAttachedUdisks2Device, dummy_deviceUsage_cannot_get)
 
 TEST_F(TestDAttachedUdisks2Device, dummy_device_usage_valid)
 {
-    Stub stub;
-    stub.set(ADDR(QStorageInfo,isValid), isValid_true_stub);
+    DiskUsageRefresher::instance()->updateUsage(getDummyMountPoint(), true, DiskUsageRefresher::Usage());
 
     EXPECT_TRUE(mUdisks2Device->deviceUsageValid());
 }
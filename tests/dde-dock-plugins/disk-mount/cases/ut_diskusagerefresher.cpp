@@ -0,0 +1,75 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#define private public
+#include "diskusagerefresher.h"
+#undef private
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QCoreApplication>
+#include <QSignalSpy>
+#include <gtest/gtest.h>
+
+namespace  {
+    class TestDiskUsageRefresher : public testing::Test {
+    public:
+        void SetUp() override
+        {
+            refresher = DiskUsageRefresher::instance();
+        }
+        void TearDown() override
+        {
+            refresher->setActive(false);
+        }
+
+        bool waitForUsage(const QString &mountPoint)
+        {
+            QElapsedTimer timer;
+            timer.start();
+            while (!refresher->usage(mountPoint, nullptr) && !timer.hasExpired(5000))
+                QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+
+            return refresher->usage(mountPoint, nullptr);
+        }
+
+    public:
+        DiskUsageRefresher *refresher = nullptr;
+    };
+}
+
+TEST_F(TestDiskUsageRefresher, refresh_only_when_active)
+{
+    const QString &mountPoint = QDir::rootPath();
+    refresher->addMountPoint(mountPoint);
+
+    // 弹出窗口未显示时不读取容量
+    EXPECT_FALSE(refresher->usage(mountPoint, nullptr));
+
+    QSignalSpy spy(refresher, &DiskUsageRefresher::usageChanged);
+    refresher->setActive(true);
+    ASSERT_TRUE(waitForUsage(mountPoint));
+    EXPECT_FALSE(spy.isEmpty());
+
+    DiskUsageRefresher::Usage usage;
+    EXPECT_TRUE(refresher->usage(mountPoint, &usage));
+    EXPECT_GT(usage.bytesTotal, 0u);
+
+    refresher->removeMountPoint(mountPoint);
+    EXPECT_FALSE(refresher->usage(mountPoint, nullptr));
+}
+
+TEST_F(TestDiskUsageRefresher, mount_point_is_reference_counted)
+{
+    const QString &mountPoint = QDir::homePath();
+    refresher->addMountPoint(mountPoint);
+    refresher->addMountPoint(mountPoint);
+    refresher->updateUsage(mountPoint, true, DiskUsageRefresher::Usage());
+
+    refresher->removeMountPoint(mountPoint);
+    EXPECT_TRUE(refresher->usage(mountPoint, nullptr));
+
+    refresher->removeMountPoint(mountPoint);
+    EXPECT_FALSE(refresher->usage(mountPoint, nullptr));
+}
@@ -17,6 +17,7 @@ SOURCES += \
     $$PWD/cases/ut_diskpluginitem.cpp \
     $$PWD/cases/ut_diskmountplugin.cpp \
     $$PWD/cases/ut_diskcontrolwidget.cpp \
+    $$PWD/cases/ut_diskusagerefresher.cpp \
     $$PWD/cases/ut_mock_stub_disk_gio.cpp \
     $$PWD/cases/ut_mock_stub_diskdevice.cpp
 
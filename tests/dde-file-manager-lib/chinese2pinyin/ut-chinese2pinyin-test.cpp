@@ -16,3 +16,11 @@ TEST(Chinese2PinYintest,Chinese2PinYin)
     EXPECT_EQ(temp,compare);
     EXPECT_GE(result.size(),sz);
 }
+
+TEST(Chinese2PinYintest,Chinese2PinYinMixed)
+{
+    EXPECT_EQ(QString("ab-dan1yuan2-1.txt"), Pinyin::Chinese2Pinyin(QString::fromUtf8("ab-单元-1.txt")));
+    // 兼容汉字区间
+    EXPECT_FALSE(Pinyin::Chinese2Pinyin(QString(QChar(0xf90e))).startsWith(QChar(0xf90e)));
+    EXPECT_TRUE(Pinyin::Chinese2Pinyin(QString()).isEmpty());
+}
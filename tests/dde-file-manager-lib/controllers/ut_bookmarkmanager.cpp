@@ -233,6 +233,40 @@ TEST_F(TestBookMarkManager, can_get_bookmark_urls)
     EXPECT_NO_FATAL_FAILURE(m_pTester->getBookmarkUrls());
 }
 
+TEST_F(TestBookMarkManager, cache_bookmark_reachability)
+{
+    DUrl targetUrl = DUrl::fromLocalFile(tempDirPath + "_reachability");
+    DUrl url = DUrl::fromBookMarkFile(targetUrl, BOOKMARK_STR);
+
+    EXPECT_EQ(BookMarkManager::ReachabilityUnknown, m_pTester->reachability(url));
+
+    BookmarkData data;
+    data.m_url = url;
+    m_pTester->m_bookmarkDataMap[targetUrl] = data;
+
+    int changedCount = 0;
+    QMetaObject::Connection connection = QObject::connect(m_pTester, &BookMarkManager::reachabilityChanged,
+                                                          [&changedCount](const DUrl &, bool) {
+        ++changedCount;
+    });
+
+    m_pTester->onBookmarkValidated(url, false);
+    EXPECT_EQ(BookMarkManager::TargetUnreachable, m_pTester->reachability(url));
+    EXPECT_EQ(1, changedCount);
+
+    // 结果没有变化时不通知侧边栏
+    m_pTester->onBookmarkValidated(url, false);
+    EXPECT_EQ(1, changedCount);
+
+    // 缓存有效期内不重复检查
+    m_pTester->validateBookmark(url);
+    EXPECT_FALSE(m_pTester->m_validatingUrls.contains(url));
+
+    QObject::disconnect(connection);
+    m_pTester->m_bookmarkDataMap.remove(targetUrl);
+    m_pTester->m_reachability.remove(url);
+}
+
 TEST_F(TestBookMarkManager, can_remove_bookmark)
 {
     DUrl fileUrl = DUrl::fromBookMarkFile(DUrl::fromLocalFile(tempDirPath.replace(BOOKMARK_STR, BOOKMARK_NEW_STR)), BOOKMARK_NEW_STR);
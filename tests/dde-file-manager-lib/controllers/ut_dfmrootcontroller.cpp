@@ -16,6 +16,8 @@
 #include "dfileservices.h"
 #include "testhelper.h"
 
+#include <ddiskmanager.h>
+
 namespace  {
     class DFMRootControllerTest : public testing::Test
     {
@@ -73,6 +75,34 @@ TEST_F(DFMRootControllerTest, get_children)
     EXPECT_TRUE(!list.empty());
 }
 
+TEST_F(DFMRootControllerTest, get_children_from_cached_block_entries)
+{
+    DUrl url;
+    url.setScheme(DFMROOT_SCHEME);
+    url.setPath("/");
+
+    auto event = dMakeEventPointer<DFMGetChildrensEvent>(nullptr, url, QStringList(), QDir::Filters());
+    controller->getChildren(event);
+    EXPECT_TRUE(controller->m_blockEntriesLoaded);
+
+    // 已缓存块设备条目时不再枚举块设备
+    static int blockDevicesCount = 0;
+    blockDevicesCount = 0;
+    QStringList (*ut_blockDevices)(QVariantMap) = [](QVariantMap) {
+        ++blockDevicesCount;
+        return QStringList();
+    };
+    Stub st;
+    st.set(ADDR(DDiskManager, blockDevices), ut_blockDevices);
+
+    controller->getChildren(event);
+    EXPECT_EQ(blockDevicesCount, 0);
+
+    controller->m_blockEntries.insert("/org/freedesktop/UDisks2/block_devices/ut_test", DFMRootController::BlockEntry());
+    controller->removeBlockEntry("/org/freedesktop/UDisks2/block_devices/ut_test");
+    EXPECT_FALSE(controller->m_blockEntries.contains("/org/freedesktop/UDisks2/block_devices/ut_test"));
+}
+
 TEST_F(DFMRootControllerTest, create_file_info)
 {
     DUrl url;
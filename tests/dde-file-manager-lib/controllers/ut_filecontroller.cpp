@@ -176,6 +176,147 @@ TEST_F(FileControllerTest, tst_create_director)
     DumpDirector(dirIterator);
 }
 
+#ifdef SYS_getdents64
+TEST_F(FileControllerTest, tst_local_dir_iterator)
+{
+    const QString dirPath = TestHelper::createTmpDir();
+    QDir dir(dirPath);
+    dir.mkdir("dir");
+    dir.mkdir(".hidden_dir");
+    QFile(dir.filePath("file.txt")).open(QIODevice::WriteOnly);
+    QFile(dir.filePath(".hidden_file")).open(QIODevice::WriteOnly);
+    QFile::link(dir.filePath("file.txt"), dir.filePath("file_link"));
+    QFile::link(dir.filePath("dir"), dir.filePath("dir_link"));
+    QFile::link(dir.filePath("not_exists"), dir.filePath("broken_link"));
+    mkfifo(QFile::encodeName(dir.filePath("fifo")).constData(), 0644);
+
+    auto listNames = [](DDirIterator &iterator) {
+        QStringList names;
+        while (iterator.hasNext()) {
+            iterator.next();
+            names << iterator.fileName();
+        }
+        names.sort();
+        return names;
+    };
+
+    const QList<QDir::Filters> filtersList {
+        QDir::NoFilter,
+        QDir::AllEntries | QDir::NoDotAndDotDot,
+        QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden,
+        QDir::AllEntries | QDir::NoDotAndDotDot | QDir::System,
+        QDir::Dirs | QDir::NoDotAndDotDot | QDir::Hidden,
+        QDir::Files | QDir::NoSymLinks | QDir::Hidden,
+        QDir::AllEntries | QDir::NoSymLinks | QDir::System
+    };
+
+    for (QDir::Filters filters : filtersList) {
+        ASSERT_TRUE(DFMLocalDirIterator::isSupported(dirPath, QStringList(), filters, QDirIterator::NoIteratorFlags, false));
+        DFMLocalDirIterator localIterator(dirPath, filters);
+        DFMQDirIterator qdirIterator(dirPath, QStringList(), filters, QDirIterator::NoIteratorFlags);
+        EXPECT_EQ(listNames(qdirIterator), listNames(localIterator)) << int(filters);
+    }
+
+    EXPECT_FALSE(DFMLocalDirIterator::isSupported(dirPath, {"*.txt"}, QDir::AllEntries, QDirIterator::NoIteratorFlags, false));
+    EXPECT_FALSE(DFMLocalDirIterator::isSupported(dirPath, QStringList(), QDir::AllEntries, QDirIterator::Subdirectories, false));
+
+    DFMLocalDirIterator iterator(dirPath, QDir::Files);
+    ASSERT_TRUE(iterator.hasNext());
+    EXPECT_EQ(DUrl::fromLocalFile(dir.filePath(iterator.next().fileName())), iterator.fileUrl());
+    EXPECT_TRUE(iterator.fileInfo()->exists());
+    iterator.close();
+    EXPECT_FALSE(iterator.hasNext());
+
+    // 网络文件系统上按批预先读取属性
+    stub_ext::StubExt stub;
+    stub.set_lamda(&DMountTable::mountClass, [] { return DMountTable::NetworkMount; });
+
+    for (QDir::Filters filters : filtersList) {
+        DFMLocalDirIterator localIterator(dirPath, filters);
+        DFMQDirIterator qdirIterator(dirPath, QStringList(), filters, QDirIterator::NoIteratorFlags);
+        EXPECT_EQ(listNames(qdirIterator), listNames(localIterator)) << int(filters);
+    }
+
+    DFMLocalDirIterator networkIterator(dirPath, QDir::AllEntries | QDir::NoDotAndDotDot);
+    while (networkIterator.hasNext()) {
+        networkIterator.next();
+
+        const DAbstractFileInfoPointer &info = networkIterator.fileInfo();
+        const QFileInfo fileInfo(dir.filePath(networkIterator.fileName()));
+        EXPECT_EQ(fileInfo.isDir(), info->isDir()) << networkIterator.fileName().toStdString();
+        EXPECT_EQ(fileInfo.isSymLink(), info->isSymLink()) << networkIterator.fileName().toStdString();
+        EXPECT_EQ(fileInfo.size(), info->size()) << networkIterator.fileName().toStdString();
+    }
+
+    TestHelper::deleteTmpFile(dirPath);
+}
+#endif
+
+TEST_F(FileControllerTest, tst_gvfs_dir_iterator)
+{
+    const QString dirPath = TestHelper::createTmpDir();
+    QDir dir(dirPath);
+    dir.mkdir("dir");
+    dir.mkdir(".hidden_dir");
+    QFile file(dir.filePath("file.txt"));
+    file.open(QIODevice::WriteOnly);
+    file.write("gvfs");
+    file.close();
+    QFile(dir.filePath(".hidden_file")).open(QIODevice::WriteOnly);
+    QFile::link(dir.filePath("file.txt"), dir.filePath("file_link"));
+
+    auto listNames = [](DDirIterator &iterator) {
+        QStringList names;
+        while (iterator.hasNext()) {
+            iterator.next();
+            names << iterator.fileName();
+        }
+        names.sort();
+        return names;
+    };
+
+    stub_ext::StubExt stub;
+    stub.set_lamda(&FileUtils::isSmbPath, [] { return true; });
+
+    EXPECT_FALSE(DFMGvfsDirIterator::isSupported(dirPath, QStringList(), QDir::AllEntries | QDir::NoDotAndDotDot, QDirIterator::NoIteratorFlags, false));
+    EXPECT_FALSE(DFMGvfsDirIterator::isSupported(dirPath, QStringList(), QDir::AllEntries, QDirIterator::NoIteratorFlags, true));
+    EXPECT_FALSE(DFMGvfsDirIterator::isSupported(dirPath, {"*.txt"}, QDir::AllEntries | QDir::NoDotAndDotDot, QDirIterator::NoIteratorFlags, true));
+
+    const QList<QDir::Filters> filtersList {
+        QDir::AllEntries | QDir::NoDotAndDotDot,
+        QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden,
+        QDir::Dirs | QDir::NoDotAndDotDot | QDir::Hidden,
+        QDir::Files | QDir::NoDotAndDotDot | QDir::NoSymLinks
+    };
+
+    for (QDir::Filters filters : filtersList) {
+        ASSERT_TRUE(DFMGvfsDirIterator::isSupported(dirPath, QStringList(), filters, QDirIterator::NoIteratorFlags, true));
+        DFMGvfsDirIterator gvfsIterator(dirPath, filters);
+        DFMQDirIterator qdirIterator(dirPath, QStringList(), filters, QDirIterator::NoIteratorFlags);
+        EXPECT_EQ(listNames(qdirIterator), listNames(gvfsIterator)) << int(filters);
+    }
+
+    // 文件信息使用枚举时取得的属性
+    DFMGvfsDirIterator iterator(dirPath, QDir::AllEntries | QDir::NoDotAndDotDot);
+    while (iterator.hasNext()) {
+        iterator.next();
+
+        const DAbstractFileInfoPointer &info = iterator.fileInfo();
+        const QFileInfo fileInfo(dir.filePath(iterator.fileName()));
+        EXPECT_TRUE(info->exists());
+        EXPECT_EQ(fileInfo.isDir(), info->isDir()) << iterator.fileName().toStdString();
+        EXPECT_EQ(fileInfo.isSymLink(), info->isSymLink()) << iterator.fileName().toStdString();
+        if (!fileInfo.isDir())
+            EXPECT_EQ(fileInfo.size(), info->size()) << iterator.fileName().toStdString();
+    }
+
+    DFMGvfsDirIterator closedIterator(dirPath, QDir::AllEntries | QDir::NoDotAndDotDot);
+    closedIterator.close();
+    EXPECT_FALSE(closedIterator.hasNext());
+
+    TestHelper::deleteTmpFile(dirPath);
+}
+
 TEST_F(FileControllerTest, tst_open_file)
 {
     stub_ext::StubExt stext;
@@ -7,6 +7,9 @@
 #include <QDialog>
 #include "stub.h"
 #include <QMutex>
+#include <QStandardPaths>
+#include <QDir>
+#include <QFile>
 #include <gtest/gtest.h>
 
 #include "controllers/mergeddesktopcontroller.h"
@@ -254,6 +257,45 @@ TEST_F(TestMergedDesktopController, tstStaticFuncs)
     EXPECT_FALSE(MergedDesktopController::isVirtualEntryPaths(DUrl("file:///home")));
 }
 
+TEST_F(TestMergedDesktopController, tstIncrementalChildren)
+{
+    const QString desktopPath = QStandardPaths::standardLocations(QStandardPaths::DesktopLocation).first();
+    QDir().mkpath(desktopPath);
+    const QString filePath = desktopPath + "/dde-file-manager-unit-test-merged.txt";
+    QFile::remove(filePath);
+
+    const QDir::Filters filters = QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden;
+    const DUrl entryUrl(DFMMD_ROOT VIRTUALENTRY_FOLDER + MergedDesktopController::entryNameByEnum(DMD_OTHER));
+    auto event = dMakeEventPointer<DFMGetChildrensEvent>(nullptr, entryUrl, QStringList(), filters);
+    ctrl->getChildren(event);
+
+    int checked = 0;
+    stub_ext::StubExt stu;
+    stu.set_lamda(&MergedDesktopController::checkUrlArrangedType, [&checked]() {
+        ++checked;
+        return DMD_OTHER;
+    });
+
+    auto contains = [&]() {
+        for (const DAbstractFileInfoPointer &info : ctrl->getChildren(event)) {
+            if (MergedDesktopController::convertToRealPath(info->fileUrl()).toLocalFile() == filePath)
+                return true;
+        }
+        return false;
+    };
+
+    // 已分类的文件不再判断类型，只判断新增的文件
+    QFile file(filePath);
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.close();
+    EXPECT_TRUE(contains());
+    EXPECT_EQ(1, checked);
+
+    QFile::remove(filePath);
+    EXPECT_FALSE(contains());
+    EXPECT_EQ(1, checked);
+}
+
 TEST_F(TestMergedDesktopController, tstSlots)
 {
     ctrl->desktopFilesCreated(DUrl("file:///home"));
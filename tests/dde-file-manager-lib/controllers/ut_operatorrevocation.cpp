@@ -85,4 +85,32 @@ TEST_F(TestOperatorRevocation, test_slotRevocationEvent)
     EXPECT_NO_FATAL_FAILURE(m_pController->slotRevocationEvent(QString("root")));
 }
 
+TEST_F(TestOperatorRevocation, test_compact_event)
+{
+    ASSERT_NE(m_pController, nullptr);
+
+    DUrlList urls;
+    for (int i = 0; i < 200; ++i)
+        urls << DUrl::fromLocalFile(QString("/tmp/revocation/%1/file_%2").arg(i % 2 ? "a" : "b/c").arg(i));
+
+    auto operatEvent = dMakeEventPointer<DFMDeleteEvent>(nullptr, urls);
+    DFMSaveOperatorEvent event(nullptr, operatEvent, true);
+    const DFMEvent saved = m_pController->compactEvent(event);
+
+    // 只保存共同的父目录和相对路径
+    EXPECT_EQ(QString("/tmp/revocation/"), saved.property("_dfm_revocation_parent").toString());
+    EXPECT_TRUE(qvariant_cast<DUrlList>(operatEvent->data()).isEmpty());
+    EXPECT_GT(urls.count() * 256, OperatorRevocation::eventMemorySize(saved));
+    EXPECT_TRUE(dfmevent_cast<DFMSaveOperatorEvent>(saved).async());
+
+    m_pController->expandEvent(saved, operatEvent);
+    EXPECT_EQ(urls, qvariant_cast<DUrlList>(operatEvent->data()));
+
+    // 文件较少时保存原来的事件
+    auto smallEvent = dMakeEventPointer<DFMDeleteEvent>(nullptr, DUrlList() << DUrl::fromLocalFile("/tmp/a"));
+    const DFMEvent smallSaved = m_pController->compactEvent(DFMSaveOperatorEvent(nullptr, smallEvent));
+    EXPECT_FALSE(smallSaved.property("_dfm_revocation_parent").isValid());
+    EXPECT_EQ(1, qvariant_cast<DUrlList>(smallEvent->data()).count());
+}
+
 DFM_END_NAMESPACE
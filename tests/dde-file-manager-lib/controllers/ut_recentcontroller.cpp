@@ -16,6 +16,7 @@
 
 #include <QTimer>
 #include <QSignalSpy>
+#include <QTemporaryDir>
 
 using namespace stub_ext;
 DFM_USE_NAMESPACE
@@ -352,5 +353,93 @@ TEST_F(TestRecentController, tst_decompressFile)
     st.set_lamda(&DFileService::decompressFile, []() { return true; });
     EXPECT_TRUE(m_controller->decompressFile(event));
 }
+TEST_F(TestRecentController, tst_directoryWatcher)
+{
+    auto event = dMakeEventPointer<DFMCreateFileWatcherEvent>(nullptr, DUrl::fromRecentFile("/"));
+    RecentFileWatcher *watcher = static_cast<RecentFileWatcher *>(m_controller->createFileWatcher(event));
+    RecentFileWatcherPrivate *d = watcher->d_func();
+
+    // 同一目录中的文件共用一个 watcher
+    const DUrl &url1 = DUrl::fromRecentFile(tmpFileUrl.path());
+    const DUrl &url2 = DUrl::fromRecentFile(tmpFileUrl2.path());
+    watcher->setEnabledSubfileWatcher(url1);
+    watcher->setEnabledSubfileWatcher(url2);
+    ASSERT_EQ(1, d->dirWatchers.size());
+    EXPECT_EQ(2, d->dirWatchers.constBegin()->refCount);
+    EXPECT_EQ(d->urlToWatcherMap.value(url1), d->urlToWatcherMap.value(url2));
+
+    // 目录中其它文件的事件不转发
+    QSignalSpy spy(watcher, SIGNAL(fileModified(const DUrl &)));
+    watcher->onDirectoryFileModified(DUrl::fromLocalFile(tmpFileUrl.path() + ".other"));
+    EXPECT_EQ(0, spy.count());
+    watcher->onDirectoryFileModified(DUrl::fromLocalFile(tmpFileUrl.path()));
+    EXPECT_EQ(1, spy.count());
+
+    // 目录被删除时其中的文件都被移除
+    QSignalSpy deletedSpy(watcher, SIGNAL(fileDeleted(const DUrl &)));
+    watcher->onDirectoryFileDeleted(DUrl::fromLocalFile(d->dirWatchers.constBegin().key()));
+    EXPECT_EQ(2, deletedSpy.count());
+    EXPECT_TRUE(d->urlToWatcherMap.isEmpty());
+    EXPECT_TRUE(d->dirWatchers.isEmpty());
+
+    delete watcher;
+}
+
+TEST_F(TestRecentController, tst_checkFilesExist)
+{
+    const QString &filePath = tmpFileUrl.path();
+    const QHash<QString, bool> &result = RecentController::checkFilesExist({ filePath, filePath + ".not-exists", tmpDirUrl.path() }, 2000);
+
+    EXPECT_TRUE(result.value(filePath));
+    EXPECT_FALSE(result.value(filePath + ".not-exists", true));
+    // 目录不显示在最近使用中
+    EXPECT_FALSE(result.value(tmpDirUrl.path(), true));
 }
 
+TEST_F(TestRecentController, tst_handleFileChanged)
+{
+    // 等待构造时的解析结束
+    for (int i = 0; i < 100 && m_controller->m_parseFuture.isRunning(); ++i)
+        TestHelper::runInLoop([] {}, 20);
+
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    const QString oldXbelPath = m_controller->m_xbelPath;
+    const auto oldEntries = m_controller->m_xbelEntries;
+    m_controller->m_xbelPath = dir.filePath("recently-used.xbel");
+    m_controller->m_xbelEntries.clear();
+
+    auto writeXbel = [&](const QStringList &paths, const QString &modified) {
+        QFile file(m_controller->m_xbelPath);
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        file.write("<?xml version=\"1.0\"?>\n<xbel version=\"1.0\">\n");
+        for (const QString &path : paths)
+            file.write(QString("<bookmark href=\"file://%1\" modified=\"%2\"/>\n").arg(path, modified).toUtf8());
+        file.write("</xbel>\n");
+    };
+
+    const QString &filePath = tmpFileUrl.path();
+    const DUrl &recentUrl = DUrl::fromRecentFile(filePath);
+    const DUrl &missingUrl = DUrl::fromRecentFile(filePath + ".not-exists");
+
+    writeXbel({ filePath, filePath + ".not-exists" }, "2022-01-01T00:00:00Z");
+    m_controller->handleFileChanged();
+    EXPECT_TRUE(m_controller->recentNodes.contains(recentUrl));
+    EXPECT_FALSE(m_controller->recentNodes.contains(missingUrl));
+    EXPECT_EQ(2, m_controller->m_xbelEntries.size());
+
+    // 记录未变化时不再检查文件
+    QFile::remove(filePath);
+    m_controller->handleFileChanged();
+    EXPECT_TRUE(m_controller->recentNodes.contains(recentUrl));
+
+    writeXbel({ filePath + ".not-exists" }, "2022-01-01T00:00:00Z");
+    m_controller->handleFileChanged();
+    EXPECT_FALSE(m_controller->recentNodes.contains(recentUrl));
+
+    m_controller->m_xbelPath = oldXbelPath;
+    m_controller->m_xbelEntries = oldEntries;
+}
+
+}
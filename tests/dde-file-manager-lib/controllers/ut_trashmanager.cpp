@@ -260,3 +260,21 @@ TEST_F(TestTrashManager, isWorking)
     auto res = m_trash->isWorking();
     EXPECT_FALSE(res);
 }
+
+TEST_F(TestTrashManager, trashFilesChanged)
+{
+    const DUrl &fileUrl = DUrl::fromLocalFile(trashFileUrl.toLocalFile());
+
+    m_trash->trashFilesChanged(fileUrl);
+    const int count = TrashManager::filesCount();
+    EXPECT_GT(count, 0);
+    EXPECT_FALSE(TrashManager::isEmpty());
+
+    // 已记录的文件被删除后数量随之减少
+    QProcess::execute("rm -f " + trashFileUrl.toLocalFile());
+    m_trash->trashFilesChanged(fileUrl);
+    if (count > 1)
+        EXPECT_EQ(count - 1, TrashManager::filesCount());
+    else
+        EXPECT_TRUE(TrashManager::isEmpty());
+}
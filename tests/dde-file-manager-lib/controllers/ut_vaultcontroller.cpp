@@ -273,6 +273,10 @@ TEST_F(TestVaultController, tst_isVaultFile)
 {
     EXPECT_TRUE(m_controller->isVaultFile(m_controller->makeVaultLocalPath()));
     EXPECT_FALSE(m_controller->isVaultFile(DUrl::fromComputerFile("Videos").toString()));
+    EXPECT_TRUE(m_controller->isVaultFile(m_controller->makeVaultLocalPath("a/b.txt")));
+    EXPECT_TRUE(m_controller->isVaultFile(DUrl::fromLocalFile(m_controller->makeVaultLocalPath("a.txt")).toString()));
+    EXPECT_FALSE(m_controller->isVaultFile("search:///" + m_controller->makeVaultLocalPath()));
+    EXPECT_FALSE(m_controller->isVaultFile(QDir::homePath()));
 }
 
 TEST_F(TestVaultController, tst_getPermissions)
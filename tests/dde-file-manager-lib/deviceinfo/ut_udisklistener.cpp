@@ -290,6 +290,25 @@ TEST_F(TestUDiskListener, fileSystemDeviceIdLabelChanged)
     );
 }
 
+TEST_F(TestUDiskListener, addFileSystemDevice)
+{
+    const QString path("/org/freedesktop/UDisks2/block_devices/ut_test");
+    DBlockDevice *blDev = DDiskManager::createBlockDevice(path);
+    m_listener->addFileSystemDevice(path, blDev);
+    EXPECT_EQ(blDev, m_listener->m_fsDevMap.value(path));
+
+    // 枚举结果与 fileSystemAdded 重复时保留先加入的
+    m_listener->addFileSystemDevice(path, DDiskManager::createBlockDevice(path));
+    EXPECT_EQ(blDev, m_listener->m_fsDevMap.value(path));
+
+    // 枚举期间被移除的设备不再加入
+    delete m_listener->m_fsDevMap.take(path);
+    m_listener->m_removedFsDevs.insert(path);
+    m_listener->addFileSystemDevice(path, DDiskManager::createBlockDevice(path));
+    EXPECT_FALSE(m_listener->m_fsDevMap.contains(path));
+    EXPECT_TRUE(m_listener->m_removedFsDevs.isEmpty());
+}
+
 TEST_F(TestUDiskListener, loopCheckCD)
 {
     EXPECT_NO_FATAL_FAILURE(m_listener->loopCheckCD());
@@ -328,3 +328,23 @@ TEST_F(TestFilePreviewDialog, testnextPage2)
     m_pTester->nextPage();
     EXPECT_EQ(m_pTester->m_firstEnterSwitchToPage, true);
 }
+
+TEST_F(TestFilePreviewDialog, testPrefetchedPreviews)
+{
+    for (int i = 0; i < 3; ++i) {
+        DFMFilePreview *preview = new UnknowFilePreview(m_pTester);
+        m_pTester->m_prefetchedPreviews.prepend(qMakePair(DUrl::fromLocalFile(QString("/tmp/ut_prefetch_%1").arg(i)), preview));
+    }
+
+    // 窗口未显示时不预加载
+    EXPECT_FALSE(m_pTester->prefetchPreview(DUrl::fromLocalFile("/tmp/ut_prefetch_3")));
+    EXPECT_EQ(nullptr, m_pTester->takePrefetchedPreview(DUrl::fromLocalFile("/tmp/ut_prefetch_3")));
+
+    DFMFilePreview *preview = m_pTester->takePrefetchedPreview(DUrl::fromLocalFile("/tmp/ut_prefetch_1"));
+    EXPECT_NE(nullptr, preview);
+    EXPECT_EQ(2, m_pTester->m_prefetchedPreviews.size());
+    preview->deleteLater();
+
+    m_pTester->clearPrefetchedPreviews();
+    EXPECT_TRUE(m_pTester->m_prefetchedPreviews.isEmpty());
+}
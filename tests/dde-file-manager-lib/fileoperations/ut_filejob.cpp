@@ -1844,6 +1844,47 @@ TEST_F(FileJobTest, start_getNotExistsTrashFileName){
     QProcess::execute("rm -rf " + QDir::currentPath()+"/start_getNotExistsTrashFileName");
 }
 
+TEST_F(FileJobTest, start_getNotExistsTrashFileName_reserved){
+    QSet<QString> reservedNames;
+    reservedNames << "11.txt";
+    const QString &name = job->getNotExistsTrashFileName("/tmp/a/11.txt", &reservedNames);
+    EXPECT_NE(QString("11.txt"), name);
+    EXPECT_TRUE(name.endsWith(".txt"));
+    EXPECT_TRUE(reservedNames.contains(name));
+    // 同一批次中的同名文件也不能重复
+    EXPECT_NE(name, job->getNotExistsTrashFileName("/tmp/b/11.txt", &reservedNames));
+}
+
+TEST_F(FileJobTest, start_doMoveToTrashInBatch){
+    const QString root = QDir::currentPath() + "/start_doMoveToTrashInBatch";
+    QDir().mkpath(root + "/a");
+    QDir().mkpath(root + "/b");
+    QProcess::execute("touch " + root + "/a/11.txt");
+    QProcess::execute("touch " + root + "/b/11.txt");
+    QDir().mkpath(DFMStandardPaths::location(DFMStandardPaths::TrashFilesPath));
+    QDir().mkpath(DFMStandardPaths::location(DFMStandardPaths::TrashInfosPath));
+
+    QList<QString> (*getTagsThroughFileslamda)(void *, const QList<DUrl> &) = [](void *, const QList<DUrl> &) {
+        return QList<QString>();
+    };
+    stl.set(ADDR(TagManager, getTagsThroughFiles), getTagsThroughFileslamda);
+
+    const DUrlList &list = job->doMoveToTrashInBatch(DUrlList() << DUrl::fromLocalFile(root + "/a/11.txt")
+                                                                << DUrl::fromLocalFile(root + "/b/11.txt")
+                                                                << DUrl::fromLocalFile(root + "/not_exists"));
+    ASSERT_EQ(2, list.size());
+    EXPECT_NE(list.first(), list.last());
+    for (const DUrl &url : list) {
+        EXPECT_TRUE(QFileInfo::exists(url.toLocalFile()));
+        const QString &infoPath = DFMStandardPaths::location(DFMStandardPaths::TrashInfosPath) + "/" + url.fileName() + ".trashinfo";
+        EXPECT_TRUE(QFileInfo::exists(infoPath));
+        QFile::remove(url.toLocalFile());
+        QFile::remove(infoPath);
+    }
+    EXPECT_FALSE(QFileInfo::exists(root + "/a/11.txt"));
+    QProcess::execute("rm -rf " + root);
+}
+
 TEST_F(FileJobTest, start_getStorageInfo){
     QProcess::execute("mkdir " + QDir::currentPath()+"/start_getStorageInfo");
     QProcess::execute("touch " + QDir::currentPath()+"/start_getStorageInfo/11.txt");
@@ -462,6 +462,25 @@ TEST_F(TestGvfsMountManager, printVolumeMounts)
     GvfsMountManager::printVolumeMounts();
 }
 
+TEST_F(TestGvfsMountManager, getMounts)
+{
+    QMount qMount;
+    qMount.setMounted_root_uri("smb://127.0.0.1/ut_share/");
+    qMount.setMounted_root_path("/run/user/1000/gvfs/smb-share:server=127.0.0.1,share=ut_share");
+    GvfsMountManager::Mounts.insert(qMount.mounted_root_uri(), qMount);
+
+    bool found = false;
+    for (const QMount &mount : GvfsMountManager::getMounts()) {
+        if (mount.mounted_root_uri() == qMount.mounted_root_uri()) {
+            found = mount.mounted_root_path() == qMount.mounted_root_path();
+            break;
+        }
+    }
+    EXPECT_TRUE(found);
+
+    GvfsMountManager::Mounts.remove(qMount.mounted_root_uri());
+}
+
 #include <QFileInfo>
 
 bool foo_stub_bool(void* obj)
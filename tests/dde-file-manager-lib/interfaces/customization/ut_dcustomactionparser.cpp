@@ -98,6 +98,24 @@ TEST_F(TestDCustomActionParser, test_get_action_files)
     EXPECT_EQ(m_parser->getActionFiles(false).size(), 2);
 }
 
+TEST_F(TestDCustomActionParser, test_get_action_files_by_combo)
+{
+    m_parser->m_actionEntry.clear();
+    m_parser->m_actionIndexValid = false;
+    DCustomActionEntry entry;
+    entry.m_fileCombo = DCustomActionDefines::AllFile;
+    m_parser->m_actionEntry << entry;
+
+    entry.m_fileCombo = DCustomActionDefines::SingleFile | DCustomActionDefines::BlankSpace;
+    entry.m_notShowIn.append("Desktop"); //不在桌面
+    m_parser->m_actionEntry << entry;
+
+    EXPECT_EQ(m_parser->getActionFiles(false, DCustomActionDefines::SingleFile).size(), 2);
+    EXPECT_EQ(m_parser->getActionFiles(true, DCustomActionDefines::SingleFile).size(), 1);
+    EXPECT_EQ(m_parser->getActionFiles(false, DCustomActionDefines::BlankSpace).size(), 1);
+    EXPECT_EQ(m_parser->getActionFiles(false, DCustomActionDefines::SingleDir).size(), 0);
+}
+
 TEST_F(TestDCustomActionParser, test_parse_file_only_settings_arg)
 {
     auto invalidFilePath = QString("%1/%2").arg(utDirPath).arg("invalid.conf");
@@ -51,6 +51,21 @@ TEST_F(TestDAbstractFileInfo, getFileInfo)
     EXPECT_TRUE(fileInfo == nullptr);
 }
 
+TEST_F(TestDAbstractFileInfo, getFileInfoFromRegistry)
+{
+    const DUrl url("file:///tmp/ut_registry_1.txt");
+
+    {
+        DAbstractFileInfoPointer holder(new DAbstractFileInfo(url));
+
+        EXPECT_EQ(holder.data(), DAbstractFileInfo::getFileInfo(url).data());
+        EXPECT_TRUE(DAbstractFileInfo::getFileInfo(DUrl("file:///tmp/ut_registry_2.txt")) == nullptr);
+    }
+
+    // 析构后从索引中移除
+    EXPECT_TRUE(DAbstractFileInfo::getFileInfo(url) == nullptr);
+}
+
 TEST_F(TestDAbstractFileInfo, exists)
 {
     EXPECT_FALSE(info->exists());
@@ -1000,3 +1015,29 @@ TEST_F(TestDAbstractFileInfo, setEmblemIntoIcons)
     }
     EXPECT_FALSE(iconList.isEmpty());
 }
+
+TEST_F(TestDAbstractFileInfo, compareByDisplayName)
+{
+    const QStringList names {"a2", "a10", "B", "b1", "中文", "_tmp", "#1", "a2"};
+    QList<DAbstractFileInfoPointer> infos;
+    for (const QString &name : names) {
+        infos << DAbstractFileInfoPointer(new DAbstractFileInfo(DUrl::fromLocalFile("/tmp/" + name)));
+    }
+
+    auto compareAll = [&] {
+        for (int i = 0; i < infos.size(); ++i) {
+            for (int j = 0; j < infos.size(); ++j) {
+                for (Qt::SortOrder order : {Qt::AscendingOrder, Qt::DescendingOrder}) {
+                    EXPECT_EQ(FileSortFunction::compareByDisplayName(infos.at(i), infos.at(j), order),
+                              FileSortFunction::compareByString(names.at(i), names.at(j), order));
+                }
+            }
+        }
+    };
+
+    // 未生成排序键时回退到字符串比较，生成排序键后结果应保持不变
+    compareAll();
+    for (const DAbstractFileInfoPointer &i : infos)
+        i->makeDisplayNameSortKey();
+    compareAll();
+}
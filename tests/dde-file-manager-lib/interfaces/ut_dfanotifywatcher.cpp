@@ -0,0 +1,52 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <QTemporaryDir>
+
+#define private public
+#include "interfaces/dfanotifywatcher.h"
+#include "interfaces/private/dfanotifywatcher_p.h"
+#undef private
+
+TEST(TestDFanotifyWatcher, subtree_lookup)
+{
+    DFanotifyWatcher watcher;
+    DFanotifyWatcherPrivate *d = watcher.d_func();
+
+    // 不依赖 fanotify 的权限，直接检查目录树的查找
+    d->subtrees.insert("/home/test/Desktop", 1);
+
+    EXPECT_TRUE(watcher.isSubtreeWatched("/home/test/Desktop"));
+    EXPECT_TRUE(watcher.isSubtreeWatched("/home/test/Desktop/a/b.txt"));
+    EXPECT_FALSE(watcher.isSubtreeWatched("/home/test/Desktop1"));
+    EXPECT_FALSE(watcher.isSubtreeWatched("/home/test"));
+    EXPECT_EQ(QStringList { "/home/test/Desktop" }, watcher.subtrees());
+
+    d->subtrees.clear();
+}
+
+TEST(TestDFanotifyWatcher, add_subtree)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    DFanotifyWatcher watcher;
+
+    // 没有权限时回退到 inotify，不记录目录树
+    if (!watcher.addSubtree(dir.path())) {
+        EXPECT_FALSE(watcher.isSubtreeWatched(dir.path()));
+        return;
+    }
+
+    EXPECT_TRUE(watcher.addSubtree(dir.path()));
+    EXPECT_TRUE(watcher.isSubtreeWatched(dir.path() + "/file"));
+
+    watcher.removeSubtree(dir.path());
+    EXPECT_TRUE(watcher.isSubtreeWatched(dir.path()));
+
+    watcher.removeSubtree(dir.path());
+    EXPECT_FALSE(watcher.isSubtreeWatched(dir.path()));
+}
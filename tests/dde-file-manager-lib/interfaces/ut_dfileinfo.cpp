@@ -9,6 +9,12 @@
 
 #include <QStandardPaths>
 #include <QIcon>
+#include <QTemporaryDir>
+
+#include <malloc.h>
+
+// 列表中每个文件信息（包含其类型）占用内存的目标
+#define MEMORY_PER_ENTRY_TARGET 3072
 
 namespace {
 class TestDFileInfo : public testing::Test
@@ -89,6 +95,36 @@ TEST_F(TestDFileInfo, test_fileinfo_property)
     EXPECT_FALSE(m_pFileInfo->isSymLink());
 }
 
+TEST_F(TestDFileInfo, test_load_stat_attributes)
+{
+    QFile file(m_filePathStr);
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write("12345");
+    file.close();
+
+    DFileInfo info(m_filePathStr);
+    const QFileInfo fileInfo(m_filePathStr);
+
+    if (!info.loadStatAttributes(true))
+        return;
+
+    EXPECT_TRUE(info.exists());
+    EXPECT_TRUE(info.isFile());
+    EXPECT_FALSE(info.isDir());
+    EXPECT_FALSE(info.isSymLink());
+    EXPECT_EQ(5, info.size());
+    EXPECT_EQ(fileInfo.ownerId(), info.ownerId());
+    EXPECT_EQ(fileInfo.lastModified().toMSecsSinceEpoch() / 1000, info.lastModified().toMSecsSinceEpoch() / 1000);
+    EXPECT_NE(0u, info.inode());
+
+    EXPECT_TRUE(m_pDirInfo->loadStatAttributes(true));
+    EXPECT_TRUE(m_pDirInfo->isDir());
+
+    // 符号链接继续使用 QFileInfo
+    EXPECT_FALSE(m_pSymLinkInfo->loadStatAttributes(true));
+    EXPECT_TRUE(m_pSymLinkInfo->isSymLink());
+}
+
 TEST_F(TestDFileInfo, test_owner)
 {
     ASSERT_NE(m_pFileInfo, nullptr);
@@ -269,3 +305,34 @@ TEST_F(TestDFileInfo, test_static_mimeType)
     EXPECT_TRUE(DFileInfo::mimeType(m_filePathStr, QMimeDatabase::MatchDefault, QString(), true).isValid());
     EXPECT_TRUE(DFileInfo::mimeType(m_filePathStr).isValid());
 }
+
+TEST(DFileInfoMemoryTest, memoryPerEntry)
+{
+    const int count = 2000;
+    QTemporaryDir tempDir;
+    ASSERT_TRUE(tempDir.isValid());
+
+    QStringList filePathList;
+    for (int i = 0; i < count; ++i) {
+        const QString &filePath = tempDir.path() + QString("/file_%1.txt").arg(i);
+        QFile file(filePath);
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        filePathList << filePath;
+    }
+
+    QList<DAbstractFileInfoPointer> infoList;
+    infoList.reserve(count);
+
+    const qint64 before = mallinfo().uordblks;
+
+    for (const QString &filePath : filePathList) {
+        DAbstractFileInfoPointer info(new DFileInfo(QFileInfo(filePath)));
+        // 模拟列表显示时读取的类型信息
+        info->mimeType().comment();
+        infoList << info;
+    }
+
+    const qint64 after = mallinfo().uordblks;
+
+    EXPECT_LE((after - before) / count, MEMORY_PER_ENTRY_TARGET);
+}
@@ -919,3 +919,24 @@ TEST_F(DFileSeviceTest, start_checkMultiSelectionFilesCache)
 {
     EXPECT_FALSE(service->checkMultiSelectionFilesCache());
 }
+
+TEST_F(DFileSeviceTest, start_createControllerOnFirstUse)
+{
+    static int createCount = 0;
+    const DUrl lazyUrl("ut-lazy:///a");
+
+    createCount = 0;
+    service->insertToCreatorHash(HandlerType(lazyUrl.scheme(), ""), HandlerCreatorType(typeid(DAbstractFileController).name(), [] {
+        ++createCount;
+        return new DAbstractFileController();
+    }));
+
+    // 注册时不创建控制器，第一次使用 scheme 时才创建
+    EXPECT_TRUE(service->isRegisted(lazyUrl.scheme(), ""));
+    EXPECT_EQ(0, createCount);
+    EXPECT_EQ(1, DFileService::getHandlerTypeByUrl(lazyUrl).size());
+    EXPECT_EQ(1, DFileService::getHandlerTypeByUrl(lazyUrl).size());
+    EXPECT_EQ(1, createCount);
+
+    service->clearController(lazyUrl.scheme(), "");
+}
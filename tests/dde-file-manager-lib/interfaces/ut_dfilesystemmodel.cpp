@@ -6,6 +6,11 @@
 #include <gmock/gmock-matchers.h>
 
 #include <QTimer>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QDir>
+#include <algorithm>
+#include <sys/stat.h>
 #include <dfmevent.h>
 #include "stubext.h"
 #define private public
@@ -125,6 +130,34 @@ TEST_F(TestDFileSystemModel, test_data)
     ASSERT_TRUE(m_model->data(index, DFileSystemModel::UnknowRole).isNull());
     //FileIconModelToolTipRole
 }
+
+TEST_F(TestDFileSystemModel, test_lazyAttributes)
+{
+    QModelIndex rootIndex = m_model->setRootUrl(tmpDirUrl);
+    TestHelper::runInLoop([&] {
+        ASSERT_TRUE(m_model->canFetchMore(rootIndex));
+        m_model->fetchMore(rootIndex);
+    });
+    EXPECT_FALSE(m_model->isLazyAttributes());
+
+    m_model->d_func()->lazyAttributes = true;
+    QModelIndex index = m_model->index(0, 0);
+    ASSERT_TRUE(index.isValid());
+    // 后台读取前只提供名称等基本信息
+    EXPECT_FALSE(m_model->data(index, DFileSystemModel::FileSizeRole).isValid());
+    EXPECT_EQ(m_model->data(index, DFileSystemModel::FileNameRole).toString(), tmpFileUrl.fileName());
+
+    int changedCount = 0;
+    QObject::connect(m_model, &DFileSystemModel::dataChanged, m_model, [&] { ++changedCount; });
+    m_model->requestAttributes(0, 0);
+    m_model->d_func()->attributeFuture.waitForFinished();
+    TestHelper::runInLoop([] {}, 10);
+
+    const DAbstractFileInfoPointer &info = m_model->fileInfo(index);
+    EXPECT_EQ(1, changedCount);
+    EXPECT_EQ(m_model->data(index, DFileSystemModel::FileSizeRole).toString(), info->sizeDisplayName());
+    EXPECT_EQ(m_model->data(index, DFileSystemModel::FileLastModifiedDateTimeRole).toDateTime(), info->lastModified());
+}
 #endif
 TEST_F(TestDFileSystemModel, test_fileInfo)
 {
@@ -354,6 +387,34 @@ TEST_F(TestDFileSystemModel, test_setAdvanceSearchFilter)
 
 }
 
+TEST(DFileSystemModelPrivateTest, coalesceFileEvents)
+{
+    using Event = QPair<DFileSystemModelPrivate::EventType, DUrl>;
+
+    const DUrl url1 = DUrl::fromLocalFile("/tmp/1.txt");
+    const DUrl url2 = DUrl::fromLocalFile("/tmp/2.txt");
+    const DUrl url3 = DUrl::fromLocalFile("/tmp/3.txt");
+    QList<Event> events;
+
+    events << qMakePair(DFileSystemModelPrivate::AddFile, url1)
+           << qMakePair(DFileSystemModelPrivate::UpdateFile, url2)
+           << qMakePair(DFileSystemModelPrivate::UpdateFile, url1)
+           << qMakePair(DFileSystemModelPrivate::UpdateFile, url2)
+           << qMakePair(DFileSystemModelPrivate::AddFile, url3)
+           << qMakePair(DFileSystemModelPrivate::RmFile, url1)
+           << qMakePair(DFileSystemModelPrivate::UpdateFile, url2);
+
+    const QList<Event> &list = DFileSystemModelPrivate::coalesceFileEvents(events);
+
+    // 重复的修改只保留一次，创建后删除以删除为准并放在最后
+    ASSERT_EQ(3, list.size());
+    EXPECT_EQ(qMakePair(DFileSystemModelPrivate::UpdateFile, url2), list.at(0));
+    EXPECT_EQ(qMakePair(DFileSystemModelPrivate::AddFile, url3), list.at(1));
+    EXPECT_EQ(qMakePair(DFileSystemModelPrivate::RmFile, url1), list.at(2));
+
+    EXPECT_TRUE(DFileSystemModelPrivate::coalesceFileEvents(QList<Event>()).isEmpty());
+}
+
 TEST(FileSystemNodeTest, setNodeVisible)
 {
     QReadWriteLock lk;
@@ -403,4 +464,215 @@ TEST(FileSystemNodeTest, takeNodeByUrl)
     EXPECT_EQ(ret, data);
 }
 
+TEST(FileSystemNodeTest, indexOfChild)
+{
+    QReadWriteLock lk;
+    DAbstractFileInfoPointer info;
+    FileSystemNode node(nullptr, info, nullptr, &lk);
+    QList<FileSystemNodePointer> nodes;
+    DUrlList urls;
+    for (int i = 0; i < 5; ++i) {
+        nodes << FileSystemNodePointer(new FileSystemNode(&node, info, nullptr, &lk));
+        urls << DUrl::fromLocalFile(QString("/tmp/node_%1").arg(i));
+        node.appendChildren(urls.last(), nodes.last());
+    }
+    EXPECT_EQ(3, node.indexOfChild(nodes.at(3)));
+    EXPECT_EQ(4, node.indexOfChild(urls.at(4)));
+
+    // 插入和删除后后面节点的位置随之更新
+    FileSystemNodePointer inserted(new FileSystemNode(&node, info, nullptr, &lk));
+    node.noLockInsertChildren(1, DUrl::fromLocalFile("/tmp/node_inserted"), inserted);
+    EXPECT_EQ(1, node.indexOfChild(inserted));
+    EXPECT_EQ(4, node.indexOfChild(nodes.at(3)));
+
+    EXPECT_EQ(nodes.at(0), node.takeNodeByUrl(urls.at(0)));
+    EXPECT_EQ(-1, node.indexOfChild(nodes.at(0)));
+    EXPECT_EQ(-1, node.indexOfChild(urls.at(0)));
+    EXPECT_EQ(3, node.indexOfChild(nodes.at(3)));
+
+    node.setNodeVisible(nodes.at(1), false);
+    EXPECT_EQ(-1, node.indexOfChild(nodes.at(1)));
+    EXPECT_EQ(2, node.indexOfChild(nodes.at(3)));
+    node.setNodeVisible(nodes.at(1), true);
+    EXPECT_EQ(node.childrenCount() - 1, node.indexOfChild(nodes.at(1)));
+
+    // 整体替换列表后重新计算位置
+    QList<FileSystemNodePointer> list = node.getChildrenList();
+    std::reverse(list.begin(), list.end());
+    node.setChildrenList(list);
+    EXPECT_EQ(0, node.indexOfChild(nodes.at(1)));
+    node.clearChildren();
+    EXPECT_EQ(-1, node.indexOfChild(nodes.at(1)));
+}
+
+TEST(FileSystemNodeTest, sortAllChildren)
+{
+    QReadWriteLock lk;
+    DAbstractFileInfoPointer info;
+    FileSystemNode node(nullptr, info, nullptr, &lk);
+    // 超过多线程排序的阈值，每两个节点的排序值相同，用于检查排序是否稳定
+    const int count = 20001;
+    for (int i = 0; i < count; ++i) {
+        const DUrl url = DUrl::fromLocalFile(QString("/tmp/%1_%2").arg((count - i) / 2).arg(i));
+        DAbstractFileInfoPointer childInfo(new DAbstractFileInfo(url, false));
+        node.appendChildren(url, FileSystemNodePointer(new FileSystemNode(&node, childInfo, nullptr, &lk)));
+    }
+
+    auto sortKey = [](const DAbstractFileInfoPointer &info) {
+        return info->fileName().section('_', 0, 0).toInt();
+    };
+    DAbstractFileInfo::CompareFunction sortFun = [&](const DAbstractFileInfoPointer &info1, const DAbstractFileInfoPointer &info2, Qt::SortOrder order, bool) {
+        return order == Qt::AscendingOrder ? sortKey(info1) < sortKey(info2) : sortKey(info1) > sortKey(info2);
+    };
+
+    bool cancel = true;
+    const QList<FileSystemNodePointer> oldList = node.getChildrenList();
+    node.sortAllChildren(sortFun, Qt::AscendingOrder, &cancel);
+    EXPECT_TRUE(node.getChildrenList() == oldList);
+
+    cancel = false;
+    node.sortAllChildren(sortFun, Qt::AscendingOrder, &cancel);
+    const QList<FileSystemNodePointer> list = node.getChildrenList();
+    ASSERT_EQ(count, list.size());
+    for (int i = 1; i < list.size(); ++i) {
+        const int key1 = sortKey(list.at(i - 1)->fileInfo);
+        const int key2 = sortKey(list.at(i)->fileInfo);
+        ASSERT_LE(key1, key2);
+        if (key1 == key2) {
+            EXPECT_LT(list.at(i - 1)->fileInfo->fileName().section('_', 1).toInt(),
+                      list.at(i)->fileInfo->fileName().section('_', 1).toInt());
+        }
+        EXPECT_EQ(i, node.indexOfChild(list.at(i)));
+    }
+}
+
+TEST(FileSystemNodeTest, sortAllChildrenBySize)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    QReadWriteLock lk;
+    DAbstractFileInfoPointer info;
+    FileSystemNode node(nullptr, info, nullptr, &lk);
+    // 大小相同的文件按名称排序，目录排在文件之前
+    const QList<int> sizes {3, 0, 7, 3, 1, 7, 0};
+    for (int i = 0; i < sizes.size(); ++i) {
+        QFile file(dir.filePath(QString("file_%1").arg(sizes.size() - i)));
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        file.write(QByteArray(sizes.at(i), 'a'));
+    }
+    ASSERT_TRUE(QDir(dir.path()).mkdir("dir_b"));
+    ASSERT_TRUE(QDir(dir.path()).mkdir("dir_a"));
+    for (const QString &name : QDir(dir.path()).entryList(QDir::AllEntries | QDir::NoDotAndDotDot)) {
+        const DUrl url = DUrl::fromLocalFile(dir.filePath(name));
+        node.appendChildren(url, FileSystemNodePointer(new FileSystemNode(&node, DFileService::instance()->createFileInfo(nullptr, url), nullptr, &lk)));
+    }
+
+    const DAbstractFileInfo::CompareFunction sortFun = FileSortFunction::compareFileListBySize;
+    // 包装后的函数与默认函数结果相同，但不会使用预先取出的排序值
+    const DAbstractFileInfo::CompareFunction wrappedSortFun = [](const DAbstractFileInfoPointer &info1, const DAbstractFileInfoPointer &info2, Qt::SortOrder order, bool isMixedSort) {
+        return FileSortFunction::compareFileListBySize(info1, info2, order, isMixedSort);
+    };
+    bool cancel = false;
+    for (Qt::SortOrder order : {Qt::AscendingOrder, Qt::DescendingOrder}) {
+        node.sortAllChildren(wrappedSortFun, order, &cancel);
+        const QList<FileSystemNodePointer> expected = node.getChildrenList();
+        QList<FileSystemNodePointer> list = expected;
+        std::reverse(list.begin(), list.end());
+        node.setChildrenList(list);
+        node.sortAllChildren(sortFun, order, &cancel);
+        EXPECT_TRUE(node.getChildrenList() == expected);
+        EXPECT_TRUE(node.getChildrenList().first()->fileInfo->isDir());
+    }
+}
+
+TEST(FileSystemNodeTest, cachedDataByRole)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    QFile file(dir.filePath("cached_data.txt"));
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write(QByteArray(10, 'a'));
+    file.flush();
+
+    QReadWriteLock lk;
+    const DUrl url = DUrl::fromLocalFile(file.fileName());
+    FileSystemNode node(nullptr, DFileService::instance()->createFileInfo(nullptr, url), nullptr, &lk);
+    const QString size = node.cachedDataByRole(DFileSystemModel::FileSizeRole, 0).toString();
+    EXPECT_EQ(node.dataByRole(DFileSystemModel::FileSizeRole).toString(), size);
+    EXPECT_TRUE(node.displayDataCache.contains(DFileSystemModel::FileSizeRole));
+
+    // 文件信息刷新前返回缓存的文本
+    file.write(QByteArray(4096, 'a'));
+    file.flush();
+    node.displayDataCache[DFileSystemModel::FileSizeRole] = QStringLiteral("cached");
+    EXPECT_EQ(QStringLiteral("cached"), node.cachedDataByRole(DFileSystemModel::FileSizeRole, 0).toString());
+    EXPECT_NE(QStringLiteral("cached"), node.cachedDataByRole(DFileSystemModel::FileSizeRole, 1).toString());
+
+    node.fileInfo->refresh();
+    EXPECT_NE(size, node.cachedDataByRole(DFileSystemModel::FileSizeRole, 1).toString());
+
+    node.clearDisplayDataCache();
+    EXPECT_TRUE(node.displayDataCache.isEmpty());
+}
+
+TEST(FileSystemNodeTest, shouldHideByFilterRule)
+{
+    QReadWriteLock lk;
+    const DUrl url = DUrl::fromLocalFile("/tmp/filter_test.txt");
+    DAbstractFileInfoPointer info(new DAbstractFileInfo(url, false));
+    FileSystemNode node(nullptr, info, nullptr, &lk);
+    std::shared_ptr<FileFilter> filter(new FileFilter);
+
+    EXPECT_FALSE(node.shouldHideByFilterRule(filter));
+
+    filter->f_comboValid[FILE_TYPE] = true;
+    filter->f_typeString = "";
+    ++filter->f_version[FILE_TYPE];
+    EXPECT_FALSE(node.shouldHideByFilterRule(filter));
+
+    // 条件的版本号不变时使用缓存的结果
+    filter->f_typeString = "dfm-no-such-type/";
+    EXPECT_FALSE(node.shouldHideByFilterRule(filter));
+
+    ++filter->f_version[FILE_TYPE];
+    EXPECT_TRUE(node.shouldHideByFilterRule(filter));
+
+    // 关闭的条件不参与筛选，重新打开时仍使用缓存的结果
+    filter->f_comboValid[FILE_TYPE] = false;
+    EXPECT_FALSE(node.shouldHideByFilterRule(filter));
+    filter->f_comboValid[FILE_TYPE] = true;
+    EXPECT_TRUE(node.shouldHideByFilterRule(filter));
+
+    filter->f_typeString = "";
+    EXPECT_TRUE(node.shouldHideByFilterRule(filter));
+    node.resetFilterResult();
+    EXPECT_FALSE(node.shouldHideByFilterRule(filter));
+}
+
+TEST_F(TestDFileSystemModel, test_rescanDirectory)
+{
+    struct stat st;
+    ASSERT_EQ(0, stat(QFile::encodeName(tmpFileUrl.toLocalFile()).constData(), &st));
+    const qint64 mtime = qint64(st.st_mtim.tv_sec) * 1000 + st.st_mtim.tv_nsec / 1000000;
+
+    // 1.txt 未变化，2.txt 的 inode 不同，3.txt 已不存在
+    QHash<QString, QPair<quint64, qint64>> snapshot;
+    snapshot.insert(tmpFileUrl.fileName(), qMakePair(quint64(st.st_ino), mtime));
+    snapshot.insert(tmpFileUrl2.fileName(), qMakePair(quint64(0), mtime));
+    snapshot.insert("3.txt", qMakePair(quint64(1), mtime));
+    TestHelper::createTmpFileName("4.txt", tmpDirUrl.toLocalFile());
+
+    m_model->rescanDirectory(tmpDirUrl.toLocalFile(), snapshot);
+
+    DFileSystemModelPrivate *d = m_model->d_func();
+    EXPECT_EQ(tmpDirUrl.toLocalFile(), d->rescanPath);
+    EXPECT_EQ(QStringList { "4.txt" }, d->rescanCreated);
+    EXPECT_EQ(QStringList { "3.txt" }, d->rescanRemoved);
+    EXPECT_EQ(QStringList { tmpFileUrl2.fileName() }, d->rescanChanged);
+
+    // 根目录不同时丢弃扫描结果
+    d->_q_onRescanFinished();
+    EXPECT_TRUE(d->rescanCreated.isEmpty());
+}
+
 }
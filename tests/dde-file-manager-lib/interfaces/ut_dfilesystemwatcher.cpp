@@ -0,0 +1,49 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <QFile>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+
+#include "interfaces/dfilesystemwatcher.h"
+
+TEST(TestDFileSystemWatcher, watch_paths)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    DFileSystemWatcher watcher;
+    EXPECT_TRUE(watcher.addPath(dir.path()));
+    EXPECT_TRUE(watcher.isWatched(dir.path()));
+    EXPECT_EQ(QStringList { dir.path() }, watcher.directories());
+    EXPECT_TRUE(watcher.files().isEmpty());
+
+    EXPECT_TRUE(watcher.removePath(dir.path()));
+    EXPECT_FALSE(watcher.isWatched(dir.path()));
+    EXPECT_TRUE(watcher.directories().isEmpty());
+}
+
+TEST(TestDFileSystemWatcher, coalesce_events)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    DFileSystemWatcher watcher;
+    ASSERT_TRUE(watcher.addPath(dir.path()));
+    QSignalSpy spy(&watcher, &DFileSystemWatcher::fileCreated);
+
+    // 短时间内的多个事件在一次读取中处理，每个事件仍然都会发出信号
+    for (int i = 0; i < 10; ++i) {
+        QFile file(dir.filePath(QString::number(i)));
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    }
+
+    for (int i = 0; i < 50 && spy.count() < 10; ++i)
+        spy.wait(100);
+
+    EXPECT_EQ(10, spy.count());
+    EXPECT_EQ(dir.path(), spy.first().at(0).toString());
+}
@@ -7,6 +7,7 @@
 #include "dfmevent.h"
 #define protected public
 #include "dfmabstracteventhandler.h"
+#include "dfmeventdispatcher.h"
 
 DFM_USE_NAMESPACE
 
@@ -48,3 +49,51 @@ TEST_F(TestDFMAbstractEventHandler, fmEventFilter)
 {
     EXPECT_FALSE(handler->fmEventFilter(dMakeEventPointer<DFMEvent>()));
 }
+
+namespace  {
+class CountingEventHandler : public DFMAbstractEventHandler
+{
+public:
+    bool fmEvent(const QSharedPointer<DFMEvent> &event, QVariant *resultData = nullptr) override
+    {
+        Q_UNUSED(resultData)
+
+        types << event->type();
+        return true;
+    }
+
+    QList<int> types;
+};
+}
+
+TEST_F(TestDFMAbstractEventHandler, setHandledEventTypes)
+{
+    const int handledType = DFMEvent::CustomBase + 1;
+    const int otherType = DFMEvent::CustomBase + 2;
+
+    CountingEventHandler counting;
+    DFMEventDispatcher::instance()->processEvent(QSharedPointer<DFMEvent>(new DFMEvent(static_cast<DFMEvent::Type>(otherType), nullptr)));
+    EXPECT_EQ(QList<int>({ otherType }), counting.types);
+
+    // 声明类型后只收到这些类型的事件
+    counting.types.clear();
+    counting.setHandledEventTypes({ handledType });
+    DFMEventDispatcher::instance()->processEvent(QSharedPointer<DFMEvent>(new DFMEvent(static_cast<DFMEvent::Type>(otherType), nullptr)));
+    DFMEventDispatcher::instance()->processEvent(QSharedPointer<DFMEvent>(new DFMEvent(static_cast<DFMEvent::Type>(handledType), nullptr)));
+    EXPECT_EQ(QList<int>({ handledType }), counting.types);
+}
+
+TEST_F(TestDFMAbstractEventHandler, processEventAsync)
+{
+    const int type = DFMEvent::CustomBase + 3;
+
+    CountingEventHandler counting;
+    counting.setHandledEventTypes({ type });
+
+    DFMEventFuture future = DFMEventDispatcher::instance()->processEventAsync(QSharedPointer<DFMEvent>(new DFMEvent(static_cast<DFMEvent::Type>(type), nullptr)),
+                                                                              nullptr, DFMEventDispatcher::BulkPriority);
+    future.waitForFinished();
+    EXPECT_TRUE(future.isFinished());
+    EXPECT_EQ(QList<int>({ type }), counting.types);
+    EXPECT_FALSE(DFMEventDispatcher::isCurrentEventCanceled());
+}
@@ -0,0 +1,160 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <QDir>
+#include <QFile>
+#include <QProcess>
+#include <QtEndian>
+
+#include "interfaces/dfmarchiveindex.h"
+
+namespace {
+class DFMArchiveIndexTest : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        QDir(workDir).removeRecursively();
+        QDir().mkpath(workDir + "/src/dir/sub");
+
+        QFile file(workDir + "/src/dir/a.txt");
+        file.open(QIODevice::WriteOnly);
+        file.write("hello");
+        file.close();
+        QFile::copy(workDir + "/src/dir/a.txt", workDir + "/src/.hidden");
+    }
+
+    void TearDown() override
+    {
+        DFMArchiveIndex::instance()->clear();
+        QDir(workDir).removeRecursively();
+    }
+
+    // 只写入中央目录，建立索引时不读取文件内容
+    static void writeZip(const QString &path, const QList<QPair<QByteArray, quint32>> &files)
+    {
+        QByteArray directory;
+
+        for (const auto &file : files) {
+            QByteArray entry(46, '\0');
+            uchar *data = reinterpret_cast<uchar *>(entry.data());
+
+            qToLittleEndian<quint32>(0x02014b50, data);
+            qToLittleEndian<quint16>(0x0314, data + 4);
+            qToLittleEndian<quint32>(file.second, data + 24);
+            qToLittleEndian<quint16>(static_cast<quint16>(file.first.size()), data + 28);
+            qToLittleEndian<quint32>((file.first.endsWith('/') ? 040755u : 0100644u) << 16, data + 38);
+            directory += entry + file.first;
+        }
+
+        QByteArray end(22, '\0');
+        uchar *data = reinterpret_cast<uchar *>(end.data());
+
+        qToLittleEndian<quint32>(0x06054b50, data);
+        qToLittleEndian<quint16>(static_cast<quint16>(files.size()), data + 8);
+        qToLittleEndian<quint16>(static_cast<quint16>(files.size()), data + 10);
+        qToLittleEndian<quint32>(static_cast<quint32>(directory.size()), data + 12);
+        qToLittleEndian<quint32>(4, data + 16);
+
+        QFile file(path);
+        file.open(QIODevice::WriteOnly);
+        file.write("data" + directory + end);
+    }
+
+    QString workDir = QDir::tempPath() + "/ut_dfmarchiveindex";
+};
+} // namespace
+
+TEST_F(DFMArchiveIndexTest, canIndex)
+{
+    EXPECT_TRUE(DFMArchiveIndex::canIndex("/tmp/a.zip"));
+    EXPECT_TRUE(DFMArchiveIndex::canIndex("/tmp/a.tar.gz"));
+    EXPECT_TRUE(DFMArchiveIndex::canIndex("/tmp/a.TGZ"));
+    EXPECT_FALSE(DFMArchiveIndex::canIndex("/tmp/a.rar"));
+    EXPECT_FALSE(DFMArchiveIndex::canIndex("/tmp/a.tar.xz"));
+}
+
+TEST_F(DFMArchiveIndexTest, tar)
+{
+    for (const QString &name : QStringList() << "test.tar" << "test.tar.gz") {
+        const QString &archive = workDir + "/" + name;
+
+        ASSERT_EQ(0, QProcess::execute("tar", QStringList() << (name.endsWith(".gz") ? "-czf" : "-cf")
+                                       << archive << "-C" << workDir + "/src" << "."));
+
+        QString archivePath;
+        QString innerPath;
+
+        EXPECT_TRUE(DFMArchiveIndex::splitPath(archive + "/dir/a.txt", &archivePath, &innerPath));
+        EXPECT_EQ(archive, archivePath);
+        EXPECT_EQ(QString("dir/a.txt"), innerPath);
+
+        DFMArchiveIndex::Entry entry;
+
+        ASSERT_TRUE(DFMArchiveIndex::instance()->entry(archive + "/dir/a.txt", &entry));
+        EXPECT_EQ(QString("a.txt"), entry.name);
+        EXPECT_EQ(5, entry.size);
+        EXPECT_FALSE(entry.isDir);
+        EXPECT_GT(entry.lastModified, 0);
+
+        ASSERT_TRUE(DFMArchiveIndex::instance()->entry(archive + "/dir", &entry));
+        EXPECT_TRUE(entry.isDir);
+        EXPECT_EQ(2, entry.childCount);
+
+        QList<DFMArchiveIndex::Entry> entries;
+
+        ASSERT_TRUE(DFMArchiveIndex::instance()->entries(archive, &entries));
+        EXPECT_EQ(2, entries.size());
+        EXPECT_FALSE(DFMArchiveIndex::instance()->entry(archive + "/none", &entry));
+        EXPECT_FALSE(DFMArchiveIndex::instance()->entries(archive + "/dir/a.txt", &entries));
+    }
+
+    EXPECT_EQ(2, DFMArchiveIndex::instance()->count());
+}
+
+TEST_F(DFMArchiveIndexTest, zip)
+{
+    const QString &archive = workDir + "/test.zip";
+
+    // 没有单独记录的上级目录会被补全
+    writeZip(archive, QList<QPair<QByteArray, quint32>>() << qMakePair(QByteArray("a/"), 0u)
+             << qMakePair(QByteArray("a/b.txt"), 10u) << qMakePair(QByteArray("c/d/e.txt"), 20u));
+
+    DFMArchiveIndex::Entry entry;
+
+    ASSERT_TRUE(DFMArchiveIndex::instance()->entry(archive + "/a/b.txt", &entry));
+    EXPECT_EQ(10, entry.size);
+    EXPECT_EQ(0644u, entry.mode);
+    ASSERT_TRUE(DFMArchiveIndex::instance()->entry(archive + "/c/d", &entry));
+    EXPECT_TRUE(entry.isDir);
+    EXPECT_EQ(1, entry.childCount);
+
+    QList<DFMArchiveIndex::Entry> entries;
+
+    ASSERT_TRUE(DFMArchiveIndex::instance()->entries(archive, &entries));
+    EXPECT_EQ(2, entries.size());
+
+    // 压缩包变化后重新建立索引
+    writeZip(archive, QList<QPair<QByteArray, quint32>>() << qMakePair(QByteArray("f.txt"), 1u)
+             << qMakePair(QByteArray("g.txt"), 1u) << qMakePair(QByteArray("h.txt"), 1u));
+    entries.clear();
+    ASSERT_TRUE(DFMArchiveIndex::instance()->entries(archive, &entries));
+    EXPECT_EQ(3, entries.size());
+}
+
+TEST_F(DFMArchiveIndexTest, invalidArchive)
+{
+    const QString &archive = workDir + "/broken.zip";
+    QFile file(archive);
+
+    file.open(QIODevice::WriteOnly);
+    file.write("not a zip file");
+    file.close();
+
+    EXPECT_FALSE(DFMArchiveIndex::instance()->entries(archive, nullptr));
+    EXPECT_FALSE(DFMArchiveIndex::instance()->entries(workDir + "/src/dir", nullptr));
+    EXPECT_EQ(0, DFMArchiveIndex::instance()->count());
+}
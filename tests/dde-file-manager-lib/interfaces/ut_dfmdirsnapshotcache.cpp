@@ -0,0 +1,75 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <QDir>
+#include <QTemporaryDir>
+
+#include "dfileservices.h"
+#include "interfaces/dfmdirsnapshotcache.h"
+
+namespace {
+class DFMDirSnapshotCacheTest : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        ASSERT_TRUE(tempDir.isValid());
+        dirUrl = DUrl::fromLocalFile(tempDir.path());
+        fileUrl = DUrl::fromLocalFile(tempDir.path() + "/a.txt");
+
+        QFile file(fileUrl.toLocalFile());
+        file.open(QIODevice::WriteOnly);
+        file.close();
+
+        DFMDirSnapshotCache::instance()->clear();
+    }
+
+    void TearDown() override
+    {
+        DFMDirSnapshotCache::instance()->clear();
+    }
+
+    QTemporaryDir tempDir;
+    DUrl dirUrl;
+    DUrl fileUrl;
+};
+}
+
+TEST_F(DFMDirSnapshotCacheTest, canCache)
+{
+    EXPECT_TRUE(DFMDirSnapshotCache::canCache(DFileService::instance()->createFileInfo(nullptr, dirUrl)));
+    EXPECT_FALSE(DFMDirSnapshotCache::canCache(DFileService::instance()->createFileInfo(nullptr, fileUrl)));
+    EXPECT_FALSE(DFMDirSnapshotCache::canCache(DAbstractFileInfoPointer()));
+}
+
+TEST_F(DFMDirSnapshotCacheTest, insertAndSnapshot)
+{
+    DFMDirSnapshotCache *cache = DFMDirSnapshotCache::instance();
+    const QDir::Filters filters = QDir::AllEntries | QDir::NoDotAndDotDot;
+    QList<DAbstractFileInfoPointer> infoList { DFileService::instance()->createFileInfo(nullptr, fileUrl) };
+
+    EXPECT_FALSE(cache->snapshot(dirUrl, filters, nullptr));
+    EXPECT_TRUE(cache->insert(dirUrl, filters, infoList));
+    EXPECT_EQ(1, cache->count());
+
+    QList<DAbstractFileInfoPointer> result;
+    EXPECT_TRUE(cache->snapshot(dirUrl, filters, &result));
+    ASSERT_EQ(1, result.size());
+    EXPECT_EQ(fileUrl, result.first()->fileUrl());
+
+    // 过滤条件不同时不能使用快照
+    EXPECT_FALSE(cache->snapshot(dirUrl, filters | QDir::Hidden, &result));
+
+    // 重复插入时替换原有快照
+    EXPECT_TRUE(cache->insert(dirUrl, filters, {}));
+    EXPECT_EQ(1, cache->count());
+    EXPECT_TRUE(cache->snapshot(dirUrl, filters, &result));
+    EXPECT_TRUE(result.isEmpty());
+
+    cache->remove(dirUrl);
+    EXPECT_EQ(0, cache->count());
+    EXPECT_FALSE(cache->snapshot(dirUrl, filters, &result));
+}
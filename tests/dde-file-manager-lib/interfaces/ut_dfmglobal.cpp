@@ -25,6 +25,8 @@
 #include <QPainter>
 #include <QTextCodec>
 #include <QApplication>
+#include <QClipboard>
+#include <QMimeData>
 
 using namespace stub_ext;
 
@@ -96,6 +98,23 @@ TEST_F(TestDFMGlobal, test_clipboard)
     EXPECT_TRUE(DFMGlobal::fetchUrlsFromClipboard().isEmpty());
 }
 
+TEST_F(TestDFMGlobal, test_clipboard_deferred_formats)
+{
+    const QList<QUrl> urls {QUrl::fromLocalFile(m_filePath), QUrl::fromLocalFile("/tmp/ut_dfmglobal_b")};
+
+    DFMGlobal::setUrlsToClipboard(urls, DFMGlobal::CutAction);
+
+    const QMimeData *mimeData = qApp->clipboard()->mimeData();
+    ASSERT_TRUE(mimeData);
+    EXPECT_TRUE(mimeData->hasUrls());
+    EXPECT_EQ(urls, mimeData->urls());
+    EXPECT_EQ(urls, DFMGlobal::fetchUrlsFromClipboard());
+    EXPECT_TRUE(mimeData->data("x-special/gnome-copied-files").startsWith("cut\n"));
+    EXPECT_EQ(m_filePath + "\n/tmp/ut_dfmglobal_b", mimeData->text());
+
+    DFMGlobal::clearClipboard();
+}
+
 TEST_F(TestDFMGlobal, test_pluginLibrary)
 {
     DFMGlobal::initPluginManager();
@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <QFile>
+#include <QTemporaryDir>
+#include <QThreadPool>
+
+#include "interfaces/dgvfsfileinfo.h"
+#include "interfaces/dfmlistingcache.h"
+
+TEST(DFMListingCacheTest, cacheKey)
+{
+    const DUrl &url = DUrl::fromLocalFile("/run/user/1000/gvfs/smb-share:server=host,share=docs/dir/");
+
+    EXPECT_EQ(QString("smb-share:server=host,share=docs/dir"), DFMListingCache::cacheKey(url));
+    // 与用户无关，只与挂载的设备和路径有关
+    EXPECT_EQ(DFMListingCache::cacheKey(url),
+              DFMListingCache::cacheKey(DUrl::fromLocalFile("/run/user/1001/gvfs/smb-share:server=host,share=docs/dir")));
+    EXPECT_EQ(QString("smb-share:server=host,share=docs/"),
+              DFMListingCache::cacheKey(DUrl::fromLocalFile("/run/user/1000/gvfs/smb-share:server=host,share=docs")));
+}
+
+TEST(DFMListingCacheTest, saveAndLoad)
+{
+    QTemporaryDir tempDir;
+    ASSERT_TRUE(tempDir.isValid());
+
+    const DUrl &dirUrl = DUrl::fromLocalFile(tempDir.path());
+    const DUrl &fileUrl = DUrl::fromLocalFile(tempDir.path() + "/a.txt");
+    QFile file(fileUrl.toLocalFile());
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write("test");
+    file.close();
+
+    EXPECT_FALSE(DFMListingCache::canCache(dirUrl));
+
+    const QDir::Filters filters = QDir::AllEntries | QDir::NoDotAndDotDot;
+    DAbstractFileInfoPointer info(new DGvfsFileInfo(fileUrl, false));
+
+    DFMListingCache::save(dirUrl, filters, {info});
+    QThreadPool::globalInstance()->waitForDone();
+
+    QList<DAbstractFileInfoPointer> infoList;
+    EXPECT_TRUE(DFMListingCache::load(dirUrl, filters, &infoList));
+    ASSERT_EQ(1, infoList.size());
+    EXPECT_EQ(fileUrl, infoList.first()->fileUrl());
+    EXPECT_EQ(info->size(), infoList.first()->size());
+    EXPECT_EQ(info->lastModified(), infoList.first()->lastModified());
+    EXPECT_FALSE(infoList.first()->isDir());
+
+    // 过滤条件不同时不能使用缓存
+    EXPECT_FALSE(DFMListingCache::load(dirUrl, filters | QDir::Hidden, &infoList));
+
+    DFMListingCache::remove(dirUrl);
+    EXPECT_FALSE(DFMListingCache::load(dirUrl, filters, &infoList));
+}
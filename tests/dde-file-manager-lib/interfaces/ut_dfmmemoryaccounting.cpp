@@ -0,0 +1,30 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include "interfaces/dfmmemoryaccounting.h"
+
+TEST(DFMMemoryAccountingTest, usage)
+{
+    // 注册后不会移除，使用静态变量保证一直有效
+    static qint64 bytes = 4096;
+
+    DFMMemoryAccounting::registerSubsystem("ut.memory", [] { return bytes; }, [] { bytes = 0; });
+
+    QVariantMap map = DFMMemoryAccounting::usage();
+
+    EXPECT_EQ(4096, map.value("ut.memory").toLongLong());
+    EXPECT_GE(map.value("total").toLongLong(), 4096);
+    EXPECT_GT(map.value("rss").toLongLong(), 0);
+    EXPECT_TRUE(map.contains("fileInfo"));
+
+    // 未设置上限时不清理
+    EXPECT_EQ(0, DFMMemoryAccounting::softLimit());
+    EXPECT_EQ(0, DFMMemoryAccounting::trim());
+    EXPECT_EQ(4096, bytes);
+
+    EXPECT_GE(DFMMemoryAccounting::trim(true), 1);
+    EXPECT_EQ(0, bytes);
+}
@@ -0,0 +1,25 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include "interfaces/dfmmetrics.h"
+
+TEST(DFMMetricsTest, snapshot)
+{
+    EXPECT_EQ(DFMMetrics::counter("ut.counter"), DFMMetrics::counter("ut.counter"));
+
+    for (int i = 0; i < 3; ++i)
+        DFM_METRIC_INC("ut.counter");
+
+    DFM_METRIC_ADD("ut.counter", -1);
+    DFM_METRIC_SET("ut.gauge", 42);
+
+    const QVariantMap &map = DFMMetrics::snapshot();
+
+    EXPECT_EQ(2, map.value("ut.counter").toLongLong());
+    EXPECT_EQ(42, map.value("ut.gauge").toLongLong());
+    EXPECT_TRUE(map.contains("threadPool.active"));
+    EXPECT_TRUE(map.contains("threadPool.max"));
+}
@@ -0,0 +1,49 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <QRegExp>
+
+#include "interfaces/dfmnamefiltermatcher.h"
+
+TEST(DFMNameFilterMatcherTest, suffixAndNames)
+{
+    const DFMNameFilterMatcher matcher(QStringList() << "*.jpg" << "*.tar.gz" << "Makefile");
+
+    EXPECT_FALSE(matcher.isEmpty());
+    EXPECT_TRUE(matcher.matches("a.jpg"));
+    EXPECT_TRUE(matcher.matches("A.JPG"));
+    EXPECT_TRUE(matcher.matches(".jpg"));
+    EXPECT_TRUE(matcher.matches("a.b.jpg"));
+    EXPECT_TRUE(matcher.matches("a.tar.gz"));
+    EXPECT_TRUE(matcher.matches("makefile"));
+    EXPECT_FALSE(matcher.matches("a.jpeg"));
+    EXPECT_FALSE(matcher.matches("a.gz"));
+    EXPECT_FALSE(matcher.matches("jpg"));
+
+    const DFMNameFilterMatcher sensitive(QStringList() << "*.jpg", Qt::CaseSensitive);
+
+    EXPECT_TRUE(sensitive.matches("a.jpg"));
+    EXPECT_FALSE(sensitive.matches("a.JPG"));
+
+    EXPECT_TRUE(DFMNameFilterMatcher().isEmpty());
+    EXPECT_TRUE(DFMNameFilterMatcher().matches("a.txt"));
+    EXPECT_TRUE(DFMNameFilterMatcher(QStringList() << "*").matches("a.txt"));
+}
+
+TEST(DFMNameFilterMatcherTest, sameAsQRegExp)
+{
+    const QStringList patterns {"*.jp?g", "img_[0-9]*", "[!a]*.txt", "[^a]*", "*.(1)", "a\\b*", "*+{1}"};
+    const QStringList names {"a.jpg", "a.jpeg", "a.jpxg", "IMG_1.png", "img_x", "b.txt", "a.txt", "^b", "+{1}",
+                             "f.(1)", "f.1", "a\\bc", "abc"};
+
+    for (const QString &pattern : patterns) {
+        const DFMNameFilterMatcher matcher(QStringList() << pattern);
+        QRegExp re(pattern, Qt::CaseInsensitive, QRegExp::Wildcard);
+
+        for (const QString &name : names)
+            EXPECT_EQ(re.exactMatch(name), matcher.matches(name)) << pattern.toStdString() << " " << name.toStdString();
+    }
+}
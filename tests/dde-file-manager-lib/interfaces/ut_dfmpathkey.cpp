@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <QHash>
+
+#include "interfaces/dfmpathkey.h"
+
+TEST(DFMPathKeyTest, internLocalFile)
+{
+    const DUrl url = DUrl::fromLocalFile("/tmp/ut_dfmpathkey/a.txt");
+    const DFMPathKey key1(url);
+    const DFMPathKey key2 = DFMPathKey::fromLocalFile("/tmp/ut_dfmpathkey/a.txt");
+    const DFMPathKey key3(DUrl::fromLocalFile("/tmp/ut_dfmpathkey/b.txt"));
+
+    EXPECT_FALSE(key1.isNull());
+    EXPECT_TRUE(key1.isLocalFile());
+    EXPECT_TRUE(key1 == key2);
+    EXPECT_TRUE(key1 != key3);
+    EXPECT_EQ(qHash(key1), qHash(key2));
+    EXPECT_EQ(QByteArray("/tmp/ut_dfmpathkey/a.txt"), key1.path());
+    EXPECT_EQ(url, key1.toUrl());
+
+    // 相同路径共享池中的同一份数据
+    const int count = DFMPathKey::poolCount();
+    {
+        DFMPathKey key4(url);
+        DFMPathKey key5(DUrl::fromLocalFile("/tmp/ut_dfmpathkey/c.txt"));
+        EXPECT_EQ(count + 1, DFMPathKey::poolCount());
+    }
+    EXPECT_EQ(count, DFMPathKey::poolCount());
+}
+
+TEST(DFMPathKeyTest, otherScheme)
+{
+    const DUrl url = DUrl::fromTrashFile("/a.txt");
+    const DFMPathKey key(url);
+
+    EXPECT_FALSE(key.isLocalFile());
+    EXPECT_EQ(url, key.toUrl());
+    EXPECT_TRUE(key != DFMPathKey(DUrl::fromLocalFile("/a.txt")));
+
+    EXPECT_TRUE(DFMPathKey(DUrl()).isNull());
+    EXPECT_TRUE(DFMPathKey() == DFMPathKey(DUrl()));
+}
+
+TEST(DFMPathKeyTest, hashKey)
+{
+    QHash<DFMPathKey, int> hash;
+
+    hash.insert(DUrl::fromLocalFile("/tmp/ut_dfmpathkey/a.txt"), 1);
+    hash.insert(DUrl::fromLocalFile("/tmp/ut_dfmpathkey/b.txt"), 2);
+
+    EXPECT_EQ(1, hash.value(DUrl::fromLocalFile("/tmp/ut_dfmpathkey/a.txt")));
+    EXPECT_EQ(2, hash.value(DFMPathKey::fromLocalFile("/tmp/ut_dfmpathkey/b.txt")));
+    EXPECT_FALSE(hash.contains(DUrl::fromLocalFile("/tmp/ut_dfmpathkey/c.txt")));
+}
@@ -6,6 +6,11 @@
 
 #include <gtest/gtest.h>
 
+#include <QDir>
+#include <QFile>
+#include <QTimer>
+#include <QEventLoop>
+
 DFM_USE_NAMESPACE
 
 namespace  {
@@ -125,3 +130,30 @@ TEST_F(TestDFMSettings, setWatchChanges)
 {
     setting->setWatchChanges(true);
 }
+
+TEST_F(TestDFMSettings, syncInBackground)
+{
+    const QString settingFile = QDir::tempPath() + "/ut_dfmsettings_background.json";
+    QFile::remove(settingFile);
+
+    DFMSettings *autoSetting = new DFMSettings(QString(), QString(), settingFile);
+    autoSetting->setAutoSync(true);
+    autoSetting->setValue("ut", "key", 1);
+    autoSetting->setValue("ut", "key", 2);
+
+    // 等待同步定时器触发并完成后台写入
+    QEventLoop loop;
+    QTimer::singleShot(1500, &loop, &QEventLoop::quit);
+    loop.exec();
+
+    DFMSettings reader(QString(), QString(), settingFile);
+    EXPECT_EQ(2, reader.value("ut", "key").toInt());
+
+    // 析构时写入未同步的修改
+    autoSetting->setValue("ut", "key", 3);
+    delete autoSetting;
+    reader.reload();
+    EXPECT_EQ(3, reader.value("ut", "key").toInt());
+
+    QFile::remove(settingFile);
+}
@@ -0,0 +1,40 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include "interfaces/dfmstartupprofile.h"
+
+TEST(DFMStartupProfileTest, recordPhases)
+{
+    // 开始前的调用不做任何事
+    DFMStartupProfile::mark("beforeStart");
+    EXPECT_FALSE(DFMStartupProfile::contains("beforeStart"));
+
+    DFMStartupProfile::start();
+    DFMStartupProfile::mark("first");
+    const qint64 beginTime = DFMStartupProfile::elapsed();
+    DFMStartupProfile::mark("second");
+    DFMStartupProfile::record("side", beginTime);
+    // 每个阶段只记录第一次
+    DFMStartupProfile::mark("first");
+
+    EXPECT_TRUE(DFMStartupProfile::contains("first"));
+    EXPECT_TRUE(DFMStartupProfile::contains("side"));
+    EXPECT_FALSE(DFMStartupProfile::contains("beforeStart"));
+
+    const QVariantMap &phases = DFMStartupProfile::phases();
+    const QVariantMap &first = phases.value("first").toMap();
+    const QVariantMap &second = phases.value("second").toMap();
+
+    EXPECT_EQ(0, first.value("begin").toLongLong());
+    EXPECT_EQ(first.value("duration").toLongLong(), second.value("begin").toLongLong());
+    EXPECT_GE(phases.value("side").toMap().value("duration").toLongLong(), 0);
+
+    DFMStartupProfile::finish();
+    EXPECT_TRUE(DFMStartupProfile::isFinished());
+
+    DFMStartupProfile::mark("afterFinish");
+    EXPECT_FALSE(DFMStartupProfile::phases().contains("afterFinish"));
+}
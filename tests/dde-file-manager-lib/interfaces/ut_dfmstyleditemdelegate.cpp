@@ -83,6 +83,11 @@ public:
     {
         DFMStyledItemDelegate::paintIcon(painter,icon,rect,alignment,mode,state);
     }
+
+    QString elideTextMine(const QString &text, const QSizeF &size, const QFont &font, Qt::TextElideMode mode)
+    {
+        return DFMStyledItemDelegate::elideText(text, size, QTextOption::NoWrap, font, mode, 20);
+    }
 };
 
 namespace {
@@ -255,6 +260,23 @@ TEST_F(DFMStyledItemDelegateTest,drawTest2)
     EXPECT_TRUE(1 == delegate->drawText(QModelIndex(), &painter, QString("testString"),QRectF(),0.0,QBrush()).size());
 }
 
+TEST_F(DFMStyledItemDelegateTest,elideText)
+{
+    DFMStyledItemDelegateInherit *inherit = static_cast<DFMStyledItemDelegateInherit *>(delegate);
+    const QString text("a very long file name for elide text cache test.txt");
+    const QFont font = this->font();
+    const QString &expected = DFMGlobal::elideText(text, QSizeF(60, 20), QTextOption::NoWrap, font, Qt::ElideRight, 20);
+
+    EXPECT_EQ(expected, inherit->elideTextMine(text, QSizeF(60, 20), font, Qt::ElideRight));
+    // 命中缓存时结果不变
+    EXPECT_EQ(expected, inherit->elideTextMine(text, QSizeF(60, 20), font, Qt::ElideRight));
+    // 参数不同不能命中同一个缓存
+    EXPECT_EQ(text, inherit->elideTextMine(text, QSizeF(10000, 20), font, Qt::ElideRight));
+
+    delegate->clearTextCache();
+    EXPECT_EQ(expected, inherit->elideTextMine(text, QSizeF(60, 20), font, Qt::ElideRight));
+}
+
 TEST_F(DFMStyledItemDelegateTest,paintCircleList)
 {
     QPainter painter(this);
@@ -300,3 +322,18 @@ TEST_F(DFMStyledItemDelegateTest,getIconPixmap)
 }
 #endif
 
+TEST_F(DFMStyledItemDelegateTest,getIconPixmap_cached)
+{
+    const QPixmap &first = DFMStyledItemDelegate::getIconPixmap(QIcon::fromTheme("edit-undo"), QSize(32, 32), 1.0);
+
+    if (first.isNull())
+        return;
+
+    // 同名主题图标共用缓存的位图
+    const QPixmap &second = DFMStyledItemDelegate::getIconPixmap(QIcon::fromTheme("edit-undo"), QSize(32, 32), 1.0);
+    EXPECT_EQ(first.cacheKey(), second.cacheKey());
+
+    const QPixmap &larger = DFMStyledItemDelegate::getIconPixmap(QIcon::fromTheme("edit-undo"), QSize(64, 64), 1.0);
+    EXPECT_NE(first.cacheKey(), larger.cacheKey());
+}
+
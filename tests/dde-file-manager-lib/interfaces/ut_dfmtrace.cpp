@@ -0,0 +1,62 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <QTemporaryDir>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+
+#include "interfaces/dfmtrace.h"
+
+TEST(DFMTraceTest, exportChromeTrace)
+{
+    QTemporaryDir dir;
+    const QString &filePath = dir.filePath("trace.json");
+
+    EXPECT_FALSE(DFMTrace::isEnabled());
+    EXPECT_FALSE(DFMTrace::stop());
+
+    ASSERT_TRUE(DFMTrace::start(filePath));
+    EXPECT_TRUE(DFMTrace::isEnabled());
+    {
+        DFM_TRACE_SPAN("test", "span");
+        DFM_TRACE_COUNTER("test", "counter", 42);
+    }
+    ASSERT_TRUE(DFMTrace::stop());
+    EXPECT_FALSE(DFMTrace::isEnabled());
+
+    // 关闭后不再记录
+    DFM_TRACE_COUNTER("test", "disabled", 1);
+
+    QFile file(filePath);
+    ASSERT_TRUE(file.open(QIODevice::ReadOnly));
+
+    const QJsonArray &events = QJsonDocument::fromJson(file.readAll()).object().value("traceEvents").toArray();
+    bool hasSpan = false;
+    bool hasCounter = false;
+
+    for (const QJsonValue &value : events) {
+        const QJsonObject &event = value.toObject();
+        const QString &name = event.value("name").toString();
+
+        EXPECT_NE(QString("disabled"), name);
+
+        if (name == "span") {
+            hasSpan = true;
+            EXPECT_EQ(QString("X"), event.value("ph").toString());
+            EXPECT_EQ(QString("test"), event.value("cat").toString());
+            EXPECT_GE(event.value("dur").toDouble(), 0);
+        } else if (name == "counter") {
+            hasCounter = true;
+            EXPECT_EQ(QString("C"), event.value("ph").toString());
+            EXPECT_EQ(42, event.value("args").toObject().value("value").toInt());
+        }
+    }
+
+    EXPECT_TRUE(hasSpan);
+    EXPECT_TRUE(hasCounter);
+}
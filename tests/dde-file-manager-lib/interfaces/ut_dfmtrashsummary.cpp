@@ -0,0 +1,62 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <QDir>
+#include <QFile>
+
+#include "interfaces/dfmtrashsummary.h"
+
+namespace {
+void writeFile(const QString &path, int size)
+{
+    QFile file(path);
+
+    file.open(QIODevice::WriteOnly);
+    file.write(QByteArray(size, 'a'));
+}
+}
+
+TEST(DFMTrashSummaryTest, incrementalSummary)
+{
+    const QString &root = QDir::tempPath() + "/ut_dfmtrashsummary";
+    const QString &files = root + "/files";
+    const QString &cacheFile = root + "/summary.json";
+
+    QDir(root).removeRecursively();
+    QDir().mkpath(files + "/dir");
+    writeFile(files + "/a.txt", 10);
+    writeFile(files + "/dir/b.txt", 20);
+
+    int count = 0;
+    qint64 size = 0;
+    {
+        DFMTrashSummary summary(files, cacheFile);
+
+        EXPECT_TRUE(summary.summary(&count, &size));
+        EXPECT_EQ(2, count);
+        EXPECT_EQ(30, size);
+        EXPECT_TRUE(summary.save());
+    }
+
+    // 新建的统计从缓存中读取，只计算新增的文件
+    writeFile(files + "/c.txt", 5);
+    QFile::remove(files + "/a.txt");
+    {
+        DFMTrashSummary summary(files, cacheFile);
+
+        EXPECT_TRUE(summary.summary(&count, &size));
+        EXPECT_EQ(2, count);
+        EXPECT_EQ(25, size);
+
+        summary.clear();
+        QDir(files).removeRecursively();
+        EXPECT_FALSE(summary.summary(&count, &size));
+        EXPECT_EQ(0, count);
+        EXPECT_EQ(0, size);
+    }
+
+    QDir(root).removeRecursively();
+}
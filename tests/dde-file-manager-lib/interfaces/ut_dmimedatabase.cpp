@@ -4,6 +4,7 @@
 
 #include <gtest/gtest.h>
 #include <QFileInfo>
+#include <QTemporaryDir>
 
 #include "dmimedatabase.h"
 #include "testhelper.h"
@@ -37,6 +38,45 @@ TEST_F(DMimeDatabaseTest, can_get_mimeTypeForUrl)
     EXPECT_TRUE(db.mimeTypeForUrl(url).name().contains("xml"));
 }
 
+TEST_F(DMimeDatabaseTest, sharedMimeType)
+{
+    const QMimeType &type1 = db.QMimeDatabase::mimeTypeForName("text/plain");
+    const QMimeType &type2 = db.QMimeDatabase::mimeTypeForName("text/plain");
+
+    const QMimeType &shared1 = DMimeDatabase::sharedMimeType(type1);
+    const QMimeType &shared2 = DMimeDatabase::sharedMimeType(type2);
+    const QMimeType &shared3 = db.mimeTypeForName("text/plain");
+
+    EXPECT_EQ(QString("text/plain"), shared1.name());
+    // QMimeType只包含一个指向数据的指针，共享时两者指向同一份数据
+    EXPECT_EQ(*reinterpret_cast<const void *const *>(&shared1), *reinterpret_cast<const void *const *>(&shared2));
+    EXPECT_EQ(*reinterpret_cast<const void *const *>(&shared1), *reinterpret_cast<const void *const *>(&shared3));
+    EXPECT_FALSE(DMimeDatabase::sharedMimeType(QMimeType()).isValid());
+}
+
+TEST_F(DMimeDatabaseTest, mimeTypeForFileCache)
+{
+    QTemporaryDir tempDir;
+    ASSERT_TRUE(tempDir.isValid());
+
+    // 没有扩展名，只能通过内容检测
+    const QString &filePath = tempDir.path() + "/noextension";
+    QFile file(filePath);
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write("%PDF-1.4\n");
+    file.close();
+
+    EXPECT_EQ(QString("application/pdf"), db.mimeTypeForFile(filePath).name());
+    EXPECT_EQ(QString("application/pdf"), db.mimeTypeForFile(QFileInfo(filePath)).name());
+
+    // 文件内容变化后大小和修改时间不同，重新检测
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    file.write("<?xml version=\"1.0\"?>\n<root/>\n");
+    file.close();
+
+    EXPECT_EQ(QString("application/xml"), db.mimeTypeForFile(filePath).name());
+}
+
 //TEST_F(DMimeDatabaseTest, can_get_mimeTypeForFile)
 //{
 //    DUrl url;
@@ -0,0 +1,124 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "interfaces/dthumbnailindex.h"
+
+DFM_USE_NAMESPACE
+
+namespace {
+class DThumbnailIndexTest : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        ASSERT_TRUE(tempDir.isValid());
+        QDir(tempDir.path()).mkpath("normal");
+        QDir(tempDir.path()).mkpath("fail");
+    }
+
+    QString thumbnailPath(const QString &directory, int number)
+    {
+        const QByteArray &md5 = QCryptographicHash::hash(QByteArray::number(number), QCryptographicHash::Md5).toHex();
+
+        return tempDir.path() + QDir::separator() + directory + QDir::separator() + QString::fromLatin1(md5) + ".png";
+    }
+
+    QString writeThumbnail(const QString &directory, int number, int size)
+    {
+        const QString &path = thumbnailPath(directory, number);
+        QFile file(path);
+
+        if (file.open(QIODevice::WriteOnly))
+            file.write(QByteArray(size, 'x'));
+
+        return path;
+    }
+
+    QTemporaryDir tempDir;
+};
+}
+
+TEST_F(DThumbnailIndexTest, check_and_insert)
+{
+    DThumbnailIndex index(tempDir.path());
+    const QString &path = thumbnailPath("normal", 1);
+
+    EXPECT_EQ(index.check(path, 100), DThumbnailIndex::Unindexed);
+
+    index.insert(path, 100, 10);
+    EXPECT_EQ(index.check(path, 100), DThumbnailIndex::Valid);
+    EXPECT_EQ(index.check(path, 101), DThumbnailIndex::Stale);
+    EXPECT_EQ(index.count(), 1);
+    EXPECT_EQ(index.totalSize(), 10);
+
+    // 不在缩略图目录中的文件不记录
+    index.insert(tempDir.path() + "/other/a.png", 100, 10);
+    EXPECT_EQ(index.count(), 1);
+
+    index.remove(path);
+    EXPECT_EQ(index.check(path, 100), DThumbnailIndex::Unindexed);
+    EXPECT_EQ(index.totalSize(), 0);
+}
+
+TEST_F(DThumbnailIndexTest, collect_garbage)
+{
+    DThumbnailIndex index(tempDir.path());
+    QStringList paths;
+
+    for (int i = 0; i < 10; ++i) {
+        paths << writeThumbnail("normal", i, 100);
+        index.insert(paths.last(), 100, 100);
+    }
+
+    index.setLimits(1000, 5);
+    index.collectGarbage();
+
+    EXPECT_LE(index.count(), 4);
+    EXPECT_LE(index.totalSize(), 800);
+
+    int existsCount = 0;
+
+    for (const QString &path : paths) {
+        if (QFile::exists(path))
+            ++existsCount;
+    }
+
+    EXPECT_EQ(existsCount, index.count());
+}
+
+TEST_F(DThumbnailIndexTest, save_and_load)
+{
+    const QString &path = thumbnailPath("fail", 1);
+
+    {
+        DThumbnailIndex index(tempDir.path());
+        index.insert(path, 100, 10);
+        EXPECT_TRUE(index.save());
+    }
+
+    DThumbnailIndex index(tempDir.path());
+    EXPECT_EQ(index.check(path, 100), DThumbnailIndex::Valid);
+    EXPECT_EQ(index.totalSize(), 10);
+}
+
+TEST_F(DThumbnailIndexTest, rebuild)
+{
+    const QString &path = writeThumbnail("normal", 1, 20);
+    writeThumbnail("normal", 2, 30);
+
+    DThumbnailIndex index(tempDir.path());
+    index.rebuild();
+
+    EXPECT_EQ(index.count(), 2);
+    EXPECT_EQ(index.totalSize(), 50);
+    // 扫描得到的记录不知道源文件的修改时间
+    EXPECT_EQ(index.check(path, 100), DThumbnailIndex::Unindexed);
+}
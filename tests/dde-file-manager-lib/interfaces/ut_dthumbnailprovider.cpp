@@ -209,6 +209,19 @@ TEST_F(DThumbnailProviderTest, test_thumbnailFilePath_fileReadError)
     ASSERT_TRUE(thumbnailProvide->thumbnailFilePath(info, DThumbnailProvider::Normal).isEmpty());
 }
 
+TEST_F(DThumbnailProviderTest, test_thumbnailPixmap_cached)
+{
+    QFileInfo info(THUMBNAIL_RESOURCE"logo.png");
+    ASSERT_TRUE(info.exists());
+    QString thumbnailPath = thumbnailProvide->createThumbnail(info, DThumbnailProvider::Normal);
+    ASSERT_FALSE(thumbnailPath.isEmpty());
+    ASSERT_TRUE(QFile(thumbnailPath).remove());
+    // 已解码的缩略图不再从磁盘读取
+    EXPECT_FALSE(thumbnailProvide->thumbnailPixmap(info, DThumbnailProvider::Normal).isNull());
+    thumbnailProvide->d_func()->imageCache.clear();
+    EXPECT_TRUE(thumbnailProvide->thumbnailPixmap(info, DThumbnailProvider::Normal).isNull());
+}
+
 TEST_F(DThumbnailProviderTest, test_appendToProduceQueue)
 {
     QFileInfo pngInfo(THUMBNAIL_RESOURCE"logo.png");
@@ -261,9 +274,9 @@ TEST_F(DThumbnailProviderTest, test_removeInProduceQueue)
     condition.wait(&mutex, 2000); // 需要等appendToProduceQueue执行完成才能进行移除
     thumbnailProvide->removeInProduceQueue(pngInfo, DThumbnailProvider::Normal);
     const QPair<QString, DThumbnailProvider::Size> &tmpKey = qMakePair(pngInfo.absoluteFilePath(), DThumbnailProvider::Normal);
-    auto discardedProduceInfos = thumbnailProvide->d_func()->discardedProduceInfos;
-    ASSERT_TRUE(discardedProduceInfos.contains(tmpKey));
-    discardedProduceInfos.remove(tmpKey);
+    QReadLocker dataLocker(&thumbnailProvide->d_func()->dataReadWriteLock);
+    ASSERT_FALSE(thumbnailProvide->d_func()->produceInfos.contains(tmpKey));
+    dataLocker.unlock();
     sem.tryAcquire(2, 2000);
     QFile savePngFile(savePngImage);
     if(savePngFile.exists()) {
@@ -271,12 +284,135 @@ TEST_F(DThumbnailProviderTest, test_removeInProduceQueue)
     }
 }
 
+TEST_F(DThumbnailProviderTest, test_appendToProduceQueue_coalesce)
+{
+    QFileInfo pngInfo(THUMBNAIL_RESOURCE"logo.png");
+    ASSERT_TRUE(pngInfo.exists());
+    QString savePngImage = calculateThumbnailPath(pngInfo);
+    QStringList thumbnailPaths;
+    QMutex pathMutex;
+    QSemaphore sem(0);
+    auto callback = [&](const QString & path) {
+        QMutexLocker locker(&pathMutex);
+        thumbnailPaths << path;
+        sem.release();
+    };
+    thumbnailProvide->appendToProduceQueue(pngInfo, DThumbnailProvider::Normal, callback);
+    thumbnailProvide->appendToProduceQueue(pngInfo, DThumbnailProvider::Normal, callback, DThumbnailProvider::PrefetchPriority);
+    ASSERT_TRUE(sem.tryAcquire(2, 2000));
+    EXPECT_EQ(thumbnailPaths, QStringList({savePngImage, savePngImage}));
+    QFile savePngFile(savePngImage);
+    if (savePngFile.exists()) {
+        savePngFile.remove();
+    }
+}
+
+TEST_F(DThumbnailProviderTest, test_takeProduceInfo_priority)
+{
+    DThumbnailProviderPrivate d(nullptr);
+    auto addInfo = [&d](const QString &path, DThumbnailProvider::Priority priority) {
+        QSharedPointer<DThumbnailProviderPrivate::ProduceInfo> info(new DThumbnailProviderPrivate::ProduceInfo());
+        info->fileInfo = QFileInfo(path);
+        info->size = DThumbnailProvider::Large;
+        info->priority = priority;
+        d.pushProduceInfo(info);
+        return info;
+    };
+    addInfo("/tmp/prefetch", DThumbnailProvider::PrefetchPriority);
+    const auto &promoted = addInfo("/tmp/promoted", DThumbnailProvider::PrefetchPriority);
+    const auto &removed = addInfo("/tmp/removed", DThumbnailProvider::VisiblePriority);
+    addInfo("/tmp/visible", DThumbnailProvider::VisiblePriority);
+    d.removeProduceInfo(removed);
+    EXPECT_EQ(removed->heapIndex, -1);
+    promoted->priority = DThumbnailProvider::VisiblePriority;
+    d.updateProduceInfo(promoted);
+
+    QStringList order;
+    while (auto info = d.takeProduceInfo()) {
+        EXPECT_EQ(info->heapIndex, -1);
+        order << info->fileInfo.absoluteFilePath();
+    }
+    EXPECT_EQ(order, QStringList({"/tmp/promoted", "/tmp/visible", "/tmp/prefetch"}));
+}
+
+TEST_F(DThumbnailProviderTest, test_produceHeap_order)
+{
+    DThumbnailProviderPrivate d(nullptr);
+    QList<QSharedPointer<DThumbnailProviderPrivate::ProduceInfo>> infos;
+    for (int i = 0; i < 100; ++i) {
+        QSharedPointer<DThumbnailProviderPrivate::ProduceInfo> info(new DThumbnailProviderPrivate::ProduceInfo());
+        info->fileInfo = QFileInfo(QString("/tmp/%1").arg(i));
+        info->priority = i % 3 ? DThumbnailProvider::PrefetchPriority : DThumbnailProvider::VisiblePriority;
+        d.pushProduceInfo(info);
+        infos << info;
+    }
+    // 移除一半后剩余的任务仍按优先级和加入顺序取出
+    for (int i = 0; i < 100; i += 2)
+        d.removeProduceInfo(infos.at(i));
+
+    QSharedPointer<DThumbnailProviderPrivate::ProduceInfo> last;
+    int count = 0;
+    while (auto info = d.takeProduceInfo()) {
+        if (last)
+            EXPECT_TRUE(DThumbnailProviderPrivate::produceBefore(*last, *info));
+        last = info;
+        ++count;
+    }
+    EXPECT_EQ(count, 50);
+}
+
+TEST_F(DThumbnailProviderTest, test_sizeLimit_deviceClass)
+{
+    QMimeType pngType = QMimeDatabase().mimeTypeForName("image/png");
+    QMimeType jpegType = QMimeDatabase().mimeTypeForName("image/jpeg");
+    // 网络设备上的 JPEG 只读取内嵌预览图，不限制文件大小
+    EXPECT_EQ(INT64_MAX, thumbnailProvide->sizeLimit(jpegType, DThumbnailProvider::RemoteDevice));
+    EXPECT_LT(thumbnailProvide->sizeLimit(pngType, DThumbnailProvider::RemoteDevice), thumbnailProvide->sizeLimit(pngType));
+    EXPECT_GT(thumbnailProvide->maxReadBytes(DThumbnailProvider::RemoteDevice), 0);
+    EXPECT_EQ(0, thumbnailProvide->maxReadBytes(DThumbnailProvider::LocalDevice));
+
+    qint64 remoteLimit = thumbnailProvide->sizeLimit(pngType, DThumbnailProvider::RemoteDevice);
+    thumbnailProvide->setSizeLimit(pngType, 1024, DThumbnailProvider::RemoteDevice);
+    EXPECT_EQ(1024, thumbnailProvide->sizeLimit(pngType, DThumbnailProvider::RemoteDevice));
+    EXPECT_EQ(1024 * 1024 * 30, thumbnailProvide->sizeLimit(pngType));
+    thumbnailProvide->setSizeLimit(pngType, remoteLimit, DThumbnailProvider::RemoteDevice);
+}
+
+TEST_F(DThumbnailProviderTest, test_appendToProduceQueue_remote_deferred)
+{
+    DMountTable *table = DMountTable::instance();
+    ASSERT_TRUE(table->loadFromData("22 1 8:1 / / rw,relatime shared:1 - ext4 /dev/sda1 rw\n"
+                                    "27 22 0:50 / /home/user/nfs rw,relatime shared:9 - nfs4 server:/export rw\n"));
+
+    QFileInfo remoteInfo("/home/user/nfs/photo.jpg");
+    EXPECT_EQ(DThumbnailProvider::RemoteDevice, DThumbnailProvider::deviceClass(remoteInfo.absoluteFilePath()));
+    EXPECT_EQ(DThumbnailProvider::LocalDevice, DThumbnailProvider::deviceClass("/home/user/photo.jpg"));
+
+    // 网络设备上的任务等待视图空闲，不进入生成队列
+    thumbnailProvide->appendToProduceQueue(remoteInfo, DThumbnailProvider::Large);
+    {
+        QReadLocker locker(&thumbnailProvide->d_func()->dataReadWriteLock);
+        EXPECT_EQ(1, thumbnailProvide->d_func()->deferredInfos.size());
+        EXPECT_TRUE(thumbnailProvide->d_func()->deferredInfos.first()->deferred);
+        EXPECT_EQ(-1, thumbnailProvide->d_func()->deferredInfos.first()->heapIndex);
+    }
+
+    thumbnailProvide->removeInProduceQueue(remoteInfo, DThumbnailProvider::Large);
+    {
+        QReadLocker locker(&thumbnailProvide->d_func()->dataReadWriteLock);
+        EXPECT_TRUE(thumbnailProvide->d_func()->deferredInfos.isEmpty());
+        EXPECT_FALSE(thumbnailProvide->d_func()->produceInfos.contains(qMakePair(remoteInfo.absoluteFilePath(), DThumbnailProvider::Large)));
+    }
+
+    table->refresh();
+}
+
 TEST_F(DThumbnailProviderTest, test_errorString)
 {
     QString simpleError = "test error";
-    thumbnailProvide->d_func()->errorString = simpleError;
+    thumbnailProvide->d_func()->errorString.setLocalData(simpleError);
     EXPECT_EQ(thumbnailProvide->errorString(), simpleError);
-    thumbnailProvide->d_func()->errorString = "";
+    thumbnailProvide->d_func()->errorString.setLocalData("");
 }
 
 TEST_F(DThumbnailProviderTest, test_hasThumbnail_no_file)
@@ -0,0 +1,73 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include "ddeviceaccessscheduler.h"
+
+#include <QElapsedTimer>
+#include <QtConcurrent>
+
+DFM_USE_NAMESPACE
+
+TEST(DDeviceAccessSchedulerTest, deviceOf)
+{
+    EXPECT_EQ(QString("/run/user/1000/gvfs/mtp:host=phone"),
+              DDeviceAccessScheduler::deviceOf("/run/user/1000/gvfs/mtp:host=phone/Internal/DCIM"));
+    EXPECT_EQ(QString("/run/user/1000/gvfs/mtp:host=phone"),
+              DDeviceAccessScheduler::deviceOf("/run/user/1000/gvfs/mtp:host=phone"));
+    EXPECT_TRUE(DDeviceAccessScheduler::deviceOf("/run/user/1000/gvfs/smb-share:server=a,share=b").isEmpty());
+    EXPECT_TRUE(DDeviceAccessScheduler::deviceOf("/home/user").isEmpty());
+}
+
+TEST(DDeviceAccessSchedulerTest, yieldToHigherPriority)
+{
+    DDeviceAccessScheduler *scheduler = DDeviceAccessScheduler::instance();
+    const QString device("/run/user/1000/gvfs/mtp:host=test");
+    QElapsedTimer timer;
+
+    // 没有更高优先级的请求时不等待
+    timer.start();
+    scheduler->begin(device, DDeviceAccessScheduler::CopyPriority);
+    scheduler->yield(device, DDeviceAccessScheduler::ListingPriority);
+    scheduler->end(device, DDeviceAccessScheduler::CopyPriority);
+    EXPECT_LT(timer.elapsed(), 500);
+
+    // 遍历结束后拷贝继续
+    scheduler->begin(device, DDeviceAccessScheduler::ListingPriority);
+    QFuture<void> future = QtConcurrent::run([scheduler, device] {
+        QThread::msleep(100);
+        scheduler->end(device, DDeviceAccessScheduler::ListingPriority);
+    });
+    timer.restart();
+    scheduler->yield(device, DDeviceAccessScheduler::CopyPriority);
+    EXPECT_GE(timer.elapsed(), 90);
+    EXPECT_LT(timer.elapsed(), 1500);
+    future.waitForFinished();
+}
+
+TEST(DDeviceAccessSchedulerTest, coalesceListing)
+{
+    DDeviceAccessScheduler *scheduler = DDeviceAccessScheduler::instance();
+    const QString dirPath("/run/user/1000/gvfs/mtp:host=test/DCIM");
+    bool owner = false;
+
+    const DDeviceAccessScheduler::ListingPointer listing = scheduler->joinListing(dirPath, &owner);
+    EXPECT_TRUE(owner);
+
+    const DDeviceAccessScheduler::ListingPointer joined = scheduler->joinListing(dirPath, &owner);
+    EXPECT_FALSE(owner);
+    EXPECT_EQ(listing, joined);
+    EXPECT_FALSE(scheduler->waitListing(joined, 10));
+
+    scheduler->finishListing(dirPath, listing, true);
+    EXPECT_TRUE(scheduler->waitListing(joined, 10));
+    EXPECT_TRUE(joined->complete);
+
+    // 遍历结束后重新开始新的遍历
+    const DDeviceAccessScheduler::ListingPointer next = scheduler->joinListing(dirPath, &owner);
+    EXPECT_TRUE(owner);
+    EXPECT_NE(listing, next);
+    scheduler->finishListing(dirPath, next, false);
+}
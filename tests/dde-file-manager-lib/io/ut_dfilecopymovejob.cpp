@@ -20,6 +20,7 @@
 #include "dgiofiledevice.h"
 #include "dabstractfilewatcher.h"
 #include "dlocalfiledevice.h"
+#include "shutil/fileutils.h"
 #include "testhelper.h"
 
 #include <QDateTime>
@@ -29,8 +30,13 @@
 #include <QByteArray>
 #include <QtDebug>
 #include <QVariant>
+#include <QTemporaryDir>
+#include <QFile>
 #include <QDialog>
 #include <QtConcurrent>
+#include <zlib.h>
+#include <unistd.h>
+#include <sys/stat.h>
 
 using namespace testing;
 using namespace stub_ext;
@@ -499,6 +505,86 @@ TEST_F(DFileCopyMoveJobTest, start_getNewFileName)
     EXPECT_FALSE(jobd->getNewFileName(source, toinfo).isEmpty());
     job->stop();
 }
+TEST_F(DFileCopyMoveJobTest, start_getNonExistsFileName)
+{
+    DFileCopyMoveJobPrivate *jobd = job->d_func();
+    ASSERT_TRUE(jobd);
+
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    QFile(dir.filePath("a.txt")).open(QIODevice::WriteOnly);
+    QFile(dir.filePath("a(copy).txt")).open(QIODevice::WriteOnly);
+
+    DAbstractFileInfoPointer source = DFileService::instance()->createFileInfo(nullptr, DUrl::fromLocalFile(dir.filePath("a.txt")));
+    DAbstractFileInfoPointer toinfo = DFileService::instance()->createFileInfo(nullptr, DUrl::fromLocalFile(dir.path()));
+
+    // 已生成的名称记录在目录的文件名快照中，即使文件还没有创建也不会重复
+    EXPECT_EQ(QString("a(copy 1).txt"), jobd->getNonExistsFileName(source, toinfo));
+    EXPECT_EQ(QString("a(copy 2).txt"), jobd->getNonExistsFileName(source, toinfo));
+
+    // 读取快照之后创建的文件以实际结果为准
+    QFile(dir.filePath("a(copy 3).txt")).open(QIODevice::WriteOnly);
+    EXPECT_EQ(QString("a(copy 4).txt"), jobd->getNonExistsFileName(source, toinfo));
+    job->stop();
+}
+
+TEST_F(DFileCopyMoveJobTest, start_finalizeTargetFile)
+{
+    DFileCopyMoveJobPrivate *jobd = job->d_func();
+    ASSERT_TRUE(jobd);
+
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    QFile from(dir.filePath("from.txt"));
+    ASSERT_TRUE(from.open(QIODevice::WriteOnly));
+    from.close();
+    from.setPermissions(QFileDevice::ReadOwner | QFileDevice::WriteOwner | QFileDevice::ReadUser | QFileDevice::WriteUser | QFileDevice::ReadGroup);
+    const QDateTime modified = QDateTime::fromTime_t(1500000000);
+    ASSERT_TRUE(from.open(QIODevice::ReadWrite));
+    ASSERT_TRUE(from.setFileTime(modified, QFileDevice::FileModificationTime));
+    from.close();
+
+    QFile to(dir.filePath("to.txt"));
+    ASSERT_TRUE(to.open(QIODevice::WriteOnly));
+
+    DAbstractFileInfoPointer fromInfo = DFileService::instance()->createFileInfo(nullptr, DUrl::fromLocalFile(from.fileName()));
+    DAbstractFileInfoPointer toInfo = DFileService::instance()->createFileInfo(nullptr, DUrl::fromLocalFile(to.fileName()));
+    QSharedPointer<DFileHandler> handler(DFileService::instance()->createFileHandler(nullptr, fromInfo->fileUrl()));
+
+    // 通过还未关闭的描述符设置时间和权限
+    EXPECT_TRUE(jobd->finalizeTargetFile(to.handle(), fromInfo, toInfo, handler));
+    to.close();
+
+    const QFileInfo info(to.fileName());
+    EXPECT_EQ(modified, info.lastModified());
+    EXPECT_EQ(from.permissions(), info.permissions());
+    job->stop();
+}
+
+TEST_F(DFileCopyMoveJobTest, start_preallocateTargetFile)
+{
+    DFileCopyMoveJobPrivate *jobd = job->d_func();
+    ASSERT_TRUE(jobd);
+
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    QFile file(dir.filePath("to.txt"));
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+
+    // 预分配不改变文件的大小，不支持的文件系统上也返回true
+    EXPECT_TRUE(jobd->preallocateTargetFile(file.handle(), 0, 4 * 1024 * 1024));
+    EXPECT_EQ(0, file.size());
+    EXPECT_TRUE(jobd->preallocateTargetFile(-1, 0, 4 * 1024 * 1024));
+
+    stub_ext::StubExt stu;
+    stu.set_lamda(::fallocate, []() {errno = ENOSPC; return -1;});
+    EXPECT_FALSE(jobd->preallocateTargetFile(file.handle(), 0, 4 * 1024 * 1024));
+    // 小文件不预分配
+    EXPECT_TRUE(jobd->preallocateTargetFile(file.handle(), 0, 4096));
+    file.close();
+    job->stop();
+}
+
 DAbstractFileInfoPointer stub_createFileInfo(const QObject *, const DUrl &)
 {
     DUrl tagurl("file:///tmp/zut_test_dir/zut_test_dir");
@@ -818,25 +904,30 @@ TEST_F(DFileCopyMoveJobTest, start_run_moveMOde)
     job->stop();
 }
 
-TEST_F(DFileCopyMoveJobTest, start_getWriteBytes)
+TEST_F(DFileCopyMoveJobTest, start_progressCounter)
 {
+    DFileCopyMoveJobPrivate::ProgressCounter counter;
+    EXPECT_EQ(0, qint64(counter));
+
+    // 多个线程同时累加
+    QList<QFuture<void>> results;
+    for (int i = 0; i < 8; ++i) {
+        results << QtConcurrent::run([&counter]() {
+            for (int j = 0; j < 10000; ++j)
+                counter += 3;
+        });
+    }
+    for (QFuture<void> &result : results)
+        result.waitForFinished();
+    EXPECT_EQ(8 * 10000 * 3, qint64(counter));
+
+    counter = 10;
+    EXPECT_EQ(10, qint64(counter));
+
     DFileCopyMoveJobPrivate *jobd = job->d_func();
     ASSERT_TRUE(jobd);
-    EXPECT_TRUE(0 == jobd->getWriteBytes(-1));
-    DUrl from;
-    from.setScheme(FILE_SCHEME);
-    from.setPath("/proc/self/task/9018765463");
-    QProcess::execute("mkdir " + from.toLocalFile());
-    from.setPath("/proc/self/task/9018765463/io");
-    QProcess::execute("touch " + from.toLocalFile());
-    EXPECT_TRUE(0 == jobd->getWriteBytes(9018765463));
-    QFile file(from.toLocalFile());
-    if (file.open(QIODevice::WriteOnly)) {
-        file.write(QByteArray("write_bytes: ioio"));
-        file.close();
-    }
-    EXPECT_TRUE(0 == jobd->getWriteBytes(9018765463));
-    TestHelper::deleteTmpFile("/proc/self/task/9018765463");
+    jobd->completedDataSize += 1024;
+    EXPECT_EQ(1024, jobd->getCompletedDataSize());
     job->stop();
 }
 
@@ -1768,11 +1859,11 @@ TEST_F(DFileCopyMoveJobTest, start_writeToFileByQueue)
     EXPECT_FALSE(jobd->writeToFileByQueue());
 
     stl.set_lamda(&DFileCopyMoveJobPrivate::stateCheck, []() {return true;});
-    copyinfo->buffer = new char[1024];
+    copyinfo->buffer = jobd->acquireCopyBuffer();
     jobd->writeQueueEnqueue(copyinfo);
     EXPECT_FALSE(jobd->writeToFileByQueue());
     if (copyinfo->buffer) {
-        delete [] copyinfo->buffer;
+        jobd->releaseCopyBuffer(copyinfo->buffer);
         copyinfo->buffer = nullptr;
     }
 
@@ -1791,7 +1882,7 @@ TEST_F(DFileCopyMoveJobTest, start_writeToFileByQueue)
     jobd->m_skipFileQueue.clear();
     copyinfo->frominfo = frominfo;
     copyinfo->toinfo = toinfo;
-    copyinfo->buffer = new char[16];
+    copyinfo->buffer = jobd->acquireCopyBuffer();
     copyinfo->buffer[0] = '1';
     copyinfo->buffer[1] = '2';
     copyinfo->buffer[2] = '3';
@@ -1802,7 +1893,7 @@ TEST_F(DFileCopyMoveJobTest, start_writeToFileByQueue)
     DFileCopyMoveJobPrivate::FileCopyInfoPointer copyinfoover(
         new DFileCopyMoveJobPrivate::FileCopyInfo(*copyinfo.data()));
     copyinfoover->closeflag = true;
-    copyinfoover->buffer = new char[16];
+    copyinfoover->buffer = jobd->acquireCopyBuffer();
     copyinfoover->buffer[0] = '1';
     copyinfoover->buffer[1] = '2';
     copyinfoover->buffer[2] = '3';
@@ -1810,12 +1901,12 @@ TEST_F(DFileCopyMoveJobTest, start_writeToFileByQueue)
     jobd->writeQueueEnqueue(copyinfoover);
     EXPECT_TRUE(jobd->writeToFileByQueue());
     if (copyinfo->buffer) {
-        delete [] copyinfo->buffer;
+        jobd->releaseCopyBuffer(copyinfo->buffer);
         copyinfo->buffer = nullptr;
     }
 
     if (copyinfoover->buffer) {
-        delete [] copyinfoover->buffer;
+        jobd->releaseCopyBuffer(copyinfoover->buffer);
         copyinfoover->buffer = nullptr;
     }
 
@@ -1826,14 +1917,14 @@ TEST_F(DFileCopyMoveJobTest, start_writeToFileByQueue)
     stl.set_lamda(write, []() {return -1;});
     stl.set_lamda(lseek, []() {return false;});
     jobd->writeQueueEnqueue(copyinfo);
-    copyinfo->buffer = new char[16];
+    copyinfo->buffer = jobd->acquireCopyBuffer();
     copyinfo->buffer[0] = '1';
     copyinfo->buffer[1] = '2';
     copyinfo->buffer[2] = '3';
     copyinfo->buffer[4] = '\n';
     EXPECT_FALSE(jobd->writeToFileByQueue());
     if (copyinfo->buffer) {
-        delete [] copyinfo->buffer;
+        jobd->releaseCopyBuffer(copyinfo->buffer);
         copyinfo->buffer = nullptr;
     }
     stl.reset(&DFileCopyMoveJobPrivate::setAndhandleError);
@@ -1842,7 +1933,7 @@ TEST_F(DFileCopyMoveJobTest, start_writeToFileByQueue)
     stl.set_lamda(&DFileCopyMoveJobPrivate::setAndhandleError, []() {
         return DFileCopyMoveJob::SkipAction;
     });
-    copyinfo->buffer = new char[16];
+    copyinfo->buffer = jobd->acquireCopyBuffer();
     copyinfo->buffer[0] = '1';
     copyinfo->buffer[1] = '2';
     copyinfo->buffer[2] = '3';
@@ -1850,7 +1941,7 @@ TEST_F(DFileCopyMoveJobTest, start_writeToFileByQueue)
     jobd->writeQueueEnqueue(copyinfo);
     EXPECT_TRUE(jobd->writeToFileByQueue());
     if (copyinfo->buffer) {
-        delete [] copyinfo->buffer;
+        jobd->releaseCopyBuffer(copyinfo->buffer);
         copyinfo->buffer = nullptr;
     }
     stl.reset(&DFileCopyMoveJobPrivate::setAndhandleError);
@@ -1859,7 +1950,7 @@ TEST_F(DFileCopyMoveJobTest, start_writeToFileByQueue)
     stl.set_lamda(&DFileCopyMoveJobPrivate::setAndhandleError, []() {
         return DFileCopyMoveJob::CancelAction;
     });
-    copyinfo->buffer = new char[16];
+    copyinfo->buffer = jobd->acquireCopyBuffer();
     copyinfo->buffer[0] = '1';
     copyinfo->buffer[1] = '2';
     copyinfo->buffer[2] = '3';
@@ -1867,7 +1958,7 @@ TEST_F(DFileCopyMoveJobTest, start_writeToFileByQueue)
     jobd->writeQueueEnqueue(copyinfo);
     EXPECT_FALSE(jobd->writeToFileByQueue());
     if (copyinfo->buffer) {
-        delete [] copyinfo->buffer;
+        jobd->releaseCopyBuffer(copyinfo->buffer);
         copyinfo->buffer = nullptr;
     }
     stl.reset(&DFileCopyMoveJobPrivate::setAndhandleError);
@@ -1878,7 +1969,7 @@ TEST_F(DFileCopyMoveJobTest, start_writeToFileByQueue)
     stl.set_lamda(&DFileCopyMoveJobPrivate::setAndhandleError, []() {
         return DFileCopyMoveJob::RetryAction;
     });
-    copyinfo->buffer = new char[16];
+    copyinfo->buffer = jobd->acquireCopyBuffer();
     copyinfo->buffer[0] = '1';
     copyinfo->buffer[1] = '2';
     copyinfo->buffer[2] = '3';
@@ -1886,7 +1977,7 @@ TEST_F(DFileCopyMoveJobTest, start_writeToFileByQueue)
     jobd->writeQueueEnqueue(copyinfo);
     EXPECT_FALSE(jobd->writeToFileByQueue());
     if (copyinfo->buffer) {
-        delete [] copyinfo->buffer;
+        jobd->releaseCopyBuffer(copyinfo->buffer);
         copyinfo->buffer = nullptr;
     }
     stl.reset(&DFileCopyMoveJobPrivate::setAndhandleError);
@@ -1895,7 +1986,7 @@ TEST_F(DFileCopyMoveJobTest, start_writeToFileByQueue)
     stl.set_lamda(&DFileCopyMoveJobPrivate::setAndhandleError, []() {
         return DFileCopyMoveJob::SkipAction;
     });
-    copyinfo->buffer = new char[16];
+    copyinfo->buffer = jobd->acquireCopyBuffer();
     copyinfo->buffer[0] = '1';
     copyinfo->buffer[1] = '2';
     copyinfo->buffer[2] = '3';
@@ -1903,7 +1994,7 @@ TEST_F(DFileCopyMoveJobTest, start_writeToFileByQueue)
     jobd->writeQueueEnqueue(copyinfo);
     EXPECT_TRUE(jobd->writeToFileByQueue());
     if (copyinfo->buffer) {
-        delete [] copyinfo->buffer;
+        jobd->releaseCopyBuffer(copyinfo->buffer);
         copyinfo->buffer = nullptr;
     }
     stl.reset(&DFileCopyMoveJobPrivate::setAndhandleError);
@@ -1912,7 +2003,7 @@ TEST_F(DFileCopyMoveJobTest, start_writeToFileByQueue)
     stl.set_lamda(&DFileCopyMoveJobPrivate::setAndhandleError, []() {
         return DFileCopyMoveJob::CancelAction;
     });
-    copyinfo->buffer = new char[16];
+    copyinfo->buffer = jobd->acquireCopyBuffer();
     copyinfo->buffer[0] = '1';
     copyinfo->buffer[1] = '2';
     copyinfo->buffer[2] = '3';
@@ -1920,7 +2011,7 @@ TEST_F(DFileCopyMoveJobTest, start_writeToFileByQueue)
     jobd->writeQueueEnqueue(copyinfo);
     EXPECT_FALSE(jobd->writeToFileByQueue());
     if (copyinfo->buffer) {
-        delete [] copyinfo->buffer;
+        jobd->releaseCopyBuffer(copyinfo->buffer);
         copyinfo->buffer = nullptr;
     }
 
@@ -1931,3 +2022,794 @@ TEST_F(DFileCopyMoveJobTest, start_writeToFileByQueue)
     TestHelper::deleteTmpFile(dirurl.path());
     job->stop();
 }
+
+TEST_F(DFileCopyMoveJobTest, start_doCopyFileByKernel)
+{
+    DFileCopyMoveJobPrivate *jobd = job->d_func();
+    ASSERT_TRUE(jobd);
+    DUrl from, to;
+    from.setScheme(FILE_SCHEME);
+    from.setPath(TestHelper::createTmpFile());
+    QByteArray data(1024 * 1024 * 3, 'k');
+    QFile filefrom(from.toLocalFile());
+    if (filefrom.open(QIODevice::WriteOnly)) {
+        filefrom.write(data);
+        filefrom.close();
+    }
+    to = from;
+    to.setPath(from.path() + "_kernel_copy");
+    DAbstractFileInfoPointer frominfo = DFileService::instance()->createFileInfo(nullptr, from);
+    DAbstractFileInfoPointer toinfo = DFileService::instance()->createFileInfo(nullptr, to);
+
+    QSharedPointer<DFileDevice> fromDevice(new DLocalFileDevice());
+    QSharedPointer<DFileDevice> toDevice(new DLocalFileDevice());
+    fromDevice->setFileUrl(from);
+    toDevice->setFileUrl(to);
+    ASSERT_TRUE(fromDevice->open(QIODevice::ReadOnly));
+    ASSERT_TRUE(toDevice->open(QIODevice::WriteOnly | QIODevice::Truncate));
+
+    jobd->setState(DFileCopyMoveJob::RunningState);
+    // 需要校验完整性时不使用内核拷贝
+    jobd->fileHints = DFileCopyMoveJob::NoHint;
+    EXPECT_FALSE(jobd->doCopyFileByKernel(frominfo, toinfo, fromDevice, toDevice));
+
+    jobd->fileHints = DFileCopyMoveJob::DontIntegrityChecking;
+    EXPECT_TRUE(jobd->doCopyFileByKernel(frominfo, toinfo, fromDevice, toDevice));
+    EXPECT_EQ(data.size(), jobd->currentJobDataSizeInfo.second);
+    fromDevice->close();
+    toDevice->close();
+
+    QFile fileto(to.toLocalFile());
+    ASSERT_TRUE(fileto.open(QIODevice::ReadOnly));
+    EXPECT_TRUE(fileto.readAll() == data);
+    fileto.close();
+
+    job->stop();
+    TestHelper::deleteTmpFile(from.path());
+    TestHelper::deleteTmpFile(to.path());
+}
+
+TEST_F(DFileCopyMoveJobTest, start_waitWriteQueue)
+{
+    DFileCopyMoveJobPrivate *jobd = job->d_func();
+    ASSERT_TRUE(jobd);
+
+    jobd->setState(DFileCopyMoveJob::RunningState);
+    jobd->setRefineCopyProccessSate(DFileCopyMoveJob::NoProccess);
+    QFuture<void> waiter = QtConcurrent::run([jobd]() {
+        jobd->waitWriteQueueNotEmpty();
+    });
+    QThread::msleep(50);
+    EXPECT_FALSE(waiter.isFinished());
+    jobd->writeQueueEnqueue(DFileCopyMoveJobPrivate::FileCopyInfoPointer(new DFileCopyMoveJobPrivate::FileCopyInfo()));
+    waiter.waitForFinished();
+    EXPECT_FALSE(jobd->checkWritQueueEmpty());
+    jobd->writeQueueDequeue();
+
+    // 写队列未满时不阻塞读线程
+    jobd->waitWriteQueueNotFull();
+    EXPECT_FALSE(jobd->checkWritQueueCount());
+
+    // 读线程结束后写线程不再等待
+    jobd->setRefineCopyProccessSate(DFileCopyMoveJob::ReadFileProccessOver);
+    jobd->waitWriteQueueNotEmpty();
+    EXPECT_TRUE(jobd->checkWritQueueEmpty());
+
+    job->stop();
+}
+
+TEST_F(DFileCopyMoveJobTest, start_copyBufferPool)
+{
+    DFileCopyMoveJobPrivate *jobd = job->d_func();
+    ASSERT_TRUE(jobd);
+
+    char *buffer = jobd->acquireCopyBuffer();
+    ASSERT_TRUE(buffer);
+    EXPECT_EQ(0, reinterpret_cast<quintptr>(buffer) % static_cast<quintptr>(FileUtils::getMemoryPageSize()));
+    EXPECT_EQ(1, jobd->m_copyBufferCount);
+
+    // 归还后的buffer会被复用，不会重新分配
+    jobd->releaseCopyBuffer(buffer);
+    EXPECT_EQ(buffer, jobd->acquireCopyBuffer());
+    EXPECT_EQ(1, jobd->m_copyBufferCount);
+    jobd->releaseCopyBuffer(buffer);
+
+    // 缓存池用完且任务已停止时不再阻塞
+    QList<char *> buffers;
+    for (int i = 0; i < 64; ++i)
+        buffers << jobd->acquireCopyBuffer();
+    jobd->setState(DFileCopyMoveJob::StoppedState);
+    EXPECT_FALSE(jobd->acquireCopyBuffer());
+    for (char *b : buffers)
+        jobd->releaseCopyBuffer(b);
+
+    jobd->clearCopyBufferPool();
+    EXPECT_EQ(0, jobd->m_copyBufferCount);
+}
+
+TEST_F(DFileCopyMoveJobTest, start_blockSizeController)
+{
+    typedef DFileCopyMoveJobPrivate::BlockSizeController Controller;
+    EXPECT_GT(Controller::defaultBlockSize(true, false), Controller::defaultBlockSize(false, false));
+    EXPECT_LT(Controller::defaultBlockSize(false, true), Controller::defaultBlockSize(false, false));
+
+    Controller controller;
+    controller.reset(1);
+    EXPECT_EQ(64 * 1024, controller.blockSize());
+    controller.reset(1024 * 1024 * 1024);
+    EXPECT_EQ(16 * 1024 * 1024, controller.blockSize());
+
+    controller.reset(1024 * 1024);
+    // 统计窗口未结束时不调整
+    EXPECT_EQ(1024 * 1024, controller.update(1024 * 1024));
+    // 第一个窗口结束后先尝试增大
+    QThread::msleep(510);
+    EXPECT_EQ(2 * 1024 * 1024, controller.update(1024 * 1024));
+
+    DFileCopyMoveJobPrivate *jobd = job->d_func();
+    ASSERT_TRUE(jobd);
+    jobd->m_blockSizeController.reset(4 * 1024 * 1024);
+    EXPECT_EQ(4 * 1024 * 1024, job->currentBlockSize());
+}
+
+TEST_F(DFileCopyMoveJobTest, start_prefetchDirectory)
+{
+    DFileCopyMoveJobPrivate *jobd = job->d_func();
+    ASSERT_TRUE(jobd);
+
+    const QString root = QDir::currentPath() + "/ut_prefetch_dir";
+    QDir().mkpath(root + "/sub1/sub11");
+    QDir().mkpath(root + "/sub2");
+    QFile file(root + "/file");
+    file.open(QIODevice::WriteOnly);
+    file.close();
+
+    jobd->setState(DFileCopyMoveJob::RunningState);
+    QStringList subDirs = jobd->prefetchDirectory(root);
+    subDirs.sort();
+    EXPECT_EQ(QStringList({root + "/sub1", root + "/sub2"}), subDirs);
+    EXPECT_TRUE(jobd->prefetchDirectory(root + "/not_exists").isEmpty());
+
+    jobd->m_isFileOnDiskUrls = true;
+    jobd->prefetchSubDirectories(DUrl::fromLocalFile(root));
+    jobd->m_prefetchPool.waitForDone();
+    EXPECT_TRUE(jobd->m_prefetchedDirs.contains(root + "/sub1"));
+    // 进入子目录后不再记录
+    jobd->prefetchSubDirectories(DUrl::fromLocalFile(root + "/sub1"));
+    jobd->m_prefetchPool.waitForDone();
+    EXPECT_FALSE(jobd->m_prefetchedDirs.contains(root + "/sub1"));
+
+    job->stop();
+    QProcess::execute("rm -rf " + root);
+}
+
+TEST_F(DFileCopyMoveJobTest, start_canCopyRemoteFileInPool)
+{
+    DFileCopyMoveJobPrivate *jobd = job->d_func();
+    ASSERT_TRUE(jobd);
+    DUrl from;
+    from.setScheme(FILE_SCHEME);
+    from.setPath(TestHelper::createTmpFile());
+    DAbstractFileInfoPointer frominfo = DFileService::instance()->createFileInfo(nullptr, from);
+
+    jobd->m_refineStat = DFileCopyMoveJob::NoRefine;
+    jobd->mode = DFileCopyMoveJob::CopyMode;
+    jobd->m_isTagGvfsFile = false;
+    EXPECT_FALSE(jobd->canCopyRemoteFileInPool(frominfo));
+
+    jobd->m_isTagGvfsFile = true;
+    EXPECT_TRUE(jobd->canCopyRemoteFileInPool(frominfo));
+    EXPECT_FALSE(jobd->canCopyRemoteFileInPool(DAbstractFileInfoPointer(nullptr)));
+
+    // 剪切需要同步删除源文件
+    jobd->mode = DFileCopyMoveJob::CutMode;
+    EXPECT_FALSE(jobd->canCopyRemoteFileInPool(frominfo));
+
+    jobd->mode = DFileCopyMoveJob::CopyMode;
+    jobd->m_refineStat = DFileCopyMoveJob::RefineLocal;
+    EXPECT_FALSE(jobd->canCopyRemoteFileInPool(frominfo));
+
+    TestHelper::deleteTmpFile(from.path());
+}
+
+TEST_F(DFileCopyMoveJobTest, start_copyJournal)
+{
+    typedef DFileCopyMoveJobPrivate::CopyJournal Journal;
+    const QString journalPath = QDir::currentPath() + "/ut_copy_journal/test.journal";
+    const DUrl from = DUrl::fromLocalFile("/tmp/ut journal from");
+    const DUrl to = DUrl::fromLocalFile("/tmp/ut journal to");
+    const DUrl dir = DUrl::fromLocalFile("/tmp/ut_journal_dir");
+
+    Journal journal;
+    EXPECT_FALSE(journal.isOpen());
+    EXPECT_EQ(Journal::NoState, journal.state(from, to));
+    ASSERT_TRUE(journal.open(journalPath));
+    journal.recordDirectory(dir, dir);
+    journal.recordProgress(from, to, 4096);
+    EXPECT_EQ(Journal::InFlightState, journal.state(from, to));
+    EXPECT_EQ(4096, journal.resumeOffset(from, to));
+    journal.close(false);
+
+    // 重新打开后恢复上次的记录
+    ASSERT_TRUE(journal.open(journalPath));
+    EXPECT_EQ(Journal::DirectoryState, journal.state(dir, dir));
+    EXPECT_EQ(4096, journal.resumeOffset(from, to));
+    journal.recordCompleted(from, to);
+    EXPECT_EQ(Journal::CompletedState, journal.state(from, to));
+    EXPECT_EQ(0, journal.resumeOffset(from, to));
+    journal.close(true);
+    EXPECT_FALSE(QFile::exists(journalPath));
+
+    EXPECT_EQ(DFileCopyMoveJob::defaultJournalFile({from}, dir), DFileCopyMoveJob::defaultJournalFile({from}, dir));
+    EXPECT_NE(DFileCopyMoveJob::defaultJournalFile({from}, dir), DFileCopyMoveJob::defaultJournalFile({to}, dir));
+    job->setJournalFile(journalPath);
+    EXPECT_EQ(journalPath, job->journalFile());
+    job->setJournalFile(QString());
+
+    QProcess::execute("rm -rf " + QDir::currentPath() + "/ut_copy_journal");
+}
+
+TEST_F(DFileCopyMoveJobTest, start_resumeFromJournal)
+{
+    DFileCopyMoveJobPrivate *jobd = job->d_func();
+    ASSERT_TRUE(jobd);
+    const QString journalPath = QDir::currentPath() + "/ut_resume_journal/test.journal";
+    const QByteArray content(256 * 1024, 'a');
+    DUrl from = DUrl::fromLocalFile(TestHelper::createTmpFile());
+    DUrl to = DUrl::fromLocalFile(TestHelper::createTmpFile());
+    QFile fromFile(from.path());
+    fromFile.open(QIODevice::WriteOnly);
+    fromFile.write(content);
+    fromFile.close();
+    QFile toFile(to.path());
+    toFile.open(QIODevice::WriteOnly);
+    toFile.write(content.left(128 * 1024));
+    toFile.close();
+
+    DAbstractFileInfoPointer frominfo = DFileService::instance()->createFileInfo(nullptr, from);
+    DAbstractFileInfoPointer toinfo = DFileService::instance()->createFileInfo(nullptr, to);
+    DLocalFileDevice *fromLocal = new DLocalFileDevice();
+    fromLocal->setFileUrl(from);
+    DLocalFileDevice *toLocal = new DLocalFileDevice();
+    toLocal->setFileUrl(to);
+    QSharedPointer<DFileDevice> fromDevice(fromLocal);
+    QSharedPointer<DFileDevice> toDevice(toLocal);
+    ASSERT_TRUE(fromDevice->open(QIODevice::ReadOnly));
+
+    jobd->setState(DFileCopyMoveJob::RunningState);
+    jobd->fileHints = DFileCopyMoveJob::NoHint;
+    DFileCopyMoveJobPrivate::StreamChecksum checksum;
+    // 没有日志时从头开始拷贝
+    EXPECT_EQ(0, jobd->resumeFromJournal(frominfo, toinfo, fromDevice, toDevice, checksum));
+
+    ASSERT_TRUE(jobd->m_copyJournal.open(journalPath));
+    jobd->m_copyJournal.recordProgress(from, to, 128 * 1024);
+    EXPECT_EQ(128 * 1024, jobd->resumeFromJournal(frominfo, toinfo, fromDevice, toDevice, checksum));
+    EXPECT_EQ(128 * 1024, fromDevice->pos());
+    EXPECT_EQ(QByteArray::number(static_cast<qulonglong>(adler32(adler32(0L, nullptr, 0), reinterpret_cast<const Bytef *>(content.constData()), 128 * 1024)), 16),
+              checksum.result());
+
+    // 断点之前的数据不一致时不续传
+    toFile.open(QIODevice::WriteOnly);
+    toFile.write(QByteArray(128 * 1024, 'b'));
+    toFile.close();
+    checksum.reset(DFileCopyMoveJob::FastVerify);
+    EXPECT_EQ(0, jobd->resumeFromJournal(frominfo, toinfo, fromDevice, toDevice, checksum));
+    EXPECT_EQ(0, fromDevice->pos());
+
+    fromDevice->close();
+    jobd->m_copyJournal.close(true);
+    job->stop();
+    TestHelper::deleteTmpFile(from.path());
+    TestHelper::deleteTmpFile(to.path());
+    QProcess::execute("rm -rf " + QDir::currentPath() + "/ut_resume_journal");
+}
+
+TEST_F(DFileCopyMoveJobTest, start_waitForDevices)
+{
+    EXPECT_TRUE(DFileCopyMoveJobPrivate::spindleDeviceKey(QString()).isEmpty());
+    EXPECT_TRUE(DFileCopyMoveJobPrivate::spindleDeviceKey("/not_exists_path").isEmpty());
+
+    StubExt stl;
+    stl.set_lamda(&DFileCopyMoveJobPrivate::deviceSchedulerKeys, []() {
+        return QStringList({"/sys/devices/ut_disk"});
+    });
+
+    QSharedPointer<DFileCopyMoveJob> other(new DFileCopyMoveJob());
+    DFileCopyMoveJobPrivate *jobd = job->d_func();
+    DFileCopyMoveJobPrivate *otherd = other->d_func();
+    ASSERT_TRUE(jobd);
+    ASSERT_TRUE(otherd);
+    jobd->setState(DFileCopyMoveJob::RunningState);
+    otherd->setState(DFileCopyMoveJob::RunningState);
+
+    // 第一个任务直接执行，第二个任务排队
+    EXPECT_TRUE(jobd->waitForDevices());
+    QFuture<bool> result = QtConcurrent::run([otherd]() {
+        return otherd->waitForDevices();
+    });
+    QThread::msleep(100);
+    EXPECT_FALSE(result.isFinished());
+    EXPECT_EQ(DFileCopyMoveJob::QueuedState, other->state());
+
+    jobd->releaseDevices();
+    result.waitForFinished();
+    EXPECT_TRUE(result.result());
+    EXPECT_EQ(DFileCopyMoveJob::RunningState, other->state());
+
+    // 排队时停止任务
+    EXPECT_TRUE(jobd->waitForDevices());
+    result = QtConcurrent::run([otherd]() {
+        return otherd->waitForDevices();
+    });
+    QThread::msleep(100);
+    other->stop();
+    result.waitForFinished();
+    EXPECT_FALSE(result.result());
+
+    otherd->releaseDevices();
+    jobd->releaseDevices();
+    EXPECT_TRUE(DFileCopyMoveJobPrivate::deviceJobQueues.isEmpty());
+    job->stop();
+}
+
+TEST_F(DFileCopyMoveJobTest, start_speedLimit)
+{
+    DFileCopyMoveJobPrivate::SpeedLimiter limiter;
+    // 不限速时不需要等待
+    EXPECT_EQ(0, limiter.consume(1024 * 1024));
+
+    limiter.setLimit(1024 * 1024);
+    EXPECT_EQ(1024 * 1024, limiter.limit());
+    // 第一次有1秒的令牌
+    EXPECT_EQ(0, limiter.consume(1024 * 1024));
+    EXPECT_GT(limiter.consume(512 * 1024), 400);
+    limiter.setLimit(-1);
+    EXPECT_EQ(0, limiter.limit());
+
+    DFileCopyMoveJobPrivate *jobd = job->d_func();
+    ASSERT_TRUE(jobd);
+    job->setSpeedLimit(4 * 1024 * 1024);
+    EXPECT_EQ(4 * 1024 * 1024, job->speedLimit());
+    EXPECT_EQ(4 * 1024 * 1024, jobd->m_speedLimiter.limit());
+
+    // 后台模式没有设置限速时使用默认限速
+    job->setSpeedLimit(0);
+    job->setBackgroundMode(true);
+    EXPECT_TRUE(job->isBackgroundMode());
+    EXPECT_GT(jobd->m_speedLimiter.limit(), 0);
+    job->setBackgroundMode(false);
+    EXPECT_FALSE(job->isBackgroundMode());
+    EXPECT_EQ(0, jobd->m_speedLimiter.limit());
+
+    jobd->setState(DFileCopyMoveJob::RunningState);
+    job->setSpeedLimit(1024 * 1024);
+    jobd->throttleRead(1024 * 1024);
+    QElapsedTimer timer;
+    timer.start();
+    jobd->throttleRead(256 * 1024);
+    EXPECT_GE(timer.elapsed(), 200);
+    job->setSpeedLimit(0);
+    job->stop();
+}
+
+TEST_F(DFileCopyMoveJobTest, start_verifyChecksum)
+{
+    const QByteArray content(3 * 1024 * 1024 + 10, 'c');
+    DFileCopyMoveJobPrivate::StreamChecksum sha256(DFileCopyMoveJob::Sha256Verify);
+    DFileCopyMoveJobPrivate::StreamChecksum adler(DFileCopyMoveJob::NoVerify);
+    for (int pos = 0; pos < content.size(); pos += 1024 * 1024) {
+        const int size = qMin(1024 * 1024, content.size() - pos);
+        sha256.addData(content.constData() + pos, size);
+        adler.addData(content.constData() + pos, size);
+    }
+    EXPECT_EQ(QCryptographicHash::hash(content, QCryptographicHash::Sha256).toHex(), sha256.result());
+    EXPECT_EQ(QByteArray::number(static_cast<qulonglong>(adler32(adler32(0L, nullptr, 0), reinterpret_cast<const Bytef *>(content.constData()),
+                                                                 static_cast<uInt>(content.size()))), 16),
+              adler.result());
+
+    sha256.reset(DFileCopyMoveJob::Sha256Verify);
+    EXPECT_EQ(QCryptographicHash::hash(QByteArray(), QCryptographicHash::Sha256).toHex(), sha256.result());
+
+    DFileCopyMoveJobPrivate *jobd = job->d_func();
+    ASSERT_TRUE(jobd);
+    EXPECT_EQ(DFileCopyMoveJob::NoVerify, job->verifyMode());
+    job->setVerifyMode(DFileCopyMoveJob::Sha256Verify);
+    EXPECT_EQ(DFileCopyMoveJob::Sha256Verify, job->verifyMode());
+    // 校验只在doCopyFile中实现
+    jobd->mode = DFileCopyMoveJob::CopyMode;
+    jobd->m_refineStat = DFileCopyMoveJob::RefineLocal;
+    jobd->initRefineState();
+    EXPECT_EQ(DFileCopyMoveJob::NoRefine, jobd->m_refineStat);
+
+    DFileCopyMoveJobPrivate::dropPageCache(QString());
+    job->setVerifyMode(DFileCopyMoveJob::NoVerify);
+}
+
+TEST_F(DFileCopyMoveJobTest, start_copySparseFile)
+{
+    DFileCopyMoveJobPrivate *jobd = job->d_func();
+    ASSERT_TRUE(jobd);
+    DUrl from = DUrl::fromLocalFile(TestHelper::createTmpFile());
+    DUrl to = DUrl::fromLocalFile(from.path() + "_sparse_copy");
+    const qint64 fileSize = 8 * 1024 * 1024;
+    const QByteArray data(1024 * 1024, 's');
+    QFile filefrom(from.toLocalFile());
+    ASSERT_TRUE(filefrom.open(QIODevice::WriteOnly));
+    filefrom.seek(4 * 1024 * 1024);
+    filefrom.write(data);
+    filefrom.resize(fileSize);
+    filefrom.close();
+
+    // 普通文件不是稀疏文件
+    EXPECT_FALSE(DFileCopyMoveJobPrivate::HoleScanner(QString()).isSparse());
+    const DFileCopyMoveJobPrivate::HoleScanner holes(from.toLocalFile());
+    if (holes.isSparse()) {
+        EXPECT_EQ(4 * 1024 * 1024, holes.nextData(0));
+        EXPECT_EQ(4 * 1024 * 1024 + 10, holes.nextData(4 * 1024 * 1024 + 10));
+        EXPECT_EQ(fileSize, holes.nextData(6 * 1024 * 1024));
+    }
+
+    DAbstractFileInfoPointer frominfo = DFileService::instance()->createFileInfo(nullptr, from);
+    DAbstractFileInfoPointer toinfo = DFileService::instance()->createFileInfo(nullptr, to);
+    QSharedPointer<DFileDevice> fromDevice(new DLocalFileDevice());
+    QSharedPointer<DFileDevice> toDevice(new DLocalFileDevice());
+    fromDevice->setFileUrl(from);
+    toDevice->setFileUrl(to);
+    ASSERT_TRUE(fromDevice->open(QIODevice::ReadOnly));
+    ASSERT_TRUE(toDevice->open(QIODevice::WriteOnly | QIODevice::Truncate));
+
+    jobd->setState(DFileCopyMoveJob::RunningState);
+    jobd->fileHints = DFileCopyMoveJob::DontIntegrityChecking | DFileCopyMoveJob::SparseFile;
+    EXPECT_TRUE(jobd->isKeepHoles());
+    EXPECT_TRUE(jobd->doCopyFileByKernel(frominfo, toinfo, fromDevice, toDevice));
+    // 进度按照文件的逻辑大小计算
+    EXPECT_EQ(fileSize, jobd->currentJobDataSizeInfo.second);
+    fromDevice->close();
+    toDevice->close();
+
+    QFile fileto(to.toLocalFile());
+    ASSERT_TRUE(fileto.open(QIODevice::ReadOnly));
+    EXPECT_EQ(fileSize, fileto.size());
+    const QByteArray &content = fileto.readAll();
+    fileto.close();
+    EXPECT_TRUE(content.mid(4 * 1024 * 1024, data.size()) == data);
+    EXPECT_TRUE(content.left(4 * 1024 * 1024) == QByteArray(4 * 1024 * 1024, '\0'));
+    if (holes.isSparse())
+        EXPECT_TRUE(DFileCopyMoveJobPrivate::HoleScanner(to.toLocalFile()).isSparse());
+
+    jobd->fileHints = DFileCopyMoveJob::SparseFile;
+    EXPECT_FALSE(jobd->isKeepHoles());
+
+    job->stop();
+    TestHelper::deleteTmpFile(from.path());
+    TestHelper::deleteTmpFile(to.path());
+}
+
+TEST_F(DFileCopyMoveJobTest, start_syncPolicy)
+{
+    DFileCopyMoveJobPrivate *jobd = job->d_func();
+    ASSERT_TRUE(jobd);
+    EXPECT_EQ(DFileCopyMoveJob::AutoSync, job->syncPolicy());
+    job->setSyncPolicy(DFileCopyMoveJob::FileSync);
+    EXPECT_EQ(DFileCopyMoveJob::FileSync, job->syncPolicy());
+
+    const QString path = TestHelper::createTmpFile();
+    QFile file(path);
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    DFileCopyMoveJobPrivate::WritebackThrottle throttle;
+    const QByteArray data(4 * 1024 * 1024, 'w');
+    for (int i = 0; i < 6; ++i) {
+        EXPECT_EQ(data.size(), file.write(data));
+        file.flush();
+        throttle.written(file.handle(), file.pos());
+    }
+    EXPECT_EQ(throttle.m_flushedPos, 6 * data.size());
+    EXPECT_EQ(throttle.m_waitPos, 4 * data.size());
+    file.close();
+
+    // 后台同步文件后再同步目标文件系统
+    jobd->syncFileInBackground(path);
+    jobd->targetRootPath = QFileInfo(path).absolutePath();
+    EXPECT_EQ(0, jobd->syncTargetFileSystem());
+    jobd->targetRootPath = "/not_exists_path";
+    EXPECT_NE(0, jobd->syncTargetFileSystem());
+
+    job->setSyncPolicy(DFileCopyMoveJob::AutoSync);
+    TestHelper::deleteTmpFile(path);
+    job->stop();
+}
+
+TEST_F(DFileCopyMoveJobTest, start_pageCachePolicy)
+{
+    DFileCopyMoveJobPrivate *jobd = job->d_func();
+    ASSERT_TRUE(jobd);
+    EXPECT_EQ(DFileCopyMoveJob::AutoPageCache, job->pageCachePolicy());
+
+    // 自动策略下小文件和少量数据都保留页缓存
+    jobd->m_isCountSizeOver = true;
+    jobd->totalsize = 1024;
+    EXPECT_FALSE(jobd->isDropPageCache(1024));
+    EXPECT_FALSE(jobd->isDropPageCache(32 * 1024 * 1024));
+    jobd->totalsize = Q_INT64_C(1) << 60;
+    EXPECT_FALSE(jobd->isDropPageCache(1024));
+    EXPECT_TRUE(jobd->isDropPageCache(32 * 1024 * 1024));
+
+    job->setPageCachePolicy(DFileCopyMoveJob::KeepPageCache);
+    EXPECT_FALSE(jobd->isDropPageCache(32 * 1024 * 1024));
+    job->setPageCachePolicy(DFileCopyMoveJob::DropPageCache);
+    EXPECT_TRUE(jobd->isDropPageCache(1024));
+
+    const QString path = TestHelper::createTmpFile();
+    QFile file(path);
+    ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+    DFileCopyMoveJobPrivate::WritebackThrottle throttle;
+    EXPECT_TRUE(jobd->adviseCopyPageCache(file.handle(), file.handle(), 1024, throttle));
+    EXPECT_TRUE(throttle.isDropCache());
+    const QByteArray data(4 * 1024 * 1024, 'c');
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(data.size(), file.write(data));
+        file.flush();
+        throttle.written(file.handle(), file.pos());
+        throttle.read(file.handle(), file.pos());
+    }
+    EXPECT_EQ(throttle.m_readDroppedPos, 4 * data.size());
+    jobd->releaseCopyPageCache(file.handle(), file.handle(), throttle);
+    file.close();
+    EXPECT_EQ(4 * data.size(), QFileInfo(path).size());
+
+    job->setPageCachePolicy(DFileCopyMoveJob::AutoPageCache);
+    jobd->totalsize = 0;
+    TestHelper::deleteTmpFile(path);
+    job->stop();
+}
+
+TEST_F(DFileCopyMoveJobTest, start_bulkRenameOnSameDevice)
+{
+    DFileCopyMoveJobPrivate *jobd = job->d_func();
+    ASSERT_TRUE(jobd);
+    const QString fromDir = TestHelper::createTmpDir();
+    const QString toDir = fromDir + "_target";
+    QDir().mkpath(toDir);
+    const QString file1 = TestHelper::createTmpFileName("bulk_file1", fromDir);
+    const QString file2 = TestHelper::createTmpFileName("bulk_file2", fromDir);
+    QDir().mkpath(fromDir + "/bulk_dir");
+    // 目标已经存在的文件留给以前的流程处理
+    TestHelper::createTmpFileName("bulk_file2", toDir);
+
+    jobd->mode = DFileCopyMoveJob::CutMode;
+    jobd->m_isTagGvfsFile = false;
+    jobd->targetUrl = DUrl::fromLocalFile(toDir);
+    jobd->sourceUrlList = DUrlList() << DUrl::fromLocalFile(file1) << DUrl::fromLocalFile(file2)
+                                     << DUrl::fromLocalFile(fromDir + "/bulk_dir");
+    jobd->setState(DFileCopyMoveJob::RunningState);
+    jobd->bulkRenameOnSameDevice();
+
+    EXPECT_EQ(2, jobd->m_bulkRenamedUrls.count());
+    EXPECT_EQ(DUrl::fromLocalFile(toDir + "/bulk_file1"), jobd->m_bulkRenamedUrls.value(DUrl::fromLocalFile(file1)));
+    EXPECT_FALSE(jobd->m_bulkRenamedUrls.contains(DUrl::fromLocalFile(file2)));
+    EXPECT_TRUE(QFileInfo::exists(toDir + "/bulk_file1"));
+    EXPECT_TRUE(QFileInfo(toDir + "/bulk_dir").isDir());
+    EXPECT_TRUE(QFileInfo::exists(file2));
+
+    // 拷贝不走批量重命名
+    jobd->mode = DFileCopyMoveJob::CopyMode;
+    jobd->bulkRenameOnSameDevice();
+    EXPECT_TRUE(jobd->m_bulkRenamedUrls.isEmpty());
+
+    TestHelper::deleteTmpFiles(QStringList() << fromDir << toDir);
+    job->stop();
+}
+
+TEST_F(DFileCopyMoveJobTest, start_treeRemover)
+{
+    DFileCopyMoveJobPrivate *jobd = job->d_func();
+    ASSERT_TRUE(jobd);
+    const QString root = TestHelper::createTmpDir();
+    for (int i = 0; i < 4; ++i) {
+        const QString sub = QString("%1/sub%2/child").arg(root).arg(i);
+        QDir().mkpath(sub);
+        TestHelper::createTmpFileName("file", sub);
+        TestHelper::createTmpFileName("file", QFileInfo(sub).path());
+    }
+    TestHelper::createTmpFileName("file", root);
+    jobd->setState(DFileCopyMoveJob::RunningState);
+
+    // root 用户不受目录权限限制
+    if (getuid() != 0) {
+        // 只读目录中的文件只有强制删除时才能删除
+        QFile::setPermissions(root + "/sub0/child", QFileDevice::ReadOwner | QFileDevice::ExeOwner);
+        DFileCopyMoveJobPrivate::TreeRemover remover(jobd, &jobd->m_pool, false);
+        EXPECT_FALSE(remover.remove(root));
+        EXPECT_TRUE(QFileInfo::exists(root + "/sub0/child/file"));
+        EXPECT_FALSE(QFileInfo::exists(root + "/sub1"));
+        EXPECT_FALSE(QFileInfo::exists(root + "/file"));
+    }
+
+    DFileCopyMoveJobPrivate::TreeRemover remover(jobd, &jobd->m_pool, true);
+    EXPECT_TRUE(remover.remove(root));
+    EXPECT_FALSE(QFileInfo::exists(root));
+    EXPECT_GT(remover.removedCount(), 0);
+
+    DFileCopyMoveJobPrivate::TreeRemover missing(jobd, &jobd->m_pool, true);
+    EXPECT_FALSE(missing.remove(root));
+    EXPECT_EQ(0, missing.removedCount());
+    job->stop();
+}
+
+TEST_F(DFileCopyMoveJobTest, start_linkToDestination)
+{
+    DFileCopyMoveJobPrivate *jobd = job->d_func();
+    ASSERT_TRUE(jobd);
+    const QString from = TestHelper::createTmpFile();
+    const QString to = from + "_link";
+    QFile file(from);
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write("link");
+    file.close();
+
+    DAbstractFileInfoPointer frominfo = DFileService::instance()->createFileInfo(nullptr, DUrl::fromLocalFile(from));
+    DAbstractFileInfoPointer toinfo = DFileService::instance()->createFileInfo(nullptr, DUrl::fromLocalFile(to));
+
+    jobd->fileHints = DFileCopyMoveJob::NoHint;
+    EXPECT_FALSE(jobd->canLinkToDestination(frominfo, toinfo));
+
+    jobd->fileHints = DFileCopyMoveJob::LinkToDestination;
+    // 目录需要复制
+    EXPECT_FALSE(jobd->canLinkToDestination(DFileService::instance()->createFileInfo(nullptr, frominfo->parentUrl()), toinfo));
+    ASSERT_TRUE(jobd->canLinkToDestination(frominfo, toinfo));
+    ASSERT_TRUE(jobd->linkToDestination(frominfo, toinfo));
+
+    struct stat fromStat;
+    struct stat toStat;
+    ASSERT_EQ(0, stat(from.toLocal8Bit().constData(), &fromStat));
+    ASSERT_EQ(0, stat(to.toLocal8Bit().constData(), &toStat));
+    EXPECT_EQ(fromStat.st_ino, toStat.st_ino);
+    // 目标已存在时不能创建
+    EXPECT_FALSE(jobd->linkToDestination(frominfo, toinfo));
+
+    jobd->fileHints = DFileCopyMoveJob::NoHint;
+    job->stop();
+    TestHelper::deleteTmpFiles(QStringList() << from << to);
+}
+
+TEST_F(DFileCopyMoveJobTest, start_identicalFilePolicy)
+{
+    DFileCopyMoveJobPrivate *jobd = job->d_func();
+    ASSERT_TRUE(jobd);
+    EXPECT_EQ(DFileCopyMoveJob::NoSkipIdentical, job->identicalFilePolicy());
+
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QDateTime modified = QDateTime::fromTime_t(1500000000);
+    // 抽样的数据块之间的内容不同
+    QByteArray fromData(1024 * 1024, 'a');
+    QByteArray toData = fromData;
+    toData[100 * 1024] = 'b';
+    auto writeFile = [&](const QString &path, const QByteArray &data) {
+        QFile file(path);
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        file.write(data);
+        ASSERT_TRUE(file.setFileTime(modified, QFileDevice::FileModificationTime));
+        file.close();
+    };
+    writeFile(dir.filePath("from"), fromData);
+    writeFile(dir.filePath("to"), toData);
+
+    DAbstractFileInfoPointer frominfo = DFileService::instance()->createFileInfo(nullptr, DUrl::fromLocalFile(dir.filePath("from")));
+    DAbstractFileInfoPointer toinfo = DFileService::instance()->createFileInfo(nullptr, DUrl::fromLocalFile(dir.filePath("to")));
+
+    EXPECT_FALSE(jobd->isIdenticalFile(frominfo, toinfo));
+    job->setIdenticalFilePolicy(DFileCopyMoveJob::SkipSameSizeAndTime);
+    EXPECT_TRUE(jobd->isIdenticalFile(frominfo, toinfo));
+    job->setIdenticalFilePolicy(DFileCopyMoveJob::SkipSameSamples);
+    EXPECT_TRUE(jobd->isIdenticalFile(frominfo, toinfo));
+    job->setIdenticalFilePolicy(DFileCopyMoveJob::SkipSameContent);
+    const DFileCopyMoveJob::State state = jobd->state;
+    jobd->state = DFileCopyMoveJob::RunningState;
+    EXPECT_FALSE(jobd->isIdenticalFile(frominfo, toinfo));
+    EXPECT_TRUE(jobd->compareFileData(dir.filePath("from"), dir.filePath("from"), fromData.size(), true));
+    jobd->state = state;
+
+    // 修改时间不同时不是相同的文件
+    writeFile(dir.filePath("to"), fromData);
+    QFile file(dir.filePath("to"));
+    ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+    ASSERT_TRUE(file.setFileTime(modified.addSecs(10), QFileDevice::FileModificationTime));
+    file.close();
+    toinfo->refresh();
+    job->setIdenticalFilePolicy(DFileCopyMoveJob::SkipSameSizeAndTime);
+    EXPECT_FALSE(jobd->isIdenticalFile(frominfo, toinfo));
+
+    job->setIdenticalFilePolicy(DFileCopyMoveJob::NoSkipIdentical);
+    job->stop();
+}
+
+TEST_F(DFileCopyMoveJobTest, start_preserveHardLinks)
+{
+    DFileCopyMoveJobPrivate *jobd = job->d_func();
+    ASSERT_TRUE(jobd);
+
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    QFile file(dir.filePath("a"));
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write("hardlink");
+    file.close();
+    ASSERT_EQ(0, ::link(QFile::encodeName(dir.filePath("a")).constData(), QFile::encodeName(dir.filePath("b")).constData()));
+    QFile(dir.filePath("a")).copy(dir.filePath("a_copy"));
+
+    DAbstractFileInfoPointer ainfo = DFileService::instance()->createFileInfo(nullptr, DUrl::fromLocalFile(dir.filePath("a")));
+    DAbstractFileInfoPointer binfo = DFileService::instance()->createFileInfo(nullptr, DUrl::fromLocalFile(dir.filePath("b")));
+    DAbstractFileInfoPointer toinfo = DFileService::instance()->createFileInfo(nullptr, DUrl::fromLocalFile(dir.filePath("b_copy")));
+
+    QPair<quint64, quint64> key(0, 0);
+    jobd->fileHints = DFileCopyMoveJob::NoHint;
+    EXPECT_TRUE(jobd->copiedHardLinkTarget(ainfo, &key).isEmpty());
+    EXPECT_EQ(0u, key.second);
+
+    jobd->fileHints = DFileCopyMoveJob::PreserveHardLinks;
+    EXPECT_TRUE(jobd->copiedHardLinkTarget(ainfo, &key).isEmpty());
+    ASSERT_NE(0u, key.second);
+    jobd->recordCopiedHardLink(key, dir.filePath("a_copy"));
+
+    // 同一 inode 的其它链接在目标中创建硬链接
+    const QString &copied = jobd->copiedHardLinkTarget(binfo, &key);
+    EXPECT_EQ(dir.filePath("a_copy"), copied);
+    ASSERT_TRUE(jobd->linkToCopiedHardLink(copied, binfo, toinfo));
+
+    struct stat copiedStat;
+    struct stat toStat;
+    ASSERT_EQ(0, stat(QFile::encodeName(dir.filePath("a_copy")).constData(), &copiedStat));
+    ASSERT_EQ(0, stat(QFile::encodeName(dir.filePath("b_copy")).constData(), &toStat));
+    EXPECT_EQ(copiedStat.st_ino, toStat.st_ino);
+    // 目标已存在时不能创建
+    EXPECT_FALSE(jobd->linkToCopiedHardLink(copied, binfo, toinfo));
+
+    jobd->fileHints = DFileCopyMoveJob::NoHint;
+    job->stop();
+}
+
+TEST_F(DFileCopyMoveJobTest, start_deltaTransfer)
+{
+    DFileCopyMoveJobPrivate *jobd = job->d_func();
+    ASSERT_TRUE(jobd);
+
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const qint64 size = 64 * 1024 * 1024 + 100;
+    // 源文件和目标文件只有第二个块和文件末尾不同，目标文件较短
+    QFile from(dir.filePath("from"));
+    ASSERT_TRUE(from.open(QIODevice::WriteOnly));
+    ASSERT_TRUE(from.resize(size));
+    ASSERT_TRUE(from.seek(1024 * 1024 + 10));
+    from.write("delta");
+    ASSERT_TRUE(from.seek(size - 4));
+    from.write("tail");
+    from.close();
+    QFile to(dir.filePath("to"));
+    ASSERT_TRUE(to.open(QIODevice::WriteOnly));
+    ASSERT_TRUE(to.resize(size - 50));
+    to.close();
+
+    DAbstractFileInfoPointer frominfo = DFileService::instance()->createFileInfo(nullptr, DUrl::fromLocalFile(dir.filePath("from")));
+    DAbstractFileInfoPointer toinfo = DFileService::instance()->createFileInfo(nullptr, DUrl::fromLocalFile(dir.filePath("to")));
+    QSharedPointer<DFileHandler> handler(DFileService::instance()->createFileHandler(nullptr, frominfo->fileUrl()));
+
+    const DFileCopyMoveJob::State state = jobd->state;
+    jobd->state = DFileCopyMoveJob::RunningState;
+    EXPECT_TRUE(jobd->deltaCopyFile(frominfo, toinfo, handler));
+    EXPECT_TRUE(jobd->compareFileData(dir.filePath("from"), dir.filePath("to"), size, true));
+    EXPECT_EQ(size, QFileInfo(dir.filePath("to")).size());
+
+    // 小文件直接完整拷贝
+    QFile small(dir.filePath("small"));
+    ASSERT_TRUE(small.open(QIODevice::WriteOnly));
+    small.write("small");
+    small.close();
+    DAbstractFileInfoPointer smallinfo = DFileService::instance()->createFileInfo(nullptr, DUrl::fromLocalFile(dir.filePath("small")));
+    EXPECT_FALSE(jobd->deltaCopyFile(smallinfo, toinfo, handler));
+    jobd->state = state;
+
+    job->stop();
+}
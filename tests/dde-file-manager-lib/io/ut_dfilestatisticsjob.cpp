@@ -6,6 +6,11 @@
 #include <QDateTime>
 
 #include "dfilestatisticsjob.h"
+#include "testhelper.h"
+
+#include <QDir>
+#include <QFile>
+#include <QThread>
 
 
 using namespace testing;
@@ -106,3 +111,108 @@ TEST_F(DFileStatisticsJobTest,can_running_ExcludeSourceFile) {
     }
     job->stop();
 }
+
+TEST_F(DFileStatisticsJobTest, can_count_local_directories) {
+    const QString dirPath = TestHelper::createTmpDir();
+    QDir().mkpath(dirPath + "/sub");
+    auto writeFile = [](const QString &path, int size) {
+        QFile file(path);
+        file.open(QIODevice::WriteOnly);
+        file.write(QByteArray(size, 's'));
+    };
+    writeFile(dirPath + "/a", 10);
+    writeFile(dirPath + "/sub/b", 20);
+    writeFile(dirPath + "/sub/empty", 0);
+    QFile::link(dirPath + "/a", dirPath + "/link");
+
+    // 没有关心每个文件的信号时使用本地统计
+    job->start(DUrlList() << DUrl::fromLocalFile(dirPath));
+    job->wait();
+    EXPECT_EQ(40, job->totalSize());
+    EXPECT_EQ(4, job->filesCount());
+    EXPECT_EQ(2, job->directorysCount());
+
+    // 和以前逐个创建文件信息的结果一致
+    DFileStatisticsJob slowJob;
+    QObject::connect(&slowJob, &DFileStatisticsJob::fileFound, [](const DUrl &) {});
+    slowJob.start(DUrlList() << DUrl::fromLocalFile(dirPath));
+    slowJob.wait();
+    EXPECT_EQ(slowJob.totalSize(), job->totalSize());
+    EXPECT_EQ(slowJob.totalProgressSize(), job->totalProgressSize());
+    EXPECT_EQ(slowJob.filesCount(), job->filesCount());
+    EXPECT_EQ(slowJob.directorysCount(), job->directorysCount());
+
+    TestHelper::deleteTmpFile(dirPath);
+}
+
+TEST_F(DFileStatisticsJobTest, can_count_with_cache) {
+    const QString dirPath = TestHelper::createTmpDir();
+    QDir().mkpath(dirPath + "/sub/deep");
+    auto writeFile = [](const QString &path, int size, QIODevice::OpenMode mode = QIODevice::WriteOnly) {
+        QFile file(path);
+        file.open(mode);
+        file.write(QByteArray(size, 's'));
+    };
+    writeFile(dirPath + "/sub/b", 20);
+    writeFile(dirPath + "/sub/deep/c", 30);
+    // 刚修改过的目录不缓存
+    QThread::sleep(3);
+    auto count = [&dirPath](DFileStatisticsJob &statisticsJob) {
+        statisticsJob.start(DUrlList() << DUrl::fromLocalFile(dirPath));
+        statisticsJob.wait();
+    };
+
+    DFileStatisticsJob firstJob;
+    count(firstJob);
+    EXPECT_EQ(50, firstJob.totalSize());
+
+    // 没有变化的目录使用缓存，结果不变
+    DFileStatisticsJob cachedJob;
+    count(cachedJob);
+    EXPECT_EQ(50, cachedJob.totalSize());
+    EXPECT_EQ(2, cachedJob.filesCount());
+    EXPECT_EQ(3, cachedJob.directorysCount());
+
+    // 修改文件的内容不会改变目录的修改时间，需要通知缓存失效
+    writeFile(dirPath + "/sub/deep/c", 5, QIODevice::Append);
+    DFileStatisticsJob::invalidateCache(DUrl::fromLocalFile(dirPath + "/sub/deep/c"));
+    DFileStatisticsJob modifiedJob;
+    count(modifiedJob);
+    EXPECT_EQ(55, modifiedJob.totalSize());
+
+    // 新建文件后目录的修改时间变化，重新读取这个目录
+    writeFile(dirPath + "/sub/d", 5);
+    DFileStatisticsJob createdJob;
+    count(createdJob);
+    EXPECT_EQ(60, createdJob.totalSize());
+    EXPECT_EQ(3, createdJob.filesCount());
+
+    TestHelper::deleteTmpFile(dirPath);
+}
+
+TEST_F(DFileStatisticsJobTest, can_notify_when_items_finished) {
+    const QString firstPath = TestHelper::createTmpDir();
+    const QString secondPath = TestHelper::createTmpDir();
+    QDir().mkpath(firstPath + "/sub");
+    QFile file(secondPath + "/a");
+    file.open(QIODevice::WriteOnly);
+    file.write(QByteArray(10, 's'));
+    file.close();
+
+    int notifyCount = 0;
+    qint64 lastSize = -1;
+    QObject::connect(job, &DFileStatisticsJob::dataNotify, [&notifyCount, &lastSize](qint64 size, int, int) {
+        ++notifyCount;
+        lastSize = size;
+    });
+
+    // 开始、选中的文件统计完成、每个顶层目录统计完成和结束时都会通知
+    job->start(DUrlList() << DUrl::fromLocalFile(firstPath) << DUrl::fromLocalFile(secondPath));
+    job->wait();
+    EXPECT_GE(notifyCount, 5);
+    EXPECT_EQ(10, lastSize);
+    EXPECT_EQ(3, job->directorysCount());
+
+    TestHelper::deleteTmpFile(firstPath);
+    TestHelper::deleteTmpFile(secondPath);
+}
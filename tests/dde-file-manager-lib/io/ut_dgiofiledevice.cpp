@@ -5,6 +5,7 @@
 #include <gtest/gtest.h>
 #include <QDateTime>
 #include <QtConcurrent>
+#include <QTemporaryDir>
 #undef signals
 extern "C" {
 #include <gio/gio.h>
@@ -176,6 +177,38 @@ TEST_F(DGIOFileDeviceTest,can_fileUrl) {
     EXPECT_EQ(url,static_cast<DFileDevice *>(device)->fileUrl());
 }
 
+TEST_F(DGIOFileDeviceTest,can_read_ahead) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    QByteArray content;
+    for (int i = 0; content.size() < 3 * 1024 * 1024 + 100; ++i)
+        content.append(QByteArray::number(i));
+    QFile file(dir.filePath("read_ahead.txt"));
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write(content);
+    file.close();
+
+    device->setFileUrl(DUrl::fromLocalFile(file.fileName()));
+    device->setReadAhead(true);
+    ASSERT_TRUE(device->open(QIODevice::ReadOnly));
+
+    // 预读时按调用者读到的位置报告 pos，读到的数据与顺序读取一致
+    QByteArray data;
+    char buffer[64 * 1024];
+    qint64 size = 0;
+    while ((size = device->read(buffer, sizeof(buffer))) > 0)
+        data.append(buffer, static_cast<int>(size));
+    EXPECT_EQ(content, data);
+    EXPECT_EQ(content.size(), device->pos());
+
+    EXPECT_TRUE(device->seek(100));
+    EXPECT_EQ(100, device->pos());
+    EXPECT_EQ(static_cast<qint64>(sizeof(buffer)), device->read(buffer, sizeof(buffer)));
+    EXPECT_EQ(content.mid(100, sizeof(buffer)), QByteArray(buffer, sizeof(buffer)));
+    EXPECT_EQ(static_cast<qint64>(100 + sizeof(buffer)), device->pos());
+    device->close();
+}
+
 TEST_F(DGIOFileDeviceTest,start_readData) {
     char buf[16] = {"a"};
     gssize (*g_input_stream_read1)(GInputStream *,void *,gsize,GCancellable*,GError**) = []
@@ -0,0 +1,60 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include "djobprogresschannel.h"
+
+DFM_USE_NAMESPACE
+
+TEST(TestDJobProgressChannel, create_and_open)
+{
+    QSharedPointer<DJobProgressChannel> writer = DJobProgressChannel::create();
+    ASSERT_TRUE(writer);
+    EXPECT_GE(writer->memoryFd(), 0);
+    EXPECT_GE(writer->eventFd(), 0);
+
+    QSharedPointer<DJobProgressChannel> reader = DJobProgressChannel::open(writer->memoryFd(), writer->eventFd());
+    ASSERT_TRUE(reader);
+    // 文件描述符被复制，两侧各自关闭
+    EXPECT_NE(writer->memoryFd(), reader->memoryFd());
+
+    EXPECT_FALSE(DJobProgressChannel::open(-1, -1));
+}
+
+TEST(TestDJobProgressChannel, snapshot)
+{
+    QSharedPointer<DJobProgressChannel> writer = DJobProgressChannel::create();
+    ASSERT_TRUE(writer);
+    QSharedPointer<DJobProgressChannel> reader = DJobProgressChannel::open(writer->memoryFd(), writer->eventFd());
+    ASSERT_TRUE(reader);
+
+    writer->setTotal(4096, 3);
+    writer->setProcessedBytes(1024);
+    writer->setProcessedFiles(1);
+    writer->setCurrentFile(QStringLiteral("/tmp/测试文件"));
+
+    const DJobProgressChannel::Snapshot &snapshot = reader->snapshot();
+    EXPECT_EQ(4096, snapshot.totalBytes);
+    EXPECT_EQ(1024, snapshot.processedBytes);
+    EXPECT_EQ(3, snapshot.totalFiles);
+    EXPECT_EQ(1, snapshot.processedFiles);
+    EXPECT_EQ(QStringLiteral("/tmp/测试文件"), snapshot.currentFile);
+}
+
+TEST(TestDJobProgressChannel, state_events)
+{
+    QSharedPointer<DJobProgressChannel> writer = DJobProgressChannel::create();
+    ASSERT_TRUE(writer);
+    QSharedPointer<DJobProgressChannel> reader = DJobProgressChannel::open(writer->memoryFd(), writer->eventFd());
+    ASSERT_TRUE(reader);
+
+    EXPECT_EQ(0u, reader->takeStateEvents());
+
+    writer->setState(1);
+    writer->setState(2);
+    EXPECT_EQ(2u, reader->takeStateEvents());
+    EXPECT_EQ(2, reader->snapshot().state);
+    EXPECT_EQ(0u, reader->takeStateEvents());
+}
@@ -4,6 +4,8 @@
 
 #include <gtest/gtest.h>
 #include <QDateTime>
+#include <QTemporaryDir>
+#include <QDir>
 
 #include "dlocalfilehandler.h"
 
@@ -153,3 +155,37 @@ TEST_F(DLocalFileHandlerTest,can_not_get_rmdir){
 
 
 
+
+TEST_F(DLocalFileHandlerTest,can_batch_operate){
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const DUrl url = DUrl::fromLocalFile(dir.path());
+
+    EXPECT_EQ(QStringList({QString(), QString()}), handler->mkdirBatch(url, {"a", "b"}));
+    EXPECT_NE(QString(), handler->mkdirBatch(url, {"a"}).first());
+    EXPECT_EQ(QStringList({QString()}), handler->linkBatch(url, {qMakePair(QString("a"), QString("link"))}));
+    EXPECT_TRUE(QFileInfo(dir.filePath("link")).isSymLink());
+
+    EXPECT_EQ(QStringList({QString(), QString()}), handler->renameBatch(url, {qMakePair(QString("a"), QString("c")),
+                                                                              qMakePair(QString("link"), QString("link2"))}));
+    EXPECT_TRUE(QFileInfo::exists(dir.filePath("c")));
+
+    const QFileDevice::Permissions permissions = QFileDevice::ReadOwner | QFileDevice::WriteOwner | QFileDevice::ExeOwner
+                                                 | QFileDevice::ReadUser | QFileDevice::WriteUser | QFileDevice::ExeUser;
+    EXPECT_EQ(QStringList({QString()}), handler->setPermissionsBatch(url, {qMakePair(QString("c"), permissions)}));
+    EXPECT_EQ(permissions, QFileInfo(dir.filePath("c")).permissions());
+
+    // 每一项单独报告结果，失败的项不影响其它项
+    const QStringList &errors = handler->removeBatch(url, {"b", "none", "c", "link2"});
+    ASSERT_EQ(4, errors.size());
+    EXPECT_EQ(QString(), errors.at(0));
+    EXPECT_NE(QString(), errors.at(1));
+    EXPECT_EQ(QString(), errors.at(2));
+    EXPECT_EQ(QString(), errors.at(3));
+    EXPECT_TRUE(QDir(dir.path()).entryList(QDir::AllEntries | QDir::NoDotAndDotDot | QDir::System).isEmpty());
+
+    // 目录不存在时所有项都失败
+    const QStringList &missing = handler->removeBatch(DUrl::fromLocalFile(dir.filePath("none")), {"a", "b"});
+    ASSERT_EQ(2, missing.size());
+    EXPECT_FALSE(missing.contains(QString()));
+}
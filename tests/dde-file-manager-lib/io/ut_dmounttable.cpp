@@ -0,0 +1,70 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include "dmounttable.h"
+
+DFM_USE_NAMESPACE
+
+namespace  {
+class TestDMountTable : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        table = DMountTable::instance();
+        ASSERT_TRUE(table->loadFromData(
+                        "22 1 8:1 / / rw,relatime shared:1 - ext4 /dev/sda1 rw\n"
+                        "23 22 0:21 / /run rw,nosuid shared:5 - tmpfs tmpfs rw\n"
+                        "24 23 0:45 / /run/user/1000/gvfs rw,nosuid shared:6 - fuse.gvfsd-fuse gvfsd-fuse rw\n"
+                        "25 22 8:17 / /media/user/my\\040disk rw,nosuid shared:7 - vfat /dev/sdb1 rw\n"
+                        "26 22 11:0 / /media/user/cdrom ro,nosuid shared:8 - iso9660 /dev/sr0 ro\n"
+                        "27 22 0:50 / /home/user/nfs rw,relatime shared:9 - nfs4 server:/export rw\n"));
+    }
+
+    void TearDown() override
+    {
+        table->refresh();
+    }
+
+    DMountTable *table = nullptr;
+};
+}
+
+TEST_F(TestDMountTable, findMount)
+{
+    DMountTable::MountEntry entry;
+    QString subPath;
+
+    EXPECT_TRUE(table->findMount("/home/user/file", &entry, &subPath));
+    EXPECT_EQ(QString("/"), entry.mountPoint);
+    EXPECT_EQ(QByteArray("/dev/sda1"), entry.device);
+    EXPECT_EQ(QString("/home/user/file"), subPath);
+
+    EXPECT_TRUE(table->findMount("/media/user/my disk/a", &entry, &subPath));
+    EXPECT_EQ(QString("/media/user/my disk"), entry.mountPoint);
+    EXPECT_EQ(QByteArray("vfat"), entry.fileSystemType);
+    EXPECT_EQ(QString("/a"), subPath);
+
+    // 不是挂载点的同名前缀
+    EXPECT_TRUE(table->findMount("/media/user/my diskette", &entry));
+    EXPECT_EQ(QString("/"), entry.mountPoint);
+
+    EXPECT_FALSE(table->findMount("relative/path", &entry));
+    EXPECT_FALSE(table->findMount("/run/../media/user/cdrom", &entry));
+}
+
+TEST_F(TestDMountTable, mountClass)
+{
+    EXPECT_EQ(DMountTable::LocalDeviceMount, table->mountClass("/home/user"));
+    EXPECT_EQ(DMountTable::LocalDeviceMount, table->mountClass("/media/user/./cdrom"));
+    EXPECT_EQ(DMountTable::OtherMount, table->mountClass("/run/user/1000"));
+    EXPECT_EQ(DMountTable::GvfsMount, table->mountClass("/run/user/1000/gvfs"));
+    EXPECT_EQ(DMountTable::GvfsMount, table->mountClass("/run/user/1000/gvfs/google-drive:host=a.com/file"));
+    EXPECT_EQ(DMountTable::LowSpeedGvfsMount, table->mountClass("/run/user/1000/gvfs/smb-share:server=1.2.3.4,share=a/b"));
+    EXPECT_EQ(DMountTable::LowSpeedGvfsMount, table->mountClass("/run/user/1000/gvfs/mtp:host=phone"));
+    EXPECT_EQ(DMountTable::NetworkMount, table->mountClass("/home/user/nfs/file"));
+    EXPECT_EQ(DMountTable::UnknownMount, table->mountClass("~/file"));
+}
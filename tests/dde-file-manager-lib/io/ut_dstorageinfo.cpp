@@ -14,6 +14,7 @@ extern "C" {
 #define signals public
 
 #include "dstorageinfo.h"
+#include "dmounttable.h"
 #include "testhelper.h"
 #include "stubext.h"
 #include "controllers/vaultcontroller.h"
@@ -273,6 +274,9 @@ TEST_F(DStorageInfoTest,can_static_isLocalDevice) {
     EXPECT_TRUE(DStorageInfo::isLocalDevice("~/dstorng_test",true));
     stl.set_lamda(&VaultController::isVaultFile,[](){return true;});
     EXPECT_TRUE(DStorageInfo::isLocalDevice("/run/user/1000"));
+    stl.set_lamda(&DMountTable::mountClass,[](){return DMountTable::GvfsMount;});
+    EXPECT_FALSE(DStorageInfo::isLocalDevice("/run/user/1000"));
+    stl.set_lamda(&DMountTable::mountClass,[](){return DMountTable::UnknownMount;});
     stl.set_lamda(&QRegularExpressionMatch::hasMatch,[](){return true;});
     EXPECT_FALSE(DStorageInfo::isLocalDevice("/run/user/1000"));
 }
@@ -280,7 +284,8 @@ TEST_F(DStorageInfoTest,can_static_isLocalDevice) {
 TEST_F(DStorageInfoTest,can_static_isLowSpeedDevice) {
     EXPECT_FALSE(DStorageInfo::isLowSpeedDevice("/sys/bin/aconnect"));
     EXPECT_FALSE(DStorageInfo::isLocalDevice("/run/user/1000"));
-    stl.set_lamda(&QRegularExpressionMatch::hasMatch,[](){return true;});
+    stl.set_lamda(&DMountTable::mountClass,[](){return DMountTable::LowSpeedGvfsMount;});
+    EXPECT_TRUE(DStorageInfo::isLowSpeedDevice("/run/user/1000"));
     EXPECT_FALSE(DStorageInfo::isLocalDevice("/run/user/1000"));
 }
 
@@ -0,0 +1,50 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <QTemporaryDir>
+
+#define private public
+#include "dstorageusagecache.h"
+#undef private
+
+DFM_USE_NAMESPACE
+
+TEST(TestDStorageUsageCache, usage)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    DStorageUsageCache *cache = DStorageUsageCache::instance();
+
+    // 等待首次查询完成
+    const DStorageUsageCache::Usage &usage = cache->usage(dir.path(), 60000, 5000);
+    ASSERT_TRUE(usage.isValid());
+    EXPECT_GT(usage.bytesTotal, 0);
+    EXPECT_GE(usage.bytesTotal, usage.bytesAvailable);
+
+    // 有效期内直接返回缓存的结果，不再查询
+    const DStorageUsageCache::Usage &cached = cache->usage(dir.path(), 60000);
+    EXPECT_EQ(usage.bytesTotal, cached.bytesTotal);
+    EXPECT_EQ(usage.fileSystemType, cached.fileSystemType);
+    EXPECT_FALSE(cache->m_entries.value(dir.path()).querying);
+}
+
+TEST(TestDStorageUsageCache, invalidate)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    DStorageUsageCache *cache = DStorageUsageCache::instance();
+    ASSERT_TRUE(cache->usage(dir.path(), 60000, 5000).isValid());
+
+    cache->invalidate(dir.path());
+    EXPECT_FALSE(cache->m_entries.value(dir.path()).updated.isValid());
+
+    // 失效后不等待时返回上一次的结果，同时在后台重新查询
+    EXPECT_TRUE(cache->usage(dir.path(), 60000).isValid());
+    EXPECT_TRUE(cache->usage(dir.path(), 60000, 5000).isValid());
+    EXPECT_TRUE(cache->m_entries.value(dir.path()).updated.isValid());
+}
@@ -123,3 +123,47 @@ TEST_F(TestFilterAppender, tst_computeFrequency)
 }
 
 
+
+TEST_F(TestFilterAppender, tst_rateLimit)
+{
+    static const char *file = "ut_filterappender.cpp";
+    QString message;
+    int passed = 0;
+
+    for (int i = 0; i < 1000; ++i) {
+        message = "repeated";
+        if (m_appender->passRateLimit(Logger::Debug, file, 1, &message))
+            ++passed;
+    }
+
+    EXPECT_GT(passed, 0);
+    EXPECT_LT(passed, 1000);
+
+    // 错误日志不限流
+    message = "error";
+    EXPECT_TRUE(m_appender->passRateLimit(Logger::Error, file, 1, &message));
+
+    // 新窗口的第一条日志注明省略的条数
+    m_appender->m_rateBuckets[qMakePair(reinterpret_cast<quintptr>(file), 1)].windowStart = -1000000;
+    message = "repeated";
+    EXPECT_TRUE(m_appender->passRateLimit(Logger::Debug, file, 1, &message));
+    EXPECT_TRUE(message.contains("suppressed"));
+}
+
+TEST_F(TestFilterAppender, tst_async)
+{
+    EXPECT_FALSE(m_appender->isAsync());
+
+    m_appender->setAsync(true);
+    EXPECT_TRUE(m_appender->isAsync());
+
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_NO_FATAL_FAILURE(m_appender->append(QDateTime::currentDateTime(),
+                                                   Logger::Info, "", i, nullptr, "", "asyncmessage"));
+    }
+
+    EXPECT_NO_FATAL_FAILURE(m_appender->flush());
+
+    m_appender->setAsync(false);
+    EXPECT_FALSE(m_appender->isAsync());
+}
@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <QDir>
+#include <QTemporaryDir>
+
+#include "mediainfo/dfmmediainfocache.h"
+
+DFM_USE_NAMESPACE
+
+namespace {
+class DFMMediaInfoCacheTest : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        ASSERT_TRUE(tempDir.isValid());
+    }
+
+    QString cachePath() const
+    {
+        return tempDir.path() + QDir::separator() + "mediainfo.cache";
+    }
+
+    QTemporaryDir tempDir;
+};
+} // namespace
+
+TEST_F(DFMMediaInfoCacheTest, find_by_size_and_modified)
+{
+    DFMMediaInfoCache cache(cachePath());
+    QHash<QString, QString> values;
+
+    values.insert("0/Duration", "1000");
+    cache.insert("/tmp/a.mp4", 100, 10, values);
+
+    QHash<QString, QString> found;
+
+    EXPECT_TRUE(cache.find("/tmp/a.mp4", 100, 10, &found));
+    EXPECT_EQ(values, found);
+    EXPECT_FALSE(cache.find("/tmp/a.mp4", 101, 10, &found));
+    EXPECT_FALSE(cache.find("/tmp/a.mp4", 100, 11, &found));
+    EXPECT_FALSE(cache.find("/tmp/b.mp4", 100, 10, &found));
+}
+
+TEST_F(DFMMediaInfoCacheTest, save_and_load)
+{
+    QHash<QString, QString> values;
+    values.insert("1/Width", "1920");
+    values.insert("1/Height", "1080");
+
+    {
+        DFMMediaInfoCache cache(cachePath());
+        cache.insert("/tmp/a.mp4", 100, 10, values);
+        EXPECT_TRUE(cache.save());
+    }
+
+    DFMMediaInfoCache cache(cachePath());
+    QHash<QString, QString> found;
+
+    EXPECT_EQ(1, cache.count());
+    EXPECT_TRUE(cache.find("/tmp/a.mp4", 100, 10, &found));
+    EXPECT_EQ(values, found);
+}
+
+TEST_F(DFMMediaInfoCacheTest, remove_least_recently_used)
+{
+    DFMMediaInfoCache cache(cachePath());
+
+    cache.setMaxCount(10);
+
+    for (int i = 0; i < 11; ++i)
+        cache.insert(QString("/tmp/%1.mp4").arg(i), i, 0, QHash<QString, QString>());
+
+    EXPECT_LE(cache.count(), 8);
+    EXPECT_TRUE(cache.find("/tmp/10.mp4", 10, 0, nullptr));
+}
@@ -7,6 +7,7 @@
 #include "addr_pri.h"
 
 #include <gtest/gtest.h>
+#include <QStringListModel>
 using namespace FileManagerSelectionModel;
 ACCESS_PRIVATE_FIELD(DFileSelectionModel, QItemSelectionModel::SelectionFlags, m_currentCommand);
 ACCESS_PRIVATE_FIELD(DFileSelectionModel, QTimer, m_timer);
@@ -97,3 +98,25 @@ TEST_F(TestDFileSelectionModel, tstClear)
 {
     call_private_fun::DFileSelectionModelclear(*model);
 }
+
+TEST_F(TestDFileSelectionModel, tstSelectedIndexesOfRanges)
+{
+    QStringList list;
+    for (int i = 0; i < 1000; ++i)
+        list << QString::number(i);
+
+    QStringListModel listModel(list);
+    DFileSelectionModel selectionModel(&listModel);
+
+    // 全选后取消一项，选中的内容拆分为两个区间
+    call_private_fun::DFileSelectionModelselect(selectionModel, QItemSelection(listModel.index(0), listModel.index(999)),
+                                                QItemSelectionModel::ClearAndSelect | QItemSelectionModel::Rows);
+    call_private_fun::DFileSelectionModelselect(selectionModel, QItemSelection(listModel.index(10), listModel.index(10)),
+                                                QItemSelectionModel::Toggle | QItemSelectionModel::Rows);
+
+    const QModelIndexList &indexes = selectionModel.selectedIndexes();
+    EXPECT_EQ(999, indexes.count());
+    EXPECT_EQ(999, selectionModel.selectedCount());
+    EXPECT_FALSE(indexes.contains(listModel.index(10)));
+    EXPECT_TRUE(indexes.contains(listModel.index(999)));
+}
@@ -135,3 +135,37 @@ TEST_F(TestTrashFileInfo, tstUpdateInfo)
     trash->deletionDate();
     delete trash;
 }
+
+TEST_F(TestTrashFileInfo, tstReadTrashInfo)
+{
+    const QString &location = QDir::tempPath() + "/ut_trashfileinfo.trashinfo";
+    QFile file(location);
+
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write("[Trash Info]\n"
+               "Path=/tmp/a%20b.txt\n"
+               "DeletionDate=2022-01-02T03:04:05\n"
+               "TagNameList=red,blue\n");
+    file.close();
+
+    QByteArray path;
+    QString date;
+    QString tagNameList;
+
+    EXPECT_TRUE(TrashFileInfoPrivate::readTrashInfo(location, &path, &date, &tagNameList));
+    EXPECT_EQ(QByteArray("/tmp/a%20b.txt"), path);
+    EXPECT_EQ(QString("2022-01-02T03:04:05"), date);
+    EXPECT_EQ(QString("red,blue"), tagNameList);
+    EXPECT_FALSE(TrashFileInfoPrivate::readTrashInfo(location + ".none", &path, &date, &tagNameList));
+
+    QFile::remove(location);
+}
+
+TEST_F(TestTrashFileInfo, tstLazyInfo)
+{
+    TrashFileInfo trash(DUrl("trash:///"));
+
+    EXPECT_FALSE(trash.d_func()->infoLoaded);
+    EXPECT_STREQ("Trash", trash.fileDisplayName().toStdString().c_str());
+    EXPECT_TRUE(trash.d_func()->infoLoaded);
+}
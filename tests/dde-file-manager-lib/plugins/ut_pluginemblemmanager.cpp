@@ -0,0 +1,89 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <QIcon>
+#include <QDateTime>
+
+#define private public
+#define protected public
+
+#include "plugins/pluginemblemmanager.h"
+#include "plugins/private/pluginemblemmanagerprivate.h"
+
+namespace  {
+class PluginEmblemManagerTest : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        d = PluginEmblemManager::instance()->d;
+        // 停止子线程，由测试用例直接处理队列
+        d->stopWork();
+        bHaveEmblemObj = d->bHaveEmblemObj;
+        d->bHaveEmblemObj = true;
+        d->clearEmblemIconsMap();
+    }
+    void TearDown() override
+    {
+        d->filePathQueue.clear();
+        d->pendingFilePaths.clear();
+        d->clearEmblemIconsMap();
+        d->bHaveEmblemObj = bHaveEmblemObj;
+    }
+
+    PluginEmblemManagerPrivate *d = nullptr;
+    bool bHaveEmblemObj = false;
+};
+}
+
+TEST_F(PluginEmblemManagerTest, use_cache_and_batch_requests)
+{
+    const DUrl url = DUrl::fromLocalFile("/tmp/ut_plugin_emblem");
+    QList<QIcon> icons;
+
+    // 没有缓存时不阻塞绘制，只排队一次
+    d->getPluginEmblemIconsFromMap(url, 0, icons, 1);
+    d->getPluginEmblemIconsFromMap(url, 0, icons, 1);
+    EXPECT_TRUE(icons.isEmpty());
+    ASSERT_EQ(d->filePathQueue.size(), 1);
+
+    QList<PluginEmblemRequest> requests;
+    requests << d->filePathQueue.dequeue();
+    d->cacheEmblemToMap(requests, QList<QStringList>() << (QStringList() << "emblem-ut" << QString() << QString() << QString()));
+    EXPECT_TRUE(d->pendingFilePaths.isEmpty());
+
+    // 缓存有效时直接使用缓存
+    d->getPluginEmblemIconsFromMap(url, 0, icons, 1);
+    EXPECT_EQ(icons.size(), kMaxEmblemCount);
+    EXPECT_TRUE(d->filePathQueue.isEmpty());
+
+    // 修改时间变化后继续使用旧的角标，同时重新获取
+    icons.clear();
+    d->getPluginEmblemIconsFromMap(url, 0, icons, 2);
+    EXPECT_EQ(icons.size(), kMaxEmblemCount);
+    ASSERT_EQ(d->filePathQueue.size(), 1);
+    EXPECT_EQ(d->filePathQueue.head().modified, 2u);
+}
+
+TEST_F(PluginEmblemManagerTest, cache_files_without_emblem)
+{
+    const DUrl url = DUrl::fromLocalFile("/tmp/ut_plugin_emblem");
+    QList<QIcon> icons;
+
+    d->getPluginEmblemIconsFromMap(url, 0, icons, 1);
+    QList<PluginEmblemRequest> requests;
+    requests << d->filePathQueue.dequeue();
+    d->cacheEmblemToMap(requests, QList<QStringList>() << QStringList());
+
+    d->getPluginEmblemIconsFromMap(url, 0, icons, 1);
+    EXPECT_TRUE(icons.isEmpty());
+    EXPECT_TRUE(d->filePathQueue.isEmpty());
+
+    // 缓存过期后重新获取
+    d->mapIcons[url.toLocalFile()].updateTime = QDateTime::currentMSecsSinceEpoch() - 60 * 1000;
+    d->getPluginEmblemIconsFromMap(url, 0, icons, 1);
+    EXPECT_EQ(d->filePathQueue.size(), 1);
+}
@@ -0,0 +1,85 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QThread>
+
+#include <gtest/gtest.h>
+
+#define private public
+#include "searcher/fsearch/fsdatabasemanager.h"
+
+namespace {
+class TestFsDatabaseManager : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        ASSERT_TRUE(tempDir.isValid());
+        QDir(tempDir.path()).mkpath("a/b");
+        QFile file(tempDir.filePath("a/b/123qweasdzxc.txt"));
+        file.open(QIODevice::WriteOnly);
+    }
+
+    QTemporaryDir tempDir;
+};
+}
+
+TEST_F(TestFsDatabaseManager, tst_database_resident)
+{
+    FsDatabaseManager manager;
+    bool state = true;
+
+    const QSharedPointer<Database> db = manager.database(tempDir.path(), &state);
+    ASSERT_TRUE(db);
+    EXPECT_EQ(3u, db_get_num_entries(db.data()));
+
+    // 再次搜索时直接使用已建立的数据库
+    EXPECT_EQ(db, manager.database(tempDir.path(), &state));
+
+    const FsDatabaseManager::DatabaseInfo &info = manager.databases.value(tempDir.path());
+    EXPECT_TRUE(info.fullyWatched);
+    EXPECT_TRUE(info.directories.contains(tempDir.filePath("a/b")));
+}
+
+TEST_F(TestFsDatabaseManager, tst_database_canceled)
+{
+    FsDatabaseManager manager;
+    bool state = false;
+
+    EXPECT_FALSE(manager.database(tempDir.path(), &state));
+    EXPECT_TRUE(manager.databases.isEmpty());
+}
+
+TEST_F(TestFsDatabaseManager, tst_rebuild_after_change)
+{
+    FsDatabaseManager manager;
+    bool state = true;
+
+    const QSharedPointer<Database> db = manager.database(tempDir.path(), &state);
+    ASSERT_TRUE(db);
+
+    // 隐藏文件不影响数据库
+    manager.onFileChanged(tempDir.filePath("a"), ".hidden");
+    EXPECT_FALSE(manager.databases.value(tempDir.path()).dirty);
+
+    QFile file(tempDir.filePath("a/new.txt"));
+    file.open(QIODevice::WriteOnly);
+    manager.onFileChanged(tempDir.filePath("a"), "new.txt");
+    EXPECT_TRUE(manager.databases.value(tempDir.path()).dirty);
+
+    manager.rebuildDirtyDatabases();
+
+    for (int i = 0; i < 500 && manager.databases.value(tempDir.path()).rebuilding; ++i)
+        QThread::msleep(10);
+
+    const QSharedPointer<Database> newDb = manager.database(tempDir.path(), &state);
+    ASSERT_TRUE(newDb);
+    EXPECT_NE(db, newDb);
+    EXPECT_EQ(4u, db_get_num_entries(newDb.data()));
+    // 旧的数据库在不再使用前仍然有效
+    EXPECT_EQ(3u, db_get_num_entries(db.data()));
+}
@@ -5,12 +5,19 @@
 #include <QStandardPaths>
 #include <QUuid>
 #include <QDir>
+#include <QtConcurrent>
+#include <QDateTime>
+#include <QFileInfo>
 
 #include <gtest/gtest.h>
 
 
 #define private public
 #include "searcher/fulltext/fulltextsearcher.h"
+#include "searcher/fulltext/fulltextsearcher_p.h"
+#undef private
+#include "stub-ext/stubext.h"
+#include "dfmapplication.h"
 
 namespace {
 class TestFullTextSearcher : public testing::Test
@@ -78,3 +85,75 @@ TEST_F(TestFullTextSearcher, tst_isSupport) {
     DUrl url = DUrl("file://" + filePath);
     EXPECT_NO_FATAL_FAILURE(search->isSupport(url));
 }
+
+TEST_F(TestFullTextSearcher, tst_blockingQueue) {
+    BlockingQueue<int> queue(2);
+    EXPECT_TRUE(queue.push(1));
+    EXPECT_TRUE(queue.push(2));
+
+    // 队列满时生产者等待，直到消费者取出元素
+    QFuture<bool> future = QtConcurrent::run([&queue] {
+        return queue.push(3);
+    });
+    EXPECT_EQ(QList<int>({ 1, 2 }), queue.pop(2));
+    EXPECT_TRUE(future.result());
+    EXPECT_EQ(QList<int>({ 3 }), queue.pop(2));
+
+    // 关闭后不再接受新元素，等待中的消费者返回空列表
+    future = QtConcurrent::run([&queue] {
+        return queue.pop().isEmpty();
+    });
+    queue.close();
+    EXPECT_TRUE(future.result());
+    EXPECT_FALSE(queue.push(4));
+}
+
+TEST_F(TestFullTextSearcher, tst_checkHit) {
+    const QString file = filePath + "/hit.txt";
+    QFile(file).open(QIODevice::WriteOnly);
+
+    FullTextSearcherPrivate::SearchHit hit;
+    hit.path = file.toStdWString();
+    hit.storeTime = QFileInfo(file).lastModified().toString("yyyyMMddHHmmss").toStdWString();
+    FullTextSearcherPrivate::checkHit(hit);
+    EXPECT_EQ(FullTextSearcherPrivate::SearchHit::kValid, hit.state);
+
+    hit.storeTime = L"19700101000000";
+    FullTextSearcherPrivate::checkHit(hit);
+    EXPECT_EQ(FullTextSearcherPrivate::SearchHit::kModified, hit.state);
+
+    QFile::remove(file);
+    FullTextSearcherPrivate::checkHit(hit);
+    EXPECT_EQ(FullTextSearcherPrivate::SearchHit::kRemoved, hit.state);
+}
+
+TEST_F(TestFullTextSearcher, tst_fileDocument) {
+    const QString file = filePath + "/document.txt";
+    QFile textFile(file);
+    ASSERT_TRUE(textFile.open(QIODevice::WriteOnly));
+    textFile.write(QByteArray(1024, 'a'));
+    textFile.close();
+
+    int storeMode = FullTextSearcherPrivate::kStoreNone;
+    stub_ext::StubExt st;
+    st.set_lamda(ADDR(DFMApplication, genericAttribute), [&storeMode](DFMApplication::GenericAttribute ga) {
+        return ga == DFMApplication::GA_FullTextStoreMode ? QVariant(storeMode) : QVariant(64);
+    });
+
+    // 默认只索引文件内容，不保存
+    Lucene::DocumentPtr doc = search->d->fileDocument(file);
+    EXPECT_FALSE(doc->getField(L"contents")->isStored());
+    EXPECT_FALSE(doc->getField(L"snippet"));
+
+    storeMode = FullTextSearcherPrivate::kStoreSnippet;
+    doc = search->d->fileDocument(file);
+    EXPECT_FALSE(doc->getField(L"contents")->isStored());
+    ASSERT_TRUE(doc->getField(L"snippet"));
+    EXPECT_GT(1024, static_cast<int>(doc->get(L"snippet").size()));
+
+    storeMode = FullTextSearcherPrivate::kStoreContents;
+    doc = search->d->fileDocument(file);
+    EXPECT_TRUE(doc->getField(L"contents")->isStored());
+
+    QFile::remove(file);
+}
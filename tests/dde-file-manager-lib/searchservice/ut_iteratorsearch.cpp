@@ -5,6 +5,7 @@
 #include <QStandardPaths>
 #include <QUuid>
 #include <QDir>
+#include <QFile>
 
 #include <gtest/gtest.h>
 
@@ -81,3 +82,26 @@ TEST_F(TestIteratorSearcher, tst_tryNotify) {
 TEST_F(TestIteratorSearcher, tst_doSearch) {
     EXPECT_NO_FATAL_FAILURE(search->doSearch());
 }
+
+TEST_F(TestIteratorSearcher, tst_parallelSearch) {
+    QDir dir(filePath);
+    ASSERT_TRUE(dir.mkpath("a/b/c"));
+    ASSERT_TRUE(dir.mkpath("d/.hidden"));
+    for (const QString &name : { "a/report.txt", "a/b/c/report.log", "d/other.txt", "d/.hidden/report.txt" }) {
+        QFile file(dir.filePath(name));
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    }
+    // 指向上级目录的链接不会导致重复遍历
+    QFile::link(filePath, dir.filePath("a/b/loop"));
+
+    IteratorSearcher searcher(DUrl::fromLocalFile(filePath), "report");
+    EXPECT_TRUE(searcher.search());
+
+    QList<DUrl> results = searcher.takeAll();
+    EXPECT_EQ(2, results.count());
+    EXPECT_TRUE(results.contains(DUrl::fromLocalFile(dir.filePath("a/report.txt"))));
+    EXPECT_TRUE(results.contains(DUrl::fromLocalFile(dir.filePath("a/b/c/report.log"))));
+
+    QDir(dir.filePath("a")).removeRecursively();
+    QDir(dir.filePath("d")).removeRecursively();
+}
@@ -0,0 +1,60 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include "utils/keywordmatcher.h"
+
+namespace {
+bool matchBytes(const KeywordMatcher &matcher, const QByteArray &name)
+{
+    return matcher.matches(name.constData(), name.size());
+}
+}
+
+TEST(KeywordMatcherTest, literal)
+{
+    const KeywordMatcher matcher("Report");
+
+    EXPECT_TRUE(matcher.isLiteral());
+    EXPECT_TRUE(matchBytes(matcher, "report.txt"));
+    EXPECT_TRUE(matchBytes(matcher, "MY-REPORT"));
+    EXPECT_TRUE(matchBytes(matcher, "a very long file name that puts the keyword rEpOrT past the first blocks.doc"));
+    EXPECT_FALSE(matchBytes(matcher, "repor"));
+    EXPECT_FALSE(matchBytes(matcher, "a very long file name without the keyword anywhere in it.doc"));
+    EXPECT_TRUE(matcher.matches(QString("Annual REPORT")));
+    EXPECT_FALSE(matcher.matches(QString("Annual")));
+
+    const KeywordMatcher single("x");
+    EXPECT_TRUE(matchBytes(single, "0123456789abcdefghijklmnopqrstuvwX"));
+    EXPECT_FALSE(matchBytes(single, "0123456789abcdefghijklmnopqrstuvw"));
+
+    const KeywordMatcher chinese("文档");
+    EXPECT_TRUE(chinese.isLiteral());
+    EXPECT_TRUE(matchBytes(chinese, QString("我的文档.txt").toUtf8()));
+    EXPECT_FALSE(matchBytes(chinese, QString("我的文件.txt").toUtf8()));
+}
+
+TEST(KeywordMatcherTest, pattern)
+{
+    const KeywordMatcher wildcard("a*.txt");
+    EXPECT_FALSE(wildcard.isLiteral());
+    EXPECT_TRUE(matchBytes(wildcard, "abc.txt"));
+    EXPECT_FALSE(matchBytes(wildcard, "abc.doc"));
+
+    // 有大小写之分的非 ASCII 字符使用正则表达式
+    const KeywordMatcher greek(QString::fromUtf8("Σ"));
+    EXPECT_FALSE(greek.isLiteral());
+    EXPECT_TRUE(matchBytes(greek, QString::fromUtf8("aσb").toUtf8()));
+}
+
+TEST(KeywordMatcherTest, indexOfLiteral)
+{
+    const QByteArray data("0123456789ABCDEFabcdef-needle-NEEDLE");
+
+    EXPECT_EQ(23, KeywordMatcher::indexOfLiteral(data.constData(), data.size(), "needle"));
+    EXPECT_EQ(10, KeywordMatcher::indexOfLiteral(data.constData(), data.size(), "abc"));
+    EXPECT_EQ(-1, KeywordMatcher::indexOfLiteral(data.constData(), data.size(), "needles"));
+    EXPECT_EQ(0, KeywordMatcher::indexOfLiteral(data.constData(), data.size(), ""));
+}
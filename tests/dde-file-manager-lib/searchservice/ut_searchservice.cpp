@@ -11,6 +11,9 @@
 #include <QUuid>
 #include <QStandardPaths>
 #include <QDir>
+#include <QTimer>
+
+#include "dfmapplication.h"
 
 #include <gtest/gtest.h>
 
@@ -79,3 +82,59 @@ TEST_F(TestSearchService, tst_matchedResults) {
 TEST_F(TestSearchService, tst_createFullTextIndex) {
     EXPECT_NO_FATAL_FAILURE(searchServ->createFullTextIndex());
 }
+
+TEST_F(TestSearchService, tst_addChangedFile) {
+    stub_ext::StubExt st;
+    st.set_lamda(ADDR(DFMApplication, genericAttribute), [](DFMApplication::GenericAttribute ga) {
+        Q_UNUSED(ga);
+        return QVariant(true);
+    });
+
+    MainController controller;
+    controller.addChangedFile(DUrl::fromLocalFile(filePath + "/a.txt"));
+    controller.addChangedFile(DUrl::fromLocalFile(filePath + "/a.txt"));
+    // 非本地文件不在全文索引中
+    controller.addChangedFile(DUrl::fromTrashFile("/a.txt"));
+    controller.onFileChanged(filePath, "b.txt");
+
+    EXPECT_EQ(2, controller.changedFiles.count());
+    EXPECT_TRUE(controller.changedFiles.contains(filePath + "/b.txt"));
+    EXPECT_TRUE(controller.indexUpdateTimer->isActive());
+}
+
+TEST_F(TestSearchService, tst_refineResults) {
+    MainController controller;
+    const DUrl &root = DUrl::fromLocalFile(filePath);
+    const DUrl &report = DUrl::fromLocalFile(filePath + "/report.txt");
+    const DUrl &repair = DUrl::fromLocalFile(filePath + "/repair.txt");
+
+    EXPECT_TRUE(controller.refineResults(root, "rep").isEmpty());
+    controller.searchSessions[root].results << report << repair << DUrl::fromLocalFile(filePath + "/rep.desktop");
+
+    // 关键字变长时从上一次的结果中过滤
+    QList<DUrl> results = controller.refineResults(root, "repo");
+    ASSERT_EQ(1, results.count());
+    EXPECT_EQ(report, results.first());
+
+    // 关键字变短或带通配符时重新搜索
+    EXPECT_TRUE(controller.refineResults(root, "re").isEmpty());
+    controller.searchSessions[root].results << report;
+    EXPECT_TRUE(controller.refineResults(root, "re*t").isEmpty());
+}
+
+TEST_F(TestSearchService, tst_indexMaintainer) {
+    MainController controller;
+
+    // 其它进程维护索引时不监听文件变化
+    if (!controller.isIndexMaintainer()) {
+        EXPECT_FALSE(controller.isWatchingChanges);
+        EXPECT_TRUE(controller.indexMaintainerTimer->isActive());
+        return;
+    }
+
+    // 同一进程中的 MainController 共用维护索引的锁
+    MainController other;
+    EXPECT_TRUE(other.isIndexMaintainer());
+    EXPECT_TRUE(other.isWatchingChanges);
+    EXPECT_FALSE(other.indexMaintainerTimer->isActive());
+}
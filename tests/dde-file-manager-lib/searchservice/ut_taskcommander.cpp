@@ -0,0 +1,25 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#define private public
+#include "maincontroller/task/taskcommander_p.h"
+#undef private
+
+TEST(TestTaskCommander, tst_rankResults) {
+    const DUrl &other = DUrl::fromLocalFile("/tmp/a/my-report.txt");
+    const DUrl &prefix = DUrl::fromLocalFile("/tmp/report-2022.txt");
+    const DUrl &deepExact = DUrl::fromLocalFile("/tmp/a/b/report.txt");
+    const DUrl &exact = DUrl::fromLocalFile("/tmp/a/Report");
+
+    QList<DUrl> results = TaskCommanderPrivate::rankResults({ other, prefix, deepExact, exact }, "report", 10);
+    EXPECT_EQ(QList<DUrl>({ exact, deepExact, prefix, other }), results);
+
+    // 只保留最靠前的结果
+    results = TaskCommanderPrivate::rankResults({ other, prefix, deepExact, exact }, "report", 2);
+    EXPECT_EQ(QList<DUrl>({ exact, deepExact }), results);
+
+    EXPECT_TRUE(TaskCommanderPrivate::rankResults({ other }, "report", 0).isEmpty());
+}
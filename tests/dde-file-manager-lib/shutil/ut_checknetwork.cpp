@@ -6,6 +6,7 @@
 
 #include "shutil/checknetwork.h"
 #include <QSharedPointer>
+#include <QTcpServer>
 #include "testhelper.h"
 
 namespace  {
@@ -31,3 +32,25 @@ TEST_F(TestCheckNetwork,can_isHostAndPortConnect){
 //    EXPECT_FALSE(check->isHostAndPortConnect("10.8.40.125","20"));
 
 }
+
+TEST_F(TestCheckNetwork, isHostAndPortConnect_cached)
+{
+    QTcpServer server;
+    ASSERT_TRUE(server.listen(QHostAddress::LocalHost));
+    const QString port = QString::number(server.serverPort());
+
+    EXPECT_TRUE(check->isHostAndPortConnect("127.0.0.1", port));
+    server.close();
+    // 有效期内使用缓存的结果
+    EXPECT_TRUE(check->isHostAndPortConnect("127.0.0.1", port));
+
+    QTcpServer closedServer;
+    ASSERT_TRUE(closedServer.listen(QHostAddress::LocalHost));
+    const quint16 closedPort = closedServer.serverPort();
+    closedServer.close();
+
+    EXPECT_FALSE(check->isHostAndPortConnect("127.0.0.1", QString::number(closedPort)));
+    // 连接不上的结果同样被缓存
+    if (closedServer.listen(QHostAddress::LocalHost, closedPort))
+        EXPECT_FALSE(check->isHostAndPortConnect("127.0.0.1", QString::number(closedPort)));
+}
@@ -9,6 +9,7 @@
 
 #include <memory>
 #include <QDir>
+#include <QFile>
 #include <QDebug>
 
 namespace  {
@@ -59,3 +60,26 @@ TEST_F(TestDesktopFile, can_parse_the_desktop_trash)
     EXPECT_TRUE(!trashfile.getDisplayName().isEmpty());
     EXPECT_FALSE(trashfile.getNoShow());
 }
+
+TEST_F(TestDesktopFile, reparse_when_file_changed)
+{
+    const QString desktop_test_file = QDir::tempPath() + "/ut_desktopfile_cache.desktop";
+    auto writeFile = [&desktop_test_file](const QByteArray &exec) {
+        QFile file(desktop_test_file);
+        file.open(QIODevice::WriteOnly | QIODevice::Truncate);
+        file.write("[Desktop Entry]\nType=Application\nName=test\nExec=" + exec + "\n");
+    };
+
+    writeFile("test-a");
+    EXPECT_EQ("test-a", DesktopFile(desktop_test_file).getExec());
+    // 第二次从缓存中读取
+    EXPECT_EQ("test-a", DesktopFile(desktop_test_file).getExec());
+    EXPECT_EQ(desktop_test_file, DesktopFile(desktop_test_file).getFileName());
+
+    // 文件大小变化后重新解析
+    writeFile("test-bb");
+    EXPECT_EQ("test-bb", DesktopFile(desktop_test_file).getExec());
+
+    QFile::remove(desktop_test_file);
+    EXPECT_TRUE(DesktopFile(desktop_test_file).getExec().isEmpty());
+}
@@ -0,0 +1,36 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "shutil/dfmdragurls.h"
+
+#include <gtest/gtest.h>
+
+#include <QSharedMemory>
+
+TEST(TestDFMDragUrls, write_and_read)
+{
+    const QString key("ut_dfmdragurls");
+    QList<QUrl> urls;
+    for (int i = 0; i < 1000; ++i)
+        urls << QUrl::fromLocalFile(QString("/tmp/测试 %1%25.txt").arg(i));
+    urls << QUrl("trash:///a");
+
+    QSharedMemory sm;
+    sm.setKey(key);
+    ASSERT_TRUE(DFMDragUrls::write(&sm, urls));
+
+    QList<QUrl> read;
+    EXPECT_TRUE(DFMDragUrls::read(key, read));
+    EXPECT_EQ(urls, read);
+
+    // 内容无效时不修改传入的 url
+    sm.lock();
+    memset(sm.data(), 0, static_cast<size_t>(sm.size()));
+    sm.unlock();
+    EXPECT_FALSE(DFMDragUrls::read(key, read));
+    EXPECT_EQ(urls, read);
+
+    sm.detach();
+    EXPECT_FALSE(DFMDragUrls::read(key, read));
+}
@@ -0,0 +1,139 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "shutil/dfmembeddedpreview.h"
+
+#include <gtest/gtest.h>
+
+#include <QBuffer>
+#include <QDataStream>
+#include <QTemporaryDir>
+
+namespace  {
+    class TestDFMEmbeddedPreview : public testing::Test {
+    public:
+        void SetUp() override
+        {
+            ASSERT_TRUE(tempDir.isValid());
+        }
+        void TearDown() override
+        {
+        }
+
+        static QByteArray jpegData(const QSize &size)
+        {
+            QImage image(size, QImage::Format_RGB32);
+            image.fill(Qt::red);
+
+            QByteArray data;
+            QBuffer buffer(&data);
+            buffer.open(QIODevice::WriteOnly);
+            image.save(&buffer, "jpeg");
+
+            return data;
+        }
+
+        // 生成只有一个 IFD 的 TIFF 数据，IFD 中记录内嵌的 JPEG 及图片方向
+        static QByteArray tiffData(const QByteArray &jpeg, QDataStream::ByteOrder byteOrder, quint16 orientation, bool emptyFirstIfd)
+        {
+            QByteArray data;
+            QDataStream stream(&data, QIODevice::WriteOnly);
+            stream.setByteOrder(byteOrder);
+
+            stream.writeRawData(byteOrder == QDataStream::LittleEndian ? "II" : "MM", 2);
+            stream << quint16(42) << quint32(8);
+
+            quint32 offset = 8;
+
+            if (emptyFirstIfd) {
+                stream << quint16(0) << quint32(offset + 6);
+                offset += 6;
+            }
+
+            const quint32 jpegOffset = offset + 2 + 3 * 12 + 4;
+
+            stream << quint16(3);
+            stream << quint16(0x0112) << quint16(3) << quint32(1) << orientation << quint16(0);
+            stream << quint16(0x0201) << quint16(4) << quint32(1) << jpegOffset;
+            stream << quint16(0x0202) << quint16(4) << quint32(1) << quint32(jpeg.size());
+            stream << quint32(0);
+            stream.writeRawData(jpeg.constData(), jpeg.size());
+
+            return data;
+        }
+
+        QString writeFile(const QString &name, const QByteArray &data)
+        {
+            const QString &path = tempDir.filePath(name);
+            QFile file(path);
+
+            if (file.open(QIODevice::WriteOnly))
+                file.write(data);
+
+            return path;
+        }
+
+        QTemporaryDir tempDir;
+    };
+}
+
+TEST_F(TestDFMEmbeddedPreview, raw_image_type)
+{
+    EXPECT_TRUE(DFMEmbeddedPreview::isRawImage("image/x-nikon-nef"));
+    EXPECT_TRUE(DFMEmbeddedPreview::isRawImage("image/x-adobe-dng"));
+    EXPECT_FALSE(DFMEmbeddedPreview::isRawImage("image/jpeg"));
+    EXPECT_FALSE(DFMEmbeddedPreview::isRawImage("image/tiff"));
+}
+
+TEST_F(TestDFMEmbeddedPreview, raw_preview_with_orientation)
+{
+    const QString &path = writeFile("test.nef", tiffData(jpegData(QSize(600, 400)), QDataStream::LittleEndian, 6, false));
+
+    QImage image;
+    ASSERT_TRUE(DFMEmbeddedPreview::loadPreview(path, "image/x-nikon-nef", 256, &image));
+    // 方向为6时需顺时针旋转90度
+    EXPECT_EQ(image.height(), 256);
+    EXPECT_LT(image.width(), image.height());
+}
+
+TEST_F(TestDFMEmbeddedPreview, raw_preview_max_read_bytes)
+{
+    const QByteArray &jpeg = jpegData(QSize(600, 400));
+    const QString &path = writeFile("test.nef", tiffData(jpeg, QDataStream::LittleEndian, 1, false));
+
+    QImage image;
+    // 预览图超出读取上限时不读取
+    EXPECT_FALSE(DFMEmbeddedPreview::loadPreview(path, "image/x-nikon-nef", 256, &image, jpeg.size() - 1));
+    EXPECT_TRUE(DFMEmbeddedPreview::loadPreview(path, "image/x-nikon-nef", 256, &image, jpeg.size()));
+}
+
+TEST_F(TestDFMEmbeddedPreview, exif_thumbnail)
+{
+    const QByteArray &tiff = tiffData(jpegData(QSize(300, 200)), QDataStream::BigEndian, 1, true);
+    QByteArray app1("\xff\xe1", 2);
+    const quint16 length = static_cast<quint16>(2 + 6 + tiff.size());
+    app1.append(char(length >> 8)).append(char(length & 0xff));
+    app1.append("Exif\0\0", 6).append(tiff);
+
+    QByteArray jpeg = jpegData(QSize(600, 400));
+    jpeg.insert(2, app1);
+    const QString &path = writeFile("test.jpg", jpeg);
+
+    QImage image;
+    ASSERT_TRUE(DFMEmbeddedPreview::loadPreview(path, "image/jpeg", 256, &image));
+    EXPECT_EQ(image.width(), 256);
+
+    // 缩略图小于需要的尺寸时解码原图
+    EXPECT_FALSE(DFMEmbeddedPreview::loadPreview(path, "image/jpeg", 512, &image));
+}
+
+TEST_F(TestDFMEmbeddedPreview, no_preview)
+{
+    const QString &path = writeFile("plain.jpg", jpegData(QSize(600, 400)));
+
+    QImage image;
+    EXPECT_FALSE(DFMEmbeddedPreview::loadPreview(path, "image/jpeg", 256, &image));
+    EXPECT_FALSE(DFMEmbeddedPreview::loadPreview(path, "image/png", 256, &image));
+    EXPECT_TRUE(image.isNull());
+}
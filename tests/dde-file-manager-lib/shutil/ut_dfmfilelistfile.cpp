@@ -11,6 +11,8 @@
 #include <gmock/gmock-matchers.h>
 
 #include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
 #include <memory>
 
 namespace  {
@@ -108,3 +110,35 @@ TEST_F(TestDFMFileListFile, load_file_with_mtp)
 
     EXPECT_FALSE(nofile.reload());
 }
+
+TEST_F(TestDFMFileListFile, reuse_parsed_file_until_changed)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    QFile file(dir.path() + "/.hidden");
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write("a.txt\nb.txt\n");
+    file.close();
+
+    DFMFileListFile first(dir.path());
+    EXPECT_TRUE(first.contains("a.txt"));
+    EXPECT_TRUE(first.contains("b.txt"));
+
+    first.insert("c.txt");
+    EXPECT_TRUE(first.save());
+
+    DFMFileListFile second(dir.path());
+    EXPECT_TRUE(second.contains("c.txt"));
+    EXPECT_EQ(3, second.getHiddenFiles().count());
+
+    // 其他进程修改文件后通过文件监控丢弃缓存
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write("d.txt\n");
+    file.close();
+    DFMFileListFile::invalidate(dir.path());
+
+    DFMFileListFile third(dir.path());
+    EXPECT_TRUE(third.contains("d.txt"));
+    EXPECT_FALSE(third.contains("a.txt"));
+}
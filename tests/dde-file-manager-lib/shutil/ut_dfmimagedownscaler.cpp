@@ -0,0 +1,47 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "shutil/dfmimagedownscaler.h"
+
+#include <gtest/gtest.h>
+
+#include <QColor>
+
+TEST(DFMImageDownscalerTest, halveAveragesPixels)
+{
+    // 宽度覆盖 SIMD 和逐像素两段处理
+    QImage image(22, 4, QImage::Format_RGB32);
+    for (int y = 0; y < image.height(); ++y) {
+        for (int x = 0; x < image.width(); ++x)
+            image.setPixel(x, y, (x + y) % 2 ? qRgb(200, 100, 0) : qRgb(100, 50, 200));
+    }
+
+    const QImage &half = DFMImageDownscaler::halve(image);
+
+    ASSERT_EQ(QSize(11, 2), half.size());
+    for (int y = 0; y < half.height(); ++y) {
+        for (int x = 0; x < half.width(); ++x) {
+            const QRgb pixel = half.pixel(x, y);
+            EXPECT_NEAR(150, qRed(pixel), 1);
+            EXPECT_NEAR(75, qGreen(pixel), 1);
+            EXPECT_NEAR(100, qBlue(pixel), 1);
+        }
+    }
+}
+
+TEST(DFMImageDownscalerTest, downscaleKeepsAspectRatio)
+{
+    QImage image(1000, 600, QImage::Format_ARGB32);
+    image.fill(QColor(10, 20, 30, 128));
+
+    const QImage &result = DFMImageDownscaler::downscale(image, 128);
+
+    EXPECT_EQ(QSize(128, 76), result.size());
+    const QColor color = QColor::fromRgba(result.convertToFormat(QImage::Format_ARGB32).pixel(60, 40));
+    EXPECT_NEAR(128, color.alpha(), 2);
+    EXPECT_NEAR(10, color.red(), 2);
+
+    // 不需要缩小时返回原图
+    EXPECT_EQ(QSize(100, 60), DFMImageDownscaler::downscale(image.scaled(100, 60), 128).size());
+}
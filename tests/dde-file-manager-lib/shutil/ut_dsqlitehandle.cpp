@@ -264,3 +264,75 @@ TEST_F(TestDSqliteHandle, test_before_tag_files)
     st.set_lamda(&QSqlQuery::next, []{return true;});
     EXPECT_TRUE(m_pHandle->disposeClientData(filesAndTags, 11).toBool());
 }
+
+TEST_F(TestDSqliteHandle, test_tag_files_with_bound_values)
+{
+    ASSERT_NE(m_pHandle, nullptr);
+    m_pHandle->m_sqlDatabasePtr.reset(new QSqlDatabase{ QSqlDatabase::addDatabase("QSQLITE", "ut_bound_values") });
+    m_pHandle->m_sqlDatabasePtr->setDatabaseName(":memory:");
+    ASSERT_TRUE(m_pHandle->m_sqlDatabasePtr->open());
+
+    QSqlQuery query{ *m_pHandle->m_sqlDatabasePtr };
+    ASSERT_TRUE(query.exec("CREATE TABLE file_property (file_name TEXT NOT NULL UNIQUE, tag_1 TEXT NOT NULL, tag_2 TEXT, tag_3 TEXT)"));
+    ASSERT_TRUE(query.exec("CREATE TABLE tag_with_file (tag_name TEXT NOT NULL, file_name TEXT NOT NULL)"));
+
+    // 文件名中的引号作为参数绑定，不会破坏语句
+    const QString fileName{ "/ut_it's a file.txt" };
+    const QString newFileName{ "/ut_it's a new file.txt" };
+    QMap<QString, QList<QString>> fileWithTags;
+    fileWithTags[fileName] = QList<QString>{ "tag1", "tag2" };
+
+    EXPECT_TRUE((m_pHandle->helpExecSql<DSqliteHandle::SqlType::TagFiles2, QMap<QString, QList<QString>>, bool>(fileWithTags, "/")));
+    EXPECT_TRUE((m_pHandle->helpExecSql<DSqliteHandle::SqlType::TagFiles3, QList<QString>, bool>(QList<QString>{ fileName }, "/")));
+
+    ASSERT_TRUE(query.exec("SELECT tag_1, tag_2, tag_3 FROM file_property"));
+    ASSERT_TRUE(query.next());
+    EXPECT_EQ(QString("tag1"), query.value(0).toString());
+    EXPECT_EQ(QString("tag2"), query.value(1).toString());
+    EXPECT_TRUE(query.value(2).toString().isEmpty());
+
+    std::map<QString, QString> oldAndNewNames{ { fileName, newFileName } };
+    EXPECT_TRUE((m_pHandle->helpExecSql<DSqliteHandle::SqlType::ChangeFilesName, std::map<QString, QString>, bool>(oldAndNewNames, "/")));
+
+    std::map<QString, QString> newAndOldNames{ { newFileName, fileName } };
+    QMap<QString, QList<QString>> tagsOfNewFile{ m_pHandle->helpExecSql<DSqliteHandle::SqlType::ChangeFilesName2, std::map<QString, QString>,
+                                                 QMap<QString, QList<QString>>>(newAndOldNames, "/") };
+    EXPECT_EQ(2, tagsOfNewFile.value(newFileName).size());
+
+    QMap<QString, QList<QString>> forDecreasing;
+    forDecreasing[newFileName] = QList<QString>{ "tag1" };
+    EXPECT_TRUE((m_pHandle->helpExecSql<DSqliteHandle::SqlType::TagFiles, QMap<QString, QList<QString>>, bool>(forDecreasing, "/")));
+    EXPECT_TRUE((m_pHandle->helpExecSql<DSqliteHandle::SqlType::TagFiles3, QList<QString>, bool>(QList<QString>{ newFileName }, "/")));
+
+    ASSERT_TRUE(query.exec("SELECT tag_1 FROM file_property"));
+    ASSERT_TRUE(query.next());
+    EXPECT_EQ(QString("tag2"), query.value(0).toString());
+
+    query.clear();
+    m_pHandle->m_sqlDatabasePtr->close();
+    m_pHandle->m_sqlDatabasePtr.reset(nullptr);
+    QSqlDatabase::removeDatabase("ut_bound_values");
+}
+
+TEST_F(TestDSqliteHandle, test_open_database_in_wal_mode)
+{
+    ASSERT_NE(m_pHandle, nullptr);
+    m_pHandle->m_sqlDatabasePtr.reset(new QSqlDatabase{ QSqlDatabase::addDatabase("QSQLITE", "ut_wal_mode") });
+    m_pHandle->m_sqlDatabasePtr->setDatabaseName(m_dirPath + "/.__deepin.db");
+    ASSERT_TRUE(m_pHandle->openSqlDatabase());
+
+    QSqlQuery query{ *m_pHandle->m_sqlDatabasePtr };
+    ASSERT_TRUE(query.exec("PRAGMA journal_mode"));
+    ASSERT_TRUE(query.next());
+    EXPECT_EQ(QString("wal"), query.value(0).toString().toLower());
+
+    // synchronous = NORMAL
+    ASSERT_TRUE(query.exec("PRAGMA synchronous"));
+    ASSERT_TRUE(query.next());
+    EXPECT_EQ(1, query.value(0).toInt());
+
+    query.clear();
+    m_pHandle->closeSqlDatabase();
+    m_pHandle->m_sqlDatabasePtr.reset(nullptr);
+    QSqlDatabase::removeDatabase("ut_wal_mode");
+}
@@ -175,3 +175,32 @@ TEST_F(TestFileBatchProcess, batch_replase_exited_files)
         EXPECT_TRUE(beg.value().fileName().contains("new"));
     }
 }
+
+TEST_F(TestFileBatchProcess, batch_swap_file_names)
+{
+    FileUtils::removeRecurse(getTestFolder(), "");
+
+    const DUrl url1 = DUrl::fromLocalFile(createOneFile("swap1.txt"));
+    const DUrl url2 = DUrl::fromLocalFile(createOneFile("swap2.txt"));
+    QFile file(url1.toLocalFile());
+
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    file.write("swap1");
+    file.close();
+
+    QSharedMap<DUrl, DUrl> map{ new QMap<DUrl, DUrl>{} };
+    map->insert(url1, url2);
+    map->insert(url2, url1);
+
+    QMap<DUrl, DUrl> result = FileBatchProcess::instance()->batchProcessFile(map);
+
+    EXPECT_EQ(2, result.size());
+    EXPECT_EQ(url2, result.value(url1));
+
+    // 名称交换后 swap2.txt 是原来的 swap1.txt，目录中不留下临时文件
+    file.setFileName(url2.toLocalFile());
+    ASSERT_TRUE(file.open(QIODevice::ReadOnly));
+    EXPECT_EQ(QByteArray("swap1"), file.readAll());
+    file.close();
+    EXPECT_EQ(2, QDir(getTestFolder()).entryList(QDir::Files | QDir::Hidden).size());
+}
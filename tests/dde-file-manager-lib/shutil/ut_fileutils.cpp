@@ -615,3 +615,43 @@ TEST_F(TestFileUtils, test_isNetworkAncestorUrl) {
     dest.setPath("/run/user/1000/smb-share:server=127.0.0.1,share=share");
     EXPECT_FALSE(FileUtils::isNetworkAncestorUrl(dest, false, source, true));
 }
+
+TEST_F(TestFileUtils, test_openFiles_group_by_app)
+{
+    static int lookupCount = 0;
+    static QList<QPair<QString, QStringList>> launched;
+    lookupCount = 0;
+    launched.clear();
+
+    stub_ext::StubExt stu;
+    stu.set_lamda(&FileUtils::getFileMimetype, [](const QString &path) {
+        return path.endsWith(".png") ? QString("image/png") : QString("text/plain");
+    });
+    stu.set_lamda(&MimesAppsManager::getDefaultAppDesktopFileByMimeType, [](const QString &mimeType) {
+        ++lookupCount;
+        return mimeType == "image/png" ? QString("/usr/share/applications/viewer.desktop")
+                                       : QString("/usr/share/applications/editor.desktop");
+    });
+    stu.set_lamda(&FileUtils::isFileManagerSelf, []() { return false; });
+    stu.set_lamda(&FileUtils::addRecentFile, []() {});
+    stu.set_lamda(&FileUtils::launchApp, [](const QString &desktopFile, const QStringList &filePaths) {
+        launched << qMakePair(desktopFile, filePaths);
+        return true;
+    });
+
+    const QString &dir = getTestFolder();
+    QStringList files;
+    for (int i = 0; i < 10; ++i)
+        files << QString("%1/group_%2.png").arg(dir).arg(i);
+    files << dir + "/group.txt";
+
+    EXPECT_TRUE(FileUtils::openFiles(files));
+
+    // 每种 mimetype 只查询一次默认应用，每个应用只启动一次
+    EXPECT_EQ(2, lookupCount);
+    ASSERT_EQ(2, launched.count());
+    EXPECT_EQ(QString("/usr/share/applications/viewer.desktop"), launched.first().first);
+    EXPECT_EQ(10, launched.first().second.count());
+    EXPECT_EQ(QString("/usr/share/applications/editor.desktop"), launched.last().first);
+    EXPECT_EQ(1, launched.last().second.count());
+}
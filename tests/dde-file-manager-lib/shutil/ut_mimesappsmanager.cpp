@@ -124,6 +124,24 @@ TEST_F(TestMimesAppsManager, get_app_info_from_mimetype_func3)
     EXPECT_FALSE( MimesAppsManager::getDesktopObjs().isEmpty() );
 }
 
+TEST_F(TestMimesAppsManager, load_mime_apps_from_index)
+{
+    MimesAppsManager::initMimeTypeApps();
+    const QMap<QString, QStringList> mimeApps = MimesAppsManager::MimeApps;
+    const int desktopObjCount = MimesAppsManager::DesktopObjs.size();
+
+    EXPECT_FALSE( MimesAppsManager::getMimeAppsIndexFile().isEmpty() );
+
+    // 第二次从索引缓存中读取，结果应与解析 desktop 文件的一致
+    MimesAppsManager::initMimeTypeApps();
+    EXPECT_EQ( desktopObjCount, MimesAppsManager::DesktopObjs.size() );
+    EXPECT_EQ( mimeApps.keys(), MimesAppsManager::MimeApps.keys() );
+
+    if (desktopObjCount > 0) {
+        EXPECT_TRUE( QFile::exists(MimesAppsManager::getMimeAppsIndexFile()) );
+    }
+}
+
 TEST_F(TestMimesAppsManager, get_app_manager_worker_object)
 {
 //    MimesAppsManager* appsManager = new MimesAppsManager();
@@ -103,6 +103,32 @@ TEST_F(TestTagManager, can_make_files_tags)
     EXPECT_TRUE(m_pManager->makeFilesTags(tags, files));
 }
 
+TEST_F(TestTagManager, can_make_tags_of_each_file)
+{
+    ASSERT_NE(m_pManager, nullptr);
+
+    QMap<DUrl, QStringList> files_and_tags {
+        { DUrl::fromLocalFile(tempDirPath_A), { TAG_NAME_A, TAG_NAME_B } },
+        { DUrl::fromLocalFile(tempDirPath_B), { TAG_NAME_B } }
+    };
+
+    // 创建标记一次，设置全部文件的标记一次
+    QList<Tag::ActionType> requests;
+    QVariantMap tagged;
+    StubExt stExt;
+    stExt.set_lamda(&TagManagerDaemonController::disposeClientData, [&](void *, const QVariantMap &data, Tag::ActionType type) {
+        requests << type;
+        if (type == Tag::ActionType::MakeTagsOfEachFile)
+            tagged = data;
+        return QVariant(true);
+    });
+
+    EXPECT_TRUE(m_pManager->makeTagsOfEachFile(files_and_tags));
+    EXPECT_EQ(QList<Tag::ActionType>({ Tag::ActionType::BeforeMakeFilesTags, Tag::ActionType::MakeTagsOfEachFile }), requests);
+    EXPECT_EQ(QStringList({ TAG_NAME_B }), tagged.value(tempDirPath_B).toStringList());
+    EXPECT_TRUE(m_pManager->makeTagsOfEachFile({}));
+}
+
 TEST_F(TestTagManager, can_getALLTags)
 {
     ASSERT_NE(m_pManager, nullptr);
@@ -123,6 +149,27 @@ TEST_F(TestTagManager, can_getTagsThroughFiles)
     EXPECT_TRUE(!m_pManager->getTagsThroughFiles(files).isEmpty());
 }
 
+TEST_F(TestTagManager, can_getTagsOfEachFile)
+{
+    ASSERT_NE(m_pManager, nullptr);
+
+    DUrlList files { DUrl::fromLocalFile(tempDirPath_A), DUrl::fromLocalFile(tempDirPath_B) };
+    StubExt stExt;
+    stExt.set_lamda(&TagManagerDaemonController::disposeClientData, [&]{
+        return QVariant(QMap<QString, QVariant>({{tempDirPath_A, QVariant(QStringList({TAG_NAME_A, TAG_NAME_B}))},
+                                                 {tempDirPath_B, QVariant(QStringList())}}));
+    });
+
+    const QMap<DUrl, QStringList> &fileTags = m_pManager->getTagsOfEachFile(files);
+    EXPECT_EQ(2, fileTags.size());
+    EXPECT_EQ(QStringList({TAG_NAME_A, TAG_NAME_B}), fileTags.value(files.first()));
+    EXPECT_TRUE(fileTags.value(files.last()).isEmpty());
+
+    // 不支持批量查询时逐个获取
+    stExt.set_lamda(&TagManagerDaemonController::disposeClientData, []{ return QVariant(QStringList({TAG_NAME_A})); });
+    EXPECT_EQ(QStringList({TAG_NAME_A}), m_pManager->getTagsOfEachFile(files).value(files.last()));
+}
+
 TEST_F(TestTagManager, can_getTagColor)
 {
     ASSERT_NE(m_pManager, nullptr);
@@ -258,6 +305,43 @@ TEST_F(TestTagManager, can_delete_tags)
     EXPECT_TRUE(m_pManager->deleteTags(tags));
 }
 
+TEST_F(TestTagManager, can_query_tag_index)
+{
+    ASSERT_NE(m_pManager, nullptr);
+
+    m_pManager->tagIndex.tagColors = { {TAG_NAME_A, "Red"}, {TAG_NAME_B, "Orange"} };
+    m_pManager->tagIndex.addTags(tempDirPath_A, { TAG_NAME_A, TAG_NAME_B });
+    m_pManager->tagIndex.addTags(tempDirPath_B, { TAG_NAME_B });
+    m_pManager->tagIndexState = TagManager::IndexState::Loaded;
+
+    // 索引可用时不请求服务
+    bool requested = false;
+    StubExt stExt;
+    stExt.set_lamda(&TagManagerDaemonController::disposeClientData, [&]{ requested = true; return QVariant(); });
+
+    const QMap<DUrl, QStringList> &file_and_tags = m_pManager->getTagsOfEachFile({ DUrl::fromLocalFile(tempDirPath_A), DUrl::fromLocalFile(tempDirPath_B) });
+    EXPECT_EQ(QStringList({ TAG_NAME_A, TAG_NAME_B }), file_and_tags.value(DUrl::fromLocalFile(tempDirPath_A)));
+    EXPECT_EQ(QStringList({ TAG_NAME_B }), file_and_tags.value(DUrl::fromLocalFile(tempDirPath_B)));
+    EXPECT_EQ(2, m_pManager->getFilesThroughTag(TAG_NAME_B).size());
+    EXPECT_EQ(QColor("#ffa503"), m_pManager->getTagColor({ TAG_NAME_B }).value(TAG_NAME_B));
+
+    // 服务的信号增量更新索引
+    emit TagManagerDaemonController::instance()->untagFiles({ {tempDirPath_A, QVariant(QStringList({ TAG_NAME_A }))} });
+    EXPECT_EQ(QStringList({ TAG_NAME_B }), m_pManager->getTagsThroughFiles({ DUrl::fromLocalFile(tempDirPath_A) }));
+
+    emit TagManagerDaemonController::instance()->changeTagName({ {TAG_NAME_B, QVariant(TAG_NAME_A_NEW)} });
+    EXPECT_EQ(QStringList({ TAG_NAME_A_NEW }), m_pManager->getTagsThroughFiles({ DUrl::fromLocalFile(tempDirPath_B) }));
+    EXPECT_TRUE(m_pManager->getFilesThroughTag(TAG_NAME_B).isEmpty());
+
+    emit TagManagerDaemonController::instance()->deleteTags(QVariant(QStringList({ TAG_NAME_A_NEW })));
+    EXPECT_TRUE(m_pManager->getTagsThroughFiles({ DUrl::fromLocalFile(tempDirPath_B) }).isEmpty());
+    EXPECT_FALSE(requested);
+
+    // 相对路径无法对应到索引中的文件，重新加载
+    emit TagManagerDaemonController::instance()->filesWereTagged({ {"a/b", QVariant(QStringList({ TAG_NAME_A }))} });
+    EXPECT_EQ(TagManager::IndexState::Dirty, m_pManager->tagIndexState);
+}
+
 TEST_F(TestTagManager, test_wind_up)
 {
     QProcess::execute("rm " + tempTxtFilePath);
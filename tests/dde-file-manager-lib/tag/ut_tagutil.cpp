@@ -5,6 +5,7 @@
 #include <gtest/gtest.h>
 
 #include <QDebug>
+#include <QTemporaryFile>
 
 #include "tag/tagutil.h"
 
@@ -43,3 +44,22 @@ TEST_F(TestTagUtil, test_en_skim)
     EXPECT_EQ(escaping_en_skim(emptyStr), emptyStr);
     EXPECT_EQ(restore_escaped_en_skim(emptyStr), emptyStr);
 }
+
+TEST_F(TestTagUtil, test_tags_in_xattr)
+{
+    QTemporaryFile file;
+    ASSERT_TRUE(file.open());
+
+    QStringList tags;
+    EXPECT_FALSE(readTagsFromXattr(file.fileName(), tags));
+
+    // 临时目录所在的文件系统可能不支持 user 扩展属性
+    if (!writeTagsToXattr(file.fileName(), { "Red", "工作" }))
+        return;
+
+    EXPECT_TRUE(readTagsFromXattr(file.fileName(), tags));
+    EXPECT_EQ(QStringList({ "Red", "工作" }), tags);
+
+    EXPECT_TRUE(writeTagsToXattr(file.fileName(), {}));
+    EXPECT_FALSE(readTagsFromXattr(file.fileName(), tags));
+}
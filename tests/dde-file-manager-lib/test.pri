@@ -30,7 +30,10 @@ SOURCES += \
     $$PWD/shutil/ut_danythingmonitorfilter.cpp \
     $$PWD/shutil/ut_desktopfile.cpp \
     $$PWD/shutil/ut_dfmfilelistfile.cpp \
+    $$PWD/shutil/ut_dfmdragurls.cpp \
     $$PWD/shutil/ut_dfmregularexpression.cpp \
+    $$PWD/shutil/ut_dfmembeddedpreview.cpp \
+    $$PWD/shutil/ut_dfmimagedownscaler.cpp \
     $$PWD/controllers/ut_appcontroller.cpp \
     $$PWD/io/ut_dlocalfilehandler.cpp \
     $$PWD/log/ut_dfmlogmanager.cpp \
@@ -69,6 +72,7 @@ SOURCES += \
     $$PWD/models/ut_tagfileinfo.cpp \
     $$PWD/models/ut_trashfileinfo.cpp \
     $$PWD/mediainfo/ut_dfmmediainfo.cpp \
+    $$PWD/mediainfo/ut_dfmmediainfocache.cpp \
     $$PWD/views/ut_dfmvaultretrievepassword.cpp \
     $$PWD/views/ut_dfmvaultactivesavekeyfileview.cpp \
     $$PWD/models/ut_dfmappentryfileinfo.cpp \
@@ -92,6 +96,10 @@ SOURCES += \
 SOURCES += \
     $$PWD/io/ut_dfilestatisticsjob.cpp \
     $$PWD/io/ut_dstorageinfo.cpp \
+    $$PWD/io/ut_dmounttable.cpp \
+    $$PWD/io/ut_ddeviceaccessscheduler.cpp \
+    $$PWD/io/ut_dstorageusagecache.cpp \
+    $$PWD/io/ut_djobprogresschannel.cpp \
     $$PWD/io/ut_dfileiodeviceproxy.cpp
 
 isEqual(ARCH, x86_64) {
@@ -139,6 +147,7 @@ SOURCES += \
     ###
     $$PWD/plugins/ut_dfmadditionalmenu.cpp \
     $$PWD/plugins/ut_pluginmanager.cpp \
+    $$PWD/plugins/ut_pluginemblemmanager.cpp \
     #$$PWD/controllers/ut_searchcontroller.cpp \
     $$PWD/sw_label/ut_llsdeepinlabellibrary_test.cpp \
     $$PWD/sw_label/ut_filemanagerlibrary_test.cpp \
@@ -207,6 +216,7 @@ SOURCES += \
     $$PWD/controllers/ut_dfmusersharecrumbcontroller.cpp \
     $$PWD/interfaces/ut_dfmsidebarmanager.cpp \
     $$PWD/interfaces/ut_dthumbnailprovider.cpp \
+    $$PWD/interfaces/ut_dthumbnailindex.cpp \
     $$PWD/interfaces/ut_dfmcrumbmanager.cpp \
     $$PWD/interfaces/ut_dfmevent.cpp \
     $$PWD/interfaces/ut_dfmstandardpaths.cpp \
@@ -232,6 +242,8 @@ SOURCES += \
     $$PWD/controllers/ut_networkcontroller.cpp \
     $$PWD/controllers/ut_dfmtrashcrumbcontroller.cpp \
     $$PWD/interfaces/ut_dfileproxywatcher.cpp \
+    $$PWD/interfaces/ut_dfilesystemwatcher.cpp \
+    $$PWD/interfaces/ut_dfanotifywatcher.cpp \
     $$PWD/interfaces/ut_dfmsidebariteminterface.cpp \
     #$$PWD/interfaces/ut_dfmstyleditemdelegate.cpp\
     $$PWD/interfaces/ut_dfmapplication.cpp
@@ -283,6 +295,18 @@ SOURCES += \
     $$PWD/interfaces/ut_dfilesystemmodel.cpp
 }
 
+SOURCES += \
+    $$PWD/interfaces/ut_dfmdirsnapshotcache.cpp \
+    $$PWD/interfaces/ut_dfmpathkey.cpp \
+    $$PWD/interfaces/ut_dfmtrace.cpp \
+    $$PWD/interfaces/ut_dfmmetrics.cpp \
+    $$PWD/interfaces/ut_dfmstartupprofile.cpp \
+    $$PWD/interfaces/ut_dfmmemoryaccounting.cpp \
+    $$PWD/interfaces/ut_dfmarchiveindex.cpp \
+    $$PWD/interfaces/ut_dfmtrashsummary.cpp \
+    $$PWD/interfaces/ut_dfmnamefiltermatcher.cpp \
+    $$PWD/interfaces/ut_dfmlistingcache.cpp
+
 SOURCES += \
     $$PWD/controllers/ut_pathmanager.cpp \
     # custom
@@ -315,7 +339,10 @@ SOURCES += \
     $$PWD/searchservice/ut_searchservice.cpp \
     $$PWD/searchservice/ut_fulltextsearcher.cpp \
     $$PWD/searchservice/ut_fsearch.cpp \
-    $$PWD/searchservice/ut_iteratorsearch.cpp
+    $$PWD/searchservice/ut_fsdatabasemanager.cpp \
+    $$PWD/searchservice/ut_iteratorsearch.cpp \
+    $$PWD/searchservice/ut_taskcommander.cpp \
+    $$PWD/searchservice/ut_keywordmatcher.cpp
 
 isEqual(ARCH, x86_64) {
 SOURCES += \
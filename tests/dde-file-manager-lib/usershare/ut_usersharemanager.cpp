@@ -387,3 +387,16 @@ TEST_F(UserShareManagerTest,can_readCacheFromFile){
     TestHelper::deleteTmpFile(url.toLocalFile());
     TestHelper::deleteTmpFile("/tmp/ut_share_manager");
 }
+
+TEST_F(UserShareManagerTest,can_parseUserShareFile){
+    const QString &path = TestHelper::createTmpFile();
+    UserShareManager::writeCacheToFile(path, "#VERSION 2\npath=/tmp/ut_share\n\nsharename=UT_Share\nusershare_acl=Everyone:R,\n");
+    const QMap<QString, QString> &info = UserShareManager::parseUserShareFile(path);
+    EXPECT_EQ(QString("/tmp/ut_share"), info.value("path"));
+    EXPECT_EQ(QString("UT_Share"), info.value("sharename"));
+    EXPECT_EQ(QString("Everyone:R,"), info.value("usershare_acl"));
+    EXPECT_FALSE(info.contains("#VERSION 2"));
+    TestHelper::deleteTmpFile(path);
+
+    EXPECT_TRUE(UserShareManager::parseUserShareFile(path).isEmpty());
+}
@@ -12,6 +12,7 @@
 #include <QFocusEvent>
 #include <QTimer>
 #include <QMimeData>
+#include <QSharedMemory>
 #include <QRect>
 #include <QScroller>
 #include <QActionGroup>
@@ -38,6 +39,8 @@
 #include "views/dfileview.h"
 #include "views/fileviewhelper.h"
 #include "interfaces/dlistitemdelegate.h"
+#include "interfaces/dfilesystemmodel.h"
+#include "shutil/dfmdragurls.h"
 #include "views/windowmanager.h"
 #include "dfmapplication.h"
 #include "dfmsettings.h"
@@ -485,6 +488,38 @@ TEST_F(DFileViewTest,get_visible_indexes)
     stub.reset(ADDR(DFileView, count));
 }
 
+TEST_F(DFileViewTest,get_icon_mode_selection)
+{
+    ASSERT_NE(nullptr,m_view);
+
+    Stub stub;
+    QSize (*ut_itemSizeHint)() = [](){return QSize(100, 100);};
+    stub.set(ADDR(DFileView, itemSizeHint), ut_itemSizeHint);
+    int (*ut_iconModeColumnCount)() = [](){return 10;};
+    stub.set(ADDR(DFileViewPrivate, iconModeColumnCount), ut_iconModeColumnCount);
+    static int myCount = 95;
+    int (*ut_count)() = [](){return myCount;};
+    stub.set(ADDR(DFileView, count), ut_count);
+
+    DFileViewPrivate *d = m_view->d_func();
+    // 每个格子宽高为110，框选区域只覆盖两列两行
+    EXPECT_EQ(2, d->iconModeSelection(QRect(50, 50, 110, 110)).count());
+    // 框选区域在项之间的空白处
+    EXPECT_TRUE(d->iconModeSelection(QRect(100, 100, 15, 15)).isEmpty());
+    // 覆盖整行时合并为一个区间
+    EXPECT_EQ(1, d->iconModeSelection(QRect(0, 0, 1100, 500)).count());
+    // 最后一行只有5个项
+    EXPECT_EQ(1, d->iconModeSelection(QRect(0, 990, 1100, 100)).count());
+    EXPECT_TRUE(d->iconModeSelection(QRect(600, 990, 300, 100)).isEmpty());
+
+    myCount = 0;
+    EXPECT_TRUE(d->iconModeSelection(QRect(0, 0, 1100, 500)).isEmpty());
+
+    stub.reset(ADDR(DFileView, itemSizeHint));
+    stub.reset(ADDR(DFileViewPrivate, iconModeColumnCount));
+    stub.reset(ADDR(DFileView, count));
+}
+
 TEST_F(DFileViewTest,get_item_size)
 {
     ASSERT_NE(nullptr,m_view);
@@ -2125,12 +2160,16 @@ TEST_F(DFileViewTest,fetch_drag_memory)
     bool result = m_view->fetchDragEventUrlsFromSharedMemory();
     EXPECT_FALSE(result);
 
-    myAttach = true;
-    result = m_view->fetchDragEventUrlsFromSharedMemory();
-    EXPECT_TRUE(result);
-
     stub.reset(ADDR(QSharedMemory, isAttached));
     stub.reset(ADDR(QSharedMemory, attach));
+
+    QSharedMemory sm;
+    sm.setKey(DRAG_EVENT_URLS);
+    const QList<QUrl> urls { QUrl::fromLocalFile("/tmp/a"), QUrl::fromLocalFile("/tmp/b") };
+    ASSERT_TRUE(DFMDragUrls::write(&sm, urls));
+    result = m_view->fetchDragEventUrlsFromSharedMemory();
+    EXPECT_TRUE(result);
+    EXPECT_EQ(urls, m_view->m_urlsForDragEvent);
 }
 
 TEST_F(SelectWorkTest,set_init_data)
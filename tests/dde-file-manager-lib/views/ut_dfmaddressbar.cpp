@@ -234,6 +234,31 @@ TEST_F(DFMAddressBarTest,append_complete_model)
     EXPECT_FALSE(isCallSetData);
 }
 
+TEST_F(DFMAddressBarTest,flush_complete_model)
+{
+    ASSERT_NE(nullptr,m_bar);
+
+    m_bar->clearCompleterModel();
+    m_bar->appendToCompleterModel(QStringList() << QString("test1") << QString() << QString("test2"));
+    // 合并前不修改模型
+    EXPECT_EQ(0, m_bar->completerModel.rowCount());
+    EXPECT_TRUE(m_bar->completionFlushTimer.isActive());
+
+    m_bar->flushCompleterModel();
+    EXPECT_EQ(QStringList() << QString("test1") << QString("test2"), m_bar->completerModel.stringList());
+    EXPECT_TRUE(m_bar->pendingCompletions.isEmpty());
+
+    QStringList stringList;
+    for (int i = 0; i < 2000; ++i)
+        stringList << QString::number(i);
+    m_bar->appendToCompleterModel(stringList);
+    m_bar->flushCompleterModel();
+    EXPECT_EQ(2000, m_bar->completerModel.rowCount());
+
+    m_bar->clearCompleterModel();
+    EXPECT_EQ(0, m_bar->completerModel.rowCount());
+}
+
 TEST_F(DFMAddressBarTest,tst_insert_completion)
 {
     ASSERT_NE(nullptr,m_bar);
@@ -49,6 +49,28 @@ TEST(Tab, set_file_view)
     EXPECT_TRUE(testView == temp.fileView());
     delete testView;
 }
+
+TEST(Tab, hibernate)
+{
+    DFileView *testView = new DFileView();
+    Tab temp(nullptr, nullptr);
+    const DUrlList selectedUrls {DUrl::fromLocalFile("/home/utTest/a.txt")};
+
+    temp.setCurrentUrl(DUrl::fromLocalFile("/home/utTest"));
+    EXPECT_FALSE(temp.isHibernated());
+
+    temp.hibernate(selectedUrls, 100);
+    EXPECT_TRUE(temp.isHibernated());
+    EXPECT_TRUE(selectedUrls == temp.hibernatedSelection());
+    EXPECT_EQ(100, temp.hibernatedScrollValue());
+    EXPECT_TRUE(DUrl::fromLocalFile("/home/utTest") == temp.currentUrl());
+
+    // 重新设置视图后不再是释放状态
+    temp.setFileView(testView);
+    EXPECT_FALSE(temp.isHibernated());
+    EXPECT_TRUE(temp.hibernatedSelection().isEmpty());
+    delete testView;
+}
 #endif
 
 TEST(Tab, current_url)
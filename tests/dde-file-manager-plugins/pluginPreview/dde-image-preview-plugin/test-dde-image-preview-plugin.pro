@@ -4,7 +4,7 @@
 #
 #-------------------------------------------------
 
-QT       += widgets   quick
+QT       += widgets   quick concurrent
 
 TARGET = test-dde-image-preview-plugin
 TEMPLATE = app
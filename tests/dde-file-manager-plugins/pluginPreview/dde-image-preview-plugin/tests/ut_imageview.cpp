@@ -9,6 +9,8 @@
 
 #include <QImageReader>
 #include <QFile>
+#include <QCoreApplication>
+#include <QThread>
 
 class TestImageView : public testing::Test {
 public:
@@ -56,3 +58,24 @@ TEST_F(TestImageView, get_source_size){
     m_imageView->setFile(m_url.toLocalFile(), format);
     EXPECT_TRUE(m_imageView->sourceSize().isValid());
 }
+
+TEST_F(TestImageView, decode_in_background){
+    QByteArray format = QImageReader::imageFormat(m_url.toLocalFile());
+    m_imageView->setFile(QString("not-exists.png"), format);
+    m_imageView->setFile(m_url.toLocalFile(), format);
+
+    // 解码完成前显示与解码结果同样大小的占位图
+    ASSERT_TRUE(m_imageView->pixmap());
+    const QSize placeholderSize = m_imageView->pixmap()->size();
+
+    for (int i = 0; i < 100; ++i) {
+        QCoreApplication::processEvents();
+        QThread::msleep(10);
+    }
+
+    ASSERT_TRUE(m_imageView->pixmap());
+    EXPECT_FALSE(m_imageView->pixmap()->isNull());
+    EXPECT_EQ(placeholderSize, m_imageView->pixmap()->size());
+    EXPECT_LE(m_imageView->pixmap()->width(), m_imageView->sourceSize().width());
+    EXPECT_LE(m_imageView->pixmap()->height(), m_imageView->sourceSize().height());
+}
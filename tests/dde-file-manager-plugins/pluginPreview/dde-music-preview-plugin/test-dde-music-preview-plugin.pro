@@ -4,7 +4,7 @@
 #
 #-------------------------------------------------
 
-QT       += core gui widgets multimedia quick dtkwidget
+QT       += core gui widgets multimedia quick concurrent dtkwidget
 
 TARGET = test-dde-music-preview-plugin
 TEMPLATE = app
@@ -7,6 +7,7 @@
 #include <QDir>
 #include <QSize>
 #include <QResizeEvent>
+#include <QCoreApplication>
 
 #include "musicmessageview.h"
 #include "durl.h"
@@ -180,6 +181,17 @@ TEST_F(TestMusicMessageView, can_play)
     emit PrivatePlayer(m_musicMessageView)->mediaStatusChanged(QMediaPlayer::LoadedMedia);
 }
 
+typedef QFutureWatcher<MediaMeta> MetaWatcher;
+ACCESS_PRIVATE_FIELD(MusicMessageView, MetaWatcher, m_metaWatcher);
+ACCESS_PRIVATE_FIELD(MusicMessageView, QString, m_artist);
+TEST_F(TestMusicMessageView, load_meta_in_background)
+{
+    access_private_field::MusicMessageViewm_metaWatcher(*m_musicMessageView).waitForFinished();
+    QCoreApplication::processEvents();
+
+    EXPECT_FALSE(access_private_field::MusicMessageViewm_artist(*m_musicMessageView).isEmpty());
+}
+
 TEST_F(TestMusicMessageView, use_resizeEvent)
 {
     m_musicMessageView->setFixedSize(200, 300);
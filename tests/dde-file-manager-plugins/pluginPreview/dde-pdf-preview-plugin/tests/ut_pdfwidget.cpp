@@ -135,3 +135,21 @@ TEST_F(TestPdfWidget, used_emptyBorder)
     QImage img = PrivateGetRenderedPageImage(temp->pdfInitWorker,0);
     PrivateEmptyBorder(m_pdfWidget, img);
 }
+
+ACCESS_PRIVATE_FUN(PdfInitWorker, QImage(int index, int width), renderPage)
+QImage PrivateRenderPage(PdfInitWorker * initWorker, int index, int width)
+{
+    return call_private_fun::PdfInitWorkerrenderPage(*initWorker, index, width);
+}
+TEST_F(TestPdfWidget, used_renderPage_tiles)
+{
+    QSharedPointer<PdfWidgetPrivate> temp = access_private_field::PdfWidgetd_ptr(*m_pdfWidget);
+    temp->pdfInitWorker->setVisiblePages(0, 0, 300);
+    QImage img = PrivateRenderPage(temp->pdfInitWorker, 0, 300);
+    EXPECT_EQ(300, img.width());
+
+    // 不可见的页面不再渲染，已缓存的分块仍可直接使用
+    temp->pdfInitWorker->setVisiblePages(1, 1, 200);
+    EXPECT_TRUE(PrivateRenderPage(temp->pdfInitWorker, 0, 200).isNull());
+    EXPECT_EQ(img.size(), PrivateRenderPage(temp->pdfInitWorker, 0, 300).size());
+}
@@ -4,7 +4,7 @@
 #
 #-------------------------------------------------
 
-QT       += core gui widgets quick
+QT       += core gui widgets quick concurrent
 
 TARGET = test-dde-text-preview-plugin
 TEMPLATE = app
@@ -26,12 +26,14 @@ QMAKE_LFLAGS += -g -Wall -fprofile-arcs -ftest-coverage  -O0
 SOURCES += \
     $$PWD/../../../../src/dde-file-manager-plugins/pluginPreview/dde-text-preview-plugin/textpreview.cpp \
     $$PWD/../../../../src/dde-file-manager-plugins/pluginPreview/dde-text-preview-plugin/textpreviewplugin.cpp \
-    $$PWD/../../../../src/dde-file-manager-plugins/pluginPreview/dde-text-preview-plugin/textbrowseredit.cpp
+    $$PWD/../../../../src/dde-file-manager-plugins/pluginPreview/dde-text-preview-plugin/textbrowseredit.cpp \
+    $$PWD/../../../../src/dde-file-manager-plugins/pluginPreview/dde-text-preview-plugin/textlineindex.cpp
 
 HEADERS += \
     $$PWD/../../../../src/dde-file-manager-plugins/pluginPreview/dde-text-preview-plugin/textpreview.h \
     $$PWD/../../../../src/dde-file-manager-plugins/pluginPreview/dde-text-preview-plugin/textpreviewplugin.h \
-    $$PWD/../../../../src/dde-file-manager-plugins/pluginPreview/dde-text-preview-plugin/textbrowseredit.h
+    $$PWD/../../../../src/dde-file-manager-plugins/pluginPreview/dde-text-preview-plugin/textbrowseredit.h \
+    $$PWD/../../../../src/dde-file-manager-plugins/pluginPreview/dde-text-preview-plugin/textlineindex.h
 
 #include(../../../../3rdparty/googletest/gtest_dependency.pri)
 include(../../../../3rdparty/cpp-stub/stub.pri)
@@ -15,7 +15,8 @@ HEADERS += \
 SOURCES += \
     $$PWD/test-main.cpp \
     $$PWD/ut_textpreview.cpp \
-    $$PWD/ut_textpreviewplugin.cpp
+    $$PWD/ut_textpreviewplugin.cpp \
+    $$PWD/ut_textlineindex.cpp
 
 !CONFIG(DISABLE_TSAN_TOOL) {
     #DEFINES += TSAN_THREAD #互斥
@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTextCodec>
+#include <QThread>
+
+#include "textlineindex.h"
+
+class TestTextLineIndex : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        ASSERT_TRUE(tempDir.isValid());
+    }
+
+    QString writeFile(const QByteArray &data)
+    {
+        const QString &path = tempDir.filePath("test.log");
+        QFile file(path);
+
+        if (file.open(QIODevice::WriteOnly))
+            file.write(data);
+
+        return path;
+    }
+
+    static void waitForIndex(const TextLineIndex &index)
+    {
+        for (int i = 0; i < 500 && !index.isFinished(); ++i)
+            QThread::msleep(10);
+    }
+
+public:
+    QTemporaryDir tempDir;
+};
+
+TEST_F(TestTextLineIndex, index_lines)
+{
+    QByteArray data;
+
+    for (int i = 0; i < 1000; ++i)
+        data.append(QByteArray("line ") + QByteArray::number(i) + "\r\n");
+
+    TextLineIndex index;
+    ASSERT_TRUE(index.open(writeFile(data)));
+    waitForIndex(index);
+
+    EXPECT_TRUE(index.isFinished());
+    EXPECT_EQ(1000, index.lineCount());
+    EXPECT_EQ(QString("line 0\nline 1"), index.lines(0, 2));
+    EXPECT_EQ(QString("line 130\nline 131"), index.lines(130, 2));
+    EXPECT_EQ(QString("line 999"), index.lines(999, 10));
+    EXPECT_TRUE(index.lines(1000, 1).isEmpty());
+}
+
+TEST_F(TestTextLineIndex, split_long_line)
+{
+    TextLineIndex index;
+    ASSERT_TRUE(index.open(writeFile(QByteArray(10000, 'a'))));
+    waitForIndex(index);
+
+    // 没有换行符的长行被拆分显示
+    EXPECT_EQ(3, index.lineCount());
+    EXPECT_EQ(10000 - 4096 * 2, index.lines(2, 1).size());
+}
+
+TEST_F(TestTextLineIndex, detect_codec)
+{
+    QTextCodec *gbk = QTextCodec::codecForName("GBK");
+    QByteArray data(100 * 1024, 'a');
+    data.append('\n').append(gbk->fromUnicode(QString::fromUtf8("中文")));
+
+    TextLineIndex index;
+    ASSERT_TRUE(index.open(writeFile(data)));
+    waitForIndex(index);
+
+    // 开头部分按 UTF-8 猜测，扫描到后面的 GBK 字符后改用 GBK
+    EXPECT_EQ(gbk, index.codec());
+    EXPECT_EQ(QString::fromUtf8("中文"), index.lines(index.lineCount() - 1, 1));
+}
+
+TEST_F(TestTextLineIndex, open_empty_file)
+{
+    TextLineIndex index;
+    EXPECT_FALSE(index.open(writeFile(QByteArray())));
+    EXPECT_FALSE(index.open(tempDir.filePath("not-exists")));
+}
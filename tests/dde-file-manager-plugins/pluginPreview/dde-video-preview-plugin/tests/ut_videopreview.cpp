@@ -123,3 +123,28 @@ TEST_F(TestVideoPreview, use_DoneCurrent)
 {
     m_videoPreview->DoneCurrent();
 }
+
+TEST_F(TestVideoPreview, reuse_player_widget)
+{
+    VideoWidget *widget = PrivateplayerWidget(m_videoPreview).data();
+
+    delete m_videoPreview;
+    m_videoPreview = new VideoPreview(nullptr);
+
+    EXPECT_EQ(widget, PrivateplayerWidget(m_videoPreview).data());
+    EXPECT_EQ(m_videoPreview, widget->p);
+}
+
+TEST_F(TestVideoPreview, show_and_hide_still)
+{
+    VideoWidget *widget = PrivateplayerWidget(m_videoPreview).data();
+    QPixmap pixmap(16, 16);
+    pixmap.fill(Qt::black);
+
+    widget->showStill(pixmap);
+    EXPECT_FALSE(widget->stillPixmap.isNull());
+
+    widget->hideStill();
+    EXPECT_TRUE(widget->stillPixmap.isNull());
+    EXPECT_TRUE(widget->still->isHidden());
+}
@@ -6,6 +6,8 @@
 
 #include <gtest/gtest.h>
 
+#include <sstream>
+
 TEST(TestToBase64, testCommonVault)
 {
     unsigned char data[6] = {0x12, 0x32, 0x56, 0x78, 0x90, 0xab};
@@ -31,3 +33,23 @@ TEST(TestToBase64, testCommonVault2)
         str = nullptr;
     }
 }
+
+TEST(TestServerProtocol, readRequest)
+{
+    std::stringstream input("256 14\n/tmp/a b\nc.mp424 0\n");
+    int size = 0;
+    std::string path;
+    EXPECT_TRUE(readRequest(input, &size, &path));
+    EXPECT_EQ(256, size);
+    EXPECT_EQ(std::string("/tmp/a b\nc.mp4"), path);
+    EXPECT_TRUE(readRequest(input, &size, &path));
+    EXPECT_EQ(24, size);
+    EXPECT_TRUE(path.empty());
+    EXPECT_FALSE(readRequest(input, &size, &path));
+}
+
+TEST(TestServerProtocol, formatResponse)
+{
+    EXPECT_EQ(std::string("0 4\nEjJW"), formatResponse(0, "EjJW"));
+    EXPECT_EQ(std::string("1 5\nerror"), formatResponse(1, "error"));
+}
@@ -6,7 +6,9 @@
 
 #include <gtest/gtest.h>
 
+#define private public
 #include "taghandle.h"
+#undef private
 
 namespace  {
 class TestTagHandle : public testing::Test
@@ -52,5 +54,18 @@ TEST_F(TestTagHandle, on_file_rename)
     files << temp;
     m_tagHandle->onFileRename(files);
 }
+
+TEST_F(TestTagHandle, rename_conflicted)
+{
+    m_tagHandle->m_pendingRenamedFiles << QPair<QByteArray, QByteArray>("/home/a", "/home/b");
+
+    // 依赖之前重命名结果的事件需要分开提交
+    EXPECT_TRUE(m_tagHandle->isRenameConflicted("/home/b", "/home/c"));
+    EXPECT_TRUE(m_tagHandle->isRenameConflicted("/home/b/x", "/home/c"));
+    EXPECT_TRUE(m_tagHandle->isRenameConflicted("/home/c", "/home/a"));
+    EXPECT_FALSE(m_tagHandle->isRenameConflicted("/home/ab", "/home/bc"));
+
+    m_tagHandle->m_pendingRenamedFiles.clear();
+}
 }
 
@@ -0,0 +1,38 @@
+# 热点路径的性能测试，不属于单元测试，需在 dde-file-manager-lib 编译后单独编译运行
+# 例如：qmake && make && ./dfm-benchmark --max-entries 100000 --json result.json
+
+PRJ_FOLDER = $$PWD/../..
+SRC_FOLDER = $$PRJ_FOLDER/src
+LIB_DFM_SRC_FOLDER = $$SRC_FOLDER/dde-file-manager-lib
+
+include($$SRC_FOLDER/common/common.pri)
+
+QT += core gui widgets dbus concurrent testlib
+
+TARGET = dfm-benchmark
+TEMPLATE = app
+CONFIG += c++11 console link_pkgconfig
+CONFIG -= app_bundle
+
+PKGCONFIG += dtkwidget gio-unix-2.0
+
+INCLUDEPATH += \
+    $$LIB_DFM_SRC_FOLDER \
+    $$LIB_DFM_SRC_FOLDER/interfaces \
+    $$LIB_DFM_SRC_FOLDER/io \
+    $$LIB_DFM_SRC_FOLDER/shutil \
+    $$SRC_FOLDER \
+    $$SRC_FOLDER/utils
+
+LIBS += -L$$OUT_PWD/../../src/dde-file-manager-lib -ldde-file-manager \
+        -L$$OUT_PWD/../../src/dde-file-manager-extension -ldfm-extension
+QMAKE_RPATHDIR += $$OUT_PWD/../../src/dde-file-manager-lib $$OUT_PWD/../../src/dde-file-manager-extension
+
+HEADERS += \
+    fixturegenerator.h \
+    $$SRC_FOLDER/dde-desktop/presenter/gridcore.h
+
+SOURCES += \
+    main.cpp \
+    fixturegenerator.cpp \
+    $$SRC_FOLDER/dde-desktop/presenter/gridcore.cpp
@@ -0,0 +1,170 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "fixturegenerator.h"
+
+#include <QDir>
+#include <QFile>
+#include <QImage>
+#include <QPainter>
+#include <QLinearGradient>
+#include <QStringList>
+
+#include <ctime>
+
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+const QStringList kWords { "alpha", "project", "notes", "build", "image", "backup", "draft", "summary",
+                           "文档", "照片", "项目", "会议", "记录", "计划", "总结", "备份" };
+const QStringList kSuffixes { "txt", "md", "png", "jpg", "pdf", "mp3", "mp4", "zip", "cpp", "log", "" };
+const int kMaxFileSize = 8192;   // 目录中的文件最大的大小
+const qint64 kTimeRange = 3 * 365 * 24 * 3600;   // 修改时间分布在最近三年内
+const qint64 kBlockSize = 1024 * 1024;
+const qint64 kSparseDataInterval = 16 * 1024 * 1024;   // 稀疏文件每隔 16M 写入一块数据
+}
+
+/*!
+ * \brief FixtureGenerator::createDirectory 在 path 中生成 fileCount 个文件，约 5% 是子目录
+ */
+bool FixtureGenerator::createDirectory(const QString &path, int fileCount)
+{
+    if (!QDir().mkpath(path))
+        return false;
+
+    const QByteArray contents(kMaxFileSize, 'x');
+    const qint64 now = time(nullptr);
+
+    for (int i = 0; i < fileCount; ++i) {
+        const QString &suffix = kSuffixes.at(static_cast<int>(random() * kSuffixes.count()));
+        QString filePath = path + "/" + randomName() + QString::number(i);
+
+        if (random() < 0.05) {
+            if (!QDir().mkdir(filePath))
+                return false;
+            continue;
+        }
+
+        if (!suffix.isEmpty())
+            filePath += "." + suffix;
+
+        const int fd = ::open(QFile::encodeName(filePath).constData(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+        if (fd < 0)
+            return false;
+
+        const ssize_t size = static_cast<ssize_t>(random() * kMaxFileSize);
+        const bool ok = ::write(fd, contents.constData(), static_cast<size_t>(size)) == size;
+        struct timespec times[2];
+
+        times[0].tv_sec = times[1].tv_sec = now - static_cast<qint64>(random() * kTimeRange);
+        times[0].tv_nsec = times[1].tv_nsec = 0;
+        ::futimens(fd, times);
+        ::close(fd);
+
+        if (!ok)
+            return false;
+    }
+
+    return true;
+}
+
+/*!
+ * \brief FixtureGenerator::createImages 生成 1920x1080 的 png 图片，用于缩略图的测试
+ */
+bool FixtureGenerator::createImages(const QString &path, int imageCount)
+{
+    if (!QDir().mkpath(path))
+        return false;
+
+    for (int i = 0; i < imageCount; ++i) {
+        QImage image(1920, 1080, QImage::Format_RGB32);
+        QPainter painter(&image);
+        QLinearGradient gradient(0, 0, image.width(), image.height());
+
+        gradient.setColorAt(0, QColor::fromHsv(static_cast<int>(random() * 360), 200, 200));
+        gradient.setColorAt(1, QColor::fromHsv(static_cast<int>(random() * 360), 200, 200));
+        painter.fillRect(image.rect(), gradient);
+        painter.drawText(image.rect(), Qt::AlignCenter, randomName());
+        painter.end();
+
+        if (!image.save(QString("%1/image%2.png").arg(path).arg(i)))
+            return false;
+    }
+
+    return true;
+}
+
+bool FixtureGenerator::createSmallFiles(const QString &path, int fileCount, int fileSize)
+{
+    if (!QDir().mkpath(path))
+        return false;
+
+    const QByteArray contents(fileSize, 's');
+
+    for (int i = 0; i < fileCount; ++i) {
+        QFile file(QString("%1/%2%3.txt").arg(path).arg(randomName()).arg(i));
+
+        if (!file.open(QIODevice::WriteOnly) || file.write(contents) != fileSize)
+            return false;
+    }
+
+    return true;
+}
+
+bool FixtureGenerator::createFile(const QString &filePath, qint64 size)
+{
+    QFile file(filePath);
+
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    QByteArray block(kBlockSize, Qt::Uninitialized);
+
+    for (qint64 written = 0; written < size; written += block.size()) {
+        // 内容不能全部相同，避免被文件系统压缩或去重
+        for (int i = 0; i < block.size(); i += 4096)
+            block[i] = static_cast<char>(random() * 256);
+
+        if (file.write(block.constData(), qMin<qint64>(block.size(), size - written)) < 0)
+            return false;
+    }
+
+    return true;
+}
+
+/*!
+ * \brief FixtureGenerator::createSparseFile 生成大小为 size 的稀疏文件，只有少量的数据块
+ */
+bool FixtureGenerator::createSparseFile(const QString &filePath, qint64 size)
+{
+    QFile file(filePath);
+
+    if (!file.open(QIODevice::WriteOnly) || !file.resize(size))
+        return false;
+
+    const QByteArray block(64 * 1024, 'd');
+
+    for (qint64 pos = 0; pos + block.size() <= size; pos += kSparseDataInterval) {
+        if (!file.seek(pos) || file.write(block) != block.size())
+            return false;
+    }
+
+    return true;
+}
+
+QString FixtureGenerator::randomName()
+{
+    return kWords.at(static_cast<int>(random() * kWords.count())) + "_"
+           + kWords.at(static_cast<int>(random() * kWords.count())) + "_";
+}
+
+double FixtureGenerator::random()
+{
+    // 线性同余，保证不同平台上生成的文件一致
+    seed = seed * 1664525u + 1013904223u;
+    return (seed >> 8) / double(1 << 24);
+}
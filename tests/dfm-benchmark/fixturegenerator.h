@@ -0,0 +1,32 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef FIXTUREGENERATOR_H
+#define FIXTUREGENERATOR_H
+
+#include <QString>
+
+/*!
+ * \brief FixtureGenerator 生成性能测试使用的文件
+ *
+ * 文件名、大小和修改时间由固定种子的随机数决定，相同的参数生成相同的文件，
+ * 保证不同版本之间的测试结果可以比较。
+ */
+class FixtureGenerator
+{
+public:
+    bool createDirectory(const QString &path, int fileCount);
+    bool createImages(const QString &path, int imageCount);
+    bool createSmallFiles(const QString &path, int fileCount, int fileSize);
+    bool createFile(const QString &filePath, qint64 size);
+    bool createSparseFile(const QString &filePath, qint64 size);
+
+private:
+    QString randomName();
+    double random();
+
+    quint32 seed = 20220101;
+};
+
+#endif   // FIXTUREGENERATOR_H
@@ -0,0 +1,428 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "fixturegenerator.h"
+
+// 排序是异步的，测试中直接调用同步的排序函数
+#define private public
+#include "dfilesystemmodel.h"
+#undef private
+
+#include "dfileservices.h"
+#include "dmimedatabase.h"
+#include "dthumbnailprovider.h"
+#include "dfmdirsnapshotcache.h"
+#include "dfilecopymovejob.h"
+#include "controllers/jobcontroller.h"
+#include "views/dfileview.h"
+#include "views/fileviewhelper.h"
+#include "dde-desktop/presenter/gridcore.h"
+
+#include <QApplication>
+#include <QAtomicInt>
+#include <QDateTime>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMap>
+#include <QSysInfo>
+#include <QTemporaryDir>
+#include <QTemporaryFile>
+#include <QXmlStreamReader>
+#include <QtTest>
+
+DFM_USE_NAMESPACE
+
+namespace {
+const QDir::Filters kListFilters = QDir::AllEntries | QDir::NoDotAndDotDot | QDir::System | QDir::Hidden;
+const int kImageCount = 20;
+const int kSmallFileCount = 10000;
+const int kSmallFileSize = 4096;
+const qint64 kBigFileSize = 512 * 1024 * 1024;
+const qint64 kSparseFileSize = Q_INT64_C(4) * 1024 * 1024 * 1024;
+const qint64 kListTimeout = 10 * 60 * 1000;   // 等待模型加载完成的最长时间（ms）
+
+//! 把 qtestlib 的 xml 结果中的基准数据转为 json，便于在不同版本之间比较
+bool writeJson(const QString &xmlFile, const QString &jsonFile)
+{
+    QFile file(xmlFile);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QXmlStreamReader reader(&file);
+    QString function;
+    QJsonArray results;
+
+    while (!reader.atEnd()) {
+        if (reader.readNext() != QXmlStreamReader::StartElement)
+            continue;
+
+        const QXmlStreamAttributes &attributes = reader.attributes();
+
+        if (reader.name() == QLatin1String("TestFunction")) {
+            function = attributes.value("name").toString();
+        } else if (reader.name() == QLatin1String("BenchmarkResult")) {
+            QJsonObject result;
+            result["test"] = function;
+            result["tag"] = attributes.value("tag").toString();
+            result["metric"] = attributes.value("metric").toString();
+            result["value"] = attributes.value("value").toDouble();
+            result["iterations"] = attributes.value("iterations").toInt();
+            results << result;
+        }
+    }
+
+    if (reader.hasError()) {
+        qWarning() << "failed to parse benchmark results:" << reader.errorString();
+        return false;
+    }
+
+    QJsonObject root;
+    root["date"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+    root["host"] = QSysInfo::machineHostName();
+    root["kernel"] = QSysInfo::kernelVersion();
+    root["cpu"] = QSysInfo::currentCpuArchitecture();
+    root["results"] = results;
+
+    QFile output(jsonFile);
+    if (!output.open(QIODevice::WriteOnly))
+        return false;
+
+    return output.write(QJsonDocument(root).toJson()) > 0;
+}
+}
+
+/*!
+ * \brief FileManagerBenchmark 文件管理器热点路径的性能测试
+ *
+ * 测试文件在第一次使用时生成，超过 maxEntries 的规模会被跳过。
+ */
+class FileManagerBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit FileManagerBenchmark(int maxEntries)
+        : maxEntries(maxEntries)
+    {
+    }
+
+private slots:
+    void initTestCase()
+    {
+        QVERIFY(root.isValid());
+    }
+
+    void cleanupTestCase()
+    {
+        delete model;
+        delete helper;
+        delete view;
+    }
+
+    void jobController_data()
+    {
+        addEntryRows();
+    }
+
+    //! 只遍历目录，不插入模型
+    void jobController()
+    {
+        QFETCH(int, entries);
+        const QString &path = listDirectory(entries);
+
+        QAtomicInt count;
+        QBENCHMARK {
+            count.store(0);
+            QScopedPointer<JobController> job(DFileService::instance()->getChildrenJob(nullptr, DUrl::fromLocalFile(path), QStringList(), kListFilters));
+            QVERIFY(job);
+            connect(job.data(), &JobController::addChildrenList, [&count](const QList<DAbstractFileInfoPointer> &infoList) {
+                count.fetchAndAddRelaxed(infoList.count());
+            });
+            job->start();
+            job->wait();
+        }
+        QCOMPARE(count.load(), entries);
+    }
+
+    void model_data()
+    {
+        addEntryRows();
+    }
+
+    //! 从打开目录到模型加载完所有文件
+    void model()
+    {
+        QFETCH(int, entries);
+        const QString &path = listDirectory(entries);
+
+        QBENCHMARK {
+            QVERIFY(loadModel(path, entries));
+        }
+    }
+
+    void sort_data()
+    {
+        QTest::addColumn<int>("role");
+
+        QTest::newRow("name") << static_cast<int>(DFileSystemModel::FileDisplayNameRole);
+        QTest::newRow("size") << static_cast<int>(DFileSystemModel::FileSizeRole);
+        QTest::newRow("type") << static_cast<int>(DFileSystemModel::FileMimeTypeRole);
+        QTest::newRow("modified") << static_cast<int>(DFileSystemModel::FileLastModifiedRole);
+        QTest::newRow("created") << static_cast<int>(DFileSystemModel::FileCreatedRole);
+    }
+
+    void sort()
+    {
+        QFETCH(int, role);
+        const int entries = qMin(maxEntries, 100000);
+
+        QVERIFY(loadModel(listDirectory(entries), entries));
+
+        // 每次切换顺序，避免对已排好的列表排序
+        Qt::SortOrder order = Qt::AscendingOrder;
+        QBENCHMARK {
+            order = order == Qt::AscendingOrder ? Qt::DescendingOrder : Qt::AscendingOrder;
+            model->setSortRole(role, order);
+            QVERIFY(model->doSortBusiness(false));
+        }
+    }
+
+    void fileInfo()
+    {
+        const QList<DUrl> &urls = fileUrls(listDirectory(10000));
+
+        QBENCHMARK {
+            for (const DUrl &url : urls) {
+                const DAbstractFileInfoPointer &info = DFileService::instance()->createFileInfo(nullptr, url, false);
+                QVERIFY(info && info->exists());
+            }
+        }
+    }
+
+    void mimeType()
+    {
+        const QList<DUrl> &urls = fileUrls(listDirectory(10000));
+        DMimeDatabase db;
+
+        QBENCHMARK {
+            for (const DUrl &url : urls)
+                db.mimeTypeForFile(url.toLocalFile());
+        }
+    }
+
+    void thumbnail()
+    {
+        const QString &path = fixturePath("images");
+
+        if (!QFile::exists(path))
+            QVERIFY(generator.createImages(path, kImageCount));
+
+        const QList<DUrl> &urls = fileUrls(path);
+        QBENCHMARK {
+            for (const DUrl &url : urls)
+                QVERIFY(!DThumbnailProvider::instance()->createThumbnail(QFileInfo(url.toLocalFile()), DThumbnailProvider::Normal).isEmpty());
+        }
+    }
+
+    void copy_data()
+    {
+        QTest::addColumn<QString>("name");
+
+        QTest::newRow("bigFile") << QString("big.bin");
+        QTest::newRow("smallFiles") << QString("small");
+        QTest::newRow("sparseFile") << QString("sparse.bin");
+    }
+
+    void copy()
+    {
+        QFETCH(QString, name);
+        const QString &source = fixturePath(name);
+
+        if (!QFile::exists(source)) {
+            if (name == "big.bin")
+                QVERIFY(generator.createFile(source, kBigFileSize));
+            else if (name == "small")
+                QVERIFY(generator.createSmallFiles(source, kSmallFileCount, kSmallFileSize));
+            else
+                QVERIFY(generator.createSparseFile(source, kSparseFileSize));
+        }
+
+        QTemporaryDir target(fixturePath("copy-XXXXXX"));
+        QVERIFY(target.isValid());
+
+        // 每次拷贝到新的目录，只测量一次
+        QBENCHMARK_ONCE {
+            DFileCopyMoveJob job;
+            job.setMode(DFileCopyMoveJob::CopyMode);
+            job.start(DUrlList() << DUrl::fromLocalFile(source), DUrl::fromLocalFile(target.path()));
+            while (!job.isFinished())
+                QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+            QCOMPARE(job.error(), DFileCopyMoveJob::NoError);
+        }
+    }
+
+    void gridArrange_data()
+    {
+        QTest::addColumn<int>("items");
+
+        QTest::newRow("1000") << 1000;
+        QTest::newRow("10000") << 10000;
+    }
+
+    //! 桌面的图标自动排列：依次放入空位，再在中间放入图标使其它图标避让
+    void gridArrange()
+    {
+        QFETCH(int, items);
+        const int height = 20;
+        const int width = items * 5 / 4 / height + 1;
+
+        QStringList names;
+        for (int i = 0; i < items; ++i)
+            names << QString("file:///home/user/Desktop/item%1").arg(i);
+
+        QBENCHMARK {
+            GridCore core;
+            core.screensCoordInfo.insert(1, qMakePair(width, height));
+            core.screens.insert(1, GridScreen(width * height));
+
+            for (const QString &name : names)
+                core.addItem(1, core.screens[1].findFree(), name);
+
+            for (int i = 0; i < 100; ++i) {
+                const GIndex index = (items / 2 + i * 7) % items;
+                const QString &item = core.screens[1].takeAt(index);
+                core.reloacle(1, index, 1, 1);
+                core.addItem(1, core.screens[1].findFree(index), item);
+            }
+
+            QCOMPARE(core.emptyPostion(1).count(), width * height - items);
+        }
+    }
+
+private:
+    void addEntryRows()
+    {
+        QTest::addColumn<int>("entries");
+
+        for (int entries : { 10000, 100000, 1000000 }) {
+            if (entries <= maxEntries)
+                QTest::newRow(QByteArray::number(entries).constData()) << entries;
+        }
+    }
+
+    QString fixturePath(const QString &name) const
+    {
+        return root.path() + "/" + name;
+    }
+
+    QString listDirectory(int entries)
+    {
+        const QString &path = fixturePath(QString("list%1").arg(entries));
+
+        if (!QFile::exists(path) && !generator.createDirectory(path, entries))
+            qWarning() << "failed to create fixture" << path;
+
+        return path;
+    }
+
+    static QList<DUrl> fileUrls(const QString &path)
+    {
+        QList<DUrl> urls;
+        QDirIterator it(path, QDir::Files);
+
+        while (it.hasNext())
+            urls << DUrl::fromLocalFile(it.next());
+
+        return urls;
+    }
+
+    //! 重新创建模型并加载目录，等待所有文件插入模型
+    bool loadModel(const QString &path, int entries)
+    {
+        if (!view) {
+            view = new DFileView();
+            helper = new FileViewHelper(view);
+        }
+
+        delete model;
+        model = new DFileSystemModel(helper);
+        // 每次都重新遍历目录，不使用上次的快照
+        DFMDirSnapshotCache::instance()->clear();
+
+        const QModelIndex &rootIndex = model->setRootUrl(DUrl::fromLocalFile(path));
+        model->fetchMore(rootIndex);
+
+        QElapsedTimer timer;
+        timer.start();
+
+        while (model->state() != DFileSystemModel::Idle || model->rowCount(rootIndex) < entries) {
+            if (timer.elapsed() > kListTimeout)
+                return false;
+
+            QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+        }
+
+        return model->rowCount(rootIndex) == entries;
+    }
+
+    int maxEntries;
+    QTemporaryDir root;
+    FixtureGenerator generator;
+    DFileView *view = nullptr;
+    FileViewHelper *helper = nullptr;
+    DFileSystemModel *model = nullptr;
+};
+
+int main(int argc, char *argv[])
+{
+    // 配置和缩略图写入临时目录，不影响当前用户的数据
+    QTemporaryDir homeDir;
+    qputenv("XDG_CONFIG_HOME", (homeDir.path() + "/config").toLocal8Bit());
+    qputenv("XDG_CACHE_HOME", (homeDir.path() + "/cache").toLocal8Bit());
+
+    QApplication app(argc, argv);
+    app.setOrganizationName("deepin");
+    app.setApplicationName("dde-file-manager");
+
+    // 取出自定义的参数，其余的参数交给 qtestlib（如 -iterations、-callgrind、测试函数名）
+    QStringList args = app.arguments();
+    QString jsonFile;
+    int maxEntries = 10000;
+
+    for (int i = 1; i < args.count() - 1;) {
+        if (args.at(i) == "--json") {
+            jsonFile = args.at(i + 1);
+        } else if (args.at(i) == "--max-entries") {
+            maxEntries = args.at(i + 1).toInt();
+        } else {
+            ++i;
+            continue;
+        }
+
+        args.removeAt(i);
+        args.removeAt(i);
+    }
+
+    QTemporaryFile xmlFile;
+    if (!xmlFile.open())
+        return 1;
+
+    args << "-o" << xmlFile.fileName() + ",xml" << "-o" << "-,txt";
+
+    FileManagerBenchmark benchmark(maxEntries);
+    int ret = QTest::qExec(&benchmark, args);
+
+    if (!jsonFile.isEmpty() && !writeJson(xmlFile.fileName(), jsonFile)) {
+        qWarning() << "failed to write" << jsonFile;
+        ret = 1;
+    }
+
+    return ret;
+}
+
+#include "main.moc"
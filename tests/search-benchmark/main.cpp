@@ -0,0 +1,230 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "treegenerator.h"
+
+#include "searchservice.h"
+#include "dfmapplication.h"
+
+// 各搜索项的构造函数是私有的，仅 TaskCommander 可以创建
+#define private public
+#include "fsearch/fssearcher.h"
+#include "fulltext/fulltextsearcher.h"
+#include "iterator/iteratorsearcher.h"
+#ifndef DISABLE_QUICK_SEARCH
+#include "anything/anythingsearcher.h"
+#endif
+#undef private
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QUuid>
+#include <QtConcurrent>
+
+namespace {
+struct Measurement
+{
+    QString name;
+    qint64 firstResult = -1;   // 第一个结果的用时（ms）
+    qint64 total = 0;   // 完成搜索的用时（ms）
+    int results = 0;
+    qint64 peakRss = 0;   // 峰值内存（KB）
+};
+
+//! 重置 /proc/self/status 中的 VmHWM，使每次测量只统计本次的峰值
+void resetPeakRss()
+{
+    QFile file("/proc/self/clear_refs");
+    if (file.open(QIODevice::WriteOnly))
+        file.write("5");
+}
+
+qint64 peakRss()
+{
+    QFile file("/proc/self/status");
+    if (!file.open(QIODevice::ReadOnly))
+        return 0;
+
+    for (const QByteArray &line : file.readAll().split('\n')) {
+        if (line.startsWith("VmHWM:"))
+            return line.mid(6).trimmed().split(' ').first().toLongLong();
+    }
+
+    return 0;
+}
+
+Measurement runSearcher(const QString &name, AbstractSearcher *searcher)
+{
+    Measurement m;
+    m.name = name;
+
+    QElapsedTimer timer;
+    QMutex mutex;
+    QObject::connect(searcher, &AbstractSearcher::unearthed, searcher, [&](AbstractSearcher *s) {
+        QMutexLocker lk(&mutex);
+        if (m.firstResult < 0)
+            m.firstResult = timer.elapsed();
+        m.results += s->takeAll().count();
+    }, Qt::DirectConnection);
+
+    resetPeakRss();
+    timer.start();
+
+    // 在线程中搜索，主线程继续处理事件（fsearch 数据库的文件监视等在主线程中）
+    QFuture<void> future = QtConcurrent::run([searcher] {
+        searcher->search();
+    });
+    while (!future.isFinished())
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+
+    QMutexLocker lk(&mutex);
+    m.results += searcher->takeAll().count();
+    m.total = timer.elapsed();
+    m.peakRss = peakRss();
+
+    delete searcher;
+    return m;
+}
+
+//! 通过 SearchService 完整地执行一次搜索，搜索项由 TaskCommander 按当前的配置选择
+Measurement runService(const DUrl &url, const QString &keyword)
+{
+    Measurement m;
+    m.name = "SearchService";
+
+    const QString &taskId = QUuid::createUuid().toString(QUuid::WithoutBraces);
+    QElapsedTimer timer;
+    QEventLoop loop;
+
+    QObject::connect(searchServ, &SearchService::matched, &loop, [&](const QString &id) {
+        if (id != taskId)
+            return;
+        if (m.firstResult < 0)
+            m.firstResult = timer.elapsed();
+        m.results += searchServ->matchedResults(taskId).count();
+    });
+    QObject::connect(searchServ, &SearchService::searchCompleted, &loop, [&](const QString &id) {
+        if (id == taskId)
+            loop.quit();
+    });
+
+    resetPeakRss();
+    timer.start();
+    if (searchServ->search(taskId, url, keyword))
+        loop.exec();
+
+    m.total = timer.elapsed();
+    m.peakRss = peakRss();
+    return m;
+}
+
+void printMeasurement(QTextStream &out, const Measurement &m)
+{
+    out << qSetFieldWidth(24) << left << m.name << qSetFieldWidth(12) << right
+        << (m.firstResult < 0 ? QString("-") : QString::number(m.firstResult))
+        << m.total << m.results << m.peakRss << qSetFieldWidth(0) << endl;
+}
+}
+
+int main(int argc, char *argv[])
+{
+    // 索引和配置写入临时目录，不影响当前用户的数据
+    QTemporaryDir configDir;
+    qputenv("XDG_CONFIG_HOME", configDir.path().toLocal8Bit());
+
+    QApplication app(argc, argv);
+    app.setOrganizationName("deepin");
+    app.setApplicationName("dde-file-manager");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Benchmark of the file manager search backends.");
+    parser.addHelpOption();
+    QCommandLineOption rootOption("root", "Search an existing directory instead of generating one.", "path");
+    QCommandLineOption filesOption("files", "Number of generated files.", "count", "10000");
+    QCommandLineOption depthOption("depth", "Maximum depth of generated directories.", "depth", "6");
+    QCommandLineOption cjkOption("cjk-ratio", "Ratio of CJK names and words.", "ratio", "0.3");
+    QCommandLineOption docOption("doc-ratio", "Ratio of text documents.", "ratio", "0.1");
+    QCommandLineOption matchOption("match-ratio", "Ratio of names and documents containing the keyword.", "ratio", "0.01");
+    QCommandLineOption keywordOption("keyword", "Search keyword.", "keyword", "report");
+    QCommandLineOption fullTextOption("fulltext", "Enable full-text search for the SearchService run.");
+    parser.addOptions({ rootOption, filesOption, depthOption, cjkOption, docOption, matchOption, keywordOption, fullTextOption });
+    parser.process(app);
+
+    QTextStream out(stdout);
+    const QString &keyword = parser.value(keywordOption);
+
+    QTemporaryDir treeDir;
+    QString root = parser.value(rootOption);
+    if (root.isEmpty()) {
+        TreeGenerator::Options options;
+        options.fileCount = parser.value(filesOption).toInt();
+        options.depth = parser.value(depthOption).toInt();
+        options.cjkRatio = parser.value(cjkOption).toDouble();
+        options.documentRatio = parser.value(docOption).toDouble();
+        options.matchRatio = parser.value(matchOption).toDouble();
+        options.keyword = keyword;
+
+        root = treeDir.path() + "/tree";
+        QElapsedTimer timer;
+        timer.start();
+
+        TreeGenerator generator(options);
+        if (!generator.generate(root)) {
+            out << "failed to generate tree in " << root << endl;
+            return 1;
+        }
+
+        out << "generated " << options.fileCount << " files in " << timer.elapsed() << " ms, "
+            << generator.matchedNameCount() << " matched names, "
+            << generator.matchedDocumentCount() << " matched documents" << endl;
+    }
+
+    const DUrl &url = DUrl::fromLocalFile(root);
+    QList<Measurement> measurements;
+
+    if (FsSearcher::isSupported(url)) {
+        // 第一次搜索包含建立数据库的时间
+        measurements << runSearcher("FsSearcher (cold)", new FsSearcher(url, keyword));
+        measurements << runSearcher("FsSearcher (warm)", new FsSearcher(url, keyword));
+    } else {
+        out << "FsSearcher: unsupported for " << root << endl;
+    }
+
+#ifndef DISABLE_QUICK_SEARCH
+    bool isPrependData = false;
+    if (AnythingSearcher::isSupported(url, isPrependData))
+        measurements << runSearcher("AnythingSearcher", new AnythingSearcher(url, keyword, isPrependData));
+    else
+        out << "AnythingSearcher: unsupported for " << root << endl;
+#endif
+
+    measurements << runSearcher("IteratorSearcher", new IteratorSearcher(url, keyword));
+
+    {
+        QElapsedTimer timer;
+        resetPeakRss();
+        timer.start();
+        FullTextSearcher indexer(DUrl(), "");
+        const bool created = indexer.createIndex(root);
+        out << "full-text index build: " << (created ? "" : "failed, ") << timer.elapsed() << " ms, peak rss "
+            << peakRss() << " KB" << endl;
+    }
+    measurements << runSearcher("FullTextSearcher", new FullTextSearcher(url, keyword));
+
+    if (parser.isSet(fullTextOption))
+        DFMApplication::setGenericAttribute(DFMApplication::GA_IndexFullTextSearch, true);
+    measurements << runService(url, keyword);
+
+    out << endl << qSetFieldWidth(24) << left << "searcher" << qSetFieldWidth(12) << right
+        << "first(ms)" << "total(ms)" << "results" << "rss(KB)" << qSetFieldWidth(0) << endl;
+    for (const Measurement &m : measurements)
+        printMeasurement(out, m);
+
+    return 0;
+}
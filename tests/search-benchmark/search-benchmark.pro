@@ -0,0 +1,42 @@
+# 搜索性能测试，不属于单元测试，需在 dde-file-manager-lib 编译后单独编译运行
+# 例如：qmake && make && ./search-benchmark --files 100000 --depth 8 --cjk-ratio 0.5
+
+PRJ_FOLDER = $$PWD/../..
+SRC_FOLDER = $$PRJ_FOLDER/src
+LIB_DFM_SRC_FOLDER = $$SRC_FOLDER/dde-file-manager-lib
+
+include($$SRC_FOLDER/common/common.pri)
+
+QT += core gui widgets dbus concurrent
+
+TARGET = search-benchmark
+TEMPLATE = app
+CONFIG += c++11 console link_pkgconfig
+CONFIG -= app_bundle
+
+PKGCONFIG += dtkwidget glib-2.0 liblucene++ liblucene++-contrib docparser
+
+!CONFIG(ENABLE_ANYTHING) {
+    DEFINES += DISABLE_QUICK_SEARCH
+}
+
+INCLUDEPATH += \
+    $$LIB_DFM_SRC_FOLDER \
+    $$LIB_DFM_SRC_FOLDER/interfaces \
+    $$LIB_DFM_SRC_FOLDER/searchservice \
+    $$LIB_DFM_SRC_FOLDER/searchservice/searcher \
+    $$PRJ_FOLDER/3rdparty \
+    $$PRJ_FOLDER/3rdparty/fsearch \
+    $$SRC_FOLDER \
+    $$SRC_FOLDER/utils
+
+LIBS += -L$$OUT_PWD/../../src/dde-file-manager-lib -ldde-file-manager \
+        -L$$OUT_PWD/../../src/dde-file-manager-extension -ldfm-extension
+QMAKE_RPATHDIR += $$OUT_PWD/../../src/dde-file-manager-lib $$OUT_PWD/../../src/dde-file-manager-extension
+
+HEADERS += \
+    treegenerator.h
+
+SOURCES += \
+    main.cpp \
+    treegenerator.cpp
@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "treegenerator.h"
+
+#include <QDir>
+#include <QFile>
+#include <QStringList>
+#include <QVector>
+
+namespace {
+const QStringList kWords { "alpha", "project", "notes", "build", "image", "backup", "draft", "summary",
+                           "data", "photo", "music", "video", "config", "archive", "invoice", "plan" };
+const QStringList kCjkWords { "文档", "照片", "项目", "会议", "记录", "计划", "总结", "备份",
+                              "资料", "合同", "表格", "设计", "测试", "音乐", "视频", "报表" };
+const QStringList kDocumentSuffixes { "txt", "md" };
+const QStringList kOtherSuffixes { "png", "jpg", "bin", "mp3", "zip", "log" };
+const int kContentWords = 300;   // 每个文档的词语数量
+}
+
+TreeGenerator::TreeGenerator(const Options &options)
+    : options(options)
+{
+}
+
+bool TreeGenerator::generate(const QString &root)
+{
+    if (!QDir().mkpath(root))
+        return false;
+
+    matchedNames = 0;
+    matchedDocuments = 0;
+
+    // 先建立目录，每个目录挂在随机选择的较浅的目录下
+    const int dirCount = qMax(1, options.fileCount / qMax(1, options.filesPerDir));
+    QVector<QPair<QString, int>> dirs { qMakePair(root, 0) };
+    for (int i = 1; i < dirCount; ++i) {
+        QPair<QString, int> parent = dirs.at(static_cast<int>(random() * dirs.count()));
+        if (parent.second >= options.depth)
+            parent = dirs.first();
+
+        const QString &path = parent.first + "/" + randomName(random() < options.cjkRatio, false) + QString::number(i);
+        if (!QDir().mkdir(path))
+            return false;
+
+        dirs << qMakePair(path, parent.second + 1);
+    }
+
+    for (int i = 0; i < options.fileCount; ++i) {
+        const QString &dir = dirs.at(static_cast<int>(random() * dirs.count())).first;
+        const bool isDocument = random() < options.documentRatio;
+        const bool nameMatched = random() < options.matchRatio;
+        const QStringList &suffixes = isDocument ? kDocumentSuffixes : kOtherSuffixes;
+        const QString &suffix = suffixes.at(static_cast<int>(random() * suffixes.count()));
+
+        QFile file(dir + "/" + randomName(random() < options.cjkRatio, nameMatched) + QString::number(i) + "." + suffix);
+        if (!file.open(QIODevice::WriteOnly))
+            return false;
+
+        if (nameMatched)
+            ++matchedNames;
+
+        if (isDocument) {
+            const bool contentMatched = random() < options.matchRatio;
+            if (contentMatched)
+                ++matchedDocuments;
+            file.write(randomContents(contentMatched));
+        }
+    }
+
+    return true;
+}
+
+int TreeGenerator::matchedNameCount() const
+{
+    return matchedNames;
+}
+
+int TreeGenerator::matchedDocumentCount() const
+{
+    return matchedDocuments;
+}
+
+QString TreeGenerator::randomName(bool cjk, bool matched)
+{
+    const QStringList &words = cjk ? kCjkWords : kWords;
+    QString name = words.at(static_cast<int>(random() * words.count()));
+    if (matched)
+        name += "_" + options.keyword;
+
+    return name + "_" + words.at(static_cast<int>(random() * words.count())) + "_";
+}
+
+QByteArray TreeGenerator::randomContents(bool matched)
+{
+    QStringList contents;
+    for (int i = 0; i < kContentWords; ++i) {
+        const QStringList &words = random() < options.cjkRatio ? kCjkWords : kWords;
+        contents << words.at(static_cast<int>(random() * words.count()));
+    }
+
+    if (matched)
+        contents.insert(static_cast<int>(random() * contents.count()), options.keyword);
+
+    return contents.join(' ').toUtf8();
+}
+
+double TreeGenerator::random()
+{
+    // 线性同余，保证不同平台上生成的目录树一致
+    seed = seed * 1664525u + 1013904223u;
+    return (seed >> 8) / double(1 << 24);
+}
@@ -0,0 +1,48 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef TREEGENERATOR_H
+#define TREEGENERATOR_H
+
+#include <QString>
+
+/*!
+ * \brief TreeGenerator 生成用于搜索性能测试的目录树
+ *
+ * 文件随机分布在不超过 depth 层的目录中，文件名由中英文词语组成，
+ * 按 matchRatio 的比例在文件名中加入关键字，按 documentRatio 的比例生成带文本内容的文档供全文搜索。
+ * 使用固定的随机数种子，相同的参数生成相同的目录树。
+ */
+class TreeGenerator
+{
+public:
+    struct Options
+    {
+        int fileCount = 10000;
+        int depth = 6;
+        int filesPerDir = 50;
+        double cjkRatio = 0.3;
+        double documentRatio = 0.1;
+        double matchRatio = 0.01;
+        QString keyword = "report";
+    };
+
+    explicit TreeGenerator(const Options &options);
+
+    bool generate(const QString &root);
+    int matchedNameCount() const;
+    int matchedDocumentCount() const;
+
+private:
+    QString randomName(bool cjk, bool matched);
+    QByteArray randomContents(bool matched);
+    double random();
+
+    Options options;
+    quint32 seed = 20220101;
+    int matchedNames = 0;
+    int matchedDocuments = 0;
+};
+
+#endif   // TREEGENERATOR_H